@@ -33,6 +33,7 @@
 #include "../../Primitives/interface/FlagEnum.h"
 
 #include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
 
 namespace Diligent
 {
@@ -425,6 +426,164 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Bounding boxes in structure-of-arrays layout
+struct BoundBoxesSoA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Bounding spheres in structure-of-arrays layout
+struct BoundSpheresSoA
+{
+    const float* CenterX = nullptr;
+    const float* CenterY = nullptr;
+    const float* CenterZ = nullptr;
+    const float* Radius  = nullptr;
+};
+
+namespace Detail
+{
+
+// Sets the bits of the objects in [First, First + Count) that are not behind any of the planes.
+// pX, pY and pZ are the per-plane arrays of the coordinates of the points tested against the plane,
+// pR is the optional array of the distances the points may be behind the plane.
+inline void GetVisibilityBatch(const Plane3D* Planes,
+                               Uint32         NumPlanes,
+                               const float**  pX,
+                               const float**  pY,
+                               const float**  pZ,
+                               const float*   pR,
+                               size_t         First,
+                               size_t         Count,
+                               Uint32*        pVisibilityBits)
+{
+    VERIFY((First % 32) == 0, "The first object index (", First, ") must be a multiple of 32");
+
+    for (size_t Block = First; Block < First + Count; Block += 32)
+    {
+        const size_t BlockSize = std::min(First + Count - Block, size_t{32});
+
+        Uint32 InvisibleBits = 0;
+        for (Uint32 plane = 0; plane < NumPlanes; ++plane)
+        {
+            const auto& Normal   = Planes[plane].Normal;
+            const auto  Distance = Planes[plane].Distance;
+
+            size_t i = 0;
+#if DILIGENT_SIMD_MATH
+            const auto nx = SIMD::Splat(Normal.x);
+            const auto ny = SIMD::Splat(Normal.y);
+            const auto nz = SIMD::Splat(Normal.z);
+            const auto d  = SIMD::Splat(Distance);
+            for (; i + 4 <= BlockSize; i += 4)
+            {
+                const size_t Idx = Block + i;
+                // Same operation order as GetBoxVisibilityAgainstPlane()
+                auto Dist = SIMD::Add(SIMD::Mul(SIMD::Load(pX[plane] + Idx), nx), SIMD::Mul(SIMD::Load(pY[plane] + Idx), ny));
+                Dist      = SIMD::Add(SIMD::Add(Dist, SIMD::Mul(SIMD::Load(pZ[plane] + Idx), nz)), d);
+                const auto MinDist = pR != nullptr ? SIMD::FlipSign<1, 1, 1, 1>(SIMD::Load(pR + Idx)) : SIMD::Zero();
+                InvisibleBits |= static_cast<Uint32>(SIMD::LessMask(Dist, MinDist)) << i;
+            }
+#endif
+            for (; i < BlockSize; ++i)
+            {
+                const size_t Idx  = Block + i;
+                const float  Dist = pX[plane][Idx] * Normal.x + pY[plane][Idx] * Normal.y + pZ[plane][Idx] * Normal.z + Distance;
+                if (Dist < (pR != nullptr ? -pR[Idx] : 0.f))
+                    InvisibleBits |= 1u << i;
+            }
+        }
+
+        const Uint32 BlockMask       = BlockSize < 32 ? (1u << BlockSize) - 1u : ~0u;
+        pVisibilityBits[Block / 32] = ~InvisibleBits & BlockMask;
+    }
+}
+
+} // namespace Detail
+
+/// Tests the bounding boxes against the view frustum.
+
+/// \param [in]  Frustum         - View frustum.
+/// \param [in]  Boxes           - Bounding boxes in structure-of-arrays layout.
+/// \param [in]  FirstBox        - Index of the first box to test. Must be a multiple of 32.
+/// \param [in]  NumBoxes        - The number of boxes to test.
+/// \param [out] pVisibilityBits - Visibility bits. Bit (i % 32) of pVisibilityBits[i / 32] is set if the box i
+///                                is not invisible, i.e. GetBoxVisibility(Frustum, Box, PlaneFlags) returns
+///                                BoxVisibility::Intersecting or BoxVisibility::FullyVisible.
+///                                Bits of the last word beyond the range are cleared.
+/// \param [in]  PlaneFlags      - Planes to test the boxes against.
+///
+/// \remarks    The boxes are tested 4 at a time when SIMD is available (see BasicMathSIMD.hpp).
+///             Since every call writes whole 32-bit words, disjoint ranges may be processed in parallel,
+///             for example with ParallelFor() using a batch size that is a multiple of 32.
+inline void GetBoxVisibilityBatch(const ViewFrustum&   Frustum,
+                                  const BoundBoxesSoA& Boxes,
+                                  size_t               FirstBox,
+                                  size_t               NumBoxes,
+                                  Uint32*              pVisibilityBits,
+                                  FRUSTUM_PLANE_FLAGS  PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    Plane3D      Planes[ViewFrustum::NUM_PLANES];
+    const float* pX[ViewFrustum::NUM_PLANES];
+    const float* pY[ViewFrustum::NUM_PLANES];
+    const float* pZ[ViewFrustum::NUM_PLANES];
+
+    Uint32 NumPlanes = 0;
+    for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+    {
+        if ((PlaneFlags & (1 << plane_idx)) == 0)
+            continue;
+
+        // Test the farthest box corner along the plane normal (see GetBoxVisibilityAgainstPlane())
+        const auto& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+        Planes[NumPlanes] = Plane;
+        pX[NumPlanes]     = Plane.Normal.x > 0 ? Boxes.MaxX : Boxes.MinX;
+        pY[NumPlanes]     = Plane.Normal.y > 0 ? Boxes.MaxY : Boxes.MinY;
+        pZ[NumPlanes]     = Plane.Normal.z > 0 ? Boxes.MaxZ : Boxes.MinZ;
+        ++NumPlanes;
+    }
+
+    Detail::GetVisibilityBatch(Planes, NumPlanes, pX, pY, pZ, nullptr, FirstBox, NumBoxes, pVisibilityBits);
+}
+
+/// Tests the bounding spheres against the view frustum.
+
+/// \remarks    The frustum planes must be normalized. A sphere is visible unless its center is farther
+///             than its radius behind one of the planes.
+///             See GetBoxVisibilityBatch() for the description of the other parameters.
+inline void GetSphereVisibilityBatch(const ViewFrustum&     Frustum,
+                                     const BoundSpheresSoA& Spheres,
+                                     size_t                 FirstSphere,
+                                     size_t                 NumSpheres,
+                                     Uint32*                pVisibilityBits,
+                                     FRUSTUM_PLANE_FLAGS    PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    Plane3D      Planes[ViewFrustum::NUM_PLANES];
+    const float* pX[ViewFrustum::NUM_PLANES];
+    const float* pY[ViewFrustum::NUM_PLANES];
+    const float* pZ[ViewFrustum::NUM_PLANES];
+
+    Uint32 NumPlanes = 0;
+    for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+    {
+        if ((PlaneFlags & (1 << plane_idx)) == 0)
+            continue;
+
+        Planes[NumPlanes] = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+        pX[NumPlanes]     = Spheres.CenterX;
+        pY[NumPlanes]     = Spheres.CenterY;
+        pZ[NumPlanes]     = Spheres.CenterZ;
+        ++NumPlanes;
+    }
+
+    Detail::GetVisibilityBatch(Planes, NumPlanes, pX, pY, pZ, Spheres.Radius, FirstSphere, NumSpheres, pVisibilityBits);
+}
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
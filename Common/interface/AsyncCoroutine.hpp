@@ -0,0 +1,341 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Optional C++20 coroutine support for asynchronous tasks and thread pools.
+///
+/// The header is empty unless it is compiled with coroutine support (C++20), so it can be
+/// included by C++14 code as well. All types are header-only since the engine itself
+/// is compiled as C++14.
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#    if __has_include(<coroutine>)
+#        define DILIGENT_COROUTINES_SUPPORTED 1
+#    endif
+#endif
+
+#ifndef DILIGENT_COROUTINES_SUPPORTED
+#    define DILIGENT_COROUTINES_SUPPORTED 0
+#endif
+
+#if DILIGENT_COROUTINES_SUPPORTED
+
+#    include <coroutine>
+#    include <memory>
+#    include <mutex>
+#    include <optional>
+#    include <utility>
+
+#    include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace Detail
+{
+
+/// Thread pool task that resumes a suspended coroutine.
+class CoroutineResumeTask final : public AsyncTaskBase
+{
+public:
+    CoroutineResumeTask(IReferenceCounters*     pRefCounters,
+                        std::coroutine_handle<> Handle,
+                        IThreadPool*            pThreadPool,
+                        THREAD_POOL_LANE        Lane) noexcept :
+        AsyncTaskBase{pRefCounters},
+        m_Handle{Handle},
+        m_pThreadPool{pThreadPool},
+        m_Lane{Lane}
+    {}
+
+    ~CoroutineResumeTask()
+    {
+        // If the task was never run (e.g. it waited for a prerequisite that was cancelled),
+        // the coroutine must still be resumed, or it would never finish.
+        // NB: the thread pool may release the task while holding its internal lock, so
+        //     the coroutine is resumed by a new task without prerequisites.
+        if (m_Handle)
+            Enqueue(m_pThreadPool, m_Handle, m_Lane);
+    }
+
+    virtual void Run(Uint32 ThreadId) override final
+    {
+        auto Handle = std::exchange(m_Handle, nullptr);
+        SetStatus(ASYNC_TASK_STATUS_COMPLETE);
+        Handle.resume();
+    }
+
+    /// Resumes the coroutine on the thread pool once all prerequisites are finished.
+    /// If the thread pool is null, the coroutine is resumed on the calling thread.
+    static void Enqueue(IThreadPool*            pThreadPool,
+                        std::coroutine_handle<> Handle,
+                        THREAD_POOL_LANE        Lane,
+                        IAsyncTask**            ppPrerequisites  = nullptr,
+                        Uint32                  NumPrerequisites = 0)
+    {
+        if (pThreadPool == nullptr)
+        {
+            Handle.resume();
+            return;
+        }
+
+        RefCntAutoPtr<CoroutineResumeTask> pTask{MakeNewRCObj<CoroutineResumeTask>()(Handle, pThreadPool, Lane)};
+        pThreadPool->EnqueueTask(pTask, ppPrerequisites, NumPrerequisites, Lane);
+    }
+
+private:
+    std::coroutine_handle<> m_Handle;
+    // The pool must outlive the coroutines that are resumed on it
+    IThreadPool* const     m_pThreadPool;
+    const THREAD_POOL_LANE m_Lane;
+};
+
+/// Asynchronous task that tracks the state of a coroutine.
+/// The task is never enqueued into a thread pool.
+class CoroutineStateTask final : public AsyncTaskBase
+{
+public:
+    using AsyncTaskBase::AsyncTaskBase;
+
+    virtual void Run(Uint32 ThreadId) override final
+    {
+        UNEXPECTED("Coroutine state task must not be run by a thread pool");
+    }
+};
+
+} // namespace Detail
+
+
+/// Coroutine that is tracked by an asynchronous task.
+
+/// A function that returns AsyncCoroutine is a coroutine that starts immediately on the calling
+/// thread and runs until its first suspension point. The task returned by GetTask() is complete
+/// when the coroutine returns, or is cancelled if the coroutine exits with an exception.
+/// The task may be waited for with IAsyncTask::WaitForCompletion(), awaited by other coroutines
+/// with AwaitTask(), or used as a prerequisite of thread pool tasks.
+///
+/// \remarks    The coroutine frame is destroyed when the coroutine finishes, so the AsyncCoroutine object
+///             does not need to be kept alive. The coroutine may finish on any thread: thread pools are
+///             notified when the task finishes and schedule the tasks that depend on it.
+///
+///             Example:
+///
+///                 AsyncCoroutine LoadAsset(IThreadPool* pPool, GPUFenceAwaitQueue& Fences, IFence* pFence, Uint64 Value)
+///                 {
+///                     co_await ResumeOn(pPool, THREAD_POOL_LANE_BACKGROUND);
+///                     // Decode the asset on a worker thread
+///                     co_await Fences.WaitForValue(pFence, Value);
+///                     // The GPU has finished the upload
+///                 }
+class AsyncCoroutine
+{
+public:
+    struct promise_type
+    {
+        RefCntAutoPtr<Detail::CoroutineStateTask> pTask{MakeNewRCObj<Detail::CoroutineStateTask>()()};
+
+        AsyncCoroutine get_return_object()
+        {
+            pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+            return AsyncCoroutine{pTask};
+        }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_void()
+        {
+            pTask->SetStatus(ASYNC_TASK_STATUS_COMPLETE);
+        }
+
+        void unhandled_exception()
+        {
+            LOG_ERROR_MESSAGE("Unhandled exception in a coroutine");
+            pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+        }
+    };
+
+    /// Returns the task that tracks the coroutine state.
+    IAsyncTask* GetTask() const { return m_pTask.RawPtr<IAsyncTask>(); }
+
+private:
+    explicit AsyncCoroutine(IAsyncTask* pTask) :
+        m_pTask{pTask}
+    {}
+
+    RefCntAutoPtr<IAsyncTask> m_pTask;
+};
+
+
+/// Awaitable that suspends the coroutine and resumes it on a worker thread of the thread pool.
+struct ResumeOnThreadPoolAwaiter
+{
+    IThreadPool* const     pThreadPool;
+    const THREAD_POOL_LANE Lane;
+
+    bool await_ready() const noexcept { return pThreadPool == nullptr; }
+    void await_suspend(std::coroutine_handle<> Handle) const
+    {
+        Detail::CoroutineResumeTask::Enqueue(pThreadPool, Handle, Lane);
+    }
+    void await_resume() const noexcept {}
+};
+
+/// Returns the awaitable that moves the coroutine to a worker thread of the thread pool.
+/// If the thread pool is null, the coroutine continues on the current thread.
+inline ResumeOnThreadPoolAwaiter ResumeOn(IThreadPool* pThreadPool, THREAD_POOL_LANE Lane = THREAD_POOL_LANE_NORMAL)
+{
+    return {pThreadPool, Lane};
+}
+
+
+/// Awaitable that suspends the coroutine until the asynchronous task is finished.
+/// co_await returns the final task status (ASYNC_TASK_STATUS_COMPLETE or ASYNC_TASK_STATUS_CANCELLED).
+struct AsyncTaskAwaiter
+{
+    RefCntAutoPtr<IAsyncTask> pTask;
+    IThreadPool* const        pThreadPool;
+    const THREAD_POOL_LANE    Lane;
+
+    bool await_ready() const noexcept { return !pTask || pTask->IsFinished(); }
+    void await_suspend(std::coroutine_handle<> Handle) const
+    {
+        VERIFY(pThreadPool != nullptr, "A thread pool is required to await a task that is not finished");
+        IAsyncTask* pPrerequisite = pTask.RawPtr<IAsyncTask>();
+        Detail::CoroutineResumeTask::Enqueue(pThreadPool, Handle, Lane, &pPrerequisite, 1);
+    }
+    ASYNC_TASK_STATUS await_resume() const noexcept
+    {
+        return pTask ? pTask->GetStatus() : ASYNC_TASK_STATUS_COMPLETE;
+    }
+};
+
+/// Returns the awaitable that suspends the coroutine until pTask is finished and resumes it
+/// on a worker thread of pThreadPool. No thread is blocked while the task is running.
+
+/// \remarks    The awaited task may be finished by any thread, see IThreadPool::EnqueueTask().
+///             If the task is cancelled, the coroutine is resumed as well and co_await
+///             returns ASYNC_TASK_STATUS_CANCELLED.
+inline AsyncTaskAwaiter AwaitTask(IThreadPool* pThreadPool, IAsyncTask* pTask, THREAD_POOL_LANE Lane = THREAD_POOL_LANE_NORMAL)
+{
+    return {RefCntAutoPtr<IAsyncTask>{pTask}, pThreadPool, Lane};
+}
+
+
+/// Single-assignment asynchronous result that may be awaited by one coroutine.
+
+/// The producer calls SetResult() from any thread. The coroutine that awaits the result is resumed
+/// on a worker thread of the thread pool, or, if the pool is null, on the thread that sets the result.
+/// AsyncResult objects are cheap to copy: all copies share the same state.
+template <typename ResultType>
+class AsyncResult
+{
+private:
+    struct State
+    {
+        State(IThreadPool* _pThreadPool, THREAD_POOL_LANE _Lane) :
+            pThreadPool{_pThreadPool},
+            Lane{_Lane}
+        {}
+
+        IThreadPool* const     pThreadPool;
+        const THREAD_POOL_LANE Lane;
+
+        std::mutex                Mtx;
+        std::optional<ResultType> Result;
+        std::coroutine_handle<>   Handle;
+    };
+
+public:
+    explicit AsyncResult(IThreadPool* pThreadPool = nullptr, THREAD_POOL_LANE Lane = THREAD_POOL_LANE_NORMAL) :
+        m_State{std::make_shared<State>(pThreadPool, Lane)}
+    {}
+
+    /// Sets the result and resumes the awaiting coroutine, if any.
+    void SetResult(ResultType Result) const
+    {
+        std::coroutine_handle<> Handle;
+        {
+            std::lock_guard<std::mutex> Lock{m_State->Mtx};
+            VERIFY(!m_State->Result.has_value(), "The result has already been set");
+            m_State->Result.emplace(std::move(Result));
+            Handle = std::exchange(m_State->Handle, nullptr);
+        }
+
+        if (Handle)
+            Detail::CoroutineResumeTask::Enqueue(m_State->pThreadPool, Handle, m_State->Lane);
+    }
+
+    /// Returns true if the result has been set.
+    bool IsReady() const
+    {
+        std::lock_guard<std::mutex> Lock{m_State->Mtx};
+        return m_State->Result.has_value();
+    }
+
+    struct Awaiter
+    {
+        std::shared_ptr<State> pState;
+
+        bool await_ready() const
+        {
+            std::lock_guard<std::mutex> Lock{pState->Mtx};
+            return pState->Result.has_value();
+        }
+        bool await_suspend(std::coroutine_handle<> Handle) const
+        {
+            std::lock_guard<std::mutex> Lock{pState->Mtx};
+            // The result may have been set after await_ready()
+            if (pState->Result.has_value())
+                return false;
+
+            VERIFY(!pState->Handle, "The result may only be awaited by one coroutine");
+            pState->Handle = Handle;
+            return true;
+        }
+        ResultType await_resume() const
+        {
+            std::lock_guard<std::mutex> Lock{pState->Mtx};
+            return std::move(*pState->Result);
+        }
+    };
+
+    /// Awaits the result. The result is moved out of the shared state, so it may only be awaited once.
+    Awaiter operator co_await() const noexcept
+    {
+        return Awaiter{m_State};
+    }
+
+private:
+    std::shared_ptr<State> m_State;
+};
+
+} // namespace Diligent
+
+#endif // DILIGENT_COROUTINES_SUPPORTED
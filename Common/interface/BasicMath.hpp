@@ -54,6 +54,10 @@
 
 #include "HashUtils.hpp"
 
+#if DILIGENT_USE_SIMD_MATH
+#    include "BasicMathSIMD.hpp"
+#endif
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4201) // nonstandard extension used: nameless struct/union
@@ -1989,6 +1993,45 @@ using double4x4 = Matrix4x4<double>;
 using double3x3 = Matrix3x3<double>;
 using double2x2 = Matrix2x2<double>;
 
+#if DILIGENT_USE_SIMD_MATH && DILIGENT_SIMD_MATH
+
+// SIMD specializations of float4x4 operations, see BasicMathSIMD.hpp.
+// The results are bit-exact with the scalar versions.
+
+template <>
+inline float4 float4::operator*(const float4x4& m) const
+{
+    float4 out;
+    SIMD::Vector4MulMatrix4x4(Data(), m.Data(), out.Data());
+    return out;
+}
+
+template <>
+inline float4x4 float4x4::Mul(const float4x4& m1, const float4x4& m2)
+{
+    float4x4 mOut;
+    SIMD::Matrix4x4Mul(m1.Data(), m2.Data(), mOut.Data());
+    return mOut;
+}
+
+template <>
+inline float4x4 float4x4::Transpose() const
+{
+    float4x4 mOut;
+    SIMD::Matrix4x4Transpose(Data(), mOut.Data());
+    return mOut;
+}
+
+template <>
+inline float4x4 float4x4::Inverse() const
+{
+    float4x4 mOut;
+    SIMD::Matrix4x4Inverse(Data(), mOut.Data());
+    return mOut;
+}
+
+#endif
+
 
 struct Quaternion
 {
@@ -2070,6 +2113,14 @@ struct Quaternion
         return out;
     }
 
+#if DILIGENT_USE_SIMD_MATH && DILIGENT_SIMD_MATH
+    static Quaternion Mul(const Quaternion& q1, const Quaternion& q2)
+    {
+        Quaternion q1_q2;
+        SIMD::QuaternionMul(q1.q.Data(), q2.q.Data(), q1_q2.q.Data());
+        return q1_q2;
+    }
+#else
     constexpr static Quaternion Mul(const Quaternion& q1, const Quaternion& q2)
     {
         Quaternion q1_q2;
@@ -2079,6 +2130,7 @@ struct Quaternion
         q1_q2.q.w = -q1.q.x * q2.q.x - q1.q.y * q2.q.y - q1.q.z * q2.q.z + q1.q.w * q2.q.w;
         return q1_q2;
     }
+#endif
 
     Quaternion& operator=(const Quaternion& rhs)
     {
@@ -2099,7 +2151,11 @@ struct Quaternion
     }
 };
 
+#if DILIGENT_USE_SIMD_MATH && DILIGENT_SIMD_MATH
+inline Quaternion operator*(const Quaternion& q1, const Quaternion& q2)
+#else
 constexpr inline Quaternion operator*(const Quaternion& q1, const Quaternion& q2)
+#endif
 {
     return Quaternion::Mul(q1, q2);
 }
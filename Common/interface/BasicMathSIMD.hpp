@@ -0,0 +1,270 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// SIMD implementations of the BasicMath float4/float4x4/Quaternion operations.
+///
+/// The functions produce bit-exact results compared to the scalar implementations in BasicMath.hpp:
+/// every lane performs the same sequence of IEEE operations as the corresponding scalar expression.
+/// This only holds when the compiler does not contract multiplications and additions into FMA
+/// instructions, which is the default for x86/x64 targets without FMA support (use -ffp-contract=off
+/// otherwise).
+///
+/// The functions are available when the target supports SSE2 or NEON (DILIGENT_SIMD_MATH is 1).
+/// BasicMath.hpp uses them for float4x4 and Quaternion operations when DILIGENT_USE_SIMD_MATH
+/// is defined to 1 (see DILIGENT_USE_SIMD_MATH CMake option).
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_SIMD_MATH_SSE 1
+#    include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define DILIGENT_SIMD_MATH_NEON 1
+#    include <arm_neon.h>
+#endif
+
+#if defined(DILIGENT_SIMD_MATH_SSE) || defined(DILIGENT_SIMD_MATH_NEON)
+#    define DILIGENT_SIMD_MATH 1
+#else
+#    define DILIGENT_SIMD_MATH 0
+#endif
+
+#if DILIGENT_SIMD_MATH
+
+namespace Diligent
+{
+
+namespace SIMD
+{
+
+#    if DILIGENT_SIMD_MATH_SSE
+
+using Float4 = __m128;
+
+inline Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+inline void   Store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+inline Float4 Zero() { return _mm_setzero_ps(); }
+inline Float4 Splat(float s) { return _mm_set1_ps(s); }
+inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+// Returns {v[X], v[Y], v[Z], v[W]}
+template <int X, int Y, int Z, int W>
+inline Float4 Shuffle(Float4 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+// Flips the sign of the lanes whose template argument is non-zero
+template <int X, int Y, int Z, int W>
+inline Float4 FlipSign(Float4 v)
+{
+    return _mm_xor_ps(v, _mm_set_ps(W ? -0.f : 0.f, Z ? -0.f : 0.f, Y ? -0.f : 0.f, X ? -0.f : 0.f));
+}
+
+inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+{
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+// Returns the 4-bit mask of the lanes where a < b
+inline int LessMask(Float4 a, Float4 b)
+{
+    return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+}
+
+#    elif DILIGENT_SIMD_MATH_NEON
+
+using Float4 = float32x4_t;
+
+inline Float4 Load(const float* p) { return vld1q_f32(p); }
+inline void   Store(float* p, Float4 v) { vst1q_f32(p, v); }
+inline Float4 Zero() { return vdupq_n_f32(0.f); }
+inline Float4 Splat(float s) { return vdupq_n_f32(s); }
+inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+// Returns {v[X], v[Y], v[Z], v[W]}
+template <int X, int Y, int Z, int W>
+inline Float4 Shuffle(Float4 v)
+{
+    Float4 r = vdupq_n_f32(vgetq_lane_f32(v, X));
+    r        = vsetq_lane_f32(vgetq_lane_f32(v, Y), r, 1);
+    r        = vsetq_lane_f32(vgetq_lane_f32(v, Z), r, 2);
+    r        = vsetq_lane_f32(vgetq_lane_f32(v, W), r, 3);
+    return r;
+}
+
+// Flips the sign of the lanes whose template argument is non-zero
+template <int X, int Y, int Z, int W>
+inline Float4 FlipSign(Float4 v)
+{
+    const uint32_t Mask[] = {X ? 0x80000000u : 0u, Y ? 0x80000000u : 0u, Z ? 0x80000000u : 0u, W ? 0x80000000u : 0u};
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vld1q_u32(Mask)));
+}
+
+inline void Transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+    const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+// Returns the 4-bit mask of the lanes where a < b
+inline int LessMask(Float4 a, Float4 b)
+{
+    const uint32x4_t c = vcltq_f32(a, b);
+    return static_cast<int>((vgetq_lane_u32(c, 0) & 1u) | (vgetq_lane_u32(c, 1) & 2u) | (vgetq_lane_u32(c, 2) & 4u) | (vgetq_lane_u32(c, 3) & 8u));
+}
+
+#    endif
+
+template <int Lane>
+inline Float4 SplatLane(Float4 v)
+{
+    return Shuffle<Lane, Lane, Lane, Lane>(v);
+}
+
+/// Computes Out = v * M, where M is a row-major 4x4 matrix.
+inline void Vector4MulMatrix4x4(const float* v, const float* M, float* Out)
+{
+    Float4 r = Mul(Splat(v[0]), Load(M + 0));
+    r        = Add(r, Mul(Splat(v[1]), Load(M + 4)));
+    r        = Add(r, Mul(Splat(v[2]), Load(M + 8)));
+    r        = Add(r, Mul(Splat(v[3]), Load(M + 12)));
+    Store(Out, r);
+}
+
+/// Computes Out = M1 * M2, where all matrices are row-major 4x4 matrices.
+/// Out may alias M1 or M2.
+inline void Matrix4x4Mul(const float* M1, const float* M2, float* Out)
+{
+    const Float4 Row0 = Load(M2 + 0);
+    const Float4 Row1 = Load(M2 + 4);
+    const Float4 Row2 = Load(M2 + 8);
+    const Float4 Row3 = Load(M2 + 12);
+
+    Float4 r[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        const Float4 a = Load(M1 + i * 4);
+        // Start with zero to match the scalar accumulation
+        r[i] = Add(Zero(), Mul(SplatLane<0>(a), Row0));
+        r[i] = Add(r[i], Mul(SplatLane<1>(a), Row1));
+        r[i] = Add(r[i], Mul(SplatLane<2>(a), Row2));
+        r[i] = Add(r[i], Mul(SplatLane<3>(a), Row3));
+    }
+    for (int i = 0; i < 4; ++i)
+        Store(Out + i * 4, r[i]);
+}
+
+/// Transposes the row-major 4x4 matrix M. Out may alias M.
+inline void Matrix4x4Transpose(const float* M, float* Out)
+{
+    Float4 r0 = Load(M + 0);
+    Float4 r1 = Load(M + 4);
+    Float4 r2 = Load(M + 8);
+    Float4 r3 = Load(M + 12);
+    Transpose(r0, r1, r2, r3);
+    Store(Out + 0, r0);
+    Store(Out + 4, r1);
+    Store(Out + 8, r2);
+    Store(Out + 12, r3);
+}
+
+// Computes the four cofactors of one row of the 4x4 matrix whose rows A, B and C
+// are the remaining rows, lane i corresponding to the minor without column i.
+inline Float4 Cofactors3x3(Float4 A, Float4 B, Float4 C)
+{
+    // Minor columns for every lane: {1,2,3}, {0,2,3}, {0,1,3}, {0,1,2}
+    const Float4 a0 = Shuffle<1, 0, 0, 0>(A);
+    const Float4 a1 = Shuffle<2, 2, 1, 1>(A);
+    const Float4 a2 = Shuffle<3, 3, 3, 2>(A);
+    const Float4 b0 = Shuffle<1, 0, 0, 0>(B);
+    const Float4 b1 = Shuffle<2, 2, 1, 1>(B);
+    const Float4 b2 = Shuffle<3, 3, 3, 2>(B);
+    const Float4 c0 = Shuffle<1, 0, 0, 0>(C);
+    const Float4 c1 = Shuffle<2, 2, 1, 1>(C);
+    const Float4 c2 = Shuffle<3, 3, 3, 2>(C);
+
+    // Same operation order as Matrix3x3::Determinant()
+    Float4 det = Add(Zero(), Mul(a0, Sub(Mul(b1, c2), Mul(c1, b2))));
+    det        = Sub(det, Mul(a1, Sub(Mul(b0, c2), Mul(c0, b2))));
+    det        = Add(det, Mul(a2, Sub(Mul(b0, c1), Mul(c0, b1))));
+    return det;
+}
+
+/// Computes the inverse of the row-major 4x4 matrix M. Out may alias M.
+inline void Matrix4x4Inverse(const float* M, float* Out)
+{
+    const Float4 Row0 = Load(M + 0);
+    const Float4 Row1 = Load(M + 4);
+    const Float4 Row2 = Load(M + 8);
+    const Float4 Row3 = Load(M + 12);
+
+    Float4 inv0 = FlipSign<0, 1, 0, 1>(Cofactors3x3(Row1, Row2, Row3));
+    Float4 inv1 = FlipSign<1, 0, 1, 0>(Cofactors3x3(Row0, Row2, Row3));
+    Float4 inv2 = FlipSign<0, 1, 0, 1>(Cofactors3x3(Row0, Row1, Row3));
+    Float4 inv3 = FlipSign<1, 0, 1, 0>(Cofactors3x3(Row0, Row1, Row2));
+
+    float Cof0[4];
+    Store(Cof0, inv0);
+    const float det = M[0] * Cof0[0] + M[1] * Cof0[1] + M[2] * Cof0[2] + M[3] * Cof0[3];
+
+    Transpose(inv0, inv1, inv2, inv3);
+
+    const Float4 s = Splat(1.f / det);
+    Store(Out + 0, Mul(inv0, s));
+    Store(Out + 4, Mul(inv1, s));
+    Store(Out + 8, Mul(inv2, s));
+    Store(Out + 12, Mul(inv3, s));
+}
+
+/// Computes the product of quaternions q1 and q2 stored as {x, y, z, w}.
+inline void QuaternionMul(const float* q1, const float* q2, float* Out)
+{
+    const Float4 b = Load(q2);
+
+    Float4 r = FlipSign<0, 1, 0, 1>(Mul(Splat(q1[0]), Shuffle<3, 2, 1, 0>(b)));
+    r        = Add(r, FlipSign<0, 0, 1, 1>(Mul(Splat(q1[1]), Shuffle<2, 3, 0, 1>(b))));
+    r        = Add(r, FlipSign<1, 0, 0, 1>(Mul(Splat(q1[2]), Shuffle<1, 0, 3, 2>(b))));
+    r        = Add(r, Mul(Splat(q1[3]), b));
+    Store(Out, r);
+}
+
+} // namespace SIMD
+
+} // namespace Diligent
+
+#endif
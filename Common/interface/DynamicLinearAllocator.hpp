@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <cstring>
+#include <algorithm>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -72,16 +73,69 @@ public:
             m_pAllocator->Free(block.Data);
         }
         m_Blocks.clear();
+        m_CurrBlock    = 0;
+        m_UsedSize     = 0;
+        m_ReservedSize = 0;
 
         m_pAllocator = nullptr;
     }
 
+    /// Releases all allocations, but keeps the memory pages for reuse.
     void Discard()
     {
-        for (auto& block : m_Blocks)
+        for (size_t i = 0; i <= m_CurrBlock && i < m_Blocks.size(); ++i)
+        {
+            m_Blocks[i].CurrPtr = m_Blocks[i].Data;
+        }
+        m_CurrBlock = 0;
+        m_UsedSize  = 0;
+    }
+
+    /// Allocation state that can be restored with Rollback().
+    struct Marker
+    {
+        size_t BlockIdx = 0;
+        size_t Offset   = 0;
+        size_t UsedSize = 0;
+    };
+
+    /// Returns the current allocation state.
+    Marker GetMarker() const
+    {
+        Marker M;
+        if (!m_Blocks.empty())
+        {
+            const auto& block = m_Blocks[m_CurrBlock];
+
+            M.BlockIdx = m_CurrBlock;
+            M.Offset   = static_cast<size_t>(block.CurrPtr - block.Data);
+            M.UsedSize = m_UsedSize;
+        }
+        return M;
+    }
+
+    /// Releases all allocations made after the marker was obtained.
+    /// The memory pages are kept for reuse.
+    void Rollback(const Marker& M)
+    {
+        if (m_Blocks.empty())
+        {
+            VERIFY(M.BlockIdx == 0 && M.Offset == 0, "The marker does not belong to this allocator");
+            return;
+        }
+
+        VERIFY(M.BlockIdx <= m_CurrBlock, "The marker is newer than the current allocation state");
+        for (size_t i = M.BlockIdx + 1; i <= m_CurrBlock; ++i)
         {
-            block.CurrPtr = block.Data;
+            m_Blocks[i].CurrPtr = m_Blocks[i].Data;
         }
+
+        auto& block = m_Blocks[M.BlockIdx];
+        VERIFY(block.Data + M.Offset <= block.CurrPtr, "The marker is newer than the current allocation state");
+        block.CurrPtr = block.Data + M.Offset;
+
+        m_CurrBlock = M.BlockIdx;
+        m_UsedSize  = M.UsedSize;
     }
 
     NODISCARD void* Allocate(size_t size, size_t align)
@@ -89,12 +143,19 @@ public:
         if (size == 0)
             return nullptr;
 
-        for (auto& block : m_Blocks)
+        // Only the current block is checked. The blocks after the current one are empty
+        // after Discard() or Rollback() and are reused before a new block is created.
+        // The space left at the end of the previous blocks is not reused, which keeps the
+        // allocation O(1) and the allocation order consistent with the markers.
+        for (; m_CurrBlock < m_Blocks.size(); ++m_CurrBlock)
         {
-            auto* Ptr = AlignUp(block.CurrPtr, align);
+            auto& block = m_Blocks[m_CurrBlock];
+            auto* Ptr   = AlignUp(block.CurrPtr, align);
             if (Ptr + size <= block.Data + block.Size)
             {
-                block.CurrPtr = Ptr + size;
+                m_UsedSize += static_cast<size_t>(Ptr + size - block.CurrPtr);
+                m_PeakUsedSize = std::max(m_PeakUsedSize, m_UsedSize);
+                block.CurrPtr  = Ptr + size;
                 return Ptr;
             }
         }
@@ -104,11 +165,17 @@ public:
         while (BlockSize < size + align - 1)
             BlockSize *= 2;
         m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize);
+        m_CurrBlock = m_Blocks.size() - 1;
+        m_ReservedSize += BlockSize;
 
         auto& block = m_Blocks.back();
         auto* Ptr   = AlignUp(block.Data, align);
         VERIFY(Ptr + size <= block.Data + block.Size, "Not enough space in the new block - this is a bug");
         block.CurrPtr = Ptr + size;
+
+        m_UsedSize += static_cast<size_t>(Ptr + size - block.Data);
+        m_PeakUsedSize = std::max(m_PeakUsedSize, m_UsedSize);
+
         return Ptr;
     }
 
@@ -198,6 +265,30 @@ public:
         return m_Blocks.size();
     }
 
+    /// Returns the number of bytes allocated since the last Discard(), including the alignment padding.
+    size_t GetUsedSize() const
+    {
+        return m_UsedSize;
+    }
+
+    /// Returns the maximum value of GetUsedSize() since the allocator was created or
+    /// since the last call to ResetPeakUsedSize().
+    size_t GetPeakUsedSize() const
+    {
+        return m_PeakUsedSize;
+    }
+
+    void ResetPeakUsedSize()
+    {
+        m_PeakUsedSize = m_UsedSize;
+    }
+
+    /// Returns the total size of all memory pages.
+    size_t GetReservedSize() const
+    {
+        return m_ReservedSize;
+    }
+
     template <typename HandlerType>
     void ProcessBlocks(HandlerType&& Handler) const
     {
@@ -217,8 +308,62 @@ private:
     };
 
     std::vector<Block> m_Blocks;
-    const Uint32       m_BlockSize  = 4 << 10;
-    IMemoryAllocator*  m_pAllocator = nullptr;
+    size_t             m_CurrBlock    = 0;
+    size_t             m_UsedSize     = 0;
+    size_t             m_PeakUsedSize = 0;
+    size_t             m_ReservedSize = 0;
+    const Uint32       m_BlockSize    = 4 << 10;
+    IMemoryAllocator*  m_pAllocator   = nullptr;
+};
+
+
+/// Returns the linear allocator of the calling thread.
+
+/// \remarks    The allocator uses the default raw memory allocator and keeps its memory
+///             pages for the lifetime of the thread, so that temporary allocations do not
+///             allocate memory from the heap once the pages have been created.
+///             Use DynamicLinearAllocatorScope to release the allocations.
+DynamicLinearAllocator& GetThreadLocalLinearAllocator();
+
+
+/// Releases all allocations made from the allocator within the scope when the scope ends.
+
+/// \remarks    Scopes may be nested, but must be released in the reverse order.
+///             All allocations made from the allocator after the scope started are
+///             released, so the memory must not be used after the scope ends.
+class DynamicLinearAllocatorScope
+{
+public:
+    explicit DynamicLinearAllocatorScope(DynamicLinearAllocator& Allocator) :
+        m_Allocator{Allocator},
+        m_Marker{Allocator.GetMarker()}
+    {}
+
+    /// Creates the scope for the thread-local allocator.
+    DynamicLinearAllocatorScope() :
+        DynamicLinearAllocatorScope{GetThreadLocalLinearAllocator()}
+    {}
+
+    // clang-format off
+    DynamicLinearAllocatorScope           (const DynamicLinearAllocatorScope&) = delete;
+    DynamicLinearAllocatorScope           (DynamicLinearAllocatorScope&&)      = delete;
+    DynamicLinearAllocatorScope& operator=(const DynamicLinearAllocatorScope&) = delete;
+    DynamicLinearAllocatorScope& operator=(DynamicLinearAllocatorScope&&)      = delete;
+    // clang-format on
+
+    ~DynamicLinearAllocatorScope()
+    {
+        m_Allocator.Rollback(m_Marker);
+    }
+
+    DynamicLinearAllocator& GetAllocator() const
+    {
+        return m_Allocator;
+    }
+
+private:
+    DynamicLinearAllocator&              m_Allocator;
+    const DynamicLinearAllocator::Marker m_Marker;
 };
 
 } // namespace Diligent
@@ -36,6 +36,7 @@
 #include <vector>
 #include <cstring>
 #include <memory>
+#include <atomic>
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "STDAllocator.hpp"
@@ -53,10 +54,16 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 #endif
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// When ThreadCacheSize is not zero, every thread keeps a small cache of free blocks
+/// (two magazines of up to ThreadCacheSize blocks each) for this allocator. Allocate and
+/// Free are served from the cache without taking the mutex; full and empty magazines are
+/// exchanged in batches with the allocator's global depot. Blocks held by the caches are
+/// not returned to the pages until the thread exits.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, Uint32 ThreadCacheSize = 0);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -75,6 +82,38 @@ private:
 
     void CreateNewPage();
 
+    // Allocates/frees a block from the pages. m_Mutex must be locked.
+    void* AllocateBlock();
+    void  FreeBlock(void* Ptr);
+
+    // Singly-linked list of free blocks threaded through the blocks themselves
+    struct Magazine
+    {
+        void*  pHead     = nullptr;
+        Uint32 NumBlocks = 0;
+
+        void Push(void* Ptr)
+        {
+            *reinterpret_cast<void**>(Ptr) = pHead;
+            pHead                          = Ptr;
+            ++NumBlocks;
+        }
+
+        void* Pop()
+        {
+            VERIFY_EXPR(NumBlocks > 0);
+            void* Ptr = pHead;
+            pHead     = *reinterpret_cast<void**>(Ptr);
+            --NumBlocks;
+            return Ptr;
+        }
+    };
+
+    class ThreadCache;
+
+    Magazine AcquireMagazine();
+    void     ReleaseMagazine(Magazine& Mag);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -227,11 +266,23 @@ private:
     using AddrToPageIdMapElem = std::pair<void* const, size_t>;
     std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
 
+    // Full magazines returned by the thread caches
+    std::vector<Magazine, STDAllocatorRawMem<Magazine>> m_Depot;
+
     std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_ThreadCacheSize;
+
+    // Unique allocator id that identifies the allocator in the thread caches
+    const Uint64 m_Id;
+
+#ifdef DILIGENT_DEBUG
+    // Number of blocks handed out through the thread caches
+    std::atomic<Int64> m_dbgNumCachedAllocations{0};
+#endif
 };
 
 IMemoryAllocator& GetRawAllocator();
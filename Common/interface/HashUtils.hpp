@@ -137,7 +137,17 @@ std::size_t ComputeHash(const FirstArgType& FirstArg, const RestArgsType&... Res
     return Seed;
 }
 
-inline std::size_t ComputeHashRaw(const void* pData, size_t Size) noexcept
+/// Computes the hash of the raw data using the XXH3 algorithm.
+
+/// \remarks    The function is implemented in Diligent-Common using the xxHash library
+///             that processes the data with SIMD instructions when available.
+std::size_t ComputeHashRawXXH3(const void* pData, size_t Size) noexcept;
+
+/// Inputs of at least this size are hashed by ComputeHashRaw() with ComputeHashRawXXH3().
+constexpr size_t ComputeHashRawXXH3Threshold = 64;
+
+/// Computes the hash of the raw data by combining it dword by dword with HashCombine().
+inline std::size_t ComputeHashRawCombine(const void* pData, size_t Size) noexcept
 {
     size_t Hash = 0;
 
@@ -182,6 +192,17 @@ inline std::size_t ComputeHashRaw(const void* pData, size_t Size) noexcept
     return Hash;
 }
 
+/// Computes the hash of the raw data.
+
+/// \remarks    Small inputs are hashed inline with ComputeHashRawCombine(), while large inputs
+///             are hashed with ComputeHashRawXXH3(). The hash does not depend on the data alignment.
+inline std::size_t ComputeHashRaw(const void* pData, size_t Size) noexcept
+{
+    return Size >= ComputeHashRawXXH3Threshold ?
+        ComputeHashRawXXH3(pData, Size) :
+        ComputeHashRawCombine(pData, Size);
+}
+
 template <typename CharType>
 struct CStringHash
 {
@@ -976,6 +997,7 @@ struct HashCombiner<HasherType, GraphicsPipelineDesc> : HashCombinerBase<HasherT
         ASSERT_SIZEOF(Desc.NumRenderTargets, 1, "Hash logic below may be incorrect.");
         ASSERT_SIZEOF(Desc.SubpassIndex, 1, "Hash logic below may be incorrect.");
         ASSERT_SIZEOF(Desc.ShadingRateFlags, 1, "Hash logic below may be incorrect.");
+        ASSERT_SIZEOF(Desc.DynamicStateFlags, 1, "Hash logic below may be incorrect.");
 
         this->m_Hasher(
             Desc.BlendDesc,
@@ -993,7 +1015,8 @@ struct HashCombiner<HasherType, GraphicsPipelineDesc> : HashCombinerBase<HasherT
         for (size_t i = 0; i < Desc.NumRenderTargets; ++i)
             this->m_Hasher(Desc.RTVFormats[i]);
 
-        this->m_Hasher(Desc.DSVFormat,
+        this->m_Hasher(Desc.DynamicStateFlags,
+                       Desc.DSVFormat,
                        Desc.SmplDesc,
                        Desc.NodeMask);
 
@@ -1317,6 +1340,47 @@ struct StdHasher
     }
 };
 
+/// Immutable value with a precomputed hash.
+
+/// \remarks    Hashing large descriptions such as GraphicsPipelineDesc or RenderPassDesc
+///             requires visiting every member. HashedValue computes the hash once when the
+///             value is constructed, so that hash map lookups with the same key do not
+///             recompute it, and the comparison only compares the values when the hashes match.
+///
+///             HasherType must be able to hash Type. For example, the wrappers from GraphicsTypesX.hpp
+///             may be used with the hasher of the wrapped description:
+///
+///                 HashedValue<RenderPassDescX, std::hash<RenderPassDesc>> Key{RPDescX};
+template <typename Type, typename HasherType = std::hash<Type>>
+class HashedValue
+{
+public:
+    explicit HashedValue(Type Val) :
+        m_Value{std::move(Val)},
+        m_Hash{HasherType{}(m_Value)}
+    {}
+
+    const Type& Get() const noexcept { return m_Value; }
+
+    operator const Type&() const noexcept { return m_Value; }
+
+    size_t GetHash() const noexcept { return m_Hash; }
+
+    bool operator==(const HashedValue& RHS) const
+    {
+        return m_Hash == RHS.m_Hash && m_Value == RHS.m_Value;
+    }
+
+    bool operator!=(const HashedValue& RHS) const
+    {
+        return !(*this == RHS);
+    }
+
+private:
+    Type   m_Value;
+    size_t m_Hash;
+};
+
 } // namespace Diligent
 
 
@@ -1378,4 +1442,13 @@ DEFINE_HASH(Diligent::TilePipelineStateCreateInfo);
 
 #undef DEFINE_HASH
 
+template <typename Type, typename HasherType>
+struct hash<Diligent::HashedValue<Type, HasherType>>
+{
+    size_t operator()(const Diligent::HashedValue<Type, HasherType>& Val) const noexcept
+    {
+        return Val.GetHash();
+    }
+};
+
 } // namespace std
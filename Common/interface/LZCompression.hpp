@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Fast LZ77-family byte stream compression.
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Returns the maximum size of the compressed data for the source data of the given size.
+size_t GetLZCompressedSizeBound(size_t SrcSize);
+
+/// Compresses the data using a fast LZ77-family codec
+
+/// \param[in]  pSrc    - A pointer to the source data.
+/// \param[in]  SrcSize - Source data size, in bytes.
+/// \param[out] pDst    - A pointer to the destination buffer.
+/// \param[in]  DstSize - Destination buffer size, in bytes.
+///
+/// \return     The size of the compressed data, or 0 if the destination
+///             buffer is too small to hold it.
+///
+/// \remarks    The codec favors speed over compression ratio.
+///             The compressed stream does not store the source data size, and the application
+///             is responsible for storing it along with the compressed data.
+///             To guarantee that compression succeeds, the destination buffer
+///             must be at least GetLZCompressedSizeBound(SrcSize) bytes large.
+size_t LZCompress(const void* pSrc,
+                  size_t      SrcSize,
+                  void*       pDst,
+                  size_t      DstSize);
+
+/// Decompresses the data compressed by LZCompress()
+
+/// \param[in]  pSrc    - A pointer to the compressed data.
+/// \param[in]  SrcSize - Compressed data size, in bytes.
+/// \param[out] pDst    - A pointer to the destination buffer.
+/// \param[in]  DstSize - Decompressed data size, in bytes.
+///
+/// \return     true if the data was decompressed successfully and its size is exactly DstSize,
+///             and false otherwise.
+///
+/// \remarks    The function validates the compressed stream and never reads or writes
+///             outside of the source and destination buffers.
+bool LZDecompress(const void* pSrc,
+                  size_t      SrcSize,
+                  void*       pDst,
+                  size_t      DstSize);
+
+} // namespace Diligent
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Implementation of the file stream backed by a memory-mapped file and asynchronous file reading
+
+#include <string>
+#include <utility>
+
+#include "../../Primitives/interface/FileStream.h"
+#include "MappedFileDataBlob.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+// {5C1E7A3B-2D4F-4B8E-9A61-0F3D8C2B7E94}
+static const INTERFACE_ID IID_MappedFileStream =
+    {0x5c1e7a3b, 0x2d4f, 0x4b8e, {0x9a, 0x61, 0xf, 0x3d, 0x8c, 0x2b, 0x7e, 0x94}};
+
+/// Read-only file stream backed by a memory-mapped file.
+
+/// Read() and ReadBlob() copy the data from the mapping. GetDataBlob() returns the
+/// mapped file contents as a data blob without copying. Consumers that know about this
+/// class can query IID_MappedFileStream to use the blob directly.
+class MappedFileStream final : public ObjectBase<IFileStream>
+{
+public:
+    typedef ObjectBase<IFileStream> TBase;
+
+    /// Maps the file and creates the stream. Returns null if the file can't be mapped.
+    static RefCntAutoPtr<MappedFileStream> Create(const char* Path);
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
+
+    /// Reads data from the stream
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override;
+
+    /// Reads the remaining data from the stream into the data blob
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override;
+
+    /// Memory-mapped file stream is read-only, so this method always fails.
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override;
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override;
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override;
+
+    /// Returns the data blob that references the whole mapped file.
+
+    /// \warning    The memory is mapped as read-only and must not be modified.
+    IDataBlob* GetDataBlob() { return m_pData; }
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    MappedFileStream(IReferenceCounters* pRefCounters, MappedFileDataBlob* pData);
+
+private:
+    RefCntAutoPtr<MappedFileDataBlob> m_pData;
+    size_t                            m_CurrentOffset = 0;
+};
+
+
+/// Touches every page of the memory-mapped data so that it is loaded from disk.
+void PrefetchMappedData(const IDataBlob* pData);
+
+/// Reads a file asynchronously.
+
+/// \param [in] Path        - Path to the file.
+/// \param [in] pThreadPool - Thread pool that performs the read. If null, the file is read
+///                           synchronously and the function returns null.
+/// \param [in] Callback    - Function that is called as Callback(IDataBlob* pData) when the read is complete.
+///                           pData is null if the file can't be read.
+/// \param [in] fPriority   - Task priority.
+///
+/// \return     The task that reads the file.
+///
+/// \remarks    The file is memory-mapped and all its pages are loaded in the worker thread,
+///             so that the data blob passed to the callback can be accessed without blocking
+///             on disk. The blob can e.g. be passed to IDearchiver::LoadArchive() with MakeCopy set
+///             to false.
+///
+///             The callback is executed by the worker thread.
+template <typename CallbackType>
+RefCntAutoPtr<IAsyncTask> ReadFileAsync(const char*  Path,
+                                        IThreadPool* pThreadPool,
+                                        CallbackType Callback,
+                                        float        fPriority = 0)
+{
+    auto ReadFile = [FilePath = std::string{Path != nullptr ? Path : ""}, Callback = std::move(Callback)]() mutable {
+        RefCntAutoPtr<MappedFileDataBlob> pData = MappedFileDataBlob::Create(FilePath.c_str());
+        if (pData)
+            PrefetchMappedData(pData);
+        Callback(static_cast<IDataBlob*>(pData.RawPtr()));
+    };
+
+    if (pThreadPool == nullptr)
+    {
+        ReadFile();
+        return {};
+    }
+
+    return EnqueueAsyncWork(
+        pThreadPool,
+        [ReadFile = std::move(ReadFile)](Uint32 ThreadId) mutable {
+            ReadFile();
+        },
+        fPriority);
+}
+
+} // namespace Diligent
@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::MetricsRegistry class and related classes
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Lock-free accumulator of metric values, e.g. durations in nanoseconds.
+
+/// The accumulator keeps the total count, sum and maximum of all values, the count and sum
+/// of the values added since the last EndFrame() call, and a histogram of values with
+/// power-of-two buckets. All methods are thread-safe.
+class MetricAccumulator
+{
+public:
+    /// The number of histogram buckets.
+
+    /// Bucket i counts values in the range [2^i, 2^(i+1)). Bucket 0 also counts zero values,
+    /// and the last bucket counts all values that are greater.
+    static constexpr Uint32 NumHistogramBuckets = 32;
+
+    struct Snapshot
+    {
+        Uint64 Count          = 0;
+        Uint64 Total          = 0;
+        Uint64 Max            = 0;
+        Uint64 LastFrameCount = 0;
+        Uint64 LastFrameTotal = 0;
+
+        std::array<Uint64, NumHistogramBuckets> Histogram = {};
+    };
+
+    void Add(Uint64 Value) noexcept
+    {
+        m_Count.fetch_add(1, std::memory_order_relaxed);
+        m_Total.fetch_add(Value, std::memory_order_relaxed);
+        m_FrameCount.fetch_add(1, std::memory_order_relaxed);
+        m_FrameTotal.fetch_add(Value, std::memory_order_relaxed);
+        m_Histogram[GetHistogramBucket(Value)].fetch_add(1, std::memory_order_relaxed);
+
+        Uint64 Max = m_Max.load(std::memory_order_relaxed);
+        while (Value > Max && !m_Max.compare_exchange_weak(Max, Value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// Moves the values accumulated in the current frame to the last frame values.
+    void EndFrame() noexcept
+    {
+        m_LastFrameCount.store(m_FrameCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        m_LastFrameTotal.store(m_FrameTotal.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    Snapshot GetSnapshot() const noexcept
+    {
+        Snapshot Snap;
+        Snap.Count          = m_Count.load(std::memory_order_relaxed);
+        Snap.Total          = m_Total.load(std::memory_order_relaxed);
+        Snap.Max            = m_Max.load(std::memory_order_relaxed);
+        Snap.LastFrameCount = m_LastFrameCount.load(std::memory_order_relaxed);
+        Snap.LastFrameTotal = m_LastFrameTotal.load(std::memory_order_relaxed);
+        for (Uint32 i = 0; i < NumHistogramBuckets; ++i)
+            Snap.Histogram[i] = m_Histogram[i].load(std::memory_order_relaxed);
+        return Snap;
+    }
+
+    void Reset() noexcept
+    {
+        m_Count.store(0, std::memory_order_relaxed);
+        m_Total.store(0, std::memory_order_relaxed);
+        m_Max.store(0, std::memory_order_relaxed);
+        m_FrameCount.store(0, std::memory_order_relaxed);
+        m_FrameTotal.store(0, std::memory_order_relaxed);
+        m_LastFrameCount.store(0, std::memory_order_relaxed);
+        m_LastFrameTotal.store(0, std::memory_order_relaxed);
+        for (std::atomic<Uint64>& Bucket : m_Histogram)
+            Bucket.store(0, std::memory_order_relaxed);
+    }
+
+    static Uint32 GetHistogramBucket(Uint64 Value) noexcept
+    {
+        return Value > 1 ? std::min(PlatformMisc::GetMSB(Value), NumHistogramBuckets - 1) : 0;
+    }
+
+private:
+    std::atomic<Uint64> m_Count{0};
+    std::atomic<Uint64> m_Total{0};
+    std::atomic<Uint64> m_Max{0};
+    std::atomic<Uint64> m_FrameCount{0};
+    std::atomic<Uint64> m_FrameTotal{0};
+    std::atomic<Uint64> m_LastFrameCount{0};
+    std::atomic<Uint64> m_LastFrameTotal{0};
+
+    std::array<std::atomic<Uint64>, NumHistogramBuckets> m_Histogram{};
+};
+
+
+/// Adds the time in nanoseconds spent in the scope to the metric accumulator.
+
+/// If the accumulator is null, the scope does nothing and does not query the clock,
+/// so that disabled metrics have negligible overhead.
+class MetricTimerScope
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MetricTimerScope(MetricAccumulator* pMetric) noexcept :
+        m_pMetric{pMetric}
+    {
+        if (m_pMetric != nullptr)
+            m_StartTime = Clock::now();
+    }
+
+    ~MetricTimerScope()
+    {
+        if (m_pMetric != nullptr)
+            m_pMetric->Add(static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_StartTime).count()));
+    }
+
+    // clang-format off
+    MetricTimerScope           (const MetricTimerScope&)  = delete;
+    MetricTimerScope           (      MetricTimerScope&&) = delete;
+    MetricTimerScope& operator=(const MetricTimerScope&)  = delete;
+    MetricTimerScope& operator=(      MetricTimerScope&&) = delete;
+    // clang-format on
+
+private:
+    MetricAccumulator* const m_pMetric;
+    Clock::time_point        m_StartTime;
+};
+
+
+/// A fixed set of metric accumulators identified by their indices.
+class MetricsRegistry
+{
+public:
+    explicit MetricsRegistry(Uint32 NumMetrics) :
+        m_NumMetrics{NumMetrics},
+        m_Metrics{new MetricAccumulator[NumMetrics]}
+    {}
+
+    Uint32 GetNumMetrics() const { return m_NumMetrics; }
+
+    MetricAccumulator& Get(Uint32 Index)
+    {
+        VERIFY(Index < m_NumMetrics, "Metric index (", Index, ") is out of range");
+        return m_Metrics[Index];
+    }
+
+    const MetricAccumulator& Get(Uint32 Index) const
+    {
+        VERIFY(Index < m_NumMetrics, "Metric index (", Index, ") is out of range");
+        return m_Metrics[Index];
+    }
+
+    /// Ends the frame for all metrics, see MetricAccumulator::EndFrame().
+    void EndFrame() noexcept
+    {
+        for (Uint32 i = 0; i < m_NumMetrics; ++i)
+            m_Metrics[i].EndFrame();
+    }
+
+    void Reset() noexcept
+    {
+        for (Uint32 i = 0; i < m_NumMetrics; ++i)
+            m_Metrics[i].Reset();
+    }
+
+private:
+    const Uint32                         m_NumMetrics;
+    std::unique_ptr<MetricAccumulator[]> m_Metrics;
+};
+
+} // namespace Diligent
@@ -31,6 +31,8 @@
 
 #include <cstring>
 #include <sstream>
+#include <string>
+#include <type_traits>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
@@ -67,6 +69,70 @@ inline bool IsStatementSeparator(Char Symbol) noexcept
 }
 
 
+// Vectorized scanning functions for contiguous character buffers.
+// Each function returns the position of the first character in [Start, End)
+// that does not belong to the respective class, or End.
+
+/// Skips delimiters (see IsDelimiter).
+const Char* SkipDelimitersFast(const Char* Start, const Char* End) noexcept;
+
+/// Skips all characters except for new line characters and '\0'.
+const Char* SkipToNewLineOrNullFast(const Char* Start, const Char* End) noexcept;
+
+/// Skips all characters except for '*' and '\0'.
+const Char* SkipToAsteriskOrNullFast(const Char* Start, const Char* End) noexcept;
+
+/// Skips identifier characters (letters, digits and underscores).
+const Char* SkipIdentifierCharsFast(const Char* Start, const Char* End) noexcept;
+
+
+/// Whether the iterator points into a contiguous character buffer,
+/// so that the vectorized scanning functions can be used.
+template <typename IteratorType>
+struct IsContiguousCharIterator : std::integral_constant<bool,
+                                                         std::is_same<IteratorType, const Char*>::value ||
+                                                             std::is_same<IteratorType, Char*>::value ||
+                                                             std::is_same<IteratorType, std::string::const_iterator>::value ||
+                                                             std::is_same<IteratorType, std::string::iterator>::value>
+{};
+
+template <typename IteratorType, typename PredicateType>
+IteratorType SkipWhile(const IteratorType& Start, const IteratorType& End, const Char* (*)(const Char*, const Char*), PredicateType Predicate, std::false_type) noexcept
+{
+    auto Pos = Start;
+    while (Pos != End && Predicate(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+template <typename IteratorType, typename PredicateType>
+IteratorType SkipWhile(const IteratorType& Start, const IteratorType& End, const Char* (*SkipFast)(const Char*, const Char*), PredicateType, std::true_type) noexcept
+{
+    if (Start == End)
+        return Start;
+
+    const Char* pStart = &*Start;
+    return Start + (SkipFast(pStart, pStart + (End - Start)) - pStart);
+}
+
+/// Skips all characters that satisfy the predicate starting from the given position.
+
+/// \param[in] Start     - starting position.
+/// \param[in] End       - end of the input string.
+/// \param[in] SkipFast  - vectorized function that skips the same characters in a contiguous buffer.
+/// \param[in] Predicate - predicate that returns true for the characters to skip.
+///
+/// \return    position of the first character that does not satisfy the predicate.
+///
+/// \remarks   SkipFast is used when the iterators point into a contiguous character buffer,
+///            and Predicate is used otherwise.
+template <typename IteratorType, typename PredicateType>
+IteratorType SkipWhile(const IteratorType& Start, const IteratorType& End, const Char* (*SkipFast)(const Char*, const Char*), PredicateType Predicate) noexcept
+{
+    return SkipWhile(Start, End, SkipFast, Predicate, IsContiguousCharIterator<IteratorType>{});
+}
+
+
 /// Skips all characters until the end of the line.
 
 /// \param[inout] Pos          - starting position.
@@ -82,9 +148,7 @@ inline bool IsStatementSeparator(Char Symbol) noexcept
 template <typename InteratorType>
 InteratorType SkipLine(const InteratorType& Start, const InteratorType& End, bool GoToNextLine = false) noexcept
 {
-    auto Pos = Start;
-    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
-        ++Pos;
+    auto Pos = SkipWhile(Start, End, SkipToNewLineOrNullFast, [](Char c) { return c != '\0' && !IsNewLine(c); });
     if (GoToNextLine && Pos != End && IsNewLine(*Pos))
     {
         ++Pos;
@@ -149,31 +213,29 @@ InteratorType SkipComment(const InteratorType& Start, const InteratorType& End)
         ++Pos;
         //  /* Comment
         //    ^
-        while (Pos != End && *Pos != '\0')
+        while (true)
         {
-            if (*Pos == '*')
-            {
-                //  /* Comment */
-                //             ^
-                //             Pos
-                ++Pos;
+            Pos = SkipWhile(Pos, End, SkipToAsteriskOrNullFast, [](Char c) { return c != '*' && c != '\0'; });
+            if (Pos == End || *Pos == '\0')
+                break;
 
-                if (Pos != End && *Pos == '/')
-                {
-                    //  /* Comment */
-                    //              ^
-                    //              Pos
+            //  /* Comment */
+            //             ^
+            //             Pos
+            VERIFY_EXPR(*Pos == '*');
+            ++Pos;
 
-                    ++Pos;
-                    //  /* Comment */
-                    //               ^
-                    //              Pos
-                    return Pos;
-                }
-            }
-            else
+            if (Pos != End && *Pos == '/')
             {
+                //  /* Comment */
+                //              ^
+                //              Pos
+
                 ++Pos;
+                //  /* Comment */
+                //               ^
+                //              Pos
+                return Pos;
             }
         }
 
@@ -192,10 +254,7 @@ InteratorType SkipComment(const InteratorType& Start, const InteratorType& End)
 template <typename InteratorType>
 InteratorType SkipDelimiters(const InteratorType& Start, const InteratorType& End) noexcept
 {
-    auto Pos = Start;
-    while (Pos != End && IsDelimiter(*Pos))
-        ++Pos;
-    return Pos;
+    return SkipWhile(Start, End, SkipDelimitersFast, IsDelimiter);
 }
 
 
@@ -246,10 +305,7 @@ IteratorType SkipIdentifier(const IteratorType& Start, const IteratorType& End)
     else
         return Pos;
 
-    while (Pos != End && (isalnum(*Pos) || *Pos == '_'))
-        ++Pos;
-
-    return Pos;
+    return SkipWhile(Pos, End, SkipIdentifierCharsFast, [](Char c) { return isalnum(c) || c == '_'; });
 }
 
 
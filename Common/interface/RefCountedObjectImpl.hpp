@@ -158,50 +158,46 @@ public:
         if (m_ObjectState.load() != ObjectState::Alive)
             return; // Early exit
 
-        // It is essential to INCREMENT REF COUNTER while HOLDING THE LOCK to make sure that
-        // StrongRefCnt > 1 guarantees that the object is alive.
-
-        // If other thread started deleting the object in ReleaseStrongRef(), then m_NumStrongReferences==0
-        // We must make sure only one thread is allowed to increment the counter to guarantee that if StrongRefCnt > 1,
-        // there is at least one real strong reference left. Otherwise the following scenario may occur:
+        // Promote the weak reference without taking the lock: the strong reference counter is only
+        // incremented if it is not zero. Once the counter reaches zero, it never changes again and
+        // exactly one thread (the one that performed the last decrement in ReleaseStrongRef()) proceeds
+        // to destroy the object. Conversely, if the counter was incremented from a non-zero value,
+        // the object can't be destroyed until the temporary reference is released:
         //
         //                                      m_NumStrongReferences == 1
         //
-        //    Thread 1 - ReleaseStrongRef()    |    Thread 2 - QueryObject()       |    Thread 3 - QueryObject()
-        //                                     |                                   |
-        //  - Decrement m_NumStrongReferences  | -Increment m_NumStrongReferences  | -Increment m_NumStrongReferences
-        //  - Read RefCount == 0               | -Read StrongRefCnt==1             | -Read StrongRefCnt==2
-        //    Destroy the object               |                                   | -Return reference to the soon
-        //                                     |                                   |  to expire object
+        //    Thread 1 - ReleaseStrongRef()    |    Thread 2 - QueryObject()
+        //                                     |
+        //  - Decrement m_NumStrongReferences  |
+        //  - Read RefCount == 0               | - Read StrongRefCnt == 0
+        //    Destroy the object               | - DO NOT increment the counter, return null
         //
-        Threading::SpinLockGuard Guard{m_Lock};
-
-        const auto StrongRefCnt = m_NumStrongReferences.fetch_add(+1) + 1;
-
-        // Checking if m_ObjectState == ObjectState::Alive only is not reliable:
+        //    or
+        //                                     | - Read StrongRefCnt == 1
+        //                                     | - Increment m_NumStrongReferences from 1 to 2
+        //  - Decrement m_NumStrongReferences  |
+        //  - Read RefCount == 1               | - Return the reference to the object
+        //    DO NOT destroy the object        | - Release the temporary reference
         //
-        //           This thread                    |          Another thread
-        //                                          |
-        //   1. Acquire the lock                    |
-        //                                          |    1. Decrement m_NumStrongReferences
-        //   2. Increment m_NumStrongReferences     |    2. Test RefCount==0
-        //   3. Read StrongRefCnt == 1              |    3. Start destroying the object
-        //      m_ObjectState == ObjectState::Alive |
-        //   4. DO NOT return the reference to      |    4. Wait for the lock, m_ObjectState == ObjectState::Alive
-        //      the object                          |
-        //   5. Decrement m_NumStrongReferences     |
-        //                                          |    5. Destroy the object
-
-        if (m_ObjectState == ObjectState::Alive && StrongRefCnt > 1)
+        auto StrongRefCnt = m_NumStrongReferences.load();
+        while (StrongRefCnt > 0)
         {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // QueryInterface() must not lock the object, or a deadlock happens.
-            // The only other two methods that lock the object are ReleaseStrongRef()
-            // and ReleaseWeakRef(), which are never called by QueryInterface()
-            auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
-            pWrapper->QueryInterface(IID_Unknown, ppObject);
+            if (m_NumStrongReferences.compare_exchange_weak(StrongRefCnt, StrongRefCnt + 1))
+            {
+                VERIFY(m_ObjectState.load() == ObjectState::Alive, "The object must be alive while there are strong references");
+                VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+                // QueryInterface() must not lock the object, or a deadlock happens.
+                // The only other two methods that lock the object are ReleaseStrongRef()
+                // and ReleaseWeakRef(), which are never called by QueryInterface()
+                auto* pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
+                pWrapper->QueryInterface(IID_Unknown, ppObject);
+
+                // Release the temporary reference. If QueryInterface() failed, this may be the last reference.
+                ReleaseStrongRef();
+                break;
+            }
+            // StrongRefCnt is updated with the current value of the counter
         }
-        m_NumStrongReferences.fetch_add(-1);
     }
 
     inline virtual ReferenceCounterValueType GetNumStrongRefs() const override final
@@ -305,53 +301,10 @@ private:
         //  IT IS CRUCIALLY IMPORTANT TO ASSURE THAT ONLY ONE THREAD WILL EVER
         //  EXECUTE THIS CODE
 
-        // The solution is to atomically increment strong ref counter in QueryObject().
-        // There are two possible scenarios depending on who first increments the counter:
-
-
-        //                                                     Scenario I
-        //
-        //             This thread              |     Another thread - QueryObject()        |  One more thread - QueryObject()
-        //                                      |                                           |
-        //                        m_NumStrongReferences == 1                                |
-        //                                      |                                           |
-        //                                      |   1. Acquire the lock                     |
-        // 1. Decrement mlNumStrongReferences   |                                           |   1. Wait for the lock
-        // 2. Read RefCount==0                  |   2. Increment m_NumStrongReferences      |
-        // 3. Start destroying the object       |   3. Read StrongRefCnt == 1               |
-        // 4. Wait for the lock                 |   4. DO NOT return the reference          |
-        //                                      |      to the object                        |
-        //                                      |   5. Decrement m_NumStrongReferences      |
-        // _  _  _  _  _  _  _  _  _  _  _  _  _|   6. Release the lock _  _  _  _  _  _  _ |_  _  _  _  _  _  _  _  _  _  _  _  _  _
-        //                                      |                                           |   2. Acquire the lock
-        //                                      |                                           |   3. Increment m_NumStrongReferences
-        //                                      |                                           |   4. Read StrongRefCnt == 1
-        //                                      |                                           |   5. DO NOT return the reference
-        //                                      |                                           |      to the object
-        //                                      |                                           |   6. Decrement m_NumStrongReferences
-        //  _  _  _  _  _  _  _  _  _  _  _  _  | _  _  _  _  _  _  _  _  _  _  _  _  _  _  | _ 7. Release the lock _  _  _  _  _  _
-        // 5. Acquire the lock                  |                                           |
-        //   - m_NumStrongReferences==0         |                                           |
-        // 6. DESTROY the object                |                                           |
-        //                                      |                                           |
-
-        //  QueryObject() MUST BE SERIALIZED for this to work properly!
-
-
-        //                                   Scenario II
-        //
-        //             This thread              |     Another thread - QueryObject()
-        //                                      |
-        //                       m_NumStrongReferences == 1
-        //                                      |
-        //                                      |   1. Acquire the lock
-        //                                      |   2. Increment m_NumStrongReferences
-        // 1. Decrement m_NumStrongReferences   |
-        // 2. Read RefCount>0                   |
-        // 3. DO NOT destroy the object         |   3. Read StrongRefCnt > 1 (while m_NumStrongReferences == 1)
-        //                                      |   4. Return the reference to the object
-        //                                      |       - Increment m_NumStrongReferences
-        //                                      |   5. Decrement m_NumStrongReferences
+        // The solution is to never increment the strong ref counter in QueryObject()
+        // once it has reached zero (see the compare-exchange loop in QueryObject()).
+        // Since the counter can't go through zero twice, only the thread that performed
+        // the last decrement ever gets here.
 
 #ifdef DILIGENT_DEBUG
         {
@@ -363,10 +316,8 @@ private:
         // Acquire the lock.
         std::unique_lock<Threading::SpinLock> Guard{m_Lock};
 
-        // QueryObject() first acquires the lock, and only then increments and
-        // decrements the ref counter. If it reads 1 after incrementing the counter,
-        // it does not return the reference to the object and decrements the counter.
-        // If we acquired the lock, QueryObject() will not start until we are done
+        // QueryObject() never increments the counter once it has reached zero,
+        // so the counter is guaranteed to remain zero.
         VERIFY_EXPR(m_NumStrongReferences.load() == 0 && m_ObjectState.load() == ObjectState::Alive);
 
         // Extra caution
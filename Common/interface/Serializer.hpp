@@ -236,6 +236,37 @@ public:
                            ElemPtrType&            Elements,
                            CountType&              Count);
 
+    /// Serializes an array of trivially serializable elements that can be read in place
+    ///
+    ///  * Measure
+    ///      Writes Count (noop)
+    ///      Aligns up current offset to alignof(ElemType)
+    ///      Writes Count elements (noop)
+    ///
+    ///  * Write
+    ///      Writes Count
+    ///      Aligns up current offset to alignof(ElemType)
+    ///      Writes Count elements
+    ///
+    ///  * Read
+    ///      Reads Count
+    ///      Aligns up current offset to alignof(ElemType)
+    ///      Sets Elements to m_Ptr. If m_Ptr is not properly aligned, copies the elements
+    ///      to the memory allocated from Allocator instead.
+    ///      Moves m_Ptr by Count elements
+    ///
+    /// \remarks    Unlike SerializeArrayRaw(), the Read mode does not allocate memory, and the array
+    ///             references the source data that must stay alive while the array is used.
+    ///             The offset is aligned relative to the start of the data, so the elements are only
+    ///             copied if the source data itself is not aligned by alignof(ElemType), in which case
+    ///             Allocator must not be null.
+    ///             The layout differs from SerializeArrayRaw(), so the same method must be used
+    ///             to write and to read the data.
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayView(DynamicLinearAllocator* Allocator,
+                            ElemPtrType&            Elements,
+                            CountType&              Count);
+
     template <typename T>
     TReadOnly<T> Cast()
     {
@@ -495,8 +526,113 @@ bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                           });
 }
 
+template <SerializerMode Mode> // Write or Measure
+template <typename ElemPtrType, typename CountType>
+bool Serializer<Mode>::SerializeArrayView(DynamicLinearAllocator* Allocator,
+                                          ElemPtrType&            Elements,
+                                          CountType&              Count)
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+
+    using ElemType = RawType<decltype(Elements[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Only arrays of trivially serializable elements can be read in place");
+    VERIFY_EXPR((Elements != nullptr) == (Count != 0));
+
+    if (!(*this)(Count))
+        return false;
+
+    AlignOffset(alignof(ElemType));
+    return Copy(Elements, sizeof(ElemType) * static_cast<size_t>(Count));
+}
+
+template <>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<SerializerMode::Read>::SerializeArrayView(DynamicLinearAllocator* Allocator,
+                                                          ElemPtrType&            Elements,
+                                                          CountType&              Count)
+{
+    using ElemType = RawType<decltype(Elements[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Only arrays of trivially serializable elements can be read in place");
+    VERIFY_EXPR(Elements == nullptr);
+
+    if (!(*this)(Count))
+        return false;
+
+    AlignOffset(alignof(ElemType));
+
+    const size_t Size = sizeof(ElemType) * static_cast<size_t>(Count);
+    CHECK_REMAINING_SIZE(Size, "Note enough data to read ", Count, " array elements.");
+
+    if (Count == 0)
+    {
+        Elements = nullptr;
+    }
+    else if (reinterpret_cast<size_t>(m_Ptr) % alignof(ElemType) == 0)
+    {
+        Elements = reinterpret_cast<const ElemType*>(m_Ptr);
+    }
+    else
+    {
+        if (Allocator == nullptr)
+        {
+            UNEXPECTED("The source data is not properly aligned and the allocator is null");
+            return false;
+        }
+        auto* pDstElements = Allocator->Allocate<ElemType>(static_cast<size_t>(Count));
+        std::memcpy(pDstElements, m_Ptr, Size);
+        Elements = pDstElements;
+    }
+    m_Ptr += Size;
+
+    return true;
+}
+
 #undef CHECK_REMAINING_SIZE
 
+
+/// Serializes the data into a new SerializedData object.
+
+/// \param [in]     Allocator     - Allocator to allocate the data.
+/// \param [in]     Handler       - Generic handler that serializes the data, e.g.
+///                                 [&](auto& Ser) { return Ser(Value1, Value2); }
+///                                It is called with Serializer<SerializerMode::Measure>
+///                                and then with Serializer<SerializerMode::Write>.
+/// \param [in,out] pMeasuredSize - Optional cache of the serialized size.
+///                                If it points to a non-zero value, the Measure pass is skipped
+///                                and the value is used as the data size.
+///                                Otherwise, the size computed by the Measure pass is written to it.
+///
+/// \remarks    The measured size may be cached by the application for objects that are
+///             serialized multiple times as long as the object does not change.
+///             If the handler returns false or the cached size does not match the size
+///             of the written data, the function returns empty data.
+template <typename HandlerType>
+SerializedData SerializeToData(IMemoryAllocator& Allocator, HandlerType&& Handler, size_t* pMeasuredSize = nullptr)
+{
+    size_t Size = pMeasuredSize != nullptr ? *pMeasuredSize : 0;
+    if (Size == 0)
+    {
+        Serializer<SerializerMode::Measure> MeasureSer;
+        if (!Handler(MeasureSer))
+            return {};
+
+        Size = MeasureSer.GetSize();
+        if (pMeasuredSize != nullptr)
+            *pMeasuredSize = Size;
+    }
+
+    SerializedData Data{Size, Allocator};
+
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    if (!Handler(WriteSer) || !WriteSer.IsEnded())
+    {
+        UNEXPECTED("Failed to serialize the data. If the measured size is cached, the object may have changed.");
+        return {};
+    }
+
+    return Data;
+}
+
 } // namespace Diligent
 
 
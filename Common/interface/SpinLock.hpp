@@ -29,6 +29,7 @@
 #include <atomic>
 #include <mutex>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Threading
@@ -94,4 +95,105 @@ private:
 
 using SpinLockGuard = std::lock_guard<SpinLock>;
 
+
+/// Adaptive spin lock that spins with a backoff and then parks the waiting thread.
+
+/// Pure spinning performs poorly when there are more threads than cores: a waiting thread
+/// may burn the time slice of the thread that holds the lock. This lock spins for a short
+/// time with an exponential PAUSE/YIELD backoff, then yields, and finally parks the thread
+/// in the OS (futex on Linux and Android, WaitOnAddress on Windows, and a condition
+/// variable on other platforms) until the lock is released.
+///
+/// The uncontended lock() and unlock() are a single atomic operation each.
+/// Contention statistics are only updated in the slow path.
+class AdaptiveSpinLock
+{
+public:
+    /// Contention statistics, see GetStatistics().
+    struct Statistics
+    {
+        /// The number of lock() calls that found the lock taken.
+        Diligent::Uint64 ContentionCount = 0;
+
+        /// The number of times a waiting thread yielded its time slice.
+        Diligent::Uint64 YieldCount = 0;
+
+        /// The number of times a waiting thread was parked.
+        Diligent::Uint64 ParkCount = 0;
+    };
+
+    AdaptiveSpinLock() noexcept {}
+
+    // clang-format off
+    AdaptiveSpinLock             (const AdaptiveSpinLock&)  = delete;
+    AdaptiveSpinLock& operator = (const AdaptiveSpinLock&)  = delete;
+    AdaptiveSpinLock             (      AdaptiveSpinLock&&) = delete;
+    AdaptiveSpinLock& operator = (      AdaptiveSpinLock&&) = delete;
+    // clang-format on
+
+    void lock() noexcept
+    {
+        Diligent::Uint32 Expected = Unlocked;
+        if (!m_State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+            LockContended();
+    }
+
+    bool try_lock() noexcept
+    {
+        if (is_locked())
+            return false;
+
+        Diligent::Uint32 Expected = Unlocked;
+        return m_State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        VERIFY(is_locked(), "Attempting to unlock a spin lock that is not locked. This is a strong indication of a flawed logic.");
+        if (m_State.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters)
+            WakeOne();
+    }
+
+    bool is_locked() const noexcept
+    {
+        return m_State.load(std::memory_order_relaxed) != Unlocked;
+    }
+
+    /// Returns the contention statistics.
+    Statistics GetStatistics() const noexcept
+    {
+        Statistics Stats;
+        Stats.ContentionCount = m_ContentionCount.load(std::memory_order_relaxed);
+        Stats.YieldCount      = m_YieldCount.load(std::memory_order_relaxed);
+        Stats.ParkCount       = m_ParkCount.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
+    /// Resets the contention statistics.
+    void ResetStatistics() noexcept
+    {
+        m_ContentionCount.store(0, std::memory_order_relaxed);
+        m_YieldCount.store(0, std::memory_order_relaxed);
+        m_ParkCount.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    void LockContended() noexcept;
+    void Park() noexcept;
+    void WakeOne() noexcept;
+
+private:
+    static constexpr Diligent::Uint32 Unlocked          = 0;
+    static constexpr Diligent::Uint32 Locked            = 1;
+    static constexpr Diligent::Uint32 LockedWithWaiters = 2;
+
+    std::atomic<Diligent::Uint32> m_State{Unlocked};
+
+    std::atomic<Diligent::Uint64> m_ContentionCount{0};
+    std::atomic<Diligent::Uint64> m_YieldCount{0};
+    std::atomic<Diligent::Uint64> m_ParkCount{0};
+};
+
+using AdaptiveSpinLockGuard = std::lock_guard<AdaptiveSpinLock>;
+
 } // namespace Threading
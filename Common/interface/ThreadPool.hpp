@@ -28,10 +28,14 @@
 
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <thread>
+#include <vector>
+#include <algorithm>
 
 #include "../../Primitives/interface/Object.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/Basic/interface/BasicPlatformMisc.hpp"
 
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -56,6 +60,29 @@ enum ASYNC_TASK_STATUS
 };
 
 
+/// Thread pool lane.
+
+/// Worker threads always take tasks from the most important non-empty lane, so tasks in
+/// a higher lane never wait behind tasks in a lower lane, regardless of their priorities.
+/// Task priorities only order the tasks within one lane.
+enum THREAD_POOL_LANE : Uint8
+{
+    /// Latency-critical tasks, e.g. jobs that must finish within the current frame.
+    /// These tasks may also be run by the worker threads reserved for this lane,
+    /// see ThreadPoolCreateInfo::NumCriticalThreads.
+    THREAD_POOL_LANE_CRITICAL = 0,
+
+    /// Regular tasks.
+    THREAD_POOL_LANE_NORMAL,
+
+    /// Background tasks, e.g. asset streaming or decoding. The number of threads that run
+    /// these tasks at the same time may be limited, see ThreadPoolCreateInfo::MaxBackgroundThreads.
+    THREAD_POOL_LANE_BACKGROUND,
+
+    THREAD_POOL_LANE_COUNT
+};
+
+
 // {B06D1DDA-AEA0-4CFD-969A-C8E2011DC294}
 static const INTERFACE_ID IID_AsyncTask =
     {0xb06d1dda, 0xaea0, 0x4cfd, {0x96, 0x9a, 0xc8, 0xe2, 0x1, 0x1d, 0xc2, 0x94}};
@@ -112,6 +139,16 @@ public:
     ///
     ///           This method must not be called from the worker thread.
     virtual void WaitUntilRunning() const = 0;
+
+    /// Adds a function that is called when the task is finished (i.e. cancelled or complete).
+
+    /// \remarks    If the task is already finished, the function is called immediately
+    ///             by the calling thread. Otherwise, it is called once by the thread that
+    ///             sets the finished status, after the status has been updated.
+    ///
+    ///             Thread pools use the callbacks to schedule the tasks that wait for
+    ///             this task, see IThreadPool::EnqueueTask().
+    virtual void AddFinishedCallback(std::function<void()> Callback) = 0;
 };
 
 
@@ -120,16 +157,37 @@ static const INTERFACE_ID IID_ThreadPool =
     {0x8bb92b5e, 0x3eab, 0x4cc3, {0x9d, 0xa2, 0x54, 0x70, 0xdb, 0xba, 0x71, 0x20}};
 
 /// Thread pool interface
-class IThreadPool : public IObject
+
+/// \remarks IThreadPool is declared as a struct as it is forward-declared
+///          as such in C-compatible interface headers (see EngineCreateInfo).
+struct IThreadPool : public IObject
 {
-public:
     /// Enqueues asynchronous task for execution.
 
-    /// \param[in] pTask - Task to run.
+    /// \param[in] pTask            - Task to run.
+    /// \param[in] ppPrerequisites  - An optional array of tasks that must be complete
+    ///                               before this task can start.
+    /// \param[in] NumPrerequisites - The number of elements in ppPrerequisites array.
+    /// \param[in] Lane             - The lane to place the task into, see Diligent::THREAD_POOL_LANE.
     ///
     /// \remarks   Thread pool will keep a strong reference to the task,
     ///            so an application is free to release it after enqueuing.
-    virtual void EnqueueTask(IAsyncTask* pTask) = 0;
+    ///
+    ///            The task will not be placed into the queue until all its
+    ///            prerequisites reach ASYNC_TASK_STATUS_COMPLETE status, so
+    ///            no worker thread is blocked waiting for them. If any prerequisite
+    ///            is cancelled, the task is cancelled too without being run.
+    ///            Tasks that wait for their prerequisites are counted by GetQueueSize()
+    ///            and are waited for by WaitForAllTasks().
+    ///
+    ///            The pool is notified when a prerequisite finishes (see IAsyncTask::AddFinishedCallback()),
+    ///            so prerequisites may be tasks of any thread pool or tasks that are run by
+    ///            the application itself. If a prerequisite is removed from the queue with
+    ///            RemoveTask(), the tasks that wait for it are cancelled.
+    virtual void EnqueueTask(IAsyncTask*      pTask,
+                             IAsyncTask**     ppPrerequisites  = nullptr,
+                             Uint32           NumPrerequisites = 0,
+                             THREAD_POOL_LANE Lane             = THREAD_POOL_LANE_NORMAL) = 0;
 
 
     /// Reprioritizes the task in the queue.
@@ -142,7 +200,7 @@ public:
     /// \remarks    When the tasks is enqueued, its priority is used to
     ///             place it in the priority queue. When an application changes
     ///             the task priority, it should call this method to update the task
-    ///             position in the queue.
+    ///             position in the queue. The task stays in its lane.
     virtual bool ReprioritizeTask(IAsyncTask* pTask) = 0;
 
 
@@ -160,6 +218,9 @@ public:
     ///
     /// \return    true if the task has been successfully removed from the queue
     ///            or if it has already finished, and false otherwise.
+    ///
+    /// \remarks   The removed task will never be run by the pool, so the tasks that
+    ///            wait for it to complete (see EnqueueTask()) are cancelled.
     virtual bool RemoveTask(IAsyncTask* pTask, bool CancelIfRunning) = 0;
 
 
@@ -199,6 +260,9 @@ public:
     /// \return     Whether there are more tasks to process. The calling thread must keep
     ///             calling the function until it returns false.
     ///
+    /// \remarks    Threads whose ThreadId is less than ThreadPoolCreateInfo::NumCriticalThreads
+    ///             only process the tasks from the THREAD_POOL_LANE_CRITICAL lane.
+    ///
     /// \remarks    This method allows an application to implement its own threading strategy.
     ///             A thread pool may be created with zero threads, and the application may call
     ///             ProcessTask() method from its own threads.
@@ -241,15 +305,24 @@ public:
 };
 
 
+/// Returns the default number of thread pool worker threads, which is the number
+/// of physical CPU cores (see PlatformMisc::GetCPUInfo()), but at least one.
+
+/// \remarks    Logical cores of the same physical core share its execution units and caches,
+///             so running more worker threads than there are physical cores usually does not
+///             speed up compute-bound tasks, but increases contention.
+size_t GetDefaultThreadPoolSize();
+
 /// Thread pool create information
 struct ThreadPoolCreateInfo
 {
-    /// The number of worker threads to start.
+    /// The number of worker threads to start. By default, one thread
+    /// per physical CPU core is started, see GetDefaultThreadPoolSize().
 
     /// \remarks    An application may create a thread pool with
     ///             zero threads, in which case it will be responsible
     ///             for manually calling the IThreadPool::ProcessTask() method.
-    size_t NumThreads = 0;
+    size_t NumThreads = GetDefaultThreadPoolSize();
 
     /// An optional function that will be called by the thread pool from
     /// the worker thread after the thread has just started, but before
@@ -259,6 +332,68 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Whether to enable work stealing.
+
+    /// \remarks    By default, all worker threads take tasks from a single
+    ///             priority queue protected by one mutex. When work stealing is
+    ///             enabled, every worker thread has its own priority queue, and
+    ///             new tasks are distributed between the queues in a round-robin
+    ///             fashion. A worker thread takes the highest-priority task from
+    ///             all queues, preferring its own queue when the priorities are equal,
+    ///             so that stealing tasks from other threads respects task priorities.
+    ///             The queue is selected without locking, so when tasks are enqueued
+    ///             or reprioritized concurrently, the order is approximate.
+    ///
+    ///             Work stealing considerably reduces contention when many threads
+    ///             process short tasks, as every queue is protected by its own mutex.
+    ///
+    ///             If the pool is created with zero threads, this option has no effect.
+    bool EnableWorkStealing = false;
+
+    /// The number of worker threads reserved for the THREAD_POOL_LANE_CRITICAL lane.
+
+    /// \remarks    Worker threads with ids from 0 to NumCriticalThreads-1 only run critical
+    ///             tasks, so that a critical task can start immediately even if all other
+    ///             threads are busy with long-running tasks. The remaining threads run the tasks
+    ///             from all lanes, taking critical tasks first.
+    ///
+    ///             The value is clamped to NumThreads-1 so that there is at least one thread
+    ///             that processes the other lanes.
+    size_t NumCriticalThreads = 0;
+
+    /// The maximum number of threads that may run THREAD_POOL_LANE_BACKGROUND tasks
+    /// at the same time, or 0 if there is no limit.
+
+    /// \remarks    Limiting the number of background threads keeps the remaining threads
+    ///             available for the normal and critical tasks while long-running background
+    ///             work saturates the other cores.
+    size_t MaxBackgroundThreads = 0;
+
+    /// OS priority of the reserved critical worker threads (see NumCriticalThreads).
+    /// ThreadPriority::Unknown keeps the default priority.
+    ThreadPriority CriticalThreadPriority = ThreadPriority::Unknown;
+
+    /// OS priority of the other worker threads.
+    /// ThreadPriority::Unknown keeps the default priority.
+
+    /// \remarks    On Windows, the priority is set with SetThreadPriority. On Linux and Android,
+    ///             it is set through the thread nice value, and raising it above normal requires
+    ///             sufficient privileges. On Apple platforms, it is mapped to a QoS class.
+    ThreadPriority WorkerThreadPriority = ThreadPriority::Unknown;
+
+    /// The type of cores to pin the reserved critical worker threads to.
+    CPUCoreType CriticalThreadCores = CPUCoreType::Any;
+
+    /// The type of cores to pin the other worker threads to.
+
+    /// \remarks    Threads are pinned to the cores reported by PlatformMisc::GetCPUCoreMask().
+    ///             If the platform can't pin threads or has no cores of the requested type
+    ///             (e.g. efficiency cores on a CPU where all cores are identical), the threads
+    ///             are not pinned. Apple platforms do not support thread affinity, and
+    ///             a low WorkerThreadPriority should be used there to direct the threads
+    ///             to the efficiency cores.
+    CPUCoreType WorkerThreadCores = CPUCoreType::Any;
 };
 
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
@@ -316,7 +451,22 @@ public:
             }
         }
 #endif
-        m_TaskStatus.store(Status);
+        if (Status != ASYNC_TASK_STATUS_CANCELLED && Status != ASYNC_TASK_STATUS_COMPLETE)
+        {
+            m_TaskStatus.store(Status);
+            return;
+        }
+
+        std::vector<std::function<void()>> Callbacks;
+        {
+            // NB: the status must be updated under the mutex so that AddFinishedCallback()
+            //     either sees the task finished or adds the callback before it is taken.
+            std::lock_guard<std::mutex> Lock{m_FinishedCallbacksMtx};
+            m_TaskStatus.store(Status);
+            Callbacks.swap(m_FinishedCallbacks);
+        }
+        for (auto& Callback : Callbacks)
+            Callback();
     }
 
     ASYNC_TASK_STATUS GetStatus() const override final
@@ -353,17 +503,38 @@ public:
             std::this_thread::yield();
     }
 
+    virtual void AddFinishedCallback(std::function<void()> Callback) override final
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_FinishedCallbacksMtx};
+            if (!IsFinished())
+            {
+                m_FinishedCallbacks.emplace_back(std::move(Callback));
+                return;
+            }
+        }
+        Callback();
+    }
+
 protected:
     std::atomic<bool> m_bSafelyCancel{false};
 
 private:
     std::atomic<float>             m_fPriority{0};
     std::atomic<ASYNC_TASK_STATUS> m_TaskStatus{ASYNC_TASK_STATUS_NOT_STARTED};
+
+    std::mutex                         m_FinishedCallbacksMtx;
+    std::vector<std::function<void()>> m_FinishedCallbacks;
 };
 
 
 template <typename HanlderType>
-RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool*     pThreadPool,
+                                           IAsyncTask**     ppPrerequisites,
+                                           Uint32           NumPrerequisites,
+                                           HanlderType      Handler,
+                                           float            fPriority = 0,
+                                           THREAD_POOL_LANE Lane      = THREAD_POOL_LANE_NORMAL)
 {
     class TaskImpl final : public AsyncTaskBase
     {
@@ -386,9 +557,178 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
     };
 
     RefCntAutoPtr<TaskImpl> pTask{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
-    pThreadPool->EnqueueTask(pTask);
+    pThreadPool->EnqueueTask(pTask, ppPrerequisites, NumPrerequisites, Lane);
 
     return pTask;
 }
 
+template <typename HanlderType>
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool*     pThreadPool,
+                                           HanlderType      Handler,
+                                           float            fPriority = 0,
+                                           THREAD_POOL_LANE Lane      = THREAD_POOL_LANE_NORMAL)
+{
+    return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority, Lane);
+}
+
+namespace Detail
+{
+
+/// Returns the batch size that splits NumItems items into a few batches per hardware thread,
+/// so that threads that finish early can pick up more work.
+inline size_t GetAdaptiveBatchSize(size_t NumItems, size_t MinBatchSize = 1)
+{
+    const size_t NumThreads = std::max(size_t{std::thread::hardware_concurrency()}, size_t{1});
+    const size_t NumBatches = NumThreads * 4;
+    return std::max((NumItems + NumBatches - 1) / NumBatches, std::max(MinBatchSize, size_t{1}));
+}
+
+} // namespace Detail
+
+/// Splits NumItems items into batches of BatchSize items and runs Handler(Begin, End) for every
+/// batch on the thread pool worker threads and the calling thread. The function returns when all
+/// batches have been processed.
+
+/// \remarks    Handler may be called concurrently from multiple threads.
+///             If BatchSize is 0, it is selected automatically based on the number of items and hardware threads.
+///             If pThreadPool is null, all batches are processed by the calling thread.
+///
+///             The calling thread does not block while the batches are processed: it takes batches
+///             from the same counter as the worker threads. Completion is tracked per call, so the
+///             function does not wait for unrelated tasks in the pool. Tasks that have not been
+///             started by the time all batches are taken are removed from the queue, so the
+///             function also works with pools that have no worker threads.
+template <typename HandlerType>
+void ParallelFor(IThreadPool* pThreadPool, size_t NumItems, size_t BatchSize, HandlerType&& Handler)
+{
+    if (NumItems == 0)
+        return;
+
+    if (BatchSize == 0)
+        BatchSize = Detail::GetAdaptiveBatchSize(NumItems);
+
+    const size_t NumBatches = (NumItems + BatchSize - 1) / BatchSize;
+
+    std::atomic<size_t> NextBatch{0};
+    auto                ProcessBatches = [&]() {
+        for (size_t Batch = NextBatch.fetch_add(1); Batch < NumBatches; Batch = NextBatch.fetch_add(1))
+        {
+            const size_t Begin = Batch * BatchSize;
+            Handler(Begin, std::min(Begin + BatchSize, NumItems));
+        }
+    };
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    if (pThreadPool != nullptr && NumBatches > 1)
+    {
+        const size_t NumTasks = std::min(NumBatches - 1, size_t{std::max(std::thread::hardware_concurrency(), 1u)});
+        Tasks.reserve(NumTasks);
+        for (size_t i = 0; i < NumTasks; ++i)
+            Tasks.emplace_back(EnqueueAsyncWork(pThreadPool, [&ProcessBatches](Uint32) { ProcessBatches(); }));
+    }
+
+    ProcessBatches();
+
+    // All batches have been taken, but the tasks reference local variables and must not outlive them
+    for (auto& pTask : Tasks)
+    {
+        if (!pThreadPool->RemoveTask(pTask, false))
+            pTask->WaitForCompletion();
+    }
+}
+
+/// Same as ParallelFor(pThreadPool, NumItems, 0, Handler), i.e. with the automatically selected batch size.
+template <typename HandlerType>
+void ParallelFor(IThreadPool* pThreadPool, size_t NumItems, HandlerType&& Handler)
+{
+    ParallelFor(pThreadPool, NumItems, 0, std::forward<HandlerType>(Handler));
+}
+
+
+/// Splits NumItems items into batches, computes Map(Begin, End) for every batch in parallel and
+/// combines the batch results with Reduce(Accum, BatchResult), starting from Identity.
+
+/// \remarks    Batch results are combined by the calling thread in batch order, so the result is
+///             deterministic for a given batch size even if Reduce is not commutative or, as with
+///             floating-point addition, not exactly associative.
+///             If BatchSize is 0, it is selected automatically.
+template <typename ResultType, typename MapType, typename ReduceType>
+ResultType ParallelReduce(IThreadPool* pThreadPool,
+                          size_t       NumItems,
+                          size_t       BatchSize,
+                          ResultType   Identity,
+                          MapType&&    Map,
+                          ReduceType&& Reduce)
+{
+    if (NumItems == 0)
+        return Identity;
+
+    if (BatchSize == 0)
+        BatchSize = Detail::GetAdaptiveBatchSize(NumItems);
+
+    const size_t NumBatches = (NumItems + BatchSize - 1) / BatchSize;
+
+    std::vector<ResultType> BatchResults(NumBatches, Identity);
+    ParallelFor(pThreadPool, NumItems, BatchSize,
+                [&](size_t Begin, size_t End) {
+                    BatchResults[Begin / BatchSize] = Map(Begin, End);
+                });
+
+    ResultType Result = std::move(Identity);
+    for (auto& BatchResult : BatchResults)
+        Result = Reduce(std::move(Result), std::move(BatchResult));
+
+    return Result;
+}
+
+
+/// Sorts the range [First, Last) using the thread pool.
+
+/// \remarks    The range is split into chunks that are sorted in parallel with std::sort and then
+///             merged pairwise with std::inplace_merge, also in parallel. Like std::sort, the
+///             function is not stable. Ranges shorter than MinChunkSize elements are sorted
+///             by the calling thread.
+template <typename RandomIt, typename CompareType>
+void ParallelSort(IThreadPool* pThreadPool, RandomIt First, RandomIt Last, CompareType Compare, size_t MinChunkSize = 4096)
+{
+    const size_t NumItems = static_cast<size_t>(Last - First);
+    if (NumItems < 2)
+        return;
+
+    const size_t ChunkSize = Detail::GetAdaptiveBatchSize(NumItems, MinChunkSize);
+    if (pThreadPool == nullptr || ChunkSize >= NumItems)
+    {
+        std::sort(First, Last, Compare);
+        return;
+    }
+
+    ParallelFor(pThreadPool, NumItems, ChunkSize,
+                [&](size_t Begin, size_t End) {
+                    std::sort(First + Begin, First + End, Compare);
+                });
+
+    // Merge sorted runs of size RunSize pairwise until there is a single run
+    for (size_t RunSize = ChunkSize; RunSize < NumItems; RunSize *= 2)
+    {
+        const size_t NumMerges = (NumItems + RunSize * 2 - 1) / (RunSize * 2);
+        ParallelFor(pThreadPool, NumMerges, 1,
+                    [&](size_t Begin, size_t End) {
+                        for (size_t Merge = Begin; Merge < End; ++Merge)
+                        {
+                            const size_t Start = Merge * RunSize * 2;
+                            const size_t Mid   = std::min(Start + RunSize, NumItems);
+                            const size_t Stop  = std::min(Start + RunSize * 2, NumItems);
+                            if (Mid < Stop)
+                                std::inplace_merge(First + Start, First + Mid, First + Stop, Compare);
+                        }
+                    });
+    }
+}
+
+template <typename RandomIt>
+void ParallelSort(IThreadPool* pThreadPool, RandomIt First, RandomIt Last)
+{
+    ParallelSort(pThreadPool, First, Last, [](const auto& Lhs, const auto& Rhs) { return Lhs < Rhs; });
+}
+
 } // namespace Diligent
@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TrackingMemoryAllocator class
+
+#include <atomic>
+#include <array>
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+
+namespace Diligent
+{
+
+/// Memory allocator that forwards all allocations to another allocator and tracks
+/// the allocated memory per allocation tag.
+
+/// Every allocation is attributed to the tag that is active in the calling thread
+/// at the time of the allocation, see Diligent::MemoryAllocationTagScope. The tag is
+/// stored in a small header in front of the allocation, so that the memory is correctly
+/// accounted for when it is released by another thread.
+///
+/// All counters are lock-free. All methods are thread-safe.
+class TrackingMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    /// The maximum number of allocation tags.
+    static constexpr Uint32 MaxTags = 16;
+
+    /// The size of the header that is prepended to every allocation.
+    static constexpr size_t HeaderSize = 16;
+
+    /// Memory statistics of a single allocation tag.
+    struct TagStatistics
+    {
+        /// The total size of all currently allocated blocks, excluding headers.
+        size_t CurrentSize = 0;
+
+        /// The maximum value of CurrentSize since the allocator was created or ResetPeakSizes() was called.
+        size_t PeakSize = 0;
+
+        /// The number of currently allocated blocks.
+        size_t CurrentAllocationCount = 0;
+
+        /// The total number of allocations made since the allocator was created.
+        Uint64 TotalAllocationCount = 0;
+    };
+
+    explicit TrackingMemoryAllocator(IMemoryAllocator& Backend) noexcept :
+        m_Backend{Backend}
+    {}
+
+    // clang-format off
+    TrackingMemoryAllocator           (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator           (TrackingMemoryAllocator&&)      = delete;
+    TrackingMemoryAllocator& operator=(const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator& operator=(TrackingMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    /// Allocates a block of memory from the backend allocator and attributes it to the current thread tag.
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases a block of memory allocated by this allocator.
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns the statistics of the given tag.
+    TagStatistics GetTagStatistics(Uint32 Tag) const;
+
+    /// Sets the peak size of every tag to its current size.
+    void ResetPeakSizes();
+
+    /// Returns the allocator that performs the actual allocations.
+    IMemoryAllocator& GetBackend() const { return m_Backend; }
+
+    /// Sets the tag that is used for allocations made by the calling thread.
+
+    /// \return     The previous tag of the calling thread.
+    static Uint32 SetThreadTag(Uint32 Tag);
+
+    /// Returns the tag that is used for allocations made by the calling thread.
+    static Uint32 GetThreadTag();
+
+private:
+    struct TagCounters
+    {
+        std::atomic<size_t> CurrentSize{0};
+        std::atomic<size_t> PeakSize{0};
+        std::atomic<size_t> CurrentAllocationCount{0};
+        std::atomic<Uint64> TotalAllocationCount{0};
+    };
+
+    IMemoryAllocator& m_Backend;
+
+    std::array<TagCounters, MaxTags> m_Counters;
+};
+
+
+/// Sets the allocation tag of the calling thread for the lifetime of the scope, see Diligent::TrackingMemoryAllocator.
+
+/// Scopes may be nested, the previous tag is restored when the scope ends.
+class MemoryAllocationTagScope
+{
+public:
+    explicit MemoryAllocationTagScope(Uint32 Tag) noexcept :
+        m_PrevTag{TrackingMemoryAllocator::SetThreadTag(Tag)}
+    {}
+
+    ~MemoryAllocationTagScope()
+    {
+        TrackingMemoryAllocator::SetThreadTag(m_PrevTag);
+    }
+
+    // clang-format off
+    MemoryAllocationTagScope           (const MemoryAllocationTagScope&) = delete;
+    MemoryAllocationTagScope           (MemoryAllocationTagScope&&)      = delete;
+    MemoryAllocationTagScope& operator=(const MemoryAllocationTagScope&) = delete;
+    MemoryAllocationTagScope& operator=(MemoryAllocationTagScope&&)      = delete;
+    // clang-format on
+
+private:
+    const Uint32 m_PrevTag;
+};
+
+} // namespace Diligent
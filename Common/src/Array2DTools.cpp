@@ -29,6 +29,7 @@
 #include <algorithm>
 
 #include "Intrinsics.hpp"
+#include "CPUDispatch.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
 
@@ -57,13 +58,15 @@ void GetArray2DMinMaxValueGeneric(const float* pData,
     }
 }
 
-#if DILIGENT_AVX2_ENABLED
-bool GetArray2DMinMaxValueAVX2(const float* pData,
-                               size_t       StrideInFloats,
-                               Uint32       Width,
-                               Uint32       Height,
-                               float&       MinValue,
-                               float&       MaxValue)
+using GetArray2DMinMaxValueFuncType = void (*)(const float*, size_t, Uint32, Uint32, float&, float&);
+
+#if DILIGENT_AVX2_SUPPORTED
+DILIGENT_TARGET_AVX2 void GetArray2DMinMaxValueAVX2(const float* pData,
+                                                    size_t       StrideInFloats,
+                                                    Uint32       Width,
+                                                    Uint32       Height,
+                                                    float&       MinValue,
+                                                    float&       MaxValue)
 {
     MinValue   = pData[0];
     MaxValue   = pData[0];
@@ -122,8 +125,6 @@ bool GetArray2DMinMaxValueAVX2(const float* pData,
     _mm_store_ss(&Max0, mMax0123);
     MinValue = std::min(Min0, MinValue);
     MaxValue = std::max(Max0, MaxValue);
-
-    return true;
 }
 #endif
 
@@ -144,12 +145,18 @@ void GetArray2DMinMaxValue(const float* pData,
     DEV_CHECK_ERR(AlignDown(pData, alignof(float)) == pData, "Data pointer is not naturally aligned");
 
     MinValue = MaxValue = pData[0];
-#if DILIGENT_AVX2_ENABLED
-    if (GetArray2DMinMaxValueAVX2(pData, StrideInFloats, Width, Height, MinValue, MaxValue))
-        return;
-#endif
 
-    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+    // The AVX2 version is selected at run time, so it is used even if AVX2 is not enabled for the build
+#if DILIGENT_AVX2_SUPPORTED
+    static const GetArray2DMinMaxValueFuncType GetMinMaxValue = SelectCPUKernel<GetArray2DMinMaxValueFuncType>(
+        {
+            {CPU_FEATURE_FLAG_AVX2, GetArray2DMinMaxValueAVX2},
+        },
+        GetArray2DMinMaxValueGeneric);
+#else
+    const GetArray2DMinMaxValueFuncType GetMinMaxValue = GetArray2DMinMaxValueGeneric;
+#endif
+    GetMinMaxValue(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
 }
 
 } // namespace Diligent
@@ -38,16 +38,135 @@ static size_t AdjustBlockSize(size_t BlockSize)
     return AlignUp(BlockSize, sizeof(void*));
 }
 
+namespace
+{
+
+// Registry of live allocators that use thread caches. Thread caches use it to
+// find out if the allocator is still alive before returning blocks to it.
+struct ThreadCachedAllocatorRegistry
+{
+    std::mutex                                            Mtx;
+    std::unordered_map<Uint64, FixedBlockMemoryAllocator*> Allocators;
+};
+
+ThreadCachedAllocatorRegistry& GetThreadCachedAllocatorRegistry()
+{
+    static ThreadCachedAllocatorRegistry Registry;
+    return Registry;
+}
+
+std::atomic<Uint64> NextAllocatorId{1};
+
+// Set when the thread cache of the current thread has been destroyed
+// (e.g. objects released during static destruction), after which the
+// allocators fall back to the locked path.
+thread_local bool ThreadCacheDestroyed = false;
+
+} // namespace
+
+class FixedBlockMemoryAllocator::ThreadCache
+{
+public:
+    struct Entry
+    {
+        Uint64                     AllocatorId = 0;
+        FixedBlockMemoryAllocator* pAllocator  = nullptr;
+
+        Magazine Loaded;
+        Magazine Previous;
+    };
+
+    static ThreadCache* Get()
+    {
+        if (ThreadCacheDestroyed)
+            return nullptr;
+
+        static thread_local ThreadCache Cache;
+        return &Cache;
+    }
+
+    Entry& GetEntry(FixedBlockMemoryAllocator& Allocator)
+    {
+        if (m_pLastEntry != nullptr && m_pLastEntry->AllocatorId == Allocator.m_Id)
+            return *m_pLastEntry;
+
+        auto it = m_Entries.find(Allocator.m_Id);
+        if (it == m_Entries.end())
+        {
+            // Every pipeline resource signature has its own allocators, so a thread
+            // may touch many of them. Purge entries of destroyed allocators when
+            // the number of entries doubles to keep the cost amortized.
+            if (m_Entries.size() >= m_PurgeThreshold)
+            {
+                RemoveStaleEntries();
+                m_PurgeThreshold = std::max(m_Entries.size() * 2, size_t{MinPurgeThreshold});
+            }
+
+            Entry NewEntry;
+            NewEntry.AllocatorId = Allocator.m_Id;
+            NewEntry.pAllocator  = &Allocator;
+            it                   = m_Entries.emplace(Allocator.m_Id, NewEntry).first;
+        }
+        m_pLastEntry = &it->second;
+        return it->second;
+    }
+
+    ~ThreadCache()
+    {
+        ThreadCacheDestroyed = true;
+
+        // Return cached blocks to the allocators that are still alive
+        auto&                       Registry = GetThreadCachedAllocatorRegistry();
+        std::lock_guard<std::mutex> Lock{Registry.Mtx};
+        for (auto& it : m_Entries)
+        {
+            auto& Entry = it.second;
+            if (Registry.Allocators.find(Entry.AllocatorId) == Registry.Allocators.end())
+                continue;
+
+            Entry.pAllocator->ReleaseMagazine(Entry.Loaded);
+            Entry.pAllocator->ReleaseMagazine(Entry.Previous);
+        }
+    }
+
+private:
+    // Removes entries of allocators that have been destroyed. Their blocks were
+    // released together with the allocator pages.
+    void RemoveStaleEntries()
+    {
+        auto&                       Registry = GetThreadCachedAllocatorRegistry();
+        std::lock_guard<std::mutex> Lock{Registry.Mtx};
+        for (auto it = m_Entries.begin(); it != m_Entries.end();)
+        {
+            if (Registry.Allocators.find(it->first) == Registry.Allocators.end())
+                it = m_Entries.erase(it);
+            else
+                ++it;
+        }
+        m_pLastEntry = nullptr;
+    }
+
+    static constexpr size_t MinPurgeThreshold = 16;
+
+    std::unordered_map<Uint64, Entry> m_Entries;
+    Entry*                            m_pLastEntry     = nullptr;
+    size_t                            m_PurgeThreshold = MinPurgeThreshold;
+};
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     Uint32            ThreadCacheSize) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
     m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
     m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
+    m_Depot             (STD_ALLOCATOR_RAW_MEM(Magazine, RawMemoryAllocator, "Allocator for vector<Magazine>")),
     m_RawMemoryAllocator{RawMemoryAllocator        },
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_NumBlocksInPage   {NumBlocksInPage           },
+    m_ThreadCacheSize   {BlockSize > 0 ? ThreadCacheSize : 0},
+    m_Id                {NextAllocatorId.fetch_add(1)}
 // clang-format on
 {
     // Allocate one page
@@ -55,15 +174,38 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
     {
         CreateNewPage();
     }
+
+    if (m_ThreadCacheSize > 0)
+    {
+        auto&                       Registry = GetThreadCachedAllocatorRegistry();
+        std::lock_guard<std::mutex> Lock{Registry.Mtx};
+        Registry.Allocators.emplace(m_Id, this);
+    }
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    if (m_ThreadCacheSize > 0)
+    {
+        // After the allocator is removed from the registry, thread caches never touch it again.
+        // Blocks that remain in the caches are released together with the pages.
+        auto&                       Registry = GetThreadCachedAllocatorRegistry();
+        std::lock_guard<std::mutex> Lock{Registry.Mtx};
+        Registry.Allocators.erase(m_Id);
+    }
+
 #ifdef DILIGENT_DEBUG
-    for (size_t p = 0; p < m_PagePool.size(); ++p)
+    if (m_ThreadCacheSize > 0)
     {
-        VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
-        VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+        VERIFY(m_dbgNumCachedAllocations == 0, "Memory leak detected: ", m_dbgNumCachedAllocations.load(), " block(s) have not been freed");
+    }
+    else
+    {
+        for (size_t p = 0; p < m_PagePool.size(); ++p)
+        {
+            VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
+            VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+        }
     }
 #endif
 }
@@ -76,15 +218,8 @@ void FixedBlockMemoryAllocator::CreateNewPage()
     m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+void* FixedBlockMemoryAllocator::AllocateBlock()
 {
-    VERIFY_EXPR(Size > 0);
-
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
@@ -102,10 +237,9 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeBlock(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
+    auto PageIdIt = m_AddrToPageId.find(Ptr);
     if (PageIdIt != m_AddrToPageId.end())
     {
         auto PageId = PageIdIt->second;
@@ -128,4 +262,99 @@ void FixedBlockMemoryAllocator::Free(void* Ptr)
     }
 }
 
+FixedBlockMemoryAllocator::Magazine FixedBlockMemoryAllocator::AcquireMagazine()
+{
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+
+    Magazine Mag;
+    if (!m_Depot.empty())
+    {
+        Mag = m_Depot.back();
+        m_Depot.pop_back();
+    }
+    else
+    {
+        // Carve a new batch of blocks from the pages
+        for (Uint32 i = 0; i < m_ThreadCacheSize; ++i)
+            Mag.Push(AllocateBlock());
+    }
+    return Mag;
+}
+
+void FixedBlockMemoryAllocator::ReleaseMagazine(Magazine& Mag)
+{
+    if (Mag.NumBlocks == 0)
+        return;
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    m_Depot.push_back(Mag);
+    Mag = {};
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    if (m_ThreadCacheSize > 0)
+    {
+        if (auto* pCache = ThreadCache::Get())
+        {
+            auto& Entry = pCache->GetEntry(*this);
+            if (Entry.Loaded.NumBlocks == 0)
+            {
+                if (Entry.Previous.NumBlocks > 0)
+                    std::swap(Entry.Loaded, Entry.Previous);
+                else
+                    Entry.Loaded = AcquireMagazine();
+            }
+
+            auto* Ptr = Entry.Loaded.Pop();
+            FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+#ifdef DILIGENT_DEBUG
+            ++m_dbgNumCachedAllocations;
+#endif
+            return Ptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+#ifdef DILIGENT_DEBUG
+    if (m_ThreadCacheSize > 0)
+        ++m_dbgNumCachedAllocations;
+#endif
+    return AllocateBlock();
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    if (m_ThreadCacheSize > 0)
+    {
+#ifdef DILIGENT_DEBUG
+        --m_dbgNumCachedAllocations;
+#endif
+        if (auto* pCache = ThreadCache::Get())
+        {
+            auto& Entry = pCache->GetEntry(*this);
+            if (Entry.Loaded.NumBlocks >= m_ThreadCacheSize)
+            {
+                // Previous magazine is either empty or full: send it to the depot
+                // and start a new one.
+                ReleaseMagazine(Entry.Previous);
+                Entry.Previous = Entry.Loaded;
+                Entry.Loaded   = {};
+            }
+
+            FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+            Entry.Loaded.Push(Ptr);
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    FreeBlock(Ptr);
+}
+
 } // namespace Diligent
@@ -0,0 +1,281 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LZCompression.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace Diligent
+{
+
+// The compressed stream is a sequence of blocks:
+//
+//   | Token | Literal length ext | Literals | Match offset | Match length ext |
+//
+// The high 4 bits of the token contain the number of literals, and the low 4 bits
+// contain the match length minus MinMatchLength. The value of 15 indicates
+// that the length continues in the following bytes: each 255 byte is added
+// to the length until a byte less than 255 is encountered.
+// Match offset is a 16-bit little-endian distance back from the current position.
+// The last block only contains literals.
+
+namespace
+{
+
+constexpr size_t MinMatchLength = 4;
+constexpr size_t MaxMatchOffset = 65535;
+constexpr Uint32 HashTableBits  = 14;
+constexpr Uint32 LengthMask     = 15;
+
+inline Uint32 Read32(const Uint8* pData)
+{
+    Uint32 Value;
+    memcpy(&Value, pData, sizeof(Value));
+    return Value;
+}
+
+inline Uint32 HashSequence(Uint32 Sequence)
+{
+    return (Sequence * 2654435761u) >> (32 - HashTableBits);
+}
+
+class OutputStream
+{
+public:
+    OutputStream(Uint8* pDst, size_t Size) :
+        m_pPtr{pDst},
+        m_pEnd{pDst + Size}
+    {}
+
+    bool WriteByte(Uint8 Byte)
+    {
+        if (m_pPtr == m_pEnd)
+            return false;
+        *m_pPtr++ = Byte;
+        return true;
+    }
+
+    bool WriteLengthExt(size_t Length)
+    {
+        for (; Length >= 255; Length -= 255)
+        {
+            if (!WriteByte(255))
+                return false;
+        }
+        return WriteByte(static_cast<Uint8>(Length));
+    }
+
+    bool WriteBytes(const Uint8* pData, size_t Size)
+    {
+        if (static_cast<size_t>(m_pEnd - m_pPtr) < Size)
+            return false;
+        memcpy(m_pPtr, pData, Size);
+        m_pPtr += Size;
+        return true;
+    }
+
+    const Uint8* GetPtr() const { return m_pPtr; }
+
+private:
+    Uint8*       m_pPtr;
+    Uint8* const m_pEnd;
+};
+
+bool WriteBlock(OutputStream& Out,
+                const Uint8*  pLiterals,
+                size_t        NumLiterals,
+                size_t        MatchOffset,
+                size_t        MatchLength)
+{
+    const auto LiteralBits = NumLiterals < LengthMask ? NumLiterals : LengthMask;
+    const auto MatchBits   = MatchLength == 0 ? 0 : (MatchLength - MinMatchLength < LengthMask ? MatchLength - MinMatchLength : LengthMask);
+
+    if (!Out.WriteByte(static_cast<Uint8>((LiteralBits << 4u) | MatchBits)))
+        return false;
+
+    if (LiteralBits == LengthMask && !Out.WriteLengthExt(NumLiterals - LengthMask))
+        return false;
+
+    if (!Out.WriteBytes(pLiterals, NumLiterals))
+        return false;
+
+    if (MatchLength == 0)
+        return true; // Last block
+
+    if (!Out.WriteByte(static_cast<Uint8>(MatchOffset & 0xFF)) ||
+        !Out.WriteByte(static_cast<Uint8>(MatchOffset >> 8u)))
+        return false;
+
+    if (MatchBits == LengthMask && !Out.WriteLengthExt(MatchLength - MinMatchLength - LengthMask))
+        return false;
+
+    return true;
+}
+
+bool ReadLengthExt(const Uint8*& pSrc, const Uint8* pSrcEnd, size_t& Length)
+{
+    Uint8 Byte = 0;
+    do
+    {
+        if (pSrc == pSrcEnd)
+            return false;
+        Byte = *pSrc++;
+        Length += Byte;
+    } while (Byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t GetLZCompressedSizeBound(size_t SrcSize)
+{
+    // Worst case: a single literal-only block
+    return 1 + SrcSize / 255 + 1 + SrcSize;
+}
+
+size_t LZCompress(const void* pSrc,
+                  size_t      SrcSize,
+                  void*       pDst,
+                  size_t      DstSize)
+{
+    if (pDst == nullptr || (pSrc == nullptr && SrcSize != 0))
+        return 0;
+
+    const auto* const pSrcStart = static_cast<const Uint8*>(pSrc);
+    const auto* const pSrcEnd   = pSrcStart + SrcSize;
+
+    OutputStream Out{static_cast<Uint8*>(pDst), DstSize};
+
+    // Positions of the last occurrence of every hashed 4-byte sequence.
+    // Zero-initialized entries point to the first byte, which is never a valid match
+    // for itself, and are verified like any other candidate.
+    std::vector<Uint32> HashTable(size_t{1} << HashTableBits);
+
+    const auto* pCurr   = pSrcStart;
+    const auto* pAnchor = pSrcStart;
+    while (SrcSize >= MinMatchLength && pCurr <= pSrcEnd - MinMatchLength)
+    {
+        const auto Sequence = Read32(pCurr);
+        auto&      Entry    = HashTable[HashSequence(Sequence)];
+        const auto pRef     = pSrcStart + Entry;
+        Entry               = static_cast<Uint32>(pCurr - pSrcStart);
+
+        if (pRef >= pCurr || static_cast<size_t>(pCurr - pRef) > MaxMatchOffset || Read32(pRef) != Sequence)
+        {
+            // Skip faster through data that does not compress
+            pCurr += 1 + ((pCurr - pAnchor) >> 6);
+            continue;
+        }
+
+        const auto* pMatchEnd = pCurr + MinMatchLength;
+        const auto* pRefEnd   = pRef + MinMatchLength;
+        while (pMatchEnd < pSrcEnd && *pMatchEnd == *pRefEnd)
+        {
+            ++pMatchEnd;
+            ++pRefEnd;
+        }
+
+        if (!WriteBlock(Out, pAnchor, pCurr - pAnchor, pCurr - pRef, pMatchEnd - pCurr))
+            return 0;
+
+        pCurr   = pMatchEnd;
+        pAnchor = pCurr;
+    }
+
+    if (!WriteBlock(Out, pAnchor, pSrcEnd - pAnchor, 0, 0))
+        return 0;
+
+    return Out.GetPtr() - static_cast<Uint8*>(pDst);
+}
+
+bool LZDecompress(const void* pSrc,
+                  size_t      SrcSize,
+                  void*       pDst,
+                  size_t      DstSize)
+{
+    if (pSrc == nullptr || (pDst == nullptr && DstSize != 0))
+        return false;
+
+    const auto*       pIn     = static_cast<const Uint8*>(pSrc);
+    const auto* const pInEnd  = pIn + SrcSize;
+    auto* const       pOutBeg = static_cast<Uint8*>(pDst);
+    auto*             pOut    = pOutBeg;
+    auto* const       pOutEnd = pOut + DstSize;
+
+    while (pIn < pInEnd)
+    {
+        const auto Token = *pIn++;
+
+        size_t NumLiterals = Token >> 4u;
+        if (NumLiterals == LengthMask && !ReadLengthExt(pIn, pInEnd, NumLiterals))
+            return false;
+
+        if (NumLiterals > static_cast<size_t>(pInEnd - pIn) || NumLiterals > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        memcpy(pOut, pIn, NumLiterals);
+        pIn += NumLiterals;
+        pOut += NumLiterals;
+
+        if (pIn == pInEnd)
+            return pOut == pOutEnd; // Last block
+
+        if (pInEnd - pIn < 2)
+            return false;
+
+        const size_t MatchOffset = size_t{pIn[0]} | (size_t{pIn[1]} << 8u);
+        pIn += 2;
+        if (MatchOffset == 0 || MatchOffset > static_cast<size_t>(pOut - pOutBeg))
+            return false;
+
+        size_t MatchLength = Token & LengthMask;
+        if (MatchLength == LengthMask && !ReadLengthExt(pIn, pInEnd, MatchLength))
+            return false;
+        MatchLength += MinMatchLength;
+
+        if (MatchLength > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        const auto* pMatch = pOut - MatchOffset;
+        if (MatchOffset >= MatchLength)
+        {
+            memcpy(pOut, pMatch, MatchLength);
+            pOut += MatchLength;
+        }
+        else
+        {
+            // Overlapping match repeats the last MatchOffset bytes
+            for (size_t i = 0; i < MatchLength; ++i)
+                *pOut++ = *pMatch++;
+        }
+    }
+
+    // Empty compressed stream is invalid
+    return false;
+}
+
+} // namespace Diligent
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "MappedFileStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Diligent
+{
+
+RefCntAutoPtr<MappedFileStream> MappedFileStream::Create(const char* Path)
+{
+    RefCntAutoPtr<MappedFileDataBlob> pData = MappedFileDataBlob::Create(Path);
+    if (!pData)
+        return {};
+
+    return RefCntAutoPtr<MappedFileStream>{MakeNewRCObj<MappedFileStream>()(pData.RawPtr())};
+}
+
+MappedFileStream::MappedFileStream(IReferenceCounters* pRefCounters, MappedFileDataBlob* pData) :
+    TBase{pRefCounters},
+    m_pData{pData}
+{
+}
+
+IMPLEMENT_QUERY_INTERFACE2(MappedFileStream, IID_FileStream, IID_MappedFileStream, TBase)
+
+bool MappedFileStream::Read(void* Data, size_t Size)
+{
+    VERIFY_EXPR(m_CurrentOffset <= m_pData->GetSize());
+    const size_t BytesToRead = std::min(m_pData->GetSize() - m_CurrentOffset, Size);
+    if (BytesToRead > 0)
+        memcpy(Data, static_cast<const Uint8*>(m_pData->GetConstDataPtr()) + m_CurrentOffset, BytesToRead);
+    m_CurrentOffset += BytesToRead;
+    return Size == BytesToRead;
+}
+
+void MappedFileStream::ReadBlob(IDataBlob* pData)
+{
+    pData->Resize(m_pData->GetSize() - m_CurrentOffset);
+    auto res = Read(pData->GetDataPtr(), pData->GetSize());
+    VERIFY_EXPR(res);
+    (void)res;
+}
+
+bool MappedFileStream::Write(const void* Data, size_t Size)
+{
+    DEV_ERROR("Memory-mapped file stream is read-only");
+    return false;
+}
+
+size_t MappedFileStream::GetSize()
+{
+    return m_pData->GetSize();
+}
+
+bool MappedFileStream::IsValid()
+{
+    return m_pData != nullptr;
+}
+
+void PrefetchMappedData(const IDataBlob* pData)
+{
+    if (pData == nullptr)
+        return;
+
+    const volatile Uint8* pBytes = static_cast<const Uint8*>(pData->GetConstDataPtr());
+    const size_t          Size   = pData->GetSize();
+
+    // Read one byte from every page. The pages are then resident in the page cache and
+    // the process working set, so that subsequent accesses don't wait for the disk.
+    constexpr size_t PageSize = 4096;
+    Uint8            Sum      = 0;
+    for (size_t Offset = 0; Offset < Size; Offset += PageSize)
+        Sum += pBytes[Offset];
+    (void)Sum;
+}
+
+} // namespace Diligent
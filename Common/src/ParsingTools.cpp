@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ParsingTools.hpp"
+
+#include "Intrinsics.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace Parsing
+{
+
+namespace
+{
+
+// Returns true for the characters that are skipped by SkipIdentifierCharsFast.
+// This is equivalent to isalnum(c) || c == '_' in the "C" locale.
+bool IsIdentifierChar(Char c) noexcept
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// The vectorized functions load 16 characters at a time and compute the mask of the characters
+// where scanning must stop. The characters after the last full group of 16 are processed by the
+// scalar loops.
+
+#if DILIGENT_SSE2_ENABLED
+
+using CharsType = __m128i;
+
+inline CharsType Or(CharsType a, CharsType b)
+{
+    return _mm_or_si128(a, b);
+}
+
+inline CharsType Not(CharsType a)
+{
+    return _mm_xor_si128(a, _mm_set1_epi32(-1));
+}
+
+inline CharsType Equal(CharsType Chars, Char c)
+{
+    return _mm_cmpeq_epi8(Chars, _mm_set1_epi8(c));
+}
+
+inline CharsType InRange(CharsType Chars, Char First, Char Last)
+{
+    // All ranges are within [1, 127], so the signed comparison rejects characters >= 0x80
+    return _mm_and_si128(_mm_cmpgt_epi8(Chars, _mm_set1_epi8(static_cast<char>(First - 1))),
+                         _mm_cmplt_epi8(Chars, _mm_set1_epi8(static_cast<char>(Last + 1))));
+}
+
+template <typename StopMaskFuncType>
+const Char* SkipChars(const Char* Pos, const Char* End, StopMaskFuncType StopMask) noexcept
+{
+    for (; End - Pos >= 16; Pos += 16)
+    {
+        const int Mask = _mm_movemask_epi8(StopMask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Pos))));
+        if (Mask != 0)
+            return Pos + PlatformMisc::GetLSB(static_cast<Uint32>(Mask));
+    }
+    return Pos;
+}
+
+#elif DILIGENT_NEON_ENABLED
+
+using CharsType = uint8x16_t;
+
+inline CharsType Or(CharsType a, CharsType b)
+{
+    return vorrq_u8(a, b);
+}
+
+inline CharsType Not(CharsType a)
+{
+    return vmvnq_u8(a);
+}
+
+inline CharsType Equal(CharsType Chars, Char c)
+{
+    return vceqq_u8(Chars, vdupq_n_u8(static_cast<Uint8>(c)));
+}
+
+inline CharsType InRange(CharsType Chars, Char First, Char Last)
+{
+    // Unsigned comparison rejects characters >= 0x80
+    return vcleq_u8(vsubq_u8(Chars, vdupq_n_u8(static_cast<Uint8>(First))), vdupq_n_u8(static_cast<Uint8>(Last - First)));
+}
+
+template <typename StopMaskFuncType>
+const Char* SkipChars(const Char* Pos, const Char* End, StopMaskFuncType StopMask) noexcept
+{
+    for (; End - Pos >= 16; Pos += 16)
+    {
+        const uint8x16_t Stop = StopMask(vld1q_u8(reinterpret_cast<const Uint8*>(Pos)));
+        // Narrow every 8-bit lane of the mask to 4 bits
+        const Uint64 Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Stop), 4)), 0);
+        if (Mask != 0)
+            return Pos + PlatformMisc::GetLSB(Mask) / 4;
+    }
+    return Pos;
+}
+
+#endif
+
+} // namespace
+
+const Char* SkipDelimitersFast(const Char* Start, const Char* End) noexcept
+{
+    const Char* Pos = Start;
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    Pos = SkipChars(Pos, End, [](CharsType Chars) {
+        return Not(Or(Or(Equal(Chars, ' '), Equal(Chars, '\t')), Or(Equal(Chars, '\r'), Equal(Chars, '\n'))));
+    });
+#endif
+    while (Pos != End && IsDelimiter(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+const Char* SkipToNewLineOrNullFast(const Char* Start, const Char* End) noexcept
+{
+    const Char* Pos = Start;
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    Pos = SkipChars(Pos, End, [](CharsType Chars) {
+        return Or(Or(Equal(Chars, '\r'), Equal(Chars, '\n')), Equal(Chars, '\0'));
+    });
+#endif
+    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+const Char* SkipToAsteriskOrNullFast(const Char* Start, const Char* End) noexcept
+{
+    const Char* Pos = Start;
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    Pos = SkipChars(Pos, End, [](CharsType Chars) {
+        return Or(Equal(Chars, '*'), Equal(Chars, '\0'));
+    });
+#endif
+    while (Pos != End && *Pos != '*' && *Pos != '\0')
+        ++Pos;
+    return Pos;
+}
+
+const Char* SkipIdentifierCharsFast(const Char* Start, const Char* End) noexcept
+{
+    const Char* Pos = Start;
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+    Pos = SkipChars(Pos, End, [](CharsType Chars) {
+        const CharsType IsAlpha = Or(InRange(Chars, 'a', 'z'), InRange(Chars, 'A', 'Z'));
+        return Not(Or(Or(IsAlpha, InRange(Chars, '0', '9')), Equal(Chars, '_')));
+    });
+#endif
+    while (Pos != End && IsIdentifierChar(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+} // namespace Parsing
+
+} // namespace Diligent
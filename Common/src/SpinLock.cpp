@@ -28,6 +28,21 @@
 
 #include <thread>
 
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+#    include "../../Platforms/Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Platforms/Win32/interface/WinHPostface.h"
+#    define USE_WAIT_ON_ADDRESS 1
+#elif PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    define USE_FUTEX 1
+#else
+#    include <condition_variable>
+#    include <mutex>
+#endif
+
 #if defined(_MSC_VER) && ((_M_IX86_FP >= 2) || defined(_M_X64))
 #    include <emmintrin.h>
 #    define PAUSE _mm_pause
@@ -59,4 +74,114 @@ void SpinLock::Wait() noexcept
     std::this_thread::yield();
 }
 
+
+constexpr Diligent::Uint32 AdaptiveSpinLock::Unlocked;
+constexpr Diligent::Uint32 AdaptiveSpinLock::Locked;
+constexpr Diligent::Uint32 AdaptiveSpinLock::LockedWithWaiters;
+
+void AdaptiveSpinLock::LockContended() noexcept
+{
+    m_ContentionCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Spin with exponential backoff: 1, 2, 4, ... 64 pauses between attempts.
+    constexpr Diligent::Uint32 MaxPauseCount = 64;
+    for (Diligent::Uint32 PauseCount = 1; PauseCount <= MaxPauseCount; PauseCount *= 2)
+    {
+        for (Diligent::Uint32 i = 0; i < PauseCount; ++i)
+            PAUSE();
+
+        if (try_lock())
+            return;
+    }
+
+    // Give the lock owner a chance to run.
+    constexpr Diligent::Uint32 NumYields = 4;
+    for (Diligent::Uint32 i = 0; i < NumYields; ++i)
+    {
+        m_YieldCount.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+
+        if (try_lock())
+            return;
+    }
+
+    // Mark the lock as having waiters, so that unlock() wakes one of them.
+    // If the lock was released in the meantime, we have acquired it.
+    while (m_State.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked)
+    {
+        m_ParkCount.fetch_add(1, std::memory_order_relaxed);
+        Park();
+    }
+}
+
+#if USE_WAIT_ON_ADDRESS
+
+void AdaptiveSpinLock::Park() noexcept
+{
+    Diligent::Uint32 Expected = LockedWithWaiters;
+    WaitOnAddress(&m_State, &Expected, sizeof(Expected), INFINITE);
+}
+
+void AdaptiveSpinLock::WakeOne() noexcept
+{
+    WakeByAddressSingle(&m_State);
+}
+
+#elif USE_FUTEX
+
+static_assert(sizeof(std::atomic<Diligent::Uint32>) == sizeof(Diligent::Uint32), "Futex requires a 32-bit atomic");
+
+void AdaptiveSpinLock::Park() noexcept
+{
+    // The call returns immediately if the state is no longer LockedWithWaiters.
+    syscall(SYS_futex, reinterpret_cast<Diligent::Uint32*>(&m_State), FUTEX_WAIT_PRIVATE, LockedWithWaiters, nullptr, nullptr, 0);
+}
+
+void AdaptiveSpinLock::WakeOne() noexcept
+{
+    syscall(SYS_futex, reinterpret_cast<Diligent::Uint32*>(&m_State), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+#else
+
+namespace
+{
+
+// Waiting threads are parked on one of the condition variables selected by the lock address.
+struct ParkingSlot
+{
+    std::mutex              Mtx;
+    std::condition_variable CondVar;
+};
+
+ParkingSlot& GetParkingSlot(const void* Address)
+{
+    static ParkingSlot Slots[64];
+    return Slots[(reinterpret_cast<size_t>(Address) >> 4) % 64];
+}
+
+} // namespace
+
+void AdaptiveSpinLock::Park() noexcept
+{
+    ParkingSlot&                 Slot = GetParkingSlot(&m_State);
+    std::unique_lock<std::mutex> Lock{Slot.Mtx};
+    // WakeOne() locks the same mutex, so the notification can't be lost
+    // between the state check and the wait.
+    if (m_State.load(std::memory_order_relaxed) == LockedWithWaiters)
+        Slot.CondVar.wait(Lock);
+}
+
+void AdaptiveSpinLock::WakeOne() noexcept
+{
+    ParkingSlot& Slot = GetParkingSlot(&m_State);
+    {
+        std::lock_guard<std::mutex> Lock{Slot.Mtx};
+    }
+    // Other locks may share the slot, so wake all threads and let them recheck their state.
+    Slot.CondVar.notify_all();
+}
+
+#endif
+
 } // namespace Threading
@@ -26,12 +26,19 @@
 
 #include "ThreadPool.hpp"
 
+#include <algorithm>
+#include <array>
 #include <mutex>
+#include <memory>
 #include <thread>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <condition_variable>
 
+#include "PlatformDefinitions.h"
+#include "PlatformMisc.hpp"
+
 namespace Diligent
 {
 
@@ -39,6 +46,32 @@ AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
+// Sets the OS priority and the core affinity of the current worker thread
+static void ConfigureWorkerThread(ThreadPriority Priority, CPUCoreType Cores)
+{
+#if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+    if (Cores != CPUCoreType::Any)
+    {
+        const Uint64 Mask = PlatformMisc::GetCPUCoreMask(Cores);
+        if (Mask == 0 || PlatformMisc::SetCurrentThreadAffinity(Mask) == 0)
+        {
+            LOG_WARNING_MESSAGE_ONCE("Failed to pin thread pool worker threads to ",
+                                     (Cores == CPUCoreType::Performance ? "performance" : "efficiency"),
+                                     " cores. The threads will run on all cores.");
+        }
+    }
+
+    if (Priority != ThreadPriority::Unknown)
+    {
+        if (PlatformMisc::SetCurrentThreadPriority(Priority) == ThreadPriority::Unknown)
+            LOG_WARNING_MESSAGE_ONCE("Failed to set the priority of thread pool worker threads.");
+    }
+#else
+    if (Cores != CPUCoreType::Any || Priority != ThreadPriority::Unknown)
+        LOG_WARNING_MESSAGE_ONCE("Thread pool worker thread priority and affinity are not supported on this platform.");
+#endif
+}
+
 class ThreadPoolImpl final : public ObjectBase<IThreadPool>
 {
 public:
@@ -46,7 +79,13 @@ public:
 
     ThreadPoolImpl(IReferenceCounters*         pRefCounters,
                    const ThreadPoolCreateInfo& PoolCI) :
-        TBase{pRefCounters}
+        TBase{pRefCounters},
+        // In work-stealing mode, every worker thread has its own queue.
+        // Otherwise, all threads share the same queue.
+        m_Queues(PoolCI.EnableWorkStealing ? std::max(PoolCI.NumThreads, size_t{1}) : 1),
+        // Keep at least one thread that processes the normal and background lanes
+        m_NumCriticalThreads{PoolCI.NumThreads > 0 ? std::min(PoolCI.NumCriticalThreads, PoolCI.NumThreads - 1) : 0},
+        m_MaxBackgroundThreads{static_cast<int>(PoolCI.MaxBackgroundThreads)}
     {
         m_WorkerThreads.reserve(PoolCI.NumThreads);
         for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
@@ -54,6 +93,11 @@ public:
             m_WorkerThreads.emplace_back(
                 [this, PoolCI, i] //
                 {
+                    if (i < m_NumCriticalThreads)
+                        ConfigureWorkerThread(PoolCI.CriticalThreadPriority, PoolCI.CriticalThreadCores);
+                    else
+                        ConfigureWorkerThread(PoolCI.WorkerThreadPriority, PoolCI.WorkerThreadCores);
+
                     if (PoolCI.OnThreadStarted)
                         PoolCI.OnThreadStarted(i);
 
@@ -71,39 +115,34 @@ public:
 
     virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
     {
-        RefCntAutoPtr<IAsyncTask> pTask;
-        {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-            if (WaitForTask)
-            {
-                // The effects of notify_one()/notify_all() and each of the three atomic parts of
-                // wait()/wait_for()/wait_until() (unlock+wait, wakeup, and lock) take place in a
-                // single total order that can be viewed as modification order of an atomic variable:
-                // the order is specific to this individual condition variable. This makes it impossible
-                // for notify_one() to, for example, be delayed and unblock a thread that started waiting
-                // just after the call to notify_one() was made.
-                m_NextTaskCond.wait(lock,
-                                    [this] //
-                                    {
-                                        return m_Stop.load() || !m_TasksQueue.empty();
-                                    } //
-                );
-            }
+        // Reserved threads only process the critical lane
+        const bool IsCriticalThread = ThreadId < m_NumCriticalThreads;
+        // The shared mutex is only acquired when there are no tasks and the thread goes to sleep
+        if (WaitForTask && !HasRunnableTasks(IsCriticalThread))
+            WaitForRunnableTask(IsCriticalThread);
 
-            // m_Stop must be accessed under the mutex
-            if (m_Stop.load() && m_TasksQueue.empty())
-                return false;
+        if (m_Stop.load() && !HasQueuedTasks(IsCriticalThread))
+            return false;
 
-            if (!m_TasksQueue.empty())
-            {
-                auto front = m_TasksQueue.begin();
-                pTask      = std::move(front->second);
-                // NB: we must increment the running task counter while holding the lock and
-                //     before removing the task from the queue, otherwise WaitForAllTasks() may
-                //     miss the task.
-                m_NumRunningTasks.fetch_add(1);
-                m_TasksQueue.erase(front);
-            }
+        // Take the task from the most important lane that has tasks
+        RefCntAutoPtr<IAsyncTask> pTask;
+        THREAD_POOL_LANE          TaskLane = THREAD_POOL_LANE_COUNT;
+
+        const Uint32 NumLanes = IsCriticalThread ? 1 : THREAD_POOL_LANE_COUNT;
+        for (Uint32 Lane = 0; Lane < NumLanes && !pTask; ++Lane)
+        {
+            if (m_NumQueuedTasks[Lane].load() == 0)
+                continue;
+
+            const bool IsBackground = Lane == THREAD_POOL_LANE_BACKGROUND;
+            if (IsBackground && !AcquireBackgroundSlot())
+                continue;
+
+            pTask = PopTask(ThreadId, static_cast<THREAD_POOL_LANE>(Lane));
+            if (pTask)
+                TaskLane = static_cast<THREAD_POOL_LANE>(Lane);
+            else if (IsBackground)
+                ReleaseBackgroundSlot();
         }
 
         if (pTask)
@@ -114,61 +153,80 @@ public:
                            pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
                           "Finished tasks must be in COMPLETE or CANCELLED state");
 
-            {
-                std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            if (TaskLane == THREAD_POOL_LANE_BACKGROUND)
+                ReleaseBackgroundSlot();
 
-                const auto NumRunningTasks = m_NumRunningTasks.fetch_add(-1) - 1;
-                if (m_TasksQueue.empty() && NumRunningTasks == 0)
-                {
-                    m_TasksFinishedCond.notify_one();
-                }
-            }
+            m_NumRunningTasks.fetch_add(-1);
+            OnTaskFinished();
+        }
+        else if (m_Stop.load())
+        {
+            // The remaining tasks may be background tasks that wait for a free background slot
+            std::this_thread::yield();
         }
 
         return true;
     }
 
-    virtual void EnqueueTask(IAsyncTask* pTask) override final
+    virtual void EnqueueTask(IAsyncTask*      pTask,
+                             IAsyncTask**     ppPrerequisites,
+                             Uint32           NumPrerequisites,
+                             THREAD_POOL_LANE Lane) override final
     {
         VERIFY_EXPR(pTask != nullptr);
         if (pTask == nullptr)
             return;
 
+        DEV_CHECK_ERR(Lane < THREAD_POOL_LANE_COUNT, "Invalid thread pool lane");
+        if (Lane >= THREAD_POOL_LANE_COUNT)
+            Lane = THREAD_POOL_LANE_NORMAL;
+
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+        DEV_CHECK_ERR(NumPrerequisites == 0 || ppPrerequisites != nullptr, "ppPrerequisites must not be null when NumPrerequisites is not zero");
+
+        m_NumPendingTasks.fetch_add(1);
+
+        if (NumPrerequisites > 0)
         {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-            DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+            {
+                std::unique_lock<std::mutex> lock{m_WaitingTasksMtx};
 
-            m_TasksQueue.emplace(pTask->GetPriority(), pTask);
+                const auto Inserted = m_WaitingTasks.emplace(pTask, WaitingTask{pTask, ppPrerequisites, NumPrerequisites, Lane}).second;
+                DEV_CHECK_ERR(Inserted, "The task is already waiting for its prerequisites");
+                if (Inserted)
+                    m_NumWaitingTasks.fetch_add(1);
+            }
+
+            // The task is moved to the queue when all its prerequisites are complete
+            UpdateWaitingTask(pTask);
+            return;
         }
-        m_NextTaskCond.notify_one();
+
+        PushReadyTask(RefCntAutoPtr<IAsyncTask>{pTask}, Lane);
     }
 
     virtual void WaitForAllTasks() override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0)
-        {
-            m_TasksFinishedCond.wait(lock,
-                                     [this] //
-                                     {
-                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0;
-                                     } //
-            );
-        }
+        std::unique_lock<std::mutex> lock{m_SignalMtx};
+        m_TasksFinishedCond.wait(lock,
+                                 [this] //
+                                 {
+                                     return AllTasksFinished();
+                                 } //
+        );
     }
 
     virtual void StopThreads() override final
     {
         {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
             // NB: even if the shared variable is atomic, it must be modified under the mutex
-            //     in order to correctly publish the modification to the waiting thread.
+            //     in order to correctly publish the modification to the sleeping threads.
             m_Stop.store(true);
+            // The sleeping threads remove themselves from the list when they wake up
+            for (auto* pThread : m_SleepingThreads)
+                pThread->Cond.notify_one();
         }
-        // Note that if there are outstanding tasks in the queue, the threads may be woken up
-        // by the corresponding notify_one() as notify*() and wait*() take place in a single
-        // total order.
-        m_NextTaskCond.notify_all();
         for (std::thread& worker : m_WorkerThreads)
             worker.join();
 
@@ -177,109 +235,607 @@ public:
 
     virtual bool RemoveTask(IAsyncTask* pTask, bool CancelIfRunning) override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+        for (auto& Queue : m_Queues)
         {
-            m_TasksQueue.erase(it);
-            return true;
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            TaskQueue::TasksMapType::iterator it;
+
+            const auto Lane = Queue.FindTask(pTask, it);
+            if (Lane != THREAD_POOL_LANE_COUNT)
+            {
+                Queue.Lanes[Lane].erase(it);
+                Queue.UpdateLaneInfo(Lane);
+                m_NumQueuedTasks[Lane].fetch_add(-1);
+                lock.unlock();
+
+                // The removed task will never complete, so the tasks that wait for it are cancelled
+                CancelDependentTasks(pTask);
+
+                OnTaskFinished();
+                return true;
+            }
         }
-        else
+
         {
-            if (CancelIfRunning)
-                pTask->Cancel();
+            std::unique_lock<std::mutex> lock{m_WaitingTasksMtx};
+
+            auto it = m_WaitingTasks.find(pTask);
+            if (it != m_WaitingTasks.end())
+            {
+                m_WaitingTasks.erase(it);
+                m_NumWaitingTasks.fetch_add(-1);
+                lock.unlock();
 
-            return pTask->IsFinished();
+                CancelDependentTasks(pTask);
+
+                OnTaskFinished();
+                return true;
+            }
         }
+
+        if (CancelIfRunning)
+            pTask->Cancel();
+
+        return pTask->IsFinished();
     }
 
     virtual bool ReprioritizeTask(IAsyncTask* pTask) override final
     {
         const auto Priority = pTask->GetPriority();
 
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+        for (auto& Queue : m_Queues)
         {
-            if (it->first != Priority)
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            TaskQueue::TasksMapType::iterator it;
+
+            const auto Lane = Queue.FindTask(pTask, it);
+            if (Lane != THREAD_POOL_LANE_COUNT)
             {
-                auto pExistingTask = std::move(it->second);
-                m_TasksQueue.erase(it);
-                m_TasksQueue.emplace(Priority, std::move(pExistingTask));
+                if (it->first != Priority)
+                {
+                    auto& Tasks         = Queue.Lanes[Lane];
+                    auto  pExistingTask = std::move(it->second);
+                    Tasks.erase(it);
+                    Tasks.emplace(Priority, std::move(pExistingTask));
+                    Queue.UpdateLaneInfo(Lane);
+                }
+
+                return true;
             }
+        }
+
+        {
+            // Tasks that are waiting for their prerequisites are placed
+            // into the queue with their current priority when they are ready.
+            std::unique_lock<std::mutex> lock{m_WaitingTasksMtx};
+            return m_WaitingTasks.find(pTask) != m_WaitingTasks.end();
+        }
+    }
+
+    virtual void ReprioritizeAllTasks() override final
+    {
+        for (auto& Queue : m_Queues)
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            Queue.ReprioritizeAll();
+        }
+    }
+
+    Uint32 GetQueueSize() override final
+    {
+        return StaticCast<Uint32>(GetNumQueuedTasks() + m_NumWaitingTasks.load());
+    }
+
+    virtual Uint32 GetRunningTaskCount() const override final
+    {
+        return m_NumRunningTasks.load();
+    }
+
+    ~ThreadPoolImpl()
+    {
+        StopThreads();
+        m_pCallbackTarget->Detach();
+        VERIFY(m_NumWaitingTasks.load() == 0, "Destroying the thread pool while there are tasks waiting for their prerequisites. "
+                                              "This may indicate that prerequisites of these tasks were never enqueued into this pool.");
+        VERIFY_EXPR(GetNumQueuedTasks() == 0);
+        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+    }
 
+private:
+    bool AllTasksFinished() const
+    {
+        return m_NumPendingTasks.load() == 0;
+    }
+
+    int GetNumQueuedTasks() const
+    {
+        int NumTasks = 0;
+        for (const auto& NumLaneTasks : m_NumQueuedTasks)
+            NumTasks += NumLaneTasks.load();
+        return NumTasks;
+    }
+
+    // Returns true if there are queued tasks that the thread may process
+    bool HasQueuedTasks(bool IsCriticalThread) const
+    {
+        return IsCriticalThread ?
+            m_NumQueuedTasks[THREAD_POOL_LANE_CRITICAL].load() > 0 :
+            GetNumQueuedTasks() > 0;
+    }
+
+    // Returns true if there are queued tasks that the thread may start right now
+    bool HasRunnableTasks(bool IsCriticalThread) const
+    {
+        if (m_NumQueuedTasks[THREAD_POOL_LANE_CRITICAL].load() > 0)
+            return true;
+        if (IsCriticalThread)
+            return false;
+        if (m_NumQueuedTasks[THREAD_POOL_LANE_NORMAL].load() > 0)
+            return true;
+        return (m_NumQueuedTasks[THREAD_POOL_LANE_BACKGROUND].load() > 0 &&
+                (m_MaxBackgroundThreads == 0 || m_NumRunningBackgroundTasks.load() < m_MaxBackgroundThreads));
+    }
+
+    bool AcquireBackgroundSlot()
+    {
+        if (m_MaxBackgroundThreads == 0)
             return true;
+
+        int NumRunning = m_NumRunningBackgroundTasks.load();
+        while (NumRunning < m_MaxBackgroundThreads)
+        {
+            if (m_NumRunningBackgroundTasks.compare_exchange_weak(NumRunning, NumRunning + 1))
+                return true;
         }
         return false;
     }
 
-    virtual void ReprioritizeAllTasks() override final
+    void ReleaseBackgroundSlot()
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        if (m_MaxBackgroundThreads == 0)
+            return;
+
+        m_NumRunningBackgroundTasks.fetch_add(-1);
+        // Wake up a thread that may be waiting for a free background slot
+        if (m_NumQueuedTasks[THREAD_POOL_LANE_BACKGROUND].load() > 0)
+            WakeThread(THREAD_POOL_LANE_BACKGROUND);
+    }
 
-        m_ReprioritizationList.clear();
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end())
+    // Takes the highest-priority task from the given lane across all queues.
+    // The queue is selected without locking using the priorities of the first tasks,
+    // and the thread's own queue is preferred if the priorities are equal.
+    // If the pool does not use work stealing, there is only one queue.
+    RefCntAutoPtr<IAsyncTask> PopTask(Uint32 ThreadId, THREAD_POOL_LANE Lane)
+    {
+        const size_t NumQueues = m_Queues.size();
+        // The selected queue may be emptied by another thread before the mutex is acquired,
+        // in which case the selection is repeated.
+        for (size_t Attempt = 0; Attempt < NumQueues; ++Attempt)
         {
-            auto pTask    = it->second;
-            auto Priority = pTask->GetPriority();
-            if (it->first != Priority)
+            TaskQueue* pQueue      = nullptr;
+            float      TopPriority = 0;
+            for (size_t i = 0; i < NumQueues; ++i)
             {
-                it = m_TasksQueue.erase(it);
-                m_ReprioritizationList.emplace_back(Priority, std::move(pTask));
+                auto& Queue = m_Queues[(ThreadId + i) % NumQueues];
+                if (Queue.NumTasks[Lane].load() == 0)
+                    continue;
+
+                const auto Priority = Queue.TopPriority[Lane].load();
+                if (pQueue == nullptr || Priority > TopPriority)
+                {
+                    pQueue      = &Queue;
+                    TopPriority = Priority;
+                }
             }
-            else
+            if (pQueue == nullptr)
+                break;
+
+            auto& Tasks = pQueue->Lanes[Lane];
+
+            std::unique_lock<std::mutex> lock{pQueue->Mtx};
+            if (!Tasks.empty())
             {
-                ++it;
+                auto front = Tasks.begin();
+                auto pTask = std::move(front->second);
+                m_NumRunningTasks.fetch_add(1);
+                m_NumQueuedTasks[Lane].fetch_add(-1);
+                Tasks.erase(front);
+                pQueue->UpdateLaneInfo(Lane);
+                return pTask;
             }
         }
+        return {};
+    }
 
-        if (!m_ReprioritizationList.empty())
-            m_TasksQueue.insert(m_ReprioritizationList.begin(), m_ReprioritizationList.end());
+    // Must be called when the task has been finished or removed from the pool
+    void OnTaskFinished()
+    {
+        if (m_NumPendingTasks.fetch_add(-1) - 1 == 0)
+        {
+            {
+                // Acquire the mutex to make sure that WaitForAllTasks() does not miss the notification
+                std::unique_lock<std::mutex> lock{m_SignalMtx};
+            }
+            m_TasksFinishedCond.notify_all();
+        }
+    }
 
-        m_ReprioritizationList.clear();
+    // WasWaiting indicates that the task is moved to the queue from the waiting task list
+    void PushReadyTask(RefCntAutoPtr<IAsyncTask> pTask, THREAD_POOL_LANE Lane, bool WasWaiting = false)
+    {
+        // Distribute tasks between the queues in a round-robin fashion
+        auto& Queue = m_Queues.size() > 1 ?
+            m_Queues[m_NextQueueIdx.fetch_add(1) % m_Queues.size()] :
+            m_Queues[0];
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            const auto                   Priority = pTask->GetPriority();
+            Queue.Lanes[Lane].emplace(Priority, std::move(pTask));
+            Queue.UpdateLaneInfo(Lane);
+            m_NumQueuedTasks[Lane].fetch_add(1);
+            // NB: the waiting task counter is decremented after the task is placed into the queue
+            //     so that GetQueueSize() does not miss the task, but before the task can be taken
+            //     from the queue so that the counter is up to date when the task finishes.
+            if (WasWaiting)
+                m_NumWaitingTasks.fetch_add(-1);
+        }
+
+        WakeThread(Lane);
     }
 
-    Uint32 GetQueueSize() override final
+    // Suspends the calling thread until there is a task it can run or the pool is stopped
+    void WaitForRunnableTask(bool IsCriticalThread)
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        return StaticCast<Uint32>(m_TasksQueue.size());
+        SleepingThread Thread{IsCriticalThread};
+        auto&          NumSleepingThreads = IsCriticalThread ? m_NumSleepingCriticalThreads : m_NumSleepingThreads;
+
+        std::unique_lock<std::mutex> lock{m_SleepMtx};
+        m_SleepingThreads.push_back(&Thread);
+        // NB: the sleeping thread counter must be incremented before the tasks are checked.
+        //     WakeThread() is called after the task counter is incremented and reads the
+        //     sleeping thread counter, so either we see the task, or it sees this thread.
+        NumSleepingThreads.fetch_add(1);
+
+        Thread.Cond.wait(lock,
+                         [&] //
+                         {
+                             return Thread.Signaled || m_Stop.load() || HasRunnableTasks(IsCriticalThread);
+                         } //
+        );
+
+        if (!Thread.Signaled)
+        {
+            // The thread has not been woken up by WakeThread(), so it is still in the list
+            m_SleepingThreads.erase(std::find(m_SleepingThreads.begin(), m_SleepingThreads.end(), &Thread));
+            NumSleepingThreads.fetch_add(-1);
+        }
     }
 
-    virtual Uint32 GetRunningTaskCount() const override final
+    // Wakes up one sleeping thread that can run the tasks from the given lane
+    void WakeThread(THREAD_POOL_LANE Lane)
     {
-        return m_NumRunningTasks.load();
+        const bool IsCritical = Lane == THREAD_POOL_LANE_CRITICAL;
+        // Critical tasks may be run by any thread, while the reserved threads only run critical tasks
+        if (m_NumSleepingThreads.load() == 0 && (!IsCritical || m_NumSleepingCriticalThreads.load() == 0))
+            return;
+
+        std::unique_lock<std::mutex> lock{m_SleepMtx};
+
+        // Wake up the most recently suspended thread, preferring the reserved threads for critical tasks
+        const auto FindThread = [this](bool IsCriticalThread) {
+            return std::find_if(m_SleepingThreads.rbegin(), m_SleepingThreads.rend(),
+                                [IsCriticalThread](const SleepingThread* pThread) {
+                                    return pThread->IsCriticalThread == IsCriticalThread;
+                                });
+        };
+        auto it = FindThread(IsCritical);
+        if (it == m_SleepingThreads.rend() && IsCritical)
+            it = FindThread(false);
+        if (it == m_SleepingThreads.rend())
+            return;
+
+        auto* pThread = *it;
+        m_SleepingThreads.erase(std::next(it).base());
+        (pThread->IsCriticalThread ? m_NumSleepingCriticalThreads : m_NumSleepingThreads).fetch_add(-1);
+        pThread->Signaled = true;
+        // The condition variable is owned by the sleeping thread and is destroyed as soon as the
+        // thread wakes up, so it must be notified while the mutex is held.
+        pThread->Cond.notify_one();
     }
 
-    ~ThreadPoolImpl()
+    // Checks the prerequisites of the waiting task. If all of them are complete, the task is moved
+    // to the queue, and if any of them was cancelled, the task is cancelled too. Otherwise, the
+    // method is called again when the first unfinished prerequisite finishes, so prerequisites
+    // may be finished by any thread.
+    void UpdateWaitingTask(IAsyncTask* pTask)
     {
-        StopThreads();
-        VERIFY_EXPR(m_TasksQueue.empty());
-        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+        RefCntAutoPtr<IAsyncTask> pPrerequisite;
+        RefCntAutoPtr<IAsyncTask> pFinishedTask;
+        THREAD_POOL_LANE          Lane  = THREAD_POOL_LANE_NORMAL;
+        ASYNC_TASK_STATUS         State = ASYNC_TASK_STATUS_NOT_STARTED;
+        {
+            std::unique_lock<std::mutex> lock{m_WaitingTasksMtx};
+
+            auto it = m_WaitingTasks.find(pTask);
+            // The task may have been removed from the pool
+            if (it == m_WaitingTasks.end())
+                return;
+
+            State = it->second.GetPrerequisitesState(pPrerequisite);
+            if (State != ASYNC_TASK_STATUS_NOT_STARTED)
+            {
+                pFinishedTask = std::move(it->second.pTask);
+                Lane          = it->second.Lane;
+                m_WaitingTasks.erase(it);
+            }
+        }
+
+        if (State == ASYNC_TASK_STATUS_NOT_STARTED)
+        {
+            // NB: the callback is called immediately if the prerequisite has finished after it was checked.
+            //     The callback must not be called while the mutex is held.
+            pPrerequisite->AddFinishedCallback(
+                [pTarget = m_pCallbackTarget, pTask]() //
+                {
+                    pTarget->UpdateWaitingTask(pTask);
+                });
+        }
+        else if (State == ASYNC_TASK_STATUS_COMPLETE)
+        {
+            PushReadyTask(std::move(pFinishedTask), Lane, /*WasWaiting = */ true);
+        }
+        else
+        {
+            // The tasks that wait for this task are cancelled by its callbacks
+            pFinishedTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+            m_NumWaitingTasks.fetch_add(-1);
+            OnTaskFinished();
+        }
+    }
+
+    // Cancels the tasks that wait for the task that has been removed from the pool and will never finish
+    void CancelDependentTasks(const IAsyncTask* pRemovedTask)
+    {
+        if (m_NumWaitingTasks.load() == 0)
+            return;
+
+        std::vector<RefCntAutoPtr<IAsyncTask>> DependentTasks;
+        {
+            std::unique_lock<std::mutex> lock{m_WaitingTasksMtx};
+            for (auto it = m_WaitingTasks.begin(); it != m_WaitingTasks.end();)
+            {
+                if (it->second.DependsOn(pRemovedTask))
+                {
+                    DependentTasks.emplace_back(std::move(it->second.pTask));
+                    it = m_WaitingTasks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        // The tasks that wait for the cancelled tasks are cancelled by their callbacks
+        for (auto& pTask : DependentTasks)
+        {
+            pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+            m_NumWaitingTasks.fetch_add(-1);
+            OnTaskFinished();
+        }
     }
 
+    // A task that waits for its prerequisites to complete
+    struct WaitingTask
+    {
+        RefCntAutoPtr<IAsyncTask>              pTask;
+        std::vector<RefCntAutoPtr<IAsyncTask>> Prerequisites;
+        THREAD_POOL_LANE                       Lane;
+
+        WaitingTask(IAsyncTask* _pTask, IAsyncTask** ppPrerequisites, Uint32 NumPrerequisites, THREAD_POOL_LANE _Lane) :
+            pTask{_pTask},
+            Prerequisites{ppPrerequisites, ppPrerequisites + NumPrerequisites},
+            Lane{_Lane}
+        {}
+
+        // Returns ASYNC_TASK_STATUS_COMPLETE if all prerequisites are complete,
+        // ASYNC_TASK_STATUS_CANCELLED if any prerequisite was cancelled,
+        // and ASYNC_TASK_STATUS_NOT_STARTED otherwise, in which case
+        // pUnfinishedPrerequisite is set to the first prerequisite that is not finished.
+        ASYNC_TASK_STATUS GetPrerequisitesState(RefCntAutoPtr<IAsyncTask>& pUnfinishedPrerequisite) const
+        {
+            for (const auto& pPrerequisite : Prerequisites)
+            {
+                if (!pPrerequisite)
+                    continue;
+
+                const auto Status = pPrerequisite->GetStatus();
+                if (Status == ASYNC_TASK_STATUS_CANCELLED)
+                    return ASYNC_TASK_STATUS_CANCELLED;
+                if (Status != ASYNC_TASK_STATUS_COMPLETE && !pUnfinishedPrerequisite)
+                    pUnfinishedPrerequisite = pPrerequisite;
+            }
+            return pUnfinishedPrerequisite ? ASYNC_TASK_STATUS_NOT_STARTED : ASYNC_TASK_STATUS_COMPLETE;
+        }
+
+        bool DependsOn(const IAsyncTask* pPrerequisite) const
+        {
+            return (pPrerequisite != nullptr &&
+                    std::find(Prerequisites.begin(), Prerequisites.end(), pPrerequisite) != Prerequisites.end());
+        }
+    };
+
+    // Tasks notify the pool through this object when they finish, see UpdateWaitingTask().
+    // A task may finish after the pool has been destroyed, so the callbacks keep a reference
+    // to this object rather than to the pool.
+    class CallbackTarget
+    {
+    public:
+        explicit CallbackTarget(ThreadPoolImpl* pPool) :
+            m_pPool{pPool}
+        {}
+
+        void UpdateWaitingTask(IAsyncTask* pTask)
+        {
+            // NB: the counter is incremented before the pool pointer is read, while Detach() resets
+            //     the pointer before it reads the counter, so either we see the null pointer, or
+            //     Detach() waits until this call returns.
+            m_NumActiveCalls.fetch_add(1);
+            if (auto* pPool = m_pPool.load())
+                pPool->UpdateWaitingTask(pTask);
+            m_NumActiveCalls.fetch_add(-1);
+        }
+
+        // Must be called before the pool is destroyed
+        void Detach()
+        {
+            m_pPool.store(nullptr);
+            while (m_NumActiveCalls.load() > 0)
+                std::this_thread::yield();
+        }
+
+    private:
+        std::atomic<ThreadPoolImpl*> m_pPool;
+        std::atomic<int>             m_NumActiveCalls{0};
+    };
+
+    // A thread that waits for a task in ProcessTask(). Every sleeping thread has its own
+    // condition variable, so that a new task only wakes up one thread that can run it.
+    struct SleepingThread
+    {
+        const bool              IsCriticalThread;
+        bool                    Signaled = false;
+        std::condition_variable Cond;
+
+        explicit SleepingThread(bool _IsCriticalThread) :
+            IsCriticalThread{_IsCriticalThread}
+        {}
+    };
+
 private:
     std::vector<std::thread> m_WorkerThreads;
 
-    // Priority queue
-    std::mutex                                                           m_TasksQueueMtx;
-    std::multimap<float, RefCntAutoPtr<IAsyncTask>, std::greater<float>> m_TasksQueue;
+    // Priority queue with a separate task map for every lane
+    struct TaskQueue
+    {
+        using TasksMapType = std::multimap<float, RefCntAutoPtr<IAsyncTask>, std::greater<float>>;
+
+        std::mutex                                       Mtx;
+        std::array<TasksMapType, THREAD_POOL_LANE_COUNT> Lanes;
+
+        // The number of tasks and the priority of the first task in every lane.
+        // The values are modified under the mutex, but are read without it to select
+        // the queue to take the next task from.
+        std::array<std::atomic<int>, THREAD_POOL_LANE_COUNT>   NumTasks{};
+        std::array<std::atomic<float>, THREAD_POOL_LANE_COUNT> TopPriority{};
+
+        // Must be called under the mutex after the lane has been modified
+        void UpdateLaneInfo(Uint32 Lane)
+        {
+            const auto& Tasks = Lanes[Lane];
+            if (!Tasks.empty())
+                TopPriority[Lane].store(Tasks.begin()->first);
+            NumTasks[Lane].store(static_cast<int>(Tasks.size()));
+        }
+
+        // Returns the lane that contains the task and sets it to the task position,
+        // or returns THREAD_POOL_LANE_COUNT if the task is not found.
+        THREAD_POOL_LANE FindTask(IAsyncTask* pTask, TasksMapType::iterator& it)
+        {
+            for (Uint32 Lane = 0; Lane < THREAD_POOL_LANE_COUNT; ++Lane)
+            {
+                auto& Tasks = Lanes[Lane];
+                for (it = Tasks.begin(); it != Tasks.end(); ++it)
+                {
+                    if (it->second == pTask)
+                        return static_cast<THREAD_POOL_LANE>(Lane);
+                }
+            }
+            return THREAD_POOL_LANE_COUNT;
+        }
+
+        void ReprioritizeAll()
+        {
+            for (Uint32 Lane = 0; Lane < THREAD_POOL_LANE_COUNT; ++Lane)
+            {
+                ReprioritizeAll(Lanes[Lane]);
+                UpdateLaneInfo(Lane);
+            }
+        }
+
+    private:
+        void ReprioritizeAll(TasksMapType& Tasks)
+        {
+            ReprioritizationList.clear();
+            auto it = Tasks.begin();
+            while (it != Tasks.end())
+            {
+                auto pTask    = it->second;
+                auto Priority = pTask->GetPriority();
+                if (it->first != Priority)
+                {
+                    it = Tasks.erase(it);
+                    ReprioritizationList.emplace_back(Priority, std::move(pTask));
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            if (!ReprioritizationList.empty())
+                Tasks.insert(ReprioritizationList.begin(), ReprioritizationList.end());
+
+            ReprioritizationList.clear();
+        }
+
+        std::vector<std::pair<float, RefCntAutoPtr<IAsyncTask>>> ReprioritizationList;
+    };
+    std::vector<TaskQueue> m_Queues;
+    std::atomic<size_t>    m_NextQueueIdx{0};
+
+    std::mutex                                   m_WaitingTasksMtx;
+    std::unordered_map<IAsyncTask*, WaitingTask> m_WaitingTasks;
+
+    const std::shared_ptr<CallbackTarget> m_pCallbackTarget = std::make_shared<CallbackTarget>(this);
+
+    // The number of worker threads reserved for the critical lane
+    const size_t m_NumCriticalThreads;
+    // The maximum number of threads running background tasks, or 0 if there is no limit
+    const int m_MaxBackgroundThreads;
 
-    std::vector<std::pair<float, RefCntAutoPtr<IAsyncTask>>> m_ReprioritizationList;
+    // Protects the list of sleeping threads. Only acquired by the threads that go to sleep
+    // and by the threads that wake them up.
+    std::mutex                   m_SleepMtx;
+    std::vector<SleepingThread*> m_SleepingThreads;
+    // The number of sleeping threads that are not reserved for the critical lane
+    std::atomic<int> m_NumSleepingThreads{0};
+    // The number of sleeping threads reserved for the critical lane
+    std::atomic<int>  m_NumSleepingCriticalThreads{0};
+    std::atomic<bool> m_Stop{false};
 
-    std::condition_variable m_NextTaskCond{};
+    std::mutex              m_SignalMtx;
     std::condition_variable m_TasksFinishedCond{};
-    std::atomic<bool>       m_Stop{false};
 
+    // The total number of tasks that have been enqueued and are not finished yet
+    std::atomic<int> m_NumPendingTasks{0};
+    // The number of tasks that wait for their prerequisites
+    std::atomic<int> m_NumWaitingTasks{0};
+    // The number of tasks in the queues, per lane
+    std::array<std::atomic<int>, THREAD_POOL_LANE_COUNT> m_NumQueuedTasks{};
+    // The number of tasks being run
     std::atomic<int> m_NumRunningTasks{0};
+    // The number of background tasks being run. Only tracked if m_MaxBackgroundThreads is not 0.
+    std::atomic<int> m_NumRunningBackgroundTasks{0};
 };
 
+size_t GetDefaultThreadPoolSize()
+{
+    return std::max(size_t{PlatformMisc::GetCPUInfo().NumPhysicalCores}, size_t{1});
+}
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
     return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TrackingMemoryAllocator.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct AllocationHeader
+{
+    size_t Size;
+    Uint32 Tag;
+};
+static_assert(sizeof(AllocationHeader) <= TrackingMemoryAllocator::HeaderSize, "Allocation header does not fit into the reserved space");
+
+thread_local Uint32 CurrentThreadTag = 0;
+
+} // namespace
+
+void* TrackingMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+    Uint8* pBlock = static_cast<Uint8*>(m_Backend.Allocate(Size + HeaderSize, dbgDescription, dbgFileName, dbgLineNumber));
+    if (pBlock == nullptr)
+        return nullptr;
+
+    const Uint32 Tag = std::min(CurrentThreadTag, MaxTags - 1);
+
+    AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(pBlock);
+    pHeader->Size             = Size;
+    pHeader->Tag              = Tag;
+
+    TagCounters& Counters = m_Counters[Tag];
+    Counters.CurrentAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    Counters.TotalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t NewSize  = Counters.CurrentSize.fetch_add(Size, std::memory_order_relaxed) + Size;
+    size_t       PeakSize = Counters.PeakSize.load(std::memory_order_relaxed);
+    while (NewSize > PeakSize && !Counters.PeakSize.compare_exchange_weak(PeakSize, NewSize, std::memory_order_relaxed))
+    {
+    }
+
+    return pBlock + HeaderSize;
+}
+
+void TrackingMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    Uint8*                  pBlock  = static_cast<Uint8*>(Ptr) - HeaderSize;
+    const AllocationHeader* pHeader = reinterpret_cast<const AllocationHeader*>(pBlock);
+    VERIFY(pHeader->Tag < MaxTags, "Invalid allocation tag. The memory may not have been allocated by this allocator.");
+
+    TagCounters& Counters = m_Counters[pHeader->Tag];
+    VERIFY(Counters.CurrentSize.load(std::memory_order_relaxed) >= pHeader->Size, "Releasing more memory than was allocated");
+    Counters.CurrentSize.fetch_sub(pHeader->Size, std::memory_order_relaxed);
+    Counters.CurrentAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+
+    m_Backend.Free(pBlock);
+}
+
+TrackingMemoryAllocator::TagStatistics TrackingMemoryAllocator::GetTagStatistics(Uint32 Tag) const
+{
+    TagStatistics Stats;
+    if (Tag < MaxTags)
+    {
+        const TagCounters& Counters = m_Counters[Tag];
+
+        Stats.CurrentSize            = Counters.CurrentSize.load(std::memory_order_relaxed);
+        Stats.PeakSize               = Counters.PeakSize.load(std::memory_order_relaxed);
+        Stats.CurrentAllocationCount = Counters.CurrentAllocationCount.load(std::memory_order_relaxed);
+        Stats.TotalAllocationCount   = Counters.TotalAllocationCount.load(std::memory_order_relaxed);
+    }
+    else
+    {
+        UNEXPECTED("Tag (", Tag, ") is out of range");
+    }
+    return Stats;
+}
+
+void TrackingMemoryAllocator::ResetPeakSizes()
+{
+    for (TagCounters& Counters : m_Counters)
+    {
+        Counters.PeakSize.store(Counters.CurrentSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+Uint32 TrackingMemoryAllocator::SetThreadTag(Uint32 Tag)
+{
+    const Uint32 PrevTag = CurrentThreadTag;
+    CurrentThreadTag     = Tag;
+    return PrevTag;
+}
+
+Uint32 TrackingMemoryAllocator::GetThreadTag()
+{
+    return CurrentThreadTag;
+}
+
+} // namespace Diligent
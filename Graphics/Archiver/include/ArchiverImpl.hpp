@@ -76,6 +76,10 @@ public:
     /// Implementation of IArchiver::AddPipelineResourceSignature().
     virtual Bool DILIGENT_CALL_TYPE AddPipelineResourceSignature(IPipelineResourceSignature* pSignature) override final;
 
+    /// Implementation of IArchiver::SetPipelineStateCacheData().
+    virtual Bool DILIGENT_CALL_TYPE SetPipelineStateCacheData(ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag,
+                                                              IDataBlob*                pData) override final;
+
     /// Implementation of IArchiver::Reset().
     virtual void DILIGENT_CALL_TYPE Reset() override final;
 
@@ -115,6 +119,9 @@ private:
 
     std::mutex     m_PipelinesMtx;
     PSOHashMapType m_Pipelines;
+
+    std::mutex                                                                   m_PipelineCacheDataMtx;
+    std::array<RefCntAutoPtr<IDataBlob>, static_cast<size_t>(DeviceType::Count)> m_PipelineCacheData;
 };
 
 } // namespace Diligent
@@ -53,9 +53,11 @@ public:
 
     // clang-format off
     UNSUPPORTED_METHOD(void, CreateGraphicsPipelineState,   const GraphicsPipelineStateCreateInfo&   PSOCreateInfo, IPipelineState** ppPipelineState)
+    UNSUPPORTED_METHOD(void, CreateDerivedGraphicsPipelineState, const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
     UNSUPPORTED_METHOD(void, CreateComputePipelineState,    const ComputePipelineStateCreateInfo&    PSOCreateInfo, IPipelineState** ppPipelineState)
     UNSUPPORTED_METHOD(void, CreateRayTracingPipelineState, const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
     UNSUPPORTED_METHOD(void, CreateTilePipelineState,       const TilePipelineStateCreateInfo&       PSOCreateInfo, IPipelineState** ppPipelineState)
+    UNSUPPORTED_METHOD(void, CreateWorkGraphPipelineState,  const WorkGraphPipelineStateCreateInfo&  PSOCreateInfo, IPipelineState** ppPipelineState)
 
     UNSUPPORTED_METHOD(void, CreateShader,      const ShaderCreateInfo&  CreateInfo, IShader** ppShader)
 
@@ -164,6 +166,8 @@ public:
     const VkProperties&    GetVkProperties() const { return m_VkProps; }
     const MtlProperties&   GetMtlProperties() const { return m_MtlProps; }
 
+    bool GetCompressShaders() const { return m_CompressShaders; }
+
     IRenderDevice* GetRenderDevice(RENDER_DEVICE_TYPE Type)
     {
         return m_RenderDevices[Type];
@@ -200,6 +204,8 @@ private:
     VkProperties    m_VkProps;
     MtlProperties   m_MtlProps;
 
+    const bool m_CompressShaders;
+
     std::vector<PipelineResourceBinding> m_ResourceBindings;
 
     std::array<RefCntAutoPtr<IRenderDevice>, RENDER_DEVICE_TYPE_COUNT> m_RenderDevices;
@@ -69,6 +69,8 @@ public:
 
     // clang-format off
     UNSUPPORTED_METHOD      (void, CreateShaderResourceBinding, IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
+    UNSUPPORTED_METHOD      (void, CreateShaderResourceBindings, Uint32 NumSRBs, IShaderResourceBinding** ppShaderResourceBindings, bool InitStaticResources)
+    UNSUPPORTED_METHOD      (void, CloneShaderResourceBinding,  IShaderResourceBinding* pSrcSRB, IShaderResourceBinding** ppShaderResourceBinding)
     UNSUPPORTED_METHOD      (void, BindStaticResources,         SHADER_TYPE ShaderStages, IResourceMapping* pResourceMapping, BIND_SHADER_RESOURCES_FLAGS Flags)
     UNSUPPORTED_METHOD      (IShaderResourceVariable*, GetStaticVariableByName, SHADER_TYPE ShaderType, const Char* Name)
     UNSUPPORTED_METHOD      (IShaderResourceVariable*, GetStaticVariableByIndex, SHADER_TYPE ShaderType, Uint32 Index)
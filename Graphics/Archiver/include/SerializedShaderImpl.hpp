@@ -65,6 +65,9 @@ public:
     UNSUPPORTED_CONST_METHOD(IObject*, GetUserData)
     UNSUPPORTED_CONST_METHOD(void, GetBytecode, const void** ppBytecode, Uint64& Size);
 
+    // Serialized shaders are always compiled synchronously
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final { return SHADER_STATUS_READY; }
+
     virtual IShader* DILIGENT_CALL_TYPE GetDeviceShader(RENDER_DEVICE_TYPE Type) const override final;
 
     struct CompiledShader
@@ -89,7 +92,8 @@ public:
         return m_CreateInfo;
     }
 
-    static SerializedData SerializeCreateInfo(const ShaderCreateInfo& CI);
+    // Reflection is the optional device-specific reflection data that is stored after the create info.
+    static SerializedData SerializeCreateInfo(const ShaderCreateInfo& CI, const SerializedData& Reflection = {});
 
     bool operator==(const SerializedShaderImpl& Rhs) const noexcept;
     bool operator!=(const SerializedShaderImpl& Rhs) const noexcept
@@ -103,6 +107,10 @@ private:
 
     std::array<std::unique_ptr<CompiledShader>, static_cast<size_t>(DeviceType::Count)> m_Shaders;
 
+    void CreateDeviceShader(IReferenceCounters*       pRefCounters,
+                            const ShaderCreateInfo&   DeviceShaderCI,
+                            ARCHIVE_DEVICE_DATA_FLAGS Flag) noexcept(false);
+
     template <typename ShaderType, typename... ArgTypes>
     void CreateShader(DeviceType              Type,
                       IReferenceCounters*     pRefCounters,
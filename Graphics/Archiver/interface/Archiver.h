@@ -147,6 +147,28 @@ DILIGENT_BEGIN_INTERFACE(IArchiver, IObject)
     VIRTUAL Bool METHOD(AddPipelineResourceSignature)(THIS_
                                                       IPipelineResourceSignature* pSignature) PURE;
 
+    /// Sets the pipeline state cache data for the given device type.
+
+    /// \param [in] DeviceFlag - Device type of the cache data, must be a single flag.
+    /// \param [in] pData      - Pipeline state cache data, e.g. the data returned by
+    ///                          IPipelineStateCache::GetData. If null, the cache data
+    ///                          of this device type is removed.
+    ///
+    /// \return     true if the data was set successfully, and false otherwise.
+    ///
+    /// \remarks    The data is stored in the archive as is, and is used by
+    ///             IDearchiver::UnpackPipelineStateCache to create the pipeline state cache.
+    ///             Metal binary archives can be produced on any device of the target
+    ///             platform, so that the pipelines do not have to be compiled for the GPU
+    ///             at run time. Vulkan and Direct3D12 cache data is only valid for the
+    ///             GPU and driver version it was produced with; the backend ignores
+    ///             incompatible data.
+    ///
+    ///     The method is thread-safe and may be called from multiple threads simultaneously.
+    VIRTUAL Bool METHOD(SetPipelineStateCacheData)(THIS_
+                                                   ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag,
+                                                   IDataBlob*                pData) PURE;
+
     /// Resets the archiver to default state and removes all added resources.
     VIRTUAL void METHOD(Reset)(THIS) PURE;
 
@@ -193,6 +215,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiver_AddShader(This, ...)                    CALL_IFACE_METHOD(Archiver, AddShader,                    This, __VA_ARGS__)
 #    define IArchiver_AddPipelineState(This, ...)             CALL_IFACE_METHOD(Archiver, AddPipelineState,             This, __VA_ARGS__)
 #    define IArchiver_AddPipelineResourceSignature(This, ...) CALL_IFACE_METHOD(Archiver, AddPipelineResourceSignature, This, __VA_ARGS__)
+#    define IArchiver_SetPipelineStateCacheData(This, ...)    CALL_IFACE_METHOD(Archiver, SetPipelineStateCacheData,    This, __VA_ARGS__)
 #    define IArchiver_GetShader(This, ...)                    CALL_IFACE_METHOD(Archiver, GetShader,                    This, __VA_ARGS__)
 #    define IArchiver_GetPipelineState(This, ...)             CALL_IFACE_METHOD(Archiver, GetPipelineState,             This, __VA_ARGS__)
 #    define IArchiver_GetPipelineResourceSignature(This, ...) CALL_IFACE_METHOD(Archiver, GetPipelineResourceSignature, This, __VA_ARGS__)
@@ -182,6 +182,21 @@ struct SerializationDeviceCreateInfo
     /// Metal attributes, see Diligent::SerializationDeviceMtlInfo.
     SerializationDeviceMtlInfo Metal;
 
+    /// Whether to compress shader byte code when the archiver serializes the archive.
+
+    /// \remarks   Every shader is compressed individually with a fast LZ-family codec,
+    ///             and is decompressed by the dearchiver on first use.
+    Bool CompressShaders DEFAULT_INITIALIZER(False);
+
+    /// An optional thread pool that is used to compile shaders for different backends in parallel.
+
+    /// \remarks   If the thread pool is null, shaders for all backends are compiled
+    ///            on the thread that calls ISerializationDevice::CreateShader.
+    ///            The device keeps a strong reference to the thread pool.
+    ///            ISerializationDevice::CreateShader waits for the pool's tasks and
+    ///            must not be called from the pool's worker threads.
+    struct IThreadPool* pCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     SerializationDeviceCreateInfo() noexcept
     {
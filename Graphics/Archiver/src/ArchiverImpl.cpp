@@ -37,7 +37,7 @@ namespace Diligent
 static DeviceObjectArchive::ResourceType PipelineTypeToArchiveResourceType(PIPELINE_TYPE PipelineType)
 {
     using ResourceType = DeviceObjectArchive::ResourceType;
-    static_assert(PIPELINE_TYPE_COUNT == 5, "Please handle the new pipeline type below");
+    static_assert(PIPELINE_TYPE_COUNT == 6, "Please handle the new pipeline type below");
     switch (PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -53,6 +53,10 @@ static DeviceObjectArchive::ResourceType PipelineTypeToArchiveResourceType(PIPEL
         case PIPELINE_TYPE_TILE:
             return ResourceType::TilePipeline;
 
+        case PIPELINE_TYPE_WORK_GRAPH:
+            UNSUPPORTED("Work graph pipelines can't be archived");
+            return ResourceType::Undefined;
+
         default:
             UNEXPECTED("Unexpected pipeline type");
             return ResourceType::Undefined;
@@ -75,9 +79,13 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
         return false;
 
     DeviceObjectArchive Archive;
+    if (m_pSerializationDevice->GetCompressShaders())
+        Archive.SetShaderCompression(DeviceObjectArchive::ShaderCompression::LZ);
 
-    // A hash map that maps shader byte code to the index in the archive, for each device type
-    std::array<std::unordered_map<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> BytecodeHashToIdx;
+    // A hash map that maps shader byte code to the index in the archive, for each device type.
+    // The keys reference the data of the shaders added to the archive and are compared by content,
+    // so that hash collisions never merge different shaders.
+    std::array<std::unordered_map<SerializedData, Uint32, SerializedData::Hasher>, static_cast<size_t>(DeviceType::Count)> BytecodeToIdx;
 
     // Add pipelines and patched shaders
     for (const auto& pso_it : m_Pipelines)
@@ -109,7 +117,7 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
             {
                 VERIFY_EXPR(SrcShader.Data);
 
-                auto it_inserted = BytecodeHashToIdx[device_type].emplace(SrcShader.Hash, StaticCast<Uint32>(DstShaders.size()));
+                auto it_inserted = BytecodeToIdx[device_type].emplace(SerializedData{SrcShader.Data.Ptr(), SrcShader.Data.Size()}, StaticCast<Uint32>(DstShaders.size()));
                 if (it_inserted.second)
                 {
                     // New byte code - add it
@@ -181,7 +189,7 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
                 continue;
 
             auto& DstShaders  = Archive.GetDeviceShaders(static_cast<DeviceType>(device_type));
-            auto  it_inserted = BytecodeHashToIdx[device_type].emplace(DeviceData.GetHash(), StaticCast<Uint32>(DstShaders.size()));
+            auto  it_inserted = BytecodeToIdx[device_type].emplace(SerializedData{DeviceData.Ptr(), DeviceData.Size()}, StaticCast<Uint32>(DstShaders.size()));
             if (it_inserted.second)
             {
                 // New byte code
@@ -202,6 +210,20 @@ Bool ArchiverImpl::SerializeToBlob(IDataBlob** ppBlob)
         }
     }
 
+    // Add pipeline state cache data
+    {
+        std::lock_guard<std::mutex> Guard{m_PipelineCacheDataMtx};
+        for (size_t device_type = 0; device_type < m_PipelineCacheData.size(); ++device_type)
+        {
+            if (const auto& pCacheData = m_PipelineCacheData[device_type])
+            {
+                // NB: since the Archive object is temporary, we do not need to copy the data
+                Archive.SetPipelineCacheData(static_cast<DeviceType>(device_type),
+                                             SerializedData{const_cast<void*>(pCacheData->GetConstDataPtr()), StaticCast<size_t>(pCacheData->GetSize())});
+            }
+        }
+    }
+
     Archive.Serialize(ppBlob);
 
     return *ppBlob != nullptr;
@@ -266,6 +288,26 @@ bool ArchiverImpl::AddPipelineResourceSignature(IPipelineResourceSignature* pPRS
     return AddObjectToArchive<SerializedResourceSignatureImpl>(pPRS, "Pipeline resource signature", IID_SerializedResourceSignature, m_SignaturesMtx, m_Signatures);
 }
 
+DeviceObjectArchive::DeviceType ArchiveDeviceDataFlagToArchiveDeviceType(ARCHIVE_DEVICE_DATA_FLAGS DataTypeFlag);
+
+Bool ArchiverImpl::SetPipelineStateCacheData(ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag, IDataBlob* pData)
+{
+    if (DeviceFlag == ARCHIVE_DEVICE_DATA_FLAG_NONE || !IsPowerOfTwo(DeviceFlag))
+    {
+        DEV_ERROR("DeviceFlag must be a single device data flag");
+        return false;
+    }
+
+    const auto DevType = ArchiveDeviceDataFlagToArchiveDeviceType(DeviceFlag);
+    if (DevType >= DeviceType::Count)
+        return false;
+
+    std::lock_guard<std::mutex> Guard{m_PipelineCacheDataMtx};
+    m_PipelineCacheData[static_cast<size_t>(DevType)] = pData != nullptr && pData->GetSize() > 0 ? pData : nullptr;
+
+    return true;
+}
+
 bool ArchiverImpl::AddRenderPass(IRenderPass* pRP)
 {
     return AddObjectToArchive<SerializedRenderPassImpl>(pRP, "Render pass", IID_SerializedRenderPass, m_RenderPassesMtx, m_RenderPasses);
@@ -341,6 +383,12 @@ void ArchiverImpl::Reset()
         std::lock_guard<std::mutex> Guard{m_ShadersMtx};
         m_Shaders.clear();
     }
+
+    {
+        std::lock_guard<std::mutex> Guard{m_PipelineCacheDataMtx};
+        for (auto& pCacheData : m_PipelineCacheData)
+            pCacheData.Release();
+    }
 }
 
 IShader* ArchiverImpl::GetShader(const char* Name)
@@ -355,7 +403,7 @@ static DeviceObjectArchive::ResourceType PiplineTypeToArchiveResourceType(PIPELI
 {
     using ResourceType = DeviceObjectArchive::ResourceType;
 
-    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? Please handle it here.");
+    static_assert(PIPELINE_TYPE_COUNT == 6, "Did you add a new pipeline type? Please handle it here.");
     switch (Type)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -371,6 +419,7 @@ static DeviceObjectArchive::ResourceType PiplineTypeToArchiveResourceType(PIPELI
         case PIPELINE_TYPE_TILE:
             return ResourceType::TilePipeline;
 
+        case PIPELINE_TYPE_WORK_GRAPH:
         default:
             return ResourceType::Undefined;
     }
@@ -253,6 +253,8 @@ void SerializedShaderImpl::CreateShaderGL(IReferenceCounters*     pRefCounters,
     Attribs.ppCompilerOutput = ShaderCI.ppCompilerOutput;
     Attribs.ShaderSource     = static_cast<const char*>(Source);
     Attribs.SourceCodeLen    = static_cast<int>(SourceLen);
+    // SPIR-V is only used to validate the shader, so there is no need to optimize it
+    Attribs.CompileFlags = SHADER_COMPILE_FLAG_MINIMAL_OPTIMIZATION;
 
     if (GLSLangUtils::GLSLtoSPIRV(Attribs).empty())
         LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, "'");
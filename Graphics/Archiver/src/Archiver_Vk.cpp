@@ -60,7 +60,13 @@ struct CompiledShaderVk : SerializedShaderImpl::CompiledShader
         ShaderCI.Macros       = nullptr;
         ShaderCI.ByteCode     = SPIRV.data();
         ShaderCI.ByteCodeSize = SPIRV.size() * sizeof(SPIRV[0]);
-        return SerializedShaderImpl::SerializeCreateInfo(ShaderCI);
+
+        // Store the reflection next to the byte code so that the dearchiver does not need to parse the SPIR-V
+        SerializedData Reflection;
+        if (const auto& pResources = ShaderVk.GetShaderResources())
+            Reflection = pResources->SerializeReflection(SPIRV, ShaderVk.GetEntryPoint(), GetRawAllocator());
+
+        return SerializedShaderImpl::SerializeCreateInfo(ShaderCI, Reflection);
     }
 
     virtual IShader* GetDeviceShader() override final
@@ -184,7 +190,16 @@ void SerializedPipelineStateImpl::PatchShadersVk(const CreateInfoType& CreateInf
             ShaderCI.Macros       = nullptr;
             ShaderCI.ByteCode     = SPIRV.data();
             ShaderCI.ByteCodeSize = SPIRV.size() * sizeof(SPIRV[0]);
-            SerializeShaderCreateInfo(DeviceType::Vulkan, ShaderCI);
+
+            // Remapping only changes the values of the decorations, so the reflection of the
+            // original shader remains valid. Stripping the reflection changes the SPIR-V layout.
+            SerializedData Reflection;
+            if (!m_Data.Aux.NoShaderReflection)
+            {
+                if (const auto& pResources = Stage.Shaders[i]->GetShaderResources())
+                    Reflection = pResources->SerializeReflection(SPIRV, Stage.Shaders[i]->GetEntryPoint(), GetRawAllocator());
+            }
+            SerializeShaderCreateInfo(DeviceType::Vulkan, ShaderCI, Reflection);
         }
     }
 }
@@ -59,9 +59,18 @@ static constexpr ARCHIVE_DEVICE_DATA_FLAGS GetSupportedDeviceFlags()
     return Flags;
 }
 
+static EngineCreateInfo GetSerializationEngineCreateInfo(const SerializationDeviceCreateInfo& CreateInfo)
+{
+    EngineCreateInfo EngineCI;
+    // Shaders for different backends are compiled in this thread pool
+    EngineCI.pAsyncShaderCompilationThreadPool = CreateInfo.pCompilationThreadPool;
+    return EngineCI;
+}
+
 SerializationDeviceImpl::SerializationDeviceImpl(IReferenceCounters* pRefCounters, const SerializationDeviceCreateInfo& CreateInfo) :
-    TBase{pRefCounters, GetRawAllocator(), nullptr, EngineCreateInfo{}, CreateInfo.AdapterInfo},
-    m_ValidDeviceFlags{Diligent::GetSupportedDeviceFlags()}
+    TBase{pRefCounters, GetRawAllocator(), nullptr, GetSerializationEngineCreateInfo(CreateInfo), CreateInfo.AdapterInfo},
+    m_ValidDeviceFlags{Diligent::GetSupportedDeviceFlags()},
+    m_CompressShaders{CreateInfo.CompressShaders != False}
 {
     m_DeviceInfo = CreateInfo.DeviceInfo;
 
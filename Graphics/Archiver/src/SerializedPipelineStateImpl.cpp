@@ -144,6 +144,18 @@ void SerializePSOCreateInfo(Serializer<Mode>&                                 Se
     PSOSerializer<Mode>::SerializeCreateInfo(Ser, PSOCreateInfo, PRSNames, nullptr, RemapShaders);
 }
 
+template <SerializerMode Mode, typename PSOCreateInfoType>
+void SerializePSOTrailingData(Serializer<Mode>& Ser, const PSOCreateInfoType& PSOCreateInfo)
+{
+}
+
+template <SerializerMode Mode>
+void SerializePSOTrailingData(Serializer<Mode>& Ser, const GraphicsPipelineStateCreateInfo& PSOCreateInfo)
+{
+    if (PSOCreateInfo.GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+        PSOSerializer<Mode>::SerializeDynamicStateFlags(Ser, PSOCreateInfo.GraphicsPipeline.DynamicStateFlags);
+}
+
 template <typename PSOCreateInfoType>
 IRenderPass* RenderPassFromCI(const PSOCreateInfoType& CreateInfo)
 {
@@ -302,6 +314,7 @@ SerializedPipelineStateImpl::SerializedPipelineStateImpl(IReferenceCounters*
             SerializePSOCreateInfo(Ser, CreateInfo, PRSNames);
             constexpr auto SerMode = std::remove_reference<decltype(Ser)>::type::GetMode();
             PSOSerializer<SerMode>::SerializeAuxData(Ser, m_Data.Aux, nullptr);
+            SerializePSOTrailingData(Ser, CreateInfo);
         };
 
         {
@@ -327,10 +340,11 @@ SerializedPipelineStateImpl::~SerializedPipelineStateImpl()
 {}
 
 void SerializedPipelineStateImpl::SerializeShaderCreateInfo(DeviceType              Type,
-                                                            const ShaderCreateInfo& CI)
+                                                            const ShaderCreateInfo& CI,
+                                                            const SerializedData&   Reflection)
 {
     Data::ShaderInfo ShaderData;
-    ShaderData.Data  = SerializedShaderImpl::SerializeCreateInfo(CI);
+    ShaderData.Data  = SerializedShaderImpl::SerializeCreateInfo(CI, Reflection);
     ShaderData.Stage = CI.Desc.ShaderType;
     ShaderData.Hash  = ShaderData.Data.GetHash();
 #ifdef DILIGENT_DEBUG
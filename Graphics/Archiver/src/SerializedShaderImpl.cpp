@@ -27,6 +27,8 @@
 #include "SerializedShaderImpl.hpp"
 
 #include <cstring>
+#include <exception>
+#include <vector>
 
 #include "SerializationDeviceImpl.hpp"
 #include "EngineMemory.h"
@@ -34,6 +36,7 @@
 #include "PlatformMisc.hpp"
 #include "BasicMath.hpp"
 #include "PSOSerializer.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -65,59 +68,115 @@ SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters
 
     m_CreateInfo = ShaderCreateInfoWrapper{ShaderCI, GetRawAllocator()};
 
+    // Device shaders must be compiled synchronously as their byte code is serialized right away
+    ShaderCreateInfo DeviceShaderCI{ShaderCI};
+    DeviceShaderCI.CompileFlags &= ~SHADER_COMPILE_FLAG_ASYNCHRONOUS;
+
     if ((DeviceFlags & ARCHIVE_DEVICE_DATA_FLAG_GL) != 0 && (DeviceFlags & ARCHIVE_DEVICE_DATA_FLAG_GLES) != 0)
     {
         // OpenGL and GLES use the same device data. Clear one flag to avoid shader duplication.
         DeviceFlags &= ~ARCHIVE_DEVICE_DATA_FLAG_GLES;
     }
 
+    std::vector<ARCHIVE_DEVICE_DATA_FLAGS> DeviceFlagsList;
     while (DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE)
+        DeviceFlagsList.push_back(ExtractLSB(DeviceFlags));
+
+    auto* pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+    if (pThreadPool != nullptr && DeviceFlagsList.size() > 1)
     {
-        const auto Flag = ExtractLSB(DeviceFlags);
+        // Every backend writes its own slot in m_Shaders, so the compilations are independent.
+        // The calling thread compiles the first backend while the pool compiles the rest.
+        std::vector<std::exception_ptr>       Exceptions(DeviceFlagsList.size());
+        std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+        Tasks.reserve(DeviceFlagsList.size() - 1);
+        for (size_t i = 1; i < DeviceFlagsList.size(); ++i)
+        {
+            Tasks.emplace_back(EnqueueAsyncWork(pThreadPool, [&, i](Uint32 ThreadId) {
+                try
+                {
+                    CreateDeviceShader(pRefCounters, DeviceShaderCI, DeviceFlagsList[i]);
+                }
+                catch (...)
+                {
+                    Exceptions[i] = std::current_exception();
+                }
+            }));
+        }
+
+        try
+        {
+            CreateDeviceShader(pRefCounters, DeviceShaderCI, DeviceFlagsList[0]);
+        }
+        catch (...)
+        {
+            Exceptions[0] = std::current_exception();
+        }
 
-        static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS, "Please update the switch below to handle the new device data type");
-        switch (Flag)
+        // Tasks reference local variables, so all of them must finish before we return
+        for (auto& pTask : Tasks)
+            pTask->WaitForCompletion();
+
+        // Report errors in the same order as the sequential path
+        for (auto& Exception : Exceptions)
         {
+            if (Exception)
+                std::rethrow_exception(Exception);
+        }
+    }
+    else
+    {
+        for (auto Flag : DeviceFlagsList)
+            CreateDeviceShader(pRefCounters, DeviceShaderCI, Flag);
+    }
+}
+
+void SerializedShaderImpl::CreateDeviceShader(IReferenceCounters*       pRefCounters,
+                                              const ShaderCreateInfo&   DeviceShaderCI,
+                                              ARCHIVE_DEVICE_DATA_FLAGS Flag) noexcept(false)
+{
+    static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS, "Please update the switch below to handle the new device data type");
+    switch (Flag)
+    {
 #if D3D11_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
-                CreateShaderD3D11(pRefCounters, ShaderCI);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
+            CreateShaderD3D11(pRefCounters, DeviceShaderCI);
+            break;
 #endif
 
 #if D3D12_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
-                CreateShaderD3D12(pRefCounters, ShaderCI);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
+            CreateShaderD3D12(pRefCounters, DeviceShaderCI);
+            break;
 #endif
 
 #if GL_SUPPORTED || GLES_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_GL:
-            case ARCHIVE_DEVICE_DATA_FLAG_GLES:
-                CreateShaderGL(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_GL:
+        case ARCHIVE_DEVICE_DATA_FLAG_GLES:
+            CreateShaderGL(pRefCounters, DeviceShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES);
+            break;
 #endif
 
 #if VULKAN_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
-                CreateShaderVk(pRefCounters, ShaderCI);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
+            CreateShaderVk(pRefCounters, DeviceShaderCI);
+            break;
 #endif
 
 #if METAL_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS:
-            case ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS:
-                CreateShaderMtl(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS:
+        case ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS:
+            CreateShaderMtl(pRefCounters, DeviceShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS);
+            break;
 #endif
 
-            case ARCHIVE_DEVICE_DATA_FLAG_NONE:
-                UNEXPECTED("ARCHIVE_DEVICE_DATA_FLAG_NONE(0) should never occur");
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_NONE:
+            UNEXPECTED("ARCHIVE_DEVICE_DATA_FLAG_NONE(0) should never occur");
+            break;
 
-            default:
-                LOG_ERROR_MESSAGE("Unexpected render device type");
-                break;
-        }
+        default:
+            LOG_ERROR_MESSAGE("Unexpected render device type");
+            break;
     }
 }
 
@@ -144,23 +203,14 @@ bool SerializedShaderImpl::operator==(const SerializedShaderImpl& Rhs) const noe
     return m_CreateInfo.Get() == Rhs.m_CreateInfo.Get();
 }
 
-SerializedData SerializedShaderImpl::SerializeCreateInfo(const ShaderCreateInfo& CI)
+SerializedData SerializedShaderImpl::SerializeCreateInfo(const ShaderCreateInfo& CI, const SerializedData& Reflection)
 {
-    SerializedData ShaderData;
-
-    {
-        Serializer<SerializerMode::Measure> Ser;
-        ShaderSerializer<SerializerMode::Measure>::SerializeCI(Ser, CI);
-        ShaderData = Ser.AllocateData(GetRawAllocator());
-    }
-
-    {
-        Serializer<SerializerMode::Write> Ser{ShaderData};
-        ShaderSerializer<SerializerMode::Write>::SerializeCI(Ser, CI);
-        VERIFY_EXPR(Ser.IsEnded());
-    }
-
-    return ShaderData;
+    return SerializeToData(GetRawAllocator(),
+                           [&](auto& Ser) {
+                               constexpr auto SerMode = std::remove_reference<decltype(Ser)>::type::GetMode();
+                               return ShaderSerializer<SerMode>::SerializeCI(Ser, CI) &&
+                                   ShaderSerializer<SerMode>::SerializeReflection(Ser, Reflection);
+                           });
 }
 
 SerializedData SerializedShaderImpl::GetDeviceData(DeviceType Type) const
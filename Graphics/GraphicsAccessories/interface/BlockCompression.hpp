@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// CPU block compression and decompression of texture data
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+/// Block compression attributes, see Diligent::CompressTextureData().
+struct CompressTextureDataAttribs
+{
+    /// Compressed texture format.
+
+    /// Supported formats are TEX_FORMAT_BC1_UNORM(_SRGB), TEX_FORMAT_BC3_UNORM(_SRGB),
+    /// TEX_FORMAT_BC4_UNORM, TEX_FORMAT_BC5_UNORM and TEX_FORMAT_BC7_UNORM(_SRGB).
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Texture width in pixels. Does not need to be a multiple of the block size.
+    Uint32 Width = 0;
+
+    /// Texture height in pixels. Does not need to be a multiple of the block size.
+    Uint32 Height = 0;
+
+    /// Source pixels in RGBA8 format.
+
+    /// BC4 uses the R channel, BC5 uses the R and G channels.
+    /// Edge blocks that extend beyond the texture replicate the last row and column.
+    /// sRGB formats store the source values as is.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination memory for the compressed blocks.
+
+    /// The destination may be the memory of a mapped upload buffer
+    /// (see IUploadBuffer::GetMappedData()) so that the blocks are written
+    /// directly into the staging memory.
+    void* pDstData = nullptr;
+
+    /// Destination stride in bytes between rows of blocks.
+    size_t DstStride = 0;
+
+    /// The number of threads to use. The rows of blocks are split evenly between the threads.
+    Uint32 NumThreads = 1;
+};
+
+/// Compresses RGBA8 texture data into a block-compressed format.
+
+/// \return     true if the data was compressed, and false if the format
+///             is not supported or the attributes are invalid.
+///
+/// \remarks    BC1 and BC3 color endpoints are fit along the principal axis of the block
+///             colors and refined with a least-squares pass. BC1 uses the 3-color mode with
+///             transparent texels for blocks that contain texels with alpha below 128.
+///             BC7 blocks are always encoded using mode 6 (single subset, 7-bit RGBA endpoints
+///             with p-bits and 4-bit indices).
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs);
+
+
+/// Block decompression attributes, see Diligent::DecompressTextureData().
+struct DecompressTextureDataAttribs
+{
+    /// Compressed texture format.
+
+    /// Supported formats are TEX_FORMAT_BC1 to TEX_FORMAT_BC5 and TEX_FORMAT_BC7 UNORM formats
+    /// and their sRGB variants.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Texture width in pixels.
+    Uint32 Width = 0;
+
+    /// Texture height in pixels.
+    Uint32 Height = 0;
+
+    /// Compressed blocks.
+    const void* pSrcData = nullptr;
+
+    /// Source stride in bytes between rows of blocks.
+    size_t SrcStride = 0;
+
+    /// Destination memory for RGBA8 pixels.
+
+    /// BC4 writes (R, 0, 0, 255), BC5 writes (R, G, 0, 255).
+    void* pDstData = nullptr;
+
+    /// Destination row stride in bytes.
+    size_t DstStride = 0;
+
+    /// The number of threads to use.
+    Uint32 NumThreads = 1;
+};
+
+/// Decompresses block-compressed texture data into RGBA8 pixels.
+
+/// This can be used to transcode compressed content to an uncompressed format
+/// on devices that do not support block-compressed textures.
+///
+/// \return     true if all blocks were decompressed, and false if the format
+///             is not supported, the attributes are invalid, or the data contains
+///             BC7 blocks that use partitioned modes (0-3 and 7), which are not
+///             supported by the decoder. Unsupported blocks are decoded as transparent black.
+bool DecompressTextureData(const DecompressTextureDataAttribs& Attribs);
+
+/// Returns true if the format is supported by Diligent::CompressTextureData().
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format);
+
+/// Returns true if the format is supported by Diligent::DecompressTextureData().
+bool IsBlockDecompressionSupported(TEXTURE_FORMAT Format);
+
+} // namespace Diligent
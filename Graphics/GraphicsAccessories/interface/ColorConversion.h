@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include "../../../Primitives/interface/BasicTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -57,4 +58,36 @@ inline float FastSRGBToLinear(float x)
     return x * (x * (x * 0.305306011f + 0.682171111f) + 0.012522878f);
 }
 
+
+// Batch conversion functions.
+//
+// The functions process Count values and use SSE2 instructions when they are available.
+// The SIMD and scalar implementations produce identical results. The source and destination
+// arrays may be the same, but must not partially overlap.
+
+/// Converts linear values to sRGB using a polynomial approximation of pow().
+/// The values are clamped to [0, 1]. The maximum absolute error compared to the exact function is 3e-7.
+void LinearToSRGB(const float* pLinear, float* pSRGB, size_t Count);
+
+/// Converts sRGB values to linear using a polynomial approximation of pow().
+/// The values are clamped to [0, 1]. The maximum absolute error compared to the exact function is 8e-7.
+void SRGBToLinear(const float* pSRGB, float* pLinear, size_t Count);
+
+/// Converts linear values to 8-bit sRGB values. The values are clamped to [0, 1].
+/// The result is the correctly rounded exact value, except when the exact value is within 4e-5
+/// of the rounding midpoint, in which case it may be off by one.
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts 8-bit linear values to sRGB using a lookup table. The results are identical to LinearToSRGB(Uint8).
+void LinearToSRGB(const Uint8* pLinear, float* pSRGB, size_t Count);
+
+/// Converts 8-bit sRGB values to linear using a lookup table. The results are identical to SRGBToLinear(Uint8).
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count);
+
+/// Batch version of FastLinearToSRGB(float) that produces identical results.
+void FastLinearToSRGB(const float* pLinear, float* pSRGB, size_t Count);
+
+/// Batch version of FastSRGBToLinear(float) that produces identical results.
+void FastSRGBToLinear(const float* pSRGB, float* pLinear, size_t Count);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <deque>
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+/// Implementation of a ring buffer that allows multiple threads to allocate space concurrently.
+
+/// Allocate() is lock-free and may be called by any number of threads. The head and the tail
+/// are monotonically increasing positions, and the offset in the buffer is the position modulo
+/// the buffer size. A thread reserves a range by advancing the head with compare-exchange.
+///
+/// FinishCurrentFrame() and ReleaseCompletedFrames() must be called by a single thread that owns
+/// the buffer. ReleaseCompletedFrames() may run concurrently with Allocate(), while FinishCurrentFrame()
+/// must be called after all allocations of the frame have been made.
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator& Allocator) noexcept :
+        m_CompletedFrameHeads(STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for deque<ConcurrentRingBuffer::FrameHeadAttribs>")),
+        m_MaxSize{MaxSize}
+    {}
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(GetUsedSize() == 0, "All space in the ring buffer must be released");
+    }
+
+    /// Reserves Size bytes aligned by Alignment. Returns the offset of the
+    /// reserved range, or InvalidOffset if there is not enough space.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (Size > m_MaxSize)
+            return InvalidOffset;
+
+        auto Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto HeadOffset = static_cast<OffsetType>(Head % m_MaxSize);
+
+            auto   Offset  = AlignUp(HeadOffset, Alignment);
+            Uint64 Padding = Offset - HeadOffset;
+            if (Offset + Size > m_MaxSize)
+            {
+                // Allocate from the beginning of the buffer
+                //
+                // Offset              Tail          Head               MaxSize
+                //  |                  |                |<--Padding---->|
+                //  [                  xxxxxxxxxxxxxxxxx++++++++++++++++]
+                //
+                Offset  = 0;
+                Padding = m_MaxSize - HeadOffset;
+            }
+            const Uint64 NewHead = Head + Padding + Size;
+
+            // The tail only moves forward, so a stale value is conservative
+            if (NewHead - m_Tail.load(std::memory_order_acquire) > m_MaxSize)
+                return InvalidOffset;
+
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return Offset;
+        }
+    }
+
+    /// Associates all space allocated since the previous call with the fence value.
+
+    /// FenceValue is the fence value associated with the command list in which the head
+    /// could have been referenced last time
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+#ifdef DILIGENT_DEBUG
+        if (!m_CompletedFrameHeads.empty())
+            VERIFY(FenceValue >= m_CompletedFrameHeads.back().FenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", m_CompletedFrameHeads.back().FenceValue, ")");
+#endif
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        // Ignore zero-size frames
+        if (Head != m_LastFrameHead)
+        {
+            m_CompletedFrameHeads.emplace_back(FenceValue, Head);
+            m_LastFrameHead = Head;
+        }
+    }
+
+    /// Releases the space of all frames whose fence value is less than or equal to CompletedFenceValue.
+
+    /// CompletedFenceValue indicates GPU progress
+    /// See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        while (!m_CompletedFrameHeads.empty() && m_CompletedFrameHeads.front().FenceValue <= CompletedFenceValue)
+        {
+            m_Tail.store(m_CompletedFrameHeads.front().Head, std::memory_order_release);
+            m_CompletedFrameHeads.pop_front();
+        }
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize() const { return m_MaxSize; }
+    bool       IsFull()     const { return GetUsedSize() == m_MaxSize; };
+    bool       IsEmpty()    const { return GetUsedSize() == 0; };
+    // clang-format on
+
+    /// Returns the used size, including the padding that is wasted for alignment
+    /// and at the end of the buffer.
+    OffsetType GetUsedSize() const
+    {
+        const auto Tail = m_Tail.load(std::memory_order_acquire);
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        return static_cast<OffsetType>(Head - Tail);
+    }
+
+private:
+    struct FrameHeadAttribs
+    {
+        // clang-format off
+        FrameHeadAttribs(Uint64 fv, Uint64 head) noexcept :
+            FenceValue{fv  },
+            Head      {head}
+        {}
+        // clang-format on
+
+        // Fence value associated with the command list in which
+        // the allocation could have been referenced last time
+        Uint64 FenceValue;
+
+        // Head position at the end of the frame
+        Uint64 Head;
+    };
+    std::deque<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs>> m_CompletedFrameHeads;
+
+    const OffsetType m_MaxSize;
+
+    // Head position at the end of the last finished frame
+    Uint64 m_LastFrameHead = 0;
+
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+};
+} // namespace Diligent
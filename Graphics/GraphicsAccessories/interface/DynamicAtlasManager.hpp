@@ -32,6 +32,7 @@
 /// Declaration of DynamicAtlasManager class
 
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 #include "../../../Primitives/interface/BasicTypes.h"
@@ -40,10 +41,26 @@
 namespace Diligent
 {
 
+class ShelfAtlasManager;
+
 /// Dynamic 2D atlas manager
 class DynamicAtlasManager
 {
 public:
+    /// Region allocation policy
+    enum ALLOCATION_POLICY : Uint8
+    {
+        /// Regions are allocated from the best-fitting free region, which is split into
+        /// up to three regions. Free regions are merged when their siblings are released.
+        /// This policy works well for general workloads.
+        ALLOCATION_POLICY_BEST_FIT = 0,
+
+        /// Regions are placed on horizontal shelves (see Diligent::ShelfAtlasManager).
+        /// Allocating regions of the same height takes amortized constant time,
+        /// which suits glyphs, icons and uniform tiles.
+        ALLOCATION_POLICY_SHELF
+    };
+
     struct Region
     {
         Uint32 x = 0;
@@ -98,19 +115,20 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, ALLOCATION_POLICY Policy = ALLOCATION_POLICY_BEST_FIT);
     ~DynamicAtlasManager();
 
     // clang-format off
     DynamicAtlasManager             (const DynamicAtlasManager&)  = delete;
     DynamicAtlasManager& operator = (const DynamicAtlasManager&)  = delete;
-    DynamicAtlasManager             (      DynamicAtlasManager&&) = default;
+    DynamicAtlasManager             (      DynamicAtlasManager&&);
     DynamicAtlasManager& operator = (      DynamicAtlasManager&&) = delete;
     // clang-format on
 
     Region Allocate(Uint32 Width, Uint32 Height);
     void   Free(Region&& R);
 
+    /// Returns the number of free regions. Free regions are only tracked by ALLOCATION_POLICY_BEST_FIT.
     Uint32 GetFreeRegionCount() const
     {
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
@@ -120,9 +138,13 @@ public:
     Uint32 GetWidth() const { return m_Width; }
     Uint32 GetHeight() const { return m_Height; }
     Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
+    ALLOCATION_POLICY GetAllocationPolicy() const { return m_Policy; }
 
     bool IsEmpty() const
     {
+        if (m_pShelfMgr)
+            return m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height};
+
         VERIFY_EXPR(m_AllocatedRegions.empty() && (m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height}) ||
                     !m_AllocatedRegions.empty() && (m_TotalFreeArea < Uint64{m_Width} * Uint64{m_Height}));
         return m_AllocatedRegions.empty();
@@ -169,8 +191,13 @@ private:
     const Uint32 m_Width;
     const Uint32 m_Height;
 
+    const ALLOCATION_POLICY m_Policy;
+
     Uint64 m_TotalFreeArea = 0;
 
+    // Shelf manager that handles all allocations when the policy is ALLOCATION_POLICY_SHELF
+    std::unique_ptr<ShelfAtlasManager> m_pShelfMgr;
+
     struct Node
     {
         Region R;
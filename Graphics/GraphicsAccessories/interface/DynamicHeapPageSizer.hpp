@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::DynamicHeapPageSizer class
+
+#include <algorithm>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Adapts the page size of a dynamic heap to the amount of memory the heap uses per frame.
+
+/// The sizer tracks the per-frame high-water mark of the heap and selects the smallest
+/// page size that holds an entire frame, so that a context typically requests a single
+/// page per frame. Page sizes are power-of-two multiples of the minimum page size.
+///
+/// The page size grows as soon as a frame does not fit into a single page. It shrinks by
+/// half only after the frame usage has stayed at or below a quarter of the page size for
+/// ShrinkDelay consecutive frames. The gap between the two thresholds provides hysteresis
+/// that keeps the size from oscillating when the usage fluctuates around a boundary.
+///
+/// The class is not thread-safe.
+class DynamicHeapPageSizer
+{
+public:
+    /// The number of consecutive frames the usage must stay low before the page size is reduced.
+    static constexpr Uint32 ShrinkDelay = 256;
+
+    DynamicHeapPageSizer(Uint64 MinPageSize, Uint64 MaxPageSize, Uint64 InitialPageSize) noexcept :
+        m_MinPageSize{MinPageSize},
+        m_MaxPageSize{std::max(MaxPageSize, MinPageSize)},
+        m_PageSize{MinPageSize}
+    {
+        VERIFY(m_MinPageSize > 0, "Minimum page size must not be zero");
+        while (m_PageSize < InitialPageSize && m_PageSize * 2 <= m_MaxPageSize)
+            m_PageSize *= 2;
+    }
+
+    /// Records the memory used by the heap in the frame that has just finished.
+
+    /// \param [in] FrameSize - The total size of the allocations made in the frame,
+    ///                         including the alignment padding.
+    /// \return     true if the page size has changed, and false otherwise.
+    bool FinishFrame(Uint64 FrameSize)
+    {
+        m_WindowPeakSize = std::max(m_WindowPeakSize, FrameSize);
+        ++m_NumFrames;
+
+        if (FrameSize > m_PageSize && m_PageSize < m_MaxPageSize)
+        {
+            // Grow right away: the frame did not fit and required several pages
+            m_PrevPageSize = m_PageSize;
+            while (m_PageSize < FrameSize && m_PageSize * 2 <= m_MaxPageSize)
+                m_PageSize *= 2;
+            m_NumLowUsageFrames = 0;
+            return true;
+        }
+
+        if (FrameSize <= m_PageSize / 4 && m_PageSize > m_MinPageSize)
+        {
+            if (++m_NumLowUsageFrames >= ShrinkDelay)
+            {
+                m_PrevPageSize      = m_PageSize;
+                m_PageSize          = std::max(m_PageSize / 2, m_MinPageSize);
+                m_NumLowUsageFrames = 0;
+                return true;
+            }
+        }
+        else
+        {
+            m_NumLowUsageFrames = 0;
+        }
+
+        return false;
+    }
+
+    /// Returns the current page size.
+    Uint64 GetPageSize() const { return m_PageSize; }
+
+    /// Returns the page size before the last change.
+    Uint64 GetPreviousPageSize() const { return m_PrevPageSize; }
+
+    /// Returns the high-water mark of the per-frame usage since the last call to ResetWindowPeakSize().
+    Uint64 GetWindowPeakSize() const { return m_WindowPeakSize; }
+
+    /// Resets the high-water mark returned by GetWindowPeakSize().
+    void ResetWindowPeakSize() { m_WindowPeakSize = 0; }
+
+    /// Returns the number of frames recorded by FinishFrame().
+    Uint64 GetNumFrames() const { return m_NumFrames; }
+
+private:
+    const Uint64 m_MinPageSize;
+    const Uint64 m_MaxPageSize;
+
+    Uint64 m_PageSize          = 0;
+    Uint64 m_PrevPageSize      = 0;
+    Uint64 m_WindowPeakSize    = 0;
+    Uint64 m_NumFrames         = 0;
+    Uint32 m_NumLowUsageFrames = 0;
+};
+
+} // namespace Diligent
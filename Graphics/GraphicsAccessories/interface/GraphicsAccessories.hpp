@@ -361,6 +361,12 @@ String GetCommandQueueTypeString(COMMAND_QUEUE_TYPE Type);
 /// Returns the string containing the fence type
 const Char* GetFenceTypeString(FENCE_TYPE Type);
 
+/// Returns the string containing the GPU memory category
+const Char* GetGPUMemoryCategoryString(GPU_MEMORY_CATEGORY Category);
+
+/// Returns the string containing the GPU memory allocation type
+const Char* GetGPUMemoryAllocationTypeString(GPU_MEMORY_ALLOCATION_TYPE Type);
+
 /// Helper template function that converts object description into a string
 template <typename TObjectDescType>
 String GetObjectDescString(const TObjectDescType&)
@@ -524,7 +530,7 @@ inline Int32 ExtractFirstShaderStageIndex(SHADER_TYPE& Stages)
 }
 
 
-static_assert(SHADER_TYPE_LAST == 0x4000, "Please add the new shader type index below");
+static_assert(SHADER_TYPE_LAST == 0x8000, "Please add the new shader type index below");
 
 static constexpr Int32 VSInd   = 0;
 static constexpr Int32 PSInd   = 1;
@@ -541,8 +547,9 @@ static constexpr Int32 RAHSInd = 11;
 static constexpr Int32 RISInd  = 12;
 static constexpr Int32 RCSInd  = 13;
 static constexpr Int32 TLSInd  = 14;
+static constexpr Int32 WGSInd  = 15;
 
-static constexpr Int32 LastShaderInd = TLSInd;
+static constexpr Int32 LastShaderInd = WGSInd;
 
 // clang-format off
 static_assert(SHADER_TYPE_VERTEX           == (1 << VSInd),   "VSInd is not consistent with SHADER_TYPE_VERTEX");
@@ -560,6 +567,7 @@ static_assert(SHADER_TYPE_RAY_ANY_HIT      == (1 << RAHSInd), "RAHSInd is not co
 static_assert(SHADER_TYPE_RAY_INTERSECTION == (1 << RISInd),  "RISInd is not consistent with SHADER_TYPE_RAY_INTERSECTION");
 static_assert(SHADER_TYPE_CALLABLE         == (1 << RCSInd),  "RCSInd is not consistent with SHADER_TYPE_CALLABLE");
 static_assert(SHADER_TYPE_TILE             == (1 << TLSInd),  "TLSInd is not consistent with SHADER_TYPE_TILE");
+static_assert(SHADER_TYPE_WORK_GRAPH       == (1 << WGSInd),  "WGSInd is not consistent with SHADER_TYPE_WORK_GRAPH");
 
 static_assert(SHADER_TYPE_LAST == (1 << LastShaderInd), "LastShaderInd is not consistent with SHADER_TYPE_LAST");
 // clang-format on
@@ -707,6 +715,8 @@ TEXTURE_FORMAT TexFormatToSRGB(TEXTURE_FORMAT Fmt);
 
 String GetPipelineShadingRateFlagsString(PIPELINE_SHADING_RATE_FLAGS Flags);
 
+String GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAGS Flags);
+
 /// Returns the sparse texture properties assuming the standard tile shapes
 SparseTextureProperties GetStandardSparseTextureProperties(const TextureDesc& TexDesc);
 
@@ -731,4 +741,18 @@ inline uint3 GetNumSparseTilesInMipLevel(const TextureDesc& Desc,
     return GetNumSparseTilesInBox(Box{0, MipProps.StorageWidth, 0, MipProps.StorageHeight, 0, MipProps.Depth}, TileSize);
 }
 
+/// Converts the number of ticks of a counter with the given frequency, in Hz, to nanoseconds.
+/// Whole seconds and the remainder are converted separately so that the result does not overflow.
+inline Uint64 TicksToNanoseconds(Uint64 Ticks, Uint64 Frequency)
+{
+    VERIFY_EXPR(Frequency != 0);
+    constexpr Uint64 NanosecondsPerSecond = 1000000000;
+    return Ticks / Frequency * NanosecondsPerSecond + Ticks % Frequency * NanosecondsPerSecond / Frequency;
+}
+
+/// Converts the GPU timestamp counter value (see QueryDataTimestamp::Counter) to the CPU time,
+/// in nanoseconds, using the calibration data returned by IDeviceContext::GetTimestampCalibration().
+/// The result is in the same time domain as TimestampCalibration::CPUTime.
+Uint64 GPUTimestampToCPUTime(const TimestampCalibration& Calibration, Uint64 GPUCounter);
+
 } // namespace Diligent
@@ -34,16 +34,71 @@
 /// Implementation of Diligent::ResourceReleaseQueue class
 
 #include <mutex>
-#include <deque>
 #include <atomic>
+#include <vector>
+#include <new>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "../../../Common/interface/SpinLock.hpp"
+#include "../../../Common/interface/TrackingMemoryAllocator.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+/// Thread-safe pool of memory blocks of the given size.
+
+/// Released blocks are kept in the pool and are never returned to the heap, so that
+/// once the pool has grown to its working size, allocating and releasing blocks does
+/// not allocate memory.
+template <size_t BlockSize>
+class StaleResourceBlockPool
+{
+public:
+    static void* Allocate()
+    {
+        auto& Pool = GetInstance();
+        {
+            Threading::SpinLockGuard Guard{Pool.m_Lock};
+            if (FreeBlock* pBlock = Pool.m_pFreeList)
+            {
+                Pool.m_pFreeList = pBlock->pNext;
+                return pBlock;
+            }
+        }
+        return ::operator new(BlockSize);
+    }
+
+    static void Free(void* Ptr)
+    {
+        auto& Pool   = GetInstance();
+        auto* pBlock = static_cast<FreeBlock*>(Ptr);
+
+        Threading::SpinLockGuard Guard{Pool.m_Lock};
+        pBlock->pNext    = Pool.m_pFreeList;
+        Pool.m_pFreeList = pBlock;
+    }
+
+private:
+    static_assert(BlockSize >= sizeof(void*), "Block size is too small");
+
+    struct FreeBlock
+    {
+        FreeBlock* pNext;
+    };
+
+    static StaleResourceBlockPool& GetInstance()
+    {
+        // The pool is never destroyed, so that resources can be released during static deinitialization
+        static auto* pPool = new StaleResourceBlockPool;
+        return *pPool;
+    }
+
+    Threading::SpinLock m_Lock;
+    FreeBlock*          m_pFreeList = nullptr;
+};
+
 /// Helper class that wraps stale resources of different types
 class DynamicStaleResourceWrapper final
 {
@@ -90,6 +145,17 @@ public:
                 delete this;
             }
 
+            static void* operator new(size_t Size)
+            {
+                VERIFY_EXPR(Size == sizeof(SpecificStaleResource));
+                return StaleResourceBlockPool<GetPoolBlockSize(sizeof(SpecificStaleResource))>::Allocate();
+            }
+
+            static void operator delete(void* Ptr)
+            {
+                StaleResourceBlockPool<GetPoolBlockSize(sizeof(SpecificStaleResource))>::Free(Ptr);
+            }
+
         private:
             ResourceType m_SpecificResource;
         };
@@ -118,6 +184,17 @@ public:
                 }
             }
 
+            static void* operator new(size_t Size)
+            {
+                VERIFY_EXPR(Size == sizeof(SpecificSharedStaleResource));
+                return StaleResourceBlockPool<GetPoolBlockSize(sizeof(SpecificSharedStaleResource))>::Allocate();
+            }
+
+            static void operator delete(void* Ptr)
+            {
+                StaleResourceBlockPool<GetPoolBlockSize(sizeof(SpecificSharedStaleResource))>::Free(Ptr);
+            }
+
         private:
             ResourceType                m_SpecificResource;
             std::atomic<RefCounterType> m_RefCounter;
@@ -164,6 +241,14 @@ private:
         virtual void Release()       = 0;
     };
 
+    // Stale resources are allocated from the pools of the blocks of the same size, so that
+    // releasing resources every frame (e.g. command buffers) does not allocate memory.
+    // Block sizes are rounded up to reduce the number of pools.
+    static constexpr size_t GetPoolBlockSize(size_t Size)
+    {
+        return (Size + 15) & ~size_t{15};
+    }
+
     DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
         m_pStaleResource(pStaleResource)
     {}
@@ -220,22 +305,47 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Releasing a resource does not take any lock: stale resources are pushed into a lock-free
+/// multi-producer list that is drained by DiscardStaleResources(). Purge() only holds the lock
+/// while it detaches completed resources and destroys them after the lock is released, so it may
+/// run on a background thread without blocking threads that release or discard resources.
+///
+/// The queue keeps the memory it has allocated (queue storage, stale resource nodes and the
+/// list of retired resources), so that in a steady state, when the number of resources
+/// released per frame does not grow, releasing and purging resources does not allocate memory.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
 {
 public:
+    /// \param [in] Allocator     - Allocator that is used to allocate the queue memory.
+    /// \param [in] AllocationTag - Tag of the memory allocated by the queue, see Diligent::TrackingMemoryAllocator.
     // clang-format off
-    ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+    ResourceReleaseQueue(IMemoryAllocator& Allocator, Uint32 AllocationTag = 0) :
+        m_Allocator       {Allocator},
+        m_AllocationTag   {AllocationTag},
+        m_ReleaseQueue    {Allocator},
+        m_StaleResources  {Allocator},
+        m_RetiredResources(STD_ALLOCATOR_RAW_MEM(ResourceWrapperType, Allocator, "Allocator for vector<ResourceWrapperType>"))
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(GetStaleResourceCount() == 0, "Not all stale objects were destroyed");
         DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+
+        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+        DrainStaleResourceList();
+
+        while (m_pFreeNodeList != nullptr)
+        {
+            FreeNode* pNext = m_pFreeNodeList->pNext;
+            m_pFreeNodeList->~FreeNode();
+            m_Allocator.Free(m_pFreeNodeList);
+            m_pFreeNodeList = pNext;
+        }
     }
 
     /// Creates a resource wrapper for the specific resource type
@@ -261,8 +371,7 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        PushStaleResource(new (AllocateStaleResourceNode()) StaleResourceNode{NextCommandListNumber, std::move(Wrapper)});
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -270,8 +379,7 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        PushStaleResource(new (AllocateStaleResourceNode()) StaleResourceNode{NextCommandListNumber, Wrapper});
     }
 
     /// Adds a resource directly to the release queue
@@ -288,6 +396,7 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
+        MemoryAllocationTagScope    TagScope{m_AllocationTag};
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
     }
@@ -297,6 +406,7 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
+        MemoryAllocationTagScope    TagScope{m_AllocationTag};
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
     }
@@ -307,6 +417,7 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
+        MemoryAllocationTagScope    TagScope{m_AllocationTag};
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         ResourceType                Resource;
         while (Iterator(Resource))
@@ -326,7 +437,12 @@ public:
     {
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
+        MemoryAllocationTagScope    TagScope{m_AllocationTag};
         std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+        DrainStaleResourceList();
+        if (m_StaleResources.empty() || m_StaleResources.front().first > SubmittedCmdBuffNumber)
+            return;
+
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         while (!m_StaleResources.empty())
         {
@@ -335,6 +451,7 @@ public:
             {
                 m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
                 m_StaleResources.pop_front();
+                m_NumStaleResources.fetch_add(-1);
             }
             else
                 break;
@@ -345,7 +462,39 @@ public:
     /// Removes all objects from the release queue whose fence value is
     /// less than or equal to CompletedFenceValue
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    ///
+    /// \remarks   The resources are destroyed after the internal lock is released.
     void Purge(Uint64 CompletedFenceValue)
+    {
+        MemoryAllocationTagScope TagScope{m_AllocationTag};
+
+        // Take the vector that keeps its capacity from the previous calls. The vector is not
+        // locked while the resources are destroyed, so that a resource destructor may purge the queue.
+        RetiredResourcesVector RetiredResources(STD_ALLOCATOR_RAW_MEM(ResourceWrapperType, m_Allocator, "Allocator for vector<ResourceWrapperType>"));
+        {
+            std::lock_guard<std::mutex> Lock{m_RetiredResourcesMutex};
+            RetiredResources.swap(m_RetiredResources);
+        }
+
+        ExtractCompletedResources(CompletedFenceValue, RetiredResources);
+        RetiredResources.clear();
+
+        {
+            std::lock_guard<std::mutex> Lock{m_RetiredResourcesMutex};
+            if (RetiredResources.capacity() > m_RetiredResources.capacity())
+                RetiredResources.swap(m_RetiredResources);
+        }
+    }
+
+    /// Moves all objects whose fence value is less than or equal to CompletedFenceValue
+    /// from the release queue to RetiredResources.
+    /// \param [in]  CompletedFenceValue -  Value of the fence that has been completed by the GPU
+    /// \param [out] RetiredResources    -  Vector to which the completed resources are appended.
+    ///
+    /// \remarks   The resources are destroyed when the wrappers are destroyed, which allows
+    ///            an application to move the destruction to another thread.
+    template <typename VectorAllocatorType>
+    void ExtractCompletedResources(Uint64 CompletedFenceValue, std::vector<ResourceWrapperType, VectorAllocatorType>& RetiredResources)
     {
         std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
 
@@ -355,7 +504,10 @@ public:
         {
             auto& FirstObj = m_ReleaseQueue.front();
             if (FirstObj.first <= CompletedFenceValue)
+            {
+                RetiredResources.emplace_back(std::move(FirstObj.second));
                 m_ReleaseQueue.pop_front();
+            }
             else
                 break;
         }
@@ -364,22 +516,207 @@ public:
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return static_cast<size_t>(m_NumStaleResources.load());
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
+        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         return m_ReleaseQueue.size();
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
+    struct StaleResourceNode
+    {
+        StaleResourceNode(Uint64 _CmdListNumber, ResourceWrapperType&& _Wrapper) :
+            CmdListNumber{_CmdListNumber},
+            Wrapper{std::move(_Wrapper)}
+        {}
+
+        StaleResourceNode(Uint64 _CmdListNumber, const ResourceWrapperType& _Wrapper) :
+            CmdListNumber{_CmdListNumber},
+            Wrapper{_Wrapper}
+        {}
+
+        const Uint64        CmdListNumber;
+        ResourceWrapperType Wrapper;
+        StaleResourceNode*  pNext = nullptr;
+    };
+
+    // Node of the free list that occupies the memory of a recycled stale resource node
+    struct FreeNode
+    {
+        FreeNode* pNext = nullptr;
+    };
+    static_assert(sizeof(FreeNode) <= sizeof(StaleResourceNode), "Free node must fit into the stale resource node");
+
+    void* AllocateStaleResourceNode()
+    {
+        {
+            Threading::SpinLockGuard Guard{m_FreeNodeListLock};
+            if (FreeNode* pNode = m_pFreeNodeList)
+            {
+                m_pFreeNodeList = pNode->pNext;
+                pNode->~FreeNode();
+                return pNode;
+            }
+        }
+
+        MemoryAllocationTagScope TagScope{m_AllocationTag};
+        return m_Allocator.Allocate(sizeof(StaleResourceNode), "Stale resource node", __FILE__, __LINE__);
+    }
+
+    // Returns the node to the free list to be reused by AllocateStaleResourceNode().
+    void RecycleStaleResourceNode(StaleResourceNode* pNode)
+    {
+        pNode->~StaleResourceNode();
+
+        Threading::SpinLockGuard Guard{m_FreeNodeListLock};
+        m_pFreeNodeList = new (pNode) FreeNode{m_pFreeNodeList};
+    }
+
+    void PushStaleResource(StaleResourceNode* pNode)
+    {
+        m_NumStaleResources.fetch_add(1);
+
+        pNode->pNext = m_StaleResourceList.load(std::memory_order_relaxed);
+        while (!m_StaleResourceList.compare_exchange_weak(pNode->pNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+        {
+            // pNode->pNext is updated with the current list head
+        }
+    }
+
+    // Moves all resources from the lock-free list to m_StaleResources.
+    // Must be called while m_StaleObjectsMutex is locked.
+    void DrainStaleResourceList()
+    {
+        auto* pNode = m_StaleResourceList.exchange(nullptr, std::memory_order_acquire);
+
+        // The list is in reverse release order
+        StaleResourceNode* pReversed = nullptr;
+        while (pNode != nullptr)
+        {
+            auto* pNext  = pNode->pNext;
+            pNode->pNext = pReversed;
+            pReversed    = pNode;
+            pNode        = pNext;
+        }
+
+        while (pReversed != nullptr)
+        {
+            auto* pNext = pReversed->pNext;
+            m_StaleResources.emplace_back(pReversed->CmdListNumber, std::move(pReversed->Wrapper));
+            RecycleStaleResourceNode(pReversed);
+            pReversed = pNext;
+        }
+    }
+
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    // FIFO queue on a ring buffer. Unlike std::deque, it keeps its storage when the elements
+    // are removed, so adding and removing the elements does not allocate memory once the
+    // queue has grown to its working size.
+    class ElementQueue
+    {
+    public:
+        explicit ElementQueue(IMemoryAllocator& Allocator) noexcept :
+            m_Allocator{Allocator}
+        {}
+
+        // clang-format off
+        ElementQueue             (const ElementQueue&) = delete;
+        ElementQueue             (ElementQueue&&)      = delete;
+        ElementQueue& operator = (const ElementQueue&) = delete;
+        ElementQueue& operator = (ElementQueue&&)      = delete;
+        // clang-format on
+
+        ~ElementQueue()
+        {
+            while (!empty())
+                pop_front();
+            if (m_pElements != nullptr)
+                m_Allocator.Free(m_pElements);
+        }
+
+        bool   empty() const { return m_Size == 0; }
+        size_t size() const { return m_Size; }
+
+        ReleaseQueueElemType& front()
+        {
+            VERIFY_EXPR(!empty());
+            return m_pElements[m_Head];
+        }
+
+        void pop_front()
+        {
+            VERIFY_EXPR(!empty());
+            m_pElements[m_Head].~ReleaseQueueElemType();
+            m_Head = (m_Head + 1) & (m_Capacity - 1);
+            --m_Size;
+        }
+
+        template <typename... ArgsType>
+        void emplace_back(ArgsType&&... Args)
+        {
+            if (m_Size == m_Capacity)
+                Grow();
+            new (&m_pElements[(m_Head + m_Size) & (m_Capacity - 1)]) ReleaseQueueElemType{std::forward<ArgsType>(Args)...};
+            ++m_Size;
+        }
+
+    private:
+        void Grow()
+        {
+            const size_t NewCapacity = m_Capacity != 0 ? m_Capacity * 2 : 64;
+
+            auto* pNewElements = static_cast<ReleaseQueueElemType*>(
+                m_Allocator.Allocate(sizeof(ReleaseQueueElemType) * NewCapacity, "Release queue elements", __FILE__, __LINE__));
+            for (size_t i = 0; i < m_Size; ++i)
+            {
+                auto& Elem = m_pElements[(m_Head + i) & (m_Capacity - 1)];
+                new (&pNewElements[i]) ReleaseQueueElemType{std::move(Elem)};
+                Elem.~ReleaseQueueElemType();
+            }
+            if (m_pElements != nullptr)
+                m_Allocator.Free(m_pElements);
+
+            m_pElements = pNewElements;
+            m_Capacity  = NewCapacity;
+            m_Head      = 0;
+        }
+
+        IMemoryAllocator&     m_Allocator;
+        ReleaseQueueElemType* m_pElements = nullptr;
+        size_t                m_Capacity  = 0; // Always a power of two
+        size_t                m_Head      = 0;
+        size_t                m_Size      = 0;
+    };
+
+    IMemoryAllocator& m_Allocator;
+
+    // Tag of the memory allocated by the queue
+    const Uint32 m_AllocationTag;
+
+    mutable std::mutex m_ReleaseQueueMutex;
+    ElementQueue       m_ReleaseQueue;
+
+    // Lock-free list of resources released since the last DiscardStaleResources() call
+    std::atomic<StaleResourceNode*> m_StaleResourceList{nullptr};
+    std::atomic<Int64>              m_NumStaleResources{0};
+
+    // Nodes that have been drained from the stale resource list and are reused by SafeReleaseResource()
+    Threading::SpinLock m_FreeNodeListLock;
+    FreeNode*           m_pFreeNodeList = nullptr;
+
+    // Serializes the consumers of the stale resource list and protects m_StaleResources
+    std::mutex   m_StaleObjectsMutex;
+    ElementQueue m_StaleResources;
+
+    // Retired resources vector that is reused by Purge()
+    using RetiredResourcesVector = std::vector<ResourceWrapperType, STDAllocatorRawMem<ResourceWrapperType>>;
+    std::mutex             m_RetiredResourcesMutex;
+    RetiredResourcesVector m_RetiredResources;
 };
 
 } // namespace Diligent
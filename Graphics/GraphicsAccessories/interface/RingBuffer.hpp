@@ -39,7 +39,7 @@
 
 namespace Diligent
 {
-/// Implementation of a ring buffer. The class is not thread-safe.
+/// Implementation of a ring buffer. The class is not thread-safe, see ConcurrentRingBuffer.
 class RingBuffer
 {
 public:
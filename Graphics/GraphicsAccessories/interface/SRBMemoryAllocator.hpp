@@ -43,11 +43,19 @@ public:
 
     ~SRBMemoryAllocator();
 
+    /// Creates fixed-block allocators for shader variable and resource cache data.
+
+    /// \param [in] ThreadCacheSize - Number of blocks in every thread-local magazine,
+    ///                               see FixedBlockMemoryAllocator. When it is not zero,
+    ///                               threads create and destroy SRBs without contending
+    ///                               for the allocator mutex, and blocks released on one
+    ///                               thread return to the pool through that thread's cache.
     void Initialize(Uint32              SRBAllocationGranularity,
                     Uint32              ShaderVariableDataAllocatorCount,
                     const size_t* const ShaderVariableDataSizes,
                     Uint32              ResourceCacheDataAllocatorCount,
-                    const size_t* const ResourceCacheDataSizes);
+                    const size_t* const ResourceCacheDataSizes,
+                    Uint32              ThreadCacheSize = 0);
 
     IMemoryAllocator& GetShaderVariableDataAllocator(Uint32 Ind)
     {
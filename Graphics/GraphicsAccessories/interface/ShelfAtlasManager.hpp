@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of ShelfAtlasManager class
+
+#include <map>
+#include <unordered_map>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "DynamicAtlasManager.hpp"
+
+namespace Diligent
+{
+
+/// Shelf-based 2D atlas manager
+
+/// The manager places regions on horizontal shelves. A shelf is a horizontal strip of the atlas
+/// whose height is defined by the first region placed on it. Regions are allocated from the
+/// free horizontal spans of the shelf that fits the region height best.
+/// Compared to DynamicAtlasManager, allocation is much faster and packing is tighter when
+/// regions have similar heights (e.g. glyphs or uniform tiles), but space is wasted when
+/// region heights vary significantly.
+/// The manager remembers the last shelf used for every region height and first tries to
+/// allocate from the end of that shelf, so allocating regions of the same height takes
+/// amortized constant time. The hints are reset when a region is freed.
+class ShelfAtlasManager
+{
+public:
+    using Region = DynamicAtlasManager::Region;
+
+    ShelfAtlasManager(Uint32 Width, Uint32 Height);
+    ~ShelfAtlasManager();
+
+    // clang-format off
+    ShelfAtlasManager             (const ShelfAtlasManager&)  = delete;
+    ShelfAtlasManager& operator = (const ShelfAtlasManager&)  = delete;
+    ShelfAtlasManager             (      ShelfAtlasManager&&) = default;
+    ShelfAtlasManager& operator = (      ShelfAtlasManager&&) = delete;
+    // clang-format on
+
+    Region Allocate(Uint32 Width, Uint32 Height);
+    void   Free(Region&& R);
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+    Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
+    Uint32 GetShelfCount() const { return static_cast<Uint32>(m_Shelves.size()); }
+
+    bool IsEmpty() const
+    {
+        return m_AllocationCount == 0;
+    }
+
+private:
+#if DILIGENT_DEBUG
+    void DbgVerifyConsistency() const;
+#endif
+
+    struct Shelf
+    {
+        Uint32 Height = 0;
+
+        Uint32 AllocationCount = 0;
+
+        // Free horizontal spans ordered by their start: x -> width
+        std::map<Uint32, Uint32> FreeSpans;
+    };
+    using ShelfIterator = std::map<Uint32, Shelf>::iterator;
+
+    ShelfIterator AddShelf(Uint32 y, Uint32 Height);
+    Region        AllocateFromSpan(ShelfIterator ShelfIt, std::map<Uint32, Uint32>::iterator SpanIt, Uint32 Width, Uint32 Height);
+    // Merges the empty shelf with its empty neighbors and releases the
+    // shelves at the top of the atlas.
+    void ReleaseEmptyShelf(ShelfIterator ShelfIt);
+
+    const Uint32 m_Width;
+    const Uint32 m_Height;
+
+    Uint64 m_TotalFreeArea   = 0;
+    Uint32 m_AllocationCount = 0;
+
+    // Shelves ordered by their vertical position: y -> shelf
+    std::map<Uint32, Shelf> m_Shelves;
+
+    // The vertical position of the first row that is not used by shelves
+    Uint32 m_Top = 0;
+
+    // The last shelf used for every region height: height -> shelf
+    std::unordered_map<Uint32, ShelfIterator> m_ShelfHints;
+};
+
+} // namespace Diligent
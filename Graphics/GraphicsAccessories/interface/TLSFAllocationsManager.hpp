@@ -0,0 +1,666 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+// Two-level segregated fit (TLSF) free block manager for variable-size allocation requests
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+// The class is a drop-in replacement for VariableSizeAllocationsManager that implements
+// two-level segregated fit (TLSF) free block management. Free blocks are kept in
+// segregated lists indexed by the first level (power of two) and the second level
+// (linear subdivision of the power-of-two range) of their size. Two bitmaps track
+// non-empty lists, so that a suitable list is found with two bit scans.
+// Block descriptions are stored in a pool, and free blocks are found by their start
+// and end offsets through open-addressing hash tables, so that Allocate() and Free()
+// take constant time and do not allocate memory for every block.
+//
+//   m_FLBitmap      0 1 0 1 ...
+//                     |   |
+//   m_SLBitmaps[1]    '-> 0 0 1 0 ...   sizes [16, 32) split into 16 ranges
+//                             |
+//   m_FreeListHeads[1][2]     '-> {Offset, Size = 18} <-> {Offset, Size = 19}
+//
+// Unlike VariableSizeAllocationsManager, Allocate() uses a good fit rather than the
+// best fit: the block is taken from the first non-empty list whose smallest size is
+// not less than the requested size. The allocation semantics are otherwise identical.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    static constexpr Uint32 SLBits  = 4;
+    static constexpr Uint32 SLCount = 1u << SLBits;
+    static constexpr Uint32 FLCount = sizeof(OffsetType) * 8 - SLBits + 1;
+
+    struct FreeBlock
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Links in the segregated free list. For unused pool entries,
+        // NextFree references the next unused entry.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+    };
+
+    // Open-addressing hash table with linear probing that maps offsets to free block indices
+    class BlockIndexMap
+    {
+    public:
+        explicit BlockIndexMap(IMemoryAllocator& Allocator) :
+            m_Slots(STD_ALLOCATOR_RAW_MEM(Slot, Allocator, "Allocator for vector<TLSFAllocationsManager::BlockIndexMap::Slot>"))
+        {}
+
+        // clang-format off
+        BlockIndexMap(BlockIndexMap&& rhs) noexcept :
+            m_Slots      {std::move(rhs.m_Slots)},
+            m_NumElements{rhs.m_NumElements     },
+            m_HashShift  {rhs.m_HashShift       }
+        {
+            // clang-format on
+            rhs.m_NumElements = 0;
+        }
+
+        BlockIndexMap& operator=(BlockIndexMap&& rhs) = default;
+
+        void Insert(OffsetType Key, Uint32 Index)
+        {
+            VERIFY_EXPR(Index != InvalidIndex);
+            if ((m_NumElements + 1) * 2 > m_Slots.size())
+                Rehash(std::max(m_Slots.size() * 2, size_t{16}));
+
+            const auto Mask = m_Slots.size() - 1;
+            for (auto s = GetHomeSlot(Key);; s = (s + 1) & Mask)
+            {
+                auto& Slot = m_Slots[s];
+                VERIFY(Slot.Index == InvalidIndex || Slot.Key != Key, "Key ", Key, " is already in the table");
+                if (Slot.Index == InvalidIndex)
+                {
+                    Slot.Key   = Key;
+                    Slot.Index = Index;
+                    ++m_NumElements;
+                    return;
+                }
+            }
+        }
+
+        Uint32 Find(OffsetType Key) const
+        {
+            const auto Slot = FindSlot(Key);
+            return Slot != InvalidSlot ? m_Slots[Slot].Index : InvalidIndex;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            auto s = FindSlot(Key);
+            VERIFY(s != InvalidSlot, "Key ", Key, " is not found");
+            if (s == InvalidSlot)
+                return;
+
+            // Backward-shift deletion keeps probe sequences intact without tombstones
+            const auto Mask = m_Slots.size() - 1;
+            for (auto n = (s + 1) & Mask; m_Slots[n].Index != InvalidIndex; n = (n + 1) & Mask)
+            {
+                const auto Home = GetHomeSlot(m_Slots[n].Key);
+                // Move the element if its home slot is not cyclically in (s, n]
+                const bool KeepInPlace = (s <= n) ? (s < Home && Home <= n) : (s < Home || Home <= n);
+                if (!KeepInPlace)
+                {
+                    m_Slots[s] = m_Slots[n];
+                    s          = n;
+                }
+            }
+            m_Slots[s] = Slot{};
+            --m_NumElements;
+        }
+
+        size_t GetNumElements() const { return m_NumElements; }
+
+    private:
+        struct Slot
+        {
+            OffsetType Key   = 0;
+            Uint32     Index = InvalidIndex;
+        };
+        static constexpr size_t InvalidSlot = ~size_t{0};
+
+        size_t GetHomeSlot(OffsetType Key) const
+        {
+            // Fibonacci hashing
+            return static_cast<size_t>((Uint64{Key} * Uint64{0x9E3779B97F4A7C15}) >> m_HashShift);
+        }
+
+        size_t FindSlot(OffsetType Key) const
+        {
+            if (m_NumElements == 0)
+                return InvalidSlot;
+
+            const auto Mask = m_Slots.size() - 1;
+            for (auto s = GetHomeSlot(Key);; s = (s + 1) & Mask)
+            {
+                const auto& Slot = m_Slots[s];
+                if (Slot.Index == InvalidIndex)
+                    return InvalidSlot;
+                if (Slot.Key == Key)
+                    return s;
+            }
+        }
+
+        void Rehash(size_t NewSize)
+        {
+            VERIFY_EXPR(IsPowerOfTwo(NewSize));
+            auto OldSlots = std::move(m_Slots);
+            m_Slots.clear();
+            m_Slots.resize(NewSize);
+            m_HashShift   = 64 - PlatformMisc::GetMSB(Uint64{NewSize});
+            m_NumElements = 0;
+            for (const auto& Slot : OldSlots)
+            {
+                if (Slot.Index != InvalidIndex)
+                    Insert(Slot.Key, Slot.Index);
+            }
+        }
+
+        std::vector<Slot, STDAllocatorRawMem<Slot>> m_Slots;
+
+        size_t m_NumElements = 0;
+        Uint32 m_HashShift   = 64;
+    };
+
+public:
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        m_Blocks(STD_ALLOCATOR_RAW_MEM(FreeBlock, Allocator, "Allocator for vector<TLSFAllocationsManager::FreeBlock>")),
+        m_BlocksByStart{Allocator},
+        m_BlocksByEnd{Allocator},
+        m_MaxSize{MaxSize},
+        m_FreeSize{MaxSize}
+    {
+        for (auto& Heads : m_FreeListHeads)
+            Heads.fill(InvalidIndex);
+        m_SLBitmaps.fill(0);
+
+        // Insert single maximum-size block
+        if (m_MaxSize > 0)
+            AddFreeBlock(0, m_MaxSize);
+        ResetCurrAlignment();
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_NumFreeBlocks != 0)
+        {
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            const auto BlockIdx = m_BlocksByStart.Find(0);
+            VERIFY(BlockIdx != InvalidIndex, "Head chunk offset is expected to be 0");
+            if (BlockIdx != InvalidIndex)
+                VERIFY(m_Blocks[BlockIdx].Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept :
+        m_Blocks        {std::move(rhs.m_Blocks)       },
+        m_BlocksByStart {std::move(rhs.m_BlocksByStart)},
+        m_BlocksByEnd   {std::move(rhs.m_BlocksByEnd)  },
+        m_FreeListHeads {rhs.m_FreeListHeads },
+        m_SLBitmaps     {rhs.m_SLBitmaps     },
+        m_FLBitmap      {rhs.m_FLBitmap      },
+        m_FirstUnusedBlock{rhs.m_FirstUnusedBlock},
+        m_NumFreeBlocks {rhs.m_NumFreeBlocks },
+        m_MaxSize       {rhs.m_MaxSize       },
+        m_FreeSize      {rhs.m_FreeSize      },
+        m_CurrAlignment {rhs.m_CurrAlignment }
+    {
+        // clang-format on
+        rhs.m_FLBitmap         = 0;
+        rhs.m_FirstUnusedBlock = InvalidIndex;
+        rhs.m_NumFreeBlocks    = 0;
+        rhs.m_MaxSize          = 0;
+        rhs.m_FreeSize         = 0;
+        rhs.m_CurrAlignment    = 0;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager& operator = (TLSFAllocationsManager&& rhs) = default;
+    TLSFAllocationsManager             (const TLSFAllocationsManager&) = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&) = delete;
+    // clang-format on
+
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+
+        // Find the first non-empty list whose blocks are all large enough
+        // to encompass Size + AlignmentReserve bytes
+        Uint32 FL = 0, SL = 0;
+        if (!FindSuitableList(Size + AlignmentReserve, FL, SL))
+            return Allocation::InvalidAllocation();
+
+        const auto BlockIdx = m_FreeListHeads[FL][SL];
+        VERIFY_EXPR(BlockIdx != InvalidIndex && m_Blocks[BlockIdx].Size >= Size + AlignmentReserve);
+        return AllocateFromBlock(BlockIdx, Size, Alignment, AlignmentReserve);
+    }
+
+    // Allocates space from the free block with the lowest offset, see VariableSizeAllocationsManager::AllocateLowest().
+    // Unlike Allocate(), the method iterates through all free blocks.
+    Allocation AllocateLowest(OffsetType Size, OffsetType Alignment, OffsetType MaxOffset)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+
+        auto LowestBlockIdx = InvalidIndex;
+        ForEachFreeBlock([&](Uint32 BlockIdx) {
+            const auto& Block = m_Blocks[BlockIdx];
+            if (Block.Offset < MaxOffset && Block.Size >= Size + AlignmentReserve &&
+                (LowestBlockIdx == InvalidIndex || Block.Offset < m_Blocks[LowestBlockIdx].Offset))
+                LowestBlockIdx = BlockIdx;
+        });
+
+        return LowestBlockIdx != InvalidIndex ?
+            AllocateFromBlock(LowestBlockIdx, Size, Alignment, AlignmentReserve) :
+            Allocation::InvalidAllocation();
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        VERIFY_EXPR(allocation.IsValid());
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
+
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+
+        //   PrevBlock.Offset           Offset            NextBlock.Offset
+        //     |                          |                    |
+        //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        const auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+        if (NextBlockIdx != InvalidIndex)
+        {
+            NewSize += m_Blocks[NextBlockIdx].Size;
+            RemoveFreeBlock(NextBlockIdx);
+        }
+
+        const auto PrevBlockIdx = m_BlocksByEnd.Find(Offset);
+        if (PrevBlockIdx != InvalidIndex)
+        {
+            NewOffset = m_Blocks[PrevBlockIdx].Offset;
+            NewSize += m_Blocks[PrevBlockIdx].Size;
+            RemoveFreeBlock(PrevBlockIdx);
+        }
+
+        AddFreeBlock(NewOffset, NewSize);
+
+        m_FreeSize += Size;
+        if (IsEmpty())
+        {
+            // Reset current alignment
+            VERIFY_EXPR(GetNumFreeBlocks() == 1);
+            ResetCurrAlignment();
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    // The largest block is in the highest non-empty list,
+    // so only this list needs to be searched.
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+        OffsetType MaxSize = 0;
+        for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            MaxSize = std::max(MaxSize, m_Blocks[BlockIdx].Size);
+        return MaxSize;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        OffsetType NewBlockOffset = m_MaxSize;
+        OffsetType NewBlockSize   = ExtraSize;
+
+        const auto LastBlockIdx = m_BlocksByEnd.Find(m_MaxSize);
+        if (LastBlockIdx != InvalidIndex)
+        {
+            // Extend the last block
+            NewBlockOffset = m_Blocks[LastBlockIdx].Offset;
+            NewBlockSize += m_Blocks[LastBlockIdx].Size;
+            RemoveFreeBlock(LastBlockIdx);
+        }
+
+        AddFreeBlock(NewBlockOffset, NewBlockSize);
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+private:
+    static void GetListIndices(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SLCount)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(Uint64{Size});
+
+            FL = MSB - SLBits + 1;
+            SL = static_cast<Uint32>(Size >> (MSB - SLBits)) - SLCount;
+        }
+        VERIFY_EXPR(FL < FLCount && SL < SLCount);
+    }
+
+    bool FindSuitableList(OffsetType Size, Uint32& FL, Uint32& SL) const
+    {
+        if (Size >= SLCount)
+        {
+            // Round the size up to the next list boundary so that
+            // any block in the list is large enough
+            const auto Round = (OffsetType{1} << (PlatformMisc::GetMSB(Uint64{Size}) - SLBits)) - 1;
+            if (Size > ~OffsetType{0} - Round)
+                return false;
+            Size += Round;
+        }
+        GetListIndices(Size, FL, SL);
+
+        auto SLMap = m_SLBitmaps[FL] & (~Uint32{0} << SL);
+        if (SLMap == 0)
+        {
+            if (FL + 1 >= FLCount)
+                return false;
+
+            const auto FLMap = m_FLBitmap & (~Uint64{0} << (FL + 1));
+            if (FLMap == 0)
+                return false;
+
+            FL    = PlatformMisc::GetLSB(FLMap);
+            SLMap = m_SLBitmaps[FL];
+        }
+        SL = PlatformMisc::GetLSB(SLMap);
+        return true;
+    }
+
+    Allocation AllocateFromBlock(Uint32 BlockIdx, OffsetType Size, OffsetType Alignment, OffsetType AlignmentReserve)
+    {
+        const auto Offset    = m_Blocks[BlockIdx].Offset;
+        const auto BlockSize = m_Blocks[BlockIdx].Size;
+        VERIFY_EXPR(Size + AlignmentReserve <= BlockSize);
+
+        //     Block.Offset
+        //        |                                  |
+        //        |<----------Block.Size------------>|
+        //        |<------Size------>|<---NewSize--->|
+        //        |                  |
+        //      Offset              NewOffset
+        //
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+        auto AlignedOffset = AlignUp(Offset, Alignment);
+        auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
+        auto NewOffset = Offset + AdjustedSize;
+        auto NewSize   = BlockSize - AdjustedSize;
+        RemoveFreeBlock(BlockIdx);
+        if (NewSize > 0)
+        {
+            AddFreeBlock(NewOffset, NewSize);
+        }
+
+        m_FreeSize -= AdjustedSize;
+
+        if ((Size & (m_CurrAlignment - 1)) != 0)
+        {
+            if (IsPowerOfTwo(Size))
+            {
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = std::min(m_CurrAlignment, Alignment);
+            }
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void AddFreeBlock(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0);
+
+        Uint32 BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+        }
+        else
+        {
+            VERIFY(m_Blocks.size() < InvalidIndex, "Too many free blocks");
+            BlockIdx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        Uint32 FL = 0, SL = 0;
+        GetListIndices(Size, FL, SL);
+
+        auto& Block    = m_Blocks[BlockIdx];
+        Block.Offset   = Offset;
+        Block.Size     = Size;
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = m_FreeListHeads[FL][SL];
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = BlockIdx;
+        m_FreeListHeads[FL][SL] = BlockIdx;
+
+        m_SLBitmaps[FL] |= 1u << SL;
+        m_FLBitmap |= Uint64{1} << FL;
+
+        m_BlocksByStart.Insert(Offset, BlockIdx);
+        m_BlocksByEnd.Insert(Offset + Size, BlockIdx);
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+
+        Uint32 FL = 0, SL = 0;
+        GetListIndices(Block.Size, FL, SL);
+
+        if (Block.PrevFree != InvalidIndex)
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        else
+        {
+            VERIFY_EXPR(m_FreeListHeads[FL][SL] == BlockIdx);
+            m_FreeListHeads[FL][SL] = Block.NextFree;
+        }
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        if (m_FreeListHeads[FL][SL] == InvalidIndex)
+        {
+            m_SLBitmaps[FL] &= ~(1u << SL);
+            if (m_SLBitmaps[FL] == 0)
+                m_FLBitmap &= ~(Uint64{1} << FL);
+        }
+
+        m_BlocksByStart.Erase(Block.Offset);
+        m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+        --m_NumFreeBlocks;
+
+        Block.PrevFree     = InvalidIndex;
+        Block.NextFree     = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = BlockIdx;
+    }
+
+    template <typename HandlerType>
+    void ForEachFreeBlock(HandlerType Handler) const
+    {
+        for (auto FLMap = m_FLBitmap; FLMap != 0; FLMap &= FLMap - 1)
+        {
+            const auto FL = PlatformMisc::GetLSB(FLMap);
+            for (auto SLMap = m_SLBitmaps[FL]; SLMap != 0; SLMap &= SLMap - 1)
+            {
+                const auto SL = PlatformMisc::GetLSB(SLMap);
+                for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                    Handler(BlockIdx);
+            }
+        }
+    }
+
+    void ResetCurrAlignment()
+    {
+        for (m_CurrAlignment = 1; m_CurrAlignment * 2 <= m_MaxSize; m_CurrAlignment *= 2)
+        {}
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyList()
+    {
+        VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+        VERIFY_EXPR(m_BlocksByStart.GetNumElements() == m_NumFreeBlocks);
+        VERIFY_EXPR(m_BlocksByEnd.GetNumElements() == m_NumFreeBlocks);
+
+        std::vector<std::pair<OffsetType, OffsetType>> FreeBlocks;
+        FreeBlocks.reserve(m_NumFreeBlocks);
+        ForEachFreeBlock([&](Uint32 BlockIdx) {
+            const auto& Block = m_Blocks[BlockIdx];
+
+            Uint32 FL = 0, SL = 0;
+            GetListIndices(Block.Size, FL, SL);
+            VERIFY((m_SLBitmaps[FL] & (1u << SL)) != 0, "Block is in the list that is marked as empty");
+            VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+            VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+            FreeBlocks.emplace_back(Block.Offset, Block.Size);
+        });
+        VERIFY_EXPR(FreeBlocks.size() == m_NumFreeBlocks);
+        std::sort(FreeBlocks.begin(), FreeBlocks.end());
+
+        OffsetType TotalFreeSize = 0;
+        for (size_t i = 0; i < FreeBlocks.size(); ++i)
+        {
+            const auto Offset = FreeBlocks[i].first;
+            const auto Size   = FreeBlocks[i].second;
+            VERIFY_EXPR(Offset + Size <= m_MaxSize);
+            VERIFY((Offset & (m_CurrAlignment - 1)) == 0, "Block offset (", Offset, ") is not ", m_CurrAlignment, "-aligned");
+            if (Offset + Size < m_MaxSize)
+                VERIFY((Size & (m_CurrAlignment - 1)) == 0, "All block sizes except for the last one must be ", m_CurrAlignment, "-aligned");
+            VERIFY(i == 0 || Offset > FreeBlocks[i - 1].first + FreeBlocks[i - 1].second, "Unmerged adjacent or overlapping blocks detected");
+            TotalFreeSize += Size;
+        }
+
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+    }
+#endif
+
+    // Pool of block descriptions. Unused entries are linked through FreeBlock::NextFree.
+    std::vector<FreeBlock, STDAllocatorRawMem<FreeBlock>> m_Blocks;
+
+    // Free blocks indexed by their start and end offsets
+    BlockIndexMap m_BlocksByStart;
+    BlockIndexMap m_BlocksByEnd;
+
+    std::array<std::array<Uint32, SLCount>, FLCount> m_FreeListHeads;
+    std::array<Uint32, FLCount>                      m_SLBitmaps;
+    Uint64                                           m_FLBitmap = 0;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumFreeBlocks    = 0;
+
+    OffsetType m_MaxSize       = 0;
+    OffsetType m_FreeSize      = 0;
+    OffsetType m_CurrAlignment = 0;
+    // When adding new members, do not forget to update move ctor
+};
+} // namespace Diligent
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// CPU texel format conversion of texture data
+
+#include <cstddef>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Texel conversion performed by Diligent::ConvertTexelData().
+enum TEXEL_CONVERSION : Uint8
+{
+    /// 3-byte RGB texels to 4-byte RGBA texels with alpha set to 255.
+    TEXEL_CONVERSION_RGB8_TO_RGBA8 = 0,
+
+    /// Swaps the R and B channels of 4-byte texels (BGRA8 to RGBA8 and vice versa).
+    TEXEL_CONVERSION_BGRA8_TO_RGBA8,
+
+    /// 32-bit float components to 16-bit half-precision float components.
+    /// The values are rounded to the nearest even, out-of-range values are converted to infinity.
+    TEXEL_CONVERSION_FLOAT32_TO_FLOAT16,
+
+    /// 16-bit normalized unsigned integer components to 32-bit float components.
+    TEXEL_CONVERSION_UNORM16_TO_FLOAT32,
+
+    /// Linear RGBA8 texels to sRGB RGBA8 texels. Alpha is not converted.
+    /// The color channels are converted using Diligent::LinearToSRGB().
+    TEXEL_CONVERSION_RGBA8_LINEAR_TO_SRGB,
+
+    /// Linear RGBA32F texels to sRGB RGBA8 texels. The values are clamped to [0, 1] range.
+    /// The color channels are converted using Diligent::FastLinearToSRGB(), alpha is not converted.
+    TEXEL_CONVERSION_RGBA32F_LINEAR_TO_RGBA8_SRGB,
+
+    TEXEL_CONVERSION_COUNT
+};
+
+/// Texel conversion attributes, see Diligent::ConvertTexelData().
+struct ConvertTexelDataAttribs
+{
+    /// Conversion to perform.
+    TEXEL_CONVERSION Conversion = TEXEL_CONVERSION_COUNT;
+
+    /// The number of texels in a row.
+    Uint32 Width = 0;
+
+    /// The number of rows.
+    Uint32 NumRows = 0;
+
+    /// The number of components in a texel.
+
+    /// Only used by TEXEL_CONVERSION_FLOAT32_TO_FLOAT16 and TEXEL_CONVERSION_UNORM16_TO_FLOAT32.
+    /// Other conversions define the texel layout.
+    Uint32 NumComponents = 1;
+
+    /// Source texels.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination memory for the converted texels.
+
+    /// The destination may be the memory of a mapped upload buffer or texture
+    /// with a different row stride, so that the texels are converted and copied
+    /// to the staging memory in one pass.
+    void* pDstData = nullptr;
+
+    /// Destination row stride in bytes.
+    size_t DstStride = 0;
+};
+
+/// Converts texel data on the CPU.
+
+/// \return     true if the data was converted, and false if the attributes are invalid.
+///
+/// \remarks    The conversions use SSE2 instructions when they are available.
+///             The results are identical to the scalar implementation.
+bool ConvertTexelData(const ConvertTexelDataAttribs& Attribs);
+
+/// Returns the size in bytes of the source and destination texels of the conversion.
+void GetTexelConversionSizes(TEXEL_CONVERSION Conversion, Uint32 NumComponents, Uint32& SrcTexelSize, Uint32& DstTexelSize);
+
+} // namespace Diligent
@@ -201,27 +201,53 @@ public:
         if (SmallestBlockItIt == m_FreeBlocksBySize.end())
             return Allocation::InvalidAllocation();
 
-        auto SmallestBlockIt = SmallestBlockItIt->second;
-        VERIFY_EXPR(Size + AlignmentReserve <= SmallestBlockIt->second.Size);
-        VERIFY_EXPR(SmallestBlockIt->second.Size == SmallestBlockItIt->first);
+        VERIFY_EXPR(SmallestBlockItIt->second->second.Size == SmallestBlockItIt->first);
+        return AllocateFromBlock(SmallestBlockItIt->second, Size, Alignment, AlignmentReserve);
+    }
+
+    // Unlike Allocate() that uses the smallest free block that fits the allocation,
+    // allocates space from the free block with the lowest offset. Returns an invalid
+    // allocation if there is no such block that starts before MaxOffset.
+    // This is useful to move existing allocations towards the start of the space.
+    Allocation AllocateLowest(OffsetType Size, OffsetType Alignment, OffsetType MaxOffset)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+        for (auto BlockIt = m_FreeBlocksByOffset.begin(); BlockIt != m_FreeBlocksByOffset.end() && BlockIt->first < MaxOffset; ++BlockIt)
+        {
+            if (BlockIt->second.Size >= Size + AlignmentReserve)
+                return AllocateFromBlock(BlockIt, Size, Alignment, AlignmentReserve);
+        }
+
+        return Allocation::InvalidAllocation();
+    }
 
-        //     SmallestBlockIt.Offset
+private:
+    Allocation AllocateFromBlock(TFreeBlocksByOffsetMap::iterator BlockIt, OffsetType Size, OffsetType Alignment, OffsetType AlignmentReserve)
+    {
+        VERIFY_EXPR(Size + AlignmentReserve <= BlockIt->second.Size);
+
+        //     BlockIt.Offset
         //        |                                  |
-        //        |<------SmallestBlockIt.Size------>|
+        //        |<---------BlockIt.Size----------->|
         //        |<------Size------>|<---NewSize--->|
         //        |                  |
         //      Offset              NewOffset
         //
-        auto Offset = SmallestBlockIt->first;
+        auto Offset = BlockIt->first;
         VERIFY_EXPR(Offset % m_CurrAlignment == 0);
         auto AlignedOffset = AlignUp(Offset, Alignment);
         auto AdjustedSize  = Size + (AlignedOffset - Offset);
         VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
         auto NewOffset = Offset + AdjustedSize;
-        auto NewSize   = SmallestBlockIt->second.Size - AdjustedSize;
-        VERIFY_EXPR(SmallestBlockItIt == SmallestBlockIt->second.OrderBySizeIt);
-        m_FreeBlocksBySize.erase(SmallestBlockItIt);
-        m_FreeBlocksByOffset.erase(SmallestBlockIt);
+        auto NewSize   = BlockIt->second.Size - AdjustedSize;
+        m_FreeBlocksBySize.erase(BlockIt->second.OrderBySizeIt);
+        m_FreeBlocksByOffset.erase(BlockIt);
         if (NewSize > 0)
         {
             AddNewBlock(NewOffset, NewSize);
@@ -248,6 +274,7 @@ public:
         return Allocation{Offset, AdjustedSize};
     }
 
+public:
     void Free(Allocation&& allocation)
     {
         VERIFY_EXPR(allocation.IsValid());
@@ -32,14 +32,23 @@
 #pragma once
 
 #include <deque>
+#include <vector>
+#include <algorithm>
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 
 namespace Diligent
 {
 // Class extends basic variable-size memory block allocator by deferring deallocation
-// of freed blocks until the corresponding frame is completed
-class VariableSizeGPUAllocationsManager : public VariableSizeAllocationsManager
+// of freed blocks until the corresponding frame is completed.
+// AllocationsManagerType is either VariableSizeAllocationsManager or TLSFAllocationsManager.
+template <typename AllocationsManagerType>
+class VariableSizeGPUAllocationsManagerImpl : public AllocationsManagerType
 {
+public:
+    using OffsetType = typename AllocationsManagerType::OffsetType;
+    using Allocation = typename AllocationsManagerType::Allocation;
+
 private:
     struct StaleAllocationAttribs
     {
@@ -52,36 +61,38 @@ private:
     };
 
 public:
-    VariableSizeGPUAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
-        VariableSizeAllocationsManager{MaxSize, Allocator},
-        m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, Allocator, "Allocator for deque<StaleAllocationAttribs>")}
+    VariableSizeGPUAllocationsManagerImpl(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        AllocationsManagerType{MaxSize, Allocator},
+        m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, Allocator, "Allocator for deque<StaleAllocationAttribs>")},
+        m_ReleasedRanges{STD_ALLOCATOR_RAW_MEM(ReleasedRange, Allocator, "Allocator for vector<ReleasedRange>")}
     {}
 
-    ~VariableSizeGPUAllocationsManager()
+    ~VariableSizeGPUAllocationsManagerImpl()
     {
         VERIFY(m_StaleAllocations.empty(), "Not all stale allocations released");
         VERIFY(m_StaleAllocationsSize == 0, "Not all stale allocations released");
     }
 
     // = default causes compiler error when instantiating std::vector::emplace_back() in Visual Studio 2015 (Version 14.0.23107.0 D14REL)
-    VariableSizeGPUAllocationsManager(VariableSizeGPUAllocationsManager&& rhs) noexcept :
-        VariableSizeAllocationsManager(std::move(rhs)),
+    VariableSizeGPUAllocationsManagerImpl(VariableSizeGPUAllocationsManagerImpl&& rhs) noexcept :
+        AllocationsManagerType(std::move(rhs)),
         m_StaleAllocations(std::move(rhs.m_StaleAllocations)),
-        m_StaleAllocationsSize(rhs.m_StaleAllocationsSize)
+        m_StaleAllocationsSize(rhs.m_StaleAllocationsSize),
+        m_ReleasedRanges(std::move(rhs.m_ReleasedRanges))
     {
         rhs.m_StaleAllocationsSize = 0;
     }
 
     // clang-format off
-	VariableSizeGPUAllocationsManager& operator = (VariableSizeGPUAllocationsManager&& rhs) = delete;
-    VariableSizeGPUAllocationsManager(const VariableSizeGPUAllocationsManager&) = delete;
-    VariableSizeGPUAllocationsManager& operator = (const VariableSizeGPUAllocationsManager&) = delete;
+	VariableSizeGPUAllocationsManagerImpl& operator = (VariableSizeGPUAllocationsManagerImpl&& rhs) = delete;
+    VariableSizeGPUAllocationsManagerImpl(const VariableSizeGPUAllocationsManagerImpl&) = delete;
+    VariableSizeGPUAllocationsManagerImpl& operator = (const VariableSizeGPUAllocationsManagerImpl&) = delete;
     // clang-format on
 
-    void Free(VariableSizeAllocationsManager::Allocation&& allocation, Uint64 FenceValue)
+    void Free(Allocation&& allocation, Uint64 FenceValue)
     {
         Free(allocation.UnalignedOffset, allocation.Size, FenceValue);
-        allocation = VariableSizeAllocationsManager::Allocation{};
+        allocation = Allocation{};
     }
 
     void Free(OffsetType Offset, OffsetType Size, Uint64 FenceValue)
@@ -98,14 +109,42 @@ public:
     // is at most N (n <= N)
     void ReleaseStaleAllocations(Uint64 LastCompletedFenceValue)
     {
-        // Free all allocations from the beginning of the queue that belong to completed command lists
+        // Collect all allocations from the beginning of the queue that belong to completed command lists
+        m_ReleasedRanges.clear();
         while (!m_StaleAllocations.empty() && m_StaleAllocations.front().FenceValue <= LastCompletedFenceValue)
         {
             auto& OldestAllocation = m_StaleAllocations.front();
-            VariableSizeAllocationsManager::Free(OldestAllocation.Offset, OldestAllocation.Size);
+            m_ReleasedRanges.emplace_back(OldestAllocation.Offset, OldestAllocation.Size);
             m_StaleAllocationsSize -= OldestAllocation.Size;
             m_StaleAllocations.pop_front();
         }
+
+        if (m_ReleasedRanges.size() > 1)
+        {
+            // Sort released ranges by offset and merge adjacent ones in a single pass, so that
+            // every contiguous range is returned to the free block manager at once
+            std::sort(m_ReleasedRanges.begin(), m_ReleasedRanges.end(),
+                      [](const ReleasedRange& lhs, const ReleasedRange& rhs) {
+                          return lhs.Offset < rhs.Offset;
+                      });
+
+            size_t LastRange = 0;
+            for (size_t i = 1; i < m_ReleasedRanges.size(); ++i)
+            {
+                auto&       Last  = m_ReleasedRanges[LastRange];
+                const auto& Range = m_ReleasedRanges[i];
+                VERIFY(Last.Offset + Last.Size <= Range.Offset, "Overlapping stale allocations detected");
+                if (Last.Offset + Last.Size == Range.Offset)
+                    Last.Size += Range.Size;
+                else
+                    m_ReleasedRanges[++LastRange] = Range;
+            }
+            m_ReleasedRanges.erase(m_ReleasedRanges.begin() + LastRange + 1, m_ReleasedRanges.end());
+        }
+
+        for (const auto& Range : m_ReleasedRanges)
+            AllocationsManagerType::Free(Range.Offset, Range.Size);
+        m_ReleasedRanges.clear();
     }
 
     size_t GetStaleAllocationsSize() const { return m_StaleAllocationsSize; }
@@ -113,5 +152,19 @@ public:
 private:
     std::deque<StaleAllocationAttribs, STDAllocatorRawMem<StaleAllocationAttribs>> m_StaleAllocations;
     size_t                                                                         m_StaleAllocationsSize = 0;
+
+    struct ReleasedRange
+    {
+        OffsetType Offset;
+        OffsetType Size;
+        ReleasedRange(OffsetType _Offset, OffsetType _Size) :
+            Offset{_Offset}, Size{_Size}
+        {}
+    };
+    // Scratch space used by ReleaseStaleAllocations()
+    std::vector<ReleasedRange, STDAllocatorRawMem<ReleasedRange>> m_ReleasedRanges;
 };
+
+using VariableSizeGPUAllocationsManager = VariableSizeGPUAllocationsManagerImpl<VariableSizeAllocationsManager>;
+using TLSFGPUAllocationsManager         = VariableSizeGPUAllocationsManagerImpl<TLSFAllocationsManager>;
 } // namespace Diligent
@@ -0,0 +1,951 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 BlockDim     = 4;
+constexpr Uint32 TexelsInBlock = BlockDim * BlockDim;
+
+using BlockTexels = Uint8[TexelsInBlock][4];
+
+Uint32 GetBlockSize(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC4_UNORM:
+            return 8;
+
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return 16;
+
+        default:
+            return 0;
+    }
+}
+
+// Processes rows of blocks [0, NumBlockRows) on up to NumThreads threads.
+template <typename HandlerType>
+void ProcessBlockRows(Uint32 NumBlockRows, Uint32 NumThreads, const HandlerType& Handler)
+{
+    NumThreads = std::max(std::min(NumThreads, NumBlockRows), 1u);
+    if (NumThreads == 1)
+    {
+        Handler(0u, NumBlockRows);
+        return;
+    }
+
+    std::vector<std::thread> Threads;
+    Threads.reserve(NumThreads - 1);
+    for (Uint32 t = 1; t < NumThreads; ++t)
+    {
+        const Uint32 StartRow = NumBlockRows * t / NumThreads;
+        const Uint32 EndRow   = NumBlockRows * (t + 1) / NumThreads;
+        Threads.emplace_back([&Handler, StartRow, EndRow]() { Handler(StartRow, EndRow); });
+    }
+    Handler(0u, NumBlockRows / NumThreads);
+
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
+void LoadBlock(const Uint8* pSrc, size_t Stride, Uint32 Width, Uint32 Height, Uint32 BlockX, Uint32 BlockY, BlockTexels& Texels)
+{
+    for (Uint32 y = 0; y < BlockDim; ++y)
+    {
+        const auto  SrcY    = std::min(BlockY * BlockDim + y, Height - 1);
+        const auto* pSrcRow = pSrc + SrcY * Stride;
+        for (Uint32 x = 0; x < BlockDim; ++x)
+        {
+            const auto SrcX = std::min(BlockX * BlockDim + x, Width - 1);
+            memcpy(Texels[y * BlockDim + x], pSrcRow + SrcX * 4, 4);
+        }
+    }
+}
+
+void StoreBlock(const BlockTexels& Texels, Uint32 Width, Uint32 Height, Uint32 BlockX, Uint32 BlockY, Uint8* pDst, size_t Stride)
+{
+    for (Uint32 y = 0; y < BlockDim && BlockY * BlockDim + y < Height; ++y)
+    {
+        auto* pDstRow = pDst + (BlockY * BlockDim + y) * Stride;
+        for (Uint32 x = 0; x < BlockDim && BlockX * BlockDim + x < Width; ++x)
+            memcpy(pDstRow + (BlockX * BlockDim + x) * 4, Texels[y * BlockDim + x], 4);
+    }
+}
+
+template <Uint32 NumComps>
+Uint32 ColorDistanceSq(const Uint8* C0, const Uint8* C1)
+{
+    Uint32 Dist = 0;
+    for (Uint32 c = 0; c < NumComps; ++c)
+    {
+        const int d = int{C0[c]} - int{C1[c]};
+        Dist += static_cast<Uint32>(d * d);
+    }
+    return Dist;
+}
+
+// Finds the endpoints of the segment along the principal axis of the texels selected by Mask.
+template <Uint32 NumComps>
+void FitPrincipalAxis(const BlockTexels& Texels, Uint32 Mask, float E0[4], float E1[4])
+{
+    float  Mean[4] = {};
+    Uint32 Count   = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        for (Uint32 c = 0; c < NumComps; ++c)
+            Mean[c] += Texels[i][c];
+        ++Count;
+    }
+    VERIFY_EXPR(Count > 0);
+    for (Uint32 c = 0; c < NumComps; ++c)
+        Mean[c] /= static_cast<float>(Count);
+
+    float Cov[4][4] = {};
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        float d[4];
+        for (Uint32 c = 0; c < NumComps; ++c)
+            d[c] = Texels[i][c] - Mean[c];
+        for (Uint32 r = 0; r < NumComps; ++r)
+        {
+            for (Uint32 c = 0; c < NumComps; ++c)
+                Cov[r][c] += d[r] * d[c];
+        }
+    }
+
+    // Power iteration
+    float Axis[4] = {1, 1, 1, 1};
+    for (int Iter = 0; Iter < 8; ++Iter)
+    {
+        float NewAxis[4] = {};
+        float MaxComp    = 0;
+        for (Uint32 r = 0; r < NumComps; ++r)
+        {
+            for (Uint32 c = 0; c < NumComps; ++c)
+                NewAxis[r] += Cov[r][c] * Axis[c];
+            MaxComp = std::max(MaxComp, std::abs(NewAxis[r]));
+        }
+        if (MaxComp < 1e-6f)
+            break;
+        for (Uint32 c = 0; c < NumComps; ++c)
+            Axis[c] = NewAxis[c] / MaxComp;
+    }
+
+    float LenSq = 0;
+    for (Uint32 c = 0; c < NumComps; ++c)
+        LenSq += Axis[c] * Axis[c];
+    const float InvLen = 1.f / std::sqrt(LenSq);
+    for (Uint32 c = 0; c < NumComps; ++c)
+        Axis[c] *= InvLen;
+
+    float MinProj = 0;
+    float MaxProj = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        float Proj = 0;
+        for (Uint32 c = 0; c < NumComps; ++c)
+            Proj += (Texels[i][c] - Mean[c]) * Axis[c];
+        MinProj = std::min(MinProj, Proj);
+        MaxProj = std::max(MaxProj, Proj);
+    }
+
+    for (Uint32 c = 0; c < NumComps; ++c)
+    {
+        E0[c] = Mean[c] + MinProj * Axis[c];
+        E1[c] = Mean[c] + MaxProj * Axis[c];
+    }
+}
+
+// Solves the least-squares problem for the endpoints given the texel indices.
+// Weights[i] is the weight of E1 for index i; E0 is weighted by 1 - Weights[i].
+template <Uint32 NumComps>
+bool RefineEndpoints(const BlockTexels& Texels, Uint32 Mask, const Uint8 Indices[], const float Weights[], float E0[4], float E1[4])
+{
+    float AA = 0, AB = 0, BB = 0;
+    float AX[4] = {};
+    float BX[4] = {};
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+            continue;
+        const float b = Weights[Indices[i]];
+        const float a = 1.f - b;
+        AA += a * a;
+        AB += a * b;
+        BB += b * b;
+        for (Uint32 c = 0; c < NumComps; ++c)
+        {
+            AX[c] += a * Texels[i][c];
+            BX[c] += b * Texels[i][c];
+        }
+    }
+
+    const float Det = AA * BB - AB * AB;
+    if (std::abs(Det) < 1e-6f)
+        return false;
+
+    const float InvDet = 1.f / Det;
+    for (Uint32 c = 0; c < NumComps; ++c)
+    {
+        E0[c] = std::max(std::min((AX[c] * BB - BX[c] * AB) * InvDet, 255.f), 0.f);
+        E1[c] = std::max(std::min((BX[c] * AA - AX[c] * AB) * InvDet, 255.f), 0.f);
+    }
+    return true;
+}
+
+
+// BC1 color block
+
+Uint16 QuantizeRGB565(const float Color[4])
+{
+    const auto R = static_cast<Uint32>(std::max(std::min(Color[0] * (31.f / 255.f) + 0.5f, 31.f), 0.f));
+    const auto G = static_cast<Uint32>(std::max(std::min(Color[1] * (63.f / 255.f) + 0.5f, 63.f), 0.f));
+    const auto B = static_cast<Uint32>(std::max(std::min(Color[2] * (31.f / 255.f) + 0.5f, 31.f), 0.f));
+    return static_cast<Uint16>((R << 11) | (G << 5) | B);
+}
+
+void UnpackRGB565(Uint16 Color, Uint8 RGBA[4])
+{
+    const Uint32 R = (Color >> 11) & 0x1F;
+    const Uint32 G = (Color >> 5) & 0x3F;
+    const Uint32 B = Color & 0x1F;
+
+    RGBA[0] = static_cast<Uint8>((R << 3) | (R >> 2));
+    RGBA[1] = static_cast<Uint8>((G << 2) | (G >> 4));
+    RGBA[2] = static_cast<Uint8>((B << 3) | (B >> 2));
+    RGBA[3] = 255;
+}
+
+void GetBC1Palette(Uint16 C0, Uint16 C1, bool ForceFourColors, Uint8 Palette[4][4])
+{
+    UnpackRGB565(C0, Palette[0]);
+    UnpackRGB565(C1, Palette[1]);
+    if (C0 > C1 || ForceFourColors)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            Palette[2][c] = static_cast<Uint8>((2 * Palette[0][c] + Palette[1][c]) / 3);
+            Palette[3][c] = static_cast<Uint8>((Palette[0][c] + 2 * Palette[1][c]) / 3);
+        }
+        Palette[2][3] = 255;
+        Palette[3][3] = 255;
+    }
+    else
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            Palette[2][c] = static_cast<Uint8>((Palette[0][c] + Palette[1][c]) / 2);
+        Palette[2][3] = 255;
+        memset(Palette[3], 0, 4);
+    }
+}
+
+// Selects the indices for the given endpoints and returns the squared error.
+// The endpoints are swapped if necessary to select the 4-color or 3-color mode.
+Uint32 SelectBC1Indices(const BlockTexels& Texels, Uint32 Mask, bool ThreeColorMode, Uint16& C0, Uint16& C1, Uint8 Indices[])
+{
+    if (ThreeColorMode ? C0 > C1 : C0 < C1)
+        std::swap(C0, C1);
+
+    Uint8 Palette[4][4];
+    GetBC1Palette(C0, C1, !ThreeColorMode, Palette);
+
+    // Equal endpoints always select the 3-color mode in BC1 blocks
+    const Uint32 NumColors = (ThreeColorMode || C0 == C1) ? 3 : 4;
+
+    Uint32 TotalError = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if ((Mask & (1u << i)) == 0)
+        {
+            Indices[i] = 3;
+            continue;
+        }
+
+        Uint32 BestDist = ~0u;
+        for (Uint32 p = 0; p < NumColors; ++p)
+        {
+            const auto Dist = ColorDistanceSq<3>(Texels[i], Palette[p]);
+            if (Dist < BestDist)
+            {
+                BestDist   = Dist;
+                Indices[i] = static_cast<Uint8>(p);
+            }
+        }
+        TotalError += BestDist;
+    }
+    return TotalError;
+}
+
+void EncodeBC1Block(const BlockTexels& Texels, bool AllowTransparency, Uint8* pDst)
+{
+    Uint32 Mask = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        if (!AllowTransparency || Texels[i][3] >= 128)
+            Mask |= 1u << i;
+    }
+    const bool ThreeColorMode = Mask != 0xFFFF;
+
+    Uint16 C0 = 0;
+    Uint16 C1 = 0;
+    Uint8  Indices[TexelsInBlock];
+    if (Mask != 0)
+    {
+        float E0[4], E1[4];
+        FitPrincipalAxis<3>(Texels, Mask, E0, E1);
+
+        C0 = QuantizeRGB565(E1);
+        C1 = QuantizeRGB565(E0);
+
+        auto Error = SelectBC1Indices(Texels, Mask, ThreeColorMode, C0, C1, Indices);
+
+        static constexpr float FourColorWeights[]  = {0, 1, 1.f / 3.f, 2.f / 3.f};
+        static constexpr float ThreeColorWeights[] = {0, 1, 0.5f};
+        if (Error > 0 && RefineEndpoints<3>(Texels, Mask, Indices, ThreeColorMode ? ThreeColorWeights : FourColorWeights, E0, E1))
+        {
+            Uint16 RefinedC0 = QuantizeRGB565(E0);
+            Uint16 RefinedC1 = QuantizeRGB565(E1);
+            Uint8  RefinedIndices[TexelsInBlock];
+
+            const auto RefinedError = SelectBC1Indices(Texels, Mask, ThreeColorMode, RefinedC0, RefinedC1, RefinedIndices);
+            if (RefinedError < Error)
+            {
+                C0 = RefinedC0;
+                C1 = RefinedC1;
+                memcpy(Indices, RefinedIndices, sizeof(Indices));
+            }
+        }
+    }
+    else
+    {
+        // All texels are transparent
+        memset(Indices, 3, sizeof(Indices));
+    }
+
+    Uint32 PackedIndices = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        PackedIndices |= Uint32{Indices[i]} << (i * 2);
+
+    pDst[0] = static_cast<Uint8>(C0 & 0xFF);
+    pDst[1] = static_cast<Uint8>(C0 >> 8);
+    pDst[2] = static_cast<Uint8>(C1 & 0xFF);
+    pDst[3] = static_cast<Uint8>(C1 >> 8);
+    for (Uint32 b = 0; b < 4; ++b)
+        pDst[4 + b] = static_cast<Uint8>(PackedIndices >> (b * 8));
+}
+
+void DecodeBC1Block(const Uint8* pSrc, bool ForceFourColors, BlockTexels& Texels)
+{
+    const Uint16 C0 = static_cast<Uint16>(pSrc[0] | (pSrc[1] << 8));
+    const Uint16 C1 = static_cast<Uint16>(pSrc[2] | (pSrc[3] << 8));
+
+    Uint8 Palette[4][4];
+    GetBC1Palette(C0, C1, ForceFourColors, Palette);
+
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        const Uint32 Index = (pSrc[4 + i / 4] >> ((i % 4) * 2)) & 0x03;
+        memcpy(Texels[i], Palette[Index], 4);
+    }
+}
+
+
+// BC4 single-channel block
+
+void GetBC4Palette(Uint8 V0, Uint8 V1, Uint8 Palette[8])
+{
+    Palette[0] = V0;
+    Palette[1] = V1;
+    if (V0 > V1)
+    {
+        for (Uint32 i = 1; i < 7; ++i)
+            Palette[i + 1] = static_cast<Uint8>(((7 - i) * V0 + i * V1) / 7);
+    }
+    else
+    {
+        for (Uint32 i = 1; i < 5; ++i)
+            Palette[i + 1] = static_cast<Uint8>(((5 - i) * V0 + i * V1) / 5);
+        Palette[6] = 0;
+        Palette[7] = 255;
+    }
+}
+
+void EncodeBC4Block(const BlockTexels& Texels, Uint32 Channel, Uint8* pDst)
+{
+    Uint8 MinVal = 255;
+    Uint8 MaxVal = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        MinVal = std::min(MinVal, Texels[i][Channel]);
+        MaxVal = std::max(MaxVal, Texels[i][Channel]);
+    }
+
+    // Use the 8-value mode (V0 > V1) unless the block is uniform
+    Uint8 Palette[8];
+    GetBC4Palette(MaxVal, MinVal, Palette);
+
+    Uint64 PackedIndices = 0;
+    if (MaxVal > MinVal)
+    {
+        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        {
+            Uint32 BestIndex = 0;
+            int    BestDist  = 256;
+            for (Uint32 p = 0; p < 8; ++p)
+            {
+                const int Dist = std::abs(int{Texels[i][Channel]} - int{Palette[p]});
+                if (Dist < BestDist)
+                {
+                    BestDist  = Dist;
+                    BestIndex = p;
+                }
+            }
+            PackedIndices |= Uint64{BestIndex} << (i * 3);
+        }
+    }
+
+    pDst[0] = MaxVal;
+    pDst[1] = MinVal;
+    for (Uint32 b = 0; b < 6; ++b)
+        pDst[2 + b] = static_cast<Uint8>(PackedIndices >> (b * 8));
+}
+
+void DecodeBC4Block(const Uint8* pSrc, Uint32 Channel, BlockTexels& Texels)
+{
+    Uint8 Palette[8];
+    GetBC4Palette(pSrc[0], pSrc[1], Palette);
+
+    Uint64 PackedIndices = 0;
+    for (Uint32 b = 0; b < 6; ++b)
+        PackedIndices |= Uint64{pSrc[2 + b]} << (b * 8);
+
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        Texels[i][Channel] = Palette[(PackedIndices >> (i * 3)) & 0x07];
+}
+
+
+// BC7 block
+
+class BC7BitWriter
+{
+public:
+    explicit BC7BitWriter(Uint8* pData) :
+        m_pData{pData}
+    {
+        memset(m_pData, 0, 16);
+    }
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 b = 0; b < NumBits; ++b, ++m_Pos)
+            m_pData[m_Pos / 8] |= static_cast<Uint8>(((Value >> b) & 0x01) << (m_Pos % 8));
+    }
+
+private:
+    Uint8* const m_pData;
+    Uint32       m_Pos = 0;
+};
+
+class BC7BitReader
+{
+public:
+    explicit BC7BitReader(const Uint8* pData) :
+        m_pData{pData}
+    {}
+
+    Uint32 Read(Uint32 NumBits)
+    {
+        Uint32 Value = 0;
+        for (Uint32 b = 0; b < NumBits; ++b, ++m_Pos)
+            Value |= ((m_pData[m_Pos / 8] >> (m_Pos % 8)) & 0x01u) << b;
+        return Value;
+    }
+
+private:
+    const Uint8* const m_pData;
+    Uint32             m_Pos = 0;
+};
+
+constexpr Uint32 BC7Weights2[] = {0, 21, 43, 64};
+constexpr Uint32 BC7Weights3[] = {0, 9, 18, 27, 37, 46, 55, 64};
+constexpr Uint32 BC7Weights4[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+inline Uint8 BC7Interpolate(Uint32 E0, Uint32 E1, Uint32 Weight)
+{
+    return static_cast<Uint8>(((64 - Weight) * E0 + Weight * E1 + 32) >> 6);
+}
+
+// Quantizes the endpoint to 7 bits per channel plus a shared p-bit.
+void QuantizeBC7Mode6Endpoint(const float Endpoint[4], Uint8 Quantized[4], Uint32& PBit)
+{
+    float BestError = 0;
+    for (Uint32 p = 0; p < 2; ++p)
+    {
+        Uint8 Q[4];
+        float Error = 0;
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            const float Val = std::max(std::min((Endpoint[c] - static_cast<float>(p)) * 0.5f + 0.5f, 127.f), 0.f);
+
+            Q[c] = static_cast<Uint8>(Val);
+
+            const float d = static_cast<float>((Q[c] << 1) | p) - Endpoint[c];
+            Error += d * d;
+        }
+        if (p == 0 || Error < BestError)
+        {
+            BestError = Error;
+            PBit      = p;
+            memcpy(Quantized, Q, 4);
+        }
+    }
+}
+
+Uint32 SelectBC7Mode6Indices(const BlockTexels& Texels, const Uint8 Q0[4], Uint32 P0, const Uint8 Q1[4], Uint32 P1, Uint8 Indices[])
+{
+    Uint8 Palette[16][4];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        const Uint32 E0 = (Q0[c] << 1) | P0;
+        const Uint32 E1 = (Q1[c] << 1) | P1;
+        for (Uint32 i = 0; i < 16; ++i)
+            Palette[i][c] = BC7Interpolate(E0, E1, BC7Weights4[i]);
+    }
+
+    Uint32 TotalError = 0;
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        Uint32 BestDist = ~0u;
+        for (Uint32 p = 0; p < 16; ++p)
+        {
+            const auto Dist = ColorDistanceSq<4>(Texels[i], Palette[p]);
+            if (Dist < BestDist)
+            {
+                BestDist   = Dist;
+                Indices[i] = static_cast<Uint8>(p);
+            }
+        }
+        TotalError += BestDist;
+    }
+    return TotalError;
+}
+
+void EncodeBC7Block(const BlockTexels& Texels, Uint8* pDst)
+{
+    float E0[4], E1[4];
+    FitPrincipalAxis<4>(Texels, 0xFFFF, E0, E1);
+
+    Uint8  Q0[4], Q1[4];
+    Uint32 P0 = 0, P1 = 0;
+    QuantizeBC7Mode6Endpoint(E0, Q0, P0);
+    QuantizeBC7Mode6Endpoint(E1, Q1, P1);
+
+    Uint8 Indices[TexelsInBlock];
+
+    auto Error = SelectBC7Mode6Indices(Texels, Q0, P0, Q1, P1, Indices);
+
+    float Weights[16];
+    for (Uint32 i = 0; i < 16; ++i)
+        Weights[i] = static_cast<float>(BC7Weights4[i]) / 64.f;
+    if (Error > 0 && RefineEndpoints<4>(Texels, 0xFFFF, Indices, Weights, E0, E1))
+    {
+        Uint8  RefinedQ0[4], RefinedQ1[4];
+        Uint32 RefinedP0 = 0, RefinedP1 = 0;
+        QuantizeBC7Mode6Endpoint(E0, RefinedQ0, RefinedP0);
+        QuantizeBC7Mode6Endpoint(E1, RefinedQ1, RefinedP1);
+
+        Uint8      RefinedIndices[TexelsInBlock];
+        const auto RefinedError = SelectBC7Mode6Indices(Texels, RefinedQ0, RefinedP0, RefinedQ1, RefinedP1, RefinedIndices);
+        if (RefinedError < Error)
+        {
+            memcpy(Q0, RefinedQ0, 4);
+            memcpy(Q1, RefinedQ1, 4);
+            P0 = RefinedP0;
+            P1 = RefinedP1;
+            memcpy(Indices, RefinedIndices, sizeof(Indices));
+        }
+    }
+
+    // The most significant bit of the anchor index is implicitly zero.
+    // The weights are symmetric, so swapping the endpoints and inverting the indices is lossless.
+    if (Indices[0] >= 8)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            std::swap(Q0[c], Q1[c]);
+        std::swap(P0, P1);
+        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+            Indices[i] = static_cast<Uint8>(15 - Indices[i]);
+    }
+
+    BC7BitWriter Writer{pDst};
+    Writer.Write(1u << 6, 7); // Mode 6
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Writer.Write(Q0[c], 7);
+        Writer.Write(Q1[c], 7);
+    }
+    Writer.Write(P0, 1);
+    Writer.Write(P1, 1);
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        Writer.Write(Indices[i], i == 0 ? 3 : 4);
+}
+
+inline Uint8 BC7Unquantize(Uint32 Value, Uint32 NumBits)
+{
+    Value <<= 8 - NumBits;
+    return static_cast<Uint8>(Value | (Value >> NumBits));
+}
+
+// Decodes single-subset BC7 blocks (modes 4, 5 and 6).
+// Returns false for partitioned modes and invalid blocks, which are decoded as transparent black.
+bool DecodeBC7Block(const Uint8* pSrc, BlockTexels& Texels)
+{
+    Uint32 Mode = 0;
+    while (Mode < 8 && (pSrc[0] & (1u << Mode)) == 0)
+        ++Mode;
+
+    if (Mode != 4 && Mode != 5 && Mode != 6)
+    {
+        memset(Texels, 0, sizeof(Texels));
+        return false;
+    }
+
+    BC7BitReader Reader{pSrc};
+    Reader.Read(Mode + 1);
+
+    if (Mode == 6)
+    {
+        Uint32 E[2][4];
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            E[0][c] = Reader.Read(7);
+            E[1][c] = Reader.Read(7);
+        }
+        const Uint32 P0 = Reader.Read(1);
+        const Uint32 P1 = Reader.Read(1);
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            E[0][c] = (E[0][c] << 1) | P0;
+            E[1][c] = (E[1][c] << 1) | P1;
+        }
+
+        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        {
+            const Uint32 Index = Reader.Read(i == 0 ? 3 : 4);
+            for (Uint32 c = 0; c < 4; ++c)
+                Texels[i][c] = BC7Interpolate(E[0][c], E[1][c], BC7Weights4[Index]);
+        }
+        return true;
+    }
+
+    // Modes 4 and 5 encode color and alpha separately
+    const Uint32 Rotation  = Reader.Read(2);
+    const Uint32 IndexMode = Mode == 4 ? Reader.Read(1) : 0;
+
+    const Uint32 ColorBits = Mode == 4 ? 5 : 7;
+    const Uint32 AlphaBits = Mode == 4 ? 6 : 8;
+
+    Uint32 E[2][4];
+    for (Uint32 c = 0; c < 3; ++c)
+    {
+        E[0][c] = BC7Unquantize(Reader.Read(ColorBits), ColorBits);
+        E[1][c] = BC7Unquantize(Reader.Read(ColorBits), ColorBits);
+    }
+    E[0][3] = BC7Unquantize(Reader.Read(AlphaBits), AlphaBits);
+    E[1][3] = BC7Unquantize(Reader.Read(AlphaBits), AlphaBits);
+
+    Uint32 Indices2[TexelsInBlock];
+    Uint32 Indices3[TexelsInBlock] = {};
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+        Indices2[i] = Reader.Read(i == 0 ? 1 : 2);
+    if (Mode == 4)
+    {
+        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+            Indices3[i] = Reader.Read(i == 0 ? 2 : 3);
+    }
+    else
+    {
+        // Mode 5 uses 2-bit alpha indices
+        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+            Indices3[i] = Reader.Read(i == 0 ? 1 : 2);
+    }
+
+    for (Uint32 i = 0; i < TexelsInBlock; ++i)
+    {
+        Uint32 ColorWeight = 0;
+        Uint32 AlphaWeight = 0;
+        if (Mode == 5)
+        {
+            ColorWeight = BC7Weights2[Indices2[i]];
+            AlphaWeight = BC7Weights2[Indices3[i]];
+        }
+        else if (IndexMode == 0)
+        {
+            ColorWeight = BC7Weights2[Indices2[i]];
+            AlphaWeight = BC7Weights3[Indices3[i]];
+        }
+        else
+        {
+            ColorWeight = BC7Weights3[Indices3[i]];
+            AlphaWeight = BC7Weights2[Indices2[i]];
+        }
+
+        for (Uint32 c = 0; c < 3; ++c)
+            Texels[i][c] = BC7Interpolate(E[0][c], E[1][c], ColorWeight);
+        Texels[i][3] = BC7Interpolate(E[0][3], E[1][3], AlphaWeight);
+
+        if (Rotation != 0)
+            std::swap(Texels[i][3], Texels[i][Rotation - 1]);
+    }
+    return true;
+}
+
+bool ValidateAttribs(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height, const void* pSrc, size_t SrcStride, const void* pDst, size_t DstStride, bool IsCompression)
+{
+    const auto  BlockSize  = GetBlockSize(Format);
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    if (IsCompression ? !IsBlockCompressionSupported(Format) : !IsBlockDecompressionSupported(Format))
+    {
+        LOG_ERROR_MESSAGE("Format ", FmtAttribs.Name, " is not supported by the block ", (IsCompression ? "compressor" : "decompressor"));
+        return false;
+    }
+    if (Width == 0 || Height == 0)
+        return true;
+
+    if (pSrc == nullptr || pDst == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Source and destination data must not be null");
+        return false;
+    }
+
+    const size_t BlocksRowSize = size_t{(Width + BlockDim - 1) / BlockDim} * BlockSize;
+    const size_t TexelsRowSize = size_t{Width} * 4;
+    if ((IsCompression ? SrcStride : DstStride) < TexelsRowSize)
+    {
+        LOG_ERROR_MESSAGE("RGBA8 row stride (", (IsCompression ? SrcStride : DstStride), ") is smaller than the row size (", TexelsRowSize, ")");
+        return false;
+    }
+    if ((IsCompression ? DstStride : SrcStride) < BlocksRowSize)
+    {
+        LOG_ERROR_MESSAGE("Block row stride (", (IsCompression ? DstStride : SrcStride), ") is smaller than the size of a row of blocks (", BlocksRowSize, ")");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool IsBlockDecompressionSupported(TEXTURE_FORMAT Format)
+{
+    return GetBlockSize(Format) != 0;
+}
+
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs)
+{
+    if (!ValidateAttribs(Attribs.Format, Attribs.Width, Attribs.Height, Attribs.pSrcData, Attribs.SrcStride, Attribs.pDstData, Attribs.DstStride, true))
+        return false;
+
+    const auto   Format     = Attribs.Format;
+    const auto   BlockSize  = GetBlockSize(Format);
+    const Uint32 NumBlocksX = (Attribs.Width + BlockDim - 1) / BlockDim;
+    const Uint32 NumBlocksY = (Attribs.Height + BlockDim - 1) / BlockDim;
+
+    const auto* const pSrc = static_cast<const Uint8*>(Attribs.pSrcData);
+    auto* const       pDst = static_cast<Uint8*>(Attribs.pDstData);
+
+    ProcessBlockRows(NumBlocksY, Attribs.NumThreads, [&](Uint32 StartRow, Uint32 EndRow) {
+        BlockTexels Texels;
+        for (Uint32 by = StartRow; by < EndRow; ++by)
+        {
+            auto* pDstBlock = pDst + by * Attribs.DstStride;
+            for (Uint32 bx = 0; bx < NumBlocksX; ++bx, pDstBlock += BlockSize)
+            {
+                LoadBlock(pSrc, Attribs.SrcStride, Attribs.Width, Attribs.Height, bx, by, Texels);
+                switch (Format)
+                {
+                    case TEX_FORMAT_BC1_UNORM:
+                    case TEX_FORMAT_BC1_UNORM_SRGB:
+                        EncodeBC1Block(Texels, /*AllowTransparency = */ true, pDstBlock);
+                        break;
+
+                    case TEX_FORMAT_BC3_UNORM:
+                    case TEX_FORMAT_BC3_UNORM_SRGB:
+                        EncodeBC4Block(Texels, 3, pDstBlock);
+                        EncodeBC1Block(Texels, /*AllowTransparency = */ false, pDstBlock + 8);
+                        break;
+
+                    case TEX_FORMAT_BC4_UNORM:
+                        EncodeBC4Block(Texels, 0, pDstBlock);
+                        break;
+
+                    case TEX_FORMAT_BC5_UNORM:
+                        EncodeBC4Block(Texels, 0, pDstBlock);
+                        EncodeBC4Block(Texels, 1, pDstBlock + 8);
+                        break;
+
+                    case TEX_FORMAT_BC7_UNORM:
+                    case TEX_FORMAT_BC7_UNORM_SRGB:
+                        EncodeBC7Block(Texels, pDstBlock);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected format");
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
+bool DecompressTextureData(const DecompressTextureDataAttribs& Attribs)
+{
+    if (!ValidateAttribs(Attribs.Format, Attribs.Width, Attribs.Height, Attribs.pSrcData, Attribs.SrcStride, Attribs.pDstData, Attribs.DstStride, false))
+        return false;
+
+    const auto   Format     = Attribs.Format;
+    const auto   BlockSize  = GetBlockSize(Format);
+    const Uint32 NumBlocksX = (Attribs.Width + BlockDim - 1) / BlockDim;
+    const Uint32 NumBlocksY = (Attribs.Height + BlockDim - 1) / BlockDim;
+
+    const auto* const pSrc = static_cast<const Uint8*>(Attribs.pSrcData);
+    auto* const       pDst = static_cast<Uint8*>(Attribs.pDstData);
+
+    std::atomic<bool> AllBlocksDecoded{true};
+    ProcessBlockRows(NumBlocksY, Attribs.NumThreads, [&](Uint32 StartRow, Uint32 EndRow) {
+        BlockTexels Texels;
+        for (Uint32 by = StartRow; by < EndRow; ++by)
+        {
+            const auto* pSrcBlock = pSrc + by * Attribs.SrcStride;
+            for (Uint32 bx = 0; bx < NumBlocksX; ++bx, pSrcBlock += BlockSize)
+            {
+                switch (Format)
+                {
+                    case TEX_FORMAT_BC1_UNORM:
+                    case TEX_FORMAT_BC1_UNORM_SRGB:
+                        DecodeBC1Block(pSrcBlock, /*ForceFourColors = */ false, Texels);
+                        break;
+
+                    case TEX_FORMAT_BC2_UNORM:
+                    case TEX_FORMAT_BC2_UNORM_SRGB:
+                        DecodeBC1Block(pSrcBlock + 8, /*ForceFourColors = */ true, Texels);
+                        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+                        {
+                            const Uint32 Alpha = (pSrcBlock[i / 2] >> ((i % 2) * 4)) & 0x0F;
+                            Texels[i][3]       = static_cast<Uint8>(Alpha * 17);
+                        }
+                        break;
+
+                    case TEX_FORMAT_BC3_UNORM:
+                    case TEX_FORMAT_BC3_UNORM_SRGB:
+                        DecodeBC1Block(pSrcBlock + 8, /*ForceFourColors = */ true, Texels);
+                        DecodeBC4Block(pSrcBlock, 3, Texels);
+                        break;
+
+                    case TEX_FORMAT_BC4_UNORM:
+                        memset(Texels, 0, sizeof(Texels));
+                        DecodeBC4Block(pSrcBlock, 0, Texels);
+                        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+                            Texels[i][3] = 255;
+                        break;
+
+                    case TEX_FORMAT_BC5_UNORM:
+                        memset(Texels, 0, sizeof(Texels));
+                        DecodeBC4Block(pSrcBlock, 0, Texels);
+                        DecodeBC4Block(pSrcBlock + 8, 1, Texels);
+                        for (Uint32 i = 0; i < TexelsInBlock; ++i)
+                            Texels[i][3] = 255;
+                        break;
+
+                    case TEX_FORMAT_BC7_UNORM:
+                    case TEX_FORMAT_BC7_UNORM_SRGB:
+                        if (!DecodeBC7Block(pSrcBlock, Texels))
+                            AllBlocksDecoded.store(false);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected format");
+                }
+                StoreBlock(Texels, Attribs.Width, Attribs.Height, bx, by, pDst, Attribs.DstStride);
+            }
+        }
+    });
+
+    return AllBlocksDecoded.load();
+}
+
+} // namespace Diligent
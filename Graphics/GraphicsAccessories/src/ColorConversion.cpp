@@ -27,7 +27,10 @@
 
 #include <array>
 #include <algorithm>
+#include <cstring>
+
 #include "ColorConversion.h"
+#include "Intrinsics.hpp"
 
 namespace Diligent
 {
@@ -75,18 +78,244 @@ private:
     std::array<float, 256> m_ToLinear;
 };
 
+// Polynomial approximation of log2(1 + u) / u on [0, 1] (Chebyshev interpolant)
+constexpr float Log2Coeffs[] = {1.4426947246f, -0.7213067574f, 0.4800124608f, -0.3530963533f, 0.2551763492f, -0.1541520064f, 0.0627484336f, -0.0120770203f};
+
+// Polynomial approximation of 2^f on [0, 1] (Chebyshev interpolant)
+constexpr float Exp2Coeffs[] = {0.9999998984f, 0.6931544897f, 0.2401418182f, 0.0558603371f, 0.0089495904f, 0.0018937541f};
+
+constexpr size_t NumLog2Coeffs = sizeof(Log2Coeffs) / sizeof(Log2Coeffs[0]);
+constexpr size_t NumExp2Coeffs = sizeof(Exp2Coeffs) / sizeof(Exp2Coeffs[0]);
+
+// The scalar functions below perform the same sequence of operations as their SIMD counterparts,
+// so that the results do not depend on the number of values processed by the batch functions.
+
+// Approximates log2(x) for non-negative x
+float Log2Approx(float x)
+{
+    Uint32 Bits;
+    std::memcpy(&Bits, &x, sizeof(Bits));
+    const float Exponent = static_cast<float>(static_cast<Int32>(Bits >> 23u) - 127);
+
+    // Mantissa in [1, 2)
+    Bits = (Bits & 0x007FFFFFu) | 0x3F800000u;
+    float Mantissa;
+    std::memcpy(&Mantissa, &Bits, sizeof(Mantissa));
+
+    const float u = Mantissa - 1.f;
+    float       p = Log2Coeffs[NumLog2Coeffs - 1];
+    for (size_t i = NumLog2Coeffs - 1; i > 0; --i)
+        p = p * u + Log2Coeffs[i - 1];
+    return p * u + Exponent;
+}
+
+// Approximates 2^t for t in (-126, 0]
+float Exp2Approx(float t)
+{
+    const float i = std::floor(t);
+    const float f = t - i;
+
+    float p = Exp2Coeffs[NumExp2Coeffs - 1];
+    for (size_t c = NumExp2Coeffs - 1; c > 0; --c)
+        p = p * f + Exp2Coeffs[c - 1];
+
+    const Uint32 ScaleBits = static_cast<Uint32>(static_cast<Int32>(i) + 127) << 23u;
+    float        Scale;
+    std::memcpy(&Scale, &ScaleBits, sizeof(Scale));
+    return p * Scale;
+}
+
+float ClampUnorm(float x)
+{
+    // NaN is converted to 0
+    return std::min(std::max(0.f, x), 1.f);
+}
+
+float LinearToSRGBApprox(float x)
+{
+    x                = ClampUnorm(x);
+    const float Pow  = 1.055f * Exp2Approx(Log2Approx(x) * (1.f / 2.4f)) - 0.055f;
+    return x <= 0.0031308f ? x * 12.92f : Pow;
+}
+
+float SRGBToLinearApprox(float x)
+{
+    x               = ClampUnorm(x);
+    const float Pow = Exp2Approx(Log2Approx((x + 0.055f) / 1.055f) * 2.4f);
+    return x <= 0.04045f ? x / 12.92f : Pow;
+}
+
+Uint8 LinearToSRGB8Approx(float x)
+{
+    const float SRGB = LinearToSRGBApprox(x) * 255.f + 0.5f;
+    return static_cast<Uint8>(std::min(SRGB, 255.f));
+}
+
+#if DILIGENT_SSE2_ENABLED
+__m128 Log2Approx(__m128 x)
+{
+    const __m128i Bits     = _mm_castps_si128(x);
+    const __m128  Exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(Bits, 23), _mm_set1_epi32(127)));
+    const __m128  Mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(Bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+    const __m128 u = _mm_sub_ps(Mantissa, _mm_set1_ps(1.f));
+    __m128       p = _mm_set1_ps(Log2Coeffs[NumLog2Coeffs - 1]);
+    for (size_t i = NumLog2Coeffs - 1; i > 0; --i)
+        p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(Log2Coeffs[i - 1]));
+    return _mm_add_ps(_mm_mul_ps(p, u), Exponent);
+}
+
+__m128 Exp2Approx(__m128 t)
+{
+    // SSE2 has no floor instruction: truncate and correct the result for negative values
+    __m128i iTrunc = _mm_cvttps_epi32(t);
+    iTrunc         = _mm_add_epi32(iTrunc, _mm_castps_si128(_mm_cmplt_ps(t, _mm_cvtepi32_ps(iTrunc))));
+
+    const __m128 f = _mm_sub_ps(t, _mm_cvtepi32_ps(iTrunc));
+    __m128       p = _mm_set1_ps(Exp2Coeffs[NumExp2Coeffs - 1]);
+    for (size_t c = NumExp2Coeffs - 1; c > 0; --c)
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(Exp2Coeffs[c - 1]));
+
+    const __m128 Scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(iTrunc, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(p, Scale);
+}
+
+__m128 ClampUnorm(__m128 x)
+{
+    // _mm_max_ps returns the second operand if either is NaN, which matches std::max(0.f, x)
+    return _mm_min_ps(_mm_set1_ps(1.f), _mm_max_ps(x, _mm_setzero_ps()));
+}
+
+__m128 Select(__m128 Mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(Mask, a), _mm_andnot_ps(Mask, b));
+}
+
+__m128 LinearToSRGBApprox(__m128 x)
+{
+    x                = ClampUnorm(x);
+    const __m128 Pow = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.055f), Exp2Approx(_mm_mul_ps(Log2Approx(x), _mm_set1_ps(1.f / 2.4f)))), _mm_set1_ps(0.055f));
+    return Select(_mm_cmple_ps(x, _mm_set1_ps(0.0031308f)), _mm_mul_ps(x, _mm_set1_ps(12.92f)), Pow);
+}
+
+__m128 SRGBToLinearApprox(__m128 x)
+{
+    x                = ClampUnorm(x);
+    const __m128 Pow = Exp2Approx(_mm_mul_ps(Log2Approx(_mm_div_ps(_mm_add_ps(x, _mm_set1_ps(0.055f)), _mm_set1_ps(1.055f))), _mm_set1_ps(2.4f)));
+    return Select(_mm_cmple_ps(x, _mm_set1_ps(0.04045f)), _mm_div_ps(x, _mm_set1_ps(12.92f)), Pow);
+}
+
+__m128 FastLinearToSRGB(__m128 x)
+{
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 Pow = _mm_mul_ps(_mm_set1_ps(1.13005f), _mm_sqrt_ps(_mm_and_ps(AbsMask, _mm_sub_ps(x, _mm_set1_ps(0.00228f)))));
+    Pow        = _mm_add_ps(_mm_sub_ps(Pow, _mm_mul_ps(_mm_set1_ps(0.13448f), x)), _mm_set1_ps(0.005719f));
+    return Select(_mm_cmplt_ps(x, _mm_set1_ps(0.0031308f)), _mm_mul_ps(_mm_set1_ps(12.92f), x), Pow);
+}
+
+__m128 FastSRGBToLinear(__m128 x)
+{
+    __m128 p = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(0.305306011f)), _mm_set1_ps(0.682171111f));
+    p        = _mm_add_ps(_mm_mul_ps(x, p), _mm_set1_ps(0.012522878f));
+    return _mm_mul_ps(x, p);
+}
+#endif
+
+// Applies the conversion function to groups of four values using SIMD instructions and to the
+// remaining values one by one. The function must be overloaded for float and SIMD types.
+template <typename ConversionFuncType>
+void ConvertFloats(const float* pSrc, float* pDst, size_t Count, ConversionFuncType ConversionFunc)
+{
+    size_t i = 0;
+#if DILIGENT_SSE2_ENABLED
+    for (; i + 4 <= Count; i += 4)
+        _mm_storeu_ps(pDst + i, ConversionFunc(_mm_loadu_ps(pSrc + i)));
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = ConversionFunc(pSrc[i]);
+}
+
+const LinearToSRGBMap& GetLinearToSRGBMap()
+{
+    static const LinearToSRGBMap map;
+    return map;
+}
+
+const SRGBToLinearMap& GetSRGBToLinearMap()
+{
+    static const SRGBToLinearMap map;
+    return map;
+}
+
 } // namespace
 
 float LinearToSRGB(Uint8 x)
 {
-    static const LinearToSRGBMap map;
-    return map[x];
+    return GetLinearToSRGBMap()[x];
 }
 
 float SRGBToLinear(Uint8 x)
 {
-    static const SRGBToLinearMap map;
-    return map[x];
+    return GetSRGBToLinearMap()[x];
+}
+
+void LinearToSRGB(const float* pLinear, float* pSRGB, size_t Count)
+{
+    ConvertFloats(pLinear, pSRGB, Count, [](auto x) { return LinearToSRGBApprox(x); });
+}
+
+void SRGBToLinear(const float* pSRGB, float* pLinear, size_t Count)
+{
+    ConvertFloats(pSRGB, pLinear, Count, [](auto x) { return SRGBToLinearApprox(x); });
+}
+
+void FastLinearToSRGB(const float* pLinear, float* pSRGB, size_t Count)
+{
+    ConvertFloats(pLinear, pSRGB, Count, [](auto x) { return FastLinearToSRGB(x); });
+}
+
+void FastSRGBToLinear(const float* pSRGB, float* pLinear, size_t Count)
+{
+    ConvertFloats(pSRGB, pLinear, Count, [](auto x) { return FastSRGBToLinear(x); });
+}
+
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128 Scale = _mm_set1_ps(255.f);
+    const __m128 Half  = _mm_set1_ps(0.5f);
+    for (; i + 16 <= Count; i += 16)
+    {
+        __m128i Values[4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            __m128 SRGB = _mm_add_ps(_mm_mul_ps(LinearToSRGBApprox(_mm_loadu_ps(pLinear + i + j * 4)), Scale), Half);
+            SRGB        = _mm_min_ps(SRGB, Scale);
+            Values[j]   = _mm_cvttps_epi32(SRGB);
+        }
+        // All values are in [0, 255], so saturation has no effect
+        const __m128i Words = _mm_packus_epi16(_mm_packs_epi32(Values[0], Values[1]), _mm_packs_epi32(Values[2], Values[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pSRGB + i), Words);
+    }
+#endif
+    for (; i < Count; ++i)
+        pSRGB[i] = LinearToSRGB8Approx(pLinear[i]);
+}
+
+void LinearToSRGB(const Uint8* pLinear, float* pSRGB, size_t Count)
+{
+    const auto& map = GetLinearToSRGBMap();
+    for (size_t i = 0; i < Count; ++i)
+        pSRGB[i] = map[pLinear[i]];
+}
+
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count)
+{
+    const auto& map = GetSRGBToLinearMap();
+    for (size_t i = 0; i < Count; ++i)
+        pLinear[i] = map[pSRGB[i]];
 }
 
 } // namespace Diligent
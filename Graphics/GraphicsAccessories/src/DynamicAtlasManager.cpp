@@ -26,6 +26,7 @@
  */
 
 #include "DynamicAtlasManager.hpp"
+#include "ShelfAtlasManager.hpp"
 
 #include <climits>
 
@@ -110,15 +111,25 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, ALLOCATION_POLICY Policy) :
     m_Width{Width},
     m_Height{Height},
+    m_Policy{Policy},
     m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
 {
+    if (m_Policy == ALLOCATION_POLICY_SHELF)
+    {
+        m_pShelfMgr = std::make_unique<ShelfAtlasManager>(Width, Height);
+        m_Root.reset();
+        return;
+    }
+
     m_Root->R = Region{0, 0, Width, Height};
     RegisterNode(*m_Root);
 }
 
+DynamicAtlasManager::DynamicAtlasManager(DynamicAtlasManager&&) = default;
+
 
 DynamicAtlasManager::~DynamicAtlasManager()
 {
@@ -184,6 +195,16 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
 {
+    if (m_pShelfMgr)
+    {
+        auto R = m_pShelfMgr->Allocate(Width, Height);
+        if (R.IsEmpty())
+            return Region{};
+
+        m_TotalFreeArea -= Uint64{R.width} * Uint64{R.height};
+        return R;
+    }
+
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
         ++it_w;
@@ -329,6 +350,15 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
 
 void DynamicAtlasManager::Free(Region&& R)
 {
+    if (m_pShelfMgr)
+    {
+        const auto Area = Uint64{R.width} * Uint64{R.height};
+        m_pShelfMgr->Free(std::move(R));
+        m_TotalFreeArea += Area;
+        R = InvalidRegion;
+        return;
+    }
+
 #if DILIGENT_DEBUG
     DbgVerifyRegion(R);
 #endif
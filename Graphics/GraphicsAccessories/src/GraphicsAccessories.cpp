@@ -480,7 +480,7 @@ const Char* GetBufferViewTypeLiteralName(BUFFER_VIEW_TYPE ViewType)
 
 const Char* GetShaderTypeLiteralName(SHADER_TYPE ShaderType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please handle the new shader type in the switch below");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please handle the new shader type in the switch below");
     switch (ShaderType)
     {
         // clang-format off
@@ -503,6 +503,7 @@ const Char* GetShaderTypeLiteralName(SHADER_TYPE ShaderType)
         RETURN_SHADER_TYPE_NAME(SHADER_TYPE_RAY_INTERSECTION)
         RETURN_SHADER_TYPE_NAME(SHADER_TYPE_CALLABLE        )
         RETURN_SHADER_TYPE_NAME(SHADER_TYPE_TILE            )
+        RETURN_SHADER_TYPE_NAME(SHADER_TYPE_WORK_GRAPH      )
 #undef  RETURN_SHADER_TYPE_NAME
             // clang-format on
 
@@ -1176,7 +1177,7 @@ const char* GetSurfaceTransformString(SURFACE_TRANSFORM SrfTransform)
 
 const char* GetPipelineTypeString(PIPELINE_TYPE PipelineType)
 {
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update this function to handle the new pipeline type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update this function to handle the new pipeline type");
     switch (PipelineType)
     {
         // clang-format off
@@ -1185,6 +1186,7 @@ const char* GetPipelineTypeString(PIPELINE_TYPE PipelineType)
         case PIPELINE_TYPE_MESH:        return "mesh";
         case PIPELINE_TYPE_RAY_TRACING: return "ray tracing";
         case PIPELINE_TYPE_TILE:        return "tile";
+        case PIPELINE_TYPE_WORK_GRAPH:  return "work graph";
         // clang-format on
         default:
             UNEXPECTED("Unexpected pipeline type");
@@ -1308,7 +1310,7 @@ String GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAGS Flags, bool GetFul
 
         auto Flag = ExtractLSB(Flags);
 
-        static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 4), "Please update the switch below to handle the new pipeline resource flag.");
+        static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 6), "Please update the switch below to handle the new pipeline resource flag.");
         switch (Flag)
         {
             case PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS:
@@ -1331,6 +1333,14 @@ String GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAGS Flags, bool GetFul
                 Str.append(GetFullName ? "PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT" : "GENERAL_INPUT_ATTACHMENT");
                 break;
 
+            case PIPELINE_RESOURCE_FLAG_BINDLESS:
+                Str.append(GetFullName ? "PIPELINE_RESOURCE_FLAG_BINDLESS" : "BINDLESS");
+                break;
+
+            case PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS:
+                Str.append(GetFullName ? "PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS" : "INLINE_CONSTANTS");
+                break;
+
             default:
                 UNEXPECTED("Unexpected pipeline resource flag");
         }
@@ -1344,19 +1354,19 @@ PIPELINE_RESOURCE_FLAGS GetValidPipelineResourceFlags(SHADER_RESOURCE_TYPE Resou
     switch (ResourceType)
     {
         case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
-            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS;
 
         case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
-            return PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            return PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_BINDLESS;
 
         case SHADER_RESOURCE_TYPE_BUFFER_SRV:
-            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_BINDLESS;
 
         case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
-            return PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            return PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_BINDLESS;
 
         case SHADER_RESOURCE_TYPE_BUFFER_UAV:
-            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            return PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER | PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY | PIPELINE_RESOURCE_FLAG_BINDLESS;
 
         case SHADER_RESOURCE_TYPE_SAMPLER:
             return PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
@@ -1618,8 +1628,8 @@ Uint32 AdapterVendorToVendorId(ADAPTER_VENDOR Vendor)
 
 bool IsConsistentShaderType(SHADER_TYPE ShaderType, PIPELINE_TYPE PipelineType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the switch below to handle the new pipeline type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the switch below to handle the new pipeline type");
     switch (PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -1648,6 +1658,9 @@ bool IsConsistentShaderType(SHADER_TYPE ShaderType, PIPELINE_TYPE PipelineType)
         case PIPELINE_TYPE_TILE:
             return ShaderType == SHADER_TYPE_TILE;
 
+        case PIPELINE_TYPE_WORK_GRAPH:
+            return ShaderType == SHADER_TYPE_WORK_GRAPH;
+
         default:
             UNEXPECTED("Unexpected pipeline type");
             return false;
@@ -1660,7 +1673,7 @@ Int32 GetShaderTypePipelineIndex(SHADER_TYPE ShaderType, PIPELINE_TYPE PipelineT
            " is inconsistent with pipeline type ", GetPipelineTypeString(PipelineType));
     VERIFY(ShaderType == SHADER_TYPE_UNKNOWN || IsPowerOfTwo(ShaderType), "More than one shader type is specified");
 
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     switch (ShaderType)
     {
         case SHADER_TYPE_UNKNOWN:
@@ -1671,6 +1684,7 @@ Int32 GetShaderTypePipelineIndex(SHADER_TYPE ShaderType, PIPELINE_TYPE PipelineT
         case SHADER_TYPE_COMPUTE:       // Compute
         case SHADER_TYPE_RAY_GEN:       // Ray tracing
         case SHADER_TYPE_TILE:          // Tile
+        case SHADER_TYPE_WORK_GRAPH:    // Work graph
             return 0;
 
         case SHADER_TYPE_HULL:     // Graphics
@@ -1701,8 +1715,8 @@ Int32 GetShaderTypePipelineIndex(SHADER_TYPE ShaderType, PIPELINE_TYPE PipelineT
 
 SHADER_TYPE GetShaderTypeFromPipelineIndex(Int32 Index, PIPELINE_TYPE PipelineType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the switch below to handle the new pipeline type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the switch below to handle the new pipeline type");
     switch (PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -1766,6 +1780,16 @@ SHADER_TYPE GetShaderTypeFromPipelineIndex(Int32 Index, PIPELINE_TYPE PipelineTy
                     return SHADER_TYPE_UNKNOWN;
             }
 
+        case PIPELINE_TYPE_WORK_GRAPH:
+            switch (Index)
+            {
+                case 0: return SHADER_TYPE_WORK_GRAPH;
+
+                default:
+                    UNEXPECTED("Index ", Index, " is not a valid work graph pipeline shader index");
+                    return SHADER_TYPE_UNKNOWN;
+            }
+
         default:
             UNEXPECTED("Unexpected pipeline type");
             return SHADER_TYPE_UNKNOWN;
@@ -1774,8 +1798,8 @@ SHADER_TYPE GetShaderTypeFromPipelineIndex(Int32 Index, PIPELINE_TYPE PipelineTy
 
 PIPELINE_TYPE PipelineTypeFromShaderStages(SHADER_TYPE ShaderStages)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the code below to handle the new shader type");
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the code below to handle the new pipeline type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the code below to handle the new shader type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the code below to handle the new pipeline type");
 
     if (ShaderStages & (SHADER_TYPE_AMPLIFICATION | SHADER_TYPE_MESH))
     {
@@ -1801,6 +1825,12 @@ PIPELINE_TYPE PipelineTypeFromShaderStages(SHADER_TYPE ShaderStages)
                "Tile stage can't be combined with any other shader stage");
         return PIPELINE_TYPE_TILE;
     }
+    if (ShaderStages & SHADER_TYPE_WORK_GRAPH)
+    {
+        VERIFY((ShaderStages & SHADER_TYPE_WORK_GRAPH) == ShaderStages,
+               "Work graph stage can't be combined with any other shader stage");
+        return PIPELINE_TYPE_WORK_GRAPH;
+    }
     if (ShaderStages & SHADER_TYPE_ALL_RAY_TRACING)
     {
         VERIFY((ShaderStages & SHADER_TYPE_ALL_RAY_TRACING) == ShaderStages,
@@ -1933,11 +1963,27 @@ void CopyTextureSubresource(const TextureSubResData& SrcSubres,
     VERIFY_EXPR(pDstData != nullptr);
     VERIFY(SrcSubres.Stride >= RowSize, "Source data row stride (", SrcSubres.Stride, ") is smaller than the row size (", RowSize, ")");
     VERIFY(DstRowStride >= RowSize, "Dst data row stride (", DstRowStride, ") is smaller than the row size (", RowSize, ")");
+
+    // Tightly packed rows are copied with a single memcpy per slice (or for the entire subresource)
+    const bool   RowsArePacked = SrcSubres.Stride == RowSize && DstRowStride == RowSize;
+    const Uint64 SliceSize     = RowSize * NumRows;
+    if (RowsArePacked && (NumDepthSlices == 1 || (SrcSubres.DepthStride == SliceSize && DstDepthStride == SliceSize)))
+    {
+        memcpy(pDstData, SrcSubres.pData, StaticCast<size_t>(SliceSize * NumDepthSlices));
+        return;
+    }
+
     for (Uint32 z = 0; z < NumDepthSlices; ++z)
     {
         const auto* pSrcSlice = reinterpret_cast<const Uint8*>(SrcSubres.pData) + SrcSubres.DepthStride * z;
         auto*       pDstSlice = reinterpret_cast<Uint8*>(pDstData) + DstDepthStride * z;
 
+        if (RowsArePacked)
+        {
+            memcpy(pDstSlice, pSrcSlice, StaticCast<size_t>(SliceSize));
+            continue;
+        }
+
         for (Uint32 y = 0; y < NumRows; ++y)
         {
             memcpy(pDstSlice + DstRowStride * y,
@@ -1988,6 +2034,44 @@ const Char* GetFenceTypeString(FENCE_TYPE Type)
     }
 }
 
+const Char* GetGPUMemoryCategoryString(GPU_MEMORY_CATEGORY Category)
+{
+    static_assert(GPU_MEMORY_CATEGORY_COUNT == 9, "Please update the switch below to handle the new GPU memory category");
+    switch (Category)
+    {
+        // clang-format off
+        case GPU_MEMORY_CATEGORY_UNKNOWN:                return "Unknown";
+        case GPU_MEMORY_CATEGORY_TEXTURE:                return "Texture";
+        case GPU_MEMORY_CATEGORY_BUFFER:                 return "Buffer";
+        case GPU_MEMORY_CATEGORY_DEVICE_MEMORY:          return "Device memory";
+        case GPU_MEMORY_CATEGORY_ACCELERATION_STRUCTURE: return "Acceleration structure";
+        case GPU_MEMORY_CATEGORY_QUERY:                  return "Query";
+        case GPU_MEMORY_CATEGORY_DESCRIPTOR_HEAP:        return "Descriptor heap";
+        case GPU_MEMORY_CATEGORY_DYNAMIC_HEAP:           return "Dynamic heap";
+        case GPU_MEMORY_CATEGORY_MEMORY_POOL:            return "Memory pool";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected GPU memory category");
+            return "Unknown";
+    }
+}
+
+const Char* GetGPUMemoryAllocationTypeString(GPU_MEMORY_ALLOCATION_TYPE Type)
+{
+    static_assert(GPU_MEMORY_ALLOCATION_TYPE_COUNT == 3, "Please update the switch below to handle the new GPU memory allocation type");
+    switch (Type)
+    {
+        // clang-format off
+        case GPU_MEMORY_ALLOCATION_TYPE_COMMITTED:    return "Committed";
+        case GPU_MEMORY_ALLOCATION_TYPE_PLACED:       return "Placed";
+        case GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED: return "Suballocated";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected GPU memory allocation type");
+            return "Unknown";
+    }
+}
+
 TEXTURE_FORMAT TexFormatToSRGB(TEXTURE_FORMAT Fmt)
 {
     switch (Fmt)
@@ -2046,6 +2130,36 @@ String GetPipelineShadingRateFlagsString(PIPELINE_SHADING_RATE_FLAGS Flags)
     return Result;
 }
 
+String GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAGS Flags)
+{
+    if (Flags == PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+        return "NONE";
+
+    String Result;
+    while (Flags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+    {
+        auto Bit = ExtractLSB(Flags);
+
+        if (!Result.empty())
+            Result += " | ";
+
+        static_assert(PIPELINE_DYNAMIC_STATE_FLAG_LAST == 0x08, "Please update the switch below to handle the new pipeline dynamic state flag");
+        switch (Bit)
+        {
+            // clang-format off
+            case PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE:          Result += "CULL_MODE";          break;
+            case PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST:         Result += "DEPTH_TEST";         break;
+            case PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST:       Result += "STENCIL_TEST";       break;
+            case PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY: Result += "PRIMITIVE_TOPOLOGY"; break;
+            // clang-format on
+            default:
+                UNEXPECTED("Unexpected pipeline dynamic state flag");
+                Result += "Unknown";
+        }
+    }
+    return Result;
+}
+
 SparseTextureProperties GetStandardSparseTextureProperties(const TextureDesc& TexDesc)
 {
     constexpr Uint32 SparseBlockSize = 64 << 10;
@@ -2185,4 +2299,19 @@ SparseTextureProperties GetStandardSparseTextureProperties(const TextureDesc& Te
     return Props;
 }
 
+Uint64 GPUTimestampToCPUTime(const TimestampCalibration& Calibration, Uint64 GPUCounter)
+{
+    DEV_CHECK_ERR(Calibration.GPUFrequency != 0, "GPU timestamp frequency must not be zero");
+    if (Calibration.GPUFrequency == 0)
+        return Calibration.CPUTime;
+
+    // GPU timestamps that precede the calibration point are common (e.g. the queries of
+    // the previous frames), so both directions must be handled without wrapping around.
+    if (GPUCounter >= Calibration.GPUCounter)
+        return Calibration.CPUTime + TicksToNanoseconds(GPUCounter - Calibration.GPUCounter, Calibration.GPUFrequency);
+
+    const auto TimeBefore = TicksToNanoseconds(Calibration.GPUCounter - GPUCounter, Calibration.GPUFrequency);
+    return Calibration.CPUTime > TimeBefore ? Calibration.CPUTime - TimeBefore : 0;
+}
+
 } // namespace Diligent
@@ -47,7 +47,8 @@ void SRBMemoryAllocator::Initialize(Uint32              SRBAllocationGranularity
                                     Uint32              ShaderVariableDataAllocatorCount,
                                     const size_t* const ShaderVariableDataSizes,
                                     Uint32              ResourceCacheDataAllocatorCount,
-                                    const size_t* const ResourceCacheDataSizes)
+                                    const size_t* const ResourceCacheDataSizes,
+                                    Uint32              ThreadCacheSize)
 {
     VERIFY_EXPR(SRBAllocationGranularity > 1);
     VERIFY(m_DataAllocators == nullptr && m_ShaderVariableDataAllocatorCount == 0 && m_ResourceCacheDataAllocatorCount == 0, "Allocator is already initialized");
@@ -68,7 +69,7 @@ void SRBMemoryAllocator::Initialize(Uint32              SRBAllocationGranularity
     for (Uint32 s = 0; s < TotalAllocatorCount; ++s)
     {
         auto size = s < ShaderVariableDataAllocatorCount ? ShaderVariableDataSizes[s] : ResourceCacheDataSizes[s - ShaderVariableDataAllocatorCount];
-        new (m_DataAllocators + s) FixedBlockMemoryAllocator(GetRawAllocator(), size, SRBAllocationGranularity);
+        new (m_DataAllocators + s) FixedBlockMemoryAllocator(GetRawAllocator(), size, SRBAllocationGranularity, ThreadCacheSize);
     }
 }
 
@@ -0,0 +1,287 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShelfAtlasManager.hpp"
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+ShelfAtlasManager::ShelfAtlasManager(Uint32 Width, Uint32 Height) :
+    m_Width{Width},
+    m_Height{Height},
+    m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
+{
+}
+
+ShelfAtlasManager::~ShelfAtlasManager()
+{
+    DEV_CHECK_ERR(m_AllocationCount == 0, "Not all allocations have been released");
+}
+
+ShelfAtlasManager::ShelfIterator ShelfAtlasManager::AddShelf(Uint32 y, Uint32 Height)
+{
+    VERIFY_EXPR(Height > 0 && y + Height <= m_Height);
+
+    auto it = m_Shelves.emplace(y, Shelf{}).first;
+
+    auto& NewShelf  = it->second;
+    NewShelf.Height = Height;
+    NewShelf.FreeSpans.emplace(0, m_Width);
+
+    return it;
+}
+
+ShelfAtlasManager::Region ShelfAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    if (Width == 0 || Height == 0 || Width > m_Width || Height > m_Height)
+        return Region{};
+
+    // Fast path: allocate from the last free span of the shelf that was used for this height
+    auto HintIt = m_ShelfHints.find(Height);
+    if (HintIt != m_ShelfHints.end())
+    {
+        auto& S = HintIt->second->second;
+        VERIFY_EXPR(S.Height >= Height && S.AllocationCount > 0);
+        if (!S.FreeSpans.empty())
+        {
+            auto LastSpanIt = std::prev(S.FreeSpans.end());
+            if (LastSpanIt->second >= Width)
+                return AllocateFromSpan(HintIt->second, LastSpanIt, Width, Height);
+        }
+    }
+
+    auto FindSpan = [Width](Shelf& S) {
+        auto SpanIt = S.FreeSpans.begin();
+        while (SpanIt != S.FreeSpans.end() && SpanIt->second < Width)
+            ++SpanIt;
+        return SpanIt;
+    };
+
+    // The shelf that is the best fit for the region among the shelves that are in use
+    auto BestShelfIt = m_Shelves.end();
+    auto BestSpanIt  = std::map<Uint32, Uint32>::iterator{};
+    // The smallest empty shelf that fits the region
+    auto EmptyShelfIt = m_Shelves.end();
+    for (auto ShelfIt = m_Shelves.begin(); ShelfIt != m_Shelves.end(); ++ShelfIt)
+    {
+        auto& S = ShelfIt->second;
+        if (S.Height < Height)
+            continue;
+
+        if (S.AllocationCount == 0)
+        {
+            if (EmptyShelfIt == m_Shelves.end() || S.Height < EmptyShelfIt->second.Height)
+                EmptyShelfIt = ShelfIt;
+        }
+        else if (BestShelfIt == m_Shelves.end() || S.Height < BestShelfIt->second.Height)
+        {
+            auto SpanIt = FindSpan(S);
+            if (SpanIt != S.FreeSpans.end())
+            {
+                BestShelfIt = ShelfIt;
+                BestSpanIt  = SpanIt;
+            }
+        }
+    }
+
+    // Do not place the region on a shelf that is much taller than the region
+    // if there is other space available.
+    const auto IsGoodFit = [Height](const Shelf& S) {
+        return S.Height - Height <= S.Height / 4;
+    };
+    if (BestShelfIt == m_Shelves.end() || !IsGoodFit(BestShelfIt->second))
+    {
+        if (EmptyShelfIt != m_Shelves.end())
+        {
+            auto& S = EmptyShelfIt->second;
+            if (S.Height > Height)
+            {
+                // Split the empty shelf
+                AddShelf(EmptyShelfIt->first + Height, S.Height - Height);
+                S.Height = Height;
+            }
+            BestShelfIt = EmptyShelfIt;
+            BestSpanIt  = S.FreeSpans.begin();
+        }
+        else if (m_Top + Height <= m_Height)
+        {
+            BestShelfIt = AddShelf(m_Top, Height);
+            BestSpanIt  = BestShelfIt->second.FreeSpans.begin();
+            m_Top += Height;
+        }
+    }
+
+    if (BestShelfIt == m_Shelves.end())
+        return Region{};
+
+    m_ShelfHints[Height] = BestShelfIt;
+
+    return AllocateFromSpan(BestShelfIt, BestSpanIt, Width, Height);
+}
+
+ShelfAtlasManager::Region ShelfAtlasManager::AllocateFromSpan(ShelfIterator ShelfIt, std::map<Uint32, Uint32>::iterator SpanIt, Uint32 Width, Uint32 Height)
+{
+    auto& S = ShelfIt->second;
+
+    const Uint32 x         = SpanIt->first;
+    const Uint32 SpanWidth = SpanIt->second;
+    VERIFY_EXPR(SpanWidth >= Width && S.Height >= Height);
+    auto NextSpanIt = S.FreeSpans.erase(SpanIt);
+    if (SpanWidth > Width)
+        S.FreeSpans.emplace_hint(NextSpanIt, x + Width, SpanWidth - Width);
+
+    ++S.AllocationCount;
+    ++m_AllocationCount;
+    m_TotalFreeArea -= Uint64{Width} * Uint64{Height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    return Region{x, ShelfIt->first, Width, Height};
+}
+
+void ShelfAtlasManager::Free(Region&& R)
+{
+    auto ShelfIt = m_Shelves.find(R.y);
+    if (ShelfIt == m_Shelves.end() || ShelfIt->second.AllocationCount == 0)
+    {
+        UNEXPECTED("Region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") is not allocated from this atlas");
+        return;
+    }
+
+    auto& S = ShelfIt->second;
+    VERIFY(R.height <= S.Height && R.x + R.width <= m_Width, "Region does not fit into its shelf");
+
+    // The freed space may be a better fit than the hinted shelves. Hints are also
+    // invalidated when the shelf is released below.
+    if (!m_ShelfHints.empty())
+        m_ShelfHints.clear();
+
+    auto SpanIt = S.FreeSpans.emplace(R.x, R.width).first;
+    VERIFY(std::next(SpanIt) == S.FreeSpans.end() || R.x + R.width <= std::next(SpanIt)->first, "The region overlaps a free span");
+
+    // Merge with the next span
+    auto NextIt = std::next(SpanIt);
+    if (NextIt != S.FreeSpans.end() && SpanIt->first + SpanIt->second == NextIt->first)
+    {
+        SpanIt->second += NextIt->second;
+        S.FreeSpans.erase(NextIt);
+    }
+
+    // Merge with the previous span
+    if (SpanIt != S.FreeSpans.begin())
+    {
+        auto PrevIt = std::prev(SpanIt);
+        VERIFY(PrevIt->first + PrevIt->second <= SpanIt->first, "The region overlaps a free span");
+        if (PrevIt->first + PrevIt->second == SpanIt->first)
+        {
+            PrevIt->second += SpanIt->second;
+            S.FreeSpans.erase(SpanIt);
+        }
+    }
+
+    --S.AllocationCount;
+    --m_AllocationCount;
+    m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
+
+    if (S.AllocationCount == 0)
+        ReleaseEmptyShelf(ShelfIt);
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    R = Region{};
+}
+
+void ShelfAtlasManager::ReleaseEmptyShelf(ShelfIterator ShelfIt)
+{
+    VERIFY_EXPR(ShelfIt->second.AllocationCount == 0);
+    VERIFY_EXPR(ShelfIt->second.FreeSpans.size() == 1 && ShelfIt->second.FreeSpans.begin()->second == m_Width);
+
+    auto NextIt = std::next(ShelfIt);
+    if (NextIt != m_Shelves.end() && NextIt->second.AllocationCount == 0)
+    {
+        ShelfIt->second.Height += NextIt->second.Height;
+        m_Shelves.erase(NextIt);
+    }
+
+    if (ShelfIt != m_Shelves.begin())
+    {
+        auto PrevIt = std::prev(ShelfIt);
+        if (PrevIt->second.AllocationCount == 0)
+        {
+            PrevIt->second.Height += ShelfIt->second.Height;
+            m_Shelves.erase(ShelfIt);
+            ShelfIt = PrevIt;
+        }
+    }
+
+    // Return the top shelf to the unused space
+    if (ShelfIt->first + ShelfIt->second.Height == m_Top)
+    {
+        m_Top = ShelfIt->first;
+        m_Shelves.erase(ShelfIt);
+    }
+}
+
+#if DILIGENT_DEBUG
+void ShelfAtlasManager::DbgVerifyConsistency() const
+{
+    Uint32 y              = 0;
+    Uint32 NumAllocations = 0;
+    bool   PrevIsEmpty    = false;
+    for (const auto& it : m_Shelves)
+    {
+        const auto& S = it.second;
+        VERIFY(it.first == y, "Shelves must be contiguous");
+        VERIFY(S.Height > 0, "Shelf height must not be zero");
+        VERIFY(S.AllocationCount != 0 || !PrevIsEmpty, "Adjacent empty shelves must be merged");
+
+        Uint32 SpanEnd = 0;
+        for (const auto& Span : S.FreeSpans)
+        {
+            VERIFY(Span.second > 0, "Free span must not be empty");
+            VERIFY(Span.first >= SpanEnd && (SpanEnd == 0 || Span.first > SpanEnd), "Free spans must not overlap or touch");
+            SpanEnd = Span.first + Span.second;
+        }
+        VERIFY(SpanEnd <= m_Width, "Free span exceeds the atlas width");
+
+        y += S.Height;
+        NumAllocations += S.AllocationCount;
+        PrevIsEmpty = S.AllocationCount == 0;
+    }
+    VERIFY(y == m_Top, "The top of the last shelf (", y, ") does not match the top of used space (", m_Top, ")");
+    VERIFY(m_Top <= m_Height, "Shelves exceed the atlas height");
+    VERIFY(NumAllocations == m_AllocationCount, "Inconsistent allocation count");
+}
+#endif
+
+} // namespace Diligent
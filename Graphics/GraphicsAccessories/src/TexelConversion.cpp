@@ -0,0 +1,411 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TexelConversion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "ColorConversion.h"
+#include "DebugUtilities.hpp"
+#include "Intrinsics.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// All SIMD kernels perform the same sequence of IEEE operations as the scalar code
+// that processes the row tail, so the results do not depend on the row alignment.
+
+void ConvertRowRGB8ToRGBA8(const Uint8* pSrc, Uint8* pDst, Uint32 Width)
+{
+    Uint32 x = 0;
+    // Process four texels (three 32-bit words) at a time
+    for (; x + 4 <= Width; x += 4, pSrc += 12, pDst += 16)
+    {
+        Uint32 w[3];
+        std::memcpy(w, pSrc, sizeof(w));
+
+        // Little-endian words: w[0] = R0 G0 B0 R1, w[1] = G1 B1 R2 G2, w[2] = B2 R3 G3 B3
+        const Uint32 Texels[4] = //
+            {
+                (w[0] & 0x00FFFFFFu) | 0xFF000000u,
+                (w[0] >> 24u) | ((w[1] & 0x0000FFFFu) << 8u) | 0xFF000000u,
+                (w[1] >> 16u) | ((w[2] & 0x000000FFu) << 16u) | 0xFF000000u,
+                (w[2] >> 8u) | 0xFF000000u,
+            };
+        std::memcpy(pDst, Texels, sizeof(Texels));
+    }
+
+    for (; x < Width; ++x, pSrc += 3, pDst += 4)
+    {
+        pDst[0] = pSrc[0];
+        pDst[1] = pSrc[1];
+        pDst[2] = pSrc[2];
+        pDst[3] = 255;
+    }
+}
+
+void ConvertRowBGRA8ToRGBA8(const Uint8* pSrc, Uint8* pDst, Uint32 Width)
+{
+    Uint32 x = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128i MaskAG = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    for (; x + 4 <= Width; x += 4, pSrc += 16, pDst += 16)
+    {
+        const __m128i Texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+        const __m128i AG     = _mm_and_si128(Texels, MaskAG);
+        const __m128i RB     = _mm_andnot_si128(MaskAG, Texels);
+        const __m128i BR     = _mm_or_si128(_mm_slli_epi32(RB, 16), _mm_srli_epi32(RB, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_or_si128(AG, BR));
+    }
+#endif
+
+    for (; x < Width; ++x, pSrc += 4, pDst += 4)
+    {
+        Uint32 Texel;
+        std::memcpy(&Texel, pSrc, sizeof(Texel));
+        const Uint32 RB = Texel & 0x00FF00FFu;
+        Texel           = (Texel & 0xFF00FF00u) | (RB << 16u) | (RB >> 16u);
+        std::memcpy(pDst, &Texel, sizeof(Texel));
+    }
+}
+
+// Round-to-nearest-even float to half conversion.
+// https://gist.github.com/rygorous/2156668 (float_to_half_fast3_rtne)
+Uint16 FloatToHalf(float f)
+{
+    constexpr Uint32 F32Infinity    = 255u << 23u;
+    constexpr Uint32 F16Max         = (127u + 16u) << 23u;
+    constexpr Uint32 F16MinNormal   = (127u - 14u) << 23u;
+    constexpr Uint32 DenormMagicU32 = ((127u - 15u) + (23u - 10u) + 1u) << 23u;
+
+    Uint32 u;
+    std::memcpy(&u, &f, sizeof(u));
+
+    const Uint32 Sign = u & 0x80000000u;
+    u ^= Sign;
+
+    Uint32 Half = 0;
+    if (u >= F16Max)
+    {
+        // Inf or NaN (NaN is converted to quiet NaN)
+        Half = (u > F32Infinity) ? 0x7E00u : 0x7C00u;
+    }
+    else if (u < F16MinNormal)
+    {
+        // Subnormal or zero: align the 10 mantissa bits at the bottom of the float
+        // and let the FP addition do the rounding.
+        float DenormMagic;
+        std::memcpy(&DenormMagic, &DenormMagicU32, sizeof(DenormMagic));
+
+        float Abs;
+        std::memcpy(&Abs, &u, sizeof(Abs));
+        Abs += DenormMagic;
+        std::memcpy(&u, &Abs, sizeof(u));
+        Half = u - DenormMagicU32;
+    }
+    else
+    {
+        const Uint32 MantOdd = (u >> 13u) & 1u;
+        // Rebias the exponent and round
+        u += ((15u - 127u) << 23u) + 0xFFFu;
+        u += MantOdd;
+        Half = u >> 13u;
+    }
+
+    return static_cast<Uint16>(Half | (Sign >> 16u));
+}
+
+#if DILIGENT_SSE2_ENABLED
+// SSE2 version of FloatToHalf() that converts four values at a time.
+// The 16-bit results are sign-extended to 32 bits.
+__m128i FloatToHalf(__m128 f)
+{
+    const __m128i SignMask       = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i F16Max         = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i NaNBit         = _mm_set1_epi32(0x200);
+    const __m128i F16Infinity    = _mm_set1_epi32(0x7C00);
+    const __m128i F16MinNormal   = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i DenormMagic    = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i NormalRounding = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+    const __m128  Sign    = _mm_and_ps(f, _mm_castsi128_ps(SignMask));
+    const __m128  Abs     = _mm_xor_ps(f, Sign);
+    const __m128i AbsBits = _mm_castps_si128(Abs);
+
+    const __m128i IsNaN     = _mm_castps_si128(_mm_cmpunord_ps(Abs, Abs));
+    const __m128i IsRegular = _mm_cmpgt_epi32(F16Max, AbsBits);
+    const __m128i InfOrNaN  = _mm_or_si128(_mm_and_si128(IsNaN, NaNBit), F16Infinity);
+
+    const __m128i IsSubnormal = _mm_cmpgt_epi32(F16MinNormal, AbsBits);
+    const __m128i Subnormal   = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(Abs, _mm_castsi128_ps(DenormMagic))), DenormMagic);
+
+    // -1 if the resulting mantissa is odd, 0 otherwise
+    const __m128i MantOdd = _mm_srai_epi32(_mm_slli_epi32(AbsBits, 31 - 13), 31);
+    const __m128i Normal  = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(AbsBits, NormalRounding), MantOdd), 13);
+
+    const __m128i Finite = _mm_or_si128(_mm_and_si128(IsSubnormal, Subnormal), _mm_andnot_si128(IsSubnormal, Normal));
+    const __m128i Half   = _mm_or_si128(_mm_and_si128(IsRegular, Finite), _mm_andnot_si128(IsRegular, InfOrNaN));
+
+    return _mm_or_si128(Half, _mm_srai_epi32(_mm_castps_si128(Sign), 16));
+}
+#endif
+
+void ConvertRowFloat32ToFloat16(const float* pSrc, Uint16* pDst, Uint32 Count)
+{
+    Uint32 i = 0;
+#if DILIGENT_SSE2_ENABLED
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128i Lo = FloatToHalf(_mm_loadu_ps(pSrc + i));
+        const __m128i Hi = FloatToHalf(_mm_loadu_ps(pSrc + i + 4));
+        // Values are sign-extended 16-bit integers, so signed saturation keeps them intact
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(Lo, Hi));
+    }
+#endif
+
+    for (; i < Count; ++i)
+        pDst[i] = FloatToHalf(pSrc[i]);
+}
+
+void ConvertRowUNorm16ToFloat32(const Uint16* pSrc, float* pDst, Uint32 Count)
+{
+    constexpr float Scale = 1.f / 65535.f;
+
+    Uint32 i = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128  vScale = _mm_set1_ps(Scale);
+    const __m128i Zero   = _mm_setzero_si128();
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128i Values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        _mm_storeu_ps(pDst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Values, Zero)), vScale));
+        _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Values, Zero)), vScale));
+    }
+#endif
+
+    for (; i < Count; ++i)
+        pDst[i] = static_cast<float>(pSrc[i]) * Scale;
+}
+
+class LinearToSRGB8Table
+{
+public:
+    LinearToSRGB8Table() noexcept
+    {
+        for (Uint32 i = 0; i < m_Table.size(); ++i)
+        {
+            m_Table[i] = static_cast<Uint8>(LinearToSRGB(static_cast<Uint8>(i)) * 255.f + 0.5f);
+        }
+    }
+
+    Uint8 operator[](Uint8 x) const
+    {
+        return m_Table[x];
+    }
+
+private:
+    std::array<Uint8, 256> m_Table;
+};
+
+void ConvertRowRGBA8LinearToSRGB(const Uint8* pSrc, Uint8* pDst, Uint32 Width)
+{
+    static const LinearToSRGB8Table Table;
+    for (Uint32 x = 0; x < Width; ++x, pSrc += 4, pDst += 4)
+    {
+        pDst[0] = Table[pSrc[0]];
+        pDst[1] = Table[pSrc[1]];
+        pDst[2] = Table[pSrc[2]];
+        pDst[3] = pSrc[3];
+    }
+}
+
+Uint8 LinearFloatToSRGB8(float x)
+{
+    // NaN is converted to 0
+    x                = std::min(std::max(0.f, x), 1.f);
+    const float SRGB = std::min(FastLinearToSRGB(x), 1.f);
+    return static_cast<Uint8>(SRGB * 255.f + 0.5f);
+}
+
+Uint8 UNormFloatToUint8(float x)
+{
+    x = std::min(std::max(0.f, x), 1.f);
+    return static_cast<Uint8>(x * 255.f + 0.5f);
+}
+
+void ConvertRowRGBA32FLinearToRGBA8SRGB(const float* pSrc, Uint8* pDst, Uint32 Width)
+{
+    Uint32 x = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128 Zero      = _mm_setzero_ps();
+    const __m128 One       = _mm_set1_ps(1.f);
+    const __m128 AbsMask   = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 Threshold = _mm_set1_ps(0.0031308f);
+    // Only convert the RGB channels
+    const __m128 ColorMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    for (; x + 2 <= Width; x += 2, pSrc += 8, pDst += 8)
+    {
+        __m128i Texels[2];
+        for (Uint32 t = 0; t < 2; ++t)
+        {
+            // _mm_max_ps returns the second operand if either is NaN, so NaN is converted to 0
+            // exactly as std::max(0.f, x) does.
+            __m128 v = _mm_loadu_ps(pSrc + t * 4);
+            v        = _mm_min_ps(One, _mm_max_ps(v, Zero));
+
+            // FastLinearToSRGB
+            const __m128 Lin  = _mm_mul_ps(_mm_set1_ps(12.92f), v);
+            const __m128 Sqrt = _mm_sqrt_ps(_mm_and_ps(AbsMask, _mm_sub_ps(v, _mm_set1_ps(0.00228f))));
+            __m128       Pow  = _mm_mul_ps(_mm_set1_ps(1.13005f), Sqrt);
+            Pow               = _mm_sub_ps(Pow, _mm_mul_ps(_mm_set1_ps(0.13448f), v));
+            Pow               = _mm_add_ps(Pow, _mm_set1_ps(0.005719f));
+
+            const __m128 IsLinear = _mm_cmplt_ps(v, Threshold);
+            __m128       SRGB     = _mm_or_ps(_mm_and_ps(IsLinear, Lin), _mm_andnot_ps(IsLinear, Pow));
+            SRGB                  = _mm_min_ps(One, SRGB);
+
+            v         = _mm_or_ps(_mm_and_ps(ColorMask, SRGB), _mm_andnot_ps(ColorMask, v));
+            Texels[t] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)));
+        }
+        // All values are in [0, 255], so saturation has no effect
+        const __m128i Words = _mm_packs_epi32(Texels[0], Texels[1]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), _mm_packus_epi16(Words, Words));
+    }
+#endif
+
+    for (; x < Width; ++x, pSrc += 4, pDst += 4)
+    {
+        pDst[0] = LinearFloatToSRGB8(pSrc[0]);
+        pDst[1] = LinearFloatToSRGB8(pSrc[1]);
+        pDst[2] = LinearFloatToSRGB8(pSrc[2]);
+        pDst[3] = UNormFloatToUint8(pSrc[3]);
+    }
+}
+
+} // namespace
+
+void GetTexelConversionSizes(TEXEL_CONVERSION Conversion, Uint32 NumComponents, Uint32& SrcTexelSize, Uint32& DstTexelSize)
+{
+    static_assert(TEXEL_CONVERSION_COUNT == 6, "Please handle the new texel conversion below");
+    switch (Conversion)
+    {
+        // clang-format off
+        case TEXEL_CONVERSION_RGB8_TO_RGBA8:                 SrcTexelSize = 3;                  DstTexelSize = 4;                  break;
+        case TEXEL_CONVERSION_BGRA8_TO_RGBA8:                SrcTexelSize = 4;                  DstTexelSize = 4;                  break;
+        case TEXEL_CONVERSION_FLOAT32_TO_FLOAT16:            SrcTexelSize = 4 * NumComponents;  DstTexelSize = 2 * NumComponents;  break;
+        case TEXEL_CONVERSION_UNORM16_TO_FLOAT32:            SrcTexelSize = 2 * NumComponents;  DstTexelSize = 4 * NumComponents;  break;
+        case TEXEL_CONVERSION_RGBA8_LINEAR_TO_SRGB:          SrcTexelSize = 4;                  DstTexelSize = 4;                  break;
+        case TEXEL_CONVERSION_RGBA32F_LINEAR_TO_RGBA8_SRGB:  SrcTexelSize = 16;                 DstTexelSize = 4;                  break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected texel conversion");
+            SrcTexelSize = 0;
+            DstTexelSize = 0;
+    }
+}
+
+bool ConvertTexelData(const ConvertTexelDataAttribs& Attribs)
+{
+    if (Attribs.Conversion >= TEXEL_CONVERSION_COUNT)
+    {
+        LOG_ERROR_MESSAGE("Invalid texel conversion (", Uint32{Attribs.Conversion}, ")");
+        return false;
+    }
+    if (Attribs.Width == 0 || Attribs.NumRows == 0)
+        return true;
+
+    if (Attribs.pSrcData == nullptr || Attribs.pDstData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Source and destination data must not be null");
+        return false;
+    }
+    if (Attribs.NumComponents == 0)
+    {
+        LOG_ERROR_MESSAGE("The number of components must not be zero");
+        return false;
+    }
+
+    Uint32 SrcTexelSize = 0;
+    Uint32 DstTexelSize = 0;
+    GetTexelConversionSizes(Attribs.Conversion, Attribs.NumComponents, SrcTexelSize, DstTexelSize);
+
+    const size_t SrcRowSize = size_t{Attribs.Width} * SrcTexelSize;
+    const size_t DstRowSize = size_t{Attribs.Width} * DstTexelSize;
+    if (Attribs.NumRows > 1 && (Attribs.SrcStride < SrcRowSize || Attribs.DstStride < DstRowSize))
+    {
+        LOG_ERROR_MESSAGE("Source (", Attribs.SrcStride, ") and destination (", Attribs.DstStride,
+                          ") row strides must not be smaller than the respective row sizes (", SrcRowSize, ", ", DstRowSize, ")");
+        return false;
+    }
+
+    const Uint32 Count = Attribs.Width * Attribs.NumComponents;
+    for (Uint32 row = 0; row < Attribs.NumRows; ++row)
+    {
+        const Uint8* pSrc = static_cast<const Uint8*>(Attribs.pSrcData) + row * Attribs.SrcStride;
+        Uint8*       pDst = static_cast<Uint8*>(Attribs.pDstData) + row * Attribs.DstStride;
+        switch (Attribs.Conversion)
+        {
+            case TEXEL_CONVERSION_RGB8_TO_RGBA8:
+                ConvertRowRGB8ToRGBA8(pSrc, pDst, Attribs.Width);
+                break;
+
+            case TEXEL_CONVERSION_BGRA8_TO_RGBA8:
+                ConvertRowBGRA8ToRGBA8(pSrc, pDst, Attribs.Width);
+                break;
+
+            case TEXEL_CONVERSION_FLOAT32_TO_FLOAT16:
+                ConvertRowFloat32ToFloat16(reinterpret_cast<const float*>(pSrc), reinterpret_cast<Uint16*>(pDst), Count);
+                break;
+
+            case TEXEL_CONVERSION_UNORM16_TO_FLOAT32:
+                ConvertRowUNorm16ToFloat32(reinterpret_cast<const Uint16*>(pSrc), reinterpret_cast<float*>(pDst), Count);
+                break;
+
+            case TEXEL_CONVERSION_RGBA8_LINEAR_TO_SRGB:
+                ConvertRowRGBA8LinearToSRGB(pSrc, pDst, Attribs.Width);
+                break;
+
+            case TEXEL_CONVERSION_RGBA32F_LINEAR_TO_RGBA8_SRGB:
+                ConvertRowRGBA32FLinearToRGBA8SRGB(reinterpret_cast<const float*>(pSrc), pDst, Attribs.Width);
+                break;
+
+            default:
+                UNEXPECTED("Unexpected texel conversion");
+                return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Diligent
@@ -38,6 +38,7 @@
 #include "RenderDeviceBase.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -260,6 +261,7 @@ protected:
     void*              m_pRawPtr       = nullptr;
     Uint32             m_GeometryCount = 0;
     ScratchBufferSizes m_ScratchSize;
+    GPUMemoryRecord    m_GPUMemoryRecord;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Uint32> m_DvpVersion{0};
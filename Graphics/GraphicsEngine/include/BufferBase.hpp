@@ -38,6 +38,7 @@
 #include "GraphicsAccessories.hpp"
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -253,6 +254,18 @@ protected:
     }
 
 
+    /// Registers the buffer memory in the device GPU memory tracker.
+
+    /// \param [in] Type          - Allocation type.
+    /// \param [in] AllocatedSize - The size of the memory occupied by the buffer, including
+    ///                             the padding and alignment. Must be zero for placed buffers.
+    void RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE Type, Uint64 AllocatedSize)
+    {
+        m_GPUMemoryRecord = GPUMemoryRecord{this->GetDevice()->GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_BUFFER, Type,
+                                            this->m_Desc.Name, this->m_Desc.Size, AllocatedSize};
+    }
+
+
 #ifdef DILIGENT_DEBUG
     TBuffViewObjAllocator& m_dbgBuffViewAllocator;
 #endif
@@ -266,6 +279,8 @@ protected:
 
     /// Default SRV addressing the entire buffer
     std::unique_ptr<BufferViewImplType, STDDeleter<BufferViewImplType, TBuffViewObjAllocator>> m_pDefaultSRV;
+
+    GPUMemoryRecord m_GPUMemoryRecord;
 };
 
 } // namespace Diligent
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::ICompilationStatistics interface and compilation timers
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "CompilationStatistics.h"
+#include "ObjectBase.hpp"
+
+namespace Diligent
+{
+
+class CompilationStageTimer;
+
+/// Implementation of the ICompilationStatistics interface.
+class CompilationStatisticsImpl final : public ObjectBase<ICompilationStatistics>
+{
+public:
+    using TBase = ObjectBase<ICompilationStatistics>;
+    using Clock = std::chrono::steady_clock;
+
+    explicit CompilationStatisticsImpl(IReferenceCounters* pRefCounters);
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_CompilationStatistics, TBase)
+
+    /// Implementation of ICompilationStatistics::GetRecordCount().
+    virtual Uint32 DILIGENT_CALL_TYPE GetRecordCount() const override final;
+
+    /// Implementation of ICompilationStatistics::GetRecord().
+    virtual const CompilationRecord& DILIGENT_CALL_TYPE GetRecord(Uint32 Index) const override final;
+
+    /// Implementation of ICompilationStatistics::Reset().
+    virtual void DILIGENT_CALL_TYPE Reset() override final;
+
+    /// Implementation of ICompilationStatistics::ExportCSV().
+    virtual void DILIGENT_CALL_TYPE ExportCSV(IDataBlob** ppData) const override final;
+
+    /// Implementation of ICompilationStatistics::ExportChromeTrace().
+    virtual void DILIGENT_CALL_TYPE ExportChromeTrace(IDataBlob** ppData) const override final;
+
+    /// Adds a record. Record.Name is ignored and Name is copied instead.
+    void AddRecord(const CompilationRecord& Record, const char* Name, Clock::time_point StartTime);
+
+    /// Returns the index of the calling thread.
+    static Uint32 GetThreadId();
+
+private:
+    struct RecordData
+    {
+        CompilationRecord Record;
+        std::string       Name;
+    };
+
+    mutable std::mutex m_Mtx;
+    Clock::time_point  m_StartTime;
+
+    // Deque keeps references to the elements valid when new records are added
+    std::deque<RecordData> m_Records;
+};
+
+
+/// Combines the cache lookup results of several pipelines or shader stages:
+/// the combined result is a hit only if all results are hits.
+inline PIPELINE_CACHE_RESULT CombinePipelineCacheResults(PIPELINE_CACHE_RESULT Result1, PIPELINE_CACHE_RESULT Result2)
+{
+    if (Result1 == PIPELINE_CACHE_RESULT_MISS || Result2 == PIPELINE_CACHE_RESULT_MISS)
+        return PIPELINE_CACHE_RESULT_MISS;
+    if (Result1 == PIPELINE_CACHE_RESULT_UNKNOWN || Result2 == PIPELINE_CACHE_RESULT_UNKNOWN)
+        return PIPELINE_CACHE_RESULT_UNKNOWN;
+    return PIPELINE_CACHE_RESULT_HIT;
+}
+
+
+/// Collects the statistics of a shader or pipeline state compiled by the current thread.
+
+/// While the scope is active, CompilationStageTimer objects created by the same thread
+/// add their time to this record. When the scope ends, the record is added to the statistics.
+class CompilationRecordScope
+{
+public:
+    /// If pStatistics is null, the scope does nothing.
+    CompilationRecordScope(CompilationStatisticsImpl* pStatistics,
+                           COMPILATION_RECORD_TYPE    Type,
+                           SHADER_TYPE                ShaderType,
+                           const char*                Name);
+    ~CompilationRecordScope();
+
+    // clang-format off
+    CompilationRecordScope           (const CompilationRecordScope&)  = delete;
+    CompilationRecordScope           (      CompilationRecordScope&&) = delete;
+    CompilationRecordScope& operator=(const CompilationRecordScope&)  = delete;
+    CompilationRecordScope& operator=(      CompilationRecordScope&&) = delete;
+    // clang-format on
+
+    /// Returns true if the scope collects statistics.
+    bool IsActive() const { return m_pStatistics != nullptr; }
+
+    void SetByteCodeSize(Uint64 Size) { m_Record.ByteCodeSize = Size; }
+
+    /// Sets the pipeline cache lookup result and the pipeline creation time reported by the driver.
+    void SetPipelineFeedback(PIPELINE_CACHE_RESULT CacheResult, Uint64 DriverDuration)
+    {
+        m_Record.CacheResult    = CacheResult;
+        m_Record.DriverDuration = DriverDuration;
+    }
+
+    /// Adds driver feedback for a shader stage. Feedback for the stages of the same type is combined.
+    void AddStageFeedback(SHADER_TYPE ShaderType, PIPELINE_CACHE_RESULT CacheResult, Uint64 Duration);
+
+    /// Returns the scope that is active in the calling thread, or null.
+    static CompilationRecordScope*& GetCurrent()
+    {
+        static thread_local CompilationRecordScope* pCurrent = nullptr;
+        return pCurrent;
+    }
+
+private:
+    friend class CompilationStageTimer;
+
+    CompilationStatisticsImpl* const                   m_pStatistics;
+    CompilationRecordScope* const                      m_pParent;
+    const char* const                                  m_Name;
+    const CompilationStatisticsImpl::Clock::time_point m_StartTime;
+
+    CompilationRecord m_Record;
+
+    // The innermost active stage timer
+    CompilationStageTimer* m_pActiveTimer = nullptr;
+};
+
+
+/// Adds the time spent in the timer scope to the given stage of the record
+/// that is active in the calling thread. If there is no active record, the timer does nothing.
+
+/// Nested timers are exclusive: the time of the inner timer is not added to the outer one.
+class CompilationStageTimer
+{
+public:
+    explicit CompilationStageTimer(COMPILATION_STAGE Stage) :
+        m_pScope{CompilationRecordScope::GetCurrent()},
+        m_Stage{Stage}
+    {
+        if (m_pScope == nullptr)
+            return;
+
+        m_pParent                = m_pScope->m_pActiveTimer;
+        m_pScope->m_pActiveTimer = this;
+        m_StartTime              = CompilationStatisticsImpl::Clock::now();
+    }
+
+    ~CompilationStageTimer()
+    {
+        if (m_pScope == nullptr)
+            return;
+
+        const auto Duration = static_cast<Uint64>(std::chrono::duration_cast<std::chrono::microseconds>(CompilationStatisticsImpl::Clock::now() - m_StartTime).count());
+        m_pScope->m_Record.StageDurations[m_Stage] += Duration > m_NestedDuration ? Duration - m_NestedDuration : 0;
+        if (m_pParent != nullptr)
+            m_pParent->m_NestedDuration += Duration;
+        m_pScope->m_pActiveTimer = m_pParent;
+    }
+
+    // clang-format off
+    CompilationStageTimer           (const CompilationStageTimer&)  = delete;
+    CompilationStageTimer           (      CompilationStageTimer&&) = delete;
+    CompilationStageTimer& operator=(const CompilationStageTimer&)  = delete;
+    CompilationStageTimer& operator=(      CompilationStageTimer&&) = delete;
+    // clang-format on
+
+private:
+    CompilationRecordScope* const m_pScope;
+    CompilationStageTimer*        m_pParent = nullptr;
+    const COMPILATION_STAGE       m_Stage;
+    Uint64                        m_NestedDuration = 0;
+
+    CompilationStatisticsImpl::Clock::time_point m_StartTime;
+};
+
+} // namespace Diligent
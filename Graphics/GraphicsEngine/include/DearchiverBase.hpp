@@ -33,6 +33,7 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <string>
 
 #include "Dearchiver.h"
 #include "RenderDevice.h"
@@ -73,6 +74,12 @@ public:
     virtual void DILIGENT_CALL_TYPE UnpackPipelineState(const PipelineStateUnpackInfo& DeArchiveInfo,
                                                         IPipelineState**               ppPSO) override final;
 
+    /// Implementation of IDearchiver::UnpackPipelineStates().
+    virtual void DILIGENT_CALL_TYPE UnpackPipelineStates(const PipelineStateUnpackInfo* pUnpackInfos,
+                                                         Uint32                         NumPipelines,
+                                                         IThreadPool*                   pThreadPool,
+                                                         IPipelineState**               ppPSOs) override final;
+
     /// Implementation of IDearchiver::UnpackResourceSignature().
     virtual void DILIGENT_CALL_TYPE UnpackResourceSignature(const ResourceSignatureUnpackInfo& DeArchiveInfo,
                                                             IPipelineResourceSignature**       ppSignature) override final;
@@ -81,6 +88,10 @@ public:
     virtual void DILIGENT_CALL_TYPE UnpackRenderPass(const RenderPassUnpackInfo& DeArchiveInfo,
                                                      IRenderPass**               ppRP) override final;
 
+    /// Implementation of IDearchiver::UnpackPipelineStateCache().
+    virtual void DILIGENT_CALL_TYPE UnpackPipelineStateCache(IRenderDevice*        pDevice,
+                                                             IPipelineStateCache** ppCache) override final;
+
     /// Implementation of IDearchiver::Store().
     virtual bool DILIGENT_CALL_TYPE Store(IDataBlob** ppArchive) const override final;
 
@@ -96,7 +107,9 @@ protected:
     virtual RefCntAutoPtr<IPipelineResourceSignature> UnpackResourceSignature(const ResourceSignatureUnpackInfo& DeArchiveInfo,
                                                                               bool                               IsImplicit) = 0;
 
+    // ShaderReflection is the optional device-specific reflection data stored after the shader create info.
     virtual RefCntAutoPtr<IShader> UnpackShader(const ShaderCreateInfo& ShaderCI,
+                                                const SerializedData&   ShaderReflection,
                                                 IRenderDevice*          pDevice);
 
 protected:
@@ -176,6 +189,42 @@ private:
         // clang-format on
     };
 
+    // Shaders shared by all loaded archives. The key is the serialized shader data (create info,
+    // byte code and reflection), so identical shaders in different archives resolve to the same object.
+    class ShaderContentCache
+    {
+    public:
+        // SerializedShader must be the data owned by a loaded archive.
+        RefCntAutoPtr<IShader> Get(DeviceType DevType, const SerializedData& SerializedShader, bool SkipReflection);
+        void                   Set(DeviceType DevType, const SerializedData& SerializedShader, bool SkipReflection, IShader* pShader);
+
+        void Clear();
+
+    private:
+        struct Key
+        {
+            // Points to the archive data, which is kept alive until the archives are reset
+            const void* pData          = nullptr;
+            size_t      Size           = 0;
+            size_t      Hash           = 0;
+            DeviceType  DevType        = DeviceType::Count;
+            bool        SkipReflection = false;
+
+            Key(DeviceType DevType, const SerializedData& SerializedShader, bool SkipReflection);
+
+            bool operator==(const Key& rhs) const;
+
+            struct Hasher
+            {
+                size_t operator()(const Key& k) const { return k.Hash; }
+            };
+        };
+
+        std::mutex m_Mtx;
+
+        std::unordered_map<Key, RefCntWeakPtr<IShader>, Key::Hasher> m_Map;
+    };
+
     struct ArchiveData
     {
         explicit ArchiveData(std::unique_ptr<DeviceObjectArchive>&& _pObjArchive) noexcept :
@@ -207,6 +256,19 @@ private:
     template <typename CreateInfoType>
     void UnpackPipelineStateImpl(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO);
 
+    // Resource signatures and render pass referenced by a pipeline in the archive
+    struct PSODependencies
+    {
+        std::vector<std::string> SignatureNames;
+        std::string              RenderPassName;
+        Uint32                   SRBAllocationGranularity = 1;
+    };
+
+    template <typename CreateInfoType>
+    bool GetPSODependenciesImpl(const PipelineStateUnpackInfo& UnpackInfo, PSODependencies& Deps);
+
+    bool GetPSODependencies(const PipelineStateUnpackInfo& UnpackInfo, PSODependencies& Deps);
+
     ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
 
 private:
@@ -216,6 +278,8 @@ private:
     std::unordered_map<NamedResourceKey, size_t, NamedResourceKey::Hasher> m_ResNameToArchiveIdx;
 
     std::vector<ArchiveData> m_Archives;
+
+    ShaderContentCache m_ShaderContentCache;
 };
 
 
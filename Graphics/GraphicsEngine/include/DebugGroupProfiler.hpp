@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DebugGroupProfiler class
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "Query.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Wraps the debug groups of an immediate device context into duration and pipeline
+/// statistics queries and collects the per-group results, see IDeviceContext::SetDebugGroupProfiling().
+///
+/// Queries are recycled through per-type free lists, so that in the steady state no
+/// queries are created. The results are read with a single IDeviceContext::GetQueryData()
+/// call per query type when the frame is finished; groups whose results are not yet
+/// available stay pending until the next frame, so the CPU never waits for the GPU.
+class DebugGroupProfiler
+{
+public:
+    /// Callback that is called for every query created by the profiler.
+    /// The queries are owned by the context and must not keep a strong reference to it.
+    using QueryCreatedCallbackType = std::function<void(IQuery*)>;
+
+    DebugGroupProfiler(IRenderDevice* pDevice, IDeviceContext* pContext, QueryCreatedCallbackType OnQueryCreated);
+
+    // clang-format off
+    DebugGroupProfiler           (const DebugGroupProfiler&)  = delete;
+    DebugGroupProfiler& operator=(const DebugGroupProfiler&)  = delete;
+    DebugGroupProfiler           (      DebugGroupProfiler&&) = delete;
+    DebugGroupProfiler& operator=(      DebugGroupProfiler&&) = delete;
+    // clang-format on
+
+    /// Begins profiling the debug group at the given nesting level.
+    void BeginDebugGroup(const Char* Name, Uint32 Depth, Uint64 FrameNumber);
+
+    /// Ends the debug group at the given nesting level if it is being profiled.
+    void EndDebugGroup(Uint32 Depth);
+
+    /// Reads the available results and publishes the profile of the last complete frame.
+
+    /// \param [in] CurrentFrame - Number of the frame that is being recorded. All groups
+    ///                            of the previous frames must have been submitted.
+    void ResolvePending(Uint64 CurrentFrame);
+
+    /// Returns the profile of the most recent frame whose results are available.
+    const DebugGroupProfile* GetProfile(Uint32& NumGroups) const
+    {
+        NumGroups = static_cast<Uint32>(m_Profile.size());
+        return !m_Profile.empty() ? m_Profile.data() : nullptr;
+    }
+
+    /// Returns true if there are open profiled groups.
+    bool HasOpenGroups() const
+    {
+        return !m_OpenGroups.empty();
+    }
+
+private:
+    enum PROFILER_QUERY : Uint32
+    {
+        PROFILER_QUERY_DURATION = 0,
+        PROFILER_QUERY_STATISTICS,
+        PROFILER_QUERY_COUNT
+    };
+
+    struct GroupRecord
+    {
+        Uint64 FrameNumber = 0;
+        Uint32 PathId      = 0;
+        Uint32 Depth       = 0;
+        bool   Ended       = false;
+
+        RefCntAutoPtr<IQuery> pQueries[PROFILER_QUERY_COUNT];
+    };
+
+    RefCntAutoPtr<IQuery> AllocateQuery(PROFILER_QUERY Type);
+    void                  RecycleQueries(GroupRecord& Record);
+
+    // Returns true if a query of the given type may be begun in the current group
+    bool CanBeginQuery(PROFILER_QUERY Type) const;
+
+    Uint32 GetPathId(const Char* Name);
+
+private:
+    IRenderDevice* const  m_pDevice;
+    IDeviceContext* const m_pContext;
+
+    const QueryCreatedCallbackType m_OnQueryCreated;
+
+    bool m_QueryEnabled[PROFILER_QUERY_COUNT] = {};
+
+    // Whether queries of the given type may be active in nested groups
+    bool m_AllowNested[PROFILER_QUERY_COUNT] = {};
+
+    // The number of open groups that have an active query of the given type
+    Uint32 m_NumActiveQueries[PROFILER_QUERY_COUNT] = {};
+
+    std::vector<RefCntAutoPtr<IQuery>> m_FreeQueries[PROFILER_QUERY_COUNT];
+
+    // Records in the order the groups were begun. Records are only removed from the front,
+    // so pointers to the open groups remain valid.
+    std::deque<GroupRecord>   m_Pending;
+    std::vector<GroupRecord*> m_OpenGroups;
+
+    // Full group paths, e.g. "Frame/Shadows". std::deque keeps the strings in place,
+    // so that DebugGroupProfile::Name pointers remain valid.
+    std::deque<std::string>                 m_Paths;
+    std::unordered_map<std::string, Uint32> m_PathIds;
+
+    // Profile of the frame whose results are being read
+    std::vector<DebugGroupProfile> m_Resolved;
+    Uint64                         m_ResolvedFrame = 0;
+
+    // Profile of the most recent complete frame
+    std::vector<DebugGroupProfile> m_Profile;
+
+    // Scratch arrays for the batched query reads
+    std::vector<IQuery*>                     m_BatchQueries;
+    std::vector<QueryDataDuration>           m_DurationData;
+    std::vector<QueryDataPipelineStatistics> m_StatisticsData;
+
+    // std::vector<Bool> does not provide data()
+    std::unique_ptr<Bool[]> m_DataAvailable;
+    Uint32                  m_DataAvailableSize = 0;
+};
+
+} // namespace Diligent
@@ -32,7 +32,10 @@
 
 #include <unordered_map>
 #include <array>
+#include <vector>
+#include <algorithm>
 #include <functional>
+#include <memory>
 
 #include "PrivateConstants.h"
 #include "DeviceContext.h"
@@ -48,6 +51,11 @@
 #include "BasicMath.hpp"
 #include "PlatformMisc.hpp"
 #include "Align.hpp"
+#include "InlineConstantsData.hpp"
+#include "DebugGroupProfiler.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "EngineMemory.h"
+#include "TrackingMemoryAllocator.hpp"
 
 namespace Diligent
 {
@@ -92,6 +100,8 @@ bool VerifyTraceRaysIndirectAttribs(const IRenderDevice*            pDevice,
 
 bool VerifyBindSparseResourceMemoryAttribs(const IRenderDevice* pDevice, const BindSparseResourceMemoryAttribs& Attribs);
 
+bool VerifyBeginConditionalRenderingAttribs(const BeginConditionalRenderingAttribs& Attribs);
+
 
 /// Describes input vertex stream
 template <typename BufferImplType>
@@ -162,6 +172,7 @@ public:
     // clang-format on
     {
         VERIFY_EXPR(m_pDevice != nullptr);
+        m_CommandValidationEnabled = (m_pDevice->GetValidationFlags() & VALIDATION_FLAG_CHECK_COMMAND_ARGUMENTS) != 0;
     }
 
     ~DeviceContextBase()
@@ -289,6 +300,50 @@ public:
         return m_pUserData.RawPtr<IObject>();
     }
 
+    /// Implementation of IDeviceContext::GetStateFilterStats.
+    virtual const DeviceContextStateFilterStats& DILIGENT_CALL_TYPE GetStateFilterStats() const override final
+    {
+        return m_StateFilterStats;
+    }
+
+    /// Implementation of IDeviceContext::GetStatistics.
+    virtual const DeviceContextStatistics& DILIGENT_CALL_TYPE GetStatistics() const override final
+    {
+        return m_Statistics;
+    }
+
+    /// Implementation of IDeviceContext::SetDebugGroupProfiling.
+    virtual void DILIGENT_CALL_TYPE SetDebugGroupProfiling(Bool Enable) override final;
+
+    /// Implementation of IDeviceContext::GetDebugGroupProfile.
+    virtual const DebugGroupProfile* DILIGENT_CALL_TYPE GetDebugGroupProfile(Uint32& NumGroups) const override final
+    {
+        if (!m_pDebugGroupProfiler)
+        {
+            NumGroups = 0;
+            return nullptr;
+        }
+        return m_pDebugGroupProfiler->GetProfile(NumGroups);
+    }
+
+    /// Implementation of IDeviceContext::SetCommandValidation.
+    virtual void DILIGENT_CALL_TYPE SetCommandValidation(Bool Enable) override final
+    {
+        m_CommandValidationEnabled = Enable;
+    }
+
+    /// Base implementation of IDeviceContext::SubmitDrawPackets.
+    virtual void DILIGENT_CALL_TYPE SubmitDrawPackets(const DrawPacket*              pPackets,
+                                                      Uint32                         NumPackets,
+                                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                                      SUBMIT_DRAW_PACKETS_FLAGS      Flags) override;
+
+    /// Base implementation of IDeviceContext::SetInlineConstants.
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(IShaderResourceVariable* pVariable,
+                                                       const void*              pConstants,
+                                                       Uint32                   FirstConstant,
+                                                       Uint32                   NumConstants) override;
+
     /// Base implementation of IDeviceContext::DispatchTile.
     virtual void DILIGENT_CALL_TYPE DispatchTile(const DispatchTileAttribs& Attribs) override
     {
@@ -301,6 +356,26 @@ public:
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Base implementation of IDeviceContext::DispatchGraph.
+    virtual void DILIGENT_CALL_TYPE DispatchGraph(const DispatchGraphAttribs& Attribs) override
+    {
+        UNSUPPORTED("Work graph pipeline is not supported by this device. Please check DeviceFeatures.WorkGraphs feature.");
+    }
+
+    /// Base implementation of IDeviceContext::GetQueryData that reads the data of every query individually.
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueryData(Uint32         NumQueries,
+                                                   IQuery* const* ppQueries,
+                                                   void*          pData,
+                                                   Uint32         DataSize,
+                                                   Bool*          pDataAvailable,
+                                                   Bool           AutoInvalidate) override;
+
+    /// Base implementation of IDeviceContext::GetTimestampCalibration that reports that the calibration is not supported.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override
+    {
+        return False;
+    }
+
     /// Returns currently bound pipeline state and blend factors
     inline void GetPipelineState(IPipelineState** ppPSO, float* BlendFactors, Uint32& StencilRef);
 
@@ -453,6 +528,24 @@ protected:
 
     inline void SetPipelineState(RefCntAutoPtr<PipelineStateImplType> pPipelineState, int /*Dummy*/);
 
+    /// Returns true if the pipeline state is already bound and counts the call as filtered.
+    inline bool IsRedundantPipelineState(IPipelineState* pPipelineState);
+
+    /// Returns true if SetVertexBuffers() with the given arguments would not change the bound vertex
+    /// buffers and would not require any state transition, and counts the call as filtered.
+    inline bool IsRedundantVertexBuffers(Uint32                         StartSlot,
+                                         Uint32                         NumBuffersSet,
+                                         IBuffer* const*                ppBuffers,
+                                         const Uint64*                  pOffsets,
+                                         RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                         SET_VERTEX_BUFFERS_FLAGS       Flags);
+
+    /// Returns true if SetIndexBuffer() with the given arguments would not change the bound index
+    /// buffer and would not require any state transition, and counts the call as filtered.
+    inline bool IsRedundantIndexBuffer(IBuffer*                       pIndexBuffer,
+                                       Uint64                         ByteOffset,
+                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
     /// Clears all cached resources
     inline void ClearStateCache();
 
@@ -479,6 +572,20 @@ protected:
     void EndFrame()
     {
         ++m_FrameNumber;
+        // Device metric frames follow the first immediate context
+        if (!IsDeferred() && GetContextId() == 0)
+        {
+            m_pDevice->EndMetricsFrame();
+            m_pDevice->EndMemoryAllocationFrame();
+        }
+
+        if (m_pDebugGroupProfiler)
+            m_pDebugGroupProfiler->ResolvePending(m_FrameNumber);
+    }
+
+    bool IsDebugGroupProfilingEnabled() const
+    {
+        return m_DebugGroupProfilingEnabled;
     }
 
     void PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount);
@@ -526,6 +633,8 @@ protected:
 
     void DvpVerifyDispatchTileArguments(const DispatchTileAttribs& Attribs) const;
 
+    void DvpVerifyDispatchGraphArguments(const DispatchGraphAttribs& Attribs) const;
+
     void DvpVerifyRenderTargets() const;
     void DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier) const;
     void DvpVerifyTextureState(const TextureImplType&   Texture, RESOURCE_STATE RequiredState, const char* OperationName) const;
@@ -539,19 +648,26 @@ protected:
         CommittedShaderResources&                                 Resources,
         std::function<PipelineResourceSignatureImplType*(Uint32)> CustomGetSignature = nullptr) const;
 #else
+    // In release builds, only the command arguments are verified, and only
+    // when command validation is enabled (see SetCommandValidation()).
     // clang-format off
-    void DvpVerifyDrawArguments                 (const DrawAttribs&                  Attribs) const {}
-    void DvpVerifyDrawIndexedArguments          (const DrawIndexedAttribs&           Attribs) const {}
-    void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs) const {}
-    void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const {}
-    void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const {}
-    void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs) const {}
+    void DvpVerifyDrawArguments                 (const DrawAttribs&                  Attribs) const;
+    void DvpVerifyDrawIndexedArguments          (const DrawIndexedAttribs&           Attribs) const;
+    void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs) const;
+    void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const;
+    void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const;
+    void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs) const;
 
-    void DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const {}
-    void DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs) const {}
+    void DvpVerifyDispatchArguments        (const DispatchComputeAttribs& Attribs) const;
+    void DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs) const;
+
+    // Verifies that a pipeline of the required type is bound
+    bool VerifyBoundPipeline(PIPELINE_TYPE RequiredType, const char* CmdName) const;
 
     void DvpVerifyDispatchTileArguments(const DispatchTileAttribs& Attribs) const {}
 
+    void DvpVerifyDispatchGraphArguments(const DispatchGraphAttribs& Attribs) const {}
+
     void DvpVerifyRenderTargets()const {}
     void DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier)const {}
     void DvpVerifyTextureState(const TextureImplType&   Texture, RESOURCE_STATE RequiredState, const char* OperationName) const {}
@@ -562,6 +678,7 @@ protected:
 #endif
 
     void BuildBLAS(const BuildBLASAttribs& Attribs, int) const;
+    void BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int);
     void BuildTLAS(const BuildTLASAttribs& Attribs, int) const;
     void CopyBLAS(const CopyBLASAttribs& Attribs, int) const;
     void CopyTLAS(const CopyTLASAttribs& Attribs, int) const;
@@ -579,6 +696,11 @@ protected:
 
     void BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs, int) const;
 
+    void BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs, int);
+    void EndConditionalRendering(int);
+
+    bool IsConditionalRenderingActive() const { return m_ConditionalRenderingActive; }
+
 protected:
     static constexpr Uint32 DrawMeshIndirectCommandStride = sizeof(Uint32) * 3; // D3D12: 12 bytes (x, y, z dimension)
                                                                                 // Vulkan: 8 bytes (task count, first task)
@@ -660,6 +782,43 @@ protected:
 
     Uint64 m_FrameNumber = 0;
 
+    /// Scratch arena for temporary arrays on the command recording and submission paths.
+    /// Allocations are released with DynamicLinearAllocatorScope, while the memory pages
+    /// are kept, so that steady-state frames do not allocate memory.
+    DynamicLinearAllocator m_ScratchAllocator{GetRawAllocator()};
+
+    /// Numbers of redundant state-setting calls that were filtered out
+    DeviceContextStateFilterStats m_StateFilterStats;
+
+    /// Context statistics updated by the backend implementations
+    DeviceContextStatistics m_Statistics;
+
+    /// Debug group profiler, see SetDebugGroupProfiling()
+    std::unique_ptr<DebugGroupProfiler> m_pDebugGroupProfiler;
+
+    bool m_DebugGroupProfilingEnabled = false;
+
+    /// Whether to verify the command arguments in release builds, see SetCommandValidation()
+    bool m_CommandValidationEnabled = false;
+
+    /// The number of open debug groups
+    Uint32 m_DebugGroupDepth = 0;
+
+    /// Whether conditional rendering is active, see BeginConditionalRendering()
+    bool m_ConditionalRenderingActive = false;
+
+    /// Whether conditional rendering was begun inside an explicit render pass
+    bool m_ConditionalRenderingInsidePass = false;
+
+    /// Scratch array used by SubmitDrawPackets() to sort the packets
+    std::vector<Uint32> m_DrawPacketOrder;
+
+    /// Builds of the current BLAS batch with resolved scratch buffers, see BuildBLASBatch()
+    std::vector<BuildBLASAttribs> m_BLASBatchBuilds;
+
+    /// Scratch buffer shared by all BLAS batch builds that do not provide their own scratch buffer
+    RefCntAutoPtr<IBuffer> m_pBLASBatchScratchBuffer;
+
     RefCntAutoPtr<IObject> m_pUserData;
 
     // Must go before m_Desc!
@@ -698,6 +857,21 @@ protected:
                       GetCommandQueueTypeString(m_Desc.QueueType), " queue.");                                                 \
     } while (false)
 
+// Command argument checks that are performed in development builds and, when command
+// validation is enabled (see SetCommandValidation()), in release builds.
+#ifdef DILIGENT_DEVELOPMENT
+#    define CHECK_COMMAND_ARGUMENTS() true
+#    define CHECK_COMMAND_ARGUMENT    DEV_CHECK_ERR
+#else
+#    define CHECK_COMMAND_ARGUMENTS() m_CommandValidationEnabled
+#    define CHECK_COMMAND_ARGUMENT(Expr, ...) \
+        do                                    \
+        {                                     \
+            if (!(Expr))                      \
+                LOG_ERROR_MESSAGE(__VA_ARGS__); \
+        } while (false)
+#endif
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
     Uint32                         StartSlot,
@@ -760,10 +934,228 @@ inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetPipelineState");
     DEV_CHECK_ERR((pPipelineState->GetDesc().ImmediateContextMask & (Uint64{1} << GetExecutionCtxId())) != 0,
                   "PSO '", pPipelineState->GetDesc().Name, "' can't be used in device context '", m_Desc.Name, "'.");
+    DEV_CHECK_ERR(pPipelineState->GetStatus(/*WaitForCompletion = */ false) == PIPELINE_STATE_STATUS_READY,
+                  "PSO '", pPipelineState->GetDesc().Name, "' is not ready. Use GetStatus() to check the pipeline status.");
 
     m_pPipelineState = std::move(pPipelineState);
 }
 
+template <typename ImplementationTraits>
+inline bool DeviceContextBase<ImplementationTraits>::IsRedundantPipelineState(IPipelineState* pPipelineState)
+{
+    // The context holds a strong reference to the bound PSO, so its address can't be reused by another object
+    if (static_cast<IPipelineState*>(m_pPipelineState.RawPtr()) != pPipelineState)
+        return false;
+
+    ++m_StateFilterStats.PipelineStates;
+    return true;
+}
+
+// Returns true if binding the buffer with the given transition mode requires no state transition or verification
+template <typename BufferImplType>
+bool IsBufferInBindState(const BufferImplType* pBuffer, RESOURCE_STATE RequiredState, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (pBuffer == nullptr || StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_NONE)
+        return true;
+
+    return pBuffer->IsInKnownState() && pBuffer->CheckState(RequiredState) && !pBuffer->CheckState(RESOURCE_STATE_UNORDERED_ACCESS);
+}
+
+template <typename ImplementationTraits>
+inline bool DeviceContextBase<ImplementationTraits>::IsRedundantVertexBuffers(
+    Uint32                         StartSlot,
+    Uint32                         NumBuffersSet,
+    IBuffer* const*                ppBuffers,
+    const Uint64*                  pOffsets,
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+    SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    // Let SetVertexBuffers() report invalid ranges
+    if (StartSlot + NumBuffersSet > MAX_BUFFER_SLOTS)
+        return false;
+
+    for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
+    {
+        const auto& CurrStream = m_VertexStreams[StartSlot + Buff];
+        IBuffer*    pBuffer    = ppBuffers != nullptr ? ppBuffers[Buff] : nullptr;
+        if (static_cast<const IBuffer*>(CurrStream.pBuffer.RawPtr()) != pBuffer)
+            return false;
+        if (pBuffer != nullptr && CurrStream.Offset != (pOffsets != nullptr ? pOffsets[Buff] : 0))
+            return false;
+        if (!IsBufferInBindState(CurrStream.pBuffer.RawPtr(), RESOURCE_STATE_VERTEX_BUFFER, StateTransitionMode))
+            return false;
+    }
+
+    if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
+    {
+        // All slots outside of the range must already be empty
+        if (m_NumVertexStreams > StartSlot + NumBuffersSet)
+            return false;
+        for (Uint32 s = 0; s < StartSlot; ++s)
+        {
+            if (m_VertexStreams[s].pBuffer)
+                return false;
+        }
+    }
+
+    ++m_StateFilterStats.VertexBuffers;
+    return true;
+}
+
+template <typename ImplementationTraits>
+inline bool DeviceContextBase<ImplementationTraits>::IsRedundantIndexBuffer(
+    IBuffer*                       pIndexBuffer,
+    Uint64                         ByteOffset,
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (static_cast<IBuffer*>(m_pIndexBuffer.RawPtr()) != pIndexBuffer || m_IndexDataStartOffset != ByteOffset)
+        return false;
+
+    if (!IsBufferInBindState(m_pIndexBuffer.RawPtr(), RESOURCE_STATE_INDEX_BUFFER, StateTransitionMode))
+        return false;
+
+    ++m_StateFilterStats.IndexBuffers;
+    return true;
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::SetInlineConstants(
+    IShaderResourceVariable* pVariable,
+    const void*              pConstants,
+    Uint32                   FirstConstant,
+    Uint32                   NumConstants)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetInlineConstants");
+    DEV_CHECK_ERR(pVariable != nullptr, "Shader resource variable must not be null");
+    DEV_CHECK_ERR(pConstants != nullptr || NumConstants == 0, "pConstants must not be null");
+    if (NumConstants == 0)
+        return;
+
+    // The buffer that emulates inline constants keeps the CPU-side copy of the constants as its user data
+    auto* const                        pBuffer = pVariable->Get(0);
+    RefCntAutoPtr<InlineConstantsData> pData{pBuffer != nullptr ? pBuffer->GetUserData() : nullptr, IID_InlineConstantsData};
+    if (!pData)
+    {
+        ShaderResourceDesc ResDesc;
+        pVariable->GetResourceDesc(ResDesc);
+        DEV_ERROR("Variable '", ResDesc.Name, "' is not an inline constants variable. Use PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag to define inline constants.");
+        return;
+    }
+
+    if (FirstConstant + NumConstants > pData->GetNumConstants())
+    {
+        ShaderResourceDesc ResDesc;
+        pVariable->GetResourceDesc(ResDesc);
+        DEV_ERROR("Constants [", FirstConstant, ", ", FirstConstant + NumConstants, ") are out of range for inline constants '",
+                  ResDesc.Name, "' that define ", pData->GetNumConstants(), " constants.");
+        return;
+    }
+
+    pData->Update(pConstants, FirstConstant, NumConstants);
+
+    // Mapping with DISCARD flag gives new memory, so the whole block must be written
+    IBuffer* const  pConstBuffer = ClassPtrCast<BufferImplType>(pBuffer);
+    IDeviceContext* pCtx         = this;
+    PVoid           pMappedData  = nullptr;
+    pCtx->MapBuffer(pConstBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+    if (pMappedData != nullptr)
+    {
+        memcpy(pMappedData, pData->GetData(), pData->GetDataSize());
+        pCtx->UnmapBuffer(pConstBuffer, MAP_WRITE);
+    }
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::SubmitDrawPackets(
+    const DrawPacket*              pPackets,
+    Uint32                         NumPackets,
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+    SUBMIT_DRAW_PACKETS_FLAGS      Flags)
+{
+    DEV_CHECK_ERR(NumPackets == 0 || pPackets != nullptr, "pPackets must not be null when NumPackets is not zero");
+    if (NumPackets == 0)
+        return;
+
+    const Uint32* pOrder = nullptr;
+    if ((Flags & SUBMIT_DRAW_PACKETS_FLAG_ALLOW_REORDER) != 0)
+    {
+        m_DrawPacketOrder.resize(NumPackets);
+        for (Uint32 i = 0; i < NumPackets; ++i)
+            m_DrawPacketOrder[i] = i;
+
+        // Group the packets by PSO and the first SRB. Stable sort preserves
+        // the order of the packets that use the same state.
+        std::stable_sort(m_DrawPacketOrder.begin(), m_DrawPacketOrder.end(),
+                         [pPackets](Uint32 Idx0, Uint32 Idx1) {
+                             const DrawPacket& P0 = pPackets[Idx0];
+                             const DrawPacket& P1 = pPackets[Idx1];
+                             if (P0.pPipelineState != P1.pPipelineState)
+                                 return std::less<const IPipelineState*>{}(P0.pPipelineState, P1.pPipelineState);
+
+                             const IShaderResourceBinding* pSRB0 = P0.NumSRBs > 0 ? P0.ppSRBs[0] : nullptr;
+                             const IShaderResourceBinding* pSRB1 = P1.NumSRBs > 0 ? P1.ppSRBs[0] : nullptr;
+                             return std::less<const IShaderResourceBinding*>{}(pSRB0, pSRB1);
+                         });
+        pOrder = m_DrawPacketOrder.data();
+    }
+
+    // Call the methods through the interface as the implementation type overrides them
+    IDeviceContext* const pCtx = this;
+
+    const DrawPacket* pPrevPacket       = nullptr;
+    IBuffer*          pBoundIndexBuffer = nullptr;
+    Uint64            BoundIndexOffset  = 0;
+    for (Uint32 i = 0; i < NumPackets; ++i)
+    {
+        const DrawPacket& Packet = pPackets[pOrder != nullptr ? pOrder[i] : i];
+        DEV_CHECK_ERR(Packet.pPipelineState != nullptr, "Pipeline state of draw packet ", i, " is null");
+        DEV_CHECK_ERR(Packet.NumSRBs == 0 || Packet.ppSRBs != nullptr, "ppSRBs of draw packet ", i, " is null");
+        DEV_CHECK_ERR(Packet.NumVertexBuffers == 0 || Packet.ppVertexBuffers != nullptr, "ppVertexBuffers of draw packet ", i, " is null");
+
+        const bool PSOChanged = pPrevPacket == nullptr || Packet.pPipelineState != pPrevPacket->pPipelineState;
+        if (PSOChanged)
+            pCtx->SetPipelineState(Packet.pPipelineState);
+
+        // Shader resources are recommitted after every PSO change as the new
+        // pipeline may use a different resource layout.
+        bool SRBsChanged = PSOChanged || Packet.NumSRBs != pPrevPacket->NumSRBs;
+        for (Uint32 srb = 0; srb < Packet.NumSRBs && !SRBsChanged; ++srb)
+            SRBsChanged = Packet.ppSRBs[srb] != pPrevPacket->ppSRBs[srb];
+        if (SRBsChanged)
+        {
+            for (Uint32 srb = 0; srb < Packet.NumSRBs; ++srb)
+                pCtx->CommitShaderResources(Packet.ppSRBs[srb], StateTransitionMode);
+        }
+
+        bool VBsChanged = pPrevPacket == nullptr || Packet.NumVertexBuffers != pPrevPacket->NumVertexBuffers;
+        for (Uint32 vb = 0; vb < Packet.NumVertexBuffers && !VBsChanged; ++vb)
+        {
+            const Uint64 Offset     = Packet.pVertexOffsets != nullptr ? Packet.pVertexOffsets[vb] : 0;
+            const Uint64 PrevOffset = pPrevPacket->pVertexOffsets != nullptr ? pPrevPacket->pVertexOffsets[vb] : 0;
+            VBsChanged              = Packet.ppVertexBuffers[vb] != pPrevPacket->ppVertexBuffers[vb] || Offset != PrevOffset;
+        }
+        if (VBsChanged)
+            pCtx->SetVertexBuffers(0, Packet.NumVertexBuffers, Packet.ppVertexBuffers, Packet.pVertexOffsets, StateTransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        if (Packet.pIndexBuffer != nullptr)
+        {
+            if (Packet.pIndexBuffer != pBoundIndexBuffer || Packet.IndexBufferOffset != BoundIndexOffset)
+            {
+                pCtx->SetIndexBuffer(Packet.pIndexBuffer, Packet.IndexBufferOffset, StateTransitionMode);
+                pBoundIndexBuffer = Packet.pIndexBuffer;
+                BoundIndexOffset  = Packet.IndexBufferOffset;
+            }
+            pCtx->DrawIndexed(Packet.IndexedAttribs);
+        }
+        else
+        {
+            pCtx->Draw(Packet.Attribs);
+        }
+
+        pPrevPacket = &Packet;
+    }
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::CommitShaderResources(
     IShaderResourceBinding*        pShaderResourceBinding,
@@ -843,6 +1235,8 @@ inline bool DeviceContextBase<ImplementationTraits>::SetBlendFactors(const float
             FactorsDiffer = true;
         m_BlendFactors[f] = BlendFactors[f];
     }
+    if (!FactorsDiffer)
+        ++m_StateFilterStats.BlendFactors;
     return FactorsDiffer;
 }
 
@@ -856,6 +1250,7 @@ inline bool DeviceContextBase<ImplementationTraits>::SetStencilRef(Uint32 Stenci
         m_StencilRef = StencilRef;
         return true;
     }
+    ++m_StateFilterStats.StencilRefs;
     return false;
 }
 
@@ -1421,7 +1816,14 @@ inline void DeviceContextBase<ImplementationTraits>::BeginRenderPass(const Begin
             auto  RequiredState = RPDesc.pAttachments[i].InitialState;
             if (Attribs.StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
             {
-                if (pTex->IsInKnownState() && !pTex->CheckState(RequiredState))
+                if (pTex->GetSubresourceStates() != nullptr)
+                {
+                    // Only transition the subresources used by the attachment
+                    const auto          Range = pTex->GetSubresourceRange(pView->GetDesc());
+                    StateTransitionDesc Barrier{pTex, RESOURCE_STATE_UNKNOWN, RequiredState, Range.FirstMip, Range.NumMips, Range.FirstSlice, Range.NumSlices, STATE_TRANSITION_TYPE_IMMEDIATE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+                    this->TransitionResourceStates(1, &Barrier);
+                }
+                else if (pTex->IsInKnownState() && !pTex->CheckState(RequiredState))
                 {
                     StateTransitionDesc Barrier{pTex, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE};
                     this->TransitionResourceStates(1, &Barrier);
@@ -1448,6 +1850,7 @@ inline void DeviceContextBase<ImplementationTraits>::NextSubpass()
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "NextSubpass");
     DEV_CHECK_ERR(m_pActiveRenderPass != nullptr, "There is no active render pass");
+    DEV_CHECK_ERR(!m_ConditionalRenderingInsidePass, "Conditional rendering that was begun inside a subpass must be ended before the next subpass starts");
     VERIFY(m_SubpassIndex + 1 < m_pActiveRenderPass->GetDesc().SubpassCount, "The render pass has reached the final subpass already");
     ++m_SubpassIndex;
     UpdateAttachmentStates(m_SubpassIndex);
@@ -1477,12 +1880,12 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateAttachmentStates(Uint
                 continue;
 
             auto* pTex = ClassPtrCast<TextureImplType>(pView->GetTexture());
-            if (pTex->IsInKnownState())
+            if (pTex->IsInKnownState() || pTex->GetSubresourceStates() != nullptr)
             {
                 auto CurrState = SubpassIndex < RPDesc.SubpassCount ?
                     m_pActiveRenderPass->GetAttachmentState(SubpassIndex, i) :
                     RPDesc.pAttachments[i].FinalState;
-                pTex->SetState(CurrState);
+                pTex->SetSubresourceState(pTex->GetSubresourceRange(pView->GetDesc()), CurrState);
             }
         }
     }
@@ -1493,6 +1896,7 @@ inline void DeviceContextBase<ImplementationTraits>::EndRenderPass()
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "EndRenderPass");
     DEV_CHECK_ERR(m_pActiveRenderPass != nullptr, "There is no active render pass");
+    DEV_CHECK_ERR(!m_ConditionalRenderingInsidePass, "Conditional rendering that was begun inside a render pass must be ended before the render pass ends");
     DEV_CHECK_ERR(m_pBoundFramebuffer != nullptr, "There is no active framebuffer");
     VERIFY(m_pActiveRenderPass->GetDesc().SubpassCount == m_SubpassIndex + 1,
            "Ending render pass at subpass ", m_SubpassIndex, " before reaching the final subpass");
@@ -1616,6 +2020,32 @@ inline void DeviceContextBase<ImplementationTraits>::EndQuery(IQuery* pQuery, in
     ClassPtrCast<QueryImplType>(pQuery)->OnEndQuery(static_cast<DeviceContextImplType*>(this));
 }
 
+template <typename ImplementationTraits>
+Uint32 DeviceContextBase<ImplementationTraits>::GetQueryData(Uint32         NumQueries,
+                                                             IQuery* const* ppQueries,
+                                                             void*          pData,
+                                                             Uint32         DataSize,
+                                                             Bool*          pDataAvailable,
+                                                             Bool           AutoInvalidate)
+{
+    DEV_CHECK_ERR(NumQueries == 0 || ppQueries != nullptr, "IDeviceContext::GetQueryData: ppQueries must not be null");
+
+    Uint32 NumAvailable = 0;
+    for (Uint32 i = 0; i < NumQueries; ++i)
+    {
+        DEV_CHECK_ERR(ppQueries[i] != nullptr, "IDeviceContext::GetQueryData: query ", i, " is null");
+
+        void*      pQueryData = pData != nullptr ? static_cast<Uint8*>(pData) + size_t{DataSize} * i : nullptr;
+        const bool Available  = ppQueries[i]->GetData(pQueryData, DataSize, AutoInvalidate);
+        if (pDataAvailable != nullptr)
+            pDataAvailable[i] = Available;
+        if (Available)
+            ++NumAvailable;
+    }
+
+    return NumAvailable;
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::EnqueueSignal(IFence* pFence, Uint64 Value, int)
 {
@@ -1642,14 +2072,13 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateBuffer(
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_TRANSFER, "UpdateBuffer");
     DEV_CHECK_ERR(pBuffer != nullptr, "Buffer must not be null");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "UpdateBuffer command must be used outside of render pass.");
-#ifdef DILIGENT_DEVELOPMENT
+    if (CHECK_COMMAND_ARGUMENTS() && pBuffer != nullptr)
     {
         const auto& BuffDesc = ClassPtrCast<BufferImplType>(pBuffer)->GetDesc();
-        DEV_CHECK_ERR(BuffDesc.Usage == USAGE_DEFAULT || BuffDesc.Usage == USAGE_SPARSE, "Unable to update buffer '", BuffDesc.Name, "': only USAGE_DEFAULT or USAGE_SPARSE buffers can be updated with UpdateData()");
-        DEV_CHECK_ERR(Offset < BuffDesc.Size, "Unable to update buffer '", BuffDesc.Name, "': offset (", Offset, ") exceeds the buffer size (", BuffDesc.Size, ")");
-        DEV_CHECK_ERR(Size + Offset <= BuffDesc.Size, "Unable to update buffer '", BuffDesc.Name, "': Update region [", Offset, ",", Size + Offset, ") is out of buffer bounds [0,", BuffDesc.Size, ")");
+        CHECK_COMMAND_ARGUMENT(BuffDesc.Usage == USAGE_DEFAULT || BuffDesc.Usage == USAGE_SPARSE, "Unable to update buffer '", BuffDesc.Name, "': only USAGE_DEFAULT or USAGE_SPARSE buffers can be updated with UpdateData()");
+        CHECK_COMMAND_ARGUMENT(Offset < BuffDesc.Size, "Unable to update buffer '", BuffDesc.Name, "': offset (", Offset, ") exceeds the buffer size (", BuffDesc.Size, ")");
+        CHECK_COMMAND_ARGUMENT(Size + Offset <= BuffDesc.Size, "Unable to update buffer '", BuffDesc.Name, "': Update region [", Offset, ",", Size + Offset, ") is out of buffer bounds [0,", BuffDesc.Size, ")");
     }
-#endif
 }
 
 template <typename ImplementationTraits>
@@ -1666,14 +2095,13 @@ inline void DeviceContextBase<ImplementationTraits>::CopyBuffer(
     DEV_CHECK_ERR(pSrcBuffer != nullptr, "Source buffer must not be null");
     DEV_CHECK_ERR(pDstBuffer != nullptr, "Destination buffer must not be null");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "CopyBuffer command must be used outside of render pass.");
-#ifdef DILIGENT_DEVELOPMENT
+    if (CHECK_COMMAND_ARGUMENTS() && pSrcBuffer != nullptr && pDstBuffer != nullptr)
     {
         const auto& SrcBufferDesc = ClassPtrCast<BufferImplType>(pSrcBuffer)->GetDesc();
         const auto& DstBufferDesc = ClassPtrCast<BufferImplType>(pDstBuffer)->GetDesc();
-        DEV_CHECK_ERR(DstOffset + Size <= DstBufferDesc.Size, "Failed to copy buffer '", SrcBufferDesc.Name, "' to '", DstBufferDesc.Name, "': Destination range [", DstOffset, ",", DstOffset + Size, ") is out of buffer bounds [0,", DstBufferDesc.Size, ")");
-        DEV_CHECK_ERR(SrcOffset + Size <= SrcBufferDesc.Size, "Failed to copy buffer '", SrcBufferDesc.Name, "' to '", DstBufferDesc.Name, "': Source range [", SrcOffset, ",", SrcOffset + Size, ") is out of buffer bounds [0,", SrcBufferDesc.Size, ")");
+        CHECK_COMMAND_ARGUMENT(DstOffset + Size <= DstBufferDesc.Size, "Failed to copy buffer '", SrcBufferDesc.Name, "' to '", DstBufferDesc.Name, "': Destination range [", DstOffset, ",", DstOffset + Size, ") is out of buffer bounds [0,", DstBufferDesc.Size, ")");
+        CHECK_COMMAND_ARGUMENT(SrcOffset + Size <= SrcBufferDesc.Size, "Failed to copy buffer '", SrcBufferDesc.Name, "' to '", DstBufferDesc.Name, "': Source range [", SrcOffset, ",", SrcOffset + Size, ") is out of buffer bounds [0,", SrcBufferDesc.Size, ")");
     }
-#endif
 }
 
 template <typename ImplementationTraits>
@@ -1848,6 +2276,80 @@ void DeviceContextBase<ImplementationTraits>::BuildBLAS(const BuildBLASAttribs&
     DEV_CHECK_ERR(VerifyBuildBLASAttribs(Attribs, m_pDevice), "BuildBLASAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "BuildBLASBatch");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().RayTracing, "IDeviceContext::BuildBLASBatch: ray tracing is not supported by this device");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BuildBLASBatch command must be performed outside of render pass");
+    DEV_CHECK_ERR(Attribs.BuildCount == 0 || Attribs.pBuilds != nullptr, "IDeviceContext::BuildBLASBatch: BuildCount is ", Attribs.BuildCount, ", but pBuilds is null");
+
+    m_BLASBatchBuilds.assign(Attribs.pBuilds, Attribs.pBuilds + Attribs.BuildCount);
+
+    // Suballocate scratch memory for the builds that do not provide their own scratch buffer.
+    // Every batch starts at the beginning of the buffer, so consecutive batches alias the same memory.
+    const Uint64 ScratchAlignment = std::max(Uint64{m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment}, Uint64{1});
+
+    Uint64 ScratchSize = 0;
+    for (auto& Build : m_BLASBatchBuilds)
+    {
+        if (Build.pScratchBuffer != nullptr || Build.pBLAS == nullptr)
+            continue;
+
+        const auto& Sizes         = Build.pBLAS->GetScratchBufferSizes();
+        Build.ScratchBufferOffset = AlignUp(ScratchSize, ScratchAlignment);
+        ScratchSize               = Build.ScratchBufferOffset + (Build.Update ? Sizes.Update : Sizes.Build);
+    }
+
+    if (ScratchSize > 0)
+    {
+        if (!m_pBLASBatchScratchBuffer || m_pBLASBatchScratchBuffer->GetDesc().Size < ScratchSize)
+        {
+            const Uint64 NumImmediateContexts = m_pDevice->GetNumImmediateContexts();
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name      = "BLAS batch scratch buffer";
+            BuffDesc.Usage     = USAGE_DEFAULT;
+            BuffDesc.BindFlags = BIND_RAY_TRACING;
+            // Grow the buffer geometrically to avoid frequent reallocations
+            BuffDesc.Size                 = std::max(ScratchSize, m_pBLASBatchScratchBuffer ? m_pBLASBatchScratchBuffer->GetDesc().Size * 2 : Uint64{0});
+            BuffDesc.ImmediateContextMask = NumImmediateContexts < 64 ? (Uint64{1} << NumImmediateContexts) - 1 : ~Uint64{0};
+
+            // The old buffer is kept alive by the release queue until the GPU is done with it
+            m_pBLASBatchScratchBuffer.Release();
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pBLASBatchScratchBuffer);
+            if (!m_pBLASBatchScratchBuffer)
+            {
+                LOG_ERROR_MESSAGE("IDeviceContext::BuildBLASBatch: failed to create the scratch buffer of size ", BuffDesc.Size);
+                m_BLASBatchBuilds.clear();
+                return;
+            }
+        }
+
+        for (auto& Build : m_BLASBatchBuilds)
+        {
+            if (Build.pScratchBuffer == nullptr)
+            {
+                Build.pScratchBuffer              = m_pBLASBatchScratchBuffer;
+                Build.ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            }
+        }
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (size_t i = 0; i < m_BLASBatchBuilds.size(); ++i)
+    {
+        const auto& Build = m_BLASBatchBuilds[i];
+        DEV_CHECK_ERR(VerifyBuildBLASAttribs(Build, m_pDevice), "IDeviceContext::BuildBLASBatch: pBuilds[", i, "] is invalid");
+        for (size_t j = 0; j < i; ++j)
+        {
+            DEV_CHECK_ERR(m_BLASBatchBuilds[j].pBLAS != Build.pBLAS, "IDeviceContext::BuildBLASBatch: pBuilds[", j, "] and pBuilds[", i,
+                          "] reference the same BLAS. Every BLAS must only be built once in a batch.");
+        }
+    }
+#endif
+}
+
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::BuildTLAS(const BuildTLASAttribs& Attribs, int) const
 {
@@ -1855,6 +2357,16 @@ void DeviceContextBase<ImplementationTraits>::BuildTLAS(const BuildTLASAttribs&
     DEV_CHECK_ERR(m_pDevice->GetFeatures().RayTracing, "IDeviceContext::BuildTLAS: ray tracing is not supported by this device");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BuildTLAS command must be performed outside of render pass");
     DEV_CHECK_ERR(VerifyBuildTLASAttribs(Attribs, m_pDevice->GetAdapterInfo().RayTracing), "BuildTLASAttribs are invalid");
+
+#ifdef DILIGENT_DEVELOPMENT
+    if (Attribs.pTLAS != nullptr)
+    {
+        auto* pTLASImpl = ClassPtrCast<TopLevelASType>(Attribs.pTLAS);
+        DEV_CHECK_ERR(!Attribs.DirtyInstancesOnly || pTLASImpl->DvpIsSameInstanceBuffer(Attribs.pInstanceBuffer, Attribs.InstanceBufferOffset),
+                      "IDeviceContext::BuildTLAS: DirtyInstancesOnly is true, but pInstanceBuffer and InstanceBufferOffset are not the same as in the previous build");
+        pTLASImpl->DvpSetInstanceBuffer(Attribs.pInstanceBuffer, Attribs.InstanceBufferOffset);
+    }
+#endif
 }
 
 template <typename ImplementationTraits>
@@ -1995,6 +2507,10 @@ void DeviceContextBase<ImplementationTraits>::BeginDebugGroup(const Char* Name,
 #ifdef DILIGENT_DEVELOPMENT
     ++m_DvpDebugGroupCount;
 #endif
+
+    if (m_DebugGroupProfilingEnabled)
+        m_pDebugGroupProfiler->BeginDebugGroup(Name, m_DebugGroupDepth, m_FrameNumber);
+    ++m_DebugGroupDepth;
 }
 
 template <typename ImplementationTraits>
@@ -2004,6 +2520,35 @@ void DeviceContextBase<ImplementationTraits>::EndDebugGroup(int)
     DEV_CHECK_ERR(m_DvpDebugGroupCount > 0, "There is no active debug group to end");
     --m_DvpDebugGroupCount;
 #endif
+
+    if (m_DebugGroupDepth == 0)
+        return;
+    --m_DebugGroupDepth;
+
+    // Groups that were begun before profiling was disabled must still be ended
+    if (m_pDebugGroupProfiler)
+        m_pDebugGroupProfiler->EndDebugGroup(m_DebugGroupDepth);
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::SetDebugGroupProfiling(Bool Enable)
+{
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Debug group profiling is not supported by deferred contexts");
+        return;
+    }
+
+    if (Enable && !m_pDebugGroupProfiler)
+    {
+        m_pDebugGroupProfiler = std::make_unique<DebugGroupProfiler>(
+            m_pDevice.RawPtr(), this,
+            [](IQuery* pQuery) {
+                // The profiler is owned by the context, so its queries must not keep the context alive
+                ClassPtrCast<QueryImplType>(pQuery)->SetContextInternal();
+            });
+    }
+    m_DebugGroupProfilingEnabled = Enable != False;
 }
 
 template <typename ImplementationTraits>
@@ -2056,6 +2601,35 @@ void DeviceContextBase<ImplementationTraits>::BindSparseResourceMemory(const Bin
     DEV_CHECK_ERR(VerifyBindSparseResourceMemoryAttribs(m_pDevice, Attribs), "BindSparseResourceMemoryAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "BeginConditionalRendering");
+
+    DEV_CHECK_ERR(m_pDevice->GetDeviceInfo().Features.ConditionalRendering, "IDeviceContext::BeginConditionalRendering: ConditionalRendering feature must be enabled");
+    DEV_CHECK_ERR(!m_ConditionalRenderingActive, "Conditional rendering is already active. Nested conditional rendering is not allowed.");
+    DEV_CHECK_ERR(!(m_pActiveRenderPass != nullptr && Attribs.TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
+                  "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
+                  "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+    DEV_CHECK_ERR(VerifyBeginConditionalRenderingAttribs(Attribs), "BeginConditionalRenderingAttribs are invalid");
+
+    m_ConditionalRenderingActive     = true;
+    m_ConditionalRenderingInsidePass = m_pActiveRenderPass != nullptr;
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::EndConditionalRendering(int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "EndConditionalRendering");
+
+    DEV_CHECK_ERR(m_ConditionalRenderingActive, "There is no active conditional rendering. This indicates a mismatch between BeginConditionalRendering() / EndConditionalRendering() calls.");
+    DEV_CHECK_ERR(m_ConditionalRenderingInsidePass == (m_pActiveRenderPass != nullptr),
+                  "Conditional rendering must either begin and end inside the same subpass of a render pass, or begin and end outside of a render pass.");
+
+    m_ConditionalRenderingActive     = false;
+    m_ConditionalRenderingInsidePass = false;
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount)
 {
@@ -2380,6 +2954,36 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchTileArgume
                   "' is not a tile pipeline.");
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchGraphArguments(const DispatchGraphAttribs& Attribs) const
+{
+    DEV_CHECK_ERR(m_pPipelineState, "DispatchGraph command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().IsWorkGraphPipeline(),
+                  "DispatchGraph command arguments are invalid: pipeline state '", m_pPipelineState->GetDesc().Name,
+                  "' is not a work graph pipeline.");
+
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "DispatchGraph command must be performed outside of render pass");
+
+    DEV_CHECK_ERR(Attribs.NumRecords == 0 || Attribs.pRecords != nullptr,
+                  "DispatchGraph command arguments are invalid: pRecords must not be null when NumRecords (", Attribs.NumRecords, ") is not zero.");
+
+    DEV_CHECK_ERR(Attribs.pRecords == nullptr || Attribs.RecordStride != 0,
+                  "DispatchGraph command arguments are invalid: RecordStride must not be zero when pRecords is not null.");
+
+    if (Attribs.pBackingMemory != nullptr)
+    {
+        const auto& BuffDesc = Attribs.pBackingMemory->GetDesc();
+        DEV_CHECK_ERR((BuffDesc.BindFlags & BIND_UNORDERED_ACCESS) != 0,
+                      "DispatchGraph command arguments are invalid: backing memory buffer '", BuffDesc.Name,
+                      "' was not created with BIND_UNORDERED_ACCESS flag.");
+        DEV_CHECK_ERR(Attribs.BackingMemoryOffset + Attribs.BackingMemorySize <= BuffDesc.Size,
+                      "DispatchGraph command arguments are invalid: backing memory region [", Attribs.BackingMemoryOffset, ", ",
+                      Attribs.BackingMemoryOffset + Attribs.BackingMemorySize, ") is out of bounds of buffer '", BuffDesc.Name,
+                      "' (", BuffDesc.Size, " bytes).");
+    }
+}
+
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier) const
 {
@@ -2484,8 +3088,119 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifySRBCompatibility(
                       m_pPipelineState->GetDesc().Name, "'.");
     }
 }
+
+#else
+
+template <typename ImplementationTraits>
+bool DeviceContextBase<ImplementationTraits>::VerifyBoundPipeline(PIPELINE_TYPE RequiredType, const char* CmdName) const
+{
+    if (!m_pPipelineState)
+    {
+        LOG_ERROR_MESSAGE(CmdName, " command arguments are invalid: no pipeline state is bound.");
+        return false;
+    }
+
+    const auto& PSODesc = m_pPipelineState->GetDesc();
+    if (PSODesc.PipelineType != RequiredType)
+    {
+        LOG_ERROR_MESSAGE(CmdName, " command arguments are invalid: pipeline state '", PSODesc.Name, "' is not a ",
+                          GetPipelineTypeString(RequiredType), " pipeline.");
+        return false;
+    }
+
+    return true;
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawArguments(const DrawAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "Draw"))
+        VerifyDrawAttribs(Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedArguments(const DrawIndexedAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndexed"))
+        return;
+
+    CHECK_COMMAND_ARGUMENT(m_pIndexBuffer, "DrawIndexed command arguments are invalid: no index buffer is bound.");
+    VerifyDrawIndexedAttribs(Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshArguments(const DrawMeshAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_MESH, "DrawMesh"))
+        VerifyDrawMeshAttribs(m_pDevice->GetAdapterInfo().MeshShader.MaxTaskCount, Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndirectArguments(const DrawIndirectAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndirect"))
+        VerifyDrawIndirectAttribs(Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedIndirectArguments(const DrawIndexedIndirectAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (!VerifyBoundPipeline(PIPELINE_TYPE_GRAPHICS, "DrawIndexedIndirect"))
+        return;
+
+    CHECK_COMMAND_ARGUMENT(m_pIndexBuffer, "DrawIndexedIndirect command arguments are invalid: no index buffer is bound.");
+    VerifyDrawIndexedIndirectAttribs(Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshIndirectArguments(const DrawMeshIndirectAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_MESH, "DrawMeshIndirect"))
+        VerifyDrawMeshIndirectAttribs(Attribs, DrawMeshIndirectCommandStride);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchArguments(const DispatchComputeAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_COMPUTE, "DispatchCompute"))
+        VerifyDispatchComputeAttribs(Attribs);
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchIndirectArguments(const DispatchComputeIndirectAttribs& Attribs) const
+{
+    if (!m_CommandValidationEnabled)
+        return;
+
+    if (VerifyBoundPipeline(PIPELINE_TYPE_COMPUTE, "DispatchComputeIndirect"))
+        VerifyDispatchComputeIndirectAttribs(Attribs);
+}
+
 #endif // DILIGENT_DEVELOPMENT
 
 #undef DVP_CHECK_QUEUE_TYPE_COMPATIBILITY
+#undef CHECK_COMMAND_ARGUMENTS
+#undef CHECK_COMMAND_ARGUMENT
 
 } // namespace Diligent
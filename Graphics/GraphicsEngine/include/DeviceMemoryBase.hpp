@@ -33,6 +33,7 @@
 #include "GraphicsTypes.h"
 #include "DeviceObjectBase.hpp"
 #include "GraphicsAccessories.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -83,6 +84,21 @@ public:
         DEV_CHECK_ERR((NewSize % this->m_Desc.PageSize) == 0,
                       "NewSize (", NewSize, ") must be  a multiple of the page size (", this->m_Desc.PageSize, ")");
     }
+
+protected:
+    /// Updates the device memory record in the GPU memory tracker after the memory has been resized.
+    void RecordGPUMemory(Uint64 Capacity)
+    {
+        m_GPUMemoryRecord.Reset();
+        if (Capacity > 0)
+        {
+            m_GPUMemoryRecord = GPUMemoryRecord{this->GetDevice()->GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_DEVICE_MEMORY, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                                this->m_Desc.Name, Capacity, Capacity};
+        }
+    }
+
+private:
+    GPUMemoryRecord m_GPUMemoryRecord;
 };
 
 } // namespace Diligent
@@ -32,6 +32,7 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include "GraphicsTypes.h"
 #include "FileStream.h"
@@ -44,13 +45,19 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header |  Resource Data  |  Device Section Table  |  Device Sections  |
 //
-//     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
+//     |  Resource Data  | = | NumResources | Res1 | Res2 | ... | ResN |
 //
-//         | ResI | = | Type | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
+//         | ResI | = | Type | Name | Common Data |
 //
-//     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
+//     |  Device Section Table  | = | OpenGL {Offset, Size} | D3D11 {Offset, Size} | ...  | Metal-iOS {Offset, Size} | Shader Compression |
+//
+//     |  Device Sections  | = |  OpenGL section | D3D11 section | ...  | Metal-iOS section |
+//
+//         | Device Section | = | Res1 device data | Res2 device data | ... | ResN device data | NumShaders | Shader1 | ... | Pipeline Cache Data |
+//
+//             | ShaderI | = | Decompressed Size | Data |
 //
 // The header contains general information such as:
 // - Magic number
@@ -61,20 +68,43 @@
 // - Type (Signature, Graphics Pipeline, Render Pass, etc.)
 // - Name
 // - Common data (e.g. a resource description)
-// - Device-specific data (e.g. shader indices)
 //
-// Shader data contains an array of shaders for each device type
+// The device section table contains the offset of each device section from the start
+// of the archive and its size. Sections are aligned by DeviceSectionAlignment bytes.
+// A device type that has no data in the archive has zero offset and size.
+//
+// Every device section contains the device-specific data (e.g. shader indices) of
+// all resources in the same order as in the resource data, followed by the device shaders.
+// This allows the loader to only read the section of the device it runs on.
+//
+// Shader data may be compressed as indicated by the shader compression method in the section table.
+// Every shader is compressed individually and is decompressed on first access.
+// Zero decompressed size indicates that the shader data is stored uncompressed.
+//
+// Vulkan shader data may be followed by the serialized shader reflection
+// (see SPIRVShaderResources::SerializeReflection) that allows creating the shader
+// without parsing the SPIR-V.
+//
+// Every device section ends with the optional pipeline state cache data (e.g. the Metal binary
+// archive or the Vulkan pipeline cache) that was added with IArchiver::SetPipelineStateCacheData.
+// The data is opaque to the archive and is not compressed. The data is only written when it is
+// not empty, so the section ends after the last shader if there is no pipeline state cache data.
 //
 //
 // For pipelines, device-specific data is the array of shader indices in the
-// archive's shader array, e.g.:
+// device shader array, e.g.:
+//
+// | OpenGL section | = | PsoX OpenGL data | ... | GL Shader 0 | GL Shader 1 |  ...
+//                           {0, 1}
 //
-// | PsoX | = |   Type   |   Name   |   Common Data   |   OpenGL data   |    D3D11 data   | ...
-//              Graphics   "My PSO"    <Description>        {0, 1}             {1, 2}
-//                                                                  ____________|  |
-//                                                                 |               |
-//                                                                 V               V
-// | GL Shader 0 | GL Shader 1 |  ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
+// | D3D11 section  | = | PsoX D3D11 data  | ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
+//                           {1, 2}
+//
+// Archive version 4 stored the device-specific data of every resource next to its common data,
+// followed by the shaders of all devices. Version 5 did not support shader compression.
+// Version 6 did not store the shader reflection. Version 7 did not store the pipeline state cache data.
+// Such archives can still be loaded, and are upgraded to the current version
+// when serialized again (e.g. with IArchiverFactory::MergeArchives).
 
 namespace Diligent
 {
@@ -127,7 +157,20 @@ public:
     };
 
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 4;
+    static constexpr Uint32 ArchiveVersion    = 8;
+
+    // The oldest archive version that can still be loaded
+    static constexpr Uint32 MinSupportedArchiveVersion = 4;
+
+    static constexpr size_t DeviceSectionAlignment = 8;
+
+    // Shader data compression method.
+    enum class ShaderCompression : Uint32
+    {
+        None = 0,
+        LZ,
+        Count
+    };
 
     struct ArchiveHeader
     {
@@ -216,6 +259,19 @@ public:
 
     std::string ToString() const;
 
+    // Sets the method that is used to compress the shader data when the archive is serialized.
+    void SetShaderCompression(ShaderCompression Compression)
+    {
+        VERIFY_EXPR(Compression < ShaderCompression::Count);
+        m_ShaderCompression = Compression;
+    }
+
+    // For archives loaded from data, returns the compression method of the source archive.
+    ShaderCompression GetShaderCompression() const
+    {
+        return m_ShaderCompression;
+    }
+
     template <typename ReourceDataType>
     bool LoadResourceCommonData(ResourceType     Type,
                                 const char*      Name,
@@ -238,42 +294,69 @@ public:
         return Res;
     }
 
+    // Device-specific data is loaded from the archive on first access for every device type.
     const SerializedData& GetDeviceSpecificData(ResourceType Type,
                                                 const char*  Name,
                                                 DeviceType   DevType) const noexcept;
 
-    ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept
-    {
-        constexpr auto MakeCopy = true;
-        return m_NamedResources[NamedResourceKey{Type, Name, MakeCopy}];
-    }
+    ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept;
 
-    auto& GetDeviceShaders(DeviceType Type) noexcept
-    {
-        return m_DeviceShaders[static_cast<size_t>(Type)];
-    }
+    std::vector<SerializedData>& GetDeviceShaders(DeviceType Type) noexcept;
 
-    const auto& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
-    {
-        const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
-        if (Idx < DeviceShaders.size())
-            return DeviceShaders[Idx];
+    const SerializedData& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept;
 
-        static const SerializedData NullData;
-        return NullData;
-    }
+    // Returns the pipeline state cache data of the given device type.
+    const SerializedData& GetPipelineCacheData(DeviceType Type) const noexcept;
+
+    // Replaces the pipeline state cache data of the given device type.
+    // The archive takes ownership of the data if it is owning.
+    void SetPipelineCacheData(DeviceType Type, SerializedData&& Data) noexcept;
 
+    // Note that the device-specific data of the returned resources may not be loaded yet.
+    // Use GetDeviceSpecificData() to access it.
     const auto& GetNamedResources() const
     {
         return m_NamedResources;
     }
 
+private:
+    void LoadDeviceData(DeviceType Dev) const noexcept(false);
+    void LoadAllDeviceData() const noexcept(false);
+    void DecompressShader(size_t DevIdx, size_t ShaderIdx) const noexcept(false);
+    void DecompressShaders(DeviceType Dev) const noexcept(false);
+
 private:
     // Named resources
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
 
     // Shaders
-    std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+    mutable std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+
+    // Device sections of the source archive that are parsed on first access.
+    std::array<SerializedData, static_cast<size_t>(DeviceType::Count)> m_DeviceSections;
+
+    // Resources in the order they are stored in the source archive, which
+    // is also the order of their data in every device section.
+    std::vector<ResourceData*> m_ArchiveResources;
+
+    mutable std::array<std::once_flag, static_cast<size_t>(DeviceType::Count)> m_DeviceDataLoadFlags;
+
+    // Compressed shaders of the source archive that are decompressed into m_DeviceShaders on first access.
+    struct CompressedShaderData
+    {
+        SerializedData Data;
+        Uint32         DecompressedSize = 0;
+        std::once_flag DecompressFlag;
+    };
+    mutable std::array<std::vector<CompressedShaderData>, static_cast<size_t>(DeviceType::Count)> m_CompressedShaders;
+
+    // Opaque pipeline state cache data of every device type
+    mutable std::array<SerializedData, static_cast<size_t>(DeviceType::Count)> m_PipelineCacheData;
+
+    ShaderCompression m_ShaderCompression = ShaderCompression::None;
+
+    // Version of the source archive
+    Uint32 m_SourceVersion = ArchiveVersion;
 
     // Strong reference to the original data blob.
     // Resources will not make copies and reference this data.
@@ -39,6 +39,8 @@
 #include "EngineMemory.h"
 #include "RefCntAutoPtr.hpp"
 
+#include <chrono>
+
 namespace Diligent
 {
 
@@ -47,6 +49,30 @@ const APIInfo& GetAPIInfo();
 /// Validates engine create info EngineCI and throws an exception in case of an error.
 void VerifyEngineCreateInfo(const EngineCreateInfo& EngineCI, const GraphicsAdapterInfo& AdapterInfo) noexcept(false);
 
+/// Measures the phases of the device initialization, see Diligent::DeviceStartupStatistics.
+class DeviceStartupTimer
+{
+public:
+    /// Returns the time, in nanoseconds, elapsed since the previous call or since the timer was created.
+    Uint64 Lap()
+    {
+        const auto Now     = std::chrono::steady_clock::now();
+        const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Now - m_LapStart).count();
+        m_LapStart         = Now;
+        return static_cast<Uint64>(Elapsed);
+    }
+
+    /// Returns the time, in nanoseconds, elapsed since the timer was created.
+    Uint64 Total() const
+    {
+        return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count());
+    }
+
+private:
+    const std::chrono::steady_clock::time_point m_Start    = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point       m_LapStart = m_Start;
+};
+
 /// Template class implementing base functionality of the engine factory
 
 /// \tparam BaseInterface - Base interface that this class will inherit
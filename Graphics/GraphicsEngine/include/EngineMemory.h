@@ -34,13 +34,21 @@
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
+class TrackingMemoryAllocator;
+
 /// Sets raw memory allocator. This function must be called before any memory allocation/deallocation function
 /// is called.
-void SetRawAllocator(IMemoryAllocator* pRawAllocator);
+
+/// If EnableTracking is true, the allocator is wrapped into Diligent::TrackingMemoryAllocator.
+/// The tracking mode is defined by the first call and can't be changed afterwards.
+void SetRawAllocator(IMemoryAllocator* pRawAllocator, bool EnableTracking = false);
 
 /// Returns raw memory allocator
 IMemoryAllocator& GetRawAllocator();
 
+/// Returns the tracking raw memory allocator, or null if memory tracking is disabled.
+TrackingMemoryAllocator* GetTrackingRawAllocator();
+
 IMemoryAllocator& GetStringAllocator();
 
 #define ALLOCATE_RAW(Allocator, Desc, Size)    (Allocator).Allocate(Size, Desc, __FILE__, __LINE__)
@@ -33,6 +33,7 @@
 #include <atomic>
 
 #include "DeviceObjectBase.hpp"
+#include "FenceCompletionWaiter.hpp"
 #include "GraphicsTypes.h"
 #include "RefCntAutoPtr.hpp"
 
@@ -69,6 +70,13 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Fence, TDeviceObjectBase)
 
+    /// Implementation of IFence::EnqueueCompletionCallback().
+    virtual void DILIGENT_CALL_TYPE EnqueueCompletionCallback(Uint64                      Value,
+                                                              FenceCompletionCallbackType Callback,
+                                                              void*                       pUserData) override final
+    {
+        this->GetDevice()->GetFenceCompletionWaiter().EnqueueCallback(this, Value, Callback, pUserData);
+    }
 
     // Validate IFence::Signal() and IDeviceContext::EnqueueSignal()
     void DvpSignal(Uint64 NewValue)
@@ -102,6 +110,13 @@ public:
     }
 
 protected:
+    // Discards pending completion callbacks. Must be called at the beginning of the destructor
+    // of the derived class, while GetCompletedValue() can still be safely called by the waiter.
+    void UnregisterCompletionCallbacks()
+    {
+        this->GetDevice()->GetFenceCompletionWaiter().UnregisterFence(this);
+    }
+
     void UpdateLastCompletedFenceValue(Uint64 NewValue)
     {
         auto LastCompletedValue = m_LastCompletedFenceValue.load();
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FenceCompletionWaiter class
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/Fence.h"
+
+namespace Diligent
+{
+
+/// Device-wide object that services the callbacks enqueued by IFence::EnqueueCompletionCallback().
+///
+/// In polled mode, the engine calls ProcessCompletedFences() periodically (e.g. from the immediate
+/// context's FinishFrame()). In threaded mode, a waiter thread is started when the first callback is
+/// enqueued. The thread blocks in WaitForAnyFence() until any of the fences with pending callbacks
+/// reaches its value, and then invokes the callbacks. Backends override WaitForAnyFence() and WakeUp()
+/// to block on native synchronization objects; the default implementation polls the fences.
+///
+/// The waiter does not keep references to the fences. A fence must call UnregisterFence() at the
+/// very beginning of its destructor, which blocks until the waiter stops using the fence.
+class FenceCompletionWaiter
+{
+public:
+    explicit FenceCompletionWaiter(bool UseThread) noexcept;
+    virtual ~FenceCompletionWaiter();
+
+    // clang-format off
+    FenceCompletionWaiter           (const FenceCompletionWaiter&)  = delete;
+    FenceCompletionWaiter& operator=(const FenceCompletionWaiter&)  = delete;
+    FenceCompletionWaiter           (      FenceCompletionWaiter&&) = delete;
+    FenceCompletionWaiter& operator=(      FenceCompletionWaiter&&) = delete;
+    // clang-format on
+
+    /// Implementation of IFence::EnqueueCompletionCallback().
+    void EnqueueCallback(IFence* pFence, Uint64 Value, FenceCompletionCallbackType Callback, void* pUserData);
+
+    /// Discards the pending callbacks of the fence and waits until the waiter stops using it.
+    void UnregisterFence(IFence* pFence);
+
+    /// Invokes the callbacks whose fence values have been reached.
+    void ProcessCompletedFences();
+
+    /// Stops the waiter thread. Derived classes must call this method from their destructors
+    /// before the native objects used by WaitForAnyFence() are released.
+    void StopThread();
+
+    size_t GetNumPendingCallbacks() const;
+
+protected:
+    struct WaitItem
+    {
+        IFence* const pFence;
+
+        /// The smallest value of the pending callbacks.
+        const Uint64 Value;
+
+        /// Backend-specific value that is preserved between waits until the fence is unregistered
+        /// (e.g. the value for which ID3D12Fence::SetEventOnCompletion() was last called).
+        /// The initial value is ~0ull.
+        Uint64 ArmedValue;
+    };
+
+    /// Blocks until any of the fences reaches its value, or WakeUp() is called with a counter
+    /// value greater than WakeCounter. Spurious returns are allowed.
+    /// The fences are guaranteed to stay alive until the method returns.
+    virtual void WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter);
+
+    /// Interrupts WaitForAnyFence(). The method is called while the internal mutex is locked.
+    virtual void WakeUp(Uint64 WakeCounter);
+
+private:
+    void ThreadFunc();
+
+    struct CallbackInfo
+    {
+        FenceCompletionCallbackType Callback;
+        void*                       pUserData;
+    };
+
+    struct FenceEntry
+    {
+        std::multimap<Uint64, CallbackInfo> Callbacks;
+
+        Uint64 ArmedValue = ~Uint64{0};
+    };
+
+    const bool m_UseThread;
+
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<IFence*, FenceEntry> m_Fences;
+
+    // Signaled when a fence is registered or the thread is stopped.
+    std::condition_variable m_ThreadCV;
+
+    // Signaled when m_BusyCount drops to zero.
+    std::condition_variable m_IdleCV;
+
+    // Used by the default implementation of WaitForAnyFence().
+    std::condition_variable m_WakeCV;
+
+    // The number of threads that access the registered fences outside of the mutex.
+    Uint32 m_BusyCount = 0;
+
+    Uint64 m_WakeCounter = 0;
+
+    std::thread m_Thread;
+    bool        m_StopThread = false;
+};
+
+} // namespace Diligent
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUBreadcrumbs class
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// CPU-side history of the commands recorded by a device context that is used to
+/// find the command that was executing when the device was lost.
+///
+/// Every recorded command gets a marker value. The backend writes this value to
+/// a small host-visible buffer when the command starts (top of the pipe) and when
+/// it completes (bottom of the pipe). When the device is lost, the two values read
+/// back from the buffer are passed to GetReport().
+class GPUBreadcrumbs
+{
+public:
+    static constexpr Uint32 DefaultCapacity = 4096;
+
+    /// Capacity is the number of the most recent commands that are kept in the history.
+    /// It must be a power of two.
+    explicit GPUBreadcrumbs(Uint32 Capacity = DefaultCapacity);
+
+    // clang-format off
+    GPUBreadcrumbs           (const GPUBreadcrumbs&)  = delete;
+    GPUBreadcrumbs& operator=(const GPUBreadcrumbs&)  = delete;
+    GPUBreadcrumbs           (      GPUBreadcrumbs&&) = delete;
+    GPUBreadcrumbs& operator=(      GPUBreadcrumbs&&) = delete;
+    // clang-format on
+
+    /// Records a command in the current debug group and returns its marker value.
+    /// The name is not copied and must be a string literal.
+    Uint32 AddCommand(const char* Name)
+    {
+        // 0 is reserved for "nothing executed yet"
+        m_LastMarker = m_LastMarker != ~Uint32{0} ? m_LastMarker + 1 : 1;
+
+        Record& Rec = m_Records[m_LastMarker & (m_Capacity - 1)];
+        Rec.Marker  = m_LastMarker;
+        Rec.Group   = m_GroupStack.back();
+        Rec.Name    = Name;
+        return m_LastMarker;
+    }
+
+    /// Begins a debug group and returns the marker value of the group begin command.
+    Uint32 BeginDebugGroup(const char* Name);
+
+    /// Ends the current debug group and returns the marker value of the group end command.
+    Uint32 EndDebugGroup();
+
+    /// Returns the marker value of the last recorded command, or 0 if no commands have been recorded.
+    Uint32 GetLastMarker() const { return m_LastMarker; }
+
+    /// Returns a human-readable list of the commands around the last started and
+    /// the last completed commands, with their debug group paths.
+    std::string GetReport(Uint32 LastStartedMarker, Uint32 LastCompletedMarker) const;
+
+private:
+    struct Record
+    {
+        Uint32      Marker = 0;
+        Uint32      Group  = 0;
+        const char* Name   = nullptr;
+    };
+
+    const Uint32 m_Capacity;
+
+    Uint32 m_LastMarker = 0;
+
+    std::vector<Record> m_Records;
+
+    // Full paths of the debug groups, e.g. "Frame/Shadows". Index 0 is the root.
+    std::vector<std::string>                m_GroupPaths;
+    std::unordered_map<std::string, Uint32> m_GroupIds;
+
+    // Indices of the open debug groups. The first element is always the root.
+    std::vector<Uint32> m_GroupStack;
+};
+
+} // namespace Diligent
@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUMemoryTracker and Diligent::GPUMemoryRecord classes
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent
+{
+
+/// Device-wide registry of GPU memory allocations made by the engine.
+///
+/// Backends register every GPU memory allocation with its category, type, owner name, requested size
+/// and allocated size (which includes padding and alignment). The tracker maintains the statistics of
+/// every category and type, and implements IRenderDevice::GetGPUMemoryStatistics(),
+/// IRenderDevice::GetGPUMemoryAllocations() and IRenderDevice::GetGPUMemoryReport().
+///
+/// Allocations are normally registered through GPUMemoryRecord objects that unregister
+/// the allocation when they are destroyed.
+///
+/// All methods are thread-safe.
+class GPUMemoryTracker
+{
+public:
+    GPUMemoryTracker() noexcept;
+
+    // clang-format off
+    GPUMemoryTracker           (const GPUMemoryTracker&)  = delete;
+    GPUMemoryTracker& operator=(const GPUMemoryTracker&)  = delete;
+    GPUMemoryTracker           (      GPUMemoryTracker&&) = delete;
+    GPUMemoryTracker& operator=(      GPUMemoryTracker&&) = delete;
+    // clang-format on
+
+    using AllocationId = Uint64;
+
+    /// Zero is never used as a valid allocation identifier.
+    static constexpr AllocationId InvalidAllocationId = 0;
+
+    /// Registers the allocation and returns its identifier.
+    AllocationId AddAllocation(GPU_MEMORY_CATEGORY        Category,
+                               GPU_MEMORY_ALLOCATION_TYPE Type,
+                               const char*                Name,
+                               Uint64                     Size,
+                               Uint64                     AllocatedSize);
+
+    /// Unregisters the allocation.
+    void RemoveAllocation(AllocationId Id);
+
+    /// Implementation of IRenderDevice::GetGPUMemoryStatistics().
+    void GetStatistics(GPUMemoryStatistics& Stats) const;
+
+    /// Implementation of IRenderDevice::GetGPUMemoryAllocations().
+    Uint32 GetAllocations(GPUMemoryAllocationInfo* pAllocations, Uint32 MaxAllocations) const;
+
+    /// Returns the text of the GPU memory report, see IRenderDevice::GetGPUMemoryReport().
+    std::string GetReport() const;
+
+private:
+    struct Allocation
+    {
+        GPU_MEMORY_CATEGORY        Category;
+        GPU_MEMORY_ALLOCATION_TYPE Type;
+        std::string                Name;
+        Uint64                     Size;
+        Uint64                     AllocatedSize;
+    };
+
+    static void AddUsage(GPUMemoryUsage& Usage, const Allocation& Alloc);
+    static void RemoveUsage(GPUMemoryUsage& Usage, const Allocation& Alloc);
+
+private:
+    mutable std::mutex m_Mtx;
+
+    AllocationId                                 m_NextId = 1;
+    std::unordered_map<AllocationId, Allocation> m_Allocations;
+    GPUMemoryStatistics                          m_Stats;
+};
+
+
+/// Registers a GPU memory allocation in the tracker and unregisters it when destroyed.
+///
+/// A default-constructed record, as well as a record created with null tracker (i.e. when
+/// GPU memory tracking is disabled), does nothing.
+class GPUMemoryRecord
+{
+public:
+    GPUMemoryRecord() noexcept {}
+
+    GPUMemoryRecord(GPUMemoryTracker*          pTracker,
+                    GPU_MEMORY_CATEGORY        Category,
+                    GPU_MEMORY_ALLOCATION_TYPE Type,
+                    const char*                Name,
+                    Uint64                     Size,
+                    Uint64                     AllocatedSize) :
+        m_pTracker{pTracker},
+        m_Id{pTracker != nullptr ? pTracker->AddAllocation(Category, Type, Name, Size, AllocatedSize) : GPUMemoryTracker::InvalidAllocationId}
+    {
+    }
+
+    GPUMemoryRecord(GPUMemoryRecord&& rhs) noexcept :
+        m_pTracker{rhs.m_pTracker},
+        m_Id{rhs.m_Id}
+    {
+        rhs.m_pTracker = nullptr;
+        rhs.m_Id       = GPUMemoryTracker::InvalidAllocationId;
+    }
+
+    GPUMemoryRecord& operator=(GPUMemoryRecord&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Reset();
+            m_pTracker     = rhs.m_pTracker;
+            m_Id           = rhs.m_Id;
+            rhs.m_pTracker = nullptr;
+            rhs.m_Id       = GPUMemoryTracker::InvalidAllocationId;
+        }
+        return *this;
+    }
+
+    // clang-format off
+    GPUMemoryRecord           (const GPUMemoryRecord&) = delete;
+    GPUMemoryRecord& operator=(const GPUMemoryRecord&) = delete;
+    // clang-format on
+
+    ~GPUMemoryRecord()
+    {
+        Reset();
+    }
+
+    /// Unregisters the allocation.
+    void Reset()
+    {
+        if (m_pTracker != nullptr && m_Id != GPUMemoryTracker::InvalidAllocationId)
+            m_pTracker->RemoveAllocation(m_Id);
+        m_pTracker = nullptr;
+        m_Id       = GPUMemoryTracker::InvalidAllocationId;
+    }
+
+    bool IsValid() const
+    {
+        return m_Id != GPUMemoryTracker::InvalidAllocationId;
+    }
+
+private:
+    GPUMemoryTracker*              m_pTracker = nullptr;
+    GPUMemoryTracker::AllocationId m_Id       = GPUMemoryTracker::InvalidAllocationId;
+};
+
+} // namespace Diligent
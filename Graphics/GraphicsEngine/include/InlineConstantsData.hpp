@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::InlineConstantsData class
+
+#include <vector>
+#include <cstring>
+
+#include "Object.h"
+#include "ObjectBase.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+// {ED5A9052-4189-4477-A55F-94DF857F4282}
+static const INTERFACE_ID IID_InlineConstantsData =
+    {0xed5a9052, 0x4189, 0x4477, {0xa5, 0x5f, 0x94, 0xdf, 0x85, 0x7f, 0x42, 0x82}};
+
+/// CPU-side copy of inline constants.
+
+/// Inline constants are emulated with a dynamic uniform buffer that is created by the SRB.
+/// The object is attached to the buffer as user data and keeps the values of all constants,
+/// so that a partial update can rewrite the whole buffer after it is mapped with MAP_FLAG_DISCARD.
+class InlineConstantsData final : public ObjectBase<IObject>
+{
+public:
+    using TBase = ObjectBase<IObject>;
+
+    InlineConstantsData(IReferenceCounters* pRefCounters, Uint32 NumConstants) :
+        TBase{pRefCounters},
+        m_Constants(NumConstants)
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_InlineConstantsData, TBase)
+
+    Uint32 GetNumConstants() const { return static_cast<Uint32>(m_Constants.size()); }
+
+    const Uint32* GetData() const { return m_Constants.data(); }
+
+    size_t GetDataSize() const { return m_Constants.size() * sizeof(Uint32); }
+
+    void Update(const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+    {
+        VERIFY_EXPR(FirstConstant + NumConstants <= m_Constants.size());
+        std::memcpy(&m_Constants[FirstConstant], pConstants, NumConstants * sizeof(Uint32));
+    }
+
+private:
+    std::vector<Uint32> m_Constants;
+};
+
+} // namespace Diligent
@@ -84,6 +84,11 @@ struct PSOSerializer
     static bool SerializeAuxData(Serializer<Mode>&                Ser,
                                  ConstQual<SerializedPSOAuxData>& AuxData,
                                  DynamicLinearAllocator*          Allocator);
+
+    // Dynamic state flags are written after the auxiliary data and only when they are not NONE,
+    // so that the common data of archives created before the flags were added can still be read.
+    static bool SerializeDynamicStateFlags(Serializer<Mode>&                        Ser,
+                                           ConstQual<PIPELINE_DYNAMIC_STATE_FLAGS>& DynamicStateFlags);
 };
 
 template <SerializerMode Mode>
@@ -121,6 +126,11 @@ struct ShaderSerializer
     static bool SerializeCI(Serializer<Mode>&            Ser,
                             ConstQual<ShaderCreateInfo>& CI);
 
+    // Serializes the optional device-specific shader reflection data that follows the create info.
+    // Empty reflection is not written, so that shaders without it keep the original layout.
+    static bool SerializeReflection(Serializer<Mode>&          Ser,
+                                    ConstQual<SerializedData>& Reflection);
+
 private:
     static bool SerializeBytecodeOrSource(Serializer<Mode>&            Ser,
                                           ConstQual<ShaderCreateInfo>& CI);
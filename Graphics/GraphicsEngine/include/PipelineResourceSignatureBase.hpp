@@ -489,6 +489,8 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding,
                                                                 bool                     InitStaticResources) override final
     {
+        MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_SHADER_RESOURCE_BINDING};
+
         auto* pThisImpl{static_cast<PipelineResourceSignatureImplType*>(this)};
         auto& SRBAllocator{pThisImpl->GetDevice()->GetSRBAllocator()};
         auto* pResBindingImpl{NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingImplType)(pThisImpl)};
@@ -497,6 +499,49 @@ public:
         pResBindingImpl->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
     }
 
+    /// Implementation of IPipelineResourceSignature::CreateShaderResourceBindings.
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32                   NumSRBs,
+                                                                 IShaderResourceBinding** ppShaderResourceBindings,
+                                                                 bool                     InitStaticResources) override final
+    {
+        DEV_CHECK_ERR(NumSRBs == 0 || ppShaderResourceBindings != nullptr, "ppShaderResourceBindings must not be null");
+
+        MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_SHADER_RESOURCE_BINDING};
+
+        auto* pThisImpl{static_cast<PipelineResourceSignatureImplType*>(this)};
+        auto& SRBAllocator{pThisImpl->GetDevice()->GetSRBAllocator()};
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+        {
+            DEV_CHECK_ERR(ppShaderResourceBindings[i] == nullptr, "Overwriting reference to existing SRB ", i, " may cause memory leaks");
+            auto* pResBindingImpl{NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingImplType)(pThisImpl)};
+            if (InitStaticResources)
+                pThisImpl->InitializeStaticSRBResources(pResBindingImpl);
+            pResBindingImpl->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(&ppShaderResourceBindings[i]));
+        }
+    }
+
+    /// Implementation of IPipelineResourceSignature::CloneShaderResourceBinding.
+    virtual void DILIGENT_CALL_TYPE CloneShaderResourceBinding(IShaderResourceBinding*  pSrcSRB,
+                                                               IShaderResourceBinding** ppShaderResourceBinding) override final
+    {
+        DEV_CHECK_ERR(pSrcSRB != nullptr, "Source SRB must not be null");
+        DEV_CHECK_ERR(ppShaderResourceBinding != nullptr && *ppShaderResourceBinding == nullptr, "ppShaderResourceBinding must not be null and must point to null");
+        if (pSrcSRB == nullptr || ppShaderResourceBinding == nullptr)
+            return;
+
+        if (pSrcSRB->GetPipelineResourceSignature() != this)
+        {
+            LOG_ERROR_MESSAGE("Unable to clone shader resource binding: the SRB was not created by signature '", this->m_Desc.Name, "'.");
+            return;
+        }
+
+        const auto* pSrcSRBImpl = ClassPtrCast<const ShaderResourceBindingImplType>(pSrcSRB);
+
+        CreateShaderResourceBinding(ppShaderResourceBinding, pSrcSRBImpl->StaticResourcesInitialized());
+        if (*ppShaderResourceBinding != nullptr)
+            ClassPtrCast<ShaderResourceBindingImplType>(*ppShaderResourceBinding)->CopyResources(*pSrcSRBImpl);
+    }
+
     /// Implementation of IPipelineResourceSignature::InitializeStaticSRBResources.
     virtual void DILIGENT_CALL_TYPE InitializeStaticSRBResources(IShaderResourceBinding* pSRB) const override final
     {
@@ -654,6 +699,18 @@ public:
         return this->m_Desc.Resources[ResIndex];
     }
 
+    struct InlineConstantsInfo
+    {
+        // Resource index in m_Desc.Resources[]
+        Uint32 ResIndex = 0;
+
+        // The number of 32-bit constants
+        Uint32 NumConstants = 0;
+    };
+
+    // Returns the resources that use PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag.
+    const std::vector<InlineConstantsInfo>& GetInlineConstants() const { return m_InlineConstants; }
+
     const ImmutableSamplerDesc& GetImmutableSamplerDesc(Uint32 SampIndex) const
     {
         VERIFY_EXPR(SampIndex < this->m_Desc.NumImmutableSamplers);
@@ -757,6 +814,18 @@ protected:
 
         CopyPipelineResourceSignatureDesc(Allocator, Desc, this->m_Desc, m_ResourceOffsets);
 
+        // Inline constants are bound as a single constant buffer. Store the number of constants
+        // separately so that backends see the resource as a regular non-array constant buffer.
+        for (Uint32 r = 0; r < this->m_Desc.NumResources; ++r)
+        {
+            auto& ResDesc = const_cast<PipelineResourceDesc&>(this->m_Desc.Resources[r]);
+            if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+            {
+                m_InlineConstants.push_back({r, ResDesc.ArraySize});
+                ResDesc.ArraySize = 1;
+            }
+        }
+
 #ifdef DILIGENT_DEBUG
         VERIFY_EXPR(m_ResourceOffsets[SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES] == this->m_Desc.NumResources);
         for (Uint32 VarType = 0; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; ++VarType)
@@ -816,7 +885,9 @@ protected:
             }
 
             const size_t CacheMemorySize = GetRequiredResourceCacheMemorySize();
-            m_SRBMemAllocator.Initialize(Desc.SRBAllocationGranularity, GetNumActiveShaderStages(), ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
+            // Thread caches let worker threads create SRBs without contending for the allocator mutex
+            const Uint32 ThreadCacheSize = std::min(Desc.SRBAllocationGranularity, Uint32{SRBDataThreadCacheSize});
+            m_SRBMemAllocator.Initialize(Desc.SRBAllocationGranularity, GetNumActiveShaderStages(), ShaderVariableDataSizes.data(), 1, &CacheMemorySize, ThreadCacheSize);
         }
 
         pThisImpl->CalculateHash();
@@ -996,6 +1067,9 @@ protected:
     // Resource offsets (e.g. index of the first resource), for each variable type.
     std::array<Uint16, SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES + 1> m_ResourceOffsets = {};
 
+    // Resources that use PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag
+    std::vector<InlineConstantsInfo> m_InlineConstants;
+
     // Shader stages that have resources.
     SHADER_TYPE m_ShaderStages = SHADER_TYPE_UNKNOWN;
 
@@ -1012,6 +1086,9 @@ protected:
     // Allocator for shader resource binding object instances.
     SRBMemoryAllocator m_SRBMemAllocator;
 
+    // Maximum number of SRB data blocks in every thread-local magazine of m_SRBMemAllocator.
+    static constexpr Uint32 SRBDataThreadCacheSize = 16;
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
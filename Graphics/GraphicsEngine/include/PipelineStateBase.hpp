@@ -35,6 +35,9 @@
 #include <unordered_set>
 #include <cstring>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <type_traits>
 
 #include "PrivateConstants.h"
 #include "PipelineState.h"
@@ -45,6 +48,8 @@
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
 #include "PipelineResourceSignatureBase.hpp"
+#include "ThreadPool.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -98,6 +103,64 @@ template <>
 void ValidatePSOCreateInfo<TilePipelineStateCreateInfo>(const IRenderDevice*               pDevice,
                                                         const TilePipelineStateCreateInfo& CreateInfo) noexcept(false);
 
+// Validates work graph pipeline create attributes and throws an exception in case of an error.
+template <>
+void ValidatePSOCreateInfo<WorkGraphPipelineStateCreateInfo>(const IRenderDevice*                    pDevice,
+                                                             const WorkGraphPipelineStateCreateInfo& CreateInfo) noexcept(false);
+
+/// Returns all shaders used by the pipeline, in no particular order.
+void GetPipelineShaders(const GraphicsPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders);
+void GetPipelineShaders(const ComputePipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders);
+void GetPipelineShaders(const RayTracingPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders);
+void GetPipelineShaders(const TilePipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders);
+void GetPipelineShaders(const WorkGraphPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders);
+
+/// Deep copy of the pipeline state create info that also keeps strong references to
+/// all objects (shaders, signatures, render pass, etc.) referenced by the create info.
+/// It is used to initialize pipelines asynchronously.
+
+/// \remarks Only graphics and compute pipeline create infos are supported.
+template <typename PSOCreateInfoType>
+class PipelineStateCreateInfoWrapper
+{
+public:
+    PipelineStateCreateInfoWrapper(const PSOCreateInfoType& CI, IMemoryAllocator& RawAllocator) noexcept(false);
+
+    // clang-format off
+    PipelineStateCreateInfoWrapper           (const PipelineStateCreateInfoWrapper&) = delete;
+    PipelineStateCreateInfoWrapper& operator=(const PipelineStateCreateInfoWrapper&) = delete;
+    // clang-format on
+
+    const PSOCreateInfoType& Get() const
+    {
+        return m_CreateInfo;
+    }
+
+private:
+    PSOCreateInfoType                             m_CreateInfo;
+    std::vector<RefCntAutoPtr<IObject>>           m_Objects;
+    std::unique_ptr<void, STDDeleterRawMem<void>> m_pRawMemory;
+};
+
+template <>
+PipelineStateCreateInfoWrapper<GraphicsPipelineStateCreateInfo>::PipelineStateCreateInfoWrapper(const GraphicsPipelineStateCreateInfo& CI, IMemoryAllocator& RawAllocator) noexcept(false);
+
+template <>
+PipelineStateCreateInfoWrapper<ComputePipelineStateCreateInfo>::PipelineStateCreateInfoWrapper(const ComputePipelineStateCreateInfo& CI, IMemoryAllocator& RawAllocator) noexcept(false);
+
+/// Indicates whether pipelines created with the given create info type can be initialized asynchronously.
+template <typename PSOCreateInfoType>
+struct IsAsyncPipelineCreateInfo : std::false_type
+{};
+
+template <>
+struct IsAsyncPipelineCreateInfo<GraphicsPipelineStateCreateInfo> : std::true_type
+{};
+
+template <>
+struct IsAsyncPipelineCreateInfo<ComputePipelineStateCreateInfo> : std::true_type
+{};
+
 /// Validates that pipeline resource description 'ResDesc' is compatible with the actual resource
 /// attributes and throws an exception in case of an error.
 void ValidatePipelineResourceCompatibility(const PipelineResourceDesc& ResDesc,
@@ -192,6 +255,9 @@ private:
     // Render pass implementation type (RenderPassD3D12Impl, RenderPassVkImpl, etc.).
     using RenderPassImplType = typename EngineImplTraits::RenderPassImplType;
 
+    // Shader implementation type (ShaderD3D12Impl, ShaderVkImpl, etc.).
+    using ShaderImplType = typename EngineImplTraits::ShaderImplType;
+
     using TDeviceObjectBase = DeviceObjectBase<BaseInterface, RenderDeviceImplType, PipelineStateDesc>;
 
 public:
@@ -212,7 +278,8 @@ public:
         TDeviceObjectBase{pRefCounters, pDevice, CreateInfo.PSODesc, bIsDeviceInternal},
         m_UsingImplicitSignature{CreateInfo.ppResourceSignatures == nullptr ||
                                  CreateInfo.ResourceSignaturesCount == 0 ||
-                                 (GetInternalCreateFlags(CreateInfo) & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0}
+                                 (GetInternalCreateFlags(CreateInfo) & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0},
+        m_ShareImplicitSignature{(CreateInfo.Flags & PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE) != 0}
     {
         try
         {
@@ -223,6 +290,8 @@ public:
                           "No bits in the immediate mask (0x", std::hex, this->m_Desc.ImmediateContextMask,
                           ") correspond to one of ", this->GetDevice()->GetCommandQueueCount(), " available software command queues.");
             this->m_Desc.ImmediateContextMask &= DeviceQueuesMask;
+
+            InitDerivativeCreateInfo(CreateInfo);
         }
         catch (...)
         {
@@ -252,6 +321,7 @@ public:
         DSSRegistry.ReportDeletedObject();
         */
         VERIFY(m_IsDestructed, "This object must be explicitly destructed with Destruct()");
+        VERIFY(!m_pInitTask, "Asynchronous initialization task has not been finished. Derived class must call FinishAsyncInitialization() in its Destruct() method.");
     }
 
     void Destruct()
@@ -270,6 +340,10 @@ public:
         {
             m_pTilePipelineData->~TilePipelineData();
         }
+        else if (this->m_Desc.IsWorkGraphPipeline() && m_pWorkGraphPipelineData != nullptr)
+        {
+            m_pWorkGraphPipelineData->~WorkGraphPipelineData();
+        }
 
         if (m_Signatures != nullptr)
         {
@@ -283,6 +357,8 @@ public:
             GetRawAllocator().Free(m_pPipelineDataRawMem);
             m_pPipelineDataRawMem = nullptr;
         }
+
+        m_pDerivativeCreateInfo.reset();
 #if DILIGENT_DEBUG
         m_IsDestructed = true;
 #endif
@@ -290,6 +366,22 @@ public:
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineState, TDeviceObjectBase)
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override
+    {
+        if (m_pInitTask)
+        {
+            if (WaitForCompletion)
+                m_pInitTask->WaitForCompletion();
+
+            // The task is cancelled if any of its prerequisites was cancelled
+            if (m_pInitTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED)
+                return PIPELINE_STATE_STATUS_FAILED;
+        }
+
+        return m_Status.load();
+    }
+
     Uint32 GetBufferStride(Uint32 BufferSlot) const
     {
         VERIFY_EXPR(this->m_Desc.IsAnyGraphicsPipeline());
@@ -321,6 +413,13 @@ public:
         return m_pGraphicsPipelineData->Desc;
     }
 
+    /// Returns the create info of the pipeline if it was created with PSO_CREATE_FLAG_ALLOW_DERIVATIVES flag,
+    /// and null otherwise. The create info remains valid while the pipeline is alive.
+    const GraphicsPipelineStateCreateInfo* GetDerivativeCreateInfo() const
+    {
+        return m_pDerivativeCreateInfo ? &m_pDerivativeCreateInfo->Get() : nullptr;
+    }
+
     virtual const RayTracingPipelineDesc& DILIGENT_CALL_TYPE GetRayTracingPipelineDesc() const override final
     {
         VERIFY_EXPR(this->m_Desc.IsRayTracingPipeline());
@@ -335,6 +434,14 @@ public:
         return m_pTilePipelineData->Desc;
     }
 
+    /// Returns the name of the work graph program.
+    const char* GetWorkGraphProgramName() const
+    {
+        VERIFY_EXPR(this->m_Desc.IsWorkGraphPipeline());
+        VERIFY_EXPR(m_pWorkGraphPipelineData != nullptr);
+        return m_pWorkGraphPipelineData->ProgramName;
+    }
+
     inline void CopyShaderHandle(const char* Name, void* pData, size_t DataSize) const
     {
         VERIFY_EXPR(this->m_Desc.IsRayTracingPipeline());
@@ -482,6 +589,12 @@ public:
         }
 
         auto* pDstSign = static_cast<PipelineStateImplType*>(pDstPipeline)->GetResourceSignature(0);
+        if (pDstSign == this->GetResourceSignature(0))
+        {
+            // The pipelines share the implicit signature (PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE),
+            // so they already use the same static resources.
+            return;
+        }
         return this->GetResourceSignature(0)->CopyStaticResources(pDstSign);
     }
 
@@ -600,6 +713,15 @@ protected:
         ReserveResourceSignatures(CreateInfo, MemPool);
     }
 
+    void ReserveSpaceForPipelineDesc(const WorkGraphPipelineStateCreateInfo& CreateInfo,
+                                     FixedLinearAllocator&                   MemPool) noexcept
+    {
+        MemPool.AddSpace<WorkGraphPipelineData>();
+        MemPool.AddSpaceForString(GetWorkGraphProgramName(CreateInfo));
+        ReserveResourceLayout(CreateInfo.PSODesc.ResourceLayout, MemPool);
+        ReserveResourceSignatures(CreateInfo, MemPool);
+    }
+
 public:
     template <typename ShaderImplType, typename TShaderStages>
     static void ExtractShaders(const GraphicsPipelineStateCreateInfo& CreateInfo,
@@ -759,6 +881,44 @@ public:
         VERIFY_EXPR(!ShaderStages.empty());
     }
 
+    template <typename ShaderImplType, typename TShaderStages>
+    static void ExtractShaders(const WorkGraphPipelineStateCreateInfo& CreateInfo,
+                               TShaderStages&                          ShaderStages,
+                               SHADER_TYPE&                            ActiveShaderStages)
+    {
+        VERIFY_EXPR(CreateInfo.PSODesc.IsWorkGraphPipeline());
+
+        std::unordered_set<IShader*> UniqueShaders;
+
+        // All work graph libraries share a single stage
+        ShaderStages.clear();
+        ShaderStages.resize(1);
+        ActiveShaderStages = SHADER_TYPE_UNKNOWN;
+
+        for (Uint32 i = 0; i < CreateInfo.ShaderCount; ++i)
+        {
+            IShader* pShader = CreateInfo.ppShaders[i];
+            VERIFY_EXPR(pShader != nullptr && pShader->GetDesc().ShaderType == SHADER_TYPE_WORK_GRAPH);
+            if (!UniqueShaders.insert(pShader).second)
+                continue;
+
+            RefCntAutoPtr<ShaderImplType> pShaderImpl{pShader, ShaderImplType::IID_InternalImpl};
+            VERIFY(pShaderImpl, "Unexpected shader object implementation");
+            ShaderStages[0].Append(pShaderImpl);
+            ActiveShaderStages = SHADER_TYPE_WORK_GRAPH;
+        }
+
+        VERIFY_EXPR(ShaderStages[0].Count() != 0);
+    }
+
+    /// Returns the name of the work graph program defined by the create info.
+    static const char* GetWorkGraphProgramName(const WorkGraphPipelineStateCreateInfo& CreateInfo)
+    {
+        if (!IsNullOrEmptyStr(CreateInfo.ProgramName))
+            return CreateInfo.ProgramName;
+        return CreateInfo.PSODesc.Name != nullptr ? CreateInfo.PSODesc.Name : "";
+    }
+
 protected:
     template <typename ShaderImplType, typename PSOCreateInfoType, typename TShaderStages>
     void ExtractShaders(const PSOCreateInfoType& PSOCreateInfo,
@@ -954,6 +1114,19 @@ protected:
         CopyResourceSignatures(CreateInfo, MemPool);
     }
 
+    void InitializePipelineDesc(const WorkGraphPipelineStateCreateInfo& CreateInfo,
+                                FixedLinearAllocator&                   MemPool)
+    {
+        this->m_pWorkGraphPipelineData = MemPool.Construct<WorkGraphPipelineData>();
+        void* Ptr                      = MemPool.ReleaseOwnership();
+        VERIFY_EXPR(Ptr == m_pPipelineDataRawMem);
+
+        this->m_pWorkGraphPipelineData->ProgramName = MemPool.CopyString(GetWorkGraphProgramName(CreateInfo));
+
+        CopyResourceLayout(CreateInfo.PSODesc.ResourceLayout, this->m_Desc.ResourceLayout, MemPool);
+        CopyResourceSignatures(CreateInfo, MemPool);
+    }
+
     // Resource attribution properties
     struct ResourceAttribution
     {
@@ -1025,14 +1198,22 @@ protected:
         return GetResourceAttribution(Name, Stage, pThis->m_Signatures, pThis->m_SignatureCount);
     }
 
-    template <typename... ExtraArgsType>
     void InitDefaultSignature(const PipelineResourceSignatureDesc& SignDesc,
-                              const ExtraArgsType&... ExtraArgs)
+                              SHADER_TYPE                          ShaderStages,
+                              bool                                 bIsDeviceInternal)
     {
         VERIFY_EXPR(m_SignatureCount == 1 && m_UsingImplicitSignature);
 
-        RefCntAutoPtr<PipelineResourceSignatureImplType> pImplicitSignature;
-        this->GetDevice()->CreatePipelineResourceSignature(SignDesc, pImplicitSignature.template DblPtr<IPipelineResourceSignature>(), ExtraArgs...);
+        auto CreateSignature = [&]() {
+            RefCntAutoPtr<PipelineResourceSignatureImplType> pSignature;
+            this->GetDevice()->CreatePipelineResourceSignature(SignDesc, pSignature.template DblPtr<IPipelineResourceSignature>(), ShaderStages, bIsDeviceInternal);
+            return pSignature;
+        };
+
+        RefCntAutoPtr<PipelineResourceSignatureImplType> pImplicitSignature =
+            m_ShareImplicitSignature && !bIsDeviceInternal ?
+            this->GetDevice()->GetSharedImplicitSignature(SignDesc, ShaderStages, CreateSignature) :
+            CreateSignature();
 
         if (!pImplicitSignature)
             LOG_ERROR_AND_THROW("Failed to create implicit resource signature for pipeline state '", this->m_Desc.Name, "'.");
@@ -1183,6 +1364,146 @@ private:
         }
     }
 
+protected:
+    /// Initializes the pipeline synchronously or, if PSO_CREATE_FLAG_ASYNCHRONOUS flag is set
+    /// and the device has a shader compilation thread pool, asynchronously.
+
+    /// \param CreateInfo   - Pipeline state create info.
+    /// \param InitPipeline - Function that initializes the pipeline, with the
+    ///                       signature void(const PSOCreateInfoType&).
+    /// \param AllowAsync   - Whether the backend supports asynchronous initialization.
+    ///
+    /// \remarks  In asynchronous mode, the create info is deep-copied and InitPipeline is executed
+    ///           by the thread pool after all shaders have been compiled. Exceptions thrown by
+    ///           InitPipeline put the pipeline into PIPELINE_STATE_STATUS_FAILED state.
+    ///           In synchronous mode, the method waits for asynchronously compiled shaders and
+    ///           exceptions are propagated to the caller.
+    ///           Derived classes that use this method must call FinishAsyncInitialization() at
+    ///           the beginning of their Destruct() method.
+    template <typename PSOCreateInfoType, typename InitHandlerType>
+    void InitializePipeline(const PSOCreateInfoType& CreateInfo, InitHandlerType InitPipeline, bool AllowAsync = true) noexcept(false)
+    {
+        IThreadPool* pThreadPool = AllowAsync ? this->GetDevice()->GetShaderCompilationThreadPool() : nullptr;
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 && pThreadPool != nullptr)
+            InitializePipelineAsync(CreateInfo, InitPipeline, pThreadPool, IsAsyncPipelineCreateInfo<PSOCreateInfoType>{});
+        else
+            InitializePipelineSync(CreateInfo, InitPipeline);
+    }
+
+    /// Sets the status of a pipeline whose initialization is completed by the backend
+    /// outside of InitializePipeline(), e.g. when the OpenGL driver links programs in parallel.
+    void SetStatus(PIPELINE_STATE_STATUS Status)
+    {
+        VERIFY(!m_pInitTask, "The status of the pipeline that is initialized asynchronously is managed by InitializePipeline()");
+        m_Status.store(Status);
+    }
+
+    /// Removes the asynchronous initialization task from the queue or waits until it is finished.
+    void FinishAsyncInitialization()
+    {
+        if (!m_pInitTask)
+            return;
+
+        if (!m_pThreadPool->RemoveTask(m_pInitTask, /*CancelIfRunning = */ false))
+            m_pInitTask->WaitForCompletion();
+
+        m_pInitTask.Release();
+        m_pThreadPool.Release();
+    }
+
+private:
+    template <typename PSOCreateInfoType, typename InitHandlerType>
+    void InitializePipelineSync(const PSOCreateInfoType& CreateInfo, const InitHandlerType& InitPipeline) noexcept(false)
+    {
+        std::vector<IShader*> Shaders;
+        GetPipelineShaders(CreateInfo, Shaders);
+
+        SHADER_TYPE ShaderStages = SHADER_TYPE_UNKNOWN;
+        for (auto* pShader : Shaders)
+        {
+            // Wait for shaders that are being compiled asynchronously
+            if (pShader->GetStatus(/*WaitForCompletion = */ true) != SHADER_STATUS_READY)
+                LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' used by pipeline state '", this->m_Desc.Name, "' failed to compile.");
+            ShaderStages |= pShader->GetDesc().ShaderType;
+        }
+
+        {
+            auto*                  pDevice = this->GetDevice();
+            CompilationRecordScope Scope{pDevice != nullptr ? pDevice->GetCompilationStatisticsImpl() : nullptr,
+                                         COMPILATION_RECORD_TYPE_PIPELINE, ShaderStages, this->m_Desc.Name};
+            InitPipeline(CreateInfo);
+        }
+        m_Status.store(PIPELINE_STATE_STATUS_READY);
+    }
+
+    template <typename PSOCreateInfoType, typename InitHandlerType>
+    void InitializePipelineAsync(const PSOCreateInfoType& CreateInfo, const InitHandlerType& InitPipeline, IThreadPool* pThreadPool, std::false_type) noexcept(false)
+    {
+        LOG_WARNING_MESSAGE("Asynchronous initialization is not supported for ", GetPipelineTypeString(this->m_Desc.PipelineType),
+                            " pipeline '", this->m_Desc.Name, "'. The pipeline will be initialized synchronously.");
+        InitializePipelineSync(CreateInfo, InitPipeline);
+    }
+
+    template <typename PSOCreateInfoType, typename InitHandlerType>
+    void InitializePipelineAsync(const PSOCreateInfoType& CreateInfo, const InitHandlerType& InitPipeline, IThreadPool* pThreadPool, std::true_type) noexcept(false)
+    {
+        auto pCreateInfo = std::make_shared<PipelineStateCreateInfoWrapper<PSOCreateInfoType>>(CreateInfo, GetRawAllocator());
+
+        std::vector<IShader*> Shaders;
+        GetPipelineShaders(CreateInfo, Shaders);
+
+        // The pipeline will be initialized once all shaders have been compiled
+        std::vector<IAsyncTask*> Prerequisites;
+        Prerequisites.reserve(Shaders.size());
+        for (auto* pShader : Shaders)
+        {
+            RefCntAutoPtr<ShaderImplType> pShaderImpl{pShader, ShaderImplType::IID_InternalImpl};
+            VERIFY(pShaderImpl, "Unexpected shader object implementation");
+            if (auto* pCompileTask = pShaderImpl->GetCompileTask())
+                Prerequisites.push_back(pCompileTask);
+        }
+
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING);
+        m_pThreadPool = pThreadPool;
+        m_pInitTask   = EnqueueAsyncWork(pThreadPool, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()),
+                                       [this, pCreateInfo, InitPipeline](Uint32 ThreadId) //
+                                       {
+                                           try
+                                           {
+                                               InitializePipelineSync(pCreateInfo->Get(), InitPipeline);
+                                           }
+                                           catch (...)
+                                           {
+                                               LOG_ERROR_MESSAGE("Failed to asynchronously initialize pipeline state '", this->m_Desc.Name, "'.");
+                                               m_Status.store(PIPELINE_STATE_STATUS_FAILED);
+                                           }
+                                       });
+    }
+
+    void InitDerivativeCreateInfo(const GraphicsPipelineStateCreateInfo& CreateInfo) noexcept(false)
+    {
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ALLOW_DERIVATIVES) != 0)
+            m_pDerivativeCreateInfo = std::make_unique<PipelineStateCreateInfoWrapper<GraphicsPipelineStateCreateInfo>>(CreateInfo, GetRawAllocator());
+    }
+
+    template <typename PSOCreateInfoType>
+    void InitDerivativeCreateInfo(const PSOCreateInfoType& CreateInfo) noexcept
+    {
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ALLOW_DERIVATIVES) != 0)
+        {
+            LOG_WARNING_MESSAGE("PSO_CREATE_FLAG_ALLOW_DERIVATIVES flag is ignored for ", GetPipelineTypeString(this->m_Desc.PipelineType),
+                                " pipeline '", this->m_Desc.Name, "': only graphics pipelines can be used as base pipelines.");
+        }
+    }
+
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_UNINITIALIZED};
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+    RefCntAutoPtr<IAsyncTask>  m_pInitTask;
+
+    // Copy of the create info that is used to create derived pipelines (see PSO_CREATE_FLAG_ALLOW_DERIVATIVES)
+    std::unique_ptr<PipelineStateCreateInfoWrapper<GraphicsPipelineStateCreateInfo>> m_pDerivativeCreateInfo;
+
 protected:
     /// Shader stages that are active in this PSO.
     SHADER_TYPE m_ActiveShaderStages = SHADER_TYPE_UNKNOWN;
@@ -1190,6 +1511,9 @@ protected:
     /// True if the pipeline was created using implicit root signature.
     const bool m_UsingImplicitSignature;
 
+    /// True if the implicit signature is shared with other pipelines, see PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE.
+    const bool m_ShareImplicitSignature;
+
     /// The number of signatures in m_Signatures array.
     /// Note that this is not necessarily the same as the number of signatures
     /// that were used to create the pipeline, because signatures are arranged
@@ -1235,11 +1559,17 @@ protected:
         TilePipelineDesc Desc;
     };
 
+    struct WorkGraphPipelineData
+    {
+        const char* ProgramName = nullptr;
+    };
+
     union
     {
         GraphicsPipelineData*   m_pGraphicsPipelineData;
         RayTracingPipelineData* m_pRayTracingPipelineData;
         TilePipelineData*       m_pTilePipelineData;
+        WorkGraphPipelineData*  m_pWorkGraphPipelineData;
         void*                   m_pPipelineDataRawMem = nullptr;
     };
 
@@ -29,8 +29,16 @@
 /// \file
 /// Implementation of the Diligent::PipelineStateCacheBase template class
 
+#include <atomic>
+#include <mutex>
+#include <string>
+
 #include "PipelineStateCache.h"
+#include "CompilationStatistics.h"
 #include "DeviceObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -38,6 +46,16 @@ namespace Diligent
 /// Validates PSO cache create info and throws an exception in case of an error.
 void ValidatePipelineStateCacheCreateInfo(const PipelineStateCacheCreateInfo& CreateInfo) noexcept(false);
 
+/// Returns the path of the managed PSO cache file in CreateInfo.CacheDirectory for the device
+/// identified by DeviceKey, or an empty string if the cache directory is not specified.
+std::string GetPipelineStateCacheFilePath(const PipelineStateCacheCreateInfo& CreateInfo, const char* DeviceKey);
+
+/// Reads the PSO cache file. Returns null if the file does not exist or can't be read.
+RefCntAutoPtr<IDataBlob> ReadPipelineStateCacheFile(const std::string& FilePath);
+
+/// Writes the data to a temporary file and then replaces the PSO cache file with it.
+bool WritePipelineStateCacheFile(const std::string& FilePath, const void* pData, size_t Size);
+
 /// Template class implementing base functionality of the pipeline state cache object
 
 /// \tparam EngineImplTraits - Engine implementation type traits.
@@ -67,7 +85,149 @@ public:
         ValidatePipelineStateCacheCreateInfo(CreateInfo);
     }
 
+    ~PipelineStateCacheBase()
+    {
+        VERIFY(!m_pSaveTask, "The save task has not been finished. Derived classes must call FlushCacheFile() in their destructors.");
+    }
+
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineStateCache, TDeviceObjectBase)
+
+    /// Implementation of IPipelineStateCache::Save().
+    virtual Bool DILIGENT_CALL_TYPE Save(Bool Async) override
+    {
+        if (m_FilePath.empty())
+        {
+            LOG_WARNING_MESSAGE("Pipeline state cache '", this->m_Desc.Name, "' can't be saved as it was created without a cache directory.");
+            return False;
+        }
+
+        IThreadPool* pThreadPool = Async ? this->GetDevice()->GetShaderCompilationThreadPool() : nullptr;
+        if (pThreadPool == nullptr)
+            return WriteCacheFile();
+
+        std::lock_guard<std::mutex> Lock{m_SaveTaskMtx};
+        // A task that has not started yet will write the latest data anyway.
+        if (!m_pSaveTask || m_pSaveTask->GetStatus() != ASYNC_TASK_STATUS_NOT_STARTED)
+        {
+            m_pThreadPool = pThreadPool;
+            m_pSaveTask   = EnqueueAsyncWork(pThreadPool,
+                                           [this](Uint32 ThreadId) //
+                                           {
+                                               WriteCacheFile();
+                                           });
+        }
+        return True;
+    }
+
+    /// Implementation of IPipelineStateCache::GetStatistics().
+    virtual void DILIGENT_CALL_TYPE GetStatistics(PipelineStateCacheStatistics& Stats) const override final
+    {
+        Stats               = {};
+        Stats.PipelineCount = m_PipelineCount.load(std::memory_order_relaxed);
+        Stats.HitCount      = m_HitCount.load(std::memory_order_relaxed);
+        Stats.MissCount     = m_MissCount.load(std::memory_order_relaxed);
+        Stats.HitDuration   = m_HitDuration.load(std::memory_order_relaxed);
+        Stats.MissDuration  = m_MissDuration.load(std::memory_order_relaxed);
+    }
+
+    /// Records the creation of a pipeline with this cache.
+
+    /// \param [in] CacheResult - Cache lookup result.
+    /// \param [in] Duration    - The time, in microseconds, the driver spent creating the pipeline.
+    void OnPipelineCreated(PIPELINE_CACHE_RESULT CacheResult, Uint64 Duration)
+    {
+        m_PipelineCount.fetch_add(1, std::memory_order_relaxed);
+        if (CacheResult == PIPELINE_CACHE_RESULT_HIT)
+        {
+            m_HitCount.fetch_add(1, std::memory_order_relaxed);
+            m_HitDuration.fetch_add(Duration, std::memory_order_relaxed);
+        }
+        else if (CacheResult == PIPELINE_CACHE_RESULT_MISS)
+        {
+            m_MissCount.fetch_add(1, std::memory_order_relaxed);
+            m_MissDuration.fetch_add(Duration, std::memory_order_relaxed);
+        }
+    }
+
+protected:
+    /// Initializes the managed cache file, see PipelineStateCacheCreateInfo::CacheDirectory.
+
+    /// \param [in] CreateInfo - PSO cache create info.
+    /// \param [in] DeviceKey  - A string that identifies the device and driver version.
+    /// \return     The contents of the cache file, or null if the cache is not managed
+    ///             or the file does not exist.
+    RefCntAutoPtr<IDataBlob> InitCacheFile(const PipelineStateCacheCreateInfo& CreateInfo, const char* DeviceKey)
+    {
+        m_FilePath = GetPipelineStateCacheFilePath(CreateInfo, DeviceKey);
+        if (m_FilePath.empty() || CreateInfo.pCacheData != nullptr)
+            return {};
+
+        auto pData = ReadPipelineStateCacheFile(m_FilePath);
+        if (pData)
+            m_SavedDataHash = ComputeHashRaw(pData->GetConstDataPtr(), pData->GetSize());
+        return pData;
+    }
+
+    /// Waits for the pending save task and writes the cache data if it has changed.
+    ///
+    /// \remarks   Derived classes must call this method at the beginning of their destructors,
+    ///            while the object that GetData() relies on is still alive.
+    void FlushCacheFile()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_SaveTaskMtx};
+            if (m_pSaveTask)
+            {
+                if (!m_pThreadPool->RemoveTask(m_pSaveTask, /*CancelIfRunning = */ false))
+                    m_pSaveTask->WaitForCompletion();
+                m_pSaveTask.Release();
+                m_pThreadPool.Release();
+            }
+        }
+
+        if (!m_FilePath.empty())
+            WriteCacheFile();
+    }
+
+private:
+    bool WriteCacheFile()
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        this->GetData(&pData);
+        if (!pData)
+        {
+            LOG_ERROR_MESSAGE("Failed to get the data of pipeline state cache '", this->m_Desc.Name, "'.");
+            return false;
+        }
+
+        std::lock_guard<std::mutex> Lock{m_FileMtx};
+
+        const auto Hash = ComputeHashRaw(pData->GetConstDataPtr(), pData->GetSize());
+        if (Hash == m_SavedDataHash)
+            return true;
+
+        if (!WritePipelineStateCacheFile(m_FilePath, pData->GetConstDataPtr(), pData->GetSize()))
+            return false;
+
+        m_SavedDataHash = Hash;
+        return true;
+    }
+
+private:
+    std::string m_FilePath;
+
+    std::mutex m_FileMtx;
+    size_t     m_SavedDataHash = 0;
+
+    std::mutex                 m_SaveTaskMtx;
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+    RefCntAutoPtr<IAsyncTask>  m_pSaveTask;
+
+    std::atomic<Uint32> m_PipelineCount{0};
+    std::atomic<Uint32> m_HitCount{0};
+    std::atomic<Uint32> m_MissCount{0};
+    std::atomic<Uint64> m_HitDuration{0};
+    std::atomic<Uint64> m_MissDuration{0};
 };
 
 } // namespace Diligent
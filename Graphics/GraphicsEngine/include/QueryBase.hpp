@@ -137,8 +137,8 @@ public:
         if (m_pContext != nullptr && m_pContext != pContext)
             Invalidate();
 
-        m_pContext = pContext;
-        m_State    = QueryState::Querying;
+        SetContext(pContext);
+        m_State = QueryState::Querying;
     }
 
     void OnEndQuery(DeviceContextImplType* pContext)
@@ -155,7 +155,7 @@ public:
             if (m_pContext != nullptr && m_pContext != pContext)
                 Invalidate();
 
-            m_pContext = pContext;
+            SetContext(pContext);
         }
 
         m_State = QueryState::Ended;
@@ -213,10 +213,33 @@ public:
         }
     }
 
+    /// Makes the query keep a raw pointer to the context that begins it instead of
+    /// a strong reference. This is used by the queries that are owned by the context
+    /// itself and would otherwise create a reference cycle.
+    void SetContextInternal()
+    {
+        m_IsContextInternal = true;
+        m_pContextRef.Release();
+    }
+
+private:
+    void SetContext(DeviceContextImplType* pContext)
+    {
+        m_pContext = pContext;
+        if (!m_IsContextInternal)
+            m_pContextRef = pContext;
+    }
+
 protected:
-    RefCntAutoPtr<DeviceContextImplType> m_pContext;
+    DeviceContextImplType* m_pContext = nullptr;
 
     QueryState m_State = QueryState::Inactive;
+
+private:
+    // Keeps the context alive unless the query is owned by the context, see SetContextInternal()
+    RefCntAutoPtr<DeviceContextImplType> m_pContextRef;
+
+    bool m_IsContextInternal = false;
 };
 
 } // namespace Diligent
@@ -30,6 +30,11 @@
 /// \file
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include "RenderDevice.h"
 #include "DeviceObjectBase.hpp"
 #include "Defines.h"
@@ -44,6 +49,13 @@
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
+#include "CompilationStatisticsImpl.hpp"
+#include "TrackingMemoryAllocator.hpp"
+#include "MetricsRegistry.hpp"
+#include "FenceCompletionWaiter.hpp"
+#include "GPUMemoryTracker.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -73,6 +85,15 @@ COMPONENT_TYPE CheckSparseTextureFormatSupport(TEXTURE_FORMAT                  T
                                                RESOURCE_DIMENSION              Dimension,
                                                Uint32                          SampleCount,
                                                const SparseResourceProperties& SparseRes) noexcept;
+
+/// Returns the memory allocation tag of the objects with the given interface type, see Diligent::MEMORY_ALLOCATION_TAG.
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const void*) { return MEMORY_ALLOCATION_TAG_UNKNOWN; }
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const ITexture*) { return MEMORY_ALLOCATION_TAG_TEXTURE; }
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const IBuffer*) { return MEMORY_ALLOCATION_TAG_BUFFER; }
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const IShader*) { return MEMORY_ALLOCATION_TAG_SHADER; }
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const IPipelineState*) { return MEMORY_ALLOCATION_TAG_PIPELINE_STATE; }
+inline MEMORY_ALLOCATION_TAG GetMemoryAllocationTag(const IPipelineResourceSignature*) { return MEMORY_ALLOCATION_TAG_PIPELINE_STATE; }
+
 /// Base implementation of a render device
 
 /// \tparam EngineImplTraits - Engine implementation type traits.
@@ -125,6 +146,11 @@ public:
         // clang-format off
         TObjectBase              {pRefCounters},
         m_pEngineFactory         {pEngineFactory},
+        m_pShaderCompilationThreadPool{EngineCI.pAsyncShaderCompilationThreadPool},
+        m_pCompilationStatistics {EngineCI.EnableCompilationStatistics ? MakeNewRCObj<CompilationStatisticsImpl>()() : nullptr},
+        m_pMetrics               {EngineCI.EnableMetrics ? std::make_unique<MetricsRegistry>(DEVICE_METRIC_COUNT) : nullptr},
+        m_pGPUMemoryTracker      {EngineCI.EnableGPUMemoryTracking ? std::make_unique<GPUMemoryTracker>() : nullptr},
+        m_pFenceCompletionWaiter {std::make_unique<FenceCompletionWaiter>(/*UseThread = */ false)},
         m_ValidationFlags        {EngineCI.ValidationFlags},
         m_AdapterInfo            {AdapterInfo},
         m_SamplersRegistry       {RawMemAllocator, "sampler"},
@@ -133,14 +159,14 @@ public:
         m_wpImmediateContexts    (std::max(1u, EngineCI.NumImmediateContexts), RefCntWeakPtr<DeviceContextImplType>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<DeviceContextImplType>, RawMemAllocator, "Allocator for vector<RefCntWeakPtr<DeviceContextImplType>>")),
         m_wpDeferredContexts     (EngineCI.NumDeferredContexts, RefCntWeakPtr<DeviceContextImplType>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<DeviceContextImplType>, RawMemAllocator, "Allocator for vector<RefCntWeakPtr<DeviceContextImplType>>")),
         m_RawMemAllocator        {RawMemAllocator},
-        m_TexObjAllocator        {RawMemAllocator, sizeof(TextureImplType),                    64},
-        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64},
-        m_BufObjAllocator        {RawMemAllocator, sizeof(BufferImplType),                    128},
-        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128},
+        m_TexObjAllocator        {RawMemAllocator, sizeof(TextureImplType),                    64, ObjThreadCacheSize},
+        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64, ObjThreadCacheSize},
+        m_BufObjAllocator        {RawMemAllocator, sizeof(BufferImplType),                    128, ObjThreadCacheSize},
+        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128, ObjThreadCacheSize},
         m_ShaderObjAllocator     {RawMemAllocator, sizeof(ShaderImplType),                     32},
         m_SamplerObjAllocator    {RawMemAllocator, sizeof(SamplerImplType),                    32},
         m_PSOAllocator           {RawMemAllocator, sizeof(PipelineStateImplType),             128},
-        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024},
+        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024, ObjThreadCacheSize},
         m_ResMappingAllocator    {RawMemAllocator, sizeof(ResourceMappingImpl),                16},
         m_FenceAllocator         {RawMemAllocator, sizeof(FenceImplType),                      16},
         m_QueryAllocator         {RawMemAllocator, sizeof(QueryImplType),                      16},
@@ -277,6 +303,131 @@ public:
         return m_pEngineFactory.RawPtr<IEngineFactory>();
     }
 
+    /// Implementation of IRenderDevice::GetCompilationStatistics().
+    virtual ICompilationStatistics* DILIGENT_CALL_TYPE GetCompilationStatistics() const override final
+    {
+        return m_pCompilationStatistics.RawPtr<ICompilationStatistics>();
+    }
+
+    /// Implementation of IRenderDevice::GetMemoryAllocationStatistics().
+    virtual Bool DILIGENT_CALL_TYPE GetMemoryAllocationStatistics(MemoryAllocationStatistics& Stats) const override final
+    {
+        Stats = {};
+
+        const TrackingMemoryAllocator* pTracker = GetTrackingRawAllocator();
+        if (pTracker == nullptr)
+            return false;
+
+        static_assert(MEMORY_ALLOCATION_TAG_COUNT <= TrackingMemoryAllocator::MaxTags, "Not enough tags in the tracking allocator");
+        for (Uint32 Tag = 0; Tag < MEMORY_ALLOCATION_TAG_COUNT; ++Tag)
+        {
+            const TrackingMemoryAllocator::TagStatistics TagStats = pTracker->GetTagStatistics(Tag);
+
+            MemoryAllocationTagStatistics& DstStats = Stats.Tags[Tag];
+            DstStats.CurrentSize                    = TagStats.CurrentSize;
+            DstStats.PeakSize                       = TagStats.PeakSize;
+            DstStats.CurrentAllocationCount         = TagStats.CurrentAllocationCount;
+            DstStats.TotalAllocationCount           = TagStats.TotalAllocationCount;
+            DstStats.FrameAllocationCount           = m_FrameAllocationCounts[Tag].load(std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /// Implementation of IRenderDevice::GetGPUMemoryStatistics().
+    virtual Bool DILIGENT_CALL_TYPE GetGPUMemoryStatistics(GPUMemoryStatistics& Stats) const override final
+    {
+        Stats = {};
+        if (!m_pGPUMemoryTracker)
+            return false;
+
+        m_pGPUMemoryTracker->GetStatistics(Stats);
+        return true;
+    }
+
+    /// Implementation of IRenderDevice::GetGPUMemoryAllocations().
+    virtual Uint32 DILIGENT_CALL_TYPE GetGPUMemoryAllocations(GPUMemoryAllocationInfo* pAllocations, Uint32 MaxAllocations) const override final
+    {
+        return m_pGPUMemoryTracker ? m_pGPUMemoryTracker->GetAllocations(pAllocations, MaxAllocations) : 0;
+    }
+
+    /// Implementation of IRenderDevice::GetGPUMemoryReport().
+    virtual void DILIGENT_CALL_TYPE GetGPUMemoryReport(IDataBlob** ppReport) const override final
+    {
+        DEV_CHECK_ERR(ppReport != nullptr, "ppReport must not be null");
+        DEV_CHECK_ERR(*ppReport == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+        *ppReport = nullptr;
+        if (!m_pGPUMemoryTracker)
+            return;
+
+        const std::string Report = m_pGPUMemoryTracker->GetReport();
+        *ppReport                = DataBlobImpl::Create(Report.size() + 1, Report.c_str()).Detach();
+    }
+
+    /// Implementation of IRenderDevice::GetMetrics().
+    virtual Bool DILIGENT_CALL_TYPE GetMetrics(DeviceMetrics& Metrics) const override final
+    {
+        Metrics = {};
+        if (!m_pMetrics)
+            return false;
+
+        static_assert(DILIGENT_METRIC_HISTOGRAM_SIZE == MetricAccumulator::NumHistogramBuckets, "Histogram sizes do not match");
+        for (Uint32 Metric = 0; Metric < DEVICE_METRIC_COUNT; ++Metric)
+        {
+            const MetricAccumulator::Snapshot Snap = m_pMetrics->Get(Metric).GetSnapshot();
+
+            DeviceMetricStatistics& DstStats = Metrics.Metrics[Metric];
+            DstStats.Count                   = Snap.Count;
+            DstStats.TotalTime               = Snap.Total;
+            DstStats.MaxTime                 = Snap.Max;
+            DstStats.LastFrameCount          = Snap.LastFrameCount;
+            DstStats.LastFrameTime           = Snap.LastFrameTotal;
+            for (Uint32 i = 0; i < MetricAccumulator::NumHistogramBuckets; ++i)
+                DstStats.Histogram[i] = Snap.Histogram[i];
+        }
+        return true;
+    }
+
+    /// Implementation of IRenderDevice::ResetMetrics().
+    virtual void DILIGENT_CALL_TYPE ResetMetrics() override final
+    {
+        if (m_pMetrics)
+            m_pMetrics->Reset();
+    }
+
+    /// Base implementation of IRenderDevice::GetStatistics().
+    virtual void DILIGENT_CALL_TYPE GetStatistics(DeviceStatistics& Stats) const override
+    {
+        Stats                        = {};
+        Stats.DescriptorCount        = m_DescriptorCount.load(std::memory_order_relaxed);
+        Stats.PipelineCacheHitCount  = m_PipelineCacheHitCount.load(std::memory_order_relaxed);
+        Stats.PipelineCacheMissCount = m_PipelineCacheMissCount.load(std::memory_order_relaxed);
+    }
+
+    /// Implementation of IRenderDevice::GetStartupStatistics().
+    virtual void DILIGENT_CALL_TYPE GetStartupStatistics(DeviceStartupStatistics& Stats) const override final
+    {
+        Stats = m_StartupStats;
+    }
+
+    /// Sets the startup statistics measured by the engine factory.
+    void SetStartupStatistics(const DeviceStartupStatistics& Stats)
+    {
+        m_StartupStats = Stats;
+    }
+
+    /// Records the allocation of Count descriptors from the device-wide allocators.
+    void OnDescriptorsAllocated(Uint64 Count)
+    {
+        m_DescriptorCount.fetch_add(Count, std::memory_order_relaxed);
+    }
+
+    /// Records the result of a pipeline state cache lookup.
+    void OnPipelineCacheLookup(bool Hit)
+    {
+        (Hit ? m_PipelineCacheHitCount : m_PipelineCacheMissCount).fetch_add(1, std::memory_order_relaxed);
+    }
+
     /// Base implementation of IRenderDevice::CreateTilePipelineState().
     virtual void DILIGENT_CALL_TYPE CreateTilePipelineState(const TilePipelineStateCreateInfo& PSOCreateInfo,
                                                             IPipelineState**                   ppPipelineState) override
@@ -284,8 +435,51 @@ public:
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Base implementation of IRenderDevice::CreateWorkGraphPipelineState().
+    virtual void DILIGENT_CALL_TYPE CreateWorkGraphPipelineState(const WorkGraphPipelineStateCreateInfo& PSOCreateInfo,
+                                                                 IPipelineState**                        ppPipelineState) override
+    {
+        UNSUPPORTED("Work graph pipeline is not supported by this device. Please check DeviceFeatures.WorkGraphs feature.");
+    }
+
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
+    /// Returns the implicit resource signature with the given description and shader stages that is
+    /// shared between pipelines created with PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE. If there is no
+    /// such signature, creates it with CreateSignature() and registers it for sharing.
+    template <typename CreateSignatureType>
+    RefCntAutoPtr<PipelineResourceSignatureImplType> GetSharedImplicitSignature(const PipelineResourceSignatureDesc& Desc,
+                                                                                SHADER_TYPE                          ShaderStages,
+                                                                                CreateSignatureType&&                CreateSignature)
+    {
+        const size_t Hash = ComputeHash(std::hash<PipelineResourceSignatureDesc>{}(Desc), static_cast<Uint32>(ShaderStages));
+
+        // The signature is created under the lock, so that identical signatures
+        // requested by multiple threads at the same time are not created twice.
+        std::lock_guard<std::mutex> Lock{m_SharedImplicitSignaturesMtx};
+
+        auto Range = m_SharedImplicitSignatures.equal_range(Hash);
+        for (auto it = Range.first; it != Range.second;)
+        {
+            if (auto pSignature = it->second.pSignature.Lock())
+            {
+                if (it->second.ShaderStages == ShaderStages && pSignature->GetDesc() == Desc)
+                    return pSignature;
+                ++it;
+            }
+            else
+            {
+                it = m_SharedImplicitSignatures.erase(it);
+            }
+        }
+
+        RefCntAutoPtr<PipelineResourceSignatureImplType> pSignature = CreateSignature();
+        if (pSignature)
+            m_SharedImplicitSignatures.emplace(Hash, SharedImplicitSignature{ShaderStages, RefCntWeakPtr<PipelineResourceSignatureImplType>{pSignature}});
+
+        return pSignature;
+    }
+
     /// Set weak reference to the immediate context
     void SetImmediateContext(size_t Ctx, DeviceContextImplType* pImmediateContext)
     {
@@ -321,6 +515,51 @@ public:
 
     VALIDATION_FLAGS GetValidationFlags() const { return m_ValidationFlags; }
 
+    /// Returns the thread pool that is used to asynchronously compile shaders and pipeline states,
+    /// or null if asynchronous compilation is disabled.
+    IThreadPool* GetShaderCompilationThreadPool() { return m_pShaderCompilationThreadPool; }
+
+    /// Returns the compilation statistics, or null if the statistics are disabled.
+    CompilationStatisticsImpl* GetCompilationStatisticsImpl() const { return m_pCompilationStatistics.RawPtr<CompilationStatisticsImpl>(); }
+
+    /// Returns the accumulator of the given metric, or null if the metrics are disabled.
+    MetricAccumulator* GetMetric(DEVICE_METRIC Metric) const { return m_pMetrics ? &m_pMetrics->Get(Metric) : nullptr; }
+
+    /// Returns the GPU memory tracker, or null if GPU memory tracking is disabled.
+    GPUMemoryTracker* GetGPUMemoryTracker() const { return m_pGPUMemoryTracker.get(); }
+
+    /// Returns the object that services fence completion callbacks, see IFence::EnqueueCompletionCallback().
+    FenceCompletionWaiter& GetFenceCompletionWaiter()
+    {
+        VERIFY_EXPR(m_pFenceCompletionWaiter);
+        return *m_pFenceCompletionWaiter;
+    }
+
+    /// Completes the current frame of all metrics.
+    void EndMetricsFrame()
+    {
+        if (m_pMetrics)
+            m_pMetrics->EndFrame();
+    }
+
+    /// Records the number of allocations of every tag made during the frame that has just
+    /// been completed, see MemoryAllocationTagStatistics::FrameAllocationCount.
+
+    /// \remarks   This method must only be called by the thread that owns the first immediate context.
+    void EndMemoryAllocationFrame()
+    {
+        const TrackingMemoryAllocator* pTracker = GetTrackingRawAllocator();
+        if (pTracker == nullptr)
+            return;
+
+        for (Uint32 Tag = 0; Tag < MEMORY_ALLOCATION_TAG_COUNT; ++Tag)
+        {
+            const Uint64 TotalCount = pTracker->GetTagStatistics(Tag).TotalAllocationCount;
+            m_FrameAllocationCounts[Tag].store(TotalCount - m_FrameStartAllocationCounts[Tag], std::memory_order_relaxed);
+            m_FrameStartAllocationCounts[Tag] = TotalCount;
+        }
+    }
+
     // Convenience function
     const DeviceFeatures& GetFeatures() const
     {
@@ -361,6 +600,7 @@ protected:
 
         *ppObject = nullptr;
 
+        MemoryAllocationTagScope TagScope{GetMemoryAllocationTag(static_cast<const ObjectType*>(nullptr))};
         try
         {
             ConstructObject();
@@ -388,6 +628,7 @@ protected:
     template <typename PSOCreateInfoType, typename... ExtraArgsType>
     void CreatePipelineStateImpl(IPipelineState** ppPipelineState, const PSOCreateInfoType& PSOCreateInfo, const ExtraArgsType&... ExtraArgs)
     {
+        MetricTimerScope MetricScope{GetMetric(DEVICE_METRIC_PIPELINE_STATE_CREATION)};
         CreateDeviceObject("Pipeline State", PSOCreateInfo.PSODesc, ppPipelineState,
                            [&]() //
                            {
@@ -396,6 +637,42 @@ protected:
                            });
     }
 
+    void CreateDerivedGraphicsPipelineStateImpl(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
+    {
+        DEV_CHECK_ERR(ppPipelineState != nullptr, "ppPipelineState must not be null");
+        DEV_CHECK_ERR(*ppPipelineState == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+        if (CreateInfo.pBasePipeline == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to create derived pipeline state '", (CreateInfo.Name != nullptr ? CreateInfo.Name : ""), "': base pipeline must not be null.");
+            return;
+        }
+
+        // Keep the base pipeline alive while its create info is used
+        RefCntAutoPtr<PipelineStateImplType> pBasePSO{CreateInfo.pBasePipeline, PipelineStateImplType::IID_InternalImpl};
+        VERIFY(pBasePSO, "Unexpected pipeline state object implementation");
+
+        const auto* pBaseCI = pBasePSO ? pBasePSO->GetDerivativeCreateInfo() : nullptr;
+        if (pBaseCI == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to create derived pipeline state '", (CreateInfo.Name != nullptr ? CreateInfo.Name : ""),
+                              "': base pipeline '", CreateInfo.pBasePipeline->GetDesc().Name, "' is not a graphics pipeline created with PSO_CREATE_FLAG_ALLOW_DERIVATIVES flag.");
+            return;
+        }
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo = *pBaseCI;
+        if (CreateInfo.Name != nullptr)
+            PSOCreateInfo.PSODesc.Name = CreateInfo.Name;
+        if (CreateInfo.pBlendDesc != nullptr)
+            PSOCreateInfo.GraphicsPipeline.BlendDesc = *CreateInfo.pBlendDesc;
+        if (CreateInfo.pRasterizerDesc != nullptr)
+            PSOCreateInfo.GraphicsPipeline.RasterizerDesc = *CreateInfo.pRasterizerDesc;
+        if (CreateInfo.pDepthStencilDesc != nullptr)
+            PSOCreateInfo.GraphicsPipeline.DepthStencilDesc = *CreateInfo.pDepthStencilDesc;
+
+        static_cast<RenderDeviceImplType*>(this)->CreateGraphicsPipelineState(PSOCreateInfo, ppPipelineState);
+    }
+
     template <typename... ExtraArgsType>
     void CreateBufferImpl(IBuffer** ppBuffer, const BufferDesc& BuffDesc, const ExtraArgsType&... ExtraArgs)
     {
@@ -557,6 +834,35 @@ protected:
 protected:
     RefCntAutoPtr<IEngineFactory> m_pEngineFactory;
 
+    /// Thread pool used to asynchronously compile shaders and pipeline states (may be null)
+    RefCntAutoPtr<IThreadPool> m_pShaderCompilationThreadPool;
+
+    /// Shader and pipeline compilation statistics (may be null)
+    RefCntAutoPtr<CompilationStatisticsImpl> m_pCompilationStatistics;
+
+    /// Device metrics (may be null)
+    std::unique_ptr<MetricsRegistry> m_pMetrics;
+
+    /// GPU memory allocations (may be null)
+    std::unique_ptr<GPUMemoryTracker> m_pGPUMemoryTracker;
+
+    /// Services fence completion callbacks. Backends that can block on native fence objects
+    /// replace the default polled waiter with a threaded one.
+    std::unique_ptr<FenceCompletionWaiter> m_pFenceCompletionWaiter;
+
+    /// Allocation counts of the last completed frame and the total allocation counts
+    /// at the start of the current frame, see EndMemoryAllocationFrame()
+    std::array<std::atomic<Uint64>, MEMORY_ALLOCATION_TAG_COUNT> m_FrameAllocationCounts{};
+    std::array<Uint64, MEMORY_ALLOCATION_TAG_COUNT>              m_FrameStartAllocationCounts{};
+
+    /// Device statistics counters, see GetStatistics()
+    std::atomic<Uint64> m_DescriptorCount{0};
+    std::atomic<Uint64> m_PipelineCacheHitCount{0};
+    std::atomic<Uint64> m_PipelineCacheMissCount{0};
+
+    /// Device startup statistics set by the engine factory, see GetStartupStatistics()
+    DeviceStartupStatistics m_StartupStats;
+
     const VALIDATION_FLAGS m_ValidationFlags;
     GraphicsAdapterInfo    m_AdapterInfo;
     RenderDeviceInfo       m_DeviceInfo;
@@ -568,6 +874,15 @@ protected:
     std::vector<TextureFormatInfoExt, STDAllocatorRawMem<TextureFormatInfoExt>> m_TextureFormatsInfo;
     std::vector<bool, STDAllocatorRawMem<bool>>                                 m_TexFmtInfoInitFlags;
 
+    struct SharedImplicitSignature
+    {
+        SHADER_TYPE                                      ShaderStages;
+        RefCntWeakPtr<PipelineResourceSignatureImplType> pSignature;
+    };
+    /// Implicit resource signatures shared between pipelines, see GetSharedImplicitSignature()
+    std::mutex                                                  m_SharedImplicitSignaturesMtx;
+    std::unordered_multimap<size_t, SharedImplicitSignature>    m_SharedImplicitSignatures;
+
     /// Weak references to immediate contexts. Immediate contexts hold strong reference
     /// to the device, so we must use weak references to avoid circular dependencies.
     std::vector<RefCntWeakPtr<DeviceContextImplType>, STDAllocatorRawMem<RefCntWeakPtr<DeviceContextImplType>>> m_wpImmediateContexts;
@@ -575,6 +890,10 @@ protected:
     /// Weak references to deferred contexts.
     std::vector<RefCntWeakPtr<DeviceContextImplType>, STDAllocatorRawMem<RefCntWeakPtr<DeviceContextImplType>>> m_wpDeferredContexts;
 
+    /// Number of blocks that every thread caches for the allocators of objects that are
+    /// frequently created and destroyed from multiple threads (textures, buffers, views, SRBs).
+    static constexpr Uint32 ObjThreadCacheSize = 32;
+
     IMemoryAllocator&         m_RawMemAllocator;      ///< Raw memory allocator
     FixedBlockMemoryAllocator m_TexObjAllocator;      ///< Allocator for texture objects
     FixedBlockMemoryAllocator m_TexViewObjAllocator;  ///< Allocator for texture view objects
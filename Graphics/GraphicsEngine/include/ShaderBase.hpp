@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "Shader.h"
 #include "DeviceObjectBase.hpp"
@@ -39,6 +40,8 @@
 #include "PlatformMisc.hpp"
 #include "EngineMemory.h"
 #include "Align.hpp"
+#include "ThreadPool.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -143,12 +146,130 @@ public:
 
         if (Desc.ShaderType == SHADER_TYPE_TILE && !deviceFeatures.TileShaders)
             LOG_ERROR_AND_THROW("Tile shaders are not supported by this device.");
+
+        if (Desc.ShaderType == SHADER_TYPE_WORK_GRAPH && !deviceFeatures.WorkGraphs)
+            LOG_ERROR_AND_THROW("Work graph shaders are not supported by this device.");
+    }
+
+    ~ShaderBase()
+    {
+        VERIFY(!m_pCompileTask, "Asynchronous compile task has not been finished. Derived class must call FinishAsyncCompilation() in its destructor.");
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Shader, TDeviceObjectBase)
 
+    /// Implementation of IShader::GetStatus().
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override
+    {
+        if (WaitForCompletion && m_pCompileTask)
+            m_pCompileTask->WaitForCompletion();
+
+        return m_Status.load();
+    }
+
+    /// Returns the asynchronous compile task, or null if the shader is not being compiled asynchronously.
+    IAsyncTask* GetCompileTask()
+    {
+        return m_pCompileTask;
+    }
+
+protected:
+    /// Compiles the shader synchronously or, if SHADER_COMPILE_FLAG_ASYNCHRONOUS flag is set
+    /// and the device has a shader compilation thread pool, asynchronously.
+
+    /// \param ShaderCI   - Shader create info.
+    /// \param InitShader - Function that initializes the shader, with the
+    ///                     signature void(const ShaderCreateInfo&).
+    /// \param AllowAsync - Whether the backend supports asynchronous compilation.
+    ///
+    /// \remarks  In asynchronous mode, the create info is deep-copied and InitShader is
+    ///           executed by the thread pool. Exceptions thrown by InitShader put the shader
+    ///           into SHADER_STATUS_FAILED state. In synchronous mode, exceptions are propagated
+    ///           to the caller.
+    ///           Derived classes that use this method must call FinishAsyncCompilation() at
+    ///           the beginning of their destructors.
+    template <typename InitHandlerType>
+    void InitializeShader(const ShaderCreateInfo& ShaderCI, InitHandlerType InitShader, bool AllowAsync = true) noexcept(false)
+    {
+        auto*        pDevice     = this->GetDevice();
+        IThreadPool* pThreadPool = (AllowAsync && pDevice != nullptr) ? pDevice->GetShaderCompilationThreadPool() : nullptr;
+        if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 && pThreadPool != nullptr)
+        {
+            if (ShaderCI.ppCompilerOutput != nullptr)
+                LOG_WARNING_MESSAGE("Compiler output is not available for shader '", this->m_Desc.Name, "' as it is compiled asynchronously.");
+
+            auto pCreateInfo = std::make_shared<ShaderCreateInfoWrapper>(ShaderCI, GetRawAllocator());
+
+            m_Status.store(SHADER_STATUS_COMPILING);
+            m_pThreadPool  = pThreadPool;
+            m_pCompileTask = EnqueueAsyncWork(pThreadPool,
+                                              [this, pCreateInfo, InitShader](Uint32 ThreadId) //
+                                              {
+                                                  try
+                                                  {
+                                                      InitShaderWithStatistics(pCreateInfo->Get(), InitShader);
+                                                      m_Status.store(SHADER_STATUS_READY);
+                                                  }
+                                                  catch (...)
+                                                  {
+                                                      LOG_ERROR_MESSAGE("Failed to asynchronously compile shader '", this->m_Desc.Name, "'.");
+                                                      m_Status.store(SHADER_STATUS_FAILED);
+                                                  }
+                                              });
+        }
+        else
+        {
+            InitShaderWithStatistics(ShaderCI, InitShader);
+            m_Status.store(SHADER_STATUS_READY);
+        }
+    }
+
+    /// Sets the status of a shader whose compilation is completed by the backend
+    /// outside of InitializeShader(), e.g. by the OpenGL driver in parallel.
+    void SetStatus(SHADER_STATUS Status)
+    {
+        VERIFY(!m_pCompileTask, "The status of the shader that is compiled asynchronously is managed by InitializeShader()");
+        m_Status.store(Status);
+    }
+
+    /// Removes the asynchronous compile task from the queue or waits until it is finished.
+    void FinishAsyncCompilation()
+    {
+        if (!m_pCompileTask)
+            return;
+
+        if (!m_pThreadPool->RemoveTask(m_pCompileTask, /*CancelIfRunning = */ false))
+            m_pCompileTask->WaitForCompletion();
+
+        m_pCompileTask.Release();
+        m_pThreadPool.Release();
+    }
+
 private:
+    // Runs InitShader and, if the device collects compilation statistics, records its timings
+    // and the resulting byte code size.
+    template <typename InitHandlerType>
+    void InitShaderWithStatistics(const ShaderCreateInfo& ShaderCI, InitHandlerType& InitShader) noexcept(false)
+    {
+        auto*                  pDevice = this->GetDevice();
+        CompilationRecordScope Scope{pDevice != nullptr ? pDevice->GetCompilationStatisticsImpl() : nullptr,
+                                     COMPILATION_RECORD_TYPE_SHADER, this->m_Desc.ShaderType, this->m_Desc.Name};
+        InitShader(ShaderCI);
+        if (Scope.IsActive())
+        {
+            const void* pBytecode    = nullptr;
+            Uint64      BytecodeSize = 0;
+            this->GetBytecode(&pBytecode, BytecodeSize);
+            Scope.SetByteCodeSize(BytecodeSize);
+        }
+    }
+
     const std::string m_CombinedSamplerSuffix;
+
+    std::atomic<SHADER_STATUS> m_Status{SHADER_STATUS_UNINITIALIZED};
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+    RefCntAutoPtr<IAsyncTask>  m_pCompileTask;
 };
 
 } // namespace Diligent
@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::ShaderBindingTableBase template class
 
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <cstring>
 
 #include "ShaderBindingTable.h"
@@ -46,6 +48,14 @@ namespace Diligent
 /// Validates SBT description and throws an exception in case of an error.
 void ValidateShaderBindingTableDesc(const ShaderBindingTableDesc& Desc, Uint32 ShaderGroupHandleSize, Uint32 MaxShaderRecordStride) noexcept(false);
 
+/// Region of the shader binding table buffer that needs to be updated.
+struct SBTUploadRegion
+{
+    const void* pData  = nullptr;
+    Uint32      Offset = 0;
+    Uint32      Size   = 0;
+};
+
 /// Template class implementing base functionality of the shader binding table object.
 
 /// \tparam EngineImplTraits - Engine implementation type traits.
@@ -108,8 +118,11 @@ public:
         this->m_MissShadersRecord.clear();
         this->m_CallableShadersRecord.clear();
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
-        this->m_pPSO    = nullptr;
+        for (auto& Ranges : this->m_DirtyRanges)
+            Ranges.clear();
+        this->m_Changed    = true;
+        this->m_FullUpload = true;
+        this->m_pPSO       = nullptr;
 
         this->m_Desc.pPSO = pPSO;
 
@@ -135,7 +148,9 @@ public:
         this->m_DbgHitGroupBindings.clear();
 #endif
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
+        this->m_DirtyRanges[TABLE_HIT_GROUP].clear();
+        this->m_Changed    = true;
+        this->m_FullUpload = true;
     }
 
 
@@ -144,12 +159,7 @@ public:
         VERIFY_EXPR((pData == nullptr) == (DataSize == 0));
         VERIFY_EXPR((pData == nullptr) || (DataSize == this->m_ShaderRecordSize));
 
-        this->m_RayGenShaderRecord.resize(this->m_ShaderRecordStride, Uint8{EmptyElem});
-        this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_RayGenShaderRecord.data(), this->m_ShaderRecordStride);
-
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        std::memcpy(this->m_RayGenShaderRecord.data() + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        WriteShaderRecord(TABLE_RAY_GEN, 0, pShaderGroupName, pData, DataSize);
     }
 
 
@@ -158,14 +168,7 @@ public:
         VERIFY_EXPR((pData == nullptr) == (DataSize == 0));
         VERIFY_EXPR((pData == nullptr) || (DataSize == this->m_ShaderRecordSize));
 
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        const size_t Stride    = this->m_ShaderRecordStride;
-        const size_t Offset    = MissIndex * Stride;
-        this->m_MissShadersRecord.resize(std::max(this->m_MissShadersRecord.size(), Offset + Stride), Uint8{EmptyElem});
-
-        this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_MissShadersRecord.data() + Offset, Stride);
-        std::memcpy(this->m_MissShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        WriteShaderRecord(TABLE_MISS, size_t{MissIndex} * this->m_ShaderRecordStride, pShaderGroupName, pData, DataSize);
     }
 
 
@@ -177,15 +180,7 @@ public:
         VERIFY_EXPR((pData == nullptr) == (DataSize == 0));
         VERIFY_EXPR((pData == nullptr) || (DataSize == this->m_ShaderRecordSize));
 
-        const size_t Stride    = this->m_ShaderRecordStride;
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        const size_t Offset    = BindingIndex * Stride;
-
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
-
-        this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
-        std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        WriteShaderRecord(TABLE_HIT_GROUP, size_t{BindingIndex} * this->m_ShaderRecordStride, pShaderGroupName, pData, DataSize);
 
 #ifdef DILIGENT_DEVELOPMENT
         OnBindHitGroup(nullptr, BindingIndex);
@@ -218,16 +213,8 @@ public:
         const Uint32 GeometryIndex  = Desc.pBLAS->GetGeometryIndex(pGeometryName);
         VERIFY_EXPR(GeometryIndex != INVALID_INDEX);
 
-        const Uint32 Index     = InstanceOffset + GeometryIndex * Info.HitGroupStride + RayOffsetInHitGroupIndex;
-        const size_t Stride    = this->m_ShaderRecordStride;
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        const size_t Offset    = Index * Stride;
-
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
-
-        this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
-        std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        const Uint32 Index = InstanceOffset + GeometryIndex * Info.HitGroupStride + RayOffsetInHitGroupIndex;
+        WriteShaderRecord(TABLE_HIT_GROUP, size_t{Index} * this->m_ShaderRecordStride, pShaderGroupName, pData, DataSize);
 
 #ifdef DILIGENT_DEVELOPMENT
         VERIFY_EXPR(Index >= Info.FirstContributionToHitGroupIndex && Index <= Info.LastContributionToHitGroupIndex);
@@ -271,19 +258,14 @@ public:
 
         const Uint32 BeginIndex = InstanceOffset;
         const size_t EndIndex   = InstanceOffset + size_t{GeometryCount} * size_t{Info.HitGroupStride};
-        const Uint32 GroupSize  = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride     = this->m_ShaderRecordStride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), EndIndex * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
+        ResizeTable(TABLE_HIT_GROUP, EndIndex * Stride);
 
         for (Uint32 i = 0; i < GeometryCount; ++i)
         {
-            Uint32 Index  = BeginIndex + i * Info.HitGroupStride + RayOffsetInHitGroupIndex;
-            size_t Offset = Index * Stride;
-            this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
-
-            std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
+            Uint32 Index = BeginIndex + i * Info.HitGroupStride + RayOffsetInHitGroupIndex;
+            WriteShaderRecord(TABLE_HIT_GROUP, Index * Stride, pShaderGroupName, pData, DataSize);
 
 #ifdef DILIGENT_DEVELOPMENT
             VERIFY_EXPR(Index >= Info.FirstContributionToHitGroupIndex && Index <= Info.LastContributionToHitGroupIndex);
@@ -310,18 +292,14 @@ public:
                     Info.BindingMode == HIT_GROUP_BINDING_MODE_PER_TLAS);
         VERIFY_EXPR(RayOffsetInHitGroupIndex < Info.HitGroupStride);
 
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        const size_t Stride    = this->m_ShaderRecordStride;
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
+        const size_t Stride = this->m_ShaderRecordStride;
+        ResizeTable(TABLE_HIT_GROUP, (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride);
 
         for (Uint32 Index = RayOffsetInHitGroupIndex + Info.FirstContributionToHitGroupIndex;
              Index <= Info.LastContributionToHitGroupIndex;
              Index += Info.HitGroupStride)
         {
-            const size_t Offset = Index * Stride;
-            this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
-            std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
+            WriteShaderRecord(TABLE_HIT_GROUP, Index * Stride, pShaderGroupName, pData, DataSize);
 
 #ifdef DILIGENT_DEVELOPMENT
             OnBindHitGroup(pTLASImpl, Index);
@@ -338,13 +316,7 @@ public:
         VERIFY_EXPR((pData == nullptr) == (DataSize == 0));
         VERIFY_EXPR((pData == nullptr) || (DataSize == this->m_ShaderRecordSize));
 
-        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
-        const size_t Offset    = size_t{CallableIndex} * size_t{this->m_ShaderRecordStride};
-        this->m_CallableShadersRecord.resize(std::max(this->m_CallableShadersRecord.size(), Offset + this->m_ShaderRecordStride), Uint8{EmptyElem});
-
-        this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_CallableShadersRecord.data() + Offset, this->m_ShaderRecordStride);
-        std::memcpy(this->m_CallableShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        WriteShaderRecord(TABLE_CALLABLE, size_t{CallableIndex} * size_t{this->m_ShaderRecordStride}, pShaderGroupName, pData, DataSize);
     }
 
 
@@ -438,33 +410,45 @@ public:
 protected:
     struct BindingTable
     {
-        const void* pData  = nullptr;
-        Uint32      Size   = 0;
-        Uint32      Offset = 0;
-        Uint32      Stride = 0;
+        Uint32 Size   = 0;
+        Uint32 Offset = 0;
+        Uint32 Stride = 0;
     };
-    void GetData(BufferImplType*& pSBTBuffer,
-                 BindingTable&    RaygenShaderBindingTable,
-                 BindingTable&    MissShaderBindingTable,
-                 BindingTable&    HitShaderBindingTable,
-                 BindingTable&    CallableShaderBindingTable)
+
+    /// Returns the SBT buffer, the location of every table in the buffer and the regions of
+    /// the buffer that must be updated.
+    ///
+    /// \remarks   Only the records that have changed since the previous call are returned in Uploads,
+    ///             unless the buffer was recreated or the table layout has changed, in which case all
+    ///             tables are uploaded. Upload regions point to the internal data and are only valid
+    ///             until the SBT is modified.
+    void GetData(BufferImplType*&              pSBTBuffer,
+                 BindingTable&                 RaygenShaderBindingTable,
+                 BindingTable&                 MissShaderBindingTable,
+                 BindingTable&                 HitShaderBindingTable,
+                 BindingTable&                 CallableShaderBindingTable,
+                 std::vector<SBTUploadRegion>& Uploads)
     {
+        Uploads.clear();
+
         const auto ShaderGroupBaseAlignment = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupBaseAlignment;
 
         const auto AlignToLarger = [ShaderGroupBaseAlignment](size_t offset) -> Uint32 {
             return AlignUp(static_cast<Uint32>(offset), ShaderGroupBaseAlignment);
         };
 
-        const Uint32 RayGenOffset          = 0;
-        const Uint32 MissShaderOffset      = AlignToLarger(m_RayGenShaderRecord.size());
-        const Uint32 HitGroupOffset        = AlignToLarger(MissShaderOffset + m_MissShadersRecord.size());
-        const Uint32 CallableShadersOffset = AlignToLarger(HitGroupOffset + m_HitGroupsRecord.size());
-        const Uint32 BufSize               = AlignToLarger(CallableShadersOffset + m_CallableShadersRecord.size());
+        Uint32 TableOffsets[TABLE_COUNT] = {};
+        TableOffsets[TABLE_RAY_GEN]      = 0;
+        TableOffsets[TABLE_MISS]         = AlignToLarger(m_RayGenShaderRecord.size());
+        TableOffsets[TABLE_HIT_GROUP]    = AlignToLarger(TableOffsets[TABLE_MISS] + m_MissShadersRecord.size());
+        TableOffsets[TABLE_CALLABLE]     = AlignToLarger(TableOffsets[TABLE_HIT_GROUP] + m_HitGroupsRecord.size());
+        const Uint32 BufSize             = AlignToLarger(TableOffsets[TABLE_CALLABLE] + m_CallableShadersRecord.size());
 
         // Recreate buffer
         if (m_pBuffer == nullptr || m_pBuffer->GetDesc().Size < BufSize)
         {
-            m_pBuffer = nullptr;
+            m_pBuffer    = nullptr;
+            m_FullUpload = true;
 
             String     BuffName = String{this->m_Desc.Name} + " - internal buffer";
             BufferDesc BuffDesc;
@@ -482,39 +466,148 @@ protected:
 
         pSBTBuffer = m_pBuffer;
 
-        if (!m_RayGenShaderRecord.empty())
+        // If any table has moved, the data in the buffer is no longer valid
+        if (!std::equal(std::begin(TableOffsets), std::end(TableOffsets), std::begin(m_UploadedTableOffsets)))
+        {
+            m_FullUpload = true;
+            std::copy(std::begin(TableOffsets), std::end(TableOffsets), std::begin(m_UploadedTableOffsets));
+        }
+
+        BindingTable* Tables[TABLE_COUNT] = {};
+        Tables[TABLE_RAY_GEN]             = &RaygenShaderBindingTable;
+        Tables[TABLE_MISS]                = &MissShaderBindingTable;
+        Tables[TABLE_HIT_GROUP]           = &HitShaderBindingTable;
+        Tables[TABLE_CALLABLE]            = &CallableShaderBindingTable;
+
+        // Dirty ranges separated by less than this many bytes are uploaded with a single copy
+        const size_t MaxMergeGap = size_t{this->m_ShaderRecordStride} * 4;
+
+        for (Uint32 t = 0; t < TABLE_COUNT; ++t)
         {
-            RaygenShaderBindingTable.pData  = m_Changed ? m_RayGenShaderRecord.data() : nullptr;
-            RaygenShaderBindingTable.Offset = RayGenOffset;
-            RaygenShaderBindingTable.Size   = static_cast<Uint32>(m_RayGenShaderRecord.size());
-            RaygenShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            const auto& Table  = GetTable(static_cast<TABLE>(t));
+            auto&       Ranges = m_DirtyRanges[t];
+            if (Table.empty())
+            {
+                Ranges.clear();
+                continue;
+            }
+
+            Tables[t]->Offset = TableOffsets[t];
+            Tables[t]->Size   = static_cast<Uint32>(Table.size());
+            Tables[t]->Stride = this->m_ShaderRecordStride;
+
+            if (!m_Changed)
+                continue;
+
+            if (m_FullUpload)
+            {
+                Uploads.push_back({Table.data(), TableOffsets[t], static_cast<Uint32>(Table.size())});
+            }
+            else if (!Ranges.empty())
+            {
+                std::sort(Ranges.begin(), Ranges.end(), [](const DirtyRange& lhs, const DirtyRange& rhs) { return lhs.Begin < rhs.Begin; });
+
+                DirtyRange Merged = Ranges.front();
+                for (size_t i = 1; i <= Ranges.size(); ++i)
+                {
+                    if (i < Ranges.size() && Ranges[i].Begin <= Merged.End + MaxMergeGap)
+                    {
+                        Merged.End = std::max(Merged.End, Ranges[i].End);
+                        continue;
+                    }
+
+                    const size_t End = std::min(Merged.End, Table.size());
+                    if (Merged.Begin < End)
+                        Uploads.push_back({Table.data() + Merged.Begin, static_cast<Uint32>(TableOffsets[t] + Merged.Begin), static_cast<Uint32>(End - Merged.Begin)});
+
+                    if (i < Ranges.size())
+                        Merged = Ranges[i];
+                }
+            }
+            Ranges.clear();
         }
 
-        if (!m_MissShadersRecord.empty())
+        m_Changed    = false;
+        m_FullUpload = false;
+    }
+
+private:
+    enum TABLE : Uint32
+    {
+        TABLE_RAY_GEN = 0,
+        TABLE_MISS,
+        TABLE_HIT_GROUP,
+        TABLE_CALLABLE,
+        TABLE_COUNT
+    };
+
+    struct DirtyRange
+    {
+        size_t Begin = 0;
+        size_t End   = 0;
+    };
+
+    std::vector<Uint8>& GetTable(TABLE Table)
+    {
+        switch (Table)
         {
-            MissShaderBindingTable.pData  = m_Changed ? m_MissShadersRecord.data() : nullptr;
-            MissShaderBindingTable.Offset = MissShaderOffset;
-            MissShaderBindingTable.Size   = static_cast<Uint32>(m_MissShadersRecord.size());
-            MissShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            // clang-format off
+            case TABLE_RAY_GEN:   return m_RayGenShaderRecord;
+            case TABLE_MISS:      return m_MissShadersRecord;
+            case TABLE_HIT_GROUP: return m_HitGroupsRecord;
+            case TABLE_CALLABLE:  return m_CallableShadersRecord;
+            // clang-format on
+            default:
+                UNEXPECTED("Unexpected table");
+                return m_RayGenShaderRecord;
         }
+    }
 
-        if (!m_HitGroupsRecord.empty())
+    void AddDirtyRange(TABLE Table, size_t Begin, size_t End)
+    {
+        auto& Ranges = m_DirtyRanges[Table];
+        // Records are often bound sequentially, so try to extend the last range first
+        if (!Ranges.empty() && Begin <= Ranges.back().End && End >= Ranges.back().Begin)
+        {
+            Ranges.back().Begin = std::min(Ranges.back().Begin, Begin);
+            Ranges.back().End   = std::max(Ranges.back().End, End);
+        }
+        else
         {
-            HitShaderBindingTable.pData  = m_Changed ? m_HitGroupsRecord.data() : nullptr;
-            HitShaderBindingTable.Offset = HitGroupOffset;
-            HitShaderBindingTable.Size   = static_cast<Uint32>(m_HitGroupsRecord.size());
-            HitShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            Ranges.push_back({Begin, End});
         }
+        m_Changed = true;
+    }
 
-        if (!m_CallableShadersRecord.empty())
+    void ResizeTable(TABLE Table, size_t Size)
+    {
+        auto& Data = GetTable(Table);
+        if (Data.size() < Size)
         {
-            CallableShaderBindingTable.pData  = m_Changed ? m_CallableShadersRecord.data() : nullptr;
-            CallableShaderBindingTable.Offset = CallableShadersOffset;
-            CallableShaderBindingTable.Size   = static_cast<Uint32>(m_CallableShadersRecord.size());
-            CallableShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            AddDirtyRange(Table, Data.size(), Size);
+            Data.resize(Size, Uint8{EmptyElem});
         }
+    }
+
+    // Writes the shader record at the given offset and marks it as dirty if its content has changed.
+    void WriteShaderRecord(TABLE Table, size_t Offset, const char* pShaderGroupName, const void* pData, Uint32 DataSize)
+    {
+        const size_t Stride    = this->m_ShaderRecordStride;
+        const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
+
+        ResizeTable(Table, Offset + Stride);
+
+        Uint8* pRecord = GetTable(Table).data() + Offset;
+        m_TmpRecord.assign(pRecord, pRecord + Stride);
+        this->m_pPSO->CopyShaderHandle(pShaderGroupName, m_TmpRecord.data(), Stride);
+        if (DataSize > 0)
+            std::memcpy(m_TmpRecord.data() + GroupSize, pData, DataSize);
 
-        m_Changed = false;
+        if (std::memcmp(pRecord, m_TmpRecord.data(), Stride) != 0)
+        {
+            std::memcpy(pRecord, m_TmpRecord.data(), Stride);
+            AddDirtyRange(Table, Offset, Offset + Stride);
+        }
     }
 
 protected:
@@ -539,6 +632,17 @@ protected:
 #endif
 
 private:
+    // Byte ranges of the records that have changed since the last GetData() call
+    std::vector<DirtyRange> m_DirtyRanges[TABLE_COUNT];
+
+    // Table offsets in the buffer at the time of the last upload
+    Uint32 m_UploadedTableOffsets[TABLE_COUNT] = {};
+
+    // Indicates that all tables must be uploaded, e.g. after Reset()
+    bool m_FullUpload = true;
+
+    std::vector<Uint8> m_TmpRecord;
+
 #ifdef DILIGENT_DEVELOPMENT
     struct HitGroupBinding
     {
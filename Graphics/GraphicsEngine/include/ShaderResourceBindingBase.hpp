@@ -43,6 +43,8 @@
 #include "ShaderResourceCacheCommon.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
+#include "InlineConstantsData.hpp"
 
 namespace Diligent
 {
@@ -122,6 +124,8 @@ public:
                 const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
                 m_pShaderVarMgrs[MgrInd].Initialize(*pPRS, VarDataAllocator, VarTypes, _countof(VarTypes), ShaderType);
             }
+
+            CreateInlineConstantBuffers();
         }
         catch (...)
         {
@@ -265,6 +269,95 @@ public:
         return StaleVarTypes;
     }
 
+    /// Implementation of IShaderResourceBinding::SetResources().
+    virtual void DILIGENT_CALL_TYPE SetResources(const ShaderResourceVariableLocation* pLocations,
+                                                 IDeviceObject* const*                 ppObjects,
+                                                 Uint32                                NumResources,
+                                                 SET_SHADER_RESOURCE_FLAGS             Flags) override final
+    {
+        DEV_CHECK_ERR(NumResources == 0 || (pLocations != nullptr && ppObjects != nullptr), "pLocations and ppObjects must not be null");
+
+        const auto PipelineType = GetPipelineType();
+
+        // Locations are typically grouped by shader stage, so only look up the manager when the stage changes
+        SHADER_TYPE                    CurrShaderType = SHADER_TYPE_UNKNOWN;
+        ShaderVariableManagerImplType* pVarMgr        = nullptr;
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            const auto& Location = pLocations[i];
+            if (Location.ShaderType != CurrShaderType)
+            {
+                CurrShaderType = Location.ShaderType;
+                pVarMgr        = nullptr;
+                if (IsConsistentShaderType(CurrShaderType, PipelineType))
+                {
+                    const auto MgrInd = m_ActiveShaderStageIndex[GetShaderTypePipelineIndex(CurrShaderType, PipelineType)];
+                    if (MgrInd >= 0)
+                        pVarMgr = &m_pShaderVarMgrs[MgrInd];
+                }
+            }
+
+            if (pVarMgr == nullptr)
+            {
+                DEV_ERROR("Unable to set resource ", i, ": shader stage ", GetShaderTypeLiteralName(Location.ShaderType),
+                          " has no mutable or dynamic variables in pipeline resource signature '", m_pPRS->GetDesc().Name, "'.");
+                continue;
+            }
+
+            auto* pVar = pVarMgr->GetVariable(Location.VariableIndex);
+            if (pVar == nullptr)
+                continue;
+
+            auto* pObject = ppObjects[i];
+            if (pVar->Get(Location.ArrayIndex) == pObject)
+                continue;
+
+            pVar->SetArray(&pObject, Location.ArrayIndex, 1, Flags);
+        }
+    }
+
+    /// Copies mutable and dynamic resources from another SRB created from the same signature.
+    /// Inline constant values are copied to this SRB's own inline constant buffers.
+    void CopyResources(const ShaderResourceBindingBase& SrcSRB)
+    {
+        VERIFY(SrcSRB.m_pPRS == m_pPRS, "Source SRB must be created from the same signature");
+
+        for (Uint32 s = 0; s < GetNumShaders(); ++s)
+        {
+            const auto& SrcMgr = SrcSRB.m_pShaderVarMgrs[s];
+            auto&       DstMgr = m_pShaderVarMgrs[s];
+            VERIFY_EXPR(SrcMgr.GetVariableCount() == DstMgr.GetVariableCount());
+            for (Uint32 v = 0; v < SrcMgr.GetVariableCount(); ++v)
+            {
+                auto* pSrcVar = SrcMgr.GetVariable(v);
+                auto* pDstVar = DstMgr.GetVariable(v);
+
+                ShaderResourceDesc ResDesc;
+                pSrcVar->GetResourceDesc(ResDesc);
+                for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+                {
+                    auto* pSrcObj = pSrcVar->Get(ArrInd);
+                    auto* pDstObj = pDstVar->Get(ArrInd);
+                    if (pSrcObj == nullptr || pSrcObj == pDstObj)
+                        continue;
+
+                    // Every SRB owns its inline constant buffers: copy the values, not the buffer
+                    RefCntAutoPtr<InlineConstantsData> pSrcData{pSrcObj->GetUserData(), IID_InlineConstantsData};
+                    if (pSrcData)
+                    {
+                        RefCntAutoPtr<InlineConstantsData> pDstData{pDstObj != nullptr ? pDstObj->GetUserData() : nullptr, IID_InlineConstantsData};
+                        VERIFY(pDstData && pDstData->GetNumConstants() == pSrcData->GetNumConstants(), "Inconsistent inline constants");
+                        if (pDstData)
+                            pDstData->Update(pSrcData->GetData(), 0, pSrcData->GetNumConstants());
+                        continue;
+                    }
+
+                    pDstVar->SetArray(&pSrcObj, ArrInd, 1, SET_SHADER_RESOURCE_FLAG_NONE);
+                }
+            }
+        }
+    }
+
     ShaderResourceCacheImplType&       GetResourceCache() { return m_ShaderResourceCache; }
     const ShaderResourceCacheImplType& GetResourceCache() const { return m_ShaderResourceCache; }
 
@@ -284,6 +377,56 @@ private:
         }
     }
 
+    // Creates a buffer for every inline constants resource and binds it to the variable.
+    void CreateInlineConstantBuffers()
+    {
+        const auto* const pPRS = GetSignature();
+        for (const auto& InlineConsts : pPRS->GetInlineConstants())
+        {
+            const auto& ResDesc = pPRS->GetResourceDesc(InlineConsts.ResIndex);
+            VERIFY(ResDesc.VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC,
+                   "Static inline constants are not allowed. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
+
+            auto* const pDevice = pPRS->GetDevice();
+
+            const std::string BufferName = std::string{"Inline constants '"} + ResDesc.Name + "'";
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = BufferName.c_str();
+            BuffDesc.Size           = AlignUp(Uint64{InlineConsts.NumConstants} * sizeof(Uint32), Uint64{16});
+            BuffDesc.Usage          = USAGE_DYNAMIC;
+            BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            // Inline constants may be set in any immediate context
+            BuffDesc.ImmediateContextMask = (Uint64{1} << pDevice->GetNumImmediateContexts()) - 1;
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+            if (!pBuffer)
+                LOG_ERROR_AND_THROW("Failed to create the buffer for inline constants '", ResDesc.Name, "'.");
+
+            RefCntAutoPtr<InlineConstantsData> pData{MakeNewRCObj<InlineConstantsData>()(InlineConsts.NumConstants)};
+            pBuffer->SetUserData(pData);
+
+            // All shader stages share the same cache entry, so it is enough to set the
+            // buffer through the variable of the first stage that uses the resource.
+            for (Uint32 s = 0; s < GetNumShaders(); ++s)
+            {
+                const auto ShaderType = pPRS->GetActiveShaderStageType(s);
+                if ((ResDesc.ShaderStages & ShaderType) == 0)
+                    continue;
+
+                const auto MgrInd = m_ActiveShaderStageIndex[GetShaderTypePipelineIndex(ShaderType, pPRS->GetPipelineType())];
+                VERIFY_EXPR(MgrInd >= 0);
+                if (auto* pVar = m_pShaderVarMgrs[MgrInd].GetVariable(ResDesc.Name))
+                {
+                    pVar->Set(pBuffer, SET_SHADER_RESOURCE_FLAG_NONE);
+                    break;
+                }
+            }
+        }
+    }
+
     template <typename HandlerType>
     void ProcessVariables(SHADER_TYPE   ShaderStages,
                           HandlerType&& Handler) const
@@ -32,9 +32,14 @@
 
 #include <unordered_map>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 #include "DeviceObject.h"
 #include "STDAllocator.hpp"
+#include "FixedLinearAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -60,17 +65,38 @@ namespace Diligent
 /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
 /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
 /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+/// \remarks
+/// The registry is split into NumShards independently locked shards selected by the
+/// descriptor hash. Find() only takes a shared lock of one shard, so that concurrent lookups
+/// do not block each other, while Add() exclusively locks a single shard. Expired references are
+/// purged incrementally: every Add() that observes enough outstanding deleted objects purges
+/// one shard in round-robin order.
 template <typename ResourceDescType>
 class StateObjectsRegistry
 {
 public:
-    /// Number of outstanding deleted objects to purge the registry.
+    /// Number of outstanding deleted objects to start purging the registry.
     static constexpr int DeletedObjectsToPurge = 32;
 
+    /// Number of independently locked shards.
+    static constexpr Uint32 NumShards = 16;
+
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
         m_RegistryName{RegistryName}
-    {}
+    {
+        FixedLinearAllocator Allocator{RawAllocator};
+        Allocator.AddSpace<ShardType>(NumShards);
+        Allocator.Reserve();
+        m_pRawMemory = decltype(m_pRawMemory){Allocator.ReleaseOwnership(), STDDeleterRawMem<void>{RawAllocator}};
+        m_Shards     = Allocator.ConstructArray<ShardType>(NumShards, &RawAllocator);
+    }
+
+    // clang-format off
+    StateObjectsRegistry           (const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry           (      StateObjectsRegistry&&) = delete;
+    StateObjectsRegistry& operator=(const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry& operator=(      StateObjectsRegistry&&) = delete;
+    // clang-format on
 
     ~StateObjectsRegistry()
     {
@@ -80,7 +106,11 @@ public:
         // may only be expired references in the registry. After we
         // purge it, the registry must be empty.
         Purge();
-        VERIFY(m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty");
+        for (Uint32 i = 0; i < NumShards; ++i)
+        {
+            VERIFY(m_Shards[i].Map.empty(), "DescToObjHashMap is not empty");
+            m_Shards[i].~ShardType();
+        }
     }
 
     /// Adds a new object to the registry
@@ -89,26 +119,22 @@ public:
     /// \param [in] pObject - pointer to the object.
     ///
     /// Besides adding a new object, the function also checks the number of
-    /// outstanding deleted objects and calls Purge() if the number has reached
-    /// the threshold value DeletedObjectsToPurge. Creating a state object is
-    /// assumed to be an expensive operation and should be performed during
-    /// the initialization. Occasional purge operations should not add significant
-    /// cost to it.
+    /// outstanding deleted objects and, if the number has reached the threshold
+    /// value DeletedObjectsToPurge, purges the next shard in round-robin order.
+    /// Spreading the purge over multiple calls bounds the cost of a single Add()
+    /// and only blocks lookups of one shard at a time.
     void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
     {
-        Threading::SpinLockGuard Guard{m_Lock};
-
-        // If the number of outstanding deleted objects reached the threshold value,
-        // purge the registry. Since we have exclusive access now, it is safe
-        // to do.
         if (m_NumDeletedObjects.load() >= DeletedObjectsToPurge)
-        {
-            Purge();
-            m_NumDeletedObjects.store(0);
-        }
+            PurgeNextShard();
+
+        HashedDesc Key{ObjectDesc};
+        auto&      Shard = GetShard(Key.Hash);
+
+        std::unique_lock<std::shared_timed_mutex> Lock{Shard.Mtx};
 
         // Try to construct the new element in place
-        auto it_inserted = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
+        auto it_inserted = Shard.Map.emplace(std::move(Key), Diligent::RefCntWeakPtr<IDeviceObject>(pObject));
         // It is theoretically possible that the same object can be found
         // in the registry. This might happen if two threads try to create
         // the same object at the same time. They both will not find the
@@ -125,53 +151,154 @@ public:
         if (!it_inserted.second)
         {
             auto& it = it_inserted.first;
-            VERIFY(it->first == ObjectDesc, "Incorrect object description");
+            VERIFY(it->first.Desc == ObjectDesc, "Incorrect object description");
             // This message likely adds no value
-            //LOG_INFO_MESSAGE("Object '", (it->first.Name ? it->first.Name : "<unnamed>"),
+            //LOG_INFO_MESSAGE("Object '", (it->first.Desc.Name ? it->first.Desc.Name : "<unnamed>"),
             //                 "' with the same description already exists in the ",
             //                 m_RegistryName, " registry. Replacing with the new object '",
             //                 (ObjectDesc.Name ? ObjectDesc.Name : "<unnamed>"), "'.");
+            if (!it->second.IsValid())
+            {
+                // Expired reference is replaced: it no longer needs to be purged
+                m_NumDeletedObjects.fetch_add(-1);
+            }
             it->second = pObject;
         }
     }
 
     /// Finds the object in the registry
+
+    /// \remarks Only a shared lock of a single shard is taken, so concurrent
+    ///          lookups never block each other. Expired references are not
+    ///          removed here, but are replaced by Add() or purged later.
     void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
         *ppObject = nullptr;
-        Threading::SpinLockGuard Guard{m_Lock};
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
+        const HashedDesc Key{Desc};
+        auto&            Shard = GetShard(Key.Hash);
+
+        std::shared_lock<std::shared_timed_mutex> Lock{Shard.Mtx};
+
+        auto It = Shard.Map.find(Key);
+        if (It != Shard.Map.end())
         {
             // Try to obtain strong reference to the object.
             // This is an atomic operation and we either get
             // a new strong reference or object has been destroyed
             // and we get null.
-            if (auto pObject = It->second.Lock())
+            // Lock() releases an expired weak pointer, so it must be called on
+            // a local copy: the shard is only locked for reading and other
+            // threads may be accessing the same reference concurrently.
+            RefCntWeakPtr<IDeviceObject> wpObject{It->second};
+            if (auto pObject = wpObject.Lock())
             {
                 *ppObject = pObject.Detach();
                 //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
             }
-            else
-            {
-                // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
-                m_NumDeletedObjects.fetch_add(-1);
-            }
         }
     }
 
-    /// Purges outstanding deleted objects from the registry
+    /// Purges outstanding deleted objects from all shards of the registry
     void Purge()
     {
         Uint32 NumPurgedObjects = 0;
-        auto   It               = m_DescToObjHashMap.begin();
-        while (It != m_DescToObjHashMap.end())
+        for (Uint32 i = 0; i < NumShards; ++i)
+        {
+            auto& Shard = m_Shards[i];
+
+            std::unique_lock<std::shared_timed_mutex> Lock{Shard.Mtx};
+            NumPurgedObjects += PurgeShard(Shard);
+        }
+        if (NumPurgedObjects > 0)
+            LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
+    }
+
+    /// Returns the total number of references in all shards, including expired ones
+    size_t GetSize()
+    {
+        size_t Size = 0;
+        for (Uint32 i = 0; i < NumShards; ++i)
+        {
+            auto& Shard = m_Shards[i];
+
+            std::shared_lock<std::shared_timed_mutex> Lock{Shard.Mtx};
+            Size += Shard.Map.size();
+        }
+        return Size;
+    }
+
+    /// Increments the number of outstanding deleted objects.
+    /// When this number reaches DeletedObjectsToPurge, Add() will
+    /// start purging the registry shard by shard.
+    void ReportDeletedObject()
+    {
+        m_NumDeletedObjects.fetch_add(+1);
+    }
+
+private:
+    /// Resource description with the hash computed once at construction,
+    /// so that it is not recomputed by the hash map and the shard selection.
+    struct HashedDesc
+    {
+        explicit HashedDesc(const ResourceDescType& _Desc) :
+            Desc{_Desc},
+            Hash{std::hash<ResourceDescType>{}(_Desc)}
+        {}
+
+        bool operator==(const HashedDesc& Other) const
+        {
+            return Hash == Other.Hash && Desc == Other.Desc;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const HashedDesc& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+
+        ResourceDescType Desc;
+        size_t           Hash;
+    };
+
+    using HashMapElem = std::pair<const HashedDesc, RefCntWeakPtr<IDeviceObject>>;
+    using HashMapType = std::unordered_map<HashedDesc, RefCntWeakPtr<IDeviceObject>, typename HashedDesc::Hasher, std::equal_to<HashedDesc>, STDAllocatorRawMem<HashMapElem>>;
+
+    struct ShardType
+    {
+        explicit ShardType(IMemoryAllocator* pRawAllocator) :
+            Map{STD_ALLOCATOR_RAW_MEM(HashMapElem, *pRawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")}
+        {}
+
+        /// Mutex that protects the shard's map
+        std::shared_timed_mutex Mtx;
+
+        /// Hash map that stores weak pointers to the referenced objects
+        HashMapType Map;
+    };
+
+    ShardType& GetShard(size_t Hash)
+    {
+        // Use Fibonacci hashing to pick the shard from the high bits of the mixed hash,
+        // so that shards are not correlated with the buckets of the per-shard maps.
+        static_assert((NumShards & (NumShards - 1)) == 0, "NumShards must be a power of two");
+        constexpr Uint32 ShardBits = 4;
+        static_assert((1u << ShardBits) == NumShards, "ShardBits is inconsistent with NumShards");
+        const Uint64 MixedHash = static_cast<Uint64>(Hash) * Uint64{0x9E3779B97F4A7C15ull};
+        return m_Shards[static_cast<size_t>(MixedHash >> (64u - ShardBits))];
+    }
+
+    /// Removes expired references from the shard and returns the number of removed
+    /// elements. The shard must be exclusively locked by the caller.
+    Uint32 PurgeShard(ShardType& Shard)
+    {
+        Uint32 NumPurgedObjects = 0;
+        auto   It               = Shard.Map.begin();
+        while (It != Shard.Map.end())
         {
-            auto NextIt = It;
-            ++NextIt;
             // Note that IsValid() is not a thread-safe function in the sense that it
             // can give false positive results. The only thread-safe way to check if the
             // object is alive is to lock the weak pointer, but that requires thread
@@ -182,34 +309,38 @@ public:
             // pointer as it will definitely be removed next time.
             if (!It->second.IsValid())
             {
-                m_DescToObjHashMap.erase(It);
+                It = Shard.Map.erase(It);
                 ++NumPurgedObjects;
             }
-
-            It = NextIt;
+            else
+            {
+                ++It;
+            }
         }
-        if (NumPurgedObjects > 0)
-            LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
+        m_NumDeletedObjects.fetch_add(-static_cast<long>(NumPurgedObjects));
+        return NumPurgedObjects;
     }
 
-    /// Increments the number of outstanding deleted objects.
-    /// When this number reaches DeletedObjectsToPurge, Purge() will
-    /// be called.
-    void ReportDeletedObject()
+    void PurgeNextShard()
     {
-        m_NumDeletedObjects.fetch_add(+1);
+        auto& Shard = m_Shards[m_NextShardToPurge.fetch_add(1) % NumShards];
+
+        // Do not wait if the shard is busy: the next Add() will purge another one.
+        std::unique_lock<std::shared_timed_mutex> Lock{Shard.Mtx, std::try_to_lock};
+        if (Lock.owns_lock())
+            PurgeShard(Shard);
     }
 
-private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    Threading::SpinLock m_Lock;
+    /// Registry shards. Each shard is protected by its own mutex.
+    ShardType* m_Shards = nullptr;
+
+    std::unique_ptr<void, STDDeleterRawMem<void>> m_pRawMemory;
 
     /// Number of outstanding deleted objects that have not been purged
     std::atomic<long> m_NumDeletedObjects{0};
 
-    /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    /// Index of the shard that will be purged next
+    std::atomic<Uint32> m_NextShardToPurge{0};
 
     /// Registry name used for debug output
     const String m_RegistryName;
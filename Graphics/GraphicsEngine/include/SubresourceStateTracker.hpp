@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SubresourceStateTracker class
+
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Tracks resource states of individual mip levels and array slices of a texture.
+
+/// Subresources are ordered slice-major (Slice * MipLevels + Mip), and the states are stored
+/// as runs of subresources that share the same state. A texture whose subresources are all in
+/// the same state is represented by a single run.
+class SubresourceStateTracker
+{
+public:
+    /// A rectangular range of subresources.
+    struct Range
+    {
+        Uint32 FirstMip   = 0;
+        Uint32 NumMips    = 0;
+        Uint32 FirstSlice = 0;
+        Uint32 NumSlices  = 0;
+
+        bool operator==(const Range& Other) const
+        {
+            return FirstMip == Other.FirstMip && NumMips == Other.NumMips && FirstSlice == Other.FirstSlice && NumSlices == Other.NumSlices;
+        }
+    };
+
+    SubresourceStateTracker(Uint32 MipLevels, Uint32 ArraySlices, RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN);
+
+    Uint32 GetMipLevels() const { return m_MipLevels; }
+    Uint32 GetArraySlices() const { return m_ArraySlices; }
+
+    /// Returns true if the range addresses all subresources.
+    bool IsFullRange(const Range& R) const
+    {
+        return R.FirstMip == 0 && R.NumMips == m_MipLevels && R.FirstSlice == 0 && R.NumSlices == m_ArraySlices;
+    }
+
+    /// Sets the state of all subresources.
+    void SetState(RESOURCE_STATE State);
+
+    /// Sets the state of the subresources in the range.
+    void SetState(const Range& R, RESOURCE_STATE State);
+
+    /// Returns the state of a single subresource.
+    RESOURCE_STATE GetState(Uint32 Mip, Uint32 Slice) const;
+
+    /// Returns true if all subresources are in the same state.
+    bool IsUniform() const { return m_Runs.size() == 1; }
+
+    /// Returns the state of all subresources if it is the same, and RESOURCE_STATE_UNKNOWN otherwise.
+    RESOURCE_STATE GetUniformState() const
+    {
+        return IsUniform() ? m_Runs[0].State : RESOURCE_STATE_UNKNOWN;
+    }
+
+    /// Returns the number of runs of subresources that share the same state.
+    size_t GetRunCount() const { return m_Runs.size(); }
+
+    /// Calls Handler(const Range&, RESOURCE_STATE) for the subresources in range R, grouped into
+    /// as few rectangular ranges as possible. Every subresource in R is visited exactly once.
+    template <typename HandlerType>
+    void ProcessRange(const Range& R, HandlerType&& Handler) const;
+
+private:
+    struct Run
+    {
+        Uint32         End;   // Index of the first subresource after the run
+        RESOURCE_STATE State; // State of all subresources in the run
+    };
+
+    struct Segment
+    {
+        Uint32         FirstMip;
+        Uint32         NumMips;
+        RESOURCE_STATE State;
+
+        bool operator==(const Segment& Other) const
+        {
+            return FirstMip == Other.FirstMip && NumMips == Other.NumMips && State == Other.State;
+        }
+    };
+
+    void SetState(Uint32 Begin, Uint32 End, RESOURCE_STATE State);
+    void GetSegments(Uint32 Slice, Uint32 FirstMip, Uint32 NumMips, std::vector<Segment>& Segments) const;
+
+    void VerifyRange(const Range& R) const
+    {
+        VERIFY(R.FirstMip + R.NumMips <= m_MipLevels, "Mip range [", R.FirstMip, ", ", R.FirstMip + R.NumMips, ") is out of bounds");
+        VERIFY(R.FirstSlice + R.NumSlices <= m_ArraySlices, "Slice range [", R.FirstSlice, ", ", R.FirstSlice + R.NumSlices, ") is out of bounds");
+    }
+
+    const Uint32 m_MipLevels;
+    const Uint32 m_ArraySlices;
+
+    // Runs are sorted by End, adjacent runs always have different states.
+    std::vector<Run> m_Runs;
+};
+
+template <typename HandlerType>
+void SubresourceStateTracker::ProcessRange(const Range& R, HandlerType&& Handler) const
+{
+    VerifyRange(R);
+    if (R.NumMips == 0 || R.NumSlices == 0)
+        return;
+
+    if (IsUniform())
+    {
+        Handler(R, m_Runs[0].State);
+        return;
+    }
+
+    // Consecutive slices with identical mip segments are merged into one range
+    std::vector<Segment> PendingSegments, Segments;
+    Uint32               PendingFirstSlice = R.FirstSlice;
+
+    const auto FlushPending = [&](Uint32 EndSlice) {
+        for (const auto& Seg : PendingSegments)
+            Handler(Range{Seg.FirstMip, Seg.NumMips, PendingFirstSlice, EndSlice - PendingFirstSlice}, Seg.State);
+    };
+
+    for (Uint32 Slice = R.FirstSlice; Slice < R.FirstSlice + R.NumSlices; ++Slice)
+    {
+        GetSegments(Slice, R.FirstMip, R.NumMips, Segments);
+        if (Slice == R.FirstSlice || Segments != PendingSegments)
+        {
+            FlushPending(Slice);
+            PendingSegments.swap(Segments);
+            PendingFirstSlice = Slice;
+        }
+    }
+    FlushPending(R.FirstSlice + R.NumSlices);
+}
+
+} // namespace Diligent
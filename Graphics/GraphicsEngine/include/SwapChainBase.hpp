@@ -30,6 +30,8 @@
 /// \file
 /// Implementation of the Diligent::SwapChainBase template class
 
+#include <algorithm>
+
 #include "RenderDevice.h"
 #include "DeviceContext.h"
 #include "SwapChain.h"
@@ -95,7 +97,28 @@ public:
     virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override
     {}
 
+    /// Implementation of ISwapChain::GetFramePacingStats()
+    virtual const FramePacingStats& DILIGENT_CALL_TYPE GetFramePacingStats() const override final
+    {
+        return m_FramePacingStats;
+    }
+
 protected:
+    /// Updates the frame pacing statistics when the presentation engine reports the display time of a frame.
+
+    /// \param PresentLatency - Time, in seconds, between the Present() call and the moment the frame was displayed.
+    /// \param MissedVBlanks  - The number of vertical blanks the frame missed.
+    void OnFrameDisplayed(double PresentLatency, Uint32 MissedVBlanks)
+    {
+        m_TotalPresentLatency += PresentLatency;
+
+        ++m_FramePacingStats.DisplayedFrameCount;
+        m_FramePacingStats.MissedVBlankCount += MissedVBlanks;
+        m_FramePacingStats.LastPresentLatency = PresentLatency;
+        m_FramePacingStats.AvgPresentLatency  = m_TotalPresentLatency / static_cast<double>(m_FramePacingStats.DisplayedFrameCount);
+        m_FramePacingStats.MaxPresentLatency  = (std::max)(m_FramePacingStats.MaxPresentLatency, PresentLatency);
+    }
+
     bool Resize(Uint32 NewWidth, Uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform, Int32 Dummy = 0 /*To be different from virtual function*/)
     {
         if (NewWidth != 0 && NewHeight != 0 &&
@@ -125,6 +148,11 @@ protected:
 
     /// Desired surface pre-transformation.
     SURFACE_TRANSFORM m_DesiredPreTransform = SURFACE_TRANSFORM_OPTIMAL;
+
+    /// Frame pacing statistics, see OnFrameDisplayed().
+    FramePacingStats m_FramePacingStats;
+
+    double m_TotalPresentLatency = 0;
 };
 
 } // namespace Diligent
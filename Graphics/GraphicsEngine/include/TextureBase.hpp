@@ -39,7 +39,9 @@
 #include "GraphicsAccessories.hpp"
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
+#include "GPUMemoryTracker.hpp"
 #include "PlatformMisc.hpp"
+#include "SubresourceStateTracker.hpp"
 
 namespace Diligent
 {
@@ -140,6 +142,9 @@ public:
 
         if ((this->m_Desc.BindFlags & BIND_INPUT_ATTACHMENT) != 0)
             this->m_Desc.BindFlags |= BIND_SHADER_RESOURCE;
+
+        if ((this->m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SUBRESOURCE_STATES) != 0)
+            m_pSubresStates = std::make_unique<SubresourceStateTracker>(this->m_Desc.MipLevels, this->m_Desc.GetArraySize());
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Texture, TDeviceObjectBase)
@@ -284,6 +289,55 @@ public:
     virtual void DILIGENT_CALL_TYPE SetState(RESOURCE_STATE State) override final
     {
         this->m_State = State;
+        if (m_pSubresStates)
+            m_pSubresStates->SetState(State);
+    }
+
+    /// Sets the state of the subresource range. If the texture does not track subresource states
+    /// (see Diligent::MISC_TEXTURE_FLAG_SUBRESOURCE_STATES), sets the state of the whole texture.
+    void SetSubresourceState(const SubresourceStateTracker::Range& Range, RESOURCE_STATE State)
+    {
+        if (!m_pSubresStates)
+        {
+            this->m_State = State;
+            return;
+        }
+
+        m_pSubresStates->SetState(Range, State);
+        // The texture state is unknown while its subresources are in different states
+        this->m_State = m_pSubresStates->GetUniformState();
+    }
+
+    /// Returns the subresource state tracker, or null if the texture does not track subresource states.
+    const SubresourceStateTracker* GetSubresourceStates() const
+    {
+        return m_pSubresStates.get();
+    }
+
+    /// Returns true if the subresources of the texture are in different states.
+    bool HasSubresourceStates() const
+    {
+        return m_pSubresStates && !m_pSubresStates->IsUniform();
+    }
+
+    /// Returns the range of subresources addressed by the texture view.
+    SubresourceStateTracker::Range GetSubresourceRange(const TextureViewDesc& ViewDesc) const
+    {
+        SubresourceStateTracker::Range Range;
+        Range.FirstMip = ViewDesc.MostDetailedMip;
+        Range.NumMips  = ViewDesc.NumMipLevels;
+        if (this->m_Desc.IsArray())
+        {
+            Range.FirstSlice = ViewDesc.FirstArraySlice;
+            Range.NumSlices  = ViewDesc.NumArraySlices;
+        }
+        else
+        {
+            // Depth slices of 3D textures are not separate subresources
+            Range.FirstSlice = 0;
+            Range.NumSlices  = 1;
+        }
+        return Range;
     }
 
     virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetState() const override final
@@ -359,6 +413,38 @@ protected:
         m_pDefaultViews = nullptr;
     }
 
+    /// Registers the texture memory in the device GPU memory tracker.
+
+    /// \param [in] Type          - Allocation type.
+    /// \param [in] AllocatedSize - The size of the memory occupied by the texture, including
+    ///                             the padding, alignment and tiling. Must be zero for placed textures.
+    void RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE Type, Uint64 AllocatedSize)
+    {
+        GPUMemoryTracker* pTracker = this->GetDevice()->GetGPUMemoryTracker();
+        if (pTracker == nullptr)
+            return;
+
+        m_GPUMemoryRecord = GPUMemoryRecord{pTracker, GPU_MEMORY_CATEGORY_TEXTURE, Type, this->m_Desc.Name, GetTexelDataSize(), AllocatedSize};
+    }
+
+    /// Registers the texture memory in the device GPU memory tracker when the backend
+    /// can't query the allocation size. The texel data size is used as the allocated size.
+    void RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE Type)
+    {
+        GPUMemoryTracker* pTracker = this->GetDevice()->GetGPUMemoryTracker();
+        if (pTracker == nullptr)
+            return;
+
+        const Uint64 Size = GetTexelDataSize();
+        m_GPUMemoryRecord = GPUMemoryRecord{pTracker, GPU_MEMORY_CATEGORY_TEXTURE, Type, this->m_Desc.Name, Size, Type != GPU_MEMORY_ALLOCATION_TYPE_PLACED ? Size : 0};
+    }
+
+    /// Returns the size of the tightly packed texel data of all subresources.
+    Uint64 GetTexelDataSize() const
+    {
+        return GetStagingTextureSubresourceOffset(this->m_Desc, this->m_Desc.GetArraySize(), 0, 1) * std::max(Uint32{this->m_Desc.SampleCount}, 1u);
+    }
+
     /// Pure virtual function that is implemented in every backend.
     virtual void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) = 0;
 
@@ -395,7 +481,12 @@ protected:
 
     RESOURCE_STATE m_State = RESOURCE_STATE_UNKNOWN;
 
+    // Per-subresource states of textures created with MISC_TEXTURE_FLAG_SUBRESOURCE_STATES flag
+    std::unique_ptr<SubresourceStateTracker> m_pSubresStates;
+
     std::unique_ptr<SparseTextureProperties> m_pSparseProps;
+
+    GPUMemoryRecord m_GPUMemoryRecord;
 };
 
 } // namespace Diligent
@@ -32,13 +32,17 @@
 
 #include <unordered_map>
 #include <atomic>
+#include <vector>
+#include <algorithm>
 
 #include "TopLevelAS.h"
+#include "Buffer.h"
 #include "BottomLevelASBase.hpp"
 #include "DeviceObjectBase.hpp"
 #include "RenderDeviceBase.hpp"
 #include "StringPool.hpp"
 #include "HashUtils.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -220,6 +224,76 @@ public:
         return true;
     }
 
+    /// Instance that is updated by a BuildTLAS command with DirtyInstancesOnly flag.
+    struct DirtyInstance
+    {
+        const TLASBuildInstanceData* pData                       = nullptr;
+        Uint32                       InstanceIndex               = 0;
+        Uint32                       ContributionToHitGroupIndex = 0;
+
+        bool operator<(const DirtyInstance& rhs) const
+        {
+            return InstanceIndex < rhs.InstanceIndex;
+        }
+    };
+
+    /// Updates the instances that have changed since the previous build and writes them
+    /// to DirtyInstances sorted by the instance index, so that the instance descriptors can
+    /// be uploaded in contiguous ranges. Instances keep their indices and, unless BindingMode is
+    /// HIT_GROUP_BINDING_MODE_USER_DEFINED, their contributions to the hit group index.
+    bool UpdateDirtyInstances(const TLASBuildInstanceData* pInstances,
+                              const Uint32                 InstanceCount,
+                              const HIT_GROUP_BINDING_MODE BindingMode,
+                              std::vector<DirtyInstance>&  DirtyInstances) noexcept
+    {
+        VERIFY_EXPR(InstanceCount <= this->m_BuildInfo.InstanceCount);
+        VERIFY_EXPR(BindingMode == this->m_BuildInfo.BindingMode);
+
+        DirtyInstances.clear();
+        DirtyInstances.reserve(InstanceCount);
+
+#ifdef DILIGENT_DEVELOPMENT
+        bool Changed = false;
+#endif
+        for (Uint32 i = 0; i < InstanceCount; ++i)
+        {
+            const auto& Inst = pInstances[i];
+            auto        Iter = this->m_Instances.find(Inst.InstanceName);
+
+            if (Iter == this->m_Instances.end())
+            {
+                UNEXPECTED("Failed to find instance with name '", Inst.InstanceName, "' in instances from the previous build");
+                return false;
+            }
+
+            auto& Desc     = Iter->second;
+            auto* pNewBLAS = ClassPtrCast<BottomLevelASImplType>(Inst.pBLAS);
+#ifdef DILIGENT_DEVELOPMENT
+            Changed = Changed || (Desc.pBLAS.RawPtr() != pNewBLAS);
+            Changed = Changed || (BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED && Desc.ContributionToHitGroupIndex != Inst.ContributionToHitGroupIndex);
+#endif
+            Desc.pBLAS = pNewBLAS;
+            if (BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED)
+                Desc.ContributionToHitGroupIndex = Inst.ContributionToHitGroupIndex;
+
+            DirtyInstances.push_back({&Inst, Desc.InstanceIndex, Desc.ContributionToHitGroupIndex});
+        }
+
+        std::sort(DirtyInstances.begin(), DirtyInstances.end());
+
+#ifdef DILIGENT_DEVELOPMENT
+        // The TLAS is refit with all instances, so BLASes of the instances that were
+        // not changed may have been rebuilt as well.
+        for (auto& NameAndInst : this->m_Instances)
+            NameAndInst.second.dvpVersion = NameAndInst.second.pBLAS->DvpGetVersion();
+
+        if (Changed)
+            this->m_DvpVersion.fetch_add(1);
+#endif
+
+        return true;
+    }
+
     void CopyInstanceData(const TopLevelASBase& Src) noexcept
     {
         ClearInstanceData();
@@ -341,6 +415,19 @@ public:
     {
         return this->m_DvpVersion.load();
     }
+
+    void DvpSetInstanceBuffer(const IBuffer* pInstanceBuffer, Uint64 Offset)
+    {
+        this->m_DvpInstanceBufferId     = pInstanceBuffer != nullptr ? pInstanceBuffer->GetUniqueID() : -1;
+        this->m_DvpInstanceBufferOffset = Offset;
+    }
+
+    bool DvpIsSameInstanceBuffer(const IBuffer* pInstanceBuffer, Uint64 Offset) const
+    {
+        return pInstanceBuffer != nullptr &&
+            pInstanceBuffer->GetUniqueID() == this->m_DvpInstanceBufferId &&
+            Offset == this->m_DvpInstanceBufferOffset;
+    }
 #endif // DILIGENT_DEVELOPMENT
 
 private:
@@ -391,8 +478,14 @@ protected:
 
     StringPool m_StringPool;
 
+    GPUMemoryRecord m_GPUMemoryRecord;
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Uint32> m_DvpVersion{0};
+
+    // Instance buffer location used by the last build
+    Int32  m_DvpInstanceBufferId     = -1;
+    Uint64 m_DvpInstanceBufferOffset = 0;
 #endif
 };
 
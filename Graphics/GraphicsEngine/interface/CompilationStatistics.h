@@ -0,0 +1,229 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+// clang-format off
+
+/// \file
+/// Definition of the Diligent::ICompilationStatistics interface and related data structures
+
+#include "../../../Primitives/interface/Object.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "GraphicsTypes.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+/// Shader and pipeline compilation stage.
+DILIGENT_TYPED_ENUM(COMPILATION_STAGE, Uint8)
+{
+    /// Source preprocessing: building the source string, processing includes,
+    /// converting HLSL to GLSL.
+    COMPILATION_STAGE_PREPROCESS = 0,
+
+    /// Compiler front end: DXC, FXC, or glslang.
+    COMPILATION_STAGE_COMPILE,
+
+    /// SPIR-V optimization.
+    COMPILATION_STAGE_OPTIMIZE,
+
+    /// Loading shader resources from the byte code.
+    COMPILATION_STAGE_REFLECTION,
+
+    /// Compilation by the driver: shader modules and pipeline objects,
+    /// OpenGL shader compilation and program linking.
+    COMPILATION_STAGE_DRIVER,
+
+    /// The number of compilation stages.
+    COMPILATION_STAGE_COUNT
+};
+
+
+/// Compilation record type.
+DILIGENT_TYPED_ENUM(COMPILATION_RECORD_TYPE, Uint8)
+{
+    /// Shader object.
+    COMPILATION_RECORD_TYPE_SHADER = 0,
+
+    /// Pipeline state object.
+    COMPILATION_RECORD_TYPE_PIPELINE
+};
+
+
+/// The result of looking up a pipeline or one of its shader stages in a pipeline cache.
+DILIGENT_TYPED_ENUM(PIPELINE_CACHE_RESULT, Uint8)
+{
+    /// The result is unknown, e.g. the pipeline was created without a cache or
+    /// the driver does not report pipeline creation feedback.
+    PIPELINE_CACHE_RESULT_UNKNOWN = 0,
+
+    /// The pipeline or the shader stage was found in the cache.
+    PIPELINE_CACHE_RESULT_HIT,
+
+    /// The pipeline or the shader stage was not found in the cache and was compiled from scratch.
+    PIPELINE_CACHE_RESULT_MISS
+};
+
+
+/// Driver feedback for the shader stages of the same type in a pipeline.
+struct PipelineStageFeedback
+{
+    /// Shader stage type.
+    SHADER_TYPE ShaderType DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Cache lookup result, see Diligent::PIPELINE_CACHE_RESULT.
+
+    /// If a pipeline has several stages of this type (e.g. ray tracing hit shaders),
+    /// the result is a hit only if all of them were found in the cache.
+    PIPELINE_CACHE_RESULT CacheResult DEFAULT_INITIALIZER(PIPELINE_CACHE_RESULT_UNKNOWN);
+
+    /// The time the driver spent creating the stages, in microseconds, or 0 if it is unknown.
+    Uint64 Duration DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStageFeedback PipelineStageFeedback;
+
+
+/// Compilation statistics of a single shader or pipeline state.
+
+/// All times are in microseconds.
+struct CompilationRecord
+{
+    /// Record type, see Diligent::COMPILATION_RECORD_TYPE.
+    COMPILATION_RECORD_TYPE Type DEFAULT_INITIALIZER(COMPILATION_RECORD_TYPE_SHADER);
+
+    /// Shader type for shader records, or the active shader stages for pipeline records.
+    SHADER_TYPE ShaderType DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Object name.
+    const Char* Name DEFAULT_INITIALIZER(nullptr);
+
+    /// Index of the thread that performed the compilation.
+    Uint32 ThreadId DEFAULT_INITIALIZER(0);
+
+    /// Start time, relative to the time when the statistics were created or reset.
+    Uint64 StartTime DEFAULT_INITIALIZER(0);
+
+    /// Total duration.
+    Uint64 Duration DEFAULT_INITIALIZER(0);
+
+    /// The time spent in every compilation stage, see Diligent::COMPILATION_STAGE.
+
+    /// Stages do not overlap, so the sum of the stage times does not exceed the total duration.
+    /// The remaining time is spent in the engine, e.g. creating resource layouts.
+    Uint64 StageDurations[COMPILATION_STAGE_COUNT] DEFAULT_INITIALIZER({});
+
+    /// Byte code size for shader records.
+    Uint64 ByteCodeSize DEFAULT_INITIALIZER(0);
+
+    /// For pipeline records, the pipeline cache lookup result, see Diligent::PIPELINE_CACHE_RESULT.
+
+    /// In Vulkan, the result is reported by the driver through VK_EXT_pipeline_creation_feedback
+    /// and reflects the VkPipelineCache of the pipeline state cache, if any. In Direct3D12, the result
+    /// of loading the pipeline from the pipeline library of the pipeline state cache is recorded.
+    PIPELINE_CACHE_RESULT CacheResult DEFAULT_INITIALIZER(PIPELINE_CACHE_RESULT_UNKNOWN);
+
+    /// For pipeline records, the time the driver reports it spent creating the pipeline,
+    /// or 0 if it is unknown (Vulkan only).
+    Uint64 DriverDuration DEFAULT_INITIALIZER(0);
+
+    /// The number of valid elements in StageFeedbacks.
+    Uint32 NumStageFeedbacks DEFAULT_INITIALIZER(0);
+
+    /// For pipeline records, driver feedback for every shader stage type (Vulkan only).
+    PipelineStageFeedback StageFeedbacks[DILIGENT_MAX_PIPELINE_STAGE_FEEDBACKS] DEFAULT_INITIALIZER({});
+};
+typedef struct CompilationRecord CompilationRecord;
+
+// clang-format on
+
+// {3F0C9B6E-1D2A-4E57-9C8B-6A4D2E7F5B13}
+static const INTERFACE_ID IID_CompilationStatistics =
+    {0x3f0c9b6e, 0x1d2a, 0x4e57, {0x9c, 0x8b, 0x6a, 0x4d, 0x2e, 0x7f, 0x5b, 0x13}};
+
+#define DILIGENT_INTERFACE_NAME ICompilationStatistics
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define ICompilationStatisticsInclusiveMethods \
+    IObjectInclusiveMethods;                   \
+    ICompilationStatisticsMethods CompilationStatistics
+
+// clang-format off
+
+/// Shader and pipeline compilation statistics interface.
+
+/// The statistics are collected by the render device when EngineCreateInfo::EnableCompilationStatistics
+/// is true, and can be obtained with IRenderDevice::GetCompilationStatistics().
+/// Every shader and pipeline state created by the device, including objects created
+/// asynchronously and through the render state cache, adds a record.
+///
+/// All methods are thread-safe.
+DILIGENT_BEGIN_INTERFACE(ICompilationStatistics, IObject)
+{
+    /// Returns the number of records.
+    VIRTUAL Uint32 METHOD(GetRecordCount)(THIS) CONST PURE;
+
+    /// Returns the record with the given index.
+
+    /// \param [in] Index - Record index, must be less than the value returned by GetRecordCount().
+    ///
+    /// \note   The returned reference, including the name, remains valid until Reset() is called.
+    VIRTUAL const CompilationRecord REF METHOD(GetRecord)(THIS_
+                                                         Uint32 Index) CONST PURE;
+
+    /// Removes all records and restarts the timer.
+    VIRTUAL void METHOD(Reset)(THIS) PURE;
+
+    /// Writes all records to a data blob in CSV format, one record per line.
+    VIRTUAL void METHOD(ExportCSV)(THIS_
+                                   IDataBlob** ppData) CONST PURE;
+
+    /// Writes all records to a data blob in Chrome trace event JSON format.
+
+    /// The data can be loaded into chrome://tracing or https://ui.perfetto.dev.
+    /// Every record is a complete event, and stage times are stored in the event arguments.
+    VIRTUAL void METHOD(ExportChromeTrace)(THIS_
+                                           IDataBlob** ppData) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define ICompilationStatistics_GetRecordCount(This)         CALL_IFACE_METHOD(CompilationStatistics, GetRecordCount,    This)
+#    define ICompilationStatistics_GetRecord(This, ...)         CALL_IFACE_METHOD(CompilationStatistics, GetRecord,         This, __VA_ARGS__)
+#    define ICompilationStatistics_Reset(This)                  CALL_IFACE_METHOD(CompilationStatistics, Reset,             This)
+#    define ICompilationStatistics_ExportCSV(This, ...)         CALL_IFACE_METHOD(CompilationStatistics, ExportCSV,         This, __VA_ARGS__)
+#    define ICompilationStatistics_ExportChromeTrace(This, ...) CALL_IFACE_METHOD(CompilationStatistics, ExportChromeTrace, This, __VA_ARGS__)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
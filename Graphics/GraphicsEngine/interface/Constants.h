@@ -50,6 +50,9 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 /// The maximum number of queues in graphics adapter description.
 #define DILIGENT_MAX_ADAPTER_QUEUES 16
 
+/// The maximum number of 32-bit constants in one inline constants resource.
+#define DILIGENT_MAX_INLINE_CONSTANTS 64
+
 /// Special constant for the default adapter index.
 #define DILIGENT_DEFAULT_ADAPTER_ID 0xFFFFFFFFU
 
@@ -62,14 +65,27 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 /// Bit shift for the the shading X-axis rate.
 #define DILIGENT_SHADING_RATE_X_SHIFT 2
 
-static const Uint32 MAX_BUFFER_SLOTS        = DILIGENT_MAX_BUFFER_SLOTS;
-static const Uint32 MAX_RENDER_TARGETS      = DILIGENT_MAX_RENDER_TARGETS;
-static const Uint32 MAX_VIEWPORTS           = DILIGENT_MAX_VIEWPORTS;
-static const Uint32 MAX_RESOURCE_SIGNATURES = DILIGENT_MAX_RESOURCE_SIGNATURES;
-static const Uint32 MAX_ADAPTER_QUEUES      = DILIGENT_MAX_ADAPTER_QUEUES;
-static const Uint32 DEFAULT_ADAPTER_ID      = DILIGENT_DEFAULT_ADAPTER_ID;
-static const Uint8  DEFAULT_QUEUE_ID        = DILIGENT_DEFAULT_QUEUE_ID;
-static const Uint32 MAX_SHADING_RATES       = DILIGENT_MAX_SHADING_RATES;
-static const Uint32 SHADING_RATE_X_SHIFT    = DILIGENT_SHADING_RATE_X_SHIFT;
+/// The number of buckets in device metric histograms.
+#define DILIGENT_METRIC_HISTOGRAM_SIZE 32
+
+/// The maximum length of the name in GPU memory allocation information, including the terminating zero.
+#define DILIGENT_GPU_MEMORY_ALLOCATION_NAME_LENGTH 128
+
+/// The maximum number of shader stage types in pipeline creation feedback.
+#define DILIGENT_MAX_PIPELINE_STAGE_FEEDBACKS 8
+
+static const Uint32 MAX_BUFFER_SLOTS                  = DILIGENT_MAX_BUFFER_SLOTS;
+static const Uint32 MAX_RENDER_TARGETS                = DILIGENT_MAX_RENDER_TARGETS;
+static const Uint32 MAX_VIEWPORTS                     = DILIGENT_MAX_VIEWPORTS;
+static const Uint32 MAX_RESOURCE_SIGNATURES           = DILIGENT_MAX_RESOURCE_SIGNATURES;
+static const Uint32 MAX_ADAPTER_QUEUES                = DILIGENT_MAX_ADAPTER_QUEUES;
+static const Uint32 MAX_INLINE_CONSTANTS              = DILIGENT_MAX_INLINE_CONSTANTS;
+static const Uint32 DEFAULT_ADAPTER_ID                = DILIGENT_DEFAULT_ADAPTER_ID;
+static const Uint8  DEFAULT_QUEUE_ID                  = DILIGENT_DEFAULT_QUEUE_ID;
+static const Uint32 MAX_SHADING_RATES                 = DILIGENT_MAX_SHADING_RATES;
+static const Uint32 SHADING_RATE_X_SHIFT              = DILIGENT_SHADING_RATE_X_SHIFT;
+static const Uint32 METRIC_HISTOGRAM_SIZE             = DILIGENT_METRIC_HISTOGRAM_SIZE;
+static const Uint32 GPU_MEMORY_ALLOCATION_NAME_LENGTH = DILIGENT_GPU_MEMORY_ALLOCATION_NAME_LENGTH;
+static const Uint32 MAX_PIPELINE_STAGE_FEEDBACKS      = DILIGENT_MAX_PIPELINE_STAGE_FEEDBACKS;
 
 DILIGENT_END_NAMESPACE // namespace Diligent
@@ -233,6 +233,10 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     ///
     /// \warning    If the archive was loaded without making a copy, the application
     ///             must not modify its contents while it is in use by the dearchiver.
+    ///
+    /// \remarks    Resources and shader byte code are not copied from the archive when MakeCopy is false.
+    ///             Large archives can thus be mapped into memory (e.g. using Diligent::MappedFileDataBlob),
+    ///             so that only the data for the device types that are actually used is loaded from disk.
     /// 
     /// \warning    This method is not thread-safe and must not be called simultaneously
     ///             with other methods.
@@ -268,6 +272,33 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
                                              const PipelineStateUnpackInfo REF UnpackInfo,
                                              IPipelineState**                  ppPSO) PURE;
 
+    /// Unpacks multiple pipeline state objects from the device object archive in parallel.
+
+    /// \param [in]  pUnpackInfos - An array of NumPipelines pipeline state unpack infos,
+    ///                             see Diligent::PipelineStateUnpackInfo.
+    /// \param [in]  NumPipelines - The number of pipelines to unpack.
+    /// \param [in]  pThreadPool  - An optional thread pool to use to unpack the pipelines.
+    ///                             If null, the pipelines are unpacked sequentially by the calling thread.
+    /// \param [out] ppPSOs       - An array of NumPipelines memory locations where pointers to the
+    ///                             unpacked pipeline state objects will be stored.
+    ///                             The function calls AddRef() for every object, so that each PSO will have
+    ///                             one reference. If a pipeline fails to unpack, null is written
+    ///                             to the corresponding location.
+    ///
+    /// \remarks    The method first unpacks all resource signatures and render passes referenced by
+    ///             the pipelines, so that the objects shared by multiple pipelines are only created once,
+    ///             and then unpacks the pipelines. Every pipeline task only waits for the objects it uses.
+    ///
+    ///             The method blocks the calling thread until all pipelines are unpacked.
+    ///             It must not be called from a worker thread of pThreadPool.
+    ///
+    /// \note   This method is thread-safe.
+    VIRTUAL void METHOD(UnpackPipelineStates)(THIS_
+                                              const PipelineStateUnpackInfo* pUnpackInfos,
+                                              Uint32                         NumPipelines,
+                                              struct IThreadPool*            pThreadPool,
+                                              IPipelineState**               ppPSOs) PURE;
+
     /// Unpacks resource signature from the device object archive.
 
     /// \param [in]  UnpackInfo  - Resource signature unpack info, see Diligent::ResourceSignatureUnpackInfo.
@@ -294,6 +325,29 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
                                           const RenderPassUnpackInfo REF UnpackInfo,
                                           IRenderPass**                  ppRP) PURE;
 
+    /// Creates a pipeline state cache from the cache data stored in the loaded archives.
+
+    /// \param [in]  pDevice - Render device that will create the cache. The device type
+    ///                        determines which cache data is used.
+    /// \param [out] ppCache - Address of the memory location where a pointer to the
+    ///                        pipeline state cache object will be stored.
+    ///                        The function calls AddRef(), so that the cache will have
+    ///                        one reference. If none of the archives contains the cache data
+    ///                        for the device type, null is written.
+    ///
+    /// \remarks    The cache data is added to the archive by IArchiver::SetPipelineStateCacheData.
+    ///             The application should pass the cache to PipelineStateUnpackInfo::pCache
+    ///             so that the pipelines known to the cache are not compiled again,
+    ///             e.g. Metal pipelines are loaded from the binary archive.
+    ///
+    ///             If several archives contain the cache data, the caches are merged
+    ///             (see IPipelineStateCache::Merge).
+    ///
+    /// \note   This method is thread-safe.
+    VIRTUAL void METHOD(UnpackPipelineStateCache)(THIS_
+                                                  struct IRenderDevice* pDevice,
+                                                  IPipelineStateCache** ppCache) PURE;
+
     /// Writes archive data to the data blob.
 
     /// \param [in] ppArchive - Memory location where a pointer to the archive data blob will be written.
@@ -318,13 +372,15 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define IDearchiver_LoadArchive(This, ...)             CALL_IFACE_METHOD(Dearchiver, LoadArchive,             This, __VA_ARGS__)
-#    define IDearchiver_UnpackShader(This, ...)            CALL_IFACE_METHOD(Dearchiver, UnpackShader,            This, __VA_ARGS__)
-#    define IDearchiver_UnpackPipelineState(This, ...)     CALL_IFACE_METHOD(Dearchiver, UnpackPipelineState,     This, __VA_ARGS__)
-#    define IDearchiver_UnpackResourceSignature(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature, This, __VA_ARGS__)
-#    define IDearchiver_UnpackRenderPass(This, ...)        CALL_IFACE_METHOD(Dearchiver, UnpackRenderPass,        This, __VA_ARGS__)
-#    define IDearchiver_Store(This, ...)                   CALL_IFACE_METHOD(Dearchiver, Store,                   This, __VA_ARGS__)
-#    define IDearchiver_Reset(This)                        CALL_IFACE_METHOD(Dearchiver, Reset,                   This)
+#    define IDearchiver_LoadArchive(This, ...)              CALL_IFACE_METHOD(Dearchiver, LoadArchive,              This, __VA_ARGS__)
+#    define IDearchiver_UnpackShader(This, ...)             CALL_IFACE_METHOD(Dearchiver, UnpackShader,             This, __VA_ARGS__)
+#    define IDearchiver_UnpackPipelineState(This, ...)      CALL_IFACE_METHOD(Dearchiver, UnpackPipelineState,      This, __VA_ARGS__)
+#    define IDearchiver_UnpackPipelineStates(This, ...)     CALL_IFACE_METHOD(Dearchiver, UnpackPipelineStates,     This, __VA_ARGS__)
+#    define IDearchiver_UnpackResourceSignature(This, ...)  CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature,  This, __VA_ARGS__)
+#    define IDearchiver_UnpackRenderPass(This, ...)         CALL_IFACE_METHOD(Dearchiver, UnpackRenderPass,         This, __VA_ARGS__)
+#    define IDearchiver_UnpackPipelineStateCache(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackPipelineStateCache, This, __VA_ARGS__)
+#    define IDearchiver_Store(This, ...)                    CALL_IFACE_METHOD(Dearchiver, Store,                    This, __VA_ARGS__)
+#    define IDearchiver_Reset(This)                         CALL_IFACE_METHOD(Dearchiver, Reset,                    This)
 
 #endif
 
@@ -147,6 +147,95 @@ struct DeviceContextDesc
 typedef struct DeviceContextDesc DeviceContextDesc;
 
 
+/// Numbers of state-setting calls that the device context filtered out because
+/// they would not change the current state, see IDeviceContext::GetStateFilterStats().
+struct DeviceContextStateFilterStats
+{
+    /// The number of IDeviceContext::SetPipelineState() calls with the already bound pipeline state.
+    Uint64 PipelineStates DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetVertexBuffers() calls that did not change the bound vertex buffers.
+    Uint64 VertexBuffers  DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetIndexBuffer() calls that did not change the bound index buffer.
+    Uint64 IndexBuffers   DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetStencilRef() calls with the current stencil reference value.
+    Uint64 StencilRefs    DEFAULT_INITIALIZER(0);
+
+    /// The number of IDeviceContext::SetBlendFactors() calls with the current blend factors.
+    Uint64 BlendFactors   DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextStateFilterStats DeviceContextStateFilterStats;
+
+
+/// Device context statistics, see IDeviceContext::GetStatistics().
+
+/// The counters accumulate over the lifetime of the context. Per-frame values can
+/// be obtained by subtracting the values queried after the previous frame.
+/// The statistics are only collected by Direct3D12 and Vulkan contexts.
+struct DeviceContextStatistics
+{
+    /// The number of resource barriers recorded by the context.
+
+    /// \remarks   In Vulkan, every image barrier and every memory barrier that covers
+    ///            buffer transitions counts as one barrier.
+    Uint64 BarrierCount           DEFAULT_INITIALIZER(0);
+
+    /// The number of command buffers submitted by the immediate context, including
+    /// the command lists recorded by deferred contexts, or the number of command lists
+    /// finished by the deferred context.
+    Uint64 CommandBufferCount     DEFAULT_INITIALIZER(0);
+
+    /// The total size, in bytes, of the space allocated from the dynamic heap for
+    /// dynamic buffers and for the data uploaded by UpdateBuffer() and UpdateTexture().
+    Uint64 DynamicHeapBytes       DEFAULT_INITIALIZER(0);
+
+    /// The number of GPU-visible descriptors (Direct3D12) or descriptor sets (Vulkan)
+    /// allocated by the context for dynamic resources.
+    Uint64 DynamicDescriptorCount DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextStatistics DeviceContextStatistics;
+
+
+/// GPU profile of a debug group captured by the device context, see IDeviceContext::GetDebugGroupProfile().
+struct DebugGroupProfile
+{
+    /// Full debug group path, which is the names of the group and its parents
+    /// separated with '/', e.g. "Frame/Shadows".
+    const Char* Name                  DEFAULT_INITIALIZER(nullptr);
+
+    /// Group nesting level, 0 for top-level groups.
+    Uint32      Depth                 DEFAULT_INITIALIZER(0);
+
+    /// Whether the pipeline statistics members are valid.
+
+    /// \remarks   Pipeline statistics queries may not overlap in Vulkan, so the statistics
+    ///            are only collected for the outermost profiled group.
+    Bool        HasPipelineStatistics DEFAULT_INITIALIZER(False);
+
+    /// GPU time, in seconds, between the beginning and the end of the group,
+    /// or 0 if duration queries are not enabled.
+    double      GPUTime               DEFAULT_INITIALIZER(0);
+
+    /// The number of vertex shader invocations.
+    Uint64      VSInvocations         DEFAULT_INITIALIZER(0);
+
+    /// The number of pixel shader invocations.
+    Uint64      PSInvocations         DEFAULT_INITIALIZER(0);
+
+    /// The number of compute shader invocations.
+    Uint64      CSInvocations         DEFAULT_INITIALIZER(0);
+
+    /// The number of primitives read by the input assembler.
+    Uint64      InputPrimitives       DEFAULT_INITIALIZER(0);
+
+    /// The number of primitives that passed the clipping stage.
+    Uint64      ClippingPrimitives    DEFAULT_INITIALIZER(0);
+};
+typedef struct DebugGroupProfile DebugGroupProfile;
+
+
 /// Draw command flags
 DILIGENT_TYPED_ENUM(DRAW_FLAGS, Uint8)
 {
@@ -629,6 +718,63 @@ struct DrawMeshIndirectAttribs
 typedef struct DrawMeshIndirectAttribs DrawMeshIndirectAttribs;
 
 
+/// Defines allowed flags for IDeviceContext::SubmitDrawPackets() function.
+DILIGENT_TYPED_ENUM(SUBMIT_DRAW_PACKETS_FLAGS, Uint8)
+{
+    /// No extra operations.
+    SUBMIT_DRAW_PACKETS_FLAG_NONE          = 0x00,
+
+    /// Allow the context to reorder the packets so that packets that use the same
+    /// pipeline state and shader resource bindings are executed back to back.
+    /// The order of packets that share the same state is preserved.
+    ///
+    /// \remarks  Reordering changes the rasterization order, so this flag should only
+    ///           be used when the result does not depend on it (e.g. opaque geometry).
+    SUBMIT_DRAW_PACKETS_FLAG_ALLOW_REORDER = 0x01
+};
+DEFINE_FLAG_ENUM_OPERATORS(SUBMIT_DRAW_PACKETS_FLAGS)
+
+
+/// Describes a single draw packet.
+
+/// This structure is used by IDeviceContext::SubmitDrawPackets().
+struct DrawPacket
+{
+    /// Pipeline state to use for the draw command. Must not be null.
+    IPipelineState*                pPipelineState      DEFAULT_INITIALIZER(nullptr);
+
+    /// An array of NumSRBs shader resource bindings to commit before the draw command.
+    IShaderResourceBinding* const* ppSRBs              DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of shader resource bindings in ppSRBs array.
+    Uint32                         NumSRBs             DEFAULT_INITIALIZER(0);
+
+    /// The number of vertex buffers in ppVertexBuffers array.
+    Uint32                         NumVertexBuffers    DEFAULT_INITIALIZER(0);
+
+    /// An array of NumVertexBuffers vertex buffers to bind starting at slot 0.
+    /// All other slots are unbound.
+    IBuffer**                      ppVertexBuffers     DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional array of NumVertexBuffers vertex buffer offsets, in bytes.
+    const Uint64*                  pVertexOffsets      DEFAULT_INITIALIZER(nullptr);
+
+    /// Index buffer. If not null, the packet is drawn with IDeviceContext::DrawIndexed()
+    /// using IndexedAttribs. Otherwise, IDeviceContext::Draw() is used with Attribs.
+    IBuffer*                       pIndexBuffer        DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the index buffer, in bytes.
+    Uint64                         IndexBufferOffset   DEFAULT_INITIALIZER(0);
+
+    /// Draw command attributes used when pIndexBuffer is null.
+    DrawAttribs                    Attribs;
+
+    /// Draw command attributes used when pIndexBuffer is not null.
+    DrawIndexedAttribs             IndexedAttribs;
+};
+typedef struct DrawPacket DrawPacket;
+
+
 /// Defines which parts of the depth-stencil buffer to clear.
 
 /// These flags are used by IDeviceContext::ClearDepthStencil().
@@ -769,6 +915,58 @@ struct DispatchTileAttribs
 typedef struct DispatchTileAttribs DispatchTileAttribs;
 
 
+/// Describes work graph dispatch command arguments.
+
+/// This structure is used by IDeviceContext::DispatchGraph().
+struct DispatchGraphAttribs
+{
+    /// The name of the entry point node to launch.
+    /// If null or empty, the first entry point of the work graph is used.
+    const Char* EntryPointName       DEFAULT_INITIALIZER(nullptr);
+
+    /// Input records for the entry point node.
+
+    /// The records are copied into the command list, so the memory does not
+    /// need to stay valid after the call returns.
+    /// May be null if the entry point node does not take input records.
+    const void* pRecords             DEFAULT_INITIALIZER(nullptr);
+
+    /// Buffer that holds the work graph backing memory.
+
+    /// The buffer must have been created with BIND_UNORDERED_ACCESS flag.
+    /// If null, the memory allocated by the pipeline is used. The pipeline memory
+    /// must not be used by more than one context at the same time.
+    IBuffer*    pBackingMemory       DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset, in bytes, of the backing memory region from the beginning of pBackingMemory.
+    Uint64      BackingMemoryOffset  DEFAULT_INITIALIZER(0);
+
+    /// Size, in bytes, of the backing memory region.
+    /// If zero, the remaining part of pBackingMemory after BackingMemoryOffset is used.
+    Uint64      BackingMemorySize    DEFAULT_INITIALIZER(0);
+
+    /// Array index of the entry point node.
+    Uint32      EntryPointArrayIndex DEFAULT_INITIALIZER(0);
+
+    /// The number of input records to launch the entry point node with.
+    Uint32      NumRecords           DEFAULT_INITIALIZER(0);
+
+    /// The distance, in bytes, between two consecutive records in pRecords.
+    Uint32      RecordStride         DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the backing memory buffer.
+    RESOURCE_STATE_TRANSITION_MODE BackingMemoryStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Whether to initialize the backing memory before the graph is launched.
+
+    /// The context initializes the memory automatically when it is used for the first time
+    /// or was last used by this context with another pipeline. Set this flag when the memory
+    /// may have been used with another work graph in a different context.
+    Bool        InitializeBackingMemory DEFAULT_INITIALIZER(False);
+};
+typedef struct DispatchGraphAttribs DispatchGraphAttribs;
+
+
 /// Describes multi-sampled texture resolve command arguments.
 
 /// This structure is used by IDeviceContext::ResolveTextureSubresource().
@@ -1236,6 +1434,8 @@ struct BuildBLASAttribs
     /// The buffer that is used for acceleration structure building.
     /// Must be created with BIND_RAY_TRACING.
     /// Call IBottomLevelAS::GetScratchBufferSizes().Build to get the minimal size for the scratch buffer.
+    /// When the structure is used by IDeviceContext::BuildBLASBatch(), the buffer may be null,
+    /// in which case the scratch memory is allocated from the context's internal scratch buffer.
     IBuffer*                        pScratchBuffer              DEFAULT_INITIALIZER(nullptr);
 
     /// Offset from the beginning of the buffer.
@@ -1254,6 +1454,20 @@ struct BuildBLASAttribs
 typedef struct BuildBLASAttribs BuildBLASAttribs;
 
 
+/// This structure is used by IDeviceContext::BuildBLASBatch().
+struct BuildBLASBatchAttribs
+{
+    /// A pointer to an array of BuildCount BuildBLASAttribs structures that describe the BLAS builds.
+    /// Every BLAS must only be referenced once in the batch.
+    /// Scratch buffer regions of the builds that provide their own scratch buffers must not overlap.
+    BuildBLASAttribs const*         pBuilds                     DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of builds in the pBuilds array.
+    Uint32                          BuildCount                  DEFAULT_INITIALIZER(0);
+};
+typedef struct BuildBLASBatchAttribs BuildBLASBatchAttribs;
+
+
 /// Can be used to calculate the TLASBuildInstanceData::ContributionToHitGroupIndex depending on instance count,
 /// geometry count in each instance (in TLASBuildInstanceData::pBLAS) and shader binding mode in BuildTLASAttribs::BindingMode.
 ///
@@ -1350,6 +1564,8 @@ struct TLASBuildInstanceData
     /// The index used to calculate the hit group location in the shader binding table.
     /// Must be TLAS_INSTANCE_OFFSET_AUTO if BuildTLASAttribs::BindingMode is not SHADER_BINDING_USER_DEFINED.
     /// Only the lower 24 bits are used.
+    /// Instances that use the same BLAS and materials may share hit group records by using the same index
+    /// with HIT_GROUP_BINDING_MODE_USER_DEFINED (see IShaderBindingTable::BindHitGroupByIndex()).
     Uint32                    ContributionToHitGroupIndex DEFAULT_INITIALIZER(TLAS_INSTANCE_OFFSET_AUTO);
 };
 typedef struct TLASBuildInstanceData TLASBuildInstanceData;
@@ -1384,7 +1600,8 @@ struct BuildTLASAttribs
 
     /// The number of instances.
     /// Must be less than or equal to TopLevelASDesc::MaxInstanceCount.
-    /// If Update is true then count must be the same as used to build TLAS.
+    /// If Update is true then count must be the same as used to build TLAS,
+    /// unless DirtyInstancesOnly is also true.
     Uint32                          InstanceCount                 DEFAULT_INITIALIZER(0);
 
     /// The buffer that will be used to store instance data during AS building.
@@ -1434,6 +1651,22 @@ struct BuildTLASAttribs
     /// pTLAS must be created with RAYTRACING_BUILD_AS_ALLOW_UPDATE flag.
     /// An update will be faster than building an acceleration structure from scratch.
     Bool                            Update                        DEFAULT_INITIALIZER(False);
+
+    /// If true, pInstances contains only the instances that have changed since the previous build,
+    /// and InstanceCount is the number of these instances. Requires Update to be true.
+    ///
+    /// \remarks   Instances keep the indices assigned by the last full build (see TLASInstanceDesc::InstanceIndex),
+    ///             and only the descriptors of the changed instances are written to the instance buffer.
+    ///             The descriptors of all other instances are reused, so pInstanceBuffer and InstanceBufferOffset
+    ///             must be the same as in the previous build, and the instance data must not have been
+    ///             overwritten since then.
+    ///
+    ///             HitGroupStride, BaseContributionToHitGroupIndex and BindingMode must be the same as in the previous build.
+    ///             If BindingMode is HIT_GROUP_BINDING_MODE_PER_GEOMETRY, the new BLAS of an instance must have
+    ///             the same number of geometries as the previous one.
+    ///
+    ///             BLASTransitionMode only applies to the BLASes of the instances in pInstances.
+    Bool                            DirtyInstancesOnly            DEFAULT_INITIALIZER(False);
 };
 typedef struct BuildTLASAttribs BuildTLASAttribs;
 
@@ -1867,6 +2100,62 @@ struct BindSparseResourceMemoryAttribs
 };
 typedef struct BindSparseResourceMemoryAttribs BindSparseResourceMemoryAttribs;
 
+
+/// Conditional rendering flags.
+DILIGENT_TYPED_ENUM(CONDITIONAL_RENDERING_FLAGS, Uint8)
+{
+    /// No flags.
+    CONDITIONAL_RENDERING_FLAG_NONE     = 0u,
+
+    /// Invert the condition: the commands are discarded if the predicate value is not zero.
+    CONDITIONAL_RENDERING_FLAG_INVERTED = 1u << 0u,
+
+    CONDITIONAL_RENDERING_FLAG_LAST     = CONDITIONAL_RENDERING_FLAG_INVERTED
+};
+DEFINE_FLAG_ENUM_OPERATORS(CONDITIONAL_RENDERING_FLAGS)
+
+
+/// Describes the conditional rendering command arguments.
+
+/// This structure is used by IDeviceContext::BeginConditionalRendering().
+struct BeginConditionalRenderingAttribs
+{
+    /// A pointer to the buffer that contains the predicate value.
+
+    /// The buffer must have been created with BIND_INDIRECT_DRAW_ARGS bind flag
+    /// and must not be a dynamic buffer.
+    IBuffer*                       pBuffer        DEFAULT_INITIALIZER(nullptr);
+
+    /// The offset from the beginning of the buffer to the predicate value.
+
+    /// The predicate is a 64-bit unsigned integer and the offset must be a multiple of 8.
+    /// Vulkan only tests the lower 32 bits of the value, so non-zero values
+    /// must not exceed 0xFFFFFFFF.
+    Uint64                         Offset         DEFAULT_INITIALIZER(0);
+
+    /// Conditional rendering flags, see Diligent::CONDITIONAL_RENDERING_FLAGS.
+    CONDITIONAL_RENDERING_FLAGS    Flags          DEFAULT_INITIALIZER(CONDITIONAL_RENDERING_FLAG_NONE);
+
+    /// State transition mode for the predicate buffer.
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr BeginConditionalRenderingAttribs() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr BeginConditionalRenderingAttribs(IBuffer*                       _pBuffer,
+                                               RESOURCE_STATE_TRANSITION_MODE _TransitionMode,
+                                               Uint64                         _Offset = 0,
+                                               CONDITIONAL_RENDERING_FLAGS    _Flags  = BeginConditionalRenderingAttribs{}.Flags) noexcept :
+        pBuffer       {_pBuffer       },
+        Offset        {_Offset        },
+        Flags         {_Flags         },
+        TransitionMode{_TransitionMode}
+    {}
+#endif
+};
+typedef struct BeginConditionalRenderingAttribs BeginConditionalRenderingAttribs;
+
 /// Special constant for all remaining mipmap levels.
 #define DILIGENT_REMAINING_MIP_LEVELS 0xFFFFFFFFU
 
@@ -2140,6 +2429,30 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                IShaderResourceBinding*        pShaderResourceBinding,
                                                RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) PURE;
 
+
+    /// Sets the values of inline constants.
+
+    /// \param [in] pVariable     - Shader resource variable of a resource that was declared with
+    ///                             Diligent::PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag.
+    /// \param [in] pConstants    - Pointer to NumConstants 32-bit values.
+    /// \param [in] FirstConstant - Index of the first 32-bit constant to set.
+    /// \param [in] NumConstants  - The number of 32-bit constants to set.
+    ///
+    /// \remarks  Constants that are not in the [FirstConstant, FirstConstant + NumConstants) range
+    ///           keep their previous values. The new values are used by all subsequent draw and
+    ///           dispatch commands that use the shader resource binding the variable belongs to;
+    ///           the SRB does not need to be committed again.
+    ///
+    ///           Inline constants are stored in a dynamic buffer whose contents do not persist
+    ///           between frames, so the constants must be set in every frame in which they are used.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(SetInlineConstants)(THIS_
+                                            IShaderResourceVariable* pVariable,
+                                            const void*              pConstants,
+                                            Uint32                   FirstConstant,
+                                            Uint32                   NumConstants) PURE;
+
     /// Sets the stencil reference value.
 
     /// \param [in] StencilRef - Stencil reference value.
@@ -2494,6 +2807,29 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                           const DrawMeshIndirectAttribs REF Attribs) PURE;
 
 
+    /// Executes a batch of draw packets.
+
+    /// \param [in] pPackets            - An array of NumPackets draw packets, see Diligent::DrawPacket.
+    /// \param [in] NumPackets          - The number of packets in pPackets array.
+    /// \param [in] StateTransitionMode - State transition mode for the shader resources, vertex
+    ///                                   and index buffers used by the packets.
+    /// \param [in] Flags               - Additional flags, see Diligent::SUBMIT_DRAW_PACKETS_FLAGS.
+    ///
+    /// \remarks  The method is equivalent to setting the pipeline state, committing the shader
+    ///           resources, setting the vertex and index buffers and issuing the draw command for
+    ///           every packet, but only emits the state changes that differ from the previous packet.
+    ///
+    ///           After the method returns, the state of the context is the state of the last
+    ///           executed packet.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SubmitDrawPackets)(THIS_
+                                           const DrawPacket*              pPackets,
+                                           Uint32                         NumPackets,
+                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                           SUBMIT_DRAW_PACKETS_FLAGS      Flags DEFAULT_VALUE(SUBMIT_DRAW_PACKETS_FLAG_NONE)) PURE;
+
+
     /// Executes a dispatch compute command.
 
     /// \param [in] Attribs - Dispatch command attributes, see Diligent::DispatchComputeAttribs for details.
@@ -2549,6 +2885,18 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                      Uint32 REF TileSizeY) PURE;
 
 
+    /// Launches a work graph.
+
+    /// \param [in] Attribs - The command attributes, see Diligent::DispatchGraphAttribs for details.
+    ///
+    /// \remarks A work graph pipeline must be bound to the context.
+    ///          Work graphs require DeviceFeatures::WorkGraphs feature.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(DispatchGraph)(THIS_
+                                       const DispatchGraphAttribs REF Attribs) PURE;
+
+
     /// Clears a depth-stencil view.
 
     /// \param [in] pView               - Pointer to ITextureView interface to clear. The view type must be
@@ -2728,6 +3076,97 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                   IQuery* pQuery) PURE;
 
 
+    /// Retrieves the data of multiple queries at once.
+
+    /// \param [in]  NumQueries     - The number of queries in ppQueries array.
+    /// \param [in]  ppQueries      - Array of NumQueries queries. All queries must have the same type
+    ///                               and must have been ended.
+    /// \param [out] pData          - Pointer to the array of NumQueries query data structures
+    ///                               (e.g. Diligent::QueryDataTimestamp) that receive the query data.
+    ///                               The structures of the queries whose data is not available are not modified.
+    ///                               May be null to only check the query status.
+    /// \param [in]  DataSize       - The size of a single query data structure.
+    /// \param [out] pDataAvailable - Optional array of NumQueries values that receive
+    ///                               the data availability status of every query.
+    /// \param [in]  AutoInvalidate - Whether to invalidate the queries whose data has been retrieved.
+    ///                               See IQuery::GetData() for details.
+    ///
+    /// \return     The number of queries whose data is available.
+    ///
+    /// \remarks    This method is equivalent to calling IQuery::GetData() for every query, but is more efficient
+    ///             in Direct3D12 and Vulkan backends. Direct3D12 backend maps the readback buffer once for all queries,
+    ///             while Vulkan backend reads the results of contiguous queries with a single vkGetQueryPoolResults call.
+    ///             It is recommended to use this method to read the results of many queries, e.g. timestamps of a GPU profiler.
+    VIRTUAL Uint32 METHOD(GetQueryData)(THIS_
+                                        Uint32          NumQueries,
+                                        IQuery* const*  ppQueries,
+                                        void*           pData,
+                                        Uint32          DataSize,
+                                        Bool*           pDataAvailable DEFAULT_VALUE(nullptr),
+                                        Bool            AutoInvalidate DEFAULT_VALUE(true)) PURE;
+
+
+    /// Samples the GPU timestamp counter of the context's command queue and the CPU clock at the same moment.
+
+    /// \param [out] Calibration - Calibration data, see Diligent::TimestampCalibration.
+    ///
+    /// \return     true if the calibration data has been written, and false if timestamp
+    ///             calibration is not supported, in which case Calibration is not modified.
+    ///
+    /// \remarks    The calibration allows converting the timestamps returned by QUERY_TYPE_TIMESTAMP
+    ///             queries to the CPU time (see Diligent::GPUTimestampToCPUTime()), so that CPU
+    ///             and GPU events can be shown on one timeline. GPU and CPU clocks may drift
+    ///             apart over time, so the calibration should be repeated periodically, e.g. every frame.
+    ///
+    ///             Vulkan:      requires VK_EXT_calibrated_timestamps extension that supports the device
+    ///                          and the host time domains (CLOCK_MONOTONIC or QueryPerformanceCounter).
+    ///             Direct3D12:  uses ID3D12CommandQueue::GetClockCalibration().
+    ///             OpenGL:      reads GL_TIMESTAMP, which requires timer queries.
+    ///             Direct3D11:  not supported.
+    ///
+    /// \remarks Supported contexts: immediate graphics, compute and transfer contexts.
+    VIRTUAL Bool METHOD(GetTimestampCalibration)(THIS_
+                                                 TimestampCalibration REF Calibration) PURE;
+
+
+    /// Begins conditional rendering.
+
+    /// \param [in] Attribs - Conditional rendering command attributes, see Diligent::BeginConditionalRenderingAttribs.
+    ///
+    /// \remarks   Until IDeviceContext::EndConditionalRendering() is called, draw, dispatch
+    ///            and clear commands are discarded by the GPU if the predicate value in the buffer
+    ///            is zero (or non-zero if CONDITIONAL_RENDERING_FLAG_INVERTED flag is set).
+    ///            The predicate is read on the GPU, so it may be written by a compute shader
+    ///            (for example, a visibility test against a depth pyramid) or copied from another
+    ///            buffer without any CPU round-trip.
+    ///
+    ///            Conditional rendering requires DeviceFeatures::ConditionalRendering feature.
+    ///            Vulkan:      the feature requires VK_EXT_conditional_rendering extension.
+    ///            Direct3D12:  uses ID3D12GraphicsCommandList::SetPredication(). Note that
+    ///                         Direct3D12 also predicates copy and resolve commands, so only
+    ///                         draw, dispatch and clear commands should be recorded while
+    ///                         conditional rendering is active.
+    ///            Direct3D11 and OpenGL predicates are query objects rather than buffers, so
+    ///            the feature is not supported by these backends.
+    ///
+    ///            Conditional rendering may not be nested. It must either begin and end
+    ///            inside the same subpass of a render pass, or begin and end outside of
+    ///            a render pass. In the latter case, the engine ends the implicit render pass
+    ///            started by SetRenderTargets(), if necessary.
+    ///            Like queries, conditional rendering cannot span command list boundaries, so it is
+    ///            an error to flush the context while conditional rendering is active.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(BeginConditionalRendering)(THIS_
+                                                   const BeginConditionalRenderingAttribs REF Attribs) PURE;
+
+
+    /// Ends conditional rendering started by IDeviceContext::BeginConditionalRendering().
+
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(EndConditionalRendering)(THIS) PURE;
+
+
     /// Submits all pending commands in the context for execution to the command queue.
 
     /// \remarks    Only immediate contexts can be flushed.\n
@@ -2966,6 +3405,28 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                    const BuildBLASAttribs REF Attribs) PURE;
 
 
+    /// Builds multiple bottom-level acceleration structures.
+
+    /// \param [in] Attribs - Structure describing the builds, see Diligent::BuildBLASBatchAttribs for details.
+    ///
+    /// \remarks The builds in the batch are independent and may execute concurrently on the GPU.
+    ///          All state transitions required by the batch are issued at once, after which
+    ///          Vulkan backend records a single vkCmdBuildAccelerationStructuresKHR command, and
+    ///          Direct3D12 backend records the builds back to back with no barriers in between.
+    ///          This is considerably more efficient than calling BuildBLAS() for every BLAS,
+    ///          e.g. when refitting the acceleration structures of many skinned meshes every frame.
+    ///
+    ///          The builds that do not specify a scratch buffer are suballocated from the context's
+    ///          internal scratch buffer. The buffer grows as needed and is reused by every batch,
+    ///          so the scratch memory of consecutive batches is aliased and separated by a barrier.
+    ///
+    /// \note The same restrictions as for BuildBLAS() apply to every build in the batch.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(BuildBLASBatch)(THIS_
+                                        const BuildBLASBatchAttribs REF Attribs) PURE;
+
+
     /// Builds a top-level acceleration structure with the specified instances.
 
     /// \param [in] Attribs - Structure describing build TLAS command attributes, see Diligent::BuildTLASAttribs for details.
@@ -3205,6 +3666,65 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///          internal queue supports COMMAND_QUEUE_TYPE_SPARSE_BINDING.
     VIRTUAL void METHOD(BindSparseResourceMemory)(THIS_
                                                   const BindSparseResourceMemoryAttribs REF Attribs) PURE;
+
+
+    /// Returns the numbers of redundant state-setting calls filtered out by the context.
+
+    /// \remarks   The counters accumulate over the lifetime of the context. Vertex and index buffer
+    ///            calls are only filtered when the buffers are already in the required state or
+    ///            RESOURCE_STATE_TRANSITION_MODE_NONE is used, so no transition is skipped.
+    VIRTUAL const DeviceContextStateFilterStats REF METHOD(GetStateFilterStats)(THIS) CONST PURE;
+
+
+    /// Returns the device context statistics, see Diligent::DeviceContextStatistics.
+
+    /// \remarks   The statistics are updated by the thread that records commands into the
+    ///            context and must be queried from the same thread.
+    VIRTUAL const DeviceContextStatistics REF METHOD(GetStatistics)(THIS) CONST PURE;
+
+
+    /// Enables or disables debug group profiling.
+
+    /// \param [in] Enable - Whether to profile the debug groups begun after this call.
+    ///
+    /// \remarks   When profiling is enabled, the context wraps every debug group, see BeginDebugGroup(),
+    ///            into a duration query and, if no enclosing group collects them, into a pipeline
+    ///            statistics query, provided that the corresponding features are enabled.
+    ///            The results are read in batches by FinishFrame() without waiting for the GPU,
+    ///            see GetDebugGroupProfile().
+    ///
+    ///            In Vulkan, a profiled group that collects pipeline statistics must begin and end
+    ///            outside of explicit render passes, or in the same subpass.
+    ///            In OpenGL, duration queries may not overlap, so only the outermost profiled
+    ///            group is timed.
+    ///
+    ///            Only immediate contexts support debug group profiling.
+    VIRTUAL void METHOD(SetDebugGroupProfiling)(THIS_
+                                                Bool Enable) PURE;
+
+
+    /// Returns the profiles of the debug groups of the most recent frame whose results are available.
+
+    /// \param [out] NumGroups - The number of profiled groups.
+    ///
+    /// \return    Pointer to the array of NumGroups profiles, in the order the groups were begun.
+    ///            The array is valid until the next call to FinishFrame().
+    VIRTUAL const DebugGroupProfile* METHOD(GetDebugGroupProfile)(THIS_
+                                                                  Uint32 REF NumGroups) CONST PURE;
+
+
+    /// Enables or disables command argument validation in Release builds.
+
+    /// \param [in] Enable - Whether to verify the arguments of the commands recorded after this call.
+    ///
+    /// \remarks   The initial state is defined by the VALIDATION_FLAG_CHECK_COMMAND_ARGUMENTS flag
+    ///            of EngineCreateInfo::ValidationFlags. When validation is disabled, the overhead
+    ///            is a single flag check per command.
+    ///
+    ///            Debug/Development builds always perform the full validation, and the method
+    ///            has no effect in these builds.
+    VIRTUAL void METHOD(SetCommandValidation)(THIS_
+                                              Bool Enable) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -3219,6 +3739,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_SetPipelineState(This, ...)              CALL_IFACE_METHOD(DeviceContext, SetPipelineState,          This, __VA_ARGS__)
 #    define IDeviceContext_TransitionShaderResources(This, ...)     CALL_IFACE_METHOD(DeviceContext, TransitionShaderResources, This, __VA_ARGS__)
 #    define IDeviceContext_CommitShaderResources(This, ...)         CALL_IFACE_METHOD(DeviceContext, CommitShaderResources,     This, __VA_ARGS__)
+#    define IDeviceContext_SetInlineConstants(This, ...)            CALL_IFACE_METHOD(DeviceContext, SetInlineConstants,        This, __VA_ARGS__)
 #    define IDeviceContext_SetStencilRef(This, ...)                 CALL_IFACE_METHOD(DeviceContext, SetStencilRef,             This, __VA_ARGS__)
 #    define IDeviceContext_SetBlendFactors(This, ...)               CALL_IFACE_METHOD(DeviceContext, SetBlendFactors,           This, __VA_ARGS__)
 #    define IDeviceContext_SetVertexBuffers(This, ...)              CALL_IFACE_METHOD(DeviceContext, SetVertexBuffers,          This, __VA_ARGS__)
@@ -3237,10 +3758,12 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)           CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                      CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirect,          This, __VA_ARGS__)
+#    define IDeviceContext_SubmitDrawPackets(This, ...)             CALL_IFACE_METHOD(DeviceContext, SubmitDrawPackets,         This, __VA_ARGS__)
 #    define IDeviceContext_DispatchCompute(This, ...)               CALL_IFACE_METHOD(DeviceContext, DispatchCompute,           This, __VA_ARGS__)
 #    define IDeviceContext_DispatchComputeIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DispatchComputeIndirect,   This, __VA_ARGS__)
 #    define IDeviceContext_DispatchTile(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DispatchTile,              This, __VA_ARGS__)
 #    define IDeviceContext_GetTileSize(This, ...)                   CALL_IFACE_METHOD(DeviceContext, GetTileSize,               This, __VA_ARGS__)
+#    define IDeviceContext_DispatchGraph(This, ...)                 CALL_IFACE_METHOD(DeviceContext, DispatchGraph,             This, __VA_ARGS__)
 #    define IDeviceContext_ClearDepthStencil(This, ...)             CALL_IFACE_METHOD(DeviceContext, ClearDepthStencil,         This, __VA_ARGS__)
 #    define IDeviceContext_ClearRenderTarget(This, ...)             CALL_IFACE_METHOD(DeviceContext, ClearRenderTarget,         This, __VA_ARGS__)
 #    define IDeviceContext_FinishCommandList(This, ...)             CALL_IFACE_METHOD(DeviceContext, FinishCommandList,         This, __VA_ARGS__)
@@ -3250,6 +3773,10 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_WaitForIdle(This)                        CALL_IFACE_METHOD(DeviceContext, WaitForIdle,               This)
 #    define IDeviceContext_BeginQuery(This, ...)                    CALL_IFACE_METHOD(DeviceContext, BeginQuery,                This, __VA_ARGS__)
 #    define IDeviceContext_EndQuery(This, ...)                      CALL_IFACE_METHOD(DeviceContext, EndQuery,                  This, __VA_ARGS__)
+#    define IDeviceContext_GetQueryData(This, ...)                  CALL_IFACE_METHOD(DeviceContext, GetQueryData,              This, __VA_ARGS__)
+#    define IDeviceContext_GetTimestampCalibration(This, ...)       CALL_IFACE_METHOD(DeviceContext, GetTimestampCalibration,   This, __VA_ARGS__)
+#    define IDeviceContext_BeginConditionalRendering(This, ...)     CALL_IFACE_METHOD(DeviceContext, BeginConditionalRendering, This, __VA_ARGS__)
+#    define IDeviceContext_EndConditionalRendering(This)            CALL_IFACE_METHOD(DeviceContext, EndConditionalRendering,   This)
 #    define IDeviceContext_Flush(This)                              CALL_IFACE_METHOD(DeviceContext, Flush,                     This)
 #    define IDeviceContext_UpdateBuffer(This, ...)                  CALL_IFACE_METHOD(DeviceContext, UpdateBuffer,              This, __VA_ARGS__)
 #    define IDeviceContext_CopyBuffer(This, ...)                    CALL_IFACE_METHOD(DeviceContext, CopyBuffer,                This, __VA_ARGS__)
@@ -3265,6 +3792,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_TransitionResourceStates(This, ...)      CALL_IFACE_METHOD(DeviceContext, TransitionResourceStates,  This, __VA_ARGS__)
 #    define IDeviceContext_ResolveTextureSubresource(This, ...)     CALL_IFACE_METHOD(DeviceContext, ResolveTextureSubresource, This, __VA_ARGS__)
 #    define IDeviceContext_BuildBLAS(This, ...)                     CALL_IFACE_METHOD(DeviceContext, BuildBLAS,                 This, __VA_ARGS__)
+#    define IDeviceContext_BuildBLASBatch(This, ...)                CALL_IFACE_METHOD(DeviceContext, BuildBLASBatch,            This, __VA_ARGS__)
 #    define IDeviceContext_BuildTLAS(This, ...)                     CALL_IFACE_METHOD(DeviceContext, BuildTLAS,                 This, __VA_ARGS__)
 #    define IDeviceContext_CopyBLAS(This, ...)                      CALL_IFACE_METHOD(DeviceContext, CopyBLAS,                  This, __VA_ARGS__)
 #    define IDeviceContext_CopyTLAS(This, ...)                      CALL_IFACE_METHOD(DeviceContext, CopyTLAS,                  This, __VA_ARGS__)
@@ -3282,6 +3810,11 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_UnlockCommandQueue(This)                 CALL_IFACE_METHOD(DeviceContext, UnlockCommandQueue,        This)
 #    define IDeviceContext_SetShadingRate(This, ...)                CALL_IFACE_METHOD(DeviceContext, SetShadingRate,            This, __VA_ARGS__)
 #    define IDeviceContext_BindSparseResourceMemory(This, ...)      CALL_IFACE_METHOD(DeviceContext, BindSparseResourceMemory,  This, __VA_ARGS__)
+#    define IDeviceContext_GetStateFilterStats(This)                CALL_IFACE_METHOD(DeviceContext, GetStateFilterStats,       This)
+#    define IDeviceContext_GetStatistics(This)                      CALL_IFACE_METHOD(DeviceContext, GetStatistics,             This)
+#    define IDeviceContext_SetDebugGroupProfiling(This, ...)        CALL_IFACE_METHOD(DeviceContext, SetDebugGroupProfiling,    This, __VA_ARGS__)
+#    define IDeviceContext_GetDebugGroupProfile(This, ...)          CALL_IFACE_METHOD(DeviceContext, GetDebugGroupProfile,      This, __VA_ARGS__)
+#    define IDeviceContext_SetCommandValidation(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetCommandValidation,      This, __VA_ARGS__)
 
 // clang-format on
 
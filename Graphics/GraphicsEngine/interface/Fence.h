@@ -71,6 +71,15 @@ struct FenceDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 };
 typedef struct FenceDesc FenceDesc;
 
+
+/// Fence completion callback, see IFence::EnqueueCompletionCallback().
+
+/// \param [in] CompletedValue - The fence value that was observed when the callback was invoked.
+///                              The value is greater than or equal to the value the callback was
+///                              enqueued for.
+/// \param [in] pUserData      - User-provided data passed to IFence::EnqueueCompletionCallback().
+typedef void(DILIGENT_CALL_TYPE* FenceCompletionCallbackType)(Uint64 CompletedValue, void* pUserData);
+
 // clang-format off
 
 #define DILIGENT_INTERFACE_NAME IFence
@@ -125,6 +134,31 @@ DILIGENT_BEGIN_INTERFACE(IFence, IDeviceObject)
     /// \note  The method blocks the execution of the calling thread until the wait is complete.
     VIRTUAL void METHOD(Wait)(THIS_
                               Uint64 Value) PURE;
+
+
+    /// Enqueues a callback that will be invoked when the fence reaches or exceeds the specified value.
+
+    /// \param [in] Value     - The value that the fence must reach before the callback is invoked.
+    /// \param [in] Callback  - The callback function.
+    /// \param [in] pUserData - User data that will be passed to the callback.
+    ///
+    /// \remarks  Callbacks of all fences are serviced by a single device-wide waiter, so an application
+    ///           does not need to poll IFence::GetCompletedValue() or block a thread in IFence::Wait().
+    ///           In Direct3D12 and Vulkan backends, the waiter is a dedicated thread that blocks until
+    ///           any of the fences with pending callbacks reaches its value, and callbacks are invoked
+    ///           from that thread. In other backends, callbacks are invoked from
+    ///           IDeviceContext::FinishFrame() of the immediate context.
+    ///
+    /// \remarks  If the fence has already reached the value, the callback will be invoked the next
+    ///           time the waiter processes the fence, not from within this method.
+    ///
+    /// \remarks  Callbacks must be lightweight. They may enqueue other callbacks, but must not
+    ///           release the last reference to the render device.
+    ///           Callbacks that are still pending when the fence is destroyed are never invoked.
+    VIRTUAL void METHOD(EnqueueCompletionCallback)(THIS_
+                                                   Uint64                      Value,
+                                                   FenceCompletionCallbackType Callback,
+                                                   void*                       pUserData) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -136,9 +170,10 @@ DILIGENT_END_INTERFACE
 
 #    define IFence_GetDesc(This) (const struct FenceDesc*)IDeviceObject_GetDesc(This)
 
-#    define IFence_GetCompletedValue(This) CALL_IFACE_METHOD(Fence, GetCompletedValue, This)
-#    define IFence_Signal(This, ...)       CALL_IFACE_METHOD(Fence, Signal,            This, __VA_ARGS__)
-#    define IFence_Wait(This, ...)         CALL_IFACE_METHOD(Fence, Wait,              This, __VA_ARGS__)
+#    define IFence_GetCompletedValue(This)              CALL_IFACE_METHOD(Fence, GetCompletedValue,         This)
+#    define IFence_Signal(This, ...)                    CALL_IFACE_METHOD(Fence, Signal,                    This, __VA_ARGS__)
+#    define IFence_Wait(This, ...)                      CALL_IFACE_METHOD(Fence, Wait,                      This, __VA_ARGS__)
+#    define IFence_EnqueueCompletionCallback(This, ...) CALL_IFACE_METHOD(Fence, EnqueueCompletionCallback, This, __VA_ARGS__)
 
 // clang-format on
 
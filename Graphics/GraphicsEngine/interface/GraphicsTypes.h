@@ -83,7 +83,8 @@ DILIGENT_TYPED_ENUM(SHADER_TYPE, Uint32)
     SHADER_TYPE_RAY_INTERSECTION = 0x1000, ///< Ray intersection shader
     SHADER_TYPE_CALLABLE         = 0x2000, ///< Callable shader
     SHADER_TYPE_TILE             = 0x4000, ///< Tile shader (Only for Metal backend)
-    SHADER_TYPE_LAST             = SHADER_TYPE_TILE,
+    SHADER_TYPE_WORK_GRAPH       = 0x8000, ///< Work graph shader library (Only for Direct3D12 backend)
+    SHADER_TYPE_LAST             = SHADER_TYPE_WORK_GRAPH,
 
     /// All graphics pipeline shader stages
     SHADER_TYPE_ALL_GRAPHICS    = SHADER_TYPE_VERTEX   |
@@ -1765,8 +1766,36 @@ struct DeviceFeatures
     ///             translate into MSL framebuffer fetch operations that
     ///             allow implementing subpasses within a single render command
     ///             encoder.
+    ///
+    ///             OpenGLES: this feature requires GL_EXT_shader_framebuffer_fetch
+    ///             and is only enabled when requested. Consecutive subpasses whose
+    ///             input attachments are written by previous subpasses share one FBO,
+    ///             and pixel shaders must read input attachment k with framebuffer fetch
+    ///             from location RenderTargetAttachmentCount + k (or from the render
+    ///             target location if the input attachment is also a render target).
     DEVICE_FEATURE_STATE SubpassFramebufferFetch DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports dynamic pipeline states (see Diligent::PIPELINE_DYNAMIC_STATE_FLAGS).
+
+    /// \remarks   Vulkan: this feature requires VK_EXT_extended_dynamic_state extension.
+    ///             When the feature is enabled, graphics pipelines may leave cull mode,
+    ///             depth test, stencil test and primitive topology out of the pipeline
+    ///             object and set them through IDeviceContextVk.
+    DEVICE_FEATURE_STATE DynamicPipelineStates DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports work graphs (see Diligent::WorkGraphPipelineStateCreateInfo).
+
+    /// \remarks   Direct3D12: this feature requires D3D12_WORK_GRAPHS_TIER_1_0
+    ///             and Agility SDK headers that define ID3D12GraphicsCommandList10.
+    DEVICE_FEATURE_STATE WorkGraphs DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports conditional rendering (see IDeviceContext::BeginConditionalRendering).
+
+    /// \remarks   Vulkan: this feature requires VK_EXT_conditional_rendering extension.
+    ///             Direct3D12: always supported.
+    ///             Direct3D11 and OpenGL: not supported as their predicates are query objects.
+    DEVICE_FEATURE_STATE ConditionalRendering DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr DeviceFeatures() noexcept {}
 
@@ -1810,11 +1839,14 @@ struct DeviceFeatures
     Handler(TransferQueueTimestampQueries)     \
     Handler(VariableRateShading)               \
     Handler(SparseResources)                   \
-    Handler(SubpassFramebufferFetch)
+    Handler(SubpassFramebufferFetch)           \
+    Handler(DynamicPipelineStates)             \
+    Handler(WorkGraphs)                        \
+    Handler(ConditionalRendering)
 
     explicit constexpr DeviceFeatures(DEVICE_FEATURE_STATE State) noexcept
     {
-        static_assert(sizeof(*this) == 40, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
+        static_assert(sizeof(*this) == 43, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
     #define INIT_FEATURE(Feature) Feature = State;
         ENUMERATE_DEVICE_FEATURES(INIT_FEATURE)
     #undef INIT_FEATURE
@@ -2426,7 +2458,17 @@ DILIGENT_TYPED_ENUM(VALIDATION_FLAGS, Uint32)
     ///           This type of validation is never performed in Release builds.
     ///
     /// \note   This option is currently supported by Vulkan backend only.
-    VALIDATION_FLAG_CHECK_SHADER_BUFFER_SIZE    = 0x01
+    VALIDATION_FLAG_CHECK_SHADER_BUFFER_SIZE    = 0x01,
+
+    /// Verify the arguments of draw, dispatch, buffer update and buffer copy commands
+    /// in Release builds, see IDeviceContext::SetCommandValidation().
+    ///
+    /// \remarks  The checks only use the command arguments and the bound pipeline and
+    ///           index buffer, and log an error when an argument is invalid. Resource states
+    ///           and shader resource bindings are not verified.
+    ///           Debug/Development builds always perform the full validation, so this flag
+    ///           has no effect in these builds.
+    VALIDATION_FLAG_CHECK_COMMAND_ARGUMENTS     = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(VALIDATION_FLAGS)
 
@@ -3262,6 +3304,315 @@ struct ImmediateContextCreateInfo
 typedef struct ImmediateContextCreateInfo ImmediateContextCreateInfo;
 
 
+/// Memory allocation tag.
+
+/// Allocation tags identify the engine subsystem that allocated the memory,
+/// see IRenderDevice::GetMemoryAllocationStatistics().
+DILIGENT_TYPED_ENUM(MEMORY_ALLOCATION_TAG, Uint8)
+{
+    /// Memory that is not attributed to any specific subsystem.
+    MEMORY_ALLOCATION_TAG_UNKNOWN = 0,
+
+    /// Texture and texture view objects.
+    MEMORY_ALLOCATION_TAG_TEXTURE,
+
+    /// Buffer and buffer view objects.
+    MEMORY_ALLOCATION_TAG_BUFFER,
+
+    /// Shader objects.
+    MEMORY_ALLOCATION_TAG_SHADER,
+
+    /// Pipeline state objects and pipeline resource signatures.
+    MEMORY_ALLOCATION_TAG_PIPELINE_STATE,
+
+    /// Shader resource binding objects.
+    MEMORY_ALLOCATION_TAG_SHADER_RESOURCE_BINDING,
+
+    /// Device object archives and objects unpacked from them.
+    MEMORY_ALLOCATION_TAG_ARCHIVE,
+
+    /// Command recording and submission: draw, dispatch, resource commits,
+    /// state transitions and command buffer submission.
+    MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT,
+
+    /// Queues that keep released resources alive until the GPU stops using them.
+    MEMORY_ALLOCATION_TAG_RELEASE_QUEUE,
+
+    /// The number of memory allocation tags.
+    MEMORY_ALLOCATION_TAG_COUNT
+};
+
+
+/// Memory allocation statistics of a single allocation tag.
+struct MemoryAllocationTagStatistics
+{
+    /// The total size of all currently allocated memory blocks, in bytes.
+    Uint64 CurrentSize            DEFAULT_INITIALIZER(0);
+
+    /// The maximum value of CurrentSize since the device was created.
+    Uint64 PeakSize               DEFAULT_INITIALIZER(0);
+
+    /// The number of currently allocated memory blocks.
+    Uint64 CurrentAllocationCount DEFAULT_INITIALIZER(0);
+
+    /// The total number of allocations since the device was created.
+    Uint64 TotalAllocationCount   DEFAULT_INITIALIZER(0);
+
+    /// The number of allocations made during the last completed frame, i.e. between
+    /// the last two calls of IDeviceContext::FinishFrame() of the first immediate context.
+
+    /// \remarks   In a steady-state frame, the engine does not allocate memory for command
+    ///            recording and submission, so the value of MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT
+    ///            and MEMORY_ALLOCATION_TAG_RELEASE_QUEUE tags is expected to be zero.
+    Uint64 FrameAllocationCount   DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryAllocationTagStatistics MemoryAllocationTagStatistics;
+
+
+/// Memory allocation statistics, see IRenderDevice::GetMemoryAllocationStatistics().
+struct MemoryAllocationStatistics
+{
+    /// Statistics of every allocation tag, see Diligent::MEMORY_ALLOCATION_TAG.
+    MemoryAllocationTagStatistics Tags[MEMORY_ALLOCATION_TAG_COUNT];
+};
+typedef struct MemoryAllocationStatistics MemoryAllocationStatistics;
+
+
+/// GPU memory category, see IRenderDevice::GetGPUMemoryStatistics().
+DILIGENT_TYPED_ENUM(GPU_MEMORY_CATEGORY, Uint8)
+{
+    /// Memory that is not attributed to any specific category.
+    GPU_MEMORY_CATEGORY_UNKNOWN = 0,
+
+    /// Texture memory.
+    GPU_MEMORY_CATEGORY_TEXTURE,
+
+    /// Buffer memory.
+    GPU_MEMORY_CATEGORY_BUFFER,
+
+    /// Memory objects created by IRenderDevice::CreateDeviceMemory().
+    GPU_MEMORY_CATEGORY_DEVICE_MEMORY,
+
+    /// Bottom-level and top-level acceleration structures.
+    GPU_MEMORY_CATEGORY_ACCELERATION_STRUCTURE,
+
+    /// Query result readback buffers.
+    GPU_MEMORY_CATEGORY_QUERY,
+
+    /// Shader-visible descriptor heaps.
+    GPU_MEMORY_CATEGORY_DESCRIPTOR_HEAP,
+
+    /// Upload heaps that back dynamic buffers and transient uploads.
+    GPU_MEMORY_CATEGORY_DYNAMIC_HEAP,
+
+    /// Memory pages that the engine suballocates resources from.
+    GPU_MEMORY_CATEGORY_MEMORY_POOL,
+
+    /// The number of GPU memory categories.
+    GPU_MEMORY_CATEGORY_COUNT
+};
+
+
+/// GPU memory allocation type, see IRenderDevice::GetGPUMemoryStatistics().
+DILIGENT_TYPED_ENUM(GPU_MEMORY_ALLOCATION_TYPE, Uint8)
+{
+    /// The allocation owns dedicated device memory (e.g. a committed resource or a memory pool page).
+    GPU_MEMORY_ALLOCATION_TYPE_COMMITTED = 0,
+
+    /// The resource is placed in the memory owned by another object (e.g. a sparse resource
+    /// bound to IDeviceMemory). The allocated size of such resources is zero.
+    GPU_MEMORY_ALLOCATION_TYPE_PLACED,
+
+    /// The resource is suballocated from a memory pool page owned by the engine
+    /// (see GPU_MEMORY_CATEGORY_MEMORY_POOL).
+    GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED,
+
+    /// The number of GPU memory allocation types.
+    GPU_MEMORY_ALLOCATION_TYPE_COUNT
+};
+
+
+/// GPU memory usage of a group of allocations.
+struct GPUMemoryUsage
+{
+    /// The total size requested by the allocations, in bytes.
+    Uint64 Size              DEFAULT_INITIALIZER(0);
+
+    /// The total size occupied by the allocations, in bytes.
+
+    /// The difference between AllocatedSize and Size is the overhead
+    /// of padding, alignment and tiling.
+    Uint64 AllocatedSize     DEFAULT_INITIALIZER(0);
+
+    /// The maximum value of AllocatedSize since the device was created.
+    Uint64 PeakAllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// The number of allocations.
+    Uint64 Count             DEFAULT_INITIALIZER(0);
+};
+typedef struct GPUMemoryUsage GPUMemoryUsage;
+
+
+/// GPU memory statistics, see IRenderDevice::GetGPUMemoryStatistics().
+
+/// The memory allocated from the driver is the allocated size of committed allocations.
+/// Suballocated resources occupy memory pool pages, and placed resources occupy the memory
+/// of the objects they are bound to, so they are not included into this sum.
+struct GPUMemoryStatistics
+{
+    /// Memory usage of every category, see Diligent::GPU_MEMORY_CATEGORY.
+    GPUMemoryUsage Categories[GPU_MEMORY_CATEGORY_COUNT];
+
+    /// Memory usage of every allocation type, see Diligent::GPU_MEMORY_ALLOCATION_TYPE.
+    GPUMemoryUsage Types[GPU_MEMORY_ALLOCATION_TYPE_COUNT];
+};
+typedef struct GPUMemoryStatistics GPUMemoryStatistics;
+
+
+/// GPU memory allocation information, see IRenderDevice::GetGPUMemoryAllocations().
+struct GPUMemoryAllocationInfo
+{
+    /// Name of the object that owns the allocation, truncated if necessary.
+    Char Name[DILIGENT_GPU_MEMORY_ALLOCATION_NAME_LENGTH] DEFAULT_INITIALIZER({});
+
+    /// Memory category.
+    GPU_MEMORY_CATEGORY Category        DEFAULT_INITIALIZER(GPU_MEMORY_CATEGORY_UNKNOWN);
+
+    /// Allocation type.
+    GPU_MEMORY_ALLOCATION_TYPE Type     DEFAULT_INITIALIZER(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED);
+
+    /// The size requested by the object, in bytes.
+    Uint64 Size                         DEFAULT_INITIALIZER(0);
+
+    /// The size occupied by the allocation, in bytes.
+    Uint64 AllocatedSize                DEFAULT_INITIALIZER(0);
+};
+typedef struct GPUMemoryAllocationInfo GPUMemoryAllocationInfo;
+
+
+/// Device metric, see IRenderDevice::GetMetrics().
+DILIGENT_TYPED_ENUM(DEVICE_METRIC, Uint8)
+{
+    /// IDeviceContext::CommitShaderResources() calls.
+    DEVICE_METRIC_COMMIT_SHADER_RESOURCES = 0,
+
+    /// IDeviceContext::TransitionResourceStates() calls.
+    DEVICE_METRIC_TRANSITION_RESOURCE_STATES,
+
+    /// IDeviceContext::MapBuffer() calls.
+    DEVICE_METRIC_MAP_BUFFER,
+
+    /// Descriptor and descriptor set allocations (Direct3D12 and Vulkan only).
+    DEVICE_METRIC_DESCRIPTOR_ALLOCATION,
+
+    /// Pipeline state creation calls. For asynchronously created pipelines,
+    /// only the time spent in the calling thread is measured.
+    DEVICE_METRIC_PIPELINE_STATE_CREATION,
+
+    /// The number of device metrics.
+    DEVICE_METRIC_COUNT
+};
+
+
+/// Statistics of a single device metric.
+
+/// All times are in nanoseconds.
+struct DeviceMetricStatistics
+{
+    /// The total number of events.
+    Uint64 Count          DEFAULT_INITIALIZER(0);
+
+    /// The total time of all events.
+    Uint64 TotalTime      DEFAULT_INITIALIZER(0);
+
+    /// The maximum time of a single event.
+    Uint64 MaxTime        DEFAULT_INITIALIZER(0);
+
+    /// The number of events in the last completed frame.
+    Uint64 LastFrameCount DEFAULT_INITIALIZER(0);
+
+    /// The total time of the events in the last completed frame.
+    Uint64 LastFrameTime  DEFAULT_INITIALIZER(0);
+
+    /// Event time histogram.
+
+    /// Element i contains the number of events that took [2^i, 2^(i+1)) nanoseconds.
+    /// The last element also counts all longer events.
+    Uint64 Histogram[DILIGENT_METRIC_HISTOGRAM_SIZE] DEFAULT_INITIALIZER({});
+};
+typedef struct DeviceMetricStatistics DeviceMetricStatistics;
+
+
+/// Device metrics, see IRenderDevice::GetMetrics().
+struct DeviceMetrics
+{
+    /// Statistics of every metric, see Diligent::DEVICE_METRIC.
+    DeviceMetricStatistics Metrics[DEVICE_METRIC_COUNT];
+};
+typedef struct DeviceMetrics DeviceMetrics;
+
+
+/// Render device statistics, see IRenderDevice::GetStatistics().
+struct DeviceStatistics
+{
+    /// The total number of CPU descriptors (Direct3D12) or descriptor sets (Vulkan)
+    /// allocated from the device-wide allocators since the device was created.
+    Uint64 DescriptorCount             DEFAULT_INITIALIZER(0);
+
+    /// The total number of command buffers submitted to all command queues
+    /// since the device was created (Direct3D12 and Vulkan only).
+    Uint64 CommandBufferCount          DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines that were loaded from a pipeline state cache
+    /// (Direct3D12, OpenGL, and Vulkan with pipeline creation feedback only).
+    Uint64 PipelineCacheHitCount       DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines that were looked up in a pipeline state cache, but
+    /// had to be compiled because they were not found (Direct3D12, OpenGL, and Vulkan
+    /// with pipeline creation feedback only).
+    Uint64 PipelineCacheMissCount      DEFAULT_INITIALIZER(0);
+
+    /// The number of released objects that wait for the command buffers
+    /// that may reference them to be submitted (Direct3D12 and Vulkan only).
+    Uint64 StaleResourceCount          DEFAULT_INITIALIZER(0);
+
+    /// The number of released objects that wait for the GPU to finish
+    /// the command buffers that reference them (Direct3D12 and Vulkan only).
+    Uint64 PendingReleaseResourceCount DEFAULT_INITIALIZER(0);
+
+    /// The size, in bytes, of the device memory currently suballocated
+    /// by the memory manager (Vulkan only).
+    Uint64 DeviceMemoryUsedSize        DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceStatistics DeviceStatistics;
+
+
+/// Render device startup statistics, see IRenderDevice::GetStartupStatistics().
+
+/// All times are in nanoseconds. Phases that are not performed by the backend
+/// or by the engine factory method that created the device are zero.
+struct DeviceStartupStatistics
+{
+    /// The time spent creating the API instance (Vulkan instance, DXGI factory,
+    /// OpenGL context), including loading the API library.
+    Uint64 InstanceCreationTime      DEFAULT_INITIALIZER(0);
+
+    /// The time spent selecting the adapter and querying its properties,
+    /// features and extensions.
+    Uint64 AdapterQueryTime          DEFAULT_INITIALIZER(0);
+
+    /// The time spent creating the native device and command queues.
+    Uint64 DeviceCreationTime        DEFAULT_INITIALIZER(0);
+
+    /// The time spent creating the engine render device and device contexts.
+    Uint64 EngineObjectsCreationTime DEFAULT_INITIALIZER(0);
+
+    /// The total time spent in the engine factory method that created the device.
+    Uint64 TotalTime                 DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceStartupStatistics DeviceStartupStatistics;
+
+
 /// Engine creation information
 struct EngineCreateInfo
 {
@@ -3301,6 +3652,12 @@ struct EngineCreateInfo
     /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, and IEngineFactoryVk::CreateDeviceAndContextsVk)
     /// starting at position max(1, NumImmediateContexts).
     ///
+    /// \remarks In OpenGL backend, deferred contexts are written to ppImmediateContext array by
+    ///          IEngineFactoryOpenGL::CreateDeviceAndSwapChainGL and IEngineFactoryOpenGL::AttachToActiveGLContext
+    ///          after the immediate context. Commands recorded by deferred contexts are
+    ///          executed by the immediate context in IDeviceContext::ExecuteCommandLists
+    ///          on the thread that owns the GL context.
+    ///
     /// \warning  An application must manually call IDeviceContext::FinishFrame for
     ///           deferred contexts to let the engine release stale resources.
     Uint32                   NumDeferredContexts    DEFAULT_INITIALIZER(0);
@@ -3332,6 +3689,64 @@ struct EngineCreateInfo
     /// operations in the engine
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
 
+    /// An optional thread pool that will be used to compile shaders and pipeline states
+    /// created with SHADER_COMPILE_FLAG_ASYNCHRONOUS and PSO_CREATE_FLAG_ASYNCHRONOUS flags.
+
+    /// \remarks   If the thread pool is null, asynchronous compilation is disabled and
+    ///            all objects are created synchronously regardless of the flags.
+    ///            The engine keeps a strong reference to the thread pool.
+    struct IThreadPool* pAsyncShaderCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
+
+    /// Whether to collect shader and pipeline compilation statistics.
+
+    /// When enabled, the device records the compilation time of every shader and
+    /// pipeline state broken down by compilation stage, see IRenderDevice::GetCompilationStatistics().
+    Bool EnableCompilationStatistics DEFAULT_INITIALIZER(false);
+
+    /// Whether to track the memory allocated through the raw memory allocator.
+
+    /// When enabled, the engine wraps the raw memory allocator (see pRawMemAllocator) into an allocator
+    /// that attributes every allocation to a subsystem, see IRenderDevice::GetMemoryAllocationStatistics().
+    ///
+    /// \remarks   The raw memory allocator is shared by all devices in the process, so memory tracking
+    ///            can only be enabled when the first device is created.
+    Bool EnableMemoryTracking DEFAULT_INITIALIZER(false);
+
+    /// Whether to track GPU memory allocations.
+
+    /// When enabled, the device records every GPU memory allocation made by the engine
+    /// (resources, device memory objects, memory pool pages, descriptor heaps, query buffers,
+    /// dynamic heaps) with its category and owner name, see IRenderDevice::GetGPUMemoryStatistics().
+    Bool EnableGPUMemoryTracking DEFAULT_INITIALIZER(false);
+
+    /// Whether to collect device metrics.
+
+    /// When enabled, the device measures the time spent in the engine hot paths,
+    /// see IRenderDevice::GetMetrics(). When disabled, the overhead is a single pointer check.
+    Bool EnableMetrics DEFAULT_INITIALIZER(false);
+
+    /// Whether to record GPU breadcrumbs.
+
+    /// When enabled, immediate contexts write a marker to a small host-visible buffer before and
+    /// after every draw, dispatch and debug group. When the device is lost, the engine reads the
+    /// markers back and logs the commands that were executing along with their debug group names.
+    ///
+    /// \remarks   Breadcrumbs are supported in Direct3D12 and in Vulkan on devices that expose
+    ///            VK_AMD_buffer_marker or VK_NV_device_diagnostic_checkpoints. The flag is ignored
+    ///            by other backends.
+    Bool EnableGPUBreadcrumbs DEFAULT_INITIALIZER(false);
+
+    /// Whether to load the shader compiler library on a background thread.
+
+    /// By default, the DirectX Shader Compiler used by Direct3D12 and Vulkan backends is
+    /// loaded when it is first needed. When this flag is set, the device starts loading
+    /// the compiler on a worker thread as soon as it is created, so that the load overlaps
+    /// with the creation of the device contexts and swap chains and the application's own
+    /// initialization. Shader creation that needs the compiler waits until the load completes.
+    ///
+    /// \remarks   The flag is ignored by backends that do not use the DirectX Shader Compiler.
+    Bool AsyncShaderCompilerLoad DEFAULT_INITIALIZER(false);
+
 #if DILIGENT_CPP_INTERFACE
     EngineCreateInfo() noexcept
     {
@@ -3348,7 +3763,7 @@ struct EngineCreateInfo
         ValidationFlags = VALIDATION_FLAG_NONE;
         if (Level >= VALIDATION_LEVEL_1)
         {
-            ValidationFlags |= VALIDATION_FLAG_CHECK_SHADER_BUFFER_SIZE;
+            ValidationFlags |= VALIDATION_FLAG_CHECK_SHADER_BUFFER_SIZE | VALIDATION_FLAG_CHECK_COMMAND_ARGUMENTS;
         }
     }
 #endif
@@ -3401,6 +3816,19 @@ struct EngineD3D11CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Direct3D11-specific validation options, see Diligent::D3D11_VALIDATION_FLAGS.
     D3D11_VALIDATION_FLAGS D3D11ValidationFlags DEFAULT_INITIALIZER(D3D11_VALIDATION_FLAG_NONE);
 
+    /// The size of the dynamic constant ring, in bytes.
+
+    /// When the device supports mapping dynamic constant buffers with D3D11_MAP_WRITE_NO_OVERWRITE
+    /// (Direct3D11.1), the immediate context suballocates the contents of USAGE_DYNAMIC buffers
+    /// that are only bound as uniform buffers from a single ring buffer and binds them with
+    /// constant buffer offsets. This avoids the driver renaming every buffer that is mapped with
+    /// MAP_FLAG_DISCARD. When the ring is full, the buffer's own D3D11 buffer is used.
+    /// Set this member to zero to disable the dynamic constant ring.
+    ///
+    /// \note   The contents of suballocated buffers are not visible through the ID3D11Buffer
+    ///         object returned by IBufferD3D11::GetD3D11Buffer().
+    Uint32 DynamicConstantRingSize DEFAULT_INITIALIZER(4 << 20);
+
 #if DILIGENT_CPP_INTERFACE
     EngineD3D11CreateInfo() noexcept :
         EngineD3D11CreateInfo{EngineCreateInfo{}}
@@ -3549,6 +3977,51 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// global dynamic heap manager to avoid page creation at run time.
     Uint32 NumDynamicHeapPagesToReserve DEFAULT_INITIALIZER(1);
 
+    /// Number of dynamic heap pages that every device context keeps across frames.
+
+    /// When the GPU is done with a page, the page goes back to the context that used it.
+    /// The context then reuses it without accessing the shared page lists of the global
+    /// dynamic heap manager. When zero, all pages are returned to the shared lists.
+    Uint32 NumDynamicHeapPagesToPin DEFAULT_INITIALIZER(0);
+
+    /// Whether device contexts adapt the dynamic heap page size to the observed usage.
+
+    /// When enabled, DynamicHeapPageSize defines the minimum page size. Every context
+    /// tracks the per-frame high-water mark of its dynamic heap and grows the page size
+    /// (up to 128 times the minimum size) when a frame does not fit into a single page.
+    /// The page size shrinks back after the usage has stayed low for a number of frames.
+    /// Every sizing decision is logged as an info message.
+    Bool AdaptiveDynamicHeapPageSize DEFAULT_INITIALIZER(False);
+
+    /// The size of the heaps that small buffers and textures are placed in.
+
+    /// Instead of creating every buffer and texture as a committed resource with its own
+    /// implicit heap, the engine suballocates them as placed resources from shared heaps of
+    /// this size. Render targets, depth-stencil and multisample textures, sparse resources
+    /// and resources larger than half of the heap size are always created as committed
+    /// resources. Note that unlike committed resources, placed resources are not zeroed
+    /// when they are created. When zero, all resources are created as committed resources.
+    Uint32 PlacedResourceHeapSize DEFAULT_INITIALIZER(64 << 20);
+
+    /// The fraction of the local video memory budget reported by the OS that committed resources are kept within.
+
+    /// When greater than zero, the engine tracks the committed buffers and textures that every
+    /// command list references. Before command lists are executed, the resources they reference
+    /// are made resident and, if the video memory usage exceeds the budget, the least recently used
+    /// resources that are no longer accessed by the GPU are evicted. When zero, residency is managed
+    /// by the OS only. Placed resources (see PlacedResourceHeapSize) are never evicted.
+    Float32 ResidencyBudgetFraction DEFAULT_INITIALIZER(0);
+
+    /// Root signature cache data previously obtained with IRenderDeviceD3D12::GetRootSignatureCacheData().
+
+    /// When not null, the root signatures stored in the data are created during device
+    /// initialization, in parallel if EngineCreateInfo::pAsyncShaderCompilationThreadPool
+    /// is not null. Data that was created by a different engine version is ignored.
+    const void* pRootSignatureCacheData DEFAULT_INITIALIZER(nullptr);
+
+    /// The size of data pointed to by pRootSignatureCacheData
+    Uint32 RootSignatureCacheDataSize DEFAULT_INITIALIZER(0);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -3736,6 +4209,18 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// Whether device contexts adapt the dynamic heap page size to the observed usage.
+
+    /// When enabled, DynamicHeapPageSize defines the minimum page size. Every context
+    /// tracks the per-frame high-water mark of its dynamic heap and grows the page size
+    /// (up to a quarter of DynamicHeapSize) when a frame does not fit into a single page.
+    /// The page size shrinks back after the usage has stayed low for a number of frames.
+    /// Every sizing decision is logged as an info message.
+    ///
+    /// \note   The size of the dynamic heap itself (DynamicHeapSize) cannot change at run time,
+    ///         because all dynamic buffers are suballocated from the same Vulkan buffer.
+    Bool AdaptiveDynamicHeapPageSize        DEFAULT_INITIALIZER(False);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -3754,6 +4239,16 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// features when compiling shaders from HLSL.
     const Char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
 
+    /// Whether to create graphics pipelines from pipeline libraries (VK_EXT_graphics_pipeline_library).
+
+    /// When enabled and supported by the device, vertex input, pre-rasterization, fragment shader
+    /// and fragment output parts of every graphics pipeline are compiled as separate libraries
+    /// that are shared between pipelines and quickly linked together. If the shader compilation
+    /// thread pool is available, a fully optimized pipeline is then linked in the background
+    /// and replaces the fast-linked one once it is ready.
+    /// The option is ignored if VK_EXT_graphics_pipeline_library extension is not supported.
+    Bool EnableGraphicsPipelineLibrary DEFAULT_INITIALIZER(False);
+
 #if DILIGENT_CPP_INTERFACE
     EngineVkCreateInfo() noexcept :
         EngineVkCreateInfo{EngineCreateInfo{}}
@@ -4378,16 +4873,20 @@ DILIGENT_TYPED_ENUM(STATE_TRANSITION_TYPE, Uint8)
     /// Perform state transition immediately.
     STATE_TRANSITION_TYPE_IMMEDIATE = 0,
 
-    /// Begin split barrier. This mode only has effect in Direct3D12 backend, and corresponds to
+    /// Begin split barrier. In Direct3D12 backend, this mode corresponds to
     /// [D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY](https://docs.microsoft.com/en-us/windows/desktop/api/d3d12/ne-d3d12-d3d12_resource_barrier_flags)
     /// flag. See https://docs.microsoft.com/en-us/windows/desktop/direct3d12/using-resource-barriers-to-synchronize-resource-states-in-direct3d-12#split-barriers.
-    /// In other backends, begin-split barriers are ignored.
+    /// In Vulkan backend, the barrier records vkCmdSetEvent in immediate contexts, and the matching
+    /// end-split barrier in the same command buffer waits for the event with vkCmdWaitEvents.
+    /// In other backends and in Vulkan deferred contexts, begin-split barriers are ignored.
     STATE_TRANSITION_TYPE_BEGIN,
 
-    /// End split barrier. This mode only has effect in Direct3D12 backend, and corresponds to
+    /// End split barrier. In Direct3D12 backend, this mode corresponds to
     /// [D3D12_RESOURCE_BARRIER_FLAG_END_ONLY](https://docs.microsoft.com/en-us/windows/desktop/api/d3d12/ne-d3d12-d3d12_resource_barrier_flags)
     /// flag. See https://docs.microsoft.com/en-us/windows/desktop/direct3d12/using-resource-barriers-to-synchronize-resource-states-in-direct3d-12#split-barriers.
-    /// In other backends, this mode is similar to STATE_TRANSITION_TYPE_IMMEDIATE.
+    /// In Vulkan backend, the barrier must use the same resource, new state and subresource range as
+    /// the begin-split barrier to be matched with it.
+    /// If there is no matching begin-split barrier, this mode is similar to STATE_TRANSITION_TYPE_IMMEDIATE.
     STATE_TRANSITION_TYPE_END
 };
 
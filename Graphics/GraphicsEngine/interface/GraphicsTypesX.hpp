@@ -1308,6 +1308,11 @@ public:
         return CreateDeviceObject<IPipelineState>("tile pipeline", CreateInfo.PSODesc.Name, &IRenderDevice::CreateTilePipelineState, CreateInfo);
     }
 
+    RefCntAutoPtr<IPipelineState> CreateWorkGraphPipelineState(const WorkGraphPipelineStateCreateInfo& CreateInfo) noexcept(!ThrowOnError)
+    {
+        return CreateDeviceObject<IPipelineState>("work graph pipeline", CreateInfo.PSODesc.Name, &IRenderDevice::CreateWorkGraphPipelineState, CreateInfo);
+    }
+
     RefCntAutoPtr<IPipelineState> CreatePipelineState(const GraphicsPipelineStateCreateInfo& CreateInfo) noexcept(!ThrowOnError)
     {
         return CreateGraphicsPipelineState(CreateInfo);
@@ -1324,6 +1329,10 @@ public:
     {
         return CreateTilePipelineState(CreateInfo);
     }
+    RefCntAutoPtr<IPipelineState> CreatePipelineState(const WorkGraphPipelineStateCreateInfo& CreateInfo) noexcept(!ThrowOnError)
+    {
+        return CreateWorkGraphPipelineState(CreateInfo);
+    }
 
     RefCntAutoPtr<IFence> CreateFence(const FenceDesc& Desc) noexcept(!ThrowOnError)
     {
@@ -129,7 +129,45 @@ DILIGENT_TYPED_ENUM(PIPELINE_RESOURCE_FLAGS, Uint8)
     /// \note This flag is only valid in Vulkan.
     PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT = 1u << 4,
 
-    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT
+    /// Indicates that the resource is accessed in the shader through the shader-visible descriptor
+    /// heap (ResourceDescriptorHeap[] in HLSL shader model 6.6) rather than through a descriptor table.
+    /// Applies to SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_TYPE_TEXTURE_UAV,
+    /// SHADER_RESOURCE_TYPE_BUFFER_SRV and SHADER_RESOURCE_TYPE_BUFFER_UAV resources.
+    ///
+    /// \remarks   Every view bound to a bindless resource is assigned a persistent slot in the
+    ///             shader-visible descriptor heap. When the SRB is committed, only the 32-bit
+    ///             heap indices of the bound views are written to root constants, so no descriptors
+    ///             are copied. The indices of all bindless resources in the signature are exposed to
+    ///             the shader as a constant buffer named `cbBindlessIndices<N>`, where `<N>` is the
+    ///             signature binding index, that occupies register b0 in the first register space after
+    ///             the space used by the signature. Each array element is stored in its own uint
+    ///             value; elements are packed in the order the resources are declared in the signature.
+    ///             Since the indices are written when the SRB is committed, a new resource bound to
+    ///             a bindless variable takes effect the next time the SRB is committed.
+    ///
+    /// \note This flag is only valid in Direct3D12 and requires shader model 6.6 and
+    ///       resource binding tier 3. It can't be combined with PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY.
+    PIPELINE_RESOURCE_FLAG_BINDLESS = 1u << 5,
+
+    /// Indicates that the resource is a small block of 32-bit constants that is set directly
+    /// through IDeviceContext::SetInlineConstants() rather than by binding a buffer.
+    /// Applies to SHADER_RESOURCE_TYPE_CONSTANT_BUFFER resources.
+    ///
+    /// \remarks   For inline constants, ArraySize defines the number of 32-bit constants
+    ///             (up to 64) rather than the number of array elements. In the shader, the
+    ///             resource is declared as a regular constant buffer. The signature reports
+    ///             ArraySize of 1 for such resources.
+    ///
+    ///             Every shader resource binding object creates its own constant buffer for
+    ///             each inline constants resource and binds it to the variable, so the variable
+    ///             must not be bound manually. Currently, all backends implement inline constants
+    ///             with a dynamic uniform buffer that is updated by IDeviceContext::SetInlineConstants().
+    ///
+    /// \note The flag can't be combined with other flags, and the variable type must be
+    ///       SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE or SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC.
+    PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS = 1u << 6,
+
+    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 
@@ -319,6 +357,40 @@ DILIGENT_BEGIN_INTERFACE(IPipelineResourceSignature, IDeviceObject)
                                                      Bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
 
 
+    /// Creates multiple shader resource binding objects
+
+    /// \param [in]  NumSRBs                  - The number of shader resource bindings to create.
+    /// \param [out] ppShaderResourceBindings - Array of NumSRBs memory locations where pointers to the new
+    ///                                        shader resource binding objects are written.
+    /// \param [in]  InitStaticResources      - If set to true, the method will initialize static resources in
+    ///                                        the created objects, see IPipelineResourceSignature::CreateShaderResourceBinding().
+    ///
+    /// \remarks This method is equivalent to calling CreateShaderResourceBinding() NumSRBs times,
+    ///          but avoids the per-call overhead when many SRBs are created at once.
+    VIRTUAL void METHOD(CreateShaderResourceBindings)(THIS_
+                                                      Uint32                   NumSRBs,
+                                                      IShaderResourceBinding** ppShaderResourceBindings,
+                                                      Bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
+
+
+    /// Creates a copy of the shader resource binding object
+
+    /// \param [in]  pSrcSRB                 - Shader resource binding to clone. It must have been created
+    ///                                       by this signature.
+    /// \param [out] ppShaderResourceBinding - Memory location where pointer to the new shader resource
+    ///                                       binding object is written.
+    ///
+    /// \remarks The new SRB references the same mutable and dynamic resources as the source SRB,
+    ///          and its inline constants have the same values. If static resources were initialized in
+    ///          the source SRB, they are initialized in the new SRB from the current static resources
+    ///          of the signature. Buffer ranges and offsets set with IShaderResourceVariable::SetBufferRange()
+    ///          and IShaderResourceVariable::SetBufferOffset() are not copied.
+    ///          The two SRBs are independent after the method returns.
+    VIRTUAL void METHOD(CloneShaderResourceBinding)(THIS_
+                                                    IShaderResourceBinding*  pSrcSRB,
+                                                    IShaderResourceBinding** ppShaderResourceBinding) PURE;
+
+
     /// Binds static resources for the specified shader stages in the pipeline resource signature.
 
     /// \param [in] ShaderStages     - Flags that specify shader stages, for which resources will be bound.
@@ -434,6 +506,8 @@ DILIGENT_END_INTERFACE
 #    define IPipelineResourceSignature_GetDesc(This) (const struct PipelineResourceSignatureDesc*)IDeviceObject_GetDesc(This)
 
 #    define IPipelineResourceSignature_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBinding, This, __VA_ARGS__)
+#    define IPipelineResourceSignature_CreateShaderResourceBindings(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBindings,This, __VA_ARGS__)
+#    define IPipelineResourceSignature_CloneShaderResourceBinding(This, ...)   CALL_IFACE_METHOD(PipelineResourceSignature, CloneShaderResourceBinding,  This, __VA_ARGS__)
 #    define IPipelineResourceSignature_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineResourceSignature, BindStaticResources,         This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByName,     This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByIndex,    This, __VA_ARGS__)
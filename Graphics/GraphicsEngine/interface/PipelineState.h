@@ -185,6 +185,40 @@ DILIGENT_TYPED_ENUM(PIPELINE_SHADING_RATE_FLAGS, Uint8)
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_SHADING_RATE_FLAGS);
 
+
+/// Pipeline dynamic state flags.
+
+/// Every flag excludes the corresponding part of the graphics pipeline
+/// description from the pipeline object. The state must instead be set
+/// through the context after the pipeline is bound. The values from the
+/// pipeline description are used as initial values when the pipeline is set.
+/// Dynamic states require DeviceFeatures::DynamicPipelineStates feature.
+DILIGENT_TYPED_ENUM(PIPELINE_DYNAMIC_STATE_FLAGS, Uint8)
+{
+    /// No dynamic states are used.
+    PIPELINE_DYNAMIC_STATE_FLAG_NONE               = 0,
+
+    /// RasterizerStateDesc::CullMode is dynamic.
+    /// See IDeviceContextVk::SetCullMode().
+    PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE          = 1u << 0u,
+
+    /// DepthStencilStateDesc::DepthEnable, DepthWriteEnable and DepthFunc are dynamic.
+    /// See IDeviceContextVk::SetDepthState().
+    PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST         = 1u << 1u,
+
+    /// DepthStencilStateDesc::StencilEnable, FrontFace and BackFace are dynamic.
+    /// See IDeviceContextVk::SetStencilState().
+    PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST       = 1u << 2u,
+
+    /// Primitive topology is dynamic within the same topology class
+    /// (point, line or triangle). Patch lists can't be dynamic.
+    /// See IDeviceContextVk::SetPrimitiveTopology().
+    PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY = 1u << 3u,
+
+    PIPELINE_DYNAMIC_STATE_FLAG_LAST               = PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY,
+};
+DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_DYNAMIC_STATE_FLAGS);
+
 /// Pipeline layout description
 struct PipelineResourceLayoutDesc
 {
@@ -306,6 +340,10 @@ struct GraphicsPipelineDesc
     /// Shading rate flags that specify which type of the shading rate will be used with this pipeline.
     PIPELINE_SHADING_RATE_FLAGS ShadingRateFlags DEFAULT_INITIALIZER(PIPELINE_SHADING_RATE_FLAG_NONE);
 
+    /// Dynamic state flags that specify which states are not baked into the pipeline,
+    /// see Diligent::PIPELINE_DYNAMIC_STATE_FLAGS.
+    PIPELINE_DYNAMIC_STATE_FLAGS DynamicStateFlags DEFAULT_INITIALIZER(PIPELINE_DYNAMIC_STATE_FLAG_NONE);
+
     /// Render target formats.
     /// All formats must be TEX_FORMAT_UNKNOWN when pRenderPass is not null.
     TEXTURE_FORMAT RTVFormats[DILIGENT_MAX_RENDER_TARGETS] DEFAULT_INITIALIZER({});
@@ -339,6 +377,7 @@ struct GraphicsPipelineDesc
               NumRenderTargets  == Rhs.NumRenderTargets  &&
               SubpassIndex      == Rhs.SubpassIndex      &&
               ShadingRateFlags  == Rhs.ShadingRateFlags  &&
+              DynamicStateFlags == Rhs.DynamicStateFlags &&
               DSVFormat         == Rhs.DSVFormat         &&
               SmplDesc          == Rhs.SmplDesc          &&
               NodeMask          == Rhs.NodeMask))
@@ -535,7 +574,10 @@ DILIGENT_TYPED_ENUM(PIPELINE_TYPE, Uint8)
     /// Tile pipeline, which is used by IDeviceContext::DispatchTile().
     PIPELINE_TYPE_TILE,
 
-    PIPELINE_TYPE_LAST = PIPELINE_TYPE_TILE,
+    /// Work graph pipeline, which is used by IDeviceContext::DispatchGraph().
+    PIPELINE_TYPE_WORK_GRAPH,
+
+    PIPELINE_TYPE_LAST = PIPELINE_TYPE_WORK_GRAPH,
 
     PIPELINE_TYPE_COUNT,
 
@@ -597,6 +639,7 @@ struct PipelineStateDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     bool IsComputePipeline()     const { return PipelineType == PIPELINE_TYPE_COMPUTE; }
     bool IsRayTracingPipeline()  const { return PipelineType == PIPELINE_TYPE_RAY_TRACING; }
     bool IsTilePipeline()        const { return PipelineType == PIPELINE_TYPE_TILE; }
+    bool IsWorkGraphPipeline()   const { return PipelineType == PIPELINE_TYPE_WORK_GRAPH; }
 #endif
 };
 typedef struct PipelineStateDesc PipelineStateDesc;
@@ -629,11 +672,63 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// by the PSO's resource signatures.
     PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES       = 1u << 2u,
 
-    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES
+    /// Create the pipeline state asynchronously.
+    ///
+    /// \remarks   When this flag is set and the engine was initialized with a thread pool
+    ///            (see EngineCreateInfo::pAsyncShaderCompilationThreadPool), IRenderDevice::CreateXXXPipelineState
+    ///            returns immediately and the pipeline is created by the thread pool once all
+    ///            its shaders have been compiled. Use IPipelineState::GetStatus() to query the status.
+    ///            The pipeline must not be used until its status is PIPELINE_STATE_STATUS_READY.
+    ///
+    ///            Only graphics and compute pipelines can be created asynchronously.
+    ///            If the thread pool is not available or the backend does not support
+    ///            asynchronous compilation (OpenGL), the flag is ignored.
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 1u << 3u,
+
+    /// Allow creating derived pipelines from this pipeline.
+    ///
+    /// \remarks   When this flag is set, the pipeline keeps a copy of its create info and
+    ///            references to its shaders, resource signatures and render pass, so that
+    ///            IRenderDevice::CreateDerivedGraphicsPipelineState() can create pipelines that
+    ///            only differ in a few states. Only graphics pipelines can be used as base pipelines.
+    PSO_CREATE_FLAG_ALLOW_DERIVATIVES                 = 1u << 4u,
+
+    /// Share the implicit resource signature with other pipelines.
+    ///
+    /// \remarks   When this flag is set and the pipeline uses an implicit resource signature
+    ///            (i.e. no resource signatures are provided in the create info), the device reuses
+    ///            the implicit signature of another pipeline that was created with this flag and has
+    ///            an identical resource layout. Pipelines that share the signature also share
+    ///            its static resource cache, static variables and immutable samplers: setting a static
+    ///            variable through one pipeline sets it for all pipelines that share the signature.
+    ///
+    ///            The flag is intended for pipelines whose static variables reference the same global
+    ///            resources and saves the memory and time required to create a signature per pipeline.
+    PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE          = 1u << 5u,
+
+    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint32)
+{
+    /// Initial pipeline state status.
+    PIPELINE_STATE_STATUS_UNINITIALIZED = 0,
+
+    /// The pipeline state is being compiled.
+    PIPELINE_STATE_STATUS_COMPILING,
+
+    /// The pipeline state has been successfully compiled
+    /// and is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// The pipeline state compilation has failed.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -765,6 +860,30 @@ struct GraphicsPipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
 typedef struct GraphicsPipelineStateCreateInfo GraphicsPipelineStateCreateInfo;
 
 
+/// Derived graphics pipeline state create info
+
+/// Describes a graphics pipeline that is identical to the base pipeline except for the
+/// states that are overridden, see IRenderDevice::CreateDerivedGraphicsPipelineState().
+struct DerivedGraphicsPipelineStateCreateInfo
+{
+    /// Base pipeline. It must be a graphics pipeline created with PSO_CREATE_FLAG_ALLOW_DERIVATIVES flag.
+    struct IPipelineState* pBasePipeline DEFAULT_INITIALIZER(nullptr);
+
+    /// Name of the derived pipeline. If null, the name of the base pipeline is used.
+    const Char* Name DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional blend state that replaces the blend state of the base pipeline.
+    const BlendStateDesc* pBlendDesc DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional rasterizer state that replaces the rasterizer state of the base pipeline.
+    const RasterizerStateDesc* pRasterizerDesc DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional depth-stencil state that replaces the depth-stencil state of the base pipeline.
+    const DepthStencilStateDesc* pDepthStencilDesc DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct DerivedGraphicsPipelineStateCreateInfo DerivedGraphicsPipelineStateCreateInfo;
+
+
 /// Compute pipeline state description.
 struct ComputePipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
 
@@ -949,6 +1068,62 @@ struct TilePipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
 typedef struct TilePipelineStateCreateInfo TilePipelineStateCreateInfo;
 
 
+/// Work graph pipeline state initialization information.
+
+/// A work graph is a set of nodes, defined in one or more shader libraries, that produce
+/// and consume records on the GPU. Nodes launch other nodes directly, so the graph can
+/// implement producer-consumer chains (e.g. culling followed by LOD selection) without
+/// writing intermediate work counts to indirect argument buffers.
+///
+/// \remarks   Work graphs require DeviceFeatures::WorkGraphs feature and are only supported
+///             by Direct3D12 backend.
+struct WorkGraphPipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
+
+    /// A pointer to an array of ShaderCount shader libraries that contain the work graph nodes.
+    /// All shaders must be of type Diligent::SHADER_TYPE_WORK_GRAPH.
+    IShader* const* ppShaders   DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of shader libraries in ppShaders array.
+    Uint32          ShaderCount DEFAULT_INITIALIZER(0);
+
+    /// The name of the work graph program. All nodes found in the shader
+    /// libraries are included into the program.
+    /// If null or empty, the pipeline name (PSODesc.Name) is used.
+    const Char*     ProgramName DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    WorkGraphPipelineStateCreateInfo() noexcept
+    {
+        PSODesc.PipelineType = PIPELINE_TYPE_WORK_GRAPH;
+    }
+    bool operator==(const WorkGraphPipelineStateCreateInfo& Rhs) const noexcept
+    {
+        if (static_cast<const PipelineStateCreateInfo&>(*this) != static_cast<const PipelineStateCreateInfo&>(Rhs))
+            return false;
+
+        if (ShaderCount != Rhs.ShaderCount)
+            return false;
+
+        if (!((IsNullOrEmptyStr(ProgramName) && IsNullOrEmptyStr(Rhs.ProgramName)) || SafeStrEqual(ProgramName, Rhs.ProgramName)))
+            return false;
+
+        for (Uint32 i = 0; i < ShaderCount; ++i)
+        {
+            if (ppShaders[i] != Rhs.ppShaders[i])
+                return false;
+        }
+
+        return true;
+    }
+    bool operator!=(const WorkGraphPipelineStateCreateInfo& Rhs) const noexcept
+    {
+        return !(*this == Rhs);
+    }
+#endif
+};
+typedef struct WorkGraphPipelineStateCreateInfo WorkGraphPipelineStateCreateInfo;
+
+
 // {06084AE5-6A71-4FE8-84B9-395DD489A28C}
 static const struct INTERFACE_ID IID_PipelineState =
     {0x6084ae5, 0x6a71, 0x4fe8, {0x84, 0xb9, 0x39, 0x5d, 0xd4, 0x89, 0xa2, 0x8c}};
@@ -1149,6 +1324,19 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method will wait until the pipeline state is compiled.
+    ///                                 If false, the method will return the current status immediately.
+    ///
+    /// \remarks   Pipeline states that are not created asynchronously are always in
+    ///            PIPELINE_STATE_STATUS_READY state after they have been created.
+    ///
+    ///            Methods that access pipeline resources (GetStaticVariableByName, CreateShaderResourceBinding, etc.)
+    ///            must only be called when the status is PIPELINE_STATE_STATUS_READY.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    Bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -1173,6 +1361,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
 #    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
 #    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                    CALL_IFACE_METHOD(PipelineState, GetStatus,                    This, __VA_ARGS__)
 
 // clang-format on
 
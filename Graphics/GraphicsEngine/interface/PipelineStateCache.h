@@ -74,9 +74,45 @@ struct PipelineStateCacheCreateInfo
 
     /// The size of data pointed to by pCacheData
     Uint32      CacheDataSize DEFAULT_INITIALIZER(0);
+
+    /// An optional directory where the engine manages the cache file.
+
+    /// When not null, the cache is stored in a file in this directory whose name
+    /// is derived from the GPU device and driver identifiers. If pCacheData is null,
+    /// the file is loaded when the cache is created; a file produced by a different
+    /// device or driver is ignored. The data is written to the file by
+    /// IPipelineStateCache::Save and when the cache object is destroyed.
+    ///
+    /// \note  The directory must exist.
+    const Char* CacheDirectory    DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCacheCreateInfo PipelineStateCacheCreateInfo;
 
+/// Pipeline state cache statistics, see IPipelineStateCache::GetStatistics().
+
+/// All times are in microseconds.
+struct PipelineStateCacheStatistics
+{
+    /// The number of pipelines created with this cache.
+    Uint32 PipelineCount DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines that were found in the cache.
+    Uint32 HitCount      DEFAULT_INITIALIZER(0);
+
+    /// The number of pipelines that were not found in the cache and were compiled from scratch.
+
+    /// Pipelines for which the cache lookup result is unknown (see Diligent::PIPELINE_CACHE_RESULT_UNKNOWN)
+    /// are counted neither as hits nor as misses.
+    Uint32 MissCount     DEFAULT_INITIALIZER(0);
+
+    /// The total time spent by the driver creating the pipelines that were found in the cache.
+    Uint64 HitDuration   DEFAULT_INITIALIZER(0);
+
+    /// The total time spent by the driver creating the pipelines that were not found in the cache.
+    Uint64 MissDuration  DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStateCacheStatistics PipelineStateCacheStatistics;
+
 // clang-format on
 
 // {6AC86F22-FFF4-493C-8C1F-C539D934F4BC}
@@ -99,6 +135,53 @@ DILIGENT_BEGIN_INTERFACE(IPipelineStateCache, IDeviceObject)
     /// Creates a blob with pipeline state cache data
     VIRTUAL void METHOD(GetData)(THIS_
                                  IDataBlob** ppBlob) PURE;
+
+    /// Merges the contents of other caches into this cache.
+
+    /// \param [in] NumSrcCaches - The number of source caches.
+    /// \param [in] ppSrcCaches  - An array of NumSrcCaches source caches. The caches must be
+    ///                            created by the same device and must not include this cache.
+    ///
+    /// \return     true if the caches were merged successfully, and false otherwise.
+    ///
+    /// \remarks    This method allows populating separate caches in several threads and
+    ///             combining them later into a single cache.
+    ///
+    /// \warning    This cache must not be used to create pipeline states while the
+    ///             method is running.
+    ///
+    /// \note       Direct3D12 pipeline libraries can't be merged, and the method always
+    ///             returns false in this backend.
+    VIRTUAL Bool METHOD(Merge)(THIS_
+                               Uint32                NumSrcCaches,
+                               IPipelineStateCache** ppSrcCaches) PURE;
+
+    /// Writes the cache data to the file managed by the engine.
+
+    /// \param [in] Async - Whether to write the data asynchronously using the engine's
+    ///                     thread pool (see EngineCreateInfo::pAsyncShaderCompilationThreadPool).
+    ///                     If the thread pool is not available, the data is written synchronously.
+    ///
+    /// \return     true if the data was written or enqueued for writing, and false otherwise.
+    ///
+    /// \remarks    The cache must be created with a non-null PipelineStateCacheCreateInfo::CacheDirectory.
+    ///             The file is not rewritten if the data has not changed since the last save.
+    ///             The data is first written to a temporary file that then replaces the cache file,
+    ///             so that the file is never left partially written.
+    VIRTUAL Bool METHOD(Save)(THIS_
+                              Bool Async) PURE;
+
+    /// Returns the statistics of the pipelines created with this cache since the cache was created.
+
+    /// \param [out] Stats - Pipeline state cache statistics, see Diligent::PipelineStateCacheStatistics.
+    ///
+    /// \remarks    In Vulkan, cache hits and misses are reported by the driver through
+    ///             VK_EXT_pipeline_creation_feedback. If the extension is not supported or a pipeline
+    ///             is created from pipeline libraries, only the pipeline count is updated.
+    ///             In Direct3D12, the result of loading the pipeline from the pipeline library is recorded.
+    ///             In OpenGL, the result of loading the program binary is recorded, and durations are not tracked.
+    VIRTUAL void METHOD(GetStatistics)(THIS_
+                                       PipelineStateCacheStatistics REF Stats) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -106,7 +189,10 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define IPipelineStateCache_GetData(This, ...)  CALL_IFACE_METHOD(PipelineStateCache, GetData, This, __VA_ARGS__)
+#    define IPipelineStateCache_GetData(This, ...)       CALL_IFACE_METHOD(PipelineStateCache, GetData,       This, __VA_ARGS__)
+#    define IPipelineStateCache_Merge(This, ...)         CALL_IFACE_METHOD(PipelineStateCache, Merge,         This, __VA_ARGS__)
+#    define IPipelineStateCache_Save(This, ...)          CALL_IFACE_METHOD(PipelineStateCache, Save,          This, __VA_ARGS__)
+#    define IPipelineStateCache_GetStatistics(This, ...) CALL_IFACE_METHOD(PipelineStateCache, GetStatistics, This, __VA_ARGS__)
 
 #endif
 
@@ -81,6 +81,31 @@ struct QueryDataTimestamp
 };
 typedef struct QueryDataTimestamp QueryDataTimestamp;
 
+/// GPU timestamp calibration data.
+
+/// This structure is filled by IDeviceContext::GetTimestampCalibration() and relates
+/// the GPU timestamp counter to the CPU clock. A GPU timestamp can be converted to
+/// the CPU time with Diligent::GPUTimestampToCPUTime().
+struct TimestampCalibration
+{
+    /// The value of the GPU timestamp counter, in the same units as QueryDataTimestamp::Counter.
+    Uint64 GPUCounter   DEFAULT_INITIALIZER(0);
+
+    /// The GPU counter frequency, in Hz (ticks/second), the same as QueryDataTimestamp::Frequency.
+    Uint64 GPUFrequency DEFAULT_INITIALIZER(0);
+
+    /// The CPU time, in nanoseconds, sampled at the same moment as GPUCounter.
+
+    /// The time is in the domain of std::chrono::steady_clock, i.e. it can be
+    /// compared with std::chrono::steady_clock::now().time_since_epoch() in nanoseconds.
+    Uint64 CPUTime      DEFAULT_INITIALIZER(0);
+
+    /// The maximum deviation, in nanoseconds, between the moments when GPUCounter
+    /// and CPUTime were sampled.
+    Uint64 MaxDeviation DEFAULT_INITIALIZER(0);
+};
+typedef struct TimestampCalibration TimestampCalibration;
+
 /// Pipeline statistics query data.
 /// This structure is filled by IQuery::GetData() for Diligent::QUERY_TYPE_PIPELINE_STATISTICS query type.
 ///
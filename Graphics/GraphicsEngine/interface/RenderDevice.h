@@ -43,6 +43,7 @@
 #include "TextureView.h"
 #include "BufferView.h"
 #include "PipelineState.h"
+#include "CompilationStatistics.h"
 #include "PipelineStateCache.h"
 #include "Fence.h"
 #include "Query.h"
@@ -170,6 +171,23 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                                      const GraphicsPipelineStateCreateInfo REF PSOCreateInfo,
                                                      IPipelineState**                          ppPipelineState) PURE;
 
+
+    /// Creates a new graphics pipeline state object that differs from an existing one in a few states
+
+    /// \param [in]  CreateInfo      - Derived pipeline state create info, see Diligent::DerivedGraphicsPipelineStateCreateInfo.
+    /// \param [out] ppPipelineState - Address of the memory location where a pointer to the
+    ///                               pipeline state interface will be written.
+    ///                               The function calls AddRef(), so that the new object will have
+    ///                               one reference.
+    ///
+    /// \remarks    The new pipeline uses the shaders, resource signatures or resource layout, input layout,
+    ///             render pass and all other states of the base pipeline, except for the states that are
+    ///             overridden in CreateInfo. Resources bound to SRBs of the base pipeline are compatible
+    ///             with the derived pipeline.
+    VIRTUAL void METHOD(CreateDerivedGraphicsPipelineState)(THIS_
+                                                            const DerivedGraphicsPipelineStateCreateInfo REF CreateInfo,
+                                                            IPipelineState**                                 ppPipelineState) PURE;
+
     /// Creates a new compute pipeline state object
 
     /// \param [in]  PSOCreateInfo   - Compute pipeline state create info, see Diligent::ComputePipelineStateCreateInfo for details.
@@ -203,6 +221,19 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                                  const TilePipelineStateCreateInfo REF PSOCreateInfo,
                                                  IPipelineState**                      ppPipelineState) PURE;
 
+    /// Creates a new work graph pipeline state object
+
+    /// \param [in]  PSOCreateInfo   - Work graph pipeline state create info, see Diligent::WorkGraphPipelineStateCreateInfo for details.
+    /// \param [out] ppPipelineState - Address of the memory location where a pointer to the
+    ///                                pipeline state interface will be written.
+    ///                                The function calls AddRef(), so that the new object will have
+    ///                                one reference.
+    ///
+    /// \remarks Work graphs require DeviceFeatures::WorkGraphs feature.
+    VIRTUAL void METHOD(CreateWorkGraphPipelineState)(THIS_
+                                                      const WorkGraphPipelineStateCreateInfo REF PSOCreateInfo,
+                                                      IPipelineState**                           ppPipelineState) PURE;
+
     /// Creates a new fence object
 
     /// \param [in]  Desc    - Fence description, see Diligent::FenceDesc for details.
@@ -391,6 +422,107 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     VIRTUAL IEngineFactory* METHOD(GetEngineFactory)(THIS) CONST PURE;
 
 
+    /// Returns shader and pipeline compilation statistics.
+
+    /// \return    A pointer to the compilation statistics object, or null if
+    ///            EngineCreateInfo::EnableCompilationStatistics was false.
+    ///
+    /// \remark This method does not increment the reference counter of the returned interface,
+    ///         so the application should not call Release().
+    VIRTUAL ICompilationStatistics* METHOD(GetCompilationStatistics)(THIS) CONST PURE;
+
+
+    /// Returns memory allocation statistics.
+
+    /// \param [out] Stats - Memory allocation statistics of every allocation tag,
+    ///                      see Diligent::MEMORY_ALLOCATION_TAG.
+    ///
+    /// \return    true if memory tracking is enabled, and false otherwise,
+    ///            see EngineCreateInfo::EnableMemoryTracking.
+    ///
+    /// \remarks   The statistics cover the memory allocated by the engine through the raw memory
+    ///            allocator and are shared by all devices in the process.
+    VIRTUAL Bool METHOD(GetMemoryAllocationStatistics)(THIS_
+                                                       MemoryAllocationStatistics REF Stats) CONST PURE;
+
+
+    /// Returns GPU memory statistics.
+
+    /// \param [out] Stats - GPU memory usage of every category and allocation type,
+    ///                      see Diligent::GPUMemoryStatistics.
+    ///
+    /// \return    true if GPU memory tracking is enabled, and false otherwise,
+    ///            see EngineCreateInfo::EnableGPUMemoryTracking.
+    ///
+    /// \remarks   The method is thread-safe.
+    VIRTUAL Bool METHOD(GetGPUMemoryStatistics)(THIS_
+                                                GPUMemoryStatistics REF Stats) CONST PURE;
+
+
+    /// Returns the information about the live GPU memory allocations.
+
+    /// \param [out] pAllocations   - A pointer to the array of MaxAllocations elements that receives
+    ///                               the allocations sorted by the allocated size in descending order.
+    ///                               May be null.
+    /// \param [in]  MaxAllocations - The number of elements in the pAllocations array.
+    ///
+    /// \return    The total number of live allocations, or zero if GPU memory tracking is disabled.
+    ///
+    /// \remarks   The method is thread-safe.
+    VIRTUAL Uint32 METHOD(GetGPUMemoryAllocations)(THIS_
+                                                   GPUMemoryAllocationInfo* pAllocations,
+                                                   Uint32                   MaxAllocations) CONST PURE;
+
+
+    /// Creates a human-readable GPU memory report.
+
+    /// \param [out] ppReport - Address of the memory location where a pointer to the data blob
+    ///                         with the null-terminated report text will be written.
+    ///
+    /// \remarks   The report lists the memory usage of every category and allocation type,
+    ///            the padding and alignment overhead, the unused space of the memory pools,
+    ///            and the largest allocations.
+    ///            If GPU memory tracking is disabled, null is written to ppReport.
+    VIRTUAL void METHOD(GetGPUMemoryReport)(THIS_
+                                            IDataBlob** ppReport) CONST PURE;
+
+
+    /// Returns device metrics.
+
+    /// \param [out] Metrics - Statistics of every metric, see Diligent::DEVICE_METRIC.
+    ///
+    /// \return    true if metrics are enabled, and false otherwise,
+    ///            see EngineCreateInfo::EnableMetrics.
+    ///
+    /// \remarks   Frame values are updated when IDeviceContext::FinishFrame() is called
+    ///            for the first immediate context.
+    VIRTUAL Bool METHOD(GetMetrics)(THIS_
+                                    DeviceMetrics REF Metrics) CONST PURE;
+
+
+    /// Resets all device metrics.
+    VIRTUAL void METHOD(ResetMetrics)(THIS) PURE;
+
+
+    /// Returns the render device statistics.
+
+    /// \param [out] Stats - Render device statistics, see Diligent::DeviceStatistics.
+    ///
+    /// \remarks   The method is thread-safe. The counters are updated with relaxed atomic
+    ///            operations, so the values reported for different counters may be
+    ///            slightly out of sync with each other.
+    ///            Per-context counters are reported by IDeviceContext::GetStatistics().
+    VIRTUAL void METHOD(GetStatistics)(THIS_
+                                       DeviceStatistics REF Stats) CONST PURE;
+
+
+    /// Returns the time spent in the phases of the device initialization.
+
+    /// \param [out] Stats - Device startup statistics, see Diligent::DeviceStartupStatistics.
+    VIRTUAL void METHOD(GetStartupStatistics)(THIS_
+                                              DeviceStartupStatistics REF Stats) CONST PURE;
+
+
 #if DILIGENT_CPP_INTERFACE
     /// Overloaded alias for CreateGraphicsPipelineState.
     void CreatePipelineState(const GraphicsPipelineStateCreateInfo& CI, IPipelineState** ppPipelineState)
@@ -412,6 +544,11 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     {
         CreateTilePipelineState(CI, ppPipelineState);
     }
+    /// Overloaded alias for CreateWorkGraphPipelineState.
+    void CreatePipelineState(const WorkGraphPipelineStateCreateInfo& CI, IPipelineState** ppPipelineState)
+    {
+        CreateWorkGraphPipelineState(CI, ppPipelineState);
+    }
 #endif
 };
 DILIGENT_END_INTERFACE
@@ -427,8 +564,10 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_CreateSampler(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateSampler,                   This, __VA_ARGS__)
 #    define IRenderDevice_CreateResourceMapping(This, ...)           CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,           This, __VA_ARGS__)
 #    define IRenderDevice_CreateGraphicsPipelineState(This, ...)     CALL_IFACE_METHOD(RenderDevice, CreateGraphicsPipelineState,     This, __VA_ARGS__)
+#    define IRenderDevice_CreateDerivedGraphicsPipelineState(This, ...) CALL_IFACE_METHOD(RenderDevice, CreateDerivedGraphicsPipelineState, This, __VA_ARGS__)
 #    define IRenderDevice_CreateComputePipelineState(This, ...)      CALL_IFACE_METHOD(RenderDevice, CreateComputePipelineState,      This, __VA_ARGS__)
 #    define IRenderDevice_CreateRayTracingPipelineState(This, ...)   CALL_IFACE_METHOD(RenderDevice, CreateRayTracingPipelineState,   This, __VA_ARGS__)
+#    define IRenderDevice_CreateWorkGraphPipelineState(This, ...)    CALL_IFACE_METHOD(RenderDevice, CreateWorkGraphPipelineState,    This, __VA_ARGS__)
 #    define IRenderDevice_CreateFence(This, ...)                     CALL_IFACE_METHOD(RenderDevice, CreateFence,                     This, __VA_ARGS__)
 #    define IRenderDevice_CreateQuery(This, ...)                     CALL_IFACE_METHOD(RenderDevice, CreateQuery,                     This, __VA_ARGS__)
 #    define IRenderDevice_CreateRenderPass(This, ...)                CALL_IFACE_METHOD(RenderDevice, CreateRenderPass,                This, __VA_ARGS__)
@@ -446,6 +585,15 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
+#    define IRenderDevice_GetCompilationStatistics(This)             CALL_IFACE_METHOD(RenderDevice, GetCompilationStatistics,        This)
+#    define IRenderDevice_GetMemoryAllocationStatistics(This, ...)   CALL_IFACE_METHOD(RenderDevice, GetMemoryAllocationStatistics,   This, __VA_ARGS__)
+#    define IRenderDevice_GetGPUMemoryStatistics(This, ...)          CALL_IFACE_METHOD(RenderDevice, GetGPUMemoryStatistics,          This, __VA_ARGS__)
+#    define IRenderDevice_GetGPUMemoryAllocations(This, ...)         CALL_IFACE_METHOD(RenderDevice, GetGPUMemoryAllocations,         This, __VA_ARGS__)
+#    define IRenderDevice_GetGPUMemoryReport(This, ...)              CALL_IFACE_METHOD(RenderDevice, GetGPUMemoryReport,              This, __VA_ARGS__)
+#    define IRenderDevice_GetMetrics(This, ...)                      CALL_IFACE_METHOD(RenderDevice, GetMetrics,                      This, __VA_ARGS__)
+#    define IRenderDevice_ResetMetrics(This)                         CALL_IFACE_METHOD(RenderDevice, ResetMetrics,                    This)
+#    define IRenderDevice_GetStatistics(This, ...)                   CALL_IFACE_METHOD(RenderDevice, GetStatistics,                   This, __VA_ARGS__)
+#    define IRenderDevice_GetStartupStatistics(This, ...)            CALL_IFACE_METHOD(RenderDevice, GetStartupStatistics,            This, __VA_ARGS__)
 // clang-format on
 
 #endif
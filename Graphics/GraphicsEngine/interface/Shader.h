@@ -270,10 +270,64 @@ DILIGENT_TYPED_ENUM(SHADER_COMPILE_FLAGS, Uint32)
     /// Don't load shader reflection.
     SHADER_COMPILE_FLAG_SKIP_REFLECTION         = 0x02,
 
-    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_SKIP_REFLECTION
+    /// Compile the shader asynchronously.
+    ///
+    /// \remarks   When this flag is set and the engine was initialized with a thread pool
+    ///            (see EngineCreateInfo::pAsyncShaderCompilationThreadPool), IRenderDevice::CreateShader
+    ///            returns immediately and the shader is compiled by the thread pool.
+    ///            Use IShader::GetStatus() to query the compilation status. The shader must not be
+    ///            used until its status is SHADER_STATUS_READY, with the exception of pipeline
+    ///            state creation: asynchronous pipelines wait for their shaders automatically.
+    ///
+    ///            Compiler output (ShaderCreateInfo::ppCompilerOutput) is not available for
+    ///            shaders that are compiled asynchronously.
+    ///
+    ///            If the thread pool is not available or the backend does not support
+    ///            asynchronous compilation (OpenGL), the flag is ignored.
+    SHADER_COMPILE_FLAG_ASYNCHRONOUS            = 0x04,
+
+    /// Reuse include files loaded by previous compilations on the same thread
+    /// from the same shader source stream factory.
+    ///
+    /// \remarks   The flag assumes that include files do not change between compilations
+    ///            and must not be used when shaders are reloaded after their sources were modified.
+    ///            The flag is currently only used by the DX Compiler.
+    SHADER_COMPILE_FLAG_CACHE_INCLUDES          = 0x08,
+
+    /// Only run the optimization passes that are required to produce a valid shader.
+    ///
+    /// \remarks  This flag reduces compilation time during development, but produces
+    ///           larger and slower shaders. It takes precedence over SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE.
+    ///           The flag is currently only used when SPIR-V is optimized with SPIRV-Tools.
+    SHADER_COMPILE_FLAG_MINIMAL_OPTIMIZATION    = 0x10,
+
+    /// Optimize the shader for size rather than for performance.
+    ///
+    /// \remarks  The flag is currently only used when SPIR-V is optimized with SPIRV-Tools.
+    SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE       = 0x20,
+
+    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE
 };
 DEFINE_FLAG_ENUM_OPERATORS(SHADER_COMPILE_FLAGS);
 
+
+/// Shader status
+DILIGENT_TYPED_ENUM(SHADER_STATUS, Uint32)
+{
+    /// Initial shader status.
+    SHADER_STATUS_UNINITIALIZED = 0,
+
+    /// The shader is being compiled.
+    SHADER_STATUS_COMPILING,
+
+    /// The shader has been successfully compiled
+    /// and is ready to be used.
+    SHADER_STATUS_READY,
+
+    /// The shader compilation has failed.
+    SHADER_STATUS_FAILED
+};
+
 // clang-format on
 
 
@@ -585,6 +639,16 @@ DILIGENT_BEGIN_INTERFACE(IShader, IDeviceObject)
     VIRTUAL void METHOD(GetBytecode)(THIS_
                                      const void** ppBytecode,
                                      Uint64 REF   Size) CONST PURE;
+
+    /// Returns the shader status, see Diligent::SHADER_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method will wait until the shader is compiled.
+    ///                                 If false, the method will return the current status immediately.
+    ///
+    /// \remarks   Shaders that are not compiled asynchronously are always in
+    ///            SHADER_STATUS_READY state after they have been created.
+    VIRTUAL SHADER_STATUS METHOD(GetStatus)(THIS_
+                                            Bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -599,6 +663,7 @@ DILIGENT_END_INTERFACE
 #    define IShader_GetResourceCount(This)     CALL_IFACE_METHOD(Shader, GetResourceCount, This)
 #    define IShader_GetResourceDesc(This, ...) CALL_IFACE_METHOD(Shader, GetResourceDesc,  This, __VA_ARGS__)
 #    define IShader_GetBytecode(This, ...)     CALL_IFACE_METHOD(Shader, GetBytecode,      This, __VA_ARGS__)
+#    define IShader_GetStatus(This, ...)       CALL_IFACE_METHOD(Shader, GetStatus,        This, __VA_ARGS__)
 
 // clang-format on
 
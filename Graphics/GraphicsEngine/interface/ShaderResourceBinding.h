@@ -40,6 +40,36 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 struct IPipelineState;
 struct IPipelineResourceSignature;
 
+/// Identifies an element of a mutable or dynamic shader resource variable in a shader resource binding.
+
+/// Variable indices are defined by the pipeline resource signature and are the same for all
+/// shader resource bindings created from it, so locations can be resolved once
+/// (e.g. with IShaderResourceVariable::GetIndex()) and reused for every SRB.
+struct ShaderResourceVariableLocation
+{
+    /// Shader stage of the variable (one of Diligent::SHADER_TYPE).
+    SHADER_TYPE ShaderType    DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Variable index in the shader stage, see IShaderResourceBinding::GetVariableByIndex().
+    Uint32      VariableIndex DEFAULT_INITIALIZER(0);
+
+    /// Array element to bind.
+    Uint32      ArrayIndex    DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ShaderResourceVariableLocation() noexcept {}
+
+    constexpr ShaderResourceVariableLocation(SHADER_TYPE _ShaderType,
+                                             Uint32      _VariableIndex,
+                                             Uint32      _ArrayIndex = 0) noexcept :
+        ShaderType   {_ShaderType   },
+        VariableIndex{_VariableIndex},
+        ArrayIndex   {_ArrayIndex   }
+    {}
+#endif
+};
+typedef struct ShaderResourceVariableLocation ShaderResourceVariableLocation;
+
 // {061F8774-9A09-48E8-8411-B5BD20560104}
 static const INTERFACE_ID IID_ShaderResourceBinding =
     {0x61f8774, 0x9a09, 0x48e8, {0x84, 0x11, 0xb5, 0xbd, 0x20, 0x56, 0x1, 0x4}};
@@ -151,6 +181,25 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
 
     /// Returns true if static resources have been initialized in this SRB.
     VIRTUAL Bool METHOD(StaticResourcesInitialized)(THIS) CONST PURE;
+
+
+    /// Binds multiple resources to variables identified by their locations.
+
+    /// \param [in] pLocations   - Array of NumResources variable locations, see Diligent::ShaderResourceVariableLocation.
+    /// \param [in] ppObjects    - Array of NumResources objects to bind. Null unbinds the element.
+    /// \param [in] NumResources - The number of resources to bind.
+    /// \param [in] Flags        - Flags, see Diligent::SET_SHADER_RESOURCE_FLAGS.
+    ///
+    /// \remarks   This method is equivalent to calling IShaderResourceVariable::SetArray() for every element,
+    ///            but avoids variable lookups by name. Elements that already reference the same object are
+    ///            skipped, which leaves their cache entries and reference counters untouched.
+    ///            When the same object is rebound, a buffer range previously set with
+    ///            IShaderResourceVariable::SetBufferRange() is kept.
+    VIRTUAL void METHOD(SetResources)(THIS_
+                                      const ShaderResourceVariableLocation* pLocations,
+                                      IDeviceObject* const*                 ppObjects,
+                                      Uint32                                NumResources,
+                                      SET_SHADER_RESOURCE_FLAGS             Flags DEFAULT_VALUE(SET_SHADER_RESOURCE_FLAG_NONE)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -167,6 +216,7 @@ DILIGENT_END_INTERFACE
 #    define IShaderResourceBinding_GetVariableCount(This, ...)        CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableCount,             This, __VA_ARGS__)
 #    define IShaderResourceBinding_GetVariableByIndex(This, ...)      CALL_IFACE_METHOD(ShaderResourceBinding, GetVariableByIndex,           This, __VA_ARGS__)
 #    define IShaderResourceBinding_StaticResourcesInitialized(This)   CALL_IFACE_METHOD(ShaderResourceBinding, StaticResourcesInitialized,   This)
+#    define IShaderResourceBinding_SetResources(This, ...)            CALL_IFACE_METHOD(ShaderResourceBinding, SetResources,                 This, __VA_ARGS__)
 
 // clang-format on
 
@@ -41,6 +41,39 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_SwapChain =
     {0x1c703b77, 0x6607, 0x4eec, {0xb1, 0xfe, 0x15, 0xc8, 0x2d, 0x3b, 0x41, 0x30}};
 
+/// Swap chain frame pacing statistics, see ISwapChain::GetFramePacingStats().
+
+/// The statistics are collected from the feedback of the presentation engine: DXGI frame
+/// statistics in Direct3D11 and Direct3D12, and VK_GOOGLE_display_timing or VK_KHR_present_wait
+/// extensions in Vulkan. Other backends do not report the statistics.
+struct FramePacingStats
+{
+    /// The number of frames whose display time has been reported by the presentation engine.
+    Uint64 DisplayedFrameCount DEFAULT_INITIALIZER(0);
+
+    /// The total number of vertical blanks that passed between the displayed frames
+    /// in excess of the sync interval they were presented with.
+
+    /// \remarks   Missed vertical blanks are not reported by Vulkan devices that
+    ///            do not support VK_GOOGLE_display_timing extension.
+    Uint64 MissedVBlankCount   DEFAULT_INITIALIZER(0);
+
+    /// Time, in seconds, between the ISwapChain::Present() call and the moment
+    /// the last reported frame was displayed.
+
+    /// \remarks   When the display time is obtained through VK_KHR_present_wait,
+    ///            the latency is the upper bound measured on the CPU.
+    double LastPresentLatency  DEFAULT_INITIALIZER(0);
+
+    /// Average present-to-display latency, in seconds, over all reported frames.
+    double AvgPresentLatency   DEFAULT_INITIALIZER(0);
+
+    /// Maximum present-to-display latency, in seconds, over all reported frames.
+    double MaxPresentLatency   DEFAULT_INITIALIZER(0);
+};
+typedef struct FramePacingStats FramePacingStats;
+
+
 #define DILIGENT_INTERFACE_NAME ISwapChain
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -91,14 +124,25 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
 
     /// Sets the maximum number of frames that the swap chain is allowed to queue for rendering.
 
-    /// This value is only relevant for D3D11 and D3D12 backends and ignored for others.
+    /// This value is only relevant for D3D11, D3D12 and Vulkan backends and ignored for others.
     /// By default it matches the number of buffers in the swap chain. For example, for a 2-buffer
     /// swap chain, the CPU can enqueue frames 0 and 1, but Present command of frame 2
     /// will block until frame 0 is presented. If in the example above the maximum frame latency is set
     /// to 1, then Present command of frame 1 will block until Present of frame 0 is complete.
+    ///
+    /// \remarks   In Vulkan, the latency can only be limited if the device supports VK_KHR_present_id
+    ///            and VK_KHR_present_wait extensions. Otherwise the number of queued frames is
+    ///            only limited by the number of buffers in the swap chain.
     VIRTUAL void METHOD(SetMaximumFrameLatency)(THIS_
                                                 Uint32 MaxLatency) PURE;
 
+    /// Returns the frame pacing statistics, see Diligent::FramePacingStats.
+
+    /// \remarks   The statistics accumulate over the lifetime of the swap chain and are updated
+    ///            by ISwapChain::Present(). Presentation engines report the display time with
+    ///            a delay, so the statistics lag a few frames behind.
+    VIRTUAL const FramePacingStats REF METHOD(GetFramePacingStats)(THIS) CONST PURE;
+
     /// Returns render target view of the current back buffer in the swap chain
 
     /// \note For Direct3D12 and Vulkan backends, the function returns
@@ -131,6 +175,7 @@ DILIGENT_END_INTERFACE
 #    define ISwapChain_SetFullscreenMode(This, ...)      CALL_IFACE_METHOD(SwapChain, SetFullscreenMode,       This, __VA_ARGS__)
 #    define ISwapChain_SetWindowedMode(This)             CALL_IFACE_METHOD(SwapChain, SetWindowedMode,         This)
 #    define ISwapChain_SetMaximumFrameLatency(This, ...) CALL_IFACE_METHOD(SwapChain, SetMaximumFrameLatency,  This, __VA_ARGS__)
+#    define ISwapChain_GetFramePacingStats(This)         CALL_IFACE_METHOD(SwapChain, GetFramePacingStats,     This)
 #    define ISwapChain_GetCurrentBackBufferRTV(This)     CALL_IFACE_METHOD(SwapChain, GetCurrentBackBufferRTV, This)
 #    define ISwapChain_GetDepthBufferDSV(This)           CALL_IFACE_METHOD(SwapChain, GetDepthBufferDSV,       This)
 
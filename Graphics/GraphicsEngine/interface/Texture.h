@@ -72,7 +72,19 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Requires SHADING_RATE_CAP_FLAG_SUBSAMPLED_RENDER_TARGET capability.
     /// 
     /// \note  Copy operations are not supported for subsampled textures.
-    MISC_TEXTURE_FLAG_SUBSAMPLED      = 1u << 3
+    MISC_TEXTURE_FLAG_SUBSAMPLED      = 1u << 3,
+
+    /// Track resource states of individual mip levels and array slices.
+    ///
+    /// \remarks   Automatic state transitions of textures created with this flag only affect the
+    ///            subresources addressed by the texture views (render targets, depth-stencil and
+    ///            shader resources), and state transition barriers with STATE_TRANSITION_FLAG_UPDATE_STATE
+    ///            flag only update the states of the subresources they address.
+    ///            While the subresources are in different states, ITexture::GetState() returns
+    ///            RESOURCE_STATE_UNKNOWN.
+    ///
+    /// \note      This flag is only supported in Vulkan backend.
+    MISC_TEXTURE_FLAG_SUBRESOURCE_STATES = 1u << 4
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
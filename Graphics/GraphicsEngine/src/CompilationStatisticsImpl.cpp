@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CompilationStatisticsImpl.hpp"
+
+#include <atomic>
+#include <sstream>
+
+#include "GraphicsAccessories.hpp"
+#include "StringDataBlobImpl.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+const char* GetCompilationStageName(COMPILATION_STAGE Stage)
+{
+    static_assert(COMPILATION_STAGE_COUNT == 5, "Please handle the new stage below");
+    switch (Stage)
+    {
+        // clang-format off
+        case COMPILATION_STAGE_PREPROCESS: return "Preprocess";
+        case COMPILATION_STAGE_COMPILE:    return "Compile";
+        case COMPILATION_STAGE_OPTIMIZE:   return "Optimize";
+        case COMPILATION_STAGE_REFLECTION: return "Reflection";
+        case COMPILATION_STAGE_DRIVER:     return "Driver";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected compilation stage");
+            return "Unknown";
+    }
+}
+
+const char* GetRecordTypeName(COMPILATION_RECORD_TYPE Type)
+{
+    return Type == COMPILATION_RECORD_TYPE_PIPELINE ? "Pipeline" : "Shader";
+}
+
+const char* GetCacheResultName(PIPELINE_CACHE_RESULT Result)
+{
+    switch (Result)
+    {
+        // clang-format off
+        case PIPELINE_CACHE_RESULT_HIT:  return "Hit";
+        case PIPELINE_CACHE_RESULT_MISS: return "Miss";
+        default:                         return "Unknown";
+            // clang-format on
+    }
+}
+
+// Formats the stage feedback as "SHADER_TYPE_VERTEX:Hit:120;SHADER_TYPE_PIXEL:Miss:850"
+std::string GetStageFeedbackString(const CompilationRecord& Record)
+{
+    std::stringstream ss;
+    for (Uint32 i = 0; i < Record.NumStageFeedbacks; ++i)
+    {
+        const auto& Feedback = Record.StageFeedbacks[i];
+        ss << (i > 0 ? ";" : "") << GetShaderTypeLiteralName(Feedback.ShaderType) << ':'
+           << GetCacheResultName(Feedback.CacheResult) << ':' << Feedback.Duration;
+    }
+    return ss.str();
+}
+
+// Writes the string as a CSV field, quoting it if necessary
+void WriteCSVField(std::stringstream& ss, const std::string& Str)
+{
+    if (Str.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        ss << Str;
+        return;
+    }
+
+    ss << '"';
+    for (auto c : Str)
+    {
+        if (c == '"')
+            ss << '"';
+        ss << c;
+    }
+    ss << '"';
+}
+
+// Writes the string as a JSON string literal
+void WriteJSONString(std::stringstream& ss, const std::string& Str)
+{
+    ss << '"';
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            // clang-format off
+            case '"':  ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\n': ss << "\\n";  break;
+            case '\r': ss << "\\r";  break;
+            case '\t': ss << "\\t";  break;
+            // clang-format on
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    static constexpr char HexDigits[] = "0123456789abcdef";
+                    ss << "\\u00" << HexDigits[(c >> 4) & 0xF] << HexDigits[c & 0xF];
+                }
+                else
+                {
+                    ss << c;
+                }
+        }
+    }
+    ss << '"';
+}
+
+} // namespace
+
+CompilationStatisticsImpl::CompilationStatisticsImpl(IReferenceCounters* pRefCounters) :
+    TBase{pRefCounters},
+    m_StartTime{Clock::now()}
+{
+}
+
+Uint32 CompilationStatisticsImpl::GetRecordCount() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_Records.size());
+}
+
+const CompilationRecord& CompilationStatisticsImpl::GetRecord(Uint32 Index) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    DEV_CHECK_ERR(Index < m_Records.size(), "Record index (", Index, ") is out of range");
+    return m_Records[Index].Record;
+}
+
+void CompilationStatisticsImpl::Reset()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Records.clear();
+    m_StartTime = Clock::now();
+}
+
+void CompilationStatisticsImpl::AddRecord(const CompilationRecord& Record, const char* Name, Clock::time_point StartTime)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    m_Records.emplace_back();
+    auto& Data = m_Records.back();
+
+    Data.Name             = Name != nullptr ? Name : "";
+    Data.Record           = Record;
+    Data.Record.Name      = Data.Name.c_str();
+    Data.Record.StartTime = StartTime > m_StartTime ?
+        static_cast<Uint64>(std::chrono::duration_cast<std::chrono::microseconds>(StartTime - m_StartTime).count()) :
+        0;
+}
+
+Uint32 CompilationStatisticsImpl::GetThreadId()
+{
+    static std::atomic<Uint32> NextThreadId{0};
+    static thread_local Uint32 ThreadId = NextThreadId.fetch_add(1);
+    return ThreadId;
+}
+
+void CompilationStatisticsImpl::ExportCSV(IDataBlob** ppData) const
+{
+    DEV_CHECK_ERR(ppData != nullptr && *ppData == nullptr, "ppData must not be null and must point to a null pointer");
+
+    std::stringstream ss;
+    ss << "Type,Name,Shader Stages,Thread,Start (us),Duration (us)";
+    for (Uint32 Stage = 0; Stage < COMPILATION_STAGE_COUNT; ++Stage)
+        ss << ',' << GetCompilationStageName(static_cast<COMPILATION_STAGE>(Stage)) << " (us)";
+    ss << ",Cache,Driver Feedback (us),Stage Feedback,Byte Code Size\n";
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (const auto& Data : m_Records)
+        {
+            const auto& Record = Data.Record;
+            ss << GetRecordTypeName(Record.Type) << ',';
+            WriteCSVField(ss, Data.Name);
+            ss << ',';
+            WriteCSVField(ss, GetShaderStagesString(Record.ShaderType));
+            ss << ',' << Record.ThreadId << ',' << Record.StartTime << ',' << Record.Duration;
+            for (Uint32 Stage = 0; Stage < COMPILATION_STAGE_COUNT; ++Stage)
+                ss << ',' << Record.StageDurations[Stage];
+            ss << ',' << GetCacheResultName(Record.CacheResult) << ',' << Record.DriverDuration << ',';
+            WriteCSVField(ss, GetStageFeedbackString(Record));
+            ss << ',' << Record.ByteCodeSize << '\n';
+        }
+    }
+
+    auto* pDataBlob = MakeNewRCObj<StringDataBlobImpl>()(ss.str());
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
+void CompilationStatisticsImpl::ExportChromeTrace(IDataBlob** ppData) const
+{
+    DEV_CHECK_ERR(ppData != nullptr && *ppData == nullptr, "ppData must not be null and must point to a null pointer");
+
+    std::stringstream ss;
+    ss << "{\"traceEvents\":[";
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        bool                        First = true;
+        for (const auto& Data : m_Records)
+        {
+            const auto& Record = Data.Record;
+
+            ss << (First ? "\n" : ",\n");
+            First = false;
+
+            ss << "{\"name\":";
+            WriteJSONString(ss, Data.Name);
+            ss << ",\"cat\":\"" << GetRecordTypeName(Record.Type) << "\""
+               << ",\"ph\":\"X\",\"pid\":0"
+               << ",\"tid\":" << Record.ThreadId
+               << ",\"ts\":" << Record.StartTime
+               << ",\"dur\":" << Record.Duration
+               << ",\"args\":{\"Shader Stages\":";
+            WriteJSONString(ss, GetShaderStagesString(Record.ShaderType));
+            for (Uint32 Stage = 0; Stage < COMPILATION_STAGE_COUNT; ++Stage)
+                ss << ",\"" << GetCompilationStageName(static_cast<COMPILATION_STAGE>(Stage)) << " (us)\":" << Record.StageDurations[Stage];
+            if (Record.Type == COMPILATION_RECORD_TYPE_PIPELINE)
+            {
+                ss << ",\"Cache\":\"" << GetCacheResultName(Record.CacheResult) << "\""
+                   << ",\"Driver Feedback (us)\":" << Record.DriverDuration;
+                for (Uint32 i = 0; i < Record.NumStageFeedbacks; ++i)
+                {
+                    const auto& Feedback  = Record.StageFeedbacks[i];
+                    const auto* StageName = GetShaderTypeLiteralName(Feedback.ShaderType);
+                    ss << ",\"" << StageName << " Cache\":\"" << GetCacheResultName(Feedback.CacheResult) << "\""
+                       << ",\"" << StageName << " (us)\":" << Feedback.Duration;
+                }
+            }
+            ss << ",\"Byte Code Size\":" << Record.ByteCodeSize << "}}";
+        }
+    }
+
+    ss << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    auto* pDataBlob = MakeNewRCObj<StringDataBlobImpl>()(ss.str());
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
+
+CompilationRecordScope::CompilationRecordScope(CompilationStatisticsImpl* pStatistics,
+                                               COMPILATION_RECORD_TYPE    Type,
+                                               SHADER_TYPE                ShaderType,
+                                               const char*                Name) :
+    m_pStatistics{pStatistics},
+    m_pParent{GetCurrent()},
+    m_Name{Name},
+    m_StartTime{pStatistics != nullptr ? CompilationStatisticsImpl::Clock::now() : CompilationStatisticsImpl::Clock::time_point{}}
+{
+    if (m_pStatistics == nullptr)
+        return;
+
+    m_Record.Type       = Type;
+    m_Record.ShaderType = ShaderType;
+    m_Record.ThreadId   = CompilationStatisticsImpl::GetThreadId();
+
+    GetCurrent() = this;
+}
+
+void CompilationRecordScope::AddStageFeedback(SHADER_TYPE ShaderType, PIPELINE_CACHE_RESULT CacheResult, Uint64 Duration)
+{
+    if (m_pStatistics == nullptr)
+        return;
+
+    for (Uint32 i = 0; i < m_Record.NumStageFeedbacks; ++i)
+    {
+        auto& Feedback = m_Record.StageFeedbacks[i];
+        if (Feedback.ShaderType == ShaderType)
+        {
+            Feedback.CacheResult = CombinePipelineCacheResults(Feedback.CacheResult, CacheResult);
+            Feedback.Duration += Duration;
+            return;
+        }
+    }
+
+    if (m_Record.NumStageFeedbacks < MAX_PIPELINE_STAGE_FEEDBACKS)
+    {
+        auto& Feedback       = m_Record.StageFeedbacks[m_Record.NumStageFeedbacks++];
+        Feedback.ShaderType  = ShaderType;
+        Feedback.CacheResult = CacheResult;
+        Feedback.Duration    = Duration;
+    }
+    else
+    {
+        UNEXPECTED("Too many shader stage types in pipeline feedback");
+    }
+}
+
+CompilationRecordScope::~CompilationRecordScope()
+{
+    if (m_pStatistics == nullptr)
+        return;
+
+    VERIFY(m_pActiveTimer == nullptr, "All stage timers must be destroyed before the record scope");
+    VERIFY(GetCurrent() == this, "Record scopes must be destroyed in the reverse order of creation");
+    GetCurrent() = m_pParent;
+
+    m_Record.Duration = static_cast<Uint64>(std::chrono::duration_cast<std::chrono::microseconds>(CompilationStatisticsImpl::Clock::now() - m_StartTime).count());
+    m_pStatistics->AddRecord(m_Record, m_Name, m_StartTime);
+}
+
+} // namespace Diligent
@@ -25,8 +25,14 @@
  */
 
 #include "DearchiverBase.hpp"
+
+#include <deque>
+#include <cstring>
+
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "ThreadPool.hpp"
+#include "TrackingMemoryAllocator.hpp"
 
 namespace Diligent
 {
@@ -127,6 +133,7 @@ struct DearchiverBase::PSOData
 
 private:
     bool DeserializeInternal(Serializer<SerializerMode::Read>& Ser);
+    bool DeserializeTrailingData(Serializer<SerializerMode::Read>& Ser);
 };
 
 
@@ -180,6 +187,53 @@ void DearchiverBase::NamedResourceCache<ResType>::Set(ResourceType Type, const c
 template class DearchiverBase::NamedResourceCache<IPipelineResourceSignature>;
 
 
+DearchiverBase::ShaderContentCache::Key::Key(DeviceType _DevType, const SerializedData& SerializedShader, bool _SkipReflection) :
+    // clang-format off
+    pData         {SerializedShader.Ptr()},
+    Size          {SerializedShader.Size()},
+    // The hash is cached by the archive data, so the shader is only hashed once
+    Hash          {ComputeHash(SerializedShader.GetHash(), static_cast<size_t>(_DevType), _SkipReflection)},
+    DevType       {_DevType},
+    SkipReflection{_SkipReflection}
+// clang-format on
+{
+}
+
+bool DearchiverBase::ShaderContentCache::Key::operator==(const Key& rhs) const
+{
+    // clang-format off
+    return Hash           == rhs.Hash           &&
+           Size           == rhs.Size           &&
+           DevType        == rhs.DevType        &&
+           SkipReflection == rhs.SkipReflection &&
+           (pData == rhs.pData || std::memcmp(pData, rhs.pData, Size) == 0);
+    // clang-format on
+}
+
+RefCntAutoPtr<IShader> DearchiverBase::ShaderContentCache::Get(DeviceType DevType, const SerializedData& SerializedShader, bool SkipReflection)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Map.find(Key{DevType, SerializedShader, SkipReflection});
+    return it != m_Map.end() ? it->second.Lock() : RefCntAutoPtr<IShader>{};
+}
+
+void DearchiverBase::ShaderContentCache::Set(DeviceType DevType, const SerializedData& SerializedShader, bool SkipReflection, IShader* pShader)
+{
+    VERIFY_EXPR(pShader != nullptr);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // Replace the expired reference, if any
+    m_Map[Key{DevType, SerializedShader, SkipReflection}] = RefCntWeakPtr<IShader>{pShader};
+}
+
+void DearchiverBase::ShaderContentCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Map.clear();
+}
+
+
 bool DearchiverBase::PRSData::Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser)
 {
     Desc.Name = Name;
@@ -213,6 +267,22 @@ bool DearchiverBase::PSOData<RayTracingPipelineStateCreateInfo>::DeserializeInte
     return PSOSerializer<SerializerMode::Read>::SerializeCreateInfo(Ser, CreateInfo, PRSNames, &Allocator, RemapShaders);
 }
 
+template <typename CreateInfoType>
+bool DearchiverBase::PSOData<CreateInfoType>::DeserializeTrailingData(Serializer<SerializerMode::Read>& Ser)
+{
+    return true;
+}
+
+template <>
+bool DearchiverBase::PSOData<GraphicsPipelineStateCreateInfo>::DeserializeTrailingData(Serializer<SerializerMode::Read>& Ser)
+{
+    // Dynamic state flags are only present when they are not NONE
+    if (Ser.IsEnded())
+        return true;
+
+    return PSOSerializer<SerializerMode::Read>::SerializeDynamicStateFlags(Ser, CreateInfo.GraphicsPipeline.DynamicStateFlags);
+}
+
 template <typename CreateInfoType>
 bool DearchiverBase::PSOData<CreateInfoType>::Deserialize(const char* Name, Serializer<SerializerMode::Read>& Ser)
 {
@@ -224,6 +294,9 @@ bool DearchiverBase::PSOData<CreateInfoType>::Deserialize(const char* Name, Seri
     if (!PSOSerializer<SerializerMode::Read>::SerializeAuxData(Ser, AuxData, &Allocator))
         return false;
 
+    if (!DeserializeTrailingData(Ser))
+        return false;
+
     CreateInfo.Flags |= PSO_CREATE_FLAG_DONT_REMAP_SHADER_RESOURCES;
     if (AuxData.NoShaderReflection)
         InternalCI.Flags |= PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION;
@@ -294,6 +367,7 @@ bool DearchiverBase::UnpackPSOSignatures(PSOData<CreateInfoType>& PSO, IRenderDe
 }
 
 RefCntAutoPtr<IShader> DearchiverBase::UnpackShader(const ShaderCreateInfo& ShaderCI,
+                                                    const SerializedData&   ShaderReflection,
                                                     IRenderDevice*          pDevice)
 {
     RefCntAutoPtr<IShader> pShader;
@@ -416,7 +490,8 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
     if (!ShaderIdxData)
         return false;
 
-    DynamicLinearAllocator Allocator{GetRawAllocator()};
+    DynamicLinearAllocatorScope AllocatorScope;
+    auto&                       Allocator = AllocatorScope.GetAllocator();
 
     DeviceObjectArchive::ShaderIndexArray ShaderIndices;
     {
@@ -453,11 +528,18 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
         if (!SerializedShader)
             return false;
 
+        const bool SkipReflection = (PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0;
+
+        // Identical shaders in other loaded archives may already have been unpacked
+        pShader = m_ShaderContentCache.Get(DevType, SerializedShader, SkipReflection);
+        if (!pShader)
         {
             ShaderCreateInfo ShaderCI;
+            SerializedData   ShaderReflection;
             {
                 Serializer<SerializerMode::Read> ShaderSer{SerializedShader};
-                if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(ShaderSer, ShaderCI))
+                if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(ShaderSer, ShaderCI) ||
+                    !ShaderSerializer<SerializerMode::Read>::SerializeReflection(ShaderSer, ShaderReflection))
                 {
                     LOG_ERROR_MESSAGE("Failed to deserialize shader create info. Archive file may be corrupted or invalid.");
                     return false;
@@ -465,12 +547,14 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
                 VERIFY_EXPR(ShaderSer.IsEnded());
             }
 
-            if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0)
+            if (SkipReflection)
                 ShaderCI.CompileFlags |= SHADER_COMPILE_FLAG_SKIP_REFLECTION;
 
-            pShader = UnpackShader(ShaderCI, pDevice);
+            pShader = UnpackShader(ShaderCI, ShaderReflection, pDevice);
             if (!pShader)
                 return false;
+
+            m_ShaderContentCache.Set(DevType, SerializedShader, SkipReflection, pShader);
         }
 
         // Add to the cache
@@ -595,6 +679,8 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
 {
     VERIFY_EXPR(UnpackInfo.pDevice != nullptr);
 
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_ARCHIVE};
+
     constexpr auto ResType = PSOData<CreateInfoType>::ArchiveResType;
 
     // Do not cache modified PSOs
@@ -653,6 +739,8 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, bool MakeCopy)
     if (pArchiveData == nullptr)
         return false;
 
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_ARCHIVE};
+
     try
     {
         for (const auto& Archive : m_Archives)
@@ -725,6 +813,176 @@ void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackIn
     }
 }
 
+template <typename CreateInfoType>
+bool DearchiverBase::GetPSODependenciesImpl(const PipelineStateUnpackInfo& UnpackInfo, PSODependencies& Deps)
+{
+    constexpr auto ResType = PSOData<CreateInfoType>::ArchiveResType;
+
+    auto* pArchiveData = FindArchive(ResType, UnpackInfo.Name);
+    if (pArchiveData == nullptr)
+        return false;
+
+    PSOData<CreateInfoType> PSO{GetRawAllocator()};
+    if (!pArchiveData->pObjArchive->LoadResourceCommonData(ResType, UnpackInfo.Name, PSO))
+        return false;
+
+    // Implicit signatures are never shared between pipelines
+    if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) == 0)
+    {
+        for (Uint32 i = 0; i < PSO.CreateInfo.ResourceSignaturesCount; ++i)
+            Deps.SignatureNames.emplace_back(PSO.PRSNames[i]);
+    }
+
+    if (PSO.RenderPassName != nullptr && *PSO.RenderPassName != 0)
+        Deps.RenderPassName = PSO.RenderPassName;
+
+    Deps.SRBAllocationGranularity = PSO.CreateInfo.PSODesc.SRBAllocationGranularity;
+
+    return true;
+}
+
+bool DearchiverBase::GetPSODependencies(const PipelineStateUnpackInfo& UnpackInfo, PSODependencies& Deps)
+{
+    switch (UnpackInfo.PipelineType)
+    {
+        case PIPELINE_TYPE_GRAPHICS:
+        case PIPELINE_TYPE_MESH:
+            return GetPSODependenciesImpl<GraphicsPipelineStateCreateInfo>(UnpackInfo, Deps);
+
+        case PIPELINE_TYPE_COMPUTE:
+            return GetPSODependenciesImpl<ComputePipelineStateCreateInfo>(UnpackInfo, Deps);
+
+        case PIPELINE_TYPE_RAY_TRACING:
+            return GetPSODependenciesImpl<RayTracingPipelineStateCreateInfo>(UnpackInfo, Deps);
+
+        case PIPELINE_TYPE_TILE:
+            return GetPSODependenciesImpl<TilePipelineStateCreateInfo>(UnpackInfo, Deps);
+
+        case PIPELINE_TYPE_INVALID:
+        default:
+            return false;
+    }
+}
+
+void DearchiverBase::UnpackPipelineStates(const PipelineStateUnpackInfo* pUnpackInfos,
+                                          Uint32                         NumPipelines,
+                                          IThreadPool*                   pThreadPool,
+                                          IPipelineState**               ppPSOs)
+{
+    if (NumPipelines == 0)
+        return;
+
+    if (pUnpackInfos == nullptr || ppPSOs == nullptr)
+    {
+        DEV_ERROR("pUnpackInfos and ppPSOs must not be null");
+        return;
+    }
+
+    if (pThreadPool == nullptr)
+    {
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+            UnpackPipelineState(pUnpackInfos[i], &ppPSOs[i]);
+        return;
+    }
+
+    // Objects shared by multiple pipelines
+    struct SharedObject
+    {
+        SharedObject(ResourceType _Type, const std::string& _Name, IRenderDevice* _pDevice, Uint32 _SRBAllocationGranularity) :
+            Type{_Type},
+            Name{_Name},
+            pDevice{_pDevice},
+            SRBAllocationGranularity{_SRBAllocationGranularity}
+        {}
+
+        const ResourceType Type;
+        const std::string  Name;
+        IRenderDevice*     pDevice;
+        Uint32             SRBAllocationGranularity;
+
+        RefCntAutoPtr<IDeviceObject> pObject;
+        RefCntAutoPtr<IAsyncTask>    pTask;
+    };
+    // Use deque to keep pointers to the elements valid
+    std::deque<SharedObject>                                                      SharedObjects;
+    std::unordered_map<NamedResourceKey, SharedObject*, NamedResourceKey::Hasher> SharedObjectsMap;
+
+    std::vector<std::vector<SharedObject*>> PSODeps(NumPipelines);
+
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        const auto& UnpackInfo = pUnpackInfos[i];
+        if (!VerifyPipelineStateUnpackInfo(UnpackInfo, &ppPSOs[i]))
+            continue;
+
+        PSODependencies Deps;
+        if (!GetPSODependencies(UnpackInfo, Deps))
+            continue;
+
+        auto AddDependency = [&](ResourceType Type, const std::string& Name) {
+            auto it = SharedObjectsMap.find(NamedResourceKey{Type, Name.c_str()});
+            if (it == SharedObjectsMap.end())
+            {
+                SharedObjects.emplace_back(Type, Name, UnpackInfo.pDevice, Deps.SRBAllocationGranularity);
+                // Note that the key references the name owned by the shared object
+                it = SharedObjectsMap.emplace(NamedResourceKey{Type, SharedObjects.back().Name.c_str()}, &SharedObjects.back()).first;
+            }
+            PSODeps[i].push_back(it->second);
+        };
+
+        for (const auto& SignName : Deps.SignatureNames)
+            AddDependency(ResourceType::ResourceSignature, SignName);
+        if (!Deps.RenderPassName.empty())
+            AddDependency(ResourceType::RenderPass, Deps.RenderPassName);
+    }
+
+    // Unpack shared objects first. Every object is unpacked only once and is added to the resource cache,
+    // so that the pipelines that use it will find it there.
+    for (auto& Obj : SharedObjects)
+    {
+        Obj.pTask = EnqueueAsyncWork(pThreadPool,
+                                     [this, &Obj](Uint32 ThreadId) {
+                                         if (Obj.Type == ResourceType::ResourceSignature)
+                                         {
+                                             ResourceSignatureUnpackInfo UnpackInfo{Obj.pDevice, Obj.Name.c_str()};
+                                             UnpackInfo.SRBAllocationGranularity = Obj.SRBAllocationGranularity;
+
+                                             RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+                                             UnpackResourceSignature(UnpackInfo, &pSignature);
+                                             Obj.pObject = std::move(pSignature);
+                                         }
+                                         else
+                                         {
+                                             VERIFY_EXPR(Obj.Type == ResourceType::RenderPass);
+
+                                             RefCntAutoPtr<IRenderPass> pRenderPass;
+                                             UnpackRenderPass(RenderPassUnpackInfo{Obj.pDevice, Obj.Name.c_str()}, &pRenderPass);
+                                             Obj.pObject = std::move(pRenderPass);
+                                         }
+                                     });
+    }
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> PSOTasks(NumPipelines);
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        std::vector<IAsyncTask*> Prerequisites;
+        Prerequisites.reserve(PSODeps[i].size());
+        for (auto* pObj : PSODeps[i])
+            Prerequisites.push_back(pObj->pTask);
+
+        PSOTasks[i] = EnqueueAsyncWork(pThreadPool, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()),
+                                       [this, &UnpackInfo = pUnpackInfos[i], ppPSO = &ppPSOs[i]](Uint32 ThreadId) {
+                                           UnpackPipelineState(UnpackInfo, ppPSO);
+                                       });
+    }
+
+    // Shared objects must be kept alive until all pipelines that use them are created
+    for (auto& pTask : PSOTasks)
+        pTask->WaitForCompletion();
+    for (auto& Obj : SharedObjects)
+        Obj.pTask->WaitForCompletion();
+}
+
 static bool ModifyShaderDesc(ShaderDesc&             Desc,
                              const ShaderUnpackInfo& UnpackInfo)
 {
@@ -782,10 +1040,24 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
     if (!SerializedShader)
         return;
 
+    // Shaders with modified descriptions are not shared
+    const bool UseContentCache = UnpackInfo.ModifyShaderDesc == nullptr;
+    if (UseContentCache)
+    {
+        auto pShader = m_ShaderContentCache.Get(DevType, SerializedShader, /*SkipReflection = */ false);
+        if (pShader)
+        {
+            *ppShader = pShader.Detach();
+            return;
+        }
+    }
+
     ShaderCreateInfo ShaderCI;
+    SerializedData   ShaderReflection;
     {
         Serializer<SerializerMode::Read> Ser{SerializedShader};
-        if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(Ser, ShaderCI))
+        if (!ShaderSerializer<SerializerMode::Read>::SerializeCI(Ser, ShaderCI) ||
+            !ShaderSerializer<SerializerMode::Read>::SerializeReflection(Ser, ShaderReflection))
         {
             LOG_ERROR_MESSAGE("Failed to deserialize shader create info. Archive file may be corrupted or invalid.");
             return;
@@ -796,10 +1068,13 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
     if (!ModifyShaderDesc(ShaderCI.Desc, UnpackInfo))
         return;
 
-    auto pShader = UnpackShader(ShaderCI, UnpackInfo.pDevice);
+    auto pShader = UnpackShader(ShaderCI, ShaderReflection, UnpackInfo.pDevice);
     if (!pShader)
         return;
 
+    if (UseContentCache)
+        m_ShaderContentCache.Set(DevType, SerializedShader, /*SkipReflection = */ false, pShader);
+
     pShader->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
 }
 
@@ -853,6 +1128,54 @@ void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IR
         m_Cache.RenderPass.Set(RPData::ArchiveResType, UnpackInfo.Name, *ppRP);
 }
 
+void DearchiverBase::UnpackPipelineStateCache(IRenderDevice* pDevice, IPipelineStateCache** ppCache)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "pDevice must not be null");
+    DEV_CHECK_ERR(ppCache != nullptr, "ppCache must not be null");
+    if (pDevice == nullptr || ppCache == nullptr)
+        return;
+    DEV_CHECK_ERR(*ppCache == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+    *ppCache = nullptr;
+
+    const auto DevType = GetArchiveDeviceType(pDevice);
+
+    std::vector<RefCntAutoPtr<IPipelineStateCache>> Caches;
+    for (const auto& Archive : m_Archives)
+    {
+        const auto& CacheData = Archive.pObjArchive->GetPipelineCacheData(DevType);
+        if (!CacheData)
+            continue;
+
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name     = "Dearchived pipeline state cache";
+        CacheCI.Desc.Mode     = PSO_CACHE_MODE_LOAD;
+        CacheCI.pCacheData    = CacheData.Ptr();
+        CacheCI.CacheDataSize = StaticCast<Uint32>(CacheData.Size());
+
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+        if (pCache)
+            Caches.emplace_back(std::move(pCache));
+    }
+
+    if (Caches.empty())
+        return;
+
+    if (Caches.size() > 1)
+    {
+        std::vector<IPipelineStateCache*> SrcCaches;
+        SrcCaches.reserve(Caches.size() - 1);
+        for (size_t i = 1; i < Caches.size(); ++i)
+            SrcCaches.push_back(Caches[i]);
+
+        if (!Caches[0]->Merge(StaticCast<Uint32>(SrcCaches.size()), SrcCaches.data()))
+            LOG_WARNING_MESSAGE("Failed to merge pipeline state caches from ", Caches.size(), " archives. Only the cache from the first archive will be used.");
+    }
+
+    *ppCache = Caches[0].Detach();
+}
+
 bool DearchiverBase::Store(IDataBlob** ppArchive) const
 {
     if (ppArchive == nullptr)
@@ -869,7 +1192,12 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
         for (const auto& Archive : m_Archives)
         {
             if (Archive.pObjArchive)
+            {
                 MergedArchive.Merge(*Archive.pObjArchive);
+                // Keep shaders compressed if any of the source archives was compressed
+                if (Archive.pObjArchive->GetShaderCompression() != DeviceObjectArchive::ShaderCompression::None)
+                    MergedArchive.SetShaderCompression(Archive.pObjArchive->GetShaderCompression());
+            }
         }
 
         MergedArchive.Serialize(ppArchive);
@@ -883,6 +1211,8 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
 
 void DearchiverBase::Reset()
 {
+    // The cache references the archive data
+    m_ShaderContentCache.Clear();
     m_Archives.clear();
 }
 
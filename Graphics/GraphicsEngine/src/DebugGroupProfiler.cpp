@@ -0,0 +1,293 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DebugGroupProfiler.hpp"
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Groups that exceed the limit are not profiled, which may only happen
+// if the frames are not finished or the GPU falls far behind.
+constexpr size_t MaxPendingGroups = 4096;
+
+} // namespace
+
+DebugGroupProfiler::DebugGroupProfiler(IRenderDevice* pDevice, IDeviceContext* pContext, QueryCreatedCallbackType OnQueryCreated) :
+    m_pDevice{pDevice},
+    m_pContext{pContext},
+    m_OnQueryCreated{std::move(OnQueryCreated)}
+{
+    const RenderDeviceInfo& DevInfo  = m_pDevice->GetDeviceInfo();
+    const bool              Graphics = (m_pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_GRAPHICS) == COMMAND_QUEUE_TYPE_GRAPHICS;
+
+    m_QueryEnabled[PROFILER_QUERY_DURATION]   = DevInfo.Features.DurationQueries != DEVICE_FEATURE_STATE_DISABLED;
+    m_QueryEnabled[PROFILER_QUERY_STATISTICS] = DevInfo.Features.PipelineStatisticsQueries != DEVICE_FEATURE_STATE_DISABLED && Graphics;
+
+    // GL_TIME_ELAPSED queries may not be nested.
+    // Pipeline statistics queries may not overlap in Vulkan and OpenGL.
+    m_AllowNested[PROFILER_QUERY_DURATION]   = !DevInfo.IsGLDevice();
+    m_AllowNested[PROFILER_QUERY_STATISTICS] = false;
+
+    if (!m_QueryEnabled[PROFILER_QUERY_DURATION] && !m_QueryEnabled[PROFILER_QUERY_STATISTICS])
+    {
+        LOG_WARNING_MESSAGE("Neither duration nor pipeline statistics queries are enabled in context '", m_pContext->GetDesc().Name,
+                            "'. Debug groups will be listed in the profile, but no GPU data will be collected.");
+    }
+}
+
+RefCntAutoPtr<IQuery> DebugGroupProfiler::AllocateQuery(PROFILER_QUERY Type)
+{
+    std::vector<RefCntAutoPtr<IQuery>>& FreeQueries = m_FreeQueries[Type];
+    if (!FreeQueries.empty())
+    {
+        RefCntAutoPtr<IQuery> pQuery = std::move(FreeQueries.back());
+        FreeQueries.pop_back();
+        return pQuery;
+    }
+
+    QueryDesc Desc;
+    if (Type == PROFILER_QUERY_DURATION)
+    {
+        Desc.Name = "Debug group duration query";
+        Desc.Type = QUERY_TYPE_DURATION;
+    }
+    else
+    {
+        Desc.Name = "Debug group pipeline statistics query";
+        Desc.Type = QUERY_TYPE_PIPELINE_STATISTICS;
+    }
+
+    RefCntAutoPtr<IQuery> pQuery;
+    m_pDevice->CreateQuery(Desc, &pQuery);
+    if (!pQuery)
+    {
+        LOG_ERROR_MESSAGE("Failed to create ", Desc.Name, ". Debug group profiling will not use this query type.");
+        m_QueryEnabled[Type] = false;
+        return {};
+    }
+
+    if (m_OnQueryCreated)
+        m_OnQueryCreated(pQuery);
+
+    return pQuery;
+}
+
+void DebugGroupProfiler::RecycleQueries(GroupRecord& Record)
+{
+    for (Uint32 Type = 0; Type < PROFILER_QUERY_COUNT; ++Type)
+    {
+        if (Record.pQueries[Type])
+        {
+            Record.pQueries[Type]->Invalidate();
+            m_FreeQueries[Type].emplace_back(std::move(Record.pQueries[Type]));
+        }
+    }
+}
+
+bool DebugGroupProfiler::CanBeginQuery(PROFILER_QUERY Type) const
+{
+    return m_QueryEnabled[Type] && (m_AllowNested[Type] || m_NumActiveQueries[Type] == 0);
+}
+
+Uint32 DebugGroupProfiler::GetPathId(const Char* Name)
+{
+    std::string Path;
+    if (!m_OpenGroups.empty())
+    {
+        Path = m_Paths[m_OpenGroups.back()->PathId];
+        Path += '/';
+    }
+    Path += Name;
+
+    auto it = m_PathIds.find(Path);
+    if (it != m_PathIds.end())
+        return it->second;
+
+    const Uint32 PathId = static_cast<Uint32>(m_Paths.size());
+    m_Paths.emplace_back(Path);
+    m_PathIds.emplace(std::move(Path), PathId);
+    return PathId;
+}
+
+void DebugGroupProfiler::BeginDebugGroup(const Char* Name, Uint32 Depth, Uint64 FrameNumber)
+{
+    if (m_Pending.size() >= MaxPendingGroups)
+        return;
+
+    m_Pending.emplace_back();
+    GroupRecord& Record = m_Pending.back();
+    Record.FrameNumber  = FrameNumber;
+    Record.PathId       = GetPathId(Name);
+    Record.Depth        = Depth;
+
+    for (Uint32 Type = 0; Type < PROFILER_QUERY_COUNT; ++Type)
+    {
+        if (!CanBeginQuery(static_cast<PROFILER_QUERY>(Type)))
+            continue;
+
+        Record.pQueries[Type] = AllocateQuery(static_cast<PROFILER_QUERY>(Type));
+        if (Record.pQueries[Type])
+        {
+            m_pContext->BeginQuery(Record.pQueries[Type]);
+            ++m_NumActiveQueries[Type];
+        }
+    }
+
+    m_OpenGroups.push_back(&Record);
+}
+
+void DebugGroupProfiler::EndDebugGroup(Uint32 Depth)
+{
+    // The group was begun while profiling was disabled or the pending queue was full
+    if (m_OpenGroups.empty() || m_OpenGroups.back()->Depth != Depth)
+        return;
+
+    GroupRecord& Record = *m_OpenGroups.back();
+    m_OpenGroups.pop_back();
+
+    // End the queries in the reverse order
+    for (Uint32 Type = PROFILER_QUERY_COUNT; Type-- > 0;)
+    {
+        if (Record.pQueries[Type])
+        {
+            m_pContext->EndQuery(Record.pQueries[Type]);
+            VERIFY_EXPR(m_NumActiveQueries[Type] > 0);
+            --m_NumActiveQueries[Type];
+        }
+    }
+    Record.Ended = true;
+}
+
+void DebugGroupProfiler::ResolvePending(Uint64 CurrentFrame)
+{
+    // Groups are resolved in the order they were begun. An open group
+    // blocks the groups that follow it, including its children.
+    size_t NumReady = 0;
+    while (NumReady < m_Pending.size() && m_Pending[NumReady].Ended && m_Pending[NumReady].FrameNumber < CurrentFrame)
+        ++NumReady;
+
+    // The number of leading groups whose results are available
+    size_t NumResolved = NumReady;
+    for (Uint32 Type = 0; Type < PROFILER_QUERY_COUNT && NumResolved > 0; ++Type)
+    {
+        m_BatchQueries.clear();
+        for (size_t i = 0; i < NumResolved; ++i)
+        {
+            if (m_Pending[i].pQueries[Type])
+                m_BatchQueries.push_back(m_Pending[i].pQueries[Type]);
+        }
+        if (m_BatchQueries.empty())
+            continue;
+
+        const Uint32 NumQueries = static_cast<Uint32>(m_BatchQueries.size());
+        if (m_DataAvailableSize < NumQueries)
+        {
+            m_DataAvailable.reset(new Bool[NumQueries]);
+            m_DataAvailableSize = NumQueries;
+        }
+
+        void*  pData    = nullptr;
+        Uint32 DataSize = 0;
+        if (Type == PROFILER_QUERY_DURATION)
+        {
+            m_DurationData.clear();
+            m_DurationData.resize(NumQueries);
+            pData    = m_DurationData.data();
+            DataSize = sizeof(QueryDataDuration);
+        }
+        else
+        {
+            m_StatisticsData.clear();
+            m_StatisticsData.resize(NumQueries);
+            pData    = m_StatisticsData.data();
+            DataSize = sizeof(QueryDataPipelineStatistics);
+        }
+        m_pContext->GetQueryData(NumQueries, m_BatchQueries.data(), pData, DataSize, m_DataAvailable.get(), False);
+
+        for (size_t i = 0, QueryIdx = 0; i < NumResolved; ++i)
+        {
+            if (!m_Pending[i].pQueries[Type])
+                continue;
+            if (!m_DataAvailable[QueryIdx++])
+            {
+                NumResolved = i;
+                break;
+            }
+        }
+    }
+
+    size_t QueryIdx[PROFILER_QUERY_COUNT] = {};
+    for (size_t i = 0; i < NumResolved; ++i)
+    {
+        GroupRecord& Record = m_Pending.front();
+        if (Record.FrameNumber != m_ResolvedFrame && !m_Resolved.empty())
+        {
+            m_Profile.swap(m_Resolved);
+            m_Resolved.clear();
+        }
+        m_ResolvedFrame = Record.FrameNumber;
+
+        m_Resolved.emplace_back();
+        DebugGroupProfile& Profile = m_Resolved.back();
+        Profile.Name               = m_Paths[Record.PathId].c_str();
+        Profile.Depth              = Record.Depth;
+        if (Record.pQueries[PROFILER_QUERY_DURATION])
+        {
+            const QueryDataDuration& Data = m_DurationData[QueryIdx[PROFILER_QUERY_DURATION]++];
+            if (Data.Frequency != 0)
+                Profile.GPUTime = static_cast<double>(Data.Duration) / static_cast<double>(Data.Frequency);
+        }
+        if (Record.pQueries[PROFILER_QUERY_STATISTICS])
+        {
+            const QueryDataPipelineStatistics& Data = m_StatisticsData[QueryIdx[PROFILER_QUERY_STATISTICS]++];
+
+            Profile.HasPipelineStatistics = True;
+            Profile.VSInvocations         = Data.VSInvocations;
+            Profile.PSInvocations         = Data.PSInvocations;
+            Profile.CSInvocations         = Data.CSInvocations;
+            Profile.InputPrimitives       = Data.InputPrimitives;
+            Profile.ClippingPrimitives    = Data.ClippingPrimitives;
+        }
+
+        RecycleQueries(Record);
+        m_Pending.pop_front();
+    }
+
+    // All groups of the frame have been resolved
+    if (!m_Resolved.empty() && (m_Pending.empty() || m_Pending.front().FrameNumber != m_ResolvedFrame))
+    {
+        m_Profile.swap(m_Resolved);
+        m_Resolved.clear();
+    }
+}
+
+} // namespace Diligent
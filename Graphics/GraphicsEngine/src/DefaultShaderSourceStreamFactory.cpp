@@ -31,6 +31,10 @@
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
 #include "BasicFileStream.hpp"
+#include "MappedFile.hpp"
+#if DILIGENT_MAPPED_FILE_SUPPORTED
+#    include "MappedFileStream.hpp"
+#endif
 
 namespace Diligent
 {
@@ -80,9 +84,15 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
 {
     auto CreateFileStream = [](const char* Path) //
     {
-        RefCntAutoPtr<BasicFileStream> pFileStream;
+        RefCntAutoPtr<IFileStream> pFileStream;
         if (FileSystem::FileExists(Path))
         {
+#if DILIGENT_MAPPED_FILE_SUPPORTED
+            // Memory-mapped stream reads the file contents without intermediate buffering
+            pFileStream = MappedFileStream::Create(Path);
+            if (pFileStream)
+                return pFileStream;
+#endif
             pFileStream = MakeNewRCObj<BasicFileStream>()(Path, EFileAccessMode::Read);
             if (!pFileStream->IsValid())
                 pFileStream.Release();
@@ -90,7 +100,7 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
         return pFileStream;
     };
 
-    RefCntAutoPtr<BasicFileStream> pFileStream;
+    RefCntAutoPtr<IFileStream> pFileStream;
     if (FileSystem::IsPathAbsolute(Name))
     {
         pFileStream = CreateFileStream(Name);
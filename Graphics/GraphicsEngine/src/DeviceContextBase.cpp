@@ -460,10 +460,15 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
 
         CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(Barrier.NewState, true), "invalid new state specified for texture '", TexDesc.Name, "'.");
         OldState = Barrier.OldState != RESOURCE_STATE_UNKNOWN ? Barrier.OldState : pTexture->GetState();
-        CHECK_STATE_TRANSITION_DESC(OldState != RESOURCE_STATE_UNKNOWN,
-                                    "the state of texture '", TexDesc.Name,
-                                    "' is unknown to the engine and is not explicitly specified in the barrier.");
-        CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(OldState, true), "invalid old state specified for texture '", TexDesc.Name, "'.");
+        // The state of a texture whose subresources are in different states is unknown.
+        // The states of individual subresources are verified by the backend.
+        if (OldState != RESOURCE_STATE_UNKNOWN || (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_SUBRESOURCE_STATES) == 0)
+        {
+            CHECK_STATE_TRANSITION_DESC(OldState != RESOURCE_STATE_UNKNOWN,
+                                        "the state of texture '", TexDesc.Name,
+                                        "' is unknown to the engine and is not explicitly specified in the barrier.");
+            CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(OldState, true), "invalid old state specified for texture '", TexDesc.Name, "'.");
+        }
 
         CHECK_STATE_TRANSITION_DESC(Barrier.FirstMipLevel < TexDesc.MipLevels, "first mip level (", Barrier.FirstMipLevel,
                                     ") specified by the barrier is out of range. Texture '",
@@ -768,7 +773,7 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs, const RayTracingPro
 
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pTLAS != nullptr, "pTLAS must not be null.");
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pScratchBuffer != nullptr, "pScratchBuffer must not be null.");
-    CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstances != nullptr, "pInstances must not be null.");
+    CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstances != nullptr || (Attribs.DirtyInstancesOnly && Attribs.InstanceCount == 0), "pInstances must not be null.");
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstanceBuffer != nullptr, "pInstanceBuffer must not be null.");
 
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED || Attribs.HitGroupStride != 0,
@@ -786,13 +791,37 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs, const RayTracingPro
                                  "Update is true, but TLAS created without RAYTRACING_BUILD_AS_ALLOW_UPDATE flag.");
 
         const Uint32 PrevInstanceCount = Attribs.pTLAS->GetBuildInfo().InstanceCount;
-        CHECK_BUILD_TLAS_ATTRIBS(PrevInstanceCount == Attribs.InstanceCount,
-                                 "Update is true, but InstanceCount (", Attribs.InstanceCount, ") does not match the previous value (", PrevInstanceCount, ").");
+        if (Attribs.DirtyInstancesOnly)
+        {
+            CHECK_BUILD_TLAS_ATTRIBS(Attribs.InstanceCount <= PrevInstanceCount,
+                                     "DirtyInstancesOnly is true, but InstanceCount (", Attribs.InstanceCount, ") is greater than the number of instances in the TLAS (", PrevInstanceCount, ").");
+        }
+        else
+        {
+            CHECK_BUILD_TLAS_ATTRIBS(PrevInstanceCount == Attribs.InstanceCount,
+                                     "Update is true, but InstanceCount (", Attribs.InstanceCount, ") does not match the previous value (", PrevInstanceCount, ").");
+        }
+    }
+
+    if (Attribs.DirtyInstancesOnly)
+    {
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.Update, "DirtyInstancesOnly requires Update to be true.");
+
+        const TLASBuildInfo BuildInfo = Attribs.pTLAS->GetBuildInfo();
+        CHECK_BUILD_TLAS_ATTRIBS(BuildInfo.BindingMode == Attribs.BindingMode,
+                                 "DirtyInstancesOnly is true, but BindingMode does not match the previous build.");
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED || BuildInfo.HitGroupStride == Attribs.HitGroupStride,
+                                 "DirtyInstancesOnly is true, but HitGroupStride (", Attribs.HitGroupStride, ") does not match the previous value (", BuildInfo.HitGroupStride, ").");
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED || BuildInfo.FirstContributionToHitGroupIndex == Attribs.BaseContributionToHitGroupIndex,
+                                 "DirtyInstancesOnly is true, but BaseContributionToHitGroupIndex (", Attribs.BaseContributionToHitGroupIndex,
+                                 ") does not match the previous value (", BuildInfo.FirstContributionToHitGroupIndex, ").");
     }
 
-    const auto& InstDesc          = Attribs.pInstanceBuffer->GetDesc();
-    const auto  InstDataSize      = size_t{Attribs.InstanceCount} * size_t{TLAS_INSTANCE_DATA_SIZE};
-    Uint32      AutoOffsetCounter = 0;
+    const auto& InstDesc = Attribs.pInstanceBuffer->GetDesc();
+    // In partial update, the instance buffer must hold all instances of the TLAS
+    const Uint32 TotalInstanceCount = Attribs.DirtyInstancesOnly ? Attribs.pTLAS->GetBuildInfo().InstanceCount : Attribs.InstanceCount;
+    const auto   InstDataSize       = size_t{TotalInstanceCount} * size_t{TLAS_INSTANCE_DATA_SIZE};
+    Uint32       AutoOffsetCounter  = 0;
 
     // Calculate instance data size
     for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
@@ -813,6 +842,15 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs, const RayTracingPro
         {
             const TLASInstanceDesc IDesc = Attribs.pTLAS->GetInstanceDesc(Inst.InstanceName);
             CHECK_BUILD_TLAS_ATTRIBS(IDesc.InstanceIndex != INVALID_INDEX, "Update is true, but pInstances[", i, "].InstanceName does not exists.");
+
+            if (Attribs.DirtyInstancesOnly && Attribs.BindingMode == HIT_GROUP_BINDING_MODE_PER_GEOMETRY && IDesc.pBLAS != nullptr && Inst.pBLAS != nullptr)
+            {
+                // Hit group offsets of the instances that follow are not recalculated
+                CHECK_BUILD_TLAS_ATTRIBS(IDesc.pBLAS->GetActualGeometryCount() == Inst.pBLAS->GetActualGeometryCount(),
+                                         "DirtyInstancesOnly is true and BindingMode is HIT_GROUP_BINDING_MODE_PER_GEOMETRY, but pInstances[", i,
+                                         "].pBLAS has ", Inst.pBLAS->GetActualGeometryCount(), " geometries while the previous BLAS of this instance has ",
+                                         IDesc.pBLAS->GetActualGeometryCount(), ".");
+            }
         }
 
         if (Inst.ContributionToHitGroupIndex == TLAS_INSTANCE_OFFSET_AUTO)
@@ -1340,4 +1378,23 @@ bool VerifyBindSparseResourceMemoryAttribs(const IRenderDevice* pDevice, const B
     return true;
 }
 
+bool VerifyBeginConditionalRenderingAttribs(const BeginConditionalRenderingAttribs& Attribs)
+{
+#define CHECK_CONDITIONAL_RENDERING_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Begin conditional rendering attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS(Attribs.pBuffer != nullptr, "predicate buffer must not be null.");
+    const auto& BuffDesc = Attribs.pBuffer->GetDesc();
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS((BuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                        "predicate buffer '", BuffDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS(BuffDesc.Usage != USAGE_DYNAMIC, "predicate buffer '", BuffDesc.Name, "' must not be a dynamic buffer.");
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS(Attribs.Offset % 8 == 0, "offset (", Attribs.Offset, ") must be a multiple of 8.");
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS(Attribs.Offset + sizeof(Uint64) <= BuffDesc.Size, "invalid offset (", Attribs.Offset,
+                                        ") or predicate buffer '", BuffDesc.Name, "' size must be at least ", Attribs.Offset + sizeof(Uint64), " bytes.");
+    CHECK_CONDITIONAL_RENDERING_ATTRIBS((Attribs.Flags & ~CONDITIONAL_RENDERING_FLAG_INVERTED) == 0, "unknown conditional rendering flags.");
+
+#undef CHECK_CONDITIONAL_RENDERING_ATTRIBS
+
+    return true;
+}
+
 } // namespace Diligent
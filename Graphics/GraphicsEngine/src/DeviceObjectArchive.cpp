@@ -33,6 +33,8 @@
 #include "EngineMemory.h"
 #include "DataBlobImpl.hpp"
 #include "PSOSerializer.hpp"
+#include "Align.hpp"
+#include "LZCompression.hpp"
 
 namespace Diligent
 {
@@ -70,6 +72,14 @@ DeviceObjectArchive::ArchiveHeader::ArchiveHeader() noexcept
 namespace
 {
 
+// Location of the device-specific section in the archive
+struct DeviceSectionInfo
+{
+    Uint32 Offset = 0;
+    Uint32 Size   = 0;
+};
+using DeviceSectionTable = std::array<DeviceSectionInfo, static_cast<size_t>(DeviceObjectArchive::DeviceType::Count)>;
+
 template <SerializerMode Mode>
 struct ArchiveSerializer
 {
@@ -90,7 +100,7 @@ struct ArchiveSerializer
     bool SerializeResourceData(ConstQual<ResourceData>& ResData) const
     {
         if (!Ser.Serialize(ResData.Common))
-            return true;
+            return false;
 
         for (auto& DevData : ResData.DeviceSpecific)
         {
@@ -102,6 +112,11 @@ struct ArchiveSerializer
     }
 
     bool SerializeShaders(ConstQual<ShadersVector>& Shaders) const;
+
+    bool SerializeDeviceSection(ConstQual<DeviceSectionInfo>& Section) const
+    {
+        return Ser(Section.Offset, Section.Size);
+    }
 };
 
 template <SerializerMode Mode>
@@ -157,13 +172,19 @@ void DeviceObjectArchive::Deserialize(const void* pData, size_t Size) noexcept(f
     if (Header.MagicNumber != HeaderMagicNumber)
         LOG_ERROR_AND_THROW("Invalid device object archive header.");
 
-    if (Header.Version != ArchiveVersion)
+    if (Header.Version < MinSupportedArchiveVersion || Header.Version > ArchiveVersion)
         LOG_ERROR_AND_THROW("Unsupported device object archive version: ", Header.Version, ". Expected version: ", Uint32{ArchiveVersion});
 
+    m_SourceVersion = Header.Version;
+
+    // Version 4 archives keep device-specific data next to the common data and are loaded all at once.
+    const auto IsV4Archive = Header.Version == 4;
+
     Uint32 NumResources = 0;
     if (!Reader(NumResources))
         LOG_ERROR_AND_THROW("Failed to read the number of named resources in the device object archive.");
 
+    m_ArchiveResources.reserve(NumResources);
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         const char*  Name    = nullptr;
@@ -176,14 +197,50 @@ void DeviceObjectArchive::Deserialize(const void* pData, size_t Size) noexcept(f
         constexpr auto MakeNameCopy = false;
         auto&          ResData      = m_NamedResources[NamedResourceKey{ResType, Name, MakeNameCopy}];
 
-        if (!ArchiveReader.SerializeResourceData(ResData))
+        const auto Res = IsV4Archive ?
+            ArchiveReader.SerializeResourceData(ResData) :
+            Reader.Serialize(ResData.Common);
+        if (!Res)
             LOG_ERROR_AND_THROW("Failed to read data of resource '", Name, "'.");
+
+        m_ArchiveResources.push_back(&ResData);
     }
 
-    for (auto& Shaders : m_DeviceShaders)
+    if (IsV4Archive)
     {
-        if (!ArchiveReader.SerializeShaders(Shaders))
-            LOG_ERROR_AND_THROW("Failed to read shader data from the device object archive.");
+        for (auto& Shaders : m_DeviceShaders)
+        {
+            if (!ArchiveReader.SerializeShaders(Shaders))
+                LOG_ERROR_AND_THROW("Failed to read shader data from the device object archive.");
+        }
+        return;
+    }
+
+    DeviceSectionTable Sections;
+    for (auto& Section : Sections)
+    {
+        if (!ArchiveReader.SerializeDeviceSection(Section))
+            LOG_ERROR_AND_THROW("Failed to read the device section table from the device object archive.");
+    }
+
+    if (Header.Version >= 6)
+    {
+        if (!Reader(m_ShaderCompression))
+            LOG_ERROR_AND_THROW("Failed to read the shader compression method from the device object archive.");
+        if (m_ShaderCompression >= ShaderCompression::Count)
+            LOG_ERROR_AND_THROW("Unknown shader compression method: ", static_cast<Uint32>(m_ShaderCompression), ". Archive file may be corrupted or invalid.");
+    }
+
+    for (size_t dev = 0; dev < Sections.size(); ++dev)
+    {
+        const auto& Section = Sections[dev];
+        if (Section.Size == 0)
+            continue;
+
+        if (size_t{Section.Offset} + size_t{Section.Size} > Size || (Section.Offset % DeviceSectionAlignment) != 0)
+            LOG_ERROR_AND_THROW("Device section ", dev, " is out of the archive bounds or misaligned. Archive file may be corrupted or invalid.");
+
+        m_DeviceSections[dev] = SerializedData{const_cast<Uint8*>(static_cast<const Uint8*>(pData)) + Section.Offset, Section.Size};
     }
 }
 
@@ -196,7 +253,11 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
     }
     DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    auto SerializeThis = [this](auto& Ser) {
+    LoadAllDeviceData();
+
+    // Note that resources must be written in the same order to the
+    // common data and to every device section.
+    auto SerializeCommonData = [this](auto& Ser, const DeviceSectionTable& Sections) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
         const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
 
@@ -215,25 +276,130 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
             res = Ser(ResType, Name);
             VERIFY(res, "Failed to serialize resource type and name");
 
-            res = ArchiveSer.SerializeResourceData(res_it.second);
-            VERIFY(res, "Failed to serialize resource data");
+            res = Ser.Serialize(res_it.second.Common);
+            VERIFY(res, "Failed to serialize resource common data");
         }
 
-        for (auto& Shaders : m_DeviceShaders)
+        for (const auto& Section : Sections)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            res = ArchiveSer.SerializeDeviceSection(Section);
+            VERIFY(res, "Failed to serialize device section table");
         }
+
+        res = Ser(m_ShaderCompression);
+        VERIFY(res, "Failed to serialize shader compression method");
     };
 
-    Serializer<SerializerMode::Measure> Measurer;
-    SerializeThis(Measurer);
+    // Compress every shader individually so that it can be decompressed on demand.
+    // Shaders that do not compress are stored as is, which is indicated by an empty compressed data.
+    std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> CompressedShaders;
+    if (m_ShaderCompression == ShaderCompression::LZ)
+    {
+        auto&              Allocator = GetRawAllocator();
+        std::vector<Uint8> CompressionBuffer;
+        for (size_t dev = 0; dev < CompressedShaders.size(); ++dev)
+        {
+            const auto& Shaders = m_DeviceShaders[dev];
+            CompressedShaders[dev].resize(Shaders.size());
+            for (size_t i = 0; i < Shaders.size(); ++i)
+            {
+                const auto& Shader = Shaders[i];
+                CompressionBuffer.resize(GetLZCompressedSizeBound(Shader.Size()));
 
-    auto pDataBlob = DataBlobImpl::Create(Measurer.GetSize());
+                const auto CompressedSize = LZCompress(Shader.Ptr(), Shader.Size(), CompressionBuffer.data(), CompressionBuffer.size());
+                if (CompressedSize == 0 || CompressedSize >= Shader.Size())
+                    continue;
 
-    Serializer<SerializerMode::Write> Writer{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
-    SerializeThis(Writer);
-    VERIFY_EXPR(Writer.IsEnded());
+                CompressedShaders[dev][i] = SerializedData{CompressedSize, Allocator};
+                memcpy(CompressedShaders[dev][i].Ptr(), CompressionBuffer.data(), CompressedSize);
+            }
+        }
+    }
+
+    auto SerializeDeviceSection = [this, &CompressedShaders](auto& Ser, size_t dev) {
+        for (const auto& res_it : m_NamedResources)
+        {
+            auto res = Ser.Serialize(res_it.second.DeviceSpecific[dev]);
+            VERIFY(res, "Failed to serialize device-specific resource data");
+        }
+
+        const auto& Shaders    = m_DeviceShaders[dev];
+        Uint32      NumShaders = StaticCast<Uint32>(Shaders.size());
+
+        auto res = Ser(NumShaders);
+        VERIFY(res, "Failed to serialize the number of shaders");
+
+        for (size_t i = 0; i < Shaders.size(); ++i)
+        {
+            const auto* pCompressed = i < CompressedShaders[dev].size() && CompressedShaders[dev][i] ? &CompressedShaders[dev][i] : nullptr;
+
+            Uint32 DecompressedSize = pCompressed != nullptr ? StaticCast<Uint32>(Shaders[i].Size()) : 0;
+            res                     = Ser(DecompressedSize) && Ser.Serialize(pCompressed != nullptr ? *pCompressed : Shaders[i]);
+            VERIFY(res, "Failed to serialize shader data");
+        }
+
+        // Pipeline cache data is optional and is only written when present, so that the section
+        // layout of an archive without the cache data does not depend on how the archive was created.
+        if (const auto& CacheData = m_PipelineCacheData[dev])
+        {
+            res = Ser.Serialize(CacheData);
+            VERIFY(res, "Failed to serialize pipeline cache data");
+        }
+    };
+
+    auto HasDeviceData = [this](size_t dev) {
+        if (!m_DeviceShaders[dev].empty() || m_PipelineCacheData[dev])
+            return true;
+        for (const auto& res_it : m_NamedResources)
+        {
+            if (res_it.second.DeviceSpecific[dev])
+                return true;
+        }
+        return false;
+    };
+
+    DeviceSectionTable Sections;
+
+    Serializer<SerializerMode::Measure> CommonDataMeasurer;
+    SerializeCommonData(CommonDataMeasurer, Sections);
+    const auto CommonDataSize = CommonDataMeasurer.GetSize();
+
+    auto ArchiveSize = CommonDataSize;
+    for (size_t dev = 0; dev < Sections.size(); ++dev)
+    {
+        if (!HasDeviceData(dev))
+            continue;
+
+        Serializer<SerializerMode::Measure> SectionMeasurer;
+        SerializeDeviceSection(SectionMeasurer, dev);
+
+        ArchiveSize = AlignUp(ArchiveSize, DeviceSectionAlignment);
+
+        Sections[dev].Offset = StaticCast<Uint32>(ArchiveSize);
+        Sections[dev].Size   = StaticCast<Uint32>(SectionMeasurer.GetSize());
+        ArchiveSize += SectionMeasurer.GetSize();
+    }
+
+    // Data blob is zero-initialized, so the padding between sections is deterministic
+    auto  pDataBlob    = DataBlobImpl::Create(ArchiveSize);
+    auto* pArchiveData = static_cast<Uint8*>(pDataBlob->GetDataPtr());
+
+    {
+        Serializer<SerializerMode::Write> Writer{SerializedData{pArchiveData, CommonDataSize}};
+        SerializeCommonData(Writer, Sections);
+        VERIFY_EXPR(Writer.IsEnded());
+    }
+
+    for (size_t dev = 0; dev < Sections.size(); ++dev)
+    {
+        const auto& Section = Sections[dev];
+        if (Section.Size == 0)
+            continue;
+
+        Serializer<SerializerMode::Write> Writer{SerializedData{pArchiveData + Section.Offset, Section.Size}};
+        SerializeDeviceSection(Writer, dev);
+        VERIFY_EXPR(Writer.IsEnded());
+    }
 
     *ppDataBlob = pDataBlob.Detach();
 }
@@ -297,26 +463,224 @@ DeviceObjectArchive::DeviceObjectArchive(const IDataBlob* pData, bool MakeCopy)
     if (!m_pArchiveData)
         LOG_ERROR_AND_THROW("pData must not be null");
 
-    Deserialize(pData->GetConstDataPtr(), StaticCast<size_t>(pData->GetSize()));
+    Deserialize(m_pArchiveData->GetConstDataPtr(), StaticCast<size_t>(m_pArchiveData->GetSize()));
+}
+
+void DeviceObjectArchive::LoadDeviceData(DeviceType Dev) const noexcept(false)
+{
+    const auto DevIdx = static_cast<size_t>(Dev);
+    VERIFY_EXPR(DevIdx < m_DeviceSections.size());
+
+    std::call_once(m_DeviceDataLoadFlags[DevIdx], [this, DevIdx]() {
+        const auto& Section = m_DeviceSections[DevIdx];
+        if (!Section)
+            return;
+
+        Serializer<SerializerMode::Read>        Reader{Section};
+        ArchiveSerializer<SerializerMode::Read> ArchiveReader{Reader};
+
+        for (auto* pResData : m_ArchiveResources)
+        {
+            if (!Reader.Serialize(pResData->DeviceSpecific[DevIdx]))
+                LOG_ERROR_AND_THROW("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " resource data from the device object archive.");
+        }
+
+        if (m_SourceVersion < 6)
+        {
+            if (!ArchiveReader.SerializeShaders(m_DeviceShaders[DevIdx]))
+                LOG_ERROR_AND_THROW("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader data from the device object archive.");
+        }
+        else
+        {
+            Uint32 NumShaders = 0;
+            if (!Reader(NumShaders))
+                LOG_ERROR_AND_THROW("Failed to read the number of ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shaders from the device object archive.");
+
+            auto& Shaders = m_DeviceShaders[DevIdx];
+            Shaders.resize(NumShaders);
+
+            auto& CompressedShaders = m_CompressedShaders[DevIdx];
+            if (m_ShaderCompression != ShaderCompression::None)
+                CompressedShaders = std::vector<CompressedShaderData>(NumShaders);
+
+            for (Uint32 i = 0; i < NumShaders; ++i)
+            {
+                Uint32         DecompressedSize = 0;
+                SerializedData Data;
+                if (!Reader(DecompressedSize) || !Reader.Serialize(Data))
+                    LOG_ERROR_AND_THROW("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader ", i, " from the device object archive.");
+
+                if (DecompressedSize == 0)
+                {
+                    Shaders[i] = std::move(Data);
+                }
+                else
+                {
+                    if (i >= CompressedShaders.size())
+                        LOG_ERROR_AND_THROW("Shader ", i, " is compressed, but the archive does not specify the compression method. Archive file may be corrupted or invalid.");
+                    CompressedShaders[i].Data             = std::move(Data);
+                    CompressedShaders[i].DecompressedSize = DecompressedSize;
+                }
+            }
+        }
+
+        // Pipeline cache data is only present if there is remaining data in the section
+        if (m_SourceVersion >= 8 && !Reader.IsEnded())
+        {
+            if (!Reader.Serialize(m_PipelineCacheData[DevIdx]))
+                LOG_ERROR_AND_THROW("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " pipeline cache data from the device object archive.");
+        }
+
+        VERIFY(Reader.IsEnded(), "There should be no other data in the device section");
+    });
+}
+
+void DeviceObjectArchive::DecompressShader(size_t DevIdx, size_t ShaderIdx) const noexcept(false)
+{
+    auto& CompressedShaders = m_CompressedShaders[DevIdx];
+    if (ShaderIdx >= CompressedShaders.size())
+        return;
+
+    auto& Compressed = CompressedShaders[ShaderIdx];
+    std::call_once(Compressed.DecompressFlag, [&]() {
+        if (!Compressed.Data)
+            return; // The shader is stored uncompressed
+
+        VERIFY_EXPR(m_ShaderCompression == ShaderCompression::LZ);
+        SerializedData Decompressed{Compressed.DecompressedSize, GetRawAllocator()};
+        if (!LZDecompress(Compressed.Data.Ptr(), Compressed.Data.Size(), Decompressed.Ptr(), Decompressed.Size()))
+            LOG_ERROR_AND_THROW("Failed to decompress ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader ", ShaderIdx, ". Archive file may be corrupted or invalid.");
+
+        m_DeviceShaders[DevIdx][ShaderIdx] = std::move(Decompressed);
+    });
+}
+
+void DeviceObjectArchive::DecompressShaders(DeviceType Dev) const noexcept(false)
+{
+    LoadDeviceData(Dev);
+
+    const auto DevIdx = static_cast<size_t>(Dev);
+    for (size_t i = 0; i < m_CompressedShaders[DevIdx].size(); ++i)
+        DecompressShader(DevIdx, i);
+}
+
+void DeviceObjectArchive::LoadAllDeviceData() const noexcept(false)
+{
+    for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+        DecompressShaders(static_cast<DeviceType>(dev));
 }
 
 const SerializedData& DeviceObjectArchive::GetDeviceSpecificData(ResourceType Type,
                                                                  const char*  Name,
                                                                  DeviceType   DevType) const noexcept
 {
+    static const SerializedData NullData;
+
     auto it = m_NamedResources.find(NamedResourceKey{Type, Name});
     if (it == m_NamedResources.end())
     {
         LOG_ERROR_MESSAGE("Resource '", Name, "' is not present in the archive");
-        static const SerializedData NullData;
         return NullData;
     }
     VERIFY_EXPR(SafeStrEqual(Name, it->first.GetName()));
+
+    try
+    {
+        LoadDeviceData(DevType);
+    }
+    catch (...)
+    {
+        return NullData;
+    }
+
     return it->second.DeviceSpecific[static_cast<size_t>(DevType)];
 }
 
+DeviceObjectArchive::ResourceData& DeviceObjectArchive::GetResourceData(ResourceType Type, const char* Name) noexcept
+{
+    try
+    {
+        // Make sure that lazily loaded data will not overwrite the changes made by the caller
+        LoadAllDeviceData();
+    }
+    catch (...)
+    {
+    }
+
+    constexpr auto MakeCopy = true;
+    return m_NamedResources[NamedResourceKey{Type, Name, MakeCopy}];
+}
+
+std::vector<SerializedData>& DeviceObjectArchive::GetDeviceShaders(DeviceType Type) noexcept
+{
+    try
+    {
+        DecompressShaders(Type);
+        // All shaders are decompressed, and the caller may now modify the array
+        m_CompressedShaders[static_cast<size_t>(Type)].clear();
+    }
+    catch (...)
+    {
+    }
+
+    return m_DeviceShaders[static_cast<size_t>(Type)];
+}
+
+const SerializedData& DeviceObjectArchive::GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+{
+    static const SerializedData NullData;
+
+    try
+    {
+        LoadDeviceData(Type);
+        DecompressShader(static_cast<size_t>(Type), Idx);
+    }
+    catch (...)
+    {
+        return NullData;
+    }
+
+    const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
+    if (Idx < DeviceShaders.size())
+        return DeviceShaders[Idx];
+
+    return NullData;
+}
+
+const SerializedData& DeviceObjectArchive::GetPipelineCacheData(DeviceType Type) const noexcept
+{
+    static const SerializedData NullData;
+
+    try
+    {
+        LoadDeviceData(Type);
+    }
+    catch (...)
+    {
+        return NullData;
+    }
+
+    return m_PipelineCacheData[static_cast<size_t>(Type)];
+}
+
+void DeviceObjectArchive::SetPipelineCacheData(DeviceType Type, SerializedData&& Data) noexcept
+{
+    try
+    {
+        // Make sure that lazily loaded data will not overwrite the new data
+        LoadDeviceData(Type);
+    }
+    catch (...)
+    {
+    }
+
+    m_PipelineCacheData[static_cast<size_t>(Type)] = std::move(Data);
+}
+
 std::string DeviceObjectArchive::ToString() const
 {
+    LoadAllDeviceData();
+
     std::stringstream Output;
     Output << "Archive contents:\n";
 
@@ -327,7 +691,8 @@ std::string DeviceObjectArchive::ToString() const
     // Print header
     {
         Output << "Header\n"
-               << Ident1 << "version: " << ArchiveVersion << '\n';
+               << Ident1 << "version: " << ArchiveVersion << '\n'
+               << Ident1 << "shader compression: " << (m_ShaderCompression == ShaderCompression::LZ ? "LZ" : "none") << '\n';
     }
 
     constexpr char CommonDataName[] = "Common";
@@ -470,20 +835,57 @@ std::string DeviceObjectArchive::ToString() const
         }
     }
 
+    // Print pipeline cache data, e.g.
+    //
+    //   ------------------
+    //   Pipeline Cache Data
+    //     Metal for iOS 65536 bytes
+    {
+        bool HasCacheData = false;
+        for (const auto& CacheData : m_PipelineCacheData)
+        {
+            if (CacheData)
+                HasCacheData = true;
+        }
+
+        if (HasCacheData)
+        {
+            Output << SeparatorLine
+                   << "Pipeline Cache Data\n";
+            for (Uint32 dev = 0; dev < m_PipelineCacheData.size(); ++dev)
+            {
+                if (const auto& CacheData = m_PipelineCacheData[dev])
+                    Output << Ident1 << ArchiveDeviceTypeToString(dev) << ' ' << CacheData.Size() << " bytes\n";
+            }
+        }
+    }
+
     return Output.str();
 }
 
 
 void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 {
+    // Drop the device section so that it is never loaded
+    m_DeviceSections[static_cast<size_t>(Dev)] = {};
+    LoadDeviceData(Dev);
+
     for (auto& res_it : m_NamedResources)
         res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
     m_DeviceShaders[static_cast<size_t>(Dev)].clear();
+    m_CompressedShaders[static_cast<size_t>(Dev)].clear();
+    m_PipelineCacheData[static_cast<size_t>(Dev)] = {};
 }
 
 void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 {
+    // Existing device data is fully replaced, so there is no need to load it
+    m_DeviceSections[static_cast<size_t>(Dev)] = {};
+    LoadDeviceData(Dev);
+    m_CompressedShaders[static_cast<size_t>(Dev)].clear();
+    Src.DecompressShaders(Dev);
+
     auto& Allocator = GetRawAllocator();
     for (auto& dst_res_it : m_NamedResources)
     {
@@ -506,12 +908,17 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
     DstShaders.clear();
     for (const auto& SrcShader : SrcShaders)
         DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+
+    m_PipelineCacheData[static_cast<size_t>(Dev)] = Src.m_PipelineCacheData[static_cast<size_t>(Dev)].MakeCopy(Allocator);
 }
 
 void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 {
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
+    LoadAllDeviceData();
+    Src.LoadAllDeviceData();
+
     auto&                  Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
@@ -529,6 +936,22 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
             DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
     }
 
+    // Copy pipeline cache data. The data is opaque and can't be merged, so the existing data is kept.
+    for (size_t i = 0; i < m_PipelineCacheData.size(); ++i)
+    {
+        const auto& SrcCacheData = Src.m_PipelineCacheData[i];
+        if (!SrcCacheData)
+            continue;
+
+        if (m_PipelineCacheData[i])
+        {
+            LOG_WARNING_MESSAGE(ArchiveDeviceTypeToString(static_cast<Uint32>(i)), " pipeline cache data is present in both archives. "
+                                "The data from the source archive is ignored.");
+            continue;
+        }
+        m_PipelineCacheData[i] = SrcCacheData.MakeCopy(Allocator);
+    }
+
     // Copy named resources
     for (auto& src_res_it : Src.m_NamedResources)
     {
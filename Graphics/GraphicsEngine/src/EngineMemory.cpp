@@ -31,14 +31,16 @@
 
 #include "EngineMemory.h"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
 #include "DebugUtilities.hpp"
 
 namespace Diligent
 {
 
-static IMemoryAllocator* g_pRawAllocator;
+static IMemoryAllocator*        g_pRawAllocator;
+static TrackingMemoryAllocator* g_pTrackingAllocator;
 
-void SetRawAllocator(IMemoryAllocator* pRawAllocator)
+void SetRawAllocator(IMemoryAllocator* pRawAllocator, bool EnableTracking)
 {
     if (pRawAllocator == nullptr)
     {
@@ -46,9 +48,26 @@ void SetRawAllocator(IMemoryAllocator* pRawAllocator)
         pRawAllocator = &DefaultRawMemoryAllocator::GetAllocator();
     }
 
-    DEV_CHECK_ERR(g_pRawAllocator == nullptr || g_pRawAllocator == pRawAllocator,
-                  "User-defined allocator has already been provided and does not match the new allocator. "
-                  "This may result in undefined behavior.");
+    if (g_pRawAllocator != nullptr)
+    {
+        IMemoryAllocator* pCurrBackend = g_pTrackingAllocator != nullptr ? &g_pTrackingAllocator->GetBackend() : g_pRawAllocator;
+        DEV_CHECK_ERR(pCurrBackend == pRawAllocator,
+                      "User-defined allocator has already been provided and does not match the new allocator. "
+                      "This may result in undefined behavior.");
+        if (EnableTracking != (g_pTrackingAllocator != nullptr))
+        {
+            LOG_WARNING_MESSAGE("Memory tracking is ", (g_pTrackingAllocator != nullptr ? "enabled" : "disabled"),
+                                " by the first device and can't be changed. EngineCreateInfo::EnableMemoryTracking is ignored.");
+        }
+        return;
+    }
+
+    if (EnableTracking)
+    {
+        // The allocator must outlive all objects, so it is never destroyed.
+        g_pTrackingAllocator = new TrackingMemoryAllocator{*pRawAllocator};
+        pRawAllocator        = g_pTrackingAllocator;
+    }
 
     g_pRawAllocator = pRawAllocator;
 }
@@ -58,6 +77,11 @@ IMemoryAllocator& GetRawAllocator()
     return g_pRawAllocator != nullptr ? *g_pRawAllocator : DefaultRawMemoryAllocator::GetAllocator();
 }
 
+TrackingMemoryAllocator* GetTrackingRawAllocator()
+{
+    return g_pTrackingAllocator;
+}
+
 IMemoryAllocator& GetStringAllocator()
 {
     return GetRawAllocator();
@@ -0,0 +1,258 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FenceCompletionWaiter.hpp"
+
+#include <chrono>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Interval at which the default implementation of WaitForAnyFence() polls the fences
+constexpr std::chrono::milliseconds FencePollInterval{1};
+
+} // namespace
+
+FenceCompletionWaiter::FenceCompletionWaiter(bool UseThread) noexcept :
+    m_UseThread{UseThread}
+{
+}
+
+FenceCompletionWaiter::~FenceCompletionWaiter()
+{
+    VERIFY(!m_Thread.joinable(), "The waiter thread must be stopped by the derived class destructor");
+    StopThread();
+
+    if (!m_Fences.empty())
+    {
+        LOG_WARNING_MESSAGE(GetNumPendingCallbacks(), " fence completion callback(s) have never been invoked");
+    }
+}
+
+void FenceCompletionWaiter::EnqueueCallback(IFence* pFence, Uint64 Value, FenceCompletionCallbackType Callback, void* pUserData)
+{
+    DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+    DEV_CHECK_ERR(Callback != nullptr, "Callback must not be null");
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    FenceEntry& Entry = m_Fences[pFence];
+    Entry.Callbacks.emplace(Value, CallbackInfo{Callback, pUserData});
+
+    if (!m_UseThread)
+        return;
+
+    if (!m_Thread.joinable() && !m_StopThread)
+    {
+        m_Thread = std::thread{&FenceCompletionWaiter::ThreadFunc, this};
+    }
+    else if (Entry.Callbacks.begin()->first == Value)
+    {
+        // The thread may be waiting for a greater value or not waiting for this fence at all
+        WakeUp(++m_WakeCounter);
+    }
+    m_ThreadCV.notify_one();
+}
+
+void FenceCompletionWaiter::UnregisterFence(IFence* pFence)
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Fences.find(pFence);
+    if (it == m_Fences.end())
+        return;
+
+    if (!it->second.Callbacks.empty())
+    {
+        LOG_WARNING_MESSAGE("Fence is being destroyed with ", it->second.Callbacks.size(),
+                            " pending completion callback(s). The callbacks will never be invoked.");
+    }
+    m_Fences.erase(it);
+
+    // Entries are only removed under the mutex, so if the fence was not found above,
+    // no thread can be using it. Otherwise, wait until the fence is no longer used.
+    if (m_BusyCount > 0)
+    {
+        VERIFY(m_Thread.get_id() != std::this_thread::get_id(),
+               "Fences can't be destroyed by the waiter thread while the fences are being waited for");
+        WakeUp(++m_WakeCounter);
+        m_IdleCV.wait(Lock, [this]() { return m_BusyCount == 0; });
+    }
+}
+
+void FenceCompletionWaiter::ProcessCompletedFences()
+{
+    std::vector<std::pair<IFence*, Uint64>> Fences;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_Fences.empty())
+            return;
+
+        Fences.reserve(m_Fences.size());
+        for (const auto& it : m_Fences)
+        {
+            if (!it.second.Callbacks.empty())
+                Fences.emplace_back(it.first, it.second.Callbacks.begin()->first);
+        }
+        ++m_BusyCount;
+    }
+
+    // Query the fences outside of the mutex: the fences may not be destroyed
+    // until m_BusyCount drops to zero.
+    size_t NumCompleted = 0;
+    for (const auto& Fence : Fences)
+    {
+        const Uint64 CompletedValue = Fence.first->GetCompletedValue();
+        if (CompletedValue >= Fence.second)
+            Fences[NumCompleted++] = {Fence.first, CompletedValue};
+    }
+    Fences.resize(NumCompleted);
+
+    std::vector<std::pair<CallbackInfo, Uint64>> ReadyCallbacks;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        for (const auto& Fence : Fences)
+        {
+            auto it = m_Fences.find(Fence.first);
+            if (it == m_Fences.end())
+                continue; // The fence was unregistered
+
+            auto& Callbacks = it->second.Callbacks;
+            auto  end       = Callbacks.upper_bound(Fence.second);
+            for (auto cb_it = Callbacks.begin(); cb_it != end; ++cb_it)
+                ReadyCallbacks.emplace_back(cb_it->second, Fence.second);
+            Callbacks.erase(Callbacks.begin(), end);
+            if (Callbacks.empty())
+                m_Fences.erase(it);
+        }
+
+        VERIFY_EXPR(m_BusyCount > 0);
+        if (--m_BusyCount == 0)
+            m_IdleCV.notify_all();
+    }
+
+    // Invoke the callbacks without holding the mutex and without accessing
+    // the fences as a callback may enqueue other callbacks or release a fence.
+    for (const auto& cb : ReadyCallbacks)
+        cb.first.Callback(cb.second, cb.first.pUserData);
+}
+
+void FenceCompletionWaiter::StopThread()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_StopThread)
+            return;
+        m_StopThread = true;
+        if (m_Thread.joinable())
+            WakeUp(++m_WakeCounter);
+        m_ThreadCV.notify_one();
+    }
+
+    if (m_Thread.joinable())
+    {
+        if (m_Thread.get_id() != std::this_thread::get_id())
+        {
+            m_Thread.join();
+        }
+        else
+        {
+            UNEXPECTED("The render device must not be released by a fence completion callback");
+            m_Thread.detach();
+        }
+    }
+}
+
+size_t FenceCompletionWaiter::GetNumPendingCallbacks() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    size_t NumCallbacks = 0;
+    for (const auto& it : m_Fences)
+        NumCallbacks += it.second.Callbacks.size();
+    return NumCallbacks;
+}
+
+void FenceCompletionWaiter::WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter)
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_WakeCV.wait_for(Lock, FencePollInterval, [&]() { return m_WakeCounter != WakeCounter; });
+}
+
+void FenceCompletionWaiter::WakeUp(Uint64 WakeCounter)
+{
+    m_WakeCV.notify_all();
+}
+
+void FenceCompletionWaiter::ThreadFunc()
+{
+    std::vector<WaitItem> Items;
+    while (true)
+    {
+        Uint64 WakeCounter = 0;
+        {
+            std::unique_lock<std::mutex> Lock{m_Mtx};
+            m_ThreadCV.wait(Lock, [this]() { return m_StopThread || !m_Fences.empty(); });
+            if (m_StopThread)
+                break;
+
+            Items.clear();
+            for (const auto& it : m_Fences)
+            {
+                if (!it.second.Callbacks.empty())
+                    Items.push_back({it.first, it.second.Callbacks.begin()->first, it.second.ArmedValue});
+            }
+            WakeCounter = m_WakeCounter;
+            ++m_BusyCount;
+        }
+
+        WaitForAnyFence(Items, WakeCounter);
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            for (const auto& Item : Items)
+            {
+                auto it = m_Fences.find(Item.pFence);
+                if (it != m_Fences.end())
+                    it->second.ArmedValue = Item.ArmedValue;
+            }
+
+            VERIFY_EXPR(m_BusyCount > 0);
+            if (--m_BusyCount == 0)
+                m_IdleCV.notify_all();
+        }
+
+        ProcessCompletedFences();
+    }
+}
+
+} // namespace Diligent
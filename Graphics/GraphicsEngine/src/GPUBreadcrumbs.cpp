@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUBreadcrumbs.hpp"
+
+#include <sstream>
+
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Returns true if marker A was recorded before or at the same time as marker B,
+// taking the wrap-around into account.
+bool IsBeforeOrEqual(Uint32 A, Uint32 B)
+{
+    return static_cast<Uint32>(B - A) < 0x80000000u;
+}
+
+Uint32 NextMarker(Uint32 Marker)
+{
+    return Marker != ~Uint32{0} ? Marker + 1 : 1;
+}
+
+// Number of the completed and not started commands shown around the commands in flight
+constexpr Uint32 ReportContextSize = 8;
+
+// Maximum number of the commands in the report
+constexpr Uint32 MaxReportCommands = 64;
+
+} // namespace
+
+GPUBreadcrumbs::GPUBreadcrumbs(Uint32 Capacity) :
+    m_Capacity{Capacity},
+    m_Records(Capacity),
+    m_GroupPaths{1},
+    m_GroupStack{0}
+{
+    VERIFY(IsPowerOfTwo(Capacity), "Capacity (", Capacity, ") must be a power of two");
+}
+
+Uint32 GPUBreadcrumbs::BeginDebugGroup(const char* Name)
+{
+    std::string Path = m_GroupPaths[m_GroupStack.back()];
+    if (!Path.empty())
+        Path += '/';
+    Path += Name != nullptr ? Name : "<unnamed>";
+
+    auto it = m_GroupIds.find(Path);
+    if (it == m_GroupIds.end())
+    {
+        const Uint32 GroupId = static_cast<Uint32>(m_GroupPaths.size());
+        m_GroupPaths.emplace_back(Path);
+        it = m_GroupIds.emplace(std::move(Path), GroupId).first;
+    }
+    m_GroupStack.push_back(it->second);
+
+    return AddCommand("BeginDebugGroup");
+}
+
+Uint32 GPUBreadcrumbs::EndDebugGroup()
+{
+    const Uint32 Marker = AddCommand("EndDebugGroup");
+    if (m_GroupStack.size() > 1)
+        m_GroupStack.pop_back();
+    else
+        UNEXPECTED("There is no debug group to end");
+    return Marker;
+}
+
+std::string GPUBreadcrumbs::GetReport(Uint32 LastStartedMarker, Uint32 LastCompletedMarker) const
+{
+    std::stringstream ss;
+    ss << "Last recorded command: " << m_LastMarker
+       << ", last started command: " << LastStartedMarker
+       << ", last completed command: " << LastCompletedMarker << '.';
+    if (m_LastMarker == 0)
+        return ss.str();
+
+    if (LastCompletedMarker != 0 && LastStartedMarker != 0 && IsBeforeOrEqual(LastStartedMarker, LastCompletedMarker))
+        LastStartedMarker = LastCompletedMarker;
+
+    // The oldest command that is still in the history
+    Uint32 First = m_LastMarker >= m_Capacity ? m_LastMarker - m_Capacity + 1 : 1;
+    if (LastCompletedMarker != 0 && IsBeforeOrEqual(First, LastCompletedMarker) && IsBeforeOrEqual(LastCompletedMarker, m_LastMarker))
+    {
+        const Uint32 ContextStart = LastCompletedMarker > ReportContextSize ? LastCompletedMarker - ReportContextSize + 1 : 1;
+        if (IsBeforeOrEqual(First, ContextStart))
+            First = ContextStart;
+    }
+
+    Uint32 Last = m_LastMarker;
+    {
+        const Uint32 Bound = LastStartedMarker != 0 ? LastStartedMarker : LastCompletedMarker;
+        if (IsBeforeOrEqual(Bound, m_LastMarker) && static_cast<Uint32>(m_LastMarker - Bound) > ReportContextSize)
+            Last = Bound + ReportContextSize;
+    }
+
+    Uint32 NumCommands = 0;
+    for (Uint32 Marker = First;; Marker = NextMarker(Marker))
+    {
+        const Record& Rec = m_Records[Marker & (m_Capacity - 1)];
+        if (Rec.Marker == Marker)
+        {
+            if (NumCommands++ == MaxReportCommands)
+            {
+                ss << "\n  ...";
+                break;
+            }
+
+            const char* Status = "not started";
+            if (LastCompletedMarker != 0 && IsBeforeOrEqual(Marker, LastCompletedMarker))
+                Status = "completed";
+            else if (LastStartedMarker != 0 && IsBeforeOrEqual(Marker, LastStartedMarker))
+                Status = "in flight";
+
+            ss << "\n  #" << Marker << " [" << Status << "] " << Rec.Name;
+            const std::string& Group = m_GroupPaths[Rec.Group];
+            if (!Group.empty())
+                ss << " (" << Group << ')';
+        }
+
+        if (Marker == Last)
+            break;
+    }
+
+    return ss.str();
+}
+
+} // namespace Diligent
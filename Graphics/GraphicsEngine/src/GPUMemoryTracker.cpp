@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUMemoryTracker.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The number of the largest allocations listed in the report
+constexpr size_t NumReportedAllocations = 32;
+
+std::ostream& PrintMB(std::ostream& os, Uint64 Size, int Width)
+{
+    return os << std::setw(Width) << std::fixed << std::setprecision(2) << static_cast<double>(Size) / double{1 << 20};
+}
+
+} // namespace
+
+constexpr GPUMemoryTracker::AllocationId GPUMemoryTracker::InvalidAllocationId;
+
+GPUMemoryTracker::GPUMemoryTracker() noexcept
+{
+}
+
+void GPUMemoryTracker::AddUsage(GPUMemoryUsage& Usage, const Allocation& Alloc)
+{
+    Usage.Size += Alloc.Size;
+    Usage.AllocatedSize += Alloc.AllocatedSize;
+    Usage.PeakAllocatedSize = std::max(Usage.PeakAllocatedSize, Usage.AllocatedSize);
+    ++Usage.Count;
+}
+
+void GPUMemoryTracker::RemoveUsage(GPUMemoryUsage& Usage, const Allocation& Alloc)
+{
+    VERIFY_EXPR(Usage.Size >= Alloc.Size && Usage.AllocatedSize >= Alloc.AllocatedSize && Usage.Count > 0);
+    Usage.Size -= Alloc.Size;
+    Usage.AllocatedSize -= Alloc.AllocatedSize;
+    --Usage.Count;
+}
+
+GPUMemoryTracker::AllocationId GPUMemoryTracker::AddAllocation(GPU_MEMORY_CATEGORY        Category,
+                                                               GPU_MEMORY_ALLOCATION_TYPE Type,
+                                                               const char*                Name,
+                                                               Uint64                     Size,
+                                                               Uint64                     AllocatedSize)
+{
+    VERIFY_EXPR(Category < GPU_MEMORY_CATEGORY_COUNT && Type < GPU_MEMORY_ALLOCATION_TYPE_COUNT);
+    VERIFY(Type != GPU_MEMORY_ALLOCATION_TYPE_PLACED || AllocatedSize == 0, "Placed allocations must not report allocated size");
+
+    Allocation Alloc{Category, Type, Name != nullptr ? Name : "", Size, AllocatedSize};
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    AddUsage(m_Stats.Categories[Category], Alloc);
+    AddUsage(m_Stats.Types[Type], Alloc);
+
+    const auto Id = m_NextId++;
+    m_Allocations.emplace(Id, std::move(Alloc));
+    return Id;
+}
+
+void GPUMemoryTracker::RemoveAllocation(AllocationId Id)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Allocations.find(Id);
+    if (it == m_Allocations.end())
+    {
+        UNEXPECTED("Allocation ", Id, " is not found");
+        return;
+    }
+
+    const auto& Alloc = it->second;
+    RemoveUsage(m_Stats.Categories[Alloc.Category], Alloc);
+    RemoveUsage(m_Stats.Types[Alloc.Type], Alloc);
+    m_Allocations.erase(it);
+}
+
+void GPUMemoryTracker::GetStatistics(GPUMemoryStatistics& Stats) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    Stats = m_Stats;
+}
+
+Uint32 GPUMemoryTracker::GetAllocations(GPUMemoryAllocationInfo* pAllocations, Uint32 MaxAllocations) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto NumAllocations = static_cast<Uint32>(m_Allocations.size());
+    if (pAllocations == nullptr || MaxAllocations == 0)
+        return NumAllocations;
+
+    std::vector<const Allocation*> SortedAllocations;
+    SortedAllocations.reserve(m_Allocations.size());
+    for (const auto& it : m_Allocations)
+        SortedAllocations.push_back(&it.second);
+
+    const auto NumReturned = std::min(MaxAllocations, NumAllocations);
+    std::partial_sort(SortedAllocations.begin(), SortedAllocations.begin() + NumReturned, SortedAllocations.end(),
+                      [](const Allocation* lhs, const Allocation* rhs) {
+                          if (lhs->AllocatedSize != rhs->AllocatedSize)
+                              return lhs->AllocatedSize > rhs->AllocatedSize;
+                          return lhs->Size > rhs->Size;
+                      });
+
+    for (Uint32 i = 0; i < NumReturned; ++i)
+    {
+        const auto& Src = *SortedAllocations[i];
+        auto&       Dst = pAllocations[i];
+
+        Dst = {};
+        strncpy(Dst.Name, Src.Name.c_str(), sizeof(Dst.Name) - 1);
+        Dst.Category      = Src.Category;
+        Dst.Type          = Src.Type;
+        Dst.Size          = Src.Size;
+        Dst.AllocatedSize = Src.AllocatedSize;
+    }
+
+    return NumAllocations;
+}
+
+std::string GPUMemoryTracker::GetReport() const
+{
+    GPUMemoryStatistics Stats;
+    GetStatistics(Stats);
+
+    std::vector<GPUMemoryAllocationInfo> Allocations(NumReportedAllocations);
+    Allocations.resize(std::min<size_t>(GetAllocations(Allocations.data(), static_cast<Uint32>(Allocations.size())), Allocations.size()));
+
+    std::stringstream ss;
+
+    const auto PrintUsage = [&ss](const char* Name, const GPUMemoryUsage& Usage) {
+        ss << std::left << std::setw(24) << Name << std::right << std::setw(8) << Usage.Count;
+        PrintMB(ss, Usage.Size, 12);
+        PrintMB(ss, Usage.AllocatedSize, 12);
+        // Placed allocations don't occupy memory of their own, so the allocated size may be smaller than the requested size
+        PrintMB(ss, Usage.AllocatedSize > Usage.Size ? Usage.AllocatedSize - Usage.Size : 0, 12);
+        PrintMB(ss, Usage.PeakAllocatedSize, 12);
+        ss << '\n';
+    };
+    const auto PrintHeader = [&ss](const char* Title) {
+        ss << std::left << std::setw(24) << Title << std::right
+           << std::setw(8) << "Count"
+           << std::setw(12) << "Size, MB"
+           << std::setw(12) << "Alloc, MB"
+           << std::setw(12) << "Overhd, MB"
+           << std::setw(12) << "Peak, MB"
+           << '\n';
+    };
+
+    ss << "GPU memory report\n\n";
+
+    PrintHeader("Category");
+    for (Uint32 Category = 0; Category < GPU_MEMORY_CATEGORY_COUNT; ++Category)
+        PrintUsage(GetGPUMemoryCategoryString(static_cast<GPU_MEMORY_CATEGORY>(Category)), Stats.Categories[Category]);
+    ss << '\n';
+
+    PrintHeader("Allocation type");
+    for (Uint32 Type = 0; Type < GPU_MEMORY_ALLOCATION_TYPE_COUNT; ++Type)
+        PrintUsage(GetGPUMemoryAllocationTypeString(static_cast<GPU_MEMORY_ALLOCATION_TYPE>(Type)), Stats.Types[Type]);
+    ss << '\n';
+
+    const auto& Committed    = Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_COMMITTED];
+    const auto& Suballocated = Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED];
+    const auto& Pools        = Stats.Categories[GPU_MEMORY_CATEGORY_MEMORY_POOL];
+
+    ss << "Memory allocated from the driver (MB): ";
+    PrintMB(ss, Committed.AllocatedSize, 0) << '\n';
+    ss << "Memory pools (MB): ";
+    PrintMB(ss, Pools.AllocatedSize, 0) << ", suballocated: ";
+    PrintMB(ss, Suballocated.AllocatedSize, 0) << ", unused: ";
+    PrintMB(ss, Pools.AllocatedSize > Suballocated.AllocatedSize ? Pools.AllocatedSize - Suballocated.AllocatedSize : 0, 0) << '\n';
+    ss << '\n';
+
+    ss << "Largest allocations\n";
+    for (const auto& Alloc : Allocations)
+    {
+        PrintMB(ss, Alloc.AllocatedSize, 10) << " MB  ";
+        ss << std::left << std::setw(24) << GetGPUMemoryCategoryString(Alloc.Category)
+           << std::setw(14) << GetGPUMemoryAllocationTypeString(Alloc.Type)
+           << '\'' << Alloc.Name << "' (" << Alloc.Size << " bytes requested)" << std::right << '\n';
+    }
+
+    return ss.str();
+}
+
+} // namespace Diligent
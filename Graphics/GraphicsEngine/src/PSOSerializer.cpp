@@ -459,6 +459,13 @@ bool PSOSerializer<Mode>::SerializeAuxData(Serializer<Mode>&                Ser,
     ASSERT_SIZEOF(SerializedPSOAuxData, 1, "Did you add a new member to SerializedPSOAuxData? Please add serialization here.");
 }
 
+template <SerializerMode Mode>
+bool PSOSerializer<Mode>::SerializeDynamicStateFlags(Serializer<Mode>&                        Ser,
+                                                     ConstQual<PIPELINE_DYNAMIC_STATE_FLAGS>& DynamicStateFlags)
+{
+    return Ser(DynamicStateFlags);
+}
+
 template <SerializerMode Mode>
 bool ShaderSerializer<Mode>::SerializeBytecodeOrSource(Serializer<Mode>&            Ser,
                                                        ConstQual<ShaderCreateInfo>& CI)
@@ -512,6 +519,21 @@ bool ShaderSerializer<Mode>::SerializeCI(Serializer<Mode>&            Ser,
     return SerializeBytecodeOrSource(Ser, CI);
 }
 
+template <SerializerMode Mode>
+bool ShaderSerializer<Mode>::SerializeReflection(Serializer<Mode>&          Ser,
+                                                 ConstQual<SerializedData>& Reflection)
+{
+    return !Reflection || Ser.Serialize(Reflection);
+}
+
+template <>
+bool ShaderSerializer<SerializerMode::Read>::SerializeReflection(Serializer<SerializerMode::Read>& Ser,
+                                                                 ConstQual<SerializedData>&        Reflection)
+{
+    // Reflection data is optional
+    return Ser.IsEnded() || Ser.Serialize(Reflection);
+}
+
 template struct PSOSerializer<SerializerMode::Read>;
 template struct PSOSerializer<SerializerMode::Write>;
 template struct PSOSerializer<SerializerMode::Measure>;
@@ -143,6 +143,40 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
             LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain GENERAL_INPUT_ATTACHMENT which is only valid in Vulkan");
         }
 
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+        {
+            if (DeviceInfo.Type != RENDER_DEVICE_TYPE_UNDEFINED && // May be UNDEFINED for serialized signature
+                DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain BINDLESS which is only valid in Direct3D12");
+            }
+
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY) != 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags contain both BINDLESS and RUNTIME_ARRAY flags, which is not allowed.");
+            }
+        }
+
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+        {
+            if (Res.Flags != PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].Flags (", GetPipelineResourceFlagsString(Res.Flags),
+                                        ") contain INLINE_CONSTANTS flag, which can't be combined with other flags.");
+            }
+
+            if (Res.ArraySize > MAX_INLINE_CONSTANTS)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "].ArraySize (", Res.ArraySize,
+                                        ") defines the number of inline constants, which must not exceed ", MAX_INLINE_CONSTANTS, ".");
+            }
+
+            if (Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "] uses INLINE_CONSTANTS flag, which is not allowed for static variables.");
+            }
+        }
+
         Resources.emplace(Res.Name, Res);
 
         // NB: when creating immutable sampler array, we have to define the sampler as both resource and
@@ -642,6 +642,16 @@ void ValidateGraphicsPipelineCreateInfo(const GraphicsPipelineStateCreateInfo& C
         if (!Features.VariableRateShading)
             LOG_PSO_ERROR_AND_THROW("ShadingRateFlags (", GetPipelineShadingRateFlagsString(CreateInfo.GraphicsPipeline.ShadingRateFlags), ") require VariableRateShading feature");
     }
+
+    if (CreateInfo.GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+    {
+        if (!Features.DynamicPipelineStates)
+            LOG_PSO_ERROR_AND_THROW("DynamicStateFlags (", GetPipelineDynamicStateFlagsString(CreateInfo.GraphicsPipeline.DynamicStateFlags), ") require DynamicPipelineStates feature");
+
+        if ((CreateInfo.GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0 &&
+            CreateInfo.GraphicsPipeline.PrimitiveTopology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST)
+            LOG_PSO_ERROR_AND_THROW("Patch list topologies can't be dynamic");
+    }
 }
 
 void ValidateComputePipelineCreateInfo(const ComputePipelineStateCreateInfo& CreateInfo,
@@ -772,6 +782,40 @@ void ValidateTilePipelineCreateInfo(const TilePipelineStateCreateInfo& CreateInf
     VALIDATE_SHADER_TYPE(CreateInfo.pTS, SHADER_TYPE_TILE, "tile")
 }
 
+void ValidateWorkGraphPipelineCreateInfo(const WorkGraphPipelineStateCreateInfo& CreateInfo,
+                                         const IRenderDevice*                    pDevice) noexcept(false)
+{
+    VERIFY_EXPR(pDevice != nullptr);
+    const auto& Features = pDevice->GetDeviceInfo().Features;
+
+    const auto& PSODesc = CreateInfo.PSODesc;
+    if (PSODesc.PipelineType != PIPELINE_TYPE_WORK_GRAPH)
+        LOG_PSO_ERROR_AND_THROW("Pipeline type must be WORK_GRAPH.");
+
+    if (!Features.WorkGraphs)
+        LOG_PSO_ERROR_AND_THROW("Work graphs are not supported by this device.");
+
+    ValidatePipelineResourceSignatures(CreateInfo, pDevice);
+    ValidatePipelineResourceLayoutDesc(PSODesc, Features);
+
+    if (CreateInfo.ShaderCount == 0)
+        LOG_PSO_ERROR_AND_THROW("ShaderCount must not be zero.");
+
+    if (CreateInfo.ppShaders == nullptr)
+        LOG_PSO_ERROR_AND_THROW("ppShaders must not be null.");
+
+    if (IsNullOrEmptyStr(CreateInfo.ProgramName) && IsNullOrEmptyStr(PSODesc.Name))
+        LOG_PSO_ERROR_AND_THROW("ProgramName must not be empty when the pipeline has no name.");
+
+    for (Uint32 i = 0; i < CreateInfo.ShaderCount; ++i)
+    {
+        if (CreateInfo.ppShaders[i] == nullptr)
+            LOG_PSO_ERROR_AND_THROW("ppShaders[", i, "] must not be null.");
+
+        VALIDATE_SHADER_TYPE(CreateInfo.ppShaders[i], SHADER_TYPE_WORK_GRAPH, "work graph")
+    }
+}
+
 } // namespace
 
 void CopyRTShaderGroupNames(std::unordered_map<HashMapStringKey, Uint32>& NameToGroupIndex,
@@ -937,4 +981,202 @@ void ValidatePSOCreateInfo<TilePipelineStateCreateInfo>(const IRenderDevice*
     ValidateTilePipelineCreateInfo(CreateInfo, pDevice);
 }
 
+template <>
+void ValidatePSOCreateInfo<WorkGraphPipelineStateCreateInfo>(const IRenderDevice*                    pDevice,
+                                                             const WorkGraphPipelineStateCreateInfo& CreateInfo) noexcept(false)
+{
+    VERIFY_EXPR(pDevice != nullptr);
+    ValidateWorkGraphPipelineCreateInfo(CreateInfo, pDevice);
+}
+
+void GetPipelineShaders(const GraphicsPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders)
+{
+    for (auto* pShader : {CreateInfo.pVS, CreateInfo.pPS, CreateInfo.pDS, CreateInfo.pHS, CreateInfo.pGS, CreateInfo.pAS, CreateInfo.pMS})
+    {
+        if (pShader != nullptr)
+            Shaders.push_back(pShader);
+    }
+}
+
+void GetPipelineShaders(const ComputePipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders)
+{
+    if (CreateInfo.pCS != nullptr)
+        Shaders.push_back(CreateInfo.pCS);
+}
+
+void GetPipelineShaders(const RayTracingPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders)
+{
+    std::unordered_set<IShader*> UniqueShaders;
+
+    auto AddShader = [&](IShader* pShader) {
+        if (pShader != nullptr && UniqueShaders.insert(pShader).second)
+            Shaders.push_back(pShader);
+    };
+
+    for (Uint32 i = 0; i < CreateInfo.GeneralShaderCount; ++i)
+    {
+        AddShader(CreateInfo.pGeneralShaders[i].pShader);
+    }
+    for (Uint32 i = 0; i < CreateInfo.TriangleHitShaderCount; ++i)
+    {
+        AddShader(CreateInfo.pTriangleHitShaders[i].pClosestHitShader);
+        AddShader(CreateInfo.pTriangleHitShaders[i].pAnyHitShader);
+    }
+    for (Uint32 i = 0; i < CreateInfo.ProceduralHitShaderCount; ++i)
+    {
+        AddShader(CreateInfo.pProceduralHitShaders[i].pIntersectionShader);
+        AddShader(CreateInfo.pProceduralHitShaders[i].pClosestHitShader);
+        AddShader(CreateInfo.pProceduralHitShaders[i].pAnyHitShader);
+    }
+}
+
+void GetPipelineShaders(const TilePipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders)
+{
+    if (CreateInfo.pTS != nullptr)
+        Shaders.push_back(CreateInfo.pTS);
+}
+
+void GetPipelineShaders(const WorkGraphPipelineStateCreateInfo& CreateInfo, std::vector<IShader*>& Shaders)
+{
+    std::unordered_set<IShader*> UniqueShaders;
+    for (Uint32 i = 0; i < CreateInfo.ShaderCount; ++i)
+    {
+        IShader* pShader = CreateInfo.ppShaders[i];
+        if (pShader != nullptr && UniqueShaders.insert(pShader).second)
+            Shaders.push_back(pShader);
+    }
+}
+
+namespace
+{
+
+void ReserveSpaceForPSOCreateInfo(const PipelineStateCreateInfo& CI, FixedLinearAllocator& Allocator)
+{
+    Allocator.AddSpaceForString(CI.PSODesc.Name);
+
+    const auto& ResLayout = CI.PSODesc.ResourceLayout;
+    if (ResLayout.Variables != nullptr)
+    {
+        Allocator.AddSpace<ShaderResourceVariableDesc>(ResLayout.NumVariables);
+        for (Uint32 i = 0; i < ResLayout.NumVariables; ++i)
+            Allocator.AddSpaceForString(ResLayout.Variables[i].Name);
+    }
+
+    if (ResLayout.ImmutableSamplers != nullptr)
+    {
+        Allocator.AddSpace<ImmutableSamplerDesc>(ResLayout.NumImmutableSamplers);
+        for (Uint32 i = 0; i < ResLayout.NumImmutableSamplers; ++i)
+        {
+            Allocator.AddSpaceForString(ResLayout.ImmutableSamplers[i].SamplerOrTextureName);
+            Allocator.AddSpaceForString(ResLayout.ImmutableSamplers[i].Desc.Name);
+        }
+    }
+
+    if (CI.ppResourceSignatures != nullptr)
+        Allocator.AddSpace<IPipelineResourceSignature*>(CI.ResourceSignaturesCount);
+
+    if (CI.pInternalData != nullptr)
+        Allocator.AddSpace<PSOCreateInternalInfo>();
+}
+
+// Copies the data referenced by the pipeline state create info into the memory owned by the allocator.
+// Dst is expected to be a shallow copy of Src.
+void CopyPSOCreateInfo(const PipelineStateCreateInfo&       Src,
+                       PipelineStateCreateInfo&             Dst,
+                       FixedLinearAllocator&                Allocator,
+                       std::vector<RefCntAutoPtr<IObject>>& Objects)
+{
+    Dst.PSODesc.Name = Allocator.CopyString(Src.PSODesc.Name);
+
+    const auto& SrcLayout = Src.PSODesc.ResourceLayout;
+    auto&       DstLayout = Dst.PSODesc.ResourceLayout;
+    if (SrcLayout.Variables != nullptr)
+    {
+        auto* pVariables = Allocator.CopyArray(SrcLayout.Variables, SrcLayout.NumVariables);
+        for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+            pVariables[i].Name = Allocator.CopyString(SrcLayout.Variables[i].Name);
+        DstLayout.Variables = pVariables;
+    }
+
+    if (SrcLayout.ImmutableSamplers != nullptr)
+    {
+        auto* pSamplers = Allocator.CopyArray(SrcLayout.ImmutableSamplers, SrcLayout.NumImmutableSamplers);
+        for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
+        {
+            pSamplers[i].SamplerOrTextureName = Allocator.CopyString(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName);
+            pSamplers[i].Desc.Name            = Allocator.CopyString(SrcLayout.ImmutableSamplers[i].Desc.Name);
+        }
+        DstLayout.ImmutableSamplers = pSamplers;
+    }
+
+    if (Src.ppResourceSignatures != nullptr)
+    {
+        Dst.ppResourceSignatures = Allocator.CopyArray(Src.ppResourceSignatures, Src.ResourceSignaturesCount);
+        for (Uint32 i = 0; i < Src.ResourceSignaturesCount; ++i)
+            Objects.emplace_back(Src.ppResourceSignatures[i]);
+    }
+
+    if (Src.pInternalData != nullptr)
+        Dst.pInternalData = Allocator.Copy(*static_cast<const PSOCreateInternalInfo*>(Src.pInternalData));
+
+    Objects.emplace_back(Src.pPSOCache);
+}
+
+} // namespace
+
+template <>
+PipelineStateCreateInfoWrapper<GraphicsPipelineStateCreateInfo>::PipelineStateCreateInfoWrapper(const GraphicsPipelineStateCreateInfo& CI, IMemoryAllocator& RawAllocator) noexcept(false) :
+    m_CreateInfo{CI}
+{
+    FixedLinearAllocator Allocator{RawAllocator};
+
+    ReserveSpaceForPSOCreateInfo(CI, Allocator);
+
+    const auto& InputLayout = CI.GraphicsPipeline.InputLayout;
+    if (InputLayout.LayoutElements != nullptr)
+    {
+        Allocator.AddSpace<LayoutElement>(InputLayout.NumElements);
+        for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+            Allocator.AddSpaceForString(InputLayout.LayoutElements[i].HLSLSemantic);
+    }
+
+    Allocator.Reserve();
+
+    m_pRawMemory = decltype(m_pRawMemory){Allocator.ReleaseOwnership(), STDDeleterRawMem<void>{RawAllocator}};
+
+    CopyPSOCreateInfo(CI, m_CreateInfo, Allocator, m_Objects);
+
+    if (InputLayout.LayoutElements != nullptr)
+    {
+        auto* pElements = Allocator.CopyArray(InputLayout.LayoutElements, InputLayout.NumElements);
+        for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+            pElements[i].HLSLSemantic = Allocator.CopyString(InputLayout.LayoutElements[i].HLSLSemantic);
+        m_CreateInfo.GraphicsPipeline.InputLayout.LayoutElements = pElements;
+    }
+
+    m_Objects.emplace_back(CI.GraphicsPipeline.pRenderPass);
+
+    std::vector<IShader*> Shaders;
+    GetPipelineShaders(CI, Shaders);
+    for (auto* pShader : Shaders)
+        m_Objects.emplace_back(pShader);
+}
+
+template <>
+PipelineStateCreateInfoWrapper<ComputePipelineStateCreateInfo>::PipelineStateCreateInfoWrapper(const ComputePipelineStateCreateInfo& CI, IMemoryAllocator& RawAllocator) noexcept(false) :
+    m_CreateInfo{CI}
+{
+    FixedLinearAllocator Allocator{RawAllocator};
+
+    ReserveSpaceForPSOCreateInfo(CI, Allocator);
+
+    Allocator.Reserve();
+
+    m_pRawMemory = decltype(m_pRawMemory){Allocator.ReleaseOwnership(), STDDeleterRawMem<void>{RawAllocator}};
+
+    CopyPSOCreateInfo(CI, m_CreateInfo, Allocator, m_Objects);
+
+    m_Objects.emplace_back(CI.pCS);
+}
+
 } // namespace Diligent
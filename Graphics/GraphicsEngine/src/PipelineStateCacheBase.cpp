@@ -26,6 +26,12 @@
 
 #include "PipelineStateCacheBase.hpp"
 
+#include <cstdio>
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+
 namespace Diligent
 {
 
@@ -45,4 +51,76 @@ void ValidatePipelineStateCacheCreateInfo(const PipelineStateCacheCreateInfo& Cr
     // AZ TODO
 }
 
+std::string GetPipelineStateCacheFilePath(const PipelineStateCacheCreateInfo& CreateInfo, const char* DeviceKey)
+{
+    if (CreateInfo.CacheDirectory == nullptr || CreateInfo.CacheDirectory[0] == '\0')
+        return {};
+
+    VERIFY_EXPR(DeviceKey != nullptr && DeviceKey[0] != '\0');
+
+    std::string FilePath{CreateInfo.CacheDirectory};
+    if (!FileSystem::IsSlash(FilePath.back()))
+        FilePath.push_back(FileSystem::SlashSymbol);
+    FilePath += "PSOCache_";
+    FilePath += DeviceKey;
+    FilePath += ".bin";
+    return FilePath;
+}
+
+RefCntAutoPtr<IDataBlob> ReadPipelineStateCacheFile(const std::string& FilePath)
+{
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return {};
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+    if (!File)
+    {
+        LOG_WARNING_MESSAGE("Failed to open pipeline state cache file ", FilePath);
+        return {};
+    }
+
+    auto pData = DataBlobImpl::Create(File->GetSize());
+    if (!File->Read(pData->GetDataPtr(), pData->GetSize()))
+    {
+        LOG_WARNING_MESSAGE("Failed to read pipeline state cache file ", FilePath);
+        return {};
+    }
+
+    return RefCntAutoPtr<IDataBlob>{pData};
+}
+
+bool WritePipelineStateCacheFile(const std::string& FilePath, const void* pData, size_t Size)
+{
+    const auto TmpFilePath = FilePath + ".tmp";
+    {
+        FileWrapper File{TmpFilePath.c_str(), EFileAccessMode::Overwrite};
+        if (!File)
+        {
+            LOG_ERROR_MESSAGE("Failed to open pipeline state cache file ", TmpFilePath, " for writing");
+            return false;
+        }
+
+        if (!File->Write(pData, Size))
+        {
+            LOG_ERROR_MESSAGE("Failed to write pipeline state cache file ", TmpFilePath);
+            File.Close();
+            FileSystem::DeleteFile(TmpFilePath.c_str());
+            return false;
+        }
+    }
+
+    // std::rename does not replace existing files on Windows
+    if (FileSystem::FileExists(FilePath.c_str()))
+        FileSystem::DeleteFile(FilePath.c_str());
+
+    if (std::rename(TmpFilePath.c_str(), FilePath.c_str()) != 0)
+    {
+        LOG_ERROR_MESSAGE("Failed to rename ", TmpFilePath, " to ", FilePath);
+        FileSystem::DeleteFile(TmpFilePath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace Diligent
@@ -112,10 +112,13 @@ DeviceFeatures EnableDeviceFeatures(const DeviceFeatures& SupportedFeatures,
     ENABLE_FEATURE(VariableRateShading,               "Variable shading rate is");
     ENABLE_FEATURE(SparseResources,                   "Sparse resources are");
     ENABLE_FEATURE(SubpassFramebufferFetch,           "Subpass framebuffer fetch is");
+    ENABLE_FEATURE(DynamicPipelineStates,             "Dynamic pipeline states are");
+    ENABLE_FEATURE(WorkGraphs,                        "Work graphs are");
+    ENABLE_FEATURE(ConditionalRendering,              "Conditional rendering is");
     // clang-format on
 #undef ENABLE_FEATURE
 
-    ASSERT_SIZEOF(Diligent::DeviceFeatures, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
+    ASSERT_SIZEOF(Diligent::DeviceFeatures, 43, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
 
     return EnabledFeatures;
 }
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "SubresourceStateTracker.hpp"
+
+#include <algorithm>
+
+namespace Diligent
+{
+
+SubresourceStateTracker::SubresourceStateTracker(Uint32 MipLevels, Uint32 ArraySlices, RESOURCE_STATE State) :
+    m_MipLevels{MipLevels},
+    m_ArraySlices{ArraySlices},
+    m_Runs{{MipLevels * ArraySlices, State}}
+{
+    VERIFY_EXPR(MipLevels > 0 && ArraySlices > 0);
+}
+
+void SubresourceStateTracker::SetState(RESOURCE_STATE State)
+{
+    m_Runs.resize(1);
+    m_Runs[0] = {m_MipLevels * m_ArraySlices, State};
+}
+
+void SubresourceStateTracker::SetState(Uint32 Begin, Uint32 End, RESOURCE_STATE State)
+{
+    VERIFY_EXPR(Begin < End && End <= m_Runs.back().End);
+
+    // First run that contains Begin and the first run that ends at or after End
+    auto FirstIt = std::upper_bound(m_Runs.begin(), m_Runs.end(), Begin, [](Uint32 Idx, const Run& R) { return Idx < R.End; });
+    auto LastIt  = std::lower_bound(FirstIt, m_Runs.end(), End, [](const Run& R, Uint32 Idx) { return R.End < Idx; });
+    VERIFY_EXPR(FirstIt != m_Runs.end() && LastIt != m_Runs.end());
+
+    const Uint32 FirstRunBegin = FirstIt == m_Runs.begin() ? 0 : std::prev(FirstIt)->End;
+
+    Run    NewRuns[3];
+    size_t NumNewRuns = 0;
+    if (FirstRunBegin < Begin && FirstIt->State != State)
+        NewRuns[NumNewRuns++] = {Begin, FirstIt->State};
+    NewRuns[NumNewRuns++] = {End, State};
+    if (LastIt->End > End)
+    {
+        if (LastIt->State != State)
+            NewRuns[NumNewRuns++] = *LastIt;
+        else
+            NewRuns[NumNewRuns - 1].End = LastIt->End;
+    }
+
+    const auto FirstIdx = static_cast<size_t>(FirstIt - m_Runs.begin());
+    m_Runs.erase(FirstIt, std::next(LastIt));
+    m_Runs.insert(m_Runs.begin() + FirstIdx, NewRuns, NewRuns + NumNewRuns);
+
+    // Merge with the neighbors that are in the same state
+    const size_t LastIdx = FirstIdx + NumNewRuns - 1;
+    if (LastIdx + 1 < m_Runs.size() && m_Runs[LastIdx + 1].State == m_Runs[LastIdx].State)
+        m_Runs.erase(m_Runs.begin() + LastIdx);
+    if (FirstIdx > 0 && m_Runs[FirstIdx - 1].State == m_Runs[FirstIdx].State)
+        m_Runs.erase(m_Runs.begin() + FirstIdx - 1);
+}
+
+void SubresourceStateTracker::SetState(const Range& R, RESOURCE_STATE State)
+{
+    VerifyRange(R);
+    if (R.NumMips == 0 || R.NumSlices == 0)
+        return;
+
+    if (IsFullRange(R))
+    {
+        SetState(State);
+    }
+    else if (R.NumMips == m_MipLevels)
+    {
+        // All mip levels of consecutive slices are contiguous
+        SetState(R.FirstSlice * m_MipLevels, (R.FirstSlice + R.NumSlices) * m_MipLevels, State);
+    }
+    else
+    {
+        for (Uint32 Slice = R.FirstSlice; Slice < R.FirstSlice + R.NumSlices; ++Slice)
+        {
+            const Uint32 Begin = Slice * m_MipLevels + R.FirstMip;
+            SetState(Begin, Begin + R.NumMips, State);
+        }
+    }
+}
+
+RESOURCE_STATE SubresourceStateTracker::GetState(Uint32 Mip, Uint32 Slice) const
+{
+    VERIFY_EXPR(Mip < m_MipLevels && Slice < m_ArraySlices);
+    const Uint32 Idx = Slice * m_MipLevels + Mip;
+
+    auto it = std::upper_bound(m_Runs.begin(), m_Runs.end(), Idx, [](Uint32 Idx, const Run& R) { return Idx < R.End; });
+    VERIFY_EXPR(it != m_Runs.end());
+    return it->State;
+}
+
+void SubresourceStateTracker::GetSegments(Uint32 Slice, Uint32 FirstMip, Uint32 NumMips, std::vector<Segment>& Segments) const
+{
+    Segments.clear();
+
+    const Uint32 SliceStart = Slice * m_MipLevels;
+    const Uint32 Begin      = SliceStart + FirstMip;
+    const Uint32 End        = Begin + NumMips;
+
+    auto it = std::upper_bound(m_Runs.begin(), m_Runs.end(), Begin, [](Uint32 Idx, const Run& R) { return Idx < R.End; });
+    for (Uint32 Idx = Begin; Idx < End; ++it)
+    {
+        VERIFY_EXPR(it != m_Runs.end());
+        const Uint32 SegEnd = std::min(it->End, End);
+        Segments.push_back({Idx - SliceStart, SegEnd - Idx, it->State});
+        Idx = SegEnd;
+    }
+}
+
+} // namespace Diligent
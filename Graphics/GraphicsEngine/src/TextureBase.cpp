@@ -213,6 +213,11 @@ void ValidateTextureDesc(const TextureDesc& Desc, const IRenderDevice* pDevice)
             LOG_TEXTURE_ERROR_AND_THROW("MISC_TEXTURE_FLAG_SUBSAMPLED is not compatible with BIND_SHADING_RATE");
     }
 
+    if ((Desc.MiscFlags & MISC_TEXTURE_FLAG_SUBRESOURCE_STATES) != 0 && pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_VULKAN)
+    {
+        LOG_TEXTURE_ERROR_AND_THROW("MISC_TEXTURE_FLAG_SUBRESOURCE_STATES is only supported in Vulkan.");
+    }
+
     if (Desc.BindFlags & BIND_SHADING_RATE)
     {
         if (!pDevice->GetDeviceInfo().Features.VariableRateShading)
@@ -30,11 +30,13 @@
 /// \file
 /// Declaration of Diligent::BufferD3D11Impl class
 
+#include <vector>
 #include <atlbase.h>
 
 #include "EngineD3D11ImplTraits.hpp"
 #include "BufferBase.hpp"
 #include "ResourceD3D11Base.hpp"
+#include "DynamicConstantRingD3D11.hpp"
 
 namespace Diligent
 {
@@ -87,6 +89,20 @@ public:
             m_State = RESOURCE_STATE_UNDEFINED;
     }
 
+    /// Returns true if the immediate context suballocates the buffer contents from the dynamic constant ring.
+    bool UsesDynamicConstantRing() const { return !m_ConstantRingData.empty(); }
+
+    /// Returns the location of the buffer contents in the dynamic constant ring.
+    /// If the contents were uploaded in one of the previous frames, the space may have been
+    /// reused since, so the contents are uploaded again.
+    const DynamicConstantRingD3D11::Allocation& GetConstantRingAllocation(DynamicConstantRingD3D11& Ring)
+    {
+        VERIFY_EXPR(UsesDynamicConstantRing());
+        if (m_ConstantRingAllocation.pd3d11Buffer != nullptr && m_ConstantRingAllocation.FrameNumber != Ring.GetFrameNumber())
+            Ring.Upload(*this);
+        return m_ConstantRingAllocation;
+    }
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -94,7 +110,14 @@ private:
     void CreateSRV(struct BufferViewDesc& SRVDesc, ID3D11ShaderResourceView** ppD3D11SRV);
 
     friend class DeviceContextD3D11Impl;
+    friend class DynamicConstantRingD3D11;
     CComPtr<ID3D11Buffer> m_pd3d11Buffer; ///< D3D11 buffer object
+
+    // CPU copy of the buffer contents that is uploaded to the dynamic constant ring
+    std::vector<Uint8> m_ConstantRingData;
+
+    // Location of the contents in the dynamic constant ring
+    DynamicConstantRingD3D11::Allocation m_ConstantRingAllocation;
 };
 
 } // namespace Diligent
@@ -41,6 +41,7 @@
 #include "FramebufferD3D11Impl.hpp"
 #include "RenderPassD3D11Impl.hpp"
 #include "DisjointQueryPool.hpp"
+#include "DynamicConstantRingD3D11.hpp"
 #include "BottomLevelASBase.hpp"
 #include "TopLevelASBase.hpp"
 #include "ShaderResourceBindingD3D11Impl.hpp"
@@ -238,6 +239,9 @@ public:
     /// Implementation of IDeviceContext::BuildBLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -285,6 +289,12 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContextD3D11::GetD3D11DeviceContext().
     virtual ID3D11DeviceContext* DILIGENT_CALL_TYPE GetD3D11DeviceContext() override final { return m_pd3d11DeviceContext; }
 
@@ -425,14 +435,33 @@ private:
         Bind
     };
 
-    // Binds all shader resource cache resources
+    /// Ranges of the slots in m_CommittedRes that have been modified by BindShaderResources()
+    /// and need to be set in the D3D11 device context, for each shader type.
+    /// Ranges of all SRBs are accumulated so that every *Set* method is called at most once
+    /// per shader stage.
+    struct DirtySlotRanges
+    {
+        // clang-format off
+        ShaderResourceCacheD3D11::MinMaxSlot CBs     [NumShaderTypes];
+        ShaderResourceCacheD3D11::MinMaxSlot SRVs    [NumShaderTypes];
+        ShaderResourceCacheD3D11::MinMaxSlot Samplers[NumShaderTypes];
+        ShaderResourceCacheD3D11::MinMaxSlot UAVs    [NumShaderTypes];
+        // clang-format on
+    };
+
+    // Updates committed resources with all shader resource cache resources
     void BindCacheResources(const ShaderResourceCacheD3D11&    ResourceCache,
                             const D3D11ShaderResourceCounters& BaseBindings,
-                            PixelShaderUAVBindMode&            PsUavBindMode);
+                            PixelShaderUAVBindMode&            PsUavBindMode,
+                            DirtySlotRanges&                   DirtySlots);
 
-    // Binds constant buffers with dynamic offsets only
+    // Updates committed resources with constant buffers with dynamic offsets only
     void BindDynamicCBs(const ShaderResourceCacheD3D11&    ResourceCache,
-                        const D3D11ShaderResourceCounters& BaseBindings);
+                        const D3D11ShaderResourceCounters& BaseBindings,
+                        DirtySlotRanges&                   DirtySlots);
+
+    // Sets the dirty slot ranges of committed resources in the D3D11 device context
+    void CommitDirtySlots(const DirtySlotRanges& DirtySlots);
 
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources();
@@ -503,6 +532,9 @@ private:
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
 
+    /// Dynamic constant ring of the immediate context (null in deferred contexts or when the ring is disabled)
+    std::unique_ptr<DynamicConstantRingD3D11> m_pDynamicConstantRing;
+
 #ifdef DILIGENT_DEVELOPMENT
 
     /// Helper template function used to facilitate context verification
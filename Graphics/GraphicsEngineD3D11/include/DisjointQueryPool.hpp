@@ -45,6 +45,11 @@ public:
         CComPtr<ID3D11Query> pd3d11Query;
         bool                 IsEnded = false;
 
+        // All timestamp queries of the frame share the same disjoint query,
+        // so its data is read from the context only once.
+        bool                                DataAvailable = false;
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT Data          = {};
+
         DisjointQueryWrapper(DisjointQueryPool&     _Pool,
                              CComPtr<ID3D11Query>&& _pd3d11Query) :
             Pool(_Pool),
@@ -57,6 +62,14 @@ public:
             Pool.m_AvailableQueries.emplace_back(std::move(pd3d11Query));
         }
 
+        bool GetData(ID3D11DeviceContext* pd3d11Ctx)
+        {
+            VERIFY(IsEnded, "Disjoint query data can't be requested before the query is ended");
+            if (!DataAvailable)
+                DataAvailable = pd3d11Ctx->GetData(pd3d11Query, &Data, sizeof(Data), 0) == S_OK;
+            return DataAvailable;
+        }
+
         DisjointQueryWrapper(DisjointQueryWrapper&&) = default;
 
         DisjointQueryWrapper(const DisjointQueryWrapper&) = delete;
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DynamicConstantRingD3D11 class
+
+#include <deque>
+#include <vector>
+#include <atlbase.h>
+
+#include "MemoryAllocator.h"
+#include "RingBuffer.hpp"
+
+namespace Diligent
+{
+
+class BufferD3D11Impl;
+
+/// Ring buffer that holds the contents of USAGE_DYNAMIC constant buffers in the immediate context.
+
+/// Writing to a dynamic constant buffer with D3D11_MAP_WRITE_DISCARD makes the driver rename the buffer,
+/// which is expensive when many small buffers are updated every frame. Instead, the data of a buffer that
+/// uses the ring is written to its CPU copy, and is then copied to a new region of one large buffer that is mapped
+/// with D3D11_MAP_WRITE_NO_OVERWRITE. The region is bound with *SSetConstantBuffers1() offsets.
+/// Ring space is released when the GPU finishes the frame in which it was allocated, which is tracked with event queries.
+class DynamicConstantRingD3D11 final
+{
+public:
+    /// Location of the buffer contents in the ring.
+    struct Allocation
+    {
+        /// D3D11 buffer of the ring, or null if the contents are located in the buffer's own D3D11 buffer.
+        ID3D11Buffer* pd3d11Buffer = nullptr;
+
+        /// Offset of the contents from the beginning of the ring, in bytes.
+        Uint32 Offset = 0;
+
+        /// Number of the frame in which the contents were written to the ring.
+        Uint64 FrameNumber = 0;
+    };
+
+    DynamicConstantRingD3D11(IMemoryAllocator&    Allocator,
+                             ID3D11Device*        pd3d11Device,
+                             ID3D11DeviceContext* pd3d11Context,
+                             Uint32               Size);
+    ~DynamicConstantRingD3D11();
+
+    // clang-format off
+    DynamicConstantRingD3D11           (const DynamicConstantRingD3D11&)  = delete;
+    DynamicConstantRingD3D11           (      DynamicConstantRingD3D11&&) = delete;
+    DynamicConstantRingD3D11& operator=(const DynamicConstantRingD3D11&)  = delete;
+    DynamicConstantRingD3D11& operator=(      DynamicConstantRingD3D11&&) = delete;
+    // clang-format on
+
+    /// Copies the CPU data of the buffer to a new region of the ring and updates the buffer's allocation.
+    /// If the ring is full, the data is written to the buffer's own D3D11 buffer instead.
+    void Upload(BufferD3D11Impl& Buffer);
+
+    /// Ends the current frame and releases the space of the frames that have been completed by the GPU.
+    void FinishFrame();
+
+    Uint64 GetFrameNumber() const { return m_FrameNumber; }
+
+private:
+    void ReleaseCompletedFrames();
+
+    CComPtr<ID3D11Device>        m_pd3d11Device;
+    CComPtr<ID3D11DeviceContext> m_pd3d11Context;
+    CComPtr<ID3D11Buffer>        m_pd3d11Buffer;
+
+    RingBuffer m_Ring;
+
+    // Event queries that are signaled when the GPU completes the frame
+    std::deque<std::pair<Uint64, CComPtr<ID3D11Query>>> m_PendingFrames;
+    std::vector<CComPtr<ID3D11Query>>                   m_AvailableQueries;
+
+    Uint64 m_FrameNumber = 0;
+};
+
+} // namespace Diligent
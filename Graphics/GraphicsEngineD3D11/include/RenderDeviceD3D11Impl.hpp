@@ -74,6 +74,10 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo,
                                                                 IPipelineState**                       ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreateDerivedGraphicsPipelineState() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo,
+                                                                       IPipelineState**                              ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateComputePipelineState() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo,
                                                                IPipelineState**                      ppPipelineState) override final;
@@ -166,6 +170,10 @@ public:
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
+    /// Returns the size of the dynamic constant ring, or zero if the ring is disabled or not supported
+    /// by the device (see EngineD3D11CreateInfo::DynamicConstantRingSize).
+    Uint32 GetDynamicConstantRingSize() const { return m_DynamicConstantRingSize; }
+
 
 #define GET_D3D11_DEVICE(Version)                                                  \
     ID3D11Device##Version* GetD3D11Device##Version()                               \
@@ -195,6 +203,8 @@ private:
     /// D3D11 device
     CComPtr<ID3D11Device> m_pd3d11Device;
 
+    Uint32 m_DynamicConstantRingSize = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
     Uint32 m_MaxD3D11DeviceVersion = 0;
 #endif
@@ -138,6 +138,32 @@ public:
             return pBuff && RangeSize != 0 && RangeSize < pBuff->GetDesc().Size;
         }
 
+        // Returns true if the contents of the bound buffer may be suballocated from the
+        // dynamic constant ring, so that the buffer needs to be rebound after every update.
+        bool UsesDynamicConstantRing() const
+        {
+            return pBuff && pBuff->UsesDynamicConstantRing();
+        }
+
+        // Returns the D3D11 buffer that holds the buffer contents, and the offset of the bound range in bytes.
+        // pConstantRing is the dynamic constant ring of the immediate context, or null for deferred contexts.
+        __forceinline ID3D11Buffer* GetD3D11Buffer(ID3D11Buffer*             pd3d11Buffer,
+                                                   DynamicConstantRingD3D11* pConstantRing,
+                                                   Uint32&                   Offset) const
+        {
+            Offset = BaseOffset + DynamicOffset;
+            if (pConstantRing != nullptr && UsesDynamicConstantRing())
+            {
+                const auto& RingAlloc = pBuff.RawPtr<BufferD3D11Impl>()->GetConstantRingAllocation(*pConstantRing);
+                if (RingAlloc.pd3d11Buffer != nullptr)
+                {
+                    pd3d11Buffer = RingAlloc.pd3d11Buffer;
+                    Offset += RingAlloc.Offset;
+                }
+            }
+            return pd3d11Buffer;
+        }
+
         // Returns ID3D11Buffer
         template <D3D11_RESOURCE_RANGE ResRange>
         typename CachedResourceTraits<ResRange>::D3D11ResourceType* GetD3D11Resource();
@@ -337,6 +363,13 @@ public:
             MaxSlot = Slot;
         }
 
+        // Extends the range to include all slots of another range
+        void Add(const MinMaxSlot& Slots)
+        {
+            MinSlot = std::min(MinSlot, Slots.MinSlot);
+            MaxSlot = std::max(MaxSlot, Slots.MaxSlot);
+        }
+
         explicit operator bool() const
         {
             return MinSlot <= MaxSlot;
@@ -354,19 +387,20 @@ public:
                                         ID3D11Resource*                                          CommittedD3D11Resources[],
                                         const D3D11ShaderResourceCounters&                       BaseBindings) const;
 
+    // pConstantRing is the dynamic constant ring of the immediate context, or null for deferred contexts.
     inline MinMaxSlot BindCBs(Uint32                             ShaderInd,
                               ID3D11Buffer*                      CommittedD3D11Resources[],
                               UINT                               FirstConstants[],
                               UINT                               NumConstants[],
-                              const D3D11ShaderResourceCounters& BaseBindings) const;
+                              const D3D11ShaderResourceCounters& BaseBindings,
+                              DynamicConstantRingD3D11*          pConstantRing) const;
 
-    template <typename BindHandlerType>
-    inline void BindDynamicCBs(Uint32                             ShaderInd,
-                               ID3D11Buffer*                      CommittedD3D11Resources[],
-                               UINT                               FirstConstants[],
-                               UINT                               NumConstants[],
-                               const D3D11ShaderResourceCounters& BaseBindings,
-                               BindHandlerType&&                  BindHandler) const;
+    inline MinMaxSlot BindDynamicCBs(Uint32                             ShaderInd,
+                                     ID3D11Buffer*                      CommittedD3D11Resources[],
+                                     UINT                               FirstConstants[],
+                                     UINT                               NumConstants[],
+                                     const D3D11ShaderResourceCounters& BaseBindings,
+                                     DynamicConstantRingD3D11*          pConstantRing) const;
 
     enum class StateTransitionMode
     {
@@ -474,7 +508,8 @@ private:
     // Indicates which slots may contain constant buffers with dynamic offsets
     std::array<Uint16, NumShaderTypes> m_DynamicCBSlotsMask{};
 
-    // Indicates which slots actually contain constant buffers with dynamic offsets
+    // Indicates which slots actually contain constant buffers with dynamic offsets or
+    // buffers that use the dynamic constant ring, i.e. the buffers that are rebound at every draw.
     std::array<Uint16, NumShaderTypes> m_DynamicCBOffsetsMask{};
     static_assert(sizeof(m_DynamicCBOffsetsMask[0]) * 8 >= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, "Not enough bits for all dynamic buffer slots");
 
@@ -629,7 +664,8 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     ID3D11Buffer*                      CommittedD3D11Resources[],
     UINT                               FirstConstants[],
     UINT                               NumConstants[],
-    const D3D11ShaderResourceCounters& BaseBindings) const
+    const D3D11ShaderResourceCounters& BaseBindings,
+    DynamicConstantRingD3D11*          pConstantRing) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
@@ -641,9 +677,10 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     for (Uint32 res = 0; res < ResCount; ++res)
     {
         const Uint32 Slot     = BaseBinding + res;
-        auto* const  pd3d11CB = ResArrays.second[res];
+        Uint32       Offset   = 0;
+        auto* const  pd3d11CB = ResArrays.first[res].GetD3D11Buffer(ResArrays.second[res], pConstantRing, Offset);
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((ResArrays.first[res].BaseOffset + ResArrays.first[res].DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>(Offset / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = StaticCast<UINT>(AlignUp(ResArrays.first[res].RangeSize / 16u, 16u));
         // clang-format off
@@ -667,19 +704,20 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     return Slots;
 }
 
-template <typename BindHandlerType>
-inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32                             ShaderInd,
-                                                     ID3D11Buffer*                      CommittedD3D11Resources[],
-                                                     UINT                               FirstConstants[],
-                                                     UINT                               NumConstants[],
-                                                     const D3D11ShaderResourceCounters& BaseBindings,
-                                                     BindHandlerType&&                  BindHandler) const
+inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindDynamicCBs(
+    Uint32                             ShaderInd,
+    ID3D11Buffer*                      CommittedD3D11Resources[],
+    UINT                               FirstConstants[],
+    UINT                               NumConstants[],
+    const D3D11ShaderResourceCounters& BaseBindings,
+    DynamicConstantRingD3D11*          pConstantRing) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
 
+    MinMaxSlot Slots;
     for (Uint32 DynamicCBMask = m_DynamicCBOffsetsMask[ShaderInd]; DynamicCBMask != 0;)
     {
         const auto CBBit   = ExtractLSB(DynamicCBMask);
@@ -687,10 +725,11 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
 
         const Uint32 Slot = BaseBinding + Binding;
         const auto&  CB   = ResArrays.first[Binding];
-        VERIFY_EXPR(CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
-        auto* const pd3d11CB = ResArrays.second[Binding];
+        VERIFY_EXPR((CB.AllowsDynamicOffset() || CB.UsesDynamicConstantRing()) && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
+        Uint32      Offset   = 0;
+        auto* const pd3d11CB = CB.GetD3D11Buffer(ResArrays.second[Binding], pConstantRing, Offset);
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((CB.BaseOffset + CB.DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>(Offset / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = StaticCast<UINT>(AlignUp(CB.RangeSize / 16u, 16u));
         // clang-format off
@@ -707,9 +746,11 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
             FirstConstants[Slot]          = FirstCBConstant;
             NumConstants[Slot]            = NumCBConstants;
 
-            BindHandler(Slot);
+            Slots.Add(Slot);
         }
     }
+
+    return Slots;
 }
 
 
@@ -740,7 +781,7 @@ inline void ShaderResourceCacheD3D11::UpdateDynamicCBOffsetFlag<D3D11_RESOURCE_R
     {
         // Only set the flag for those slots that allow dynamic buffers
         // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
-        if (CB.AllowsDynamicOffset())
+        if (CB.AllowsDynamicOffset() || CB.UsesDynamicConstantRing())
             m_DynamicCBOffsetsMask[ShaderInd] |= BufferBit;
         else
             m_DynamicCBOffsetsMask[ShaderInd] &= ~BufferBit;
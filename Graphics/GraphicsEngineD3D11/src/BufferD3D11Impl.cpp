@@ -129,10 +129,27 @@ BufferD3D11Impl::BufferD3D11Impl(IReferenceCounters*        pRefCounters,
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to set buffer name");
     }
 
+    if (m_Desc.Usage == USAGE_DYNAMIC && m_Desc.BindFlags == BIND_UNIFORM_BUFFER &&
+        pRenderDeviceD3D11->GetDynamicConstantRingSize() != 0 &&
+        m_Desc.Size <= Uint64{D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT} * 16)
+    {
+        // The immediate context writes the buffer contents to the CPU copy and uploads them to
+        // the dynamic constant ring, see DynamicConstantRingD3D11.
+        m_ConstantRingData.resize(StaticCast<size_t>(m_Desc.Size));
+        if (InitData.pSysMem != nullptr)
+            memcpy(m_ConstantRingData.data(), InitData.pSysMem, std::min(m_ConstantRingData.size(), StaticCast<size_t>(pBuffData->DataSize)));
+    }
+
     SetState(RESOURCE_STATE_UNDEFINED);
 
     // The memory is always coherent in Direct3D11
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
+
+    // Direct3D11 does not expose the allocation size, so the buffer size is reported
+    if (m_Desc.Usage == USAGE_SPARSE)
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_PLACED, 0);
+    else
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, m_Desc.Size);
 }
 
 static BufferDesc BuffDescFromD3D11Buffer(ID3D11Buffer* pd3d11Buffer, BufferDesc BuffDesc)
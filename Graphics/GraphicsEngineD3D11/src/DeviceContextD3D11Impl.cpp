@@ -65,6 +65,11 @@ DeviceContextD3D11Impl::DeviceContextD3D11Impl(IReferenceCounters*          pRef
     m_CmdListAllocator    {GetRawAllocator(), sizeof(CommandListD3D11Impl), 64}
 // clang-format on
 {
+    if (!Desc.IsDeferred && pDevice->GetDynamicConstantRingSize() != 0)
+    {
+        m_pDynamicConstantRing = std::make_unique<DynamicConstantRingD3D11>(GetRawAllocator(), pDevice->GetD3D11Device(), pd3d11DeviceContext,
+                                                                            pDevice->GetDynamicConstantRingSize());
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDeviceContextBase)
@@ -78,10 +83,11 @@ void DeviceContextD3D11Impl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    if (IsRedundantPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateD3D11Impl> pPipelineStateD3D11{pPipelineState, PipelineStateD3D11Impl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateD3D11 != nullptr, "Unknown pipeline state object implementation");
-    if (PipelineStateD3D11Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D11))
-        return;
 
     TDeviceContextBase::SetPipelineState(std::move(pPipelineStateD3D11), 0 /*Dummy*/);
     const auto& Desc = m_pPipelineState->GetDesc();
@@ -217,6 +223,8 @@ void DeviceContextD3D11Impl::TransitionShaderResources(IPipelineState* pPipeline
 
 void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_COMMIT_SHADER_RESOURCES)};
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* const pShaderResBindingD3D11 = ClassPtrCast<ShaderResourceBindingD3D11Impl>(pShaderResourceBinding);
@@ -244,68 +252,32 @@ void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShad
 
 void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&    ResourceCache,
                                                 const D3D11ShaderResourceCounters& BaseBindings,
-                                                PixelShaderUAVBindMode&            PsUavBindMode)
+                                                PixelShaderUAVBindMode&            PsUavBindMode,
+                                                DirtySlotRanges&                   DirtySlots)
 {
     for (SHADER_TYPE ActiveStages = m_BindInfo.ActiveStages; ActiveStages != SHADER_TYPE_UNKNOWN;)
     {
-        const auto ShaderInd  = ExtractFirstShaderStageIndex(ActiveStages);
-        const auto ShaderType = GetShaderTypeFromIndex(ShaderInd);
+        const auto ShaderInd = ExtractFirstShaderStageIndex(ActiveStages);
 
         if (ResourceCache.GetCBCount(ShaderInd) > 0)
         {
             auto* d3d11CBs       = m_CommittedRes.d3d11CBs[ShaderInd];
             auto* FirstConstants = m_CommittedRes.CBFirstConstants[ShaderInd];
             auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
-            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings))
-            {
-                auto SetCB1Method = SetCB1Methods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetCB1Method)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1,
-                                                       d3d11CBs + Slots.MinSlot,
-                                                       FirstConstants + Slots.MinSlot,
-                                                       NumConstants + Slots.MinSlot);
-                m_CommittedRes.NumCBs[ShaderInd] = std::max(m_CommittedRes.NumCBs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
-            }
-#ifdef DILIGENT_DEVELOPMENT
-            if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
-            {
-                DvpVerifyCommittedCBs(ShaderType);
-            }
-#endif
+            DirtySlots.CBs[ShaderInd].Add(ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, m_pDynamicConstantRing.get()));
         }
 
         if (ResourceCache.GetSRVCount(ShaderInd) > 0)
         {
             auto* d3d11SRVs   = m_CommittedRes.d3d11SRVs[ShaderInd];
             auto* d3d11SRVRes = m_CommittedRes.d3d11SRVResources[ShaderInd];
-            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings))
-            {
-                auto SetSRVMethod = SetSRVMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSRVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11SRVs + Slots.MinSlot);
-                m_CommittedRes.NumSRVs[ShaderInd] = std::max(m_CommittedRes.NumSRVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
-            }
-#ifdef DILIGENT_DEVELOPMENT
-            if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
-            {
-                DvpVerifyCommittedSRVs(ShaderType);
-            }
-#endif
+            DirtySlots.SRVs[ShaderInd].Add(ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings));
         }
 
         if (ResourceCache.GetSamplerCount(ShaderInd) > 0)
         {
             auto* d3d11Samplers = m_CommittedRes.d3d11Samplers[ShaderInd];
-            if (auto Slots = ResourceCache.BindResources<D3D11_RESOURCE_RANGE_SAMPLER>(ShaderInd, d3d11Samplers, BaseBindings))
-            {
-                auto SetSamplerMethod = SetSamplerMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSamplerMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11Samplers + Slots.MinSlot);
-                m_CommittedRes.NumSamplers[ShaderInd] = std::max(m_CommittedRes.NumSamplers[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
-            }
-#ifdef DILIGENT_DEVELOPMENT
-            if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
-            {
-                DvpVerifyCommittedSamplers(ShaderType);
-            }
-#endif
+            DirtySlots.Samplers[ShaderInd].Add(ResourceCache.BindResources<D3D11_RESOURCE_RANGE_SAMPLER>(ShaderInd, d3d11Samplers, BaseBindings));
         }
 
         if (ResourceCache.GetUAVCount(ShaderInd) > 0)
@@ -319,58 +291,91 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             {
                 if (ShaderInd == PSInd)
                 {
+                    // Pixel shader UAVs are set together with render targets, see BindShaderResources()
                     PsUavBindMode = PixelShaderUAVBindMode::Bind;
                 }
                 else if (ShaderInd == CSInd)
                 {
-                    // This can only be CS
-                    auto SetUAVMethod = SetUAVMethods[ShaderInd];
-                    (m_pd3d11DeviceContext->*SetUAVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11UAVs + Slots.MinSlot, nullptr);
-                    m_CommittedRes.NumUAVs[ShaderInd] = std::max(m_CommittedRes.NumUAVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+                    DirtySlots.UAVs[ShaderInd].Add(Slots);
                 }
                 else
                 {
                     UNEXPECTED("UAV is not supported in shader that is not pixel or compute");
                 }
             }
-#ifdef DILIGENT_DEVELOPMENT
-            if ((m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE) != 0 && ShaderInd == CSInd)
-            {
-                DvpVerifyCommittedUAVs(ShaderType);
-            }
-#endif
         }
     }
 }
 
 void DeviceContextD3D11Impl::BindDynamicCBs(const ShaderResourceCacheD3D11&    ResourceCache,
-                                            const D3D11ShaderResourceCounters& BaseBindings)
+                                            const D3D11ShaderResourceCounters& BaseBindings,
+                                            DirtySlotRanges&                   DirtySlots)
 {
     for (SHADER_TYPE ActiveStages = m_BindInfo.ActiveStages; ActiveStages != SHADER_TYPE_UNKNOWN;)
     {
         const auto ShaderInd = ExtractFirstShaderStageIndex(ActiveStages);
         if (ResourceCache.GetDynamicCBOffsetsMask(ShaderInd) == 0)
         {
-            // Skip stages that don't have any constant buffers with dynamic offsets
+            // Skip stages that don't have any constant buffers with dynamic offsets or in the dynamic constant ring
             continue;
         }
 
         auto* d3d11CBs       = m_CommittedRes.d3d11CBs[ShaderInd];
         auto* FirstConstants = m_CommittedRes.CBFirstConstants[ShaderInd];
         auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
-        auto  SetCB1Method   = SetCB1Methods[ShaderInd];
+        DirtySlots.CBs[ShaderInd].Add(ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, m_pDynamicConstantRing.get()));
+    }
+}
+
+void DeviceContextD3D11Impl::CommitDirtySlots(const DirtySlotRanges& DirtySlots)
+{
+    for (SHADER_TYPE ActiveStages = m_BindInfo.ActiveStages; ActiveStages != SHADER_TYPE_UNKNOWN;)
+    {
+        const auto ShaderInd = ExtractFirstShaderStageIndex(ActiveStages);
 
-        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings,
-                                     [&](Uint32 Slot) //
-                                     {
-                                         (m_pd3d11DeviceContext->*SetCB1Method)(Slot, 1, d3d11CBs + Slot, FirstConstants + Slot, NumConstants + Slot);
-                                     });
+        // Slots within the range that have not been modified are set to the same
+        // values, which is much cheaper than setting every modified slot individually.
+        if (const auto& Slots = DirtySlots.CBs[ShaderInd])
+        {
+            auto SetCB1Method = SetCB1Methods[ShaderInd];
+            (m_pd3d11DeviceContext->*SetCB1Method)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1,
+                                                   m_CommittedRes.d3d11CBs[ShaderInd] + Slots.MinSlot,
+                                                   m_CommittedRes.CBFirstConstants[ShaderInd] + Slots.MinSlot,
+                                                   m_CommittedRes.CBNumConstants[ShaderInd] + Slots.MinSlot);
+            m_CommittedRes.NumCBs[ShaderInd] = std::max(m_CommittedRes.NumCBs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+        }
+
+        if (const auto& Slots = DirtySlots.SRVs[ShaderInd])
+        {
+            auto SetSRVMethod = SetSRVMethods[ShaderInd];
+            (m_pd3d11DeviceContext->*SetSRVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, m_CommittedRes.d3d11SRVs[ShaderInd] + Slots.MinSlot);
+            m_CommittedRes.NumSRVs[ShaderInd] = std::max(m_CommittedRes.NumSRVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+        }
+
+        if (const auto& Slots = DirtySlots.Samplers[ShaderInd])
+        {
+            auto SetSamplerMethod = SetSamplerMethods[ShaderInd];
+            (m_pd3d11DeviceContext->*SetSamplerMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, m_CommittedRes.d3d11Samplers[ShaderInd] + Slots.MinSlot);
+            m_CommittedRes.NumSamplers[ShaderInd] = std::max(m_CommittedRes.NumSamplers[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+        }
+
+        if (const auto& Slots = DirtySlots.UAVs[ShaderInd])
+        {
+            VERIFY(ShaderInd == CSInd, "Only compute shader UAVs are expected here");
+            auto SetUAVMethod = SetUAVMethods[ShaderInd];
+            (m_pd3d11DeviceContext->*SetUAVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, m_CommittedRes.d3d11UAVs[ShaderInd] + Slots.MinSlot, nullptr);
+            m_CommittedRes.NumUAVs[ShaderInd] = std::max(m_CommittedRes.NumUAVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+        }
 
 #ifdef DILIGENT_DEVELOPMENT
         if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
         {
             const auto ShaderType = GetShaderTypeFromIndex(ShaderInd);
             DvpVerifyCommittedCBs(ShaderType);
+            DvpVerifyCommittedSRVs(ShaderType);
+            DvpVerifyCommittedSamplers(ShaderType);
+            if (ShaderInd == CSInd)
+                DvpVerifyCommittedUAVs(ShaderType);
         }
 #endif
     }
@@ -385,6 +390,8 @@ void DeviceContextD3D11Impl::BindShaderResources(Uint32 BindSRBMask)
         PixelShaderUAVBindMode::Clear :
         PixelShaderUAVBindMode::Keep;
 
+    DirtySlotRanges DirtySlots;
+
     while (BindSRBMask != 0)
     {
         auto SignBit = ExtractLSB(BindSRBMask);
@@ -400,7 +407,7 @@ void DeviceContextD3D11Impl::BindShaderResources(Uint32 BindSRBMask)
         if (m_BindInfo.StaleSRBMask & SignBit)
         {
             // Bind all cache resources
-            BindCacheResources(*pResourceCache, BaseBindings, PsUavBindMode);
+            BindCacheResources(*pResourceCache, BaseBindings, PsUavBindMode, DirtySlots);
         }
         else
         {
@@ -415,11 +422,13 @@ void DeviceContextD3D11Impl::BindShaderResources(Uint32 BindSRBMask)
                 if (PsUavBindMode != PixelShaderUAVBindMode::Bind)
                     PsUavBindMode = PixelShaderUAVBindMode::Keep;
             }
-            BindDynamicCBs(*pResourceCache, BaseBindings);
+            BindDynamicCBs(*pResourceCache, BaseBindings, DirtySlots);
         }
     }
     m_BindInfo.StaleSRBMask &= ~m_BindInfo.ActiveSRBMask;
 
+    CommitDirtySlots(DirtySlots);
+
     if (PsUavBindMode == PixelShaderUAVBindMode::Bind)
     {
         // Pixel shader UAVs cannot be set independently; they all need to be set at the same time.
@@ -909,6 +918,18 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     auto* pSrcBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pSrcBuffer);
     auto* pDstBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pDstBuffer);
 
+    ID3D11Buffer* pd3d11SrcBuffer = pSrcBufferD3D11Impl->m_pd3d11Buffer;
+    if (m_pDynamicConstantRing && pSrcBufferD3D11Impl->UsesDynamicConstantRing())
+    {
+        // The source buffer contents may be located in the dynamic constant ring
+        const auto& RingAlloc = pSrcBufferD3D11Impl->GetConstantRingAllocation(*m_pDynamicConstantRing);
+        if (RingAlloc.pd3d11Buffer != nullptr)
+        {
+            pd3d11SrcBuffer = RingAlloc.pd3d11Buffer;
+            SrcOffset += RingAlloc.Offset;
+        }
+    }
+
     D3D11_BOX SrcBox;
     SrcBox.left   = StaticCast<UINT>(SrcOffset);
     SrcBox.right  = StaticCast<UINT>(SrcOffset + Size);
@@ -916,15 +937,26 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     SrcBox.bottom = 1;
     SrcBox.front  = 0;
     SrcBox.back   = 1;
-    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pSrcBufferD3D11Impl->m_pd3d11Buffer, 0, &SrcBox);
+    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pd3d11SrcBuffer, 0, &SrcBox);
 }
 
 
 void DeviceContextD3D11Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_MAP_BUFFER)};
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
 
-    auto*     pBufferD3D11  = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (m_pDynamicConstantRing && pBufferD3D11->UsesDynamicConstantRing())
+    {
+        // The data is written to the CPU copy of the buffer and uploaded to the ring by UnmapBuffer().
+        // The copy keeps the previous contents, so MAP_FLAG_NO_OVERWRITE is handled as well.
+        VERIFY_EXPR(MapType == MAP_WRITE);
+        pMappedData = pBufferD3D11->m_ConstantRingData.data();
+        return;
+    }
+
     D3D11_MAP d3d11MapType  = static_cast<D3D11_MAP>(0);
     UINT      d3d11MapFlags = 0;
     MapParamsToD3D11MapParams(MapType, MapFlags, d3d11MapType, d3d11MapFlags);
@@ -943,6 +975,11 @@ void DeviceContextD3D11Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (m_pDynamicConstantRing && pBufferD3D11->UsesDynamicConstantRing())
+    {
+        m_pDynamicConstantRing->Upload(*pBufferD3D11);
+        return;
+    }
     m_pd3d11DeviceContext->Unmap(pBufferD3D11->m_pd3d11Buffer, 0);
 }
 
@@ -1076,6 +1113,13 @@ void DeviceContextD3D11Impl::FinishFrame()
         m_ActiveDisjointQuery.reset();
     }
 
+    // D3D11 fences can only be queried by the immediate context thread
+    if (!IsDeferred())
+        m_pDevice->GetFenceCompletionWaiter().ProcessCompletedFences();
+
+    if (m_pDynamicConstantRing)
+        m_pDynamicConstantRing->FinishFrame();
+
     TDeviceContextBase::EndFrame();
 }
 
@@ -1086,6 +1130,9 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
@@ -1118,6 +1165,9 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
 
 void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
 
     if (m_pIndexBuffer)
@@ -2055,6 +2105,8 @@ static void AliasingBarrier(ID3D11DeviceContext* pd3d11Ctx, IDeviceObject* pReso
 
 void DeviceContextD3D11Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_TRANSITION_RESOURCE_STATES)};
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 
     for (Uint32 i = 0; i < BarrierCount; ++i)
@@ -2228,6 +2280,11 @@ void DeviceContextD3D11Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     UNSUPPORTED("BuildBLAS is not supported in DirectX 11");
 }
 
+void DeviceContextD3D11Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     UNSUPPORTED("BuildTLAS is not supported in DirectX 11");
@@ -2326,6 +2383,16 @@ bool DeviceContextD3D11Impl::ResizeTilePool(ID3D11Buffer* pBuffer, UINT NewSize)
     return SUCCEEDED(pd3d11DeviceContext2->ResizeTilePool(pBuffer, NewSize));
 }
 
+void DeviceContextD3D11Impl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    UNSUPPORTED("Conditional rendering is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::EndConditionalRendering()
+{
+    UNSUPPORTED("Conditional rendering is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
@@ -51,6 +51,8 @@ DeviceMemoryD3D11Impl::DeviceMemoryD3D11Impl(IReferenceCounters*           pRefC
     auto* pDeviceD3D11 = m_pDevice->GetD3D11Device();
     CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateBuffer(&D3D11BuffDesc, nullptr, &m_pd3d11Buffer),
                            "Failed to create Direct3D11 tile pool");
+
+    RecordGPUMemory(MemCI.InitialSize);
 }
 
 DeviceMemoryD3D11Impl::~DeviceMemoryD3D11Impl()
@@ -72,7 +74,9 @@ Bool DeviceMemoryD3D11Impl::Resize(Uint64 NewSize)
     auto pImmediateCtx = m_pDevice->GetImmediateContext(0);
     VERIFY(pImmediateCtx, "Immediate context has been released");
 
-    return pImmediateCtx->ResizeTilePool(m_pd3d11Buffer, StaticCast<UINT>(NewSize));
+    const auto Resized = pImmediateCtx->ResizeTilePool(m_pd3d11Buffer, StaticCast<UINT>(NewSize));
+    RecordGPUMemory(GetCapacity());
+    return Resized;
 }
 
 Uint64 DeviceMemoryD3D11Impl::GetCapacity() const
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "DynamicConstantRingD3D11.hpp"
+
+#include <cstring>
+
+#include "BufferD3D11Impl.hpp"
+
+namespace Diligent
+{
+
+DynamicConstantRingD3D11::DynamicConstantRingD3D11(IMemoryAllocator&    Allocator,
+                                                   ID3D11Device*        pd3d11Device,
+                                                   ID3D11DeviceContext* pd3d11Context,
+                                                   Uint32               Size) :
+    m_pd3d11Device{pd3d11Device},
+    m_pd3d11Context{pd3d11Context},
+    m_Ring{Size, Allocator}
+{
+    D3D11_BUFFER_DESC d3d11BuffDesc{};
+    d3d11BuffDesc.ByteWidth      = Size;
+    d3d11BuffDesc.Usage          = D3D11_USAGE_DYNAMIC;
+    d3d11BuffDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    d3d11BuffDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    CHECK_D3D_RESULT_THROW(m_pd3d11Device->CreateBuffer(&d3d11BuffDesc, nullptr, &m_pd3d11Buffer),
+                           "Failed to create the dynamic constant ring buffer");
+    static constexpr char RingName[] = "Dynamic constant ring";
+    m_pd3d11Buffer->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(sizeof(RingName) - 1), RingName);
+}
+
+DynamicConstantRingD3D11::~DynamicConstantRingD3D11()
+{
+    // The ring buffer object is kept alive by the D3D11 runtime while the GPU uses it
+    m_Ring.FinishCurrentFrame(m_FrameNumber);
+    m_Ring.ReleaseCompletedFrames(m_FrameNumber);
+}
+
+void DynamicConstantRingD3D11::Upload(BufferD3D11Impl& Buffer)
+{
+    VERIFY_EXPR(Buffer.UsesDynamicConstantRing());
+    const auto& Data = Buffer.m_ConstantRingData;
+
+    // Constant buffer offsets must be multiples of 16 constants
+    constexpr RingBuffer::OffsetType CBOffsetAlignment = 256;
+
+    auto Offset = m_Ring.Allocate(Data.size(), CBOffsetAlignment);
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        ReleaseCompletedFrames();
+        Offset = m_Ring.Allocate(Data.size(), CBOffsetAlignment);
+    }
+
+    D3D11_MAPPED_SUBRESOURCE MappedData{};
+    if (Offset != RingBuffer::InvalidOffset)
+    {
+        // The region has not been used since the GPU completed the frame that referenced it last time
+        if (SUCCEEDED(m_pd3d11Context->Map(m_pd3d11Buffer, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &MappedData)))
+        {
+            memcpy(reinterpret_cast<Uint8*>(MappedData.pData) + Offset, Data.data(), Data.size());
+            m_pd3d11Context->Unmap(m_pd3d11Buffer, 0);
+
+            auto& Alloc        = Buffer.m_ConstantRingAllocation;
+            Alloc.pd3d11Buffer = m_pd3d11Buffer;
+            Alloc.Offset       = StaticCast<Uint32>(Offset);
+            Alloc.FrameNumber  = m_FrameNumber;
+            return;
+        }
+        LOG_ERROR_MESSAGE("Failed to map the dynamic constant ring buffer");
+    }
+
+    // The ring is full: write the data to the buffer's own D3D11 buffer
+    if (SUCCEEDED(m_pd3d11Context->Map(Buffer.m_pd3d11Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MappedData)))
+    {
+        memcpy(MappedData.pData, Data.data(), Data.size());
+        m_pd3d11Context->Unmap(Buffer.m_pd3d11Buffer, 0);
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Failed to map buffer '", Buffer.GetDesc().Name, "'");
+    }
+    Buffer.m_ConstantRingAllocation = {};
+}
+
+void DynamicConstantRingD3D11::FinishFrame()
+{
+    m_Ring.FinishCurrentFrame(m_FrameNumber);
+
+    CComPtr<ID3D11Query> pd3d11Query;
+    if (!m_AvailableQueries.empty())
+    {
+        pd3d11Query = std::move(m_AvailableQueries.back());
+        m_AvailableQueries.pop_back();
+    }
+    else
+    {
+        D3D11_QUERY_DESC QueryDesc{D3D11_QUERY_EVENT, 0};
+        m_pd3d11Device->CreateQuery(&QueryDesc, &pd3d11Query);
+        DEV_CHECK_ERR(pd3d11Query, "Failed to create D3D11 event query");
+    }
+
+    if (pd3d11Query)
+    {
+        m_pd3d11Context->End(pd3d11Query);
+        m_PendingFrames.emplace_back(m_FrameNumber, std::move(pd3d11Query));
+    }
+    ++m_FrameNumber;
+
+    ReleaseCompletedFrames();
+}
+
+void DynamicConstantRingD3D11::ReleaseCompletedFrames()
+{
+    bool   FrameCompleted = false;
+    Uint64 CompletedFrame = 0;
+    while (!m_PendingFrames.empty())
+    {
+        auto& Frame = m_PendingFrames.front();
+
+        BOOL QueryData = FALSE;
+        if (m_pd3d11Context->GetData(Frame.second, &QueryData, sizeof(QueryData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK || !QueryData)
+            break;
+
+        FrameCompleted = true;
+        CompletedFrame = Frame.first;
+        m_AvailableQueries.emplace_back(std::move(Frame.second));
+        m_PendingFrames.pop_front();
+    }
+
+    if (FrameCompleted)
+        m_Ring.ReleaseCompletedFrames(CompletedFrame);
+}
+
+} // namespace Diligent
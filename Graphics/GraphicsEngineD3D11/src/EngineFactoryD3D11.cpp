@@ -178,6 +178,9 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
     *ppDevice = nullptr;
     memset(ppContexts, 0, sizeof(*ppContexts) * (size_t{std::max(1u, EngineCI.NumImmediateContexts)} + size_t{EngineCI.NumDeferredContexts}));
 
+    DeviceStartupTimer      StartupTimer;
+    DeviceStartupStatistics StartupStats;
+
     // This flag adds support for surfaces with a different color channel ordering
     // than the API default. It is required for compatibility with Direct2D.
     // D3D11_CREATE_DEVICE_BGRA_SUPPORT;
@@ -203,6 +206,8 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
         }
     }
 
+    StartupStats.AdapterQueryTime = StartupTimer.Lap();
+
     // Create the Direct3D 11 API device object and a corresponding context.
     CComPtr<ID3D11Device>        pd3d11Device;
     CComPtr<ID3D11DeviceContext> pd3d11Context;
@@ -232,7 +237,16 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
     if (!pd3d11Device)
         LOG_ERROR_AND_THROW("Failed to create d3d11 device and immediate context");
 
+    StartupStats.DeviceCreationTime = StartupTimer.Lap();
+
     AttachToD3D11Device(pd3d11Device, pd3d11Context, EngineCI, ppDevice, ppContexts);
+
+    if (*ppDevice != nullptr)
+    {
+        StartupStats.EngineObjectsCreationTime = StartupTimer.Lap();
+        StartupStats.TotalTime                 = StartupTimer.Total();
+        ClassPtrCast<RenderDeviceD3D11Impl>(*ppDevice)->SetStartupStatistics(StartupStats);
+    }
 }
 
 
@@ -301,7 +315,7 @@ void EngineFactoryD3D11Impl::AttachToD3D11Device(void*                        pd
         const auto AdapterInfo = GetGraphicsAdapterInfo(pd3d11NativeDevice, pDXGIAdapter1);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
-        SetRawAllocator(EngineCI.pRawMemAllocator);
+        SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
         auto& RawAllocator = GetRawAllocator();
 
         RenderDeviceD3D11Impl* pRenderDeviceD3D11{
@@ -438,7 +452,7 @@ GraphicsAdapterInfo EngineFactoryD3D11Impl::GetGraphicsAdapterInfo(void*
         }
         Features.ShaderFloat16 = ShaderFloat16Supported ? DEVICE_FEATURE_STATE_ENABLED : DEVICE_FEATURE_STATE_DISABLED;
     }
-    ASSERT_SIZEOF(Features, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(Features, 42, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     // Texture properties
     {
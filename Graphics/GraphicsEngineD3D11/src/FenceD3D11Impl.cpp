@@ -45,6 +45,8 @@ FenceD3D11Impl::FenceD3D11Impl(IReferenceCounters*    pRefCounters,
 
 FenceD3D11Impl::~FenceD3D11Impl()
 {
+    UnregisterCompletionCallbacks();
+
     if (m_MaxPendingQueries < 10)
         LOG_INFO_MESSAGE("Max pending queries: ", m_MaxPendingQueries);
     else
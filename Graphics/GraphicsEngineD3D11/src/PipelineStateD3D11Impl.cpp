@@ -41,7 +41,6 @@
 #include "RenderPassD3D11Impl.hpp"
 
 #include "EngineMemory.h"
-#include "DXBCUtils.hpp"
 #include "D3DShaderResourceValidation.hpp"
 
 namespace Diligent
@@ -122,7 +121,6 @@ void PipelineStateD3D11Impl::RemapOrVerifyShaderResources(const TShaderStages&
     {
         auto* const pShader    = Shaders[s];
         auto const  ShaderType = pShader->GetDesc().ShaderType;
-        auto* const pBytecode  = Shaders[s]->GetD3DBytecode();
 
         ResourceBinding::TMap ResourceMap;
         for (Uint32 sign = 0; sign < SignatureCount; ++sign)
@@ -140,11 +138,9 @@ void PipelineStateD3D11Impl::RemapOrVerifyShaderResources(const TShaderStages&
 
         if (HandleRemappedBytecodeFn)
         {
-            CComPtr<ID3DBlob> pPatchedBytecode;
-            D3DCreateBlob(pBytecode->GetBufferSize(), &pPatchedBytecode);
-            memcpy(pPatchedBytecode->GetBufferPointer(), pBytecode->GetBufferPointer(), pBytecode->GetBufferSize());
-
-            if (!DXBCUtils::RemapResourceBindings(ResourceMap, pPatchedBytecode->GetBufferPointer(), pPatchedBytecode->GetBufferSize()))
+            // The shader caches the binding locations, so the byte code is only parsed once
+            auto pPatchedBytecode = pShader->GetRemappedBytecode(ResourceMap, nullptr);
+            if (!pPatchedBytecode)
                 LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
 
             HandleRemappedBytecodeFn(s, pShader, pPatchedBytecode);
@@ -303,40 +299,44 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*
 {
     try
     {
-        CComPtr<ID3DBlob> pVSByteCode;
-        InitInternalObjects(CreateInfo, pVSByteCode);
-
-        if (GetD3D11VertexShader() == nullptr)
-            LOG_ERROR_AND_THROW("Vertex shader is null");
-
-        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
-        auto* const pDeviceD3D11     = pRenderDeviceD3D11->GetD3D11Device();
-
-        D3D11_BLEND_DESC D3D11BSDesc = {};
-        BlendStateDesc_To_D3D11_BLEND_DESC(GraphicsPipeline.BlendDesc, D3D11BSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateBlendState(&D3D11BSDesc, &m_pd3d11BlendState),
-                               "Failed to create D3D11 blend state object");
-
-        D3D11_RASTERIZER_DESC D3D11RSDesc = {};
-        RasterizerStateDesc_To_D3D11_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, D3D11RSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateRasterizerState(&D3D11RSDesc, &m_pd3d11RasterizerState),
-                               "Failed to create D3D11 rasterizer state");
-
-        D3D11_DEPTH_STENCIL_DESC D3D11DSSDesc = {};
-        DepthStencilStateDesc_To_D3D11_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, D3D11DSSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateDepthStencilState(&D3D11DSSDesc, &m_pd3d11DepthStencilState),
-                               "Failed to create D3D11 depth stencil state");
-
-        // Create input layout
-        const auto& InputLayout = GraphicsPipeline.InputLayout;
-        if (InputLayout.NumElements > 0)
-        {
-            std::vector<D3D11_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D11_INPUT_ELEMENT_DESC>> d311InputElements(STD_ALLOCATOR_RAW_MEM(D3D11_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D11_INPUT_ELEMENT_DESC>"));
-            LayoutElements_To_D3D11_INPUT_ELEMENT_DESCs(InputLayout, d311InputElements);
-
-            CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateInputLayout(d311InputElements.data(), static_cast<UINT>(d311InputElements.size()), pVSByteCode->GetBufferPointer(), pVSByteCode->GetBufferSize(), &m_pd3d11InputLayout),
-                                   "Failed to create the Direct3D11 input layout");
-        }
+        InitializePipeline(CreateInfo,
+                           [this](const GraphicsPipelineStateCreateInfo& CI) //
+                           {
+                               CComPtr<ID3DBlob> pVSByteCode;
+                               InitInternalObjects(CI, pVSByteCode);
+
+                               if (GetD3D11VertexShader() == nullptr)
+                                   LOG_ERROR_AND_THROW("Vertex shader is null");
+
+                               const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+                               auto* const pDeviceD3D11     = m_pDevice->GetD3D11Device();
+
+                               D3D11_BLEND_DESC D3D11BSDesc = {};
+                               BlendStateDesc_To_D3D11_BLEND_DESC(GraphicsPipeline.BlendDesc, D3D11BSDesc);
+                               CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateBlendState(&D3D11BSDesc, &m_pd3d11BlendState),
+                                                      "Failed to create D3D11 blend state object");
+
+                               D3D11_RASTERIZER_DESC D3D11RSDesc = {};
+                               RasterizerStateDesc_To_D3D11_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, D3D11RSDesc);
+                               CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateRasterizerState(&D3D11RSDesc, &m_pd3d11RasterizerState),
+                                                      "Failed to create D3D11 rasterizer state");
+
+                               D3D11_DEPTH_STENCIL_DESC D3D11DSSDesc = {};
+                               DepthStencilStateDesc_To_D3D11_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, D3D11DSSDesc);
+                               CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateDepthStencilState(&D3D11DSSDesc, &m_pd3d11DepthStencilState),
+                                                      "Failed to create D3D11 depth stencil state");
+
+                               // Create input layout
+                               const auto& InputLayout = GraphicsPipeline.InputLayout;
+                               if (InputLayout.NumElements > 0)
+                               {
+                                   std::vector<D3D11_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D11_INPUT_ELEMENT_DESC>> d311InputElements(STD_ALLOCATOR_RAW_MEM(D3D11_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D11_INPUT_ELEMENT_DESC>"));
+                                   LayoutElements_To_D3D11_INPUT_ELEMENT_DESCs(InputLayout, d311InputElements);
+
+                                   CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateInputLayout(d311InputElements.data(), static_cast<UINT>(d311InputElements.size()), pVSByteCode->GetBufferPointer(), pVSByteCode->GetBufferSize(), &m_pd3d11InputLayout),
+                                                          "Failed to create the Direct3D11 input layout");
+                               }
+                           });
     }
     catch (...)
     {
@@ -352,9 +352,13 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*
 {
     try
     {
-        CComPtr<ID3DBlob> pVSByteCode;
-        InitInternalObjects(CreateInfo, pVSByteCode);
-        VERIFY(!pVSByteCode, "There must be no VS in a compute pipeline.");
+        InitializePipeline(CreateInfo,
+                           [this](const ComputePipelineStateCreateInfo& CI) //
+                           {
+                               CComPtr<ID3DBlob> pVSByteCode;
+                               InitInternalObjects(CI, pVSByteCode);
+                               VERIFY(!pVSByteCode, "There must be no VS in a compute pipeline.");
+                           });
     }
     catch (...)
     {
@@ -370,6 +374,8 @@ PipelineStateD3D11Impl::~PipelineStateD3D11Impl()
 
 void PipelineStateD3D11Impl::Destruct()
 {
+    FinishAsyncInitialization();
+
     m_pd3d11BlendState.Release();
     m_pd3d11RasterizerState.Release();
     m_pd3d11DepthStencilState.Release();
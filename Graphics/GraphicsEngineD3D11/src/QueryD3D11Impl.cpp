@@ -141,15 +141,14 @@ bool QueryD3D11Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
                 // Note: DataReady is a return value, so we query the counter first, and then check pData for null.
                 if (DataReady && pData != nullptr)
                 {
-                    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT DisjointQueryData;
-                    DataReady = pd3d11Ctx->GetData(m_DisjointQuery->pd3d11Query, &DisjointQueryData, sizeof(DisjointQueryData), 0) == S_OK;
+                    DataReady = m_DisjointQuery->GetData(pd3d11Ctx);
 
                     if (DataReady)
                     {
                         auto& QueryData   = *reinterpret_cast<QueryDataTimestamp*>(pData);
                         QueryData.Counter = Counter;
                         // The timestamp returned by ID3D11DeviceContext::GetData for a timestamp query is only reliable if Disjoint is FALSE.
-                        QueryData.Frequency = DisjointQueryData.Disjoint ? 0 : DisjointQueryData.Frequency;
+                        QueryData.Frequency = m_DisjointQuery->Data.Disjoint ? 0 : m_DisjointQuery->Data.Frequency;
                     }
                 }
             }
@@ -201,8 +200,7 @@ bool QueryD3D11Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
                     // Note: DataReady is a return value, so we query the counters first, and then check pData for null.
                     if (DataReady && pData != nullptr)
                     {
-                        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT DisjointQueryData;
-                        DataReady = pd3d11Ctx->GetData(m_DisjointQuery->pd3d11Query, &DisjointQueryData, sizeof(DisjointQueryData), 0) == S_OK;
+                        DataReady = m_DisjointQuery->GetData(pd3d11Ctx);
 
                         if (DataReady)
                         {
@@ -210,7 +208,7 @@ bool QueryD3D11Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
                             VERIFY_EXPR(EndCounter >= StartCounter);
                             QueryData.Duration = EndCounter - StartCounter;
                             // The timestamp returned by ID3D11DeviceContext::GetData for a timestamp query is only reliable if Disjoint is FALSE.
-                            QueryData.Frequency = DisjointQueryData.Disjoint ? 0 : DisjointQueryData.Frequency;
+                            QueryData.Frequency = m_DisjointQuery->Data.Disjoint ? 0 : m_DisjointQuery->Data.Frequency;
                         }
                     }
                 }
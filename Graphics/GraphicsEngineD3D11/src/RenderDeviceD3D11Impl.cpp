@@ -48,6 +48,7 @@
 
 #include "D3D11TypeConversions.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -110,6 +111,22 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
 
     // Initialize device features
     m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
+
+    if (EngineCI.DynamicConstantRingSize != 0)
+    {
+        // Suballocating constants from a ring requires mapping dynamic constant buffers with
+        // D3D11_MAP_WRITE_NO_OVERWRITE and binding them with offsets (Direct3D11.1).
+        D3D11_FEATURE_DATA_D3D11_OPTIONS d3d11Options{};
+        if (SUCCEEDED(m_pd3d11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &d3d11Options, sizeof(d3d11Options))) &&
+            d3d11Options.ConstantBufferOffsetting && d3d11Options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            m_DynamicConstantRingSize = AlignUp(EngineCI.DynamicConstantRingSize, Uint32{D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16});
+        }
+        else
+        {
+            LOG_INFO_MESSAGE("The device does not support mapping dynamic constant buffers with D3D11_MAP_WRITE_NO_OVERWRITE: dynamic constant ring is disabled.");
+        }
+    }
 }
 
 RenderDeviceD3D11Impl::~RenderDeviceD3D11Impl()
@@ -276,6 +293,11 @@ void RenderDeviceD3D11Impl::CreateGraphicsPipelineState(const GraphicsPipelineSt
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
+void RenderDeviceD3D11Impl::CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
+{
+    CreateDerivedGraphicsPipelineStateImpl(CreateInfo, ppPipelineState);
+}
+
 void RenderDeviceD3D11Impl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
@@ -29,6 +29,7 @@
 
 #include "ShaderD3D11Impl.hpp"
 #include "RenderDeviceD3D11Impl.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -99,13 +100,25 @@ ShaderD3D11Impl::ShaderD3D11Impl(IReferenceCounters*     pRefCounters,
         D3D11ShaderCI.DeviceInfo,
         D3D11ShaderCI.AdapterInfo,
         IsDeviceInternal
-    },
-    ShaderD3DBase{ShaderCI, GetD3D11ShaderModel(D3D11ShaderCI.FeatureLevel, ShaderCI.HLSLVersion), nullptr}
+    }
 // clang-format on
 {
+    InitializeShader(ShaderCI,
+                     [this, D3D11ShaderCI](const ShaderCreateInfo& CI) //
+                     {
+                         Initialize(CI, D3D11ShaderCI);
+                     });
+}
+
+void ShaderD3D11Impl::Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& D3D11ShaderCI) noexcept(false)
+{
+    ShaderD3DBase::Initialize(ShaderCI, GetD3D11ShaderModel(D3D11ShaderCI.FeatureLevel, ShaderCI.HLSLVersion), nullptr);
+
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
+        CompilationStageTimer Timer{COMPILATION_STAGE_REFLECTION};
+
         auto& Allocator  = GetRawAllocator();
         auto* pRawMem    = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D11, 1);
         auto* pResources = new (pRawMem) ShaderResourcesD3D11{m_pShaderByteCode, m_Desc, m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr};
@@ -115,6 +128,7 @@ ShaderD3D11Impl::ShaderD3D11Impl(IReferenceCounters*     pRefCounters,
 
 ShaderD3D11Impl::~ShaderD3D11Impl()
 {
+    FinishAsyncCompilation();
 }
 
 void ShaderD3D11Impl::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
@@ -148,6 +162,8 @@ ID3D11DeviceChild* ShaderD3D11Impl::GetD3D11Shader(ID3DBlob* pBlob) noexcept(fal
 
     auto* pd3d11Device = GetDevice()->GetD3D11Device();
 
+    CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
+
     CComPtr<ID3D11DeviceChild> pd3d11Shader;
     switch (m_Desc.ShaderType)
     {
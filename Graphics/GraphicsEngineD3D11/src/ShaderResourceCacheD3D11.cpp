@@ -336,7 +336,7 @@ void ShaderResourceCacheD3D11::DbgVerifyDynamicBufferMasks() const
             const auto  BuffBit = 1u << i;
             const auto& CB      = CBArrays.first[i];
 
-            const auto IsDynamicOffset = CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & BuffBit) != 0;
+            const auto IsDynamicOffset = (CB.AllowsDynamicOffset() || CB.UsesDynamicConstantRing()) && (m_DynamicCBSlotsMask[ShaderInd] & BuffBit) != 0;
             VERIFY(IsDynamicOffset == ((m_DynamicCBOffsetsMask[ShaderInd] & BuffBit) != 0), "Bit ", i, " in m_DynamicCBOffsetsMask is not valid");
         }
     }
@@ -152,7 +152,9 @@ void SwapChainD3D11Impl::Present(Uint32 SyncInterval)
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
     WaitForFrame();
 
+    const Uint64 PresentQPCTime = GetQPCTime();
     m_pSwapChain->Present(SyncInterval, 0);
+    UpdateFramePacingStats(PresentQPCTime, SyncInterval);
 }
 
 void SwapChainD3D11Impl::UpdateSwapChain(bool CreateNew)
@@ -90,6 +90,9 @@ Texture1D_D3D11::Texture1D_D3D11(IReferenceCounters*        pRefCounters,
 
     if (m_Desc.Usage == USAGE_SPARSE)
         InitSparseProperties();
+
+    // Direct3D11 does not expose the allocation size, so the texel data size is reported
+    RecordGPUMemory(m_Desc.Usage == USAGE_SPARSE ? GPU_MEMORY_ALLOCATION_TYPE_PLACED : GPU_MEMORY_ALLOCATION_TYPE_COMMITTED);
 }
 
 namespace
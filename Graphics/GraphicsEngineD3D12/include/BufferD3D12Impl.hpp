@@ -35,6 +35,7 @@
 #include "BufferViewD3D12Impl.hpp" // Required by BufferBase
 #include "D3D12ResourceBase.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12MemoryManager.hpp"
 #include "DescriptorHeap.hpp"
 #include "IndexWrapper.hpp"
 
@@ -127,6 +128,9 @@ private:
 
     DescriptorHeapAllocation m_CBVDescriptorAllocation;
 
+    // Heap memory that hosts the buffer if it is a placed resource
+    D3D12MemoryAllocation m_MemoryAllocation;
+
     // Align the struct size to the cache line size to avoid false sharing
     static constexpr size_t CacheLineSize = 64;
     struct alignas(CacheLineSize) CtxDynamicData : D3D12DynamicAllocation
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::BufferViewD3D12Impl class
 
+#include <atomic>
+
 #include "EngineD3D12ImplTraits.hpp"
 #include "BufferViewBase.hpp"
 #include "DescriptorHeap.hpp"
@@ -60,9 +62,24 @@ public:
         return m_DescriptorHandle.GetCpuHandle();
     }
 
+    /// Returns the index of the view descriptor in the shader-visible CBV/SRV/UAV heap.
+    /// The descriptor is copied to the heap when the method is called for the first time.
+    Uint32 GetBindlessDescriptorIndex()
+    {
+        const auto Index = m_BindlessDescriptorIndex.load(std::memory_order_acquire);
+        return Index != GPUDescriptorHeap::InvalidDescriptorIndex ? Index : CreateBindlessDescriptor();
+    }
+
+private:
+    Uint32 CreateBindlessDescriptor();
+
 protected:
     // Allocation in a CPU-only descriptor heap
     DescriptorHeapAllocation m_DescriptorHandle;
+
+    // Persistent slot in the shader-visible heap used by bindless resources
+    DescriptorHeapAllocation m_BindlessDescriptor;
+    std::atomic<Uint32>      m_BindlessDescriptorIndex{GPUDescriptorHeap::InvalidDescriptorIndex};
 };
 
 } // namespace Diligent
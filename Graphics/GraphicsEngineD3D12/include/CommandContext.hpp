@@ -82,6 +82,11 @@ public:
     ID3D12GraphicsCommandList* Close(CComPtr<ID3D12CommandAllocator>& pAllocator);
     void                       Reset(CommandListManager& CmdListManager);
 
+    // Flushes pending barriers and closes the command list without releasing the allocator.
+    // Deferred contexts call this method on the recording thread, so that Close() called
+    // by the immediate context when the command list is executed is cheap.
+    void CloseCommandList();
+
     class GraphicsContext&  AsGraphicsContext();
     class GraphicsContext1& AsGraphicsContext1();
     class GraphicsContext2& AsGraphicsContext2();
@@ -89,6 +94,7 @@ public:
     class GraphicsContext4& AsGraphicsContext4();
     class GraphicsContext5& AsGraphicsContext5();
     class GraphicsContext6& AsGraphicsContext6();
+    class GraphicsContext10& AsGraphicsContext10();
     class ComputeContext&   AsComputeContext();
 
     void ClearUAVFloat(D3D12_GPU_DESCRIPTOR_HANDLE GpuHandle,
@@ -111,6 +117,7 @@ public:
 
     void CopyResource(ID3D12Resource* pDstRes, ID3D12Resource* pSrcRes)
     {
+        FlushResourceBarriers();
         m_pCommandList->CopyResource(pDstRes, pSrcRes);
     }
 
@@ -126,6 +133,15 @@ public:
 
     //void BeginResourceTransition(GpuResource& Resource, D3D12_RESOURCE_STATES NewState, bool FlushImmediate = false);
 
+    // Adds the resource to the residency set of the command list (see ResidencyManagerD3D12)
+    template <typename ResourceImplType>
+    void TrackResidency(ResourceImplType& Resource)
+    {
+        m_ResidencySet.Add(Resource.GetResidencyHandle(), &Resource);
+    }
+
+    ResidencyManagerD3D12::ResidencySet& GetResidencySet() { return m_ResidencySet; }
+
     void ResolveSubresource(ID3D12Resource* pDstResource,
                             UINT            DstSubresource,
                             ID3D12Resource* pSrcResource,
@@ -136,13 +152,23 @@ public:
         m_pCommandList->ResolveSubresource(pDstResource, DstSubresource, pSrcResource, SrcSubresource, Format);
     }
 
+    // Pending barriers must be flushed before any command that accesses resources
     void FlushResourceBarriers()
     {
-        if (!m_PendingResourceBarriers.empty())
-        {
+        if (m_PendingResourceBarriers.empty())
+            return;
+
+        if (m_pStatistics != nullptr)
+            m_pStatistics->BarrierCount += m_PendingResourceBarriers.size();
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        if (m_UseEnhancedBarriers)
+            FlushEnhancedBarriers();
+        else
+#endif
             m_pCommandList->ResourceBarrier(static_cast<UINT>(m_PendingResourceBarriers.size()), m_PendingResourceBarriers.data());
-            m_PendingResourceBarriers.clear();
-        }
+
+        m_PendingResourceBarriers.clear();
     }
 
 
@@ -186,13 +212,13 @@ public:
     {
         VERIFY(m_DynamicGPUDescriptorAllocators != nullptr, "Dynamic GPU descriptor allocators have not been initialized. Did you forget to call SetDynamicGPUDescriptorAllocators() after resetting the context?");
         VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type <= D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, "Invalid heap type");
+        if (m_pStatistics != nullptr)
+            m_pStatistics->DynamicDescriptorCount += Count;
         return m_DynamicGPUDescriptorAllocators[Type].Allocate(Count);
     }
 
-    void ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier)
-    {
-        m_PendingResourceBarriers.emplace_back(Barrier);
-    }
+    // Adds the barrier to the pending batch, merging it with the pending barriers for the same resource when possible.
+    void ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier);
 
     void SetPipelineState(ID3D12PipelineState* pPSO)
     {
@@ -208,6 +234,12 @@ public:
         m_DynamicGPUDescriptorAllocators = Allocators;
     }
 
+    // Sets the device context statistics that the command context updates (may be null)
+    void SetStatistics(DeviceContextStatistics* pStatistics)
+    {
+        m_pStatistics = pStatistics;
+    }
+
     void BeginQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index)
     {
         m_pCommandList->BeginQuery(pQueryHeap, Type, Index);
@@ -252,19 +284,41 @@ public:
 protected:
     void InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate = false);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Translates pending legacy barriers into enhanced barriers and records them
+    void FlushEnhancedBarriers();
+#endif
+
     CComPtr<ID3D12GraphicsCommandList> m_pCommandList;
     CComPtr<ID3D12CommandAllocator>    m_pCurrentAllocator;
 
+    // Indicates that the command list has been closed by CloseCommandList()
+    bool m_IsListClosed = false;
+
     void*                m_pCurPipelineState         = nullptr;
     ID3D12RootSignature* m_pCurGraphicsRootSignature = nullptr;
     ID3D12RootSignature* m_pCurComputeRootSignature  = nullptr;
 
     std::vector<D3D12_RESOURCE_BARRIER, STDAllocatorRawMem<D3D12_RESOURCE_BARRIER>> m_PendingResourceBarriers;
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Enhanced barriers are used when the device supports them and the command list implements ID3D12GraphicsCommandList7
+    bool m_UseEnhancedBarriers = false;
+
+    std::vector<D3D12_TEXTURE_BARRIER> m_TextureBarriers;
+    std::vector<D3D12_BUFFER_BARRIER>  m_BufferBarriers;
+    std::vector<D3D12_GLOBAL_BARRIER>  m_GlobalBarriers;
+#endif
+
     ShaderDescriptorHeaps m_BoundDescriptorHeaps;
 
     DynamicSuballocationsManager* m_DynamicGPUDescriptorAllocators = nullptr;
 
+    DeviceContextStatistics* m_pStatistics = nullptr;
+
+    // Committed resources referenced by the command list
+    ResidencyManagerD3D12::ResidencySet m_ResidencySet;
+
     String m_ID;
 
     D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
@@ -372,6 +426,13 @@ class GraphicsContext1 : public GraphicsContext
 
 class GraphicsContext2 : public GraphicsContext1
 {
+public:
+    void WriteBufferImmediate(UINT                                        Count,
+                              const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER* pParams,
+                              const D3D12_WRITEBUFFERIMMEDIATE_MODE*      pModes)
+    {
+        static_cast<ID3D12GraphicsCommandList2*>(m_pCommandList.p)->WriteBufferImmediate(Count, pParams, pModes);
+    }
 };
 
 class GraphicsContext3 : public GraphicsContext2
@@ -472,6 +533,27 @@ public:
     }
 };
 
+class GraphicsContext10 : public GraphicsContext6
+{
+public:
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+    void SetProgram(const D3D12_SET_PROGRAM_DESC& Desc, ID3D12StateObject* pStateObject)
+    {
+        // The program description also carries backing memory and initialization
+        // flags, so it is always set, but the state object is tracked to make sure
+        // that the next SetPipelineState() call is not skipped.
+        static_cast<ID3D12GraphicsCommandList10*>(m_pCommandList.p)->SetProgram(&Desc);
+        m_pCurPipelineState = pStateObject;
+    }
+
+    void DispatchGraph(const D3D12_DISPATCH_GRAPH_DESC& Desc)
+    {
+        FlushResourceBarriers();
+        static_cast<ID3D12GraphicsCommandList10*>(m_pCommandList.p)->DispatchGraph(&Desc);
+    }
+#endif
+};
+
 inline GraphicsContext& CommandContext::AsGraphicsContext()
 {
     return static_cast<GraphicsContext&>(*this);
@@ -513,6 +595,12 @@ inline GraphicsContext6& CommandContext::AsGraphicsContext6()
     return static_cast<GraphicsContext6&>(*this);
 }
 
+inline GraphicsContext10& CommandContext::AsGraphicsContext10()
+{
+    VERIFY(m_MaxInterfaceVer >= 10, "Maximum supported interface version is ", m_MaxInterfaceVer);
+    return static_cast<GraphicsContext10&>(*this);
+}
+
 inline ComputeContext& CommandContext::AsComputeContext()
 {
     return static_cast<ComputeContext&>(*this);
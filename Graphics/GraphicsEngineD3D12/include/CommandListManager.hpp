@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include <mutex>
 #include <atomic>
@@ -54,8 +55,14 @@ public:
     // Returns the maximum supported interface version
     void CreateNewCommandList(ID3D12GraphicsCommandList** ppList, ID3D12CommandAllocator** ppAllocator, Uint32& IfaceVersion);
 
+    // Free allocators are kept in per-thread pools: a thread first takes allocators from its own pool,
+    // and only accesses the pools of other threads when its pool is empty. Allocators are always
+    // returned to the pool of the thread that created them, so that threads that record commands
+    // concurrently (e.g. deferred contexts) do not contend for the same lock.
     void RequestAllocator(ID3D12CommandAllocator** ppAllocator);
     void ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
+    // Releases multiple allocators used by the same submission
+    void ReleaseAllocators(CComPtr<ID3D12CommandAllocator>* pAllocators, size_t NumAllocators, SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
 
     // Returns allocator to the list of available allocators. The GPU must have finished using the
     // allocator
@@ -73,9 +80,24 @@ public:
         return m_CmdListType;
     }
 
+    RenderDeviceD3D12Impl& GetDevice() const
+    {
+        return m_DeviceD3D12Impl;
+    }
+
 private:
-    std::mutex                                                                                        m_AllocatorMutex;
-    std::vector<CComPtr<ID3D12CommandAllocator>, STDAllocatorRawMem<CComPtr<ID3D12CommandAllocator>>> m_FreeAllocators;
+    static Uint32 GetThreadPoolIndex();
+
+    CComPtr<ID3D12CommandAllocator> PopFreeAllocator(Uint32 PoolIdx, bool Wait);
+
+    static constexpr Uint32 NumThreadPools = 16;
+
+    struct ThreadAllocatorPool
+    {
+        std::mutex                                   Mtx;
+        std::vector<CComPtr<ID3D12CommandAllocator>> FreeAllocators;
+    };
+    std::array<ThreadAllocatorPool, NumThreadPools> m_ThreadPools;
 
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
@@ -82,13 +82,23 @@ public:
     virtual void DILIGENT_CALL_TYPE UpdateTileMappings(ResourceTileMappingsD3D12* pMappings,
                                                        Uint32                     Count) override final;
 
+    // Returns true if the device removal has been detected by the queue.
+    bool IsDeviceRemoved() const
+    {
+        return m_DeviceRemoved.load();
+    }
+
 private:
+    void CheckDeviceRemoved(HRESULT hr);
+
     // A value that will be signaled by the command queue next
     std::atomic<Uint64> m_NextFenceValue{1};
 
     // Last fence value completed by the GPU
     std::atomic<Uint64> m_LastCompletedFenceValue{0};
 
+    std::atomic<bool> m_DeviceRemoved{false};
+
     std::mutex                  m_QueueMtx;
     CComPtr<ID3D12CommandQueue> m_pd3d12CmdQueue;
 
@@ -31,6 +31,12 @@
 #include <map>
 #include <deque>
 #include <atomic>
+#include <array>
+#include <vector>
+
+#include "SpinLock.hpp"
+#include "DynamicHeapPageSizer.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -76,7 +82,7 @@ struct D3D12DynamicAllocation
 class D3D12DynamicPage
 {
 public:
-    D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size);
+    D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size, GPUMemoryTracker* pGPUMemoryTracker);
 
     // clang-format off
     D3D12DynamicPage            (const D3D12DynamicPage&)  = delete;
@@ -116,9 +122,19 @@ private:
     CComPtr<ID3D12Resource>   m_pd3d12Buffer;
     void*                     m_CPUVirtualAddress = nullptr; // The CPU-writeable address
     D3D12_GPU_VIRTUAL_ADDRESS m_GPUVirtualAddress = 0;       // The GPU-visible address
+    GPUMemoryRecord           m_GPUMemoryRecord;
 };
 
 
+// Dynamic memory manager keeps free pages in fixed size classes. Class C holds pages of
+// PageSize << C bytes, which are the sizes that D3D12DynamicHeap requests. Every class is
+// protected by its own spin lock, so contexts that request pages at the same time rarely contend.
+// Pages of other sizes are kept in a separate map.
+//
+// A dynamic heap may also register as a page owner. Pages that an owner releases come back to
+// its own pinned list (up to the specified limit) once the GPU is done with them, and the owner
+// takes pages from this list first. This lets a context reuse the same pages every frame without
+// going through the shared lists at all.
 class D3D12DynamicMemoryManager
 {
 public:
@@ -135,11 +151,38 @@ public:
     D3D12DynamicMemoryManager& operator= (      D3D12DynamicMemoryManager&&) = delete;
     // clang-format on
 
-    void ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask);
+    static constexpr Uint32 InvalidOwnerId = ~0u;
+
+    // Registers a new page owner that keeps up to MaxPinnedPages pages across frames.
+    // Returns InvalidOwnerId if MaxPinnedPages is zero or all owner slots are in use.
+    Uint32 RegisterPageOwner(Uint32 MaxPinnedPages);
+    // Returns the pinned pages of the owner to the shared lists
+    void UnregisterPageOwner(Uint32 OwnerId);
+    // Returns the pinned pages of the owner to the shared lists, but keeps the owner registered.
+    // This is used when the owner changes its page size and the pinned pages no longer match it.
+    void ReleasePinnedPages(Uint32 OwnerId);
+
+    // Returns the size of the pages in the largest page class
+    Uint64 GetMaxPageClassSize() const { return m_PageSize << (NumPageClasses - 1); }
+
+    void ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask, Uint32 OwnerId = InvalidOwnerId);
 
     void Destroy();
 
-    D3D12DynamicPage AllocatePage(Uint64 SizeInBytes);
+    D3D12DynamicPage AllocatePage(Uint64 SizeInBytes, Uint32 OwnerId = InvalidOwnerId);
+
+    struct Stats
+    {
+        // The number of pages that were created
+        Uint32 NumCreatedPages = 0;
+
+        // The number of page requests served from the pinned lists of page owners
+        Uint64 NumPinnedPageHits = 0;
+
+        // The number of page requests served from the shared lists
+        Uint64 NumSharedPageHits = 0;
+    };
+    Stats GetStats() const;
 
 #ifdef DILIGENT_DEVELOPMENT
     Int32 GetAllocatedPageCounter() const
@@ -148,13 +191,48 @@ public:
     }
 #endif
 
+private:
+    // Returns the page class index for the given page size, or NumPageClasses if the size
+    // does not match any class.
+    Uint32 GetPageClass(Uint64 PageSize) const;
+
+    // Returns a page that is no longer used by the GPU to the owner's pinned list or to the shared lists
+    void ReturnPage(D3D12DynamicPage&& Page, Uint32 OwnerId);
+    void ReturnPageToSharedList(D3D12DynamicPage&& Page);
+
 private:
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
+    const Uint64 m_PageSize;
+
+    static constexpr Uint32 NumPageClasses = 8;
+    struct PageClass
+    {
+        Threading::SpinLock           Lock;
+        std::vector<D3D12DynamicPage> Pages;
+    };
+    std::array<PageClass, NumPageClasses> m_PageClasses;
+
+    static constexpr Uint32 MaxPageOwners = 64;
+    struct PinnedPageList
+    {
+        Threading::SpinLock           Lock;
+        std::vector<D3D12DynamicPage> Pages;
+        Uint32                        MaxPages = 0;
+        bool                          IsActive = false;
+    };
+    std::array<PinnedPageList, MaxPageOwners> m_PinnedPages;
+    std::mutex                                m_PageOwnersMtx;
+
+    // Pages whose size does not match any page class
     std::mutex m_AvailablePagesMtx;
     using AvailablePagesMapElemType = std::pair<const Uint64, D3D12DynamicPage>;
     std::multimap<Uint64, D3D12DynamicPage, std::less<Uint64>, STDAllocatorRawMem<AvailablePagesMapElemType>> m_AvailablePages;
 
+    std::atomic<Uint32> m_NumCreatedPages{0};
+    std::atomic<Uint64> m_NumPinnedPageHits{0};
+    std::atomic<Uint64> m_NumSharedPageHits{0};
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedPageCounter = 0;
 #endif
@@ -164,10 +242,20 @@ private:
 class D3D12DynamicHeap
 {
 public:
-    D3D12DynamicHeap(D3D12DynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint64 PageSize) :
+    // NumPinnedPages is the number of pages that the heap keeps across frames, see D3D12DynamicMemoryManager.
+    // When AdaptivePageSize is true, PageSize is the minimum page size, and the heap adapts
+    // the page size to the per-frame usage, see DynamicHeapPageSizer.
+    D3D12DynamicHeap(D3D12DynamicMemoryManager& DynamicMemMgr,
+                     std::string                HeapName,
+                     Uint64                     PageSize,
+                     Uint32                     NumPinnedPages   = 0,
+                     bool                       AdaptivePageSize = false) :
         m_GlobalDynamicMemMgr{DynamicMemMgr},
         m_HeapName{std::move(HeapName)},
-        m_PageSize{PageSize}
+        m_PageSize{PageSize},
+        m_PageOwnerId{DynamicMemMgr.RegisterPageOwner(NumPinnedPages)},
+        m_AdaptivePageSize{AdaptivePageSize},
+        m_PageSizer{PageSize, DynamicMemMgr.GetMaxPageClassSize(), PageSize}
     {}
 
     // clang-format off
@@ -186,13 +274,39 @@ public:
 
     size_t GetAllocatedPagesCount() const { return m_AllocatedPages.size(); }
 
+    struct Stats
+    {
+        // Memory used/allocated in the current frame
+        Uint64 CurrUsedSize      = 0;
+        Uint64 CurrAllocatedSize = 0;
+
+        // Memory used/allocated in the last finished frame
+        Uint64 LastFrameUsedSize      = 0;
+        Uint64 LastFrameAllocatedSize = 0;
+
+        // Peak memory used/allocated in a single frame
+        Uint64 PeakFrameUsedSize      = 0;
+        Uint64 PeakFrameAllocatedSize = 0;
+
+        // The number of finished frames
+        Uint64 NumFrames = 0;
+
+        // The current page size
+        Uint64 PageSize = 0;
+    };
+    Stats GetStats() const;
+
 private:
     D3D12DynamicMemoryManager& m_GlobalDynamicMemMgr;
     const std::string          m_HeapName;
 
     std::vector<D3D12DynamicPage> m_AllocatedPages;
 
-    const Uint64 m_PageSize;
+    Uint64       m_PageSize;
+    const Uint32 m_PageOwnerId;
+
+    const bool           m_AdaptivePageSize;
+    DynamicHeapPageSizer m_PageSizer;
 
     Uint64 m_CurrOffset    = InvalidOffset;
     Uint64 m_AvailableSize = 0;
@@ -203,6 +317,10 @@ private:
     Uint64 m_PeakAllocatedSize = 0;
     Uint64 m_PeakUsedSize      = 0;
     Uint64 m_PeakAlignedSize   = 0;
+
+    Uint64 m_LastFrameUsedSize      = 0;
+    Uint64 m_LastFrameAllocatedSize = 0;
+    Uint64 m_NumFrames              = 0;
 };
 
 } // namespace Diligent
@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D12MemoryManager class
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <atomic>
+
+#include "MemoryAllocator.h"
+#include "VariableSizeAllocationsManager.hpp"
+#include "HashUtils.hpp"
+#include "GPUMemoryTracker.hpp"
+
+namespace Diligent
+{
+
+class D3D12MemoryPage;
+class D3D12MemoryManager;
+
+/// Memory range in a D3D12 heap that hosts a placed resource.
+struct D3D12MemoryAllocation
+{
+    D3D12MemoryAllocation() noexcept {}
+
+    // clang-format off
+    D3D12MemoryAllocation            (const D3D12MemoryAllocation&) = delete;
+    D3D12MemoryAllocation& operator= (const D3D12MemoryAllocation&) = delete;
+
+    D3D12MemoryAllocation(D3D12MemoryPage* _Page, Uint64 _UnalignedOffset, Uint64 _Size) noexcept :
+        Page           {_Page           },
+        UnalignedOffset{_UnalignedOffset},
+        Size           {_Size           }
+    {}
+
+    D3D12MemoryAllocation(D3D12MemoryAllocation&& rhs) noexcept :
+        Page           {rhs.Page           },
+        UnalignedOffset{rhs.UnalignedOffset},
+        Size           {rhs.Size           }
+    {
+        rhs.Page            = nullptr;
+        rhs.UnalignedOffset = 0;
+        rhs.Size            = 0;
+    }
+
+    D3D12MemoryAllocation& operator= (D3D12MemoryAllocation&& rhs) noexcept
+    {
+        Page            = rhs.Page;
+        UnalignedOffset = rhs.UnalignedOffset;
+        Size            = rhs.Size;
+
+        rhs.Page            = nullptr;
+        rhs.UnalignedOffset = 0;
+        rhs.Size            = 0;
+
+        return *this;
+    }
+    // clang-format on
+
+    // Destructor immediately returns the allocation to the parent page.
+    // The resource placed in the allocation must not be in use by the GPU.
+    ~D3D12MemoryAllocation();
+
+    bool IsValid() const { return Page != nullptr; }
+
+    D3D12MemoryPage* Page            = nullptr; // Heap page that contains this allocation
+    Uint64           UnalignedOffset = 0;       // Unaligned offset from the start of the heap
+    Uint64           Size            = 0;       // Reserved size of this allocation
+};
+
+/// D3D12 heap that placed resources are suballocated from.
+class D3D12MemoryPage
+{
+public:
+    D3D12MemoryPage(D3D12MemoryManager& ParentMemoryMgr,
+                    Uint64              PageSize,
+                    D3D12_HEAP_TYPE     HeapType,
+                    D3D12_HEAP_FLAGS    HeapFlags);
+    ~D3D12MemoryPage();
+
+    // clang-format off
+    D3D12MemoryPage            (const D3D12MemoryPage&)  = delete;
+    D3D12MemoryPage            (      D3D12MemoryPage&&) = delete;
+    D3D12MemoryPage& operator= (const D3D12MemoryPage&)  = delete;
+    D3D12MemoryPage& operator= (      D3D12MemoryPage&&) = delete;
+
+    bool   IsEmpty()     const { return m_AllocationMgr.IsEmpty();     }
+    Uint64 GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
+    Uint64 GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    // clang-format on
+
+    D3D12MemoryAllocation Allocate(Uint64 Size, Uint64 Alignment);
+
+    ID3D12Heap* GetD3D12Heap() const { return m_pd3d12Heap; }
+
+private:
+    using AllocationsMgrOffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    friend struct D3D12MemoryAllocation;
+
+    // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
+    void Free(D3D12MemoryAllocation&& Allocation);
+
+    D3D12MemoryManager&            m_ParentMemoryMgr;
+    std::mutex                     m_Mutex;
+    VariableSizeAllocationsManager m_AllocationMgr;
+    CComPtr<ID3D12Heap>            m_pd3d12Heap;
+    GPUMemoryRecord                m_GPUMemoryRecord;
+};
+
+/// Suballocates buffers and textures as placed resources in shared D3D12 heaps.
+
+/// Creating a committed resource allocates an implicit heap for every buffer and texture,
+/// which is expensive for the driver and wastes memory on small resources.
+/// The manager keeps a set of heaps for every heap type and resource category
+/// (buffers and non render target/depth-stencil textures, so that heap tier 1 devices are
+/// supported) and places the resources in them. Resources that can't be placed are expected
+/// to be created as committed resources by the caller.
+class D3D12MemoryManager
+{
+public:
+    D3D12MemoryManager(IMemoryAllocator& Allocator,
+                       ID3D12Device*     pd3d12Device,
+                       Uint64            PageSize,
+                       Uint64            ReserveSize,
+                       GPUMemoryTracker* pGPUMemoryTracker);
+    ~D3D12MemoryManager();
+
+    // clang-format off
+    D3D12MemoryManager            (const D3D12MemoryManager&)  = delete;
+    D3D12MemoryManager            (      D3D12MemoryManager&&) = delete;
+    D3D12MemoryManager& operator= (const D3D12MemoryManager&)  = delete;
+    D3D12MemoryManager& operator= (      D3D12MemoryManager&&) = delete;
+    // clang-format on
+
+    /// Creates a resource placed in one of the heaps of the given type.
+
+    /// \param [in]  HeapType        - Heap type (default, upload or readback).
+    /// \param [in]  d3d12ResDesc    - Resource description. Small textures are placed with
+    ///                                D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT when the device allows it.
+    /// \param [in]  InitialState    - Initial resource state.
+    /// \param [in]  pClearValue     - Optimized clear value, may be null.
+    /// \param [out] pd3d12Resource  - Created resource.
+    ///
+    /// \return     The memory allocation that hosts the resource. The allocation must be kept alive while
+    ///             the resource is in use by the GPU and released after the resource.
+    ///             If the manager is disabled, or the resource can't be placed (render targets, depth-stencil
+    ///             and multisample textures, resources larger than half of the page size), returns an
+    ///             invalid allocation and leaves pd3d12Resource null, in which case the caller must
+    ///             create a committed resource.
+    ///
+    /// \remarks    Unlike committed resources, placed resources are not zeroed on creation.
+    D3D12MemoryAllocation CreatePlacedResource(D3D12_HEAP_TYPE            HeapType,
+                                               const D3D12_RESOURCE_DESC& d3d12ResDesc,
+                                               D3D12_RESOURCE_STATES      InitialState,
+                                               const D3D12_CLEAR_VALUE*   pClearValue,
+                                               CComPtr<ID3D12Resource>&   pd3d12Resource);
+
+    /// Releases empty pages while the total allocated size exceeds the reserve size.
+    void ShrinkMemory();
+
+    /// Returns the total size of the memory currently suballocated by the manager
+    Uint64 GetCurrentUsedSize() const
+    {
+        return static_cast<Uint64>(m_CurrUsedSize.load(std::memory_order_relaxed));
+    }
+
+private:
+    friend class D3D12MemoryPage;
+
+    struct MemoryPageIndex
+    {
+        const D3D12_HEAP_TYPE  HeapType;
+        const D3D12_HEAP_FLAGS HeapFlags;
+
+        // clang-format off
+        MemoryPageIndex(D3D12_HEAP_TYPE  _HeapType,
+                        D3D12_HEAP_FLAGS _HeapFlags) :
+            HeapType {_HeapType },
+            HeapFlags{_HeapFlags}
+        {}
+
+        bool operator == (const MemoryPageIndex& rhs)const
+        {
+            return HeapType  == rhs.HeapType &&
+                   HeapFlags == rhs.HeapFlags;
+        }
+        // clang-format on
+
+        struct Hasher
+        {
+            size_t operator()(const MemoryPageIndex& PageIndex) const
+            {
+                return ComputeHash(static_cast<Uint32>(PageIndex.HeapType), static_cast<Uint32>(PageIndex.HeapFlags));
+            }
+        };
+    };
+
+    // Allocates from an existing page. Partially used pages are preferred over empty ones
+    // so that empty pages stay empty and can be released by ShrinkMemory().
+    // m_PagesMtx must be locked.
+    D3D12MemoryAllocation AllocateFromExistingPages(const MemoryPageIndex& PageIdx, Uint64 Size, Uint64 Alignment);
+
+    D3D12MemoryAllocation Allocate(const MemoryPageIndex& PageIdx, Uint64 Size, Uint64 Alignment);
+
+    void OnFreeAllocation(Uint64 Size);
+
+    IMemoryAllocator&     m_Allocator;
+    CComPtr<ID3D12Device> m_pd3d12Device;
+    GPUMemoryTracker*     m_pGPUMemoryTracker;
+
+    const Uint64 m_PageSize;
+    const Uint64 m_ReserveSize;
+
+    // Allocations from the existing pages only take a shared lock. The exclusive lock is
+    // only taken to create or destroy pages.
+    std::shared_timed_mutex                                                            m_PagesMtx;
+    std::unordered_multimap<MemoryPageIndex, D3D12MemoryPage, MemoryPageIndex::Hasher> m_Pages;
+
+    std::atomic<int64_t> m_CurrUsedSize{0};
+    std::atomic<int64_t> m_PeakUsedSize{0};
+    Uint64               m_CurrAllocatedSize = 0;
+    Uint64               m_PeakAllocatedSize = 0;
+};
+
+} // namespace Diligent
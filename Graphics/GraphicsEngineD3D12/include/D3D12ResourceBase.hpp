@@ -30,6 +30,8 @@
 /// \file
 /// Implementation of the Diligent::D3D12ResourceBase class
 
+#include "ResidencyManagerD3D12.hpp"
+
 namespace Diligent
 {
 
@@ -42,8 +44,13 @@ public:
 
     ID3D12Resource* GetD3D12Resource() const { return m_pd3d12Resource; }
 
+    ResidencyManagerD3D12::Handle& GetResidencyHandle() { return m_ResidencyHandle; }
+
 protected:
     CComPtr<ID3D12Resource> m_pd3d12Resource; ///< D3D12 resource object
+
+    /// Residency state of a committed resource registered with the residency manager
+    ResidencyManagerD3D12::Handle m_ResidencyHandle;
 };
 
 } // namespace Diligent
@@ -81,6 +81,14 @@ D3D12_RESOURCE_STATES     ResourceStateFlagsToD3D12ResourceStates(RESOURCE_STATE
 RESOURCE_STATE            D3D12ResourceStatesToResourceStateFlags(D3D12_RESOURCE_STATES StateFlags);
 D3D12_RESOURCE_STATES     GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAND_LIST_TYPE CmdListType);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+// Returns the synchronization scope, access bits and texture layout that are equivalent to legacy resource states
+void D3D12ResourceStatesToBarrierSyncAccessLayout(D3D12_RESOURCE_STATES States,
+                                                  D3D12_BARRIER_SYNC&   Sync,
+                                                  D3D12_BARRIER_ACCESS& Access,
+                                                  D3D12_BARRIER_LAYOUT& Layout);
+#endif
+
 D3D12_QUERY_HEAP_TYPE QueryTypeToD3D12QueryHeapType(QUERY_TYPE QueryType, HardwareQueueIndex QueueId);
 D3D12_QUERY_TYPE      QueryTypeToD3D12QueryType(QUERY_TYPE QueryType);
 
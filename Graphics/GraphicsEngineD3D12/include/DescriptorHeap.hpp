@@ -37,7 +37,9 @@
 #include <unordered_set>
 #include <atomic>
 
-#include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
+#include "SpinLock.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -240,7 +242,7 @@ private:
 
 
 // The class performs suballocations within one D3D12 descriptor heap.
-// It uses VariableSizeAllocationsManager to manage free space in the heap
+// It uses TLSFAllocationsManager to manage free space in the heap
 //
 // |  X  X  X  X  O  O  O  X  X  O  O  X  O  O  O  O  |  D3D12 descriptor heap
 //
@@ -342,8 +344,8 @@ private:
     Uint32 m_NumDescriptorsInAllocation = 0;
 
     // Allocations manager used to handle descriptor allocations within the heap
-    std::mutex                     m_FreeBlockManagerMutex;
-    VariableSizeAllocationsManager m_FreeBlockManager;
+    std::mutex             m_FreeBlockManagerMutex;
+    TLSFAllocationsManager m_FreeBlockManager;
 
     // Strong reference to D3D12 descriptor heap object
     CComPtr<ID3D12DescriptorHeap> m_pd3d12DescriptorHeap;
@@ -386,6 +388,20 @@ private:
 // Render device contains four CPUDescriptorHeap object instances (one for each D3D12 heap type). The heaps are accessed
 // when a texture or a buffer view is created.
 //
+// Single-descriptor requests, which is what almost every view needs, are served from one of the thread caches
+// that sit in front of the heap pool. A cache is selected by the calling thread id and is protected by a spin lock
+// that is practically never contended. When the cache is empty, it takes a batch of descriptors from the pool
+// under m_HeapPoolMutex; when it holds too many released descriptors, it returns a batch back to the pool:
+//
+//      Thread 0         Thread 1          Thread N
+//   | D D D D   |    | D         |     | D D D D D |      <- m_ThreadCaches
+//         |                 ^                 |
+//         | refill          | refill          | drain
+//    _____v_________________|_________________v_____
+//   |                  m_HeapPool                   |
+//
+// Multi-descriptor requests bypass the caches.
+//
 class CPUDescriptorHeap final : public IDescriptorAllocator
 {
 public:
@@ -409,6 +425,28 @@ public:
     virtual void                     Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQueueMask) override final;
     virtual Uint32                   GetDescriptorSize() const override final { return m_DescriptorSize; }
 
+    struct Stats
+    {
+        // The number of descriptors currently allocated by the application
+        Uint32 CurrentSize = 0;
+
+        // The maximum number of descriptors allocated by the application at the same time
+        Uint32 MaxSize = 0;
+
+        // The number of descriptors held by the thread caches
+        Uint32 CachedDescriptors = 0;
+
+        // The number of single-descriptor requests served by the thread caches
+        Uint64 CacheHits = 0;
+
+        // The number of single-descriptor requests that had to refill the thread cache from the pool
+        Uint64 CacheMisses = 0;
+
+        // The number of batches that were returned from the thread caches to the pool
+        Uint64 CacheDrains = 0;
+    };
+    Stats GetStats() const;
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount();
 #endif
@@ -416,6 +454,31 @@ public:
 private:
     void FreeAllocation(DescriptorHeapAllocation&& Allocation);
 
+    // Allocates descriptors from the heap pool. m_HeapPoolMutex must be locked.
+    DescriptorHeapAllocation AllocateFromPool(Uint32 Count);
+
+    // A single descriptor kept in a thread cache
+    struct CachedDescriptor
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE CPUHandle       = {0};
+        ID3D12DescriptorHeap*       pd3d12Heap      = nullptr;
+        Uint16                      AllocationMgrId = 0;
+    };
+
+    struct ThreadCache
+    {
+        Threading::SpinLock           Lock;
+        std::vector<CachedDescriptor> Descriptors;
+    };
+
+    ThreadCache& GetThreadCache();
+
+    // Takes a batch of descriptors from the pool and puts them into the cache
+    void RefillThreadCache(ThreadCache& Cache);
+
+    // Returns descriptors to the heap pool
+    void ReleaseToPool(const CachedDescriptor* pDescriptors, size_t Count);
+
     IMemoryAllocator&      m_MemAllocator;
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
@@ -428,9 +491,23 @@ private:
     D3D12_DESCRIPTOR_HEAP_DESC m_HeapDesc;
     const UINT                 m_DescriptorSize = 0;
 
+    // The number of thread caches. Threads are mapped to caches by their ids.
+    static constexpr size_t NumThreadCaches = 16;
+    // The number of descriptors that a cache takes from or returns to the pool at once
+    static constexpr size_t CacheBatchSize = 32;
+    // The cache returns a batch to the pool when it holds more than this number of descriptors
+    static constexpr size_t MaxCachedDescriptors = CacheBatchSize * 2;
+
+    ThreadCache m_ThreadCaches[NumThreadCaches];
+
     // Maximum heap size during the application lifetime - for statistic purposes
-    Uint32 m_MaxSize     = 0;
-    Uint32 m_CurrentSize = 0;
+    std::atomic<Uint32> m_MaxSize{0};
+    std::atomic<Uint32> m_CurrentSize{0};
+
+    std::atomic<Uint32> m_CachedDescriptors{0};
+    std::atomic<Uint64> m_CacheHits{0};
+    std::atomic<Uint64> m_CacheMisses{0};
+    std::atomic<Uint64> m_CacheDrains{0};
 };
 
 // GPU descriptor heap provides storage for shader-visible descriptors
@@ -507,6 +584,18 @@ public:
     const D3D12_DESCRIPTOR_HEAP_DESC& GetHeapDesc() const { return m_HeapDesc; }
     Uint32                            GetMaxStaticDescriptors() const { return m_HeapAllocationManager.GetMaxDescriptors(); }
     Uint32                            GetMaxDynamicDescriptors() const { return m_DynamicAllocationsManager.GetMaxDescriptors(); }
+    ID3D12DescriptorHeap*             GetD3D12DescriptorHeap() const { return m_pd3d12DescriptorHeap; }
+
+    static constexpr Uint32 InvalidDescriptorIndex = ~0u;
+
+    // Returns the index of the descriptor in the heap, which is how the descriptor
+    // is addressed by the shaders through ResourceDescriptorHeap[] or SamplerDescriptorHeap[].
+    Uint32 GetDescriptorIndex(const DescriptorHeapAllocation& Allocation, Uint32 Offset = 0) const
+    {
+        VERIFY(Allocation.GetDescriptorHeap() == m_pd3d12DescriptorHeap, "The allocation does not belong to this heap");
+        const auto HeapStart = m_pd3d12DescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+        return static_cast<Uint32>((Allocation.GetGpuHandle(Offset).ptr - HeapStart.ptr) / m_DescriptorSize);
+    }
 
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount() const
@@ -529,6 +618,8 @@ protected:
 
     // Allocation manager for dynamic part
     DescriptorHeapAllocationManager m_DynamicAllocationsManager;
+
+    GPUMemoryRecord m_GPUMemoryRecord;
 };
 
 
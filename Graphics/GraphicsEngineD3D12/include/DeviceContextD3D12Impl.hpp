@@ -47,6 +47,7 @@
 #include "TopLevelASD3D12Impl.hpp"
 
 #include "D3D12DynamicHeap.hpp"
+#include "GPUBreadcrumbsD3D12.hpp"
 
 namespace Diligent
 {
@@ -244,6 +245,23 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetQueryData() in Direct3D12 backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueryData(Uint32         NumQueries,
+                                                   IQuery* const* ppQueries,
+                                                   void*          pData,
+                                                   Uint32         DataSize,
+                                                   Bool*          pDataAvailable,
+                                                   Bool           AutoInvalidate) override final;
+
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in Direct3D12 backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -256,6 +274,9 @@ public:
     /// Implementation of IDeviceContext::BuildBLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -280,6 +301,9 @@ public:
     /// Implementation of IDeviceContext::UpdateSBT() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs) override final;
 
+    /// Implementation of IDeviceContext::DispatchGraph() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE DispatchGraph(const DispatchGraphAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BeginDebugGroup() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final;
 
@@ -292,6 +316,9 @@ public:
     /// Implementation of IDeviceContextD3D12::ID3D12GraphicsCommandList() in Direct3D12 backend.
     virtual ID3D12GraphicsCommandList* DILIGENT_CALL_TYPE GetD3D12CommandList() override final;
 
+    /// Implementation of IDeviceContextD3D12::ExecuteIndirectCommands() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ExecuteIndirectCommands(const ExecuteIndirectCommandsAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetShadingRate() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetShadingRate(SHADING_RATE          BaseRate,
                                                    SHADING_RATE_COMBINER PrimitiveCombiner,
@@ -371,6 +398,11 @@ private:
 
     __forceinline void RequestCommandContext();
 
+    // Adds the resources that remain bound to the context to the residency set of the current command list
+    void TrackBoundResourcesResidency();
+
+    void ResolvePendingQueries();
+
     __forceinline void TransitionOrVerifyBufferState(CommandContext&                CmdCtx,
                                                      BufferD3D12Impl&               Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -392,6 +424,14 @@ private:
                                                    RESOURCE_STATE                 RequiredState,
                                                    const char*                    OperationName);
 
+    struct BLASBuildInfo
+    {
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC d3d12BuildASDesc{};
+        std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>        Geometries;
+    };
+    // Transitions the resources used by the BLAS build and initializes the build description.
+    void PrepareBLASBuild(CommandContext& CmdCtx, const BuildBLASAttribs& Attribs, BLASBuildInfo& BuildInfo, const char* OpName);
+
     __forceinline void PrepareForDraw(GraphicsContext& GraphCtx, DRAW_FLAGS Flags);
 
     __forceinline void PrepareForIndexedDraw(GraphicsContext& GraphCtx, DRAW_FLAGS Flags, VALUE_TYPE IndexType);
@@ -399,6 +439,21 @@ private:
     __forceinline void PrepareForDispatchCompute(ComputeContext& GraphCtx);
     __forceinline void PrepareForDispatchRays(GraphicsContext& GraphCtx);
 
+    // Writes GPU breadcrumbs around a command when they are enabled.
+    // The name is not copied and must be a string literal.
+    __forceinline Uint32 BeginBreadcrumb(CommandContext& CmdCtx, const char* Name)
+    {
+        return m_pBreadcrumbs ? m_pBreadcrumbs->BeginCommand(CmdCtx, Name) : 0;
+    }
+    __forceinline void EndBreadcrumb(CommandContext& CmdCtx, Uint32 Marker)
+    {
+        if (m_pBreadcrumbs)
+            m_pBreadcrumbs->EndCommand(CmdCtx, Marker);
+    }
+
+    // Logs GPU breadcrumbs if the command queue has detected the device removal.
+    void CheckDeviceRemoved();
+
     __forceinline void PrepareIndirectAttribsBuffer(CommandContext&                CmdCtx,
                                                     IBuffer*                       pAttribsBuffer,
                                                     RESOURCE_STATE_TRANSITION_MODE BufferStateTransitionMode,
@@ -422,6 +477,9 @@ private:
     ID3D12CommandSignature* GetDrawIndirectSignature(Uint32 Stride);
     ID3D12CommandSignature* GetDrawIndexedIndirectSignature(Uint32 Stride);
 
+    // Returns the command signature for the command layout in m_IndirectCmdSigKey
+    ID3D12CommandSignature* GetIndirectCommandSignature();
+
     struct TextureUploadSpace
     {
         D3D12DynamicAllocation Allocation;
@@ -476,6 +534,45 @@ private:
     CComPtr<ID3D12CommandSignature>                             m_pDrawMeshIndirectSignature;
     CComPtr<ID3D12CommandSignature>                             m_pTraceRaysIndirectSignature;
 
+    // The work graph and backing memory region used by the last DispatchGraph command.
+    // The backing memory must be initialized when either of them changes.
+    // Strong references prevent the objects from being released and their addresses reused.
+    struct LastWorkGraphInfo
+    {
+        CComPtr<ID3D12StateObject> pStateObject;
+        CComPtr<ID3D12Resource>    pBackingMemory;
+
+        D3D12_GPU_VIRTUAL_ADDRESS BackingMemoryAddress = 0;
+        Uint64                    BackingMemorySize    = 0;
+    } m_LastWorkGraph;
+
+    struct IndirectCommandSignatureKey
+    {
+        std::vector<D3D12_INDIRECT_ARGUMENT_DESC> Arguments;
+
+        UINT ByteStride = 0;
+
+        // Command signatures that change root arguments must be created with the root signature.
+        // The key keeps a strong reference so that the pointer can't be reused by another root signature.
+        CComPtr<ID3D12RootSignature> pd3d12RootSig;
+
+        size_t Hash = 0;
+
+        bool operator==(const IndirectCommandSignatureKey& rhs) const;
+
+        struct Hasher
+        {
+            size_t operator()(const IndirectCommandSignatureKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+    };
+    // Reused by every ExecuteIndirectCommands() call to avoid allocations
+    IndirectCommandSignatureKey m_IndirectCmdSigKey;
+
+    std::unordered_map<IndirectCommandSignatureKey, CComPtr<ID3D12CommandSignature>, IndirectCommandSignatureKey::Hasher> m_IndirectCommandSignatures;
+
     D3D12DynamicHeap m_DynamicHeap;
 
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
@@ -515,8 +612,25 @@ private:
 
     QueryManagerD3D12* m_QueryMgr = nullptr;
 
+    // GPU breadcrumbs of the immediate context, see EngineCreateInfo::EnableGPUBreadcrumbs.
+    std::unique_ptr<GPUBreadcrumbsD3D12> m_pBreadcrumbs;
+    bool                                 m_DeviceRemovedReported = false;
+
+    // Queries that have been ended in the current command list and whose data
+    // will be resolved by ResolvePendingQueries() before the list is closed.
+    std::vector<QueryManagerD3D12::PendingResolve> m_PendingQueryResolves;
+
     // Null render targets require a null RTV. NULL descriptor causes an error.
     DescriptorHeapAllocation m_NullRTV;
+
+    // Build infos reused by BuildBLAS() and BuildBLASBatch() to avoid allocations
+    std::vector<BLASBuildInfo> m_BLASBuildInfos;
+
+    // Instances reused by BuildTLAS() with DirtyInstancesOnly flag
+    std::vector<TopLevelASD3D12Impl::DirtyInstance> m_DirtyTLASInstances;
+
+    // SBT regions reused by UpdateSBT()
+    std::vector<SBTUploadRegion> m_SBTUploads;
 };
 
 } // namespace Diligent
@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FenceCompletionWaiterD3D12 class
+
+#include "FenceCompletionWaiter.hpp"
+
+namespace Diligent
+{
+
+/// Fence completion waiter that blocks the waiter thread on a single event shared by all fences.
+/// ID3D12Fence::SetEventOnCompletion() is called when the value a fence is waited for changes,
+/// and WaitForMultipleObjects() returns when either any fence signals the event or the waiter is woken up.
+class FenceCompletionWaiterD3D12 final : public FenceCompletionWaiter
+{
+public:
+    FenceCompletionWaiterD3D12();
+    ~FenceCompletionWaiterD3D12();
+
+protected:
+    virtual void WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter) override final;
+    virtual void WakeUp(Uint64 WakeCounter) override final;
+
+private:
+    // Auto-reset events
+    HANDLE m_hCompletionEvent = NULL;
+    HANDLE m_hWakeUpEvent     = NULL;
+};
+
+} // namespace Diligent
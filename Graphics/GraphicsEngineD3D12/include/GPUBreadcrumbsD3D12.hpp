@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUBreadcrumbsD3D12 class
+
+#include <string>
+
+#include "GPUBreadcrumbs.hpp"
+#include "CommandContext.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceD3D12Impl;
+
+// Writes GPU breadcrumbs of an immediate context with ID3D12GraphicsCommandList2::WriteBufferImmediate().
+//
+// The marker of every command is written to a persistently mapped readback buffer when the
+// command starts (D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_IN) and when it completes
+// (D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT). The buffer always stays in the COPY_DEST state.
+class GPUBreadcrumbsD3D12
+{
+public:
+    GPUBreadcrumbsD3D12(RenderDeviceD3D12Impl& DeviceD3D12, const char* ContextName);
+    ~GPUBreadcrumbsD3D12();
+
+    // clang-format off
+    GPUBreadcrumbsD3D12             (const GPUBreadcrumbsD3D12&)  = delete;
+    GPUBreadcrumbsD3D12             (      GPUBreadcrumbsD3D12&&) = delete;
+    GPUBreadcrumbsD3D12& operator = (const GPUBreadcrumbsD3D12&)  = delete;
+    GPUBreadcrumbsD3D12& operator = (      GPUBreadcrumbsD3D12&&) = delete;
+    // clang-format on
+
+    // Returns true if the command lists of the given type support WriteBufferImmediate().
+    static bool IsSupported(RenderDeviceD3D12Impl& DeviceD3D12, D3D12_COMMAND_LIST_TYPE CmdListType);
+
+    // Records the command and writes the marker that is reached when the command starts.
+    // The name is not copied and must be a string literal.
+    __forceinline Uint32 BeginCommand(CommandContext& CmdCtx, const char* Name)
+    {
+        const Uint32 Marker = m_Breadcrumbs.AddCommand(Name);
+        WriteMarker(CmdCtx, StartedMarkerOffset, Marker, D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_IN);
+        return Marker;
+    }
+
+    // Writes the marker that is reached when the command completes.
+    __forceinline void EndCommand(CommandContext& CmdCtx, Uint32 Marker)
+    {
+        WriteMarker(CmdCtx, CompletedMarkerOffset, Marker, D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT);
+    }
+
+    void BeginDebugGroup(CommandContext& CmdCtx, const char* Name);
+    void EndDebugGroup(CommandContext& CmdCtx);
+
+    // Reads back the markers and logs the commands that were executing when the device was removed.
+    void LogDeviceRemoved(ID3D12Device* pd3d12Device) const;
+
+private:
+    __forceinline void WriteMarker(CommandContext& CmdCtx, UINT64 Offset, Uint32 Marker, D3D12_WRITEBUFFERIMMEDIATE_MODE Mode)
+    {
+        const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER Param{m_GPUAddress + Offset, Marker};
+        CmdCtx.AsGraphicsContext2().WriteBufferImmediate(1, &Param, &Mode);
+    }
+
+    static constexpr UINT64 StartedMarkerOffset   = 0;
+    static constexpr UINT64 CompletedMarkerOffset = sizeof(Uint32);
+
+    const std::string m_ContextName;
+
+    GPUBreadcrumbs m_Breadcrumbs;
+
+    CComPtr<ID3D12Resource>   m_pd3d12Buffer;
+    D3D12_GPU_VIRTUAL_ADDRESS m_GPUAddress = 0;
+    const volatile Uint32*    m_pMarkers   = nullptr;
+};
+
+} // namespace Diligent
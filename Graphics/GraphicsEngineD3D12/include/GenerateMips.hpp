@@ -55,14 +55,49 @@ namespace Diligent
 class GenerateMipsHelper
 {
 public:
-    GenerateMipsHelper(ID3D12Device* pd3d12Device);
+    GenerateMipsHelper(ID3D12Device* pd3d12Device, size_t NumCommandQueues);
 
-    void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx) const;
+    void GenerateMips(ID3D12Device*               pd3d12Device,
+                      class TextureViewD3D12Impl* pTexView,
+                      class CommandContext&       Ctx,
+                      SoftwareQueueIndex          CmdQueueInd) const;
 
 private:
+    void CreateSinglePassDownsampler(ID3D12Device* pd3d12Device, size_t NumCommandQueues);
+
+    bool CanUseSinglePassDownsampler(const TextureDesc& TexDesc, const TextureViewDesc& ViewDesc) const;
+
+    // Generates up to 4 mip levels per dispatch
+    void GenerateMipsMultiPass(ID3D12Device*               pd3d12Device,
+                               class TextureViewD3D12Impl* pTexView,
+                               class CommandContext&       Ctx,
+                               RESOURCE_STATE              OriginalState,
+                               RESOURCE_STATE              FinalState) const;
+
+    // Generates the entire mip chain with one dispatch per MaxSlicesPerDispatch array slices
+    void GenerateMipsSinglePass(ID3D12Device*               pd3d12Device,
+                                class TextureViewD3D12Impl* pTexView,
+                                class CommandContext&       Ctx,
+                                SoftwareQueueIndex          CmdQueueInd,
+                                RESOURCE_STATE              OriginalState,
+                                RESOURCE_STATE              FinalState) const;
+
     CComPtr<ID3D12RootSignature> m_pGenerateMipsRS;
     CComPtr<ID3D12PipelineState> m_pGenerateMipsLinearPSO[4];
     CComPtr<ID3D12PipelineState> m_pGenerateMipsGammaPSO[4];
+
+    // Single-pass downsampler objects. Null if the device does not support
+    // resource binding tier 2 required for 13 UAVs in the descriptor table.
+    CComPtr<ID3D12RootSignature> m_pSPDRootSig;
+    CComPtr<ID3D12PipelineState> m_pSPDLinearPSO;
+    CComPtr<ID3D12PipelineState> m_pSPDGammaPSO;
+
+    // Every command queue needs its own atomic counters and mip 6 scratch memory
+    // as dispatches on different queues may run concurrently.
+    std::vector<CComPtr<ID3D12Resource>> m_SPDScratchBuffers;
+    // Non-shader-visible heap with the UAV of every scratch buffer
+    CComPtr<ID3D12DescriptorHeap> m_pSPDScratchUAVHeap;
+    Uint32                        m_SPDScratchUAVSize = 0;
 };
 
 } // namespace Diligent
@@ -138,6 +138,13 @@ public:
                 GetD3D12RootParamType() == D3D12_ROOT_PARAMETER_TYPE_UAV);
     }
 
+    // Bindless resources are accessed through the descriptor heap; their
+    // heap indices are stored in the signature's root constants.
+    bool IsBindless() const
+    {
+        return GetD3D12RootParamType() == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    }
+
     bool IsCompatibleWith(const PipelineResourceAttribsD3D12& rhs) const
     {
         // Ignore sampler index, signature root index & offset.
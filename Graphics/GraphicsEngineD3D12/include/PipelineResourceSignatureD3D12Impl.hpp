@@ -136,7 +136,7 @@ public:
 
     Uint32 GetTotalRootParamsCount() const
     {
-        return m_RootParams.GetNumRootTables() + m_RootParams.GetNumRootViews();
+        return m_RootParams.GetNumRootTables() + m_RootParams.GetNumRootViews() + m_RootParams.GetNumRootConstants();
     }
 
     Uint32 GetNumRootTables() const
@@ -149,6 +149,15 @@ public:
         return m_RootParams.GetNumRootViews();
     }
 
+    // Returns true if the signature contains resources with PIPELINE_RESOURCE_FLAG_BINDLESS flag.
+    bool HasBindlessResources() const
+    {
+        return m_RootParams.GetNumRootConstants() > 0;
+    }
+
+    // Returns the name of the constant buffer that holds descriptor heap indices of bindless resources.
+    String GetBindlessIndicesBufferName() const;
+
     void InitSRBResourceCache(ShaderResourceCacheD3D12& ResourceCache);
 
     void CopyStaticResources(ShaderResourceCacheD3D12& ResourceCache) const;
@@ -29,6 +29,8 @@
 /// \file
 /// Declaration of Diligent::PipelineStateCacheD3D12Impl class
 
+#include <mutex>
+
 #include "EngineD3D12ImplTraits.hpp"
 #include "PipelineStateCacheBase.hpp"
 
@@ -51,6 +53,9 @@ public:
     /// Implementation of IPipelineStateCache::GetData().
     virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
 
+    /// Implementation of IPipelineStateCache::Merge() in Direct3D12 backend.
+    virtual Bool DILIGENT_CALL_TYPE Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches) override final;
+
     CComPtr<ID3D12DeviceChild> LoadComputePipeline(const wchar_t* Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc);
     CComPtr<ID3D12DeviceChild> LoadGraphicsPipeline(const wchar_t* Name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc);
 
@@ -58,6 +63,11 @@ public:
 
 private:
     CComPtr<ID3D12PipelineLibrary> m_pLibrary;
+
+    // Serialized library data that the library was created from
+    RefCntAutoPtr<IDataBlob> m_pLibraryData;
+
+    std::mutex m_LibraryMtx;
 };
 
 } // namespace Diligent
@@ -31,6 +31,9 @@
 /// Declaration of Diligent::PipelineStateD3D12Impl class
 
 #include <vector>
+#include <string>
+#include <memory>
+#include <utility>
 
 #include "EngineD3D12ImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -54,6 +57,7 @@ public:
     PipelineStateD3D12Impl(IReferenceCounters* pRefCounters, RenderDeviceD3D12Impl* pDeviceD3D12, const GraphicsPipelineStateCreateInfo& CreateInfo);
     PipelineStateD3D12Impl(IReferenceCounters* pRefCounters, RenderDeviceD3D12Impl* pDeviceD3D12, const ComputePipelineStateCreateInfo& CreateInfo);
     PipelineStateD3D12Impl(IReferenceCounters* pRefCounters, RenderDeviceD3D12Impl* pDeviceD3D12, const RayTracingPipelineStateCreateInfo& CreateInfo);
+    PipelineStateD3D12Impl(IReferenceCounters* pRefCounters, RenderDeviceD3D12Impl* pDeviceD3D12, const WorkGraphPipelineStateCreateInfo& CreateInfo);
     ~PipelineStateD3D12Impl();
 
     IMPLEMENT_QUERY_INTERFACE2_IN_PLACE(IID_PipelineStateD3D12, IID_InternalImpl, TPipelineStateBase)
@@ -72,6 +76,32 @@ public:
 
     const RootSignatureD3D12& GetRootSignature() const { return *m_RootSig; }
 
+    /// Work graph program properties queried from the state object.
+    struct WorkGraphProgramInfo
+    {
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+        D3D12_PROGRAM_IDENTIFIER ProgramId = {};
+#endif
+        // Entry point names and node array indices, in the order of entry point indices.
+        std::vector<std::pair<std::string, Uint32>> EntryPoints;
+
+        // Minimum size of the backing memory required by the work graph.
+        Uint64 MinBackingMemorySize = 0;
+
+        // Backing memory used when DispatchGraphAttribs::pBackingMemory is null.
+        RefCntAutoPtr<IBuffer> pBackingMemory;
+    };
+
+    const WorkGraphProgramInfo& GetWorkGraphProgramInfo() const
+    {
+        VERIFY_EXPR(m_pWorkGraph);
+        return *m_pWorkGraph;
+    }
+
+    /// Returns the index of the work graph entry point with the given name and node array index,
+    /// or ~0u if there is no such entry point. Null name selects the first entry point.
+    Uint32 GetWorkGraphEntryPointIndex(const char* Name, Uint32 ArrayIndex) const;
+
 #ifdef DILIGENT_DEVELOPMENT
     using ShaderResourceCacheArrayType = std::array<ShaderResourceCacheD3D12*, MAX_RESOURCE_SIGNATURES>;
     void DvpVerifySRBResources(const DeviceContextD3D12Impl*       pDeviceCtx,
@@ -128,10 +158,17 @@ private:
 
     void ValidateShaderResources(const ShaderD3D12Impl* pShader, const LocalRootSignatureD3D12* pLocalRootSig);
 
+    // Returns true if Name is the name of the constant buffer that holds bindless resource indices
+    // of one of the resource signatures.
+    bool IsBindlessIndicesBuffer(const char* Name) const;
+
 private:
     CComPtr<ID3D12DeviceChild>        m_pd3d12PSO;
     RefCntAutoPtr<RootSignatureD3D12> m_RootSig;
 
+    // Only initialized for work graph pipelines.
+    std::unique_ptr<WorkGraphProgramInfo> m_pWorkGraph;
+
     // NB:  Pipeline resource signatures used to create the PSO may NOT be the same as
     //      pipeline resource signatures in m_RootSig, because the latter may be used from the
     //      cache. While the two signatures may be compatible, they resource names may not be identical.
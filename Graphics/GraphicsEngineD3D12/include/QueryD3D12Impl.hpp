@@ -73,6 +73,20 @@ public:
     bool OnBeginQuery(DeviceContextD3D12Impl* pContext);
     bool OnEndQuery(DeviceContextD3D12Impl* pContext);
 
+    QueryManagerD3D12* GetQueryManager() const
+    {
+        return m_pQueryMgr;
+    }
+
+    // Returns true if the command list that ended the query has completed execution.
+    bool IsEndFenceCompleted() const;
+
+    // Returns the range [Begin, End) of the query manager resolve buffer that contains the query data.
+    void GetResolveBufferRange(Uint64& Begin, Uint64& End) const;
+
+    // Same as GetData(), but reads the data from the resolve buffer mapped by QueryManagerD3D12::MapResolveBuffer().
+    bool GetData(void* pData, Uint32 DataSize, bool AutoInvalidate, const Uint8* pMappedResolveBuffer);
+
 private:
     bool AllocateQueries();
     void DiscardQueries();
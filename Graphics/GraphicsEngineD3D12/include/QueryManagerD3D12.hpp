@@ -33,6 +33,7 @@
 
 #include "Query.h"
 #include "IndexWrapper.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace Diligent
 {
@@ -67,9 +68,43 @@ public:
         return m_Heaps[Type].GetD3D12QueryHeap();
     }
 
+    // Query whose data must be resolved into the readback buffer before the command list is closed.
+    struct PendingResolve
+    {
+        QUERY_TYPE Type  = QUERY_TYPE_UNDEFINED;
+        Uint32     Index = InvalidIndex;
+
+        bool operator<(const PendingResolve& rhs) const
+        {
+            return Type != rhs.Type ? Type < rhs.Type : Index < rhs.Index;
+        }
+        bool operator==(const PendingResolve& rhs) const
+        {
+            return Type == rhs.Type && Index == rhs.Index;
+        }
+    };
+
     void BeginQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index) const;
+
+    // Ends the query. The query data is not resolved until ResolveQueries() is called.
     void EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index) const;
-    void ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const;
+
+    // Resolves the data of all pending queries into the readback buffer. Queries with contiguous
+    // indices are resolved by a single ResolveQueryData command. The list is cleared.
+    // Returns the number of commands recorded.
+    Uint32 ResolveQueries(CommandContext& Ctx, std::vector<PendingResolve>& Queries) const;
+
+    // Reads the query data from the readback buffer. If pMappedData is null, the buffer is mapped
+    // for the duration of the call. Otherwise, pMappedData must be the pointer returned by MapResolveBuffer().
+    void ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize, const Uint8* pMappedData = nullptr) const;
+
+    // Returns the range [Begin, End) of the readback buffer that contains the query data.
+    void GetResolveBufferRange(QUERY_TYPE Type, Uint32 Index, Uint64& Begin, Uint64& End) const;
+
+    // Maps the range [Begin, End) of the readback buffer for reading and returns the pointer to the
+    // beginning of the buffer. The pointer is never offset by Begin.
+    const Uint8* MapResolveBuffer(Uint64 Begin, Uint64 End) const;
+    void         UnmapResolveBuffer() const;
 
     SoftwareQueueIndex GetCommandQueueId() const
     {
@@ -145,6 +180,7 @@ private:
 
     // Readback buffer that will contain the query data.
     CComPtr<ID3D12Resource> m_pd3d12ResolveBuffer;
+    GPUMemoryRecord         m_ResolveBufferMemoryRecord;
 };
 
 } // namespace Diligent
@@ -41,6 +41,8 @@
 #include "CommandListManager.hpp"
 #include "CommandContext.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12MemoryManager.hpp"
+#include "ResidencyManagerD3D12.hpp"
 #include "GenerateMips.hpp"
 #include "DXCompiler.hpp"
 #include "RootSignature.hpp"
@@ -91,12 +93,19 @@ public:
     /// Implementation of IRenderDevice::CreateGraphicsPipelineState() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreateDerivedGraphicsPipelineState() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo,
+                                                                       IPipelineState**                              ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateComputePipelineState() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
 
     /// Implementation of IRenderDevice::CreateRayTracingPipelineState() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreateWorkGraphPipelineState() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateWorkGraphPipelineState(const WorkGraphPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateBuffer() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateBuffer(const BufferDesc& BuffDesc,
                                                  const BufferData* pBuffData,
@@ -203,6 +212,9 @@ public:
         return m_MaxShaderVersion;
     }
 
+    /// Implementation of IRenderDeviceD3D12::GetRootSignatureCacheData().
+    virtual void DILIGENT_CALL_TYPE GetRootSignatureCacheData(IDataBlob** ppData) override final;
+
     void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig);
 
     RootSignatureCacheD3D12& GetRootSignatureCache() { return m_RootSignatureCache; }
@@ -210,6 +222,18 @@ public:
     DescriptorHeapAllocation AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count = 1);
     DescriptorHeapAllocation AllocateGPUDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count = 1);
 
+    // Returns allocation and thread cache statistics of the CPU descriptor heap of the given type
+    CPUDescriptorHeap::Stats GetCPUDescriptorHeapStats(D3D12_DESCRIPTOR_HEAP_TYPE Type) const
+    {
+        VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES, "Invalid heap type");
+        return m_CPUDescriptorHeaps[Type].GetStats();
+    }
+
+    // Allocates a persistent slot in the shader-visible CBV/SRV/UAV heap, copies the view descriptor
+    // into it and writes the slot index to Index, unless another thread has already done this.
+    // Returns the slot index.
+    Uint32 CreateBindlessDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE d3d12CPUDescriptor, DescriptorHeapAllocation& Slot, std::atomic<Uint32>& Index);
+
     /// Implementation of IRenderDevice::IdleGPU() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -243,6 +267,11 @@ public:
 
     D3D12DynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    D3D12MemoryManager& GetMemoryManager() { return m_MemoryMgr; }
+
+    // Returns null when residency management is disabled
+    ResidencyManagerD3D12* GetResidencyManager() { return m_pResidencyMgr.get(); }
+
     GPUDescriptorHeap& GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE Type)
     {
         VERIFY_EXPR(Type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || Type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
@@ -253,6 +282,13 @@ public:
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
+    // Returns true if the device supports enhanced barriers (ID3D12GraphicsCommandList7::Barrier)
+    bool AreEnhancedBarriersSupported() const { return m_EnhancedBarriersSupported; }
+
+    // Returns true if the device supports accessing resources through ResourceDescriptorHeap[]
+    // (shader model 6.6 and resource binding tier 3)
+    bool AreBindlessResourcesSupported() const { return m_BindlessResourcesSupported; }
+
 #define GET_D3D12_DEVICE(Version)                                                  \
     ID3D12Device##Version* GetD3D12Device##Version()                               \
     {                                                                              \
@@ -301,6 +337,12 @@ private:
 
     D3D12DynamicMemoryManager m_DynamicMemoryManager;
 
+    // Suballocates buffers and textures as placed resources
+    D3D12MemoryManager m_MemoryMgr;
+
+    // Keeps committed resources within the video memory budget (see EngineD3D12CreateInfo::ResidencyBudgetFraction)
+    std::unique_ptr<ResidencyManagerD3D12> m_pResidencyMgr;
+
     // Note: mips generator must be released after the device has been idled
     GenerateMipsHelper m_MipsGenerator;
 
@@ -317,7 +359,12 @@ private:
     // Dummy heap required by NvAPI_D3D12_CreateReservedResource.
     CComPtr<ID3D12Heap> m_pNVApiHeap;
 
-    bool m_IsPSOCacheSupported = false;
+    // Protects bindless descriptor creation
+    std::mutex m_BindlessDescriptorsMtx;
+
+    bool m_IsPSOCacheSupported        = false;
+    bool m_EnhancedBarriersSupported  = false;
+    bool m_BindlessResourcesSupported = false;
 
 #ifdef DILIGENT_DEVELOPMENT
     Uint32 m_MaxD3D12DeviceVersion = 0;
@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResidencyManagerD3D12 class
+
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "DeviceObject.h"
+#include "RefCntAutoPtr.hpp"
+#include "IndexWrapper.hpp"
+
+struct IDXGIAdapter3;
+
+namespace Diligent
+{
+
+class RenderDeviceD3D12Impl;
+
+// Keeps committed resources within the video memory budget reported by the OS.
+//
+// Device contexts record the resources that every command list references in its residency set.
+// Before the command lists are executed, the manager makes the referenced resources resident and,
+// when the memory usage exceeds the budget, evicts the least recently used resources that are not
+// accessed by the GPU anymore.
+//
+// https://learn.microsoft.com/en-us/windows/win32/direct3d12/residency
+class ResidencyManagerD3D12
+{
+public:
+    // Residency state of a committed resource.
+    class Handle
+    {
+    public:
+        Handle() noexcept {}
+        ~Handle();
+
+        // clang-format off
+        Handle             (const Handle&)  = delete;
+        Handle             (      Handle&&) = delete;
+        Handle& operator = (const Handle&)  = delete;
+        Handle& operator = (      Handle&&) = delete;
+        // clang-format on
+
+        bool IsRegistered() const { return m_pMgr != nullptr; }
+
+        // Removes the resource from the manager it was registered with.
+        // This must be done before the D3D12 resource is released.
+        void Unregister();
+
+    private:
+        friend class ResidencyManagerD3D12;
+
+        ResidencyManagerD3D12* m_pMgr           = nullptr;
+        ID3D12Pageable*        m_pd3d12Pageable = nullptr;
+        Uint64                 m_Size           = 0;
+
+        // The members below are protected by the manager mutex.
+
+        // Index of the last submission that referenced the resource
+        Uint64 m_LastSubmitIndex = 0;
+
+        bool m_IsResident = true;
+
+        // Resident resources that have been used at least once are kept in the list sorted
+        // by the last submission index, the least recently used resource first.
+        bool    m_IsInList = false;
+        Handle* m_pPrev    = nullptr;
+        Handle* m_pNext    = nullptr;
+
+        // Tag of the last residency set the resource was added to
+        std::atomic<Uint64> m_SetTag{0};
+    };
+
+    // Resources referenced by a command list.
+    class ResidencySet
+    {
+    public:
+        // Starts a new set. pMgr is null when residency management is disabled.
+        void Reset(ResidencyManagerD3D12* pMgr);
+
+        // Adds the resource to the set. The set keeps a reference to the object
+        // until the command list is submitted.
+        void Add(Handle& ResHandle, IDeviceObject* pObject)
+        {
+            // Only committed resources are registered with the manager
+            if (!ResHandle.IsRegistered())
+                return;
+
+            // A resource is added to the set only once. If the tag was overwritten by
+            // another set in the meantime, the duplicate entry is harmless.
+            if (ResHandle.m_SetTag.exchange(m_Tag, std::memory_order_relaxed) != m_Tag)
+                m_Entries.emplace_back(&ResHandle, pObject);
+        }
+
+        bool IsEmpty() const { return m_Entries.empty(); }
+
+        void Clear() { m_Entries.clear(); }
+
+    private:
+        friend class ResidencyManagerD3D12;
+
+        Uint64 m_Tag = 0;
+
+        std::vector<std::pair<Handle*, RefCntAutoPtr<IDeviceObject>>> m_Entries;
+    };
+
+    ResidencyManagerD3D12(RenderDeviceD3D12Impl& DeviceD3D12Impl, Float32 BudgetFraction);
+    ~ResidencyManagerD3D12();
+
+    // clang-format off
+    ResidencyManagerD3D12             (const ResidencyManagerD3D12&)  = delete;
+    ResidencyManagerD3D12             (      ResidencyManagerD3D12&&) = delete;
+    ResidencyManagerD3D12& operator = (const ResidencyManagerD3D12&)  = delete;
+    ResidencyManagerD3D12& operator = (      ResidencyManagerD3D12&&) = delete;
+    // clang-format on
+
+    // Registers a committed resource. The resource is never evicted before
+    // it has been referenced by a submitted command list.
+    void Register(Handle& ResHandle, ID3D12Resource* pd3d12Resource);
+
+    // Makes all resources referenced by the residency sets resident, evicting the least recently
+    // used resources if necessary, and calls SubmitFunc() that must submit the command lists and
+    // return the fence value that is signaled by the submission.
+    // The manager mutex is held while the command lists are submitted, so that resources referenced
+    // by the submission can't be evicted by another queue before they are used by the GPU.
+    template <typename SubmitFuncType>
+    Uint64 Submit(SoftwareQueueIndex CommandQueueId, ResidencySet* const* ppSets, Uint32 NumSets, SubmitFuncType&& SubmitFunc)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        const auto SubmitIndex = m_NextSubmitIndex++;
+        PrepareSubmission(SubmitIndex, ppSets, NumSets);
+
+        const Uint64 FenceValue = SubmitFunc();
+        m_Submissions.push_back({SubmitIndex, CommandQueueId, FenceValue});
+        return FenceValue;
+    }
+
+    Uint64 GetNextSetTag()
+    {
+        return m_NextSetTag.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    void PrepareSubmission(Uint64 SubmitIndex, ResidencySet* const* ppSets, Uint32 NumSets);
+    void UpdateCompletedSubmitIndex();
+    void EvictColdResources(Uint64 RequiredSize);
+
+    void AddToList(Handle& ResHandle);
+    void RemoveFromList(Handle& ResHandle);
+
+    RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
+
+    CComPtr<IDXGIAdapter3> m_pAdapter;
+
+    const Float32 m_BudgetFraction;
+
+    std::mutex m_Mtx;
+
+    Handle* m_pListHead = nullptr;
+    Handle* m_pListTail = nullptr;
+
+    Uint64 m_NextSubmitIndex      = 1;
+    Uint64 m_CompletedSubmitIndex = 0;
+
+    struct SubmissionInfo
+    {
+        Uint64             Index;
+        SoftwareQueueIndex QueueId;
+        Uint64             FenceValue;
+    };
+    std::deque<SubmissionInfo> m_Submissions;
+
+    std::atomic<Uint64> m_NextSetTag{1};
+
+    // Scratch arrays reused by PrepareSubmission
+    std::vector<Handle*>         m_PendingResident;
+    std::vector<ID3D12Pageable*> m_Pageables;
+};
+
+} // namespace Diligent
@@ -115,14 +115,15 @@ static_assert(sizeof(RootParameter) == sizeof(D3D12_ROOT_PARAMETER) + sizeof(Uin
 /// root indices and shader spaces are biased based on earlier signatures.
 
 // Note that root index is NOT the same as the index of
-// the root table or index of the root view, e.g.
+// the root table, root view or root constants, e.g.
 //
-//   Root Index |  Root Table Index | Root View Index
-//       0      |         0         |
-//       1      |                   |        0
-//       2      |         1         |
-//       3      |         2         |
-//       4      |                   |        1
+//   Root Index |  Root Table Index | Root View Index | Root Constants Index
+//       0      |         0         |                 |
+//       1      |                   |        0        |
+//       2      |         1         |                 |
+//       3      |                   |                 |          0
+//       4      |         2         |                 |
+//       5      |                   |        1        |
 //
 class RootParamsManager
 {
@@ -139,6 +140,7 @@ public:
 
     Uint32 GetNumRootTables() const { return m_NumRootTables; }
     Uint32 GetNumRootViews() const { return m_NumRootViews; }
+    Uint32 GetNumRootConstants() const { return m_NumRootConstants; }
 
     const RootParameter& GetRootTable(Uint32 TableInd) const
     {
@@ -152,6 +154,12 @@ public:
         return m_pRootViews[ViewInd];
     }
 
+    const RootParameter& GetRootConstants(Uint32 ConstInd) const
+    {
+        VERIFY_EXPR(ConstInd < m_NumRootConstants);
+        return m_pRootConstants[ConstInd];
+    }
+
     // Returns the total number of resources in a given parameter group and descriptor heap type
     Uint32 GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE d3d12HeapType, ROOT_PARAMETER_GROUP Group) const
     {
@@ -169,11 +177,13 @@ private:
 
     std::unique_ptr<void, STDDeleter<void, IMemoryAllocator>> m_pMemory;
 
-    Uint32 m_NumRootTables = 0;
-    Uint32 m_NumRootViews  = 0;
+    Uint32 m_NumRootTables    = 0;
+    Uint32 m_NumRootViews     = 0;
+    Uint32 m_NumRootConstants = 0;
 
-    const RootParameter* m_pRootTables = nullptr;
-    const RootParameter* m_pRootViews  = nullptr;
+    const RootParameter* m_pRootTables    = nullptr;
+    const RootParameter* m_pRootViews     = nullptr;
+    const RootParameter* m_pRootConstants = nullptr;
 
     // The total number of resources placed in descriptor tables for each heap type and parameter group type
     std::array<std::array<Uint32, ROOT_PARAMETER_GROUP_COUNT>, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> m_ParameterGroupSizes{};
@@ -185,6 +195,9 @@ public:
     RootParamsBuilder();
 
     // Allocates root parameter slot for the given resource attributes.
+    // For D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS, ArraySize 32-bit values are
+    // allocated in the root constants parameter bound to the given register and space;
+    // OffsetFromTableStart is set to the offset of the first value.
     void AllocateResourceSlot(SHADER_TYPE                   ShaderStages,
                               SHADER_RESOURCE_VARIABLE_TYPE VariableType,
                               D3D12_ROOT_PARAMETER_TYPE     RootParameterType,
@@ -206,6 +219,12 @@ private:
                                D3D12_SHADER_VISIBILITY   Visibility,
                                ROOT_PARAMETER_GROUP      RootType);
 
+    // Adds a new root constants parameter and returns the index of the parameter in m_RootConstants.
+    size_t AddRootConstants(Uint32               RootIndex,
+                            UINT                 Register,
+                            UINT                 RegisterSpace,
+                            ROOT_PARAMETER_GROUP Group);
+
     struct RootTableData;
     // Adds a new root table parameter and returns the reference to it.
     RootTableData& AddRootTable(Uint32                  RootIndex,
@@ -232,6 +251,14 @@ private:
     std::vector<RootTableData> m_RootTables;
     std::vector<RootParameter> m_RootViews;
 
+    struct RootConstantsData
+    {
+        const Uint32               RootIndex;
+        const ROOT_PARAMETER_GROUP Group;
+        D3D12_ROOT_PARAMETER       d3d12RootParam{};
+    };
+    std::vector<RootConstantsData> m_RootConstants;
+
     static constexpr int InvalidRootTableIndex = -1;
 
     // The array below contains the index of a CBV/SRV/UAV root table in m_RootTables
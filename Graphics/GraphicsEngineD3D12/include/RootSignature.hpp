@@ -55,6 +55,8 @@
 #include "ShaderResources.hpp"
 #include "ObjectBase.hpp"
 #include "ResourceBindingMap.hpp"
+#include "Serializer.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -165,6 +167,12 @@ private:
 
 
 /// Root signature cache that deduplicates RootSignatureD3D12 objects.
+///
+/// The cache also keeps serialized root signature blobs keyed by the contents of
+/// the root signature description, so that a description that has been seen before
+/// does not need to go through D3D12SerializeRootSignature() again. The blobs can be
+/// saved with SerializeBlobs() and loaded with PrecreateRootSignatures(), which creates
+/// the d3d12 root signature objects up front, e.g. during device initialization.
 class RootSignatureCacheD3D12
 {
 public:
@@ -183,11 +191,32 @@ public:
 
     void OnDestroyRootSig(RootSignatureD3D12* pRootSig);
 
+    // Returns the d3d12 root signature for the given description, reusing the
+    // cached blob or pre-created object if the description has been seen before.
+    CComPtr<ID3D12RootSignature> CreateD3D12RootSignature(const D3D12_ROOT_SIGNATURE_DESC& d3d12RootSigDesc) noexcept(false);
+
+    // Writes all cached root signature blobs into the data blob.
+    void SerializeBlobs(IDataBlob** ppBlob);
+
+    // Loads root signature blobs previously written by SerializeBlobs() and creates
+    // d3d12 root signatures for them. If pThreadPool is not null, the root signatures
+    // are created in parallel. Returns the number of created root signatures.
+    Uint32 PrecreateRootSignatures(const void* pData, size_t DataSize, IThreadPool* pThreadPool);
+
 private:
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
     std::mutex                                                         m_RootSigCacheMtx;
     std::unordered_multimap<size_t, RefCntWeakPtr<RootSignatureD3D12>> m_RootSigCache;
+
+    struct RootSigBlob
+    {
+        SerializedData               Blob;
+        CComPtr<ID3D12RootSignature> pd3d12RootSig;
+    };
+    // Serialized root signature description -> root signature blob
+    std::mutex                                                              m_BlobsMtx;
+    std::unordered_map<SerializedData, RootSigBlob, SerializedData::Hasher> m_Blobs;
 };
 
 } // namespace Diligent
@@ -52,7 +52,7 @@
 // The cache is also assigned descriptor heap space to store descriptor handles.
 // Static and mutable table resources are stored in shader-visible heap.
 // Dynamic table resources are stored in CPU-only heap.
-// Root views are not assigned descriptor space.
+// Root views and root constants that hold bindless resource indices are not assigned descriptor space.
 //
 //
 //      DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
@@ -159,6 +159,7 @@ public:
 
     static constexpr Uint32 InvalidDescriptorOffset = ~0u;
 
+    // sizeof(Resource) == 40 (x64, msvc, Release)
     struct Resource
     {
         Resource() noexcept {}
@@ -186,17 +187,23 @@ public:
             }
         }
 
-        SHADER_RESOURCE_TYPE Type = SHADER_RESOURCE_TYPE_UNKNOWN;
+        // Members that are accessed when resources are committed and transitioned go first.
+        // The buffer range is only read when a CBV is created and when root views are committed.
 
-        Uint64 BufferDynamicOffset = 0;
+        // clang-format off
+/* 0 */ SHADER_RESOURCE_TYPE Type = SHADER_RESOURCE_TYPE_UNKNOWN;
+/*1-3*/ // Unused
+/* 4 */ Uint32 BufferDynamicOffset = 0;
 
         // CPU descriptor handle of a cached resource in CPU-only descriptor heap.
         // This handle may be null for CBVs that address the buffer range.
-        D3D12_CPU_DESCRIPTOR_HANDLE  CPUDescriptorHandle = {};
-        RefCntAutoPtr<IDeviceObject> pObject;
+/* 8 */ D3D12_CPU_DESCRIPTOR_HANDLE  CPUDescriptorHandle = {};
+/*16 */ RefCntAutoPtr<IDeviceObject> pObject;
 
-        Uint64 BufferBaseOffset = 0;
-        Uint64 BufferRangeSize  = 0;
+/*24 */ Uint64 BufferBaseOffset = 0;
+/*32 */ Uint64 BufferRangeSize  = 0;
+/*40 */ // End of structure
+        // clang-format on
 
         bool IsNull() const { return pObject == nullptr; }
 
@@ -331,6 +338,9 @@ public:
     // Transitions all resources in the cache
     void TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode);
 
+    // Adds all committed resources in the cache to the residency set of the command list
+    void TrackResidency(CommandContext& Ctx);
+
     ResourceCacheContentType GetContentType() const { return m_ContentType; }
 
     // Returns the bitmask indicating root views with bound dynamic buffers (including buffer ranges)
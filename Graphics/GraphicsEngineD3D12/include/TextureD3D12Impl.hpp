@@ -102,6 +102,9 @@ protected:
     void InitSparseProperties();
 
     D3D12_PLACED_SUBRESOURCE_FOOTPRINT* m_StagingFootprints = nullptr;
+
+    // Heap memory that hosts the texture if it is a placed resource
+    D3D12MemoryAllocation m_MemoryAllocation;
 };
 
 } // namespace Diligent
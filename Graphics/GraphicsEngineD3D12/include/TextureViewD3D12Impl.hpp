@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::TextureViewD3D12Impl class
 
+#include <atomic>
+
 #include "EngineD3D12ImplTraits.hpp"
 #include "TextureViewBase.hpp"
 #include "DescriptorHeap.hpp"
@@ -61,6 +63,14 @@ public:
         return m_Descriptor.GetCpuHandle();
     }
 
+    /// Returns the index of the view descriptor in the shader-visible CBV/SRV/UAV heap.
+    /// The descriptor is copied to the heap when the method is called for the first time.
+    Uint32 GetBindlessDescriptorIndex()
+    {
+        const auto Index = m_BindlessDescriptorIndex.load(std::memory_order_acquire);
+        return Index != GPUDescriptorHeap::InvalidDescriptorIndex ? Index : CreateBindlessDescriptor();
+    }
+
     D3D12_CPU_DESCRIPTOR_HANDLE GetMipLevelUAV(Uint32 Mip)
     {
         VERIFY_EXPR((m_Desc.Flags & TEXTURE_VIEW_FLAG_ALLOW_MIP_MAP_GENERATION) != 0 && m_MipGenerationDescriptors != nullptr && Mip < m_Desc.NumMipLevels);
@@ -73,6 +83,9 @@ public:
         return m_MipGenerationDescriptors[0].GetCpuHandle();
     }
 
+private:
+    Uint32 CreateBindlessDescriptor();
+
 protected:
     /// D3D12 view descriptor handle
     DescriptorHeapAllocation m_Descriptor;
@@ -81,6 +94,10 @@ protected:
     // [0] == texture array SRV used for mipmap generation
     // [1] == mip level UAVs used for mipmap generation
     DescriptorHeapAllocation* m_MipGenerationDescriptors = nullptr;
+
+    // Persistent slot in the shader-visible heap used by bindless resources
+    DescriptorHeapAllocation m_BindlessDescriptor;
+    std::atomic<Uint32>      m_BindlessDescriptorIndex{GPUDescriptorHeap::InvalidDescriptorIndex};
 };
 
 } // namespace Diligent
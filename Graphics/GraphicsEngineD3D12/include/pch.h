@@ -61,6 +61,20 @@ enum D3D12_SHADING_RATE_COMBINER
 constexpr D3D12_RESOURCE_STATES D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE = static_cast<D3D12_RESOURCE_STATES>(0x1000000);
 #endif
 
+#ifndef NTDDI_WIN10_FE // First defined in Win SDK 10.0.20348.0
+constexpr D3D12_ROOT_SIGNATURE_FLAGS D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(0x400);
+#endif
+
+#if defined(__ID3D12GraphicsCommandList7_INTERFACE_DEFINED__) && defined(D3D12_H_HAS_MESH_SHADER)
+// ID3D12GraphicsCommandList7 and enhanced barriers are first defined in Agility SDK 1.606
+#    define D3D12_H_HAS_ENHANCED_BARRIERS
+#endif
+
+#if defined(__ID3D12GraphicsCommandList10_INTERFACE_DEFINED__) && defined(D3D12_H_HAS_ENHANCED_BARRIERS)
+// ID3D12GraphicsCommandList10 and work graphs are first defined in Agility SDK 1.613
+#    define D3D12_H_HAS_WORK_GRAPHS
+#endif
+
 #include "PlatformDefinitions.h"
 #include "Errors.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -39,6 +39,127 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextD3D12 =
     {0xdde9e3ab, 0x5109, 0x4026, {0x92, 0xb7, 0xf5, 0xe7, 0xec, 0x83, 0xe2, 0x1e}};
 
+// clang-format off
+
+/// Indirect command argument type, see Diligent::IndirectCommandArgumentDesc.
+DILIGENT_TYPED_ENUM(INDIRECT_COMMAND_ARGUMENT_TYPE, Uint8)
+{
+    /// Undefined argument type.
+    INDIRECT_COMMAND_ARGUMENT_TYPE_UNDEFINED = 0,
+
+    /// Sets the vertex buffer in the slot given by IndirectCommandArgumentDesc::Slot.
+    /// The argument data is D3D12_VERTEX_BUFFER_VIEW (16 bytes).
+    INDIRECT_COMMAND_ARGUMENT_TYPE_VERTEX_BUFFER,
+
+    /// Sets the index buffer.
+    /// The argument data is D3D12_INDEX_BUFFER_VIEW (16 bytes).
+    INDIRECT_COMMAND_ARGUMENT_TYPE_INDEX_BUFFER,
+
+    /// Sets the constant buffer identified by IndirectCommandArgumentDesc::Name.
+    /// The argument data is the buffer GPU virtual address (8 bytes).
+    /// The buffer must be a single root constant buffer, i.e. it must not be an array and
+    /// must not be labeled with PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS flag.
+    INDIRECT_COMMAND_ARGUMENT_TYPE_CONSTANT_BUFFER,
+
+    /// Sets descriptor heap indices of the bindless resource identified by IndirectCommandArgumentDesc::Name
+    /// (see PIPELINE_RESOURCE_FLAG_BINDLESS). The argument data is one Uint32 index per array element.
+    INDIRECT_COMMAND_ARGUMENT_TYPE_BINDLESS_INDICES,
+
+    /// Non-indexed draw. The argument data is D3D12_DRAW_ARGUMENTS (16 bytes).
+    INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW,
+
+    /// Indexed draw. The argument data is D3D12_DRAW_INDEXED_ARGUMENTS (20 bytes).
+    INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED,
+
+    INDIRECT_COMMAND_ARGUMENT_TYPE_LAST = INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED
+};
+
+
+/// Describes a single argument of an indirect command, see Diligent::ExecuteIndirectCommandsAttribs.
+struct IndirectCommandArgumentDesc
+{
+    /// Argument type, see Diligent::INDIRECT_COMMAND_ARGUMENT_TYPE.
+    INDIRECT_COMMAND_ARGUMENT_TYPE Type  DEFAULT_INITIALIZER(INDIRECT_COMMAND_ARGUMENT_TYPE_UNDEFINED);
+
+    /// Vertex buffer slot for INDIRECT_COMMAND_ARGUMENT_TYPE_VERTEX_BUFFER argument.
+    Uint32                         Slot  DEFAULT_INITIALIZER(0);
+
+    /// Resource name for INDIRECT_COMMAND_ARGUMENT_TYPE_CONSTANT_BUFFER and
+    /// INDIRECT_COMMAND_ARGUMENT_TYPE_BINDLESS_INDICES arguments.
+    /// The resource is searched in all signatures of the currently bound pipeline.
+    const Char*                    Name  DEFAULT_INITIALIZER(nullptr);
+
+    /// Shader stages used to find the resource by name.
+    /// SHADER_TYPE_UNKNOWN means the first resource with the given name in any stage.
+    SHADER_TYPE                    ShaderStages DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr IndirectCommandArgumentDesc() noexcept {}
+
+    constexpr IndirectCommandArgumentDesc(INDIRECT_COMMAND_ARGUMENT_TYPE _Type,
+                                          Uint32                         _Slot         = IndirectCommandArgumentDesc{}.Slot,
+                                          const Char*                    _Name         = IndirectCommandArgumentDesc{}.Name,
+                                          SHADER_TYPE                    _ShaderStages = IndirectCommandArgumentDesc{}.ShaderStages) noexcept :
+        Type        {_Type        },
+        Slot        {_Slot        },
+        Name        {_Name        },
+        ShaderStages{_ShaderStages}
+    {}
+#endif
+};
+typedef struct IndirectCommandArgumentDesc IndirectCommandArgumentDesc;
+
+
+/// Attributes of IDeviceContextD3D12::ExecuteIndirectCommands() command.
+struct ExecuteIndirectCommandsAttribs
+{
+    /// Array of NumArguments command arguments. The last argument must be
+    /// INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW or INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED,
+    /// and no other argument may be a draw.
+    const IndirectCommandArgumentDesc* pArguments   DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pArguments array.
+    Uint32                             NumArguments DEFAULT_INITIALIZER(0);
+
+    /// The maximum number of commands to execute.
+    /// If pCounterBuffer is not null, the actual number of commands is
+    /// min(MaxCommandCount, counter buffer value).
+    Uint32                             MaxCommandCount DEFAULT_INITIALIZER(1);
+
+    /// The buffer that contains the command stream.
+    IBuffer*                           pArgsBuffer  DEFAULT_INITIALIZER(nullptr);
+
+    /// The offset of the first command in pArgsBuffer.
+    Uint64                             ArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// The distance between consecutive commands, in bytes.
+    /// If zero, the commands are tightly packed.
+    Uint32                             ArgsStride   DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for pArgsBuffer.
+    RESOURCE_STATE_TRANSITION_MODE     ArgsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Optional buffer that contains the Uint32 command count.
+    IBuffer*                           pCounterBuffer DEFAULT_INITIALIZER(nullptr);
+
+    /// The offset of the command count in pCounterBuffer.
+    Uint64                             CounterOffset  DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for pCounterBuffer.
+    RESOURCE_STATE_TRANSITION_MODE     CounterBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Index type of the currently bound index buffer.
+    /// Only used for indexed draws that do not set the index buffer through
+    /// INDIRECT_COMMAND_ARGUMENT_TYPE_INDEX_BUFFER argument.
+    VALUE_TYPE                         IndexType    DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Draw flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                         Flags        DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+};
+typedef struct ExecuteIndirectCommandsAttribs ExecuteIndirectCommandsAttribs;
+
+// clang-format on
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextD3D12
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -85,6 +206,25 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextD3D12, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL ID3D12GraphicsCommandList* METHOD(GetD3D12CommandList)(THIS) PURE;
+
+    /// Executes a stream of GPU-generated draw commands that may also change vertex buffers,
+    /// the index buffer, root constant buffers and bindless resource indices between draws.
+
+    /// \param [in] Attribs - Command attributes, see Diligent::ExecuteIndirectCommandsAttribs.
+    ///
+    /// \remarks  Every command in the stream contains the data of all arguments in pArguments
+    ///           array, tightly packed in the same order. The command layout is translated into
+    ///           a D3D12 command signature that is created once and cached by the context.
+    ///
+    ///           A graphics pipeline must be bound. Shader resources of the pipeline are committed
+    ///           before the commands are executed, the same way as for other draw commands.
+    ///           Vertex buffers, the index buffer and root arguments that are changed by the commands
+    ///           are restored from the context state by the next draw command.
+    ///
+    ///           The buffers referenced by the command stream must be transitioned to the
+    ///           appropriate states by the application.
+    VIRTUAL void METHOD(ExecuteIndirectCommands)(THIS_
+                                                 const ExecuteIndirectCommandsAttribs REF Attribs) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -94,9 +234,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextD3D12_TransitionTextureState(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,This, __VA_ARGS__)
-#    define IDeviceContextD3D12_TransitionBufferState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState, This, __VA_ARGS__)
-#    define IDeviceContextD3D12_GetD3D12CommandList(This)         CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,   This)
+#    define IDeviceContextD3D12_TransitionTextureState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,  This, __VA_ARGS__)
+#    define IDeviceContextD3D12_TransitionBufferState(This, ...)   CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState,   This, __VA_ARGS__)
+#    define IDeviceContextD3D12_GetD3D12CommandList(This)          CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,     This)
+#    define IDeviceContextD3D12_ExecuteIndirectCommands(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, ExecuteIndirectCommands, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -120,6 +120,17 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceD3D12, IRenderDevice)
 
     /// Returns the maximum shader version supported by this render device.
     VIRTUAL const ShaderVersion REF METHOD(GetMaxShaderVersion)(THIS) CONST PURE;
+
+    /// Creates a data blob with the serialized root signatures that have been created by the device.
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                       data blob will be stored.
+    ///
+    /// \remarks   The data can be passed to EngineD3D12CreateInfo::pRootSignatureCacheData
+    ///            when the device is created next time so that the root signatures are created
+    ///            during device initialization rather than when pipeline states are first created.
+    VIRTUAL void METHOD(GetRootSignatureCacheData)(THIS_
+                                                   IDataBlob** ppData) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -135,6 +146,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceD3D12_CreateBLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBLASFromD3DResource,    This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_CreateTLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTLASFromD3DResource,    This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_GetMaxShaderVersion(This)               CALL_IFACE_METHOD(RenderDeviceD3D12, GetMaxShaderVersion,          This)
+#    define IRenderDeviceD3D12_GetRootSignatureCacheData(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, GetRootSignatureCacheData,    This, __VA_ARGS__)
 
 // clang-format on
 
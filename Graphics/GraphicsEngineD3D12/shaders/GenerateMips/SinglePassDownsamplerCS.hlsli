@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+// Single-pass downsampler: generates up to 12 mip levels of a texture with one dispatch.
+//
+// Every thread group reduces a 64x64 tile of the source mip level to mip levels 1 through 6
+// in group shared memory. The group then writes its mip 6 texel to the scratch buffer and
+// increments the atomic counter of the array slice. The last group to finish reads the
+// complete mip 6 level from the scratch buffer and generates the remaining mip levels.
+//
+// Mip N+1 texel (x, y) is the average of mip N texels (2x, 2y) - (2x+1, 2y+1). The last
+// row or column of an odd-sized level does not contribute to the next level.
+
+#define RootSig \
+    "RootFlags(0), " \
+    "RootConstants(b0, num32BitConstants = 8), " \
+    "DescriptorTable(SRV(t0, numDescriptors = 1))," \
+    "DescriptorTable(UAV(u0, numDescriptors = 13))," \
+    "StaticSampler(s0," \
+        "addressU = TEXTURE_ADDRESS_CLAMP," \
+        "addressV = TEXTURE_ADDRESS_CLAMP," \
+        "addressW = TEXTURE_ADDRESS_CLAMP," \
+        "filter = FILTER_MIN_MAG_MIP_LINEAR)"
+
+// Must match the value in GenerateMips.cpp
+#define SCRATCH_COUNTERS_SIZE 256
+
+Texture2DArray<float4> SrcTex        : register(t0);
+SamplerState           BilinearClamp : register(s0);
+
+RWTexture2DArray<float4> OutMip1  : register(u0);
+RWTexture2DArray<float4> OutMip2  : register(u1);
+RWTexture2DArray<float4> OutMip3  : register(u2);
+RWTexture2DArray<float4> OutMip4  : register(u3);
+RWTexture2DArray<float4> OutMip5  : register(u4);
+RWTexture2DArray<float4> OutMip6  : register(u5);
+RWTexture2DArray<float4> OutMip7  : register(u6);
+RWTexture2DArray<float4> OutMip8  : register(u7);
+RWTexture2DArray<float4> OutMip9  : register(u8);
+RWTexture2DArray<float4> OutMip10 : register(u9);
+RWTexture2DArray<float4> OutMip11 : register(u10);
+RWTexture2DArray<float4> OutMip12 : register(u11);
+
+// Atomic counters of every array slice in the dispatch, followed by
+// the 64x64 mip 6 texels of every slice.
+globallycoherent RWByteAddressBuffer Scratch : register(u12);
+
+cbuffer CB : register(b0)
+{
+    uint  SrcMipLevel;     // Source mip level, relative to the view
+    uint  NumMipLevels;    // Number of mip levels to generate: [1, 12]
+    uint  FirstArraySlice; // First array slice processed by the dispatch, relative to the view
+    uint  NumWorkGroups;   // Number of thread groups per array slice
+    uint2 SrcMipSize;      // Dimensions of the source mip level
+    uint2 Dummy;
+}
+
+// The reason for separating channels is to reduce bank conflicts in the
+// local data memory controller.
+groupshared float gs_R[1024];
+groupshared float gs_G[1024];
+groupshared float gs_B[1024];
+groupshared float gs_A[1024];
+groupshared uint  gs_Counter;
+
+void StoreColor(uint Index, float4 Color)
+{
+    gs_R[Index] = Color.r;
+    gs_G[Index] = Color.g;
+    gs_B[Index] = Color.b;
+    gs_A[Index] = Color.a;
+}
+
+float4 LoadColor(uint Index)
+{
+    return float4(gs_R[Index], gs_G[Index], gs_B[Index], gs_A[Index]);
+}
+
+float3 LinearToSRGB(float3 x)
+{
+    // This is cheaper but nearly equivalent to the exact sRGB curve
+    return x < 0.0031308 ? 12.92 * x : 1.13005 * sqrt(abs(x - 0.00228)) - 0.13448 * x + 0.005719;
+}
+
+float4 PackColor(float4 Linear)
+{
+#ifdef CONVERT_TO_SRGB
+    return float4(LinearToSRGB(Linear.rgb), Linear.a);
+#else
+    return Linear;
+#endif
+}
+
+uint2 GetMipSize(uint Mip)
+{
+    return max(SrcMipSize >> Mip, uint2(1, 1));
+}
+
+uint GetMip6TexelOffset(uint SliceInDispatch, uint2 Texel)
+{
+    return SCRATCH_COUNTERS_SIZE + ((SliceInDispatch * 64 + Texel.y) * 64 + Texel.x) * 16;
+}
+
+// Generates the 32x32 mip 1 tile from the source mip level and stores it in group shared memory
+void DownsampleSource(uint GI, uint2 TileOrigin, uint Slice)
+{
+    uint2 MipSize = GetMipSize(1);
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint2 Local = uint2((GI + i * 256) % 32, (GI + i * 256) / 32);
+        uint2 Texel = TileOrigin + Local;
+        // Bilinear sample at the center of the 2x2 quad is the average of the four texels
+        float2 UV    = (float2(Texel * 2) + 1.0) / float2(SrcMipSize);
+        float4 Color = SrcTex.SampleLevel(BilinearClamp, float3(UV, Slice), SrcMipLevel);
+        if (all(Texel < MipSize))
+            OutMip1[uint3(Texel, Slice)] = PackColor(Color);
+        StoreColor(Local.y * 32 + Local.x, Color);
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+// Generates the 32x32 mip 7 tile from mip 6 in the scratch buffer and stores it in group shared memory
+void DownsampleScratch(uint GI, bool Enabled, uint SliceInDispatch, uint Slice)
+{
+    uint2 SrcSize = GetMipSize(6);
+    uint2 MipSize = GetMipSize(7);
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint2 Local = uint2((GI + i * 256) % 32, (GI + i * 256) / 32);
+        if (Enabled)
+        {
+            uint2  Src0  = min(Local * 2, SrcSize - 1);
+            uint2  Src1  = min(Local * 2 + 1, SrcSize - 1);
+            float4 Color = asfloat(Scratch.Load4(GetMip6TexelOffset(SliceInDispatch, Src0))) +
+                           asfloat(Scratch.Load4(GetMip6TexelOffset(SliceInDispatch, uint2(Src1.x, Src0.y)))) +
+                           asfloat(Scratch.Load4(GetMip6TexelOffset(SliceInDispatch, uint2(Src0.x, Src1.y)))) +
+                           asfloat(Scratch.Load4(GetMip6TexelOffset(SliceInDispatch, Src1)));
+            Color *= 0.25;
+            if (all(Local < MipSize))
+                OutMip7[uint3(Local, Slice)] = PackColor(Color);
+            StoreColor(Local.y * 32 + Local.x, Color);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+// Reduces the (2*DstSize)x(2*DstSize) tile in group shared memory to DstSize x DstSize.
+// The barriers are executed by all threads of the group even if the group is disabled.
+void DownsampleLDS(uint GI, bool Enabled, uint DstSize, uint2 TileOrigin, uint Mip, RWTexture2DArray<float4> OutMip, uint Slice)
+{
+    bool   IsActive = Enabled && GI < DstSize * DstSize;
+    uint2  Local    = uint2(GI % DstSize, GI / DstSize);
+    float4 Color    = float4(0.0, 0.0, 0.0, 0.0);
+    if (IsActive)
+    {
+        uint Idx = Local.y * 2 * 32 + Local.x * 2;
+        Color    = 0.25 * (LoadColor(Idx) + LoadColor(Idx + 1) + LoadColor(Idx + 32) + LoadColor(Idx + 33));
+
+        uint2 Texel = TileOrigin + Local;
+        if (all(Texel < GetMipSize(Mip)))
+            OutMip[uint3(Texel, Slice)] = PackColor(Color);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (IsActive)
+        StoreColor(Local.y * 32 + Local.x, Color);
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[RootSignature(RootSig)]
+[numthreads(256, 1, 1)]
+void main(uint GI : SV_GroupIndex, uint3 GroupId : SV_GroupID)
+{
+    uint  Slice = FirstArraySlice + GroupId.z;
+    uint2 Tile  = GroupId.xy;
+
+    DownsampleSource(GI, Tile * 32, Slice);
+
+    // A scalar (constant) branch can exit all threads coherently.
+    if (NumMipLevels == 1)
+        return;
+    DownsampleLDS(GI, true, 16, Tile * 16, 2, OutMip2, Slice);
+    if (NumMipLevels == 2)
+        return;
+    DownsampleLDS(GI, true, 8, Tile * 8, 3, OutMip3, Slice);
+    if (NumMipLevels == 3)
+        return;
+    DownsampleLDS(GI, true, 4, Tile * 4, 4, OutMip4, Slice);
+    if (NumMipLevels == 4)
+        return;
+    DownsampleLDS(GI, true, 2, Tile * 2, 5, OutMip5, Slice);
+    if (NumMipLevels == 5)
+        return;
+    DownsampleLDS(GI, true, 1, Tile, 6, OutMip6, Slice);
+    if (NumMipLevels == 6)
+        return;
+
+    if (GI == 0)
+    {
+        Scratch.Store4(GetMip6TexelOffset(GroupId.z, Tile), asuint(LoadColor(0)));
+        // Make the texel visible to the last group before incrementing the counter
+        DeviceMemoryBarrier();
+
+        uint PrevCounter;
+        Scratch.InterlockedAdd(GroupId.z * 4, 1, PrevCounter);
+        gs_Counter = PrevCounter;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Only the last group of the slice continues. Other groups still execute all barriers
+    // below as they may not be placed in varying flow control.
+    bool IsLastGroup = gs_Counter == NumWorkGroups - 1;
+    if (IsLastGroup && GI == 0)
+    {
+        // Reset the counter for the next dispatch
+        Scratch.Store(GroupId.z * 4, 0);
+    }
+
+    DownsampleScratch(GI, IsLastGroup, GroupId.z, Slice);
+    if (NumMipLevels == 7)
+        return;
+    DownsampleLDS(GI, IsLastGroup, 16, uint2(0, 0), 8, OutMip8, Slice);
+    if (NumMipLevels == 8)
+        return;
+    DownsampleLDS(GI, IsLastGroup, 8, uint2(0, 0), 9, OutMip9, Slice);
+    if (NumMipLevels == 9)
+        return;
+    DownsampleLDS(GI, IsLastGroup, 4, uint2(0, 0), 10, OutMip10, Slice);
+    if (NumMipLevels == 10)
+        return;
+    DownsampleLDS(GI, IsLastGroup, 2, uint2(0, 0), 11, OutMip11, Slice);
+    if (NumMipLevels == 11)
+        return;
+    DownsampleLDS(GI, IsLastGroup, 1, uint2(0, 0), 12, OutMip12, Slice);
+}
@@ -31,6 +31,7 @@
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "D3D12TypeConversions.hpp"
+#include "Align.hpp"
 #include "GraphicsAccessories.hpp"
 #include "DXGITypeConversions.hpp"
 #include "StringTools.hpp"
@@ -154,6 +155,9 @@ BottomLevelASD3D12Impl::BottomLevelASD3D12Impl(IReferenceCounters*      pRefCoun
     if (FAILED(hr))
         LOG_ERROR_AND_THROW("Failed to create D3D12 Bottom-level acceleration structure");
 
+    m_GPUMemoryRecord = GPUMemoryRecord{pDeviceD3D12->GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_ACCELERATION_STRUCTURE, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                        m_Desc.Name, ResultDataMaxSizeInBytes, AlignUp(ResultDataMaxSizeInBytes, Uint64{D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT})};
+
     if (*m_Desc.Name != 0)
         m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
 
@@ -128,6 +128,9 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
 
             SetState(RESOURCE_STATE_UNDEFINED);
+
+            // Sparse buffer memory is tracked by the device memory objects it is bound to
+            RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_PLACED, 0);
         }
         else
         {
@@ -173,13 +176,40 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
                 D3D12_HEAP_FLAG_NONE;
 
-            auto hr = pd3d12Device->CreateCommittedResource(
-                &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
+            // Suballocate the buffer from a shared heap if possible, and fall back to a committed resource otherwise
+            m_MemoryAllocation = pRenderDeviceD3D12->GetMemoryManager().CreatePlacedResource(
+                HeapProps.Type, d3d12BuffDesc, d3d12State,
                 nullptr, // pOptimizedClearValue
-                __uuidof(m_pd3d12Resource),
-                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
+                m_pd3d12Resource);
+
+            HRESULT hr = S_OK;
+            if (!m_MemoryAllocation.IsValid())
+            {
+                hr = pd3d12Device->CreateCommittedResource(
+                    &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
+                    nullptr, // pOptimizedClearValue
+                    __uuidof(m_pd3d12Resource),
+                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+                if (FAILED(hr))
+                    LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
+
+                // Upload and readback heaps reside in system memory
+                if (HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT)
+                {
+                    if (auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager())
+                        pResidencyMgr->Register(m_ResidencyHandle, m_pd3d12Resource);
+                }
+            }
+
+            if (m_MemoryAllocation.IsValid())
+            {
+                RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, m_MemoryAllocation.Size);
+            }
+            else if (pRenderDeviceD3D12->GetGPUMemoryTracker() != nullptr)
+            {
+                const auto AllocInfo = pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12BuffDesc);
+                RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, AllocInfo.SizeInBytes);
+            }
 
             if (*m_Desc.Name != 0)
                 m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
@@ -336,8 +366,16 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
 
 BufferD3D12Impl::~BufferD3D12Impl()
 {
+    // The resource must be removed from the residency manager before it can be released
+    m_ResidencyHandle.Unregister();
+
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    if (m_MemoryAllocation.IsValid())
+    {
+        // The memory must be returned to the heap after the resource has been released
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+    }
 }
 
 void BufferD3D12Impl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
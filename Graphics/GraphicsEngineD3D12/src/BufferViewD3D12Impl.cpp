@@ -59,4 +59,11 @@ BufferViewD3D12Impl::~BufferViewD3D12Impl()
 {
 }
 
+Uint32 BufferViewD3D12Impl::CreateBindlessDescriptor()
+{
+    VERIFY(m_Desc.ViewType == BUFFER_VIEW_SHADER_RESOURCE || m_Desc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS,
+           "Only shader resource and unordered access views can be accessed through the descriptor heap");
+    return GetDevice()->CreateBindlessDescriptor(m_DescriptorHandle.GetCpuHandle(), m_BindlessDescriptor, m_BindlessDescriptorIndex);
+}
+
 } // namespace Diligent
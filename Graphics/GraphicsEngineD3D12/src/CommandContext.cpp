@@ -59,6 +59,11 @@ CommandContext::CommandContext(CommandListManager& CmdListManager) :
 {
     m_PendingResourceBarriers.reserve(32);
     CmdListManager.CreateNewCommandList(&m_pCommandList, &m_pCurrentAllocator, m_MaxInterfaceVer);
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    m_UseEnhancedBarriers = m_MaxInterfaceVer >= 7 && CmdListManager.GetDevice().AreEnhancedBarriersSupported();
+#endif
+    m_ResidencySet.Reset(CmdListManager.GetDevice().GetResidencyManager());
 }
 
 CommandContext::~CommandContext(void)
@@ -78,6 +83,7 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
         // command list is still being executed. A typical pattern is to submit a command list and then
         // immediately reset it to reuse the allocated memory for another command list.
         m_pCommandList->Reset(m_pCurrentAllocator, nullptr);
+        m_IsListClosed = false;
     }
 
     m_pCurPipelineState         = nullptr;
@@ -87,23 +93,34 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
     m_BoundDescriptorHeaps = ShaderDescriptorHeaps{};
 
     m_DynamicGPUDescriptorAllocators = nullptr;
+    m_pStatistics                    = nullptr;
 
     m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    m_ResidencySet.Reset(CmdListManager.GetDevice().GetResidencyManager());
 #if 0
     BindDescriptorHeaps();
 #endif
 }
 
-ID3D12GraphicsCommandList* CommandContext::Close(CComPtr<ID3D12CommandAllocator>& pAllocator)
+void CommandContext::CloseCommandList()
 {
+    VERIFY(!m_IsListClosed, "The command list has already been closed");
     FlushResourceBarriers();
 
     //if (m_ID.length() > 0)
     //  EngineProfiling::EndBlock(this);
 
-    VERIFY_EXPR(m_pCurrentAllocator != nullptr);
     auto hr = m_pCommandList->Close();
     DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to close the command list");
+    m_IsListClosed = true;
+}
+
+ID3D12GraphicsCommandList* CommandContext::Close(CComPtr<ID3D12CommandAllocator>& pAllocator)
+{
+    VERIFY_EXPR(m_pCurrentAllocator != nullptr);
+    if (!m_IsListClosed)
+        CloseCommandList();
 
     pAllocator = std::move(m_pCurrentAllocator);
     return m_pCommandList;
@@ -439,12 +456,14 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
 
 void CommandContext::TransitionResource(TextureD3D12Impl& Texture, const StateTransitionDesc& Barrier)
 {
+    TrackResidency(Texture);
     StateTransitionHelper Helper{Barrier, *this};
     Helper(Texture);
 }
 
 void CommandContext::TransitionResource(BufferD3D12Impl& Buffer, const StateTransitionDesc& Barrier)
 {
+    TrackResidency(Buffer);
     StateTransitionHelper Helper{Barrier, *this};
     Helper(Buffer);
 }
@@ -461,6 +480,195 @@ void CommandContext::TransitionResource(TopLevelASD3D12Impl& TLAS, const StateTr
     Helper(TLAS);
 }
 
+namespace
+{
+
+bool BarrierReferencesResource(const D3D12_RESOURCE_BARRIER& Barrier, const ID3D12Resource* pResource)
+{
+    switch (Barrier.Type)
+    {
+        case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            return Barrier.Transition.pResource == pResource;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+            return Barrier.Aliasing.pResourceBefore == pResource || Barrier.Aliasing.pResourceAfter == pResource;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            // UAV barrier with null resource applies to all resources
+            return Barrier.UAV.pResource == pResource || Barrier.UAV.pResource == nullptr;
+
+        default:
+            UNEXPECTED("Unexpected barrier type");
+            return true;
+    }
+}
+
+} // namespace
+
+void CommandContext::ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier)
+{
+    // No commands are recorded between the pending barriers, so transitions of the same
+    // resource can be merged and split barriers can be replaced with a single barrier.
+    if (Barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+    {
+        const auto& NewTransition = Barrier.Transition;
+        for (size_t i = m_PendingResourceBarriers.size(); i > 0; --i)
+        {
+            auto& Pending = m_PendingResourceBarriers[i - 1];
+            if (!BarrierReferencesResource(Pending, NewTransition.pResource))
+                continue;
+
+            // Only the last pending barrier that references the resource can be merged with the new one
+            if (Pending.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+                Pending.Transition.Subresource == NewTransition.Subresource &&
+                Pending.Transition.StateAfter == NewTransition.StateBefore)
+            {
+                if (Pending.Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY && Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+                {
+                    // The split barrier begins and ends in the same batch
+                    Pending.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                    return;
+                }
+
+                if (Pending.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE)
+                {
+                    // A->B followed by B->C is equivalent to A->C
+                    Pending.Transition.StateAfter = NewTransition.StateAfter;
+                    if (Pending.Transition.StateBefore == Pending.Transition.StateAfter)
+                        m_PendingResourceBarriers.erase(m_PendingResourceBarriers.begin() + (i - 1));
+                    return;
+                }
+            }
+            break;
+        }
+    }
+    else if (Barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+    {
+        // Identical UAV barriers in the same batch are redundant
+        for (const auto& Pending : m_PendingResourceBarriers)
+        {
+            if (Pending.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && Pending.UAV.pResource == Barrier.UAV.pResource)
+                return;
+        }
+    }
+
+    m_PendingResourceBarriers.emplace_back(Barrier);
+}
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+void CommandContext::FlushEnhancedBarriers()
+{
+    VERIFY_EXPR(m_UseEnhancedBarriers && m_MaxInterfaceVer >= 7);
+    auto* pCmdList7 = static_cast<ID3D12GraphicsCommandList7*>(m_pCommandList.p);
+
+    auto RecordBarrierGroups = [&]() {
+        D3D12_BARRIER_GROUP Groups[3];
+        UINT32              NumGroups = 0;
+        if (!m_GlobalBarriers.empty())
+        {
+            Groups[NumGroups].Type            = D3D12_BARRIER_TYPE_GLOBAL;
+            Groups[NumGroups].NumBarriers     = static_cast<UINT32>(m_GlobalBarriers.size());
+            Groups[NumGroups].pGlobalBarriers = m_GlobalBarriers.data();
+            ++NumGroups;
+        }
+        if (!m_BufferBarriers.empty())
+        {
+            Groups[NumGroups].Type            = D3D12_BARRIER_TYPE_BUFFER;
+            Groups[NumGroups].NumBarriers     = static_cast<UINT32>(m_BufferBarriers.size());
+            Groups[NumGroups].pBufferBarriers = m_BufferBarriers.data();
+            ++NumGroups;
+        }
+        if (!m_TextureBarriers.empty())
+        {
+            Groups[NumGroups].Type             = D3D12_BARRIER_TYPE_TEXTURE;
+            Groups[NumGroups].NumBarriers      = static_cast<UINT32>(m_TextureBarriers.size());
+            Groups[NumGroups].pTextureBarriers = m_TextureBarriers.data();
+            ++NumGroups;
+        }
+        if (NumGroups > 0)
+            pCmdList7->Barrier(NumGroups, Groups);
+
+        m_GlobalBarriers.clear();
+        m_BufferBarriers.clear();
+        m_TextureBarriers.clear();
+    };
+
+    for (const auto& Barrier : m_PendingResourceBarriers)
+    {
+        switch (Barrier.Type)
+        {
+            case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            {
+                const auto& Transition = Barrier.Transition;
+
+                D3D12_BARRIER_SYNC   SyncBefore, SyncAfter;
+                D3D12_BARRIER_ACCESS AccessBefore, AccessAfter;
+                D3D12_BARRIER_LAYOUT LayoutBefore, LayoutAfter;
+                D3D12ResourceStatesToBarrierSyncAccessLayout(Transition.StateBefore, SyncBefore, AccessBefore, LayoutBefore);
+                D3D12ResourceStatesToBarrierSyncAccessLayout(Transition.StateAfter, SyncAfter, AccessAfter, LayoutAfter);
+
+                // Split barriers are expressed through the special split sync scope
+                if (Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+                    SyncAfter = D3D12_BARRIER_SYNC_SPLIT;
+                else if (Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+                    SyncBefore = D3D12_BARRIER_SYNC_SPLIT;
+
+                if (Transition.pResource->GetDesc().Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+                {
+                    // Buffers have no layout
+                    m_BufferBarriers.push_back({SyncBefore, SyncAfter, AccessBefore, AccessAfter, Transition.pResource, 0, UINT64_MAX});
+                }
+                else
+                {
+                    D3D12_TEXTURE_BARRIER TexBarrier{};
+                    TexBarrier.SyncBefore   = SyncBefore;
+                    TexBarrier.SyncAfter    = SyncAfter;
+                    TexBarrier.AccessBefore = AccessBefore;
+                    TexBarrier.AccessAfter  = AccessAfter;
+                    TexBarrier.LayoutBefore = LayoutBefore;
+                    TexBarrier.LayoutAfter  = LayoutAfter;
+                    TexBarrier.pResource    = Transition.pResource;
+                    // When NumMipLevels is zero, IndexOrFirstMipLevel is the subresource index,
+                    // and 0xFFFFFFFF (D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) selects all subresources.
+                    TexBarrier.Subresources.IndexOrFirstMipLevel = Transition.Subresource;
+                    TexBarrier.Subresources.NumMipLevels         = 0;
+                    TexBarrier.Flags                             = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+                    m_TextureBarriers.push_back(TexBarrier);
+                }
+                break;
+            }
+
+            case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            {
+                // Complete all previous UAV and acceleration structure writes before any following access.
+                // All UAV barriers in the batch are merged into a single global barrier.
+                if (m_GlobalBarriers.empty())
+                {
+                    m_GlobalBarriers.push_back({
+                        D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_BUILD_RAYTRACING_ACCELERATION_STRUCTURE,
+                        D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_BUILD_RAYTRACING_ACCELERATION_STRUCTURE,
+                        D3D12_BARRIER_ACCESS_UNORDERED_ACCESS | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_WRITE,
+                        D3D12_BARRIER_ACCESS_UNORDERED_ACCESS | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_READ | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_WRITE //
+                    });
+                }
+                break;
+            }
+
+            default:
+            {
+                // Aliasing barriers are recorded using the legacy API, which may be mixed with enhanced barriers.
+                // Preserve the order by recording the barriers accumulated so far first.
+                RecordBarrierGroups();
+                m_pCommandList->ResourceBarrier(1, &Barrier);
+                break;
+            }
+        }
+    }
+
+    RecordBarrierGroups();
+}
+#endif
+
 void CommandContext::InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate)
 {
     m_PendingResourceBarriers.emplace_back();
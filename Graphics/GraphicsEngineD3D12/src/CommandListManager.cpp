@@ -32,10 +32,13 @@
 namespace Diligent
 {
 
+// Private data GUID that stores the index of the thread pool the allocator belongs to
+// {B4D6C4C1-5D62-4F4B-9A0F-3E2A7B1C8D55}
+static const GUID AllocatorPoolIndexGUID = {0xb4d6c4c1, 0x5d62, 0x4f4b, {0x9a, 0x0f, 0x3e, 0x2a, 0x7b, 0x1c, 0x8d, 0x55}};
+
 CommandListManager::CommandListManager(RenderDeviceD3D12Impl& DeviceD3D12Impl, D3D12_COMMAND_LIST_TYPE ListType) :
     // clang-format off
     m_DeviceD3D12Impl{DeviceD3D12Impl},
-    m_FreeAllocators (STD_ALLOCATOR_RAW_MEM(CComPtr<ID3D12CommandAllocator>, GetRawAllocator(), "Allocator for vector<CComPtr<ID3D12CommandAllocator>>")),
     m_CmdListType    {ListType}
 // clang-format on
 {
@@ -44,7 +47,34 @@ CommandListManager::CommandListManager(RenderDeviceD3D12Impl& DeviceD3D12Impl, D
 CommandListManager::~CommandListManager()
 {
     DEV_CHECK_ERR(m_AllocatorCounter == 0, m_AllocatorCounter, " allocator(s) have not been returned to the manager. This will cause a crash if these allocators are referenced by release queues and later returned via FreeAllocator()");
-    LOG_INFO_MESSAGE("Command list manager: created ", m_FreeAllocators.size(), " allocators");
+    LOG_INFO_MESSAGE("Command list manager: created ", m_NumAllocators.load(), " allocators");
+}
+
+Uint32 CommandListManager::GetThreadPoolIndex()
+{
+    // Assign pools to threads in round-robin order so that up to NumThreadPools threads never share a pool
+    static std::atomic<Uint32>       NextPoolIdx{0};
+    static thread_local const Uint32 PoolIdx = NextPoolIdx.fetch_add(1) % NumThreadPools;
+    return PoolIdx;
+}
+
+CComPtr<ID3D12CommandAllocator> CommandListManager::PopFreeAllocator(Uint32 PoolIdx, bool Wait)
+{
+    auto& Pool = m_ThreadPools[PoolIdx];
+
+    std::unique_lock<std::mutex> Lock{Pool.Mtx, std::defer_lock};
+    if (Wait)
+        Lock.lock();
+    else if (!Lock.try_lock())
+        return {};
+
+    CComPtr<ID3D12CommandAllocator> pAllocator;
+    if (!Pool.FreeAllocators.empty())
+    {
+        pAllocator = std::move(Pool.FreeAllocators.back());
+        Pool.FreeAllocators.pop_back();
+    }
+    return pAllocator;
 }
 
 void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List, ID3D12CommandAllocator** Allocator, Uint32& IfaceVersion)
@@ -54,6 +84,14 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 
     const IID CmdListIIDs[] =
         {
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+            __uuidof(ID3D12GraphicsCommandList10),
+            __uuidof(ID3D12GraphicsCommandList9),
+            __uuidof(ID3D12GraphicsCommandList8),
+#endif
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+            __uuidof(ID3D12GraphicsCommandList7),
+#endif
 #ifdef D3D12_H_HAS_MESH_SHADER
             __uuidof(ID3D12GraphicsCommandList6),
             __uuidof(ID3D12GraphicsCommandList5),
@@ -83,73 +121,122 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 
 void CommandListManager::RequestAllocator(ID3D12CommandAllocator** ppAllocator)
 {
-    std::lock_guard<std::mutex> LockGuard{m_AllocatorMutex};
-
     VERIFY((*ppAllocator) == nullptr, "Allocator pointer is not null");
     (*ppAllocator) = nullptr;
 
-    if (!m_FreeAllocators.empty())
+    const auto PoolIdx = GetThreadPoolIndex();
+
+    auto pAllocator = PopFreeAllocator(PoolIdx, /*Wait = */ true);
+    // Reuse an allocator from the pool of another thread rather than create a new one,
+    // but never wait for the thread that owns the pool.
+    for (Uint32 i = 1; i < NumThreadPools && !pAllocator; ++i)
+        pAllocator = PopFreeAllocator((PoolIdx + i) % NumThreadPools, /*Wait = */ false);
+
+    if (pAllocator)
     {
-        *ppAllocator = m_FreeAllocators.back().Detach();
-        auto hr      = (*ppAllocator)->Reset();
+        // Resetting the allocator may take a while, so it is done outside of the pool lock
+        auto hr = pAllocator->Reset();
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to reset command allocator");
-        m_FreeAllocators.pop_back();
     }
-
-    // If no allocators were ready to be reused, create a new one
-    if ((*ppAllocator) == nullptr)
+    else
     {
+        // If no allocators were ready to be reused, create a new one
         auto* pd3d12Device = m_DeviceD3D12Impl.GetD3D12Device();
-        auto  hr           = pd3d12Device->CreateCommandAllocator(m_CmdListType, __uuidof(*ppAllocator), reinterpret_cast<void**>(ppAllocator));
+        auto  hr           = pd3d12Device->CreateCommandAllocator(m_CmdListType, __uuidof(pAllocator), reinterpret_cast<void**>(&pAllocator));
         VERIFY(SUCCEEDED(hr), "Failed to create command allocator");
         wchar_t AllocatorName[32];
         swprintf(AllocatorName, _countof(AllocatorName), L"Cmd list allocator %ld", m_NumAllocators.fetch_add(1));
-        (*ppAllocator)->SetName(AllocatorName);
+        pAllocator->SetName(AllocatorName);
+        // The allocator will always be returned to the pool of this thread
+        pAllocator->SetPrivateData(AllocatorPoolIndexGUID, sizeof(PoolIdx), &PoolIdx);
     }
+
+    *ppAllocator = pAllocator.Detach();
 #ifdef DILIGENT_DEVELOPMENT
     m_AllocatorCounter.fetch_add(1);
 #endif
 }
 
-void CommandListManager::ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+namespace
+{
+
+// Returns the allocator to the manager when the release queue destroys the object
+struct StaleAllocator
 {
-    struct StaleAllocator
+    CComPtr<ID3D12CommandAllocator> Allocator;
+    CommandListManager*             Mgr = nullptr;
+
+    // clang-format off
+    StaleAllocator() noexcept {}
+
+    StaleAllocator(CComPtr<ID3D12CommandAllocator>&& _Allocator, CommandListManager& _Mgr)noexcept :
+        Allocator {std::move(_Allocator)},
+        Mgr       {&_Mgr                }
     {
-        CComPtr<ID3D12CommandAllocator> Allocator;
-        CommandListManager*             Mgr;
+    }
 
-        // clang-format off
-        StaleAllocator(CComPtr<ID3D12CommandAllocator>&& _Allocator, CommandListManager& _Mgr)noexcept :
-            Allocator {std::move(_Allocator)},
-            Mgr       {&_Mgr                }
-        {
-        }
+    StaleAllocator            (const StaleAllocator&)  = delete;
+    StaleAllocator& operator= (const StaleAllocator&)  = delete;
 
-        StaleAllocator            (const StaleAllocator&)  = delete;
-        StaleAllocator& operator= (const StaleAllocator&)  = delete;
-        StaleAllocator& operator= (      StaleAllocator&&) = delete;
+    StaleAllocator(StaleAllocator&& rhs)noexcept :
+        Allocator {std::move(rhs.Allocator)},
+        Mgr       {rhs.Mgr                 }
+    {
+        rhs.Mgr       = nullptr;
+    }
 
-        StaleAllocator(StaleAllocator&& rhs)noexcept :
-            Allocator {std::move(rhs.Allocator)},
-            Mgr       {rhs.Mgr                 }
-        {
-            rhs.Mgr       = nullptr;
-        }
-        // clang-format on
+    StaleAllocator& operator= (StaleAllocator&& rhs)noexcept
+    {
+        VERIFY(Mgr == nullptr, "Overwriting an allocator that has not been returned to the manager");
+        Allocator = std::move(rhs.Allocator);
+        Mgr       = rhs.Mgr;
+        rhs.Mgr   = nullptr;
+        return *this;
+    }
+    // clang-format on
 
-        ~StaleAllocator()
-        {
-            if (Mgr != nullptr)
-                Mgr->FreeAllocator(std::move(Allocator));
-        }
-    };
+    ~StaleAllocator()
+    {
+        if (Mgr != nullptr)
+            Mgr->FreeAllocator(std::move(Allocator));
+    }
+};
+
+} // namespace
+
+void CommandListManager::ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+{
     m_DeviceD3D12Impl.GetReleaseQueue(CmdQueue).DiscardResource(StaleAllocator{std::move(Allocator), *this}, FenceValue);
 }
 
+void CommandListManager::ReleaseAllocators(CComPtr<ID3D12CommandAllocator>* pAllocators, size_t NumAllocators, SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+{
+    size_t Idx = 0;
+    // Add all allocators to the release queue under a single lock
+    m_DeviceD3D12Impl.GetReleaseQueue(CmdQueue).DiscardResources<StaleAllocator>(
+        FenceValue,
+        [&](StaleAllocator& Stale) {
+            if (Idx >= NumAllocators)
+                return false;
+            Stale = StaleAllocator{std::move(pAllocators[Idx++]), *this};
+            return true;
+        });
+}
+
 void CommandListManager::FreeAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator)
 {
-    std::lock_guard<std::mutex> LockGuard(m_AllocatorMutex);
-    m_FreeAllocators.emplace_back(std::move(Allocator));
+    Uint32 PoolIdx  = 0;
+    UINT   DataSize = sizeof(PoolIdx);
+    if (FAILED(Allocator->GetPrivateData(AllocatorPoolIndexGUID, &DataSize, &PoolIdx)) || PoolIdx >= NumThreadPools)
+    {
+        UNEXPECTED("Command allocator does not have a valid pool index");
+        PoolIdx = GetThreadPoolIndex();
+    }
+
+    auto& Pool = m_ThreadPools[PoolIdx];
+
+    std::lock_guard<std::mutex> LockGuard{Pool.Mtx};
+    Pool.FreeAllocators.emplace_back(std::move(Allocator));
 #ifdef DILIGENT_DEVELOPMENT
     m_AllocatorCounter.fetch_add(-1);
 #endif
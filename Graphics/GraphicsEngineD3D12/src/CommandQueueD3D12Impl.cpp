@@ -80,7 +80,7 @@ Uint64 CommandQueueD3D12Impl::Submit(Uint32                    NumCommandLists,
     }
 
     // Signal the fence. This must be done atomically with command list submission.
-    m_pd3d12CmdQueue->Signal(m_d3d12Fence, FenceValue);
+    CheckDeviceRemoved(m_pd3d12CmdQueue->Signal(m_d3d12Fence, FenceValue));
 
     return FenceValue;
 }
@@ -91,7 +91,7 @@ Uint64 CommandQueueD3D12Impl::WaitForIdle()
 
     Uint64 LastSignaledFenceValue = m_NextFenceValue.fetch_add(1);
 
-    m_pd3d12CmdQueue->Signal(m_d3d12Fence, LastSignaledFenceValue);
+    CheckDeviceRemoved(m_pd3d12CmdQueue->Signal(m_d3d12Fence, LastSignaledFenceValue));
 
     if (GetCompletedFenceValue() < LastSignaledFenceValue)
     {
@@ -105,7 +105,11 @@ Uint64 CommandQueueD3D12Impl::WaitForIdle()
 Uint64 CommandQueueD3D12Impl::GetCompletedFenceValue()
 {
     auto CompletedFenceValue = m_d3d12Fence->GetCompletedValue();
-    VERIFY(CompletedFenceValue != UINT64_MAX, "If the device has been removed, the return value will be UINT64_MAX");
+    if (CompletedFenceValue == UINT64_MAX)
+    {
+        // If the device has been removed, the return value will be UINT64_MAX
+        CheckDeviceRemoved(DXGI_ERROR_DEVICE_REMOVED);
+    }
 
     auto CurrValue = m_LastCompletedFenceValue.load();
     while (!m_LastCompletedFenceValue.compare_exchange_weak(CurrValue, std::max(CurrValue, CompletedFenceValue)))
@@ -116,6 +120,12 @@ Uint64 CommandQueueD3D12Impl::GetCompletedFenceValue()
     return m_LastCompletedFenceValue.load();
 }
 
+void CommandQueueD3D12Impl::CheckDeviceRemoved(HRESULT hr)
+{
+    if ((hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET || hr == DXGI_ERROR_DEVICE_HUNG) && !m_DeviceRemoved.exchange(true))
+        LOG_ERROR_MESSAGE("Direct3D12 device has been removed");
+}
+
 void CommandQueueD3D12Impl::EnqueueSignal(ID3D12Fence* pFence, Uint64 Value)
 {
     DEV_CHECK_ERR(pFence, "Fence must not be null");
@@ -32,7 +32,7 @@
 namespace Diligent
 {
 
-D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
+D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size, GPUMemoryTracker* pGPUMemoryTracker)
 {
     D3D12_HEAP_PROPERTIES HeapProps;
     HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
@@ -68,6 +68,9 @@ D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
 
     m_pd3d12Buffer->SetName(L"Dynamic memory page");
 
+    m_GPUMemoryRecord = GPUMemoryRecord{pGPUMemoryTracker, GPU_MEMORY_CATEGORY_DYNAMIC_HEAP, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                        "Dynamic memory page", Size, Size};
+
     m_GPUVirtualAddress = m_pd3d12Buffer->GetGPUVirtualAddress();
 
     m_pd3d12Buffer->Map(0, nullptr, &m_CPUVirtualAddress);
@@ -80,47 +83,215 @@ D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allo
                                                      Uint32                 NumPagesToReserve,
                                                      Uint64                 PageSize) :
     m_DeviceD3D12Impl{DeviceD3D12Impl},
+    m_PageSize{PageSize},
     m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>"))
 {
+    VERIFY(m_PageSize > 0, "Page size must not be zero");
     for (Uint32 i = 0; i < NumPagesToReserve; ++i)
     {
-        D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), PageSize);
-        auto             Size = Page.GetSize();
-        m_AvailablePages.emplace(Size, std::move(Page));
+        D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), m_PageSize, m_DeviceD3D12Impl.GetGPUMemoryTracker());
+        if (!Page.IsValid())
+            break;
+        ++m_NumCreatedPages;
+        ReturnPageToSharedList(std::move(Page));
+    }
+}
+
+Uint32 D3D12DynamicMemoryManager::GetPageClass(Uint64 PageSize) const
+{
+    for (Uint32 PageClass = 0; PageClass < NumPageClasses; ++PageClass)
+    {
+        const auto ClassPageSize = m_PageSize << PageClass;
+        if (ClassPageSize == PageSize)
+            return PageClass;
+        if (ClassPageSize > PageSize)
+            break;
+    }
+    return NumPageClasses;
+}
+
+Uint32 D3D12DynamicMemoryManager::RegisterPageOwner(Uint32 MaxPinnedPages)
+{
+    if (MaxPinnedPages == 0)
+        return InvalidOwnerId;
+
+    std::lock_guard<std::mutex> OwnersLock{m_PageOwnersMtx};
+    for (Uint32 OwnerId = 0; OwnerId < MaxPageOwners; ++OwnerId)
+    {
+        auto& PinnedList = m_PinnedPages[OwnerId];
+
+        Threading::SpinLockGuard PinnedLock{PinnedList.Lock};
+        if (!PinnedList.IsActive)
+        {
+            // The list may still contain pages of the previous owner that were
+            // returned after it had been unregistered.
+            PinnedList.IsActive = true;
+            PinnedList.MaxPages = MaxPinnedPages;
+            return OwnerId;
+        }
+    }
+
+    LOG_WARNING_MESSAGE("All ", MaxPageOwners, " dynamic page owner slots are in use. Dynamic pages will not be pinned.");
+    return InvalidOwnerId;
+}
+
+void D3D12DynamicMemoryManager::UnregisterPageOwner(Uint32 OwnerId)
+{
+    if (OwnerId == InvalidOwnerId)
+        return;
+
+    VERIFY_EXPR(OwnerId < MaxPageOwners);
+    std::vector<D3D12DynamicPage> Pages;
+    {
+        std::lock_guard<std::mutex> OwnersLock{m_PageOwnersMtx};
+
+        auto& PinnedList = m_PinnedPages[OwnerId];
+
+        Threading::SpinLockGuard PinnedLock{PinnedList.Lock};
+        VERIFY(PinnedList.IsActive, "Page owner ", OwnerId, " is not registered");
+        PinnedList.IsActive = false;
+        PinnedList.MaxPages = 0;
+        Pages.swap(PinnedList.Pages);
+    }
+
+    for (auto& Page : Pages)
+        ReturnPageToSharedList(std::move(Page));
+}
+
+void D3D12DynamicMemoryManager::ReleasePinnedPages(Uint32 OwnerId)
+{
+    if (OwnerId == InvalidOwnerId)
+        return;
+
+    VERIFY_EXPR(OwnerId < MaxPageOwners);
+    std::vector<D3D12DynamicPage> Pages;
+    {
+        auto& PinnedList = m_PinnedPages[OwnerId];
+
+        Threading::SpinLockGuard PinnedLock{PinnedList.Lock};
+        Pages.swap(PinnedList.Pages);
     }
+
+    for (auto& Page : Pages)
+        ReturnPageToSharedList(std::move(Page));
 }
 
-D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
+D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes, Uint32 OwnerId)
 {
-    std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPageCounter;
 #endif
-    auto PageIt = m_AvailablePages.lower_bound(SizeInBytes); // Returns an iterator pointing to the first element that is not less than key
-    if (PageIt != m_AvailablePages.end())
+
+    // Pinned pages of the owner come first
+    if (OwnerId != InvalidOwnerId)
+    {
+        VERIFY_EXPR(OwnerId < MaxPageOwners);
+        auto& PinnedList = m_PinnedPages[OwnerId];
+
+        Threading::SpinLockGuard PinnedLock{PinnedList.Lock};
+        for (auto it = PinnedList.Pages.begin(); it != PinnedList.Pages.end(); ++it)
+        {
+            if (it->GetSize() >= SizeInBytes)
+            {
+                D3D12DynamicPage Page{std::move(*it)};
+                PinnedList.Pages.erase(it);
+                ++m_NumPinnedPageHits;
+                return Page;
+            }
+        }
+    }
+
+    // Then the smallest page class that fits the requested size
+    for (Uint32 PageClass = 0; PageClass < NumPageClasses; ++PageClass)
+    {
+        if ((m_PageSize << PageClass) < SizeInBytes)
+            continue;
+
+        auto& Class = m_PageClasses[PageClass];
+
+        Threading::SpinLockGuard ClassLock{Class.Lock};
+        if (!Class.Pages.empty())
+        {
+            D3D12DynamicPage Page{std::move(Class.Pages.back())};
+            Class.Pages.pop_back();
+            ++m_NumSharedPageHits;
+            return Page;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+
+        auto PageIt = m_AvailablePages.lower_bound(SizeInBytes); // Returns an iterator pointing to the first element that is not less than key
+        if (PageIt != m_AvailablePages.end())
+        {
+            VERIFY_EXPR(PageIt->first >= SizeInBytes);
+            D3D12DynamicPage Page(std::move(PageIt->second));
+            m_AvailablePages.erase(PageIt);
+            ++m_NumSharedPageHits;
+            return Page;
+        }
+    }
+
+    D3D12DynamicPage NewPage{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes, m_DeviceD3D12Impl.GetGPUMemoryTracker()};
+    if (NewPage.IsValid())
+        ++m_NumCreatedPages;
+    return NewPage;
+}
+
+void D3D12DynamicMemoryManager::ReturnPageToSharedList(D3D12DynamicPage&& Page)
+{
+    const auto PageSize  = Page.GetSize();
+    const auto PageClass = GetPageClass(PageSize);
+    if (PageClass < NumPageClasses)
     {
-        VERIFY_EXPR(PageIt->first >= SizeInBytes);
-        D3D12DynamicPage Page(std::move(PageIt->second));
-        m_AvailablePages.erase(PageIt);
-        return Page;
+        auto& Class = m_PageClasses[PageClass];
+
+        Threading::SpinLockGuard ClassLock{Class.Lock};
+        Class.Pages.emplace_back(std::move(Page));
     }
     else
     {
-        return D3D12DynamicPage{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+        std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+        m_AvailablePages.emplace(PageSize, std::move(Page));
+    }
+}
+
+void D3D12DynamicMemoryManager::ReturnPage(D3D12DynamicPage&& Page, Uint32 OwnerId)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    --m_AllocatedPageCounter;
+#endif
+
+    if (OwnerId != InvalidOwnerId)
+    {
+        VERIFY_EXPR(OwnerId < MaxPageOwners);
+        auto& PinnedList = m_PinnedPages[OwnerId];
+
+        Threading::SpinLockGuard PinnedLock{PinnedList.Lock};
+        if (PinnedList.IsActive && PinnedList.Pages.size() < PinnedList.MaxPages)
+        {
+            PinnedList.Pages.emplace_back(std::move(Page));
+            return;
+        }
     }
+
+    ReturnPageToSharedList(std::move(Page));
 }
 
-void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask)
+void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask, Uint32 OwnerId)
 {
     struct StalePage
     {
         D3D12DynamicPage           Page;
         D3D12DynamicMemoryManager* Mgr;
+        Uint32                     OwnerId;
 
         // clang-format off
-        StalePage(D3D12DynamicPage&& _Page, D3D12DynamicMemoryManager& _Mgr)noexcept :
-            Page {std::move(_Page)},
-            Mgr  {&_Mgr}
+        StalePage(D3D12DynamicPage&& _Page, D3D12DynamicMemoryManager& _Mgr, Uint32 _OwnerId)noexcept :
+            Page    {std::move(_Page)},
+            Mgr     {&_Mgr},
+            OwnerId {_OwnerId}
         {
         }
 
@@ -129,8 +300,9 @@ void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Page
         StalePage& operator= (      StalePage&&) = delete;
 
         StalePage(StalePage&& rhs)noexcept :
-            Page {std::move(rhs.Page)},
-            Mgr  {rhs.Mgr}
+            Page    {std::move(rhs.Page)},
+            Mgr     {rhs.Mgr},
+            OwnerId {rhs.OwnerId}
         {
             rhs.Mgr  = nullptr;
         }
@@ -139,39 +311,64 @@ void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Page
         ~StalePage()
         {
             if (Mgr != nullptr)
-            {
-                std::lock_guard<std::mutex> Lock{Mgr->m_AvailablePagesMtx};
-#ifdef DILIGENT_DEVELOPMENT
-                --Mgr->m_AllocatedPageCounter;
-#endif
-                auto PageSize = Page.GetSize();
-                Mgr->m_AvailablePages.emplace(PageSize, std::move(Page));
-            }
+                Mgr->ReturnPage(std::move(Page), OwnerId);
         }
     };
     for (auto& Page : Pages)
     {
-        m_DeviceD3D12Impl.SafeReleaseDeviceObject(StalePage{std::move(Page), *this}, QueueMask);
+        m_DeviceD3D12Impl.SafeReleaseDeviceObject(StalePage{std::move(Page), *this, OwnerId}, QueueMask);
     }
 }
 
+D3D12DynamicMemoryManager::Stats D3D12DynamicMemoryManager::GetStats() const
+{
+    Stats MgrStats;
+    MgrStats.NumCreatedPages   = m_NumCreatedPages.load();
+    MgrStats.NumPinnedPageHits = m_NumPinnedPageHits.load();
+    MgrStats.NumSharedPageHits = m_NumSharedPageHits.load();
+    return MgrStats;
+}
+
 void D3D12DynamicMemoryManager::Destroy()
 {
     DEV_CHECK_ERR(m_AllocatedPageCounter == 0, m_AllocatedPageCounter, " page(s) have not been returned to the manager.");
+
+    for (Uint32 OwnerId = 0; OwnerId < MaxPageOwners; ++OwnerId)
+    {
+        auto& PinnedList = m_PinnedPages[OwnerId];
+        VERIFY(!PinnedList.IsActive, "Page owner ", OwnerId, " has not been unregistered");
+        for (auto& Page : PinnedList.Pages)
+            ReturnPageToSharedList(std::move(Page));
+        PinnedList.Pages.clear();
+    }
+
     Uint64 TotalAllocatedSize = 0;
+    for (auto& Class : m_PageClasses)
+    {
+        for (const auto& Page : Class.Pages)
+            TotalAllocatedSize += Page.GetSize();
+    }
     for (const auto& Page : m_AvailablePages)
         TotalAllocatedSize += Page.second.GetSize();
 
+    const auto MgrStats = GetStats();
     LOG_INFO_MESSAGE("Dynamic memory manager usage stats:\n"
                      "                       Total allocated memory: ",
-                     FormatMemorySize(TotalAllocatedSize, 2));
+                     FormatMemorySize(TotalAllocatedSize, 2), " (", MgrStats.NumCreatedPages, (MgrStats.NumCreatedPages == 1 ? " page)" : " pages)"),
+                     ". Page requests served from pinned/shared lists: ", MgrStats.NumPinnedPageHits, " / ", MgrStats.NumSharedPageHits);
 
+    for (auto& Class : m_PageClasses)
+        Class.Pages.clear();
     m_AvailablePages.clear();
 }
 
 D3D12DynamicMemoryManager::~D3D12DynamicMemoryManager()
 {
     DEV_CHECK_ERR(m_AllocatedPageCounter == 0, m_AllocatedPageCounter, " page(s) have not been released. If there are outstanding references to the pages in release queues, the app will crash when the page is returned to the manager.");
+#ifdef DILIGENT_DEBUG
+    for (const auto& Class : m_PageClasses)
+        VERIFY(Class.Pages.empty(), "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
+#endif
     VERIFY(m_AvailablePages.empty(), "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
 }
 
@@ -179,6 +376,7 @@ D3D12DynamicMemoryManager::~D3D12DynamicMemoryManager()
 D3D12DynamicHeap::~D3D12DynamicHeap()
 {
     VERIFY(m_AllocatedPages.empty(), "Allocated pages have not been released which indicates FinishFrame() has not been called");
+    m_GlobalDynamicMemMgr.UnregisterPageOwner(m_PageOwnerId);
 
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName,
@@ -189,7 +387,23 @@ D3D12DynamicHeap::~D3D12DynamicHeap()
                      FormatMemorySize(m_PeakAllocatedSize, 2, m_PeakAllocatedSize),
                      " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"),
                      ". Peak efficiency (used/aligned): ", std::fixed, std::setprecision(1), static_cast<double>(m_PeakUsedSize) / static_cast<double>(std::max(m_PeakAlignedSize, Uint64{1})) * 100.0, '%',
-                     ". Peak utilization (used/allocated): ", std::fixed, std::setprecision(1), static_cast<double>(m_PeakUsedSize) / static_cast<double>(std::max(m_PeakAllocatedSize, Uint64{1})) * 100.0, '%');
+                     ". Peak utilization (used/allocated): ", std::fixed, std::setprecision(1), static_cast<double>(m_PeakUsedSize) / static_cast<double>(std::max(m_PeakAllocatedSize, Uint64{1})) * 100.0, '%',
+                     ". Last frame used/allocated size: ", FormatMemorySize(m_LastFrameUsedSize, 2, m_LastFrameAllocatedSize), " / ",
+                     FormatMemorySize(m_LastFrameAllocatedSize, 2, m_LastFrameAllocatedSize), " (", m_NumFrames, (m_NumFrames == 1 ? " frame)" : " frames)"));
+}
+
+D3D12DynamicHeap::Stats D3D12DynamicHeap::GetStats() const
+{
+    Stats HeapStats;
+    HeapStats.CurrUsedSize           = m_CurrUsedSize;
+    HeapStats.CurrAllocatedSize      = m_CurrAllocatedSize;
+    HeapStats.LastFrameUsedSize      = m_LastFrameUsedSize;
+    HeapStats.LastFrameAllocatedSize = m_LastFrameAllocatedSize;
+    HeapStats.PeakFrameUsedSize      = m_PeakUsedSize;
+    HeapStats.PeakFrameAllocatedSize = m_PeakAllocatedSize;
+    HeapStats.NumFrames              = m_NumFrames;
+    HeapStats.PageSize               = m_PageSize;
+    return HeapStats;
 }
 
 D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Alignment, Uint64 DvpCtxFrameNumber)
@@ -203,7 +417,7 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
         while (NewPageSize < SizeInBytes)
             NewPageSize *= 2;
 
-        auto NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize);
+        auto NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize, m_PageOwnerId);
         if (NewPage.IsValid())
         {
             m_CurrOffset    = 0;
@@ -251,9 +465,25 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
 
 void D3D12DynamicHeap::ReleaseAllocatedPages(Uint64 QueueMask)
 {
-    m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, QueueMask);
+    m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, QueueMask, m_PageOwnerId);
     m_AllocatedPages.clear();
 
+    // Current sizes are reset every frame, so the peak values are per-frame peaks
+    m_LastFrameUsedSize      = m_CurrUsedSize;
+    m_LastFrameAllocatedSize = m_CurrAllocatedSize;
+    ++m_NumFrames;
+
+    if (m_AdaptivePageSize && m_PageSizer.FinishFrame(m_CurrAlignedSize))
+    {
+        LOG_INFO_MESSAGE(m_HeapName, ": page size changed from ", FormatMemorySize(m_PageSizer.GetPreviousPageSize(), 2),
+                         " to ", FormatMemorySize(m_PageSizer.GetPageSize(), 2), ". Last frame size: ", FormatMemorySize(m_CurrAlignedSize, 2),
+                         "; peak frame size since the last change: ", FormatMemorySize(m_PageSizer.GetWindowPeakSize(), 2), '.');
+        m_PageSizer.ResetWindowPeakSize();
+        m_PageSize = m_PageSizer.GetPageSize();
+        // Pinned pages of the previous size would either be too small or keep too much memory
+        m_GlobalDynamicMemMgr.ReleasePinnedPages(m_PageOwnerId);
+    }
+
     m_CurrOffset        = InvalidOffset;
     m_AvailableSize     = 0;
     m_CurrAllocatedSize = 0;
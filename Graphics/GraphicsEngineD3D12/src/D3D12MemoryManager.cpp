@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "D3D12MemoryManager.hpp"
+
+#include <tuple>
+
+#include "Align.hpp"
+#include "FormatString.hpp"
+
+namespace Diligent
+{
+
+D3D12MemoryAllocation::~D3D12MemoryAllocation()
+{
+    if (Page != nullptr)
+    {
+        Page->Free(std::move(*this));
+    }
+}
+
+D3D12MemoryPage::D3D12MemoryPage(D3D12MemoryManager& ParentMemoryMgr,
+                                 Uint64              PageSize,
+                                 D3D12_HEAP_TYPE     HeapType,
+                                 D3D12_HEAP_FLAGS    HeapFlags) :
+    // clang-format off
+    m_ParentMemoryMgr{ParentMemoryMgr},
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+// clang-format on
+{
+    D3D12_HEAP_DESC HeapDesc{};
+    HeapDesc.SizeInBytes                     = PageSize;
+    HeapDesc.Properties.Type                 = HeapType;
+    HeapDesc.Properties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    HeapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    HeapDesc.Properties.CreationNodeMask     = 1;
+    HeapDesc.Properties.VisibleNodeMask      = 1;
+    HeapDesc.Alignment                       = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    HeapDesc.Flags                           = HeapFlags;
+
+    auto hr = ParentMemoryMgr.m_pd3d12Device->CreateHeap(&HeapDesc, __uuidof(m_pd3d12Heap), reinterpret_cast<void**>(static_cast<ID3D12Heap**>(&m_pd3d12Heap)));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create D3D12 heap (", FormatMemorySize(PageSize, 2), ")");
+
+    m_pd3d12Heap->SetName(L"Placed resource heap");
+
+    m_GPUMemoryRecord = GPUMemoryRecord{ParentMemoryMgr.m_pGPUMemoryTracker, GPU_MEMORY_CATEGORY_MEMORY_POOL, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                        "Placed resource heap", PageSize, PageSize};
+}
+
+D3D12MemoryPage::~D3D12MemoryPage()
+{
+    VERIFY(IsEmpty(), "Destroying a page with not all allocations released");
+}
+
+D3D12MemoryAllocation D3D12MemoryPage::Allocate(Uint64 Size, Uint64 Alignment)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    VERIFY(Size <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
+           "Allocation size (", Size, ") exceeds maximum allowed value ",
+           std::numeric_limits<AllocationsMgrOffsetType>::max());
+    auto Allocation = m_AllocationMgr.Allocate(static_cast<AllocationsMgrOffsetType>(Size), static_cast<AllocationsMgrOffsetType>(Alignment));
+    if (!Allocation.IsValid())
+        return D3D12MemoryAllocation{};
+
+    // Offset may not necessarily be aligned, but the allocation is guaranteed to be large enough
+    // to accommodate requested alignment
+    VERIFY_EXPR(AlignUp(Uint64{Allocation.UnalignedOffset}, Alignment) - Allocation.UnalignedOffset + Size <= Allocation.Size);
+    return D3D12MemoryAllocation{this, Allocation.UnalignedOffset, Allocation.Size};
+}
+
+void D3D12MemoryPage::Free(D3D12MemoryAllocation&& Allocation)
+{
+    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size);
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+    Allocation = D3D12MemoryAllocation{};
+}
+
+
+D3D12MemoryManager::D3D12MemoryManager(IMemoryAllocator& Allocator,
+                                       ID3D12Device*     pd3d12Device,
+                                       Uint64            PageSize,
+                                       Uint64            ReserveSize,
+                                       GPUMemoryTracker* pGPUMemoryTracker) :
+    // clang-format off
+    m_Allocator        {Allocator        },
+    m_pd3d12Device     {pd3d12Device     },
+    m_pGPUMemoryTracker{pGPUMemoryTracker},
+    m_PageSize         {PageSize         },
+    m_ReserveSize      {ReserveSize      }
+// clang-format on
+{
+    VERIFY(m_PageSize <= std::numeric_limits<VariableSizeAllocationsManager::OffsetType>::max(),
+           "PageSize (", m_PageSize, ") exceeds maximum allowed value ",
+           std::numeric_limits<VariableSizeAllocationsManager::OffsetType>::max());
+}
+
+D3D12MemoryManager::~D3D12MemoryManager()
+{
+    if (m_PeakAllocatedSize > 0)
+    {
+        const auto PeakPages = m_PeakAllocatedSize / m_PageSize;
+        LOG_INFO_MESSAGE("D3D12MemoryManager stats:\n"
+                         "                       Peak used/allocated placed resource memory size: ",
+                         FormatMemorySize(static_cast<Uint64>(m_PeakUsedSize.load()), 2, m_PeakAllocatedSize), " / ",
+                         FormatMemorySize(m_PeakAllocatedSize, 2, m_PeakAllocatedSize),
+                         " (", PeakPages, (PeakPages == 1 ? " page)" : " pages)"));
+    }
+
+    for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
+        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    VERIFY(m_CurrUsedSize == 0, "Not all allocations have been released");
+}
+
+D3D12MemoryAllocation D3D12MemoryManager::CreatePlacedResource(D3D12_HEAP_TYPE            HeapType,
+                                                               const D3D12_RESOURCE_DESC& d3d12ResDesc,
+                                                               D3D12_RESOURCE_STATES      InitialState,
+                                                               const D3D12_CLEAR_VALUE*   pClearValue,
+                                                               CComPtr<ID3D12Resource>&   pd3d12Resource)
+{
+    VERIFY_EXPR(!pd3d12Resource);
+    if (m_PageSize == 0)
+        return D3D12MemoryAllocation{};
+
+    D3D12_RESOURCE_DESC PlacedResDesc = d3d12ResDesc;
+    D3D12_HEAP_FLAGS    HeapFlags     = D3D12_HEAP_FLAG_NONE;
+    if (PlacedResDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        // Buffers must always be 64KB-aligned
+        HeapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    }
+    else
+    {
+        // Placed render targets and depth-stencil buffers must be initialized with a clear, discard
+        // or copy operation before they are used, and they are typically large, so they remain committed.
+        // Multisample textures require 4MB-aligned heaps.
+        if ((PlacedResDesc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0 ||
+            PlacedResDesc.SampleDesc.Count > 1 ||
+            PlacedResDesc.Layout != D3D12_TEXTURE_LAYOUT_UNKNOWN ||
+            HeapType != D3D12_HEAP_TYPE_DEFAULT)
+            return D3D12MemoryAllocation{};
+
+        HeapFlags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+        // Try the small 4KB alignment first. If it is not allowed for this texture,
+        // the device reports the required alignment, and the default one is used instead.
+        PlacedResDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+    }
+
+    auto AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &PlacedResDesc);
+    if (PlacedResDesc.Alignment != 0 && AllocInfo.Alignment != PlacedResDesc.Alignment)
+    {
+        PlacedResDesc.Alignment = 0;
+        AllocInfo               = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &PlacedResDesc);
+    }
+
+    if (AllocInfo.SizeInBytes == UINT64_MAX || AllocInfo.SizeInBytes > m_PageSize / 2)
+        return D3D12MemoryAllocation{};
+
+    auto Allocation = Allocate(MemoryPageIndex{HeapType, HeapFlags}, AllocInfo.SizeInBytes, AllocInfo.Alignment);
+    if (!Allocation.IsValid())
+        return D3D12MemoryAllocation{};
+
+    const auto Offset = AlignUp(Allocation.UnalignedOffset, AllocInfo.Alignment);
+
+    auto hr = m_pd3d12Device->CreatePlacedResource(Allocation.Page->GetD3D12Heap(), Offset, &PlacedResDesc, InitialState, pClearValue,
+                                                   __uuidof(pd3d12Resource),
+                                                   reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&pd3d12Resource)));
+    if (FAILED(hr))
+    {
+        LOG_WARNING_MESSAGE("Failed to create placed resource. The resource will be created as committed.");
+        pd3d12Resource.Release();
+        return D3D12MemoryAllocation{};
+    }
+
+    return Allocation;
+}
+
+D3D12MemoryAllocation D3D12MemoryManager::AllocateFromExistingPages(const MemoryPageIndex& PageIdx, Uint64 Size, Uint64 Alignment)
+{
+    D3D12MemoryAllocation Allocation;
+
+    auto range = m_Pages.equal_range(PageIdx);
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        auto& Page = page_it->second;
+        if (Page.IsEmpty())
+            continue;
+
+        Allocation = Page.Allocate(Size, Alignment);
+        if (Allocation.IsValid())
+            return Allocation;
+    }
+
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        Allocation = page_it->second.Allocate(Size, Alignment);
+        if (Allocation.IsValid())
+            return Allocation;
+    }
+
+    return Allocation;
+}
+
+D3D12MemoryAllocation D3D12MemoryManager::Allocate(const MemoryPageIndex& PageIdx, Uint64 Size, Uint64 Alignment)
+{
+    D3D12MemoryAllocation Allocation;
+
+    {
+        // Every page is protected by its own mutex, so the page list only needs to be locked for reading
+        std::shared_lock<std::shared_timed_mutex> SharedLock{m_PagesMtx};
+        Allocation = AllocateFromExistingPages(PageIdx, Size, Alignment);
+    }
+
+    if (!Allocation.IsValid())
+    {
+        std::unique_lock<std::shared_timed_mutex> Lock{m_PagesMtx};
+
+        // Another thread may have created a new page while we were waiting for the lock
+        Allocation = AllocateFromExistingPages(PageIdx, Size, Alignment);
+        if (!Allocation.IsValid())
+        {
+            auto it = m_Pages.emplace(std::piecewise_construct,
+                                      std::forward_as_tuple(PageIdx),
+                                      std::forward_as_tuple(*this, m_PageSize, PageIdx.HeapType, PageIdx.HeapFlags));
+
+            m_CurrAllocatedSize += m_PageSize;
+            m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_CurrAllocatedSize);
+            LOG_INFO_MESSAGE("D3D12MemoryManager: created new placed resource heap (", FormatMemorySize(m_PageSize, 2),
+                             "). Current allocated size: ", FormatMemorySize(m_CurrAllocatedSize, 2));
+
+            Allocation = it->second.Allocate(Size, Alignment);
+            DEV_CHECK_ERR(Allocation.IsValid(), "Failed to allocate from a new heap");
+        }
+    }
+
+    const auto CurrUsedSize = m_CurrUsedSize.fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size);
+
+    auto PeakUsedSize = m_PeakUsedSize.load();
+    while (PeakUsedSize < CurrUsedSize && !m_PeakUsedSize.compare_exchange_weak(PeakUsedSize, CurrUsedSize))
+    {
+    }
+
+    return Allocation;
+}
+
+void D3D12MemoryManager::ShrinkMemory()
+{
+    std::unique_lock<std::shared_timed_mutex> Lock{m_PagesMtx};
+    if (m_CurrAllocatedSize <= m_ReserveSize)
+        return;
+
+    auto it = m_Pages.begin();
+    while (it != m_Pages.end() && m_CurrAllocatedSize > m_ReserveSize)
+    {
+        auto curr_it = it;
+        ++it;
+        if (curr_it->second.IsEmpty())
+        {
+            m_CurrAllocatedSize -= curr_it->second.GetPageSize();
+            LOG_INFO_MESSAGE("D3D12MemoryManager: destroying placed resource heap (", FormatMemorySize(curr_it->second.GetPageSize(), 2),
+                             "). Current allocated size: ", FormatMemorySize(m_CurrAllocatedSize, 2));
+            m_Pages.erase(curr_it);
+        }
+    }
+}
+
+void D3D12MemoryManager::OnFreeAllocation(Uint64 Size)
+{
+    m_CurrUsedSize.fetch_add(-static_cast<int64_t>(Size));
+}
+
+} // namespace Diligent
@@ -404,6 +404,90 @@ D3D12_RESOURCE_STATES ResourceStateFlagsToD3D12ResourceStates(RESOURCE_STATE Sta
     return D3D12ResourceStates;
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+void D3D12ResourceStatesToBarrierSyncAccessLayout(D3D12_RESOURCE_STATES States,
+                                                  D3D12_BARRIER_SYNC&   Sync,
+                                                  D3D12_BARRIER_ACCESS& Access,
+                                                  D3D12_BARRIER_LAYOUT& Layout)
+{
+    if (States == D3D12_RESOURCE_STATE_COMMON)
+    {
+        // Common state allows any access in any stage
+        Sync   = D3D12_BARRIER_SYNC_ALL;
+        Access = D3D12_BARRIER_ACCESS_COMMON;
+        Layout = D3D12_BARRIER_LAYOUT_COMMON;
+        return;
+    }
+
+    struct StateInfo
+    {
+        D3D12_RESOURCE_STATES State;
+        D3D12_BARRIER_SYNC    Sync;
+        D3D12_BARRIER_ACCESS  Access;
+    };
+    // clang-format off
+    static constexpr StateInfo StateInfos[] =
+    {
+        {D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER,        D3D12_BARRIER_SYNC_ALL_SHADING,          D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER},
+        {D3D12_RESOURCE_STATE_INDEX_BUFFER,                      D3D12_BARRIER_SYNC_INDEX_INPUT,          D3D12_BARRIER_ACCESS_INDEX_BUFFER},
+        {D3D12_RESOURCE_STATE_RENDER_TARGET,                     D3D12_BARRIER_SYNC_RENDER_TARGET,        D3D12_BARRIER_ACCESS_RENDER_TARGET},
+        {D3D12_RESOURCE_STATE_UNORDERED_ACCESS,                  D3D12_BARRIER_SYNC_ALL_SHADING,          D3D12_BARRIER_ACCESS_UNORDERED_ACCESS},
+        {D3D12_RESOURCE_STATE_DEPTH_WRITE,                       D3D12_BARRIER_SYNC_DEPTH_STENCIL,        D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE},
+        {D3D12_RESOURCE_STATE_DEPTH_READ,                        D3D12_BARRIER_SYNC_DEPTH_STENCIL,        D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ},
+        {D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,         D3D12_BARRIER_SYNC_NON_PIXEL_SHADING,    D3D12_BARRIER_ACCESS_SHADER_RESOURCE},
+        {D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,             D3D12_BARRIER_SYNC_PIXEL_SHADING,        D3D12_BARRIER_ACCESS_SHADER_RESOURCE},
+        {D3D12_RESOURCE_STATE_STREAM_OUT,                        D3D12_BARRIER_SYNC_ALL,                  D3D12_BARRIER_ACCESS_STREAM_OUTPUT},
+        {D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,                 D3D12_BARRIER_SYNC_EXECUTE_INDIRECT,     D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT},
+        {D3D12_RESOURCE_STATE_COPY_DEST,                         D3D12_BARRIER_SYNC_COPY,                 D3D12_BARRIER_ACCESS_COPY_DEST},
+        {D3D12_RESOURCE_STATE_COPY_SOURCE,                       D3D12_BARRIER_SYNC_COPY,                 D3D12_BARRIER_ACCESS_COPY_SOURCE},
+        {D3D12_RESOURCE_STATE_RESOLVE_DEST,                      D3D12_BARRIER_SYNC_RESOLVE,              D3D12_BARRIER_ACCESS_RESOLVE_DEST},
+        {D3D12_RESOURCE_STATE_RESOLVE_SOURCE,                    D3D12_BARRIER_SYNC_RESOLVE,              D3D12_BARRIER_ACCESS_RESOLVE_SOURCE},
+        {D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE, D3D12_BARRIER_SYNC_RAYTRACING | D3D12_BARRIER_SYNC_BUILD_RAYTRACING_ACCELERATION_STRUCTURE,
+                                                                                                          D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_READ | D3D12_BARRIER_ACCESS_RAYTRACING_ACCELERATION_STRUCTURE_WRITE},
+        {D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE,               D3D12_BARRIER_SYNC_PIXEL_SHADING,        D3D12_BARRIER_ACCESS_SHADING_RATE_SOURCE},
+    };
+    // clang-format on
+
+    Sync   = D3D12_BARRIER_SYNC_NONE;
+    Access = D3D12_BARRIER_ACCESS_COMMON;
+    for (const auto& Info : StateInfos)
+    {
+        if ((States & Info.State) != 0)
+        {
+            Sync |= Info.Sync;
+            Access |= Info.Access;
+        }
+    }
+    VERIFY(Sync != D3D12_BARRIER_SYNC_NONE, "Unexpected resource states");
+    if ((Sync & D3D12_BARRIER_SYNC_ALL) != 0)
+        Sync = D3D12_BARRIER_SYNC_ALL; // All other scopes are redundant
+
+    // Write states are exclusive, so at most one of them may be present
+    if (States & D3D12_RESOURCE_STATE_RENDER_TARGET)
+        Layout = D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+    else if (States & D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+        Layout = D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+    else if (States & D3D12_RESOURCE_STATE_DEPTH_WRITE)
+        Layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;
+    else if (States & D3D12_RESOURCE_STATE_COPY_DEST)
+        Layout = D3D12_BARRIER_LAYOUT_COPY_DEST;
+    else if (States & D3D12_RESOURCE_STATE_RESOLVE_DEST)
+        Layout = D3D12_BARRIER_LAYOUT_RESOLVE_DEST;
+    else if (States & D3D12_RESOURCE_STATE_DEPTH_READ)
+        Layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ; // Also allows shader resource and copy source access
+    else if (States == D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE)
+        Layout = D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE;
+    else if ((States & D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE) == States)
+        Layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+    else if (States == D3D12_RESOURCE_STATE_COPY_SOURCE)
+        Layout = D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+    else if (States == D3D12_RESOURCE_STATE_RESOLVE_SOURCE)
+        Layout = D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE;
+    else
+        Layout = D3D12_BARRIER_LAYOUT_GENERIC_READ; // Combination of read-only states
+}
+#endif
+
 D3D12_RESOURCE_STATES GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAND_LIST_TYPE CmdListType)
 {
     constexpr D3D12_RESOURCE_STATES TransferResStates =
@@ -600,7 +684,7 @@ D3D12_SHADER_VISIBILITY ShaderTypeToD3D12ShaderVisibility(SHADER_TYPE ShaderType
 {
     VERIFY(IsPowerOfTwo(ShaderType), "Only single shader stage should be provided");
 
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     switch (ShaderType)
     {
         // clang-format off
@@ -619,7 +703,8 @@ D3D12_SHADER_VISIBILITY ShaderTypeToD3D12ShaderVisibility(SHADER_TYPE ShaderType
         case SHADER_TYPE_RAY_CLOSEST_HIT:
         case SHADER_TYPE_RAY_ANY_HIT:
         case SHADER_TYPE_RAY_INTERSECTION:
-        case SHADER_TYPE_CALLABLE:          return D3D12_SHADER_VISIBILITY_ALL;
+        case SHADER_TYPE_CALLABLE:
+        case SHADER_TYPE_WORK_GRAPH:        return D3D12_SHADER_VISIBILITY_ALL;
         // clang-format on
         case SHADER_TYPE_TILE:
             UNSUPPORTED("Unsupported shader type (", GetShaderTypeLiteralName(ShaderType), ")");
@@ -632,7 +717,7 @@ D3D12_SHADER_VISIBILITY ShaderTypeToD3D12ShaderVisibility(SHADER_TYPE ShaderType
 
 SHADER_TYPE D3D12ShaderVisibilityToShaderType(D3D12_SHADER_VISIBILITY ShaderVisibility)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     switch (ShaderVisibility)
     {
         // clang-format off
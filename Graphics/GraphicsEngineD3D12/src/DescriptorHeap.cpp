@@ -26,6 +26,9 @@
  */
 
 #include "pch.h"
+
+#include <thread>
+
 #include "DescriptorHeap.hpp"
 #include "RenderDeviceD3D12Impl.hpp"
 #include "D3D12Utils.h"
@@ -193,7 +196,7 @@ DescriptorHeapAllocation DescriptorHeapAllocationManager::Allocate(uint32_t Coun
     VERIFY_EXPR(Count > 0);
 
     std::lock_guard<std::mutex> LockGuard(m_FreeBlockManagerMutex);
-    // Methods of VariableSizeAllocationsManager class are not thread safe!
+    // Methods of TLSFAllocationsManager class are not thread safe!
 
     // Use variable-size GPU allocations manager to allocate the requested number of descriptors
     auto Allocation = m_FreeBlockManager.Allocate(Count, 1);
@@ -242,7 +245,7 @@ void DescriptorHeapAllocationManager::FreeAllocation(DescriptorHeapAllocation&&
 
     std::lock_guard<std::mutex> LockGuard(m_FreeBlockManagerMutex);
     auto                        DescriptorOffset = (Allocation.GetCpuHandle().ptr - m_FirstCPUHandle.ptr) / m_DescriptorSize;
-    // Methods of VariableSizeAllocationsManager class are not thread safe!
+    // Methods of TLSFAllocationsManager class are not thread safe!
     m_FreeBlockManager.Free(DescriptorOffset, Allocation.GetNumHandles());
 
     // Clear the allocation
@@ -284,6 +287,14 @@ CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
 
 CPUDescriptorHeap::~CPUDescriptorHeap()
 {
+    // Return all cached descriptors to the pool
+    for (auto& Cache : m_ThreadCaches)
+    {
+        ReleaseToPool(Cache.Descriptors.data(), Cache.Descriptors.size());
+        Cache.Descriptors.clear();
+    }
+    VERIFY_EXPR(m_CachedDescriptors.load() == 0);
+
     DEV_CHECK_ERR(m_CurrentSize == 0, "Not all allocations released");
 
     DEV_CHECK_ERR(m_AvailableHeaps.size() == m_HeapPool.size(), "Not all descriptor heap pools are released");
@@ -294,9 +305,25 @@ CPUDescriptorHeap::~CPUDescriptorHeap()
         TotalDescriptors += Heap.GetMaxDescriptors();
     }
 
+    const auto MaxSize     = m_MaxSize.load();
+    const auto CacheHits   = m_CacheHits.load();
+    const auto CacheMisses = m_CacheMisses.load();
     LOG_INFO_MESSAGE(std::setw(38), std::left, GetD3D12DescriptorHeapTypeLiteralName(m_HeapDesc.Type), " CPU heap allocated pool count: ", m_HeapPool.size(),
-                     ". Max descriptors: ", m_MaxSize, '/', TotalDescriptors,
-                     " (", std::fixed, std::setprecision(2), m_MaxSize * 100.0 / std::max(TotalDescriptors, 1u), "%).");
+                     ". Max descriptors: ", MaxSize, '/', TotalDescriptors,
+                     " (", std::fixed, std::setprecision(2), MaxSize * 100.0 / std::max(TotalDescriptors, 1u), "%).",
+                     " Thread cache hit rate: ", CacheHits * 100.0 / std::max(CacheHits + CacheMisses, Uint64{1}), "%.");
+}
+
+CPUDescriptorHeap::Stats CPUDescriptorHeap::GetStats() const
+{
+    Stats HeapStats;
+    HeapStats.CurrentSize       = m_CurrentSize.load();
+    HeapStats.MaxSize           = m_MaxSize.load();
+    HeapStats.CachedDescriptors = m_CachedDescriptors.load();
+    HeapStats.CacheHits         = m_CacheHits.load();
+    HeapStats.CacheMisses       = m_CacheMisses.load();
+    HeapStats.CacheDrains       = m_CacheDrains.load();
+    return HeapStats;
 }
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -307,13 +334,13 @@ int32_t CPUDescriptorHeap::DvpGetTotalAllocationCount()
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
     for (auto& Heap : m_HeapPool)
         AllocationCount += Heap.DvpGetAllocationsCounter();
-    return AllocationCount;
+    // Descriptors held by the thread caches are not allocated by the application
+    return AllocationCount - static_cast<int32_t>(m_CachedDescriptors.load());
 }
 #endif
 
-DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
+DescriptorHeapAllocation CPUDescriptorHeap::AllocateFromPool(Uint32 Count)
 {
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
     // Note that every DescriptorHeapAllocationManager object instance is itself
     // thread-safe. Nested mutexes cannot cause a deadlock
 
@@ -357,8 +384,103 @@ DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
         Allocation = m_HeapPool[*NewHeapIt.first].Allocate(Count);
     }
 
-    m_CurrentSize += static_cast<Uint32>(Allocation.GetNumHandles());
-    m_MaxSize = std::max(m_MaxSize, m_CurrentSize);
+    return Allocation;
+}
+
+CPUDescriptorHeap::ThreadCache& CPUDescriptorHeap::GetThreadCache()
+{
+    const auto CacheIdx = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NumThreadCaches;
+    return m_ThreadCaches[CacheIdx];
+}
+
+void CPUDescriptorHeap::RefillThreadCache(ThreadCache& Cache)
+{
+    CachedDescriptor Batch[CacheBatchSize];
+    size_t           BatchSize = 0;
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        for (; BatchSize < CacheBatchSize; ++BatchSize)
+        {
+            auto Allocation = AllocateFromPool(1);
+            if (Allocation.IsNull())
+                break;
+
+            auto& Descriptor           = Batch[BatchSize];
+            Descriptor.CPUHandle       = Allocation.GetCpuHandle();
+            Descriptor.pd3d12Heap      = Allocation.GetDescriptorHeap();
+            Descriptor.AllocationMgrId = static_cast<Uint16>(Allocation.GetAllocationManagerId());
+            // The descriptor is now owned by the cache
+            Allocation.Reset();
+        }
+    }
+
+    m_CachedDescriptors.fetch_add(static_cast<Uint32>(BatchSize));
+
+    Threading::SpinLockGuard Guard{Cache.Lock};
+    Cache.Descriptors.insert(Cache.Descriptors.end(), Batch, Batch + BatchSize);
+}
+
+void CPUDescriptorHeap::ReleaseToPool(const CachedDescriptor* pDescriptors, size_t Count)
+{
+    if (Count == 0)
+        return;
+
+    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const auto& Descriptor = pDescriptors[i];
+        auto&       Manager    = m_HeapPool[Descriptor.AllocationMgrId];
+        Manager.FreeAllocation(DescriptorHeapAllocation{*this, Descriptor.pd3d12Heap, Descriptor.CPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE{0}, 1, Descriptor.AllocationMgrId});
+        m_AvailableHeaps.insert(Descriptor.AllocationMgrId);
+    }
+    m_CachedDescriptors.fetch_sub(static_cast<Uint32>(Count));
+}
+
+DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
+{
+    DescriptorHeapAllocation Allocation;
+    if (Count == 1)
+    {
+        auto& Cache = GetThreadCache();
+        for (Uint32 Attempt = 0; Attempt < 2 && Allocation.IsNull(); ++Attempt)
+        {
+            {
+                Threading::SpinLockGuard Guard{Cache.Lock};
+                if (!Cache.Descriptors.empty())
+                {
+                    const auto Descriptor = Cache.Descriptors.back();
+                    Cache.Descriptors.pop_back();
+                    Allocation = DescriptorHeapAllocation{*this, Descriptor.pd3d12Heap, Descriptor.CPUHandle, D3D12_GPU_DESCRIPTOR_HANDLE{0}, 1, Descriptor.AllocationMgrId};
+                }
+            }
+
+            if (!Allocation.IsNull())
+            {
+                m_CachedDescriptors.fetch_sub(1);
+                if (Attempt == 0)
+                    m_CacheHits.fetch_add(1, std::memory_order_relaxed);
+            }
+            else if (Attempt == 0)
+            {
+                // The cache is empty - take a batch from the pool. Another thread mapped
+                // to the same cache may refill it too, which is harmless.
+                m_CacheMisses.fetch_add(1, std::memory_order_relaxed);
+                RefillThreadCache(Cache);
+            }
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        Allocation = AllocateFromPool(Count);
+    }
+
+    const auto CurrentSize = m_CurrentSize.fetch_add(static_cast<Uint32>(Allocation.GetNumHandles())) + static_cast<Uint32>(Allocation.GetNumHandles());
+
+    auto MaxSize = m_MaxSize.load();
+    while (MaxSize < CurrentSize && !m_MaxSize.compare_exchange_weak(MaxSize, CurrentSize))
+    {
+    }
 
     return Allocation;
 }
@@ -401,9 +523,45 @@ void CPUDescriptorHeap::Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQu
 
 void CPUDescriptorHeap::FreeAllocation(DescriptorHeapAllocation&& Allocation)
 {
+    m_CurrentSize.fetch_sub(static_cast<Uint32>(Allocation.GetNumHandles()));
+
+    if (Allocation.GetNumHandles() == 1)
+    {
+        // Put the descriptor into the cache of the thread that releases it
+        CachedDescriptor Descriptor;
+        Descriptor.CPUHandle       = Allocation.GetCpuHandle();
+        Descriptor.pd3d12Heap      = Allocation.GetDescriptorHeap();
+        Descriptor.AllocationMgrId = static_cast<Uint16>(Allocation.GetAllocationManagerId());
+        Allocation.Reset();
+        m_CachedDescriptors.fetch_add(1);
+
+        // Descriptors are usually released by the thread that purges the release queues, so
+        // its cache will overflow and return batches to the pool for other threads to use.
+        CachedDescriptor Drain[CacheBatchSize];
+        size_t           DrainSize = 0;
+
+        auto& Cache = GetThreadCache();
+        {
+            Threading::SpinLockGuard Guard{Cache.Lock};
+            Cache.Descriptors.push_back(Descriptor);
+            if (Cache.Descriptors.size() > MaxCachedDescriptors)
+            {
+                DrainSize = CacheBatchSize;
+                std::copy(Cache.Descriptors.end() - DrainSize, Cache.Descriptors.end(), Drain);
+                Cache.Descriptors.resize(Cache.Descriptors.size() - DrainSize);
+            }
+        }
+
+        if (DrainSize > 0)
+        {
+            m_CacheDrains.fetch_add(1, std::memory_order_relaxed);
+            ReleaseToPool(Drain, DrainSize);
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
     auto                        ManagerId = Allocation.GetAllocationManagerId();
-    m_CurrentSize -= static_cast<Uint32>(Allocation.GetNumHandles());
     m_HeapPool[ManagerId].FreeAllocation(std::move(Allocation));
     // Return the manager to the pool of available managers
     VERIFY_EXPR(m_HeapPool[ManagerId].GetNumAvailableDescriptors() > 0);
@@ -441,6 +599,10 @@ GPUDescriptorHeap::GPUDescriptorHeap(IMemoryAllocator&           Allocator,
     m_DynamicAllocationsManager{Allocator, Device, *this, 1, m_pd3d12DescriptorHeap, NumDescriptorsInHeap, NumDynamicDescriptors}
 // clang-format on
 {
+    // Shader-visible descriptor heaps reside in video memory
+    const Uint64 HeapSize = Uint64{m_HeapDesc.NumDescriptors} * m_DescriptorSize;
+    m_GPUMemoryRecord     = GPUMemoryRecord{Device.GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_DESCRIPTOR_HEAP, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                        GetD3D12DescriptorHeapTypeLiteralName(Type), HeapSize, HeapSize};
 }
 
 GPUDescriptorHeap::~GPUDescriptorHeap()
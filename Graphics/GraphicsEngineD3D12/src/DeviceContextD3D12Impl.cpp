@@ -30,6 +30,7 @@
 #include "DeviceContextD3D12Impl.hpp"
 
 #include <sstream>
+#include <algorithm>
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "PipelineStateD3D12Impl.hpp"
@@ -48,6 +49,7 @@
 #include "D3D12DynamicHeap.hpp"
 #include "QueryManagerD3D12.hpp"
 #include "DXGITypeConversions.hpp"
+#include "GraphicsAccessories.hpp"
 
 #include "D3D12TileMappingHelper.hpp"
 
@@ -80,7 +82,9 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
     {
         pDeviceD3D12Impl->GetDynamicMemoryManager(),
         GetContextObjectName("Dynamic heap", Desc.IsDeferred, Desc.ContextId),
-        EngineCI.DynamicHeapPageSize
+        EngineCI.DynamicHeapPageSize,
+        EngineCI.NumDynamicHeapPagesToPin,
+        EngineCI.AdaptiveDynamicHeapPageSize != False
     },
     m_DynamicGPUDescriptorAllocator
     {
@@ -106,6 +110,13 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
     {
         RequestCommandContext();
         m_QueryMgr = &pDeviceD3D12Impl->GetQueryMgr(GetCommandQueueId());
+        if (EngineCI.EnableGPUBreadcrumbs)
+        {
+            if (GPUBreadcrumbsD3D12::IsSupported(*pDeviceD3D12Impl, pDeviceD3D12Impl->GetCommandQueueType(GetCommandQueueId())))
+                m_pBreadcrumbs = std::make_unique<GPUBreadcrumbsD3D12>(*pDeviceD3D12Impl, Desc.Name);
+            else
+                LOG_WARNING_MESSAGE("GPU breadcrumbs are requested, but WriteBufferImmediate is not supported by the command queue of context '", Desc.Name, "'.");
+        }
     }
 
     auto* pDrawIndirectSignature = GetDrawIndirectSignature(sizeof(UINT) * 4);
@@ -194,6 +205,10 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
     // In this case there are no resources to release, so there will be no issues.
     FinishFrame();
 
+    // The breadcrumbs buffer may still be written by the GPU
+    if (m_pBreadcrumbs)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_pBreadcrumbs), ~Uint64{0});
+
     // Note: as dynamic pages are returned to the global dynamic memory manager hosted by the render device,
     // the dynamic heap can be destroyed before all pages are actually returned to the global manager.
     DEV_CHECK_ERR(m_DynamicHeap.GetAllocatedPagesCount() == 0, "All dynamic pages must have been released by now.");
@@ -251,6 +266,55 @@ ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndexedIndirectSignature(
     return Sig;
 }
 
+bool DeviceContextD3D12Impl::IndirectCommandSignatureKey::operator==(const IndirectCommandSignatureKey& rhs) const
+{
+    // Argument descriptions are zero-initialized, so unused union members can be compared too
+    return Hash == rhs.Hash &&
+        ByteStride == rhs.ByteStride &&
+        pd3d12RootSig == rhs.pd3d12RootSig &&
+        Arguments.size() == rhs.Arguments.size() &&
+        memcmp(Arguments.data(), rhs.Arguments.data(), Arguments.size() * sizeof(Arguments[0])) == 0;
+}
+
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetIndirectCommandSignature()
+{
+    auto& Key = m_IndirectCmdSigKey;
+
+    Key.Hash = ComputeHash(Key.ByteStride, Key.pd3d12RootSig.p);
+    for (const auto& Arg : Key.Arguments)
+    {
+        static_assert(sizeof(Arg) % sizeof(Uint32) == 0, "Unexpected size of D3D12_INDIRECT_ARGUMENT_DESC");
+        for (size_t i = 0; i < sizeof(Arg) / sizeof(Uint32); ++i)
+        {
+            Uint32 Val = 0;
+            memcpy(&Val, reinterpret_cast<const Uint32*>(&Arg) + i, sizeof(Val));
+            HashCombine(Key.Hash, Val);
+        }
+    }
+
+    auto it = m_IndirectCommandSignatures.find(Key);
+    if (it != m_IndirectCommandSignatures.end())
+        return it->second;
+
+    D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc{};
+    CmdSignatureDesc.NodeMask         = 0;
+    CmdSignatureDesc.NumArgumentDescs = static_cast<UINT>(Key.Arguments.size());
+    CmdSignatureDesc.pArgumentDescs   = Key.Arguments.data();
+    CmdSignatureDesc.ByteStride       = Key.ByteStride;
+
+    CComPtr<ID3D12CommandSignature> pSignature;
+
+    auto hr = m_pDevice->GetD3D12Device()->CreateCommandSignature(&CmdSignatureDesc, Key.pd3d12RootSig, IID_PPV_ARGS(&pSignature));
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to create indirect command signature");
+        return nullptr;
+    }
+
+    it = m_IndirectCommandSignatures.emplace(Key, std::move(pSignature)).first;
+    return it->second;
+}
+
 void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
 {
     DEV_CHECK_ERR(ImmediateContextId < m_pDevice->GetCommandQueueCount(), "ImmediateContextId is out of range");
@@ -264,10 +328,11 @@ void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    if (IsRedundantPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateD3D12Impl> pPipelineStateD3D12{pPipelineState, PipelineStateD3D12Impl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateD3D12 != nullptr, "Unknown pipeline state object implementation");
-    if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
-        return;
 
     const auto& PSODesc = pPipelineStateD3D12->GetDesc();
 
@@ -310,7 +375,7 @@ void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
         RootInfo.MakeAllStale();
     }
 
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the switch below to handle the new pipeline type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the switch below to handle the new pipeline type");
     switch (PSODesc.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -361,6 +426,12 @@ void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
             RTCtx.SetComputeRootSignature(pd3d12RootSig);
             break;
         }
+        case PIPELINE_TYPE_WORK_GRAPH:
+        {
+            // The work graph program is set by DispatchGraph as it depends on the backing memory
+            CmdCtx.AsComputeContext().SetComputeRootSignature(pd3d12RootSig);
+            break;
+        }
         case PIPELINE_TYPE_TILE:
             UNEXPECTED("Unsupported pipeline type");
             break;
@@ -438,6 +509,9 @@ void DeviceContextD3D12Impl::TransitionShaderResources(IPipelineState* pPipeline
 
 void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    MetricTimerScope         MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_COMMIT_SHADER_RESOURCES)};
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingD3D12Impl = ClassPtrCast<ShaderResourceBindingD3D12Impl>(pShaderResourceBinding);
@@ -460,6 +534,9 @@ void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShad
     }
 #endif
 
+    if (m_pDevice->GetResidencyManager() != nullptr)
+        ResourceCache.TrackResidency(CmdCtx);
+
     const auto SRBIndex = pResBindingD3D12Impl->GetBindingIndex();
     auto&      RootInfo = GetRootTableInfo(pSignature->GetPipelineType());
 
@@ -603,6 +680,8 @@ void DeviceContextD3D12Impl::CommitD3D12VertexBuffers(GraphicsContext& GraphCtx)
 
 void DeviceContextD3D12Impl::PrepareForDraw(GraphicsContext& GraphCtx, DRAW_FLAGS Flags)
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
@@ -674,7 +753,9 @@ void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
     PrepareForDraw(GraphCtx, Attribs.Flags);
     if (Attribs.NumVertices > 0 && Attribs.NumInstances > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "Draw");
         GraphCtx.Draw(Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -687,7 +768,9 @@ void DeviceContextD3D12Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
     if (Attribs.NumIndices > 0 && Attribs.NumInstances > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "DrawIndexed");
         GraphCtx.DrawIndexed(Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -739,12 +822,14 @@ void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
     if (Attribs.DrawCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "DrawIndirect");
         GraphCtx.ExecuteIndirect(pDrawIndirectSignature,
                                  Attribs.DrawCount,
                                  pd3d12ArgsBuff,
                                  Attribs.DrawArgsOffset + BuffDataStartByteOffset,
                                  pd3d12CountBuff,
                                  pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartByteOffset : 0);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
     }
 
     ++m_State.NumCommands;
@@ -776,17 +861,221 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
     if (Attribs.DrawCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "DrawIndexedIndirect");
         GraphCtx.ExecuteIndirect(pDrawIndexedIndirectSignature,
                                  Attribs.DrawCount,
                                  pd3d12ArgsBuff,
                                  Attribs.DrawArgsOffset + BuffDataStartByteOffset,
                                  pd3d12CountBuff,
                                  pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartByteOffset : 0);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
     }
 
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::ExecuteIndirectCommands(const ExecuteIndirectCommandsAttribs& Attribs)
+{
+    DEV_CHECK_ERR(m_pPipelineState, "ExecuteIndirectCommands: no pipeline state is bound.");
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "ExecuteIndirectCommands: pipeline state '", m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+    DEV_CHECK_ERR(Attribs.NumArguments > 0 && Attribs.pArguments != nullptr, "ExecuteIndirectCommands: indirect command must have at least one argument.");
+    DEV_CHECK_ERR(Attribs.pArgsBuffer != nullptr, "ExecuteIndirectCommands: arguments buffer must not be null.");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr ||
+                      (Attribs.ArgsBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION &&
+                       Attribs.CounterBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
+                  "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
+                  "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+
+    const auto LastArgType = Attribs.pArguments[Attribs.NumArguments - 1].Type;
+    const bool IsIndexed   = LastArgType == INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED;
+    DEV_CHECK_ERR(IsIndexed || LastArgType == INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW,
+                  "The last argument of an indirect command must be INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW or INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED");
+
+    const auto& RootSig = m_pPipelineState->GetRootSignature();
+
+    // Finds the root parameter of the resource with the given name in the signatures of the current pipeline
+    auto FindResource = [&](const IndirectCommandArgumentDesc& Arg, Uint32& RootIndex, const PipelineResourceAttribsD3D12*& pAttribs, const PipelineResourceDesc*& pResDesc) {
+        DEV_CHECK_ERR(Arg.Name != nullptr && Arg.Name[0] != '\0', "Resource name must not be null or empty");
+        for (Uint32 s = 0; s < m_pPipelineState->GetResourceSignatureCount(); ++s)
+        {
+            const auto* pSignature = m_pPipelineState->GetResourceSignature(s);
+            if (pSignature == nullptr)
+                continue;
+
+            for (Uint32 r = 0; r < pSignature->GetTotalResourceCount(); ++r)
+            {
+                const auto& ResDesc = pSignature->GetResourceDesc(r);
+                if (Arg.ShaderStages != SHADER_TYPE_UNKNOWN && (ResDesc.ShaderStages & Arg.ShaderStages) == 0)
+                    continue;
+                if (strcmp(ResDesc.Name, Arg.Name) != 0)
+                    continue;
+
+                pResDesc  = &ResDesc;
+                pAttribs  = &pSignature->GetResourceAttribs(r);
+                RootIndex = RootSig.GetBaseRootIndex(pSignature->GetDesc().BindingIndex) + pAttribs->RootIndex(ResourceCacheContentType::SRB);
+                return true;
+            }
+        }
+        LOG_ERROR_MESSAGE("Resource '", Arg.Name, "' referenced by an indirect command argument is not found in pipeline '", m_pPipelineState->GetDesc().Name, "'.");
+        return false;
+    };
+
+    auto& Key = m_IndirectCmdSigKey;
+    Key.Arguments.clear();
+    Key.pd3d12RootSig.Release();
+
+    bool   ChangesVBs      = false;
+    bool   ChangesIB       = false;
+    bool   ChangesRootArgs = false;
+    Uint32 CommandSize     = 0;
+    for (Uint32 i = 0; i < Attribs.NumArguments; ++i)
+    {
+        const auto& Arg = Attribs.pArguments[i];
+
+        D3D12_INDIRECT_ARGUMENT_DESC d3d12Arg{};
+        switch (Arg.Type)
+        {
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_VERTEX_BUFFER:
+                DEV_CHECK_ERR(Arg.Slot < MAX_BUFFER_SLOTS, "Vertex buffer slot (", Arg.Slot, ") is out of range");
+                d3d12Arg.Type              = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+                d3d12Arg.VertexBuffer.Slot = Arg.Slot;
+                CommandSize += sizeof(D3D12_VERTEX_BUFFER_VIEW);
+                ChangesVBs = true;
+                break;
+
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_INDEX_BUFFER:
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+                CommandSize += sizeof(D3D12_INDEX_BUFFER_VIEW);
+                ChangesIB = true;
+                break;
+
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_CONSTANT_BUFFER:
+            {
+                Uint32                              RootIndex = 0;
+                const PipelineResourceAttribsD3D12* pAttribs  = nullptr;
+                const PipelineResourceDesc*         pResDesc  = nullptr;
+                if (!FindResource(Arg, RootIndex, pAttribs, pResDesc))
+                    return;
+                if (pResDesc->ResourceType != SHADER_RESOURCE_TYPE_CONSTANT_BUFFER || pAttribs->GetD3D12RootParamType() != D3D12_ROOT_PARAMETER_TYPE_CBV)
+                {
+                    LOG_ERROR_MESSAGE("Resource '", Arg.Name, "' referenced by INDIRECT_COMMAND_ARGUMENT_TYPE_CONSTANT_BUFFER argument is not a root constant buffer. "
+                                                              "Only non-array constant buffers without PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS flag can be set by indirect commands.");
+                    return;
+                }
+                d3d12Arg.Type                                  = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW;
+                d3d12Arg.ConstantBufferView.RootParameterIndex = RootIndex;
+                CommandSize += sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
+                ChangesRootArgs = true;
+                break;
+            }
+
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_BINDLESS_INDICES:
+            {
+                Uint32                              RootIndex = 0;
+                const PipelineResourceAttribsD3D12* pAttribs  = nullptr;
+                const PipelineResourceDesc*         pResDesc  = nullptr;
+                if (!FindResource(Arg, RootIndex, pAttribs, pResDesc))
+                    return;
+                if (!pAttribs->IsBindless())
+                {
+                    LOG_ERROR_MESSAGE("Resource '", Arg.Name, "' referenced by INDIRECT_COMMAND_ARGUMENT_TYPE_BINDLESS_INDICES argument is not labeled with PIPELINE_RESOURCE_FLAG_BINDLESS flag.");
+                    return;
+                }
+                d3d12Arg.Type                             = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+                d3d12Arg.Constant.RootParameterIndex      = RootIndex;
+                d3d12Arg.Constant.DestOffsetIn32BitValues = pAttribs->OffsetFromTableStart(ResourceCacheContentType::SRB);
+                d3d12Arg.Constant.Num32BitValuesToSet     = pResDesc->ArraySize;
+                CommandSize += sizeof(Uint32) * pResDesc->ArraySize;
+                ChangesRootArgs = true;
+                break;
+            }
+
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW:
+                DEV_CHECK_ERR(i == Attribs.NumArguments - 1, "Draw argument must be the last argument of an indirect command");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+                CommandSize += sizeof(D3D12_DRAW_ARGUMENTS);
+                break;
+
+            case INDIRECT_COMMAND_ARGUMENT_TYPE_DRAW_INDEXED:
+                DEV_CHECK_ERR(i == Attribs.NumArguments - 1, "Draw argument must be the last argument of an indirect command");
+                d3d12Arg.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+                CommandSize += sizeof(D3D12_DRAW_INDEXED_ARGUMENTS);
+                break;
+
+            default:
+                UNEXPECTED("Unexpected indirect command argument type");
+                return;
+        }
+        Key.Arguments.push_back(d3d12Arg);
+    }
+
+    DEV_CHECK_ERR(Attribs.ArgsStride == 0 || Attribs.ArgsStride >= CommandSize,
+                  "Indirect command stride (", Attribs.ArgsStride, ") is smaller than the command size (", CommandSize, ")");
+    DEV_CHECK_ERR(Attribs.ArgsStride % 4 == 0, "Indirect command stride (", Attribs.ArgsStride, ") must be a multiple of 4");
+    Key.ByteStride = Attribs.ArgsStride != 0 ? Attribs.ArgsStride : CommandSize;
+    if (ChangesRootArgs)
+        Key.pd3d12RootSig = m_pPipelineState->GetD3D12RootSignature();
+
+    auto* pCmdSignature = GetIndirectCommandSignature();
+    if (pCmdSignature == nullptr)
+        return;
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    if (ChangesVBs)
+    {
+        // Vertex buffers are set by the command stream; they may not be bound in the context
+        m_State.bCommittedD3D12VBsUpToDate = true;
+    }
+    if (IsIndexed && !ChangesIB)
+    {
+        DEV_CHECK_ERR(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32, "IndexType must be VT_UINT16 or VT_UINT32 for indexed commands that do not set the index buffer");
+        PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+    }
+    else
+    {
+        PrepareForDraw(GraphCtx, Attribs.Flags);
+    }
+
+    ID3D12Resource* pd3d12ArgsBuff          = nullptr;
+    Uint64          BuffDataStartByteOffset = 0;
+    PrepareIndirectAttribsBuffer(GraphCtx, Attribs.pArgsBuffer, Attribs.ArgsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
+                                 "Indirect commands (DeviceContextD3D12Impl::ExecuteIndirectCommands)");
+
+    ID3D12Resource* pd3d12CountBuff              = nullptr;
+    Uint64          CountBuffDataStartByteOffset = 0;
+    if (Attribs.pCounterBuffer != nullptr)
+    {
+        PrepareIndirectAttribsBuffer(GraphCtx, Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                     "Counter buffer (DeviceContextD3D12Impl::ExecuteIndirectCommands)");
+    }
+
+    if (Attribs.MaxCommandCount > 0)
+    {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "ExecuteIndirectCommands");
+        GraphCtx.ExecuteIndirect(pCmdSignature,
+                                 Attribs.MaxCommandCount,
+                                 pd3d12ArgsBuff,
+                                 Attribs.ArgsOffset + BuffDataStartByteOffset,
+                                 pd3d12CountBuff,
+                                 pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartByteOffset : 0);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
+    }
+
+    // Bindings changed by the commands must be restored by the next draw command
+    if (ChangesVBs)
+        m_State.bCommittedD3D12VBsUpToDate = false;
+    if (ChangesIB)
+    {
+        m_State.CommittedD3D12IndexBuffer.Release();
+        m_State.bCommittedD3D12IBUpToDate = false;
+    }
+    if (ChangesRootArgs)
+        GetRootTableInfo(PIPELINE_TYPE_GRAPHICS).MakeAllStale();
+
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     DvpVerifyDrawMeshArguments(Attribs);
@@ -796,7 +1085,9 @@ void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 
     if (Attribs.ThreadGroupCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "DrawMesh");
         GraphCtx.DrawMesh(Attribs.ThreadGroupCount, 1, 1);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -823,12 +1114,14 @@ void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Att
 
     if (Attribs.CommandCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(GraphCtx, "DrawMeshIndirect");
         GraphCtx.ExecuteIndirect(m_pDrawMeshIndirectSignature,
                                  Attribs.CommandCount,
                                  pd3d12ArgsBuff,
                                  Attribs.DrawArgsOffset + BuffDataStartByteOffset,
                                  pd3d12CountBuff,
                                  Attribs.CounterOffset + CountBuffDataStartByteOffset);
+        EndBreadcrumb(GraphCtx, Breadcrumb);
     }
 
     ++m_State.NumCommands;
@@ -836,6 +1129,8 @@ void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Att
 
 void DeviceContextD3D12Impl::PrepareForDispatchCompute(ComputeContext& ComputeCtx)
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
     auto& RootInfo = GetRootTableInfo(PIPELINE_TYPE_COMPUTE);
 #ifdef DILIGENT_DEVELOPMENT
     DvpValidateCommittedShaderResources(RootInfo);
@@ -866,7 +1161,9 @@ void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attri
     PrepareForDispatchCompute(ComputeCtx);
     if (Attribs.ThreadGroupCountX > 0 && Attribs.ThreadGroupCountY > 0 && Attribs.ThreadGroupCountZ > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb(ComputeCtx, "DispatchCompute");
         ComputeCtx.Dispatch(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
+        EndBreadcrumb(ComputeCtx, Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -883,7 +1180,9 @@ void DeviceContextD3D12Impl::DispatchComputeIndirect(const DispatchComputeIndire
     PrepareIndirectAttribsBuffer(ComputeCtx, Attribs.pAttribsBuffer, Attribs.AttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
                                  "Indirect dispatch (DeviceContextD3D12Impl::DispatchComputeIndirect)");
 
+    const Uint32 Breadcrumb = BeginBreadcrumb(ComputeCtx, "DispatchComputeIndirect");
     ComputeCtx.ExecuteIndirect(m_pDispatchIndirectSignature, 1, pd3d12ArgsBuff, Attribs.DispatchArgsByteOffset + BuffDataStartByteOffset);
+    EndBreadcrumb(ComputeCtx, Breadcrumb);
     ++m_State.NumCommands;
 }
 
@@ -938,6 +1237,7 @@ void DeviceContextD3D12Impl::RequestCommandContext()
 {
     m_CurrCmdCtx = m_pDevice->AllocateCommandContext(GetCommandQueueId());
     m_CurrCmdCtx->SetDynamicGPUDescriptorAllocators(m_DynamicGPUDescriptorAllocator);
+    m_CurrCmdCtx->SetStatistics(&m_Statistics);
 }
 
 void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
@@ -949,17 +1249,27 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
     DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
                   "Flushing device context that has ", m_ActiveQueriesCounter,
                   " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(),
+                  "Flushing device context with active conditional rendering. Predication state does not persist across command lists");
+
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
+    // Temporary arrays are allocated from the scratch arena that keeps its pages between the frames
+    DynamicLinearAllocatorScope ScratchScope{m_ScratchAllocator};
 
-    // TODO: use small_vector
-    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> Contexts;
-    Contexts.reserve(size_t{NumCommandLists} + 1);
+    using PooledCommandContext = RenderDeviceD3D12Impl::PooledCommandContext;
+
+    const size_t MaxContexts = size_t{NumCommandLists} + 1;
+    auto*        Contexts    = m_ScratchAllocator.ConstructArray<PooledCommandContext>(MaxContexts);
+    Uint32       NumContexts = 0;
 
     // First, execute current context
     if (m_CurrCmdCtx)
     {
+        ResolvePendingQueries();
         VERIFY(!IsDeferred(), "Deferred contexts cannot execute command lists directly");
         if (m_State.NumCommands != 0)
-            Contexts.emplace_back(std::move(m_CurrCmdCtx));
+            Contexts[NumContexts++] = std::move(m_CurrCmdCtx);
         else
             m_pDevice->DisposeCommandContext(std::move(m_CurrCmdCtx));
     }
@@ -970,22 +1280,27 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
         auto* const pCmdListD3D12 = ClassPtrCast<CommandListD3D12Impl>(ppCommandLists[i]);
 
         RefCntAutoPtr<DeviceContextD3D12Impl> pDeferredCtx;
-        Contexts.emplace_back(pCmdListD3D12->Close(pDeferredCtx));
-        VERIFY(Contexts.back() && pDeferredCtx, "Trying to execute empty command buffer");
+        auto& Ctx = Contexts[NumContexts++];
+        Ctx       = pCmdListD3D12->Close(pDeferredCtx);
+        VERIFY(Ctx && pDeferredCtx, "Trying to execute empty command buffer");
         // Set the bit in the deferred context cmd queue mask corresponding to the cmd queue of this context
         pDeferredCtx->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
     }
 
-    if (!Contexts.empty())
+    if (NumContexts != 0)
     {
-        m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(Contexts.size()), Contexts.data(), true, &m_SignalFences, &m_WaitFences);
+        m_Statistics.CommandBufferCount += NumContexts;
+        m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), NumContexts, Contexts, true, &m_SignalFences, &m_WaitFences);
         m_SignalFences.clear();
+        CheckDeviceRemoved();
 
 #ifdef DILIGENT_DEBUG
-        for (Uint32 i = 0; i < NumCommandLists; ++i)
+        for (Uint32 i = 0; i < NumContexts; ++i)
             VERIFY(!Contexts[i], "All contexts must be disposed by CloseAndExecuteCommandContexts");
 #endif
     }
+    for (size_t i = 0; i < MaxContexts; ++i)
+        Contexts[i].~PooledCommandContext();
 
     m_WaitFences.clear();
 
@@ -997,7 +1312,10 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
     }
 
     if (RequestNewCmdCtx)
+    {
         RequestCommandContext();
+        TrackBoundResourcesResidency();
+    }
 
     m_State             = State{};
     m_GraphicsResources = RootTableInfo{};
@@ -1008,6 +1326,46 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
     m_pPipelineState = nullptr;
 }
 
+void DeviceContextD3D12Impl::TrackBoundResourcesResidency()
+{
+    if (m_pDevice->GetResidencyManager() == nullptr)
+        return;
+
+    // Vertex and index buffers as well as render targets remain bound after the context is flushed
+    // and must be resident when the new command list is executed. Shader resources are committed again.
+    // Note that GetCmdContext() must not be used here as it would prevent an empty context from being disposed.
+    auto& CmdCtx = *m_CurrCmdCtx;
+    for (Uint32 s = 0; s < m_NumVertexStreams; ++s)
+    {
+        if (auto* pBufferD3D12 = m_VertexStreams[s].pBuffer.RawPtr())
+            CmdCtx.TrackResidency(*pBufferD3D12);
+    }
+    if (m_pIndexBuffer)
+        CmdCtx.TrackResidency(*m_pIndexBuffer);
+
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        if (auto* pRTV = m_pBoundRenderTargets[rt].RawPtr())
+            CmdCtx.TrackResidency(*pRTV->GetTexture<TextureD3D12Impl>());
+    }
+    if (m_pBoundDepthStencil)
+        CmdCtx.TrackResidency(*m_pBoundDepthStencil->GetTexture<TextureD3D12Impl>());
+}
+
+void DeviceContextD3D12Impl::CheckDeviceRemoved()
+{
+    if (!m_pBreadcrumbs || m_DeviceRemovedReported)
+        return;
+
+    auto* pQueueD3D12 = ClassPtrCast<CommandQueueD3D12Impl>(LockCommandQueue());
+    if (pQueueD3D12->IsDeviceRemoved())
+    {
+        m_pBreadcrumbs->LogDeviceRemoved(m_pDevice->GetD3D12Device());
+        m_DeviceRemovedReported = true;
+    }
+    UnlockCommandQueue();
+}
+
 void DeviceContextD3D12Impl::Flush()
 {
     DEV_CHECK_ERR(!IsDeferred(), "Flush() should only be called for immediate contexts");
@@ -1018,6 +1376,8 @@ void DeviceContextD3D12Impl::Flush()
 
 void DeviceContextD3D12Impl::FinishFrame()
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
 #ifdef DILIGENT_DEBUG
     for (const auto& MappedBuffIt : m_DbgMappedBuffers)
     {
@@ -1079,6 +1439,9 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
 
     auto& CmdCtx = GetCmdContext();
@@ -1105,6 +1468,9 @@ void DeviceContextD3D12Impl::InvalidateState()
 
 void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     if (m_pIndexBuffer)
     {
@@ -1568,6 +1934,7 @@ void DeviceContextD3D12Impl::EndRenderPass()
 
 D3D12DynamicAllocation DeviceContextD3D12Impl::AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment)
 {
+    m_Statistics.DynamicHeapBytes += NumBytes;
     return m_DynamicHeap.Allocate(NumBytes, Alignment, GetFrameNumber());
 }
 
@@ -1637,6 +2004,8 @@ void DeviceContextD3D12Impl::CopyBuffer(IBuffer*                       pSrcBuffe
 
 void DeviceContextD3D12Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_MAP_BUFFER)};
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto*       pBufferD3D12   = ClassPtrCast<BufferD3D12Impl>(pBuffer);
     const auto& BuffDesc       = pBufferD3D12->GetDesc();
@@ -2246,7 +2615,7 @@ void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
     if (m_pPipelineState)
     {
         const auto& PSODesc = m_pPipelineState->GetDesc();
-        if (PSODesc.IsComputePipeline() || PSODesc.IsRayTracingPipeline())
+        if (PSODesc.IsComputePipeline() || PSODesc.IsRayTracingPipeline() || PSODesc.IsWorkGraphPipeline())
         {
             // Mips generator will set its own compute pipeline, root signature and root resources.
             // We need to invalidate current PSO and reset it afterwards.
@@ -2259,7 +2628,7 @@ void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
     auto& Ctx = GetCmdContext();
 
     const auto& MipsGenerator = m_pDevice->GetMipsGenerator();
-    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ClassPtrCast<TextureViewD3D12Impl>(pTexView), Ctx);
+    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ClassPtrCast<TextureViewD3D12Impl>(pTexView), Ctx, GetCommandQueueId());
     ++m_State.NumCommands;
 
     if (pCurrPSO != nullptr)
@@ -2272,6 +2641,20 @@ void DeviceContextD3D12Impl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(), "Finishing command list with active conditional rendering.");
+
+    // Query data must be resolved before the command context is moved to the command list
+    ResolvePendingQueries();
+
+    if (m_CurrCmdCtx)
+    {
+        // Close the command list on the recording thread rather than in ExecuteCommandLists()
+        // so that pending barriers are flushed in parallel with other deferred contexts.
+        m_CurrCmdCtx->CloseCommandList();
+        // The command context may be used by another thread, so it must not update the statistics of this context
+        m_CurrCmdCtx->SetStatistics(nullptr);
+    }
+    ++m_Statistics.CommandBufferCount;
 
     CommandListD3D12Impl* pCmdListD3D12(NEW_RC_OBJ(m_CmdListAllocator, "CommandListD3D12Impl instance", CommandListD3D12Impl)(m_pDevice, this, std::move(m_CurrCmdCtx)));
     pCmdListD3D12->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
@@ -2332,9 +2715,14 @@ void DeviceContextD3D12Impl::BeginQuery(IQuery* pQuery)
     auto& Ctx      = GetCmdContext();
     auto  Idx      = pQueryD3D12Impl->GetQueryHeapIndex(0);
     if (QueryType != QUERY_TYPE_DURATION)
+    {
         QueryMgr.BeginQuery(Ctx, QueryType, Idx);
+    }
     else
+    {
         QueryMgr.EndQuery(Ctx, QueryType, Idx);
+        m_PendingQueryResolves.push_back({QueryType, Idx});
+    }
 }
 
 void DeviceContextD3D12Impl::EndQuery(IQuery* pQuery)
@@ -2353,6 +2741,150 @@ void DeviceContextD3D12Impl::EndQuery(IQuery* pQuery)
     auto& Ctx      = GetCmdContext();
     auto  Idx      = pQueryD3D12Impl->GetQueryHeapIndex(QueryType == QUERY_TYPE_DURATION ? 1 : 0);
     QueryMgr.EndQuery(Ctx, QueryType, Idx);
+    m_PendingQueryResolves.push_back({QueryType, Idx});
+}
+
+void DeviceContextD3D12Impl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    TDeviceContextBase::BeginConditionalRendering(Attribs, 0);
+
+    auto* pBufferD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pBuffer);
+    auto& CmdCtx       = GetCmdContext();
+
+    // D3D12_RESOURCE_STATE_PREDICATION is the same as D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT
+    TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, Attribs.TransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                  "Begin conditional rendering (DeviceContextD3D12Impl::BeginConditionalRendering)");
+    CmdCtx.FlushResourceBarriers();
+
+    Uint64 BuffDataStartByteOffset = 0;
+    auto*  pd3d12Buffer            = pBufferD3D12->GetD3D12Buffer(BuffDataStartByteOffset, this);
+
+    // With D3D12_PREDICATION_OP_EQUAL_ZERO, the commands are discarded if the predicate is zero
+    const auto Operation = (Attribs.Flags & CONDITIONAL_RENDERING_FLAG_INVERTED) != 0 ?
+        D3D12_PREDICATION_OP_NOT_EQUAL_ZERO :
+        D3D12_PREDICATION_OP_EQUAL_ZERO;
+    CmdCtx.GetCommandList()->SetPredication(pd3d12Buffer, BuffDataStartByteOffset + Attribs.Offset, Operation);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    GetCmdContext().GetCommandList()->SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::ResolvePendingQueries()
+{
+    if (m_PendingQueryResolves.empty())
+        return;
+
+    // Resolving the data of all queries at the end of the command list allows issuing
+    // a single ResolveQueryData command for every range of contiguous query indices.
+    m_State.NumCommands += GetQueryManager().ResolveQueries(GetCmdContext(), m_PendingQueryResolves);
+    VERIFY_EXPR(m_PendingQueryResolves.empty());
+}
+
+Uint32 DeviceContextD3D12Impl::GetQueryData(Uint32         NumQueries,
+                                            IQuery* const* ppQueries,
+                                            void*          pData,
+                                            Uint32         DataSize,
+                                            Bool*          pDataAvailable,
+                                            Bool           AutoInvalidate)
+{
+    DEV_CHECK_ERR(NumQueries == 0 || ppQueries != nullptr, "IDeviceContext::GetQueryData: ppQueries must not be null");
+
+    // Indices of the queries whose data is ready, grouped by the query manager
+    std::vector<Uint32> ReadyQueries;
+    ReadyQueries.reserve(NumQueries);
+    for (Uint32 i = 0; i < NumQueries; ++i)
+    {
+        DEV_CHECK_ERR(ppQueries[i] != nullptr, "IDeviceContext::GetQueryData: query ", i, " is null");
+        DEV_CHECK_ERR(ppQueries[i]->GetDesc().Type == ppQueries[0]->GetDesc().Type, "IDeviceContext::GetQueryData: all queries must have the same type");
+
+        if (pDataAvailable != nullptr)
+            pDataAvailable[i] = False;
+
+        auto* pQueryD3D12 = ClassPtrCast<QueryD3D12Impl>(ppQueries[i]);
+        if (pQueryD3D12->GetQueryManager() != nullptr && pQueryD3D12->IsEndFenceCompleted())
+            ReadyQueries.push_back(i);
+    }
+    std::stable_sort(ReadyQueries.begin(), ReadyQueries.end(),
+                     [ppQueries](Uint32 lhs, Uint32 rhs) {
+                         return ClassPtrCast<QueryD3D12Impl>(ppQueries[lhs])->GetQueryManager() < ClassPtrCast<QueryD3D12Impl>(ppQueries[rhs])->GetQueryManager();
+                     });
+
+    Uint32 NumAvailable = 0;
+    for (size_t i = 0; i < ReadyQueries.size();)
+    {
+        auto* const pQueryMgr = ClassPtrCast<QueryD3D12Impl>(ppQueries[ReadyQueries[i]])->GetQueryManager();
+
+        // Find the range of the resolve buffer that covers all queries of this manager
+        auto   GroupEnd = i;
+        Uint64 Begin    = ~Uint64{0};
+        Uint64 End      = 0;
+        for (; GroupEnd < ReadyQueries.size(); ++GroupEnd)
+        {
+            const auto* pQueryD3D12 = ClassPtrCast<QueryD3D12Impl>(ppQueries[ReadyQueries[GroupEnd]]);
+            if (pQueryD3D12->GetQueryManager() != pQueryMgr)
+                break;
+
+            Uint64 QueryBegin = 0, QueryEnd = 0;
+            pQueryD3D12->GetResolveBufferRange(QueryBegin, QueryEnd);
+            Begin = std::min(Begin, QueryBegin);
+            End   = std::max(End, QueryEnd);
+        }
+
+        // Map the readback buffer once for all queries
+        const auto* pMappedData = pQueryMgr->MapResolveBuffer(Begin, End);
+        for (; i < GroupEnd; ++i)
+        {
+            const auto QueryIdx    = ReadyQueries[i];
+            void*      pQueryData  = pData != nullptr ? static_cast<Uint8*>(pData) + size_t{DataSize} * QueryIdx : nullptr;
+            auto*      pQueryD3D12 = ClassPtrCast<QueryD3D12Impl>(ppQueries[QueryIdx]);
+            if (pQueryD3D12->GetData(pQueryData, DataSize, AutoInvalidate, pMappedData))
+            {
+                if (pDataAvailable != nullptr)
+                    pDataAvailable[QueryIdx] = True;
+                ++NumAvailable;
+            }
+        }
+        pQueryMgr->UnmapResolveBuffer();
+    }
+
+    return NumAvailable;
+}
+
+Bool DeviceContextD3D12Impl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Timestamp calibration is only supported by immediate contexts");
+    if (IsDeferred())
+        return False;
+
+    const auto& CmdQueue    = m_pDevice->GetCommandQueue(GetCommandQueueId());
+    auto*       pd3d12Queue = const_cast<ICommandQueueD3D12&>(CmdQueue).GetD3D12CommandQueue();
+
+    // The GPU timestamp and the CPU QueryPerformanceCounter value are sampled at the same moment.
+    // https://learn.microsoft.com/en-us/windows/win32/api/d3d12/nf-d3d12-id3d12commandqueue-getclockcalibration
+    UINT64 GPUTimestamp = 0;
+    UINT64 CPUTimestamp = 0;
+    if (FAILED(pd3d12Queue->GetClockCalibration(&GPUTimestamp, &CPUTimestamp)))
+        return False;
+
+    UINT64 GPUFrequency = 0;
+    if (FAILED(pd3d12Queue->GetTimestampFrequency(&GPUFrequency)) || GPUFrequency == 0)
+        return False;
+
+    LARGE_INTEGER QPCFrequency;
+    QueryPerformanceFrequency(&QPCFrequency);
+
+    Calibration.GPUCounter   = GPUTimestamp;
+    Calibration.GPUFrequency = GPUFrequency;
+    // std::chrono::steady_clock is QueryPerformanceCounter converted to nanoseconds the same way
+    Calibration.CPUTime      = TicksToNanoseconds(CPUTimestamp, static_cast<Uint64>(QPCFrequency.QuadPart));
+    Calibration.MaxDeviation = 0;
+    return True;
 }
 
 static void AliasingBarrier(CommandContext& CmdCtx, IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter)
@@ -2398,6 +2930,8 @@ static void AliasingBarrier(CommandContext& CmdCtx, IDeviceObject* pResourceBefo
 
 void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_TRANSITION_RESOURCE_STATES)};
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 
     auto& CmdCtx = GetCmdContext();
@@ -2433,6 +2967,9 @@ void DeviceContextD3D12Impl::TransitionOrVerifyBufferState(CommandContext&
                                                            RESOURCE_STATE                 RequiredState,
                                                            const char*                    OperationName)
 {
+    // The resource must be resident regardless of the transition mode
+    CmdCtx.TrackResidency(Buffer);
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Buffer.IsInKnownState())
@@ -2452,6 +2989,9 @@ void DeviceContextD3D12Impl::TransitionOrVerifyTextureState(CommandContext&
                                                             RESOURCE_STATE                 RequiredState,
                                                             const char*                    OperationName)
 {
+    // The resource must be resident regardless of the transition mode
+    CmdCtx.TrackResidency(Texture);
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Texture.IsInKnownState())
@@ -2564,22 +3104,22 @@ void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*
     CmdCtx.ResolveSubresource(pDstTexD3D12->GetD3D12Resource(), DstSubresIndex, pSrcTexD3D12->GetD3D12Resource(), SrcSubresIndex, DXGIFmt);
 }
 
-void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextD3D12Impl::PrepareBLASBuild(CommandContext& CmdCtx, const BuildBLASAttribs& Attribs, BLASBuildInfo& BuildInfo, const char* OpName)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
-
     auto* const pBLASD3D12    = ClassPtrCast<BottomLevelASD3D12Impl>(Attribs.pBLAS);
     auto* const pScratchD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pScratchBuffer);
     const auto& BLASDesc      = pBLASD3D12->GetDesc();
 
-    auto&       CmdCtx = GetCmdContext();
-    const char* OpName = "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)";
     TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
 
-    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC    d3d12BuildASDesc   = {};
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC&   d3d12BuildASDesc   = BuildInfo.d3d12BuildASDesc;
     D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& d3d12BuildASInputs = d3d12BuildASDesc.Inputs;
-    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>           Geometries;
+    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>&          Geometries         = BuildInfo.Geometries;
+
+    // The build info is reused, so reset it to value-initialize all fields below
+    d3d12BuildASDesc = {};
+    Geometries.clear();
 
     if (Attribs.pTriangleData != nullptr)
     {
@@ -2707,14 +3247,49 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     DEV_CHECK_ERR(d3d12BuildASDesc.ScratchAccelerationStructureData % D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT == 0,
                   "Scratch data address is not properly aligned");
 
-    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
-    ++m_State.NumCommands;
-
 #ifdef DILIGENT_DEVELOPMENT
     pBLASD3D12->DvpUpdateVersion();
 #endif
 }
 
+void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
+    if (m_BLASBuildInfos.empty())
+        m_BLASBuildInfos.resize(1);
+    auto& BuildInfo = m_BLASBuildInfos[0];
+
+    auto& CmdCtx = GetCmdContext();
+    PrepareBLASBuild(CmdCtx, Attribs, BuildInfo, "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)");
+
+    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(BuildInfo.d3d12BuildASDesc, 0, nullptr);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    const auto& Builds = m_BLASBatchBuilds;
+    if (Builds.empty())
+        return;
+
+    if (m_BLASBuildInfos.size() < Builds.size())
+        m_BLASBuildInfos.resize(Builds.size());
+
+    // Record all state transitions first. They are flushed as a single batch before
+    // the first build, so the builds are recorded back to back without barriers in between.
+    auto& CmdCtx = GetCmdContext();
+    for (size_t i = 0; i < Builds.size(); ++i)
+        PrepareBLASBuild(CmdCtx, Builds[i], m_BLASBuildInfos[i], "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLASBatch)");
+
+    auto& CmdCtx4 = CmdCtx.AsGraphicsContext4();
+    for (size_t i = 0; i < Builds.size(); ++i)
+        CmdCtx4.BuildRaytracingAccelerationStructure(m_BLASBuildInfos[i].d3d12BuildASDesc, 0, nullptr);
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     TDeviceContextBase::BuildTLAS(Attribs, 0);
@@ -2730,19 +3305,73 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     TransitionOrVerifyTLASState(CmdCtx, *pTLASD3D12, Attribs.TLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
 
-    if (Attribs.Update)
+    const auto WriteInstanceDesc = [&](D3D12_RAYTRACING_INSTANCE_DESC& d3d12Inst, const TLASBuildInstanceData& Inst, Uint32 ContributionToHitGroupIndex) {
+        auto* pBLASD3D12 = ClassPtrCast<BottomLevelASD3D12Impl>(Inst.pBLAS);
+
+        static_assert(sizeof(d3d12Inst.Transform) == sizeof(Inst.Transform), "size mismatch");
+        std::memcpy(&d3d12Inst.Transform, Inst.Transform.data, sizeof(d3d12Inst.Transform));
+
+        d3d12Inst.InstanceID                          = Inst.CustomId;
+        d3d12Inst.InstanceContributionToHitGroupIndex = ContributionToHitGroupIndex;
+        d3d12Inst.InstanceMask                        = Inst.Mask;
+        d3d12Inst.Flags                               = InstanceFlagsToD3D12RTInstanceFlags(Inst.Flags);
+        d3d12Inst.AccelerationStructure               = pBLASD3D12->GetGPUAddress();
+
+        TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
+    };
+
+    if (Attribs.DirtyInstancesOnly)
     {
-        if (!pTLASD3D12->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+        if (!pTLASD3D12->UpdateDirtyInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BindingMode, m_DirtyTLASInstances))
             return;
+
+        // Only write the descriptors of the changed instances. Instances with consecutive indices
+        // are copied with a single CopyBufferRegion.
+        if (!m_DirtyTLASInstances.empty())
+        {
+            constexpr size_t InstSize = sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+
+            auto TmpSpace = m_DynamicHeap.Allocate(m_DirtyTLASInstances.size() * InstSize, 16, m_FrameNumber);
+            auto pDstInst = static_cast<D3D12_RAYTRACING_INSTANCE_DESC*>(TmpSpace.CPUAddress);
+            for (size_t i = 0; i < m_DirtyTLASInstances.size(); ++i)
+            {
+                const auto& Dirty = m_DirtyTLASInstances[i];
+                WriteInstanceDesc(pDstInst[i], *Dirty.pData, Dirty.ContributionToHitGroupIndex);
+            }
+
+            TransitionOrVerifyBufferState(CmdCtx, *pInstancesD3D12, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_COPY_DEST, OpName);
+            Uint64 DstBuffDataStartByteOffset;
+            auto*  pd3d12InstBuff = pInstancesD3D12->GetD3D12Buffer(DstBuffDataStartByteOffset, this);
+            VERIFY(DstBuffDataStartByteOffset == 0, "Dst buffer must not be suballocated");
+            CmdCtx.FlushResourceBarriers();
+
+            size_t RunStart = 0;
+            for (size_t i = 1; i <= m_DirtyTLASInstances.size(); ++i)
+            {
+                if (i < m_DirtyTLASInstances.size() && m_DirtyTLASInstances[i].InstanceIndex == m_DirtyTLASInstances[i - 1].InstanceIndex + 1)
+                    continue;
+
+                CmdCtx.GetCommandList()->CopyBufferRegion(pd3d12InstBuff, Attribs.InstanceBufferOffset + m_DirtyTLASInstances[RunStart].InstanceIndex * InstSize,
+                                                          TmpSpace.pBuffer, TmpSpace.Offset + RunStart * InstSize, (i - RunStart) * InstSize);
+                ++m_State.NumCommands;
+                RunStart = i;
+            }
+        }
     }
     else
     {
-        if (!pTLASD3D12->SetInstanceData(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
-            return;
-    }
+        if (Attribs.Update)
+        {
+            if (!pTLASD3D12->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+                return;
+        }
+        else
+        {
+            if (!pTLASD3D12->SetInstanceData(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+                return;
+        }
 
-    // copy instance data into instance buffer
-    {
+        // copy instance data into instance buffer
         size_t Size     = Attribs.InstanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
         auto   TmpSpace = m_DynamicHeap.Allocate(Size, 16, m_FrameNumber);
 
@@ -2757,19 +3386,7 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
                 return;
             }
 
-            auto& d3d12Inst  = static_cast<D3D12_RAYTRACING_INSTANCE_DESC*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex];
-            auto* pBLASD3D12 = ClassPtrCast<BottomLevelASD3D12Impl>(Inst.pBLAS);
-
-            static_assert(sizeof(d3d12Inst.Transform) == sizeof(Inst.Transform), "size mismatch");
-            std::memcpy(&d3d12Inst.Transform, Inst.Transform.data, sizeof(d3d12Inst.Transform));
-
-            d3d12Inst.InstanceID                          = Inst.CustomId;
-            d3d12Inst.InstanceContributionToHitGroupIndex = InstDesc.ContributionToHitGroupIndex;
-            d3d12Inst.InstanceMask                        = Inst.Mask;
-            d3d12Inst.Flags                               = InstanceFlagsToD3D12RTInstanceFlags(Inst.Flags);
-            d3d12Inst.AccelerationStructure               = pBLASD3D12->GetGPUAddress();
-
-            TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
+            WriteInstanceDesc(static_cast<D3D12_RAYTRACING_INSTANCE_DESC*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex], Inst, InstDesc.ContributionToHitGroupIndex);
         }
         UpdateBufferRegion(pInstancesD3D12, TmpSpace, Attribs.InstanceBufferOffset, Size, Attribs.InstanceBufferTransitionMode);
     }
@@ -2781,7 +3398,7 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     d3d12BuildASInputs.Type          = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
     d3d12BuildASInputs.Flags         = BuildASFlagsToD3D12ASBuildFlags(pTLASD3D12->GetDesc().Flags);
     d3d12BuildASInputs.DescsLayout   = D3D12_ELEMENTS_LAYOUT_ARRAY;
-    d3d12BuildASInputs.NumDescs      = Attribs.InstanceCount;
+    d3d12BuildASInputs.NumDescs      = pTLASD3D12->GetBuildInfo().InstanceCount; // All instances, including the ones not updated by DirtyInstancesOnly build
     d3d12BuildASInputs.InstanceDescs = pInstancesD3D12->GetGPUAddress() + Attribs.InstanceBufferOffset;
 
     d3d12BuildASDesc.DestAccelerationStructureData    = pTLASD3D12->GetGPUAddress();
@@ -2913,7 +3530,9 @@ void DeviceContextD3D12Impl::TraceRays(const TraceRaysAttribs& Attribs)
 
     PrepareForDispatchRays(CmdCtx);
 
+    const Uint32 Breadcrumb = BeginBreadcrumb(CmdCtx, "TraceRays");
     CmdCtx.DispatchRays(d3d12DispatchDesc);
+    EndBreadcrumb(CmdCtx, Breadcrumb);
     ++m_State.NumCommands;
 }
 
@@ -2928,10 +3547,90 @@ void DeviceContextD3D12Impl::TraceRaysIndirect(const TraceRaysIndirectAttribs& A
 
     PrepareForDispatchRays(CmdCtx);
 
+    const Uint32 Breadcrumb = BeginBreadcrumb(CmdCtx, "TraceRaysIndirect");
     CmdCtx.ExecuteIndirect(m_pTraceRaysIndirectSignature, 1, pAttribsBufferD3D12->GetD3D12Resource(), Attribs.ArgsByteOffset);
+    EndBreadcrumb(CmdCtx, Breadcrumb);
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::DispatchGraph(const DispatchGraphAttribs& Attribs)
+{
+    DvpVerifyDispatchGraphArguments(Attribs);
+
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+    auto&       CmdCtx      = GetCmdContext().AsGraphicsContext10();
+    const auto& WorkGraph   = m_pPipelineState->GetWorkGraphProgramInfo();
+    const char* OpName      = "Dispatch graph (DeviceContextD3D12Impl::DispatchGraph)";
+    auto*       pd3d12SO    = m_pPipelineState->GetD3D12StateObject();
+    const auto  EntryPoint  = m_pPipelineState->GetWorkGraphEntryPointIndex(Attribs.EntryPointName != nullptr && *Attribs.EntryPointName != 0 ? Attribs.EntryPointName : nullptr,
+                                                                          Attribs.EntryPointArrayIndex);
+    auto*       pBackingMem = ClassPtrCast<BufferD3D12Impl>(Attribs.pBackingMemory != nullptr ? Attribs.pBackingMemory : WorkGraph.pBackingMemory.RawPtr());
+
+    if (EntryPoint == ~0u)
+    {
+        LOG_ERROR_MESSAGE("Work graph '", m_pPipelineState->GetDesc().Name, "' has no entry point '",
+                          (Attribs.EntryPointName != nullptr ? Attribs.EntryPointName : ""), "' with array index ", Attribs.EntryPointArrayIndex);
+        return;
+    }
+
+    PrepareForDispatchCompute(CmdCtx);
+
+    D3D12_SET_PROGRAM_DESC SetProgramDesc{};
+    SetProgramDesc.Type                        = D3D12_PROGRAM_TYPE_WORK_GRAPH;
+    SetProgramDesc.WorkGraph.ProgramIdentifier = WorkGraph.ProgramId;
+
+    if (pBackingMem != nullptr)
+    {
+        TransitionOrVerifyBufferState(CmdCtx, *pBackingMem, Attribs.BackingMemoryStateTransitionMode, RESOURCE_STATE_UNORDERED_ACCESS, OpName);
+
+        const Uint64 Offset = Attribs.pBackingMemory != nullptr ? Attribs.BackingMemoryOffset : 0;
+        const Uint64 Size   = Attribs.pBackingMemory != nullptr && Attribs.BackingMemorySize != 0 ?
+            Attribs.BackingMemorySize :
+            pBackingMem->GetDesc().Size - Offset;
+        DEV_CHECK_ERR(Size >= WorkGraph.MinBackingMemorySize, "Backing memory size (", Size, ") is smaller than the minimum size (",
+                      WorkGraph.MinBackingMemorySize, ") required by work graph '", m_pPipelineState->GetDesc().Name, "'.");
+
+        SetProgramDesc.WorkGraph.BackingMemory.StartAddress = pBackingMem->GetGPUAddress() + Offset;
+        SetProgramDesc.WorkGraph.BackingMemory.SizeInBytes  = Size;
+    }
+    else
+    {
+        DEV_CHECK_ERR(WorkGraph.MinBackingMemorySize == 0, "Work graph '", m_pPipelineState->GetDesc().Name, "' requires backing memory.");
+    }
+
+    ID3D12Resource* pd3d12BackingMem = pBackingMem != nullptr ? pBackingMem->GetD3D12Resource() : nullptr;
+
+    const bool Initialize =
+        Attribs.InitializeBackingMemory ||
+        m_LastWorkGraph.pStateObject != pd3d12SO ||
+        m_LastWorkGraph.pBackingMemory != pd3d12BackingMem ||
+        m_LastWorkGraph.BackingMemoryAddress != SetProgramDesc.WorkGraph.BackingMemory.StartAddress ||
+        m_LastWorkGraph.BackingMemorySize != SetProgramDesc.WorkGraph.BackingMemory.SizeInBytes;
+    if (Initialize)
+    {
+        SetProgramDesc.WorkGraph.Flags = D3D12_SET_WORK_GRAPH_FLAG_INITIALIZE;
+
+        m_LastWorkGraph.pStateObject         = pd3d12SO;
+        m_LastWorkGraph.pBackingMemory       = pd3d12BackingMem;
+        m_LastWorkGraph.BackingMemoryAddress = SetProgramDesc.WorkGraph.BackingMemory.StartAddress;
+        m_LastWorkGraph.BackingMemorySize    = SetProgramDesc.WorkGraph.BackingMemory.SizeInBytes;
+    }
+
+    CmdCtx.SetProgram(SetProgramDesc, pd3d12SO);
+
+    D3D12_DISPATCH_GRAPH_DESC DispatchDesc{};
+    DispatchDesc.Mode                             = D3D12_DISPATCH_MODE_NODE_CPU_INPUT;
+    DispatchDesc.NodeCPUInput.EntrypointIndex     = EntryPoint;
+    DispatchDesc.NodeCPUInput.NumRecords          = Attribs.NumRecords;
+    DispatchDesc.NodeCPUInput.pRecords            = Attribs.pRecords;
+    DispatchDesc.NodeCPUInput.RecordStrideInBytes = Attribs.RecordStride;
+    CmdCtx.DispatchGraph(DispatchDesc);
+    ++m_State.NumCommands;
+#else
+    UNSUPPORTED("Work graphs are not supported by the Direct3D12 headers the engine was built with");
+#endif
+}
+
 void DeviceContextD3D12Impl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs)
 {
     TDeviceContextBase::UpdateSBT(pSBT, pUpdateIndirectBufferAttribs, 0);
@@ -2946,24 +3645,37 @@ void DeviceContextD3D12Impl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIn
     ShaderBindingTableD3D12Impl::BindingTable HitGroupTable       = {};
     ShaderBindingTableD3D12Impl::BindingTable CallableShaderTable = {};
 
-    pSBTD3D12->GetData(pSBTBufferD3D12, RayGenShaderRecord, MissShaderTable, HitGroupTable, CallableShaderTable);
+    pSBTD3D12->GetData(pSBTBufferD3D12, RayGenShaderRecord, MissShaderTable, HitGroupTable, CallableShaderTable, m_SBTUploads);
 
-    if (RayGenShaderRecord.pData || MissShaderTable.pData || HitGroupTable.pData || CallableShaderTable.pData)
+    if (!m_SBTUploads.empty())
     {
-        TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, OpName);
+        // Only the records that changed since the previous update are uploaded.
+        // All regions are staged in a single dynamic heap allocation.
+        constexpr size_t RegionAlignment = 16;
 
-        // Buffer ranges do not intersect, so we don't need to add barriers between them
-        if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        size_t StagingSize = 0;
+        for (const auto& Region : m_SBTUploads)
+            StagingSize = AlignUp(StagingSize, RegionAlignment) + Region.Size;
 
-        if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        auto TmpSpace = m_DynamicHeap.Allocate(StagingSize, RegionAlignment, GetFrameNumber());
 
-        if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, OpName);
+
+        Uint64 DstBuffDataStartByteOffset;
+        auto*  pd3d12SBTBuff = pSBTBufferD3D12->GetD3D12Buffer(DstBuffDataStartByteOffset, this);
+        VERIFY(DstBuffDataStartByteOffset == 0, "SBT buffer must not be suballocated");
+        CmdCtx.FlushResourceBarriers();
 
-        if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        // Buffer ranges do not intersect, so we don't need to add barriers between them
+        size_t SrcOffset = 0;
+        for (const auto& Region : m_SBTUploads)
+        {
+            SrcOffset = AlignUp(SrcOffset, RegionAlignment);
+            memcpy(static_cast<Uint8*>(TmpSpace.CPUAddress) + SrcOffset, Region.pData, Region.Size);
+            CmdCtx.GetCommandList()->CopyBufferRegion(pd3d12SBTBuff, Region.Offset, TmpSpace.pBuffer, TmpSpace.Offset + SrcOffset, Region.Size);
+            ++m_State.NumCommands;
+            SrcOffset += Region.Size;
+        }
 
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, OpName);
     }
@@ -2988,14 +3700,22 @@ void DeviceContextD3D12Impl::BeginDebugGroup(const Char* Name, const float* pCol
 {
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
-    GetCmdContext().PixBeginEvent(Name, pColor);
+    auto& CmdCtx = GetCmdContext();
+    CmdCtx.PixBeginEvent(Name, pColor);
+
+    if (m_pBreadcrumbs)
+        m_pBreadcrumbs->BeginDebugGroup(CmdCtx, Name);
 }
 
 void DeviceContextD3D12Impl::EndDebugGroup()
 {
     TDeviceContextBase::EndDebugGroup(0);
 
-    GetCmdContext().PixEndEvent();
+    auto& CmdCtx = GetCmdContext();
+    CmdCtx.PixEndEvent();
+
+    if (m_pBreadcrumbs)
+        m_pBreadcrumbs->EndDebugGroup(CmdCtx);
 }
 
 void DeviceContextD3D12Impl::InsertDebugLabel(const Char* Label, const float* pColor)
@@ -223,9 +223,14 @@ Bool DeviceMemoryD3D12Impl::Resize(Uint64 NewSize)
     while (m_Pages.size() < NewPageCount)
     {
         if (auto pHeap = CreateD3D12Heap(m_pDevice, d3d12HeapDesc, m_UseNVApi))
+        {
             m_Pages.emplace_back(std::move(pHeap));
+        }
         else
+        {
+            RecordGPUMemory(GetCapacity());
             return false;
+        }
     }
 
     while (m_Pages.size() > NewPageCount)
@@ -234,6 +239,8 @@ Bool DeviceMemoryD3D12Impl::Resize(Uint64 NewSize)
         m_Pages.pop_back();
     }
 
+    RecordGPUMemory(GetCapacity());
+
     return true;
 }
 
@@ -117,6 +117,15 @@ public:
     }
 
 private:
+    // If pAdapterInfo is not null, it is used instead of querying the adapter information from the device again.
+    void AttachToD3D12Device(void*                        pd3d12NativeDevice,
+                             Uint32                       CommandQueueCount,
+                             ICommandQueueD3D12**         ppCommandQueues,
+                             const EngineD3D12CreateInfo& EngineCI,
+                             const GraphicsAdapterInfo*   pAdapterInfo,
+                             IRenderDevice**              ppDevice,
+                             IDeviceContext**             ppContexts);
+
 #if USE_D3D12_LOADER
     HMODULE     m_hD3D12Dll = NULL;
     std::string m_DllName;
@@ -246,6 +255,9 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         return;
     }
 
+    DeviceStartupTimer      StartupTimer;
+    DeviceStartupStatistics StartupStats;
+
     if (!LoadD3D12(EngineCI.D3D12DllName))
         return;
 
@@ -259,10 +271,11 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
     std::vector<RefCntAutoPtr<CommandQueueD3D12Impl>> CmdQueueD3D12Refs;
     CComPtr<ID3D12Device>                             d3d12Device;
     std::vector<ICommandQueueD3D12*>                  CmdQueues;
+    GraphicsAdapterInfo                               AdapterInfo;
     try
     {
         ValidateD3D12CreateInfo(EngineCI);
-        SetRawAllocator(EngineCI.pRawMemAllocator);
+        SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
 
         // Enable the D3D12 debug layer.
         if (EngineCI.EnableValidation)
@@ -289,6 +302,8 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         HRESULT hr = CreateDXGIFactory1(__uuidof(factory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&factory)));
         CHECK_D3D_RESULT_THROW(hr, "Failed to create DXGI factory");
 
+        StartupStats.InstanceCreationTime = StartupTimer.Lap();
+
         // Direct3D12 does not allow feature levels below 11.0 (D3D12CreateDevice fails to create a device).
         const auto MinimumFeatureLevel = Version::Max(EngineCI.GraphicsAPIVersion, Version{11, 0});
 
@@ -316,6 +331,8 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
             LOG_INFO_MESSAGE("D3D12-capable adapter found: ", NarrowString(desc.Description), " (", desc.DedicatedVideoMemory >> 20, " MB)");
         }
 
+        StartupStats.AdapterQueryTime = StartupTimer.Lap();
+
         const Version FeatureLevelList[] = {{12, 1}, {12, 0}, {11, 1}, {11, 0}};
         for (auto FeatureLevel : FeatureLevelList)
         {
@@ -409,11 +426,13 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         //d3d12Device->SetStablePowerState(TRUE);
 #endif
 
-        {
-            auto       pDXGIAdapter1 = DXGIAdapterFromD3D12Device(d3d12Device);
-            const auto AdapterInfo   = GetGraphicsAdapterInfo(d3d12Device, pDXGIAdapter1);
-            VerifyEngineCreateInfo(EngineCI, AdapterInfo);
-        }
+        StartupStats.DeviceCreationTime = StartupTimer.Lap();
+
+        // The adapter information is passed to AttachToD3D12Device() to avoid querying it twice
+        AdapterInfo = GetGraphicsAdapterInfo(d3d12Device, DXGIAdapterFromD3D12Device(d3d12Device));
+        VerifyEngineCreateInfo(EngineCI, AdapterInfo);
+
+        StartupStats.AdapterQueryTime += StartupTimer.Lap();
 
         // Describe and create the command queue.
         const auto CreateQueue = [&](const ImmediateContextCreateInfo& ContextCI) //
@@ -448,6 +467,8 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
 
             CreateQueue(DefaultContext);
         }
+
+        StartupStats.DeviceCreationTime += StartupTimer.Lap();
     }
     catch (const std::runtime_error&)
     {
@@ -455,7 +476,14 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         return;
     }
 
-    AttachToD3D12Device(d3d12Device, static_cast<Uint32>(CmdQueues.size()), CmdQueues.data(), EngineCI, ppDevice, ppContexts);
+    AttachToD3D12Device(d3d12Device, static_cast<Uint32>(CmdQueues.size()), CmdQueues.data(), EngineCI, &AdapterInfo, ppDevice, ppContexts);
+
+    if (*ppDevice != nullptr)
+    {
+        StartupStats.EngineObjectsCreationTime = StartupTimer.Lap();
+        StartupStats.TotalTime                 = StartupTimer.Total();
+        ClassPtrCast<RenderDeviceD3D12Impl>(*ppDevice)->SetStartupStatistics(StartupStats);
+    }
 }
 
 
@@ -492,6 +520,17 @@ void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd
                                                  const EngineD3D12CreateInfo& EngineCI,
                                                  IRenderDevice**              ppDevice,
                                                  IDeviceContext**             ppContexts)
+{
+    AttachToD3D12Device(pd3d12NativeDevice, CommandQueueCount, ppCommandQueues, EngineCI, nullptr, ppDevice, ppContexts);
+}
+
+void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd3d12NativeDevice,
+                                                 const Uint32                 CommandQueueCount,
+                                                 ICommandQueueD3D12**         ppCommandQueues,
+                                                 const EngineD3D12CreateInfo& EngineCI,
+                                                 const GraphicsAdapterInfo*   pAdapterInfo,
+                                                 IRenderDevice**              ppDevice,
+                                                 IDeviceContext**             ppContexts)
 {
     if (EngineCI.EngineAPIVersion != DILIGENT_API_VERSION)
     {
@@ -539,14 +578,15 @@ void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd
 
     try
     {
-        SetRawAllocator(EngineCI.pRawMemAllocator);
+        SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
         auto& RawMemAllocator = GetRawAllocator();
         auto  d3d12Device     = reinterpret_cast<ID3D12Device*>(pd3d12NativeDevice);
-        auto  pDXGIAdapter1   = DXGIAdapterFromD3D12Device(d3d12Device);
 
         ValidateD3D12CreateInfo(EngineCI);
 
-        const auto AdapterInfo = GetGraphicsAdapterInfo(pd3d12NativeDevice, pDXGIAdapter1);
+        const auto AdapterInfo = pAdapterInfo != nullptr ?
+            *pAdapterInfo :
+            GetGraphicsAdapterInfo(pd3d12NativeDevice, DXGIAdapterFromD3D12Device(d3d12Device));
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
         RenderDeviceD3D12Impl* pRenderDeviceD3D12{
@@ -763,7 +803,25 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
             ASSERT_SIZEOF(MeshProps, 4, "Did you add a new member to MeshShaderProperties? Please initialize it here.");
         }
 
+        // Check if work graphs are supported.
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+        {
+            D3D12_FEATURE_DATA_SHADER_MODEL ShaderModel = {D3D_SHADER_MODEL_6_8};
+            if (SUCCEEDED(d3d12Device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &ShaderModel, sizeof(ShaderModel))) &&
+                ShaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_8)
+            {
+                D3D12_FEATURE_DATA_D3D12_OPTIONS21 d3d12Features21 = {};
+                if (SUCCEEDED(d3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS21, &d3d12Features21, sizeof(d3d12Features21))) &&
+                    d3d12Features21.WorkGraphsTier >= D3D12_WORK_GRAPHS_TIER_1_0)
+                {
+                    Features.WorkGraphs = DEVICE_FEATURE_STATE_ENABLED;
+                }
+            }
+        }
+#endif
+
         Features.ShaderResourceRuntimeArray = DEVICE_FEATURE_STATE_ENABLED;
+        Features.ConditionalRendering       = DEVICE_FEATURE_STATE_ENABLED;
 
         {
             D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Features = {};
@@ -1056,7 +1114,7 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
         ASSERT_SIZEOF(DrawCommandProps, 12, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 43, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     return AdapterInfo;
 }
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "FenceCompletionWaiterD3D12.hpp"
+
+#include "FenceD3D12Impl.hpp"
+
+namespace Diligent
+{
+
+FenceCompletionWaiterD3D12::FenceCompletionWaiterD3D12() :
+    FenceCompletionWaiter{/*UseThread = */ true},
+    // clang-format off
+    m_hCompletionEvent{CreateEvent(NULL, FALSE, FALSE, NULL)},
+    m_hWakeUpEvent    {CreateEvent(NULL, FALSE, FALSE, NULL)}
+// clang-format on
+{
+    if (m_hCompletionEvent == NULL || m_hWakeUpEvent == NULL)
+        LOG_ERROR_AND_THROW("Failed to create fence completion waiter events");
+}
+
+FenceCompletionWaiterD3D12::~FenceCompletionWaiterD3D12()
+{
+    StopThread();
+
+    if (m_hCompletionEvent != NULL)
+        CloseHandle(m_hCompletionEvent);
+    if (m_hWakeUpEvent != NULL)
+        CloseHandle(m_hWakeUpEvent);
+}
+
+void FenceCompletionWaiterD3D12::WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter)
+{
+    for (auto& Item : Items)
+    {
+        if (Item.ArmedValue == Item.Value)
+            continue; // The event will be signaled by the previous call
+
+        ID3D12Fence* pd3d12Fence = ClassPtrCast<FenceD3D12Impl>(Item.pFence)->GetD3D12Fence();
+        // If the fence has already reached the value, the event is signaled immediately
+        HRESULT hr = pd3d12Fence->SetEventOnCompletion(Item.Value, m_hCompletionEvent);
+        if (FAILED(hr))
+        {
+            LOG_ERROR_MESSAGE("ID3D12Fence::SetEventOnCompletion() failed");
+            // Fall back to polling
+            SetEvent(m_hCompletionEvent);
+            continue;
+        }
+        Item.ArmedValue = Item.Value;
+    }
+
+    const HANDLE Events[] = {m_hCompletionEvent, m_hWakeUpEvent};
+    WaitForMultipleObjects(_countof(Events), Events, FALSE, INFINITE);
+}
+
+void FenceCompletionWaiterD3D12::WakeUp(Uint64 WakeCounter)
+{
+    // The event stays signaled until the waiter thread calls WaitForMultipleObjects()
+    SetEvent(m_hWakeUpEvent);
+}
+
+} // namespace Diligent
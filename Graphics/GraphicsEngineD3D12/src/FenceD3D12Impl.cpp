@@ -62,6 +62,8 @@ FenceD3D12Impl::FenceD3D12Impl(IReferenceCounters*    pRefCounters,
 
 FenceD3D12Impl::~FenceD3D12Impl()
 {
+    UnregisterCompletionCallbacks();
+
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Fence), ~0ull);
     if (m_FenceCompleteEvent != NULL)
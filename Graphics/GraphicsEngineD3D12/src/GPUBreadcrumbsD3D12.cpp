@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GPUBreadcrumbsD3D12.hpp"
+
+#include "RenderDeviceD3D12Impl.hpp"
+
+namespace Diligent
+{
+
+GPUBreadcrumbsD3D12::GPUBreadcrumbsD3D12(RenderDeviceD3D12Impl& DeviceD3D12, const char* ContextName) :
+    m_ContextName{ContextName != nullptr ? ContextName : ""}
+{
+    D3D12_RESOURCE_DESC D3D12BuffDesc{};
+    D3D12BuffDesc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
+    D3D12BuffDesc.Alignment          = 0;
+    D3D12BuffDesc.Width              = CompletedMarkerOffset + sizeof(Uint32);
+    D3D12BuffDesc.Height             = 1;
+    D3D12BuffDesc.DepthOrArraySize   = 1;
+    D3D12BuffDesc.MipLevels          = 1;
+    D3D12BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
+    D3D12BuffDesc.SampleDesc.Count   = 1;
+    D3D12BuffDesc.SampleDesc.Quality = 0;
+    D3D12BuffDesc.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    D3D12BuffDesc.Flags              = D3D12_RESOURCE_FLAG_NONE;
+
+    // Readback memory stays accessible by the CPU after the device has been removed.
+    D3D12_HEAP_PROPERTIES HeapProps{};
+    HeapProps.Type                 = D3D12_HEAP_TYPE_READBACK;
+    HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    HeapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    HeapProps.CreationNodeMask     = 1;
+    HeapProps.VisibleNodeMask      = 1;
+
+    // Resources in the readback heap must always be in the COPY_DEST state,
+    // which is also the state required by WriteBufferImmediate().
+    auto hr = DeviceD3D12.GetD3D12Device()->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE,
+                                                                    &D3D12BuffDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                                    __uuidof(m_pd3d12Buffer),
+                                                                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Buffer)));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create D3D12 GPU breadcrumbs buffer");
+
+    m_pd3d12Buffer->SetName(L"GPU breadcrumbs buffer");
+    m_GPUAddress = m_pd3d12Buffer->GetGPUVirtualAddress();
+
+    void* pData = nullptr;
+    hr          = m_pd3d12Buffer->Map(0, nullptr, &pData);
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to map D3D12 GPU breadcrumbs buffer");
+
+    auto* pMarkers = static_cast<Uint32*>(pData);
+    pMarkers[0]    = 0;
+    pMarkers[1]    = 0;
+    m_pMarkers     = pMarkers;
+}
+
+GPUBreadcrumbsD3D12::~GPUBreadcrumbsD3D12()
+{
+    if (m_pMarkers != nullptr)
+    {
+        // Nothing has been written by the CPU
+        D3D12_RANGE WrittenRange{0, 0};
+        m_pd3d12Buffer->Unmap(0, &WrittenRange);
+    }
+}
+
+bool GPUBreadcrumbsD3D12::IsSupported(RenderDeviceD3D12Impl& DeviceD3D12, D3D12_COMMAND_LIST_TYPE CmdListType)
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS3 d3d12Features3{};
+    if (FAILED(DeviceD3D12.GetD3D12Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS3, &d3d12Features3, sizeof(d3d12Features3))))
+        return false;
+
+    return (d3d12Features3.WriteBufferImmediateSupportFlags & (1u << CmdListType)) != 0;
+}
+
+void GPUBreadcrumbsD3D12::BeginDebugGroup(CommandContext& CmdCtx, const char* Name)
+{
+    const Uint32 Marker = m_Breadcrumbs.BeginDebugGroup(Name);
+    WriteMarker(CmdCtx, StartedMarkerOffset, Marker, D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_IN);
+    EndCommand(CmdCtx, Marker);
+}
+
+void GPUBreadcrumbsD3D12::EndDebugGroup(CommandContext& CmdCtx)
+{
+    const Uint32 Marker = m_Breadcrumbs.EndDebugGroup();
+    WriteMarker(CmdCtx, StartedMarkerOffset, Marker, D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_IN);
+    EndCommand(CmdCtx, Marker);
+}
+
+void GPUBreadcrumbsD3D12::LogDeviceRemoved(ID3D12Device* pd3d12Device) const
+{
+    const HRESULT RemovedReason = pd3d12Device->GetDeviceRemovedReason();
+    LOG_ERROR_MESSAGE("Direct3D12 device has been removed (reason: 0x", std::hex, static_cast<Uint32>(RemovedReason), std::dec,
+                      "). GPU breadcrumbs of context '", m_ContextName, "'. ",
+                      m_Breadcrumbs.GetReport(m_pMarkers[0], m_pMarkers[1]));
+}
+
+} // namespace Diligent
@@ -61,10 +61,36 @@
 #include "GenerateMips/GenerateMipsGammaOddCS.h"
 #include "GenerateMips/GenerateMipsGammaOddXCS.h"
 #include "GenerateMips/GenerateMipsGammaOddYCS.h"
+#include "GenerateMips/SinglePassDownsamplerLinearCS.h"
+#include "GenerateMips/SinglePassDownsamplerGammaCS.h"
 
 namespace Diligent
 {
-GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
+
+namespace
+{
+
+// The scratch buffer layout must match SinglePassDownsamplerCS.hlsli
+constexpr Uint32 SPDMaxMipLevels         = 12;
+constexpr Uint32 SPDMaxSlicesPerDispatch = 6;
+constexpr Uint32 SPDScratchCountersSize  = 256;
+// Every slice needs up to 64x64 float4 mip 6 texels
+constexpr Uint32 SPDScratchBufferSize = SPDScratchCountersSize + SPDMaxSlicesPerDispatch * 64 * 64 * 16;
+
+struct SPDRootConstants
+{
+    Uint32 SrcMipLevel;
+    Uint32 NumMipLevels;
+    Uint32 FirstArraySlice;
+    Uint32 NumWorkGroups;
+    Uint32 SrcMipSize[2];
+    Uint32 Dummy[2];
+};
+static_assert(sizeof(SPDRootConstants) == 8 * sizeof(Uint32), "Root constants size must match the root signature");
+
+} // namespace
+
+GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device, size_t NumCommandQueues)
 {
     CD3DX12_ROOT_PARAMETER Params[3];
     Params[0].InitAsConstants(6, 0);
@@ -113,12 +139,111 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
     CreatePSO(m_pGenerateMipsGammaPSO[1], g_pGenerateMipsGammaOddXCS);
     CreatePSO(m_pGenerateMipsGammaPSO[2], g_pGenerateMipsGammaOddYCS);
     CreatePSO(m_pGenerateMipsGammaPSO[3], g_pGenerateMipsGammaOddCS);
+
+    // The single-pass downsampler binds 13 UAVs, which requires resource binding tier 2
+    D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Options{};
+    if (SUCCEEDED(pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Options, sizeof(d3d12Options))) &&
+        d3d12Options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2)
+    {
+        CreateSinglePassDownsampler(pd3d12Device, NumCommandQueues);
+    }
 }
 
-void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx) const
+void GenerateMipsHelper::CreateSinglePassDownsampler(ID3D12Device* pd3d12Device, size_t NumCommandQueues)
+{
+    CD3DX12_ROOT_PARAMETER Params[3];
+    Params[0].InitAsConstants(sizeof(SPDRootConstants) / sizeof(Uint32), 0);
+    CD3DX12_DESCRIPTOR_RANGE SRVRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+    Params[1].InitAsDescriptorTable(1, &SRVRange);
+    CD3DX12_DESCRIPTOR_RANGE UAVRange(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, SPDMaxMipLevels + 1, 0);
+    Params[2].InitAsDescriptorTable(1, &UAVRange);
+    CD3DX12_STATIC_SAMPLER_DESC SamplerLinearClampDesc(
+        0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+    CD3DX12_ROOT_SIGNATURE_DESC RootSigDesc;
+    RootSigDesc.NumParameters     = _countof(Params);
+    RootSigDesc.pParameters       = Params;
+    RootSigDesc.NumStaticSamplers = 1;
+    RootSigDesc.pStaticSamplers   = &SamplerLinearClampDesc;
+    RootSigDesc.Flags             = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    CComPtr<ID3DBlob> signature;
+    CComPtr<ID3DBlob> error;
+
+    HRESULT hr = D3D12SerializeRootSignature(&RootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+    CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature for single-pass mipmap generation");
+
+    hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pSPDRootSig), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pSPDRootSig)));
+    CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature for single-pass mipmap generation");
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC PSODesc = {};
+
+    PSODesc.pRootSignature = m_pSPDRootSig;
+    PSODesc.NodeMask       = 0;
+    PSODesc.Flags          = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+    CreatePSO(m_pSPDLinearPSO, g_pSinglePassDownsamplerLinearCS);
+    CreatePSO(m_pSPDGammaPSO, g_pSinglePassDownsamplerGammaCS);
+
+    D3D12_DESCRIPTOR_HEAP_DESC HeapDesc{};
+    HeapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    HeapDesc.NumDescriptors = static_cast<UINT>(NumCommandQueues);
+    HeapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    HeapDesc.NodeMask       = 0;
+    hr                      = pd3d12Device->CreateDescriptorHeap(&HeapDesc, __uuidof(m_pSPDScratchUAVHeap), reinterpret_cast<void**>(static_cast<ID3D12DescriptorHeap**>(&m_pSPDScratchUAVHeap)));
+    CHECK_D3D_RESULT_THROW(hr, "Failed to create descriptor heap for single-pass mipmap generation");
+    m_SPDScratchUAVSize = pd3d12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    D3D12_HEAP_PROPERTIES HeapProps{};
+    HeapProps.Type                 = D3D12_HEAP_TYPE_DEFAULT;
+    HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    HeapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    HeapProps.CreationNodeMask     = 1;
+    HeapProps.VisibleNodeMask      = 1;
+
+    const auto ScratchBuffDesc = CD3DX12_RESOURCE_DESC::Buffer(SPDScratchBufferSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+    m_SPDScratchBuffers.resize(NumCommandQueues);
+    for (size_t q = 0; q < NumCommandQueues; ++q)
+    {
+        // The shader expects the counters to be zero. Committed resources are zeroed on creation,
+        // and the last thread group of every dispatch resets the counters.
+        auto& pScratchBuffer = m_SPDScratchBuffers[q];
+        hr                   = pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE, &ScratchBuffDesc, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr,
+                                                                     __uuidof(pScratchBuffer), reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&pScratchBuffer)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create scratch buffer for single-pass mipmap generation");
+        pScratchBuffer->SetName(L"Single-pass downsampler scratch buffer");
+
+        D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc{};
+        UAVDesc.Format              = DXGI_FORMAT_R32_TYPELESS;
+        UAVDesc.ViewDimension       = D3D12_UAV_DIMENSION_BUFFER;
+        UAVDesc.Buffer.FirstElement = 0;
+        UAVDesc.Buffer.NumElements  = SPDScratchBufferSize / 4;
+        UAVDesc.Buffer.Flags        = D3D12_BUFFER_UAV_FLAG_RAW;
+
+        D3D12_CPU_DESCRIPTOR_HANDLE UAVHandle = m_pSPDScratchUAVHeap->GetCPUDescriptorHandleForHeapStart();
+        UAVHandle.ptr += q * m_SPDScratchUAVSize;
+        pd3d12Device->CreateUnorderedAccessView(pScratchBuffer, nullptr, &UAVDesc, UAVHandle);
+    }
+}
+
+bool GenerateMipsHelper::CanUseSinglePassDownsampler(const TextureDesc& TexDesc, const TextureViewDesc& ViewDesc) const
+{
+    if (!m_pSPDRootSig)
+        return false;
+
+    // The multi-pass path generates up to 4 mip levels per dispatch and handles odd dimensions more accurately
+    const auto NumMipsToGenerate = ViewDesc.NumMipLevels - 1;
+    if (NumMipsToGenerate <= 4 || NumMipsToGenerate > SPDMaxMipLevels)
+        return false;
+
+    // Every thread group processes a 64x64 tile, and the mip 6 scratch memory holds up to 64x64 texels
+    const auto SrcWidth  = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const auto SrcHeight = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    return SrcWidth <= 4096 && SrcHeight <= 4096;
+}
+
+void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx, SoftwareQueueIndex CmdQueueInd) const
 {
-    auto& ComputeCtx = Ctx.AsComputeContext();
-    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
     auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
     const auto& TexDesc   = pTexD3D12->GetDesc();
     const auto& ViewDesc  = pTexView->GetDesc();
@@ -130,8 +255,6 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
         TexDesc.ArraySize == ViewDesc.NumArraySlices;
     bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
 
-    auto SRVDescriptorHandle = pTexView->GetTexArraySRV();
-
     if (!pTexD3D12->IsInKnownState())
     {
         LOG_ERROR_MESSAGE("Unable to generate mips for texture '", TexDesc.Name, "' because the texture state is unknown");
@@ -152,6 +275,29 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
     // Otherwise we will transition affected subresources back to original layout.
     const auto FinalState = (IsAllSlices && IsAllMips) ? RESOURCE_STATE_SHADER_RESOURCE : OriginalState;
 
+    if (CanUseSinglePassDownsampler(TexDesc, ViewDesc))
+        GenerateMipsSinglePass(pd3d12Device, pTexView, Ctx, CmdQueueInd, OriginalState, FinalState);
+    else
+        GenerateMipsMultiPass(pd3d12Device, pTexView, Ctx, OriginalState, FinalState);
+
+    // Set state
+    pTexD3D12->SetState(FinalState);
+}
+
+void GenerateMipsHelper::GenerateMipsMultiPass(ID3D12Device*         pd3d12Device,
+                                               TextureViewD3D12Impl* pTexView,
+                                               CommandContext&       Ctx,
+                                               RESOURCE_STATE        OriginalState,
+                                               RESOURCE_STATE        FinalState) const
+{
+    auto& ComputeCtx = Ctx.AsComputeContext();
+    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
+    auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
+    const auto& TexDesc   = pTexD3D12->GetDesc();
+    const auto& ViewDesc  = pTexView->GetDesc();
+
+    auto SRVDescriptorHandle = pTexView->GetTexArraySRV();
+
     auto BottomMip = ViewDesc.NumMipLevels - 1;
     for (uint32_t TopMip = 0; TopMip < BottomMip;)
     {
@@ -273,8 +419,116 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
 
         TopMip += NumMips;
     }
+}
 
-    // Set state
-    pTexD3D12->SetState(FinalState);
+void GenerateMipsHelper::GenerateMipsSinglePass(ID3D12Device*         pd3d12Device,
+                                                TextureViewD3D12Impl* pTexView,
+                                                CommandContext&       Ctx,
+                                                SoftwareQueueIndex    CmdQueueInd,
+                                                RESOURCE_STATE        OriginalState,
+                                                RESOURCE_STATE        FinalState) const
+{
+    auto& ComputeCtx = Ctx.AsComputeContext();
+    ComputeCtx.SetComputeRootSignature(m_pSPDRootSig);
+    auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
+    const auto& TexDesc   = pTexD3D12->GetDesc();
+    const auto& ViewDesc  = pTexView->GetDesc();
+
+    ComputeCtx.SetPipelineState(TexDesc.Format == TEX_FORMAT_RGBA8_UNORM_SRGB ? m_pSPDGammaPSO : m_pSPDLinearPSO);
+
+    const Uint32 NumMips   = ViewDesc.NumMipLevels - 1;
+    const Uint32 SrcWidth  = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const Uint32 SrcHeight = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    // Every thread group processes a 64x64 tile of the source mip level
+    const Uint32 NumGroupsX = (SrcWidth + 63) / 64;
+    const Uint32 NumGroupsY = (SrcHeight + 63) / 64;
+
+    VERIFY_EXPR(static_cast<size_t>(CmdQueueInd) < m_SPDScratchBuffers.size());
+    ID3D12Resource* pScratchBuffer = m_SPDScratchBuffers[CmdQueueInd];
+
+    D3D12_CPU_DESCRIPTOR_HANDLE ScratchUAVHandle = m_pSPDScratchUAVHeap->GetCPUDescriptorHandleForHeapStart();
+    ScratchUAVHandle.ptr += static_cast<size_t>(CmdQueueInd) * m_SPDScratchUAVSize;
+
+    auto DescriptorAlloc = Ctx.AllocateDynamicGPUVisibleDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 2 + SPDMaxMipLevels);
+
+    CommandContext::ShaderDescriptorHeaps Heaps{DescriptorAlloc.GetDescriptorHeap(), nullptr};
+    ComputeCtx.SetDescriptorHeaps(Heaps);
+    Ctx.GetCommandList()->SetComputeRootDescriptorTable(1, DescriptorAlloc.GetGpuHandle(0));
+    Ctx.GetCommandList()->SetComputeRootDescriptorTable(2, DescriptorAlloc.GetGpuHandle(1));
+
+    D3D12_CPU_DESCRIPTOR_HANDLE DstDescriptorRange = DescriptorAlloc.GetCpuHandle();
+    UINT                        DstRangeSize       = 2 + SPDMaxMipLevels;
+
+    D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRanges[2 + SPDMaxMipLevels] = {};
+    UINT                        SrcRangeSizes[2 + SPDMaxMipLevels]       = {};
+
+    SrcDescriptorRanges[0] = pTexView->GetTexArraySRV();
+    // On Resource Binding Tier 2 hardware, all UAV descriptors in the table must be initialized,
+    // so copy the last mip level UAV to all unused slots.
+    for (Uint32 u = 0; u < SPDMaxMipLevels; ++u)
+        SrcDescriptorRanges[1 + u] = pTexView->GetMipLevelUAV(std::min(u + 1, NumMips));
+    SrcDescriptorRanges[1 + SPDMaxMipLevels] = ScratchUAVHandle;
+    for (auto& RangeSize : SrcRangeSizes)
+        RangeSize = 1;
+
+    pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, _countof(SrcDescriptorRanges), SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    // Transition the source mip level to the shader resource state
+    StateTransitionDesc SrcMipBarrier{pTexD3D12, OriginalState, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_NONE};
+    if (SrcMipBarrier.OldState != SrcMipBarrier.NewState)
+    {
+        SrcMipBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip;
+        SrcMipBarrier.MipLevelsCount  = 1;
+        SrcMipBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+        SrcMipBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
+        Ctx.TransitionResource(*pTexD3D12, SrcMipBarrier);
+    }
+
+    // Transition all destination mip levels to the UAV state
+    StateTransitionDesc DstMipsBarrier{pTexD3D12, OriginalState, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_NONE};
+    if (DstMipsBarrier.OldState != DstMipsBarrier.NewState)
+    {
+        DstMipsBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + 1;
+        DstMipsBarrier.MipLevelsCount  = NumMips;
+        DstMipsBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+        DstMipsBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
+        Ctx.TransitionResource(*pTexD3D12, DstMipsBarrier);
+    }
+
+    for (Uint32 FirstSlice = 0; FirstSlice < ViewDesc.NumArraySlices; FirstSlice += SPDMaxSlicesPerDispatch)
+    {
+        const Uint32 NumSlices = std::min(ViewDesc.NumArraySlices - FirstSlice, SPDMaxSlicesPerDispatch);
+
+        // Wait for the previous dispatch that used the scratch buffer to reset the counters
+        Ctx.ResourceBarrier(CD3DX12_RESOURCE_BARRIER::UAV(pScratchBuffer));
+
+        SPDRootConstants Constants{
+            0, // Mip levels are relative to the view's most detailed mip
+            NumMips,
+            FirstSlice, // Array slices are relative to the view's first array slice
+            NumGroupsX * NumGroupsY,
+            {SrcWidth, SrcHeight},
+            {0, 0}
+        };
+        Ctx.GetCommandList()->SetComputeRoot32BitConstants(0, sizeof(Constants) / sizeof(Uint32), &Constants, 0);
+
+        ComputeCtx.Dispatch(NumGroupsX, NumGroupsY, NumSlices);
+    }
+
+    // Transition all processed mip levels to the final state
+    if (SrcMipBarrier.NewState != FinalState)
+    {
+        SrcMipBarrier.OldState = SrcMipBarrier.NewState;
+        SrcMipBarrier.NewState = FinalState;
+        Ctx.TransitionResource(*pTexD3D12, SrcMipBarrier);
+    }
+
+    if (DstMipsBarrier.NewState != FinalState)
+    {
+        DstMipsBarrier.OldState = DstMipsBarrier.NewState;
+        DstMipsBarrier.NewState = FinalState;
+        Ctx.TransitionResource(*pTexD3D12, DstMipsBarrier);
+    }
 }
+
 } // namespace Diligent
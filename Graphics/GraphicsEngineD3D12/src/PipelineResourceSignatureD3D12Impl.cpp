@@ -46,8 +46,40 @@ namespace Diligent
 namespace
 {
 
-void ValidatePipelineResourceSignatureDescD3D12(const PipelineResourceSignatureDesc& Desc) noexcept(false)
+void ValidatePipelineResourceSignatureDescD3D12(const PipelineResourceSignatureDesc& Desc, const RenderDeviceD3D12Impl* pDevice) noexcept(false)
 {
+    {
+        // Every bindless array element takes one 32-bit value in the root signature,
+        // which is limited to 64 DWORDs.
+        constexpr Uint32 MaxBindlessIndices = 64;
+
+        Uint32 NumBindlessIndices = 0;
+        for (Uint32 i = 0; i < Desc.NumResources; ++i)
+        {
+            const auto& Res = Desc.Resources[i];
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) == 0)
+                continue;
+
+            // pDevice is null when the signature is created by the archiver
+            if (pDevice != nullptr && !pDevice->AreBindlessResourcesSupported())
+            {
+                LOG_ERROR_AND_THROW("Pipeline resource signature '", (Desc.Name != nullptr ? Desc.Name : ""),
+                                    "' uses BINDLESS flag for resource '", Res.Name,
+                                    "', but the device does not support accessing resources through the descriptor heap. "
+                                    "Shader model 6.6 and resource binding tier 3 are required.");
+            }
+
+            NumBindlessIndices += Res.ArraySize;
+        }
+
+        if (NumBindlessIndices > MaxBindlessIndices)
+        {
+            LOG_ERROR_AND_THROW("Pipeline resource signature '", (Desc.Name != nullptr ? Desc.Name : ""),
+                                "' defines ", NumBindlessIndices, " bindless resource array elements, which exceeds the maximum allowed number (",
+                                MaxBindlessIndices, ").");
+        }
+    }
+
     {
         std::unordered_multimap<HashMapStringKey, SHADER_TYPE> ResNameToShaderStages;
         for (Uint32 i = 0; i < Desc.NumResources; ++i)
@@ -120,7 +152,7 @@ PipelineResourceSignatureD3D12Impl::PipelineResourceSignatureD3D12Impl(IReferenc
 {
     try
     {
-        ValidatePipelineResourceSignatureDescD3D12(Desc);
+        ValidatePipelineResourceSignatureDescD3D12(Desc, pDevice);
 
         Initialize(
             GetRawAllocator(), DecoupleCombinedSamplers(Desc), m_ImmutableSamplers,
@@ -146,10 +178,15 @@ void PipelineResourceSignatureD3D12Impl::AllocateRootParameters(const bool IsSer
     std::vector<Uint32> TextureSrvToAssignedSamplerInd(m_Desc.NumResources, ResourceAttribs::InvalidSamplerInd);
     // Index of the immutable sampler for every sampler in m_Desc.Resources, or InvalidImmutableSamplerIndex.
     std::vector<Uint32> ResourceToImmutableSamplerInd(m_Desc.NumResources, InvalidImmutableSamplerIndex);
+    // The number of run-time sized arrays, each of which is allocated in a separate space.
+    Uint32 NumRTSizedArrays = 0;
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
     {
         const auto& ResDesc = m_Desc.Resources[i];
 
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY) != 0)
+            ++NumRTSizedArrays;
+
         if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
         {
             // We only need to search for immutable samplers for SHADER_RESOURCE_TYPE_SAMPLER.
@@ -214,6 +251,9 @@ void PipelineResourceSignatureD3D12Impl::AllocateRootParameters(const bool IsSer
     RootParamsBuilder ParamsBuilder;
 
     Uint32 NextRTSizedArraySpace = 1;
+    // Root constants that hold descriptor heap indices of bindless resources go into the first space
+    // after all run-time sized arrays.
+    const Uint32 BindlessIndicesSpace = 1 + NumRTSizedArrays;
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
     {
         const auto& ResDesc = m_Desc.Resources[i];
@@ -230,6 +270,7 @@ void PipelineResourceSignatureD3D12Impl::AllocateRootParameters(const bool IsSer
 
         const auto d3d12DescriptorRangeType = ResourceTypeToD3D12DescriptorRangeType(ResDesc.ResourceType);
         const bool IsRTSizedArray           = (ResDesc.Flags & PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY) != 0;
+        const bool IsBindless               = (ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0;
         Uint32     Register                 = 0;
         Uint32     Space                    = 0;
         Uint32     SRBRootIndex             = ResourceAttribs::InvalidSRBRootIndex;
@@ -253,7 +294,14 @@ void PipelineResourceSignatureD3D12Impl::AllocateRootParameters(const bool IsSer
                 StaticResCacheTblSizes[SigRootIndex] += ResDesc.ArraySize;
             }
 
-            if (IsRTSizedArray)
+            if (IsBindless)
+            {
+                // Bindless resources are not bound to shader registers; they are accessed
+                // through the descriptor heap using the indices stored in root constants.
+                Space    = 0;
+                Register = 0;
+            }
+            else if (IsRTSizedArray)
             {
                 // All run-time sized arrays are allocated in separate spaces.
                 Space    = NextRTSizedArraySpace++;
@@ -296,9 +344,20 @@ void PipelineResourceSignatureD3D12Impl::AllocateRootParameters(const bool IsSer
                     d3d12RootParamType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
             }
 
-            ParamsBuilder.AllocateResourceSlot(ResDesc.ShaderStages, ResDesc.VarType, d3d12RootParamType,
-                                               d3d12DescriptorRangeType, ResDesc.ArraySize, Register, Space,
-                                               SRBRootIndex, SRBOffsetFromTableStart);
+            if (IsBindless)
+            {
+                // Every bindless array element takes one 32-bit value in the root constants
+                d3d12RootParamType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+                ParamsBuilder.AllocateResourceSlot(ResDesc.ShaderStages, ResDesc.VarType, d3d12RootParamType,
+                                                   d3d12DescriptorRangeType, ResDesc.ArraySize, 0, BindlessIndicesSpace,
+                                                   SRBRootIndex, SRBOffsetFromTableStart);
+            }
+            else
+            {
+                ParamsBuilder.AllocateResourceSlot(ResDesc.ShaderStages, ResDesc.VarType, d3d12RootParamType,
+                                                   d3d12DescriptorRangeType, ResDesc.ArraySize, Register, Space,
+                                                   SRBRootIndex, SRBOffsetFromTableStart);
+            }
         }
         else
         {
@@ -585,6 +644,12 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
     };
     if (Heaps.pSrvCbvUavHeap == nullptr && pSrvCbvUavDynamicAllocation != nullptr)
         Heaps.pSrvCbvUavHeap = pSrvCbvUavDynamicAllocation->GetDescriptorHeap();
+    if (Heaps.pSrvCbvUavHeap == nullptr && HasBindlessResources())
+    {
+        // Bindless resources are accessed through the shader-visible heap that contains all persistent
+        // view descriptors. This is the same heap that static/mutable and dynamic allocations come from.
+        Heaps.pSrvCbvUavHeap = GetDevice()->GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).GetD3D12DescriptorHeap();
+    }
     if (Heaps.pSamplerHeap == nullptr && pSamplerDynamicAllocation != nullptr)
         Heaps.pSamplerHeap = pSamplerDynamicAllocation->GetDescriptorHeap();
 
@@ -631,6 +696,42 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
             CmdCtx.GetCommandList()->SetGraphicsRootDescriptorTable(BaseRootIndex + RootTable.RootIndex, RootTableGPUDescriptorHandle);
     }
 
+    // Commit descriptor heap indices of bindless resources
+    for (Uint32 rc = 0, NumRootConstants = m_RootParams.GetNumRootConstants(); rc < NumRootConstants; ++rc)
+    {
+        const auto& RootConsts = m_RootParams.GetRootConstants(rc);
+        const auto& CacheTbl   = ResourceCache.GetRootTable(RootConsts.RootIndex);
+        const auto  NumValues  = CacheTbl.GetSize();
+        VERIFY_EXPR(NumValues == RootConsts.d3d12RootParam.Constants.Num32BitValues);
+
+        // Root signature size is limited to 64 DWORDs
+        std::array<Uint32, 64> Indices;
+        VERIFY_EXPR(NumValues <= Indices.size());
+        for (Uint32 i = 0; i < NumValues; ++i)
+        {
+            const auto& Res = CacheTbl.GetResource(i);
+            if (Res.IsNull())
+            {
+                // Index 0 is always a valid slot in the heap
+                Indices[i] = 0;
+                continue;
+            }
+
+            // No need to QueryInterface() - the type is verified when a resource is bound
+            if (Res.Type == SHADER_RESOURCE_TYPE_TEXTURE_SRV || Res.Type == SHADER_RESOURCE_TYPE_TEXTURE_UAV)
+                Indices[i] = Res.pObject.RawPtr<TextureViewD3D12Impl>()->GetBindlessDescriptorIndex();
+            else if (Res.Type == SHADER_RESOURCE_TYPE_BUFFER_SRV || Res.Type == SHADER_RESOURCE_TYPE_BUFFER_UAV)
+                Indices[i] = Res.pObject.RawPtr<BufferViewD3D12Impl>()->GetBindlessDescriptorIndex();
+            else
+                UNEXPECTED("Unexpected bindless resource type");
+        }
+
+        if (CommitAttribs.IsCompute)
+            CmdCtx.GetCommandList()->SetComputeRoot32BitConstants(BaseRootIndex + RootConsts.RootIndex, NumValues, Indices.data(), 0);
+        else
+            CmdCtx.GetCommandList()->SetGraphicsRoot32BitConstants(BaseRootIndex + RootConsts.RootIndex, NumValues, Indices.data(), 0);
+    }
+
     // Commit non-dynamic root buffer views
     if (auto NonDynamicBuffersMask = ResourceCache.GetNonDynamicRootBuffersMask())
     {
@@ -655,7 +756,8 @@ void PipelineResourceSignatureD3D12Impl::UpdateShaderResourceBindingMap(Resource
         const auto& ResDesc = GetResourceDesc(r);
         const auto& Attribs = GetResourceAttribs(r);
 
-        if ((ResDesc.ShaderStages & ShaderStage) != 0)
+        // Bindless resources are not declared in shaders
+        if ((ResDesc.ShaderStages & ShaderStage) != 0 && !Attribs.IsBindless())
         {
             ResourceBinding::BindInfo BindInfo //
                 {
@@ -671,6 +773,23 @@ void PipelineResourceSignatureD3D12Impl::UpdateShaderResourceBindingMap(Resource
         }
     }
 
+    // Add the constant buffer that holds descriptor heap indices of bindless resources
+    for (Uint32 rc = 0, NumRootConstants = m_RootParams.GetNumRootConstants(); rc < NumRootConstants; ++rc)
+    {
+        VERIFY(NumRootConstants == 1, "Only one root constants parameter is expected");
+        const auto& d3d12Consts = m_RootParams.GetRootConstants(rc).d3d12RootParam.Constants;
+
+        ResourceBinding::BindInfo BindInfo //
+            {
+                d3d12Consts.ShaderRegister,
+                d3d12Consts.RegisterSpace + BaseRegisterSpace,
+                1,
+                SHADER_RESOURCE_TYPE_CONSTANT_BUFFER //
+            };
+        auto IsUnique = ResourceMap.emplace(HashMapStringKey{GetBindlessIndicesBufferName(), true}, BindInfo).second;
+        VERIFY(IsUnique, "Bindless indices buffer '", GetBindlessIndicesBufferName(), "' already present in the binding map.");
+    }
+
     // Add immutable samplers to the map as there may be immutable samplers that are not defined as resources, e.g.:
     //
     //      PipelineResourceDesc Resources[] = {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, ...}
@@ -713,6 +832,11 @@ void PipelineResourceSignatureD3D12Impl::UpdateShaderResourceBindingMap(Resource
     }
 }
 
+String PipelineResourceSignatureD3D12Impl::GetBindlessIndicesBufferName() const
+{
+    return String{"cbBindlessIndices"} + std::to_string(Uint32{m_Desc.BindingIndex});
+}
+
 bool PipelineResourceSignatureD3D12Impl::HasImmutableSamplerArray(SHADER_TYPE ShaderStage) const
 {
     for (Uint32 s = 0; s < GetImmutableSamplerCount(); ++s)
@@ -859,7 +983,7 @@ PipelineResourceSignatureD3D12Impl::PipelineResourceSignatureD3D12Impl(IReferenc
 {
     try
     {
-        ValidatePipelineResourceSignatureDescD3D12(Desc);
+        ValidatePipelineResourceSignatureDescD3D12(Desc, pDevice);
 
         Deserialize(
             GetRawAllocator(), DecoupleCombinedSamplers(Desc), InternalData, m_ImmutableSamplers,
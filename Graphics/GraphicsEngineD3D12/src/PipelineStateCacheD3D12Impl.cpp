@@ -29,9 +29,26 @@
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DataBlobImpl.hpp"
 
+#include <sstream>
+
 namespace Diligent
 {
 
+namespace
+{
+
+// Pipeline library data is only compatible with the same adapter and driver version.
+// The driver version is validated by CreatePipelineLibrary.
+std::string GetPipelineLibraryDeviceKey(const GraphicsAdapterInfo& AdapterInfo)
+{
+    std::stringstream ss;
+    ss << "D3D12_" << std::hex << std::uppercase
+       << AdapterInfo.VendorId << '_' << AdapterInfo.DeviceId;
+    return ss.str();
+}
+
+} // namespace
+
 PipelineStateCacheD3D12Impl::PipelineStateCacheD3D12Impl(IReferenceCounters*                 pRefCounters,
                                                          RenderDeviceD3D12Impl*              pRenderDeviceD3D12,
                                                          const PipelineStateCacheCreateInfo& CreateInfo) :
@@ -45,13 +62,38 @@ PipelineStateCacheD3D12Impl::PipelineStateCacheD3D12Impl(IReferenceCounters*
     }
 // clang-format on
 {
-    auto hr = pRenderDeviceD3D12->GetD3D12Device1()->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
-    if (FAILED(hr))
-        LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+    auto* pd3d12Device = pRenderDeviceD3D12->GetD3D12Device1();
+
+    m_pLibraryData = InitCacheFile(CreateInfo, GetPipelineLibraryDeviceKey(pRenderDeviceD3D12->GetAdapterInfo()).c_str());
+    if (!m_pLibraryData && CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0)
+    {
+        // The library references the data, so it must be kept alive for the library lifetime
+        m_pLibraryData = DataBlobImpl::Create(CreateInfo.CacheDataSize, CreateInfo.pCacheData);
+    }
+
+    if (m_pLibraryData)
+    {
+        auto hr = pd3d12Device->CreatePipelineLibrary(m_pLibraryData->GetConstDataPtr(), m_pLibraryData->GetSize(), IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+        {
+            // D3D12_ERROR_DRIVER_VERSION_MISMATCH, D3D12_ERROR_ADAPTER_NOT_FOUND or corrupted data
+            LOG_INFO_MESSAGE("Pipeline library data is not compatible with the device and will be ignored.");
+            m_pLibraryData.Release();
+        }
+    }
+
+    if (!m_pLibrary)
+    {
+        auto hr = pd3d12Device->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+    }
 }
 
 PipelineStateCacheD3D12Impl::~PipelineStateCacheD3D12Impl()
 {
+    FlushCacheFile();
+
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pLibrary), ~Uint64{0});
 }
@@ -86,6 +128,8 @@ bool PipelineStateCacheD3D12Impl::StorePipeline(const wchar_t* Name, ID3D12Devic
     if ((m_Desc.Mode & PSO_CACHE_MODE_STORE) == 0)
         return false;
 
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+
     auto hr = m_pLibrary->StorePipeline(Name, static_cast<ID3D12PipelineState*>(pPSO));
     if (FAILED(hr))
         LOG_INFO_MESSAGE("Failed to add pipeline to the library");
@@ -98,6 +142,9 @@ void PipelineStateCacheD3D12Impl::GetData(IDataBlob** ppBlob)
     DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
     *ppBlob = nullptr;
 
+    // Prevent pipelines from being added between GetSerializedSize() and Serialize()
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+
     auto pDataBlob = DataBlobImpl::Create(m_pLibrary->GetSerializedSize());
 
     auto hr = m_pLibrary->Serialize(pDataBlob->GetDataPtr(), pDataBlob->GetSize());
@@ -110,4 +157,10 @@ void PipelineStateCacheD3D12Impl::GetData(IDataBlob** ppBlob)
     *ppBlob = pDataBlob.Detach();
 }
 
+Bool PipelineStateCacheD3D12Impl::Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches)
+{
+    LOG_WARNING_MESSAGE("Merging pipeline state caches is not supported in Direct3D12");
+    return False;
+}
+
 } // namespace Diligent
@@ -31,6 +31,7 @@
 #include "PipelineStateCacheD3D12Impl.hpp"
 
 #include <array>
+#include <chrono>
 #include <sstream>
 #include <unordered_map>
 
@@ -48,10 +49,10 @@
 #include "CommandContext.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "CompilationStatisticsImpl.hpp"
 #include "DynamicLinearAllocator.hpp"
 #include "D3DShaderResourceValidation.hpp"
 
-#include "DXBCUtils.hpp"
 #include "DXCompiler.hpp"
 #include "dxc/dxcapi.h"
 
@@ -62,6 +63,23 @@ constexpr INTERFACE_ID PipelineStateD3D12Impl::IID_InternalImpl;
 
 namespace
 {
+
+// Records the result of the pipeline library lookup in the PSO cache statistics and
+// in the compilation record of the pipeline. StartTime is the time when the lookup started.
+void RecordPipelineCacheResult(PipelineStateCacheD3D12Impl*          pPSOCache,
+                               PIPELINE_CACHE_RESULT                 CacheResult,
+                               std::chrono::steady_clock::time_point StartTime)
+{
+    if (pPSOCache != nullptr)
+    {
+        const auto Duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count();
+        pPSOCache->OnPipelineCreated(CacheResult, static_cast<Uint64>(Duration));
+    }
+
+    if (auto* pScope = CompilationRecordScope::GetCurrent())
+        pScope->SetPipelineFeedback(CacheResult, 0);
+}
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4324) //  warning C4324: structure was padded due to alignment specifier
@@ -475,26 +493,14 @@ void PipelineStateD3D12Impl::RemapOrVerifyShaderResources(TShaderStages&
             }
             else
             {
-                auto& pBytecode = ByteCodes[i];
-
-                CComPtr<ID3DBlob> pBlob;
-                if (IsDXILBytecode(pBytecode->GetBufferPointer(), pBytecode->GetBufferSize()))
-                {
-                    if (!pDxCompiler)
-                        LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
+                VERIFY_EXPR(ByteCodes[i] == pShader->GetD3DBytecode());
 
-                    if (!pDxCompiler->RemapResourceBindings(ResourceMap, reinterpret_cast<IDxcBlob*>(pBytecode.p), reinterpret_cast<IDxcBlob**>(&pBlob)))
-                        LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-                }
-                else
-                {
-                    D3DCreateBlob(pBytecode->GetBufferSize(), &pBlob);
-                    memcpy(pBlob->GetBufferPointer(), pBytecode->GetBufferPointer(), pBytecode->GetBufferSize());
+                // The shader caches the binding locations, so the byte code is only parsed once
+                auto pBlob = pShader->GetRemappedBytecode(ResourceMap, pDxCompiler);
+                if (!pBlob)
+                    LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
 
-                    if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBlob->GetBufferPointer(), pBlob->GetBufferSize()))
-                        LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-                }
-                pBytecode = pBlob;
+                ByteCodes[i] = pBlob;
             }
         }
     }
@@ -554,6 +560,17 @@ void PipelineStateD3D12Impl::InitRootSignature(const PipelineStateCreateInfo& Cr
     }
 }
 
+bool PipelineStateD3D12Impl::IsBindlessIndicesBuffer(const char* Name) const
+{
+    for (Uint32 s = 0; s < m_SignatureCount; ++s)
+    {
+        const auto& pSignature = m_Signatures[s];
+        if (pSignature != nullptr && pSignature->HasBindlessResources() && pSignature->GetBindlessIndicesBufferName() == Name)
+            return true;
+    }
+    return false;
+}
+
 void PipelineStateD3D12Impl::ValidateShaderResources(const ShaderD3D12Impl* pShader, const LocalRootSignatureD3D12* pLocalRootSig)
 {
     const auto& pShaderResources = pShader->GetShaderResources();
@@ -581,6 +598,9 @@ void PipelineStateD3D12Impl::ValidateShaderResources(const ShaderD3D12Impl* pSha
             if (IsSampler && pShaderResources->IsUsingCombinedTextureSamplers())
                 return;
 
+            if (Attribs.GetInputType() == D3D_SIT_CBUFFER && IsBindlessIndicesBuffer(Attribs.Name))
+                return;
+
             ResAttribution = GetResourceAttribution(Attribs.Name, ShaderType);
             if (!ResAttribution)
             {
@@ -598,6 +618,13 @@ void PipelineStateD3D12Impl::ValidateShaderResources(const ShaderD3D12Impl* pSha
             if (ResAttribution.ResourceIndex != ResourceAttribution::InvalidResourceIndex)
             {
                 auto ResDesc = pSignature->GetResourceDesc(ResAttribution.ResourceIndex);
+                if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS) != 0)
+                {
+                    LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' declares resource '", Attribs.Name,
+                                        "' that is labeled as BINDLESS in pipeline resource signature '", pSignature->GetDesc().Name,
+                                        "'. Bindless resources must be accessed through ResourceDescriptorHeap[] using the indices from '",
+                                        pSignature->GetBindlessIndicesBufferName(), "' constant buffer.");
+                }
                 if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT)
                     ResDesc.ResourceType = SHADER_RESOURCE_TYPE_TEXTURE_SRV;
                 ValidatePipelineResourceCompatibility(ResDesc, ResType, ResFlags, Attribs.BindCount,
@@ -679,200 +706,213 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        const auto WName = WidenString(m_Desc.Name);
-
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
-
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
-        if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
-        {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
-
-            D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
-
-            for (const auto& Stage : ShaderStages)
-            {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
-
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
-                    case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
-                    case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
-                    case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
-
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
-            }
-
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
-
-            memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
-
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
-            // The sample mask for the blend state.
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
-
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
-
-            std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
-
-            const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
-            if (InputLayout.NumElements > 0)
-            {
-                LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
-                d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
-                d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
-            }
-            else
-            {
-                d3d12PSODesc.InputLayout.NumElements        = 0;
-                d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
-            }
-
-            d3d12PSODesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
-            static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
-            d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
-
-            d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
-                d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
-
-            d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
-
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
-
-            d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
-
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-
-            // Try to load from the cache
-            auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
-            if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(WName.c_str(), d3d12PSODesc);
-            if (!m_pd3d12PSO)
-            {
-                // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-                HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-                if (FAILED(hr))
-                    LOG_ERROR_AND_THROW("Failed to create pipeline state");
-
-                // Add to the cache
-                if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                    pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
-            }
-        }
+        InitializePipeline(CreateInfo,
+                           [this](const GraphicsPipelineStateCreateInfo& CI) //
+                           {
+                               const auto WName = WidenString(m_Desc.Name);
+
+                               TShaderStages ShaderStages;
+                               InitInternalObjects(CI, ShaderStages);
+
+                               auto* pd3d12Device = m_pDevice->GetD3D12Device();
+                               if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
+                               {
+                                   const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+
+                                   D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
+
+                                   for (const auto& Stage : ShaderStages)
+                                   {
+                                       VERIFY_EXPR(Stage.Count() == 1);
+                                       const auto& pByteCode = Stage.ByteCodes[0];
+
+                                       D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+                                       switch (Stage.Type)
+                                       {
+                                               // clang-format off
+                                       case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
+                                       case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                                       case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
+                                       case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
+                                       case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
+                                           // clang-format on
+                                           default: UNEXPECTED("Unexpected shader type");
+                                       }
+
+                                       pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+                                       pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+                                   }
+
+                                   d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+
+                                   memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
+
+                                   BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
+                                   // The sample mask for the blend state.
+                                   d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+
+                                   RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
+                                   DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
+
+                                   std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
+
+                                   const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
+                                   if (InputLayout.NumElements > 0)
+                                   {
+                                       LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
+                                       d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
+                                       d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
+                                   }
+                                   else
+                                   {
+                                       d3d12PSODesc.InputLayout.NumElements        = 0;
+                                       d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
+                                   }
+
+                                   d3d12PSODesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+                                   static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
+                                   d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
+
+                                   d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+                                   for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+                                       d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+                                   for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
+                                       d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
+                                   d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+
+                                   d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
+                                   d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
+
+                                   // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                                   // set bits to identify the nodes (the device's physical adapters) for which the
+                                   // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                                   d3d12PSODesc.NodeMask = 0;
+
+                                   d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+                                   d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+
+                                   // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                                   d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+                                   // Try to load from the cache
+                                   auto* const           pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CI.pPSOCache);
+                                   const auto            StartTime      = std::chrono::steady_clock::now();
+                                   PIPELINE_CACHE_RESULT CacheResult    = PIPELINE_CACHE_RESULT_UNKNOWN;
+                                   if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                                   {
+                                       m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(WName.c_str(), d3d12PSODesc);
+                                       m_pDevice->OnPipelineCacheLookup(m_pd3d12PSO != nullptr);
+                                       CacheResult = m_pd3d12PSO ? PIPELINE_CACHE_RESULT_HIT : PIPELINE_CACHE_RESULT_MISS;
+                                   }
+                                   if (!m_pd3d12PSO)
+                                   {
+                                       CompilationStageTimer DriverTimer{COMPILATION_STAGE_DRIVER};
+                                       // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                                       HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                                       if (FAILED(hr))
+                                           LOG_ERROR_AND_THROW("Failed to create pipeline state");
+
+                                       // Add to the cache
+                                       if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                                           pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
+                                   }
+                                   RecordPipelineCacheResult(pPSOCacheD3D12, CacheResult, StartTime);
+                               }
 #ifdef D3D12_H_HAS_MESH_SHADER
-        else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
-        {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
-
-            struct MESH_SHADER_PIPELINE_STATE_DESC
-            {
-                PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
-                PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
-                PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
-                PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
-                PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
-                PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
-                PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
-                PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
-                PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
-            };
-            MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
-
-            for (const auto& Stage : ShaderStages)
-            {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
-
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
-                    case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
-                    case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
-
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
-            }
-
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
-
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
-
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
-
-            d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
-
-            d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
-
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
-
-            d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
-
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-
-            D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
-            streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
-            streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
-
-            auto* pd3d12Device2 = pDeviceD3D12->GetD3D12Device2();
-            // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-            HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create pipeline state");
-        }
+                               else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
+                               {
+                                   const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+
+                                   struct MESH_SHADER_PIPELINE_STATE_DESC
+                                   {
+                                       PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
+                                       PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
+                                       PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
+                                       PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
+                                       PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
+                                       PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
+                                       PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
+                                       PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
+                                       PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
+                                       PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
+                                       PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
+                                       PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
+                                       PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
+                                       PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
+                                   };
+                                   MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
+
+                                   for (const auto& Stage : ShaderStages)
+                                   {
+                                       VERIFY_EXPR(Stage.Count() == 1);
+                                       const auto& pByteCode = Stage.ByteCodes[0];
+
+                                       D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+                                       switch (Stage.Type)
+                                       {
+                                               // clang-format off
+                                       case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
+                                       case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
+                                       case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                                           // clang-format on
+                                           default: UNEXPECTED("Unexpected shader type");
+                                       }
+
+                                       pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+                                       pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+                                   }
+
+                                   d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+
+                                   BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
+                                   d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+
+                                   RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
+                                   DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
+
+                                   d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+                                   for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+                                       d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+                                   for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
+                                       d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
+                                   d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+
+                                   d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
+                                   d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
+
+                                   // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                                   // set bits to identify the nodes (the device's physical adapters) for which the
+                                   // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                                   d3d12PSODesc.NodeMask = 0;
+
+                                   d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
+                                   d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
+
+                                   // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                                   d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+                                   D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+                                   streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
+                                   streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
+
+                                   auto* pd3d12Device2 = m_pDevice->GetD3D12Device2();
+                                   CompilationStageTimer DriverTimer{COMPILATION_STAGE_DRIVER};
+                                   // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                                   HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                                   if (FAILED(hr))
+                                       LOG_ERROR_AND_THROW("Failed to create pipeline state");
+                               }
 #endif // D3D12_H_HAS_MESH_SHADER
-        else
-        {
-            LOG_ERROR_AND_THROW("Unsupported pipeline type");
-        }
-
-        if (!WName.empty())
-        {
-            m_pd3d12PSO->SetName(WName.c_str());
-        }
+                               else
+                               {
+                                   LOG_ERROR_AND_THROW("Unsupported pipeline type");
+                               }
+
+                               if (!WName.empty())
+                               {
+                                   m_pd3d12PSO->SetName(WName.c_str());
+                               }
+                           });
     }
     catch (...)
     {
@@ -888,53 +928,65 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
-
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
-
-        D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
-
-        VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
-        VERIFY_EXPR(ShaderStages[0].Count() == 1);
-        const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
-        d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
-        d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
-
-        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-        // set bits to identify the nodes (the device's physical adapters) for which the
-        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-        d3d12PSODesc.NodeMask = 0;
-
-        d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-        d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
-
-        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-
-        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
-
-        // Try to load from the cache
-        const auto  WName          = WidenString(m_Desc.Name);
-        auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
-        if (pPSOCacheD3D12 != nullptr && !WName.empty())
-            m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(WName.c_str(), d3d12PSODesc);
-        if (!m_pd3d12PSO)
-        {
-            // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
-            HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create pipeline state");
-
-            // Add to the cache
-            if (pPSOCacheD3D12 != nullptr && !WName.empty())
-                pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
-        }
-
-        if (!WName.empty())
-        {
-            m_pd3d12PSO->SetName(WName.c_str());
-        }
+        InitializePipeline(CreateInfo,
+                           [this](const ComputePipelineStateCreateInfo& CI) //
+                           {
+                               TShaderStages ShaderStages;
+                               InitInternalObjects(CI, ShaderStages);
+
+                               auto* pd3d12Device = m_pDevice->GetD3D12Device();
+
+                               D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
+
+                               VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
+                               VERIFY_EXPR(ShaderStages[0].Count() == 1);
+                               const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
+                               d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
+                               d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
+
+                               // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+                               // set bits to identify the nodes (the device's physical adapters) for which the
+                               // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+                               d3d12PSODesc.NodeMask = 0;
+
+                               d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+                               d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+
+                               // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+                               d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+                               d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+
+                               // Try to load from the cache
+                               const auto            WName          = WidenString(m_Desc.Name);
+                               auto* const           pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CI.pPSOCache);
+                               const auto            StartTime      = std::chrono::steady_clock::now();
+                               PIPELINE_CACHE_RESULT CacheResult    = PIPELINE_CACHE_RESULT_UNKNOWN;
+                               if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                               {
+                                   m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(WName.c_str(), d3d12PSODesc);
+                                   m_pDevice->OnPipelineCacheLookup(m_pd3d12PSO != nullptr);
+                                   CacheResult = m_pd3d12PSO ? PIPELINE_CACHE_RESULT_HIT : PIPELINE_CACHE_RESULT_MISS;
+                               }
+                               if (!m_pd3d12PSO)
+                               {
+                                   CompilationStageTimer DriverTimer{COMPILATION_STAGE_DRIVER};
+                                   // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+                                   HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                                   if (FAILED(hr))
+                                       LOG_ERROR_AND_THROW("Failed to create pipeline state");
+
+                                   // Add to the cache
+                                   if (pPSOCacheD3D12 != nullptr && !WName.empty())
+                                       pPSOCacheD3D12->StorePipeline(WName.c_str(), m_pd3d12PSO);
+                               }
+                               RecordPipelineCacheResult(pPSOCacheD3D12, CacheResult, StartTime);
+
+                               if (!WName.empty())
+                               {
+                                   m_pd3d12PSO->SetName(WName.c_str());
+                               }
+                           });
     }
     catch (...)
     {
@@ -950,40 +1002,159 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        LocalRootSignatureD3D12 LocalRootSig{CreateInfo.pShaderRecordName, CreateInfo.RayTracingPipeline.ShaderRecordSize};
-        TShaderStages           ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages, &LocalRootSig);
-
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device5();
-
-        DynamicLinearAllocator             TempPool{GetRawAllocator(), 4 << 10};
-        std::vector<D3D12_STATE_SUBOBJECT> Subobjects;
-        BuildRTPipelineDescription(CreateInfo, Subobjects, TempPool, ShaderStages);
-
-        D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
-        Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
-
-        D3D12_LOCAL_ROOT_SIGNATURE LocalRoot = {LocalRootSig.GetD3D12RootSignature()};
-        if (LocalRoot.pLocalRootSignature)
-            Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_LOCAL_ROOT_SIGNATURE, &LocalRoot});
-
-        D3D12_STATE_OBJECT_DESC RTPipelineDesc = {};
-        RTPipelineDesc.Type                    = D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE;
-        RTPipelineDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
-        RTPipelineDesc.pSubobjects             = Subobjects.data();
-
-        HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, __uuidof(ID3D12StateObject), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-        if (FAILED(hr))
-            LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
-
-        // Extract shader identifiers from ray tracing pipeline and store them in ShaderHandles
-        GetShaderIdentifiers(m_pd3d12PSO, CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex,
-                             m_pRayTracingPipelineData->ShaderHandles, m_pRayTracingPipelineData->ShaderHandleSize);
+        InitializePipeline(CreateInfo,
+                           [this](const RayTracingPipelineStateCreateInfo& CI) //
+                           {
+                               LocalRootSignatureD3D12 LocalRootSig{CI.pShaderRecordName, CI.RayTracingPipeline.ShaderRecordSize};
+                               TShaderStages           ShaderStages;
+                               InitInternalObjects(CI, ShaderStages, &LocalRootSig);
+
+                               auto* pd3d12Device = m_pDevice->GetD3D12Device5();
+
+                               DynamicLinearAllocatorScope        TempPoolScope;
+                               std::vector<D3D12_STATE_SUBOBJECT> Subobjects;
+                               BuildRTPipelineDescription(CI, Subobjects, TempPoolScope.GetAllocator(), ShaderStages);
+
+                               D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
+                               Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
+
+                               D3D12_LOCAL_ROOT_SIGNATURE LocalRoot = {LocalRootSig.GetD3D12RootSignature()};
+                               if (LocalRoot.pLocalRootSignature)
+                                   Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_LOCAL_ROOT_SIGNATURE, &LocalRoot});
+
+                               D3D12_STATE_OBJECT_DESC RTPipelineDesc = {};
+                               RTPipelineDesc.Type                    = D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE;
+                               RTPipelineDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
+                               RTPipelineDesc.pSubobjects             = Subobjects.data();
+
+                               CompilationStageTimer DriverTimer{COMPILATION_STAGE_DRIVER};
+                               HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, __uuidof(ID3D12StateObject), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                               if (FAILED(hr))
+                                   LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
+
+                               // Extract shader identifiers from ray tracing pipeline and store them in ShaderHandles
+                               GetShaderIdentifiers(m_pd3d12PSO, CI, m_pRayTracingPipelineData->NameToGroupIndex,
+                                                    m_pRayTracingPipelineData->ShaderHandles, m_pRayTracingPipelineData->ShaderHandleSize);
+
+                               if (*m_Desc.Name != 0)
+                               {
+                                   m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
+                               }
+                           });
+    }
+    catch (...)
+    {
+        Destruct();
+        throw;
+    }
+}
 
-        if (*m_Desc.Name != 0)
-        {
-            m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
-        }
+PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*                     pRefCounters,
+                                               RenderDeviceD3D12Impl*                  pDeviceD3D12,
+                                               const WorkGraphPipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pDeviceD3D12, CreateInfo}
+{
+    try
+    {
+        InitializePipeline(CreateInfo,
+                           [this](const WorkGraphPipelineStateCreateInfo& CI) //
+                           {
+#ifdef D3D12_H_HAS_WORK_GRAPHS
+                               TShaderStages ShaderStages;
+                               InitInternalObjects(CI, ShaderStages);
+                               VERIFY_EXPR(ShaderStages.size() == 1);
+
+                               auto* pd3d12Device = m_pDevice->GetD3D12Device5();
+
+                               std::vector<D3D12_DXIL_LIBRARY_DESC> Libraries;
+                               std::vector<D3D12_STATE_SUBOBJECT>   Subobjects;
+                               Libraries.reserve(ShaderStages[0].ByteCodes.size());
+                               for (const auto& pByteCode : ShaderStages[0].ByteCodes)
+                               {
+                                   D3D12_DXIL_LIBRARY_DESC LibDesc{};
+                                   LibDesc.DXILLibrary.pShaderBytecode = pByteCode->GetBufferPointer();
+                                   LibDesc.DXILLibrary.BytecodeLength  = pByteCode->GetBufferSize();
+                                   // Export all symbols from the library
+                                   LibDesc.NumExports = 0;
+                                   LibDesc.pExports   = nullptr;
+                                   Libraries.push_back(LibDesc);
+                                   Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_DXIL_LIBRARY, &Libraries.back()});
+                               }
+
+                               D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
+                               Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
+
+                               const std::wstring ProgramName = WidenString(GetWorkGraphProgramName());
+
+                               D3D12_WORK_GRAPH_DESC WorkGraphDesc{};
+                               WorkGraphDesc.ProgramName = ProgramName.c_str();
+                               WorkGraphDesc.Flags       = D3D12_WORK_GRAPH_FLAG_INCLUDE_ALL_AVAILABLE_NODES;
+                               Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_WORK_GRAPH, &WorkGraphDesc});
+
+                               D3D12_STATE_OBJECT_DESC StateObjDesc = {};
+                               StateObjDesc.Type                    = D3D12_STATE_OBJECT_TYPE_EXECUTABLE;
+                               StateObjDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
+                               StateObjDesc.pSubobjects             = Subobjects.data();
+
+                               CompilationStageTimer DriverTimer{COMPILATION_STAGE_DRIVER};
+                               HRESULT hr = pd3d12Device->CreateStateObject(&StateObjDesc, __uuidof(ID3D12StateObject), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+                               if (FAILED(hr))
+                                   LOG_ERROR_AND_THROW("Failed to create work graph state object");
+
+                               CComPtr<ID3D12StateObjectProperties1> pStateObjectProperties;
+                               hr = m_pd3d12PSO->QueryInterface(IID_PPV_ARGS(&pStateObjectProperties));
+                               if (FAILED(hr))
+                                   LOG_ERROR_AND_THROW("Failed to get state object properties");
+
+                               CComPtr<ID3D12WorkGraphProperties> pWorkGraphProperties;
+                               hr = m_pd3d12PSO->QueryInterface(IID_PPV_ARGS(&pWorkGraphProperties));
+                               if (FAILED(hr))
+                                   LOG_ERROR_AND_THROW("Failed to get work graph properties");
+
+                               m_pWorkGraph            = std::make_unique<WorkGraphProgramInfo>();
+                               m_pWorkGraph->ProgramId = pStateObjectProperties->GetProgramIdentifier(ProgramName.c_str());
+
+                               const UINT WorkGraphIndex = pWorkGraphProperties->GetWorkGraphIndex(ProgramName.c_str());
+                               if (WorkGraphIndex == ~0u)
+                                   LOG_ERROR_AND_THROW("Work graph program '", GetWorkGraphProgramName(), "' is not found in the state object");
+
+                               const UINT NumEntryPoints = pWorkGraphProperties->GetNumEntrypoints(WorkGraphIndex);
+                               m_pWorkGraph->EntryPoints.reserve(NumEntryPoints);
+                               for (UINT i = 0; i < NumEntryPoints; ++i)
+                               {
+                                   const D3D12_NODE_ID NodeId = pWorkGraphProperties->GetEntrypointID(WorkGraphIndex, i);
+                                   m_pWorkGraph->EntryPoints.emplace_back(NodeId.Name != nullptr ? NarrowString(NodeId.Name) : std::string{}, NodeId.ArrayIndex);
+                               }
+
+                               D3D12_WORK_GRAPH_MEMORY_REQUIREMENTS MemReqs{};
+                               pWorkGraphProperties->GetWorkGraphMemoryRequirements(WorkGraphIndex, &MemReqs);
+                               m_pWorkGraph->MinBackingMemorySize = MemReqs.MinSizeInBytes;
+
+                               if (MemReqs.MaxSizeInBytes > 0)
+                               {
+                                   const std::string BuffName = std::string{m_Desc.Name} + " - work graph backing memory";
+
+                                   BufferDesc BuffDesc;
+                                   BuffDesc.Name                 = BuffName.c_str();
+                                   BuffDesc.Size                 = MemReqs.MaxSizeInBytes;
+                                   BuffDesc.Usage                = USAGE_DEFAULT;
+                                   BuffDesc.BindFlags            = BIND_UNORDERED_ACCESS;
+                                   BuffDesc.Mode                 = BUFFER_MODE_RAW;
+                                   BuffDesc.ImmediateContextMask = m_Desc.ImmediateContextMask;
+                                   GetDevice()->CreateBuffer(BuffDesc, nullptr, &m_pWorkGraph->pBackingMemory);
+                                   if (!m_pWorkGraph->pBackingMemory)
+                                       LOG_ERROR_AND_THROW("Failed to create work graph backing memory buffer");
+                               }
+
+                               if (*m_Desc.Name != 0)
+                               {
+                                   m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
+                               }
+#else
+                (void)CI;
+                LOG_ERROR_AND_THROW("Work graphs are not supported by the Direct3D12 headers the engine was built with");
+#endif
+                           });
     }
     catch (...)
     {
@@ -999,7 +1170,10 @@ PipelineStateD3D12Impl::~PipelineStateD3D12Impl()
 
 void PipelineStateD3D12Impl::Destruct()
 {
+    FinishAsyncInitialization();
+
     m_RootSig.Release();
+    m_pWorkGraph.reset();
 
     if (m_pd3d12PSO)
     {
@@ -1010,6 +1184,20 @@ void PipelineStateD3D12Impl::Destruct()
     TPipelineStateBase::Destruct();
 }
 
+Uint32 PipelineStateD3D12Impl::GetWorkGraphEntryPointIndex(const char* Name, Uint32 ArrayIndex) const
+{
+    const auto& EntryPoints = GetWorkGraphProgramInfo().EntryPoints;
+    if (Name == nullptr)
+        return !EntryPoints.empty() ? 0 : ~0u;
+
+    for (size_t i = 0; i < EntryPoints.size(); ++i)
+    {
+        if (EntryPoints[i].first == Name && EntryPoints[i].second == ArrayIndex)
+            return static_cast<Uint32>(i);
+    }
+    return ~0u;
+}
+
 bool PipelineStateD3D12Impl::IsCompatibleWith(const IPipelineState* pPSO) const
 {
     DEV_CHECK_ERR(pPSO != nullptr, "pPSO must not be null");
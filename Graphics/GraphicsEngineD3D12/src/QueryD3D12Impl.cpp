@@ -29,6 +29,8 @@
 
 #include "QueryD3D12Impl.hpp"
 
+#include <algorithm>
+
 #include "WinHPreface.h"
 #include <atlbase.h>
 #include "WinHPostface.h"
@@ -123,14 +125,37 @@ bool QueryD3D12Impl::OnEndQuery(DeviceContextD3D12Impl* pContext)
     return true;
 }
 
+bool QueryD3D12Impl::IsEndFenceCompleted() const
+{
+    VERIFY_EXPR(m_pQueryMgr != nullptr);
+    return m_pDevice->GetCompletedFenceValue(m_pQueryMgr->GetCommandQueueId()) >= m_QueryEndFenceValue;
+}
+
+void QueryD3D12Impl::GetResolveBufferRange(Uint64& Begin, Uint64& End) const
+{
+    VERIFY_EXPR(m_pQueryMgr != nullptr);
+    m_pQueryMgr->GetResolveBufferRange(m_Desc.Type, m_QueryHeapIndex[0], Begin, End);
+    if (m_Desc.Type == QUERY_TYPE_DURATION)
+    {
+        Uint64 EndQueryBegin = 0, EndQueryEnd = 0;
+        m_pQueryMgr->GetResolveBufferRange(m_Desc.Type, m_QueryHeapIndex[1], EndQueryBegin, EndQueryEnd);
+        Begin = std::min(Begin, EndQueryBegin);
+        End   = std::max(End, EndQueryEnd);
+    }
+}
+
 bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
+{
+    return GetData(pData, DataSize, AutoInvalidate, nullptr);
+}
+
+bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate, const Uint8* pMappedResolveBuffer)
 {
     TQueryBase::CheckQueryDataPtr(pData, DataSize);
 
     VERIFY_EXPR(m_pQueryMgr != nullptr);
-    auto CmdQueueId          = m_pQueryMgr->GetCommandQueueId();
-    auto CompletedFenceValue = m_pDevice->GetCompletedFenceValue(CmdQueueId);
-    if (CompletedFenceValue >= m_QueryEndFenceValue)
+    auto CmdQueueId = m_pQueryMgr->GetCommandQueueId();
+    if (IsEndFenceCompleted())
     {
         auto GetTimestampFrequency = [this](SoftwareQueueIndex CmdQueueId) //
         {
@@ -148,7 +173,7 @@ bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
             case QUERY_TYPE_OCCLUSION:
             {
                 UINT64 NumSamples;
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &NumSamples, sizeof(NumSamples));
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &NumSamples, sizeof(NumSamples), pMappedResolveBuffer);
                 if (pData != nullptr)
                 {
                     auto& QueryData      = *reinterpret_cast<QueryDataOcclusion*>(pData);
@@ -160,7 +185,7 @@ bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
             case QUERY_TYPE_BINARY_OCCLUSION:
             {
                 UINT64 AnySamplePassed;
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &AnySamplePassed, sizeof(AnySamplePassed));
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &AnySamplePassed, sizeof(AnySamplePassed), pMappedResolveBuffer);
                 if (pData != nullptr)
                 {
                     auto& QueryData = *reinterpret_cast<QueryDataBinaryOcclusion*>(pData);
@@ -174,7 +199,7 @@ bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
             case QUERY_TYPE_TIMESTAMP:
             {
                 UINT64 Counter;
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &Counter, sizeof(Counter));
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &Counter, sizeof(Counter), pMappedResolveBuffer);
                 if (pData != nullptr)
                 {
                     auto& QueryData     = *reinterpret_cast<QueryDataTimestamp*>(pData);
@@ -187,7 +212,7 @@ bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
             case QUERY_TYPE_PIPELINE_STATISTICS:
             {
                 D3D12_QUERY_DATA_PIPELINE_STATISTICS d3d12QueryData;
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &d3d12QueryData, sizeof(d3d12QueryData));
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &d3d12QueryData, sizeof(d3d12QueryData), pMappedResolveBuffer);
                 if (pData != nullptr)
                 {
                     auto& QueryData = *reinterpret_cast<QueryDataPipelineStatistics*>(pData);
@@ -210,8 +235,8 @@ bool QueryD3D12Impl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
             case QUERY_TYPE_DURATION:
             {
                 UINT64 StartCounter, EndCounter;
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &StartCounter, sizeof(StartCounter));
-                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[1], &EndCounter, sizeof(EndCounter));
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[0], &StartCounter, sizeof(StartCounter), pMappedResolveBuffer);
+                m_pQueryMgr->ReadQueryData(m_Desc.Type, m_QueryHeapIndex[1], &EndCounter, sizeof(EndCounter), pMappedResolveBuffer);
                 if (pData != nullptr)
                 {
                     auto& QueryData     = *reinterpret_cast<QueryDataDuration*>(pData);
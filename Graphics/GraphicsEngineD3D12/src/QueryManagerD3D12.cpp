@@ -81,6 +81,8 @@ void QueryManagerD3D12::QueryHeapInfo::Init(ID3D12Device*                pd3d12D
     // AlignedDestinationBufferOffset must be a multiple of 8 bytes.
     // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
     m_AlignedQueryDataSize    = AlignUp(GetQueryDataSize(QueryType), Uint32{8});
+    // Batched resolves require that the data of contiguous queries is tightly packed.
+    VERIFY_EXPR(m_AlignedQueryDataSize == GetQueryDataSize(QueryType));
     m_ResolveBufferBaseOffset = CurrResolveBufferOffset;
     CurrResolveBufferOffset += m_AlignedQueryDataSize * m_QueryCount;
 
@@ -209,6 +211,9 @@ QueryManagerD3D12::QueryManagerD3D12(RenderDeviceD3D12Impl* pDeviceD3D12Impl,
                                                         reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12ResolveBuffer)));
         if (FAILED(hr))
             LOG_ERROR_AND_THROW("Failed to create D3D12 resolve buffer");
+
+        m_ResolveBufferMemoryRecord = GPUMemoryRecord{pDeviceD3D12Impl->GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_QUERY, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                                      "Query resolve buffer", D3D12BuffDesc.Width, AlignUp(D3D12BuffDesc.Width, Uint64{D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT})};
     }
 }
 
@@ -260,27 +265,83 @@ void QueryManagerD3D12::EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 In
 
     VERIFY(Index < HeapInfo.GetQueryCount(), "Query index ", Index, " is out of range");
     Ctx.EndQuery(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, Index);
+}
 
-    // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
-    Ctx.ResolveQueryData(HeapInfo.GetD3D12QueryHeap(), d3d12QueryType, Index, 1, m_pd3d12ResolveBuffer, HeapInfo.GetResolveBufferOffset(Index));
+Uint32 QueryManagerD3D12::ResolveQueries(CommandContext& Ctx, std::vector<PendingResolve>& Queries) const
+{
+    if (Queries.empty())
+        return 0;
+
+    // The same query may have been ended multiple times
+    std::sort(Queries.begin(), Queries.end());
+    Queries.erase(std::unique(Queries.begin(), Queries.end()), Queries.end());
+
+    Uint32 NumCommands = 0;
+    for (size_t i = 0; i < Queries.size();)
+    {
+        const auto  Type       = Queries[i].Type;
+        const auto  StartIndex = Queries[i].Index;
+        const auto& HeapInfo   = m_Heaps[Type];
+        VERIFY_EXPR(HeapInfo.GetType() == Type);
+        VERIFY(StartIndex < HeapInfo.GetQueryCount(), "Query index ", StartIndex, " is out of range");
+
+        Uint32 NumQueries = 1;
+        while (i + NumQueries < Queries.size() && Queries[i + NumQueries].Type == Type && Queries[i + NumQueries].Index == StartIndex + NumQueries)
+            ++NumQueries;
+
+        // The data of queries with contiguous indices is tightly packed in the resolve buffer.
+        // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
+        Ctx.ResolveQueryData(HeapInfo.GetD3D12QueryHeap(), QueryTypeToD3D12QueryType(Type), StartIndex, NumQueries,
+                             m_pd3d12ResolveBuffer, HeapInfo.GetResolveBufferOffset(StartIndex));
+        ++NumCommands;
+
+        i += NumQueries;
+    }
+    Queries.clear();
+
+    return NumCommands;
 }
 
-void QueryManagerD3D12::ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const
+void QueryManagerD3D12::GetResolveBufferRange(QUERY_TYPE Type, Uint32 Index, Uint64& Begin, Uint64& End) const
 {
     const auto& HeapInfo = m_Heaps[Type];
     VERIFY_EXPR(HeapInfo.GetType() == Type);
-    const auto QueryDataSize = GetQueryDataSize(Type);
-    VERIFY_EXPR(QueryDataSize == DataSize);
-    const auto  Offset = HeapInfo.GetResolveBufferOffset(Index);
+    Begin = HeapInfo.GetResolveBufferOffset(Index);
+    End   = Begin + GetQueryDataSize(Type);
+}
+
+const Uint8* QueryManagerD3D12::MapResolveBuffer(Uint64 Begin, Uint64 End) const
+{
+    VERIFY_EXPR(Begin <= End);
     D3D12_RANGE ReadRange;
-    ReadRange.Begin = Offset;
-    ReadRange.End   = SIZE_T{Offset} + SIZE_T{QueryDataSize};
+    ReadRange.Begin = StaticCast<SIZE_T>(Begin);
+    ReadRange.End   = StaticCast<SIZE_T>(End);
 
     void* pBufferData = nullptr;
     // The pointer returned by Map is never offset by any values in pReadRange.
     m_pd3d12ResolveBuffer->Map(0, &ReadRange, &pBufferData);
-    memcpy(pDataPtr, reinterpret_cast<const Uint8*>(pBufferData) + Offset, QueryDataSize);
-    m_pd3d12ResolveBuffer->Unmap(0, nullptr);
+    return static_cast<const Uint8*>(pBufferData);
+}
+
+void QueryManagerD3D12::UnmapResolveBuffer() const
+{
+    // Empty written range indicates that the CPU did not write any data.
+    D3D12_RANGE WrittenRange{0, 0};
+    m_pd3d12ResolveBuffer->Unmap(0, &WrittenRange);
+}
+
+void QueryManagerD3D12::ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize, const Uint8* pMappedData) const
+{
+    const auto QueryDataSize = GetQueryDataSize(Type);
+    VERIFY_EXPR(QueryDataSize == DataSize);
+
+    Uint64 Begin = 0, End = 0;
+    GetResolveBufferRange(Type, Index, Begin, End);
+
+    const Uint8* pBufferData = pMappedData != nullptr ? pMappedData : MapResolveBuffer(Begin, End);
+    memcpy(pDataPtr, pBufferData + Begin, QueryDataSize);
+    if (pMappedData == nullptr)
+        UnmapResolveBuffer();
 }
 
 } // namespace Diligent
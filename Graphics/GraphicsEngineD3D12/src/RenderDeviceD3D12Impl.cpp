@@ -43,6 +43,7 @@
 #include "ShaderResourceBindingD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
 #include "FenceD3D12Impl.hpp"
+#include "FenceCompletionWaiterD3D12.hpp"
 #include "QueryD3D12Impl.hpp"
 #include "RenderPassD3D12Impl.hpp"
 #include "FramebufferD3D12Impl.hpp"
@@ -54,6 +55,7 @@
 #include "PipelineResourceSignatureD3D12Impl.hpp"
 
 #include "EngineMemory.h"
+#include "DynamicLinearAllocator.hpp"
 #include "D3D12TypeConversions.hpp"
 #include "DXGITypeConversions.hpp"
 #include "QueryManagerD3D12.hpp"
@@ -162,7 +164,8 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
     },
     m_ContextPool           (STD_ALLOCATOR_RAW_MEM(PooledCommandContext, GetRawAllocator(), "Allocator for vector<PooledCommandContext>")),
     m_DynamicMemoryManager  {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
-    m_MipsGenerator         {pd3d12Device},
+    m_MemoryMgr             {GetRawAllocator(), pd3d12Device, EngineCI.PlacedResourceHeapSize, EngineCI.PlacedResourceHeapSize, GetGPUMemoryTracker()},
+    m_MipsGenerator         {pd3d12Device, CommandQueueCount},
     m_pDxCompiler           {CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath)},
     m_RootSignatureAllocator{GetRawAllocator(), sizeof(RootSignatureD3D12), 128},
     m_RootSignatureCache    {*this}
@@ -170,6 +173,9 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
 {
     m_DeviceInfo.Type = RENDER_DEVICE_TYPE_D3D12;
 
+    if (EngineCI.AsyncShaderCompilerLoad && m_pDxCompiler)
+        m_pDxCompiler->LoadAsync();
+
     try
     {
         // Enable requested device features
@@ -196,6 +202,9 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
             // Header may not have constants for D3D_SHADER_MODEL_6_1 and above.
             const D3D_SHADER_MODEL Models[] = //
                 {
+                    static_cast<D3D_SHADER_MODEL>(0x68), // minimum required for work graphs
+                    static_cast<D3D_SHADER_MODEL>(0x67),
+                    static_cast<D3D_SHADER_MODEL>(0x66), // minimum required for ResourceDescriptorHeap
                     static_cast<D3D_SHADER_MODEL>(0x65), // minimum required for mesh shader and DXR 1.1
                     static_cast<D3D_SHADER_MODEL>(0x64),
                     static_cast<D3D_SHADER_MODEL>(0x63), // minimum required for DXR 1.0
@@ -252,6 +261,49 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
                 m_IsPSOCacheSupported = (ShaderCacheFeature.SupportFlags & D3D12_SHADER_CACHE_SUPPORT_LIBRARY) != 0;
             }
         }
+
+        // Check bindless resources support
+        {
+            D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Features{};
+            if (SUCCEEDED(m_pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Features, sizeof(d3d12Features))))
+            {
+                m_BindlessResourcesSupported =
+                    d3d12Features.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_3 &&
+                    m_MaxShaderVersion >= ShaderVersion{6, 6};
+            }
+        }
+
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        // Check enhanced barriers support
+        {
+            D3D12_FEATURE_DATA_D3D12_OPTIONS12 d3d12Features12{};
+            if (SUCCEEDED(m_pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &d3d12Features12, sizeof(d3d12Features12))))
+            {
+                m_EnhancedBarriersSupported = d3d12Features12.EnhancedBarriersSupported != FALSE;
+                if (m_EnhancedBarriersSupported)
+                    LOG_INFO_MESSAGE("Enhanced barriers are supported and will be used for resource state transitions");
+            }
+        }
+#endif
+
+        if (EngineCI.ResidencyBudgetFraction > 0)
+        {
+            auto BudgetFraction = EngineCI.ResidencyBudgetFraction;
+            if (BudgetFraction > 1)
+            {
+                LOG_WARNING_MESSAGE("Residency budget fraction (", BudgetFraction, ") must not exceed 1.");
+                BudgetFraction = 1;
+            }
+            m_pResidencyMgr = std::make_unique<ResidencyManagerD3D12>(*this, BudgetFraction);
+        }
+
+        m_pFenceCompletionWaiter = std::make_unique<FenceCompletionWaiterD3D12>();
+
+        if (EngineCI.pRootSignatureCacheData != nullptr)
+        {
+            const auto NumRootSigs = m_RootSignatureCache.PrecreateRootSignatures(EngineCI.pRootSignatureCacheData, EngineCI.RootSignatureCacheDataSize, GetShaderCompilationThreadPool());
+            LOG_INFO_MESSAGE("Pre-created ", NumRootSigs, " root signature(s) from the root signature cache data");
+        }
     }
     catch (...)
     {
@@ -311,6 +363,8 @@ void RenderDeviceD3D12Impl::DisposeCommandContext(PooledCommandContext&& Ctx)
 
 void RenderDeviceD3D12Impl::FreeCommandContext(PooledCommandContext&& Ctx)
 {
+    Ctx->GetResidencySet().Clear();
+
     std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
     m_ContextPool.emplace_back(std::move(Ctx));
 #ifdef DILIGENT_DEVELOPMENT
@@ -346,11 +400,13 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
 {
     VERIFY_EXPR(NumContexts > 0 && pContexts != 0);
 
-    // TODO: use small_vector
-    std::vector<ID3D12CommandList*>              d3d12CmdLists;
-    std::vector<CComPtr<ID3D12CommandAllocator>> CmdAllocators;
-    d3d12CmdLists.reserve(NumContexts);
-    CmdAllocators.reserve(NumContexts);
+    // Temporary arrays are allocated from the thread-local scratch arena as the method
+    // may be called by multiple threads.
+    DynamicLinearAllocatorScope ScratchScope;
+    DynamicLinearAllocator&     ScratchAllocator = ScratchScope.GetAllocator();
+
+    auto* d3d12CmdLists = ScratchAllocator.Allocate<ID3D12CommandList*>(NumContexts);
+    auto* CmdAllocators = ScratchAllocator.ConstructArray<CComPtr<ID3D12CommandAllocator>>(NumContexts);
 
     auto& CmdListMngr = GetCmdListManager(CommandQueueId);
     for (Uint32 i = 0; i < NumContexts; ++i)
@@ -358,9 +414,7 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
         auto& pCtx = pContexts[i];
         VERIFY_EXPR(pCtx);
         VERIFY_EXPR(CmdListMngr.GetCommandListType() == pCtx->GetCommandListType());
-        CComPtr<ID3D12CommandAllocator> pAllocator;
-        d3d12CmdLists.emplace_back(pCtx->Close(pAllocator));
-        CmdAllocators.emplace_back(std::move(pAllocator));
+        d3d12CmdLists[i] = pCtx->Close(CmdAllocators[i]);
     }
 
     Uint64 FenceValue = 0;
@@ -385,16 +439,43 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
         //                  |     with number N                      |                                   |
         if (pWaitFences != nullptr)
             WaitFences(CommandQueueId, *pWaitFences);
-        auto SubmittedCmdBuffInfo = TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, NumContexts, d3d12CmdLists.data());
-        FenceValue                = SubmittedCmdBuffInfo.FenceValue;
+        const auto SubmitCmdLists = [&]() {
+            return TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, NumContexts, d3d12CmdLists).FenceValue;
+        };
+        if (m_pResidencyMgr)
+        {
+            // Make the resources referenced by the command lists resident before they are executed
+            auto* ResidencySets = ScratchAllocator.Allocate<ResidencyManagerD3D12::ResidencySet*>(NumContexts);
+            for (Uint32 i = 0; i < NumContexts; ++i)
+                ResidencySets[i] = &pContexts[i]->GetResidencySet();
+            FenceValue = m_pResidencyMgr->Submit(CommandQueueId, ResidencySets, NumContexts, SubmitCmdLists);
+        }
+        else
+        {
+            FenceValue = SubmitCmdLists();
+        }
         if (pSignalFences != nullptr)
             SignalFences(CommandQueueId, *pSignalFences);
     }
 
+    // Return allocators and contexts of the whole batch under a single lock each
+    CmdListMngr.ReleaseAllocators(CmdAllocators, NumContexts, CommandQueueId, FenceValue);
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
-        CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue);
-        FreeCommandContext(std::move(pContexts[i]));
+        VERIFY(!CmdAllocators[i], "All allocators must be moved to the release queue");
+        CmdAllocators[i].~CComPtr<ID3D12CommandAllocator>();
+    }
+    // Release references to the resources used by the command lists. This must be done
+    // outside of the residency manager lock as the resources may be destroyed.
+    for (Uint32 i = 0; i < NumContexts; ++i)
+        pContexts[i]->GetResidencySet().Clear();
+    {
+        std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
+        for (Uint32 i = 0; i < NumContexts; ++i)
+            m_ContextPool.emplace_back(std::move(pContexts[i]));
+#ifdef DILIGENT_DEVELOPMENT
+        m_AllocatedCtxCounter.fetch_add(-static_cast<Int32>(NumContexts));
+#endif
     }
 
     PurgeReleaseQueue(CommandQueueId);
@@ -442,25 +523,34 @@ void RenderDeviceD3D12Impl::FlushStaleResources(SoftwareQueueIndex CommandQueueI
 void RenderDeviceD3D12Impl::ReleaseStaleResources(bool ForceRelease)
 {
     PurgeReleaseQueues(ForceRelease);
+    m_MemoryMgr.ShrinkMemory();
 }
 
 
 RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateCommandContext(SoftwareQueueIndex CommandQueueId, const Char* ID)
 {
     auto& CmdListMngr = GetCmdListManager(CommandQueueId);
+
+    PooledCommandContext Ctx;
     {
         std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
         if (!m_ContextPool.empty())
         {
-            PooledCommandContext Ctx = std::move(m_ContextPool.back());
+            Ctx = std::move(m_ContextPool.back());
             m_ContextPool.pop_back();
-            Ctx->Reset(CmdListMngr);
-            Ctx->SetID(ID);
+        }
+    }
+
+    if (Ctx)
+    {
+        // Requesting an allocator and resetting the command list is done outside of the
+        // pool lock so that contexts recording on other threads are not blocked.
+        Ctx->Reset(CmdListMngr);
+        Ctx->SetID(ID);
 #ifdef DILIGENT_DEVELOPMENT
-            m_AllocatedCtxCounter.fetch_add(1);
+        m_AllocatedCtxCounter.fetch_add(1);
 #endif
-            return Ctx;
-        }
+        return Ctx;
     }
 
     auto& CmdCtxAllocator = GetRawAllocator();
@@ -527,6 +617,11 @@ void RenderDeviceD3D12Impl::CreateGraphicsPipelineState(const GraphicsPipelineSt
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
+void RenderDeviceD3D12Impl::CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
+{
+    CreateDerivedGraphicsPipelineStateImpl(CreateInfo, ppPipelineState);
+}
+
 void RenderDeviceD3D12Impl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
@@ -537,6 +632,11 @@ void RenderDeviceD3D12Impl::CreateRayTracingPipelineState(const RayTracingPipeli
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
+void RenderDeviceD3D12Impl::CreateWorkGraphPipelineState(const WorkGraphPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
+}
+
 void RenderDeviceD3D12Impl::CreateBufferFromD3DResource(ID3D12Resource* pd3d12Buffer, const BufferDesc& BuffDesc, RESOURCE_STATE InitialState, IBuffer** ppBuffer)
 {
     CreateBufferImpl(ppBuffer, BuffDesc, InitialState, pd3d12Buffer);
@@ -663,16 +763,53 @@ void RenderDeviceD3D12Impl::CreatePipelineResourceSignature(const PipelineResour
 
 DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count /*= 1*/)
 {
+    MetricTimerScope MetricScope{GetMetric(DEVICE_METRIC_DESCRIPTOR_ALLOCATION)};
+
     VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES, "Invalid heap type");
+    OnDescriptorsAllocated(Count);
     return m_CPUDescriptorHeaps[Type].Allocate(Count);
 }
 
 DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateGPUDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count /*= 1*/)
 {
+    MetricTimerScope MetricScope{GetMetric(DEVICE_METRIC_DESCRIPTOR_ALLOCATION)};
+
     VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type <= D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, "Invalid heap type");
     return m_GPUDescriptorHeaps[Type].Allocate(Count);
 }
 
+Uint32 RenderDeviceD3D12Impl::CreateBindlessDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE d3d12CPUDescriptor, DescriptorHeapAllocation& Slot, std::atomic<Uint32>& Index)
+{
+    std::lock_guard<std::mutex> Lock{m_BindlessDescriptorsMtx};
+
+    // Another thread may have created the descriptor while we were waiting for the lock
+    auto SlotIndex = Index.load(std::memory_order_relaxed);
+    if (SlotIndex != GPUDescriptorHeap::InvalidDescriptorIndex)
+        return SlotIndex;
+
+    auto& GPUHeap = m_GPUDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
+
+    Slot = GPUHeap.Allocate(1);
+    if (Slot.IsNull())
+    {
+        LOG_ERROR_MESSAGE("Failed to allocate a bindless descriptor: the shader-visible CBV/SRV/UAV heap is full. "
+                          "Increase GPUDescriptorHeapSize[0] in EngineD3D12CreateInfo.");
+        return GPUDescriptorHeap::InvalidDescriptorIndex;
+    }
+
+    m_pd3d12Device->CopyDescriptorsSimple(1, Slot.GetCpuHandle(), d3d12CPUDescriptor, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    SlotIndex = GPUHeap.GetDescriptorIndex(Slot);
+    Index.store(SlotIndex, std::memory_order_release);
+
+    return SlotIndex;
+}
+
+void RenderDeviceD3D12Impl::GetRootSignatureCacheData(IDataBlob** ppData)
+{
+    m_RootSignatureCache.SerializeBlobs(ppData);
+}
+
 void RenderDeviceD3D12Impl::CreateRootSignature(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig)
 {
     RootSignatureD3D12* pRootSigD3D12{NEW_RC_OBJ(m_RootSignatureAllocator, "RootSignatureD3D12 instance", RootSignatureD3D12)(this, ppSignatures, SignatureCount, Hash)};
@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "ResidencyManagerD3D12.hpp"
+
+#include <dxgi1_4.h>
+
+#include "RenderDeviceD3D12Impl.hpp"
+
+namespace Diligent
+{
+
+ResidencyManagerD3D12::Handle::~Handle()
+{
+    // Resource destructors unregister the handle explicitly, but the constructor may throw an exception
+    Unregister();
+}
+
+void ResidencyManagerD3D12::Handle::Unregister()
+{
+    if (m_pMgr == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_pMgr->m_Mtx};
+        if (m_IsInList)
+            m_pMgr->RemoveFromList(*this);
+    }
+    m_pMgr           = nullptr;
+    m_pd3d12Pageable = nullptr;
+}
+
+void ResidencyManagerD3D12::ResidencySet::Reset(ResidencyManagerD3D12* pMgr)
+{
+    m_Entries.clear();
+    m_Tag = pMgr != nullptr ? pMgr->GetNextSetTag() : 0;
+}
+
+ResidencyManagerD3D12::ResidencyManagerD3D12(RenderDeviceD3D12Impl& DeviceD3D12Impl, Float32 BudgetFraction) :
+    m_DeviceD3D12Impl{DeviceD3D12Impl},
+    m_BudgetFraction{BudgetFraction}
+{
+    auto* pd3d12Device = DeviceD3D12Impl.GetD3D12Device();
+
+    CComPtr<IDXGIFactory4> pFactory;
+    if (SUCCEEDED(CreateDXGIFactory1(__uuidof(pFactory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&pFactory)))))
+    {
+        pFactory->EnumAdapterByLuid(pd3d12Device->GetAdapterLuid(), __uuidof(m_pAdapter), reinterpret_cast<void**>(static_cast<IDXGIAdapter3**>(&m_pAdapter)));
+    }
+
+    if (!m_pAdapter)
+        LOG_WARNING_MESSAGE("Failed to query IDXGIAdapter3 interface. Video memory budget is unknown and resources will not be evicted.");
+}
+
+ResidencyManagerD3D12::~ResidencyManagerD3D12()
+{
+    VERIFY(m_pListHead == nullptr, "All resources must have been unregistered");
+}
+
+void ResidencyManagerD3D12::Register(Handle& ResHandle, ID3D12Resource* pd3d12Resource)
+{
+    VERIFY(!ResHandle.IsRegistered(), "The resource is already registered");
+    VERIFY_EXPR(pd3d12Resource != nullptr);
+
+    const auto d3d12Desc = pd3d12Resource->GetDesc();
+    const auto AllocInfo = m_DeviceD3D12Impl.GetD3D12Device()->GetResourceAllocationInfo(0, 1, &d3d12Desc);
+
+    // The handle is not added to the list until the resource is referenced by a submission,
+    // so that the resource can't be evicted while it is being initialized.
+    ResHandle.m_pd3d12Pageable = pd3d12Resource;
+    ResHandle.m_Size           = AllocInfo.SizeInBytes;
+    ResHandle.m_IsResident     = true;
+    ResHandle.m_pMgr           = this;
+}
+
+void ResidencyManagerD3D12::AddToList(Handle& ResHandle)
+{
+    VERIFY_EXPR(!ResHandle.m_IsInList);
+    ResHandle.m_pPrev = m_pListTail;
+    ResHandle.m_pNext = nullptr;
+    if (m_pListTail != nullptr)
+        m_pListTail->m_pNext = &ResHandle;
+    else
+        m_pListHead = &ResHandle;
+    m_pListTail         = &ResHandle;
+    ResHandle.m_IsInList = true;
+}
+
+void ResidencyManagerD3D12::RemoveFromList(Handle& ResHandle)
+{
+    VERIFY_EXPR(ResHandle.m_IsInList);
+    if (ResHandle.m_pPrev != nullptr)
+        ResHandle.m_pPrev->m_pNext = ResHandle.m_pNext;
+    else
+        m_pListHead = ResHandle.m_pNext;
+
+    if (ResHandle.m_pNext != nullptr)
+        ResHandle.m_pNext->m_pPrev = ResHandle.m_pPrev;
+    else
+        m_pListTail = ResHandle.m_pPrev;
+
+    ResHandle.m_pPrev    = nullptr;
+    ResHandle.m_pNext    = nullptr;
+    ResHandle.m_IsInList = false;
+}
+
+void ResidencyManagerD3D12::UpdateCompletedSubmitIndex()
+{
+    // Submissions to different queues may complete out of order, so the index only advances
+    // while all previous submissions have completed.
+    while (!m_Submissions.empty())
+    {
+        const auto& Submission = m_Submissions.front();
+        if (m_DeviceD3D12Impl.GetCompletedFenceValue(Submission.QueueId) < Submission.FenceValue)
+            break;
+
+        m_CompletedSubmitIndex = Submission.Index;
+        m_Submissions.pop_front();
+    }
+}
+
+void ResidencyManagerD3D12::PrepareSubmission(Uint64 SubmitIndex, ResidencySet* const* ppSets, Uint32 NumSets)
+{
+    UpdateCompletedSubmitIndex();
+
+    Uint64 RequiredSize = 0;
+    m_PendingResident.clear();
+    for (Uint32 i = 0; i < NumSets; ++i)
+    {
+        for (auto& Entry : ppSets[i]->m_Entries)
+        {
+            auto& ResHandle = *Entry.first;
+            VERIFY(ResHandle.m_pMgr == this, "The resource is not registered with this manager");
+
+            if (!ResHandle.m_IsResident)
+            {
+                // MakeResident() and Evict() are reference counted, so every resource must only
+                // be made resident once even if it is referenced by several command lists.
+                ResHandle.m_IsResident = true;
+                RequiredSize += ResHandle.m_Size;
+                m_PendingResident.push_back(&ResHandle);
+            }
+
+            // Move the resource to the end of the list. Resources referenced by this
+            // submission are never evicted as their last submission index is not completed.
+            ResHandle.m_LastSubmitIndex = SubmitIndex;
+            if (ResHandle.m_IsInList)
+                RemoveFromList(ResHandle);
+            AddToList(ResHandle);
+        }
+    }
+
+    EvictColdResources(RequiredSize);
+
+    if (!m_PendingResident.empty())
+    {
+        m_Pageables.clear();
+        for (auto* pHandle : m_PendingResident)
+            m_Pageables.push_back(pHandle->m_pd3d12Pageable);
+
+        // MakeResident() blocks until the resources are resident
+        auto hr = m_DeviceD3D12Impl.GetD3D12Device()->MakeResident(static_cast<UINT>(m_Pageables.size()), m_Pageables.data());
+        if (FAILED(hr))
+            LOG_ERROR_MESSAGE("Failed to make ", m_Pageables.size(), " resource(s) resident");
+    }
+}
+
+void ResidencyManagerD3D12::EvictColdResources(Uint64 RequiredSize)
+{
+    if (!m_pAdapter)
+        return;
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO MemInfo{};
+    if (FAILED(m_pAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &MemInfo)))
+        return;
+
+    const auto Budget = static_cast<Uint64>(static_cast<double>(MemInfo.Budget) * m_BudgetFraction);
+
+    auto Usage = MemInfo.CurrentUsage + RequiredSize;
+    if (Usage <= Budget)
+        return;
+
+    m_Pageables.clear();
+    Uint64 EvictedSize = 0;
+    for (auto* pHandle = m_pListHead; pHandle != nullptr && Usage > Budget;)
+    {
+        // The list is sorted by the last submission index, so the first resource
+        // that may still be used by the GPU ends the search.
+        if (pHandle->m_LastSubmitIndex > m_CompletedSubmitIndex)
+            break;
+
+        auto* pNext = pHandle->m_pNext;
+
+        VERIFY_EXPR(pHandle->m_IsResident);
+        m_Pageables.push_back(pHandle->m_pd3d12Pageable);
+        pHandle->m_IsResident = false;
+        // Evicted resources are added back to the list when they are used again
+        RemoveFromList(*pHandle);
+
+        EvictedSize += pHandle->m_Size;
+        Usage -= std::min(Usage, pHandle->m_Size);
+
+        pHandle = pNext;
+    }
+
+    if (m_Pageables.empty())
+        return;
+
+    LOG_INFO_MESSAGE_ONCE("Video memory usage (", MemInfo.CurrentUsage >> 20, " MB) exceeds the budget (", Budget >> 20,
+                          " MB). Least recently used resources will be evicted (", EvictedSize >> 20, " MB this time).");
+
+    auto hr = m_DeviceD3D12Impl.GetD3D12Device()->Evict(static_cast<UINT>(m_Pageables.size()), m_Pageables.data());
+    if (FAILED(hr))
+        LOG_ERROR_MESSAGE("Failed to evict ", m_Pageables.size(), " resource(s)");
+}
+
+} // namespace Diligent
@@ -27,6 +27,8 @@
 
 #include "pch.h"
 
+#include <algorithm>
+
 #include "RootParamsManager.hpp"
 #include "D3D12Utils.h"
 #include "D3D12TypeConversions.hpp"
@@ -144,13 +146,14 @@ size_t RootParameter::GetHash() const
 
 RootParamsManager::~RootParamsManager()
 {
-    static_assert(std::is_trivially_destructible<RootParameter>::value, "Destructors for m_pRootTables and m_pRootViews are required");
+    static_assert(std::is_trivially_destructible<RootParameter>::value, "Destructors for m_pRootTables, m_pRootViews and m_pRootConstants are required");
 }
 
 bool RootParamsManager::operator==(const RootParamsManager& RootParams) const noexcept
 {
     if (m_NumRootTables != RootParams.m_NumRootTables ||
-        m_NumRootViews != RootParams.m_NumRootViews)
+        m_NumRootViews != RootParams.m_NumRootViews ||
+        m_NumRootConstants != RootParams.m_NumRootConstants)
         return false;
 
     for (Uint32 rv = 0; rv < m_NumRootViews; ++rv)
@@ -169,6 +172,14 @@ bool RootParamsManager::operator==(const RootParamsManager& RootParams) const no
             return false;
     }
 
+    for (Uint32 rc = 0; rc < m_NumRootConstants; ++rc)
+    {
+        const auto& RC0 = GetRootConstants(rc);
+        const auto& RC1 = RootParams.GetRootConstants(rc);
+        if (RC0 != RC1)
+            return false;
+    }
+
     return true;
 }
 
@@ -230,6 +241,15 @@ void RootParamsManager::Validate() const
         VERIFY(RootView.TableOffsetInGroupAllocation == RootParameter::InvalidTableOffsetInGroupAllocation,
                "Root views must not be assigned to descriptor table allocations.");
     }
+
+    for (Uint32 i = 0; i < GetNumRootConstants(); ++i)
+    {
+        const auto& RootConsts = GetRootConstants(i);
+        VERIFY_EXPR(RootConsts.d3d12RootParam.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS);
+        VERIFY(RootConsts.d3d12RootParam.Constants.Num32BitValues > 0, "Root constants must contain at least one value");
+        VERIFY(RootConsts.TableOffsetInGroupAllocation == RootParameter::InvalidTableOffsetInGroupAllocation,
+               "Root constants must not be assigned to descriptor table allocations.");
+    }
 }
 #endif
 
@@ -260,6 +280,8 @@ RootParameter& RootParamsBuilder::AddRootView(D3D12_ROOT_PARAMETER_TYPE Paramete
         VERIFY(RootTbl.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root table");
     for (const auto& RootView : m_RootViews)
         VERIFY(RootView.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root view");
+    for (const auto& RootConsts : m_RootConstants)
+        VERIFY(RootConsts.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root constants parameter");
 #endif
 
     D3D12_ROOT_PARAMETER d3d12RootParam{ParameterType, {}, Visibility};
@@ -270,6 +292,30 @@ RootParameter& RootParamsBuilder::AddRootView(D3D12_ROOT_PARAMETER_TYPE Paramete
     return m_RootViews.back();
 }
 
+size_t RootParamsBuilder::AddRootConstants(Uint32               RootIndex,
+                                           UINT                 Register,
+                                           UINT                 RegisterSpace,
+                                           ROOT_PARAMETER_GROUP Group)
+{
+#ifdef DILIGENT_DEBUG
+    for (const auto& RootTbl : m_RootTables)
+        VERIFY(RootTbl.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root table");
+    for (const auto& RootView : m_RootViews)
+        VERIFY(RootView.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root view");
+    for (const auto& RootConsts : m_RootConstants)
+        VERIFY(RootConsts.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root constants parameter");
+#endif
+
+    // Root constants are shared by all resources in the signature, so they are visible to all stages
+    D3D12_ROOT_PARAMETER d3d12RootParam{D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS, {}, D3D12_SHADER_VISIBILITY_ALL};
+    d3d12RootParam.Constants.ShaderRegister = Register;
+    d3d12RootParam.Constants.RegisterSpace  = RegisterSpace;
+    d3d12RootParam.Constants.Num32BitValues = 0;
+    m_RootConstants.emplace_back(RootConstantsData{RootIndex, Group, d3d12RootParam});
+
+    return m_RootConstants.size() - 1;
+}
+
 RootParamsBuilder::RootTableData::RootTableData(Uint32                  _RootIndex,
                                                 D3D12_SHADER_VISIBILITY _Visibility,
                                                 ROOT_PARAMETER_GROUP    _Group,
@@ -309,6 +355,8 @@ RootParamsBuilder::RootTableData& RootParamsBuilder::AddRootTable(Uint32
         VERIFY(RootTbl.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root table");
     for (const auto& RootView : m_RootViews)
         VERIFY(RootView.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root view");
+    for (const auto& RootConsts : m_RootConstants)
+        VERIFY(RootConsts.RootIndex != RootIndex, "Index ", RootIndex, " is already used by another root constants parameter");
 #endif
 
     m_RootTables.emplace_back(RootIndex, Visibility, Group, NumRangesInNewTable);
@@ -330,8 +378,8 @@ void RootParamsBuilder::AllocateResourceSlot(SHADER_TYPE                   Shade
     const auto ShaderVisibility = ShaderStagesToD3D12ShaderVisibility(ShaderStages);
     const auto ParameterGroup   = VariableTypeToRootParameterGroup(VariableType);
 
-    // Get the next available root index past all allocated tables and root views
-    RootIndex = static_cast<Uint32>(m_RootTables.size() + m_RootViews.size());
+    // Get the next available root index past all allocated tables, root views and root constants
+    RootIndex = static_cast<Uint32>(m_RootTables.size() + m_RootViews.size() + m_RootConstants.size());
 
     if (RootParameterType == D3D12_ROOT_PARAMETER_TYPE_CBV ||
         RootParameterType == D3D12_ROOT_PARAMETER_TYPE_SRV ||
@@ -396,6 +444,25 @@ void RootParamsBuilder::AllocateResourceSlot(SHADER_TYPE                   Shade
         DbgValidateD3D12RootTable(d3d12RootParam.DescriptorTable);
 #endif
     }
+    else if (RootParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS)
+    {
+        VERIFY(ArraySize > 0, "Array size must not be zero");
+
+        auto  ConstantsIt = std::find_if(m_RootConstants.begin(), m_RootConstants.end(),
+                                        [Register, Space](const RootConstantsData& Consts) {
+                                            return Consts.d3d12RootParam.Constants.ShaderRegister == Register &&
+                                                Consts.d3d12RootParam.Constants.RegisterSpace == Space;
+                                        });
+        auto& Consts      = ConstantsIt != m_RootConstants.end() ?
+            *ConstantsIt :
+            m_RootConstants[AddRootConstants(RootIndex, Register, Space, ROOT_PARAMETER_GROUP_STATIC_MUTABLE)];
+
+        RootIndex = Consts.RootIndex;
+
+        // One 32-bit value per array element; values are tightly packed
+        OffsetFromTableStart = Consts.d3d12RootParam.Constants.Num32BitValues;
+        Consts.d3d12RootParam.Constants.Num32BitValues += ArraySize;
+    }
     else
     {
         UNSUPPORTED("Unsupported root parameter type");
@@ -406,15 +473,17 @@ void RootParamsBuilder::InitializeMgr(IMemoryAllocator& MemAllocator, RootParams
 {
     VERIFY(!ParamsMgr.m_pMemory, "Params manager has already been initialized!");
 
-    auto& NumRootTables = ParamsMgr.m_NumRootTables;
-    auto& NumRootViews  = ParamsMgr.m_NumRootViews;
+    auto& NumRootTables    = ParamsMgr.m_NumRootTables;
+    auto& NumRootViews     = ParamsMgr.m_NumRootViews;
+    auto& NumRootConstants = ParamsMgr.m_NumRootConstants;
 
-    NumRootTables = static_cast<Uint32>(m_RootTables.size());
-    NumRootViews  = static_cast<Uint32>(m_RootViews.size());
-    if (NumRootTables == 0 && NumRootViews == 0)
+    NumRootTables    = static_cast<Uint32>(m_RootTables.size());
+    NumRootViews     = static_cast<Uint32>(m_RootViews.size());
+    NumRootConstants = static_cast<Uint32>(m_RootConstants.size());
+    if (NumRootTables == 0 && NumRootViews == 0 && NumRootConstants == 0)
         return;
 
-    const auto TotalRootParamsCount = m_RootTables.size() + m_RootViews.size();
+    const auto TotalRootParamsCount = m_RootTables.size() + m_RootViews.size() + m_RootConstants.size();
 
     size_t TotalRangesCount = 0;
     for (auto& Tbl : m_RootTables)
@@ -426,7 +495,7 @@ void RootParamsBuilder::InitializeMgr(IMemoryAllocator& MemAllocator, RootParams
     const auto MemorySize = TotalRootParamsCount * sizeof(RootParameter) + TotalRangesCount * sizeof(D3D12_DESCRIPTOR_RANGE);
     VERIFY_EXPR(MemorySize > 0);
     ParamsMgr.m_pMemory = decltype(ParamsMgr.m_pMemory){
-        ALLOCATE_RAW(MemAllocator, "Memory buffer for root tables, root views & descriptor ranges", MemorySize),
+        ALLOCATE_RAW(MemAllocator, "Memory buffer for root tables, root views, root constants & descriptor ranges", MemorySize),
         STDDeleter<void, IMemoryAllocator>(MemAllocator) //
     };
 
@@ -437,7 +506,8 @@ void RootParamsBuilder::InitializeMgr(IMemoryAllocator& MemAllocator, RootParams
     // Note: this order is more efficient than views->tables->ranges
     auto* const pRootTables       = reinterpret_cast<RootParameter*>(ParamsMgr.m_pMemory.get());
     auto* const pRootViews        = pRootTables + NumRootTables;
-    auto* const pDescriptorRanges = reinterpret_cast<D3D12_DESCRIPTOR_RANGE*>(pRootViews + NumRootViews);
+    auto* const pRootConstants    = pRootViews + NumRootViews;
+    auto* const pDescriptorRanges = reinterpret_cast<D3D12_DESCRIPTOR_RANGE*>(pRootConstants + NumRootConstants);
 
     // Copy descriptor tables
     auto* pCurrDescrRangePtr = pDescriptorRanges;
@@ -484,8 +554,19 @@ void RootParamsBuilder::InitializeMgr(IMemoryAllocator& MemAllocator, RootParams
                "Unexpected parameter type: SBV, SRV or UAV is expected");
         new (pRootViews + rv) RootParameter{SrcView.RootIndex, SrcView.Group, d3d12RootParam};
     }
-    ParamsMgr.m_pRootTables = NumRootTables != 0 ? pRootTables : nullptr;
-    ParamsMgr.m_pRootViews  = NumRootViews != 0 ? pRootViews : nullptr;
+
+    // Copy root constants
+    for (Uint32 rc = 0; rc < NumRootConstants; ++rc)
+    {
+        const auto& SrcConsts = m_RootConstants[rc];
+        VERIFY(SrcConsts.d3d12RootParam.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS,
+               "Unexpected parameter type: 32-bit constants are expected");
+        new (pRootConstants + rc) RootParameter{SrcConsts.RootIndex, SrcConsts.Group, SrcConsts.d3d12RootParam};
+    }
+
+    ParamsMgr.m_pRootTables    = NumRootTables != 0 ? pRootTables : nullptr;
+    ParamsMgr.m_pRootViews     = NumRootViews != 0 ? pRootViews : nullptr;
+    ParamsMgr.m_pRootConstants = NumRootConstants != 0 ? pRootConstants : nullptr;
 
 #ifdef DILIGENT_DEBUG
     ParamsMgr.Validate();
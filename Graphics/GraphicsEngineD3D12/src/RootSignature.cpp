@@ -34,10 +34,92 @@
 #include "CommandContext.hpp"
 #include "D3D12TypeConversions.hpp"
 #include "HashUtils.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+constexpr Uint32 RootSigCacheMagicNumber = 0x52534344; // 'RSCD'
+constexpr Uint32 RootSigCacheVersion     = 1;
+
+// Serializes the contents of the root signature description, following all pointers,
+// so that two equal descriptions produce equal byte sequences.
+template <SerializerMode Mode>
+bool SerializeRootSignatureDesc(Serializer<Mode>& Ser, const D3D12_ROOT_SIGNATURE_DESC& Desc)
+{
+    if (!Ser(Desc.Flags, Desc.NumParameters, Desc.NumStaticSamplers))
+        return false;
+
+    for (UINT i = 0; i < Desc.NumParameters; ++i)
+    {
+        const auto& Param = Desc.pParameters[i];
+        if (!Ser(Param.ParameterType, Param.ShaderVisibility))
+            return false;
+
+        switch (Param.ParameterType)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+            {
+                const auto& Tbl = Param.DescriptorTable;
+                if (!Ser(Tbl.NumDescriptorRanges))
+                    return false;
+                for (UINT r = 0; r < Tbl.NumDescriptorRanges; ++r)
+                {
+                    const auto& Range = Tbl.pDescriptorRanges[r];
+                    if (!Ser(Range.RangeType, Range.NumDescriptors, Range.BaseShaderRegister, Range.RegisterSpace, Range.OffsetInDescriptorsFromTableStart))
+                        return false;
+                }
+                break;
+            }
+
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                if (!Ser(Param.Constants.ShaderRegister, Param.Constants.RegisterSpace, Param.Constants.Num32BitValues))
+                    return false;
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_CBV:
+            case D3D12_ROOT_PARAMETER_TYPE_SRV:
+            case D3D12_ROOT_PARAMETER_TYPE_UAV:
+                if (!Ser(Param.Descriptor.ShaderRegister, Param.Descriptor.RegisterSpace))
+                    return false;
+                break;
+
+            default:
+                UNEXPECTED("Unexpected root parameter type");
+                return false;
+        }
+    }
+
+    for (UINT i = 0; i < Desc.NumStaticSamplers; ++i)
+    {
+        const auto& Sam = Desc.pStaticSamplers[i];
+        if (!Ser(Sam.Filter, Sam.AddressU, Sam.AddressV, Sam.AddressW, Sam.MipLODBias, Sam.MaxAnisotropy, Sam.ComparisonFunc,
+                 Sam.BorderColor, Sam.MinLOD, Sam.MaxLOD, Sam.ShaderRegister, Sam.RegisterSpace, Sam.ShaderVisibility))
+            return false;
+    }
+
+    return true;
+}
+
+SerializedData MakeRootSignatureDescKey(const D3D12_ROOT_SIGNATURE_DESC& Desc)
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeRootSignatureDesc(MeasureSer, Desc);
+
+    auto Key = MeasureSer.AllocateData(GetRawAllocator());
+
+    Serializer<SerializerMode::Write> WriteSer{Key};
+    SerializeRootSignatureDesc(WriteSer, Desc);
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    return Key;
+}
+
+} // namespace
+
 RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*                                     pRefCounters,
                                        RenderDeviceD3D12Impl*                                  pDeviceD3D12Impl,
                                        const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[],
@@ -78,7 +160,7 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
         const auto& RootParams = pSignature->GetRootParams();
 
         SignInfo.BaseRootIndex = TotalParams;
-        TotalParams += RootParams.GetNumRootTables() + RootParams.GetNumRootViews();
+        TotalParams += RootParams.GetNumRootTables() + RootParams.GetNumRootViews() + RootParams.GetNumRootConstants();
 
         for (Uint32 rt = 0; rt < RootParams.GetNumRootTables(); ++rt)
         {
@@ -113,6 +195,7 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
     auto descr_range_it = d3d12DescrRanges.begin();
 
     Uint32 BaseRegisterSpace = 0;
+    bool   HasBindless       = false;
     for (Uint32 sig = 0; sig < m_SignatureCount; ++sig)
     {
         auto& SignInfo = m_ResourceSignatures[sig];
@@ -166,6 +249,23 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
             d3d12Parameters[RootIndex].Descriptor.RegisterSpace += BaseRegisterSpace;
         }
 
+        for (Uint32 rc = 0; rc < RootParams.GetNumRootConstants(); ++rc)
+        {
+            const auto&  RootConsts    = RootParams.GetRootConstants(rc);
+            const auto&  d3d12SrcParam = RootConsts.d3d12RootParam;
+            const Uint32 RootIndex     = SignInfo.BaseRootIndex + RootConsts.RootIndex;
+            VERIFY(d3d12SrcParam.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS, "Root constants are expected");
+
+            MaxSpaceUsed = std::max(MaxSpaceUsed, d3d12SrcParam.Constants.RegisterSpace);
+
+            d3d12Parameters[RootIndex] = d3d12SrcParam;
+            // Offset register space value by the base register space of the current resource signature.
+            d3d12Parameters[RootIndex].Constants.RegisterSpace += BaseRegisterSpace;
+        }
+
+        if (pSignature->HasBindlessResources())
+            HasBindless = true;
+
         for (Uint32 samp = 0, SampCount = pSignature->GetImmutableSamplerCount(); samp < SampCount; ++samp)
         {
             const auto& SampAttr = pSignature->GetImmutableSamplerAttribs(samp);
@@ -211,7 +311,12 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
     VERIFY_EXPR(descr_range_it == d3d12DescrRanges.end());
 
     D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
-    rootSignatureDesc.Flags         = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+    rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+    if (HasBindless)
+    {
+        // Bindless resources are accessed by shaders through ResourceDescriptorHeap[]
+        rootSignatureDesc.Flags |= D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED;
+    }
     rootSignatureDesc.NumParameters = static_cast<UINT>(d3d12Parameters.size());
     rootSignatureDesc.pParameters   = !d3d12Parameters.empty() ? d3d12Parameters.data() : nullptr;
 
@@ -225,22 +330,9 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
 
     if (pDeviceD3D12Impl)
     {
-        CComPtr<ID3DBlob> signature;
-        CComPtr<ID3DBlob> error;
-
-        HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
-        if (error)
-        {
-            LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
-        }
-        CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
-
         m_pCache = &pDeviceD3D12Impl->GetRootSignatureCache();
 
-        auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
-
-        hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
-        CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
+        m_pd3d12RootSignature = m_pCache->CreateD3D12RootSignature(rootSignatureDesc);
     }
 }
 
@@ -349,21 +441,37 @@ RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefC
         }
     }
 
-    std::lock_guard<std::mutex> Lock{m_RootSigCacheMtx};
-
-    auto Range = m_RootSigCache.equal_range(Hash);
-    for (auto Iter = Range.first; Iter != Range.second; ++Iter)
-    {
-        if (auto Ptr = Iter->second.Lock())
+    auto FindCompatibleRootSig = [&]() -> RefCntAutoPtr<RootSignatureD3D12> {
+        auto Range = m_RootSigCache.equal_range(Hash);
+        for (auto Iter = Range.first; Iter != Range.second; ++Iter)
         {
-            if (Ptr->IsCompatibleWith(ppSignatures, SignatureCount))
-                return Ptr;
+            if (auto Ptr = Iter->second.Lock())
+            {
+                if (Ptr->IsCompatibleWith(ppSignatures, SignatureCount))
+                    return Ptr;
+            }
         }
+        return {};
+    };
+
+    {
+        std::lock_guard<std::mutex> Lock{m_RootSigCacheMtx};
+        if (auto pRootSig = FindCompatibleRootSig())
+            return pRootSig;
     }
 
+    // Create the root signature without holding the lock so that other threads
+    // are not blocked while the d3d12 root signature is being serialized and created.
+    // Note that pNewRootSig must be declared before the lock as its destructor
+    // calls OnDestroyRootSig() if the root signature is discarded.
     RefCntAutoPtr<RootSignatureD3D12> pNewRootSig;
     m_DeviceD3D12Impl.CreateRootSignature(ppSignatures, SignatureCount, Hash, &pNewRootSig);
 
+    std::lock_guard<std::mutex> Lock{m_RootSigCacheMtx};
+    // Another thread may have created a compatible root signature in the meantime
+    if (auto pRootSig = FindCompatibleRootSig())
+        return pRootSig;
+
     m_RootSigCache.emplace(Hash, pNewRootSig);
     return pNewRootSig;
 }
@@ -382,4 +490,164 @@ void RootSignatureCacheD3D12::OnDestroyRootSig(RootSignatureD3D12* pRootSig)
     }
 }
 
+CComPtr<ID3D12RootSignature> RootSignatureCacheD3D12::CreateD3D12RootSignature(const D3D12_ROOT_SIGNATURE_DESC& d3d12RootSigDesc) noexcept(false)
+{
+    auto DescKey = MakeRootSignatureDescKey(d3d12RootSigDesc);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_BlobsMtx};
+
+        auto it = m_Blobs.find(DescKey);
+        if (it != m_Blobs.end())
+            return it->second.pd3d12RootSig;
+    }
+
+    CComPtr<ID3DBlob> signature;
+    CComPtr<ID3DBlob> error;
+
+    HRESULT hr = D3D12SerializeRootSignature(&d3d12RootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+    if (error)
+    {
+        LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
+    }
+    CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
+
+    auto* pd3d12Device = m_DeviceD3D12Impl.GetD3D12Device();
+
+    CComPtr<ID3D12RootSignature> pd3d12RootSig;
+    hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(pd3d12RootSig), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&pd3d12RootSig)));
+    CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
+
+    RootSigBlob NewBlob;
+    NewBlob.Blob          = SerializedData{signature->GetBufferPointer(), signature->GetBufferSize()}.MakeCopy(GetRawAllocator());
+    NewBlob.pd3d12RootSig = pd3d12RootSig;
+
+    std::lock_guard<std::mutex> Lock{m_BlobsMtx};
+    // If another thread has added the same root signature in the meantime, use that one
+    auto it = m_Blobs.emplace(std::move(DescKey), std::move(NewBlob)).first;
+    return it->second.pd3d12RootSig;
+}
+
+void RootSignatureCacheD3D12::SerializeBlobs(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    *ppBlob = nullptr;
+
+    std::lock_guard<std::mutex> Lock{m_BlobsMtx};
+
+    auto SerializeAll = [this](auto& Ser) {
+        const Uint32 NumBlobs = static_cast<Uint32>(m_Blobs.size());
+        if (!Ser(RootSigCacheMagicNumber, RootSigCacheVersion, NumBlobs))
+            return false;
+
+        for (const auto& it : m_Blobs)
+        {
+            const auto& DescKey = it.first;
+            const auto& Blob    = it.second.Blob;
+            if (!Ser.SerializeBytes(DescKey.Ptr(), DescKey.Size()) || !Ser.SerializeBytes(Blob.Ptr(), Blob.Size()))
+                return false;
+        }
+        return true;
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeAll(MeasureSer);
+
+    auto pDataBlob = DataBlobImpl::Create(MeasureSer.GetSize());
+
+    SerializedData                    Data{pDataBlob->GetDataPtr(), pDataBlob->GetSize()};
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    if (!SerializeAll(WriteSer))
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize root signature cache");
+        return;
+    }
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    *ppBlob = pDataBlob.Detach();
+}
+
+Uint32 RootSignatureCacheD3D12::PrecreateRootSignatures(const void* pData, size_t DataSize, IThreadPool* pThreadPool)
+{
+    if (pData == nullptr || DataSize == 0)
+        return 0;
+
+    SerializedData                   Data{const_cast<void*>(pData), DataSize};
+    Serializer<SerializerMode::Read> Ser{Data};
+
+    Uint32 MagicNumber = 0;
+    Uint32 Version     = 0;
+    Uint32 NumBlobs    = 0;
+    if (!Ser(MagicNumber, Version, NumBlobs) || MagicNumber != RootSigCacheMagicNumber || Version != RootSigCacheVersion)
+    {
+        LOG_WARNING_MESSAGE("Root signature cache data is not valid or has been created by a different engine version and will be ignored");
+        return 0;
+    }
+
+    struct PendingRootSig
+    {
+        const void* pDescKey    = nullptr;
+        size_t      DescKeySize = 0;
+        const void* pBlob       = nullptr;
+        size_t      BlobSize    = 0;
+
+        CComPtr<ID3D12RootSignature> pd3d12RootSig;
+    };
+    std::vector<PendingRootSig> PendingRootSigs(NumBlobs);
+    for (auto& RootSig : PendingRootSigs)
+    {
+        if (!Ser.SerializeBytes(RootSig.pDescKey, RootSig.DescKeySize) || !Ser.SerializeBytes(RootSig.pBlob, RootSig.BlobSize))
+        {
+            LOG_WARNING_MESSAGE("Root signature cache data is corrupted and will be ignored");
+            return 0;
+        }
+    }
+
+    auto* pd3d12Device  = m_DeviceD3D12Impl.GetD3D12Device();
+    auto  CreateRootSig = [pd3d12Device](PendingRootSig& RootSig) {
+        auto hr = pd3d12Device->CreateRootSignature(0, RootSig.pBlob, RootSig.BlobSize, __uuidof(RootSig.pd3d12RootSig), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&RootSig.pd3d12RootSig)));
+        if (FAILED(hr))
+            LOG_WARNING_MESSAGE("Failed to create root signature from the cached blob. The root signature will be created when it is first used.");
+    };
+
+    if (pThreadPool != nullptr)
+    {
+        std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+        Tasks.reserve(PendingRootSigs.size());
+        for (auto& RootSig : PendingRootSigs)
+        {
+            Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                                [&CreateRootSig, &RootSig](Uint32 ThreadId) {
+                                                    CreateRootSig(RootSig);
+                                                }));
+        }
+        for (auto& pTask : Tasks)
+            pTask->WaitForCompletion();
+    }
+    else
+    {
+        for (auto& RootSig : PendingRootSigs)
+            CreateRootSig(RootSig);
+    }
+
+    Uint32 NumCreated = 0;
+
+    std::lock_guard<std::mutex> Lock{m_BlobsMtx};
+    for (auto& RootSig : PendingRootSigs)
+    {
+        if (!RootSig.pd3d12RootSig)
+            continue;
+
+        auto DescKey = SerializedData{const_cast<void*>(RootSig.pDescKey), RootSig.DescKeySize}.MakeCopy(GetRawAllocator());
+
+        RootSigBlob NewBlob;
+        NewBlob.Blob          = SerializedData{const_cast<void*>(RootSig.pBlob), RootSig.BlobSize}.MakeCopy(GetRawAllocator());
+        NewBlob.pd3d12RootSig = RootSig.pd3d12RootSig;
+        if (m_Blobs.emplace(std::move(DescKey), std::move(NewBlob)).second)
+            ++NumCreated;
+    }
+
+    return NumCreated;
+}
+
 } // namespace Diligent
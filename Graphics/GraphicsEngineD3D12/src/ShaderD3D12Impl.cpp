@@ -35,6 +35,7 @@
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DataBlobImpl.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -101,18 +102,26 @@ ShaderD3D12Impl::ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
         D3D12ShaderCI.AdapterInfo,
         IsDeviceInternal
     },
-    ShaderD3DBase
-    {
-        ShaderCI,
-        GetD3D12ShaderModel(ShaderCI.HLSLVersion, ShaderCI.ShaderCompiler, D3D12ShaderCI.pDXCompiler, D3D12ShaderCI.MaxShaderVersion),
-        D3D12ShaderCI.pDXCompiler
-    },
     m_EntryPoint{ShaderCI.EntryPoint}
 // clang-format on
 {
+    InitializeShader(ShaderCI,
+                     [this, D3D12ShaderCI](const ShaderCreateInfo& CI) //
+                     {
+                         Initialize(CI, D3D12ShaderCI);
+                     });
+}
+
+void ShaderD3D12Impl::Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& D3D12ShaderCI) noexcept(false)
+{
+    const auto ShaderModel = GetD3D12ShaderModel(ShaderCI.HLSLVersion, ShaderCI.ShaderCompiler, D3D12ShaderCI.pDXCompiler, D3D12ShaderCI.MaxShaderVersion);
+    ShaderD3DBase::Initialize(ShaderCI, ShaderModel, D3D12ShaderCI.pDXCompiler);
+
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
+        CompilationStageTimer Timer{COMPILATION_STAGE_REFLECTION};
+
         auto& Allocator  = GetRawAllocator();
         auto* pRawMem    = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D12, 1);
         auto* pResources = new (pRawMem) ShaderResourcesD3D12 //
@@ -128,6 +137,7 @@ ShaderD3D12Impl::ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
 
 ShaderD3D12Impl::~ShaderD3D12Impl()
 {
+    FinishAsyncCompilation();
 }
 
 void ShaderD3D12Impl::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
@@ -43,8 +43,9 @@ namespace Diligent
 
 ShaderResourceCacheD3D12::MemoryRequirements ShaderResourceCacheD3D12::GetMemoryRequirements(const RootParamsManager& RootParams)
 {
-    const auto NumRootTables = RootParams.GetNumRootTables();
-    const auto NumRootViews  = RootParams.GetNumRootViews();
+    const auto NumRootTables    = RootParams.GetNumRootTables();
+    const auto NumRootViews     = RootParams.GetNumRootViews();
+    const auto NumRootConstants = RootParams.GetNumRootConstants();
 
     MemoryRequirements MemReqs;
 
@@ -63,11 +64,14 @@ ShaderResourceCacheD3D12::MemoryRequirements ShaderResourceCacheD3D12::GetMemory
     }
     // Root views' resources are stored in one-descriptor tables
     MemReqs.TotalResources += NumRootViews;
+    // Bindless resources are stored in root constants tables, one resource per 32-bit value
+    for (Uint32 i = 0; i < NumRootConstants; ++i)
+        MemReqs.TotalResources += RootParams.GetRootConstants(i).d3d12RootParam.Constants.Num32BitValues;
 
     static_assert(sizeof(RootTable) % sizeof(void*) == 0, "sizeof(RootTable) is not aligned by the sizeof(void*)");
     static_assert(sizeof(Resource) % sizeof(void*) == 0, "sizeof(Resource) is not aligned by the sizeof(void*)");
 
-    MemReqs.NumTables = NumRootTables + NumRootViews;
+    MemReqs.NumTables = NumRootTables + NumRootViews + NumRootConstants;
 
     MemReqs.TotalSize = (MemReqs.NumTables * sizeof(RootTable) +
                          MemReqs.TotalResources * sizeof(Resource) +
@@ -220,6 +224,27 @@ void ShaderResourceCacheD3D12::Initialize(IMemoryAllocator&        MemAllocator,
         RootTableInitFlags[RootView.RootIndex] = true;
 #endif
     }
+
+    // Initialize tables for root constants that hold descriptor heap indices of bindless resources.
+    // These tables are not assigned descriptor space.
+    for (Uint32 i = 0; i < RootParams.GetNumRootConstants(); ++i)
+    {
+        const auto& RootConsts = RootParams.GetRootConstants(i);
+        VERIFY(!RootTableInitFlags[RootConsts.RootIndex], "Root table at index ", RootConsts.RootIndex, " has already been initialized.");
+        VERIFY_EXPR(RootConsts.d3d12RootParam.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS);
+
+        const auto NumValues = RootConsts.d3d12RootParam.Constants.Num32BitValues;
+        new (&GetRootTable(RootConsts.RootIndex)) RootTable{
+            NumValues,
+            &GetResource(ResIdx),
+            false // IsRootView
+        };
+        ResIdx += NumValues;
+
+#ifdef DILIGENT_DEBUG
+        RootTableInitFlags[RootConsts.RootIndex] = true;
+#endif
+    }
     VERIFY_EXPR(ResIdx == m_TotalResourceCount);
 
 #ifdef DILIGENT_DEBUG
@@ -396,7 +421,8 @@ const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource
     if (m_ContentType == ResourceCacheContentType::SRB)
     {
         auto& Tbl = GetRootTable(RootIndex);
-        if (!Tbl.IsRootView())
+        // Root views and root constants of bindless resources are not assigned descriptor space
+        if (!Tbl.IsRootView() && Tbl.GetStartOffset() != InvalidDescriptorOffset)
         {
             const auto HeapType = DstRes.Type == SHADER_RESOURCE_TYPE_SAMPLER ? D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER : D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 
@@ -696,4 +722,37 @@ void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, Sta
     }
 }
 
+void ShaderResourceCacheD3D12::TrackResidency(CommandContext& Ctx)
+{
+    static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update this function to handle the new resource type");
+    for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+    {
+        auto& Res = GetResource(r);
+        if (Res.IsNull())
+            continue;
+
+        switch (Res.Type)
+        {
+            case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                Ctx.TrackResidency(*Res.pObject.RawPtr<BufferD3D12Impl>());
+                break;
+
+            case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+            case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                Ctx.TrackResidency(*Res.pObject.RawPtr<BufferViewD3D12Impl>()->GetBuffer<BufferD3D12Impl>());
+                break;
+
+            case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+            case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+            case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+                Ctx.TrackResidency(*Res.pObject.RawPtr<TextureViewD3D12Impl>()->GetTexture<TextureD3D12Impl>());
+                break;
+
+            default:
+                // Samplers and acceleration structures are not tracked
+                break;
+        }
+    }
+}
+
 } // namespace Diligent
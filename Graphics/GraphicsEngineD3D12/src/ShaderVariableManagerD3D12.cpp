@@ -281,7 +281,7 @@ BindResourceHelper::BindResourceHelper(const PipelineResourceSignatureD3D12Impl&
 {
     VERIFY(ArrayIndex < m_ResDesc.ArraySize, "Array index is out of range, but it should've been corrected by ShaderVariableBase::SetArray()");
 
-    if (m_CacheType != ResourceCacheContentType::Signature && !m_Attribs.IsRootView())
+    if (m_CacheType != ResourceCacheContentType::Signature && !m_Attribs.IsRootView() && !m_Attribs.IsBindless())
     {
         const auto IsSampler      = (m_ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER);
         const auto RootParamGroup = VariableTypeToRootParameterGroup(m_ResDesc.VarType);
@@ -303,6 +303,10 @@ BindResourceHelper::BindResourceHelper(const PipelineResourceSignatureD3D12Impl&
         {
             VERIFY(m_DstTableCPUDescriptorHandle.ptr != 0, "Shader resources allocated in descriptor tables must be assigned descriptor space.");
         }
+        else if (m_Attribs.IsBindless())
+        {
+            VERIFY(m_DstTableCPUDescriptorHandle.ptr == 0, "Bindless resources should never be assigned descriptor space.");
+        }
         else
         {
             VERIFY_EXPR(m_Attribs.IsRootView());
@@ -519,6 +523,13 @@ void BindResourceHelper::CacheResourceView(const BindResourceInfo& BindInfo,
 
         BindCombinedSampler(pViewD3D12, BindInfo.ArrayIndex, BindInfo.Flags);
 
+        if (m_Attribs.IsBindless())
+        {
+            // Make sure the view has a slot in the shader-visible heap, so that
+            // committing the SRB only needs to read the index.
+            pViewD3D12->GetBindlessDescriptorIndex();
+        }
+
         SetResource(CPUDescriptorHandle, std::move(pViewD3D12));
     }
 }
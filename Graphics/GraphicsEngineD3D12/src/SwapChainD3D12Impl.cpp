@@ -154,9 +154,13 @@ void SwapChainD3D12Impl::Present(Uint32 SyncInterval)
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
     WaitForFrame();
 
+    const Uint64 PresentQPCTime = GetQPCTime();
+
     auto hr = m_pSwapChain->Present(SyncInterval, 0);
     VERIFY(SUCCEEDED(hr), "Present failed");
 
+    UpdateFramePacingStats(PresentQPCTime, SyncInterval);
+
     if (m_SwapChainDesc.IsPrimary)
     {
         pImmediateCtxD3D12->FinishFrame();
@@ -212,6 +212,9 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
         SetState(RESOURCE_STATE_UNDEFINED);
 
         InitSparseProperties();
+
+        // Sparse texture memory is tracked by the device memory objects it is bound to
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_PLACED, 0);
     }
     else if (m_Desc.Usage == USAGE_IMMUTABLE || m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_DYNAMIC)
     {
@@ -237,11 +240,33 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
             D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
             D3D12_HEAP_FLAG_NONE;
 
-        auto hr = pd3d12Device->CreateCommittedResource(
-            &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
-            reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
-        if (FAILED(hr))
-            LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+        // Small textures are suballocated from shared heaps. Render targets, depth-stencil and
+        // multisample textures as well as large textures are created as committed resources.
+        m_MemoryAllocation = pRenderDeviceD3D12->GetMemoryManager().CreatePlacedResource(
+            HeapProps.Type, d3d12TexDesc, d3d12State, pClearValue, m_pd3d12Resource);
+
+        HRESULT hr = S_OK;
+        if (!m_MemoryAllocation.IsValid())
+        {
+            hr = pd3d12Device->CreateCommittedResource(
+                &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            if (FAILED(hr))
+                LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+
+            if (auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager())
+                pResidencyMgr->Register(m_ResidencyHandle, m_pd3d12Resource);
+        }
+
+        if (m_MemoryAllocation.IsValid())
+        {
+            RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, m_MemoryAllocation.Size);
+        }
+        else if (pRenderDeviceD3D12->GetGPUMemoryTracker() != nullptr)
+        {
+            const auto AllocInfo = pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12TexDesc);
+            RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, AllocInfo.SizeInBytes);
+        }
 
         if (*m_Desc.Name != 0)
             m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
@@ -388,6 +413,8 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
         if (FAILED(hr))
             LOG_ERROR_AND_THROW("Failed to create staging buffer");
 
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, stagingBufferSize);
+
         if (bInitializeTexture)
         {
             const auto FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
@@ -621,8 +648,16 @@ void TextureD3D12Impl::CreateViewInternal(const TextureViewDesc& ViewDesc, IText
 
 TextureD3D12Impl::~TextureD3D12Impl()
 {
+    // The resource must be removed from the residency manager before it can be released
+    m_ResidencyHandle.Unregister();
+
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    if (m_MemoryAllocation.IsValid())
+    {
+        // The memory must be returned to the heap after the resource has been released
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+    }
     if (m_StagingFootprints != nullptr)
     {
         FREE(GetRawAllocator(), m_StagingFootprints);
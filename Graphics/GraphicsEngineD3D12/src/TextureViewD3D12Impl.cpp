@@ -74,4 +74,11 @@ TextureViewD3D12Impl::~TextureViewD3D12Impl()
     }
 }
 
+Uint32 TextureViewD3D12Impl::CreateBindlessDescriptor()
+{
+    VERIFY(m_Desc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE || m_Desc.ViewType == TEXTURE_VIEW_UNORDERED_ACCESS,
+           "Only shader resource and unordered access views can be accessed through the descriptor heap");
+    return GetDevice()->CreateBindlessDescriptor(m_Descriptor.GetCpuHandle(), m_BindlessDescriptor, m_BindlessDescriptorIndex);
+}
+
 } // namespace Diligent
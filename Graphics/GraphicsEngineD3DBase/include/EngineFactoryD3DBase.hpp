@@ -215,6 +215,8 @@ public:
             Features.InstanceDataStepRate          = DEVICE_FEATURE_STATE_ENABLED;
             Features.TileShaders                   = DEVICE_FEATURE_STATE_DISABLED;
             Features.SubpassFramebufferFetch       = DEVICE_FEATURE_STATE_DISABLED;
+            Features.WorkGraphs                    = DEVICE_FEATURE_STATE_DISABLED;
+            Features.ConditionalRendering          = DEVICE_FEATURE_STATE_DISABLED;
         }
 
         // Set memory properties
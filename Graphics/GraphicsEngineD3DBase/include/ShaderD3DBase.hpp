@@ -27,11 +27,17 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "WinHPreface.h"
 #include <d3dcommon.h>
 #include "WinHPostface.h"
 
 #include "Shader.h"
+#include "DXBCUtils.hpp"
 
 /// \file
 /// Base implementation of a D3D shader
@@ -43,7 +49,8 @@ namespace Diligent
 class ShaderD3DBase
 {
 public:
-    ShaderD3DBase(const ShaderCreateInfo& ShaderCI, ShaderVersion ShaderModel, class IDXCompiler* DxCompiler);
+    /// Compiles the shader from the source or copies the byte code.
+    void Initialize(const ShaderCreateInfo& ShaderCI, ShaderVersion ShaderModel, class IDXCompiler* DxCompiler) noexcept(false);
 
     void GetBytecode(const void** ppBytecode,
                      Uint64&      Size) const
@@ -62,8 +69,24 @@ public:
 
     ID3DBlob* GetD3DBytecode() const { return m_pShaderByteCode; }
 
+    /// Returns a copy of the byte code with the resource bindings remapped according to the resource map,
+    /// or null if the bindings could not be remapped.
+
+    /// The locations of the bindings in DXBC byte code are found by the first call, so that
+    /// subsequent calls only copy the byte code and write the new bindings.
+    /// DXIL byte code can't be patched in place and is remapped by the compiler. The result
+    /// is cached for every distinct resource map.
+    CComPtr<ID3DBlob> GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap, class IDXCompiler* DxCompiler) const noexcept(false);
+
 protected:
     CComPtr<ID3DBlob> m_pShaderByteCode;
+
+private:
+    mutable std::mutex m_RemapMtx;
+
+    mutable std::shared_ptr<const DXBCUtils::ResourceBindingPatchTable> m_pBindingPatchTable;
+
+    mutable std::vector<std::pair<ResourceBinding::TMap, CComPtr<ID3DBlob>>> m_RemappedDXIL;
 };
 
 } // namespace Diligent
@@ -295,6 +295,61 @@ protected:
         }
     }
 
+    // Updates the frame pacing statistics from the DXGI frame statistics.
+    // Must be called right after IDXGISwapChain::Present().
+    void UpdateFramePacingStats(Uint64 PresentQPCTime, Uint32 SyncInterval)
+    {
+        UINT LastPresentCount = 0;
+        if (FAILED(m_pSwapChain->GetLastPresentCount(&LastPresentCount)))
+            return;
+        m_PresentQPCTimes[LastPresentCount % _countof(m_PresentQPCTimes)] = PresentQPCTime;
+
+        // Frame statistics are only available for flip-model swap chains and in full screen mode,
+        // and DXGI_ERROR_FRAME_STATISTICS_DISJOINT is returned when the output changes.
+        DXGI_FRAME_STATISTICS FrameStats = {};
+        if (FAILED(m_pSwapChain->GetFrameStatistics(&FrameStats)))
+        {
+            m_LastFrameStats = {};
+            return;
+        }
+        if (FrameStats.PresentCount == m_LastFrameStats.PresentCount)
+            return;
+
+        // https://learn.microsoft.com/en-us/windows/win32/direct3ddxgi/dxgi-flip-model#avoiding-synchronizing-and-detecting-glitches
+        Uint32 MissedVBlanks = 0;
+        if (m_LastFrameStats.PresentCount != 0 && SyncInterval != 0)
+        {
+            const UINT NumFrames    = FrameStats.PresentCount - m_LastFrameStats.PresentCount;
+            const UINT NumRefreshes = FrameStats.SyncRefreshCount - m_LastFrameStats.SyncRefreshCount;
+            if (NumRefreshes > NumFrames * SyncInterval)
+                MissedVBlanks = NumRefreshes - NumFrames * SyncInterval;
+        }
+
+        double PresentLatency = 0;
+        if (LastPresentCount - FrameStats.PresentCount < _countof(m_PresentQPCTimes))
+        {
+            if (m_QPCFrequency == 0)
+            {
+                LARGE_INTEGER Frequency;
+                QueryPerformanceFrequency(&Frequency);
+                m_QPCFrequency = Frequency.QuadPart;
+            }
+            const Uint64 QPCPresentTime = m_PresentQPCTimes[FrameStats.PresentCount % _countof(m_PresentQPCTimes)];
+            if (static_cast<Uint64>(FrameStats.SyncQPCTime.QuadPart) > QPCPresentTime)
+                PresentLatency = static_cast<double>(FrameStats.SyncQPCTime.QuadPart - QPCPresentTime) / static_cast<double>(m_QPCFrequency);
+        }
+
+        TBase::OnFrameDisplayed(PresentLatency, MissedVBlanks);
+        m_LastFrameStats = FrameStats;
+    }
+
+    static Uint64 GetQPCTime()
+    {
+        LARGE_INTEGER Time;
+        QueryPerformanceCounter(&Time);
+        return static_cast<Uint64>(Time.QuadPart);
+    }
+
     virtual void DILIGENT_CALL_TYPE SetFullscreenMode(const DisplayModeAttribs& DisplayMode) override final
     {
         if (m_pSwapChain)
@@ -367,6 +422,11 @@ protected:
     HANDLE m_FrameLatencyWaitableObject = NULL;
 
     Uint32 m_MaxFrameLatency = 0;
+
+    // Times of the recent Present() calls indexed by the present count
+    Uint64                m_PresentQPCTimes[16] = {};
+    Uint64                m_QPCFrequency        = 0;
+    DXGI_FRAME_STATISTICS m_LastFrameStats      = {};
 };
 
 } // namespace Diligent
@@ -42,7 +42,9 @@
 #include "ShaderD3DBase.hpp"
 #include "DXCompiler.hpp"
 #include "HLSLUtils.hpp"
+#include "DXBCUtils.hpp"
 #include "BasicMath.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 #ifndef D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES
 #    define D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES (1 << 20)
@@ -115,13 +117,21 @@ static HRESULT CompileShader(const char*             Source,
     for (auto CompileFlags = ShaderCI.CompileFlags; CompileFlags != SHADER_COMPILE_FLAG_NONE;)
     {
         auto Flag = ExtractLSB(CompileFlags);
-        static_assert(SHADER_COMPILE_FLAG_LAST == 2, "Please updated the switch below to handle the new shader flag");
+        static_assert(SHADER_COMPILE_FLAG_LAST == 32, "Please updated the switch below to handle the new shader flag");
         switch (Flag)
         {
             case SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS:
                 dwShaderFlags |= D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES;
                 break;
 
+            case SHADER_COMPILE_FLAG_SKIP_REFLECTION:
+            case SHADER_COMPILE_FLAG_ASYNCHRONOUS:
+            case SHADER_COMPILE_FLAG_CACHE_INCLUDES:
+            case SHADER_COMPILE_FLAG_MINIMAL_OPTIMIZATION:
+            case SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE:
+                // These flags do not affect the compiler
+                break;
+
             default:
                 UNEXPECTED("Unexpected shader compile flag");
         }
@@ -130,10 +140,12 @@ static HRESULT CompileShader(const char*             Source,
     D3D_SHADER_MACRO Macros[] = {{"D3DCOMPILER", ""}, {}};
 
     D3DIncludeImpl IncludeImpl{ShaderCI.pShaderSourceStreamFactory};
+
+    CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
     return D3DCompile(Source, SourceLength, nullptr, Macros, &IncludeImpl, ShaderCI.EntryPoint, profile, dwShaderFlags, 0, ppBlobOut, ppCompilerOutput);
 }
 
-ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersion ShaderModel, IDXCompiler* DxCompiler)
+void ShaderD3DBase::Initialize(const ShaderCreateInfo& ShaderCI, const ShaderVersion ShaderModel, IDXCompiler* DxCompiler) noexcept(false)
 {
     if (ShaderCI.Source || ShaderCI.FilePath)
     {
@@ -191,4 +203,87 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
     }
 }
 
+static bool ResourceMapsEqual(const ResourceBinding::TMap& Map1, const ResourceBinding::TMap& Map2)
+{
+    if (Map1.size() != Map2.size())
+        return false;
+
+    for (const auto& it1 : Map1)
+    {
+        const auto it2 = Map2.find(it1.first);
+        if (it2 == Map2.end())
+            return false;
+
+        const auto& Info1 = it1.second;
+        const auto& Info2 = it2->second;
+        if (Info1.BindPoint != Info2.BindPoint || Info1.Space != Info2.Space || Info1.ArraySize != Info2.ArraySize)
+            return false;
+    }
+
+    return true;
+}
+
+CComPtr<ID3DBlob> ShaderD3DBase::GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap, IDXCompiler* DxCompiler) const noexcept(false)
+{
+    VERIFY_EXPR(m_pShaderByteCode);
+    const auto* const pBytecode = m_pShaderByteCode->GetBufferPointer();
+    const auto        Size      = m_pShaderByteCode->GetBufferSize();
+
+    CComPtr<ID3DBlob> pBlob;
+    if (IsDXILBytecode(pBytecode, Size))
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_RemapMtx};
+            for (const auto& Remapped : m_RemappedDXIL)
+            {
+                if (ResourceMapsEqual(Remapped.first, ResourceMap))
+                    return Remapped.second;
+            }
+        }
+
+        if (DxCompiler == nullptr)
+            LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
+
+        VERIFY_EXPR(__uuidof(ID3DBlob) == __uuidof(IDxcBlob));
+        if (!DxCompiler->RemapResourceBindings(ResourceMap, reinterpret_cast<IDxcBlob*>(m_pShaderByteCode.p), reinterpret_cast<IDxcBlob**>(&pBlob)))
+            return {};
+
+        // Resource names in the map may be owned by the resource signatures, so make copies
+        ResourceBinding::TMap ResourceMapCopy;
+        for (const auto& it : ResourceMap)
+            ResourceMapCopy.emplace(HashMapStringKey{it.first.GetStr(), true}, it.second);
+
+        std::lock_guard<std::mutex> Lock{m_RemapMtx};
+        m_RemappedDXIL.emplace_back(std::move(ResourceMapCopy), pBlob);
+        return pBlob;
+    }
+
+    CHECK_D3D_RESULT_THROW(D3DCreateBlob(Size, &pBlob), "Failed to create D3D blob");
+    memcpy(pBlob->GetBufferPointer(), pBytecode, Size);
+
+    std::shared_ptr<const DXBCUtils::ResourceBindingPatchTable> pPatchTable;
+    {
+        std::lock_guard<std::mutex> Lock{m_RemapMtx};
+        pPatchTable = m_pBindingPatchTable;
+    }
+
+    if (pPatchTable)
+    {
+        if (!DXBCUtils::PatchResourceBindings(*pPatchTable, ResourceMap, pBlob->GetBufferPointer(), Size))
+            return {};
+    }
+    else
+    {
+        auto pNewPatchTable = std::make_shared<DXBCUtils::ResourceBindingPatchTable>();
+        if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBlob->GetBufferPointer(), Size, pNewPatchTable.get()))
+            return {};
+
+        std::lock_guard<std::mutex> Lock{m_RemapMtx};
+        if (!m_pBindingPatchTable)
+            m_pBindingPatchTable = std::move(pNewPatchTable);
+    }
+
+    return pBlob;
+}
+
 } // namespace Diligent
@@ -281,6 +281,19 @@ public:
         Queue.Mtx.unlock();
     }
 
+    /// Implementation of IRenderDevice::GetStatistics() that adds the command queue statistics.
+    virtual void DILIGENT_CALL_TYPE GetStatistics(DeviceStatistics& Stats) const override
+    {
+        TBase::GetStatistics(Stats);
+        for (size_t q = 0; q < m_CmdQueueCount; ++q)
+        {
+            const CommandQueue& Queue = m_CommandQueues[q];
+            Stats.CommandBufferCount          += Queue.NextCmdBufferNumber.load(std::memory_order_relaxed);
+            Stats.StaleResourceCount          += Queue.ReleaseQueue.GetStaleResourceCount();
+            Stats.PendingReleaseResourceCount += Queue.ReleaseQueue.GetPendingReleaseResourceCount();
+        }
+    }
+
 protected:
     void DestroyCommandQueues()
     {
@@ -302,7 +315,7 @@ protected:
     {
         CommandQueue(RefCntAutoPtr<CommandQueueType> _CmdQueue, IMemoryAllocator& Allocator) noexcept :
             CmdQueue{std::move(_CmdQueue)},
-            ReleaseQueue{Allocator}
+            ReleaseQueue{Allocator, MEMORY_ALLOCATION_TAG_RELEASE_QUEUE}
         {
             NextCmdBufferNumber.store(0);
         }
@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "EngineGLImplTraits.hpp"
 #include "BufferBase.hpp"
 #include "BufferViewGLImpl.hpp" // Required by BufferBase
@@ -83,15 +85,35 @@ public:
     /// Implementation of IBuffer::GetSparseProperties().
     virtual SparseBufferProperties DILIGENT_CALL_TYPE GetSparseProperties() const override final;
 
+    /// Returns true if the buffer is a persistently mapped ring of regions (see MapRange()).
+    bool IsPersistentlyMapped() const { return m_pPersistentData != nullptr; }
+
+    /// Returns the offset of the region that contains the current buffer data.
+    /// The offset must be added to any range the buffer is bound with.
+    Uint64 GetRegionOffset() const { return Uint64{m_CurrRegion} * m_RegionSize; }
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
     friend class DeviceContextGLImpl;
     friend class VAOCache;
 
+    void AdvanceRegion();
+
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+
+    // Dynamic uniform buffers use immutable storage of NumRegions regions that is
+    // persistently mapped. Every map with MAP_FLAG_DISCARD moves to the next region,
+    // and the fence of the region guarantees that the GPU does not read it anymore.
+    static constexpr Uint32 NumRegions = 3;
+
+    Uint8* m_pPersistentData = nullptr;
+    Uint64 m_RegionSize      = 0;
+    Uint32 m_CurrRegion      = 0;
+
+    std::array<GLObjectWrappers::GLSyncObj, NumRegions> m_RegionFences;
 };
 
 void BufferGLImpl::BufferMemoryBarrier(MEMORY_BARRIER RequiredBarriers, GLContextState& GLState)
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <unordered_map>
 
 #include "EngineGLImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -43,6 +45,7 @@
 
 #include "GLContextState.hpp"
 #include "GLObjectWrapper.hpp"
+#include "GLCommandStream.hpp"
 
 namespace Diligent
 {
@@ -241,6 +244,9 @@ public:
     /// Implementation of IDeviceContext::BuildBLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -288,6 +294,15 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in OpenGL backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContextGL::UpdateCurrentGLContext().
     virtual bool DILIGENT_CALL_TYPE UpdateCurrentGLContext() override final;
 
@@ -352,6 +367,15 @@ private:
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
+
+    // Commands recorded by a deferred context. The commands are replayed
+    // by the immediate context in ExecuteCommandLists().
+    std::unique_ptr<GLCommandStream> m_pCommands;
+
+    // Scratch memory for buffers mapped by a deferred context
+    std::unordered_map<IBuffer*, void*> m_DeferredMappedBuffers;
+
+    FixedBlockMemoryAllocator m_CmdListAllocator;
 };
 
 } // namespace Diligent
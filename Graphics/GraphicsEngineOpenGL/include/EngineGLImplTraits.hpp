@@ -44,6 +44,8 @@
 #include "RenderPass.h"
 #include "Framebuffer.h"
 #include "PipelineResourceSignature.h"
+#include "PipelineStateCache.h"
+#include "CommandList.h"
 #include "DeviceContextGL.h"
 #include "BaseInterfacesGL.h"
 
@@ -69,8 +71,8 @@ class TopLevelASGLImpl;
 class ShaderBindingTableGLImpl;
 class PipelineResourceSignatureGLImpl;
 class DeviceMemoryGLImpl;
-class PipelineStateCacheGlImpl
-{};
+class PipelineStateCacheGLImpl;
+class CommandListGLImpl;
 
 class FixedBlockMemoryAllocator;
 
@@ -105,6 +107,8 @@ struct EngineGLImplTraits
     using RenderPassInterface                = IRenderPass;
     using FramebufferInterface               = IFramebuffer;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
+    using PipelineStateCacheInterface        = IPipelineStateCache;
+    using CommandListInterface               = ICommandList;
 
     using RenderDeviceImplType              = RenderDeviceGLImpl;
     using DeviceContextImplType             = DeviceContextGLImpl;
@@ -125,7 +129,8 @@ struct EngineGLImplTraits
     using ShaderBindingTableImplType        = ShaderBindingTableGLImpl;
     using PipelineResourceSignatureImplType = PipelineResourceSignatureGLImpl;
     using DeviceMemoryImplType              = DeviceMemoryGLImpl;
-    using PipelineStateCacheImplType        = PipelineStateCacheGlImpl;
+    using PipelineStateCacheImplType        = PipelineStateCacheGLImpl;
+    using CommandListImplType               = CommandListGLImpl;
 
     using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
     using TexViewObjAllocatorType  = FixedBlockMemoryAllocator;
@@ -27,8 +27,12 @@
 
 #pragma once
 
+#include <list>
+#include <unordered_set>
+
 #include "GraphicsTypes.h"
 #include "TextureView.h"
+#include "Framebuffer.h"
 #include "SpinLock.hpp"
 #include "HashUtils.hpp"
 #include "GLObjectWrapper.hpp"
@@ -42,7 +46,11 @@ class GLContextState;
 class FBOCache
 {
 public:
-    FBOCache();
+    // Default maximum number of FBOs kept in the cache. When the limit is reached,
+    // the least recently used FBO is released.
+    static constexpr size_t DefaultMaxSize = 256;
+
+    explicit FBOCache(size_t MaxSize = DefaultMaxSize);
     ~FBOCache();
 
     // clang-format off
@@ -62,8 +70,15 @@ public:
                                                      TextureViewGLImpl* pDSV,
                                                      GLContextState&    ContextState);
 
+    /// Creates FBOs for all subpasses of the framebuffer that do not use the default framebuffer,
+    /// so that subsequent GetFBO() calls with the same attachments do not create new objects.
+    /// NB: the method overwrites framebuffer bindings if it needs to create new FBOs.
+    void PrewarmFramebuffer(const FramebufferDesc& Desc, GLContextState& ContextState);
+
     void OnReleaseTexture(ITexture* pTexture);
 
+    size_t GetSize() const { return m_Cache.size(); }
+
 private:
     // This structure is used as the key to find FBO
     struct FBOCacheKey
@@ -90,14 +105,67 @@ private:
         std::size_t operator()(const FBOCacheKey& Key) const noexcept;
     };
 
+    struct FBOCacheEntry
+    {
+        GLObjectWrappers::GLFrameBufferObj FBO;
+
+        // Position of the key in the LRU list
+        std::list<FBOCacheKey>::iterator LRUIt;
+    };
+
+    static FBOCacheKey CreateKey(Uint32             NumRenderTargets,
+                                 TextureViewGLImpl* ppRTVs[],
+                                 TextureViewGLImpl* pDSV);
+
+    static void AttachTargets(Uint32             NumRenderTargets,
+                              TextureViewGLImpl* ppRTVs[],
+                              TextureViewGLImpl* pDSV);
+
+    static GLenum GetDepthAttachmentPoint(const TextureViewGLImpl& DSV);
+
+    static bool CheckFramebufferStatus();
+
+    // Hash of the attachment formats, sample counts and view types that determine
+    // the framebuffer completeness. Attachment sizes do not affect it since GL3.0.
+    static size_t ComputeLayoutHash(Uint32             NumRenderTargets,
+                                    TextureViewGLImpl* ppRTVs[],
+                                    TextureViewGLImpl* pDSV);
+
+    // The methods below must be called with m_CacheLock acquired
+    const GLObjectWrappers::GLFrameBufferObj& FindOrCreateFBO(const FBOCacheKey& Key,
+                                                              TextureViewGLImpl* ppRTVs[],
+                                                              TextureViewGLImpl* pDSV,
+                                                              GLContextState&    ContextState);
+
+    const GLObjectWrappers::GLFrameBufferObj& RebindFBO(const FBOCacheKey& Key,
+                                                        TextureViewGLImpl* pRTV,
+                                                        TextureViewGLImpl* pDSV,
+                                                        GLContextState&    ContextState);
+
+    void EraseEntry(const FBOCacheKey& Key);
 
     friend class RenderDeviceGLImpl;
-    Threading::SpinLock                                                                      m_CacheLock;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    Threading::SpinLock                                                 m_CacheLock;
+    std::unordered_map<FBOCacheKey, FBOCacheEntry, FBOCacheKeyHashFunc> m_Cache;
+
+    // Most recently used keys are at the front of the list
+    std::list<FBOCacheKey> m_LRUList;
+
+    const size_t m_MaxSize;
 
     // Multimap that sets up correspondence between unique texture id and all
     // FBOs it is used in
     std::unordered_multimap<UniqueIdentifier, FBOCacheKey> m_TexIdToKey;
+
+    // Layouts of the framebuffers that were found to be complete.
+    // FBOs with these layouts are not validated again in release builds.
+    std::unordered_set<size_t> m_ValidatedLayouts;
+
+    // When the cache is full, the common "one color + depth" combination is not
+    // cached, but is attached to this single FBO instead of evicting other entries.
+    GLObjectWrappers::GLFrameBufferObj m_RebindableFBO{false};
+    FBOCacheKey                        m_RebindableKey;
+    GLenum                             m_RebindableDSAttachment = 0;
 };
 
 } // namespace Diligent
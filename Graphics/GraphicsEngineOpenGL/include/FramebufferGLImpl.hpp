@@ -31,6 +31,7 @@
 /// Declaration of Diligent::FramebufferGLImpl class
 
 #include <vector>
+#include <array>
 
 #include "EngineGLImplTraits.hpp"
 #include "FramebufferBase.hpp"
@@ -63,6 +64,17 @@ public:
 
         GLObjectWrappers::GLFrameBufferObj RenderTarget;
         GLObjectWrappers::GLFrameBufferObj Resolve;
+
+        // Index of the subpass whose RenderTarget FBO is used by this subpass.
+        // When framebuffer fetch is enabled, consecutive subpasses that read input attachments
+        // written by previous subpasses share a single FBO, so that the attachments stay in tile memory.
+        Uint32 RenderTargetSubpass = 0;
+
+        // Draw buffers of a subpass that shares the FBO with other subpasses.
+        // Render target i is written to location i, while input attachment k that is not
+        // a render target of the subpass is available for framebuffer fetch at location RenderTargetAttachmentCount + k.
+        Uint32                                 NumDrawBuffers = 0;
+        std::array<GLenum, MAX_RENDER_TARGETS> DrawBuffers    = {};
     };
 
     const SubpassFramebuffers& GetSubpassFramebuffer(Uint32 subpass)
@@ -70,7 +82,24 @@ public:
         return m_SubpassFramebuffers[subpass];
     }
 
+    const GLObjectWrappers::GLFrameBufferObj& GetSubpassRenderTarget(Uint32 subpass)
+    {
+        return m_SubpassFramebuffers[m_SubpassFramebuffers[subpass].RenderTargetSubpass].RenderTarget;
+    }
+
+    // Returns true if the next subpass uses the same FBO as this one
+    bool IsMergedWithNextSubpass(Uint32 subpass) const
+    {
+        return subpass + 1 < m_SubpassFramebuffers.size() &&
+            m_SubpassFramebuffers[subpass + 1].RenderTargetSubpass == m_SubpassFramebuffers[subpass].RenderTargetSubpass;
+    }
+
 private:
+    void InitMergedSubpass(Uint32          Subpass,
+                           Uint32          GroupStart,
+                           Uint32          GroupEnd,
+                           GLContextState& CtxState);
+
     std::vector<SubpassFramebuffers> m_SubpassFramebuffers;
 };
 
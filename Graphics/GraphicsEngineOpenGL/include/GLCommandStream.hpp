@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <vector>
+#include <type_traits>
+
+#include "DynamicLinearAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+class DeviceContextGLImpl;
+
+/// Compact stream of device context commands recorded by a deferred context.
+
+/// Commands are stored in linear memory pages and are replayed on the immediate context
+/// by calling the same DeviceContextGLImpl methods. Commands may only capture raw pointers
+/// and plain data: objects are kept alive with KeepAlive(), and arrays and user data
+/// are copied into the stream memory with CopyArray() and Allocate().
+class GLCommandStream
+{
+public:
+    explicit GLCommandStream(IMemoryAllocator& Allocator);
+    ~GLCommandStream();
+
+    // clang-format off
+    GLCommandStream           (const GLCommandStream&) = delete;
+    GLCommandStream           (GLCommandStream&&)      = delete;
+    GLCommandStream& operator=(const GLCommandStream&) = delete;
+    GLCommandStream& operator=(GLCommandStream&&)      = delete;
+    // clang-format on
+
+    template <typename HandlerType>
+    void Record(HandlerType&& Handler)
+    {
+        using CommandType = Command<typename std::decay<HandlerType>::type>;
+        static_assert(std::is_trivially_destructible<CommandType>::value,
+                      "Commands are never destroyed and must only capture raw pointers and plain data");
+        m_Commands.emplace_back(m_Allocator.Construct<CommandType>(std::forward<HandlerType>(Handler)));
+    }
+
+    template <typename ObjectType>
+    ObjectType* KeepAlive(ObjectType* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+        return pObject;
+    }
+
+    template <typename T>
+    T* CopyArray(const T* pSrc, size_t Count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be copied into the stream");
+        if (pSrc == nullptr || Count == 0)
+            return nullptr;
+        auto* pDst = m_Allocator.Allocate<T>(Count);
+        memcpy(pDst, pSrc, sizeof(T) * Count);
+        return pDst;
+    }
+
+    void* Allocate(size_t Size)
+    {
+        return m_Allocator.Allocate(Size, 16);
+    }
+
+    const Char* CopyString(const Char* Str)
+    {
+        return m_Allocator.CopyString(Str);
+    }
+
+    /// Replays all recorded commands on the given context.
+    void Execute(DeviceContextGLImpl& Ctx) const;
+
+    /// Releases all objects and recorded commands.
+    void Reset();
+
+    bool IsEmpty() const { return m_Commands.empty(); }
+
+private:
+    struct CommandBase
+    {
+        virtual void Execute(DeviceContextGLImpl& Ctx) const = 0;
+    };
+
+    template <typename HandlerType>
+    struct Command final : CommandBase
+    {
+        template <typename ArgType>
+        explicit Command(ArgType&& _Handler) :
+            Handler{std::forward<ArgType>(_Handler)}
+        {}
+
+        virtual void Execute(DeviceContextGLImpl& Ctx) const override final
+        {
+            Handler(Ctx);
+        }
+
+        const HandlerType Handler;
+    };
+
+    DynamicLinearAllocator m_Allocator;
+
+    std::vector<const CommandBase*> m_Commands;
+
+    // Objects referenced by the recorded commands
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
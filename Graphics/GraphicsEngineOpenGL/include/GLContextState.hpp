@@ -28,6 +28,7 @@
 #pragma once
 
 #include <limits>
+#include <vector>
 
 #include "GraphicsTypes.h"
 #include "GLObjectWrapper.hpp"
@@ -88,6 +89,29 @@ public:
 
     // clang-format on
 
+    /// Starts a batch of texture, sampler, uniform buffer and storage block bindings.
+
+    /// \remarks   When multi-bind (GL4.4 or GL_ARB_multi_bind) is supported, the bindings that
+    ///            change the state are not applied until CommitBindings() is called, which issues
+    ///            a single call per contiguous range of changed slots. Otherwise, the bindings are
+    ///            applied immediately. Other commands must not be issued until the batch is committed.
+    void BeginBindingBatch();
+
+    /// Applies the bindings recorded since the last call to BeginBindingBatch().
+    void CommitBindings();
+
+    /// Resource binding statistics.
+    struct BindingStats
+    {
+        /// The number of GL calls issued to bind textures, samplers, images and buffers.
+        Uint64 NumGLCalls = 0;
+
+        /// The number of bindings skipped because the same object was already bound.
+        Uint64 NumSkipped = 0;
+    };
+    const BindingStats& GetBindingStats() const { return m_BindingStats; }
+    void                ResetBindingStats() { m_BindingStats = {}; }
+
     void SetNumPatchVertices(Int32 NumVertices);
     void Invalidate();
 
@@ -110,11 +134,13 @@ public:
 
     struct ContextCaps
     {
-        bool  IsFillModeSelectionSupported = true;
-        bool  IsProgramPipelineSupported   = true;
-        GLint MaxCombinedTexUnits          = 0;
-        GLint MaxDrawBuffers               = 0;
-        GLint MaxUniformBufferBindings     = 0;
+        bool  IsFillModeSelectionSupported   = true;
+        bool  IsProgramPipelineSupported     = true;
+        bool  IsMultiBindSupported           = false;
+        bool  IsVertexAttribBindingSupported = false;
+        GLint MaxCombinedTexUnits            = 0;
+        GLint MaxDrawBuffers                 = 0;
+        GLint MaxUniformBufferBindings       = 0;
     };
     const ContextCaps& GetContextCaps() { return m_Caps; }
 
@@ -207,6 +233,34 @@ private:
     std::vector<BoundImageInfo>   m_BoundImages;
     std::vector<BoundBufferInfo>  m_BoundStorageBlocks;
 
+    // Bindings recorded in the current batch that are committed with multi-bind functions
+    struct PendingBindings
+    {
+        std::vector<GLuint>     Handles;
+        std::vector<GLintptr>   Offsets; // Buffers only
+        std::vector<GLsizeiptr> Sizes;   // Buffers only
+        std::vector<bool>       Dirty;
+
+        Uint32 FirstDirty = ~0u;
+        Uint32 LastDirty  = 0;
+
+        void Set(Uint32 Slot, GLuint Handle, GLintptr Offset = 0, GLsizeiptr Size = 0);
+
+        // Calls BindRange(First, Count) for every contiguous range of dirty slots
+        template <typename BindRangeFuncType>
+        Uint32 Flush(BindRangeFuncType&& BindRange);
+
+        void Reset();
+    };
+    PendingBindings m_PendingTextures;
+    PendingBindings m_PendingSamplers;
+    PendingBindings m_PendingUniformBuffers;
+    PendingBindings m_PendingStorageBlocks;
+
+    bool m_IsBindingBatchActive = false;
+
+    BindingStats m_BindingStats;
+
     MEMORY_BARRIER m_PendingMemoryBarriers = MEMORY_BARRIER_NONE;
 
     class EnableStateHelper
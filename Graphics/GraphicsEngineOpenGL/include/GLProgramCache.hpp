@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "RefCntAutoPtr.hpp"
+#include "SpinLock.hpp"
+#include "UniqueIdentifier.hpp"
+#include "GLObjectWrapper.hpp"
+#include "GLContext.hpp"
+
+namespace Diligent
+{
+
+class PipelineResourceSignatureGLImpl;
+
+/// Cache of linked programs shared by pipeline states.
+
+/// Resource bindings that PipelineResourceSignatureGLImpl::ApplyBindings() assigns to the programs
+/// only depend on the shaders and the resource signatures, while blend, depth-stencil and rasterizer
+/// states are set dynamically in OpenGL. Pipeline states that only differ by these states therefore
+/// share the programs and the program pipelines. Program sets are owned by the pipeline states, and
+/// the cache only keeps weak references to them.
+class GLProgramCache
+{
+public:
+    /// Programs of a pipeline state.
+    struct ProgramSet
+    {
+        bool                          IsSeparable = false;
+        std::vector<UniqueIdentifier> ShaderIds;
+
+        // Resource signatures that define the resource bindings of the programs. Null signatures are allowed.
+        std::vector<RefCntAutoPtr<PipelineResourceSignatureGLImpl>> Signatures;
+
+        // One program for every shader stage when separable programs are used, and a single program otherwise.
+        std::vector<GLObjectWrappers::GLProgramObj> Programs;
+        std::vector<SHADER_TYPE>                    ShaderTypes;
+
+        // Resource bindings have been applied to the programs. Only initialized sets are added to the cache.
+        bool IsInitialized = false;
+
+        /// Returns the program pipeline for the given GL context, creating it if necessary.
+        GLObjectWrappers::GLPipelineObj& GetProgramPipeline(GLContext::NativeGLContextType Context, const char* Name);
+
+    private:
+        Threading::SpinLock                                                                     m_PipelinesLock;
+        std::vector<std::pair<GLContext::NativeGLContextType, GLObjectWrappers::GLPipelineObj>> m_Pipelines;
+    };
+    using ProgramSetPtr = std::shared_ptr<ProgramSet>;
+
+    /// Returns the initialized program set that has the same shaders and binds the resources identically
+    /// to the given one, or null if there is no such set in the cache.
+    ProgramSetPtr Find(const ProgramSet& Key);
+
+    /// Adds the initialized program set to the cache. If an equivalent set has been added by another
+    /// thread, returns that set. Otherwise, returns pSet.
+    ProgramSetPtr Add(ProgramSetPtr pSet);
+
+private:
+    ProgramSetPtr FindUnsafe(const ProgramSet& Key, size_t Hash);
+
+    std::mutex                                                 m_Mtx;
+    std::unordered_multimap<size_t, std::weak_ptr<ProgramSet>> m_Sets;
+};
+
+} // namespace Diligent
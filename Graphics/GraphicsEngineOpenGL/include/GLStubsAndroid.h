@@ -259,6 +259,11 @@
 #   define GL_PROGRAM_SEPARABLE 0x8258
 #endif
 
+// Program binaries are core in GLES3.0
+#ifndef GL_ARB_get_program_binary
+#   define GL_ARB_get_program_binary 1
+#endif
+
 // Define unsupported uniform data types
 #ifndef GL_SAMPLER_1D
     #define GL_SAMPLER_1D 0x8B5D
@@ -944,6 +949,17 @@
 #   define GL_KHR_debug 1
 #endif
 
+#ifndef GL_KHR_parallel_shader_compile
+#   define GL_KHR_parallel_shader_compile 1
+#   define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#   define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (GL_APIENTRY* PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+#endif
+
+// GL_KHR_parallel_shader_compile
+#define LOAD_GL_MAX_SHADER_COMPILER_THREADS
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
+
 #ifndef GL_DEBUG_OUTPUT
 #   define GL_DEBUG_OUTPUT 0x92E0
 #endif
@@ -1165,8 +1181,24 @@ void UnsupportedGLFunctionStub( const T &Name )
     typedef void (GL_APIENTRY* PFNGLSHADERSTORAGEBLOCKBINDINGPROC) (GLuint program, GLuint storageBlockIndex, GLuint storageBlockBinding);
     extern PFNGLSHADERSTORAGEBLOCKBINDINGPROC glShaderStorageBlockBinding;
 
+    #define LOAD_GL_VERTEX_ATTRIB_BINDING
+    typedef void (GL_APIENTRY* PFNGLBINDVERTEXBUFFERPROC) (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
+    typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBFORMATPROC) (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset);
+    typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBIFORMATPROC) (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset);
+    typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBBINDINGPROC) (GLuint attribindex, GLuint bindingindex);
+    typedef void (GL_APIENTRY* PFNGLVERTEXBINDINGDIVISORPROC) (GLuint bindingindex, GLuint divisor);
+    extern PFNGLBINDVERTEXBUFFERPROC     glBindVertexBuffer;
+    extern PFNGLVERTEXATTRIBFORMATPROC   glVertexAttribFormat;
+    extern PFNGLVERTEXATTRIBIFORMATPROC  glVertexAttribIFormat;
+    extern PFNGLVERTEXATTRIBBINDINGPROC  glVertexAttribBinding;
+    extern PFNGLVERTEXBINDINGDIVISORPROC glVertexBindingDivisor;
+
 #endif //GL_ES_VERSION_3_1
 
+#ifndef GL_ARB_vertex_attrib_binding
+#   define GL_ARB_vertex_attrib_binding 1
+#endif
+
 // GL_OES_texture_buffer or GL_EXT_texture_buffer or 3.2
 #define LOAD_GL_TEX_BUFFER
 typedef void (GL_APIENTRY* PFNGLTEXBUFFERPROC) (GLenum target, GLenum internalformat, GLuint buffer);
@@ -1256,6 +1288,23 @@ extern PFNGLTEXSTORAGE3DMULTISAMPLEPROC glTexStorage3DMultisample;
 typedef void (GL_APIENTRY* PFNGLTEXTUREVIEWPROC) (GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers);
 extern PFNGLTEXTUREVIEWPROC glTextureView;
 
+#ifndef GL_ARB_buffer_storage
+#   define GL_ARB_buffer_storage 1
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#   define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#   define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+// GL_EXT_buffer_storage
+#define LOAD_GL_BUFFER_STORAGE
+typedef void (GL_APIENTRY* PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC glBufferStorage;
+
 // GL_EXT_base_instance
 #define LOAD_GL_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE
 typedef void (GL_APIENTRY* PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance);
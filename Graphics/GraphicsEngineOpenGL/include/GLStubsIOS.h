@@ -61,6 +61,7 @@
 #define GL_ARB_program_interface_query      0
 #define GL_ARB_internalformat_query2        0
 #define GL_ARB_texture_storage_multisample  0
+#define GL_ARB_get_program_binary           1
 
 #ifndef GL_CLAMP_TO_BORDER
 #    define GL_CLAMP_TO_BORDER GL_CLAMP_TO_EDGE
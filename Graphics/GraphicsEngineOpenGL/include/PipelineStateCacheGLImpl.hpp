@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheGLImpl class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineGLImplTraits.hpp"
+#include "PipelineStateCacheBase.hpp"
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+class ShaderGLImpl;
+
+/// Pipeline state cache implementation in OpenGL backend.
+
+/// The cache stores linked program binaries (see glGetProgramBinary) keyed by the hash of
+/// the GLSL sources of the program shaders. Program binaries are only compatible with the
+/// same GPU and driver version, so the data also records the device key and is discarded
+/// when it does not match the current device.
+class PipelineStateCacheGLImpl final : public PipelineStateCacheBase<EngineGLImplTraits>
+{
+public:
+    using TPipelineStateCacheBase = PipelineStateCacheBase<EngineGLImplTraits>;
+
+    PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceGLImpl*                 pDevice,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheGLImpl();
+
+    /// Implementation of IPipelineStateCache::GetData() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    /// Implementation of IPipelineStateCache::Merge() in OpenGL backend.
+    virtual Bool DILIGENT_CALL_TYPE Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches) override final;
+
+    /// Computes the cache key of the program linked from the given shaders.
+    static size_t ComputeProgramHash(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+
+    /// Creates the program from the cached binary.
+
+    /// \return     The linked program, or null if the binary is not in the cache
+    ///             or was rejected by the driver.
+    GLObjectWrappers::GLProgramObj LoadProgram(size_t ProgramHash, bool IsSeparableProgram);
+
+    /// Retrieves the binary of the linked program and adds it to the cache.
+    void StoreProgram(size_t ProgramHash, GLuint GLProg);
+
+private:
+    bool Deserialize(const void* pData, size_t DataSize);
+
+    // Records the result of a program binary lookup in the device and cache statistics
+    // and in the compilation record of the pipeline
+    void OnProgramLookup(bool Hit);
+
+private:
+    struct ProgramBinary
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+
+    // GL_VENDOR, GL_RENDERER and GL_VERSION strings of the device the binaries were created with
+    std::string m_DeviceKey;
+
+    std::mutex                                m_ProgramsMtx;
+    std::unordered_map<size_t, ProgramBinary> m_Programs;
+};
+
+} // namespace Diligent
@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "EngineGLImplTraits.hpp"
@@ -37,6 +38,7 @@
 
 #include "GLObjectWrapper.hpp"
 #include "GLContext.hpp"
+#include "GLProgramCache.hpp"
 
 namespace Diligent
 {
@@ -63,6 +65,13 @@ public:
     /// Queries the specific interface, see IObject::QueryInterface() for details
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
 
+    /// Implementation of IPipelineState::GetStatus() in OpenGL backend.
+
+    /// \remarks  When the driver links programs in parallel, the link status of the pipeline
+    ///           created with PSO_CREATE_FLAG_ASYNCHRONOUS flag is checked by this method,
+    ///           which must be called in the thread that owns the GL context.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final;
+
     void CommitProgram(GLContextState& State);
 
     using TBindings = PipelineResourceSignatureGLImpl::TBindings;
@@ -88,14 +97,24 @@ public:
 #endif
 
 private:
-    GLObjectWrappers::GLPipelineObj& GetGLProgramPipeline(GLContext::NativeGLContextType Context);
-
     template <typename PSOCreateInfoType>
-    void InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages);
+    void InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages, bool DeferLink);
+
+    bool IsParallelLinkEnabled(const PipelineStateCreateInfo& CreateInfo) const;
+    bool IsPendingLinkCompleted();
+    void FinishPendingLink() noexcept(false);
 
     void InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalFlags,
                             const TShaderStages&      ShaderStages,
-                            SHADER_TYPE               ActiveStages);
+                            SHADER_TYPE               ActiveStages,
+                            bool                      bCreateDefaultSignature);
+
+    void CreateDefaultSignature(PSO_CREATE_INTERNAL_FLAGS InternalFlags,
+                                const TShaderStages&      ShaderStages,
+                                SHADER_TYPE               ActiveStages);
+
+    // Looks up the linked programs with the same shaders and resource bindings in the device program cache.
+    bool FindCachedPrograms();
 
     PipelineResourceSignatureDescWrapper GetDefaultSignatureDesc(
         const TShaderStages& ShaderStages,
@@ -104,7 +123,7 @@ private:
     void Destruct();
 
     SHADER_TYPE GetShaderStageType(Uint32 Index) const;
-    Uint32      GetNumShaderStages() const { return m_NumPrograms; }
+    Uint32      GetNumShaderStages() const { return static_cast<Uint32>(m_pProgramSet->Programs.size()); }
 
     void ValidateShaderResources(std::shared_ptr<const ShaderResourcesGL> pShaderResources, const char* ShaderName, SHADER_TYPE ShaderStages);
 
@@ -113,22 +132,30 @@ private:
     PIPELINE_RESOURCE_FLAGS GetSamplerResourceFlag(const TShaderStages& Stages, bool SilenceWarning) const;
 
 private:
-    // Linked GL programs for every shader stage. Every pipeline needs to have its own programs
-    // because resource bindings assigned by PipelineResourceSignatureGLImpl::ApplyBindings depend on other
-    // shader stages.
-    using GLProgramObj         = GLObjectWrappers::GLProgramObj;
-    GLProgramObj* m_GLPrograms = nullptr; // [m_NumPrograms]
-
-    Threading::SpinLock m_ProgPipelineLock;
-
-    std::vector<std::pair<GLContext::NativeGLContextType, GLObjectWrappers::GLPipelineObj>> m_GLProgPipelines;
+    // Linked GL programs for every shader stage and their program pipelines. Resource bindings assigned
+    // by PipelineResourceSignatureGLImpl::ApplyBindings depend on all shader stages and signatures,
+    // so the programs are shared only with pipelines that use the same shaders and bind resources
+    // identically (see GLProgramCache).
+    GLProgramCache::ProgramSetPtr m_pProgramSet;
 
-    Uint8        m_NumPrograms                = 0;
-    bool         m_IsProgramPipelineSupported = false;
-    SHADER_TYPE* m_ShaderTypes                = nullptr; // [m_NumPrograms]
+    bool m_IsProgramPipelineSupported = false;
 
     TBindings* m_BaseBindings = nullptr; // [m_SignatureCount]
 
+    // Programs that are being linked by the driver in parallel (see GL_KHR_parallel_shader_compile).
+    // The resource layout is initialized once all programs are linked.
+    struct PendingLinkInfo
+    {
+        std::vector<RefCntAutoPtr<ShaderGLImpl>> Shaders;
+        RefCntAutoPtr<PipelineStateCacheGLImpl>  pPSOCache;
+        PSO_CREATE_INTERNAL_FLAGS                InternalFlags = PSO_CREATE_INTERNAL_FLAG_NONE;
+        SHADER_TYPE                              ActiveStages  = SHADER_TYPE_UNKNOWN;
+
+        // Indices of the programs in m_pProgramSet->Programs and their PSO cache keys
+        std::vector<std::pair<Uint32, size_t>> LinkingPrograms;
+    };
+    std::unique_ptr<PendingLinkInfo> m_pPendingLink;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages in the pipeline.
     std::vector<std::shared_ptr<const ShaderResourcesGL>> m_ShaderResources;
@@ -36,10 +36,13 @@
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
 #include "TexRegionRender.hpp"
+#include "GLProgramCache.hpp"
 
 namespace Diligent
 {
 
+class HLSL2GLSLTokenCache;
+
 /// Render device implementation in OpenGL backend.
 // RenderDeviceGLESImpl is inherited from RenderDeviceGLImpl
 class RenderDeviceGLImpl : public RenderDeviceBase<EngineGLImplTraits>
@@ -97,6 +100,10 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo,
                                                                 IPipelineState**                       ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreateDerivedGraphicsPipelineState() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo,
+                                                                       IPipelineState**                              ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateComputePipelineState() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo,
                                                                IPipelineState**                      ppPipelineState) override final;
@@ -195,6 +202,8 @@ public:
     void      OnDestroyPSO(PipelineStateGLImpl& PSO);
     void      OnDestroyBuffer(BufferGLImpl& Buffer);
 
+    GLProgramCache& GetProgramCache() { return m_ProgramCache; }
+
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
@@ -209,6 +218,17 @@ public:
     };
     const GLDeviceLimits& GetDeviceLimits() const { return m_DeviceLimits; }
 
+    /// Returns true if the driver compiles shaders and links programs in parallel
+    /// (GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile).
+    bool IsParallelShaderCompileSupported() const { return m_IsParallelShaderCompileSupported; }
+
+    /// Returns true if immutable buffer storage that can be persistently mapped is supported
+    /// (GL4.4, GL_ARB_buffer_storage or GL_EXT_buffer_storage).
+    bool IsBufferStorageSupported() const { return m_IsBufferStorageSupported; }
+
+    /// Returns true if resident bindless texture handles are supported (GL_ARB_bindless_texture).
+    bool IsBindlessTextureSupported() const { return m_IsBindlessTextureSupported; }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -230,8 +250,15 @@ protected:
     Threading::SpinLock                                          m_FBOCacheLock;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
 
+    // Pipeline states with identical shaders and resource bindings share linked programs.
+    GLProgramCache m_ProgramCache;
+
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
 
+    // Shaders converted from the same HLSL source share the tokenized source.
+    // shared_ptr does not require the complete type, which is not available when HLSL support is disabled.
+    std::shared_ptr<HLSL2GLSLTokenCache> m_pHLSL2GLSLTokenCache;
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
     bool         CheckExtension(const Char* ExtensionString) const;
@@ -240,6 +267,15 @@ private:
 
     int m_ShowDebugGLOutput = 1;
 
+    // Whether the driver supports at least one program binary format
+    bool m_IsProgramBinarySupported = false;
+
+    bool m_IsParallelShaderCompileSupported = false;
+
+    bool m_IsBufferStorageSupported = false;
+
+    bool m_IsBindlessTextureSupported = false;
+
     GLDeviceLimits m_DeviceLimits = {};
 };
 
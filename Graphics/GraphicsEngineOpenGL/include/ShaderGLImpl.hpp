@@ -35,6 +35,8 @@
 namespace Diligent
 {
 
+class HLSL2GLSLTokenCache;
+
 /// Shader object implementation in OpenGL backend.
 class ShaderGLImpl final : public ShaderBase<EngineGLImplTraits>
 {
@@ -48,6 +50,9 @@ public:
     {
         const RenderDeviceInfo&    DeviceInfo;
         const GraphicsAdapterInfo& AdapterInfo;
+
+        // Optional cache of tokenized HLSL sources
+        HLSL2GLSLTokenCache* const pHLSL2GLSLTokenCache = nullptr;
     };
 
     ShaderGLImpl(IReferenceCounters*     pRefCounters,
@@ -59,13 +64,40 @@ public:
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
+    /// Implementation of IShader::GetStatus() in OpenGL backend.
+
+    /// \remarks  When the driver compiles shaders in parallel, the compile status of the shader
+    ///           created with SHADER_COMPILE_FLAG_ASYNCHRONOUS flag is checked by this method,
+    ///           which must be called in the thread that owns the GL context.
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final;
+
     /// Implementation of IShader::GetResourceCount() in OpenGL backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetResourceCount() const override final;
 
     /// Implementation of IShader::GetResource() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
-    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+    /// Links the program from the shaders. If pPSOCache is not null, the program is
+    /// created from the cached binary when possible, and the binary of the newly
+    /// linked program is added to the cache otherwise.
+    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                      Uint32                    NumShaders,
+                                                      bool                      IsSeparableProgram,
+                                                      PipelineStateCacheGLImpl* pPSOCache = nullptr);
+
+    /// Creates the program and issues the link command without waiting for the result,
+    /// so that the driver that supports parallel compilation may link it in the background.
+    static GLObjectWrappers::GLProgramObj StartLinkProgram(ShaderGLImpl* const* ppShaders,
+                                                           Uint32               NumShaders,
+                                                           bool                 IsSeparableProgram,
+                                                           bool                 RetrievableBinary);
+
+    /// Returns true if the program has been linked successfully, and logs the error otherwise.
+    static bool CheckLinkStatus(GLuint GLProg);
+
+    /// Returns true if the driver has finished compiling the shader or linking the program
+    /// (see GL_COMPLETION_STATUS_KHR). Always returns true if parallel compilation is not supported.
+    static bool IsCompletionStatusSet(GLuint GLObject, bool IsProgram);
 
     const std::shared_ptr<const ShaderResourcesGL>& GetShaderResources() const { return m_pShaderResources; }
 
@@ -79,10 +111,20 @@ public:
     }
 
 private:
+    void Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& GLShaderCI) noexcept(false);
+    void FinishCompilation(IDataBlob** ppCompilerOutput) noexcept(false);
+    bool IsCompilationCompleted() const;
+
     const SHADER_SOURCE_LANGUAGE             m_SourceLanguage;
     std::string                              m_GLSLSourceString;
     GLObjectWrappers::GLShaderObj            m_GLShaderObj;
     std::shared_ptr<const ShaderResourcesGL> m_pShaderResources;
+
+    // Program used to reflect shader resources when separable programs are supported
+    GLObjectWrappers::GLProgramObj m_ReflectionProgram{false};
+
+    // Compilation was started by the driver in parallel and its status has not been checked yet
+    bool m_IsCompilationPending = false;
 };
 
 } // namespace Diligent
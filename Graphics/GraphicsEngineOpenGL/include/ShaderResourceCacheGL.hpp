@@ -71,12 +71,12 @@ public:
         Uint32 RangeSize     = 0;
         Uint32 DynamicOffset = 0;
 
-        // In OpenGL dynamic buffers are only those that are not bound as a whole and
-        // can use a dynamic offset, irrespective of the variable type or whether the
-        // buffer is USAGE_DYNAMIC or not.
+        // In OpenGL dynamic buffers are those that are not bound as a whole and
+        // can use a dynamic offset, irrespective of the variable type, as well as
+        // persistently mapped buffers that change the region on every map.
         bool IsDynamic() const
         {
-            return pBuffer && RangeSize < pBuffer->GetDesc().Size;
+            return pBuffer && (RangeSize < pBuffer->GetDesc().Size || pBuffer->IsPersistentlyMapped());
         }
     };
 
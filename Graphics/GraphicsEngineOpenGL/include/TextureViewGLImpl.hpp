@@ -55,9 +55,15 @@ public:
     GLenum GetBindTarget();
     void   SetBindTarget(GLenum ViewTexBindTarget) { m_ViewTexBindTarget = ViewTexBindTarget; }
 
+    /// Implementation of ITextureViewGL::GetBindlessHandle().
+    virtual Uint64 DILIGENT_CALL_TYPE GetBindlessHandle() override final;
+
 protected:
     GLObjectWrappers::GLTextureObj m_ViewTexGLHandle;
     GLenum                         m_ViewTexBindTarget;
+
+    // Resident bindless handle, created on first request
+    Uint64 m_BindlessHandle = 0;
 };
 
 } // namespace Diligent
@@ -68,6 +68,17 @@ public:
                                                      class GLContextState& GLContextState);
     const GLObjectWrappers::GLVertexArrayObj& GetEmptyVAO();
 
+    /// Binds the VAO that defines the vertex format of the pipeline input layout and
+    /// binds the vertex and index buffers to it with glBindVertexBuffer and glBindBuffer.
+    /// Unlike the VAO returned by GetVAO(), this VAO is shared by all pipelines with the same
+    /// input layout and does not depend on the buffers. Requires vertex attrib binding
+    /// (GL4.3, GLES3.1 or GL_ARB_vertex_attrib_binding).
+    ///
+    /// \return    false if the input layout can't be expressed with vertex attrib binding,
+    ///            in which case GetVAO() must be used.
+    bool BindFormatVAO(const VAOAttribs&     Attribs,
+                       class GLContextState& GLContextState);
+
     void OnDestroyBuffer(const BufferGLImpl& Buffer);
     void OnDestroyPSO(const PipelineStateGLImpl& PSO);
 
@@ -126,6 +137,59 @@ private:
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_PSOToKey;
     std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_BuffToKey;
 
+    // Vertex format shared by all pipelines with the same input layout.
+    // Buffer strides are set by glBindVertexBuffer and are not part of the format.
+    struct VertexFormatKey
+    {
+        explicit VertexFormatKey(const InputLayoutDesc& InputLayout);
+
+        std::vector<LayoutElement> Elements;
+
+        size_t Hash = 0;
+
+        bool operator==(const VertexFormatKey& Key) const noexcept
+        {
+            return Hash == Key.Hash && Elements == Key.Elements;
+        }
+
+        struct Hasher
+        {
+            std::size_t operator()(const VertexFormatKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+    };
+
+    struct VertexFormatVAO
+    {
+        GLObjectWrappers::GLVertexArrayObj VAO{false};
+
+        // False if the input layout can't be expressed with vertex attrib binding
+        bool IsSupported = false;
+
+        Uint32 UsedSlotsMask = 0;
+
+        // Buffers that are currently bound to the VAO. Note that the storage of a deleted
+        // buffer is not released by the driver until the slot is rebound.
+        struct BoundStream
+        {
+            UniqueIdentifier BufferUId = -1;
+            Uint64           Offset    = 0;
+            Uint32           Stride    = 0;
+        } Streams[MAX_BUFFER_SLOTS];
+
+        UniqueIdentifier IndexBufferUId = -1;
+    };
+    VertexFormatVAO& GetVertexFormat(const InputLayoutDesc& InputLayout, GLContextState& GLState);
+
+    std::unordered_map<VertexFormatKey, VertexFormatVAO, VertexFormatKey::Hasher> m_FormatVAOs;
+
+    // The format of the last pipeline, which avoids the lookup in m_FormatVAOs
+    // when only the buffers change between draw commands.
+    UniqueIdentifier m_LastFormatPsoUId = -1;
+    VertexFormatVAO* m_pLastFormat      = nullptr;
+
     // Any draw command fails if no VAO is bound. We will use this empty
     // VAO for draw commands with null input layout, such as these that
     // only use VertexID as input.
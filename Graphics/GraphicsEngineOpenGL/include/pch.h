@@ -130,16 +130,33 @@
 #include "RenderDevice.h"
 #include "BaseInterfacesGL.h"
 
-#define CHECK_GL_ERROR(...)                                                                                              \
-    do                                                                                                                   \
-    {                                                                                                                    \
-        auto err = glGetError();                                                                                         \
-        if (err != GL_NO_ERROR)                                                                                          \
-        {                                                                                                                \
-            LogError<false>(/*IsFatal=*/false, __FUNCTION__, __FILE__, __LINE__, __VA_ARGS__, "\nGL Error Code: ", err); \
-            UNEXPECTED("Error");                                                                                         \
-        }                                                                                                                \
-    } while (false)
+// In WebGL, every glGetError() call is a synchronous round trip to the GPU process.
+// In release Emscripten builds, per-call error checks are compiled out and the errors
+// are collected once per frame by DeviceContextGLImpl::FinishFrame().
+// CHECK_GL_ERROR_AND_THROW that guards object creation is not affected.
+#if PLATFORM_EMSCRIPTEN && !defined(DILIGENT_DEVELOPMENT)
+#    define DILIGENT_DEFER_GL_ERROR_CHECKS 1
+#else
+#    define DILIGENT_DEFER_GL_ERROR_CHECKS 0
+#endif
+
+#if DILIGENT_DEFER_GL_ERROR_CHECKS
+#    define CHECK_GL_ERROR(...) \
+        do                      \
+        {                       \
+        } while (false)
+#else
+#    define CHECK_GL_ERROR(...)                                                                                              \
+        do                                                                                                                   \
+        {                                                                                                                    \
+            auto err = glGetError();                                                                                         \
+            if (err != GL_NO_ERROR)                                                                                          \
+            {                                                                                                                \
+                LogError<false>(/*IsFatal=*/false, __FUNCTION__, __FILE__, __LINE__, __VA_ARGS__, "\nGL Error Code: ", err); \
+                UNEXPECTED("Error");                                                                                         \
+            }                                                                                                                \
+        } while (false)
+#endif
 
 #define CHECK_GL_ERROR_AND_THROW(...)                                                                                   \
     do                                                                                                                  \
@@ -42,34 +42,34 @@ static const INTERFACE_ID IID_TextureViewGL =
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
 #define ITextureViewGLInclusiveMethods \
-    ITextureViewInclusiveMethods
-//ITextureViewGLMethods TextureViewGL
-
-#if DILIGENT_CPP_INTERFACE
+    ITextureViewInclusiveMethods;      \
+    ITextureViewGLMethods TextureViewGL
 
 /// Exposes OpenGL-specific functionality of a texture view object.
-DILIGENT_BEGIN_INTERFACE(ITextureViewGL, ITextureView) //
+DILIGENT_BEGIN_INTERFACE(ITextureViewGL, ITextureView)
 {
-    //const GLObjectWrappers::GLTextureObj& GetHandle();
-    //GLenum GetBindTarget();
+    /// Returns a resident bindless texture handle (GL_ARB_bindless_texture) for the view.
+
+    /// The handle is created on the first call and is made resident until the view is destroyed.
+    /// If a sampler is set for the view, the handle combines the texture and the sampler,
+    /// otherwise the texture's own sampling state is used. The handle may be written into a
+    /// structured (storage) buffer and indexed in GLSL shaders that enable GL_ARB_bindless_texture,
+    /// which removes texture unit bindings between draws that only differ in material.
+    ///
+    /// \remarks   Only shader resource views support bindless handles. After the handle
+    ///            has been created, the sampler set for the view must not be changed.
+    ///            The method must only be called from the thread that owns the GL context.
+    ///
+    /// \return    64-bit texture handle, or 0 if GL_ARB_bindless_texture is not supported.
+    VIRTUAL Uint64 METHOD(GetBindlessHandle)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
 
-#endif
-
 #include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
 
 #if DILIGENT_C_INTERFACE
 
-typedef struct ITextureViewGLVtbl
-{
-    ITextureViewGLInclusiveMethods;
-} ITextureViewGLVtbl;
-
-typedef struct ITextureViewGL
-{
-    struct ITextureViewGLVtbl* pVtbl;
-} ITextureViewGL;
+#    define ITextureViewGL_GetBindlessHandle(This) CALL_IFACE_METHOD(TextureViewGL, GetBindlessHandle, This)
 
 #endif
 
@@ -29,11 +29,14 @@
 
 #include "BufferGLImpl.hpp"
 
+#include <limits>
+
 #include "RenderDeviceGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -142,10 +145,37 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
 
     // See also http://www.informit.com/articles/article.aspx?p=2033340&seqNum=2
 
-    // All buffer bind targets (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER etc.) relate to the same
-    // kind of objects. As a result they are all equivalent from a transfer point of view.
-    glBufferData(m_BindTarget, StaticCast<GLsizeiptr>(BuffDesc.Size), pData, m_GLUsageHint);
-    CHECK_GL_ERROR_AND_THROW("glBufferData() failed");
+#if GL_ARB_buffer_storage
+    if (m_Desc.Usage == USAGE_DYNAMIC && m_Desc.BindFlags == BIND_UNIFORM_BUFFER && pDeviceGL->IsBufferStorageSupported())
+    {
+        // Every region must be bindable with glBindBufferRange
+        m_RegionSize = AlignUp(m_Desc.Size, Uint64{pDeviceGL->GetAdapterInfo().Buffer.ConstantBufferOffsetAlignment});
+
+        const auto StorageSize  = StaticCast<GLsizeiptr>(m_RegionSize * NumRegions);
+        const auto StorageFlags = GLbitfield{GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT};
+        glBufferStorage(m_BindTarget, StorageSize, nullptr, StorageFlags);
+        CHECK_GL_ERROR_AND_THROW("glBufferStorage() failed");
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, static_cast<Uint64>(StorageSize));
+
+        // Coherent mapping makes the CPU writes visible to the GPU without explicit flushes
+        m_pPersistentData = static_cast<Uint8*>(glMapBufferRange(m_BindTarget, 0, StorageSize, StorageFlags));
+        CHECK_GL_ERROR_AND_THROW("glMapBufferRange() failed");
+        if (m_pPersistentData == nullptr)
+            LOG_ERROR_AND_THROW("Failed to persistently map buffer '", m_Desc.Name, "'");
+
+        if (pData != nullptr)
+            memcpy(m_pPersistentData, pData, StaticCast<size_t>(m_Desc.Size));
+    }
+    else
+#endif
+    {
+        // All buffer bind targets (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER etc.) relate to the same
+        // kind of objects. As a result they are all equivalent from a transfer point of view.
+        glBufferData(m_BindTarget, StaticCast<GLsizeiptr>(BuffDesc.Size), pData, m_GLUsageHint);
+        CHECK_GL_ERROR_AND_THROW("glBufferData() failed");
+        // OpenGL does not expose the allocation size, so the buffer size is reported
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, BuffDesc.Size);
+    }
     GLState.BindBuffer(m_BindTarget, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
 
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
@@ -254,6 +284,8 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    VERIFY(!IsPersistentlyMapped(), "Persistently mapped buffers can only be written by the CPU");
+    SrcOffset += SrcBufferGL.GetRegionOffset();
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, StaticCast<GLintptr>(SrcOffset), StaticCast<GLintptr>(DstOffset), StaticCast<GLsizeiptr>(Size));
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -267,6 +299,19 @@ void BufferGLImpl::Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFla
 
 void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData)
 {
+    if (m_pPersistentData != nullptr)
+    {
+        VERIFY(MapType == MAP_WRITE, "Persistently mapped buffers can only be mapped for writing");
+        VERIFY(Offset + Length <= m_Desc.Size, "The range is out of buffer bounds");
+        if (MapFlags & MAP_FLAG_DISCARD)
+            AdvanceRegion();
+
+        // With MAP_FLAG_NO_OVERWRITE, the application guarantees that it does not
+        // overwrite the data in the current region that may be in use by the GPU.
+        pMappedData = m_pPersistentData + GetRegionOffset() + Offset;
+        return;
+    }
+
     BufferMemoryBarrier(
         MEMORY_BARRIER_CLIENT_MAPPED_BUFFER, // Access by the client to persistent mapped regions of buffer
                                              // objects will reflect data written by shaders prior to the barrier.
@@ -328,6 +373,12 @@ void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 M
 
 void BufferGLImpl::Unmap(GLContextState& CtxState)
 {
+    if (m_pPersistentData != nullptr)
+    {
+        // The storage is mapped for the whole lifetime of the buffer
+        return;
+    }
+
     constexpr bool ResetVAO = true;
     CtxState.BindBuffer(m_BindTarget, m_GlBuffer, ResetVAO);
     auto Result = glUnmapBuffer(m_BindTarget);
@@ -343,6 +394,29 @@ void BufferGLImpl::Unmap(GLContextState& CtxState)
     (void)Result;
 }
 
+void BufferGLImpl::AdvanceRegion()
+{
+    // Fence all commands issued so far that may read the current region
+    m_RegionFences[m_CurrRegion] = GLObjectWrappers::GLSyncObj{glFenceSync(
+        GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+        0                              // Flags, must be 0
+        )};
+    DEV_CHECK_GL_ERROR("Failed to create gl fence");
+
+    m_CurrRegion = (m_CurrRegion + 1) % NumRegions;
+
+    auto& Fence = m_RegionFences[m_CurrRegion];
+    if (Fence != GLsync{})
+    {
+        // Block only if the GPU has not finished reading the region yet, which happens
+        // when the buffer is discarded more than NumRegions - 1 times per frame.
+        auto res = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+        VERIFY_EXPR(res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED);
+        (void)res;
+        Fence.Release();
+    }
+}
+
 void BufferGLImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
 {
     VERIFY(ppView != nullptr, "Buffer view pointer address is null");
@@ -33,6 +33,7 @@
 #include <fstream>
 #include <string>
 #include <array>
+#include <chrono>
 
 #include "SwapChainGL.h"
 
@@ -49,6 +50,7 @@
 #include "PipelineStateGLImpl.hpp"
 #include "FenceGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -68,12 +70,16 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
         pDeviceGL,
         Desc
     },
-    m_ContextState{pDeviceGL},
-    m_DefaultFBO  {false    }
+    m_ContextState    {pDeviceGL},
+    m_DefaultFBO      {false    },
+    m_CmdListAllocator{GetRawAllocator(), sizeof(CommandListGLImpl), 64}
 // clang-format on
 {
     m_BoundWritableTextures.reserve(16);
     m_BoundWritableBuffers.reserve(16);
+
+    if (IsDeferred())
+        m_pCommands = std::make_unique<GLCommandStream>(GetRawAllocator());
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
@@ -81,18 +87,27 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 
 void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
 {
-    UNEXPECTED("OpenGL does not support deferred contexts");
-    (void)(ImmediateContextId);
+    DEV_CHECK_ERR(ImmediateContextId == 0, "OpenGL supports only one immediate context");
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
 }
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pPSO = m_pCommands->KeepAlive(pPipelineState)](DeviceContextGLImpl& Ctx) {
+            Ctx.SetPipelineState(pPSO);
+        });
+        return;
+    }
+
     VERIFY_EXPR(pPipelineState != nullptr);
 
+    if (IsRedundantPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateGLImpl> pPipelineStateGLImpl{pPipelineState, PipelineStateGLImpl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateGLImpl != nullptr, "Unknown pipeline state object implementation");
-    if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
-        return;
 
     TDeviceContextBase::SetPipelineState(std::move(pPipelineStateGLImpl), 0 /*Dummy*/);
 
@@ -176,6 +191,17 @@ void DeviceContextGLImpl::TransitionShaderResources(IPipelineState* pPipelineSta
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pSRB = m_pCommands->KeepAlive(pShaderResourceBinding), StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.CommitShaderResources(pSRB, StateTransitionMode);
+        });
+        return;
+    }
+
+    // Commands recorded by deferred contexts are measured when they are replayed
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_COMMIT_SHADER_RESOURCES)};
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
 
     auto* const pShaderResBindingGL = ClassPtrCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding);
@@ -190,6 +216,14 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([StencilRef](DeviceContextGLImpl& Ctx) {
+            Ctx.SetStencilRef(StencilRef);
+        });
+        return;
+    }
+
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
     {
         m_ContextState.SetStencilRef(GL_FRONT, StencilRef);
@@ -199,6 +233,14 @@ void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 
 void DeviceContextGLImpl::SetBlendFactors(const float* pBlendFactors)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pFactors = m_pCommands->CopyArray(pBlendFactors, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.SetBlendFactors(pFactors);
+        });
+        return;
+    }
+
     if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
     {
         m_ContextState.SetBlendFactors(m_BlendFactors);
@@ -212,12 +254,34 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsDeferred())
+    {
+        auto* ppBuffersCopy = m_pCommands->CopyArray(ppBuffers, NumBuffersSet);
+        for (Uint32 i = 0; ppBuffersCopy != nullptr && i < NumBuffersSet; ++i)
+            m_pCommands->KeepAlive(ppBuffersCopy[i]);
+        m_pCommands->Record([=, pOffsetsCopy = m_pCommands->CopyArray(pOffsets, NumBuffersSet)](DeviceContextGLImpl& Ctx) {
+            Ctx.SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffersCopy, pOffsetsCopy, StateTransitionMode, Flags);
+        });
+        return;
+    }
+
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::InvalidateState()
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([](DeviceContextGLImpl& Ctx) {
+            Ctx.InvalidateState();
+        });
+        return;
+    }
+
     TDeviceContextBase::InvalidateState();
 
     m_ContextState.Invalidate();
@@ -229,12 +293,32 @@ void DeviceContextGLImpl::InvalidateState()
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pIB = m_pCommands->KeepAlive(pIndexBuffer), ByteOffset, StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.SetIndexBuffer(pIB, ByteOffset, StateTransitionMode);
+        });
+        return;
+    }
+
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        // Viewports that match the render target size are resolved when the commands are replayed
+        m_pCommands->Record([=, pVPs = m_pCommands->CopyArray(pViewports, NumViewports)](DeviceContextGLImpl& Ctx) {
+            Ctx.SetViewports(NumViewports, pVPs, RTWidth, RTHeight);
+        });
+        return;
+    }
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -298,6 +382,14 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([=, pRectsCopy = m_pCommands->CopyArray(pRects, NumRects)](DeviceContextGLImpl& Ctx) {
+            Ctx.SetScissorRects(NumRects, pRectsCopy, RTWidth, RTHeight);
+        });
+        return;
+    }
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
@@ -340,6 +432,7 @@ void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, U
 
 void DeviceContextGLImpl::SetSwapChain(ISwapChainGL* pSwapChain)
 {
+    VERIFY(!IsDeferred(), "Swap chain can only be set for the immediate context");
     m_pSwapChain = pSwapChain;
 }
 
@@ -398,6 +491,20 @@ void DeviceContextGLImpl::CommitRenderTargets()
 
 void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        SetRenderTargetsAttribs RTAttribs = Attribs;
+        RTAttribs.ppRenderTargets         = m_pCommands->CopyArray(Attribs.ppRenderTargets, Attribs.NumRenderTargets);
+        for (Uint32 rt = 0; RTAttribs.ppRenderTargets != nullptr && rt < RTAttribs.NumRenderTargets; ++rt)
+            m_pCommands->KeepAlive(RTAttribs.ppRenderTargets[rt]);
+        m_pCommands->KeepAlive(RTAttribs.pDepthStencil);
+        m_pCommands->KeepAlive(RTAttribs.pShadingRateMap);
+        m_pCommands->Record([RTAttribs](DeviceContextGLImpl& Ctx) {
+            Ctx.SetRenderTargetsExt(RTAttribs);
+        });
+        return;
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
     if (TDeviceContextBase::SetRenderTargets(Attribs))
@@ -439,10 +546,18 @@ void DeviceContextGLImpl::BeginSubpass()
     const auto& SubpassDesc = RPDesc.pSubpasses[m_SubpassIndex];
     const auto& FBDesc      = m_pBoundFramebuffer->GetDesc();
 
-    const auto& RenderTargetFBO = m_pBoundFramebuffer->GetSubpassFramebuffer(m_SubpassIndex).RenderTarget;
+    const auto& SubpassFBOs     = m_pBoundFramebuffer->GetSubpassFramebuffer(m_SubpassIndex);
+    const auto& RenderTargetFBO = m_pBoundFramebuffer->GetSubpassRenderTarget(m_SubpassIndex);
     if (RenderTargetFBO != 0)
     {
+        // If the FBO is shared with the previous subpass, it is already bound
         m_ContextState.BindFBO(RenderTargetFBO);
+        if (SubpassFBOs.NumDrawBuffers != 0)
+        {
+            // Select the attachments of the merged FBO that are used by this subpass
+            glDrawBuffers(SubpassFBOs.NumDrawBuffers, SubpassFBOs.DrawBuffers.data());
+            DEV_CHECK_GL_ERROR("Failed to set draw buffers of the subpass");
+        }
     }
     else
     {
@@ -511,13 +626,14 @@ void DeviceContextGLImpl::EndSubpass()
     VERIFY_EXPR(m_SubpassIndex < RPDesc.SubpassCount);
     const auto& SubpassDesc = RPDesc.pSubpasses[m_SubpassIndex];
 
-    const auto& SubpassFBOs = m_pBoundFramebuffer->GetSubpassFramebuffer(m_SubpassIndex);
+    const auto& SubpassFBOs     = m_pBoundFramebuffer->GetSubpassFramebuffer(m_SubpassIndex);
+    const auto& RenderTargetFBO = m_pBoundFramebuffer->GetSubpassRenderTarget(m_SubpassIndex);
 #ifdef DILIGENT_DEBUG
     {
         GLint glCurrReadFB = 0;
         glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &glCurrReadFB);
         CHECK_GL_ERROR("Failed to get current read framebuffer");
-        GLuint glExpectedReadFB = SubpassFBOs.RenderTarget != 0 ? static_cast<GLuint>(SubpassFBOs.RenderTarget) : m_pSwapChain->GetDefaultFBO();
+        GLuint glExpectedReadFB = RenderTargetFBO != 0 ? static_cast<GLuint>(RenderTargetFBO) : m_pSwapChain->GetDefaultFBO();
         VERIFY(static_cast<GLuint>(glCurrReadFB) == glExpectedReadFB, "Unexpected read framebuffer");
     }
 #endif
@@ -556,14 +672,17 @@ void DeviceContextGLImpl::EndSubpass()
                 auto AttachmentLastUse = m_pActiveRenderPass->GetAttachmentFirstLastUse(RTAttachmentIdx).second;
                 if (AttachmentLastUse == m_SubpassIndex && RPDesc.pAttachments[RTAttachmentIdx].StoreOp == ATTACHMENT_STORE_OP_DISCARD)
                 {
-                    if (SubpassFBOs.RenderTarget == 0)
+                    if (RenderTargetFBO == 0)
                     {
                         VERIFY(rt == 0, "Default framebuffer can only have single color attachment");
                         InvalidateAttachments[InvalidateAttachmentsCount++] = GL_COLOR;
                     }
                     else
                     {
-                        InvalidateAttachments[InvalidateAttachmentsCount++] = GL_COLOR_ATTACHMENT0 + rt;
+                        // Render targets of merged subpasses are not necessarily attached to GL_COLOR_ATTACHMENT0 + rt
+                        InvalidateAttachments[InvalidateAttachmentsCount++] = SubpassFBOs.NumDrawBuffers != 0 ?
+                            SubpassFBOs.DrawBuffers[rt] :
+                            GL_COLOR_ATTACHMENT0 + rt;
                     }
                 }
             }
@@ -579,7 +698,7 @@ void DeviceContextGLImpl::EndSubpass()
                 {
                     const auto& FmtAttribs = GetTextureFormatAttribs(RPDesc.pAttachments[DSAttachmentIdx].Format);
                     VERIFY_EXPR(FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH || FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL);
-                    if (SubpassFBOs.RenderTarget == 0)
+                    if (RenderTargetFBO == 0)
                     {
                         InvalidateAttachments[InvalidateAttachmentsCount++] = GL_DEPTH;
                         if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
@@ -602,11 +721,25 @@ void DeviceContextGLImpl::EndSubpass()
 
     // TODO: invalidate input attachments using glInvalidateTexImage
 
-    m_ContextState.InvalidateFBO();
+    // Keep the FBO bound if the next subpass uses it, so that the attachments are not flushed from tile memory
+    if (!m_pBoundFramebuffer->IsMergedWithNextSubpass(m_SubpassIndex))
+        m_ContextState.InvalidateFBO();
 }
 
 void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        BeginRenderPassAttribs RPAttribs = Attribs;
+        RPAttribs.pClearValues           = m_pCommands->CopyArray(Attribs.pClearValues, Attribs.ClearValueCount);
+        m_pCommands->KeepAlive(RPAttribs.pRenderPass);
+        m_pCommands->KeepAlive(RPAttribs.pFramebuffer);
+        m_pCommands->Record([RPAttribs](DeviceContextGLImpl& Ctx) {
+            Ctx.BeginRenderPass(RPAttribs);
+        });
+        return;
+    }
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     m_AttachmentClearValues.resize(Attribs.ClearValueCount);
@@ -622,6 +755,14 @@ void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 
 void DeviceContextGLImpl::NextSubpass()
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([](DeviceContextGLImpl& Ctx) {
+            Ctx.NextSubpass();
+        });
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::NextSubpass();
     BeginSubpass();
@@ -630,6 +771,14 @@ void DeviceContextGLImpl::NextSubpass()
 
 void DeviceContextGLImpl::EndRenderPass()
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([](DeviceContextGLImpl& Ctx) {
+            Ctx.EndRenderPass();
+        });
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::EndRenderPass();
     m_ContextState.InvalidateFBO();
@@ -659,6 +808,8 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
 
     m_CommittedResourcesTentativeBarriers = MEMORY_BARRIER_NONE;
 
+    // Textures, samplers and buffers of all signatures are bound with as few calls as possible
+    m_ContextState.BeginBindingBatch();
     while (BindSRBMask != 0)
     {
         auto SignBit = ExtractLSB(BindSRBMask);
@@ -683,6 +834,7 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
             pResourceCache->BindDynamicBuffers(GetContextState(), BaseBindings);
         }
     }
+    m_ContextState.CommitBindings();
     m_BindInfo.StaleSRBMask &= ~m_BindInfo.ActiveSRBMask;
 
 
@@ -746,8 +898,13 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
                     m_VertexStreams,
                     m_NumVertexStreams //
                 };
-            const auto& VAO = VaoCache.GetVAO(vaoAttribs, m_ContextState);
-            m_ContextState.BindVAO(VAO);
+            // With vertex attrib binding, the VAO only defines the vertex format, and the
+            // buffers are bound to it directly, so no new VAO is created when buffers change.
+            if (!m_ContextState.GetContextCaps().IsVertexAttribBindingSupported || !VaoCache.BindFormatVAO(vaoAttribs, m_ContextState))
+            {
+                const auto& VAO = VaoCache.GetVAO(vaoAttribs, m_ContextState);
+                m_ContextState.BindVAO(VAO);
+            }
         }
         else
         {
@@ -797,6 +954,14 @@ void DeviceContextGLImpl::PostDraw()
 
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.Draw(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDrawArguments(Attribs);
 
     GLenum GlTopology;
@@ -823,6 +988,14 @@ void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.DrawIndexed(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDrawIndexedArguments(Attribs);
 
     GLenum GlTopology;
@@ -908,6 +1081,16 @@ void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
 
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->KeepAlive(Attribs.pAttribsBuffer);
+        m_pCommands->KeepAlive(Attribs.pCounterBuffer);
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.DrawIndirect(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDrawIndirectArguments(Attribs);
 
     GLenum GlTopology;
@@ -982,6 +1165,16 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->KeepAlive(Attribs.pAttribsBuffer);
+        m_pCommands->KeepAlive(Attribs.pCounterBuffer);
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.DrawIndexedIndirect(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDrawIndexedIndirectArguments(Attribs);
 
     GLenum GlTopology;
@@ -1074,6 +1267,14 @@ void DeviceContextGLImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.DispatchCompute(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDispatchArguments(Attribs);
 
 #if GL_ARB_compute_shader
@@ -1104,6 +1305,15 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->KeepAlive(Attribs.pAttribsBuffer);
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.DispatchComputeIndirect(Attribs);
+        });
+        return;
+    }
+
     DvpVerifyDispatchIndirectArguments(Attribs);
 
 #if GL_ARB_compute_shader
@@ -1150,6 +1360,14 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
                                             Uint8                          Stencil,
                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([=, pDSV = m_pCommands->KeepAlive(pView)](DeviceContextGLImpl& Ctx) {
+            Ctx.ClearDepthStencil(pDSV, ClearFlags, fDepth, Stencil, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::ClearDepthStencil(pView);
 
     if (pView != m_pBoundDepthStencil)
@@ -1184,6 +1402,14 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
 
 void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([=, pRTV = m_pCommands->KeepAlive(pView), pColor = m_pCommands->CopyArray(RGBA, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.ClearRenderTarget(pRTV, pColor, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::ClearRenderTarget(pView);
 
     Int32 RTIndex = -1;
@@ -1233,6 +1459,12 @@ void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const float* RG
 
 void DeviceContextGLImpl::Flush()
 {
+    if (IsDeferred())
+    {
+        DEV_ERROR("Flush() should only be called for immediate contexts.");
+        return;
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
 
     glFlush();
@@ -1242,18 +1474,64 @@ void DeviceContextGLImpl::Flush()
 
 void DeviceContextGLImpl::FinishFrame()
 {
+#if DILIGENT_DEFER_GL_ERROR_CHECKS
+    if (!IsDeferred())
+    {
+        // Per-call error checks are disabled, so report the errors recorded during the frame.
+        // Note that GL keeps one flag per error code, so the loop is bounded.
+        for (Uint32 i = 0; i < 8; ++i)
+        {
+            const auto err = glGetError();
+            if (err == GL_NO_ERROR)
+                break;
+            LOG_ERROR_MESSAGE("GL error was generated during the frame. GL Error Code: ", err,
+                              ". Use development build to find the failing call.");
+        }
+    }
+#endif
+
+    // GL fences can only be queried by the thread that owns the context
+    if (!IsDeferred())
+        m_pDevice->GetFenceCompletionWaiter().ProcessCompletedFences();
+
     TDeviceContextBase::EndFrame();
 }
 
 void DeviceContextGLImpl::FinishCommandList(ICommandList** ppCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(IsDeferred(), "Only deferred contexts can record command list");
+    DEV_CHECK_ERR(m_DeferredMappedBuffers.empty(), "Finishing command list while some buffers are still mapped.");
+    m_DeferredMappedBuffers.clear();
+
+    CommandListGLImpl* pCmdListGL(NEW_RC_OBJ(m_CmdListAllocator, "CommandListGLImpl instance", CommandListGLImpl)(m_pDevice, this, std::move(m_pCommands)));
+    pCmdListGL->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    // The command list takes ownership of the recorded commands
+    m_pCommands = std::make_unique<GLCommandStream>(GetRawAllocator());
+
+    TDeviceContextBase::FinishCommandList();
 }
 
 void DeviceContextGLImpl::ExecuteCommandLists(Uint32               NumCommandLists,
                                               ICommandList* const* ppCommandLists)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(!IsDeferred(), "Only immediate context can execute command list");
+
+    if (NumCommandLists == 0)
+        return;
+    DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        // Every command list starts from the default state, same as in other backends
+        InvalidateState();
+
+        auto* pCmdListGL = ClassPtrCast<CommandListGLImpl>(ppCommandLists[i]);
+        pCmdListGL->GetCommands().Execute(*this);
+    }
+
+    // Device context is now in default state
+    InvalidateState();
 }
 
 void DeviceContextGLImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
@@ -1287,6 +1565,14 @@ void DeviceContextGLImpl::WaitForIdle()
 
 void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pQueryToBegin = m_pCommands->KeepAlive(pQuery)](DeviceContextGLImpl& Ctx) {
+            Ctx.BeginQuery(pQueryToBegin);
+        });
+        return;
+    }
+
     TDeviceContextBase::BeginQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1334,6 +1620,14 @@ void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 
 void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pQueryToEnd = m_pCommands->KeepAlive(pQuery)](DeviceContextGLImpl& Ctx) {
+            Ctx.EndQuery(pQueryToEnd);
+        });
+        return;
+    }
+
     TDeviceContextBase::EndQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1389,6 +1683,8 @@ void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 
 bool DeviceContextGLImpl::UpdateCurrentGLContext()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "GL context can only be updated for the immediate context");
+
     auto NativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     if (NativeGLContext == NULL)
         return false;
@@ -1403,6 +1699,16 @@ void DeviceContextGLImpl::UpdateBuffer(IBuffer*                       pBuffer,
                                        const void*                    pData,
                                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        void* pDataCopy = m_pCommands->Allocate(StaticCast<size_t>(Size));
+        memcpy(pDataCopy, pData, StaticCast<size_t>(Size));
+        m_pCommands->Record([=, pBuff = m_pCommands->KeepAlive(pBuffer)](DeviceContextGLImpl& Ctx) {
+            Ctx.UpdateBuffer(pBuff, Offset, Size, pDataCopy, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
 
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
@@ -1417,6 +1723,14 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
                                      Uint64                         Size,
                                      RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([=, pSrc = m_pCommands->KeepAlive(pSrcBuffer), pDst = m_pCommands->KeepAlive(pDstBuffer)](DeviceContextGLImpl& Ctx) {
+            Ctx.CopyBuffer(pSrc, SrcOffset, SrcBufferTransitionMode, pDst, DstOffset, Size, DstBufferTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
 
     auto* pSrcBufferGL = ClassPtrCast<BufferGLImpl>(pSrcBuffer);
@@ -1426,6 +1740,20 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_MAP_BUFFER)};
+
+    if (IsDeferred())
+    {
+        // Deferred contexts write to scratch memory in the command stream that is
+        // copied to the buffer when the commands are replayed, see UnmapBuffer().
+        const auto& BuffDesc = pBuffer->GetDesc();
+        DEV_CHECK_ERR(MapType == MAP_WRITE && (MapFlags & MAP_FLAG_DISCARD) != 0,
+                      "Buffer '", BuffDesc.Name, "' can only be mapped for writing with MAP_FLAG_DISCARD flag by a deferred context in OpenGL backend");
+        pMappedData = m_pCommands->Allocate(StaticCast<size_t>(BuffDesc.Size));
+        m_DeferredMappedBuffers[pBuffer] = pMappedData;
+        return;
+    }
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
     pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
@@ -1433,6 +1761,29 @@ void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    if (IsDeferred())
+    {
+        auto it = m_DeferredMappedBuffers.find(pBuffer);
+        if (it == m_DeferredMappedBuffers.end())
+        {
+            DEV_ERROR("Buffer '", pBuffer->GetDesc().Name, "' is not mapped by this context");
+            return;
+        }
+        const void* pScratchData = it->second;
+        m_DeferredMappedBuffers.erase(it);
+
+        m_pCommands->Record([pBuff = m_pCommands->KeepAlive(pBuffer), pScratchData](DeviceContextGLImpl& Ctx) {
+            const auto Size = StaticCast<size_t>(pBuff->GetDesc().Size);
+
+            PVoid pMappedData = nullptr;
+            Ctx.MapBuffer(pBuff, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+            if (pMappedData != nullptr)
+                memcpy(pMappedData, pScratchData, Size);
+            Ctx.UnmapBuffer(pBuff, MAP_WRITE);
+        });
+        return;
+    }
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
     pBufferGL->Unmap(m_ContextState);
@@ -1446,6 +1797,42 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
                                         RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                         RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        TextureSubResData SubresDataCopy = SubresData;
+        if (SubresData.pSrcBuffer != nullptr)
+        {
+            m_pCommands->KeepAlive(SubresData.pSrcBuffer);
+        }
+        else
+        {
+            // Copy the source data into the command stream
+            const auto& FmtAttribs = GetTextureFormatAttribs(pTexture->GetDesc().Format);
+
+            Uint64 RowSize = 0;
+            Uint32 NumRows = 0;
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+            {
+                RowSize = Uint64{(DstBox.Width() + FmtAttribs.BlockWidth - 1) / FmtAttribs.BlockWidth} * FmtAttribs.ComponentSize;
+                NumRows = (DstBox.Height() + FmtAttribs.BlockHeight - 1) / FmtAttribs.BlockHeight;
+            }
+            else
+            {
+                RowSize = Uint64{DstBox.Width()} * FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
+                NumRows = DstBox.Height();
+            }
+            const auto DataSize = StaticCast<size_t>((DstBox.Depth() - 1) * SubresData.DepthStride + (NumRows - 1) * SubresData.Stride + RowSize);
+
+            void* pDataCopy = m_pCommands->Allocate(DataSize);
+            memcpy(pDataCopy, SubresData.pData, DataSize);
+            SubresDataCopy.pData = pDataCopy;
+        }
+        m_pCommands->Record([=, pTex = m_pCommands->KeepAlive(pTexture)](DeviceContextGLImpl& Ctx) {
+            Ctx.UpdateTexture(pTex, MipLevel, Slice, DstBox, SubresDataCopy, SrcBufferStateTransitionMode, TextureStateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
     auto* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
     pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, SubresData);
@@ -1453,6 +1840,18 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
 
 void DeviceContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
+    if (IsDeferred())
+    {
+        CopyTextureAttribs Attribs = CopyAttribs;
+        Attribs.pSrcBox            = m_pCommands->CopyArray(CopyAttribs.pSrcBox, 1);
+        m_pCommands->KeepAlive(Attribs.pSrcTexture);
+        m_pCommands->KeepAlive(Attribs.pDstTexture);
+        m_pCommands->Record([Attribs](DeviceContextGLImpl& Ctx) {
+            Ctx.CopyTexture(Attribs);
+        });
+        return;
+    }
+
     TDeviceContextBase::CopyTexture(CopyAttribs);
     auto* pSrcTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pSrcTexture);
     auto* pDstTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pDstTexture);
@@ -1574,6 +1973,13 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
                                                 const Box*                pMapRegion,
                                                 MappedTextureSubresource& MappedData)
 {
+    if (IsDeferred())
+    {
+        DEV_ERROR("Textures can't be mapped by deferred contexts in OpenGL backend");
+        MappedData = MappedTextureSubresource{};
+        return;
+    }
+
     TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1597,6 +2003,12 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
 
 void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
 {
+    if (IsDeferred())
+    {
+        DEV_ERROR("Textures can't be mapped by deferred contexts in OpenGL backend");
+        return;
+    }
+
     TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1613,6 +2025,14 @@ void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 Mip
 
 void DeviceContextGLImpl::GenerateMips(ITextureView* pTexView)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pView = m_pCommands->KeepAlive(pTexView)](DeviceContextGLImpl& Ctx) {
+            Ctx.GenerateMips(pView);
+        });
+        return;
+    }
+
     TDeviceContextBase::GenerateMips(pTexView);
     auto* pTexViewGL = ClassPtrCast<TextureViewGLImpl>(pTexView);
     auto  BindTarget = pTexViewGL->GetBindTarget();
@@ -1631,6 +2051,14 @@ void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*
                                                     ITexture*                               pDstTexture,
                                                     const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([ResolveAttribs, pSrc = m_pCommands->KeepAlive(pSrcTexture), pDst = m_pCommands->KeepAlive(pDstTexture)](DeviceContextGLImpl& Ctx) {
+            Ctx.ResolveTextureSubresource(pSrc, pDst, ResolveAttribs);
+        });
+        return;
+    }
+
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
     auto*       pSrcTexGl  = ClassPtrCast<TextureBaseGL>(pSrcTexture);
     auto*       pDstTexGl  = ClassPtrCast<TextureBaseGL>(pDstTexture);
@@ -1713,6 +2141,11 @@ void DeviceContextGLImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     UNSUPPORTED("BuildBLAS is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in OpenGL");
+}
+
 void DeviceContextGLImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     UNSUPPORTED("BuildTLAS is not supported in OpenGL");
@@ -1763,8 +2196,56 @@ void DeviceContextGLImpl::BindSparseResourceMemory(const BindSparseResourceMemor
     UNSUPPORTED("BindSparseResourceMemory is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    UNSUPPORTED("Conditional rendering is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::EndConditionalRendering()
+{
+    UNSUPPORTED("Conditional rendering is not supported in OpenGL");
+}
+
+Bool DeviceContextGLImpl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+#if GL_TIMESTAMP
+    if (!m_pDevice->GetFeatures().TimestampQueries)
+        return False;
+
+    const auto GetCPUTime = []() {
+        return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+
+    // OpenGL has no way to sample both clocks at the same moment, so the GPU time is
+    // bracketed by two CPU clock reads and the deviation is half of the interval.
+    const auto CPUTimeBefore = GetCPUTime();
+    GLint64    GPUTime       = 0;
+    glGetInteger64v(GL_TIMESTAMP, &GPUTime);
+    const auto CPUTimeAfter = GetCPUTime();
+    if (glGetError() != GL_NO_ERROR)
+        return False;
+
+    Calibration.GPUCounter = static_cast<Uint64>(GPUTime);
+    // GL_TIMESTAMP is always measured in nanoseconds, the same as the timestamp queries
+    Calibration.GPUFrequency = 1000000000;
+    Calibration.CPUTime      = CPUTimeBefore + (CPUTimeAfter - CPUTimeBefore) / 2;
+    Calibration.MaxDeviation = (CPUTimeAfter - CPUTimeBefore + 1) / 2;
+    return True;
+#else
+    return False;
+#endif
+}
+
 void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pName = m_pCommands->CopyString(Name), pGroupColor = m_pCommands->CopyArray(pColor, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.BeginDebugGroup(pName, pGroupColor);
+        });
+        return;
+    }
+
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
 #if GL_KHR_debug
@@ -1775,6 +2256,14 @@ void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 
 void DeviceContextGLImpl::EndDebugGroup()
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([](DeviceContextGLImpl& Ctx) {
+            Ctx.EndDebugGroup();
+        });
+        return;
+    }
+
     TDeviceContextBase::EndDebugGroup(0);
 
 #if GL_KHR_debug
@@ -1785,6 +2274,14 @@ void DeviceContextGLImpl::EndDebugGroup()
 
 void DeviceContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        m_pCommands->Record([pLabel = m_pCommands->CopyString(Label), pLabelColor = m_pCommands->CopyArray(pColor, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.InsertDebugLabel(pLabel, pLabelColor);
+        });
+        return;
+    }
+
     TDeviceContextBase::InsertDebugLabel(Label, pColor, 0);
 
 #if GL_KHR_debug
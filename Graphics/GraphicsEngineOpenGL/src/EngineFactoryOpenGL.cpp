@@ -137,6 +137,30 @@ static void SetDefaultGraphicsAdapterInfo(GraphicsAdapterInfo& AdapterInfo)
     AdapterInfo.Queues[0].TextureCopyGranularity[2] = 1;
 }
 
+static void CreateDeferredContexts(const EngineGLCreateInfo& EngineCI,
+                                   RenderDeviceGLImpl*       pRenderDeviceOpenGL,
+                                   IDeviceContext**          ppContexts)
+{
+    auto& RawMemAllocator = GetRawAllocator();
+    for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+    {
+        RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxGL{
+            NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
+                pRenderDeviceOpenGL,
+                DeviceContextDesc{
+                    nullptr,
+                    COMMAND_QUEUE_TYPE_UNKNOWN,
+                    True,           // IsDeferred
+                    1 + DeferredCtx // Context id
+                })                  //
+        };
+        // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+        // keep a weak reference to the context
+        pDeferredCtxGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx));
+        pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxGL);
+    }
+}
+
 void EngineFactoryOpenGLImpl::EnumerateAdapters(Version              MinVersion,
                                                 Uint32&              NumAdapters,
                                                 GraphicsAdapterInfo* Adapters) const
@@ -160,7 +184,9 @@ void EngineFactoryOpenGLImpl::EnumerateAdapters(Version              MinVersion,
 /// \param [out] ppDevice           - Address of the memory location where pointer to
 ///                                   the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. Pointers to
+///                                   EngineCI.NumDeferredContexts deferred contexts are written
+///                                   after the immediate context.
 /// \param [in]  SCDesc             - Swap chain description.
 /// \param [out] ppSwapChain        - Address of the memory location where pointer to the new
 ///                                   swap chain will be written.
@@ -180,21 +206,18 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
     if (!ppDevice || !ppImmediateContext || !ppSwapChain)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
-    *ppSwapChain        = nullptr;
+    *ppDevice    = nullptr;
+    *ppSwapChain = nullptr;
+    memset(ppImmediateContext, 0, sizeof(*ppImmediateContext) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
+
+    DeviceStartupTimer      StartupTimer;
+    DeviceStartupStatistics StartupStats;
 
     try
     {
@@ -202,7 +225,7 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         SetDefaultGraphicsAdapterInfo(AdapterInfo);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
-        SetRawAllocator(EngineCI.pRawMemAllocator);
+        SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
         auto& RawMemAllocator = GetRawAllocator();
 
         RenderDeviceGLImpl* pRenderDeviceOpenGL{
@@ -212,6 +235,9 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         };
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        // The render device creates or attaches to the GL context and loads the GL functions
+        StartupStats.DeviceCreationTime = StartupTimer.Lap();
+
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
                 pRenderDeviceOpenGL,
@@ -235,6 +261,12 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         pSwapChainGL->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
 
         pDeviceContextOpenGL->SetSwapChain(pSwapChainGL);
+
+        CreateDeferredContexts(EngineCI, pRenderDeviceOpenGL, ppImmediateContext);
+
+        StartupStats.EngineObjectsCreationTime = StartupTimer.Lap();
+        StartupStats.TotalTime                 = StartupTimer.Total();
+        pRenderDeviceOpenGL->SetStartupStatistics(StartupStats);
     }
     catch (const std::runtime_error&)
     {
@@ -244,10 +276,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         if (*ppSwapChain)
@@ -267,7 +302,9 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. Pointers to
+///                                   EngineCI.NumDeferredContexts deferred contexts are written
+///                                   after the immediate context.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                       IRenderDevice**           ppDevice,
                                                       IDeviceContext**          ppImmediateContext)
@@ -282,20 +319,17 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
     if (!ppDevice || !ppImmediateContext)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
+    *ppDevice = nullptr;
+    memset(ppImmediateContext, 0, sizeof(*ppImmediateContext) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
+
+    DeviceStartupTimer      StartupTimer;
+    DeviceStartupStatistics StartupStats;
 
     try
     {
@@ -303,7 +337,7 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         SetDefaultGraphicsAdapterInfo(AdapterInfo);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
-        SetRawAllocator(EngineCI.pRawMemAllocator);
+        SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
         auto& RawMemAllocator = GetRawAllocator();
 
         RenderDeviceGLImpl* pRenderDeviceOpenGL{
@@ -313,6 +347,9 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         };
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        // The render device creates or attaches to the GL context and loads the GL functions
+        StartupStats.DeviceCreationTime = StartupTimer.Lap();
+
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
                 pRenderDeviceOpenGL,
@@ -328,6 +365,12 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         // keep a weak reference to the context
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
+
+        CreateDeferredContexts(EngineCI, pRenderDeviceOpenGL, ppImmediateContext);
+
+        StartupStats.EngineObjectsCreationTime = StartupTimer.Lap();
+        StartupStats.TotalTime                 = StartupTimer.Total();
+        pRenderDeviceOpenGL->SetStartupStatistics(StartupStats);
     }
     catch (const std::runtime_error&)
     {
@@ -337,10 +380,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR("Failed to initialize OpenGL-based render device");
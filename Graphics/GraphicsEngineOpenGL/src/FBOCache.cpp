@@ -83,7 +83,8 @@ std::size_t FBOCache::FBOCacheKeyHashFunc::operator()(const FBOCacheKey& Key) co
 }
 
 
-FBOCache::FBOCache()
+FBOCache::FBOCache(size_t MaxSize) :
+    m_MaxSize{std::max(MaxSize, size_t{2})}
 {
     m_Cache.max_load_factor(0.5f);
     m_TexIdToKey.max_load_factor(0.5f);
@@ -93,32 +94,103 @@ FBOCache::~FBOCache()
 {
     VERIFY(m_Cache.empty(), "FBO cache is not empty. Are there any unreleased objects?");
     VERIFY(m_TexIdToKey.empty(), "TexIdToKey cache is not empty.");
+    VERIFY(!m_RebindableFBO, "Rebindable FBO has not been released. Are there any unreleased objects?");
+}
+
+void FBOCache::EraseEntry(const FBOCacheKey& Key)
+{
+    auto It = m_Cache.find(Key);
+    if (It == m_Cache.end())
+        return;
+
+    auto RemoveTexIdToKey = [&](UniqueIdentifier TexId) {
+        auto EqualRange = m_TexIdToKey.equal_range(TexId);
+        for (auto TexIt = EqualRange.first; TexIt != EqualRange.second;)
+        {
+            if (TexIt->second == Key)
+                TexIt = m_TexIdToKey.erase(TexIt);
+            else
+                ++TexIt;
+        }
+    };
+    if (Key.DSId != 0)
+        RemoveTexIdToKey(Key.DSId);
+    for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
+    {
+        if (Key.RTIds[rt] != 0)
+            RemoveTexIdToKey(Key.RTIds[rt]);
+    }
+
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
 }
 
 void FBOCache::OnReleaseTexture(ITexture* pTexture)
 {
     Threading::SpinLockGuard CacheGuard{m_CacheLock};
 
-    auto* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
+    auto*      pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
+    const auto TexId  = pTexGL->GetUniqueID();
+
     // Find all FBOs that this texture used in
-    auto EqualRange = m_TexIdToKey.equal_range(pTexGL->GetUniqueID());
+    std::vector<FBOCacheKey> Keys;
+    auto EqualRange = m_TexIdToKey.equal_range(TexId);
     for (auto It = EqualRange.first; It != EqualRange.second; ++It)
+        Keys.emplace_back(It->second);
+
+    for (const auto& Key : Keys)
+        EraseEntry(Key);
+
+    if (m_RebindableFBO && (m_RebindableKey.RTIds[0] == TexId || m_RebindableKey.DSId == TexId))
     {
-        m_Cache.erase(It->second);
+        // Release the FBO rather than detaching the texture, which would require binding the FBO:
+        // GL keeps deleted textures alive while they are attached to an FBO that is not bound.
+        m_RebindableFBO          = GLObjectWrappers::GLFrameBufferObj{false};
+        m_RebindableKey          = FBOCacheKey{};
+        m_RebindableDSAttachment = 0;
     }
-    m_TexIdToKey.erase(EqualRange.first, EqualRange.second);
 }
 
-GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    ContextState,
-                                                       Uint32             NumRenderTargets,
-                                                       TextureViewGLImpl* ppRTVs[],
-                                                       TextureViewGLImpl* pDSV)
+GLenum FBOCache::GetDepthAttachmentPoint(const TextureViewGLImpl& DSV)
 {
-    GLObjectWrappers::GLFrameBufferObj FBO{true};
-
-    ContextState.BindFBO(FBO);
+    const auto& DSVDesc = DSV.GetDesc();
+    if (DSVDesc.Format == TEX_FORMAT_D32_FLOAT ||
+        DSVDesc.Format == TEX_FORMAT_D16_UNORM)
+    {
+#ifdef DILIGENT_DEBUG
+        {
+            const auto GLTexFmt = DSV.GetTexture<TextureBaseGL>()->GetGLTexFormat();
+            VERIFY(GLTexFmt == GL_DEPTH_COMPONENT32F || GLTexFmt == GL_DEPTH_COMPONENT16,
+                   "Inappropriate internal texture format (", GLTexFmt,
+                   ") for depth attachment. GL_DEPTH_COMPONENT32F or GL_DEPTH_COMPONENT16 is expected");
+        }
+#endif
+        return GL_DEPTH_ATTACHMENT;
+    }
+    else if (DSVDesc.Format == TEX_FORMAT_D32_FLOAT_S8X24_UINT ||
+             DSVDesc.Format == TEX_FORMAT_D24_UNORM_S8_UINT)
+    {
+#ifdef DILIGENT_DEBUG
+        {
+            const auto GLTexFmt = DSV.GetTexture<TextureBaseGL>()->GetGLTexFormat();
+            VERIFY(GLTexFmt == GL_DEPTH24_STENCIL8 || GLTexFmt == GL_DEPTH32F_STENCIL8,
+                   "Inappropriate internal texture format (", GLTexFmt,
+                   ") for depth-stencil attachment. GL_DEPTH24_STENCIL8 or GL_DEPTH32F_STENCIL8 is expected");
+        }
+#endif
+        return GL_DEPTH_STENCIL_ATTACHMENT;
+    }
+    else
+    {
+        UNEXPECTED(GetTextureFormatAttribs(DSVDesc.Format).Name, " is not valid depth-stencil view format");
+        return 0;
+    }
+}
 
-    // Initialize the FBO
+void FBOCache::AttachTargets(Uint32             NumRenderTargets,
+                             TextureViewGLImpl* ppRTVs[],
+                             TextureViewGLImpl* pDSV)
+{
     for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
     {
         if (auto* pRTView = ppRTVs[rt])
@@ -131,40 +203,9 @@ GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    Contex
 
     if (pDSV != nullptr)
     {
-        const auto& DSVDesc         = pDSV->GetDesc();
-        auto*       pDepthTexGL     = pDSV->GetTexture<TextureBaseGL>();
-        GLenum      AttachmentPoint = 0;
-        if (DSVDesc.Format == TEX_FORMAT_D32_FLOAT ||
-            DSVDesc.Format == TEX_FORMAT_D16_UNORM)
-        {
-#ifdef DILIGENT_DEBUG
-            {
-                const auto GLTexFmt = pDepthTexGL->GetGLTexFormat();
-                VERIFY(GLTexFmt == GL_DEPTH_COMPONENT32F || GLTexFmt == GL_DEPTH_COMPONENT16,
-                       "Inappropriate internal texture format (", GLTexFmt,
-                       ") for depth attachment. GL_DEPTH_COMPONENT32F or GL_DEPTH_COMPONENT16 is expected");
-            }
-#endif
-            AttachmentPoint = GL_DEPTH_ATTACHMENT;
-        }
-        else if (DSVDesc.Format == TEX_FORMAT_D32_FLOAT_S8X24_UINT ||
-                 DSVDesc.Format == TEX_FORMAT_D24_UNORM_S8_UINT)
-        {
-#ifdef DILIGENT_DEBUG
-            {
-                const auto GLTexFmt = pDepthTexGL->GetGLTexFormat();
-                VERIFY(GLTexFmt == GL_DEPTH24_STENCIL8 || GLTexFmt == GL_DEPTH32F_STENCIL8,
-                       "Inappropriate internal texture format (", GLTexFmt,
-                       ") for depth-stencil attachment. GL_DEPTH24_STENCIL8 or GL_DEPTH32F_STENCIL8 is expected");
-            }
-#endif
-            AttachmentPoint = GL_DEPTH_STENCIL_ATTACHMENT;
-        }
-        else
-        {
-            UNEXPECTED(GetTextureFormatAttribs(DSVDesc.Format).Name, " is not valid depth-stencil view format");
-        }
-        pDepthTexGL->AttachToFramebuffer(DSVDesc, AttachmentPoint);
+        const auto AttachmentPoint = GetDepthAttachmentPoint(*pDSV);
+        if (AttachmentPoint != 0)
+            pDSV->GetTexture<TextureBaseGL>()->AttachToFramebuffer(pDSV->GetDesc(), AttachmentPoint);
     }
 
     // We now need to set mapping between shader outputs and
@@ -196,7 +237,10 @@ GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    Contex
     // So it can be set up once and left it set.
     glDrawBuffers(NumRenderTargets, DrawBuffers);
     CHECK_GL_ERROR("Failed to set draw buffers via glDrawBuffers()");
+}
 
+bool FBOCache::CheckFramebufferStatus()
+{
     GLenum Status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     if (Status != GL_FRAMEBUFFER_COMPLETE)
     {
@@ -215,10 +259,172 @@ GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    Contex
         }
         LOG_ERROR("Framebuffer is incomplete. FB status: ", StatusString);
         UNEXPECTED("Framebuffer is incomplete");
+        return false;
     }
+    return true;
+}
+
+size_t FBOCache::ComputeLayoutHash(Uint32             NumRenderTargets,
+                                   TextureViewGLImpl* ppRTVs[],
+                                   TextureViewGLImpl* pDSV)
+{
+    auto HashView = [](size_t& Hash, const TextureViewGLImpl* pView) {
+        if (pView == nullptr)
+        {
+            HashCombine(Hash, 0);
+            return;
+        }
+        const auto& ViewDesc = pView->GetDesc();
+        const auto& TexDesc  = pView->GetTexture<TextureBaseGL>()->GetDesc();
+        HashCombine(Hash, ViewDesc.Format, TexDesc.SampleCount, ViewDesc.TextureDim, ViewDesc.NumArraySlices > 1);
+    };
+
+    size_t Hash = ComputeHash(NumRenderTargets);
+    for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+        HashView(Hash, ppRTVs[rt]);
+    HashView(Hash, pDSV);
+    return Hash;
+}
+
+GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    ContextState,
+                                                       Uint32             NumRenderTargets,
+                                                       TextureViewGLImpl* ppRTVs[],
+                                                       TextureViewGLImpl* pDSV)
+{
+    GLObjectWrappers::GLFrameBufferObj FBO{true};
+
+    ContextState.BindFBO(FBO);
+
+    // Initialize the FBO
+    AttachTargets(NumRenderTargets, ppRTVs, pDSV);
+    CheckFramebufferStatus();
+
     return FBO;
 }
 
+FBOCache::FBOCacheKey FBOCache::CreateKey(Uint32             NumRenderTargets,
+                                          TextureViewGLImpl* ppRTVs[],
+                                          TextureViewGLImpl* pDSV)
+{
+    FBOCacheKey Key;
+    Key.NumRenderTargets = NumRenderTargets;
+    for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+    {
+        if (auto* pRTView = ppRTVs[rt])
+        {
+            Key.RTIds[rt]    = pRTView->GetTexture<TextureBaseGL>()->GetUniqueID();
+            Key.RTVDescs[rt] = pRTView->GetDesc();
+        }
+    }
+
+    if (pDSV != nullptr)
+    {
+        Key.DSId    = pDSV->GetTexture<TextureBaseGL>()->GetUniqueID();
+        Key.DSVDesc = pDSV->GetDesc();
+    }
+
+    return Key;
+}
+
+const GLObjectWrappers::GLFrameBufferObj& FBOCache::FindOrCreateFBO(const FBOCacheKey& Key,
+                                                                    TextureViewGLImpl* ppRTVs[],
+                                                                    TextureViewGLImpl* pDSV,
+                                                                    GLContextState&    ContextState)
+{
+    // Try to find FBO in the map
+    auto It = m_Cache.find(Key);
+    if (It != m_Cache.end())
+    {
+        // Move the entry to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.FBO;
+    }
+
+    if (m_Cache.size() >= m_MaxSize)
+    {
+        if (Key.NumRenderTargets == 1 && Key.RTIds[0] != 0 && Key.DSId != 0)
+        {
+            // Reuse the single rebindable FBO for the most common combination rather than
+            // evicting an entry that is likely to be requested again.
+            return RebindFBO(Key, ppRTVs[0], pDSV, ContextState);
+        }
+
+        // Release the least recently used FBO. Since the new key is not in the cache,
+        // the evicted entry is never the one that has just been requested.
+        const auto LRUKey = m_LRUList.back();
+        EraseEntry(LRUKey);
+    }
+
+    // Create a new FBO
+    GLObjectWrappers::GLFrameBufferObj NewFBO{true};
+    ContextState.BindFBO(NewFBO);
+    AttachTargets(Key.NumRenderTargets, ppRTVs, pDSV);
+
+    const auto LayoutHash = ComputeLayoutHash(Key.NumRenderTargets, ppRTVs, pDSV);
+#ifdef DILIGENT_DEVELOPMENT
+    // Always validate the framebuffer in development build
+    if (CheckFramebufferStatus())
+        m_ValidatedLayouts.emplace(LayoutHash);
+#else
+    // Completeness only depends on the attachment formats, sample counts and layering,
+    // so there is no need to check the status of FBOs with already validated layouts.
+    if (m_ValidatedLayouts.find(LayoutHash) == m_ValidatedLayouts.end() && CheckFramebufferStatus())
+        m_ValidatedLayouts.emplace(LayoutHash);
+#endif
+
+    m_LRUList.emplace_front(Key);
+
+    auto NewElems = m_Cache.emplace(Key, FBOCacheEntry{std::move(NewFBO), m_LRUList.begin()});
+    // New element must be actually inserted
+    VERIFY(NewElems.second, "New element was not inserted");
+    if (Key.DSId != 0)
+        m_TexIdToKey.emplace(Key.DSId, Key);
+    for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
+    {
+        if (Key.RTIds[rt] != 0)
+            m_TexIdToKey.emplace(Key.RTIds[rt], Key);
+    }
+
+    return NewElems.first->second.FBO;
+}
+
+const GLObjectWrappers::GLFrameBufferObj& FBOCache::RebindFBO(const FBOCacheKey& Key,
+                                                              TextureViewGLImpl* pRTV,
+                                                              TextureViewGLImpl* pDSV,
+                                                              GLContextState&    ContextState)
+{
+    VERIFY_EXPR(pRTV != nullptr && pDSV != nullptr);
+
+    if (m_RebindableFBO && m_RebindableKey == Key)
+        return m_RebindableFBO;
+
+    if (!m_RebindableFBO)
+        m_RebindableFBO = GLObjectWrappers::GLFrameBufferObj{true};
+
+    ContextState.BindFBO(m_RebindableFBO);
+
+    const auto DSAttachment = GetDepthAttachmentPoint(*pDSV);
+    if (m_RebindableDSAttachment == GL_DEPTH_STENCIL_ATTACHMENT && DSAttachment == GL_DEPTH_ATTACHMENT)
+    {
+        // Detach the stencil buffer left from the previous depth-stencil attachment
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+        CHECK_GL_ERROR("Failed to detach stencil buffer from the framebuffer");
+    }
+
+    TextureViewGLImpl* ppRTVs[] = {pRTV};
+    AttachTargets(1, ppRTVs, pDSV);
+
+    // Attaching textures to an FBO does not change its identity, so only new layouts are validated
+    const auto LayoutHash = ComputeLayoutHash(1, ppRTVs, pDSV);
+    if (m_ValidatedLayouts.find(LayoutHash) == m_ValidatedLayouts.end() && CheckFramebufferStatus())
+        m_ValidatedLayouts.emplace(LayoutHash);
+
+    m_RebindableKey          = Key;
+    m_RebindableDSAttachment = DSAttachment;
+
+    return m_RebindableFBO;
+}
+
 const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             NumRenderTargets,
                                                            TextureViewGLImpl* ppRTVs[],
                                                            TextureViewGLImpl* pDSV,
@@ -233,60 +439,68 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             Nu
     // Lock the cache
     Threading::SpinLockGuard CacheGuard{m_CacheLock};
 
-    // Construct the key
-    FBOCacheKey Key;
     VERIFY(NumRenderTargets < MAX_RENDER_TARGETS, "Too many render targets are being set");
-    NumRenderTargets     = std::min(NumRenderTargets, MAX_RENDER_TARGETS);
-    Key.NumRenderTargets = NumRenderTargets;
+    NumRenderTargets = std::min(NumRenderTargets, MAX_RENDER_TARGETS);
     for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
     {
-        auto* pRTView = ppRTVs[rt];
-        if (pRTView == nullptr)
-            continue;
-
-        auto* pColorTexGL = pRTView->GetTexture<TextureBaseGL>();
-        pColorTexGL->TextureMemoryBarrier(
-            MEMORY_BARRIER_FRAMEBUFFER, // Reads and writes via framebuffer object attachments after the
-                                        // barrier will reflect data written by shaders prior to the barrier.
-                                        // Additionally, framebuffer writes issued after the barrier will wait
-                                        // on the completion of all shader writes issued prior to the barrier.
-            ContextState);
-
-        Key.RTIds[rt]    = pColorTexGL->GetUniqueID();
-        Key.RTVDescs[rt] = pRTView->GetDesc();
+        if (auto* pRTView = ppRTVs[rt])
+        {
+            pRTView->GetTexture<TextureBaseGL>()->TextureMemoryBarrier(
+                MEMORY_BARRIER_FRAMEBUFFER, // Reads and writes via framebuffer object attachments after the
+                                            // barrier will reflect data written by shaders prior to the barrier.
+                                            // Additionally, framebuffer writes issued after the barrier will wait
+                                            // on the completion of all shader writes issued prior to the barrier.
+                ContextState);
+        }
     }
 
     if (pDSV)
-    {
-        auto* pDepthTexGL = pDSV->GetTexture<TextureBaseGL>();
-        pDepthTexGL->TextureMemoryBarrier(MEMORY_BARRIER_FRAMEBUFFER, ContextState);
-        Key.DSId    = pDepthTexGL->GetUniqueID();
-        Key.DSVDesc = pDSV->GetDesc();
-    }
+        pDSV->GetTexture<TextureBaseGL>()->TextureMemoryBarrier(MEMORY_BARRIER_FRAMEBUFFER, ContextState);
 
-    // Try to find FBO in the map
-    auto It = m_Cache.find(Key);
-    if (It != m_Cache.end())
-    {
-        return It->second;
-    }
-    else
+    const auto Key = CreateKey(NumRenderTargets, ppRTVs, pDSV);
+    return FindOrCreateFBO(Key, ppRTVs, pDSV, ContextState);
+}
+
+void FBOCache::PrewarmFramebuffer(const FramebufferDesc& Desc, GLContextState& ContextState)
+{
+    VERIFY_EXPR(Desc.pRenderPass != nullptr);
+    const auto& RPDesc = Desc.pRenderPass->GetDesc();
+
+    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+
+    for (Uint32 subpass = 0; subpass < RPDesc.SubpassCount; ++subpass)
     {
-        // Create a new FBO
-        auto NewFBO = CreateFBO(ContextState, NumRenderTargets, ppRTVs, pDSV);
-
-        auto NewElems = m_Cache.emplace(std::make_pair(Key, std::move(NewFBO)));
-        // New element must be actually inserted
-        VERIFY(NewElems.second, "New element was not inserted");
-        if (Key.DSId != 0)
-            m_TexIdToKey.insert(std::make_pair(Key.DSId, Key));
+        const auto& SubpassDesc = RPDesc.pSubpasses[subpass];
+
+        TextureViewGLImpl* ppRTVs[MAX_RENDER_TARGETS] = {};
+        TextureViewGLImpl* pDSV                       = nullptr;
+
+        bool   UsesDefaultFBO   = false;
+        Uint32 NumRenderTargets = std::min(SubpassDesc.RenderTargetAttachmentCount, MAX_RENDER_TARGETS);
         for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
         {
-            if (Key.RTIds[rt] != 0)
-                m_TexIdToKey.insert(std::make_pair(Key.RTIds[rt], Key));
+            const auto AttachmentIndex = SubpassDesc.pRenderTargetAttachments[rt].AttachmentIndex;
+            if (AttachmentIndex != ATTACHMENT_UNUSED)
+                ppRTVs[rt] = ClassPtrCast<TextureViewGLImpl>(Desc.ppAttachments[AttachmentIndex]);
+            if (ppRTVs[rt] != nullptr && ppRTVs[rt]->GetTexture<TextureBaseGL>()->GetGLHandle() == 0)
+                UsesDefaultFBO = true;
         }
 
-        return NewElems.first->second;
+        if (SubpassDesc.pDepthStencilAttachment != nullptr && SubpassDesc.pDepthStencilAttachment->AttachmentIndex != ATTACHMENT_UNUSED)
+        {
+            pDSV = ClassPtrCast<TextureViewGLImpl>(Desc.ppAttachments[SubpassDesc.pDepthStencilAttachment->AttachmentIndex]);
+            if (pDSV != nullptr && pDSV->GetTexture<TextureBaseGL>()->GetGLHandle() == 0)
+                UsesDefaultFBO = true;
+        }
+
+        while (NumRenderTargets > 0 && ppRTVs[NumRenderTargets - 1] == nullptr)
+            --NumRenderTargets;
+
+        // Swap chain attachments are rendered to the default framebuffer
+        if (UsesDefaultFBO || (NumRenderTargets == 0 && pDSV == nullptr))
+            continue;
+
+        FindOrCreateFBO(CreateKey(NumRenderTargets, ppRTVs, pDSV), ppRTVs, pDSV, ContextState);
     }
 }
 
@@ -80,6 +80,82 @@ static bool UseDefaultFBO(Uint32             NumRenderTargets,
     return useDefaultFBO;
 }
 
+// Returns the index of the first subpass of the group that shares the FBO with every subpass.
+// A subpass is merged with the previous one if all its input attachments are color attachments
+// of the merged FBO, so that they can be read with framebuffer fetch without leaving tile memory.
+static std::vector<Uint32> GetMergedSubpassGroups(const RenderPassDesc& RPDesc,
+                                                  const FramebufferDesc& FBDesc,
+                                                  Uint32                 MaxDrawBuffers)
+{
+    std::vector<Uint32> Groups(RPDesc.SubpassCount);
+
+    auto IsDefaultFBOAttachment = [&](Uint32 AttachmentIndex) {
+        auto* pView = ClassPtrCast<TextureViewGLImpl>(FBDesc.ppAttachments[AttachmentIndex]);
+        return pView != nullptr && pView->GetHandle() == 0;
+    };
+    auto GetDepthStencilAttachment = [](const SubpassDesc& Subpass) {
+        return Subpass.pDepthStencilAttachment != nullptr ? Subpass.pDepthStencilAttachment->AttachmentIndex : ATTACHMENT_UNUSED;
+    };
+
+    // Color attachments of the current group
+    std::vector<Uint32> GroupRTs;
+    for (Uint32 subpass = 0; subpass < RPDesc.SubpassCount; ++subpass)
+    {
+        const auto& Subpass = RPDesc.pSubpasses[subpass];
+
+        bool CanMerge = subpass > 0 && Subpass.InputAttachmentCount > 0;
+        if (CanMerge)
+        {
+            const auto& PrevSubpass = RPDesc.pSubpasses[subpass - 1];
+            // Resolves are performed by blitting from the read buffer, which must be the only color attachment
+            CanMerge = (PrevSubpass.pResolveAttachments == nullptr &&
+                        Subpass.pResolveAttachments == nullptr &&
+                        GetDepthStencilAttachment(PrevSubpass) == GetDepthStencilAttachment(Subpass) &&
+                        Subpass.RenderTargetAttachmentCount + Subpass.InputAttachmentCount <= MaxDrawBuffers);
+        }
+        for (Uint32 i = 0; CanMerge && i < Subpass.InputAttachmentCount; ++i)
+        {
+            const auto AttachmentIndex = Subpass.pInputAttachments[i].AttachmentIndex;
+            if (AttachmentIndex != ATTACHMENT_UNUSED)
+                CanMerge = std::find(GroupRTs.begin(), GroupRTs.end(), AttachmentIndex) != GroupRTs.end() && !IsDefaultFBOAttachment(AttachmentIndex);
+        }
+
+        auto MergedRTs = CanMerge ? GroupRTs : std::vector<Uint32>{};
+        for (Uint32 rt = 0; rt < Subpass.RenderTargetAttachmentCount; ++rt)
+        {
+            const auto AttachmentIndex = Subpass.pRenderTargetAttachments[rt].AttachmentIndex;
+            if (AttachmentIndex == ATTACHMENT_UNUSED)
+                continue;
+            if (IsDefaultFBOAttachment(AttachmentIndex))
+                CanMerge = false;
+            if (std::find(MergedRTs.begin(), MergedRTs.end(), AttachmentIndex) == MergedRTs.end())
+                MergedRTs.push_back(AttachmentIndex);
+        }
+        const auto DSAttachmentIndex = GetDepthStencilAttachment(Subpass);
+        if (DSAttachmentIndex != ATTACHMENT_UNUSED && IsDefaultFBOAttachment(DSAttachmentIndex))
+            CanMerge = false;
+
+        if (CanMerge && MergedRTs.size() <= MaxDrawBuffers)
+        {
+            Groups[subpass] = Groups[subpass - 1];
+            GroupRTs.swap(MergedRTs);
+        }
+        else
+        {
+            Groups[subpass] = subpass;
+            GroupRTs.clear();
+            for (Uint32 rt = 0; rt < Subpass.RenderTargetAttachmentCount; ++rt)
+            {
+                const auto AttachmentIndex = Subpass.pRenderTargetAttachments[rt].AttachmentIndex;
+                if (AttachmentIndex != ATTACHMENT_UNUSED && std::find(GroupRTs.begin(), GroupRTs.end(), AttachmentIndex) == GroupRTs.end())
+                    GroupRTs.push_back(AttachmentIndex);
+            }
+        }
+    }
+
+    return Groups;
+}
+
 FramebufferGLImpl::FramebufferGLImpl(IReferenceCounters*    pRefCounters,
                                      RenderDeviceGLImpl*    pDevice,
                                      const FramebufferDesc& Desc,
@@ -87,11 +163,32 @@ FramebufferGLImpl::FramebufferGLImpl(IReferenceCounters*    pRefCounters,
     TFramebufferBase{pRefCounters, pDevice, Desc}
 {
     const auto& RPDesc = m_Desc.pRenderPass->GetDesc();
+
+    // Subpasses may only share the FBO when shaders read input attachments through framebuffer fetch
+    // rather than texture sampling, which would otherwise create a feedback loop.
+    std::vector<Uint32> SubpassGroups;
+    if (pDevice->GetFeatures().SubpassFramebufferFetch == DEVICE_FEATURE_STATE_ENABLED)
+    {
+        const auto MaxDrawBuffers = std::min(static_cast<Uint32>(CtxState.GetContextCaps().MaxDrawBuffers), MAX_RENDER_TARGETS);
+        SubpassGroups             = GetMergedSubpassGroups(RPDesc, m_Desc, MaxDrawBuffers);
+    }
+
     m_SubpassFramebuffers.reserve(RPDesc.SubpassCount);
     for (Uint32 subpass = 0; subpass < RPDesc.SubpassCount; ++subpass)
     {
         const auto& SubpassDesc = RPDesc.pSubpasses[subpass];
 
+        const auto GroupStart = !SubpassGroups.empty() ? SubpassGroups[subpass] : subpass;
+        auto       GroupEnd   = subpass + 1;
+        while (GroupEnd < SubpassGroups.size() && SubpassGroups[GroupEnd] == GroupStart)
+            ++GroupEnd;
+
+        if (GroupStart != subpass || GroupEnd > subpass + 1)
+        {
+            InitMergedSubpass(subpass, GroupStart, GroupEnd, CtxState);
+            continue;
+        }
+
         TextureViewGLImpl* ppRTVs[MAX_RENDER_TARGETS] = {};
         TextureViewGLImpl* pDSV                       = nullptr;
 
@@ -132,6 +229,81 @@ FramebufferGLImpl::FramebufferGLImpl(IReferenceCounters*    pRefCounters,
         RenderTargetFBO.SetName(m_Desc.Name);
 
         m_SubpassFramebuffers.emplace_back(std::move(RenderTargetFBO), std::move(ResolveFBO));
+        m_SubpassFramebuffers.back().RenderTargetSubpass = subpass;
+    }
+}
+
+void FramebufferGLImpl::InitMergedSubpass(Uint32          Subpass,
+                                          Uint32          GroupStart,
+                                          Uint32          GroupEnd,
+                                          GLContextState& CtxState)
+{
+    const auto& RPDesc = m_Desc.pRenderPass->GetDesc();
+
+    // Color attachments of the merged FBO in the order of their first use
+    std::vector<Uint32> GroupRTs;
+    for (Uint32 subpass = GroupStart; subpass < GroupEnd; ++subpass)
+    {
+        const auto& SubpassDesc = RPDesc.pSubpasses[subpass];
+        for (Uint32 rt = 0; rt < SubpassDesc.RenderTargetAttachmentCount; ++rt)
+        {
+            const auto AttachmentIndex = SubpassDesc.pRenderTargetAttachments[rt].AttachmentIndex;
+            if (AttachmentIndex != ATTACHMENT_UNUSED && std::find(GroupRTs.begin(), GroupRTs.end(), AttachmentIndex) == GroupRTs.end())
+                GroupRTs.push_back(AttachmentIndex);
+        }
+    }
+    VERIFY_EXPR(GroupRTs.size() <= MAX_RENDER_TARGETS);
+
+    GLObjectWrappers::GLFrameBufferObj RenderTargetFBO{false};
+    if (Subpass == GroupStart)
+    {
+        TextureViewGLImpl* ppRTVs[MAX_RENDER_TARGETS] = {};
+        for (size_t i = 0; i < GroupRTs.size(); ++i)
+            ppRTVs[i] = ClassPtrCast<TextureViewGLImpl>(m_Desc.ppAttachments[GroupRTs[i]]);
+
+        // All subpasses in the group use the same depth-stencil attachment
+        const auto&        GroupStartDesc = RPDesc.pSubpasses[GroupStart];
+        TextureViewGLImpl* pDSV           = nullptr;
+        if (GroupStartDesc.pDepthStencilAttachment != nullptr && GroupStartDesc.pDepthStencilAttachment->AttachmentIndex != ATTACHMENT_UNUSED)
+            pDSV = ClassPtrCast<TextureViewGLImpl>(m_Desc.ppAttachments[GroupStartDesc.pDepthStencilAttachment->AttachmentIndex]);
+
+        RenderTargetFBO = FBOCache::CreateFBO(CtxState, static_cast<Uint32>(GroupRTs.size()), ppRTVs, pDSV);
+        RenderTargetFBO.SetName(m_Desc.Name);
+    }
+
+    m_SubpassFramebuffers.emplace_back(std::move(RenderTargetFBO), GLObjectWrappers::GLFrameBufferObj{false});
+    auto& SubpassFBOs               = m_SubpassFramebuffers.back();
+    SubpassFBOs.RenderTargetSubpass = GroupStart;
+
+    auto GetAttachmentPoint = [&](Uint32 AttachmentIndex) -> GLenum {
+        const auto It = std::find(GroupRTs.begin(), GroupRTs.end(), AttachmentIndex);
+        return It != GroupRTs.end() ? static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + (It - GroupRTs.begin())) : GL_NONE;
+    };
+
+    const auto& SubpassDesc = RPDesc.pSubpasses[Subpass];
+    auto&       DrawBuffers = SubpassFBOs.DrawBuffers;
+    for (Uint32 rt = 0; rt < SubpassDesc.RenderTargetAttachmentCount; ++rt)
+    {
+        const auto AttachmentIndex = SubpassDesc.pRenderTargetAttachments[rt].AttachmentIndex;
+        DrawBuffers[rt]            = AttachmentIndex != ATTACHMENT_UNUSED ? GetAttachmentPoint(AttachmentIndex) : GL_NONE;
+    }
+    SubpassFBOs.NumDrawBuffers = SubpassDesc.RenderTargetAttachmentCount;
+
+    for (Uint32 i = 0; i < SubpassDesc.InputAttachmentCount; ++i)
+    {
+        const auto Location = SubpassDesc.RenderTargetAttachmentCount + i;
+        VERIFY_EXPR(Location < MAX_RENDER_TARGETS);
+
+        const auto AttachmentIndex = SubpassDesc.pInputAttachments[i].AttachmentIndex;
+        const auto AttachmentPoint = AttachmentIndex != ATTACHMENT_UNUSED ? GetAttachmentPoint(AttachmentIndex) : GL_NONE;
+        // Every color attachment may only be used by a single draw buffer. Input attachments that are
+        // also render targets of the subpass are read through the render target location.
+        const auto DrawBuffersEnd = DrawBuffers.begin() + SubpassFBOs.NumDrawBuffers;
+        if (AttachmentPoint != GL_NONE && std::find(DrawBuffers.begin(), DrawBuffersEnd, AttachmentPoint) == DrawBuffersEnd)
+        {
+            DrawBuffers[Location]      = AttachmentPoint;
+            SubpassFBOs.NumDrawBuffers = Location + 1;
+        }
     }
 }
 
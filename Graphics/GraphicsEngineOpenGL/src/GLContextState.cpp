@@ -29,6 +29,8 @@
 
 #include "GLContextState.hpp"
 
+#include <algorithm>
+
 #include "BufferViewGLImpl.hpp"
 #include "RenderDeviceGLImpl.hpp"
 #include "TextureBaseGL.hpp"
@@ -47,6 +49,20 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
     const auto& AdapterInfo             = pDeviceGL->GetAdapterInfo();
     m_Caps.IsFillModeSelectionSupported = AdapterInfo.Features.WireframeFill;
     m_Caps.IsProgramPipelineSupported   = AdapterInfo.Features.SeparablePrograms;
+#if GL_ARB_multi_bind
+    m_Caps.IsMultiBindSupported =
+        (pDeviceGL->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_GL && pDeviceGL->GetDeviceInfo().APIVersion >= Version{4, 4}) ||
+        pDeviceGL->CheckExtension("GL_ARB_multi_bind");
+#endif
+#if GL_ARB_vertex_attrib_binding
+    {
+        const auto& DeviceInfo = pDeviceGL->GetDeviceInfo();
+        m_Caps.IsVertexAttribBindingSupported =
+            (DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && DeviceInfo.APIVersion >= Version{4, 3}) ||
+            (DeviceInfo.Type == RENDER_DEVICE_TYPE_GLES && DeviceInfo.APIVersion >= Version{3, 1}) ||
+            pDeviceGL->CheckExtension("GL_ARB_vertex_attrib_binding");
+    }
+#endif
 
     {
         m_Caps.MaxCombinedTexUnits = 0;
@@ -108,6 +124,12 @@ void GLContextState::Invalidate()
     m_BoundUniformBuffers.clear();
     m_BoundStorageBlocks.clear();
 
+    m_PendingTextures.Reset();
+    m_PendingSamplers.Reset();
+    m_PendingUniformBuffers.Reset();
+    m_PendingStorageBlocks.Reset();
+    m_IsBindingBatchActive = false;
+
     m_DSState = DepthStencilGLState();
     m_RSState = RasterizerGLState();
 
@@ -228,6 +250,17 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
     }
     VERIFY(0 <= Index && Index < m_Caps.MaxCombinedTexUnits, "Texture unit is out of range");
 
+    if (m_IsBindingBatchActive)
+    {
+        // glBindTextures does not use the active texture unit
+        GLuint GLTexHandle = 0;
+        if (UpdateBoundObjectsArr(m_BoundTextures, Index, Tex, GLTexHandle))
+            m_PendingTextures.Set(Index, GLTexHandle);
+        else
+            ++m_BindingStats.NumSkipped;
+        return;
+    }
+
     // Always update active texture unit
     SetActiveTexture(Index);
 
@@ -236,6 +269,11 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
     {
         glBindTexture(BindTarget, GLTexHandle);
         DEV_CHECK_GL_ERROR("Failed to bind texture to slot ", Index);
+        ++m_BindingStats.NumGLCalls;
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 }
 
@@ -244,8 +282,20 @@ void GLContextState::BindSampler(Uint32 Index, const GLObjectWrappers::GLSampler
     GLuint GLSamplerHandle = 0;
     if (UpdateBoundObjectsArr(m_BoundSamplers, Index, GLSampler, GLSamplerHandle))
     {
-        glBindSampler(Index, GLSamplerHandle);
-        DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
+        if (m_IsBindingBatchActive)
+        {
+            m_PendingSamplers.Set(Index, GLSamplerHandle);
+        }
+        else
+        {
+            glBindSampler(Index, GLSamplerHandle);
+            DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
+            ++m_BindingStats.NumGLCalls;
+        }
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 }
 
@@ -275,6 +325,11 @@ void GLContextState::BindImage(Uint32             Index,
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, MipLevel, IsLayered, Layer, Access, Format);
         DEV_CHECK_GL_ERROR("glBindImageTexture() failed");
+        ++m_BindingStats.NumGLCalls;
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
@@ -301,6 +356,11 @@ void GLContextState::BindImage(Uint32 Index, BufferViewGLImpl* pBuffView, GLenum
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, 0, GL_FALSE, 0, Access, Format);
         DEV_CHECK_GL_ERROR("glBindImageTexture() failed");
+        ++m_BindingStats.NumGLCalls;
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
@@ -353,10 +413,22 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
     {
         m_BoundUniformBuffers[Index] = NewUBOInfo;
         GLuint GLBufferHandle        = Buff;
-        // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase also binds
-        // buffer to the generic buffer binding point specified by target.
-        glBindBufferRange(GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size);
-        DEV_CHECK_GL_ERROR("Failed to bind uniform buffer to slot ", Index);
+        if (m_IsBindingBatchActive)
+        {
+            m_PendingUniformBuffers.Set(Index, GLBufferHandle, Offset, Size);
+        }
+        else
+        {
+            // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase also binds
+            // buffer to the generic buffer binding point specified by target.
+            glBindBufferRange(GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size);
+            DEV_CHECK_GL_ERROR("Failed to bind uniform buffer to slot ", Index);
+            ++m_BindingStats.NumGLCalls;
+        }
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 }
 
@@ -371,16 +443,120 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
     {
         m_BoundStorageBlocks[Index] = NewSSBOInfo;
         GLuint GLBufferHandle       = Buff;
-        // In addition to binding buffer to the indexed buffer binding target, glBindBufferRange also binds
-        // buffer to the generic buffer binding point specified by target.
-        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, Index, GLBufferHandle, Offset, Size);
-        DEV_CHECK_GL_ERROR("Failed to bind shader storage block to slot ", Index);
+        if (m_IsBindingBatchActive)
+        {
+            m_PendingStorageBlocks.Set(Index, GLBufferHandle, Offset, Size);
+        }
+        else
+        {
+            // In addition to binding buffer to the indexed buffer binding target, glBindBufferRange also binds
+            // buffer to the generic buffer binding point specified by target.
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, Index, GLBufferHandle, Offset, Size);
+            DEV_CHECK_GL_ERROR("Failed to bind shader storage block to slot ", Index);
+            ++m_BindingStats.NumGLCalls;
+        }
+    }
+    else
+    {
+        ++m_BindingStats.NumSkipped;
     }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
 #endif
 }
 
+void GLContextState::PendingBindings::Set(Uint32 Slot, GLuint Handle, GLintptr Offset, GLsizeiptr Size)
+{
+    if (Slot >= Handles.size())
+    {
+        Handles.resize(size_t{Slot} + 1);
+        Offsets.resize(size_t{Slot} + 1);
+        Sizes.resize(size_t{Slot} + 1);
+        Dirty.resize(size_t{Slot} + 1);
+    }
+    Handles[Slot] = Handle;
+    Offsets[Slot] = Offset;
+    Sizes[Slot]   = Size;
+    Dirty[Slot]   = true;
+
+    FirstDirty = std::min(FirstDirty, Slot);
+    LastDirty  = std::max(LastDirty, Slot);
+}
+
+template <typename BindRangeFuncType>
+Uint32 GLContextState::PendingBindings::Flush(BindRangeFuncType&& BindRange)
+{
+    Uint32 NumCalls = 0;
+    for (Uint32 Slot = FirstDirty; Slot <= LastDirty && Slot < Dirty.size();)
+    {
+        if (!Dirty[Slot])
+        {
+            ++Slot;
+            continue;
+        }
+
+        // Slots that are not dirty are not rebound as the objects
+        // that are recorded as bound to them may have been deleted.
+        const auto First = Slot;
+        while (Slot <= LastDirty && Dirty[Slot])
+            Dirty[Slot++] = false;
+
+        BindRange(First, Slot - First);
+        ++NumCalls;
+    }
+    FirstDirty = ~0u;
+    LastDirty  = 0;
+
+    return NumCalls;
+}
+
+void GLContextState::PendingBindings::Reset()
+{
+    std::fill(Dirty.begin(), Dirty.end(), false);
+    FirstDirty = ~0u;
+    LastDirty  = 0;
+}
+
+void GLContextState::BeginBindingBatch()
+{
+    VERIFY(!m_IsBindingBatchActive, "Binding batch has already been started");
+    m_IsBindingBatchActive = m_Caps.IsMultiBindSupported;
+}
+
+void GLContextState::CommitBindings()
+{
+    if (!m_IsBindingBatchActive)
+        return;
+
+#if GL_ARB_multi_bind
+    m_BindingStats.NumGLCalls += m_PendingTextures.Flush([this](Uint32 First, Uint32 Count) {
+        glBindTextures(First, Count, &m_PendingTextures.Handles[First]);
+        DEV_CHECK_GL_ERROR("Failed to bind textures to slots ", First, "..", First + Count - 1);
+    });
+
+    m_BindingStats.NumGLCalls += m_PendingSamplers.Flush([this](Uint32 First, Uint32 Count) {
+        glBindSamplers(First, Count, &m_PendingSamplers.Handles[First]);
+        DEV_CHECK_GL_ERROR("Failed to bind samplers to slots ", First, "..", First + Count - 1);
+    });
+
+    m_BindingStats.NumGLCalls += m_PendingUniformBuffers.Flush([this](Uint32 First, Uint32 Count) {
+        glBindBuffersRange(GL_UNIFORM_BUFFER, First, Count, &m_PendingUniformBuffers.Handles[First],
+                           &m_PendingUniformBuffers.Offsets[First], &m_PendingUniformBuffers.Sizes[First]);
+        DEV_CHECK_GL_ERROR("Failed to bind uniform buffers to slots ", First, "..", First + Count - 1);
+    });
+
+    m_BindingStats.NumGLCalls += m_PendingStorageBlocks.Flush([this](Uint32 First, Uint32 Count) {
+        glBindBuffersRange(GL_SHADER_STORAGE_BUFFER, First, Count, &m_PendingStorageBlocks.Handles[First],
+                           &m_PendingStorageBlocks.Offsets[First], &m_PendingStorageBlocks.Sizes[First]);
+        DEV_CHECK_GL_ERROR("Failed to bind shader storage blocks to slots ", First, "..", First + Count - 1);
+    });
+#else
+    UNEXPECTED("Binding batch must not be active when multi-bind is not supported");
+#endif
+
+    m_IsBindingBatchActive = false;
+}
+
 void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO)
 {
     // Binding ARRAY_BUFFER or ELEMENT_ARRAY_BUFFER affects currently bound VAO
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "GLProgramCache.hpp"
+
+#include <cstring>
+
+#include "RenderDeviceGLImpl.hpp"
+#include "PipelineResourceSignatureGLImpl.hpp"
+#include "GLTypeConversions.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+size_t ComputeProgramSetHash(const GLProgramCache::ProgramSet& Set)
+{
+    size_t Hash = ComputeHash(Set.IsSeparable, Set.ShaderIds.size(), Set.Signatures.size());
+    for (auto Id : Set.ShaderIds)
+        HashCombine(Hash, Id);
+    for (const auto& pSignature : Set.Signatures)
+        HashCombine(Hash, pSignature ? pSignature->GetHash() : size_t{0});
+    return Hash;
+}
+
+// Compatible signatures may still assign different bindings to the same resource, as
+// ApplyBindings() looks up the resources by name and shader stages.
+bool SignaturesBindIdentically(const PipelineResourceSignatureGLImpl* pSign0, const PipelineResourceSignatureGLImpl* pSign1)
+{
+    if (pSign0 == pSign1)
+        return true;
+    if (pSign0 == nullptr || pSign1 == nullptr)
+        return false;
+    if (!pSign0->IsCompatibleWith(pSign1))
+        return false;
+
+    const auto ResCount = pSign0->GetTotalResourceCount();
+    VERIFY_EXPR(ResCount == pSign1->GetTotalResourceCount());
+    for (Uint32 r = 0; r < ResCount; ++r)
+    {
+        const auto& Res0 = pSign0->GetResourceDesc(r);
+        const auto& Res1 = pSign1->GetResourceDesc(r);
+        if (Res0.ShaderStages != Res1.ShaderStages || std::strcmp(Res0.Name, Res1.Name) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool ProgramSetsEqual(const GLProgramCache::ProgramSet& Set0, const GLProgramCache::ProgramSet& Set1)
+{
+    if (Set0.IsSeparable != Set1.IsSeparable ||
+        Set0.ShaderIds != Set1.ShaderIds ||
+        Set0.Signatures.size() != Set1.Signatures.size())
+        return false;
+
+    for (size_t i = 0; i < Set0.Signatures.size(); ++i)
+    {
+        if (!SignaturesBindIdentically(Set0.Signatures[i], Set1.Signatures[i]))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+GLObjectWrappers::GLPipelineObj& GLProgramCache::ProgramSet::GetProgramPipeline(GLContext::NativeGLContextType Context, const char* Name)
+{
+    VERIFY_EXPR(IsSeparable);
+
+    Threading::SpinLockGuard Guard{m_PipelinesLock};
+    for (auto& ctx_pipeline : m_Pipelines)
+    {
+        if (ctx_pipeline.first == Context)
+            return ctx_pipeline.second;
+    }
+
+    // Create new program pipeline
+    m_Pipelines.emplace_back(Context, true);
+    auto&  ctx_pipeline = m_Pipelines.back();
+    GLuint Pipeline     = ctx_pipeline.second;
+    for (size_t i = 0; i < Programs.size(); ++i)
+    {
+        auto GLShaderBit = ShaderTypeToGLShaderBit(ShaderTypes[i]);
+        // If the program has an active code for each stage mentioned in set flags,
+        // then that code will be used by the pipeline. If program is 0, then the given
+        // stages are cleared from the pipeline.
+        glUseProgramStages(Pipeline, GLShaderBit, Programs[i]);
+        CHECK_GL_ERROR("glUseProgramStages() failed");
+    }
+
+    ctx_pipeline.second.SetName(Name);
+
+    return ctx_pipeline.second;
+}
+
+GLProgramCache::ProgramSetPtr GLProgramCache::FindUnsafe(const ProgramSet& Key, size_t Hash)
+{
+    auto range = m_Sets.equal_range(Hash);
+    for (auto it = range.first; it != range.second;)
+    {
+        if (auto pSet = it->second.lock())
+        {
+            if (ProgramSetsEqual(*pSet, Key))
+                return pSet;
+            ++it;
+        }
+        else
+        {
+            // All pipeline states that used the programs have been destroyed
+            it = m_Sets.erase(it);
+        }
+    }
+    return {};
+}
+
+GLProgramCache::ProgramSetPtr GLProgramCache::Find(const ProgramSet& Key)
+{
+    const auto Hash = ComputeProgramSetHash(Key);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return FindUnsafe(Key, Hash);
+}
+
+GLProgramCache::ProgramSetPtr GLProgramCache::Add(ProgramSetPtr pSet)
+{
+    VERIFY_EXPR(pSet && pSet->IsInitialized);
+    const auto Hash = ComputeProgramSetHash(*pSet);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (auto pExisting = FindUnsafe(*pSet, Hash))
+        return pExisting;
+
+    m_Sets.emplace(Hash, pSet);
+    return pSet;
+}
+
+} // namespace Diligent
@@ -193,6 +193,14 @@
     DECLARE_GL_FUNCTION_NO_STUB( glShaderStorageBlockBinding, PFNGLSHADERSTORAGEBLOCKBINDINGPROC, GLuint program, GLuint storageBlockIndex, GLuint storageBlockBinding )
 #endif
 
+#ifdef LOAD_GL_VERTEX_ATTRIB_BINDING
+    DECLARE_GL_FUNCTION( glBindVertexBuffer,     PFNGLBINDVERTEXBUFFERPROC,     GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride )
+    DECLARE_GL_FUNCTION( glVertexAttribFormat,   PFNGLVERTEXATTRIBFORMATPROC,   GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset )
+    DECLARE_GL_FUNCTION( glVertexAttribIFormat,  PFNGLVERTEXATTRIBIFORMATPROC,  GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset )
+    DECLARE_GL_FUNCTION( glVertexAttribBinding,  PFNGLVERTEXATTRIBBINDINGPROC,  GLuint attribindex, GLuint bindingindex )
+    DECLARE_GL_FUNCTION( glVertexBindingDivisor, PFNGLVERTEXBINDINGDIVISORPROC, GLuint bindingindex, GLuint divisor )
+#endif
+
 #ifdef LOAD_GL_TEX_STORAGE_3D_MULTISAMPLE
     DECLARE_GL_FUNCTION( glTexStorage3DMultisample, PFNGLTEXSTORAGE3DMULTISAMPLEPROC, GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations )
 #endif
@@ -201,6 +209,10 @@
     DECLARE_GL_FUNCTION_NO_STUB( glTextureView, PFNGLTEXTUREVIEWPROC, GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers)
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    DECLARE_GL_FUNCTION_NO_STUB( glBufferStorage, PFNGLBUFFERSTORAGEPROC, GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+#endif
+
 #ifdef LOAD_GL_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE
     DECLARE_GL_FUNCTION( glDrawElementsInstancedBaseVertexBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC, GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance)
 #endif
@@ -237,6 +249,10 @@
     DECLARE_GL_FUNCTION( glQueryCounter, PFNGLQUERYCOUNTERPROC, GLuint id, GLenum target)
 #endif
 
+#ifdef LOAD_GL_MAX_SHADER_COMPILER_THREADS
+    DECLARE_GL_FUNCTION_NO_STUB( glMaxShaderCompilerThreadsKHR, PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)
+#endif
+
 #ifdef LOAD_GL_OBJECT_LABEL
     DECLARE_GL_FUNCTION_NO_STUB( glObjectLabel, PFNGLOBJECTLABELPROC)
 #endif
@@ -441,6 +457,14 @@ void LoadGLFunctions()
     //LOAD_GL_FUNCTION_NO_STUB(glShaderStorageBlockBinding, "glShaderStorageBlockBinding")
 #endif
 
+#ifdef LOAD_GL_VERTEX_ATTRIB_BINDING
+    LOAD_GL_FUNCTION(glBindVertexBuffer)
+    LOAD_GL_FUNCTION(glVertexAttribFormat)
+    LOAD_GL_FUNCTION(glVertexAttribIFormat)
+    LOAD_GL_FUNCTION(glVertexAttribBinding)
+    LOAD_GL_FUNCTION(glVertexBindingDivisor)
+#endif
+
 #ifdef LOAD_GL_TEX_STORAGE_3D_MULTISAMPLE
     LOAD_GL_FUNCTION2(glTexStorage3DMultisample, {{"glTexStorage3DMultisample", {3,2}}, {"glTexStorage3DMultisampleOES", {3,1}}} )
 #endif
@@ -449,6 +473,10 @@ void LoadGLFunctions()
     LOAD_GL_FUNCTION_NO_STUB(glTextureView, {{"glTextureViewOES", {3,1}}, {"glTextureViewEXT", {3,1}}} )
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    LOAD_GL_FUNCTION_NO_STUB(glBufferStorage, {{"glBufferStorageEXT", {3,1}}} )
+#endif
+
 #ifdef LOAD_GL_DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE
     LOAD_GL_FUNCTION2(glDrawElementsInstancedBaseVertexBaseInstance, {{"glDrawElementsInstancedBaseVertexBaseInstanceEXT", {3,0}}} )
 #endif
@@ -477,6 +505,10 @@ void LoadGLFunctions()
     LOAD_GL_FUNCTION_NO_STUB(glQueryCounter, {{"glQueryCounterEXT", {3,0}}} );
 #endif
 
+#ifdef LOAD_GL_MAX_SHADER_COMPILER_THREADS
+    LOAD_GL_FUNCTION_NO_STUB(glMaxShaderCompilerThreadsKHR, {{"glMaxShaderCompilerThreadsKHR", {3,0}}} );
+#endif
+
 #ifdef LOAD_GL_OBJECT_LABEL
     LOAD_GL_FUNCTION_NO_STUB(glObjectLabel, {{"glObjectLabel", {3,2}}, {"glObjectLabelKHR", {3,0}}} );
 #endif
@@ -0,0 +1,287 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "PipelineStateCacheGLImpl.hpp"
+
+#include <sstream>
+
+#include "RenderDeviceGLImpl.hpp"
+#include "ShaderGLImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "Serializer.hpp"
+#include "CompilationStatisticsImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 ProgramBinaryCacheMagic   = 0x50474C44; // DLGP
+constexpr Uint32 ProgramBinaryCacheVersion = 1;
+
+// Program binaries are only compatible with the same GPU and driver version.
+std::string GetProgramBinaryDeviceKey()
+{
+    std::string DeviceKey;
+    for (GLenum Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        if (const auto* Str = reinterpret_cast<const char*>(glGetString(Name)))
+            DeviceKey += Str;
+        DeviceKey += '|';
+    }
+    return DeviceKey;
+}
+
+// The device key may contain characters that are not allowed in file names, so use its hash.
+std::string GetCacheFileDeviceKey(const std::string& DeviceKey)
+{
+    std::stringstream ss;
+    ss << "GL_" << std::hex << std::uppercase << ComputeHashRaw(DeviceKey.data(), DeviceKey.size());
+    return ss.str();
+}
+
+} // namespace
+
+PipelineStateCacheGLImpl::PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceGLImpl*                 pRenderDeviceGL,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    // clang-format off
+    TPipelineStateCacheBase
+    {
+        pRefCounters,
+        pRenderDeviceGL,
+        CreateInfo,
+        false
+    },
+    m_DeviceKey{GetProgramBinaryDeviceKey()}
+// clang-format on
+{
+    auto pCacheData = InitCacheFile(CreateInfo, GetCacheFileDeviceKey(m_DeviceKey).c_str());
+
+    const void* pData    = pCacheData ? pCacheData->GetConstDataPtr() : CreateInfo.pCacheData;
+    const auto  DataSize = pCacheData ? pCacheData->GetSize() : size_t{CreateInfo.CacheDataSize};
+    if (pData != nullptr && DataSize > 0 && !Deserialize(pData, DataSize))
+    {
+        LOG_INFO_MESSAGE("Program binary cache data is not compatible with the device and will be ignored.");
+        m_Programs.clear();
+    }
+}
+
+PipelineStateCacheGLImpl::~PipelineStateCacheGLImpl()
+{
+    FlushCacheFile();
+}
+
+bool PipelineStateCacheGLImpl::Deserialize(const void* pData, size_t DataSize)
+{
+    Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(pData), DataSize}};
+
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+    if (!Ser(Magic, Version) || Magic != ProgramBinaryCacheMagic || Version != ProgramBinaryCacheVersion)
+        return false;
+
+    const char* DeviceKey   = nullptr;
+    Uint32      NumPrograms = 0;
+    if (!Ser(DeviceKey, NumPrograms) || m_DeviceKey != DeviceKey)
+        return false;
+
+    m_Programs.reserve(NumPrograms);
+    for (Uint32 i = 0; i < NumPrograms; ++i)
+    {
+        Uint64      Hash       = 0;
+        Uint32      Format     = 0;
+        const void* pBinary    = nullptr;
+        size_t      BinarySize = 0;
+        if (!Ser(Hash, Format) || !Ser.SerializeBytes(pBinary, BinarySize, 1))
+            return false;
+
+        auto& Program  = m_Programs[static_cast<size_t>(Hash)];
+        Program.Format = static_cast<GLenum>(Format);
+        Program.Data.assign(static_cast<const Uint8*>(pBinary), static_cast<const Uint8*>(pBinary) + BinarySize);
+    }
+
+    return Ser.IsEnded();
+}
+
+void PipelineStateCacheGLImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    *ppBlob = nullptr;
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+
+    const auto SerializeData = [this](auto& Ser) {
+        const char*  DeviceKey   = m_DeviceKey.c_str();
+        const Uint32 NumPrograms = static_cast<Uint32>(m_Programs.size());
+        if (!Ser(ProgramBinaryCacheMagic, ProgramBinaryCacheVersion, DeviceKey, NumPrograms))
+            return false;
+
+        for (const auto& it : m_Programs)
+        {
+            const Uint64 Hash   = it.first;
+            const Uint32 Format = it.second.Format;
+            if (!Ser(Hash, Format) || !Ser.SerializeBytes(it.second.Data.data(), it.second.Data.size(), 1))
+                return false;
+        }
+        return true;
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeData(MeasureSer);
+
+    auto pDataBlob = DataBlobImpl::Create(MeasureSer.GetSize());
+
+    Serializer<SerializerMode::Write> Ser{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
+    if (!SerializeData(Ser) || !Ser.IsEnded())
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize program binary cache");
+        return;
+    }
+
+    *ppBlob = pDataBlob.Detach();
+}
+
+Bool PipelineStateCacheGLImpl::Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches)
+{
+    DEV_CHECK_ERR(NumSrcCaches == 0 || ppSrcCaches != nullptr, "ppSrcCaches must not be null");
+
+    for (Uint32 i = 0; i < NumSrcCaches; ++i)
+    {
+        auto* pSrcCacheGL = ClassPtrCast<PipelineStateCacheGLImpl>(ppSrcCaches[i]);
+        if (pSrcCacheGL == nullptr)
+            continue;
+
+        DEV_CHECK_ERR(pSrcCacheGL != this, "Pipeline state cache can't be merged with itself");
+        DEV_CHECK_ERR(pSrcCacheGL->GetDevice() == GetDevice(), "Source cache '", pSrcCacheGL->GetDesc().Name, "' was created by another device");
+
+        // Always lock the caches in the same order to avoid deadlocks
+        std::unique_lock<std::mutex> DstLock{m_ProgramsMtx, std::defer_lock};
+        std::unique_lock<std::mutex> SrcLock{pSrcCacheGL->m_ProgramsMtx, std::defer_lock};
+        std::lock(DstLock, SrcLock);
+
+        // Existing programs take precedence
+        m_Programs.insert(pSrcCacheGL->m_Programs.begin(), pSrcCacheGL->m_Programs.end());
+    }
+
+    return True;
+}
+
+size_t PipelineStateCacheGLImpl::ComputeProgramHash(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+{
+    size_t Hash = ComputeHash(NumShaders, IsSeparableProgram);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        const void* pSource    = nullptr;
+        Uint64      SourceSize = 0;
+        ppShaders[i]->GetBytecode(&pSource, SourceSize);
+        HashCombine(Hash, ppShaders[i]->GetDesc().ShaderType, ComputeHashRaw(pSource, static_cast<size_t>(SourceSize)));
+    }
+    return Hash;
+}
+
+void PipelineStateCacheGLImpl::OnProgramLookup(bool Hit)
+{
+    const PIPELINE_CACHE_RESULT CacheResult = Hit ? PIPELINE_CACHE_RESULT_HIT : PIPELINE_CACHE_RESULT_MISS;
+
+    m_pDevice->OnPipelineCacheLookup(Hit);
+    OnPipelineCreated(CacheResult, 0);
+    if (auto* pScope = CompilationRecordScope::GetCurrent())
+        pScope->SetPipelineFeedback(CacheResult, 0);
+}
+
+GLObjectWrappers::GLProgramObj PipelineStateCacheGLImpl::LoadProgram(size_t ProgramHash, bool IsSeparableProgram)
+{
+#if GL_ARB_get_program_binary
+    if ((m_Desc.Mode & PSO_CACHE_MODE_LOAD) == 0)
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+
+    auto it = m_Programs.find(ProgramHash);
+    if (it == m_Programs.end())
+    {
+        OnProgramLookup(false);
+        return GLObjectWrappers::GLProgramObj::Null();
+    }
+
+    GLObjectWrappers::GLProgramObj GLProg{true};
+    if (IsSeparableProgram)
+        glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+    const auto& Binary = it->second;
+    glProgramBinary(GLProg, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+
+    // The driver may reject the binary, e.g. after an update. In this case the program
+    // must be linked from the source, and the stale binary is replaced by StoreProgram().
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+    if (glGetError() != GL_NO_ERROR || !IsLinked)
+    {
+        LOG_INFO_MESSAGE("Cached program binary was rejected by the driver; the program will be linked from the source.");
+        m_Programs.erase(it);
+        OnProgramLookup(false);
+        return GLObjectWrappers::GLProgramObj::Null();
+    }
+
+    OnProgramLookup(true);
+    return GLProg;
+#else
+    return GLObjectWrappers::GLProgramObj::Null();
+#endif
+}
+
+void PipelineStateCacheGLImpl::StoreProgram(size_t ProgramHash, GLuint GLProg)
+{
+#if GL_ARB_get_program_binary
+    if ((m_Desc.Mode & PSO_CACHE_MODE_STORE) == 0)
+        return;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProg, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(static_cast<size_t>(BinaryLength));
+    GLsizei Length = 0;
+    glGetProgramBinary(GLProg, BinaryLength, &Length, &Binary.Format, Binary.Data.data());
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        LOG_INFO_MESSAGE("Failed to retrieve program binary");
+        return;
+    }
+    Binary.Data.resize(static_cast<size_t>(Length));
+
+    std::lock_guard<std::mutex> Lock{m_ProgramsMtx};
+    m_Programs[ProgramHash] = std::move(Binary);
+#endif
+}
+
+} // namespace Diligent
@@ -35,6 +35,7 @@
 #include "DeviceContextGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "EngineMemory.h"
 
@@ -141,10 +142,11 @@ PipelineResourceSignatureDescWrapper PipelineStateGLImpl::GetDefaultSignatureDes
     {
         auto pImmediateCtx = m_pDevice->GetImmediateContext(0);
         VERIFY_EXPR(pImmediateCtx);
-        VERIFY_EXPR(m_GLPrograms[0] != 0);
+        const auto& GLProg = m_pProgramSet->Programs[0];
+        VERIFY_EXPR(GLProg != 0);
 
         const auto SamplerResFlag = GetSamplerResourceFlag(ShaderStages, true /*SilenceWarning*/);
-        ProgramResources.LoadUniforms(ActiveStages, SamplerResFlag, m_GLPrograms[0], pImmediateCtx->GetContextState());
+        ProgramResources.LoadUniforms(ActiveStages, SamplerResFlag, GLProg, pImmediateCtx->GetContextState());
         ProgramResources.ProcessConstResources(HandleResource, HandleResource, HandleResource, HandleResource);
 
         if (ResourceLayout.NumImmutableSamplers > 0)
@@ -161,29 +163,52 @@ PipelineResourceSignatureDescWrapper PipelineStateGLImpl::GetDefaultSignatureDes
     return SignDesc;
 }
 
-void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalFlags,
-                                             const TShaderStages&      ShaderStages,
-                                             SHADER_TYPE               ActiveStages)
+void PipelineStateGLImpl::CreateDefaultSignature(PSO_CREATE_INTERNAL_FLAGS InternalFlags,
+                                                 const TShaderStages&      ShaderStages,
+                                                 SHADER_TYPE               ActiveStages)
 {
-    if (m_UsingImplicitSignature)
+    VERIFY_EXPR(m_UsingImplicitSignature);
+    if ((InternalFlags & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0)
     {
-        if ((InternalFlags & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0)
-        {
-            // Release deserialized default signature as it is empty in OpenGL.
-            // We need to create a new one from scratch.
-            m_Signatures[0].Release();
-        }
+        // Release deserialized default signature as it is empty in OpenGL.
+        // We need to create a new one from scratch.
+        m_Signatures[0].Release();
+    }
+
+    const auto SignDesc = GetDefaultSignatureDesc(ShaderStages, ActiveStages);
+    // Always initialize default resource signature as internal device object.
+    // This is necessary to avoid cyclic references from TexRegionRenderer.
+    // This may never be a problem as the PSO keeps the reference to the device if necessary.
+    constexpr bool bIsDeviceInternal = true;
+    InitDefaultSignature(SignDesc, GetActiveShaderStages(), bIsDeviceInternal);
+    VERIFY_EXPR(m_Signatures[0]);
+}
 
-        const auto SignDesc = GetDefaultSignatureDesc(ShaderStages, ActiveStages);
-        // Always initialize default resource signature as internal device object.
-        // This is necessary to avoid cyclic references from TexRegionRenderer.
-        // This may never be a problem as the PSO keeps the reference to the device if necessary.
-        constexpr bool bIsDeviceInternal = true;
-        InitDefaultSignature(SignDesc, GetActiveShaderStages(), bIsDeviceInternal);
-        VERIFY_EXPR(m_Signatures[0]);
+bool PipelineStateGLImpl::FindCachedPrograms()
+{
+    VERIFY_EXPR(m_pProgramSet && !m_pProgramSet->IsInitialized);
+
+    auto& Signatures = m_pProgramSet->Signatures;
+    Signatures.assign(m_Signatures, m_Signatures + m_SignatureCount);
+    if (auto pCachedSet = GetDevice()->GetProgramCache().Find(*m_pProgramSet))
+    {
+        m_pProgramSet = std::move(pCachedSet);
+        return true;
     }
+    return false;
+}
+
+void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalFlags,
+                                             const TShaderStages&      ShaderStages,
+                                             SHADER_TYPE               ActiveStages,
+                                             bool                      bCreateDefaultSignature)
+{
+    if (bCreateDefaultSignature)
+        CreateDefaultSignature(InternalFlags, ShaderStages, ActiveStages);
+
+    const auto NumPrograms = GetNumShaderStages();
 
-    std::vector<std::shared_ptr<const ShaderResourcesGL>> ProgResources(m_NumPrograms);
+    std::vector<std::shared_ptr<const ShaderResourcesGL>> ProgResources(NumPrograms);
     if (m_IsProgramPipelineSupported)
     {
         for (size_t i = 0; i < ShaderStages.size(); ++i)
@@ -197,17 +222,23 @@ void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalF
     {
         auto pImmediateCtx = m_pDevice->GetImmediateContext(0);
         VERIFY_EXPR(pImmediateCtx != nullptr);
-        VERIFY_EXPR(m_GLPrograms[0] != 0);
+        const auto& GLProg = m_pProgramSet->Programs[0];
+        VERIFY_EXPR(GLProg != 0);
 
         const auto SamplerResFlag = GetSamplerResourceFlag(ShaderStages, false /*SilenceWarning*/);
 
         auto pResources = std::make_shared<ShaderResourcesGL>();
-        pResources->LoadUniforms(ActiveStages, GetSamplerResourceFlag(ShaderStages, SamplerResFlag), m_GLPrograms[0], pImmediateCtx->GetContextState());
+        pResources->LoadUniforms(ActiveStages, GetSamplerResourceFlag(ShaderStages, SamplerResFlag), GLProg, pImmediateCtx->GetContextState());
         ProgResources[0] = pResources;
         ValidateShaderResources(std::move(pResources), m_Desc.Name, ActiveStages);
     }
 
-    // Apply resource bindings to programs.
+    // When the default signature is created from the program reflection, the programs can only be looked up
+    // in the cache after they have been linked. Our own programs are then released in favor of the cached ones.
+    const bool ApplyBindings = !m_pProgramSet->IsInitialized && !FindCachedPrograms();
+
+    // Apply resource bindings to programs, unless the programs are shared with another pipeline
+    // that has already applied identical bindings.
     auto& CtxState = m_pDevice->GetImmediateContext(0)->GetContextState();
 
     PipelineResourceSignatureGLImpl::TBindings Bindings = {};
@@ -218,8 +249,11 @@ void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalF
             continue;
 
         m_BaseBindings[s] = Bindings;
-        for (Uint32 p = 0; p < m_NumPrograms; ++p)
-            pSignature->ApplyBindings(m_GLPrograms[p], *ProgResources[p], CtxState, Bindings);
+        if (ApplyBindings)
+        {
+            for (Uint32 p = 0; p < NumPrograms; ++p)
+                pSignature->ApplyBindings(m_pProgramSet->Programs[p], *ProgResources[p], CtxState, Bindings);
+        }
 
         pSignature->ShiftBindings(Bindings);
     }
@@ -234,31 +268,40 @@ void PipelineStateGLImpl::InitResourceLayout(PSO_CREATE_INTERNAL_FLAGS InternalF
         LOG_ERROR_AND_THROW("The number of bindings in range '", GetBindingRangeName(BINDING_RANGE_STORAGE_BUFFER), "' is greater than the maximum allowed (", Limits.MaxStorageBlock, ").");
     if (Bindings[BINDING_RANGE_IMAGE] > static_cast<Uint32>(Limits.MaxImagesUnits))
         LOG_ERROR_AND_THROW("The number of bindings in range '", GetBindingRangeName(BINDING_RANGE_IMAGE), "' is greater than the maximum allowed (", Limits.MaxImagesUnits, ").");
+
+    if (ApplyBindings)
+    {
+        m_pProgramSet->IsInitialized = true;
+        // Another pipeline may have added identical programs in the meantime
+        m_pProgramSet = GetDevice()->GetProgramCache().Add(std::move(m_pProgramSet));
+    }
 }
 
 template <typename PSOCreateInfoType>
-void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages)
+void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages, bool DeferLink)
 {
     const auto& DeviceInfo = GetDevice()->GetDeviceInfo();
     VERIFY(DeviceInfo.Type != RENDER_DEVICE_TYPE_UNDEFINED, "Device info is not initialized");
 
     m_IsProgramPipelineSupported = DeviceInfo.Features.SeparablePrograms != DEVICE_FEATURE_STATE_DISABLED;
-    m_NumPrograms                = m_IsProgramPipelineSupported ? static_cast<Uint8>(ShaderStages.size()) : 1;
+    const Uint32 NumPrograms     = m_IsProgramPipelineSupported ? static_cast<Uint32>(ShaderStages.size()) : 1;
 
     FixedLinearAllocator MemPool{GetRawAllocator()};
 
     ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
-    MemPool.AddSpace<GLProgramObj>(m_NumPrograms);
     const auto SignCount = GetResourceSignatureCount(); // Must be called after ReserveSpaceForPipelineDesc()
     MemPool.AddSpace<TBindings>(SignCount);
-    MemPool.AddSpace<SHADER_TYPE>(m_NumPrograms);
 
     MemPool.Reserve();
 
     InitializePipelineDesc(CreateInfo, MemPool);
-    m_GLPrograms   = MemPool.ConstructArray<GLProgramObj>(m_NumPrograms, false);
     m_BaseBindings = MemPool.ConstructArray<TBindings>(SignCount);
-    m_ShaderTypes  = MemPool.ConstructArray<SHADER_TYPE>(m_NumPrograms, SHADER_TYPE_UNKNOWN);
+
+    m_pProgramSet              = std::make_shared<GLProgramCache::ProgramSet>();
+    m_pProgramSet->IsSeparable = m_IsProgramPipelineSupported;
+    m_pProgramSet->ShaderIds.reserve(ShaderStages.size());
+    for (auto* pShaderGL : ShaderStages)
+        m_pProgramSet->ShaderIds.push_back(pShaderGL->GetUniqueID());
 
     // Get active shader stages.
     SHADER_TYPE ActiveStages = SHADER_TYPE_UNKNOWN;
@@ -269,25 +312,144 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
         ActiveStages |= ShaderType;
     }
 
+    const auto InternalFlags = GetInternalCreateFlags(CreateInfo);
+
+    // Separable programs do not need to be linked to create the default signature from the shader reflection,
+    // unless the shaders are still being compiled.
+    const bool EarlyDefaultSignature = m_UsingImplicitSignature && m_IsProgramPipelineSupported && !DeferLink;
+    if (EarlyDefaultSignature)
+        CreateDefaultSignature(InternalFlags, ShaderStages, ActiveStages);
+
+    // When all signatures are known, look up the programs in the cache before linking.
+    const bool UseCachedPrograms = (!m_UsingImplicitSignature || EarlyDefaultSignature) && FindCachedPrograms();
+
+    auto* const pPSOCacheGL = ClassPtrCast<PipelineStateCacheGLImpl>(CreateInfo.pPSOCache);
+
+    if (DeferLink)
+    {
+        m_pPendingLink                = std::make_unique<PendingLinkInfo>();
+        m_pPendingLink->pPSOCache     = pPSOCacheGL;
+        m_pPendingLink->InternalFlags = InternalFlags;
+        m_pPendingLink->ActiveStages  = ActiveStages;
+        m_pPendingLink->Shaders.assign(ShaderStages.begin(), ShaderStages.end());
+    }
+
+    const auto CreateProgram = [&](Uint32 ProgIdx, ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram) {
+        if (!DeferLink)
+            return ShaderGLImpl::LinkProgram(ppShaders, NumShaders, IsSeparableProgram, pPSOCacheGL);
+
+        size_t ProgramHash = 0;
+        if (pPSOCacheGL != nullptr)
+        {
+            ProgramHash = PipelineStateCacheGLImpl::ComputeProgramHash(ppShaders, NumShaders, IsSeparableProgram);
+            if (auto GLProg = pPSOCacheGL->LoadProgram(ProgramHash, IsSeparableProgram))
+                return GLProg;
+        }
+
+        // The link status is checked by FinishPendingLink()
+        m_pPendingLink->LinkingPrograms.emplace_back(ProgIdx, ProgramHash);
+        return ShaderGLImpl::StartLinkProgram(ppShaders, NumShaders, IsSeparableProgram, pPSOCacheGL != nullptr);
+    };
+
     // Create programs.
-    if (m_IsProgramPipelineSupported)
+    if (!UseCachedPrograms)
     {
-        for (size_t i = 0; i < ShaderStages.size(); ++i)
+        auto& Programs    = m_pProgramSet->Programs;
+        auto& ShaderTypes = m_pProgramSet->ShaderTypes;
+        Programs.reserve(NumPrograms);
+        ShaderTypes.reserve(NumPrograms);
+        if (m_IsProgramPipelineSupported)
         {
-            auto* pShaderGL  = ShaderStages[i];
-            m_GLPrograms[i]  = GLProgramObj{ShaderGLImpl::LinkProgram(&ShaderStages[i], 1, true)};
-            m_ShaderTypes[i] = pShaderGL->GetDesc().ShaderType;
+            for (Uint32 i = 0; i < ShaderStages.size(); ++i)
+            {
+                auto* pShaderGL = ShaderStages[i];
+                Programs.emplace_back(CreateProgram(i, &ShaderStages[i], 1, true));
+                ShaderTypes.push_back(pShaderGL->GetDesc().ShaderType);
+            }
+        }
+        else
+        {
+            Programs.emplace_back(CreateProgram(0, ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false));
+            ShaderTypes.push_back(ActiveStages);
+
+            Programs[0].SetName(m_Desc.Name);
         }
     }
-    else
+    VERIFY_EXPR(GetNumShaderStages() == NumPrograms);
+
+    // Resource layout requires linked programs and shader reflection
+    if (!DeferLink)
+        InitResourceLayout(InternalFlags, ShaderStages, ActiveStages, m_UsingImplicitSignature && !EarlyDefaultSignature);
+}
+
+bool PipelineStateGLImpl::IsParallelLinkEnabled(const PipelineStateCreateInfo& CreateInfo) const
+{
+    return (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 && GetDevice()->IsParallelShaderCompileSupported();
+}
+
+bool PipelineStateGLImpl::IsPendingLinkCompleted()
+{
+    VERIFY_EXPR(m_pPendingLink);
+    for (const auto& Prog : m_pPendingLink->LinkingPrograms)
+    {
+        if (!ShaderGLImpl::IsCompletionStatusSet(m_pProgramSet->Programs[Prog.first], /*IsProgram = */ true))
+            return false;
+    }
+    for (auto& pShader : m_pPendingLink->Shaders)
+    {
+        if (pShader->GetStatus(/*WaitForCompletion = */ false) == SHADER_STATUS_COMPILING)
+            return false;
+    }
+    return true;
+}
+
+void PipelineStateGLImpl::FinishPendingLink() noexcept(false)
+{
+    VERIFY_EXPR(m_pPendingLink);
+    std::unique_ptr<PendingLinkInfo> pLinkInfo{std::move(m_pPendingLink)};
+
+    TShaderStages ShaderStages;
+    ShaderStages.reserve(pLinkInfo->Shaders.size());
+    for (auto& pShader : pLinkInfo->Shaders)
+    {
+        if (pShader->GetStatus(/*WaitForCompletion = */ true) != SHADER_STATUS_READY)
+            LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' used by pipeline state '", m_Desc.Name, "' failed to compile.");
+        ShaderStages.push_back(pShader);
+    }
+
+    for (const auto& Prog : pLinkInfo->LinkingPrograms)
+    {
+        const auto& GLProg = m_pProgramSet->Programs[Prog.first];
+        if (!ShaderGLImpl::CheckLinkStatus(GLProg))
+            LOG_ERROR_AND_THROW("Failed to link program of pipeline state '", m_Desc.Name, "'.");
+
+        if (pLinkInfo->pPSOCache)
+            pLinkInfo->pPSOCache->StoreProgram(Prog.second, GLProg);
+    }
+
+    InitResourceLayout(pLinkInfo->InternalFlags, ShaderStages, pLinkInfo->ActiveStages, m_UsingImplicitSignature);
+}
+
+PIPELINE_STATE_STATUS PipelineStateGLImpl::GetStatus(bool WaitForCompletion)
+{
+    if (m_pPendingLink)
     {
-        m_GLPrograms[0]  = ShaderGLImpl::LinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false);
-        m_ShaderTypes[0] = ActiveStages;
+        if (!WaitForCompletion && !IsPendingLinkCompleted())
+            return PIPELINE_STATE_STATUS_COMPILING;
 
-        m_GLPrograms[0].SetName(m_Desc.Name);
+        try
+        {
+            FinishPendingLink();
+            SetStatus(PIPELINE_STATE_STATUS_READY);
+        }
+        catch (...)
+        {
+            LOG_ERROR_MESSAGE("Failed to initialize pipeline state '", m_Desc.Name, "'.");
+            SetStatus(PIPELINE_STATE_STATUS_FAILED);
+        }
     }
 
-    InitResourceLayout(GetInternalCreateFlags(CreateInfo), ShaderStages, ActiveStages);
+    return TPipelineStateBase::GetStatus(WaitForCompletion);
 }
 
 PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                    pRefCounters,
@@ -306,25 +468,47 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*
 {
     try
     {
-        TShaderStages Shaders;
-        ExtractShaders<ShaderGLImpl>(CreateInfo, Shaders);
+        const auto InitPipeline = [this](const GraphicsPipelineStateCreateInfo& CI, bool DeferLink) //
+        {
+            TShaderStages Shaders;
+            ExtractShaders<ShaderGLImpl>(CI, Shaders);
+
+            RefCntAutoPtr<ShaderGLImpl> pTempPS;
+            if (CI.pPS == nullptr)
+            {
+                // Some OpenGL implementations fail if fragment shader is not present, so
+                // create a dummy one.
+                ShaderCreateInfo ShaderCI;
+                ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+                ShaderCI.Source          = "void main(){}";
+                ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+                ShaderCI.Desc.Name       = "Dummy fragment shader";
+                m_pDevice->CreateShader(ShaderCI, pTempPS.DblPtr<IShader>());
+
+                Shaders.emplace_back(pTempPS);
+            }
 
-        RefCntAutoPtr<ShaderGLImpl> pTempPS;
-        if (CreateInfo.pPS == nullptr)
+            InitInternalObjects(CI, Shaders, DeferLink);
+        };
+
+        if (IsParallelLinkEnabled(CreateInfo))
         {
-            // Some OpenGL implementations fail if fragment shader is not present, so
-            // create a dummy one.
-            ShaderCreateInfo ShaderCI;
-            ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
-            ShaderCI.Source          = "void main(){}";
-            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
-            ShaderCI.Desc.Name       = "Dummy fragment shader";
-            pDeviceGL->CreateShader(ShaderCI, pTempPS.DblPtr<IShader>());
-
-            Shaders.emplace_back(pTempPS);
+            // The driver links the programs in parallel, and the pipeline is finalized by GetStatus()
+            InitPipeline(CreateInfo, /*DeferLink = */ true);
+            SetStatus(PIPELINE_STATE_STATUS_COMPILING);
+        }
+        else
+        {
+            // GL programs must be created in the thread that owns the GL context,
+            // so asynchronous initialization is not supported.
+            InitializePipeline(
+                CreateInfo,
+                [&InitPipeline](const GraphicsPipelineStateCreateInfo& CI) //
+                {
+                    InitPipeline(CI, /*DeferLink = */ false);
+                },
+                /*AllowAsync = */ false);
         }
-
-        InitInternalObjects(CreateInfo, Shaders);
     }
     catch (...)
     {
@@ -349,10 +533,30 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                   p
 {
     try
     {
-        TShaderStages Shaders;
-        ExtractShaders<ShaderGLImpl>(CreateInfo, Shaders);
+        const auto InitPipeline = [this](const ComputePipelineStateCreateInfo& CI, bool DeferLink) //
+        {
+            TShaderStages Shaders;
+            ExtractShaders<ShaderGLImpl>(CI, Shaders);
 
-        InitInternalObjects(CreateInfo, Shaders);
+            InitInternalObjects(CI, Shaders, DeferLink);
+        };
+
+        if (IsParallelLinkEnabled(CreateInfo))
+        {
+            // The driver links the programs in parallel, and the pipeline is finalized by GetStatus()
+            InitPipeline(CreateInfo, /*DeferLink = */ true);
+            SetStatus(PIPELINE_STATE_STATUS_COMPILING);
+        }
+        else
+        {
+            InitializePipeline(
+                CreateInfo,
+                [&InitPipeline](const ComputePipelineStateCreateInfo& CI) //
+                {
+                    InitPipeline(CI, /*DeferLink = */ false);
+                },
+                /*AllowAsync = */ false);
+        }
     }
     catch (...)
     {
@@ -370,17 +574,8 @@ void PipelineStateGLImpl::Destruct()
 {
     GetDevice()->OnDestroyPSO(*this);
 
-    if (m_GLPrograms)
-    {
-        for (Uint32 i = 0; i < m_NumPrograms; ++i)
-        {
-            m_GLPrograms[i].~GLProgramObj();
-        }
-        m_GLPrograms = nullptr;
-    }
-
-    m_ShaderTypes = nullptr;
-    m_NumPrograms = 0;
+    m_pPendingLink.reset();
+    m_pProgramSet.reset();
 
     TPipelineStateBase::Destruct();
 }
@@ -389,8 +584,8 @@ IMPLEMENT_QUERY_INTERFACE2(PipelineStateGLImpl, IID_PipelineStateGL, IID_Interna
 
 SHADER_TYPE PipelineStateGLImpl::GetShaderStageType(Uint32 Index) const
 {
-    VERIFY(Index < m_NumPrograms, "Index is out of range");
-    return m_ShaderTypes[Index];
+    VERIFY(Index < GetNumShaderStages(), "Index is out of range");
+    return m_pProgramSet->ShaderTypes[Index];
 }
 
 
@@ -402,46 +597,17 @@ void PipelineStateGLImpl::CommitProgram(GLContextState& State)
         // a program pipeline bound, all rendering will use the program that is in use, not the pipeline programs!
         // So make sure that glUseProgram(0) has been called if pipeline is in use
         State.SetProgram(GLObjectWrappers::GLProgramObj::Null());
-        auto& Pipeline = GetGLProgramPipeline(State.GetCurrentGLContext());
+        auto& Pipeline = m_pProgramSet->GetProgramPipeline(State.GetCurrentGLContext(), m_Desc.Name);
         VERIFY(Pipeline != 0, "Program pipeline must not be null");
         State.SetPipeline(Pipeline);
     }
     else
     {
-        VERIFY_EXPR(m_GLPrograms != nullptr);
-        State.SetProgram(m_GLPrograms[0]);
+        VERIFY_EXPR(m_pProgramSet && !m_pProgramSet->Programs.empty());
+        State.SetProgram(m_pProgramSet->Programs[0]);
     }
 }
 
-GLObjectWrappers::GLPipelineObj& PipelineStateGLImpl::GetGLProgramPipeline(GLContext::NativeGLContextType Context)
-{
-    Threading::SpinLockGuard Guard{m_ProgPipelineLock};
-    for (auto& ctx_pipeline : m_GLProgPipelines)
-    {
-        if (ctx_pipeline.first == Context)
-            return ctx_pipeline.second;
-    }
-
-    // Create new program pipeline
-    m_GLProgPipelines.emplace_back(Context, true);
-    auto&  ctx_pipeline = m_GLProgPipelines.back();
-    GLuint Pipeline     = ctx_pipeline.second;
-    for (Uint32 i = 0; i < GetNumShaderStages(); ++i)
-    {
-        auto GLShaderBit = ShaderTypeToGLShaderBit(GetShaderStageType(i));
-        // If the program has an active code for each stage mentioned in set flags,
-        // then that code will be used by the pipeline. If program is 0, then the given
-        // stages are cleared from the pipeline.
-        glUseProgramStages(Pipeline, GLShaderBit, m_GLPrograms[i]);
-        CHECK_GL_ERROR("glUseProgramStages() failed");
-    }
-
-    ctx_pipeline.second.SetName(m_Desc.Name);
-
-    return ctx_pipeline.second;
-}
-
-
 void PipelineStateGLImpl::ValidateShaderResources(std::shared_ptr<const ShaderResourcesGL> pShaderResources, const char* ShaderName, SHADER_TYPE ShaderStages)
 {
     const auto HandleResource = [&](const ShaderResourcesGL::GLResourceAttribs& Attribs,
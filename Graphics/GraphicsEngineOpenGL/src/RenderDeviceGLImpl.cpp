@@ -47,12 +47,17 @@
 #include "RenderPassGLImpl.hpp"
 #include "FramebufferGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
 
+#if !DILIGENT_NO_HLSL
+#    include "HLSL2GLSLConverterImpl.hpp"
+#endif
+
 namespace Diligent
 {
 
@@ -179,7 +184,9 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 {
     VerifyEngineGLCreateInfo(EngineCI);
 
-    VERIFY(EngineCI.NumDeferredContexts == 0, "EngineCI.NumDeferredContexts > 0 should've been caught by CreateDeviceAndSwapChainGL() or AttachToActiveGLContext()");
+#if !DILIGENT_NO_HLSL
+    m_pHLSL2GLSLTokenCache = std::make_shared<HLSL2GLSLTokenCache>();
+#endif
 
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
@@ -269,6 +276,53 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #endif
         }
     }
+
+#if GL_ARB_get_program_binary
+    {
+        GLint NumBinaryFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumBinaryFormats);
+        // The query fails if neither GL4.1/GLES3.0 nor GL_ARB_get_program_binary is supported
+        m_IsProgramBinarySupported = glGetError() == GL_NO_ERROR && NumBinaryFormats > 0;
+    }
+#endif
+
+#if GL_KHR_parallel_shader_compile || GL_ARB_parallel_shader_compile
+    {
+        // Let the driver choose the number of shader compiler threads
+        constexpr GLuint MaxShaderCompilerThreads = 0xFFFFFFFFu;
+#    if GL_KHR_parallel_shader_compile
+        if (CheckExtension("GL_KHR_parallel_shader_compile") && glMaxShaderCompilerThreadsKHR != nullptr)
+        {
+            glMaxShaderCompilerThreadsKHR(MaxShaderCompilerThreads);
+            m_IsParallelShaderCompileSupported = true;
+        }
+#    endif
+#    if GL_ARB_parallel_shader_compile
+        if (!m_IsParallelShaderCompileSupported && CheckExtension("GL_ARB_parallel_shader_compile") && glMaxShaderCompilerThreadsARB != nullptr)
+        {
+            glMaxShaderCompilerThreadsARB(MaxShaderCompilerThreads);
+            m_IsParallelShaderCompileSupported = true;
+        }
+#    endif
+    }
+#endif
+
+#if GL_ARB_buffer_storage
+    {
+        const bool IsGL44OrAbove = m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && m_DeviceInfo.APIVersion >= Version{4, 4};
+        m_IsBufferStorageSupported =
+            (IsGL44OrAbove || CheckExtension("GL_ARB_buffer_storage") || CheckExtension("GL_EXT_buffer_storage")) && glBufferStorage != nullptr;
+    }
+#endif
+
+#if GL_ARB_bindless_texture
+    m_IsBindlessTextureSupported =
+        CheckExtension("GL_ARB_bindless_texture") &&
+        glGetTextureHandleARB != nullptr &&
+        glGetTextureSamplerHandleARB != nullptr &&
+        glMakeTextureHandleResidentARB != nullptr &&
+        glMakeTextureHandleNonResidentARB != nullptr;
+#endif
 }
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
@@ -307,7 +361,8 @@ void RenderDeviceGLImpl::CreateShader(const ShaderCreateInfo& ShaderCreateInfo,
 {
     const ShaderGLImpl::CreateInfo GLShaderCI{
         GetDeviceInfo(),
-        GetAdapterInfo() //
+        GetAdapterInfo(),
+        m_pHLSL2GLSLTokenCache.get() //
     };
     CreateShaderImpl(ppShader, ShaderCreateInfo, GLShaderCI, bIsDeviceInternal);
 }
@@ -480,6 +535,11 @@ void RenderDeviceGLImpl::CreateGraphicsPipelineState(const GraphicsPipelineState
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo, false);
 }
 
+void RenderDeviceGLImpl::CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
+{
+    CreateDerivedGraphicsPipelineStateImpl(CreateInfo, ppPipelineState);
+}
+
 void RenderDeviceGLImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo, false);
@@ -566,7 +626,13 @@ void RenderDeviceGLImpl::CreateDeviceMemory(const DeviceMemoryCreateInfo& Create
 void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
                                                   IPipelineStateCache**               ppPSOCache)
 {
-    *ppPSOCache = nullptr;
+    if (m_IsProgramBinarySupported)
+        CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
+    else
+    {
+        LOG_INFO_MESSAGE("Pipeline state cache is not supported as the driver does not support program binaries");
+        *ppPSOCache = nullptr;
+    }
 }
 
 SparseTextureFormatInfo RenderDeviceGLImpl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
@@ -700,6 +766,8 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         Features.NativeFence                = DEVICE_FEATURE_STATE_DISABLED;
         Features.TileShaders                = DEVICE_FEATURE_STATE_DISABLED;
         Features.SubpassFramebufferFetch    = DEVICE_FEATURE_STATE_DISABLED;
+        Features.WorkGraphs                 = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ConditionalRendering       = DEVICE_FEATURE_STATE_DISABLED;
 
         {
             bool WireframeFillSupported = (glPolygonMode != nullptr);
@@ -805,6 +873,10 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             // Separable programs may be disabled
             Features.SeparablePrograms = (IsGLES31OrAbove || strstr(Extensions, "separate_shader_objects")) ? DEVICE_FEATURE_STATE_OPTIONAL : DEVICE_FEATURE_STATE_DISABLED;
 
+            // Framebuffer fetch requires shaders to read input attachments with GL_EXT_shader_framebuffer_fetch,
+            // so it is only enabled when requested by the application.
+            Features.SubpassFramebufferFetch = CheckExtension("GL_EXT_shader_framebuffer_fetch") ? DEVICE_FEATURE_STATE_OPTIONAL : DEVICE_FEATURE_STATE_DISABLED;
+
             // clang-format off
             ENABLE_FEATURE(WireframeFill,                 false);
             ENABLE_FEATURE(MultithreadedResourceCreation, false);
@@ -997,7 +1069,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         m_AdapterInfo.Queues[0].TextureCopyGranularity[2] = 1;
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 43, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 }
 
 void RenderDeviceGLImpl::FlagSupportedTexFormats()
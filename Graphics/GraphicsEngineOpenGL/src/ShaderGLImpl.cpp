@@ -37,6 +37,8 @@
 #include "GLSLUtils.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 using namespace Diligent;
 
@@ -63,6 +65,22 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     m_SourceLanguage{ShaderCI.SourceLanguage},
     m_GLShaderObj{pDeviceGL != nullptr, GLObjectWrappers::GLShaderObjCreateReleaseHelper{GetGLShaderType(m_Desc.ShaderType)}}
 // clang-format on
+{
+    // OpenGL shaders must be compiled in the thread that owns the GL context,
+    // so asynchronous compilation is not supported.
+    InitializeShader(
+        ShaderCI,
+        [this, &GLShaderCI](const ShaderCreateInfo& CI) //
+        {
+            Initialize(CI, GLShaderCI);
+        },
+        /*AllowAsync = */ false);
+
+    if (m_IsCompilationPending)
+        SetStatus(SHADER_STATUS_COMPILING);
+}
+
+void ShaderGLImpl::Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& GLShaderCI) noexcept(false)
 {
     DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from the source code or a file");
     DEV_CHECK_ERR(ShaderCI.ShaderCompiler == SHADER_COMPILER_DEFAULT, "only default compiler is supported in OpenGL");
@@ -90,10 +108,11 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
         // platform definitions, user-provided shader macros, etc.
         m_GLSLSourceString = BuildGLSLSourceString(
             ShaderCI, DeviceInfo, AdapterInfo, TargetGLSLCompiler::driver,
-            (DeviceInfo.NDC.MinZ >= 0 ? NDCDefine : nullptr));
+            (DeviceInfo.NDC.MinZ >= 0 ? NDCDefine : nullptr),
+            GLShaderCI.pHLSL2GLSLTokenCache);
     }
 
-    if (pDeviceGL == nullptr)
+    if (GetDevice() == nullptr)
         return;
 
     // Note: there is a simpler way to create the program:
@@ -119,18 +138,46 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lengths.data());
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
-    glCompileShader(m_GLShaderObj);
+    {
+        CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
+        glCompileShader(m_GLShaderObj);
+    }
+
+    // Note: we have to always read reflection information in OpenGL as bindings are always assigned at run time.
+    if (DeviceInfo.Features.SeparablePrograms /*&& (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0*/)
+    {
+        // The program may be linked before the compile status is checked. This lets the driver
+        // that compiles shaders in parallel link the program without blocking.
+        ShaderGLImpl* const ThisShader[] = {this};
+        m_ReflectionProgram              = StartLinkProgram(ThisShader, 1, true, false);
+    }
+
+    if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 && GetDevice()->IsParallelShaderCompileSupported())
+    {
+        if (ShaderCI.ppCompilerOutput != nullptr)
+            LOG_WARNING_MESSAGE("Compiler output is not available for shader '", m_Desc.Name, "' as it is compiled asynchronously.");
+
+        // Compile status will be checked by GetStatus()
+        m_IsCompilationPending = true;
+        return;
+    }
+
+    FinishCompilation(ShaderCI.ppCompilerOutput);
+}
+
+void ShaderGLImpl::FinishCompilation(IDataBlob** ppCompilerOutput) noexcept(false)
+{
     GLint compiled = GL_FALSE;
     // Get compilation status
     glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
     if (!compiled)
     {
-        std::string FullSource;
-        for (const auto* str : ShaderStrings)
-            FullSource.append(str);
+        m_ReflectionProgram.Release();
+
+        const auto& FullSource = m_GLSLSourceString;
 
         std::stringstream ErrorMsgSS;
-        ErrorMsgSS << "Failed to compile shader file '" << (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : "") << '\'' << std::endl;
+        ErrorMsgSS << "Failed to compile shader file '" << (m_Desc.Name != nullptr ? m_Desc.Name : "") << '\'' << std::endl;
         int infoLogLen = 0;
         // The function glGetShaderiv() tells how many bytes to allocate; the length includes the NULL terminator.
         glGetShaderiv(m_GLShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
@@ -148,7 +195,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
                        << infoLog.data() << std::endl;
         }
 
-        if (ShaderCI.ppCompilerOutput != nullptr)
+        if (ppCompilerOutput != nullptr)
         {
             // infoLogLen accounts for null terminator
             auto  pOutputDataBlob = DataBlobImpl::Create(infoLogLen + FullSource.length() + 1);
@@ -156,7 +203,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
             if (infoLogLen > 0)
                 memcpy(DataPtr, infoLog.data(), infoLogLen);
             memcpy(DataPtr + infoLogLen, FullSource.data(), FullSource.length() + 1);
-            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ShaderCI.ppCompilerOutput));
+            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
         }
         else
         {
@@ -169,11 +216,11 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
         LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
     }
 
-    // Note: we have to always read reflection information in OpenGL as bindings are always assigned at run time.
-    if (DeviceInfo.Features.SeparablePrograms /*&& (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0*/)
+    if (m_ReflectionProgram)
     {
-        ShaderGLImpl* const            ThisShader[] = {this};
-        GLObjectWrappers::GLProgramObj Program      = LinkProgram(ThisShader, 1, true);
+        GLObjectWrappers::GLProgramObj Program{std::move(m_ReflectionProgram)};
+        if (!CheckLinkStatus(Program))
+            UNEXPECTED("glLinkProgram failed");
 
         auto pImmediateCtx = m_pDevice->GetImmediateContext(0);
         VERIFY_EXPR(pImmediateCtx);
@@ -189,6 +236,33 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     }
 }
 
+bool ShaderGLImpl::IsCompilationCompleted() const
+{
+    return IsCompletionStatusSet(m_GLShaderObj, false) && (!m_ReflectionProgram || IsCompletionStatusSet(m_ReflectionProgram, true));
+}
+
+SHADER_STATUS ShaderGLImpl::GetStatus(bool WaitForCompletion)
+{
+    if (m_IsCompilationPending)
+    {
+        if (!WaitForCompletion && !IsCompilationCompleted())
+            return SHADER_STATUS_COMPILING;
+
+        m_IsCompilationPending = false;
+        try
+        {
+            FinishCompilation(nullptr);
+            SetStatus(SHADER_STATUS_READY);
+        }
+        catch (...)
+        {
+            SetStatus(SHADER_STATUS_FAILED);
+        }
+    }
+
+    return TShaderBase::GetStatus(WaitForCompletion);
+}
+
 ShaderGLImpl::~ShaderGLImpl()
 {
 }
@@ -196,7 +270,32 @@ ShaderGLImpl::~ShaderGLImpl()
 IMPLEMENT_QUERY_INTERFACE2(ShaderGLImpl, IID_ShaderGL, IID_InternalImpl, TShaderBase)
 
 
-GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                         Uint32                    NumShaders,
+                                                         bool                      IsSeparableProgram,
+                                                         PipelineStateCacheGLImpl* pPSOCache)
+{
+    size_t ProgramHash = 0;
+    if (pPSOCache != nullptr)
+    {
+        ProgramHash = PipelineStateCacheGLImpl::ComputeProgramHash(ppShaders, NumShaders, IsSeparableProgram);
+        if (auto GLProg = pPSOCache->LoadProgram(ProgramHash, IsSeparableProgram))
+            return GLProg;
+    }
+
+    auto GLProg = StartLinkProgram(ppShaders, NumShaders, IsSeparableProgram, pPSOCache != nullptr);
+    if (!CheckLinkStatus(GLProg))
+        UNEXPECTED("glLinkProgram failed");
+    else if (pPSOCache != nullptr)
+        pPSOCache->StoreProgram(ProgramHash, GLProg);
+
+    return GLProg;
+}
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::StartLinkProgram(ShaderGLImpl* const* ppShaders,
+                                                              Uint32               NumShaders,
+                                                              bool                 IsSeparableProgram,
+                                                              bool                 RetrievableBinary)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
@@ -206,6 +305,12 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+#if GL_ARB_get_program_binary
+    // Some drivers only keep the binary if the hint is set before linking
+    if (RetrievableBinary)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
@@ -223,8 +328,25 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
     //compatible program on the other side of the interface. If a mismatch
     //between programs occurs, no GL error will be generated, but some or all
     //of the inputs on the interface will be undefined.
-    glLinkProgram(GLProg);
-    CHECK_GL_ERROR("glLinkProgram() failed");
+    {
+        CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
+        glLinkProgram(GLProg);
+        CHECK_GL_ERROR("glLinkProgram() failed");
+    }
+
+    // Shaders may be detached right after the link command, even if the driver links the program in parallel.
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        auto* pCurrShader = ClassPtrCast<const ShaderGLImpl>(ppShaders[i]);
+        glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
+        CHECK_GL_ERROR("glDetachShader() failed");
+    }
+
+    return GLProg;
+}
+
+bool ShaderGLImpl::CheckLinkStatus(GLuint GLProg)
+{
     int IsLinked = GL_FALSE;
     glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
     CHECK_GL_ERROR("glGetProgramiv() failed");
@@ -242,17 +364,26 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
         glGetProgramInfoLog(GLProg, LengthWithNull, &Length, shaderProgramInfoLog.data());
         VERIFY(Length == LengthWithNull - 1, "Incorrect program info log len");
         LOG_ERROR_MESSAGE("Failed to link shader program:\n", shaderProgramInfoLog.data(), '\n');
-        UNEXPECTED("glLinkProgram failed");
     }
 
-    for (Uint32 i = 0; i < NumShaders; ++i)
-    {
-        auto* pCurrShader = ClassPtrCast<const ShaderGLImpl>(ppShaders[i]);
-        glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
-        CHECK_GL_ERROR("glDetachShader() failed");
-    }
+    return IsLinked != GL_FALSE;
+}
 
-    return GLProg;
+bool ShaderGLImpl::IsCompletionStatusSet(GLuint GLObject, bool IsProgram)
+{
+#if GL_KHR_parallel_shader_compile || GL_ARB_parallel_shader_compile
+#    ifndef GL_COMPLETION_STATUS_KHR
+    static constexpr GLenum GL_COMPLETION_STATUS_KHR = 0x91B1;
+#    endif
+    GLint IsCompleted = GL_TRUE;
+    if (IsProgram)
+        glGetProgramiv(GLObject, GL_COMPLETION_STATUS_KHR, &IsCompleted);
+    else
+        glGetShaderiv(GLObject, GL_COMPLETION_STATUS_KHR, &IsCompleted);
+    return IsCompleted != GL_FALSE;
+#else
+    return true;
+#endif
 }
 
 Uint32 ShaderGLImpl::GetResourceCount() const
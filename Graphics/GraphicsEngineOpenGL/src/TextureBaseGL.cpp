@@ -82,6 +82,12 @@ TextureBaseGL::TextureBaseGL(IReferenceCounters*        pRefCounters,
         pDeviceGL->CreateBuffer(StagingBufferDesc, nullptr, &m_pPBO);
         VERIFY_EXPR(m_pPBO);
     }
+    else
+    {
+        // OpenGL does not expose the allocation size, so the texel data size is reported.
+        // The memory of staging textures is tracked by their pixel buffers.
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_COMMITTED);
+    }
 }
 
 static GLenum GetTextureInternalFormat(GLContextState& GLState, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& GLTex, TEXTURE_FORMAT TexFmtFromDesc)
@@ -31,6 +31,8 @@
 #include "RenderDeviceGLImpl.hpp"
 #include "TextureBaseGL.hpp"
 #include "DeviceContextGLImpl.hpp"
+#include "SamplerGLImpl.hpp"
+#include "GraphicsAccessories.hpp"
 
 namespace Diligent
 {
@@ -58,6 +60,10 @@ TextureViewGLImpl::TextureViewGLImpl(IReferenceCounters*    pRefCounters,
 
 TextureViewGLImpl::~TextureViewGLImpl()
 {
+#if GL_ARB_bindless_texture
+    if (m_BindlessHandle != 0)
+        glMakeTextureHandleNonResidentARB(m_BindlessHandle);
+#endif
 }
 
 IMPLEMENT_QUERY_INTERFACE(TextureViewGLImpl, IID_TextureViewGL, TTextureViewBase)
@@ -76,4 +82,40 @@ GLenum TextureViewGLImpl::GetBindTarget()
         GetTexture<TextureBaseGL>()->GetBindTarget();
 }
 
+Uint64 TextureViewGLImpl::GetBindlessHandle()
+{
+    if (m_BindlessHandle != 0)
+        return m_BindlessHandle;
+
+    if (!GetDevice()->IsBindlessTextureSupported())
+    {
+        LOG_WARNING_MESSAGE("Bindless textures are not supported by this device (GL_ARB_bindless_texture)");
+        return 0;
+    }
+
+    if (m_Desc.ViewType != TEXTURE_VIEW_SHADER_RESOURCE)
+    {
+        LOG_ERROR_MESSAGE("Failed to get bindless handle for view '", m_Desc.Name, "' of texture '", m_pTexture->GetDesc().Name,
+                          "': ", GetTexViewTypeLiteralName(m_Desc.ViewType), " views do not support bindless handles; only shader resource views do.");
+        return 0;
+    }
+
+#if GL_ARB_bindless_texture
+    const GLuint GLTex = GetHandle();
+    if (auto* pSampler = GetSampler<SamplerGLImpl>())
+        m_BindlessHandle = glGetTextureSamplerHandleARB(GLTex, pSampler->GetHandle());
+    else
+        m_BindlessHandle = glGetTextureHandleARB(GLTex);
+    DEV_CHECK_GL_ERROR("Failed to get bindless texture handle");
+
+    if (m_BindlessHandle != 0)
+    {
+        glMakeTextureHandleResidentARB(m_BindlessHandle);
+        DEV_CHECK_GL_ERROR("Failed to make bindless texture handle resident");
+    }
+#endif
+
+    return m_BindlessHandle;
+}
+
 } // namespace Diligent
@@ -44,6 +44,17 @@
 namespace Diligent
 {
 
+static bool IsIntegerAttrib(const LayoutElement& LayoutElem)
+{
+    return !LayoutElem.IsNormalized &&
+        (LayoutElem.ValueType == VT_INT8 ||
+         LayoutElem.ValueType == VT_INT16 ||
+         LayoutElem.ValueType == VT_INT32 ||
+         LayoutElem.ValueType == VT_UINT8 ||
+         LayoutElem.ValueType == VT_UINT16 ||
+         LayoutElem.ValueType == VT_UINT32);
+}
+
 VAOCache::VAOCache() :
     m_EmptyVAO{true}
 {
@@ -279,13 +290,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>(StaticCast<size_t>(CurrStream.Offset) + static_cast<size_t>(LayoutElem.RelativeOffset));
 
             const auto GlType = TypeToGLType(LayoutElem.ValueType);
-            if (!LayoutElem.IsNormalized &&
-                (LayoutElem.ValueType == VT_INT8 ||
-                 LayoutElem.ValueType == VT_INT16 ||
-                 LayoutElem.ValueType == VT_INT32 ||
-                 LayoutElem.ValueType == VT_UINT8 ||
-                 LayoutElem.ValueType == VT_UINT16 ||
-                 LayoutElem.ValueType == VT_UINT32))
+            if (IsIntegerAttrib(LayoutElem))
                 glVertexAttribIPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, Stride, DataStartOffset);
             else
                 glVertexAttribPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, Stride, DataStartOffset);
@@ -341,4 +346,157 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetEmptyVAO()
     return m_EmptyVAO;
 }
 
+VAOCache::VertexFormatKey::VertexFormatKey(const InputLayoutDesc& InputLayout) :
+    Elements{InputLayout.LayoutElements, InputLayout.LayoutElements + InputLayout.NumElements}
+{
+    Hash = ComputeHash(InputLayout.NumElements);
+    for (auto& Elem : Elements)
+    {
+        // Semantics are not used by OpenGL, and strides are set when buffers are bound
+        Elem.HLSLSemantic = nullptr;
+        Elem.Stride       = 0;
+
+        HashCombine(Hash, Elem.InputIndex, Elem.BufferSlot, Elem.NumComponents, Elem.ValueType,
+                    Elem.IsNormalized, Elem.RelativeOffset, Elem.Frequency, Elem.InstanceDataStepRate);
+    }
+}
+
+VAOCache::VertexFormatVAO& VAOCache::GetVertexFormat(const InputLayoutDesc& InputLayout, GLContextState& GLState)
+{
+    VertexFormatKey Key{InputLayout};
+
+    auto It = m_FormatVAOs.find(Key);
+    if (It != m_FormatVAOs.end())
+        return It->second;
+
+    VertexFormatVAO Format;
+
+    // Instance divisor is the property of the binding rather than of the attribute,
+    // so all attributes that use the same buffer slot must have the same step rate.
+    Uint32 Divisors[MAX_BUFFER_SLOTS] = {};
+
+    // Minimum value of GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET guaranteed by the spec
+    constexpr Uint32 MaxRelativeOffset = 2047;
+
+    Format.IsSupported = true;
+    for (const auto& LayoutElem : Key.Elements)
+    {
+        const auto BuffSlot = LayoutElem.BufferSlot;
+        VERIFY_EXPR(BuffSlot < MAX_BUFFER_SLOTS);
+
+        const auto Divisor = LayoutElem.Frequency == INPUT_ELEMENT_FREQUENCY_PER_INSTANCE ? LayoutElem.InstanceDataStepRate : 0;
+        const auto SlotBit = 1u << BuffSlot;
+        if ((Format.UsedSlotsMask & SlotBit) != 0 && Divisors[BuffSlot] != Divisor)
+            Format.IsSupported = false;
+        if (LayoutElem.RelativeOffset > MaxRelativeOffset)
+            Format.IsSupported = false;
+
+        Format.UsedSlotsMask |= SlotBit;
+        Divisors[BuffSlot] = Divisor;
+    }
+
+#if GL_ARB_vertex_attrib_binding
+    if (Format.IsSupported)
+    {
+        Format.VAO = GLObjectWrappers::GLVertexArrayObj{true};
+        GLState.BindVAO(Format.VAO);
+
+        for (const auto& LayoutElem : Key.Elements)
+        {
+            const auto GlType = TypeToGLType(LayoutElem.ValueType);
+            if (IsIntegerAttrib(LayoutElem))
+                glVertexAttribIFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.RelativeOffset);
+            else
+                glVertexAttribFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, LayoutElem.RelativeOffset);
+            glVertexAttribBinding(LayoutElem.InputIndex, LayoutElem.BufferSlot);
+            glEnableVertexAttribArray(LayoutElem.InputIndex);
+        }
+
+        for (auto SlotMask = Format.UsedSlotsMask; SlotMask != 0;)
+        {
+            const auto SlotBit = ExtractLSB(SlotMask);
+            const auto Slot    = PlatformMisc::GetLSB(SlotBit);
+            glVertexBindingDivisor(Slot, Divisors[Slot]);
+        }
+        DEV_CHECK_GL_ERROR("Failed to initialize vertex format VAO");
+    }
+#else
+    Format.IsSupported = false;
+#endif
+
+    return m_FormatVAOs.emplace(std::move(Key), std::move(Format)).first->second;
+}
+
+bool VAOCache::BindFormatVAO(const VAOAttribs& Attribs,
+                             GLContextState&   GLState)
+{
+#if GL_ARB_vertex_attrib_binding
+    // Lock the cache
+    Threading::SpinLockGuard CacheGuard{m_CacheLock};
+
+    const auto PsoUId = Attribs.PSO.GetUniqueID();
+    if (m_LastFormatPsoUId != PsoUId)
+    {
+        m_pLastFormat      = &GetVertexFormat(Attribs.PSO.GetGraphicsPipelineDesc().InputLayout, GLState);
+        m_LastFormatPsoUId = PsoUId;
+    }
+
+    auto& Format = *m_pLastFormat;
+    if (!Format.IsSupported)
+        return false;
+
+    GLState.BindVAO(Format.VAO);
+
+    for (auto SlotMask = Format.UsedSlotsMask; SlotMask != 0;)
+    {
+        const auto SlotBit = ExtractLSB(SlotMask);
+        const auto Slot    = PlatformMisc::GetLSB(SlotBit);
+        DEV_CHECK_ERR(Slot < Attribs.NumVertexStreams, "Input layout requires at least ", Slot + 1, " buffer(s), but only ", Attribs.NumVertexStreams, " are bound.");
+
+        const auto& SrcStream = Attribs.VertexStreams[Slot];
+        auto*       pBuffer   = SrcStream.pBuffer.RawPtr<BufferGLImpl>();
+        DEV_CHECK_ERR(pBuffer, "VAO requires buffer at slot ", Slot, ", but none is bound in the context.");
+        if (pBuffer == nullptr)
+            continue;
+
+        pBuffer->BufferMemoryBarrier(
+            MEMORY_BARRIER_VERTEX_BUFFER, // Vertex data sourced from buffer objects after the barrier
+                                          // will reflect data written by shaders prior to the barrier.
+            GLState);
+
+        const auto Stride    = Attribs.PSO.GetBufferStride(Slot);
+        auto&      DstStream = Format.Streams[Slot];
+        if (DstStream.BufferUId != pBuffer->GetUniqueID() || DstStream.Offset != SrcStream.Offset || DstStream.Stride != Stride)
+        {
+            glBindVertexBuffer(Slot, pBuffer->GetGLHandle(), StaticCast<GLintptr>(SrcStream.Offset), static_cast<GLsizei>(Stride));
+            DEV_CHECK_GL_ERROR("Failed to bind vertex buffer to slot ", Slot);
+
+            DstStream.BufferUId = pBuffer->GetUniqueID();
+            DstStream.Offset    = SrcStream.Offset;
+            DstStream.Stride    = Stride;
+        }
+    }
+
+    if (Attribs.pIndexBuffer)
+    {
+        Attribs.pIndexBuffer->BufferMemoryBarrier(
+            MEMORY_BARRIER_INDEX_BUFFER, // Vertex array indices sourced from buffer objects after the barrier
+                                         // will reflect data written by shaders prior to the barrier.
+            GLState);
+
+        if (Format.IndexBufferUId != Attribs.pIndexBuffer->GetUniqueID())
+        {
+            // Element array buffer binding is part of the VAO state
+            constexpr bool ResetVAO = false;
+            GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->GetGLHandle(), ResetVAO);
+            Format.IndexBufferUId = Attribs.pIndexBuffer->GetUniqueID();
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 } // namespace Diligent
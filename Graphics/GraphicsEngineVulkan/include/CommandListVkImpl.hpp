@@ -46,11 +46,13 @@ public:
     CommandListVkImpl(IReferenceCounters*  pRefCounters,
                       RenderDeviceVkImpl*  pDevice,
                       DeviceContextVkImpl* pDeferredCtx,
-                      VkCommandBuffer      vkCmdBuff) :
+                      VkCommandBuffer      vkCmdBuff,
+                      bool                 IsSecondary) :
         // clang-format off
         TCommandListBase {pRefCounters, pDevice, pDeferredCtx},
         m_pDeferredCtx   {pDeferredCtx},
-        m_vkCmdBuff      {vkCmdBuff   }
+        m_vkCmdBuff      {vkCmdBuff   },
+        m_IsSecondary    {IsSecondary }
     // clang-format on
     {
     }
@@ -67,9 +69,14 @@ public:
         m_vkCmdBuff    = VK_NULL_HANDLE;
     }
 
+    // Returns true if the command list was recorded into a secondary command buffer,
+    // see IDeviceContextVk::BeginSecondaryCommandList().
+    bool IsSecondary() const { return m_IsSecondary; }
+
 private:
     RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
     VkCommandBuffer               m_vkCmdBuff;
+    const bool                    m_IsSecondary;
 };
 
 } // namespace Diligent
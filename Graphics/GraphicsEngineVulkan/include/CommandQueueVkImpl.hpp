@@ -145,10 +145,16 @@ public:
     void SetFence(RefCntAutoPtr<FenceVkImpl> pFence)
     {
         VERIFY_EXPR(pFence->GetDesc().Type == FENCE_TYPE_CPU_WAIT_ONLY);
-        VERIFY_EXPR(!pFence->IsTimelineSemaphore());
+        VERIFY_EXPR(pFence->IsTimelineSemaphore() == m_SupportedTimelineSemaphore);
         m_pFence = std::move(pFence);
     }
 
+    /// Returns true if any of the queue operations has returned VK_ERROR_DEVICE_LOST.
+    bool IsDeviceLost() const
+    {
+        return m_DeviceLost.load();
+    }
+
     SyncPointVkPtr GetLastSyncPoint()
     {
         Threading::SpinLockGuard Guard{m_LastSyncPointLock};
@@ -160,6 +166,22 @@ private:
 
     void InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore, Uint64 Value);
 
+    void CheckDeviceLost(VkResult err);
+
+    // Appends the queue fence timeline semaphore to the signal semaphores of a submission.
+    // Returns the new pNext chain, or nullptr if the semaphore could not be merged into
+    // the submission and must be signaled separately.
+    const void* AppendFenceTimelineSignal(const void*                    pNext,
+                                          uint32_t                       SignalSemaphoreCount,
+                                          const VkSemaphore*             pSignalSemaphores,
+                                          Uint64                         FenceValue,
+                                          VkTimelineSemaphoreSubmitInfo& TimelineSubmitInfo);
+
+    bool UseFenceTimelineSemaphore() const
+    {
+        return m_SupportedTimelineSemaphore && m_pFence->IsTimelineSemaphore();
+    }
+
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> m_LogicalDevice;
 
     const VkQueue            m_VkQueue;
@@ -177,11 +199,15 @@ private:
     // A value that will be signaled by the command queue next
     std::atomic<Uint64> m_NextFenceValue{1};
 
+    std::atomic<bool> m_DeviceLost{false};
+
     // Protects access to the m_VkQueue internal data.
     std::mutex m_QueueMutex;
 
     // Array used to merge semaphores from SubmitInfo and from SyncPointVk
     std::vector<VkSemaphore> m_TempSignalSemaphores;
+    // Signal values that correspond to m_TempSignalSemaphores when the queue fence is a timeline semaphore
+    std::vector<Uint64> m_TempSignalValues;
 
     // Protects access to the m_LastSyncPoint
     Threading::SpinLock m_LastSyncPointLock;
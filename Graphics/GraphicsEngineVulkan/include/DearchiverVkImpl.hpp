@@ -44,6 +44,10 @@ public:
 
 protected:
     RefCntAutoPtr<IPipelineResourceSignature> UnpackResourceSignature(const ResourceSignatureUnpackInfo& DeArchiveInfo, bool IsImplicit) override final;
+
+    RefCntAutoPtr<IShader> UnpackShader(const ShaderCreateInfo& ShaderCI,
+                                        const SerializedData&   ShaderReflection,
+                                        IRenderDevice*          pDevice) override final;
 };
 
 } // namespace Diligent
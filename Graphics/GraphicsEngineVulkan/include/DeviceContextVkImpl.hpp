@@ -58,6 +58,9 @@
 #include "DescriptorPoolManager.hpp"
 #include "HashUtils.hpp"
 #include "ManagedVulkanObject.hpp"
+#include "RenderPassCache.hpp"
+#include "FramebufferCache.hpp"
+#include "GPUBreadcrumbsVk.hpp"
 
 namespace Diligent
 {
@@ -244,12 +247,32 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetQueryData() in Vulkan backend.
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueryData(Uint32         NumQueries,
+                                                   IQuery* const* ppQueries,
+                                                   void*          pData,
+                                                   Uint32         DataSize,
+                                                   Bool*          pDataAvailable,
+                                                   Bool           AutoInvalidate) override final;
+
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in Vulkan backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
     /// Implementation of IDeviceContext::BuildBLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::BuildTLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
@@ -294,6 +317,7 @@ public:
     // Transitions texture subresources from OldState to NewState, and optionally updates
     // internal texture state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal texture state is used as old state.
+    // For textures that track subresource states, every subresource is transitioned from its own state.
     void TransitionTextureState(TextureVkImpl&           TextureVk,
                                 RESOURCE_STATE           OldState,
                                 RESOURCE_STATE           NewState,
@@ -318,6 +342,31 @@ public:
     /// Implementation of IDeviceContextVk::GetVkCommandBuffer().
     virtual VkCommandBuffer DILIGENT_CALL_TYPE GetVkCommandBuffer() override final;
 
+    /// Implementation of IDeviceContextVk::BeginSecondaryCommandList().
+    virtual void DILIGENT_CALL_TYPE BeginSecondaryCommandList(Uint32        ImmediateContextId,
+                                                              IRenderPass*  pRenderPass,
+                                                              Uint32        SubpassIndex,
+                                                              IFramebuffer* pFramebuffer) override final;
+
+    /// Implementation of IDeviceContextVk::EnableSecondaryCommandLists().
+    virtual void DILIGENT_CALL_TYPE EnableSecondaryCommandLists(Bool Enable) override final;
+
+    /// Implementation of IDeviceContextVk::SetCullMode().
+    virtual void DILIGENT_CALL_TYPE SetCullMode(CULL_MODE CullMode) override final;
+
+    /// Implementation of IDeviceContextVk::SetDepthState().
+    virtual void DILIGENT_CALL_TYPE SetDepthState(Bool                DepthEnable,
+                                                  Bool                DepthWriteEnable,
+                                                  COMPARISON_FUNCTION DepthFunc) override final;
+
+    /// Implementation of IDeviceContextVk::SetStencilState().
+    virtual void DILIGENT_CALL_TYPE SetStencilState(Bool                 StencilEnable,
+                                                    const StencilOpDesc& FrontFace,
+                                                    const StencilOpDesc& BackFace) override final;
+
+    /// Implementation of IDeviceContextVk::SetPrimitiveTopology().
+    virtual void DILIGENT_CALL_TYPE SetPrimitiveTopology(PRIMITIVE_TOPOLOGY PrimitiveTopology) override final;
+
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
     void TransitionBLASState(BottomLevelASVkImpl& BLAS,
@@ -394,6 +443,7 @@ public:
     {
         // Descriptor pools are externally synchronized, meaning that the application must not allocate
         // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+        ++m_Statistics.DynamicDescriptorCount;
         return m_DynamicDescrSetAllocator.Allocate(SetLayout, DebugName);
     }
 
@@ -419,11 +469,21 @@ private:
                                                      VkAccessFlagBits               ExpectedAccessFlags,
                                                      const char*                    OperationName);
 
+    // If pView is not null and the texture tracks subresource states, only transitions the subresources addressed by the view.
     __forceinline void TransitionOrVerifyTextureState(TextureVkImpl&                 Texture,
                                                       RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                       RESOURCE_STATE                 RequiredState,
                                                       VkImageLayout                  ExpectedLayout,
-                                                      const char*                    OperationName);
+                                                      const char*                    OperationName,
+                                                      const TextureViewVkImpl*       pView = nullptr);
+
+    // Records the layout transition of the subresource range if it is required.
+    // Returns true if the barrier has been recorded.
+    bool TransitionTextureSubresources(TextureVkImpl&                 TextureVk,
+                                       RESOURCE_STATE                 OldState,
+                                       RESOURCE_STATE                 NewState,
+                                       STATE_TRANSITION_FLAGS         Flags,
+                                       const VkImageSubresourceRange& SubresRange);
 
     __forceinline void TransitionOrVerifyBLASState(BottomLevelASVkImpl&           BLAS,
                                                    RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -435,8 +495,23 @@ private:
                                                    RESOURCE_STATE                 RequiredState,
                                                    const char*                    OperationName);
 
+    struct BLASBuildInfo
+    {
+        VkAccelerationStructureBuildGeometryInfoKHR           vkBuildInfo{};
+        std::vector<VkAccelerationStructureGeometryKHR>       vkGeometries;
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> vkRanges;
+    };
+    // Transitions the resources used by the BLAS build and initializes the build info.
+    void PrepareBLASBuild(const BuildBLASAttribs& Attribs, BLASBuildInfo& BuildInfo, const char* OpName);
+
     void AliasingBarrier(IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter);
 
+    // Records vkCmdSetEvent() for the begin-split barrier and adds it to the list of pending split barriers.
+    void BeginSplitBarrier(const StateTransitionDesc& Barrier);
+    // Finds and removes the pending split barrier that matches the end-split barrier.
+    // Returns false if there is no such barrier.
+    bool EndSplitBarrier(const StateTransitionDesc& Barrier, VkEvent& vkEvent, VkPipelineStageFlags& SrcStages, RESOURCE_STATE& OldState);
+
     __forceinline void EnsureVkCmdBuffer()
     {
         VERIFY_EXPR(m_CmdPool != nullptr);
@@ -451,7 +526,10 @@ private:
         }
     }
 
-    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
+    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary = false);
+
+    // Executes secondary command lists inside the current subpass with vkCmdExecuteCommands.
+    void        ExecuteSecondaryCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists);
     inline void DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
 
     void CopyBufferToTexture(VkBuffer                       vkSrcBuffer,
@@ -478,6 +556,21 @@ private:
     __forceinline void          PrepareForDispatchCompute();
     __forceinline void          PrepareForRayTracing();
 
+    // Writes GPU breadcrumbs around a command when they are enabled.
+    // The name is not copied and must be a string literal.
+    __forceinline Uint32 BeginBreadcrumb(const char* Name)
+    {
+        return m_pBreadcrumbs ? m_pBreadcrumbs->BeginCommand(m_CommandBuffer, Name) : 0;
+    }
+    __forceinline void EndBreadcrumb(Uint32 Marker)
+    {
+        if (m_pBreadcrumbs)
+            m_pBreadcrumbs->EndCommand(m_CommandBuffer, Marker);
+    }
+
+    // Logs GPU breadcrumbs if the command queue has lost the device.
+    void CheckDeviceLost();
+
     void DvpLogRenderPass_PSOMismatch();
 
     void CreateASCompactedSizeQueryPool();
@@ -486,6 +579,14 @@ private:
 
     void ChooseRenderPassAndFramebuffer();
 
+    // Sets the dynamic states of the current graphics pipeline to the values from its description.
+    void CommitDynamicPipelineStates(const GraphicsPipelineDesc& GraphicsPipeline);
+
+    bool DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAGS Flag, const char* MethodName) const;
+
+    RenderPassVkImpl* GetImplicitRenderPass(const RenderPassCache::RenderPassCacheKey& Key);
+    VkFramebuffer     GetImplicitFramebuffer(const FramebufferCache::FramebufferCacheKey& Key);
+
     VulkanUtilities::VulkanCommandBuffer m_CommandBuffer;
 
     struct ContextState
@@ -500,6 +601,9 @@ private:
         /// vkCmdSetFragmentShadingRateKHR must be called before the draw.
         bool ShadingRateIsSet = false;
 
+        /// Flag indicating if the current subpass was begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+        bool SecondaryCmdListsSubpass = false;
+
         Uint32 NumCommands = 0;
 
         VkPipelineBindPoint vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
@@ -524,6 +628,9 @@ private:
             // Note that this is not the actual number of dynamic buffers in the resource cache.
             Uint32 DynamicOffsetCount = 0;
 
+            // The index of the first dynamic offset of this signature in ResourceBindInfo::BoundDynamicOffsets
+            Uint32 DynamicOffsetsStart = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
             // The descriptor set base index that was used in the last BindDescriptorSets() call
             Uint32 LastBoundBaseInd = ~0u;
@@ -534,6 +641,12 @@ private:
         // Pipeline layout of the currently bound pipeline
         VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
 
+        // Dynamic buffer offsets of every signature that were used in the last BindDescriptorSets() call
+        std::vector<Uint32> BoundDynamicOffsets;
+
+        // Indicates signatures whose offsets in BoundDynamicOffsets are valid
+        SRBMaskType BoundDynamicOffsetsMask = 0;
+
         ResourceBindInfo()
         {}
     };
@@ -541,6 +654,12 @@ private:
     __forceinline ResourceBindInfo& GetBindInfo(PIPELINE_TYPE Type);
 
     __forceinline void CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask);
+
+    // Returns the dynamic descriptor set with the current contents of the SRB dynamic resources.
+    // The set is shared by all SRBs of the same signature that reference the same resources.
+    VkDescriptorSet GetDynamicDescriptorSet(const PipelineResourceSignatureVkImpl& Signature,
+                                            const ShaderResourceCacheVk&           ResourceCache,
+                                            Uint32                                 DynamicSetIndex);
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources(ResourceBindInfo& BindInfo);
 #endif
@@ -577,6 +696,28 @@ private:
     std::vector<uint64_t> m_WaitSemaphoreValues;
     std::vector<uint64_t> m_SignalSemaphoreValues;
 
+    // Split barrier that was begun with STATE_TRANSITION_TYPE_BEGIN in the current command buffer,
+    // but has not been ended yet.
+    struct PendingSplitBarrier
+    {
+        RefCntAutoPtr<IDeviceObject> pResource;
+
+        RESOURCE_STATE OldState        = RESOURCE_STATE_UNKNOWN;
+        RESOURCE_STATE NewState        = RESOURCE_STATE_UNKNOWN;
+        Uint32         FirstMipLevel   = 0;
+        Uint32         MipLevelsCount  = 0;
+        Uint32         FirstArraySlice = 0;
+        Uint32         ArraySliceCount = 0;
+
+        VkEvent              vkEvent   = VK_NULL_HANDLE;
+        VkPipelineStageFlags SrcStages = 0;
+    };
+    std::vector<PendingSplitBarrier> m_PendingSplitBarriers;
+
+    // Events used by the split barriers in the current command buffer.
+    // They are released with the fence value of the submission that contains the command buffer.
+    std::vector<VulkanUtilities::EventWrapper> m_SplitBarrierEvents;
+
     // List of fences to signal/wait next time the command context is flushed
     std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>> m_SignalFences;
     std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>> m_WaitFences;
@@ -619,15 +760,101 @@ private:
     VulkanDynamicHeap             m_DynamicHeap;
     DynamicDescriptorSetAllocator m_DynamicDescrSetAllocator;
 
+    // Dynamic descriptor sets allocated since the last FinishFrame(), indexed by the SRB unique ID.
+    // A set is reused when the SRB is committed again and its dynamic resources have not changed.
+    struct DynamicDescrSetCacheEntry
+    {
+        VkDescriptorSet vkSet    = VK_NULL_HANDLE;
+        Uint32          Revision = 0;
+    };
+    std::unordered_map<Int32, DynamicDescrSetCacheEntry> m_DynamicDescrSetCache;
+
+    // Identifies the contents of a dynamic descriptor set: the signature and the unique IDs
+    // and buffer ranges of all resources in the set.
+    struct DynamicDescrSetKey
+    {
+        Int32               SignatureId = 0;
+        std::vector<Uint64> Resources;
+        size_t              Hash = 0;
+
+        bool operator==(const DynamicDescrSetKey& rhs) const
+        {
+            return Hash == rhs.Hash && SignatureId == rhs.SignatureId && Resources == rhs.Resources;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const DynamicDescrSetKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+    };
+    // Dynamic descriptor sets allocated since the last FinishFrame(), indexed by their contents.
+    std::unordered_map<DynamicDescrSetKey, VkDescriptorSet, DynamicDescrSetKey::Hasher> m_DynamicDescrSetsByContent;
+    // Scratch key reused to avoid allocations when looking up the sets
+    DynamicDescrSetKey m_DynamicDescrSetLookupKey;
+
     // In Vulkan we can't bind null vertex buffer, so we have to create a dummy VB
     RefCntAutoPtr<BufferVkImpl> m_DummyVB;
 
     QueryManagerVk* m_pQueryMgr            = nullptr;
     Int32           m_ActiveQueriesCounter = 0;
 
+    // GPU breadcrumbs of the immediate context, see EngineCreateInfo::EnableGPUBreadcrumbs.
+    std::unique_ptr<GPUBreadcrumbsVk> m_pBreadcrumbs;
+    bool                              m_DeviceLostReported = false;
+
     std::vector<VkClearValue> m_vkClearValues;
 
+    // Implicit render passes and framebuffers recently used by this context. They let
+    // SetRenderTargets() avoid locking the device-wide caches when the same render targets
+    // are bound repeatedly. Implicit render passes are never released before the device, while
+    // cached framebuffers are discarded when the version of the device-wide cache changes.
+    static constexpr size_t LocalRenderPassCacheSize = 4;
+    struct LocalRenderPassCacheEntry
+    {
+        RenderPassCache::RenderPassCacheKey Key;
+        RenderPassVkImpl*                   pRenderPass = nullptr;
+    };
+    std::array<LocalRenderPassCacheEntry, LocalRenderPassCacheSize> m_LocalRenderPassCache;
+    Uint32                                                          m_NextLocalRenderPassCacheEntry = 0;
+
+    struct LocalFramebufferCacheEntry
+    {
+        FramebufferCache::FramebufferCacheKey Key;
+        VkFramebuffer                         vkFramebuffer = VK_NULL_HANDLE;
+    };
+    std::array<LocalFramebufferCacheEntry, LocalRenderPassCacheSize> m_LocalFramebufferCache;
+    Uint32                                                           m_NextLocalFramebufferCacheEntry = 0;
+    Uint32                                                           m_LocalFramebufferCacheVersion   = 0;
+
+    // Indicates if the deferred context is recording a secondary command list
+    bool m_IsRecordingSecondaryCmdList = false;
+
+    // Indicates if the render pass subpasses are begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    bool m_SecondaryCmdListsEnabled = false;
+
+    // Secondary command buffers executed in the current primary command buffer and the deferred
+    // contexts that recorded them. The buffers are disposed when the primary command buffer is submitted.
+    std::vector<std::pair<RefCntAutoPtr<IDeviceContext>, VkCommandBuffer>> m_PendingSecondaryCmdBuffers;
+    std::vector<VkCommandBuffer>                                           m_vkSecondaryCmdBuffers;
+
     VulkanUtilities::QueryPoolWrapper m_ASQueryPool;
+
+    // Build infos reused by BuildBLAS() and BuildBLASBatch() to avoid allocations
+    std::vector<BLASBuildInfo>                                     m_BLASBuildInfos;
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR>       m_vkBLASBuildInfos;
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*>   m_vkBLASBuildRangePtrs;
+
+    // Instances reused by BuildTLAS() with DirtyInstancesOnly flag
+    std::vector<TopLevelASVkImpl::DirtyInstance> m_DirtyTLASInstances;
+
+    // SBT regions reused by UpdateSBT()
+    std::vector<SBTUploadRegion> m_SBTUploads;
+
+    // Copy regions reused by BuildTLAS() and UpdateSBT()
+    std::vector<VkBufferCopy> m_vkBufferCopyRegions;
 };
 
 } // namespace Diligent
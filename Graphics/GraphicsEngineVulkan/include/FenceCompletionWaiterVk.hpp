@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::FenceCompletionWaiterVk class
+
+#include <memory>
+
+#include "FenceCompletionWaiter.hpp"
+#include "VulkanUtilities/VulkanLogicalDevice.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+/// Fence completion waiter that blocks the waiter thread in a single vkWaitSemaphores() call
+/// with VK_SEMAPHORE_WAIT_ANY_BIT on the timeline semaphores of all fences and an internal
+/// timeline semaphore that is signaled to wake the thread up.
+/// Fences that are not backed by timeline semaphores are polled.
+class FenceCompletionWaiterVk final : public FenceCompletionWaiter
+{
+public:
+    explicit FenceCompletionWaiterVk(std::shared_ptr<const VulkanUtilities::VulkanLogicalDevice> LogicalDevice);
+    ~FenceCompletionWaiterVk();
+
+protected:
+    virtual void WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter) override final;
+    virtual void WakeUp(Uint64 WakeCounter) override final;
+
+private:
+    const std::shared_ptr<const VulkanUtilities::VulkanLogicalDevice> m_LogicalDevice;
+
+    VulkanUtilities::SemaphoreWrapper m_WakeUpSemaphore;
+
+    std::vector<VkSemaphore> m_WaitSemaphores;
+    std::vector<uint64_t>    m_WaitValues;
+};
+
+} // namespace Diligent
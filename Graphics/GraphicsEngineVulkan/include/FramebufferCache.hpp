@@ -32,6 +32,8 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
@@ -76,6 +78,10 @@ public:
     void          OnDestroyImageView(VkImageView ImgView);
     void          OnDestroyRenderPass(VkRenderPass Pass);
 
+    // The version is incremented every time a framebuffer is removed from the cache.
+    // Device contexts use it to validate the framebuffers they cache locally.
+    Uint32 GetVersion() const { return m_Version.load(); }
+
 private:
     RenderDeviceVkImpl& m_DeviceVk;
 
@@ -87,9 +93,12 @@ private:
         }
     };
 
-    std::mutex                                                                                            m_Mutex;
+    // Lookups only take a shared lock; exclusive lock is required to add or remove framebuffers
+    std::shared_timed_mutex                                                                               m_Mutex;
     std::unordered_map<FramebufferCacheKey, VulkanUtilities::FramebufferWrapper, FramebufferCacheKeyHash> m_Cache;
 
+    std::atomic<Uint32> m_Version{0};
+
     std::unordered_multimap<VkImageView, FramebufferCacheKey>  m_ViewToKeyMap;
     std::unordered_multimap<VkRenderPass, FramebufferCacheKey> m_RenderPassToKeyMap;
 };
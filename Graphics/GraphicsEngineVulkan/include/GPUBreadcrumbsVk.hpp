@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUBreadcrumbsVk class
+
+#include <string>
+
+#include "GPUBreadcrumbs.hpp"
+#include "VulkanUtilities/VulkanMemoryManager.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+// Writes GPU breadcrumbs of an immediate context using VK_AMD_buffer_marker or,
+// if it is not available, VK_NV_device_diagnostic_checkpoints.
+//
+// With buffer markers, the marker of every command is written to a host-visible buffer
+// at the top of the pipe when the command starts and at the bottom of the pipe when
+// it completes. With checkpoints, a single checkpoint is set before every command and
+// the driver reports the last checkpoint reached by every pipeline stage.
+class GPUBreadcrumbsVk
+{
+public:
+    GPUBreadcrumbsVk(RenderDeviceVkImpl& DeviceVk, const char* ContextName);
+
+    // clang-format off
+    GPUBreadcrumbsVk           (const GPUBreadcrumbsVk&)  = delete;
+    GPUBreadcrumbsVk           (      GPUBreadcrumbsVk&&) = delete;
+    GPUBreadcrumbsVk& operator=(const GPUBreadcrumbsVk&)  = delete;
+    GPUBreadcrumbsVk& operator=(      GPUBreadcrumbsVk&&) = delete;
+    // clang-format on
+
+    // Returns true if the device supports either of the extensions required by the breadcrumbs.
+    static bool IsSupported(const RenderDeviceVkImpl& DeviceVk);
+
+    // Records the command and writes the marker that is reached when the command starts.
+    // The name is not copied and must be a string literal.
+    __forceinline Uint32 BeginCommand(VulkanUtilities::VulkanCommandBuffer& CmdBuff, const char* Name)
+    {
+        const Uint32 Marker = m_Breadcrumbs.AddCommand(Name);
+        WriteStartedMarker(CmdBuff, Marker);
+        return Marker;
+    }
+
+    // Writes the marker that is reached when the command completes.
+    __forceinline void EndCommand(VulkanUtilities::VulkanCommandBuffer& CmdBuff, Uint32 Marker)
+    {
+        if (m_UseBufferMarkers)
+            CmdBuff.WriteBufferMarker(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_vkBuffer, CompletedMarkerOffset, Marker);
+    }
+
+    void BeginDebugGroup(VulkanUtilities::VulkanCommandBuffer& CmdBuff, const char* Name);
+    void EndDebugGroup(VulkanUtilities::VulkanCommandBuffer& CmdBuff);
+
+    // Reads back the markers and logs the commands that were executing when the device was lost.
+    void LogDeviceLost(VkQueue vkQueue) const;
+
+private:
+    __forceinline void WriteStartedMarker(VulkanUtilities::VulkanCommandBuffer& CmdBuff, Uint32 Marker)
+    {
+        if (m_UseBufferMarkers)
+            CmdBuff.WriteBufferMarker(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_vkBuffer, StartedMarkerOffset, Marker);
+        else
+            CmdBuff.SetCheckpoint(reinterpret_cast<const void*>(size_t{Marker}));
+    }
+
+    static constexpr VkDeviceSize StartedMarkerOffset   = 0;
+    static constexpr VkDeviceSize CompletedMarkerOffset = sizeof(Uint32);
+
+    const std::string m_ContextName;
+    const bool        m_UseBufferMarkers;
+
+    GPUBreadcrumbs m_Breadcrumbs;
+
+    // Only used with buffer markers. The buffer must be destroyed before its memory is released.
+    VulkanUtilities::VulkanMemoryAllocation m_MemAllocation;
+    VulkanUtilities::BufferWrapper          m_vkBuffer;
+    const volatile Uint32*                  m_pMarkers = nullptr;
+};
+
+} // namespace Diligent
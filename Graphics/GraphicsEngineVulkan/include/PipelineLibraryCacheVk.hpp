@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineLibraryCacheVk class
+
+#include <array>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+
+#include "GraphicsTypes.h"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Cache of graphics pipeline libraries (VK_EXT_graphics_pipeline_library).
+
+/// Every graphics pipeline is split into four parts that are compiled as separate
+/// pipeline libraries. Identical parts are shared between pipelines and the complete
+/// pipeline is created by linking the libraries together.
+class PipelineLibraryCacheVk
+{
+public:
+    enum LIBRARY_TYPE : Uint32
+    {
+        LIBRARY_TYPE_VERTEX_INPUT = 0,
+        LIBRARY_TYPE_PRE_RASTERIZATION,
+        LIBRARY_TYPE_FRAGMENT_SHADER,
+        LIBRARY_TYPE_FRAGMENT_OUTPUT,
+        LIBRARY_TYPE_COUNT
+    };
+
+    using LibraryHashes  = std::array<size_t, LIBRARY_TYPE_COUNT>;
+    using LibraryHandles = std::array<VkPipeline, LIBRARY_TYPE_COUNT>;
+
+    PipelineLibraryCacheVk(RenderDeviceVkImpl& DeviceVk) noexcept;
+
+    // clang-format off
+    PipelineLibraryCacheVk             (const PipelineLibraryCacheVk&) = delete;
+    PipelineLibraryCacheVk             (PipelineLibraryCacheVk&&)      = delete;
+    PipelineLibraryCacheVk& operator = (const PipelineLibraryCacheVk&) = delete;
+    PipelineLibraryCacheVk& operator = (PipelineLibraryCacheVk&&)      = delete;
+    // clang-format on
+
+    ~PipelineLibraryCacheVk();
+
+    // Returns the libraries for all parts of the pipeline described by PipelineCI.
+    // Libraries that are not found in the cache are created and added to it.
+    // Library handles remain valid until the cache is destroyed.
+    LibraryHandles GetLibraries(const VkGraphicsPipelineCreateInfo& PipelineCI,
+                                const LibraryHashes&                Hashes,
+                                VkPipelineCache                     vkPSOCache,
+                                const char*                         PipelineName) noexcept(false);
+
+    // Links the libraries into a complete pipeline. When Optimize is true, link-time
+    // optimization is performed, which is slower, but produces a faster pipeline.
+    VulkanUtilities::PipelineWrapper Link(const LibraryHandles& Libraries,
+                                          VkPipelineLayout      vkLayout,
+                                          bool                  Optimize,
+                                          VkPipelineCache       vkPSOCache,
+                                          const char*           PipelineName) const noexcept(false);
+
+    void Destroy();
+
+private:
+    VulkanUtilities::PipelineWrapper CreateLibrary(const VkGraphicsPipelineCreateInfo& PipelineCI,
+                                                   LIBRARY_TYPE                        Type,
+                                                   VkPipelineCache                     vkPSOCache,
+                                                   const char*                         PipelineName) const noexcept(false);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    // Lookups only take a shared lock; exclusive lock is required to add new libraries
+    std::shared_timed_mutex                                                                      m_Mutex;
+    std::array<std::unordered_map<size_t, VulkanUtilities::PipelineWrapper>, LIBRARY_TYPE_COUNT> m_Libraries;
+};
+
+} // namespace Diligent
@@ -205,6 +205,14 @@ private:
     void Destruct();
 
     void CreateSetLayouts(bool IsSerialized);
+    void CreateDescriptorUpdateTemplates();
+
+    // Writes all descriptors of the set in a single vkUpdateDescriptorSetWithTemplate() call.
+    // Returns false if the set has no update template or any of its resources is null, in which case
+    // the descriptors must be written individually.
+    bool UpdateDescriptorSetWithTemplate(const ShaderResourceCacheVk& ResourceCache,
+                                         DESCRIPTOR_SET_ID            SetId,
+                                         VkDescriptorSet              vkSet) const;
 
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
@@ -212,6 +220,9 @@ private:
 private:
     std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
 
+    // Update templates that write the descriptors of SRB resource cache sets, see UpdateDescriptorSetWithTemplate()
+    std::array<VulkanUtilities::DescriptorUpdateTemplateWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrUpdateTemplates;
+
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
@@ -29,6 +29,11 @@
 /// \file
 /// Declaration of Diligent::PipelineStateCacheVkImpl class
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateCacheBase.hpp"
 
@@ -54,11 +59,62 @@ public:
     /// Implementation of IPipelineStateCache::GetData().
     virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
 
+    /// Implementation of IPipelineStateCache::Merge().
+    virtual Bool DILIGENT_CALL_TYPE Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches) override final;
+
     /// Implementation of IPipelineStateCacheVk::GetVkPipelineCache().
     virtual VkPipelineCache DILIGENT_CALL_TYPE GetVkPipelineCache() const override final { return m_PipelineStateCache; }
 
+    /// Identifies the patched SPIR-V byte code of a pipeline shader stage,
+    /// see ShaderVkImpl::GetPatchedShaderModule().
+    struct ShaderModuleKey
+    {
+        Uint64 Hash            = 0;
+        Uint32 CodeSize        = 0; // Size of the byte code, in words
+        Uint32 StripReflection = 0;
+
+        ShaderModuleKey() noexcept {}
+        ShaderModuleKey(const std::vector<uint32_t>& PatchedSPIRV, bool _StripReflection) noexcept;
+
+        bool operator==(const ShaderModuleKey& Rhs) const noexcept
+        {
+            return Hash == Rhs.Hash && CodeSize == Rhs.CodeSize && StripReflection == Rhs.StripReflection;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ShaderModuleKey& Key) const noexcept
+            {
+                return static_cast<size_t>(Key.Hash);
+            }
+        };
+    };
+
+    /// Returns true if the cache stores shader module identifiers (VK_EXT_shader_module_identifier).
+    /// Pipelines found in the cache can then be created from the identifiers without the shader modules.
+    bool UsesShaderModuleIdentifiers() const { return m_UseShaderModuleIdentifiers; }
+
+    /// Returns the identifier of the shader module created from the byte code identified by Key,
+    /// or null if the identifier is not in the cache.
+    ///
+    /// \remarks   The returned pointer remains valid until the cache is destroyed.
+    const std::vector<Uint8>* FindShaderModuleIdentifier(const ShaderModuleKey& Key) const;
+
+    /// Adds the shader module identifier to the cache.
+    void AddShaderModuleIdentifier(const ShaderModuleKey& Key, const VkShaderModuleIdentifierEXT& Identifier);
+
 private:
+    void LoadShaderModuleIdentifiers(const Uint8* pData, size_t Size);
+
     VulkanUtilities::PipelineCacheWrapper m_PipelineStateCache;
+
+    std::mutex m_MergeMtx;
+
+    const bool m_UseShaderModuleIdentifiers;
+
+    // Entries are never removed, so pointers to the identifiers remain valid
+    mutable std::shared_timed_mutex                                                  m_IdentifiersMtx;
+    std::unordered_map<ShaderModuleKey, std::vector<Uint8>, ShaderModuleKey::Hasher> m_ShaderModuleIdentifiers;
 };
 
 } // namespace Diligent
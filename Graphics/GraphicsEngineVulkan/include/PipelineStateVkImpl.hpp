@@ -32,6 +32,7 @@
 
 #include <array>
 #include <memory>
+#include <atomic>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -41,6 +42,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "SRBMemoryAllocator.hpp"
 #include "PipelineLayoutVk.hpp"
+#include "PipelineLibraryCacheVk.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
@@ -69,7 +71,11 @@ public:
     virtual IRenderPassVk* DILIGENT_CALL_TYPE GetRenderPass() const override final { return GetRenderPassPtr().RawPtr<IRenderPassVk>(); }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        // When the pipeline is linked from libraries, the optimized pipeline replaces the fast-linked one once it is ready
+        return m_OptimizedPipelineReady.load(std::memory_order_acquire) ? m_OptimizedPipeline : m_Pipeline;
+    }
 
     const PipelineLayoutVk& GetPipelineLayout() const { return m_PipelineLayout; }
 
@@ -122,17 +128,30 @@ public:
 
 private:
     template <typename PSOCreateInfoType>
-    TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
-                                      std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false);
+    TShaderStages InitInternalObjects(const PSOCreateInfoType&                      CreateInfo,
+                                      std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages,
+                                      bool&                                         StripReflection) noexcept(false);
 
-    void InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
+    // Returns true if reflection information must be stripped from the shaders' byte code
+    bool InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
                             TShaderStages&                 ShaderStages) noexcept(false);
 
+    size_t GetPipelineLayoutHash() const;
+
+    void StartPipelineOptimization(const PipelineLibraryCacheVk::LibraryHandles& Libraries, IPipelineStateCache* pPSOCache);
+    void FinishPipelineOptimization();
+
     void Destruct();
 
     VulkanUtilities::PipelineWrapper m_Pipeline;
-    PipelineLayoutVk                 m_PipelineLayout;
+
+    // Pipeline linked from libraries with link-time optimization in the background
+    VulkanUtilities::PipelineWrapper m_OptimizedPipeline;
+    std::atomic<bool>                m_OptimizedPipelineReady{false};
+    RefCntAutoPtr<IAsyncTask>        m_pOptimizationTask;
+    RefCntAutoPtr<IThreadPool>       m_pOptimizationThreadPool;
+
+    PipelineLayoutVk m_PipelineLayout;
 
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages
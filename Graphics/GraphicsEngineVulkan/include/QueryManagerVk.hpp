@@ -75,6 +75,22 @@ public:
     Uint32 ResetStaleQueries(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
                              VulkanUtilities::VulkanCommandBuffer&       CmdBuff);
 
+    // Returns the number of 64-bit values that vkGetQueryPoolResults writes for a single
+    // query of the given type, including the availability value.
+    Uint32 GetQueryResultStride(QUERY_TYPE Type) const
+    {
+        return m_Pools[Type].GetResultStride();
+    }
+
+    // Reads the results of QueryCount queries starting with FirstQuery using a single vkGetQueryPoolResults call.
+    // pResults must have room for QueryCount * GetQueryResultStride(Type) values. The last value of
+    // every query is non-zero if the results of this query are available.
+    void GetQueryResults(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                         QUERY_TYPE                                  Type,
+                         Uint32                                      FirstQuery,
+                         Uint32                                      QueryCount,
+                         Uint64*                                     pResults) const;
+
     SoftwareQueueIndex GetCommandQueueId() const
     {
         return m_CommandQueueId;
@@ -118,6 +134,10 @@ private:
         {
             return m_MaxAllocatedQueries;
         }
+        Uint32 GetResultStride() const
+        {
+            return m_ResultStride;
+        }
         bool IsNull() const
         {
             return m_vkQueryPool == VK_NULL_HANDLE;
@@ -129,6 +149,7 @@ private:
         QUERY_TYPE m_Type                = QUERY_TYPE_UNDEFINED;
         Uint32     m_QueryCount          = 0;
         Uint32     m_MaxAllocatedQueries = 0;
+        Uint32     m_ResultStride        = 0;
 
         std::mutex          m_QueriesMtx;
         std::vector<Uint32> m_AvailableQueries;
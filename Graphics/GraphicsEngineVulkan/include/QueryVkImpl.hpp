@@ -68,6 +68,18 @@ public:
     bool OnBeginQuery(DeviceContextVkImpl* pContext);
     bool OnEndQuery(DeviceContextVkImpl* pContext);
 
+    QueryManagerVk* GetQueryManager() const
+    {
+        return m_pQueryMgr;
+    }
+
+    // Returns true if the command buffer that ended the query has completed execution.
+    bool IsEndFenceCompleted() const;
+
+    // Same as GetData(), but takes the query results read by QueryManagerVk::GetQueryResults().
+    // ppResults[i] points to the results of the query with pool index GetQueryPoolIndex(i).
+    bool GetData(void* pData, Uint32 DataSize, bool AutoInvalidate, const Uint64* const ppResults[2]);
+
 private:
     bool AllocateQueries();
     void DiscardQueries();
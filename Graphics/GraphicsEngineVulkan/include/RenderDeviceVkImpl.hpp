@@ -51,6 +51,7 @@
 #include "VulkanUploadHeap.hpp"
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
+#include "PipelineLibraryCacheVk.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
 
@@ -82,6 +83,10 @@ public:
     /// Implementation of IRenderDevice::CreateGraphicsPipelineState() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
 
+    /// Implementation of IRenderDevice::CreateDerivedGraphicsPipelineState() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo,
+                                                                       IPipelineState**                              ppPipelineState) override final;
+
     /// Implementation of IRenderDevice::CreateComputePipelineState() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
 
@@ -96,6 +101,10 @@ public:
     /// Implementation of IRenderDevice::CreateShader() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateShader(const ShaderCreateInfo& ShaderCreateInfo, IShader** ppShader) override final;
 
+    /// Creates a shader from SPIR-V byte code using the reflection data produced by
+    /// SPIRVShaderResources::SerializeReflection() instead of parsing the byte code.
+    void CreateShader(const ShaderCreateInfo& ShaderCreateInfo, const SerializedData& ReflectionData, IShader** ppShader);
+
     /// Implementation of IRenderDevice::CreateTexture() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CreateTexture(const TextureDesc& TexDesc,
                                                   const TextureData* pData,
@@ -215,6 +224,9 @@ public:
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
 
+    /// Implementation of IRenderDevice::GetStatistics() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetStatistics(DeviceStatistics& Stats) const override final;
+
     /// Implementation of IRenderDevice::GetSparseTextureFormatInfo() in Vulkan backend.
     virtual SparseTextureFormatInfo DILIGENT_CALL_TYPE GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
                                                                                   RESOURCE_DIMENSION Dimension,
@@ -234,6 +246,9 @@ public:
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
+    // Returns null if graphics pipeline libraries are not enabled
+    PipelineLibraryCacheVk* GetPipelineLibraryCache() { return m_pPipelineLibraryCache.get(); }
+
     VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
     {
         return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
@@ -293,8 +308,11 @@ private:
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  m_LogicalVkDevice;
 
-    FramebufferCache       m_FramebufferCache;
-    RenderPassCache        m_ImplicitRenderPassCache;
+    FramebufferCache m_FramebufferCache;
+    RenderPassCache  m_ImplicitRenderPassCache;
+
+    std::unique_ptr<PipelineLibraryCacheVk> m_pPipelineLibraryCache;
+
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
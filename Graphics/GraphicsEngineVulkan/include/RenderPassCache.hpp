@@ -32,6 +32,7 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
 
 #include "GraphicsTypes.h"
 #include "Constants.h"
@@ -137,7 +138,8 @@ private:
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
-    std::mutex                                                                                      m_Mutex;
+    // Lookups only take a shared lock; exclusive lock is required to create new render passes
+    std::shared_timed_mutex                                                                         m_Mutex;
     std::unordered_map<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
 };
 
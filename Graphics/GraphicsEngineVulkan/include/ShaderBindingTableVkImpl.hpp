@@ -55,11 +55,12 @@ public:
     virtual const BindingTableVk& DILIGENT_CALL_TYPE GetVkBindingTable() const override final { return m_VkBindingTable; }
 
     using BindingTable = TShaderBindingTableBase::BindingTable;
-    void GetData(BufferVkImpl*& pSBTBufferVk,
-                 BindingTable&  RayGenShaderRecord,
-                 BindingTable&  MissShaderTable,
-                 BindingTable&  HitGroupTable,
-                 BindingTable&  CallableShaderTable);
+    void GetData(BufferVkImpl*&                pSBTBufferVk,
+                 BindingTable&                 RayGenShaderRecord,
+                 BindingTable&                 MissShaderTable,
+                 BindingTable&                 HitGroupTable,
+                 BindingTable&                 CallableShaderTable,
+                 std::vector<SBTUploadRegion>& Uploads);
 
 private:
     BindingTableVk m_VkBindingTable = {};
@@ -68,7 +68,7 @@ namespace Diligent
 
 class DeviceContextVkImpl;
 
-// sizeof(ShaderResourceCacheVk) == 24 (x64, msvc, Release)
+// sizeof(ShaderResourceCacheVk) == 32 (x64, msvc, Release)
 class ShaderResourceCacheVk : public ShaderResourceCacheBase
 {
 public:
@@ -93,6 +93,17 @@ public:
     void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes);
     void InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, DescriptorType Type, bool HasImmutableSampler);
 
+    // Descriptor info of a single resource in the form consumed by vkUpdateDescriptorSetWithTemplate().
+    // All info types share the same size, so the infos of a descriptor set form an array indexed by
+    // the cache offset that a descriptor update template can address with a constant stride.
+    union DescriptorInfo
+    {
+        VkDescriptorImageInfo      ImageInfo;
+        VkDescriptorBufferInfo     BufferInfo;
+        VkBufferView               BufferView;
+        VkAccelerationStructureKHR AccelStruct;
+    };
+
     // sizeof(Resource) == 32 (x64, msvc, Release)
     struct Resource
     {
@@ -132,6 +143,11 @@ public:
         template <DescriptorType DescrType>
         auto GetDescriptorWriteInfo() const;
 
+        DescriptorInfo GetDescriptorInfo() const;
+
+        // Immutable separate samplers are never written to the descriptor set
+        bool IsWrittenToDescriptorSet() const { return !(Type == DescriptorType::Sampler && HasImmutableSampler); }
+
         void SetUniformBuffer(RefCntAutoPtr<IDeviceObject>&& _pBuffer, Uint64 _RangeOffset, Uint64 _RangeSize);
         void SetStorageBuffer(RefCntAutoPtr<IDeviceObject>&& _pBufferView);
 
@@ -164,6 +180,11 @@ public:
 
         Uint32 GetSize() const { return m_NumResources; }
 
+        // Writes the descriptor infos of all resources in the set to pInfos[0..GetSize()-1].
+        // Returns false if any resource that needs to be written to the descriptor set is null,
+        // in which case the set can't be updated with a template.
+        bool GetDescriptorInfos(DescriptorInfo* pInfos) const;
+
         VkDescriptorSet GetVkDescriptorSet() const
         {
             return m_DescriptorSetAllocation.GetVkDescriptorSet();
@@ -229,7 +250,9 @@ public:
         {
         }
     };
-    // Sets the resource at the given descriptor set index and offset
+    // Sets the resource at the given descriptor set index and offset.
+    // If pLogicalDevice is null, the descriptor is not written to the Vulkan descriptor set, and
+    // the caller is responsible for writing it.
     const Resource& SetResource(const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
                                 Uint32                                      DescrSetIndex,
                                 Uint32                                      CacheOffset,
@@ -249,6 +272,10 @@ public:
     Uint32 GetNumDescriptorSets() const { return m_NumSets; }
     bool   HasDynamicResources() const { return m_NumDynamicBuffers > 0; }
 
+    // Returns the revision of the resources stored in sets that do not have a Vulkan descriptor set
+    // (i.e. the dynamic set). The revision is incremented every time such resource is modified.
+    Uint32 GetDynamicSetRevision() const { return m_DynamicSetRevision; }
+
     ResourceCacheContentType GetContentType() const { return static_cast<ResourceCacheContentType>(m_ContentType); }
 
 #ifdef DILIGENT_DEBUG
@@ -292,6 +319,9 @@ private:
     // Indicates what types of resources are stored in the cache
     const Uint32 m_ContentType : 1;
 
+    // Revision of the resources in sets without Vulkan descriptor set, see GetDynamicSetRevision()
+    Uint32 m_DynamicSetRevision = 0;
+
 #ifdef DILIGENT_DEBUG
     // Debug array that stores flags indicating if resources in the cache have been initialized
     std::vector<std::vector<bool>> m_DbgInitializedResources;
@@ -30,9 +30,13 @@
 /// \file
 /// Declaration of Diligent::ShaderVkImpl class
 
+#include <mutex>
+#include <unordered_map>
+
 #include "EngineVkImplTraits.hpp"
 #include "ShaderBase.hpp"
 #include "SPIRVShaderResources.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
 namespace Diligent
 {
@@ -54,6 +58,10 @@ public:
         const GraphicsAdapterInfo& AdapterInfo;
         const Uint32               VkVersion;
         const bool                 HasSpirv14;
+
+        // Optional reflection data produced by SPIRVShaderResources::SerializeReflection().
+        // When it is provided, the shader is created synchronously and SPIRV-Cross is not used.
+        const SerializedData* const pReflectionData = nullptr;
     };
     ShaderVkImpl(IReferenceCounters*     pRefCounters,
                  RenderDeviceVkImpl*     pRenderDeviceVk,
@@ -90,13 +98,36 @@ public:
         Size        = m_SPIRV.size() * sizeof(m_SPIRV[0]);
     }
 
+    /// Returns the shader module created from the SPIR-V byte code patched by
+    /// PipelineStateVkImpl::RemapOrVerifyShaderResources().
+    ///
+    /// \remarks   The patched byte code only differs from the shader's SPIR-V by the resource
+    ///            bindings and descriptor sets. Modules are cached for every unique assignment
+    ///            and are shared by all pipelines that use the shader with compatible layouts.
+    ///            The module stays valid until the shader is destroyed.
+    VkShaderModule GetPatchedShaderModule(const std::vector<uint32_t>& PatchedSPIRV, bool StripReflection) const noexcept(false);
+
 private:
+    void Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& VkShaderCI) noexcept(false);
+
     void MapHLSLVertexShaderInputs();
 
     std::shared_ptr<const SPIRVShaderResources> m_pShaderResources;
 
     std::string           m_EntryPoint;
     std::vector<uint32_t> m_SPIRV;
+
+    struct PatchedShaderModule
+    {
+        // Binding and descriptor set of every shader resource
+        std::vector<uint32_t> Bindings;
+        bool                  StripReflection = false;
+
+        VulkanUtilities::ShaderModuleWrapper Module;
+    };
+    // Patched modules keyed by the hash of the resource bindings
+    mutable std::mutex                                           m_PatchedModulesMtx;
+    mutable std::unordered_multimap<size_t, PatchedShaderModule> m_PatchedModules;
 };
 
 } // namespace Diligent
@@ -30,6 +30,8 @@
 /// \file
 /// Declaration of Diligent::SwapChainVkImpl class
 
+#include <array>
+
 #include "EngineVkImplTraits.hpp"
 #include "SwapChainVk.h"
 #include "SwapChainBase.hpp"
@@ -67,6 +69,9 @@ public:
     /// Implementation of ISwapChain::SetWindowedMode() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetWindowedMode() override final;
 
+    /// Implementation of ISwapChain::SetMaximumFrameLatency() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override final;
+
     /// Implementation of ISwapChainVk::GetVkSwapChain().
     virtual VkSwapchainKHR DILIGENT_CALL_TYPE GetVkSwapChain() override final { return m_VkSwapChain; }
 
@@ -88,6 +93,9 @@ private:
     void     RecreateVulkanSwapchain(DeviceContextVkImpl* pImmediateCtxVk);
     void     WaitForImageAcquiredFences();
     void     ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateCtxVk, bool DestroyVkSwapChain);
+    void     WaitForFrameLatency();
+    void     OnPresentsDisplayed(Uint64 LastPresentId);
+    void     UpdateFramePacingStats();
 
     const NativeWindow m_Window;
 
@@ -124,6 +132,23 @@ private:
     uint32_t m_BackBufferIndex = 0;
     bool     m_IsMinimized     = false;
     bool     m_VSyncEnabled    = true;
+
+    // Frame latency control (VK_KHR_present_wait) and frame pacing statistics (VK_GOOGLE_display_timing)
+    Uint32 m_MaxFrameLatency        = 0;
+    bool   m_PresentWaitSupported   = false;
+    bool   m_DisplayTimingSupported = false;
+
+    // Id of the last frame presented to the current Vulkan swap chain. Ids start from 1 for every new swap chain.
+    Uint64 m_PresentId = 0;
+    // Id of the last frame that is known to have been displayed.
+    Uint64 m_DisplayedPresentId = 0;
+
+    // Times, in nanoseconds, of the recent Present() calls indexed by the present id.
+    std::array<Uint64, 16> m_PresentTimes = {};
+
+    Uint64 m_RefreshDuration       = 0;
+    Uint64 m_LastActualPresentTime = 0;
+    Uint64 m_LastTimedPresentId    = 0;
 };
 
 } // namespace Diligent
@@ -33,6 +33,7 @@
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "DynamicHeap.hpp"
+#include "DynamicHeapPageSizer.hpp"
 
 namespace Diligent
 {
@@ -150,6 +151,7 @@ private:
     const VkDeviceSize                   m_DefaultAlignment;
     const Uint64                         m_CommandQueueMask;
     OffsetType                           m_TotalPeakSize = 0;
+    GPUMemoryRecord                      m_GPUMemoryRecord;
 };
 
 
@@ -182,11 +184,15 @@ private:
 class VulkanDynamicHeap
 {
 public:
+    // When AdaptivePageSize is true, PageSize is the minimum page size, and the heap adapts
+    // the page size to the per-frame usage, see DynamicHeapPageSizer.
     // clang-format off
-    VulkanDynamicHeap(VulkanDynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint32 PageSize) :
+    VulkanDynamicHeap(VulkanDynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint32 PageSize, bool AdaptivePageSize = false) :
         m_GlobalDynamicMemMgr{DynamicMemMgr},
         m_HeapName           {std::move(HeapName)},
-        m_MasterBlockSize    (PageSize)
+        m_MasterBlockSize    {PageSize},
+        m_AdaptivePageSize   {AdaptivePageSize},
+        m_PageSizer          {PageSize, std::max<Uint64>(DynamicMemMgr.GetSize() / 4, PageSize), PageSize}
     {}
 
     VulkanDynamicHeap            (const VulkanDynamicHeap&) = delete;
@@ -213,15 +219,40 @@ public:
 
     size_t GetAllocatedMasterBlockCount() const { return m_MasterBlocks.size(); }
 
+    struct Stats
+    {
+        // Memory used/allocated in the current frame
+        Uint32 CurrUsedSize      = 0;
+        Uint32 CurrAllocatedSize = 0;
+
+        // Memory used/allocated in the last finished frame
+        Uint32 LastFrameUsedSize      = 0;
+        Uint32 LastFrameAllocatedSize = 0;
+
+        // Peak memory used/allocated in a single frame
+        Uint32 PeakFrameUsedSize      = 0;
+        Uint32 PeakFrameAllocatedSize = 0;
+
+        // The number of finished frames
+        Uint64 NumFrames = 0;
+
+        // The current master block size
+        Uint32 PageSize = 0;
+    };
+    Stats GetStats() const;
+
 private:
     VulkanDynamicMemoryManager& m_GlobalDynamicMemMgr;
     const std::string           m_HeapName;
 
     std::vector<MasterBlock> m_MasterBlocks;
 
-    OffsetType   m_CurrOffset = InvalidOffset;
-    const Uint32 m_MasterBlockSize;
-    Uint32       m_AvailableSize = 0;
+    OffsetType m_CurrOffset = InvalidOffset;
+    Uint32     m_MasterBlockSize;
+    Uint32     m_AvailableSize = 0;
+
+    const bool           m_AdaptivePageSize;
+    DynamicHeapPageSizer m_PageSizer;
 
     Uint32 m_CurrAlignedSize   = 0;
     Uint32 m_CurrUsedSize      = 0;
@@ -229,6 +260,10 @@ private:
     Uint32 m_PeakUsedSize      = 0;
     Uint32 m_CurrAllocatedSize = 0;
     Uint32 m_PeakAllocatedSize = 0;
+
+    Uint32 m_LastFrameUsedSize      = 0;
+    Uint32 m_LastFrameAllocatedSize = 0;
+    Uint64 m_NumFrames              = 0;
 };
 
 } // namespace Diligent
@@ -47,6 +47,9 @@ VkIndexType TypeToVkIndexType(VALUE_TYPE IndexType);
 VkPipelineRasterizationStateCreateInfo RasterizerStateDesc_To_VkRasterizationStateCI(const struct RasterizerStateDesc& RasterizerDesc);
 VkPipelineDepthStencilStateCreateInfo  DepthStencilStateDesc_To_VkDepthStencilStateCI(const struct DepthStencilStateDesc& DepthStencilDesc);
 
+VkCullModeFlagBits CullModeToVkCullMode(CULL_MODE CullMode);
+VkStencilOpState   StencilOpDescToVkStencilOpState(const struct StencilOpDesc& desc, Uint8 StencilReadMask, Uint8 StencilWriteMask);
+
 void BlendStateDesc_To_VkBlendStateCI(const struct BlendStateDesc&                      BSDesc,
                                       VkPipelineColorBlendStateCreateInfo&              ColorBlendStateCI,
                                       std::vector<VkPipelineColorBlendAttachmentState>& ColorBlendAttachments);
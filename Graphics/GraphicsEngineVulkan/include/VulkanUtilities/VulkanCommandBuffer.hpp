@@ -230,7 +230,8 @@ public:
                                        uint32_t            FramebufferWidth,
                                        uint32_t            FramebufferHeight,
                                        uint32_t            ClearValueCount = 0,
-                                       const VkClearValue* pClearValues    = nullptr)
+                                       const VkClearValue* pClearValues    = nullptr,
+                                       VkSubpassContents   Contents        = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
@@ -255,9 +256,10 @@ public:
                                                       // ignored (7.4)
 
             vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo,
-                                 VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the
-                                                            // primary command buffer, and secondary command buffers must not
-                                                            // be executed within the subpass
+                                 Contents // VK_SUBPASS_CONTENTS_INLINE specifies that the contents of the subpass will be recorded
+                                          // inline in the primary command buffer, and secondary command buffers must not be executed
+                                          // within the subpass. VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS specifies that the
+                                          // contents are recorded in secondary command buffers executed with vkCmdExecuteCommands.
             );
             m_State.RenderPass        = RenderPass;
             m_State.Framebuffer       = Framebuffer;
@@ -282,13 +284,61 @@ public:
                               "subpass of a render pass instance, or must both begin and end outside of a render pass "
                               "instance (i.e. contain entire render pass instances). (17.2)");
         }
+        if (m_State.InsidePassConditionalRendering)
+        {
+            LOG_ERROR_MESSAGE("Ending render pass while conditional rendering that has been started inside the pass is active. "
+                              "Vulkan requires that conditional rendering started inside a render pass instance is ended "
+                              "in the same subpass.");
+        }
     }
 
-    __forceinline void NextSubpass()
+    __forceinline void NextSubpass(VkSubpassContents Contents = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdNextSubpass(m_VkCmdBuffer, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdNextSubpass(m_VkCmdBuffer, Contents);
+    }
+
+    // Sets the render pass state of a secondary command buffer that continues the render pass
+    // begun in the primary command buffer (VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT).
+    __forceinline void SetRenderPassContinuation(VkRenderPass  RenderPass,
+                                                 VkFramebuffer Framebuffer,
+                                                 uint32_t      FramebufferWidth,
+                                                 uint32_t      FramebufferHeight)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        m_State.RenderPass        = RenderPass;
+        m_State.Framebuffer       = Framebuffer;
+        m_State.FramebufferWidth  = FramebufferWidth;
+        m_State.FramebufferHeight = FramebufferHeight;
+    }
+
+    // Resets the render pass state set by SetRenderPassContinuation(). The render pass
+    // is ended by the primary command buffer, so no command is recorded.
+    __forceinline void ResetRenderPassContinuation()
+    {
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass continuation has not been set");
+        m_State.RenderPass        = VK_NULL_HANDLE;
+        m_State.Framebuffer       = VK_NULL_HANDLE;
+        m_State.FramebufferWidth  = 0;
+        m_State.FramebufferHeight = 0;
+    }
+
+    __forceinline void ExecuteCommands(uint32_t CommandBufferCount, const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(CommandBufferCount > 0 && pCommandBuffers != nullptr);
+        FlushBarriers();
+        vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
+
+        // After vkCmdExecuteCommands, the bound state of the primary command buffer is undefined
+        m_State.GraphicsPipeline   = VK_NULL_HANDLE;
+        m_State.ComputePipeline    = VK_NULL_HANDLE;
+        m_State.RayTracingPipeline = VK_NULL_HANDLE;
+        m_State.IndexBuffer        = VK_NULL_HANDLE;
+        m_State.IndexBufferOffset  = 0;
+        m_State.IndexType          = VK_INDEX_TYPE_MAX_ENUM;
     }
 
     __forceinline void EndCommandBuffer()
@@ -305,6 +355,9 @@ public:
         m_State       = {};
         m_Barrier     = {};
         m_ImageBarriers.clear();
+        m_PendingCopies.Regions.clear();
+        m_PendingCopies.SrcBuffer = VK_NULL_HANDLE;
+        m_PendingCopies.DstBuffer = VK_NULL_HANDLE;
     }
 
     __forceinline void BindComputePipeline(VkPipeline ComputePipeline)
@@ -425,6 +478,11 @@ public:
         vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
     }
 
+    // Adds a copy region to the pending vkCmdCopyBuffer command. Consecutive copies between
+    // the same buffers are recorded as a single command with many regions. The pending command
+    // is recorded by FlushBarriers() before any other command that depends on it.
+    void AppendBufferCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& Region);
+
     __forceinline void CopyImage(VkImage            srcImage,
                                  VkImageLayout      srcImageLayout,
                                  VkImage            dstImage,
@@ -529,6 +587,7 @@ public:
         // begin and end outside a render pass instance (i.e. contain entire render pass instances) (17.2).
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBufferCopies();
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
         if (m_State.RenderPass != VK_NULL_HANDLE)
             m_State.InsidePassQueries |= queryFlag;
@@ -536,11 +595,54 @@ public:
             m_State.OutsidePassQueries |= queryFlag;
     }
 
+    __forceinline void BeginConditionalRendering(VkBuffer                       Buffer,
+                                                 VkDeviceSize                   Offset,
+                                                 VkConditionalRenderingFlagsEXT Flags)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!m_State.InsidePassConditionalRendering && !m_State.OutsidePassConditionalRendering,
+               "Conditional rendering is already active");
+
+        // The barriers for the predicate buffer must be executed before conditional rendering begins.
+        // Inside a render pass, barriers are not allowed and there must be none pending.
+        if (m_State.RenderPass == VK_NULL_HANDLE)
+            FlushBarriers();
+
+        VkConditionalRenderingBeginInfoEXT BeginInfo{};
+        BeginInfo.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+        BeginInfo.buffer = Buffer;
+        BeginInfo.offset = Offset;
+        BeginInfo.flags  = Flags;
+        vkCmdBeginConditionalRenderingEXT(m_VkCmdBuffer, &BeginInfo);
+
+        if (m_State.RenderPass != VK_NULL_HANDLE)
+            m_State.InsidePassConditionalRendering = true;
+        else
+            m_State.OutsidePassConditionalRendering = true;
+#else
+        LOG_WARNING_MESSAGE_ONCE("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void EndConditionalRendering()
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.InsidePassConditionalRendering || m_State.OutsidePassConditionalRendering, "Conditional rendering is not active");
+
+        vkCmdEndConditionalRenderingEXT(m_VkCmdBuffer);
+        m_State.InsidePassConditionalRendering  = false;
+        m_State.OutsidePassConditionalRendering = false;
+#endif
+    }
+
     __forceinline void EndQuery(VkQueryPool queryPool,
                                 uint32_t    query,
                                 uint32_t    queryFlag)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBufferCopies();
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
         if (m_State.RenderPass != VK_NULL_HANDLE)
         {
@@ -559,6 +661,7 @@ public:
                                       uint32_t                query)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBufferCopies();
         vkCmdWriteTimestamp(m_VkCmdBuffer, pipelineStage, queryPool, query);
     }
 
@@ -693,6 +796,8 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY_EXPR(Label.sType == VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT);
 
+        FlushBufferCopies();
+
         // Pointer to the function may be null if validation layer is not enabled
         if (vkCmdBeginDebugUtilsLabelEXT != nullptr)
             vkCmdBeginDebugUtilsLabelEXT(m_VkCmdBuffer, &Label);
@@ -704,6 +809,8 @@ public:
     __forceinline void EndDebugUtilsLabel()
     {
 #if DILIGENT_USE_VOLK
+        FlushBufferCopies();
+
         // Pointer to function may be null if validation layer is not enabled
         if (vkCmdEndDebugUtilsLabelEXT != nullptr)
             vkCmdEndDebugUtilsLabelEXT(m_VkCmdBuffer);
@@ -718,6 +825,8 @@ public:
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY_EXPR(Label.sType == VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT);
 
+        FlushBufferCopies();
+
         // Pointer to the function may be null if validation layer is not enabled
         if (vkCmdInsertDebugUtilsLabelEXT != nullptr)
             vkCmdInsertDebugUtilsLabelEXT(m_VkCmdBuffer, &Label);
@@ -726,6 +835,28 @@ public:
 #endif
     }
 
+    __forceinline void WriteBufferMarker(VkPipelineStageFlagBits PipelineStage, VkBuffer DstBuffer, VkDeviceSize DstOffset, uint32_t Marker)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBufferCopies();
+        vkCmdWriteBufferMarkerAMD(m_VkCmdBuffer, PipelineStage, DstBuffer, DstOffset, Marker);
+#else
+        UNSUPPORTED("Buffer markers are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetCheckpoint(const void* pCheckpointMarker)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBufferCopies();
+        vkCmdSetCheckpointNV(m_VkCmdBuffer, pCheckpointMarker);
+#else
+        UNSUPPORTED("Diagnostic checkpoints are not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void SetFragmentShadingRate(const VkExtent2D&                        FragSize,
                                               const VkFragmentShadingRateCombinerOpKHR CombinerOps[2])
     {
@@ -738,8 +869,69 @@ public:
 #endif
     }
 
+    __forceinline void SetCullMode(VkCullModeFlags CullMode)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetCullModeEXT(m_VkCmdBuffer, CullMode);
+#else
+        LOG_WARNING_MESSAGE_ONCE("Dynamic pipeline states are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetDepthState(VkBool32 DepthTestEnable, VkBool32 DepthWriteEnable, VkCompareOp DepthCompareOp)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetDepthTestEnableEXT(m_VkCmdBuffer, DepthTestEnable);
+        vkCmdSetDepthWriteEnableEXT(m_VkCmdBuffer, DepthWriteEnable);
+        vkCmdSetDepthCompareOpEXT(m_VkCmdBuffer, DepthCompareOp);
+#else
+        LOG_WARNING_MESSAGE_ONCE("Dynamic pipeline states are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetStencilState(VkBool32 StencilTestEnable, const VkStencilOpState& Front, const VkStencilOpState& Back)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetStencilTestEnableEXT(m_VkCmdBuffer, StencilTestEnable);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, Front.failOp, Front.passOp, Front.depthFailOp, Front.compareOp);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_BACK_BIT, Back.failOp, Back.passOp, Back.depthFailOp, Back.compareOp);
+#else
+        LOG_WARNING_MESSAGE_ONCE("Dynamic pipeline states are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetPrimitiveTopology(VkPrimitiveTopology Topology)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetPrimitiveTopologyEXT(m_VkCmdBuffer, Topology);
+#else
+        LOG_WARNING_MESSAGE_ONCE("Dynamic pipeline states are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    // Records the pending buffer copies and barriers
     void FlushBarriers();
 
+    // Records all pending barriers with vkCmdWaitEvents() instead of vkCmdPipelineBarrier().
+    // EventSrcStages must match the stage mask that was passed to SetEvent().
+    void FlushBarriers(VkEvent WaitEvent, VkPipelineStageFlags EventSrcStages);
+
+    __forceinline void SetEvent(VkEvent Event, VkPipelineStageFlags StageMask)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (m_State.RenderPass != VK_NULL_HANDLE)
+        {
+            // vkCmdSetEvent must only be called outside of a render pass instance
+            EndRenderPass();
+        }
+        FlushBarriers();
+        vkCmdSetEvent(m_VkCmdBuffer, Event, StageMask & m_Barrier.SupportedStagesMask);
+    }
+
     __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer, VkPipelineStageFlags StageMask, VkAccessFlags AccessMask)
     {
         m_VkCmdBuffer                 = VkCmdBuffer;
@@ -748,6 +940,9 @@ public:
     }
     VkCommandBuffer GetVkCmdBuffer() const { return m_VkCmdBuffer; }
 
+    // Sets the counter that FlushBarriers() increments by the number of recorded barriers (may be null)
+    void SetBarrierCounter(uint64_t* pBarrierCounter) { m_pBarrierCounter = pBarrierCounter; }
+
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_Barrier.SupportedStagesMask; }
     VkAccessFlags        GetSupportedAccessMask() const { return m_Barrier.SupportedAccessMask; }
 
@@ -765,11 +960,21 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+
+        bool InsidePassConditionalRendering  = false;
+        bool OutsidePassConditionalRendering = false;
     };
 
     const StateCache& GetState() const { return m_State; }
 
 private:
+    void FlushBufferCopies();
+
+    bool HasPendingBarriers() const
+    {
+        return m_Barrier.MemorySrcStages != 0 || m_Barrier.MemoryDstStages != 0 || !m_ImageBarriers.empty();
+    }
+
     struct PipelineBarrier
     {
         VkPipelineStageFlags MemorySrcStages = 0;
@@ -789,6 +994,18 @@ private:
     PipelineBarrier m_Barrier;
 
     std::vector<VkImageMemoryBarrier> m_ImageBarriers;
+
+    struct PendingBufferCopies
+    {
+        VkBuffer SrcBuffer = VK_NULL_HANDLE;
+        VkBuffer DstBuffer = VK_NULL_HANDLE;
+
+        std::vector<VkBufferCopy> Regions;
+    };
+    // Buffer copies that are always recorded before the pending barriers
+    PendingBufferCopies m_PendingCopies;
+
+    uint64_t* m_pBarrierCounter = nullptr;
 };
 
 } // namespace VulkanUtilities
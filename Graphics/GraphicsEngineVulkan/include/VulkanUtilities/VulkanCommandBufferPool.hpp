@@ -54,9 +54,11 @@ public:
 
     ~VulkanCommandBufferPool();
 
-    VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
+    // If pInheritanceInfo is not null, returns a secondary command buffer that continues the render pass
+    // specified by the inheritance info. Otherwise, returns a primary command buffer.
+    VkCommandBuffer GetCommandBuffer(const char* DebugName = "", const VkCommandBufferInheritanceInfo* pInheritanceInfo = nullptr);
     // The GPU must have finished with the command buffer being returned to the pool
-    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer);
+    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, bool IsSecondary = false);
 
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_SupportedStagesMask; }
     VkAccessFlags        GetSupportedAccessMask() const { return m_SupportedAccessMask; }
@@ -69,6 +71,7 @@ private:
 
     std::mutex                  m_Mutex;
     std::deque<VkCommandBuffer> m_CmdBuffers;
+    std::deque<VkCommandBuffer> m_SecondaryCmdBuffers;
     const VkPipelineStageFlags  m_SupportedStagesMask;
     const VkAccessFlags         m_SupportedAccessMask;
 
@@ -50,6 +50,7 @@
 
 #ifdef _WINBASE_
 #    undef CreateSemaphore
+#    undef CreateEvent
 #    undef MemoryBarrier
 #endif
 
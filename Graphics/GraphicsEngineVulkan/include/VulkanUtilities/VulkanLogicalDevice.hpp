@@ -59,7 +59,8 @@ enum class VulkanHandleTypeId : uint32_t
     Event,
     QueryPool,
     AccelerationStructureKHR,
-    PipelineCache
+    PipelineCache,
+    DescriptorUpdateTemplate
 };
 
 template <typename VulkanObjectType, VulkanHandleTypeId>
@@ -82,9 +83,11 @@ using FramebufferWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(Framebuffer);
 using DescriptorPoolWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
 using DescriptorSetLayoutWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
 using SemaphoreWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
+using EventWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(Event);
 using QueryPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
 using AccelStructWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(AccelerationStructureKHR);
 using PipelineCacheWrapper       = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+using DescriptorUpdateTemplateWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorUpdateTemplate);
 #undef DEFINE_VULKAN_OBJECT_WRAPPER
 
 class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDevice>
@@ -149,6 +152,7 @@ public:
 
     SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo& SemaphoreCI, const char* DebugName = "") const;
     SemaphoreWrapper    CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName = "") const;
+    EventWrapper        CreateEvent(const VkEventCreateInfo& EventCI, const char* DebugName = "") const;
     QueryPoolWrapper    CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName = "") const;
     AccelStructWrapper  CreateAccelStruct(const VkAccelerationStructureCreateInfoKHR& CI, const char* DebugName = "") const;
 
@@ -157,6 +161,8 @@ public:
 
     PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo &CI, const char* DebugName = "") const;
 
+    DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName = "") const;
+
     void ReleaseVulkanObject(CommandPoolWrapper&&  CmdPool) const;
     void ReleaseVulkanObject(BufferWrapper&&       Buffer) const;
     void ReleaseVulkanObject(BufferViewWrapper&&   BufferView) const;
@@ -173,9 +179,11 @@ public:
     void ReleaseVulkanObject(DescriptorPoolWrapper&& DescriptorPool) const;
     void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout) const;
     void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore) const;
+    void ReleaseVulkanObject(EventWrapper&&         Event) const;
     void ReleaseVulkanObject(QueryPoolWrapper&&     QueryPool) const;
     void ReleaseVulkanObject(AccelStructWrapper&&   AccelStruct) const;
     void ReleaseVulkanObject(PipelineCacheWrapper&& PSOCache) const;
+    void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescrUpdateTemplate) const;
 
     void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const;
     void FreeCommandBuffer(VkCommandPool Pool, VkCommandBuffer CmdBuffer) const;
@@ -210,6 +218,10 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    void UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                         VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                         const void*                pData) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
@@ -236,6 +248,10 @@ public:
 
     VkResult GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const;
 
+    void GetShaderModuleIdentifier(VkShaderModule shaderModule, VkShaderModuleIdentifierEXT& Identifier) const;
+
+    VkResult GetCalibratedTimestamps(uint32_t timestampCount, const VkCalibratedTimestampInfoEXT* pTimestampInfos, uint64_t* pTimestamps, uint64_t* pMaxDeviation) const;
+
     VkPipelineStageFlags GetSupportedStagesMask(HardwareQueueIndex QueueFamilyIndex) const { return m_SupportedStagesMask[QueueFamilyIndex]; }
     VkAccessFlags        GetSupportedAccessMask(HardwareQueueIndex QueueFamilyIndex) const { return m_SupportedAccessMask[QueueFamilyIndex]; }
 
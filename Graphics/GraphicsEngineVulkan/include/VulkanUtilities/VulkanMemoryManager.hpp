@@ -28,6 +28,7 @@
 #pragma once
 
 #include <mutex>
+#include <shared_mutex>
 #include <array>
 #include <unordered_map>
 #include <atomic>
@@ -38,6 +39,7 @@
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "HashUtils.hpp"
+#include "GPUMemoryTracker.hpp"
 
 namespace VulkanUtilities
 {
@@ -107,7 +109,8 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_GPUMemoryRecord {std::move(rhs.m_GPUMemoryRecord)}
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -141,6 +144,7 @@ private:
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+    Diligent::GPUMemoryRecord                m_GPUMemoryRecord;
 };
 
 class VulkanMemoryManager
@@ -154,7 +158,8 @@ public:
                         VkDeviceSize                 DeviceLocalPageSize,
                         VkDeviceSize                 HostVisiblePageSize,
                         VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) :
+                        VkDeviceSize                 HostVisibleReserveSize,
+                        Diligent::GPUMemoryTracker*  pGPUMemoryTracker) :
         m_MgrName               {std::move(MgrName)    },
         m_LogicalDevice         {LogicalDevice         },
         m_PhysicalDevice        {PhysicalDevice        },
@@ -162,7 +167,9 @@ public:
         m_DeviceLocalPageSize   {DeviceLocalPageSize   },
         m_HostVisiblePageSize   {HostVisiblePageSize   },
         m_DeviceLocalReserveSize{DeviceLocalReserveSize},
-        m_HostVisibleReserveSize{HostVisibleReserveSize}
+        m_HostVisibleReserveSize{HostVisibleReserveSize},
+        m_UseMemoryBudget       {LogicalDevice.GetEnabledExtFeatures().MemoryBudget},
+        m_pGPUMemoryTracker     {pGPUMemoryTracker     }
     {}
 
 
@@ -180,15 +187,20 @@ public:
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
+        m_UseMemoryBudget        {rhs.m_UseMemoryBudget       },
+        m_pGPUMemoryTracker      {rhs.m_pGPUMemoryTracker     },
 
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
-        m_PeakUsedSize      {rhs.m_PeakUsedSize     },
+        //m_PeakUsedSize      {rhs.m_PeakUsedSize},
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
         m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
+        {
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+            m_PeakUsedSize[i].store(rhs.m_PeakUsedSize[i].load());
+        }
     }
 
     ~VulkanMemoryManager();
@@ -203,6 +215,12 @@ public:
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
     void                   ShrinkMemory();
 
+    // Returns the total size of the device-local and host-visible memory currently suballocated by the manager
+    VkDeviceSize GetCurrentUsedSize() const
+    {
+        return static_cast<VkDeviceSize>(m_CurrUsedSize[0].load(std::memory_order_relaxed) + m_CurrUsedSize[1].load(std::memory_order_relaxed));
+    }
+
 protected:
     friend class VulkanMemoryPage;
 
@@ -216,7 +234,10 @@ protected:
 
     Diligent::IMemoryAllocator& m_Allocator;
 
-    std::mutex m_PagesMtx;
+    // Allocations from the existing pages only take a shared lock, so that threads
+    // allocating resources in parallel are not serialized. The exclusive lock is
+    // only taken to create or destroy pages.
+    std::shared_timed_mutex m_PagesMtx;
     struct MemoryPageIndex
     {
         const uint32_t              MemoryTypeIndex;
@@ -255,11 +276,30 @@ protected:
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
+    // Whether VK_EXT_memory_budget is enabled and heap budgets should be respected
+    const bool m_UseMemoryBudget;
+
+    // Memory pages are registered in the tracker (may be null)
+    Diligent::GPUMemoryTracker* const m_pGPUMemoryTracker;
+
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible);
 
+    // Allocates from an existing page. Partially used pages are preferred over empty ones
+    // so that empty pages stay empty and can be released by ShrinkMemory().
+    // m_PagesMtx must be locked.
+    VulkanMemoryAllocation AllocateFromExistingPages(const MemoryPageIndex& PageIdx, VkDeviceSize Size, VkDeviceSize Alignment);
+
+    // Releases empty pages while the allocated size exceeds the reserve size.
+    // m_PagesMtx must be locked exclusively.
+    void ReleaseEmptyPages(VkDeviceSize DeviceLocalReserveSize, VkDeviceSize HostVisibleReserveSize);
+
+    // Checks if a new page of the given size fits into the budget of the heap that backs
+    // the memory type. Always returns true if VK_EXT_memory_budget is not enabled.
+    bool IsWithinHeapBudget(uint32_t MemoryTypeIndex, VkDeviceSize PageSize) const;
+
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic<int64_t>, 2> m_CurrUsedSize      = {};
-    std::array<VkDeviceSize, 2>         m_PeakUsedSize      = {};
+    std::array<std::atomic<int64_t>, 2> m_PeakUsedSize      = {};
     std::array<VkDeviceSize, 2>         m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2>         m_PeakAllocatedSize = {};
 
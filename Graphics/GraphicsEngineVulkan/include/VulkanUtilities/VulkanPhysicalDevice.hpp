@@ -48,47 +48,62 @@ public:
 
     struct ExtensionFeatures
     {
-        VkPhysicalDeviceMeshShaderFeaturesNV              MeshShader             = {};
-        VkPhysicalDevice16BitStorageFeaturesKHR           Storage16Bit           = {};
-        VkPhysicalDevice8BitStorageFeaturesKHR            Storage8Bit            = {};
-        VkPhysicalDeviceShaderFloat16Int8FeaturesKHR      ShaderFloat16Int8      = {};
-        VkPhysicalDeviceAccelerationStructureFeaturesKHR  AccelStruct            = {};
-        VkPhysicalDeviceRayTracingPipelineFeaturesKHR     RayTracingPipeline     = {};
-        VkPhysicalDeviceRayQueryFeaturesKHR               RayQuery               = {};
-        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR    BufferDeviceAddress    = {};
-        VkPhysicalDeviceDescriptorIndexingFeaturesEXT     DescriptorIndexing     = {};
-        VkPhysicalDevicePortabilitySubsetFeaturesKHR      PortabilitySubset      = {};
-        VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT VertexAttributeDivisor = {};
-        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR      TimelineSemaphore      = {};
-        VkPhysicalDeviceHostQueryResetFeatures            HostQueryReset         = {};
-        VkPhysicalDeviceFragmentShadingRateFeaturesKHR    ShadingRate            = {};
-        VkPhysicalDeviceFragmentDensityMapFeaturesEXT     FragmentDensityMap     = {}; // Only for desktop devices
-        VkPhysicalDeviceFragmentDensityMap2FeaturesEXT    FragmentDensityMap2    = {}; // Only for mobile devices
-        VkPhysicalDeviceMultiviewFeaturesKHR              Multiview              = {}; // Required for RenderPass2
-
-        bool Spirv14              = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
-        bool Spirv15              = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
-        bool SubgroupOps          = false; // Requires Vulkan 1.1
-        bool HasPortabilitySubset = false;
-        bool RenderPass2          = false;
-        bool DrawIndirectCount    = false;
+        VkPhysicalDeviceMeshShaderFeaturesNV                    MeshShader                   = {};
+        VkPhysicalDevice16BitStorageFeaturesKHR                 Storage16Bit                 = {};
+        VkPhysicalDevice8BitStorageFeaturesKHR                  Storage8Bit                  = {};
+        VkPhysicalDeviceShaderFloat16Int8FeaturesKHR            ShaderFloat16Int8            = {};
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR        AccelStruct                  = {};
+        VkPhysicalDeviceRayTracingPipelineFeaturesKHR           RayTracingPipeline           = {};
+        VkPhysicalDeviceRayQueryFeaturesKHR                     RayQuery                     = {};
+        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR          BufferDeviceAddress          = {};
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT           DescriptorIndexing           = {};
+        VkPhysicalDevicePortabilitySubsetFeaturesKHR            PortabilitySubset            = {};
+        VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT       VertexAttributeDivisor       = {};
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR            TimelineSemaphore            = {};
+        VkPhysicalDeviceHostQueryResetFeatures                  HostQueryReset               = {};
+        VkPhysicalDeviceFragmentShadingRateFeaturesKHR          ShadingRate                  = {};
+        VkPhysicalDeviceFragmentDensityMapFeaturesEXT           FragmentDensityMap           = {}; // Only for desktop devices
+        VkPhysicalDeviceFragmentDensityMap2FeaturesEXT          FragmentDensityMap2          = {}; // Only for mobile devices
+        VkPhysicalDeviceMultiviewFeaturesKHR                    Multiview                    = {}; // Required for RenderPass2
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT         ExtendedDynamicState         = {};
+        VkPhysicalDeviceConditionalRenderingFeaturesEXT         ConditionalRendering         = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT      GraphicsPipelineLibrary      = {};
+        VkPhysicalDevicePresentIdFeaturesKHR                    PresentId                    = {};
+        VkPhysicalDevicePresentWaitFeaturesKHR                  PresentWait                  = {};
+        VkPhysicalDevicePipelineCreationCacheControlFeaturesEXT PipelineCreationCacheControl = {};
+        VkPhysicalDeviceShaderModuleIdentifierFeaturesEXT       ShaderModuleIdentifier       = {};
+
+        bool Spirv14                  = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
+        bool Spirv15                  = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
+        bool SubgroupOps              = false; // Requires Vulkan 1.1
+        bool HasPortabilitySubset     = false;
+        bool RenderPass2              = false;
+        bool DrawIndirectCount        = false;
+        bool MemoryBudget             = false;
+        bool BufferMarker             = false; // VK_AMD_buffer_marker
+        bool DiagnosticCheckpoints    = false; // VK_NV_device_diagnostic_checkpoints
+        bool DisplayTiming            = false; // VK_GOOGLE_display_timing
+        bool CalibratedTimestamps     = false; // VK_EXT_calibrated_timestamps with the device and the host time domains
+        bool PipelineCreationFeedback = false; // VK_EXT_pipeline_creation_feedback or Vulkan 1.3
     };
 
     struct ExtensionProperties
     {
-        VkPhysicalDeviceMeshShaderPropertiesNV              MeshShader             = {};
-        VkPhysicalDeviceAccelerationStructurePropertiesKHR  AccelStruct            = {};
-        VkPhysicalDeviceRayTracingPipelinePropertiesKHR     RayTracingPipeline     = {};
-        VkPhysicalDeviceDescriptorIndexingPropertiesEXT     DescriptorIndexing     = {};
-        VkPhysicalDevicePortabilitySubsetPropertiesKHR      PortabilitySubset      = {};
-        VkPhysicalDeviceSubgroupProperties                  Subgroup               = {};
-        VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT VertexAttributeDivisor = {};
-        VkPhysicalDeviceTimelineSemaphorePropertiesKHR      TimelineSemaphore      = {};
-        VkPhysicalDeviceFragmentShadingRatePropertiesKHR    ShadingRate            = {};
-        VkPhysicalDeviceFragmentDensityMapPropertiesEXT     FragmentDensityMap     = {};
-        VkPhysicalDeviceMultiviewPropertiesKHR              Multiview              = {};
-        VkPhysicalDeviceMaintenance3Properties              Maintenance3           = {};
-        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT    FragmentDensityMap2    = {};
+        VkPhysicalDeviceMeshShaderPropertiesNV               MeshShader              = {};
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR   AccelStruct             = {};
+        VkPhysicalDeviceRayTracingPipelinePropertiesKHR      RayTracingPipeline      = {};
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT      DescriptorIndexing      = {};
+        VkPhysicalDevicePortabilitySubsetPropertiesKHR       PortabilitySubset       = {};
+        VkPhysicalDeviceSubgroupProperties                   Subgroup                = {};
+        VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT  VertexAttributeDivisor  = {};
+        VkPhysicalDeviceTimelineSemaphorePropertiesKHR       TimelineSemaphore       = {};
+        VkPhysicalDeviceFragmentShadingRatePropertiesKHR     ShadingRate             = {};
+        VkPhysicalDeviceFragmentDensityMapPropertiesEXT      FragmentDensityMap      = {};
+        VkPhysicalDeviceMultiviewPropertiesKHR               Multiview               = {};
+        VkPhysicalDeviceMaintenance3Properties               Maintenance3            = {};
+        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT     FragmentDensityMap2     = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT GraphicsPipelineLibrary = {};
+        VkPhysicalDeviceShaderModuleIdentifierPropertiesEXT  ShaderModuleIdentifier  = {};
     };
 
 public:
@@ -110,6 +125,18 @@ public:
 
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
+    // Queries the current memory heap budgets and usage. Returns false if VK_EXT_memory_budget
+    // extension is not supported, in which case Budget is left unchanged.
+    bool GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const;
+
+    // Gets the host time domain that matches std::chrono::steady_clock on this platform
+    // (QueryPerformanceCounter on Windows, CLOCK_MONOTONIC on Linux and Android).
+    // Returns false if there is no such domain.
+    static bool GetHostTimeDomain(VkTimeDomainEXT& Domain);
+
+    // Converts the timestamp in the host time domain to nanoseconds.
+    static uint64_t HostTimestampToNanoseconds(uint64_t Timestamp);
+
     VkPhysicalDevice                            GetVkDeviceHandle() const { return m_VkDevice; }
     uint32_t                                    GetVkVersion() const { return m_VkVersion; }
     const VkPhysicalDeviceProperties&           GetProperties() const { return m_Properties; }
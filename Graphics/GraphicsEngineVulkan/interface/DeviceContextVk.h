@@ -84,6 +84,96 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL VkCommandBuffer METHOD(GetVkCommandBuffer)(THIS) PURE;
+
+    /// Begins recording a secondary command list in a deferred context
+
+    /// \param [in] ImmediateContextId - Index of the immediate context that will execute the command list,
+    ///                                  same as in IDeviceContext::Begin().
+    /// \param [in] pRenderPass        - Render pass that the command list will be executed in.
+    /// \param [in] SubpassIndex       - Index of the subpass that the command list will be executed in.
+    /// \param [in] pFramebuffer       - Framebuffer that the render pass will be begun with.
+    ///
+    /// \remarks   Commands are recorded into a secondary Vulkan command buffer that continues the
+    ///            specified subpass. The context behaves as if the render pass had been begun and the
+    ///            subpass had been made current: the subpass render targets, framebuffer size and
+    ///            viewport are set. Render pass commands, resource state transitions, copies and
+    ///            dispatches are not allowed while recording a secondary command list.
+    ///
+    ///            Call IDeviceContext::FinishCommandList() to finish the recording. The command list must be
+    ///            executed with IDeviceContext::ExecuteCommandLists() by the immediate context inside the same
+    ///            subpass, which must have been begun while secondary command lists were enabled (see
+    ///            IDeviceContextVk::EnableSecondaryCommandLists()). Multiple deferred contexts may record
+    ///            secondary command lists for the same subpass in parallel.
+    VIRTUAL void METHOD(BeginSecondaryCommandList)(THIS_
+                                                   Uint32        ImmediateContextId,
+                                                   IRenderPass*  pRenderPass,
+                                                   Uint32        SubpassIndex,
+                                                   IFramebuffer* pFramebuffer) PURE;
+
+    /// Enables or disables executing secondary command lists in the render pass subpasses
+
+    /// \param [in] Enable - Whether the subpasses begun by the following IDeviceContext::BeginRenderPass()
+    ///                      and IDeviceContext::NextSubpass() calls get their contents from secondary
+    ///                      command lists.
+    ///
+    /// \remarks   This method is only allowed for immediate contexts.
+    ///            Vulkan requires that a subpass either records all its commands inline or executes them from
+    ///            secondary command buffers. When secondary command lists are enabled, the only command allowed
+    ///            inside a subpass is IDeviceContext::ExecuteCommandLists() with command lists recorded by
+    ///            IDeviceContextVk::BeginSecondaryCommandList().
+    VIRTUAL void METHOD(EnableSecondaryCommandLists)(THIS_
+                                                     Bool Enable) PURE;
+
+    /// Sets the cull mode of the currently bound graphics pipeline
+
+    /// \param [in] CullMode - Cull mode to set.
+    ///
+    /// \remarks   The pipeline must have been created with PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE flag.
+    ///            When a pipeline with the flag is bound by IDeviceContext::SetPipelineState(), the cull mode
+    ///            is reset to the value from its rasterizer state description.
+    VIRTUAL void METHOD(SetCullMode)(THIS_
+                                     CULL_MODE CullMode) PURE;
+
+    /// Sets the depth test state of the currently bound graphics pipeline
+
+    /// \param [in] DepthEnable      - Whether to enable the depth test.
+    /// \param [in] DepthWriteEnable - Whether to enable writes to the depth buffer.
+    /// \param [in] DepthFunc        - Depth comparison function.
+    ///
+    /// \remarks   The pipeline must have been created with PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST flag.
+    ///            When a pipeline with the flag is bound by IDeviceContext::SetPipelineState(), the depth
+    ///            state is reset to the values from its depth-stencil state description.
+    VIRTUAL void METHOD(SetDepthState)(THIS_
+                                       Bool                DepthEnable,
+                                       Bool                DepthWriteEnable,
+                                       COMPARISON_FUNCTION DepthFunc) PURE;
+
+    /// Sets the stencil test state of the currently bound graphics pipeline
+
+    /// \param [in] StencilEnable - Whether to enable the stencil test.
+    /// \param [in] FrontFace     - Stencil operations for front-facing triangles.
+    /// \param [in] BackFace      - Stencil operations for back-facing triangles.
+    ///
+    /// \remarks   The pipeline must have been created with PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST flag.
+    ///            Stencil read and write masks are not dynamic and are taken from the pipeline.
+    ///            When a pipeline with the flag is bound by IDeviceContext::SetPipelineState(), the stencil
+    ///            state is reset to the values from its depth-stencil state description.
+    VIRTUAL void METHOD(SetStencilState)(THIS_
+                                         Bool                    StencilEnable,
+                                         const StencilOpDesc REF FrontFace,
+                                         const StencilOpDesc REF BackFace) PURE;
+
+    /// Sets the primitive topology of the currently bound graphics pipeline
+
+    /// \param [in] PrimitiveTopology - Primitive topology to set. It must belong to the same
+    ///                                 topology class (point, line or triangle) as the topology
+    ///                                 the pipeline was created with.
+    ///
+    /// \remarks   The pipeline must have been created with PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY flag.
+    ///            When a pipeline with the flag is bound by IDeviceContext::SetPipelineState(), the topology
+    ///            is reset to the value from its description.
+    VIRTUAL void METHOD(SetPrimitiveTopology)(THIS_
+                                              PRIMITIVE_TOPOLOGY PrimitiveTopology) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -93,8 +183,14 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
-#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
+#    define IDeviceContextVk_TransitionImageLayout(This, ...)       CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout,       This, __VA_ARGS__)
+#    define IDeviceContextVk_BufferMemoryBarrier(This, ...)         CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,         This, __VA_ARGS__)
+#    define IDeviceContextVk_BeginSecondaryCommandList(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BeginSecondaryCommandList,   This, __VA_ARGS__)
+#    define IDeviceContextVk_EnableSecondaryCommandLists(This, ...) CALL_IFACE_METHOD(DeviceContextVk, EnableSecondaryCommandLists, This, __VA_ARGS__)
+#    define IDeviceContextVk_SetCullMode(This, ...)                 CALL_IFACE_METHOD(DeviceContextVk, SetCullMode,                 This, __VA_ARGS__)
+#    define IDeviceContextVk_SetDepthState(This, ...)               CALL_IFACE_METHOD(DeviceContextVk, SetDepthState,               This, __VA_ARGS__)
+#    define IDeviceContextVk_SetStencilState(This, ...)             CALL_IFACE_METHOD(DeviceContextVk, SetStencilState,             This, __VA_ARGS__)
+#    define IDeviceContextVk_SetPrimitiveTopology(This, ...)        CALL_IFACE_METHOD(DeviceContextVk, SetPrimitiveTopology,        This, __VA_ARGS__)
 
 // clang-format on
 
@@ -130,6 +130,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             case BIND_INDIRECT_DRAW_ARGS:
             {
                 VkBuffCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+                // Indirect argument buffers may also hold conditional rendering predicates
+                if (LogicalDevice.GetEnabledExtFeatures().ConditionalRendering.conditionalRendering != VK_FALSE)
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
                 break;
             }
             case BIND_UNIFORM_BUFFER:
@@ -199,6 +202,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
         SetState(RESOURCE_STATE_UNDEFINED);
+
+        // Sparse buffer memory is tracked by the device memory objects it is bound to
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_PLACED, 0);
     }
     else if (m_Desc.Usage == USAGE_DYNAMIC && !RequiresBackingBuffer)
     {
@@ -220,6 +226,7 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         {
             constexpr VkAccessFlags AccessFlags =
                 VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT |
                 VK_ACCESS_INDEX_READ_BIT |
                 VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
                 VK_ACCESS_UNIFORM_READ_BIT |
@@ -324,6 +331,8 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+        RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, m_MemoryAllocation.Size);
+
         VERIFY(!AlignToNonCoherentAtomSize || (m_BufferMemoryAlignedOffset + MemReqs.size) % DeviceLimits.nonCoherentAtomSize == 0, "End offset is not properly aligned");
 
 #ifdef DILIGENT_DEBUG
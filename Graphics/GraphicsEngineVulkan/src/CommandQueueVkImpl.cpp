@@ -61,6 +61,7 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
         VulkanUtilities::SetQueueName(m_LogicalDevice->GetVkDevice(), m_VkQueue, CreateInfo.Name);
 
     m_TempSignalSemaphores.reserve(16);
+    m_TempSignalValues.reserve(16);
 }
 
 CommandQueueVkImpl::~CommandQueueVkImpl()
@@ -147,6 +148,57 @@ __forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue
     return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), dbgValue}, std::move(Deleter)};
 }
 
+const void* CommandQueueVkImpl::AppendFenceTimelineSignal(const void*                    pNext,
+                                                          uint32_t                       SignalSemaphoreCount,
+                                                          const VkSemaphore*             pSignalSemaphores,
+                                                          Uint64                         FenceValue,
+                                                          VkTimelineSemaphoreSubmitInfo& TimelineSubmitInfo)
+{
+    VERIFY_EXPR(UseFenceTimelineSemaphore());
+
+    const VkTimelineSemaphoreSubmitInfo* pSrcTimelineInfo = nullptr;
+    for (const auto* pStruct = static_cast<const VkBaseInStructure*>(pNext); pStruct != nullptr; pStruct = pStruct->pNext)
+    {
+        if (pStruct->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
+        {
+            // The structure can only be replaced when it is the first one in the chain
+            if (pStruct != pNext)
+                return nullptr;
+            pSrcTimelineInfo = reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(pStruct);
+            break;
+        }
+    }
+
+    m_TempSignalSemaphores.clear();
+    m_TempSignalValues.clear();
+    for (uint32_t s = 0; s < SignalSemaphoreCount; ++s)
+    {
+        m_TempSignalSemaphores.push_back(pSignalSemaphores[s]);
+        // Values are ignored for binary semaphores
+        m_TempSignalValues.push_back(pSrcTimelineInfo != nullptr && s < pSrcTimelineInfo->signalSemaphoreValueCount ?
+                                         pSrcTimelineInfo->pSignalSemaphoreValues[s] :
+                                         0);
+    }
+    m_TempSignalSemaphores.push_back(m_pFence->GetVkSemaphore());
+    m_TempSignalValues.push_back(FenceValue);
+
+    if (pSrcTimelineInfo != nullptr)
+    {
+        TimelineSubmitInfo = *pSrcTimelineInfo;
+    }
+    else
+    {
+        TimelineSubmitInfo.sType                   = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        TimelineSubmitInfo.pNext                   = pNext;
+        TimelineSubmitInfo.waitSemaphoreValueCount = 0;
+        TimelineSubmitInfo.pWaitSemaphoreValues    = nullptr;
+    }
+    TimelineSubmitInfo.signalSemaphoreValueCount = static_cast<uint32_t>(m_TempSignalValues.size());
+    TimelineSubmitInfo.pSignalSemaphoreValues    = m_TempSignalValues.data();
+
+    return &TimelineSubmitInfo;
+}
+
 Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
@@ -154,6 +206,37 @@ Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
     // Increment the value before submitting the buffer to be overly safe
     const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
 
+    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
+    if (UseFenceTimelineSemaphore())
+    {
+        // The queue fence is signaled by the submission itself, so no binary fence is required.
+        VkTimelineSemaphoreSubmitInfo TimelineSubmitInfo{};
+
+        VkSubmitInfo SubmitInfo = InSubmitInfo;
+        if (const void* pNext = AppendFenceTimelineSignal(InSubmitInfo.pNext, InSubmitInfo.signalSemaphoreCount, InSubmitInfo.pSignalSemaphores, FenceValue, TimelineSubmitInfo))
+        {
+            SubmitInfo.pNext                = pNext;
+            SubmitInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
+            SubmitInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
+
+            auto err = vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, VK_NULL_HANDLE);
+            CheckDeviceLost(err);
+            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
+            (void)err;
+        }
+        else
+        {
+            auto err = vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, VK_NULL_HANDLE);
+            CheckDeviceLost(err);
+            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
+            (void)err;
+
+            InternalSignalSemaphore(m_pFence->GetVkSemaphore(), FenceValue);
+        }
+
+        return FenceValue;
+    }
+
     auto NewSyncPoint = CreateSyncPoint(FenceValue);
 
     m_TempSignalSemaphores.clear();
@@ -187,10 +270,10 @@ Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
         0;
 
     auto err = vkQueueSubmit(m_VkQueue, SubmitCount, &SubmitInfo, NewSyncPoint->GetFence());
+    CheckDeviceLost(err);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
     (void)err;
 
-    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
     m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
 
     // Update the last sync point
@@ -228,14 +311,36 @@ Uint64 CommandQueueVkImpl::WaitForIdle()
     // Update last completed fence value to unlock all waiting events.
     const auto FenceValue = m_NextFenceValue.fetch_add(1);
 
-    vkQueueWaitIdle(m_VkQueue);
-    // For some reason after idling the queue not all fences are signaled
-    m_pFence->Wait(UINT64_MAX);
-    m_pFence->Reset(FenceValue);
+    CheckDeviceLost(vkQueueWaitIdle(m_VkQueue));
+    if (UseFenceTimelineSemaphore())
+    {
+        // All previous submissions are complete, so the semaphore can be signaled from the host
+        VkSemaphoreSignalInfo SignalInfo{};
+        SignalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        SignalInfo.pNext     = nullptr;
+        SignalInfo.semaphore = m_pFence->GetVkSemaphore();
+        SignalInfo.value     = FenceValue;
+
+        auto err = m_LogicalDevice->SignalSemaphore(SignalInfo);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to signal timeline semaphore");
+        (void)err;
+    }
+    else
+    {
+        // For some reason after idling the queue not all fences are signaled
+        m_pFence->Wait(UINT64_MAX);
+        m_pFence->Reset(FenceValue);
+    }
 
     return FenceValue;
 }
 
+void CommandQueueVkImpl::CheckDeviceLost(VkResult err)
+{
+    if (err == VK_ERROR_DEVICE_LOST && !m_DeviceLost.exchange(true))
+        LOG_ERROR_MESSAGE("Vulkan device has been lost");
+}
+
 Uint64 CommandQueueVkImpl::GetCompletedFenceValue()
 {
     return m_pFence->GetCompletedValue();
@@ -248,6 +353,7 @@ void CommandQueueVkImpl::EnqueueSignalFence(VkFence vkFence)
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
 
     auto err = vkQueueSubmit(m_VkQueue, 0, nullptr, vkFence);
+    CheckDeviceLost(err);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit fence signal command to the command queue");
     (void)err;
 }
@@ -280,6 +386,7 @@ void CommandQueueVkImpl::InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore
     SubmitInfo.pSignalSemaphores    = &vkTimelineSemaphore;
 
     auto err = vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, VK_NULL_HANDLE);
+    CheckDeviceLost(err);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit timeline semaphore signal command to the command queue");
     (void)err;
 }
@@ -287,7 +394,9 @@ void CommandQueueVkImpl::InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore
 VkResult CommandQueueVkImpl::Present(const VkPresentInfoKHR& PresentInfo)
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
-    return vkQueuePresentKHR(m_VkQueue, &PresentInfo);
+    auto err = vkQueuePresentKHR(m_VkQueue, &PresentInfo);
+    CheckDeviceLost(err);
+    return err;
 }
 
 Uint64 CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& InBindInfo)
@@ -297,6 +406,34 @@ Uint64 CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& InBindInfo)
     // Increment the value before submitting the buffer to be overly safe
     const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
 
+    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
+    if (UseFenceTimelineSemaphore())
+    {
+        VkTimelineSemaphoreSubmitInfo TimelineSubmitInfo{};
+
+        VkBindSparseInfo BindInfo = InBindInfo;
+        if (const void* pNext = AppendFenceTimelineSignal(InBindInfo.pNext, InBindInfo.signalSemaphoreCount, InBindInfo.pSignalSemaphores, FenceValue, TimelineSubmitInfo))
+        {
+            BindInfo.pNext                = pNext;
+            BindInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
+            BindInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
+
+            auto err = vkQueueBindSparse(m_VkQueue, 1, &BindInfo, VK_NULL_HANDLE);
+            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit sparse bind commands to the command queue");
+            (void)err;
+        }
+        else
+        {
+            auto err = vkQueueBindSparse(m_VkQueue, 1, &BindInfo, VK_NULL_HANDLE);
+            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit sparse bind commands to the command queue");
+            (void)err;
+
+            InternalSignalSemaphore(m_pFence->GetVkSemaphore(), FenceValue);
+        }
+
+        return FenceValue;
+    }
+
     auto NewSyncPoint = CreateSyncPoint(FenceValue);
 
     m_TempSignalSemaphores.clear();
@@ -326,7 +463,6 @@ Uint64 CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& InBindInfo)
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit sparse bind commands to the command queue");
     (void)err;
 
-    VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
     m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
 
     // Update the last sync point
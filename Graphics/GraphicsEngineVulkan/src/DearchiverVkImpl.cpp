@@ -44,4 +44,17 @@ RefCntAutoPtr<IPipelineResourceSignature> DearchiverVkImpl::UnpackResourceSignat
     return DearchiverBase::UnpackResourceSignatureImpl<RenderDeviceVkImpl, PRSSerializerVk<SerializerMode::Read>>(DeArchiveInfo, IsImplicit);
 }
 
+RefCntAutoPtr<IShader> DearchiverVkImpl::UnpackShader(const ShaderCreateInfo& ShaderCI,
+                                                      const SerializedData&   ShaderReflection,
+                                                      IRenderDevice*          pDevice)
+{
+    if (!ShaderReflection || (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) != 0)
+        return TDearchiverBase::UnpackShader(ShaderCI, ShaderReflection, pDevice);
+
+    // Use the stored reflection to avoid parsing the SPIR-V
+    RefCntAutoPtr<IShader> pShader;
+    ClassPtrCast<RenderDeviceVkImpl>(pDevice)->CreateShader(ShaderCI, ShaderReflection, &pShader);
+    return pShader;
+}
+
 } // namespace Diligent
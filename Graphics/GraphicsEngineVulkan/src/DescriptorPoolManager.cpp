@@ -197,6 +197,9 @@ DescriptorSetAllocator::~DescriptorSetAllocator()
 
 DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    MetricTimerScope MetricScope{m_DeviceVkImpl.GetMetric(DEVICE_METRIC_DESCRIPTOR_ALLOCATION)};
+    m_DeviceVkImpl.OnDescriptorsAllocated(1);
+
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
     std::lock_guard<std::mutex> Lock{m_Mutex};
@@ -289,6 +292,8 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
 
 VkDescriptorSet DynamicDescriptorSetAllocator::Allocate(VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    MetricTimerScope MetricScope{m_GlobalPoolMgr.GetDeviceVkImpl().GetMetric(DEVICE_METRIC_DESCRIPTOR_ALLOCATION)};
+
     VkDescriptorSet set           = VK_NULL_HANDLE;
     const auto&     LogicalDevice = m_GlobalPoolMgr.GetDeviceVkImpl().GetLogicalDevice();
     if (!m_AllocatedPools.empty())
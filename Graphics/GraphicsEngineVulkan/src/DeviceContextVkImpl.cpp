@@ -31,6 +31,8 @@
 
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <functional>
 
 #include "RenderDeviceVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
@@ -92,7 +94,8 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*       pRefCounters,
     {
         pDeviceVkImpl->GetDynamicMemoryManager(),
         GetContextObjectName("Dynamic heap", Desc.IsDeferred, Desc.ContextId),
-        EngineCI.DynamicHeapPageSize
+        EngineCI.DynamicHeapPageSize,
+        EngineCI.AdaptiveDynamicHeapPageSize != False
     },
     m_DynamicDescrSetAllocator
     {
@@ -101,10 +104,14 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*       pRefCounters,
     }
 // clang-format on
 {
+    m_CommandBuffer.SetBarrierCounter(&m_Statistics.BarrierCount);
+
     if (!IsDeferred())
     {
         PrepareCommandPool(GetCommandQueueId());
         m_pQueryMgr = &pDeviceVkImpl->GetQueryMgr(GetCommandQueueId());
+        if (EngineCI.EnableGPUBreadcrumbs && GPUBreadcrumbsVk::IsSupported(*pDeviceVkImpl))
+            m_pBreadcrumbs = std::make_unique<GPUBreadcrumbsVk>(*pDeviceVkImpl, Desc.Name);
         EnsureVkCmdBuffer();
         m_State.NumCommands += m_pQueryMgr->ResetStaleQueries(m_pDevice->GetLogicalDevice(), m_CommandBuffer);
     }
@@ -168,6 +175,10 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
     if (m_QueueFamilyCmdPools)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_QueueFamilyCmdPools), ~Uint64{0});
 
+    // The breadcrumbs buffer may still be written by the GPU
+    if (m_pBreadcrumbs)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_pBreadcrumbs), ~Uint64{0});
+
     // NB: Upload heap, dynamic heap and dynamic descriptor manager return their resources to
     //     global managers and do not need to wait for GPU to idle.
 }
@@ -212,7 +223,7 @@ void DeviceContextVkImpl::Begin(Uint32 ImmediateContextId)
     m_pQueryMgr = &m_pDevice->GetQueryMgr(CommandQueueId);
 }
 
-void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, bool IsSecondary)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     VERIFY_EXPR(m_CmdPool != nullptr);
@@ -221,9 +232,11 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
     public:
         // clang-format off
         CmdBufferRecycler(VkCommandBuffer                           _vkCmdBuff,
-                         VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
-            vkCmdBuff {_vkCmdBuff},
-            Pool      {&_Pool    }
+                         VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                         bool                                      _IsSecondary) noexcept :
+            vkCmdBuff   {_vkCmdBuff  },
+            Pool        {&_Pool      },
+            IsSecondary {_IsSecondary}
         {
             VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         }
@@ -233,8 +246,9 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         CmdBufferRecycler& operator = (      CmdBufferRecycler&&) = delete;
 
         CmdBufferRecycler(CmdBufferRecycler&& rhs) noexcept :
-            vkCmdBuff {rhs.vkCmdBuff},
-            Pool      {rhs.Pool     }
+            vkCmdBuff   {rhs.vkCmdBuff  },
+            Pool        {rhs.Pool       },
+            IsSecondary {rhs.IsSecondary}
         {
             rhs.vkCmdBuff = VK_NULL_HANDLE;
             rhs.Pool      = nullptr;
@@ -245,19 +259,20 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         {
             if (Pool != nullptr)
             {
-                Pool->RecycleCommandBuffer(std::move(vkCmdBuff));
+                Pool->RecycleCommandBuffer(std::move(vkCmdBuff), IsSecondary);
             }
         }
 
     private:
-        VkCommandBuffer                           vkCmdBuff = VK_NULL_HANDLE;
-        VulkanUtilities::VulkanCommandBufferPool* Pool      = nullptr;
+        VkCommandBuffer                           vkCmdBuff   = VK_NULL_HANDLE;
+        VulkanUtilities::VulkanCommandBufferPool* Pool        = nullptr;
+        bool                                      IsSecondary = false;
     };
 
     // Discard command buffer directly to the release queue since we know exactly which queue it was submitted to
     // as well as the associated FenceValue.
     auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
-    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool}, FenceValue);
+    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool, IsSecondary}, FenceValue);
 }
 
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
@@ -269,15 +284,30 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQ
         DisposeVkCmdBuffer(CmdQueue, vkCmdBuff, FenceValue);
         m_CommandBuffer.Reset();
     }
+
+    if (!m_PendingSplitBarriers.empty())
+    {
+        LOG_WARNING_MESSAGE(m_PendingSplitBarriers.size(), " split barrier(s) have been begun, but not ended before the command buffer was submitted.");
+        m_PendingSplitBarriers.clear();
+    }
+
+    if (!m_SplitBarrierEvents.empty())
+    {
+        auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
+        for (auto& Event : m_SplitBarrierEvents)
+            ReleaseQueue.DiscardResource(std::move(Event), FenceValue);
+        m_SplitBarrierEvents.clear();
+    }
 }
 
 
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    if (IsRedundantPipelineState(pPipelineState))
+        return;
+
     RefCntAutoPtr<PipelineStateVkImpl> pPipelineStateVk{pPipelineState, PipelineStateVkImpl::IID_InternalImpl};
     VERIFY(pPipelineState == nullptr || pPipelineStateVk != nullptr, "Unknown pipeline state object implementation");
-    if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
-        return;
 
     const auto& PSODesc = pPipelineStateVk->GetDesc();
 
@@ -308,7 +338,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 
     auto vkPipeline = m_pPipelineState->GetVkPipeline();
 
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the switch below to handle the new pipeline type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the switch below to handle the new pipeline type");
     switch (PSODesc.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -328,6 +358,12 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             {
                 CommitScissorRects();
             }
+
+            if (GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+            {
+                // Dynamic states are undefined after a pipeline that does not use them has been bound
+                CommitDynamicPipelineStates(GraphicsPipeline);
+            }
             m_State.vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
             break;
         }
@@ -344,6 +380,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             break;
         }
         case PIPELINE_TYPE_TILE:
+        case PIPELINE_TYPE_WORK_GRAPH:
             UNEXPECTED("Unsupported pipeline type");
             break;
         default:
@@ -380,13 +417,17 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 
         VERIFY_EXPR(BindInfo.ActiveSRBMask & (1u << i));
 
-        SetInfo.BaseInd            = Layout.GetFirstDescrSetIndex(pSignature->GetDesc().BindingIndex);
-        SetInfo.DynamicOffsetCount = pSignature->GetDynamicOffsetCount();
+        SetInfo.BaseInd             = Layout.GetFirstDescrSetIndex(pSignature->GetDesc().BindingIndex);
+        SetInfo.DynamicOffsetCount  = pSignature->GetDynamicOffsetCount();
+        SetInfo.DynamicOffsetsStart = TotalDynamicOffsetCount;
         TotalDynamicOffsetCount += SetInfo.DynamicOffsetCount;
     }
 
     // Reserve space to store all dynamic buffer offsets
     m_DynamicBufferOffsets.resize(TotalDynamicOffsetCount);
+    BindInfo.BoundDynamicOffsets.resize(TotalDynamicOffsetCount);
+    // Offset locations may have changed, so the sets must be bound again
+    BindInfo.BoundDynamicOffsetsMask = 0;
 }
 
 DeviceContextVkImpl::ResourceBindInfo& DeviceContextVkImpl::GetBindInfo(PIPELINE_TYPE Type)
@@ -399,6 +440,7 @@ DeviceContextVkImpl::ResourceBindInfo& DeviceContextVkImpl::GetBindInfo(PIPELINE
     static_assert(PIPELINE_TYPE_MESH        == 2, "PIPELINE_TYPE_MESH == 2 is expected");
     static_assert(PIPELINE_TYPE_RAY_TRACING == 3, "PIPELINE_TYPE_RAY_TRACING == 3 is expected");
     static_assert(PIPELINE_TYPE_TILE        == 4, "PIPELINE_TYPE_TILE == 4 is expected");
+    static_assert(PIPELINE_TYPE_WORK_GRAPH  == 5, "PIPELINE_TYPE_WORK_GRAPH == 5 is expected");
     // clang-format on
     constexpr size_t Indices[] = {
         0, // PIPELINE_TYPE_GRAPHICS
@@ -406,6 +448,7 @@ DeviceContextVkImpl::ResourceBindInfo& DeviceContextVkImpl::GetBindInfo(PIPELINE
         0, // PIPELINE_TYPE_MESH
         2, // PIPELINE_TYPE_RAY_TRACING
         0, // PIPELINE_TYPE_TILE
+        1, // PIPELINE_TYPE_WORK_GRAPH
     };
     static_assert(_countof(Indices) == Uint32{PIPELINE_TYPE_LAST} + 1, "Please add the new pipeline type to the list above");
 
@@ -420,6 +463,10 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
     const auto LastSign  = PlatformMisc::GetMSB(CommitSRBMask);
     VERIFY_EXPR(LastSign < m_pPipelineState->GetResourceSignatureCount());
 
+    // Descriptor sets of the SRBs that are not stale are the same as in the last BindDescriptorSets call.
+    // If none of the SRBs is stale and dynamic buffer offsets have not changed either, nothing needs to be bound.
+    bool BindRequired = (CommitSRBMask & BindInfo.StaleSRBMask) != 0;
+
     // Bind all descriptor sets in a single BindDescriptorSets call
     uint32_t   DynamicOffsetCount = 0;
     uint32_t   TotalSetCount      = 0;
@@ -455,6 +502,18 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
 
             auto NumOffsetsWritten = pResourceCache->GetDynamicBufferOffsets(GetContextId(), m_DynamicBufferOffsets, DynamicOffsetCount);
             VERIFY_EXPR(NumOffsetsWritten == SetInfo.DynamicOffsetCount);
+
+            VERIFY_EXPR(BindInfo.BoundDynamicOffsets.size() >= size_t{SetInfo.DynamicOffsetsStart} + size_t{SetInfo.DynamicOffsetCount});
+            const auto  OffsetsSize   = sizeof(Uint32) * SetInfo.DynamicOffsetCount;
+            const auto* pOffsets      = &m_DynamicBufferOffsets[DynamicOffsetCount];
+            auto*       pBoundOffsets = &BindInfo.BoundDynamicOffsets[SetInfo.DynamicOffsetsStart];
+            const auto  SignBit       = static_cast<ResourceBindInfo::SRBMaskType>(1u << sign);
+            if ((BindInfo.BoundDynamicOffsetsMask & SignBit) == 0 || memcmp(pBoundOffsets, pOffsets, OffsetsSize) != 0)
+            {
+                memcpy(pBoundOffsets, pOffsets, OffsetsSize);
+                BindInfo.BoundDynamicOffsetsMask |= SignBit;
+                BindRequired = true;
+            }
             DynamicOffsetCount += SetInfo.DynamicOffsetCount;
         }
 
@@ -472,8 +531,11 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
     // applied via these sets are no longer valid.
     // https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkCmdBindDescriptorSets.html
     VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
-    m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, FirstSetToBind, TotalSetCount,
-                                       m_DescriptorSets.data(), DynamicOffsetCount, m_DynamicBufferOffsets.data());
+    if (BindRequired)
+    {
+        m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, FirstSetToBind, TotalSetCount,
+                                           m_DescriptorSets.data(), DynamicOffsetCount, m_DynamicBufferOffsets.data());
+    }
 
     BindInfo.StaleSRBMask &= ~BindInfo.ActiveSRBMask;
 }
@@ -527,8 +589,60 @@ void DeviceContextVkImpl::TransitionShaderResources(IPipelineState*, IShaderReso
     ResourceCache.TransitionResources<false>(this);
 }
 
+VkDescriptorSet DeviceContextVkImpl::GetDynamicDescriptorSet(const PipelineResourceSignatureVkImpl& Signature,
+                                                             const ShaderResourceCacheVk&           ResourceCache,
+                                                             Uint32                                 DynamicSetIndex)
+{
+    auto& Key = m_DynamicDescrSetLookupKey;
+
+    Key.SignatureId = Signature.GetUniqueID();
+    Key.Resources.clear();
+    Key.Hash = 0;
+    HashCombine(Key.Hash, Key.SignatureId);
+
+    // Unique IDs are never reused, so unlike object pointers they can't match a resource
+    // that was released and replaced by another object at the same address.
+    const auto& DescrSet = ResourceCache.GetDescriptorSet(DynamicSetIndex);
+    for (Uint32 i = 0; i < DescrSet.GetSize(); ++i)
+    {
+        const auto&  Res   = DescrSet.GetResource(i);
+        const Uint64 ResId = Res.pObject ? static_cast<Uint32>(Res.pObject->GetUniqueID()) : 0;
+        Key.Resources.push_back(ResId);
+        Key.Resources.push_back(Res.BufferBaseOffset);
+        Key.Resources.push_back(Res.BufferRangeSize);
+        HashCombine(Key.Hash, ResId, Res.BufferBaseOffset, Res.BufferRangeSize);
+    }
+
+    auto it = m_DynamicDescrSetsByContent.find(Key);
+    if (it != m_DynamicDescrSetsByContent.end())
+        return it->second;
+
+    const auto vkLayout = Signature.GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC);
+
+    const char* DynamicDescrSetName = "Dynamic Descriptor Set";
+#ifdef DILIGENT_DEVELOPMENT
+    String _DynamicDescrSetName{DynamicDescrSetName};
+    _DynamicDescrSetName.append(" (");
+    _DynamicDescrSetName.append(Signature.GetDesc().Name);
+    _DynamicDescrSetName += ')';
+    DynamicDescrSetName = _DynamicDescrSetName.c_str();
+#endif
+    // Allocate vulkan descriptor set for dynamic resources
+    VkDescriptorSet vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
+
+    // Write all dynamic resource descriptors
+    Signature.CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+
+    m_DynamicDescrSetsByContent.emplace(Key, vkDynamicDescrSet);
+
+    return vkDynamicDescrSet;
+}
+
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    MetricTimerScope         MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_COMMIT_SHADER_RESOURCES)};
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
     TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingVkImpl = ClassPtrCast<ShaderResourceBindingVkImpl>(pShaderResourceBinding);
@@ -579,24 +693,17 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
         VERIFY_EXPR(DSIndex == pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC>());
         VERIFY_EXPR(const_cast<const ShaderResourceCacheVk&>(ResourceCache).GetDescriptorSet(DSIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
 
-        const auto vkLayout = pSignature->GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC);
-
-        VkDescriptorSet vkDynamicDescrSet   = VK_NULL_HANDLE;
-        const char*     DynamicDescrSetName = "Dynamic Descriptor Set";
-#ifdef DILIGENT_DEVELOPMENT
-        String _DynamicDescrSetName{DynamicDescrSetName};
-        _DynamicDescrSetName.append(" (");
-        _DynamicDescrSetName.append(pSignature->GetDesc().Name);
-        _DynamicDescrSetName += ')';
-        DynamicDescrSetName = _DynamicDescrSetName.c_str();
-#endif
-        // Allocate vulkan descriptor set for dynamic resources
-        vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
-
-        // Write all dynamic resource descriptors
-        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+        // Descriptor sets are never updated after they have been written, so the set that was written
+        // for the same dynamic resources earlier in this frame can be bound again.
+        const auto DynamicSetRevision = ResourceCache.GetDynamicSetRevision();
+        auto&      CachedDynamicSet   = m_DynamicDescrSetCache[pResBindingVkImpl->GetUniqueID()];
+        if (CachedDynamicSet.vkSet == VK_NULL_HANDLE || CachedDynamicSet.Revision != DynamicSetRevision)
+        {
+            CachedDynamicSet.vkSet    = GetDynamicDescriptorSet(*pSignature, ResourceCache, DSIndex);
+            CachedDynamicSet.Revision = DynamicSetRevision;
+        }
 
-        SetInfo.vkSets[DSIndex] = vkDynamicDescrSet;
+        SetInfo.vkSets[DSIndex] = CachedDynamicSet.vkSet;
         ++DSIndex;
     }
 
@@ -718,6 +825,8 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
 
 void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
@@ -815,7 +924,9 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
     if (Attribs.NumVertices > 0 && Attribs.NumInstances > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("Draw");
         m_CommandBuffer.Draw(Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+        EndBreadcrumb(Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -828,7 +939,9 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
     if (Attribs.NumIndices > 0 && Attribs.NumInstances > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DrawIndexed");
         m_CommandBuffer.DrawIndexed(Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+        EndBreadcrumb(Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -848,6 +961,7 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
     if (Attribs.DrawCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DrawIndirect");
         if (Attribs.pCounterBuffer == nullptr)
         {
             m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(),
@@ -863,6 +977,7 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
                                               Attribs.DrawCount,
                                               Attribs.DrawArgsStride);
         }
+        EndBreadcrumb(Breadcrumb);
     }
 
     ++m_State.NumCommands;
@@ -883,6 +998,7 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
     if (Attribs.DrawCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DrawIndexedIndirect");
         if (Attribs.pCounterBuffer == nullptr)
         {
             m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(),
@@ -898,6 +1014,7 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
                                                      Attribs.DrawCount,
                                                      Attribs.DrawArgsStride);
         }
+        EndBreadcrumb(Breadcrumb);
     }
 
     ++m_State.NumCommands;
@@ -911,7 +1028,9 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
     if (Attribs.ThreadGroupCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DrawMesh");
         m_CommandBuffer.DrawMesh(Attribs.ThreadGroupCount, 0);
+        EndBreadcrumb(Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -931,6 +1050,7 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
     if (Attribs.CommandCount > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DrawMeshIndirect");
         if (Attribs.pCounterBuffer == nullptr)
         {
             m_CommandBuffer.DrawMeshIndirect(pIndirectDrawAttribsVk->GetVkBuffer(),
@@ -947,6 +1067,7 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
                                                   Attribs.CommandCount,
                                                   DrawMeshIndirectCommandStride);
         }
+        EndBreadcrumb(Breadcrumb);
     }
 
     ++m_State.NumCommands;
@@ -954,6 +1075,8 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
 void DeviceContextVkImpl::PrepareForDispatchCompute()
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
@@ -996,7 +1119,9 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
     if (Attribs.ThreadGroupCountX > 0 && Attribs.ThreadGroupCountY > 0 && Attribs.ThreadGroupCountZ > 0)
     {
+        const Uint32 Breadcrumb = BeginBreadcrumb("DispatchCompute");
         m_CommandBuffer.Dispatch(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
+        EndBreadcrumb(Breadcrumb);
         ++m_State.NumCommands;
     }
 }
@@ -1018,7 +1143,9 @@ void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
     TransitionOrVerifyBufferState(*pBufferVk, Attribs.AttribsBufferStateTransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT,
                                   VK_ACCESS_INDIRECT_COMMAND_READ_BIT, "Indirect dispatch (DeviceContextVkImpl::DispatchCompute)");
 
+    const Uint32 Breadcrumb = BeginBreadcrumb("DispatchComputeIndirect");
     m_CommandBuffer.DispatchIndirect(pBufferVk->GetVkBuffer(), pBufferVk->GetDynamicOffset(GetContextId(), this) + Attribs.DispatchArgsByteOffset);
+    EndBreadcrumb(Breadcrumb);
     ++m_State.NumCommands;
 }
 
@@ -1241,6 +1368,8 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
 
 void DeviceContextVkImpl::FinishFrame()
 {
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
 #ifdef DILIGENT_DEBUG
     for (const auto& MappedBuffIt : m_DbgMappedBuffers)
     {
@@ -1302,10 +1431,26 @@ void DeviceContextVkImpl::FinishFrame()
     // Note: as global pool manager is hosted by the render device, the allocator can
     // be destroyed before the pools are actually returned to the global pool manager.
     m_DynamicDescrSetAllocator.ReleasePools(QueueMask);
+    m_DynamicDescrSetCache.clear();
+    m_DynamicDescrSetsByContent.clear();
 
     EndFrame();
 }
 
+void DeviceContextVkImpl::CheckDeviceLost()
+{
+    if (!m_pBreadcrumbs || m_DeviceLostReported)
+        return;
+
+    auto* pQueueVk = ClassPtrCast<CommandQueueVkImpl>(LockCommandQueue());
+    if (pQueueVk->IsDeviceLost())
+    {
+        m_pBreadcrumbs->LogDeviceLost(pQueueVk->GetVkQueue());
+        m_DeviceLostReported = true;
+    }
+    UnlockCommandQueue();
+}
+
 void DeviceContextVkImpl::Flush()
 {
     Flush(0, nullptr);
@@ -1320,14 +1465,21 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
                   "Flushing device context that has ", m_ActiveQueriesCounter,
                   " active queries. Vulkan requires that queries are begun and ended in the same command buffer.");
 
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(),
+                  "Flushing device context with active conditional rendering. Vulkan requires that conditional rendering is begun and ended in the same command buffer.");
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
                   "Flushing device context inside an active render pass.");
 
-    // TODO: replace with small_vector
-    std::vector<VkCommandBuffer>               vkCmdBuffs;
-    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs;
-    vkCmdBuffs.reserve(size_t{NumCommandLists} + 1);
-    DeferredCtxs.reserve(size_t{NumCommandLists} + 1);
+    MemoryAllocationTagScope TagScope{MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT};
+
+    // Temporary arrays are allocated from the scratch arena that keeps its pages between the frames
+    DynamicLinearAllocatorScope ScratchScope{m_ScratchAllocator};
+
+    VkCommandBuffer* vkCmdBuffs    = m_ScratchAllocator.Allocate<VkCommandBuffer>(size_t{NumCommandLists} + 1);
+    Uint32           NumVkCmdBuffs = 0;
+    // Deferred contexts are released explicitly after the command buffers have been disposed
+    auto* DeferredCtxs = m_ScratchAllocator.ConstructArray<RefCntAutoPtr<IDeviceContext>>(NumCommandLists);
 
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
@@ -1355,7 +1507,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
             m_CommandBuffer.FlushBarriers();
             m_CommandBuffer.EndCommandBuffer();
 
-            vkCmdBuffs.push_back(vkCmdBuff);
+            vkCmdBuffs[NumVkCmdBuffs++] = vkCmdBuff;
         }
     }
 
@@ -1365,12 +1517,13 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
         DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
         DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
-        DeferredCtxs.emplace_back();
-        vkCmdBuffs.emplace_back();
-        pCmdListVk->Close(DeferredCtxs.back(), vkCmdBuffs.back());
-        VERIFY(vkCmdBuffs.back() != VK_NULL_HANDLE, "Trying to execute empty command buffer");
-        VERIFY_EXPR(DeferredCtxs.back() != nullptr);
+        DEV_CHECK_ERR(!pCmdListVk->IsSecondary(), "Secondary command lists can only be executed inside a render pass.");
+        auto& vkCmdListBuff = vkCmdBuffs[NumVkCmdBuffs++];
+        pCmdListVk->Close(DeferredCtxs[i], vkCmdListBuff);
+        VERIFY(vkCmdListBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(DeferredCtxs[i] != nullptr);
     }
+    m_Statistics.CommandBufferCount += NumVkCmdBuffs;
 
     VERIFY_EXPR(m_VkWaitSemaphores.size() == m_WaitManagedSemaphores.size() + m_WaitRecycledSemaphores.size());
     VERIFY_EXPR(m_VkSignalSemaphores.size() == m_SignalManagedSemaphores.size());
@@ -1431,8 +1584,8 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     VkSubmitInfo SubmitInfo{};
     SubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     SubmitInfo.pNext                = nullptr;
-    SubmitInfo.commandBufferCount   = static_cast<uint32_t>(vkCmdBuffs.size());
-    SubmitInfo.pCommandBuffers      = vkCmdBuffs.data();
+    SubmitInfo.commandBufferCount   = NumVkCmdBuffs;
+    SubmitInfo.pCommandBuffers      = vkCmdBuffs;
     SubmitInfo.waitSemaphoreCount   = static_cast<uint32_t>(m_VkWaitSemaphores.size());
     SubmitInfo.pWaitSemaphores      = SubmitInfo.waitSemaphoreCount != 0 ? m_VkWaitSemaphores.data() : nullptr;
     SubmitInfo.pWaitDstStageMask    = SubmitInfo.waitSemaphoreCount != 0 ? m_WaitDstStageMasks.data() : nullptr;
@@ -1454,6 +1607,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
 
     // Submit command buffer even if there are no commands to release stale resources.
     auto SubmittedFenceValue = m_pDevice->ExecuteCommandBuffer(GetCommandQueueId(), SubmitInfo, &m_SignalFences);
+    CheckDeviceLost();
 
     // Recycle semaphores
     {
@@ -1492,8 +1646,18 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         // It is OK to dispose command buffer from another thread. We are not going to
         // record any commands and only need to add the buffer to the queue
         pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), std::move(vkCmdBuffs[buff_idx]), SubmittedFenceValue);
+        DeferredCtxs[i].~RefCntAutoPtr<IDeviceContext>();
     }
-    VERIFY_EXPR(buff_idx == vkCmdBuffs.size());
+    VERIFY_EXPR(buff_idx == NumVkCmdBuffs);
+
+    // Secondary command buffers executed by the submitted primary command buffer
+    for (auto& CtxAndCmdBuff : m_PendingSecondaryCmdBuffers)
+    {
+        auto pDeferredCtxVkImpl = CtxAndCmdBuff.first.RawPtr<DeviceContextVkImpl>();
+        pDeferredCtxVkImpl->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+        pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), CtxAndCmdBuff.second, SubmittedFenceValue, /*IsSecondary = */ true);
+    }
+    m_PendingSecondaryCmdBuffers.clear();
 
     m_State    = {};
     m_BindInfo = {};
@@ -1510,6 +1674,9 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsRedundantVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags))
+        return;
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
@@ -1540,6 +1707,9 @@ void DeviceContextVkImpl::InvalidateState()
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsRedundantIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode))
+        return;
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     if (m_pIndexBuffer)
     {
@@ -1649,7 +1819,7 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
     {
         auto* pDepthBufferVk = m_pBoundDepthStencil->GetTexture<TextureVkImpl>();
         TransitionOrVerifyTextureState(*pDepthBufferVk, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                                       "Binding depth-stencil buffer (DeviceContextVkImpl::TransitionRenderTargets)");
+                                       "Binding depth-stencil buffer (DeviceContextVkImpl::TransitionRenderTargets)", m_pBoundDepthStencil);
     }
 
     for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
@@ -1658,7 +1828,7 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
         {
             auto* pRenderTargetVk = pRTVVk->GetTexture<TextureVkImpl>();
             TransitionOrVerifyTextureState(*pRenderTargetVk, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                                           "Binding render targets (DeviceContextVkImpl::TransitionRenderTargets)");
+                                           "Binding render targets (DeviceContextVkImpl::TransitionRenderTargets)", pRTVVk);
         }
     }
 
@@ -1749,15 +1919,12 @@ void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
         RenderPassKey.EnableVRS = false;
     }
 
-    auto& FBCache = m_pDevice->GetFramebufferCache();
-    auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
-
-    if (auto* pRenderPass = RPCache.GetRenderPass(RenderPassKey))
+    if (auto* pRenderPass = GetImplicitRenderPass(RenderPassKey))
     {
         m_vkRenderPass         = pRenderPass->GetVkRenderPass();
         FBKey.Pass             = m_vkRenderPass;
         FBKey.CommandQueueMask = ~Uint64{0};
-        m_vkFramebuffer        = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+        m_vkFramebuffer        = GetImplicitFramebuffer(FBKey);
     }
     else
     {
@@ -1767,6 +1934,57 @@ void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
     }
 }
 
+RenderPassVkImpl* DeviceContextVkImpl::GetImplicitRenderPass(const RenderPassCache::RenderPassCacheKey& Key)
+{
+    for (const auto& Entry : m_LocalRenderPassCache)
+    {
+        if (Entry.pRenderPass != nullptr && Entry.Key == Key)
+            return Entry.pRenderPass;
+    }
+
+    auto* pRenderPass = m_pDevice->GetImplicitRenderPassCache().GetRenderPass(Key);
+    if (pRenderPass != nullptr)
+    {
+        auto& Entry       = m_LocalRenderPassCache[m_NextLocalRenderPassCacheEntry];
+        Entry.Key         = Key;
+        Entry.pRenderPass = pRenderPass;
+
+        m_NextLocalRenderPassCacheEntry = (m_NextLocalRenderPassCacheEntry + 1) % LocalRenderPassCacheSize;
+    }
+    return pRenderPass;
+}
+
+VkFramebuffer DeviceContextVkImpl::GetImplicitFramebuffer(const FramebufferCache::FramebufferCacheKey& Key)
+{
+    auto& FBCache = m_pDevice->GetFramebufferCache();
+
+    const auto FBCacheVersion = FBCache.GetVersion();
+    if (FBCacheVersion != m_LocalFramebufferCacheVersion)
+    {
+        // Some framebuffers have been destroyed, and their handles may have been reused
+        for (auto& Entry : m_LocalFramebufferCache)
+            Entry.vkFramebuffer = VK_NULL_HANDLE;
+        m_LocalFramebufferCacheVersion = FBCacheVersion;
+    }
+
+    for (const auto& Entry : m_LocalFramebufferCache)
+    {
+        if (Entry.vkFramebuffer != VK_NULL_HANDLE && Entry.Key == Key)
+            return Entry.vkFramebuffer;
+    }
+
+    auto vkFramebuffer = FBCache.GetFramebuffer(Key, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+    if (vkFramebuffer != VK_NULL_HANDLE)
+    {
+        auto& Entry         = m_LocalFramebufferCache[m_NextLocalFramebufferCacheEntry];
+        Entry.Key           = Key;
+        Entry.vkFramebuffer = vkFramebuffer;
+
+        m_NextLocalFramebufferCacheEntry = (m_NextLocalFramebufferCacheEntry + 1) % LocalRenderPassCacheSize;
+    }
+    return vkFramebuffer;
+}
+
 void DeviceContextVkImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
@@ -1793,11 +2011,14 @@ void DeviceContextVkImpl::ResetRenderTargets()
     m_vkFramebuffer = VK_NULL_HANDLE;
     if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
         m_CommandBuffer.EndRenderPass();
-    m_State.ShadingRateIsSet = false;
+    m_State.ShadingRateIsSet         = false;
+    m_State.SecondaryCmdListsSubpass = false;
 }
 
 void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    DEV_CHECK_ERR(!m_IsRecordingSecondaryCmdList, "Render pass commands are not allowed while recording a secondary command list.");
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     VERIFY_EXPR(m_pActiveRenderPass != nullptr);
@@ -1837,23 +2058,39 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
     }
 
     EnsureVkCmdBuffer();
-    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues);
+    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues,
+                                    m_SecondaryCmdListsEnabled ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    m_State.SecondaryCmdListsSubpass = m_SecondaryCmdListsEnabled;
 
     // Set the viewport to match the framebuffer size
-    SetViewports(1, nullptr, 0, 0);
+    if (m_State.SecondaryCmdListsSubpass)
+    {
+        // No commands can be recorded inline in the subpass, so only update the viewport state.
+        // The viewport is committed when a pipeline is bound after the secondary command lists are executed.
+        TDeviceContextBase::SetViewports(1, nullptr, 0, 0);
+    }
+    else
+    {
+        SetViewports(1, nullptr, 0, 0);
+    }
 
     m_State.ShadingRateIsSet = false;
 }
 
 void DeviceContextVkImpl::NextSubpass()
 {
+    DEV_CHECK_ERR(!m_IsRecordingSecondaryCmdList, "Render pass commands are not allowed while recording a secondary command list.");
+
     TDeviceContextBase::NextSubpass();
     VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
-    m_CommandBuffer.NextSubpass();
+    m_CommandBuffer.NextSubpass(m_SecondaryCmdListsEnabled ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    m_State.SecondaryCmdListsSubpass = m_SecondaryCmdListsEnabled;
 }
 
 void DeviceContextVkImpl::EndRenderPass()
 {
+    DEV_CHECK_ERR(!m_IsRecordingSecondaryCmdList, "Render pass commands are not allowed while recording a secondary command list.");
+
     TDeviceContextBase::EndRenderPass();
     // TDeviceContextBase::EndRenderPass calls ResetRenderTargets() that in turn
     // calls m_CommandBuffer.EndRenderPass()
@@ -1877,7 +2114,8 @@ void DeviceContextVkImpl::UpdateBufferRegion(BufferVkImpl*                  pBuf
     CopyRegion.dstOffset = DstOffset;
     CopyRegion.size      = NumBytes;
     VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
-    m_CommandBuffer.CopyBuffer(vkSrcBuffer, pBuffVk->GetVkBuffer(), 1, &CopyRegion);
+    // Consecutive updates of the same buffer from the same upload page are merged into one vkCmdCopyBuffer
+    m_CommandBuffer.AppendBufferCopy(vkSrcBuffer, pBuffVk->GetVkBuffer(), CopyRegion);
     ++m_State.NumCommands;
 }
 
@@ -1935,6 +2173,8 @@ void DeviceContextVkImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextVkImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_MAP_BUFFER)};
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* const pBufferVk = ClassPtrCast<BufferVkImpl>(pBuffer);
     const auto& BuffDesc  = pBufferVk->GetDesc();
@@ -2559,6 +2799,20 @@ void DeviceContextVkImpl::UnmapTextureSubresource(ITexture* pTexture,
 void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(), "Finishing command list with active conditional rendering.");
+
+    const bool IsSecondary = m_IsRecordingSecondaryCmdList;
+    if (IsSecondary)
+    {
+        // The render pass is continued from the primary command buffer and is ended there
+        m_CommandBuffer.ResetRenderPassContinuation();
+        m_pActiveRenderPass.Release();
+        m_pBoundFramebuffer.Release();
+        m_SubpassIndex = 0;
+        ResetRenderTargets();
+        m_IsRecordingSecondaryCmdList = false;
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
     if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
@@ -2566,12 +2820,15 @@ void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
         m_CommandBuffer.EndRenderPass();
     }
 
+    m_CommandBuffer.FlushBarriers();
+
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     auto err       = vkEndCommandBuffer(vkCmdBuff);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
     (void)err;
+    ++m_Statistics.CommandBufferCount;
 
-    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff)};
+    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff, IsSecondary)};
     pCmdListVk->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
     m_CommandBuffer.Reset();
@@ -2593,11 +2850,236 @@ void DeviceContextVkImpl::ExecuteCommandLists(Uint32               NumCommandLis
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
+    if (m_pActiveRenderPass != nullptr)
+    {
+        ExecuteSecondaryCommandLists(NumCommandLists, ppCommandLists);
+        return;
+    }
+
     Flush(NumCommandLists, ppCommandLists);
 
     InvalidateState();
 }
 
+void DeviceContextVkImpl::ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                                       ICommandList* const* ppCommandLists)
+{
+    DEV_CHECK_ERR(m_State.SecondaryCmdListsSubpass,
+                  "Command lists can only be executed inside a render pass in a subpass that has been begun while "
+                  "secondary command lists were enabled. Call IDeviceContextVk::EnableSecondaryCommandLists(true) before "
+                  "beginning the render pass or the subpass.");
+    VERIFY_EXPR(m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
+
+    m_vkSecondaryCmdBuffers.clear();
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
+        DEV_CHECK_ERR(pCmdListVk->IsSecondary(), "Only secondary command lists can be executed inside a render pass. Use IDeviceContextVk::BeginSecondaryCommandList() to record them.");
+
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        VkCommandBuffer               vkCmdBuff = VK_NULL_HANDLE;
+        pCmdListVk->Close(pDeferredCtx, vkCmdBuff);
+        VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(pDeferredCtx != nullptr);
+
+        m_vkSecondaryCmdBuffers.push_back(vkCmdBuff);
+        // Secondary command buffers can only be recycled after the primary command buffer is submitted and executed
+        m_PendingSecondaryCmdBuffers.emplace_back(std::move(pDeferredCtx), vkCmdBuff);
+    }
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.ExecuteCommands(static_cast<uint32_t>(m_vkSecondaryCmdBuffers.size()), m_vkSecondaryCmdBuffers.data());
+    ++m_State.NumCommands;
+
+    // The state bound in the primary command buffer is undefined after vkCmdExecuteCommands,
+    // so the pipeline, resources, and vertex and index buffers must be committed again.
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+    m_State.ShadingRateIsSet     = false;
+    m_BindInfo                   = {};
+    m_pPipelineState             = nullptr;
+}
+
+void DeviceContextVkImpl::BeginSecondaryCommandList(Uint32        ImmediateContextId,
+                                                    IRenderPass*  pRenderPass,
+                                                    Uint32        SubpassIndex,
+                                                    IFramebuffer* pFramebuffer)
+{
+    DEV_CHECK_ERR(pRenderPass != nullptr, "pRenderPass must not be null");
+    DEV_CHECK_ERR(pFramebuffer != nullptr, "pFramebuffer must not be null");
+    DEV_CHECK_ERR(SubpassIndex < pRenderPass->GetDesc().SubpassCount, "Subpass index (", SubpassIndex, ") exceeds the number of subpasses (",
+                  pRenderPass->GetDesc().SubpassCount, ") in render pass '", pRenderPass->GetDesc().Name, "'");
+
+    Begin(ImmediateContextId);
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "BeginSecondaryCommandList");
+
+    // Make the subpass current as if the render pass had been begun in this context.
+    // Attachment states are managed by the immediate context that begins the render pass.
+    m_pActiveRenderPass = ClassPtrCast<RenderPassVkImpl>(pRenderPass);
+    m_pBoundFramebuffer = ClassPtrCast<FramebufferVkImpl>(pFramebuffer);
+    m_SubpassIndex      = SubpassIndex;
+    SetSubpassRenderTargets();
+
+    m_vkRenderPass  = m_pActiveRenderPass->GetVkRenderPass();
+    m_vkFramebuffer = m_pBoundFramebuffer->GetVkFramebuffer();
+
+    VkCommandBufferInheritanceInfo InheritanceInfo{};
+    InheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    InheritanceInfo.pNext                = nullptr;
+    InheritanceInfo.renderPass           = m_vkRenderPass;
+    InheritanceInfo.subpass              = SubpassIndex;
+    InheritanceInfo.framebuffer          = m_vkFramebuffer;
+    InheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    InheritanceInfo.queryFlags           = 0;
+    InheritanceInfo.pipelineStatistics   = 0;
+
+    VERIFY(m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE, "Deferred context has an unfinished command buffer");
+    auto vkCmdBuff = m_CmdPool->GetCommandBuffer("", &InheritanceInfo);
+    m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask(), m_CmdPool->GetSupportedAccessMask());
+    m_CommandBuffer.SetRenderPassContinuation(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+    m_IsRecordingSecondaryCmdList = true;
+
+    // Set the viewport to match the framebuffer size
+    SetViewports(1, nullptr, 0, 0);
+}
+
+void DeviceContextVkImpl::EnableSecondaryCommandLists(Bool Enable)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Secondary command lists can only be enabled in immediate contexts");
+    m_SecondaryCmdListsEnabled = Enable;
+}
+
+void DeviceContextVkImpl::CommitDynamicPipelineStates(const GraphicsPipelineDesc& GraphicsPipeline)
+{
+    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE);
+
+    const auto Flags = GraphicsPipeline.DynamicStateFlags;
+    if (Flags & PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE)
+    {
+        m_CommandBuffer.SetCullMode(CullModeToVkCullMode(GraphicsPipeline.RasterizerDesc.CullMode));
+    }
+
+    const auto& DSSDesc = GraphicsPipeline.DepthStencilDesc;
+    if (Flags & PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST)
+    {
+        m_CommandBuffer.SetDepthState(DSSDesc.DepthEnable ? VK_TRUE : VK_FALSE,
+                                      DSSDesc.DepthWriteEnable ? VK_TRUE : VK_FALSE,
+                                      ComparisonFuncToVkCompareOp(DSSDesc.DepthFunc));
+    }
+    if (Flags & PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST)
+    {
+        m_CommandBuffer.SetStencilState(DSSDesc.StencilEnable ? VK_TRUE : VK_FALSE,
+                                        StencilOpDescToVkStencilOpState(DSSDesc.FrontFace, DSSDesc.StencilReadMask, DSSDesc.StencilWriteMask),
+                                        StencilOpDescToVkStencilOpState(DSSDesc.BackFace, DSSDesc.StencilReadMask, DSSDesc.StencilWriteMask));
+    }
+    if (Flags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY)
+    {
+        VkPrimitiveTopology vkTopology         = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+        uint32_t            PatchControlPoints = 0;
+        PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(GraphicsPipeline.PrimitiveTopology, vkTopology, PatchControlPoints);
+        m_CommandBuffer.SetPrimitiveTopology(vkTopology);
+    }
+}
+
+bool DeviceContextVkImpl::DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAGS Flag, const char* MethodName) const
+{
+    DEV_CHECK_ERR(m_pPipelineState, MethodName, ": no pipeline state is bound");
+    if (!m_pPipelineState)
+        return false;
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().IsAnyGraphicsPipeline(), MethodName, ": pipeline '", m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline");
+    if (!m_pPipelineState->GetDesc().IsAnyGraphicsPipeline())
+        return false;
+
+    const auto IsDynamic = (m_pPipelineState->GetGraphicsPipelineDesc().DynamicStateFlags & Flag) != 0;
+    DEV_CHECK_ERR(IsDynamic, MethodName, ": pipeline '", m_pPipelineState->GetDesc().Name, "' was not created with ",
+                  GetPipelineDynamicStateFlagsString(Flag), " dynamic state flag");
+    return IsDynamic;
+}
+
+void DeviceContextVkImpl::SetCullMode(CULL_MODE CullMode)
+{
+    if (!DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE, "SetCullMode"))
+        return;
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetCullMode(CullModeToVkCullMode(CullMode));
+}
+
+void DeviceContextVkImpl::SetDepthState(Bool DepthEnable, Bool DepthWriteEnable, COMPARISON_FUNCTION DepthFunc)
+{
+    if (!DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST, "SetDepthState"))
+        return;
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetDepthState(DepthEnable ? VK_TRUE : VK_FALSE,
+                                  DepthWriteEnable ? VK_TRUE : VK_FALSE,
+                                  ComparisonFuncToVkCompareOp(DepthFunc));
+}
+
+void DeviceContextVkImpl::SetStencilState(Bool StencilEnable, const StencilOpDesc& FrontFace, const StencilOpDesc& BackFace)
+{
+    if (!DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST, "SetStencilState"))
+        return;
+
+    // Stencil masks are not dynamic, so the values in VkStencilOpState are ignored
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetStencilState(StencilEnable ? VK_TRUE : VK_FALSE,
+                                    StencilOpDescToVkStencilOpState(FrontFace, 0, 0),
+                                    StencilOpDescToVkStencilOpState(BackFace, 0, 0));
+}
+
+#ifdef DILIGENT_DEVELOPMENT
+static Uint32 GetPrimitiveTopologyClass(PRIMITIVE_TOPOLOGY Topology)
+{
+    static_assert(PRIMITIVE_TOPOLOGY_NUM_TOPOLOGIES == 42, "Please handle the new primitive topology below");
+    switch (Topology)
+    {
+        case PRIMITIVE_TOPOLOGY_POINT_LIST:
+            return 0;
+
+        case PRIMITIVE_TOPOLOGY_LINE_LIST:
+        case PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case PRIMITIVE_TOPOLOGY_LINE_LIST_ADJ:
+        case PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ:
+            return 1;
+
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_ADJ:
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_ADJ:
+            return 2;
+
+        default:
+            return 3; // Patch lists
+    }
+}
+#endif
+
+void DeviceContextVkImpl::SetPrimitiveTopology(PRIMITIVE_TOPOLOGY PrimitiveTopology)
+{
+    if (!DvpVerifyDynamicState(PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY, "SetPrimitiveTopology"))
+        return;
+
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto PipelineTopology = m_pPipelineState->GetGraphicsPipelineDesc().PrimitiveTopology;
+        DEV_CHECK_ERR(GetPrimitiveTopologyClass(PrimitiveTopology) == GetPrimitiveTopologyClass(PipelineTopology),
+                      "SetPrimitiveTopology: primitive topology (", Uint32{PrimitiveTopology},
+                      ") does not belong to the same topology class as the pipeline topology (", Uint32{PipelineTopology}, ")");
+    }
+#endif
+
+    VkPrimitiveTopology vkTopology         = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+    uint32_t            PatchControlPoints = 0;
+    PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(PrimitiveTopology, vkTopology, PatchControlPoints);
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetPrimitiveTopology(vkTopology);
+}
+
 void DeviceContextVkImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
 {
     TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
@@ -2712,19 +3194,182 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
     }
 }
 
+void DeviceContextVkImpl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    TDeviceContextBase::BeginConditionalRendering(Attribs, 0);
+
+    auto* pBufferVk = ClassPtrCast<BufferVkImpl>(Attribs.pBuffer);
+
+    EnsureVkCmdBuffer();
+    // Buffer memory barriers must be executed outside of render pass
+    TransitionOrVerifyBufferState(*pBufferVk, Attribs.TransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                  VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT, "Begin conditional rendering (DeviceContextVkImpl::BeginConditionalRendering)");
+
+    // Conditional rendering that begins inside a render pass instance must end in the same subpass (21.5).
+    // Outside of an explicit render pass, begin it outside of the implicit render pass so that
+    // it can span multiple render pass instances.
+    if (m_pActiveRenderPass == nullptr && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        m_CommandBuffer.EndRenderPass();
+
+    const VkConditionalRenderingFlagsEXT vkFlags = (Attribs.Flags & CONDITIONAL_RENDERING_FLAG_INVERTED) != 0 ?
+        VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT :
+        0;
+    m_CommandBuffer.BeginConditionalRendering(pBufferVk->GetVkBuffer(), Attribs.Offset, vkFlags);
+}
+
+void DeviceContextVkImpl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    EnsureVkCmdBuffer();
+    // Conditional rendering that was begun outside of a render pass instance
+    // must not be ended inside a render pass instance.
+    if (m_CommandBuffer.GetState().OutsidePassConditionalRendering && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        m_CommandBuffer.EndRenderPass();
+
+    m_CommandBuffer.EndConditionalRendering();
+}
+
+Uint32 DeviceContextVkImpl::GetQueryData(Uint32         NumQueries,
+                                         IQuery* const* ppQueries,
+                                         void*          pData,
+                                         Uint32         DataSize,
+                                         Bool*          pDataAvailable,
+                                         Bool           AutoInvalidate)
+{
+    DEV_CHECK_ERR(NumQueries == 0 || ppQueries != nullptr, "IDeviceContext::GetQueryData: ppQueries must not be null");
+
+    // Pool queries of all queries whose command buffers have completed execution
+    struct PoolQuery
+    {
+        QueryManagerVk* pQueryMgr;
+        QUERY_TYPE      Type;
+        Uint32          PoolIdx;
+        Uint32          QueryIdx;      // Index in ppQueries
+        Uint32          QueryId;       // Begin/end query id, see QueryVkImpl::GetQueryPoolIndex()
+        size_t          ResultsOffset; // Offset of the query results in the Results array
+
+        bool operator<(const PoolQuery& rhs) const
+        {
+            if (pQueryMgr != rhs.pQueryMgr)
+                return std::less<QueryManagerVk*>{}(pQueryMgr, rhs.pQueryMgr);
+            return Type != rhs.Type ? Type < rhs.Type : PoolIdx < rhs.PoolIdx;
+        }
+    };
+    std::vector<PoolQuery> PoolQueries;
+    PoolQueries.reserve(NumQueries);
+    for (Uint32 i = 0; i < NumQueries; ++i)
+    {
+        DEV_CHECK_ERR(ppQueries[i] != nullptr, "IDeviceContext::GetQueryData: query ", i, " is null");
+        DEV_CHECK_ERR(ppQueries[i]->GetDesc().Type == ppQueries[0]->GetDesc().Type, "IDeviceContext::GetQueryData: all queries must have the same type");
+
+        if (pDataAvailable != nullptr)
+            pDataAvailable[i] = False;
+
+        const auto* pQueryVk = ClassPtrCast<QueryVkImpl>(ppQueries[i]);
+        DEV_CHECK_ERR(pQueryVk->GetQueryManager() != nullptr, "Requesting data from query '", pQueryVk->GetDesc().Name, "' that has not been ended or has been invalidated");
+        if (pQueryVk->GetQueryManager() == nullptr || !pQueryVk->IsEndFenceCompleted())
+            continue;
+
+        const auto Type = pQueryVk->GetDesc().Type;
+        for (Uint32 id = 0; id < (Type == QUERY_TYPE_DURATION ? Uint32{2} : Uint32{1}); ++id)
+            PoolQueries.push_back({pQueryVk->GetQueryManager(), Type, pQueryVk->GetQueryPoolIndex(id), i, id, 0});
+    }
+    if (PoolQueries.empty())
+        return 0;
+
+    // Read the results of every range of contiguous pool queries with a single vkGetQueryPoolResults call
+    std::sort(PoolQueries.begin(), PoolQueries.end());
+    std::vector<Uint64> Results;
+    for (size_t i = 0; i < PoolQueries.size();)
+    {
+        const auto& First  = PoolQueries[i];
+        const auto  Stride = First.pQueryMgr->GetQueryResultStride(First.Type);
+
+        size_t RangeEnd = i + 1;
+        while (RangeEnd < PoolQueries.size() &&
+               PoolQueries[RangeEnd].pQueryMgr == First.pQueryMgr &&
+               PoolQueries[RangeEnd].Type == First.Type &&
+               PoolQueries[RangeEnd].PoolIdx == First.PoolIdx + (RangeEnd - i))
+            ++RangeEnd;
+
+        const auto RangeSize = static_cast<Uint32>(RangeEnd - i);
+        const auto Offset    = Results.size();
+        Results.resize(Offset + size_t{Stride} * RangeSize);
+        First.pQueryMgr->GetQueryResults(m_pDevice->GetLogicalDevice(), First.Type, First.PoolIdx, RangeSize, &Results[Offset]);
+        for (; i < RangeEnd; ++i)
+            PoolQueries[i].ResultsOffset = Offset + size_t{Stride} * (PoolQueries[i].PoolIdx - First.PoolIdx);
+    }
+
+    // Restore the order of the queries so that the pool queries of every query are adjacent
+    std::sort(PoolQueries.begin(), PoolQueries.end(),
+              [](const PoolQuery& lhs, const PoolQuery& rhs) {
+                  return lhs.QueryIdx != rhs.QueryIdx ? lhs.QueryIdx < rhs.QueryIdx : lhs.QueryId < rhs.QueryId;
+              });
+
+    Uint32 NumAvailable = 0;
+    for (size_t i = 0; i < PoolQueries.size();)
+    {
+        const auto    QueryIdx     = PoolQueries[i].QueryIdx;
+        const Uint64* ppResults[2] = {};
+        for (; i < PoolQueries.size() && PoolQueries[i].QueryIdx == QueryIdx; ++i)
+            ppResults[PoolQueries[i].QueryId] = &Results[PoolQueries[i].ResultsOffset];
+
+        void* pQueryData = pData != nullptr ? static_cast<Uint8*>(pData) + size_t{DataSize} * QueryIdx : nullptr;
+        if (ClassPtrCast<QueryVkImpl>(ppQueries[QueryIdx])->GetData(pQueryData, DataSize, AutoInvalidate, ppResults))
+        {
+            if (pDataAvailable != nullptr)
+                pDataAvailable[QueryIdx] = True;
+            ++NumAvailable;
+        }
+    }
+
+    return NumAvailable;
+}
+
+Bool DeviceContextVkImpl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Timestamp calibration is only supported by immediate contexts");
+    if (IsDeferred() || m_pQueryMgr == nullptr)
+        return False;
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    if (!LogicalDevice.GetEnabledExtFeatures().CalibratedTimestamps)
+        return False;
+
+    // Device timestamps are the same for all queues and use the same units as vkCmdWriteTimestamp
+    VkCalibratedTimestampInfoEXT TimestampInfos[2]{};
+    TimestampInfos[0].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    TimestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    TimestampInfos[1].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    if (!VulkanUtilities::VulkanPhysicalDevice::GetHostTimeDomain(TimestampInfos[1].timeDomain))
+        return False;
+
+    uint64_t Timestamps[2]{};
+    uint64_t MaxDeviation = 0;
+    if (LogicalDevice.GetCalibratedTimestamps(_countof(TimestampInfos), TimestampInfos, Timestamps, &MaxDeviation) != VK_SUCCESS)
+        return False;
+
+    Calibration.GPUCounter   = Timestamps[0];
+    Calibration.GPUFrequency = m_pQueryMgr->GetCounterFrequency();
+    Calibration.CPUTime      = VulkanUtilities::VulkanPhysicalDevice::HostTimestampToNanoseconds(Timestamps[1]);
+    Calibration.MaxDeviation = MaxDeviation;
+    return True;
+}
+
 
 void DeviceContextVkImpl::TransitionImageLayout(ITexture* pTexture, VkImageLayout NewLayout)
 {
     VERIFY_EXPR(pTexture != nullptr);
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
     auto pTextureVk = ClassPtrCast<TextureVkImpl>(pTexture);
-    if (!pTextureVk->IsInKnownState())
+    if (!pTextureVk->IsInKnownState() && !pTextureVk->HasSubresourceStates())
     {
         LOG_ERROR_MESSAGE("Failed to transition layout for texture '", pTextureVk->GetDesc().Name, "' because the texture state is unknown");
         return;
     }
     auto NewState = VkImageLayoutToResourceState(NewLayout);
-    if (!pTextureVk->CheckState(NewState))
+    if (pTextureVk->HasSubresourceStates() || !pTextureVk->CheckState(NewState))
     {
         TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE);
     }
@@ -2753,13 +3398,15 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
                                                  VkImageSubresourceRange* pSubresRange /* = nullptr*/)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+
+    const auto* pSubresStates = TextureVk.GetSubresourceStates();
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
         if (TextureVk.IsInKnownState())
         {
             OldState = TextureVk.GetState();
         }
-        else
+        else if (!TextureVk.HasSubresourceStates())
         {
             LOG_ERROR_MESSAGE("Failed to transition the state of texture '", TextureVk.GetDesc().Name, "' because the state is unknown and is not explicitly specified.");
             return;
@@ -2777,8 +3424,6 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
 
     EnsureVkCmdBuffer();
 
-    auto vkImg = TextureVk.GetVkImage();
-
     VkImageSubresourceRange FullSubresRange;
     if (pSubresRange == nullptr)
     {
@@ -2791,9 +3436,9 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
         FullSubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
     }
 
+    const auto& TexDesc = TextureVk.GetDesc();
     if (pSubresRange->aspectMask == 0)
     {
-        const auto& TexDesc    = TextureVk.GetDesc();
         const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
         if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
             pSubresRange->aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -2808,6 +3453,72 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
             pSubresRange->aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     }
 
+    if (pSubresStates == nullptr)
+    {
+        if (TransitionTextureSubresources(TextureVk, OldState, NewState, Flags, *pSubresRange) &&
+            (Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
+        {
+            TextureVk.SetState(NewState);
+            VERIFY_EXPR(TextureVk.GetLayout() == ResourceStateToVkImageLayout(NewState, /*IsInsideRenderPass = */ false,
+                                                                              m_pDevice->GetLogicalDevice().GetEnabledExtFeatures().FragmentDensityMap.fragmentDensityMap != VK_FALSE));
+        }
+        return;
+    }
+
+    SubresourceStateTracker::Range Range;
+    Range.FirstMip   = pSubresRange->baseMipLevel;
+    Range.NumMips    = pSubresRange->levelCount == VK_REMAINING_MIP_LEVELS ? TexDesc.MipLevels - Range.FirstMip : pSubresRange->levelCount;
+    Range.FirstSlice = pSubresRange->baseArrayLayer;
+    Range.NumSlices  = pSubresRange->layerCount == VK_REMAINING_ARRAY_LAYERS ? TexDesc.GetArraySize() - Range.FirstSlice : pSubresRange->layerCount;
+
+    // Ranges whose state has been transitioned. The tracker must not be modified while it is being traversed.
+    std::vector<SubresourceStateTracker::Range> TransitionedRanges;
+
+    const auto TransitionRange = [&](const SubresourceStateTracker::Range& R, RESOURCE_STATE SubresOldState) {
+        VkImageSubresourceRange SubresRange = *pSubresRange;
+        SubresRange.baseMipLevel            = R.FirstMip;
+        SubresRange.levelCount              = R.NumMips;
+        SubresRange.baseArrayLayer          = R.FirstSlice;
+        SubresRange.layerCount              = R.NumSlices;
+        if (TransitionTextureSubresources(TextureVk, SubresOldState, NewState, Flags, SubresRange))
+            TransitionedRanges.push_back(R);
+    };
+
+    if (OldState != RESOURCE_STATE_UNKNOWN)
+    {
+        TransitionRange(Range, OldState);
+    }
+    else
+    {
+        // Only the subresources that are not in the new state are transitioned
+        pSubresStates->ProcessRange(Range,
+                                    [&](const SubresourceStateTracker::Range& R, RESOURCE_STATE SubresState) {
+                                        if (SubresState == RESOURCE_STATE_UNKNOWN)
+                                        {
+                                            LOG_ERROR_MESSAGE("Failed to transition mip levels ", R.FirstMip, "..", R.FirstMip + R.NumMips - 1,
+                                                              " and array slices ", R.FirstSlice, "..", R.FirstSlice + R.NumSlices - 1, " of texture '",
+                                                              TexDesc.Name, "' because their state is unknown and is not explicitly specified.");
+                                            return;
+                                        }
+                                        TransitionRange(R, SubresState);
+                                    });
+    }
+
+    if ((Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
+    {
+        for (const auto& R : TransitionedRanges)
+            TextureVk.SetSubresourceState(R, NewState);
+    }
+}
+
+bool DeviceContextVkImpl::TransitionTextureSubresources(TextureVkImpl&                 TextureVk,
+                                                        RESOURCE_STATE                 OldState,
+                                                        RESOURCE_STATE                 NewState,
+                                                        STATE_TRANSITION_FLAGS         Flags,
+                                                        const VkImageSubresourceRange& SubresRange)
+{
+    VERIFY_EXPR(OldState != RESOURCE_STATE_UNKNOWN && SubresRange.aspectMask != 0);
+
     // Always add barrier after writes.
     const bool AfterWrite = ResourceStateHasWriteAccess(OldState);
 
@@ -2820,25 +3531,35 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
 
     if (((OldState & NewState) != NewState) || OldLayout != NewLayout || AfterWrite)
     {
-        m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange, OldStages, NewStages);
-        if ((Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
-        {
-            TextureVk.SetState(NewState);
-            VERIFY_EXPR(TextureVk.GetLayout() == NewLayout);
-        }
+        m_CommandBuffer.TransitionImageLayout(TextureVk.GetVkImage(), OldLayout, NewLayout, SubresRange, OldStages, NewStages);
+        return true;
     }
+
+    return false;
 }
 
 void DeviceContextVkImpl::TransitionOrVerifyTextureState(TextureVkImpl&                 Texture,
                                                          RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                          RESOURCE_STATE                 RequiredState,
                                                          VkImageLayout                  ExpectedLayout,
-                                                         const char*                    OperationName)
+                                                         const char*                    OperationName,
+                                                         const TextureViewVkImpl*       pView)
 {
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
-        if (Texture.IsInKnownState())
+        if (pView != nullptr && Texture.GetSubresourceStates() != nullptr)
+        {
+            const auto Range = Texture.GetSubresourceRange(pView->GetDesc());
+
+            VkImageSubresourceRange SubresRange{};
+            SubresRange.baseMipLevel   = Range.FirstMip;
+            SubresRange.levelCount     = Range.NumMips;
+            SubresRange.baseArrayLayer = Range.FirstSlice;
+            SubresRange.layerCount     = Range.NumSlices;
+            TransitionTextureState(Texture, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE, &SubresRange);
+        }
+        else if (Texture.IsInKnownState() || Texture.HasSubresourceStates())
         {
             TransitionTextureState(Texture, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE);
             VERIFY_EXPR(Texture.GetLayout() == ExpectedLayout);
@@ -3088,6 +3809,8 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint64 SizeInB
     DEV_CHECK_ERR(SizeInBytes < std::numeric_limits<Uint32>::max(),
                   "Dynamic allocation size must be less than 2^32");
 
+    m_Statistics.DynamicHeapBytes += SizeInBytes;
+
     auto DynAlloc = m_DynamicHeap.Allocate(static_cast<Uint32>(SizeInBytes), Alignment);
 #ifdef DILIGENT_DEVELOPMENT
     DynAlloc.dvpFrameNumber = GetFrameNumber();
@@ -3097,6 +3820,8 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint64 SizeInB
 
 void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    MetricTimerScope MetricScope{m_pDevice->GetMetric(DEVICE_METRIC_TRANSITION_RESOURCE_STATES)};
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
 
     if (BarrierCount == 0)
@@ -3112,8 +3837,8 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
 #endif
         if (Barrier.TransitionType == STATE_TRANSITION_TYPE_BEGIN)
         {
-            // Skip begin-split barriers
             VERIFY((Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) == 0, "Resource state can't be updated in begin-split barrier");
+            BeginSplitBarrier(Barrier);
             continue;
         }
         if (Barrier.Flags & STATE_TRANSITION_FLAG_ALIASING)
@@ -3124,6 +3849,16 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
         {
             VERIFY(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || Barrier.TransitionType == STATE_TRANSITION_TYPE_END, "Unexpected barrier type");
 
+            RESOURCE_STATE       OldState       = Barrier.OldState;
+            VkEvent              SplitEvent     = VK_NULL_HANDLE;
+            VkPipelineStageFlags SplitSrcStages = 0;
+            if (Barrier.TransitionType == STATE_TRANSITION_TYPE_END && EndSplitBarrier(Barrier, SplitEvent, SplitSrcStages, OldState))
+            {
+                // Record the barriers accumulated so far with vkCmdPipelineBarrier, so that
+                // only this barrier waits for the event.
+                m_CommandBuffer.FlushBarriers();
+            }
+
             if (RefCntAutoPtr<TextureVkImpl> pTexture{Barrier.pResource, IID_TextureVk})
             {
                 VkImageSubresourceRange SubResRange;
@@ -3132,11 +3867,11 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
                 SubResRange.levelCount     = (Barrier.MipLevelsCount == REMAINING_MIP_LEVELS) ? VK_REMAINING_MIP_LEVELS : Barrier.MipLevelsCount;
                 SubResRange.baseArrayLayer = Barrier.FirstArraySlice;
                 SubResRange.layerCount     = (Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES) ? VK_REMAINING_ARRAY_LAYERS : Barrier.ArraySliceCount;
-                TransitionTextureState(*pTexture, Barrier.OldState, Barrier.NewState, Barrier.Flags, &SubResRange);
+                TransitionTextureState(*pTexture, OldState, Barrier.NewState, Barrier.Flags, &SubResRange);
             }
             else if (RefCntAutoPtr<BufferVkImpl> pBuffer{Barrier.pResource, IID_BufferVk})
             {
-                TransitionBufferState(*pBuffer, Barrier.OldState, Barrier.NewState, (Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0);
+                TransitionBufferState(*pBuffer, OldState, Barrier.NewState, (Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0);
             }
             else if (RefCntAutoPtr<BottomLevelASVkImpl> pBottomLevelAS{Barrier.pResource, IID_BottomLevelAS})
             {
@@ -3150,8 +3885,97 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
             {
                 UNEXPECTED("unsupported resource type");
             }
+
+            if (SplitEvent != VK_NULL_HANDLE)
+                m_CommandBuffer.FlushBarriers(SplitEvent, SplitSrcStages);
+        }
+    }
+}
+
+void DeviceContextVkImpl::BeginSplitBarrier(const StateTransitionDesc& Barrier)
+{
+    // Events must be released with the fence value of the submission that executes them,
+    // which is only known in immediate contexts. Deferred contexts ignore begin-split barriers
+    // and execute end-split barriers as immediate ones.
+    if (IsDeferred() || (Barrier.Flags & STATE_TRANSITION_FLAG_ALIASING) != 0)
+        return;
+
+    RESOURCE_STATE OldState = Barrier.OldState;
+    if (RefCntAutoPtr<TextureVkImpl> pTexture{Barrier.pResource, IID_TextureVk})
+    {
+        if (OldState == RESOURCE_STATE_UNKNOWN && pTexture->IsInKnownState())
+            OldState = pTexture->GetState();
+    }
+    else if (RefCntAutoPtr<BufferVkImpl> pBuffer{Barrier.pResource, IID_BufferVk})
+    {
+        if (OldState == RESOURCE_STATE_UNKNOWN && pBuffer->IsInKnownState())
+            OldState = pBuffer->GetState();
+    }
+    else
+    {
+        // Acceleration structure barriers are always executed at the end of the split
+        return;
+    }
+
+    // If the old state is unknown, the end-split barrier will report the error
+    if (OldState == RESOURCE_STATE_UNKNOWN)
+        return;
+
+    const VkPipelineStageFlags SrcStages = ResourceStateFlagsToVkPipelineStageFlags(OldState) & m_CommandBuffer.GetSupportedStagesMask();
+    if (SrcStages == 0)
+        return;
+
+    VkEventCreateInfo EventCI{};
+    EventCI.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    EventCI.pNext = nullptr;
+    EventCI.flags = 0;
+
+    auto Event = m_pDevice->GetLogicalDevice().CreateEvent(EventCI, "Split barrier event");
+    m_CommandBuffer.SetEvent(Event, SrcStages);
+
+    PendingSplitBarrier Pending;
+    Pending.pResource       = Barrier.pResource;
+    Pending.OldState        = OldState;
+    Pending.NewState        = Barrier.NewState;
+    Pending.FirstMipLevel   = Barrier.FirstMipLevel;
+    Pending.MipLevelsCount  = Barrier.MipLevelsCount;
+    Pending.FirstArraySlice = Barrier.FirstArraySlice;
+    Pending.ArraySliceCount = Barrier.ArraySliceCount;
+    Pending.vkEvent         = Event;
+    Pending.SrcStages       = SrcStages;
+    m_PendingSplitBarriers.emplace_back(std::move(Pending));
+
+    m_SplitBarrierEvents.emplace_back(std::move(Event));
+}
+
+bool DeviceContextVkImpl::EndSplitBarrier(const StateTransitionDesc& Barrier, VkEvent& vkEvent, VkPipelineStageFlags& SrcStages, RESOURCE_STATE& OldState)
+{
+    for (auto it = m_PendingSplitBarriers.begin(); it != m_PendingSplitBarriers.end(); ++it)
+    {
+        const auto& Pending = *it;
+        if (Pending.pResource.RawPtr() != Barrier.pResource ||
+            Pending.NewState != Barrier.NewState ||
+            Pending.FirstMipLevel != Barrier.FirstMipLevel ||
+            Pending.MipLevelsCount != Barrier.MipLevelsCount ||
+            Pending.FirstArraySlice != Barrier.FirstArraySlice ||
+            Pending.ArraySliceCount != Barrier.ArraySliceCount)
+            continue;
+
+        if (Barrier.OldState != RESOURCE_STATE_UNKNOWN && Barrier.OldState != Pending.OldState)
+        {
+            LOG_ERROR_MESSAGE("The old state ", GetResourceStateString(Barrier.OldState), " of the end-split barrier does not match the old state ",
+                              GetResourceStateString(Pending.OldState), " of the begin-split barrier");
+            continue;
         }
+
+        vkEvent   = Pending.vkEvent;
+        SrcStages = Pending.SrcStages;
+        OldState  = Pending.OldState;
+        m_PendingSplitBarriers.erase(it);
+        return true;
     }
+
+    return false;
 }
 
 void DeviceContextVkImpl::AliasingBarrier(IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter)
@@ -3240,23 +4064,23 @@ void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*
                                  1, &ResolveRegion);
 }
 
-void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextVkImpl::PrepareBLASBuild(const BuildBLASAttribs& Attribs, BLASBuildInfo& BuildInfo, const char* OpName)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
-
     auto* pBLASVk    = ClassPtrCast<BottomLevelASVkImpl>(Attribs.pBLAS);
     auto* pScratchVk = ClassPtrCast<BufferVkImpl>(Attribs.pScratchBuffer);
     auto& BLASDesc   = pBLASVk->GetDesc();
 
     EnsureVkCmdBuffer();
 
-    const char* OpName = "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)";
     TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
 
-    VkAccelerationStructureBuildGeometryInfoKHR           vkASBuildInfo = {};
-    std::vector<VkAccelerationStructureBuildRangeInfoKHR> vkRanges;
-    std::vector<VkAccelerationStructureGeometryKHR>       vkGeometries;
+    VkAccelerationStructureBuildGeometryInfoKHR&           vkASBuildInfo = BuildInfo.vkBuildInfo;
+    std::vector<VkAccelerationStructureBuildRangeInfoKHR>& vkRanges      = BuildInfo.vkRanges;
+    std::vector<VkAccelerationStructureGeometryKHR>&       vkGeometries  = BuildInfo.vkGeometries;
+    // The vectors are reused, so clear them to value-initialize all elements below
+    vkRanges.clear();
+    vkGeometries.clear();
 
     if (Attribs.pTriangleData != nullptr)
     {
@@ -3386,8 +4210,7 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
         }
     }
 
-    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
-
+    vkASBuildInfo                           = {};
     vkASBuildInfo.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     vkASBuildInfo.type                      = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;                 // type must be compatible with create info
     vkASBuildInfo.flags                     = BuildASFlagsToVkBuildAccelerationStructureFlags(BLASDesc.Flags); // flags must be compatible with create info
@@ -3402,15 +4225,56 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     const auto& ASLimits = m_pDevice->GetPhysicalDevice().GetExtProperties().AccelStruct;
     VERIFY(vkASBuildInfo.scratchData.deviceAddress % ASLimits.minAccelerationStructureScratchOffsetAlignment == 0, "Scratch buffer start address is not properly aligned");
 
-    EnsureVkCmdBuffer();
-    m_CommandBuffer.BuildAccelerationStructure(1, &vkASBuildInfo, &VkRangePtr);
-    ++m_State.NumCommands;
-
 #ifdef DILIGENT_DEVELOPMENT
     pBLASVk->DvpUpdateVersion();
 #endif
 }
 
+void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
+    if (m_BLASBuildInfos.empty())
+        m_BLASBuildInfos.resize(1);
+    auto& BuildInfo = m_BLASBuildInfos[0];
+    PrepareBLASBuild(Attribs, BuildInfo, "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)");
+
+    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = BuildInfo.vkRanges.data();
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.BuildAccelerationStructure(1, &BuildInfo.vkBuildInfo, &VkRangePtr);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    const auto& Builds = m_BLASBatchBuilds;
+    if (Builds.empty())
+        return;
+
+    if (m_BLASBuildInfos.size() < Builds.size())
+        m_BLASBuildInfos.resize(Builds.size());
+
+    // Record all state transitions first. They are flushed as a single pipeline barrier
+    // before the build command.
+    for (size_t i = 0; i < Builds.size(); ++i)
+        PrepareBLASBuild(Builds[i], m_BLASBuildInfos[i], "Build BottomLevelAS (DeviceContextVkImpl::BuildBLASBatch)");
+
+    m_vkBLASBuildInfos.clear();
+    m_vkBLASBuildRangePtrs.clear();
+    for (size_t i = 0; i < Builds.size(); ++i)
+    {
+        m_vkBLASBuildInfos.push_back(m_BLASBuildInfos[i].vkBuildInfo);
+        m_vkBLASBuildRangePtrs.push_back(m_BLASBuildInfos[i].vkRanges.data());
+    }
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.BuildAccelerationStructure(static_cast<uint32_t>(m_vkBLASBuildInfos.size()), m_vkBLASBuildInfos.data(), m_vkBLASBuildRangePtrs.data());
+    ++m_State.NumCommands;
+}
+
 void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
     TDeviceContextBase::BuildTLAS(Attribs, 0);
@@ -3428,19 +4292,76 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     TransitionOrVerifyTLASState(*pTLASVk, Attribs.TLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
 
-    if (Attribs.Update)
+    const auto WriteInstanceDesc = [&](VkAccelerationStructureInstanceKHR& vkASInst, const TLASBuildInstanceData& Inst, Uint32 ContributionToHitGroupIndex) {
+        auto* pBLASVk = ClassPtrCast<BottomLevelASVkImpl>(Inst.pBLAS);
+
+        static_assert(sizeof(vkASInst.transform) == sizeof(Inst.Transform), "size mismatch");
+        std::memcpy(&vkASInst.transform, Inst.Transform.data, sizeof(vkASInst.transform));
+
+        vkASInst.instanceCustomIndex                    = Inst.CustomId;
+        vkASInst.instanceShaderBindingTableRecordOffset = ContributionToHitGroupIndex;
+        vkASInst.mask                                   = Inst.Mask;
+        vkASInst.flags                                  = InstanceFlagsToVkGeometryInstanceFlags(Inst.Flags);
+        vkASInst.accelerationStructureReference         = pBLASVk->GetVkDeviceAddress();
+
+        TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
+    };
+
+    if (Attribs.DirtyInstancesOnly)
     {
-        if (!pTLASVk->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+        if (!pTLASVk->UpdateDirtyInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BindingMode, m_DirtyTLASInstances))
             return;
+
+        // Only write the descriptors of the changed instances. Instances with consecutive indices
+        // are copied with a single region.
+        if (!m_DirtyTLASInstances.empty())
+        {
+            constexpr size_t InstSize = sizeof(VkAccelerationStructureInstanceKHR);
+
+            auto TmpSpace = m_UploadHeap.Allocate(m_DirtyTLASInstances.size() * InstSize, 16);
+            auto pDstInst = static_cast<VkAccelerationStructureInstanceKHR*>(TmpSpace.CPUAddress);
+
+            m_vkBufferCopyRegions.clear();
+            for (size_t i = 0; i < m_DirtyTLASInstances.size(); ++i)
+            {
+                const auto& Dirty = m_DirtyTLASInstances[i];
+                WriteInstanceDesc(pDstInst[i], *Dirty.pData, Dirty.ContributionToHitGroupIndex);
+
+                const VkDeviceSize DstOffset = Attribs.InstanceBufferOffset + Dirty.InstanceIndex * InstSize;
+                if (!m_vkBufferCopyRegions.empty() && m_vkBufferCopyRegions.back().dstOffset + m_vkBufferCopyRegions.back().size == DstOffset)
+                {
+                    m_vkBufferCopyRegions.back().size += InstSize;
+                }
+                else
+                {
+                    VkBufferCopy Region;
+                    Region.srcOffset = TmpSpace.AlignedOffset + i * InstSize;
+                    Region.dstOffset = DstOffset;
+                    Region.size      = InstSize;
+                    m_vkBufferCopyRegions.push_back(Region);
+                }
+            }
+
+            TransitionOrVerifyBufferState(*pInstancesVk, Attribs.InstanceBufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
+            VERIFY(pInstancesVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
+            m_CommandBuffer.CopyBuffer(TmpSpace.vkBuffer, pInstancesVk->GetVkBuffer(), static_cast<uint32_t>(m_vkBufferCopyRegions.size()), m_vkBufferCopyRegions.data());
+            ++m_State.NumCommands;
+        }
     }
     else
     {
-        if (!pTLASVk->SetInstanceData(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
-            return;
-    }
+        if (Attribs.Update)
+        {
+            if (!pTLASVk->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+                return;
+        }
+        else
+        {
+            if (!pTLASVk->SetInstanceData(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
+                return;
+        }
 
-    // copy instance data into instance buffer
-    {
+        // copy instance data into instance buffer
         size_t Size     = Attribs.InstanceCount * sizeof(VkAccelerationStructureInstanceKHR);
         auto   TmpSpace = m_UploadHeap.Allocate(Size, 16);
 
@@ -3455,19 +4376,7 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
                 return;
             }
 
-            auto& vkASInst = static_cast<VkAccelerationStructureInstanceKHR*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex];
-            auto* pBLASVk  = ClassPtrCast<BottomLevelASVkImpl>(Inst.pBLAS);
-
-            static_assert(sizeof(vkASInst.transform) == sizeof(Inst.Transform), "size mismatch");
-            std::memcpy(&vkASInst.transform, Inst.Transform.data, sizeof(vkASInst.transform));
-
-            vkASInst.instanceCustomIndex                    = Inst.CustomId;
-            vkASInst.instanceShaderBindingTableRecordOffset = InstDesc.ContributionToHitGroupIndex;
-            vkASInst.mask                                   = Inst.Mask;
-            vkASInst.flags                                  = InstanceFlagsToVkGeometryInstanceFlags(Inst.Flags);
-            vkASInst.accelerationStructureReference         = pBLASVk->GetVkDeviceAddress();
-
-            TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_READ, OpName);
+            WriteInstanceDesc(static_cast<VkAccelerationStructureInstanceKHR*>(TmpSpace.CPUAddress)[InstDesc.InstanceIndex], Inst, InstDesc.ContributionToHitGroupIndex);
         }
 
         UpdateBufferRegion(pInstancesVk, Attribs.InstanceBufferOffset, Size, TmpSpace.vkBuffer, TmpSpace.AlignedOffset, Attribs.InstanceBufferTransitionMode);
@@ -3479,7 +4388,8 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     VkAccelerationStructureBuildRangeInfoKHR const* vkRangePtr    = &vkRange;
     VkAccelerationStructureGeometryKHR              vkASGeometry  = {};
 
-    vkRange.primitiveCount = Attribs.InstanceCount;
+    // The TLAS is always built or refit with all instances
+    vkRange.primitiveCount = pTLASVk->GetBuildInfo().InstanceCount;
 
     vkASGeometry.sType        = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
     vkASGeometry.pNext        = nullptr;
@@ -3637,8 +4547,10 @@ void DeviceContextVkImpl::TraceRays(const TraceRaysAttribs& Attribs)
     const auto& BindingTable = pSBTVk->GetVkBindingTable();
 
     PrepareForRayTracing();
+    const Uint32 Breadcrumb = BeginBreadcrumb("TraceRays");
     m_CommandBuffer.TraceRays(BindingTable.RaygenShader, BindingTable.MissShader, BindingTable.HitShader, BindingTable.CallableShader,
                               Attribs.DimensionX, Attribs.DimensionY, Attribs.DimensionZ);
+    EndBreadcrumb(Breadcrumb);
     ++m_State.NumCommands;
 }
 
@@ -3653,8 +4565,10 @@ void DeviceContextVkImpl::TraceRaysIndirect(const TraceRaysIndirectAttribs& Attr
     const auto  IndirectBuffOffset = Attribs.ArgsByteOffset + TraceRaysIndirectCommandSBTSize;
 
     PrepareForRayTracing();
+    const Uint32 Breadcrumb = BeginBreadcrumb("TraceRaysIndirect");
     m_CommandBuffer.TraceRaysIndirect(BindingTable.RaygenShader, BindingTable.MissShader, BindingTable.HitShader, BindingTable.CallableShader,
                                       pIndirectAttribsVk->GetVkDeviceAddress() + IndirectBuffOffset);
+    EndBreadcrumb(Breadcrumb);
     ++m_State.NumCommands;
 }
 
@@ -3670,26 +4584,44 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
     ShaderBindingTableVkImpl::BindingTable HitGroupTable       = {};
     ShaderBindingTableVkImpl::BindingTable CallableShaderTable = {};
 
-    pSBTVk->GetData(pSBTBufferVk, RayGenShaderRecord, MissShaderTable, HitGroupTable, CallableShaderTable);
+    pSBTVk->GetData(pSBTBufferVk, RayGenShaderRecord, MissShaderTable, HitGroupTable, CallableShaderTable, m_SBTUploads);
 
     const char* OpName = "Update shader binding table (DeviceContextVkImpl::UpdateSBT)";
 
-    if (RayGenShaderRecord.pData || MissShaderTable.pData || HitGroupTable.pData || CallableShaderTable.pData)
+    if (!m_SBTUploads.empty())
     {
-        TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
+        // Only the records that changed since the previous update are uploaded.
+        // All regions are staged in a single allocation and copied with one command.
+        constexpr size_t RegionAlignment = 16;
+
+        size_t StagingSize = 0;
+        for (const auto& Region : m_SBTUploads)
+            StagingSize = AlignUp(StagingSize, RegionAlignment) + Region.Size;
+
+        auto TmpSpace = m_UploadHeap.Allocate(StagingSize, RegionAlignment);
 
-        // Buffer ranges do not intersect, so we don't need to add barriers between them
-        if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        m_vkBufferCopyRegions.clear();
+        size_t SrcOffset = 0;
+        for (const auto& Region : m_SBTUploads)
+        {
+            SrcOffset = AlignUp(SrcOffset, RegionAlignment);
+            memcpy(static_cast<Uint8*>(TmpSpace.CPUAddress) + SrcOffset, Region.pData, Region.Size);
+
+            VkBufferCopy CopyRegion;
+            CopyRegion.srcOffset = TmpSpace.AlignedOffset + SrcOffset;
+            CopyRegion.dstOffset = Region.Offset;
+            CopyRegion.size      = Region.Size;
+            m_vkBufferCopyRegions.push_back(CopyRegion);
 
-        if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            SrcOffset += Region.Size;
+        }
 
-        if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferVk, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        EnsureVkCmdBuffer();
+        TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
 
-        if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        VERIFY(pSBTBufferVk->m_VulkanBuffer != VK_NULL_HANDLE, "Copy destination buffer must not be suballocated");
+        m_CommandBuffer.CopyBuffer(TmpSpace.vkBuffer, pSBTBufferVk->GetVkBuffer(), static_cast<uint32_t>(m_vkBufferCopyRegions.size()), m_vkBufferCopyRegions.data());
+        ++m_State.NumCommands;
 
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, VK_ACCESS_SHADER_READ_BIT, OpName);
     }
@@ -3702,6 +4634,14 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
 
 void DeviceContextVkImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
+    if (IsDebugGroupProfilingEnabled() && m_pActiveRenderPass == nullptr && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    {
+        // The profiler may begin a pipeline statistics query for the group. A query begun inside
+        // the implicit render pass would have to end in the same pass, which may have been ended
+        // by then (17.2).
+        m_CommandBuffer.EndRenderPass();
+    }
+
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
     VkDebugUtilsLabelEXT Info{};
@@ -3713,6 +4653,9 @@ void DeviceContextVkImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 
     EnsureVkCmdBuffer();
     m_CommandBuffer.BeginDebugUtilsLabel(Info);
+
+    if (m_pBreadcrumbs)
+        m_pBreadcrumbs->BeginDebugGroup(m_CommandBuffer, Name);
 }
 
 void DeviceContextVkImpl::EndDebugGroup()
@@ -3721,6 +4664,9 @@ void DeviceContextVkImpl::EndDebugGroup()
 
     EnsureVkCmdBuffer();
     m_CommandBuffer.EndDebugUtilsLabel();
+
+    if (m_pBreadcrumbs)
+        m_pBreadcrumbs->EndDebugGroup(m_CommandBuffer);
 }
 
 void DeviceContextVkImpl::InsertDebugLabel(const Char* Label, const float* pColor)
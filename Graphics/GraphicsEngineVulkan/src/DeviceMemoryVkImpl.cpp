@@ -104,6 +104,8 @@ DeviceMemoryVkImpl::DeviceMemoryVkImpl(IReferenceCounters*           pRefCounter
 
     for (size_t i = 0; i < PageCount; ++i)
         m_Pages.emplace_back(LogicalDevice.AllocateDeviceMemory(MemAlloc, m_Desc.Name)); // throw on error
+
+    RecordGPUMemory(GetCapacity());
 }
 
 DeviceMemoryVkImpl::~DeviceMemoryVkImpl()
@@ -136,6 +138,7 @@ Bool DeviceMemoryVkImpl::Resize(Uint64 NewSize)
         }
         catch (...)
         {
+            RecordGPUMemory(GetCapacity());
             return false;
         }
     }
@@ -146,6 +149,8 @@ Bool DeviceMemoryVkImpl::Resize(Uint64 NewSize)
         m_Pages.pop_back();
     }
 
+    RecordGPUMemory(GetCapacity());
+
     return true;
 }
 
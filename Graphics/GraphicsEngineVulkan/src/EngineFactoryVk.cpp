@@ -640,7 +640,10 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         return;
     }
 
-    SetRawAllocator(EngineCI.pRawMemAllocator);
+    SetRawAllocator(EngineCI.pRawMemAllocator, EngineCI.EnableMemoryTracking);
+
+    DeviceStartupTimer      StartupTimer;
+    DeviceStartupStatistics StartupStats;
 
     try
     {
@@ -663,6 +666,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
 
         auto Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
 
+        StartupStats.InstanceCreationTime = StartupTimer.Lap();
+
         auto vkDevice       = Instance->SelectPhysicalDevice(EngineCI.AdapterId);
         auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create({*Instance, vkDevice, /*LogExtensions = */ true});
 
@@ -680,6 +685,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
         const auto EnabledFeatures = EnableDeviceFeatures(AdapterInfo.Features, EngineCI.Features);
 
+        StartupStats.AdapterQueryTime = StartupTimer.Lap();
+
         std::vector<VkDeviceQueueGlobalPriorityCreateInfoEXT> QueueGlobalPriority;
         std::vector<VkDeviceQueueCreateInfo>                  QueueInfos;
         std::vector<float>                                    QueuePriorities;
@@ -1077,6 +1084,64 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 NextExt  = &EnabledExtFeats.HostQueryReset.pNext;
             }
 
+            if (EnabledFeatures.DynamicPipelineStates != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+
+                EnabledExtFeats.ExtendedDynamicState = DeviceExtFeatures.ExtendedDynamicState;
+
+                *NextExt = &EnabledExtFeats.ExtendedDynamicState;
+                NextExt  = &EnabledExtFeats.ExtendedDynamicState.pNext;
+            }
+
+            if (EnabledFeatures.ConditionalRendering != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.ConditionalRendering = DeviceExtFeatures.ConditionalRendering;
+                // Predicating secondary command buffers is not used
+                EnabledExtFeats.ConditionalRendering.inheritedConditionalRendering = VK_FALSE;
+
+                *NextExt = &EnabledExtFeats.ConditionalRendering;
+                NextExt  = &EnabledExtFeats.ConditionalRendering.pNext;
+            }
+
+            // Graphics pipeline library is not exposed as a device feature and is only enabled on request
+            if (EngineCI.EnableGraphicsPipelineLibrary && DeviceExtFeatures.GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+                DeviceExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+                EnabledExtFeats.GraphicsPipelineLibrary = DeviceExtFeatures.GraphicsPipelineLibrary;
+
+                *NextExt = &EnabledExtFeats.GraphicsPipelineLibrary;
+                NextExt  = &EnabledExtFeats.GraphicsPipelineLibrary.pNext;
+            }
+
+            // Shader module identifiers let the pipelines found in the pipeline state cache
+            // be created without the SPIR-V. The extension is transparent to the application.
+            if (DeviceExtFeatures.ShaderModuleIdentifier.shaderModuleIdentifier != VK_FALSE &&
+                DeviceExtFeatures.PipelineCreationCacheControl.pipelineCreationCacheControl != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME);
+                DeviceExtensions.push_back(VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME);
+
+                EnabledExtFeats.PipelineCreationCacheControl = DeviceExtFeatures.PipelineCreationCacheControl;
+                EnabledExtFeats.ShaderModuleIdentifier       = DeviceExtFeatures.ShaderModuleIdentifier;
+
+                *NextExt = &EnabledExtFeats.PipelineCreationCacheControl;
+                NextExt  = &EnabledExtFeats.PipelineCreationCacheControl.pNext;
+
+                *NextExt = &EnabledExtFeats.ShaderModuleIdentifier;
+                NextExt  = &EnabledExtFeats.ShaderModuleIdentifier.pNext;
+            }
+
             if (EnabledFeatures.VariableRateShading != DEVICE_FEATURE_STATE_DISABLED)
             {
                 if (DeviceExtFeatures.ShadingRate.pipelineFragmentShadingRate != VK_FALSE ||
@@ -1139,6 +1204,82 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 }
             }
 
+            if (DeviceExtFeatures.MemoryBudget)
+            {
+                // Used by the memory manager to keep allocations within the heap budgets
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+                EnabledExtFeats.MemoryBudget = true;
+            }
+
+            if (DeviceExtFeatures.CalibratedTimestamps)
+            {
+                // Used by IDeviceContext::GetTimestampCalibration()
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+                EnabledExtFeats.CalibratedTimestamps = true;
+            }
+
+            if (DeviceExtFeatures.PipelineCreationFeedback)
+            {
+                // Used to record pipeline cache hits, see IPipelineStateCache::GetStatistics().
+                // The extension is core in Vulkan 1.3.
+                if (PhysicalDevice->IsExtensionSupported(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME))
+                    DeviceExtensions.push_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+                EnabledExtFeats.PipelineCreationFeedback = true;
+            }
+
+            // Presentation extensions are used by the swap chain to limit the frame latency
+            // and to collect the frame pacing statistics.
+            if (Instance->IsExtensionEnabled(VK_KHR_SURFACE_EXTENSION_NAME))
+            {
+                if (DeviceExtFeatures.PresentId.presentId != VK_FALSE && DeviceExtFeatures.PresentWait.presentWait != VK_FALSE)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME));
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+                    DeviceExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+                    EnabledExtFeats.PresentId   = DeviceExtFeatures.PresentId;
+                    EnabledExtFeats.PresentWait = DeviceExtFeatures.PresentWait;
+
+                    *NextExt = &EnabledExtFeats.PresentId;
+                    NextExt  = &EnabledExtFeats.PresentId.pNext;
+
+                    *NextExt = &EnabledExtFeats.PresentWait;
+                    NextExt  = &EnabledExtFeats.PresentWait.pNext;
+                }
+
+                if (DeviceExtFeatures.DisplayTiming)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+                    EnabledExtFeats.DisplayTiming = true;
+                }
+            }
+
+            if (EngineCI.EnableGPUBreadcrumbs)
+            {
+                // Buffer markers survive the device loss in host-visible memory and are preferred
+                // over the checkpoints that can only be queried from the lost queue.
+                if (DeviceExtFeatures.BufferMarker)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_AMD_BUFFER_MARKER_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_AMD_BUFFER_MARKER_EXTENSION_NAME);
+                    EnabledExtFeats.BufferMarker = true;
+                }
+                else if (DeviceExtFeatures.DiagnosticCheckpoints)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME);
+                    EnabledExtFeats.DiagnosticCheckpoints = true;
+                }
+                else
+                {
+                    LOG_WARNING_MESSAGE("GPU breadcrumbs are requested, but the device supports neither VK_AMD_buffer_marker nor VK_NV_device_diagnostic_checkpoints extension.");
+                }
+            }
+
             // Append user-defined features
             *NextExt = EngineCI.pDeviceExtensionFeatures;
         }
@@ -1148,7 +1289,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 LOG_ERROR_MESSAGE("Can not enable extended device features when VK_KHR_get_physical_device_properties2 extension is not supported by device");
         }
 
-        ASSERT_SIZEOF(Diligent::DeviceFeatures, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+        ASSERT_SIZEOF(Diligent::DeviceFeatures, 43, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
         for (Uint32 i = 0; i < EngineCI.DeviceExtensionCount; ++i)
         {
@@ -1212,6 +1353,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
             CommandQueues[0]   = CommandQueuesVk[0];
         }
 
+        StartupStats.DeviceCreationTime = StartupTimer.Lap();
+
         m_OnRenderDeviceCreated = [&](RenderDeviceVkImpl* pRenderDeviceVk) //
         {
             FenceDesc Desc;
@@ -1228,6 +1371,13 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
 
         AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, static_cast<Uint32>(CommandQueues.size()), CommandQueues.data(), EngineCI, AdapterInfo, ppDevice, ppContexts);
 
+        if (*ppDevice != nullptr)
+        {
+            StartupStats.EngineObjectsCreationTime = StartupTimer.Lap();
+            StartupStats.TotalTime                 = StartupTimer.Total();
+            ClassPtrCast<RenderDeviceVkImpl>(*ppDevice)->SetStartupStatistics(StartupStats);
+        }
+
         m_wpDevice = *ppDevice;
     }
     catch (std::runtime_error&)
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "FenceCompletionWaiterVk.hpp"
+
+#include "FenceVkImpl.hpp"
+
+namespace Diligent
+{
+
+FenceCompletionWaiterVk::FenceCompletionWaiterVk(std::shared_ptr<const VulkanUtilities::VulkanLogicalDevice> LogicalDevice) :
+    FenceCompletionWaiter{/*UseThread = */ true},
+    // clang-format off
+    m_LogicalDevice  {std::move(LogicalDevice)},
+    m_WakeUpSemaphore{m_LogicalDevice->CreateTimelineSemaphore(0, "Fence completion waiter wake-up semaphore")}
+// clang-format on
+{
+}
+
+FenceCompletionWaiterVk::~FenceCompletionWaiterVk()
+{
+    StopThread();
+}
+
+void FenceCompletionWaiterVk::WaitForAnyFence(std::vector<WaitItem>& Items, Uint64 WakeCounter)
+{
+    m_WaitSemaphores.clear();
+    m_WaitValues.clear();
+
+    m_WaitSemaphores.push_back(m_WakeUpSemaphore);
+    m_WaitValues.push_back(WakeCounter + 1);
+    for (const auto& Item : Items)
+    {
+        FenceVkImpl* pFenceVk = ClassPtrCast<FenceVkImpl>(Item.pFence);
+        if (!pFenceVk->IsTimelineSemaphore())
+        {
+            // Fences that are not backed by timeline semaphores can only be polled
+            FenceCompletionWaiter::WaitForAnyFence(Items, WakeCounter);
+            return;
+        }
+        m_WaitSemaphores.push_back(pFenceVk->GetVkSemaphore());
+        m_WaitValues.push_back(Item.Value);
+    }
+
+    VkSemaphoreWaitInfo WaitInfo{};
+    WaitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    WaitInfo.pNext          = nullptr;
+    WaitInfo.flags          = VK_SEMAPHORE_WAIT_ANY_BIT;
+    WaitInfo.semaphoreCount = static_cast<uint32_t>(m_WaitSemaphores.size());
+    WaitInfo.pSemaphores    = m_WaitSemaphores.data();
+    WaitInfo.pValues        = m_WaitValues.data();
+
+    auto err = m_LogicalDevice->WaitSemaphores(WaitInfo, UINT64_MAX);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to wait for timeline semaphores");
+    (void)err;
+}
+
+void FenceCompletionWaiterVk::WakeUp(Uint64 WakeCounter)
+{
+    VkSemaphoreSignalInfo SignalInfo{};
+    SignalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    SignalInfo.pNext     = nullptr;
+    SignalInfo.semaphore = m_WakeUpSemaphore;
+    SignalInfo.value     = WakeCounter;
+
+    auto err = m_LogicalDevice->SignalSemaphore(SignalInfo);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to signal the wake-up semaphore");
+    (void)err;
+}
+
+} // namespace Diligent
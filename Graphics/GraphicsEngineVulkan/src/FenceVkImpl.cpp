@@ -49,8 +49,9 @@ FenceVkImpl::FenceVkImpl(IReferenceCounters* pRefCounters,
     }
 // clang-format on
 {
-    if (m_Desc.Type == FENCE_TYPE_GENERAL &&
-        pRenderDeviceVkImpl->GetFeatures().NativeFence)
+    // When timeline semaphores are available, CPU-wait-only fences (including the command queue fences)
+    // also use them, so that command queues do not need to allocate a binary VkFence for every submission.
+    if (pRenderDeviceVkImpl->GetFeatures().NativeFence)
     {
         const auto& LogicalDevice = pRenderDeviceVkImpl->GetLogicalDevice();
         m_TimelineSemaphore       = LogicalDevice.CreateTimelineSemaphore(0, m_Desc.Name);
@@ -78,6 +79,8 @@ FenceVkImpl::FenceVkImpl(IReferenceCounters* pRefCounters,
 
 FenceVkImpl::~FenceVkImpl()
 {
+    UnregisterCompletionCallbacks();
+
     if (IsTimelineSemaphore())
     {
         VERIFY_EXPR(m_SyncPoints.empty());
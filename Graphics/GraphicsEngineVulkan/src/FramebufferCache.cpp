@@ -71,8 +71,17 @@ size_t FramebufferCache::FramebufferCacheKey::GetHash() const
 
 VkFramebuffer FramebufferCache::GetFramebuffer(const FramebufferCacheKey& Key, uint32_t width, uint32_t height, uint32_t layers)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    {
+        std::shared_lock<std::shared_timed_mutex> SharedLock{m_Mutex};
+
+        auto it = m_Cache.find(Key);
+        if (it != m_Cache.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
 
+    // Another thread may have created the framebuffer while we were waiting for the lock
     auto it = m_Cache.find(Key);
     if (it != m_Cache.end())
     {
@@ -138,7 +147,7 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
     // all entries in the m_ViewToKeyMap that refer to all keys with
     // that render pass
 
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
 
     auto equal_range = m_ViewToKeyMap.equal_range(ImgView);
     for (auto it = equal_range.first; it != equal_range.second; ++it)
@@ -150,6 +159,7 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
         {
             m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second), it->second.CommandQueueMask);
             m_Cache.erase(fb_it);
+            m_Version.fetch_add(1);
         }
     }
     m_ViewToKeyMap.erase(equal_range.first, equal_range.second);
@@ -160,7 +170,7 @@ void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
     // TODO: when an image view is released, we need to also destroy
     // all entries in the m_RenderPassToKeyMap that refer to the keys
     // with the same image view
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
 
     auto equal_range = m_RenderPassToKeyMap.equal_range(Pass);
     for (auto it = equal_range.first; it != equal_range.second; ++it)
@@ -172,6 +182,7 @@ void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
         {
             m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second), it->second.CommandQueueMask);
             m_Cache.erase(fb_it);
+            m_Version.fetch_add(1);
         }
     }
     m_RenderPassToKeyMap.erase(equal_range.first, equal_range.second);
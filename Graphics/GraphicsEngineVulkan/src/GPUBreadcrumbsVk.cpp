@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GPUBreadcrumbsVk.hpp"
+
+#include <vector>
+
+#include "RenderDeviceVkImpl.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+GPUBreadcrumbsVk::GPUBreadcrumbsVk(RenderDeviceVkImpl& DeviceVk, const char* ContextName) :
+    m_ContextName{ContextName != nullptr ? ContextName : ""},
+    m_UseBufferMarkers{DeviceVk.GetLogicalDevice().GetEnabledExtFeatures().BufferMarker}
+{
+    VERIFY(IsSupported(DeviceVk), "GPU breadcrumbs are not supported by the device");
+    if (!m_UseBufferMarkers)
+        return;
+
+    VkBufferCreateInfo BufferCI{};
+    BufferCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    BufferCI.size        = CompletedMarkerOffset + sizeof(Uint32);
+    BufferCI.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT; // Required by vkCmdWriteBufferMarkerAMD
+    BufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    const auto& LogicalDevice  = DeviceVk.GetLogicalDevice();
+    const auto& PhysicalDevice = DeviceVk.GetPhysicalDevice();
+
+    m_vkBuffer = LogicalDevice.CreateBuffer(BufferCI, "GPU breadcrumbs buffer");
+
+    // The markers must be visible to the host after the device has been lost,
+    // so they are written directly to the host-visible memory.
+    const auto MemReqs         = LogicalDevice.GetBufferMemoryRequirements(m_vkBuffer);
+    const auto MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    VERIFY(MemoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
+           "Vulkan spec requires that there is a host-visible coherent memory type for every buffer (11.6)");
+
+    m_MemAllocation = DeviceVk.GetGlobalMemoryManager().Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, true, VkMemoryAllocateFlags{0});
+
+    const auto AlignedOffset = AlignUp(m_MemAllocation.UnalignedOffset, MemReqs.alignment);
+
+    auto err = LogicalDevice.BindBufferMemory(m_vkBuffer, m_MemAllocation.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind GPU breadcrumbs buffer memory");
+
+    auto* pMarkers = reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(m_MemAllocation.Page->GetCPUMemory()) + AlignedOffset);
+    pMarkers[0]    = 0;
+    pMarkers[1]    = 0;
+    m_pMarkers     = pMarkers;
+}
+
+bool GPUBreadcrumbsVk::IsSupported(const RenderDeviceVkImpl& DeviceVk)
+{
+    const auto& ExtFeats = DeviceVk.GetLogicalDevice().GetEnabledExtFeatures();
+    return ExtFeats.BufferMarker || ExtFeats.DiagnosticCheckpoints;
+}
+
+void GPUBreadcrumbsVk::BeginDebugGroup(VulkanUtilities::VulkanCommandBuffer& CmdBuff, const char* Name)
+{
+    const Uint32 Marker = m_Breadcrumbs.BeginDebugGroup(Name);
+    WriteStartedMarker(CmdBuff, Marker);
+    EndCommand(CmdBuff, Marker);
+}
+
+void GPUBreadcrumbsVk::EndDebugGroup(VulkanUtilities::VulkanCommandBuffer& CmdBuff)
+{
+    const Uint32 Marker = m_Breadcrumbs.EndDebugGroup();
+    WriteStartedMarker(CmdBuff, Marker);
+    EndCommand(CmdBuff, Marker);
+}
+
+void GPUBreadcrumbsVk::LogDeviceLost(VkQueue vkQueue) const
+{
+    Uint32 LastStarted   = 0;
+    Uint32 LastCompleted = 0;
+    if (m_UseBufferMarkers)
+    {
+        LastStarted   = m_pMarkers[0];
+        LastCompleted = m_pMarkers[1];
+    }
+    else
+    {
+#if DILIGENT_USE_VOLK
+        uint32_t NumCheckpoints = 0;
+        vkGetQueueCheckpointDataNV(vkQueue, &NumCheckpoints, nullptr);
+        std::vector<VkCheckpointDataNV> Checkpoints(NumCheckpoints);
+        for (auto& Checkpoint : Checkpoints)
+            Checkpoint.sType = VK_STRUCTURE_TYPE_CHECKPOINT_DATA_NV;
+        vkGetQueueCheckpointDataNV(vkQueue, &NumCheckpoints, Checkpoints.data());
+
+        for (Uint32 i = 0; i < NumCheckpoints; ++i)
+        {
+            const auto Marker = static_cast<Uint32>(reinterpret_cast<size_t>(Checkpoints[i].pCheckpointMarker));
+            if (Checkpoints[i].stage == VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT)
+                LastStarted = Marker;
+            else if (Checkpoints[i].stage == VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT)
+                LastCompleted = Marker > 1 ? Marker - 1 : 0; // The checkpoint is set before the command
+        }
+#else
+        (void)vkQueue;
+#endif
+    }
+
+    LOG_ERROR_MESSAGE("GPU breadcrumbs of context '", m_ContextName, "'. ", m_Breadcrumbs.GetReport(LastStarted, LastCompleted));
+}
+
+} // namespace Diligent
@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "PipelineLibraryCacheVk.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+PipelineLibraryCacheVk::PipelineLibraryCacheVk(RenderDeviceVkImpl& DeviceVk) noexcept :
+    m_DeviceVkImpl{DeviceVk}
+{}
+
+PipelineLibraryCacheVk::~PipelineLibraryCacheVk()
+{
+    VERIFY(std::all_of(m_Libraries.begin(), m_Libraries.end(), [](const auto& Libs) { return Libs.empty(); }),
+           "Pipeline library cache is not empty. Did you call Destroy?");
+}
+
+void PipelineLibraryCacheVk::Destroy()
+{
+    std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
+
+    // Libraries are never bound to command buffers, so they can be destroyed immediately.
+    for (auto& Libs : m_Libraries)
+        Libs.clear();
+}
+
+VulkanUtilities::PipelineWrapper PipelineLibraryCacheVk::CreateLibrary(const VkGraphicsPipelineCreateInfo& PipelineCI,
+                                                                       LIBRARY_TYPE                        Type,
+                                                                       VkPipelineCache                     vkPSOCache,
+                                                                       const char*                         PipelineName) const noexcept(false)
+{
+    static constexpr VkGraphicsPipelineLibraryFlagsEXT LibraryFlags[] = {
+        VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+        VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT //
+    };
+    static_assert(_countof(LibraryFlags) == LIBRARY_TYPE_COUNT, "Please update the array above");
+
+    static constexpr const char* LibraryNames[] = {
+        "vertex input",
+        "pre-rasterization",
+        "fragment shader",
+        "fragment output" //
+    };
+    static_assert(_countof(LibraryNames) == LIBRARY_TYPE_COUNT, "Please update the array above");
+
+    VkShaderStageFlags LibraryStages = 0;
+    switch (Type)
+    {
+        case LIBRARY_TYPE_PRE_RASTERIZATION:
+            LibraryStages =
+                VK_SHADER_STAGE_VERTEX_BIT |
+                VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT |
+                VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT |
+                VK_SHADER_STAGE_GEOMETRY_BIT;
+            break;
+
+        case LIBRARY_TYPE_FRAGMENT_SHADER:
+            LibraryStages = VK_SHADER_STAGE_FRAGMENT_BIT;
+            break;
+
+        default:
+            // Vertex input and fragment output libraries do not contain shaders
+            break;
+    }
+
+    std::vector<VkPipelineShaderStageCreateInfo> Stages;
+    for (uint32_t s = 0; s < PipelineCI.stageCount; ++s)
+    {
+        if ((PipelineCI.pStages[s].stage & LibraryStages) != 0)
+            Stages.push_back(PipelineCI.pStages[s]);
+    }
+
+    VkGraphicsPipelineLibraryCreateInfoEXT LibraryCI{};
+    LibraryCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    LibraryCI.pNext = PipelineCI.pNext;
+    LibraryCI.flags = LibraryFlags[Type];
+
+    // State that is not associated with the library type is ignored
+    VkGraphicsPipelineCreateInfo LibPipelineCI = PipelineCI;
+    LibPipelineCI.pNext                        = &LibraryCI;
+    // Retain link-time optimization info to let the pipeline be optimized when the libraries are linked
+    LibPipelineCI.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    LibPipelineCI.stageCount = static_cast<uint32_t>(Stages.size());
+    LibPipelineCI.pStages    = !Stages.empty() ? Stages.data() : nullptr;
+
+    const auto LibName = std::string{PipelineName != nullptr ? PipelineName : ""} + " - " + LibraryNames[Type] + " library";
+    return m_DeviceVkImpl.GetLogicalDevice().CreateGraphicsPipeline(LibPipelineCI, vkPSOCache, LibName.c_str());
+}
+
+PipelineLibraryCacheVk::LibraryHandles PipelineLibraryCacheVk::GetLibraries(const VkGraphicsPipelineCreateInfo& PipelineCI,
+                                                                            const LibraryHashes&                Hashes,
+                                                                            VkPipelineCache                     vkPSOCache,
+                                                                            const char*                         PipelineName) noexcept(false)
+{
+    LibraryHandles Libraries{};
+    {
+        std::shared_lock<std::shared_timed_mutex> SharedLock{m_Mutex};
+        for (Uint32 Type = 0; Type < LIBRARY_TYPE_COUNT; ++Type)
+        {
+            auto it = m_Libraries[Type].find(Hashes[Type]);
+            if (it != m_Libraries[Type].end())
+                Libraries[Type] = it->second;
+        }
+    }
+
+    for (Uint32 Type = 0; Type < LIBRARY_TYPE_COUNT; ++Type)
+    {
+        if (Libraries[Type] != VK_NULL_HANDLE)
+            continue;
+
+        // Create the library without holding the lock to not block other threads
+        auto NewLibrary = CreateLibrary(PipelineCI, static_cast<LIBRARY_TYPE>(Type), vkPSOCache, PipelineName);
+
+        std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
+        // Another thread may have created the same library while we were compiling ours,
+        // in which case the existing library is used and the new one is destroyed.
+        auto it_inserted = m_Libraries[Type].emplace(Hashes[Type], std::move(NewLibrary));
+        Libraries[Type]  = it_inserted.first->second;
+    }
+
+    return Libraries;
+}
+
+VulkanUtilities::PipelineWrapper PipelineLibraryCacheVk::Link(const LibraryHandles& Libraries,
+                                                              VkPipelineLayout      vkLayout,
+                                                              bool                  Optimize,
+                                                              VkPipelineCache       vkPSOCache,
+                                                              const char*           PipelineName) const noexcept(false)
+{
+    VkPipelineLibraryCreateInfoKHR LinkCI{};
+    LinkCI.sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    LinkCI.pNext        = nullptr;
+    LinkCI.libraryCount = static_cast<uint32_t>(Libraries.size());
+    LinkCI.pLibraries   = Libraries.data();
+
+    VkGraphicsPipelineCreateInfo PipelineCI{};
+    PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    PipelineCI.pNext = &LinkCI;
+#ifdef DILIGENT_DEBUG
+    PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
+#endif
+    if (Optimize)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+    PipelineCI.layout             = vkLayout;
+    PipelineCI.basePipelineHandle = VK_NULL_HANDLE;
+    PipelineCI.basePipelineIndex  = -1;
+
+    return m_DeviceVkImpl.GetLogicalDevice().CreateGraphicsPipeline(PipelineCI, vkPSOCache, PipelineName);
+}
+
+} // namespace Diligent
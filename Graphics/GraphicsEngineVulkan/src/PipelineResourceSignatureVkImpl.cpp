@@ -265,7 +265,8 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
     std::array<std::vector<VkDescriptorSetLayoutBinding>, DESCRIPTOR_SET_ID_NUM_SETS> vkSetLayoutBindings;
 
-    DynamicLinearAllocator TempAllocator{GetRawAllocator(), 256};
+    DynamicLinearAllocatorScope TempAllocatorScope;
+    auto&                       TempAllocator = TempAllocatorScope.GetAllocator();
 
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
     {
@@ -488,7 +489,90 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
             m_VkDescrSetLayouts[i]   = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
         }
         VERIFY_EXPR(NumSets == GetNumDescriptorSets());
+
+        // Descriptor update templates are core in Vulkan 1.1
+        if (GetDevice()->GetPhysicalDevice().GetVkVersion() >= VK_API_VERSION_1_1)
+            CreateDescriptorUpdateTemplates();
+    }
+}
+
+void PipelineResourceSignatureVkImpl::CreateDescriptorUpdateTemplates()
+{
+    constexpr auto CacheType = ResourceCacheContentType::SRB;
+
+    std::array<std::vector<VkDescriptorUpdateTemplateEntry>, DESCRIPTOR_SET_ID_NUM_SETS> vkTemplateEntries;
+    for (Uint32 r = 0; r < m_Desc.NumResources; ++r)
+    {
+        const auto& ResDesc = m_Desc.Resources[r];
+        const auto& Attr    = GetResourceAttribs(r);
+        if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER && Attr.IsImmutableSamplerAssigned())
+            continue; // Immutable separate samplers are never written
+
+        // The info of the resource at cache offset N is located at N * sizeof(DescriptorInfo),
+        // see ShaderResourceCacheVk::DescriptorSet::GetDescriptorInfos().
+        VkDescriptorUpdateTemplateEntry Entry{};
+        Entry.dstBinding      = Attr.BindingIndex;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Attr.ArraySize;
+        Entry.descriptorType  = DescriptorTypeToVkDescriptorType(Attr.GetDescriptorType());
+        Entry.offset          = size_t{Attr.CacheOffset(CacheType)} * sizeof(ShaderResourceCacheVk::DescriptorInfo);
+        Entry.stride          = sizeof(ShaderResourceCacheVk::DescriptorInfo);
+        vkTemplateEntries[VarTypeToDescriptorSetId(ResDesc.VarType)].push_back(Entry);
+    }
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    for (size_t SetId = 0; SetId < vkTemplateEntries.size(); ++SetId)
+    {
+        const auto& Entries = vkTemplateEntries[SetId];
+        if (Entries.empty())
+            continue;
+        VERIFY_EXPR(m_VkDescrSetLayouts[SetId]);
+
+        VkDescriptorUpdateTemplateCreateInfo TemplateCI{};
+        TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        TemplateCI.pNext                      = nullptr;
+        TemplateCI.flags                      = 0;
+        TemplateCI.descriptorUpdateEntryCount = StaticCast<uint32_t>(Entries.size());
+        TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+        TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        TemplateCI.descriptorSetLayout        = m_VkDescrSetLayouts[SetId];
+
+        m_VkDescrUpdateTemplates[SetId] = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI, m_Desc.Name);
+    }
+}
+
+bool PipelineResourceSignatureVkImpl::UpdateDescriptorSetWithTemplate(const ShaderResourceCacheVk& ResourceCache,
+                                                                      DESCRIPTOR_SET_ID            SetId,
+                                                                      VkDescriptorSet              vkSet) const
+{
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+    VERIFY_EXPR(vkSet != VK_NULL_HANDLE);
+
+    const auto& vkTemplate = m_VkDescrUpdateTemplates[SetId];
+    if (!vkTemplate)
+        return false;
+
+    const auto  SetIdx   = SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE ? GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>() : GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
+    const auto& DescrSet = ResourceCache.GetDescriptorSet(SetIdx);
+    const auto  NumInfos = DescrSet.GetSize();
+
+    // Do not zero-initialize!
+    static constexpr Uint32                            MaxLocalInfos = 64;
+    ShaderResourceCacheVk::DescriptorInfo              LocalInfos[MaxLocalInfos];
+    std::vector<ShaderResourceCacheVk::DescriptorInfo> HeapInfos;
+
+    auto* pInfos = LocalInfos;
+    if (NumInfos > MaxLocalInfos)
+    {
+        HeapInfos.resize(NumInfos);
+        pInfos = HeapInfos.data();
     }
+
+    if (!DescrSet.GetDescriptorInfos(pInfos))
+        return false;
+
+    GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(vkSet, vkTemplate, pInfos);
+    return true;
 }
 
 PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
@@ -504,6 +588,12 @@ void PipelineResourceSignatureVkImpl::Destruct()
             GetDevice()->SafeReleaseDeviceObject(std::move(Layout), ~0ull);
     }
 
+    for (auto& Template : m_VkDescrUpdateTemplates)
+    {
+        if (Template)
+            GetDevice()->SafeReleaseDeviceObject(std::move(Template), ~0ull);
+    }
+
     if (m_ImmutableSamplers != nullptr)
     {
         for (Uint32 i = 0; i < m_Desc.NumImmutableSamplers; ++i)
@@ -570,6 +660,25 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
     const auto  SrcCacheType     = SrcResourceCache.GetContentType();
     const auto  DstCacheType     = DstResourceCache.GetContentType();
 
+    // If the static/mutable set of an SRB only contains static resources and all of them are initialized,
+    // write the entire set with a single template update rather than one descriptor at a time.
+    const auto MutableResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    bool       WriteWithTemplate  = (DstCacheType == ResourceCacheContentType::SRB &&
+                                  m_VkDescrUpdateTemplates[DESCRIPTOR_SET_ID_STATIC_MUTABLE] &&
+                                  MutableResIdxRange.first == MutableResIdxRange.second);
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second && WriteWithTemplate; ++r)
+    {
+        const auto& ResDesc = GetResourceDesc(r);
+        const auto& Attr    = GetResourceAttribs(r);
+        if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize && WriteWithTemplate; ++ArrInd)
+            WriteWithTemplate = !SrcDescrSet.GetResource(Attr.CacheOffset(SrcCacheType) + ArrInd).IsNull();
+    }
+    // Null logical device makes SetResource() only update the cache
+    const auto* pLogicalDevice = WriteWithTemplate ? nullptr : &GetDevice()->GetLogicalDevice();
+
     for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
     {
         const auto& ResDesc = GetResourceDesc(r);
@@ -599,7 +708,7 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
             if (pCachedResource != pObject)
             {
                 DEV_CHECK_ERR(pCachedResource == nullptr, "Static resource has already been initialized, and the new resource does not match previously assigned resource");
-                DstResourceCache.SetResource(&GetDevice()->GetLogicalDevice(),
+                DstResourceCache.SetResource(pLogicalDevice,
                                              StaticSetIdx,
                                              DstCacheOffset,
                                              {
@@ -613,6 +722,13 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
         }
     }
 
+    if (WriteWithTemplate)
+    {
+        const auto Written = UpdateDescriptorSetWithTemplate(DstResourceCache, DESCRIPTOR_SET_ID_STATIC_MUTABLE, DstDescrSet.GetVkDescriptorSet());
+        VERIFY(Written, "All resources in the static/mutable set are initialized, so the template update is not expected to fail");
+        (void)Written;
+    }
+
 #ifdef DILIGENT_DEBUG
     DstResourceCache.DbgVerifyDynamicBuffersCounter();
 #endif
@@ -639,6 +755,11 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
+    if (UpdateDescriptorSetWithTemplate(ResourceCache, DESCRIPTOR_SET_ID_DYNAMIC, vkDynamicDescriptorSet))
+        return;
+
+    // Some resources are null or the update template is not available: write the descriptors individually,
+    // skipping null resources.
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
     static constexpr size_t BuffUpdateBatchSize         = 2;
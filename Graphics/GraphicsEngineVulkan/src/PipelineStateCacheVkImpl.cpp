@@ -29,10 +29,72 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Vulkan pipeline cache data is only compatible with the same device, driver version and pipeline cache UUID.
+std::string GetPipelineCacheDeviceKey(const VkPhysicalDeviceProperties& Props)
+{
+    std::stringstream ss;
+    ss << std::hex << std::uppercase << std::setfill('0')
+       << std::setw(4) << Props.vendorID << '_'
+       << std::setw(4) << Props.deviceID << '_'
+       << std::setw(8) << Props.driverVersion << '_';
+    for (auto b : Props.pipelineCacheUUID)
+        ss << std::setw(2) << Uint32{b};
+    return ss.str();
+}
+
+// Shader module identifiers are stored after the Vulkan pipeline cache data:
+//
+//   | Vulkan cache data | Entry 0 | ... | Entry N-1 | ShaderModuleIdentifiersFooter |
+//
+// Every entry is the shader module key followed by the identifier size and the identifier bytes.
+struct ShaderModuleIdentifiersFooter
+{
+    static constexpr Uint32 ExpectedMagic = 0x44494D53; // 'SMID'
+
+    Uint64 EntriesSize = 0;
+    Uint32 NumEntries  = 0;
+    Uint32 Magic       = ExpectedMagic;
+    Uint8  AlgorithmUUID[VK_UUID_SIZE] = {};
+};
+constexpr Uint32 ShaderModuleIdentifiersFooter::ExpectedMagic;
+
+constexpr size_t ShaderModuleIdentifierEntryHeaderSize = sizeof(Uint64) + sizeof(Uint32) * 3;
+
+// Returns the size of the Vulkan pipeline cache data in the blob, or the blob size if there is no footer.
+size_t GetVkPipelineCacheDataSize(const void* pData, size_t Size)
+{
+    if (pData == nullptr || Size < sizeof(ShaderModuleIdentifiersFooter))
+        return Size;
+
+    ShaderModuleIdentifiersFooter Footer;
+    std::memcpy(&Footer, static_cast<const Uint8*>(pData) + Size - sizeof(Footer), sizeof(Footer));
+    if (Footer.Magic != ShaderModuleIdentifiersFooter::ExpectedMagic || Footer.EntriesSize > Size - sizeof(Footer))
+        return Size;
+
+    return Size - sizeof(Footer) - static_cast<size_t>(Footer.EntriesSize);
+}
+
+} // namespace
+
+PipelineStateCacheVkImpl::ShaderModuleKey::ShaderModuleKey(const std::vector<uint32_t>& PatchedSPIRV, bool _StripReflection) noexcept :
+    Hash{ComputeHashRaw(PatchedSPIRV.data(), PatchedSPIRV.size() * sizeof(uint32_t))},
+    CodeSize{static_cast<Uint32>(PatchedSPIRV.size())},
+    StripReflection{_StripReflection ? 1u : 0u}
+{
+}
+
 PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
                                                    RenderDeviceVkImpl*                 pRenderDeviceVk,
                                                    const PipelineStateCacheCreateInfo& CreateInfo) :
@@ -43,21 +105,45 @@ PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*
         pRenderDeviceVk,
         CreateInfo,
         false
+    },
+    m_UseShaderModuleIdentifiers
+    {
+        pRenderDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().ShaderModuleIdentifier.shaderModuleIdentifier != VK_FALSE
     }
 // clang-format on
 {
     // Separate load/store is not supported in Vulkan.
     m_Desc.Mode |= PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE;
 
+    const auto& Props = GetDevice()->GetPhysicalDevice().GetProperties();
+
+    const void* pCacheData    = CreateInfo.pCacheData;
+    size_t      CacheDataSize = CreateInfo.CacheDataSize;
+
+    auto pFileData = InitCacheFile(CreateInfo, GetPipelineCacheDeviceKey(Props).c_str());
+    if (pFileData)
+    {
+        pCacheData    = pFileData->GetConstDataPtr();
+        CacheDataSize = pFileData->GetSize();
+    }
+
+    if (pCacheData != nullptr)
+    {
+        const auto VkCacheDataSize = GetVkPipelineCacheDataSize(pCacheData, CacheDataSize);
+        if (VkCacheDataSize < CacheDataSize)
+        {
+            LoadShaderModuleIdentifiers(static_cast<const Uint8*>(pCacheData) + VkCacheDataSize, CacheDataSize - VkCacheDataSize);
+            CacheDataSize = VkCacheDataSize;
+        }
+    }
+
     VkPipelineCacheCreateInfo VkPipelineStateCacheCI{};
     VkPipelineStateCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
-    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > sizeof(VkPipelineCacheHeaderVersionOne))
+    if (pCacheData != nullptr && CacheDataSize > sizeof(VkPipelineCacheHeaderVersionOne))
     {
-        const auto& Props = GetDevice()->GetPhysicalDevice().GetProperties();
-
         VkPipelineCacheHeaderVersionOne HeaderVersion;
-        std::memcpy(&HeaderVersion, CreateInfo.pCacheData, sizeof(HeaderVersion));
+        std::memcpy(&HeaderVersion, pCacheData, sizeof(HeaderVersion));
 
         if (HeaderVersion.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
             HeaderVersion.headerSize == 32 && // from specs
@@ -65,8 +151,12 @@ PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*
             HeaderVersion.vendorID == Props.vendorID &&
             std::memcmp(HeaderVersion.pipelineCacheUUID, Props.pipelineCacheUUID, sizeof(HeaderVersion.pipelineCacheUUID)) == 0)
         {
-            VkPipelineStateCacheCI.initialDataSize = CreateInfo.CacheDataSize;
-            VkPipelineStateCacheCI.pInitialData    = CreateInfo.pCacheData;
+            VkPipelineStateCacheCI.initialDataSize = CacheDataSize;
+            VkPipelineStateCacheCI.pInitialData    = pCacheData;
+        }
+        else if (pFileData)
+        {
+            LOG_INFO_MESSAGE("Pipeline state cache file is not compatible with the device and will be overwritten.");
         }
     }
 
@@ -75,6 +165,8 @@ PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*
 
 PipelineStateCacheVkImpl::~PipelineStateCacheVkImpl()
 {
+    FlushCacheFile();
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_PipelineStateCache != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_PipelineStateCache), ~Uint64{0});
@@ -91,12 +183,163 @@ void PipelineStateCacheVkImpl::GetData(IDataBlob** ppBlob)
     if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, nullptr) != VK_SUCCESS)
         return;
 
-    auto pDataBlob = DataBlobImpl::Create(DataSize);
+    std::shared_lock<std::shared_timed_mutex> Lock{m_IdentifiersMtx};
+
+    size_t EntriesSize = 0;
+    for (const auto& it : m_ShaderModuleIdentifiers)
+        EntriesSize += ShaderModuleIdentifierEntryHeaderSize + it.second.size();
+    const size_t FooterSize = !m_ShaderModuleIdentifiers.empty() ? sizeof(ShaderModuleIdentifiersFooter) : 0;
+
+    auto pDataBlob = DataBlobImpl::Create(DataSize + EntriesSize + FooterSize);
 
     if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, pDataBlob->GetDataPtr()) != VK_SUCCESS)
         return;
 
+    // The cache may have shrunk between the two calls
+    pDataBlob->Resize(DataSize + EntriesSize + FooterSize);
+
+    if (FooterSize != 0)
+    {
+        auto* pDst  = pDataBlob->GetDataPtr<Uint8>() + DataSize;
+        auto  Write = [&pDst](const void* pSrc, size_t Size) {
+            std::memcpy(pDst, pSrc, Size);
+            pDst += Size;
+        };
+
+        for (const auto& it : m_ShaderModuleIdentifiers)
+        {
+            const auto   IdSize = static_cast<Uint32>(it.second.size());
+            const Uint64 Hash   = it.first.Hash;
+            Write(&Hash, sizeof(Hash));
+            Write(&it.first.CodeSize, sizeof(it.first.CodeSize));
+            Write(&it.first.StripReflection, sizeof(it.first.StripReflection));
+            Write(&IdSize, sizeof(IdSize));
+            Write(it.second.data(), IdSize);
+        }
+
+        ShaderModuleIdentifiersFooter Footer;
+        Footer.EntriesSize = EntriesSize;
+        Footer.NumEntries  = static_cast<Uint32>(m_ShaderModuleIdentifiers.size());
+        std::memcpy(Footer.AlgorithmUUID, GetDevice()->GetPhysicalDevice().GetExtProperties().ShaderModuleIdentifier.shaderModuleIdentifierAlgorithmUUID, VK_UUID_SIZE);
+        Write(&Footer, sizeof(Footer));
+    }
+
     *ppBlob = pDataBlob.Detach();
 }
 
+Bool PipelineStateCacheVkImpl::Merge(Uint32 NumSrcCaches, IPipelineStateCache** ppSrcCaches)
+{
+    DEV_CHECK_ERR(NumSrcCaches == 0 || ppSrcCaches != nullptr, "ppSrcCaches must not be null");
+
+    std::vector<VkPipelineCache> vkSrcCaches;
+    vkSrcCaches.reserve(NumSrcCaches);
+    for (Uint32 i = 0; i < NumSrcCaches; ++i)
+    {
+        auto* pSrcCacheVk = ClassPtrCast<PipelineStateCacheVkImpl>(ppSrcCaches[i]);
+        if (pSrcCacheVk == nullptr)
+            continue;
+
+        DEV_CHECK_ERR(pSrcCacheVk != this, "Pipeline state cache can't be merged with itself");
+        DEV_CHECK_ERR(pSrcCacheVk->GetDevice() == GetDevice(), "Source cache '", pSrcCacheVk->GetDesc().Name, "' was created by another device");
+        vkSrcCaches.push_back(pSrcCacheVk->GetVkPipelineCache());
+
+        if (m_UseShaderModuleIdentifiers)
+        {
+            // Copy the identifiers first to never hold the locks of both caches at the same time
+            decltype(m_ShaderModuleIdentifiers) SrcIdentifiers;
+            {
+                std::shared_lock<std::shared_timed_mutex> SrcLock{pSrcCacheVk->m_IdentifiersMtx};
+                SrcIdentifiers = pSrcCacheVk->m_ShaderModuleIdentifiers;
+            }
+            std::unique_lock<std::shared_timed_mutex> Lock{m_IdentifiersMtx};
+            m_ShaderModuleIdentifiers.insert(SrcIdentifiers.begin(), SrcIdentifiers.end());
+        }
+    }
+    if (vkSrcCaches.empty())
+        return True;
+
+    // Host access to the destination cache must be externally synchronized
+    std::lock_guard<std::mutex> Lock{m_MergeMtx};
+
+    const auto vkDevice = m_pDevice->GetLogicalDevice().GetVkDevice();
+    const auto err      = vkMergePipelineCaches(vkDevice, m_PipelineStateCache, static_cast<uint32_t>(vkSrcCaches.size()), vkSrcCaches.data());
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to merge pipeline caches into '", m_Desc.Name, "'");
+        return False;
+    }
+
+    return True;
+}
+
+void PipelineStateCacheVkImpl::LoadShaderModuleIdentifiers(const Uint8* pData, size_t Size)
+{
+    if (!m_UseShaderModuleIdentifiers)
+        return;
+
+    VERIFY_EXPR(Size >= sizeof(ShaderModuleIdentifiersFooter));
+    ShaderModuleIdentifiersFooter Footer;
+    std::memcpy(&Footer, pData + Size - sizeof(Footer), sizeof(Footer));
+
+    // Identifiers are only compatible with the same identifier algorithm
+    const auto& Props = GetDevice()->GetPhysicalDevice().GetExtProperties().ShaderModuleIdentifier;
+    if (std::memcmp(Footer.AlgorithmUUID, Props.shaderModuleIdentifierAlgorithmUUID, VK_UUID_SIZE) != 0)
+        return;
+
+    const auto* pEnd = pData + Size - sizeof(Footer);
+    auto        Read = [&pData, pEnd](void* pDst, size_t DstSize) {
+        if (pData + DstSize > pEnd)
+            return false;
+        std::memcpy(pDst, pData, DstSize);
+        pData += DstSize;
+        return true;
+    };
+
+    std::unique_lock<std::shared_timed_mutex> Lock{m_IdentifiersMtx};
+    for (Uint32 i = 0; i < Footer.NumEntries; ++i)
+    {
+        Uint64          Hash   = 0;
+        Uint32          IdSize = 0;
+        ShaderModuleKey Key;
+        if (!Read(&Hash, sizeof(Hash)) ||
+            !Read(&Key.CodeSize, sizeof(Key.CodeSize)) ||
+            !Read(&Key.StripReflection, sizeof(Key.StripReflection)) ||
+            !Read(&IdSize, sizeof(IdSize)) ||
+            IdSize == 0 || IdSize > VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT)
+        {
+            LOG_WARNING_MESSAGE("Shader module identifiers in pipeline state cache '", m_Desc.Name, "' are corrupted and will be ignored.");
+            m_ShaderModuleIdentifiers.clear();
+            return;
+        }
+        Key.Hash = Hash;
+
+        std::vector<Uint8> Identifier(IdSize);
+        if (!Read(Identifier.data(), IdSize))
+        {
+            LOG_WARNING_MESSAGE("Shader module identifiers in pipeline state cache '", m_Desc.Name, "' are corrupted and will be ignored.");
+            m_ShaderModuleIdentifiers.clear();
+            return;
+        }
+        m_ShaderModuleIdentifiers.emplace(Key, std::move(Identifier));
+    }
+}
+
+const std::vector<Uint8>* PipelineStateCacheVkImpl::FindShaderModuleIdentifier(const ShaderModuleKey& Key) const
+{
+    std::shared_lock<std::shared_timed_mutex> Lock{m_IdentifiersMtx};
+
+    auto it = m_ShaderModuleIdentifiers.find(Key);
+    return it != m_ShaderModuleIdentifiers.end() ? &it->second : nullptr;
+}
+
+void PipelineStateCacheVkImpl::AddShaderModuleIdentifier(const ShaderModuleKey& Key, const VkShaderModuleIdentifierEXT& Identifier)
+{
+    VERIFY_EXPR(m_UseShaderModuleIdentifiers);
+    if (Identifier.identifierSize == 0 || Identifier.identifierSize > VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT)
+        return;
+
+    std::unique_lock<std::shared_timed_mutex> Lock{m_IdentifiersMtx};
+    m_ShaderModuleIdentifiers.emplace(Key, std::vector<Uint8>{Identifier.identifier, Identifier.identifier + Identifier.identifierSize});
+}
+
 } // namespace Diligent
@@ -30,6 +30,7 @@
 #include "PipelineStateVkImpl.hpp"
 
 #include <array>
+#include <chrono>
 #include <unordered_map>
 
 #include "RenderDeviceVkImpl.hpp"
@@ -42,6 +43,7 @@
 #include "VulkanTypeConversions.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 #if !DILIGENT_NO_HLSL
 #    include "SPIRVTools.hpp"
@@ -55,18 +57,15 @@ constexpr INTERFACE_ID PipelineStateVkImpl::IID_InternalImpl;
 namespace
 {
 
-void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
-                              PipelineStateVkImpl::TShaderStages&                ShaderStages,
-                              std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
-                              std::vector<VkPipelineShaderStageCreateInfo>&      Stages)
+void InitPipelineShaderStages(const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                              std::vector<VkPipelineShaderStageCreateInfo>& Stages)
 {
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const auto& Shaders    = ShaderStages[s].Shaders;
-        auto&       SPIRVs     = ShaderStages[s].SPIRVs;
         const auto  ShaderType = ShaderStages[s].Type;
 
-        VERIFY_EXPR(Shaders.size() == SPIRVs.size());
+        VERIFY_EXPR(Shaders.size() == ShaderStages[s].SPIRVs.size());
 
         VkPipelineShaderStageCreateInfo StageCI{};
         StageCI.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -74,47 +73,218 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
         StageCI.flags = 0; //  reserved for future use
         StageCI.stage = ShaderTypeToVkShaderStageFlagBit(ShaderType);
 
-        VkShaderModuleCreateInfo ShaderModuleCI{};
-        ShaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        ShaderModuleCI.pNext = nullptr;
-        ShaderModuleCI.flags = 0;
-
         for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            auto* pShader = Shaders[i];
-            auto& SPIRV   = SPIRVs[i];
+            StageCI.module              = VK_NULL_HANDLE; // Initialized by InitShaderModules()
+            StageCI.pName               = Shaders[i]->GetEntryPoint();
+            StageCI.pSpecializationInfo = nullptr;
 
-            ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
-            ShaderModuleCI.pCode    = SPIRV.data();
+            Stages.push_back(StageCI);
+        }
+    }
+}
 
-            ShaderModules.push_back(LogicalDevice.CreateShaderModule(ShaderModuleCI, pShader->GetDesc().Name));
+void InitShaderModules(const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                       bool                                          StripReflection,
+                       std::vector<VkPipelineShaderStageCreateInfo>& Stages)
+{
+    size_t StageIdx = 0;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (size_t i = 0; i < Stage.Shaders.size(); ++i, ++StageIdx)
+        {
+            // Shaders cache the modules, so pipelines that use the same shader
+            // with compatible resource layouts share the module.
+            Stages[StageIdx].module = Stage.Shaders[i]->GetPatchedShaderModule(Stage.SPIRVs[i], StripReflection);
+        }
+    }
+    VERIFY_EXPR(StageIdx == Stages.size());
+}
 
-            StageCI.module              = ShaderModules.back();
-            StageCI.pName               = pShader->GetEntryPoint();
-            StageCI.pSpecializationInfo = nullptr;
+// Creates the pipeline from the shader module identifiers (VK_EXT_shader_module_identifier) stored
+// in the pipeline state cache, so that the pipelines found in the cache are created without the SPIR-V.
+// When the identifiers are not available or the pipeline is not in the cache, falls back to the shader
+// modules and records their identifiers in the cache.
+template <typename CreatePipelineType>
+void CreatePipelineFromShaderStages(const VulkanUtilities::VulkanLogicalDevice&   LogicalDevice,
+                                    const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                                    bool                                          StripReflection,
+                                    std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                                    PipelineStateCacheVkImpl*                     pPSOCache,
+                                    const VulkanUtilities::PipelineWrapper&       Pipeline,
+                                    CreatePipelineType&&                          CreatePipeline)
+{
+    std::vector<PipelineStateCacheVkImpl::ShaderModuleKey> Keys;
+    if (pPSOCache != nullptr && pPSOCache->UsesShaderModuleIdentifiers())
+    {
+        Keys.reserve(Stages.size());
+        for (const auto& Stage : ShaderStages)
+        {
+            for (const auto& SPIRV : Stage.SPIRVs)
+                Keys.emplace_back(SPIRV, StripReflection);
+        }
+        VERIFY_EXPR(Keys.size() == Stages.size());
 
-            Stages.push_back(StageCI);
+        std::vector<VkPipelineShaderStageModuleIdentifierCreateInfoEXT> IdentifierCIs(Stages.size());
+        for (size_t i = 0; i < Stages.size(); ++i)
+        {
+            const auto* pIdentifier = pPSOCache->FindShaderModuleIdentifier(Keys[i]);
+            if (pIdentifier == nullptr)
+            {
+                IdentifierCIs.clear();
+                break;
+            }
+
+            auto& IdentifierCI          = IdentifierCIs[i];
+            IdentifierCI.sType          = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_MODULE_IDENTIFIER_CREATE_INFO_EXT;
+            IdentifierCI.pNext          = nullptr;
+            IdentifierCI.identifierSize = static_cast<uint32_t>(pIdentifier->size());
+            IdentifierCI.pIdentifier    = pIdentifier->data();
+        }
+
+        if (!IdentifierCIs.empty())
+        {
+            for (size_t i = 0; i < Stages.size(); ++i)
+                Stages[i].pNext = &IdentifierCIs[i];
+
+            // Pipeline creation fails with VK_PIPELINE_COMPILE_REQUIRED if the pipeline is not in the cache
+            CreatePipeline(VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT);
+
+            for (auto& Stage : Stages)
+                Stage.pNext = nullptr;
+
+            if (Pipeline != VK_NULL_HANDLE)
+                return;
         }
     }
 
-    VERIFY_EXPR(ShaderModules.size() == Stages.size());
+    InitShaderModules(ShaderStages, StripReflection, Stages);
+    CreatePipeline(VkPipelineCreateFlags{0});
+
+    for (size_t i = 0; i < Keys.size(); ++i)
+    {
+        if (pPSOCache->FindShaderModuleIdentifier(Keys[i]) != nullptr)
+            continue;
+
+        VkShaderModuleIdentifierEXT Identifier;
+        LogicalDevice.GetShaderModuleIdentifier(Stages[i].module, Identifier);
+        pPSOCache->AddShaderModuleIdentifier(Keys[i], Identifier);
+    }
 }
 
+// Collects the pipeline creation feedback (VK_EXT_pipeline_creation_feedback) and records it
+// in the PSO cache statistics and in the compilation record of the pipeline.
+class PipelineCreationFeedbackVk
+{
+public:
+    PipelineCreationFeedbackVk(RenderDeviceVkImpl*       pDeviceVk,
+                               PipelineStateCacheVkImpl* pPSOCache,
+                               uint32_t                  StageCount) :
+        m_pDevice{pDeviceVk},
+        m_pPSOCache{pPSOCache},
+        m_IsEnabled{pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().PipelineCreationFeedback},
+        m_StartTime{std::chrono::steady_clock::now()}
+    {
+        if (!m_IsEnabled)
+            return;
+
+        m_StageFeedbacks.resize(StageCount);
+
+        m_CreateInfo.sType                              = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+        m_CreateInfo.pNext                              = nullptr;
+        m_CreateInfo.pPipelineCreationFeedback          = &m_Feedback;
+        m_CreateInfo.pipelineStageCreationFeedbackCount = StageCount;
+        m_CreateInfo.pPipelineStageCreationFeedbacks    = m_StageFeedbacks.data();
+    }
+
+    /// Adds the feedback structure to the pNext chain of the pipeline create info.
+    template <typename PipelineCreateInfoType>
+    void Chain(PipelineCreateInfoType& PipelineCI)
+    {
+        if (!m_IsEnabled)
+            return;
+
+        m_CreateInfo.pNext = PipelineCI.pNext;
+        PipelineCI.pNext   = &m_CreateInfo;
+    }
+
+    /// Records the feedback for the pipeline created from the given stages.
+    void Record(const VkPipelineShaderStageCreateInfo* pStages) const
+    {
+        // The application pipeline cache hit flag is only meaningful if the pipeline is created with a cache
+        const bool HasCache = m_pPSOCache != nullptr;
+
+        PIPELINE_CACHE_RESULT CacheResult    = PIPELINE_CACHE_RESULT_UNKNOWN;
+        Uint64                DriverDuration = 0;
+        if (m_IsEnabled && (m_Feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) != 0)
+        {
+            if (HasCache)
+                CacheResult = GetCacheResult(m_Feedback.flags);
+            DriverDuration = m_Feedback.duration / 1000;
+        }
+
+        if (HasCache)
+        {
+            const auto MeasuredDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+            m_pPSOCache->OnPipelineCreated(CacheResult, DriverDuration != 0 ? DriverDuration : static_cast<Uint64>(MeasuredDuration));
+            if (CacheResult != PIPELINE_CACHE_RESULT_UNKNOWN)
+                m_pDevice->OnPipelineCacheLookup(CacheResult == PIPELINE_CACHE_RESULT_HIT);
+        }
+
+        auto* pScope = CompilationRecordScope::GetCurrent();
+        if (pScope == nullptr)
+            return;
+
+        pScope->SetPipelineFeedback(CacheResult, DriverDuration);
+        for (size_t i = 0; i < m_StageFeedbacks.size(); ++i)
+        {
+            const auto& StageFeedback = m_StageFeedbacks[i];
+            if ((StageFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) == 0)
+                continue;
+
+            pScope->AddStageFeedback(VkShaderStageFlagsToShaderTypes(pStages[i].stage),
+                                     HasCache ? GetCacheResult(StageFeedback.flags) : PIPELINE_CACHE_RESULT_UNKNOWN,
+                                     StageFeedback.duration / 1000);
+        }
+    }
+
+private:
+    static PIPELINE_CACHE_RESULT GetCacheResult(VkPipelineCreationFeedbackFlagsEXT Flags)
+    {
+        return (Flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT) != 0 ?
+            PIPELINE_CACHE_RESULT_HIT :
+            PIPELINE_CACHE_RESULT_MISS;
+    }
+
+private:
+    RenderDeviceVkImpl* const       m_pDevice;
+    PipelineStateCacheVkImpl* const m_pPSOCache;
+    const bool                      m_IsEnabled;
+
+    const std::chrono::steady_clock::time_point m_StartTime;
+
+    VkPipelineCreationFeedbackCreateInfoEXT     m_CreateInfo{};
+    VkPipelineCreationFeedbackEXT               m_Feedback{};
+    std::vector<VkPipelineCreationFeedbackEXT> m_StageFeedbacks;
+};
 
 void CreateComputePipeline(RenderDeviceVkImpl*                           pDeviceVk,
                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                            const PipelineLayoutVk&                       Layout,
                            const PipelineStateDesc&                      PSODesc,
                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                           VkPipelineCache                               vkPSOCache)
+                           PipelineStateCacheVkImpl*                     pPSOCache,
+                           VkPipelineCreateFlags                         Flags)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    const auto  vkPSOCache    = pPSOCache != nullptr ? pPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
 
     VkComputePipelineCreateInfo PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     PipelineCI.pNext = nullptr;
+    PipelineCI.flags = Flags;
 #ifdef DILIGENT_DEBUG
-    PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
+    PipelineCI.flags |= VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
@@ -122,10 +292,66 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
     PipelineCI.stage  = Stages[0];
     PipelineCI.layout = Layout.GetVkPipelineLayout();
 
+    PipelineCreationFeedbackVk Feedback{pDeviceVk, pPSOCache, 1};
+    Feedback.Chain(PipelineCI);
+
+    CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
     Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    if (Pipeline != VK_NULL_HANDLE)
+        Feedback.Record(&PipelineCI.stage);
 }
 
 
+PipelineLibraryCacheVk::LibraryHashes ComputePipelineLibraryHashes(const PipelineStateVkImpl::TShaderStages& ShaderStages,
+                                                                   size_t                                    LayoutHash,
+                                                                   const GraphicsPipelineDesc&               GraphicsPipeline,
+                                                                   VkRenderPass                              vkRenderPass,
+                                                                   const std::vector<VkDynamicState>&        DynamicStates)
+{
+    // Hashes the shaders of the given types
+    auto HashShaders = [&ShaderStages](size_t& Hash, SHADER_TYPE ShaderTypes) {
+        for (const auto& Stage : ShaderStages)
+        {
+            if ((Stage.Type & ShaderTypes) == 0)
+                continue;
+
+            HashCombine(Hash, Stage.Type);
+            for (size_t i = 0; i < Stage.Shaders.size(); ++i)
+            {
+                const auto& SPIRV = Stage.SPIRVs[i];
+                HashCombine(Hash,
+                            CStringHash<Char>{}(Stage.Shaders[i]->GetEntryPoint()),
+                            ComputeHashRaw(SPIRV.data(), SPIRV.size() * sizeof(uint32_t)));
+            }
+        }
+    };
+
+    // Libraries that are linked together must use the same render pass and identically defined
+    // pipeline layouts. Dynamic states are specified for every library.
+    size_t CommonHash = ComputeHash(LayoutHash, vkRenderPass, GraphicsPipeline.SubpassIndex, GraphicsPipeline.ShadingRateFlags, GraphicsPipeline.DynamicStateFlags);
+    for (auto State : DynamicStates)
+        HashCombine(CommonHash, static_cast<Uint32>(State));
+
+    PipelineLibraryCacheVk::LibraryHashes Hashes;
+    Hashes.fill(CommonHash);
+
+    auto& VertexInputHash = Hashes[PipelineLibraryCacheVk::LIBRARY_TYPE_VERTEX_INPUT];
+    HashCombine(VertexInputHash, StdHasher<InputLayoutDesc>{}(GraphicsPipeline.InputLayout), GraphicsPipeline.PrimitiveTopology);
+
+    auto& PreRasterHash = Hashes[PipelineLibraryCacheVk::LIBRARY_TYPE_PRE_RASTERIZATION];
+    HashCombine(PreRasterHash, StdHasher<RasterizerStateDesc>{}(GraphicsPipeline.RasterizerDesc), GraphicsPipeline.NumViewports, GraphicsPipeline.PrimitiveTopology);
+    HashShaders(PreRasterHash, SHADER_TYPE_VERTEX | SHADER_TYPE_HULL | SHADER_TYPE_DOMAIN | SHADER_TYPE_GEOMETRY);
+
+    auto& FragmentHash = Hashes[PipelineLibraryCacheVk::LIBRARY_TYPE_FRAGMENT_SHADER];
+    HashCombine(FragmentHash, StdHasher<DepthStencilStateDesc>{}(GraphicsPipeline.DepthStencilDesc), StdHasher<SampleDesc>{}(GraphicsPipeline.SmplDesc), GraphicsPipeline.SampleMask);
+    HashShaders(FragmentHash, SHADER_TYPE_PIXEL);
+
+    auto& OutputHash = Hashes[PipelineLibraryCacheVk::LIBRARY_TYPE_FRAGMENT_OUTPUT];
+    HashCombine(OutputHash, StdHasher<BlendStateDesc>{}(GraphicsPipeline.BlendDesc), StdHasher<SampleDesc>{}(GraphicsPipeline.SmplDesc), GraphicsPipeline.SampleMask);
+
+    return Hashes;
+}
+
 void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
                             std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                             const PipelineLayoutVk&                       Layout,
@@ -133,11 +359,16 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
                             const GraphicsPipelineDesc&                   GraphicsPipeline,
                             VulkanUtilities::PipelineWrapper&             Pipeline,
                             RefCntAutoPtr<IRenderPass>&                   pRenderPass,
-                            VkPipelineCache                               vkPSOCache)
+                            PipelineStateCacheVkImpl*                     pPSOCache,
+                            const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                            size_t                                        LayoutHash,
+                            PipelineLibraryCacheVk::LibraryHandles*       pLibraries,
+                            VkPipelineCreateFlags                         Flags)
 {
     const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
     const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
     auto&       RPCache        = pDeviceVk->GetImplicitRenderPassCache();
+    const auto  vkPSOCache     = pPSOCache != nullptr ? pPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
 
     if (pRenderPass == nullptr)
     {
@@ -155,8 +386,9 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     VkGraphicsPipelineCreateInfo PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     PipelineCI.pNext = nullptr;
+    PipelineCI.flags = Flags;
 #ifdef DILIGENT_DEBUG
-    PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
+    PipelineCI.flags |= VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
 
     PipelineCI.stageCount = static_cast<Uint32>(Stages.size());
@@ -312,6 +544,35 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         DynamicStates.push_back(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR);
     }
 
+    if (GraphicsPipeline.DynamicStateFlags != PIPELINE_DYNAMIC_STATE_FLAG_NONE)
+    {
+        VERIFY(pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().ExtendedDynamicState.extendedDynamicState != VK_FALSE,
+               "Dynamic states require VK_EXT_extended_dynamic_state extension. This error should've been caught by ValidateGraphicsPipelineCreateInfo.");
+
+        // The corresponding members of VkPipelineRasterizationStateCreateInfo, VkPipelineDepthStencilStateCreateInfo
+        // and VkPipelineInputAssemblyStateCreateInfo will be ignored and must be set dynamically before any draw commands.
+        if (GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE)
+        {
+            DynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+        }
+        if (GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST)
+        {
+            DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+            DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+            DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+        }
+        if (GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST)
+        {
+            DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+            DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_OP_EXT);
+        }
+        if (GraphicsPipeline.DynamicStateFlags & PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY)
+        {
+            // Only the topology class (point, line or triangle) of the pipeline's topology is baked into the pipeline
+            DynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+        }
+    }
+
     DynamicStateCI.dynamicStateCount = static_cast<uint32_t>(DynamicStates.size());
     DynamicStateCI.pDynamicStates    = DynamicStates.data();
     PipelineCI.pDynamicState         = &DynamicStateCI;
@@ -322,7 +583,27 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    // Pipelines linked from libraries provide no creation feedback and are reported with unknown cache result
+    PipelineCreationFeedbackVk Feedback{pDeviceVk, pPSOCache, PipelineCI.stageCount};
+    if (pLibraries == nullptr)
+        Feedback.Chain(PipelineCI);
+
+    CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
+    if (pLibraries != nullptr)
+    {
+        // Get or compile the pipeline parts and quickly link them without link-time optimization
+        auto*      pLibraryCache = pDeviceVk->GetPipelineLibraryCache();
+        const auto Hashes        = ComputePipelineLibraryHashes(ShaderStages, LayoutHash, GraphicsPipeline, PipelineCI.renderPass, DynamicStates);
+
+        *pLibraries = pLibraryCache->GetLibraries(PipelineCI, Hashes, vkPSOCache, PSODesc.Name);
+        Pipeline    = pLibraryCache->Link(*pLibraries, PipelineCI.layout, /*Optimize = */ false, vkPSOCache, PSODesc.Name);
+    }
+    else
+    {
+        Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    }
+    if (Pipeline != VK_NULL_HANDLE)
+        Feedback.Record(PipelineCI.pStages);
 }
 
 
@@ -333,9 +614,10 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
                               const PipelineStateDesc&                                 PSODesc,
                               const RayTracingPipelineDesc&                            RayTracingPipeline,
                               VulkanUtilities::PipelineWrapper&                        Pipeline,
-                              VkPipelineCache                                          vkPSOCache)
+                              PipelineStateCacheVkImpl*                                pPSOCache)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    const auto  vkPSOCache    = pPSOCache != nullptr ? pPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
 
     VkRayTracingPipelineCreateInfoKHR PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
@@ -356,7 +638,13 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
     PipelineCI.basePipelineHandle           = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex            = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
+    PipelineCreationFeedbackVk Feedback{pDeviceVk, pPSOCache, PipelineCI.stageCount};
+    Feedback.Chain(PipelineCI);
+
+    CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
     Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    if (Pipeline != VK_NULL_HANDLE)
+        Feedback.Record(PipelineCI.pStages);
 }
 
 
@@ -744,7 +1032,7 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
     }
 }
 
-void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo, TShaderStages& ShaderStages) noexcept(false)
+bool PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo, TShaderStages& ShaderStages) noexcept(false)
 {
     const auto InternalFlags = GetInternalCreateFlags(CreateInfo);
     if (m_UsingImplicitSignature && (InternalFlags & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) == 0)
@@ -769,13 +1057,14 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
         for (Uint32 i = 0; i < m_SignatureCount; ++i)
             BindIndexToDescSetIndex[i] = m_PipelineLayout.GetFirstDescrSetIndex(i);
 
-        // Note that we always need to strip reflection information when it is present
+        // Reflection is stripped when the shader module is created, see ShaderVkImpl::GetPatchedShaderModule().
+        // The SPIR-V offsets of the shader resources must remain valid until then.
         RemapOrVerifyShaderResources(ShaderStages,
                                      m_Signatures,
                                      m_SignatureCount,
                                      BindIndexToDescSetIndex,
                                      VerifyBindings, // VerifyOnly
-                                     true,           // bStripReflection
+                                     false,          // bStripReflection
                                      m_Desc.Name,
 #ifdef DILIGENT_DEVELOPMENT
                                      &m_ShaderResources, &m_ResourceAttibutions
@@ -784,13 +1073,16 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
 #endif
         );
     }
+
+    // Note that we always need to strip reflection information when it is present
+    return RemapResources || VerifyBindings;
 }
 
 template <typename PSOCreateInfoType>
 PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
-    const PSOCreateInfoType&                           CreateInfo,
-    std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false)
+    const PSOCreateInfoType&                      CreateInfo,
+    std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages,
+    bool&                                         StripReflection) noexcept(false)
 {
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages);
@@ -801,14 +1093,12 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
 
     MemPool.Reserve();
 
-    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
-
     InitializePipelineDesc(CreateInfo, MemPool);
 
-    InitPipelineLayout(CreateInfo, ShaderStages);
+    StripReflection = InitPipelineLayout(CreateInfo, ShaderStages);
 
-    // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+    // Shader modules are created when the pipeline is created, see CreatePipelineFromShaderStages()
+    InitPipelineShaderStages(ShaderStages, vkShaderStages);
 
     return ShaderStages;
 }
@@ -818,13 +1108,31 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+        InitializePipeline(CreateInfo,
+                           [this](const GraphicsPipelineStateCreateInfo& CI) //
+                           {
+                               std::vector<VkPipelineShaderStageCreateInfo> vkShaderStages;
+
+                               bool       StripReflection = false;
+                               const auto ShaderStages    = InitInternalObjects(CI, vkShaderStages, StripReflection);
+
+                               // Mesh pipelines can't be created from libraries
+                               const bool UseLibraries = m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS && m_pDevice->GetPipelineLibraryCache() != nullptr;
+
+                               PipelineLibraryCacheVk::LibraryHandles Libraries{};
+
+                               auto* pPSOCacheVk = ClassPtrCast<PipelineStateCacheVkImpl>(CI.pPSOCache);
+                               // Libraries are cached by the device and are always created from the shader modules
+                               CreatePipelineFromShaderStages(m_pDevice->GetLogicalDevice(), ShaderStages, StripReflection, vkShaderStages, UseLibraries ? nullptr : pPSOCacheVk, m_Pipeline,
+                                                              [&](VkPipelineCreateFlags Flags) //
+                                                              {
+                                                                  CreateGraphicsPipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), pPSOCacheVk,
+                                                                                         ShaderStages, GetPipelineLayoutHash(), UseLibraries ? &Libraries : nullptr, Flags);
+                                                              });
+
+                               if (UseLibraries)
+                                   StartPipelineOptimization(Libraries, CI.pPSOCache);
+                           });
     }
     catch (...)
     {
@@ -838,13 +1146,21 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+        InitializePipeline(CreateInfo,
+                           [this](const ComputePipelineStateCreateInfo& CI) //
+                           {
+                               std::vector<VkPipelineShaderStageCreateInfo> vkShaderStages;
+
+                               bool       StripReflection = false;
+                               const auto ShaderStages    = InitInternalObjects(CI, vkShaderStages, StripReflection);
+
+                               auto* pPSOCacheVk = ClassPtrCast<PipelineStateCacheVkImpl>(CI.pPSOCache);
+                               CreatePipelineFromShaderStages(m_pDevice->GetLogicalDevice(), ShaderStages, StripReflection, vkShaderStages, pPSOCacheVk, m_Pipeline,
+                                                              [&](VkPipelineCreateFlags Flags) //
+                                                              {
+                                                                  CreateComputePipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, pPSOCacheVk, Flags);
+                                                              });
+                           });
     }
     catch (...)
     {
@@ -858,23 +1174,28 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
-
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        const auto ShaderStages   = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-        const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
-        const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-
-        CreateRayTracingPipeline(pDeviceVk, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline, vkSPOCache);
-
-        VERIFY(m_pRayTracingPipelineData->NameToGroupIndex.size() == vkShaderGroups.size(),
-               "The size of NameToGroupIndex map does not match the actual number of groups in the pipeline. This is a bug.");
-        // Get shader group handles from the PSO.
-        auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(vkShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
-        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
-        (void)err;
+        InitializePipeline(CreateInfo,
+                           [this](const RayTracingPipelineStateCreateInfo& CI) //
+                           {
+                               const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+                               std::vector<VkPipelineShaderStageCreateInfo> vkShaderStages;
+
+                               bool       StripReflection = false;
+                               const auto ShaderStages    = InitInternalObjects(CI, vkShaderStages, StripReflection);
+                               const auto vkShaderGroups  = BuildRTShaderGroupDescription(CI, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
+                               auto*      pPSOCacheVk     = ClassPtrCast<PipelineStateCacheVkImpl>(CI.pPSOCache);
+
+                               InitShaderModules(ShaderStages, StripReflection, vkShaderStages);
+                               CreateRayTracingPipeline(m_pDevice, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline, pPSOCacheVk);
+
+                               VERIFY(m_pRayTracingPipelineData->NameToGroupIndex.size() == vkShaderGroups.size(),
+                                      "The size of NameToGroupIndex map does not match the actual number of groups in the pipeline. This is a bug.");
+                               // Get shader group handles from the PSO.
+                               auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(vkShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
+                               DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
+                               (void)err;
+                           });
     }
     catch (...)
     {
@@ -888,8 +1209,62 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
     Destruct();
 }
 
+size_t PipelineStateVkImpl::GetPipelineLayoutHash() const
+{
+    // Pipeline layouts created from the same signatures are identically defined
+    size_t Hash = ComputeHash(m_SignatureCount);
+    for (Uint32 i = 0; i < m_SignatureCount; ++i)
+        HashCombine(Hash, m_Signatures[i] ? m_Signatures[i]->GetHash() : size_t{0});
+    return Hash;
+}
+
+void PipelineStateVkImpl::StartPipelineOptimization(const PipelineLibraryCacheVk::LibraryHandles& Libraries, IPipelineStateCache* pPSOCache)
+{
+    // Without the thread pool, the fast-linked pipeline is used as linking
+    // the optimized pipeline synchronously would defeat the purpose of libraries.
+    IThreadPool* pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+    if (pThreadPool == nullptr)
+        return;
+
+    m_pOptimizationThreadPool = pThreadPool;
+    m_pOptimizationTask       = EnqueueAsyncWork(pThreadPool,
+                                           [this, Libraries, pCache = RefCntAutoPtr<IPipelineStateCache>{pPSOCache}](Uint32 ThreadId) //
+                                           {
+                                               const auto vkSPOCache = pCache ? ClassPtrCast<PipelineStateCacheVkImpl>(pCache.RawPtr())->GetVkPipelineCache() : VK_NULL_HANDLE;
+                                               try
+                                               {
+                                                   // Libraries are owned by the cache and stay valid until the device is destroyed
+                                                   m_OptimizedPipeline = m_pDevice->GetPipelineLibraryCache()->Link(Libraries, m_PipelineLayout.GetVkPipelineLayout(), /*Optimize = */ true, vkSPOCache, m_Desc.Name);
+                                                   m_OptimizedPipelineReady.store(true, std::memory_order_release);
+                                               }
+                                               catch (...)
+                                               {
+                                                   LOG_WARNING_MESSAGE("Failed to link optimized pipeline '", m_Desc.Name, "'. Fast-linked pipeline will be used instead.");
+                                               }
+                                           });
+}
+
+void PipelineStateVkImpl::FinishPipelineOptimization()
+{
+    if (!m_pOptimizationTask)
+        return;
+
+    if (!m_pOptimizationThreadPool->RemoveTask(m_pOptimizationTask, /*CancelIfRunning = */ false))
+        m_pOptimizationTask->WaitForCompletion();
+
+    m_pOptimizationTask.Release();
+    m_pOptimizationThreadPool.Release();
+}
+
 void PipelineStateVkImpl::Destruct()
 {
+    FinishAsyncInitialization();
+    // Optimization task is started by the initialization task
+    FinishPipelineOptimization();
+
+    // Deferred contexts may have recorded the fast-linked pipeline before the optimized one
+    // became ready, so both pipelines are kept alive until the PSO is destroyed.
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_OptimizedPipeline), m_Desc.ImmediateContextMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.ImmediateContextMask);
     m_PipelineLayout.Release(m_pDevice, m_Desc.ImmediateContextMask);
 
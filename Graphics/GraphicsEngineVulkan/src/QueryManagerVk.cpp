@@ -46,6 +46,13 @@ void QueryManagerVk::QueryPoolInfo::Init(const VulkanUtilities::VulkanLogicalDev
     m_QueryCount  = QueryPoolCI.queryCount;
     m_vkQueryPool = LogicalDevice.CreateQueryPool(QueryPoolCI, "QueryManagerVk: query pool");
 
+    // Pipeline statistics queries write one value for every enabled statistic (17.2).
+    // All other queries write a single value. The availability value follows the results.
+    m_ResultStride = QueryPoolCI.queryType == VK_QUERY_TYPE_PIPELINE_STATISTICS ?
+        PlatformMisc::CountOneBits(static_cast<Uint32>(QueryPoolCI.pipelineStatistics)) :
+        1;
+    m_ResultStride += 1;
+
     m_StaleQueries.resize(m_QueryCount);
     for (Uint32 i = 0; i < m_QueryCount; ++i)
         m_StaleQueries[i] = i;
@@ -279,6 +286,37 @@ void QueryManagerVk::DiscardQuery(QUERY_TYPE Type, Uint32 Index)
     m_Pools[Type].Discard(Index);
 }
 
+void QueryManagerVk::GetQueryResults(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                     QUERY_TYPE                                  Type,
+                                     Uint32                                      FirstQuery,
+                                     Uint32                                      QueryCount,
+                                     Uint64*                                     pResults) const
+{
+    const auto& PoolInfo = m_Pools[Type];
+    VERIFY_EXPR(PoolInfo.GetType() == Type);
+    VERIFY(FirstQuery + QueryCount <= PoolInfo.GetQueryCount(), "Query range [", FirstQuery, ", ", FirstQuery + QueryCount, ") is out of range");
+
+    const auto Stride = sizeof(Uint64) * PoolInfo.GetResultStride();
+
+    // If VK_QUERY_RESULT_WITH_AVAILABILITY_BIT is set, the final integer value written for each query
+    // is non-zero if the query's status was available or zero if the status was unavailable.
+    // VK_NOT_READY is returned if any of the queries is unavailable, but the availability values
+    // of all queries are still written (17.2).
+    auto vkRes = LogicalDevice.GetQueryPoolResults(PoolInfo.GetVkQueryPool(),
+                                                   FirstQuery,
+                                                   QueryCount,
+                                                   Stride * QueryCount, // Data Size
+                                                   pResults,
+                                                   Stride,
+                                                   VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (vkRes != VK_SUCCESS && vkRes != VK_NOT_READY)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the results of ", QueryCount, " queries of type ", GetQueryTypeString(Type));
+        for (Uint32 i = 0; i < QueryCount; ++i)
+            pResults[(i + 1) * PoolInfo.GetResultStride() - 1] = 0;
+    }
+}
+
 Uint32 QueryManagerVk::ResetStaleQueries(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, VulkanUtilities::VulkanCommandBuffer& CmdBuff)
 {
     Uint32 NumQueriesReset = 0;
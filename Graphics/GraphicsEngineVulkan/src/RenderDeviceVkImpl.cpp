@@ -37,6 +37,7 @@
 #include "ShaderResourceBindingVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "FenceVkImpl.hpp"
+#include "FenceCompletionWaiterVk.hpp"
 #include "QueryVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
 #include "FramebufferVkImpl.hpp"
@@ -134,7 +135,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryPageSize,
         EngineCI.HostVisibleMemoryPageSize,
         EngineCI.DeviceLocalMemoryReserveSize,
-        EngineCI.HostVisibleMemoryReserveSize
+        EngineCI.HostVisibleMemoryReserveSize,
+        GetGPUMemoryTracker()
     },
     m_DynamicMemoryManager
     {
@@ -148,6 +150,9 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 {
     static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
 
+    if (EngineCI.AsyncShaderCompilerLoad && m_pDxCompiler)
+        m_pDxCompiler->LoadAsync();
+
     const auto vkVersion    = m_PhysicalDevice->GetVkVersion();
     m_DeviceInfo.Type       = RENDER_DEVICE_TYPE_VULKAN;
     m_DeviceInfo.APIVersion = Version{VK_API_VERSION_MAJOR(vkVersion), VK_API_VERSION_MINOR(vkVersion)};
@@ -189,6 +194,25 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
 
     for (Uint32 fmt = 1; fmt < m_TextureFormatsInfo.size(); ++fmt)
         m_TextureFormatsInfo[fmt].Supported = true; // We will test every format on a specific hardware device
+
+    // Without timeline semaphores, the waiter thread polls the fences
+    if (m_DeviceInfo.Features.NativeFence)
+        m_pFenceCompletionWaiter = std::make_unique<FenceCompletionWaiterVk>(m_LogicalVkDevice);
+    else
+        m_pFenceCompletionWaiter = std::make_unique<FenceCompletionWaiter>(/*UseThread = */ true);
+
+    if (m_LogicalVkDevice->GetEnabledExtFeatures().GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+    {
+        VERIFY_EXPR(EngineCI.EnableGraphicsPipelineLibrary);
+        if (m_PhysicalDevice->GetExtProperties().GraphicsPipelineLibrary.graphicsPipelineLibraryFastLinking != VK_FALSE)
+        {
+            m_pPipelineLibraryCache = std::make_unique<PipelineLibraryCacheVk>(*this);
+        }
+        else
+        {
+            LOG_INFO_MESSAGE("The device does not support fast linking of graphics pipeline libraries. Pipelines will be created without libraries.");
+        }
+    }
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -200,9 +224,16 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // Explicitly destroy render pass cache
     m_ImplicitRenderPassCache.Destroy();
 
+    if (m_pPipelineLibraryCache)
+        m_pPipelineLibraryCache->Destroy();
+
     // Wait for the GPU to complete all its operations
     IdleGPU();
 
+    // Stop the waiter thread and release the wake-up semaphore while the logical device is alive.
+    // All fences with completion callbacks have been released at this point.
+    m_pFenceCompletionWaiter = std::make_unique<FenceCompletionWaiter>(/*UseThread = */ false);
+
     ReleaseStaleResources(true);
 
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
@@ -445,6 +476,12 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
     PurgeReleaseQueues(ForceRelease);
 }
 
+void RenderDeviceVkImpl::GetStatistics(DeviceStatistics& Stats) const
+{
+    TRenderDeviceBase::GetStatistics(Stats);
+    Stats.DeviceMemoryUsedSize = m_MemoryMgr.GetCurrentUsedSize();
+}
+
 
 void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 {
@@ -563,6 +600,11 @@ void RenderDeviceVkImpl::CreateGraphicsPipelineState(const GraphicsPipelineState
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
+void RenderDeviceVkImpl::CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState)
+{
+    CreateDerivedGraphicsPipelineStateImpl(CreateInfo, ppPipelineState);
+}
+
 void RenderDeviceVkImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
@@ -596,6 +638,19 @@ void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader*
     CreateShaderImpl(ppShader, ShaderCI, VkShaderCI);
 }
 
+void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI, const SerializedData& ReflectionData, IShader** ppShader)
+{
+    const ShaderVkImpl::CreateInfo VkShaderCI{
+        GetDxCompiler(),
+        GetDeviceInfo(),
+        GetAdapterInfo(),
+        GetVkVersion(),
+        GetLogicalDevice().GetEnabledExtFeatures().Spirv14,
+        &ReflectionData //
+    };
+    CreateShaderImpl(ppShader, ShaderCI, VkShaderCI);
+}
+
 
 void RenderDeviceVkImpl::CreateTextureFromVulkanImage(VkImage vkImage, const TextureDesc& TexDesc, RESOURCE_STATE InitialState, ITexture** ppTexture)
 {
@@ -182,8 +182,18 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
 RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    auto                        it = m_Cache.find(Key);
+    {
+        std::shared_lock<std::shared_timed_mutex> SharedLock{m_Mutex};
+
+        auto it = m_Cache.find(Key);
+        if (it != m_Cache.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_timed_mutex> Lock{m_Mutex};
+
+    // Another thread may have created the render pass while we were waiting for the lock
+    auto it = m_Cache.find(Key);
     if (it == m_Cache.end())
     {
         // Do not zero-initialize arrays
@@ -329,10 +329,14 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
     }
 
     auto vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (vkSet == VK_NULL_HANDLE)
+    {
+        // Descriptors for this set are written when the resources are committed.
+        // Invalidate descriptor sets that may have been written for the previous contents.
+        ++m_DynamicSetRevision;
+    }
+    else if (DstRes.pObject && pLogicalDevice != nullptr)
     {
-        VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
-
         VkWriteDescriptorSet WriteDescrSet;
         WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         WriteDescrSet.pNext           = nullptr;
@@ -554,7 +558,7 @@ inline void TransitionTextureView(DeviceContextVkImpl* pCtxVkImpl,
         return;
 
     auto* pTextureVk = pTextureViewVk->GetTexture<TextureVkImpl>();
-    if (!pTextureVk->IsInKnownState())
+    if (!pTextureVk->IsInKnownState() && pTextureVk->GetSubresourceStates() == nullptr)
         return;
 
     // The image subresources for a storage image must be in the VK_IMAGE_LAYOUT_GENERAL layout in
@@ -585,6 +589,39 @@ inline void TransitionTextureView(DeviceContextVkImpl* pCtxVkImpl,
             VERIFY_EXPR(ResourceStateToVkImageLayout(RequiredState) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
         }
     }
+
+    if (const auto* pSubresStates = pTextureVk->GetSubresourceStates())
+    {
+        // Only the subresources addressed by the view are verified or transitioned
+        const auto Range = pTextureVk->GetSubresourceRange(pTextureViewVk->GetDesc());
+
+        bool IsInRequiredState = true;
+        pSubresStates->ProcessRange(Range,
+                                    [&](const SubresourceStateTracker::Range&, RESOURCE_STATE State) {
+                                        IsInRequiredState = IsInRequiredState && (State & RequiredState) == RequiredState;
+                                    });
+
+        if (VerifyOnly)
+        {
+            if (!IsInRequiredState)
+            {
+                LOG_ERROR_MESSAGE("State of mip levels ", Range.FirstMip, "..", Range.FirstMip + Range.NumMips - 1, " and array slices ",
+                                  Range.FirstSlice, "..", Range.FirstSlice + Range.NumSlices - 1, " of texture '", pTextureVk->GetDesc().Name,
+                                  "' is incorrect. Required state: ", GetResourceStateString(RequiredState), ".");
+            }
+        }
+        else if (!IsInRequiredState || RequiredState == RESOURCE_STATE_UNORDERED_ACCESS)
+        {
+            VkImageSubresourceRange SubresRange{};
+            SubresRange.baseMipLevel   = Range.FirstMip;
+            SubresRange.levelCount     = Range.NumMips;
+            SubresRange.baseArrayLayer = Range.FirstSlice;
+            SubresRange.layerCount     = Range.NumSlices;
+            pCtxVkImpl->TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE, &SubresRange);
+        }
+        return;
+    }
+
     const bool IsInRequiredState = pTextureVk->CheckState(RequiredState);
 
     if (VerifyOnly)
@@ -854,6 +891,73 @@ VkDescriptorImageInfo ShaderResourceCacheVk::Resource::GetInputAttachmentDescrip
     return DescrImgInfo;
 }
 
+ShaderResourceCacheVk::DescriptorInfo ShaderResourceCacheVk::Resource::GetDescriptorInfo() const
+{
+    // Do not zero-initialize!
+    DescriptorInfo Info;
+
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (Type)
+    {
+        case DescriptorType::Sampler:
+            Info.ImageInfo = GetSamplerDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+            Info.ImageInfo = GetImageDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            Info.BufferView = GetBufferViewWriteInfo();
+            break;
+
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            Info.BufferInfo = GetUniformBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            Info.BufferInfo = GetStorageBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::InputAttachment:
+        case DescriptorType::InputAttachment_General:
+            Info.ImageInfo = GetInputAttachmentDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::AccelerationStructure:
+            Info.AccelStruct = *GetAccelerationStructureWriteInfo().pAccelerationStructures;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+    }
+
+    return Info;
+}
+
+bool ShaderResourceCacheVk::DescriptorSet::GetDescriptorInfos(DescriptorInfo* pInfos) const
+{
+    for (Uint32 i = 0; i < m_NumResources; ++i)
+    {
+        const auto& Res = m_pResources[i];
+        if (!Res.IsWrittenToDescriptorSet())
+            continue;
+        if (Res.IsNull())
+            return false;
+
+        pInfos[i] = Res.GetDescriptorInfo();
+    }
+    return true;
+}
+
 VkWriteDescriptorSetAccelerationStructureKHR ShaderResourceCacheVk::Resource::GetAccelerationStructureWriteInfo() const
 {
     VERIFY(Type == DescriptorType::AccelerationStructure, "Acceleration structure resource is expected");
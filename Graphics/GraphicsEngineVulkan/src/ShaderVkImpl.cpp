@@ -37,6 +37,8 @@
 #include "GLSLUtils.hpp"
 #include "DXCompiler.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "CompilationStatisticsImpl.hpp"
+#include "HashUtils.hpp"
 
 #if !DILIGENT_NO_GLSLANG
 #    include "GLSLangUtils.hpp"
@@ -76,7 +78,10 @@ std::vector<uint32_t> CompileShaderDXC(const ShaderCreateInfo&         ShaderCI,
 #if !DILIGENT_NO_HLSL
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
-    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION);
+    // DXC runs the performance passes itself, so only the size passes may be added.
+    const auto Level          = GetSPIRVOptimizationLevel(ShaderCI.CompileFlags);
+    const auto Passes         = GetSPIRVOptimizationFlags(Level == SPIRV_OPTIMIZATION_LEVEL_SIZE ? Level : SPIRV_OPTIMIZATION_LEVEL_FAST_DEV, /*Legalize = */ true);
+    auto       LegalizedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, Passes);
     if (!LegalizedSPIRV.empty())
         SPIRV = std::move(LegalizedSPIRV);
     else
@@ -132,6 +137,7 @@ std::vector<uint32_t> CompileShaderGLSLang(const ShaderCreateInfo&         Shade
         Attribs.AssignBindings             = true;
         Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
         Attribs.ppCompilerOutput           = ShaderCI.ppCompilerOutput;
+        Attribs.CompileFlags               = ShaderCI.CompileFlags;
 
         if (VkShaderCI.VkVersion >= VK_API_VERSION_1_2)
             Attribs.Version = GLSLangUtils::SpirvVersion::Vk120;
@@ -163,6 +169,19 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
         IsDeviceInternal
     }
 // clang-format on
+{
+    // Reflection data is owned by the caller and can't be used by asynchronous compilation
+    const auto AllowAsync = VkShaderCI.pReflectionData == nullptr;
+    InitializeShader(
+        ShaderCI,
+        [this, VkShaderCI](const ShaderCreateInfo& CI) //
+        {
+            Initialize(CI, VkShaderCI);
+        },
+        AllowAsync);
+}
+
+void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI, const CreateInfo& VkShaderCI) noexcept(false)
 {
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
@@ -217,18 +236,47 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
-        auto& Allocator        = GetRawAllocator();
-        auto* pRawMem          = ALLOCATE(Allocator, "Memory for SPIRVShaderResources", SPIRVShaderResources, 1);
-        auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-        auto* pResources       = new (pRawMem) SPIRVShaderResources //
+        CompilationStageTimer Timer{COMPILATION_STAGE_REFLECTION};
+
+        auto& Allocator             = GetRawAllocator();
+        auto* pRawMem               = ALLOCATE(Allocator, "Memory for SPIRVShaderResources", SPIRVShaderResources, 1);
+        auto  LoadShaderInputs      = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
+        auto  CombinedSamplerSuffix = m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr;
+
+        SPIRVShaderResources* pResources = nullptr;
+        if (VkShaderCI.pReflectionData != nullptr && *VkShaderCI.pReflectionData)
+        {
+            try
+            {
+                pResources = new (pRawMem) SPIRVShaderResources //
+                    {
+                        Allocator,
+                        *VkShaderCI.pReflectionData,
+                        m_SPIRV,
+                        m_Desc,
+                        CombinedSamplerSuffix,
+                        m_EntryPoint //
+                    };
+            }
+            catch (...)
             {
-                Allocator,
-                m_SPIRV,
-                m_Desc,
-                m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr,
-                LoadShaderInputs,
-                m_EntryPoint //
-            };
+                LOG_WARNING_MESSAGE("Failed to load stored reflection of shader '", m_Desc.Name, "'. The reflection will be loaded from SPIR-V.");
+                m_EntryPoint.clear();
+            }
+        }
+
+        if (pResources == nullptr)
+        {
+            pResources = new (pRawMem) SPIRVShaderResources //
+                {
+                    Allocator,
+                    m_SPIRV,
+                    m_Desc,
+                    CombinedSamplerSuffix,
+                    LoadShaderInputs,
+                    m_EntryPoint //
+                };
+        }
         VERIFY_EXPR(ShaderCI.ByteCode != nullptr || m_EntryPoint == ShaderCI.EntryPoint);
         m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
@@ -276,6 +324,67 @@ void ShaderVkImpl::MapHLSLVertexShaderInputs()
 
 ShaderVkImpl::~ShaderVkImpl()
 {
+    FinishAsyncCompilation();
+}
+
+VkShaderModule ShaderVkImpl::GetPatchedShaderModule(const std::vector<uint32_t>& PatchedSPIRV, bool StripReflection) const noexcept(false)
+{
+    VERIFY(PatchedSPIRV.size() == m_SPIRV.size(), "Patched SPIR-V must only differ from the original byte code by the resource bindings");
+
+    std::vector<uint32_t> Bindings;
+    if (m_pShaderResources)
+    {
+        Bindings.reserve(size_t{m_pShaderResources->GetTotalResources()} * 2);
+        m_pShaderResources->ProcessResources(
+            [&](const SPIRVShaderResourceAttribs& Attribs, Uint32) //
+            {
+                Bindings.push_back(PatchedSPIRV[Attribs.BindingDecorationOffset]);
+                Bindings.push_back(PatchedSPIRV[Attribs.DescriptorSetDecorationOffset]);
+            });
+    }
+    const size_t Hash = ComputeHash(ComputeHashRaw(Bindings.data(), Bindings.size() * sizeof(uint32_t)), StripReflection);
+
+    std::lock_guard<std::mutex> Lock{m_PatchedModulesMtx};
+
+    auto range = m_PatchedModules.equal_range(Hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.StripReflection == StripReflection && it->second.Bindings == Bindings)
+            return it->second.Module;
+    }
+
+    const std::vector<uint32_t>* pSPIRV = &PatchedSPIRV;
+#if !DILIGENT_NO_HLSL
+    std::vector<uint32_t> StrippedSPIRV;
+    if (StripReflection)
+    {
+        // We have to strip reflection instructions to fix the following validation error:
+        //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
+        // Optimizer also performs validation and may catch problems with the byte code.
+        StrippedSPIRV = OptimizeSPIRV(PatchedSPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION);
+        if (!StrippedSPIRV.empty())
+            pSPIRV = &StrippedSPIRV;
+        else
+            LOG_ERROR("Failed to strip reflection information from shader '", m_Desc.Name, "'. This may indicate a problem with the byte code.");
+    }
+#endif
+
+    VkShaderModuleCreateInfo ShaderModuleCI{};
+    ShaderModuleCI.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    ShaderModuleCI.pNext    = nullptr;
+    ShaderModuleCI.flags    = 0;
+    ShaderModuleCI.codeSize = pSPIRV->size() * sizeof(uint32_t);
+    ShaderModuleCI.pCode    = pSPIRV->data();
+
+    PatchedShaderModule Patched;
+    Patched.Bindings        = std::move(Bindings);
+    Patched.StripReflection = StripReflection;
+    {
+        CompilationStageTimer Timer{COMPILATION_STAGE_DRIVER};
+        Patched.Module = GetDevice()->GetLogicalDevice().CreateShaderModule(ShaderModuleCI, m_Desc.Name);
+    }
+
+    return m_PatchedModules.emplace(Hash, std::move(Patched))->second.Module;
 }
 
 void ShaderVkImpl::GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const
@@ -26,6 +26,9 @@
  */
 
 #include "pch.h"
+
+#include <chrono>
+
 #include "SwapChainVkImpl.hpp"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
@@ -37,6 +40,17 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// Returns the time, in nanoseconds, used to measure the present latency
+Uint64 GetPresentClockTime()
+{
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
 SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
                                  const SwapChainDesc& SCDesc,
                                  RenderDeviceVkImpl*  pRenderDeviceVk,
@@ -49,9 +63,19 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     m_DesiredBufferCount         {SCDesc.BufferCount},
     m_pBackBufferRTV             (STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<ITextureView>, GetRawAllocator(), "Allocator for vector<RefCntAutoPtr<ITextureView>>")),
     m_SwapChainImagesInitialized (STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
-    m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>"))
+    m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
+    m_MaxFrameLatency            {SCDesc.BufferCount}
 // clang-format on
 {
+    const auto& EnabledExtFeats = pRenderDeviceVk->GetLogicalDevice().GetEnabledExtFeatures();
+
+    m_PresentWaitSupported = EnabledExtFeats.PresentWait.presentWait != VK_FALSE;
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+    // Presentation times are reported in CLOCK_MONOTONIC time domain that is only
+    // guaranteed to match std::chrono::steady_clock on these platforms.
+    m_DisplayTimingSupported = EnabledExtFeats.DisplayTiming;
+#endif
+
     CreateSurface();
     CreateVulkanSwapChain();
     InitBuffersAndViews();
@@ -478,6 +502,19 @@ void SwapChainVkImpl::CreateVulkanSwapChain()
         oldSwapchain = VK_NULL_HANDLE;
     }
 
+    // Present ids are counted separately for every swap chain
+    m_PresentId             = 0;
+    m_DisplayedPresentId    = 0;
+    m_LastActualPresentTime = 0;
+    m_LastTimedPresentId    = 0;
+    m_RefreshDuration       = 0;
+    if (m_DisplayTimingSupported)
+    {
+        VkRefreshCycleDurationGOOGLE RefreshCycle = {};
+        if (vkGetRefreshCycleDurationGOOGLE(vkDevice, m_VkSwapChain, &RefreshCycle) == VK_SUCCESS)
+            m_RefreshDuration = RefreshCycle.refreshDuration;
+    }
+
     uint32_t swapchainImageCount = 0;
 
     err = vkGetSwapchainImagesKHR(vkDevice, m_VkSwapChain, &swapchainImageCount, NULL);
@@ -711,6 +748,12 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
 
     if (!m_IsMinimized)
     {
+        // Similar to Direct3D, wait for the frame as late as possible - right before presenting.
+        WaitForFrameLatency();
+
+        ++m_PresentId;
+        m_PresentTimes[m_PresentId % m_PresentTimes.size()] = GetPresentClockTime();
+
         VkPresentInfoKHR PresentInfo = {};
 
         PresentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -724,6 +767,31 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         PresentInfo.pImageIndices   = &m_BackBufferIndex;
         VkResult Result             = VK_SUCCESS;
         PresentInfo.pResults        = &Result;
+
+        VkPresentIdKHR PresentIdInfo = {};
+        if (m_PresentWaitSupported)
+        {
+            PresentIdInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+            PresentIdInfo.pNext          = PresentInfo.pNext;
+            PresentIdInfo.swapchainCount = 1;
+            PresentIdInfo.pPresentIds    = &m_PresentId;
+            PresentInfo.pNext            = &PresentIdInfo;
+        }
+
+        VkPresentTimeGOOGLE      PresentTime      = {};
+        VkPresentTimesInfoGOOGLE PresentTimesInfo = {};
+        if (m_DisplayTimingSupported)
+        {
+            PresentTime.presentID          = static_cast<uint32_t>(m_PresentId);
+            PresentTime.desiredPresentTime = 0; // Present as soon as possible
+
+            PresentTimesInfo.sType          = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+            PresentTimesInfo.pNext          = PresentInfo.pNext;
+            PresentTimesInfo.swapchainCount = 1;
+            PresentTimesInfo.pTimes         = &PresentTime;
+            PresentInfo.pNext               = &PresentTimesInfo;
+        }
+
         pDeviceVk->LockCmdQueueAndRun(
             pImmediateCtxVk->GetCommandQueueId(),
             [&PresentInfo](ICommandQueueVk* pCmdQueueVk) //
@@ -740,6 +808,7 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
         else
         {
             DEV_CHECK_ERR(Result == VK_SUCCESS, "Present failed");
+            UpdateFramePacingStats();
         }
     }
 
@@ -770,6 +839,120 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
     }
 }
 
+void SwapChainVkImpl::SetMaximumFrameLatency(Uint32 MaxLatency)
+{
+    if (!m_PresentWaitSupported)
+    {
+        LOG_WARNING_MESSAGE_ONCE("The maximum frame latency is ignored because the device does not support "
+                                 "VK_KHR_present_id and VK_KHR_present_wait extensions.");
+    }
+    m_MaxFrameLatency = std::max(MaxLatency, 1u);
+}
+
+void SwapChainVkImpl::WaitForFrameLatency()
+{
+    if (!m_PresentWaitSupported || m_PresentId < m_MaxFrameLatency)
+        return;
+
+    // The frame that is about to be presented has id m_PresentId + 1. Wait until
+    // the frame m_MaxFrameLatency frames before it has been displayed.
+    const Uint64 WaitPresentId = m_PresentId + 1 - m_MaxFrameLatency;
+    if (WaitPresentId <= m_DisplayedPresentId)
+        return;
+
+    const VkDevice vkDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetVkDevice();
+
+    const auto res = vkWaitForPresentKHR(vkDevice, m_VkSwapChain, WaitPresentId,
+                                         500000000 // 0.5 second timeout (shouldn't ever occur)
+    );
+    if (res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR)
+    {
+        OnPresentsDisplayed(WaitPresentId);
+    }
+    else if (res == VK_TIMEOUT)
+    {
+        LOG_ERROR_MESSAGE("Timeout elapsed while waiting for the frame to be presented. This is a strong indication of a synchronization error.");
+    }
+    // VK_ERROR_OUT_OF_DATE_KHR is handled by the following present
+}
+
+void SwapChainVkImpl::OnPresentsDisplayed(Uint64 LastPresentId)
+{
+    const Uint64 CurrTime = GetPresentClockTime();
+    for (Uint64 Id = m_DisplayedPresentId + 1; Id <= LastPresentId; ++Id)
+    {
+        // When display timing is supported, the statistics are collected by UpdateFramePacingStats()
+        if (!m_DisplayTimingSupported && m_PresentId - Id < m_PresentTimes.size())
+        {
+            // The frame has been displayed some time before the wait returned, so this is the upper bound
+            const Uint64 PresentTime = m_PresentTimes[Id % m_PresentTimes.size()];
+            OnFrameDisplayed(static_cast<double>(CurrTime - PresentTime) * 1e-9, 0);
+        }
+    }
+    m_DisplayedPresentId = std::max(m_DisplayedPresentId, LastPresentId);
+}
+
+void SwapChainVkImpl::UpdateFramePacingStats()
+{
+    const VkDevice vkDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetVkDevice();
+
+    if (m_DisplayTimingSupported)
+    {
+        uint32_t NumTimings = 0;
+        if (vkGetPastPresentationTimingGOOGLE(vkDevice, m_VkSwapChain, &NumTimings, nullptr) != VK_SUCCESS || NumTimings == 0)
+            return;
+
+        std::vector<VkPastPresentationTimingGOOGLE> Timings(NumTimings);
+        if (vkGetPastPresentationTimingGOOGLE(vkDevice, m_VkSwapChain, &NumTimings, Timings.data()) != VK_SUCCESS)
+            return;
+        Timings.resize(NumTimings);
+
+        for (const auto& Timing : Timings)
+        {
+            const Uint64 Id = Timing.presentID;
+            if (Id <= m_LastTimedPresentId || Id > m_PresentId)
+                continue;
+
+            double PresentLatency = 0;
+            if (m_PresentId - Id < m_PresentTimes.size())
+            {
+                const Uint64 PresentTime = m_PresentTimes[Id % m_PresentTimes.size()];
+                if (Timing.actualPresentTime > PresentTime)
+                    PresentLatency = static_cast<double>(Timing.actualPresentTime - PresentTime) * 1e-9;
+            }
+
+            // Every frame is expected to be displayed one refresh cycle after the previous one
+            // with the vertical sync enabled.
+            Uint32 MissedVBlanks = 0;
+            if (m_VSyncEnabled && m_RefreshDuration != 0 && m_LastActualPresentTime != 0 && Timing.actualPresentTime > m_LastActualPresentTime)
+            {
+                const Uint64 NumRefreshes = (Timing.actualPresentTime - m_LastActualPresentTime + m_RefreshDuration / 2) / m_RefreshDuration;
+                const Uint64 NumFrames    = Id - m_LastTimedPresentId;
+                if (NumRefreshes > NumFrames)
+                    MissedVBlanks = static_cast<Uint32>(NumRefreshes - NumFrames);
+            }
+
+            OnFrameDisplayed(PresentLatency, MissedVBlanks);
+            m_LastActualPresentTime = Timing.actualPresentTime;
+            m_LastTimedPresentId    = Id;
+        }
+        m_DisplayedPresentId = std::max(m_DisplayedPresentId, m_LastTimedPresentId);
+    }
+    else if (m_PresentWaitSupported)
+    {
+        // Poll the frames that have not been reported as displayed yet
+        Uint64 LastDisplayedId = m_DisplayedPresentId;
+        while (LastDisplayedId < m_PresentId)
+        {
+            const auto res = vkWaitForPresentKHR(vkDevice, m_VkSwapChain, LastDisplayedId + 1, 0);
+            if (res != VK_SUCCESS && res != VK_SUBOPTIMAL_KHR)
+                break;
+            ++LastDisplayedId;
+        }
+        OnPresentsDisplayed(LastDisplayedId);
+    }
+}
+
 void SwapChainVkImpl::WaitForImageAcquiredFences()
 {
     const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
@@ -204,6 +204,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             SetState(RESOURCE_STATE_UNDEFINED);
 
             InitSparseProperties();
+
+            // Sparse texture memory is tracked by the device memory objects it is bound to
+            RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_PLACED, 0);
         }
         else
         {
@@ -220,6 +223,8 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
             auto err    = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
             CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
 
+            RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, m_MemoryAllocation.Size);
+
             if (pInitData != nullptr && pInitData->pSubResources != nullptr && pInitData->NumSubresources > 0)
                 InitializeTextureContent(*pInitData, FmtAttribs, ImageCI);
             else
@@ -477,6 +482,8 @@ void TextureVkImpl::CreateStagingTexture(const TextureData* pInitData, const Tex
 
     m_StagingDataAlignedOffset = AlignedStagingMemOffset;
 
+    RecordGPUMemory(GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, m_MemoryAllocation.Size);
+
     if (bInitializeTexture)
     {
         uint8_t* const pStagingData = GetStagingDataCPUAddress();
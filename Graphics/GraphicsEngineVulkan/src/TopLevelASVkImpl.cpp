@@ -97,6 +97,9 @@ TopLevelASVkImpl::TopLevelASVkImpl(IReferenceCounters*   pRefCounters,
     auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_MemoryAlignedOffset);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+    m_GPUMemoryRecord = GPUMemoryRecord{pRenderDeviceVk->GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_ACCELERATION_STRUCTURE, GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED,
+                                        m_Desc.Name, AccelStructSize, m_MemoryAllocation.Size};
+
     VkAccelerationStructureCreateInfoKHR vkAccelStrCI{};
     vkAccelStrCI.sType       = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
     vkAccelStrCI.createFlags = 0;
@@ -111,6 +111,9 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
     err = LogicalDevice.BindBufferMemory(m_VkBuffer, m_BufferMemory, 0 /*offset*/);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+    m_GPUMemoryRecord = GPUMemoryRecord{DeviceVk.GetGPUMemoryTracker(), GPU_MEMORY_CATEGORY_DYNAMIC_HEAP, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                        "Dynamic heap buffer", Size, MemAlloc.allocationSize};
+
     LOG_INFO_MESSAGE("GPU dynamic heap created. Total buffer size: ", FormatMemorySize(Size, 2));
 }
 
@@ -123,6 +126,7 @@ void VulkanDynamicMemoryManager::Destroy()
         m_DeviceVk.SafeReleaseDeviceObject(std::move(m_BufferMemory), m_CommandQueueMask);
     }
     m_CPUAddress = nullptr;
+    m_GPUMemoryRecord.Reset();
 }
 
 VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
@@ -289,6 +293,20 @@ void VulkanDynamicHeap::ReleaseMasterBlocks(RenderDeviceVkImpl& DeviceVkImpl, Ui
     m_GlobalDynamicMemMgr.ReleaseMasterBlocks(m_MasterBlocks, DeviceVkImpl, CmdQueueMask);
     m_MasterBlocks.clear();
 
+    // Current sizes are reset every frame, so the peak values are per-frame peaks
+    m_LastFrameUsedSize      = m_CurrUsedSize;
+    m_LastFrameAllocatedSize = m_CurrAllocatedSize;
+    ++m_NumFrames;
+
+    if (m_AdaptivePageSize && m_PageSizer.FinishFrame(m_CurrAlignedSize))
+    {
+        LOG_INFO_MESSAGE(m_HeapName, ": page size changed from ", FormatMemorySize(m_PageSizer.GetPreviousPageSize(), 2),
+                         " to ", FormatMemorySize(m_PageSizer.GetPageSize(), 2), ". Last frame size: ", FormatMemorySize(m_CurrAlignedSize, 2),
+                         "; peak frame size since the last change: ", FormatMemorySize(m_PageSizer.GetWindowPeakSize(), 2), '.');
+        m_PageSizer.ResetWindowPeakSize();
+        m_MasterBlockSize = static_cast<Uint32>(m_PageSizer.GetPageSize());
+    }
+
     m_CurrOffset    = InvalidOffset;
     m_AvailableSize = 0;
 
@@ -297,6 +315,20 @@ void VulkanDynamicHeap::ReleaseMasterBlocks(RenderDeviceVkImpl& DeviceVkImpl, Ui
     m_CurrAllocatedSize = 0;
 }
 
+VulkanDynamicHeap::Stats VulkanDynamicHeap::GetStats() const
+{
+    Stats HeapStats;
+    HeapStats.CurrUsedSize           = m_CurrUsedSize;
+    HeapStats.CurrAllocatedSize      = m_CurrAllocatedSize;
+    HeapStats.LastFrameUsedSize      = m_LastFrameUsedSize;
+    HeapStats.LastFrameAllocatedSize = m_LastFrameAllocatedSize;
+    HeapStats.PeakFrameUsedSize      = m_PeakUsedSize;
+    HeapStats.PeakFrameAllocatedSize = m_PeakAllocatedSize;
+    HeapStats.NumFrames              = m_NumFrames;
+    HeapStats.PageSize               = m_MasterBlockSize;
+    return HeapStats;
+}
+
 VulkanDynamicHeap::~VulkanDynamicHeap()
 {
     DEV_CHECK_ERR(m_MasterBlocks.empty(), m_MasterBlocks.size(), " master block(s) have not been returned to dynamic memory manager");
@@ -1206,7 +1206,7 @@ static VkPipelineStageFlags ResourceStateFlagToVkPipelineStage(RESOURCE_STATE St
         case RESOURCE_STATE_DEPTH_READ:        return VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
         case RESOURCE_STATE_SHADER_RESOURCE:   return VulkanUtilities::VK_PIPELINE_STAGE_ALL_SHADERS;
         case RESOURCE_STATE_STREAM_OUT:        return 0;
-        case RESOURCE_STATE_INDIRECT_ARGUMENT: return VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+        case RESOURCE_STATE_INDIRECT_ARGUMENT: return VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT; // Conditional rendering stage is masked out when not enabled
         case RESOURCE_STATE_COPY_DEST:         return VK_PIPELINE_STAGE_TRANSFER_BIT;
         case RESOURCE_STATE_COPY_SOURCE:       return VK_PIPELINE_STAGE_TRANSFER_BIT;
         case RESOURCE_STATE_RESOLVE_DEST:      return VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -1270,7 +1270,7 @@ static VkAccessFlags ResourceStateFlagToVkAccessFlags(RESOURCE_STATE StateFlag)
         case RESOURCE_STATE_DEPTH_READ:        return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
         case RESOURCE_STATE_SHADER_RESOURCE:   return VK_ACCESS_SHADER_READ_BIT;
         case RESOURCE_STATE_STREAM_OUT:        return VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT;
-        case RESOURCE_STATE_INDIRECT_ARGUMENT: return VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        case RESOURCE_STATE_INDIRECT_ARGUMENT: return VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT;
         case RESOURCE_STATE_COPY_DEST:         return VK_ACCESS_TRANSFER_WRITE_BIT;
         case RESOURCE_STATE_COPY_SOURCE:       return VK_ACCESS_TRANSFER_READ_BIT;
         case RESOURCE_STATE_RESOLVE_DEST:      return VK_ACCESS_TRANSFER_WRITE_BIT;
@@ -1335,6 +1335,7 @@ static RESOURCE_STATE VkAccessFlagToResourceStates(VkAccessFlagBits AccessFlagBi
     {
         // clang-format off
         case VK_ACCESS_INDIRECT_COMMAND_READ_BIT:                 return RESOURCE_STATE_INDIRECT_ARGUMENT;
+        case VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT:        return RESOURCE_STATE_INDIRECT_ARGUMENT;
         case VK_ACCESS_INDEX_READ_BIT:                            return RESOURCE_STATE_INDEX_BUFFER;
         case VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT:                 return RESOURCE_STATE_VERTEX_BUFFER;
         case VK_ACCESS_UNIFORM_READ_BIT:                          return RESOURCE_STATE_CONSTANT_BUFFER;
@@ -1628,7 +1629,7 @@ SAMPLE_COUNT VkSampleCountFlagsToSampleCount(VkSampleCountFlags Flags)
 
 VkShaderStageFlagBits ShaderTypeToVkShaderStageFlagBit(SHADER_TYPE ShaderType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     VERIFY(IsPowerOfTwo(Uint32{ShaderType}), "More than one shader type is specified");
     switch (ShaderType)
     {
@@ -1649,6 +1650,7 @@ VkShaderStageFlagBits ShaderTypeToVkShaderStageFlagBit(SHADER_TYPE ShaderType)
         case SHADER_TYPE_CALLABLE:         return VK_SHADER_STAGE_CALLABLE_BIT_KHR;
         // clang-format on
         case SHADER_TYPE_TILE:
+        case SHADER_TYPE_WORK_GRAPH:
             UNEXPECTED("Unsupported shader type");
             return VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
         default:
@@ -1676,7 +1678,7 @@ SHADER_TYPE VkShaderStageFlagsToShaderTypes(VkShaderStageFlags StageFlags)
     }
     else if (StageFlags == VK_SHADER_STAGE_ALL)
     {
-        static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the return value below");
+        static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the return value below");
         return SHADER_TYPE_ALL_GRAPHICS | SHADER_TYPE_COMPUTE | SHADER_TYPE_ALL_MESH | SHADER_TYPE_ALL_RAY_TRACING;
     }
 
@@ -1685,7 +1687,7 @@ SHADER_TYPE VkShaderStageFlagsToShaderTypes(VkShaderStageFlags StageFlags)
     {
         auto Type = ExtractLSB(StageFlags);
 
-        static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+        static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
         switch (Type)
         {
             // clang-format off
@@ -2027,6 +2029,14 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
                   ExtFeatures.ShadingRate.attachmentFragmentShadingRate != VK_FALSE ||
                   ExtFeatures.FragmentDensityMap.fragmentDensityMap != VK_FALSE));
 
+    INIT_FEATURE(DynamicPipelineStates,
+                 ExtFeatures.ExtendedDynamicState.extendedDynamicState != VK_FALSE);
+
+    INIT_FEATURE(WorkGraphs, false); // Not currently supported
+
+    INIT_FEATURE(ConditionalRendering,
+                 ExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE);
+
 #undef INIT_FEATURE
 
     // Not supported in Vulkan on top of Metal.
@@ -2036,7 +2046,7 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
     Features.DurationQueries        = DEVICE_FEATURE_STATE_DISABLED;
 #endif
 
-    ASSERT_SIZEOF(DeviceFeatures, 40, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
+    ASSERT_SIZEOF(DeviceFeatures, 43, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
 
     return Features;
 }
@@ -2142,8 +2152,8 @@ void GetAllowedStagesAndAccessMask(BIND_FLAGS Flags, VkPipelineStageFlags& Stage
                 AccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
                 break;
             case BIND_INDIRECT_DRAW_ARGS:
-                StageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-                AccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+                StageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
+                AccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT;
                 break;
             case BIND_INPUT_ATTACHMENT:
                 StageMask |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
@@ -146,6 +146,7 @@ static VkAccessFlags AccessMaskFromImageLayout(VkImageLayout Layout,
 VulkanCommandBuffer::VulkanCommandBuffer() noexcept
 {
     m_ImageBarriers.reserve(32);
+    m_PendingCopies.Regions.reserve(32);
 }
 
 void VulkanCommandBuffer::TransitionImageLayout(VkImage                        Image,
@@ -178,12 +179,31 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
     // Check overlapping subresources
     for (size_t i = 0; i < m_ImageBarriers.size(); ++i)
     {
-        const auto& ImgBarrier = m_ImageBarriers[i];
+        auto& ImgBarrier = m_ImageBarriers[i];
         if (ImgBarrier.image != Image)
             continue;
 
         const auto& OtherRange = ImgBarrier.subresourceRange;
 
+        // Pending barriers are always flushed before the next command is recorded, so the image
+        // can't have been accessed in the intermediate layout. If the new transition continues the
+        // pending one for the same subresources (or discards the contents), both transitions can be
+        // merged into a single OldLayout -> NewLayout barrier instead of splitting the batch.
+        if ((ImgBarrier.newLayout == OldLayout || OldLayout == VK_IMAGE_LAYOUT_UNDEFINED) &&
+            OtherRange.aspectMask == SubresRange.aspectMask &&
+            OtherRange.baseMipLevel == SubresRange.baseMipLevel &&
+            OtherRange.levelCount == SubresRange.levelCount &&
+            OtherRange.baseArrayLayer == SubresRange.baseArrayLayer &&
+            OtherRange.layerCount == SubresRange.layerCount)
+        {
+            ImgBarrier.newLayout     = NewLayout;
+            ImgBarrier.dstAccessMask = AccessMaskFromImageLayout(NewLayout, true) & m_Barrier.SupportedAccessMask;
+
+            m_Barrier.ImageSrcStages |= SrcStages;
+            m_Barrier.ImageDstStages |= DstStages;
+            return;
+        }
+
         const auto StartLayer0 = SubresRange.baseArrayLayer;
         const auto EndLayer0   = SubresRange.layerCount != VK_REMAINING_ARRAY_LAYERS ? (SubresRange.baseArrayLayer + SubresRange.layerCount) : ~0u;
         const auto StartLayer1 = OtherRange.baseArrayLayer;
@@ -245,7 +265,15 @@ void VulkanCommandBuffer::MemoryBarrier(VkAccessFlags        srcAccessMask,
 
 void VulkanCommandBuffer::FlushBarriers()
 {
-    if (m_Barrier.MemorySrcStages == 0 && m_Barrier.MemoryDstStages == 0 && m_ImageBarriers.empty())
+    FlushBarriers(VK_NULL_HANDLE, 0);
+}
+
+void VulkanCommandBuffer::FlushBarriers(VkEvent WaitEvent, VkPipelineStageFlags EventSrcStages)
+{
+    // The pending copies were added before the pending barriers (see AppendBufferCopy)
+    FlushBufferCopies();
+
+    if (!HasPendingBarriers())
         return;
 
     if (m_State.RenderPass != VK_NULL_HANDLE)
@@ -269,16 +297,40 @@ void VulkanCommandBuffer::FlushBarriers()
     const VkPipelineStageFlags DstStages = (m_Barrier.ImageDstStages | m_Barrier.MemoryDstStages) & m_Barrier.SupportedStagesMask;
     VERIFY_EXPR(SrcStages != 0 && DstStages != 0);
 
-    vkCmdPipelineBarrier(m_VkCmdBuffer,
-                         SrcStages,
-                         DstStages,
-                         0,
-                         HasMemoryBarrier ? 1 : 0,
-                         HasMemoryBarrier ? &vkMemBarrier : nullptr,
-                         0,
-                         nullptr,
-                         static_cast<uint32_t>(m_ImageBarriers.size()),
-                         m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+    if (WaitEvent != VK_NULL_HANDLE)
+    {
+        // srcStageMask of vkCmdWaitEvents must be the bitwise OR of the stageMask parameters
+        // used in previous calls to vkCmdSetEvent with the same event.
+        VERIFY((SrcStages & ~(EventSrcStages & m_Barrier.SupportedStagesMask)) == 0,
+               "Barrier source stages are not covered by the stages the event was set with");
+        vkCmdWaitEvents(m_VkCmdBuffer,
+                        1,
+                        &WaitEvent,
+                        EventSrcStages & m_Barrier.SupportedStagesMask,
+                        DstStages,
+                        HasMemoryBarrier ? 1 : 0,
+                        HasMemoryBarrier ? &vkMemBarrier : nullptr,
+                        0,
+                        nullptr,
+                        static_cast<uint32_t>(m_ImageBarriers.size()),
+                        m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+    }
+    else
+    {
+        vkCmdPipelineBarrier(m_VkCmdBuffer,
+                             SrcStages,
+                             DstStages,
+                             0,
+                             HasMemoryBarrier ? 1 : 0,
+                             HasMemoryBarrier ? &vkMemBarrier : nullptr,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(m_ImageBarriers.size()),
+                             m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+    }
+
+    if (m_pBarrierCounter != nullptr)
+        *m_pBarrierCounter += m_ImageBarriers.size() + (HasMemoryBarrier ? 1 : 0);
 
     m_ImageBarriers.clear();
     m_Barrier.ImageSrcStages  = 0;
@@ -290,4 +342,59 @@ void VulkanCommandBuffer::FlushBarriers()
     // Do not clear SupportedStagesMask and SupportedAccessMask
 }
 
+void VulkanCommandBuffer::AppendBufferCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, const VkBufferCopy& Region)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (m_State.RenderPass != VK_NULL_HANDLE)
+    {
+        // Copy buffer operation must be performed outside of render pass.
+        EndRenderPass();
+    }
+
+    // Limits the cost of the overlap test below
+    constexpr size_t MaxRegionsPerCopy = 256;
+
+    // The copy can only be merged if no barriers were added after the pending copies.
+    bool CanMerge =
+        m_PendingCopies.SrcBuffer == srcBuffer &&
+        m_PendingCopies.DstBuffer == dstBuffer &&
+        m_PendingCopies.Regions.size() < MaxRegionsPerCopy &&
+        !HasPendingBarriers();
+
+    if (CanMerge)
+    {
+        // The regions of one command may be copied in any order, so overlapping
+        // writes must be recorded as separate commands.
+        for (const auto& Pending : m_PendingCopies.Regions)
+        {
+            if (Pending.dstOffset < Region.dstOffset + Region.size && Region.dstOffset < Pending.dstOffset + Pending.size)
+            {
+                CanMerge = false;
+                break;
+            }
+        }
+    }
+
+    if (!CanMerge)
+    {
+        FlushBarriers();
+        m_PendingCopies.SrcBuffer = srcBuffer;
+        m_PendingCopies.DstBuffer = dstBuffer;
+    }
+
+    m_PendingCopies.Regions.push_back(Region);
+}
+
+void VulkanCommandBuffer::FlushBufferCopies()
+{
+    if (m_PendingCopies.Regions.empty())
+        return;
+
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Buffer copies must not be pending inside a render pass");
+    vkCmdCopyBuffer(m_VkCmdBuffer, m_PendingCopies.SrcBuffer, m_PendingCopies.DstBuffer,
+                    static_cast<uint32_t>(m_PendingCopies.Regions.size()), m_PendingCopies.Regions.data());
+    m_PendingCopies.Regions.clear();
+}
+
 } // namespace VulkanUtilities
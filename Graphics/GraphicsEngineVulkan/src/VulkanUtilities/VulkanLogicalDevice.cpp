@@ -26,6 +26,7 @@
  */
 
 #include <limits>
+#include <atomic>
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
@@ -34,6 +35,11 @@
 namespace VulkanUtilities
 {
 
+#if DILIGENT_USE_VOLK
+// The number of logical devices created by the process that have not been destroyed yet
+static std::atomic<int> g_NumLiveDevices{0};
+#endif
+
 std::shared_ptr<VulkanLogicalDevice> VulkanLogicalDevice::Create(const VulkanPhysicalDevice&  PhysicalDevice,
                                                                  const VkDeviceCreateInfo&    DeviceCI,
                                                                  const ExtensionFeatures&     EnabledExtFeatures,
@@ -46,6 +52,9 @@ std::shared_ptr<VulkanLogicalDevice> VulkanLogicalDevice::Create(const VulkanPhy
 VulkanLogicalDevice::~VulkanLogicalDevice()
 {
     vkDestroyDevice(m_VkDevice, m_VkAllocator);
+#if DILIGENT_USE_VOLK
+    g_NumLiveDevices.fetch_sub(1);
+#endif
 }
 
 VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDevice,
@@ -60,9 +69,19 @@ VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDe
     CHECK_VK_ERROR_AND_THROW(res, "Failed to create logical device");
 
 #if DILIGENT_USE_VOLK
-    // Since we only use one device at this time, load device function entries
-    // https://github.com/zeux/volk#optimizing-device-calls
-    volkLoadDevice(m_VkDevice);
+    if (g_NumLiveDevices.fetch_add(1) == 0)
+    {
+        // While there is only one device, load device function entries directly
+        // https://github.com/zeux/volk#optimizing-device-calls
+        volkLoadDevice(m_VkDevice);
+    }
+    else
+    {
+        // Entries loaded for one device must not be used with another device, which may belong to a different
+        // driver (e.g. one device per GPU). Use loader trampolines that dispatch calls by the device handle.
+        LOG_INFO_MESSAGE("Multiple Vulkan devices are alive: device functions will be dispatched through the Vulkan loader");
+        volkLoadInstance(volkGetLoadedInstance());
+    }
 #endif
 
     auto GraphicsStages =
@@ -117,6 +136,12 @@ VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDe
         GraphicsStages |= VK_PIPELINE_STAGE_FRAGMENT_DENSITY_PROCESS_BIT_EXT;
         GraphicsAccessMask |= VK_ACCESS_FRAGMENT_DENSITY_MAP_READ_BIT_EXT;
     }
+    if (m_EnabledExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE)
+    {
+        // Conditional rendering predicates draw and dispatch commands
+        ComputeStages |= VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
+        ComputeAccessMask |= VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT;
+    }
 
     const auto QueueCount = PhysicalDevice.GetQueueProperties().size();
     m_SupportedStagesMask.resize(QueueCount, 0);
@@ -282,6 +307,9 @@ PipelineWrapper VulkanLogicalDevice::CreateComputePipeline(const VkComputePipeli
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
     auto err = vkCreateComputePipelines(m_VkDevice, cache, 1, &PipelineCI, m_VkAllocator, &vkPipeline);
+    // The pipeline was not found in the cache, and the caller requested not to compile it
+    if (err == VK_PIPELINE_COMPILE_REQUIRED_EXT && (PipelineCI.flags & VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT) != 0)
+        return PipelineWrapper{};
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create compute pipeline '", DebugName, '\'');
 
     if (*DebugName != 0)
@@ -302,6 +330,9 @@ PipelineWrapper VulkanLogicalDevice::CreateGraphicsPipeline(const VkGraphicsPipe
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
     auto err = vkCreateGraphicsPipelines(m_VkDevice, cache, 1, &PipelineCI, m_VkAllocator, &vkPipeline);
+    // The pipeline was not found in the cache, and the caller requested not to compile it
+    if (err == VK_PIPELINE_COMPILE_REQUIRED_EXT && (PipelineCI.flags & VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT) != 0)
+        return PipelineWrapper{};
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create graphics pipeline '", DebugName, '\'');
 
     if (*DebugName != 0)
@@ -385,6 +416,12 @@ SemaphoreWrapper VulkanLogicalDevice::CreateTimelineSemaphore(uint64_t InitialVa
     return CreateVulkanObject<VkSemaphore, VulkanHandleTypeId::Semaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "timeline semaphore");
 }
 
+EventWrapper VulkanLogicalDevice::CreateEvent(const VkEventCreateInfo& EventCI, const char* DebugName) const
+{
+    VERIFY_EXPR(EventCI.sType == VK_STRUCTURE_TYPE_EVENT_CREATE_INFO);
+    return CreateVulkanObject<VkEvent, VulkanHandleTypeId::Event>(vkCreateEvent, EventCI, DebugName, "event");
+}
+
 QueryPoolWrapper VulkanLogicalDevice::CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName) const
 {
     VERIFY_EXPR(QueryPoolCI.sType == VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO);
@@ -447,6 +484,12 @@ PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCa
     return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, CI, DebugName, "pipeline cache");
 }
 
+DescriptorUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName) const
+{
+    VERIFY_EXPR(CI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO);
+    return CreateVulkanObject<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(vkCreateDescriptorUpdateTemplate, CI, DebugName, "descriptor update template");
+}
+
 void VulkanLogicalDevice::ReleaseVulkanObject(CommandPoolWrapper&& CmdPool) const
 {
     vkDestroyCommandPool(m_VkDevice, CmdPool.m_VkObject, m_VkAllocator);
@@ -543,6 +586,12 @@ void VulkanLogicalDevice::ReleaseVulkanObject(SemaphoreWrapper&& Semaphore) cons
     Semaphore.m_VkObject = VK_NULL_HANDLE;
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(EventWrapper&& Event) const
+{
+    vkDestroyEvent(m_VkDevice, Event.m_VkObject, m_VkAllocator);
+    Event.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::ReleaseVulkanObject(QueryPoolWrapper&& QueryPool) const
 {
     vkDestroyQueryPool(m_VkDevice, QueryPool.m_VkObject, m_VkAllocator);
@@ -565,6 +614,12 @@ void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipeCache)
     PipeCache.m_VkObject = VK_NULL_HANDLE;
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescrUpdateTemplate) const
+{
+    vkDestroyDescriptorUpdateTemplate(m_VkDevice, DescrUpdateTemplate.m_VkObject, m_VkAllocator);
+    DescrUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -707,6 +762,13 @@ void VulkanLogicalDevice::UpdateDescriptorSets(uint32_t                    descr
     vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
+void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                                          VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                          const void*                pData) const
+{
+    vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+}
+
 VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool,
                                                VkCommandPoolResetFlags flags) const
 {
@@ -745,4 +807,26 @@ VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipelin
 #endif
 }
 
+void VulkanLogicalDevice::GetShaderModuleIdentifier(VkShaderModule shaderModule, VkShaderModuleIdentifierEXT& Identifier) const
+{
+    Identifier       = {};
+    Identifier.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_IDENTIFIER_EXT;
+#if DILIGENT_USE_VOLK
+    vkGetShaderModuleIdentifierEXT(m_VkDevice, shaderModule, &Identifier);
+#else
+    UNSUPPORTED("vkGetShaderModuleIdentifierEXT is only available through Volk");
+#endif
+}
+
+VkResult VulkanLogicalDevice::GetCalibratedTimestamps(uint32_t timestampCount, const VkCalibratedTimestampInfoEXT* pTimestampInfos, uint64_t* pTimestamps, uint64_t* pMaxDeviation) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY(m_EnabledExtFeatures.CalibratedTimestamps, "VK_EXT_calibrated_timestamps extension is not enabled");
+    return vkGetCalibratedTimestampsEXT(m_VkDevice, timestampCount, pTimestampInfos, pTimestamps, pMaxDeviation);
+#else
+    UNSUPPORTED("vkGetCalibratedTimestampsEXT is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
 } // namespace VulkanUtilities
@@ -83,6 +83,9 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
             &m_CPUMemory);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to map staging memory");
     }
+
+    m_GPUMemoryRecord = Diligent::GPUMemoryRecord{ParentMemoryMgr.m_pGPUMemoryTracker, Diligent::GPU_MEMORY_CATEGORY_MEMORY_POOL, Diligent::GPU_MEMORY_ALLOCATION_TYPE_COMMITTED,
+                                                  ParentMemoryMgr.m_MgrName.c_str(), PageSize, PageSize};
 }
 
 VulkanMemoryPage::~VulkanMemoryPage()
@@ -158,6 +161,55 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
 }
 
+VulkanMemoryAllocation VulkanMemoryManager::AllocateFromExistingPages(const MemoryPageIndex& PageIdx, VkDeviceSize Size, VkDeviceSize Alignment)
+{
+    VulkanMemoryAllocation Allocation;
+
+    auto range = m_Pages.equal_range(PageIdx);
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        auto& Page = page_it->second;
+        // Do not spill allocations into empty pages while partially used pages have space.
+        // Otherwise long-living allocations get scattered across all pages, and no page
+        // can ever be released.
+        if (Page.IsEmpty())
+            continue;
+
+        Allocation = Page.Allocate(Size, Alignment);
+        if (Allocation.Page != nullptr)
+            return Allocation;
+    }
+
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        auto& Page = page_it->second;
+        // The page may have become non-empty after the first pass; trying it again is harmless.
+        Allocation = Page.Allocate(Size, Alignment);
+        if (Allocation.Page != nullptr)
+            return Allocation;
+    }
+
+    return Allocation;
+}
+
+bool VulkanMemoryManager::IsWithinHeapBudget(uint32_t MemoryTypeIndex, VkDeviceSize PageSize) const
+{
+    if (!m_UseMemoryBudget)
+        return true;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT Budget{};
+    if (!m_PhysicalDevice.GetMemoryBudget(Budget))
+        return true;
+
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+    VERIFY_EXPR(MemoryTypeIndex < MemoryProps.memoryTypeCount);
+    const auto HeapIndex = MemoryProps.memoryTypes[MemoryTypeIndex].heapIndex;
+    VERIFY_EXPR(HeapIndex < MemoryProps.memoryHeapCount);
+
+    // heapUsage includes memory allocated by other processes and other allocators of this process
+    return Budget.heapUsage[HeapIndex] + PageSize <= Budget.heapBudget[HeapIndex];
+}
+
 VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
 {
     VulkanMemoryAllocation Allocation;
@@ -169,34 +221,51 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    MemoryPageIndex PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
 
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        // Every page is protected by its own mutex, so the page list only needs to be locked for reading
+        std::shared_lock<std::shared_timed_mutex> SharedLock{m_PagesMtx};
+        Allocation = AllocateFromExistingPages(PageIdx, Size, Alignment);
     }
 
     size_t stat_ind = HostVisible ? 1 : 0;
     if (Allocation.Page == nullptr)
     {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
-
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
-
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
-        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        std::unique_lock<std::shared_timed_mutex> Lock{m_PagesMtx};
+
+        // Another thread may have created a new page while we were waiting for the lock
+        Allocation = AllocateFromExistingPages(PageIdx, Size, Alignment);
+        if (Allocation.Page == nullptr)
+        {
+            auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+            while (PageSize < Size)
+                PageSize *= 2;
+
+            if (!IsWithinHeapBudget(MemoryTypeIndex, PageSize))
+            {
+                // Return all empty pages, including the reserved ones, to the driver before
+                // going over the budget. This leaves more room for the new page.
+                ReleaseEmptyPages(0, 0);
+                if (!IsWithinHeapBudget(MemoryTypeIndex, PageSize))
+                {
+                    LOG_WARNING_MESSAGE("VulkanMemoryManager '", m_MgrName, "': creating new ", Diligent::FormatMemorySize(PageSize, 2),
+                                        " page exceeds the budget of the memory heap used by type ", MemoryTypeIndex,
+                                        ". The allocation may fail or degrade the performance.");
+                }
+            }
+
+            m_CurrAllocatedSize[stat_ind] += PageSize;
+            m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+
+            auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
+            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
+                             " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
+                             "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
+            OnNewPageCreated(it->second);
+            Allocation = it->second.Allocate(Size, Alignment);
+            DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        }
     }
 
     if (Allocation.Page != nullptr)
@@ -204,18 +273,18 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
         VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    const auto CurrUsedSize = m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size) + static_cast<int64_t>(Allocation.Size);
+
+    auto PeakUsedSize = m_PeakUsedSize[stat_ind].load();
+    while (PeakUsedSize < CurrUsedSize && !m_PeakUsedSize[stat_ind].compare_exchange_weak(PeakUsedSize, CurrUsedSize))
+    {
+    }
 
     return Allocation;
 }
 
-void VulkanMemoryManager::ShrinkMemory()
+void VulkanMemoryManager::ReleaseEmptyPages(VkDeviceSize DeviceLocalReserveSize, VkDeviceSize HostVisibleReserveSize)
 {
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
-        return;
-
     auto it = m_Pages.begin();
     while (it != m_Pages.end())
     {
@@ -223,7 +292,7 @@ void VulkanMemoryManager::ShrinkMemory()
         ++it;
         auto& Page          = curr_it->second;
         bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+        auto  ReserveSize   = IsHostVisible ? HostVisibleReserveSize : DeviceLocalReserveSize;
         if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
         {
             auto PageSize = Page.GetPageSize();
@@ -238,6 +307,15 @@ void VulkanMemoryManager::ShrinkMemory()
     }
 }
 
+void VulkanMemoryManager::ShrinkMemory()
+{
+    std::unique_lock<std::shared_timed_mutex> Lock{m_PagesMtx};
+    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+        return;
+
+    ReleaseEmptyPages(m_DeviceLocalReserveSize, m_HostVisibleReserveSize);
+}
+
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible)
 {
     m_CurrUsedSize[IsHostVisible ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
@@ -249,11 +327,11 @@ VulkanMemoryManager::~VulkanMemoryManager()
     auto PeakHostVisiblePages = m_PeakAllocatedSize[1] / m_HostVisiblePageSize;
     LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "' stats:\n"
                                                          "                       Peak used/allocated device-local memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[0], 2, m_PeakAllocatedSize[0]), " / ",
+                     Diligent::FormatMemorySize(static_cast<VkDeviceSize>(m_PeakUsedSize[0].load()), 2, m_PeakAllocatedSize[0]), " / ",
                      Diligent::FormatMemorySize(m_PeakAllocatedSize[0], 2, m_PeakAllocatedSize[0]),
                      " (", PeakDeviceLocalPages, (PeakDeviceLocalPages == 1 ? " page)" : " pages)"),
                      "\n                       Peak used/allocated host-visible memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
+                     Diligent::FormatMemorySize(static_cast<VkDeviceSize>(m_PeakUsedSize[1].load()), 2, m_PeakAllocatedSize[1]), " / ",
                      Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
                      " (", PeakHostVisiblePages, (PeakHostVisiblePages == 1 ? " page)" : " pages)"));
 
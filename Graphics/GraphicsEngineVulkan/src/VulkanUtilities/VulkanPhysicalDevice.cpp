@@ -31,6 +31,13 @@
 
 #include "VulkanErrors.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
+#include "GraphicsAccessories.hpp"
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#endif
 
 namespace VulkanUtilities
 {
@@ -305,11 +312,117 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(const CreateInfo& CI) :
             m_ExtFeatures.HostQueryReset.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
         }
 
+        if (IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ExtendedDynamicState;
+            NextFeat  = &m_ExtFeatures.ExtendedDynamicState.pNext;
+
+            m_ExtFeatures.ExtendedDynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ConditionalRendering;
+            NextFeat  = &m_ExtFeatures.ConditionalRendering.pNext;
+
+            m_ExtFeatures.ConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+        }
+
+        // Graphics pipeline library extension requires VK_KHR_pipeline_library.
+        if (IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.GraphicsPipelineLibrary;
+            NextFeat  = &m_ExtFeatures.GraphicsPipelineLibrary.pNext;
+
+            m_ExtFeatures.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.GraphicsPipelineLibrary;
+            NextProp  = &m_ExtProperties.GraphicsPipelineLibrary.pNext;
+
+            m_ExtProperties.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        }
+
+        // Shader module identifier extension requires VK_EXT_pipeline_creation_cache_control.
+        if (IsExtensionSupported(VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PipelineCreationCacheControl;
+            NextFeat  = &m_ExtFeatures.PipelineCreationCacheControl.pNext;
+
+            m_ExtFeatures.PipelineCreationCacheControl.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_CREATION_CACHE_CONTROL_FEATURES_EXT;
+
+            *NextFeat = &m_ExtFeatures.ShaderModuleIdentifier;
+            NextFeat  = &m_ExtFeatures.ShaderModuleIdentifier.pNext;
+
+            m_ExtFeatures.ShaderModuleIdentifier.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_MODULE_IDENTIFIER_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.ShaderModuleIdentifier;
+            NextProp  = &m_ExtProperties.ShaderModuleIdentifier.pNext;
+
+            m_ExtProperties.ShaderModuleIdentifier.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_MODULE_IDENTIFIER_PROPERTIES_EXT;
+        }
+
+        // Present wait extension requires VK_KHR_present_id.
+        if (IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PresentId;
+            NextFeat  = &m_ExtFeatures.PresentId.pNext;
+
+            m_ExtFeatures.PresentId.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+            *NextFeat = &m_ExtFeatures.PresentWait;
+            NextFeat  = &m_ExtFeatures.PresentWait.pNext;
+
+            m_ExtFeatures.PresentWait.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        }
+
         if (IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
         {
             m_ExtFeatures.DrawIndirectCount = true;
         }
 
+        if (IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        {
+            m_ExtFeatures.MemoryBudget = true;
+        }
+
+        if (IsExtensionSupported(VK_AMD_BUFFER_MARKER_EXTENSION_NAME))
+        {
+            m_ExtFeatures.BufferMarker = true;
+        }
+
+        if (IsExtensionSupported(VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DiagnosticCheckpoints = true;
+        }
+
+        if (IsExtensionSupported(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DisplayTiming = true;
+        }
+
+        if (IsExtensionSupported(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME) || m_VkVersion >= VK_API_VERSION_1_3)
+        {
+            m_ExtFeatures.PipelineCreationFeedback = true;
+        }
+
+        VkTimeDomainEXT HostTimeDomain{};
+        if (IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) && GetHostTimeDomain(HostTimeDomain))
+        {
+            // Timestamps can only be calibrated if both the device and the host time domains are supported
+            uint32_t NumTimeDomains = 0;
+            vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &NumTimeDomains, nullptr);
+            std::vector<VkTimeDomainEXT> TimeDomains(NumTimeDomains);
+            vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &NumTimeDomains, TimeDomains.data());
+
+            const auto HasTimeDomain = [&TimeDomains](VkTimeDomainEXT Domain) {
+                return std::find(TimeDomains.begin(), TimeDomains.end(), Domain) != TimeDomains.end();
+            };
+            m_ExtFeatures.CalibratedTimestamps = HasTimeDomain(VK_TIME_DOMAIN_DEVICE_EXT) && HasTimeDomain(HostTimeDomain);
+        }
+
         if (IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
         {
             *NextProp = &m_ExtProperties.Maintenance3;
@@ -437,6 +550,54 @@ bool VulkanPhysicalDevice::IsExtensionSupported(const char* ExtensionName) const
     return false;
 }
 
+bool VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const
+{
+#if DILIGENT_USE_VOLK
+    if (!m_ExtFeatures.MemoryBudget)
+        return false;
+
+    Budget       = {};
+    Budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 MemProps2{};
+    MemProps2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    MemProps2.pNext = &Budget;
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemProps2);
+    Budget.pNext = nullptr;
+    return true;
+#else
+    (void)Budget;
+    return false;
+#endif
+}
+
+bool VulkanPhysicalDevice::GetHostTimeDomain(VkTimeDomainEXT& Domain)
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    Domain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+    return true;
+#elif PLATFORM_LINUX || PLATFORM_ANDROID
+    Domain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+    return true;
+#else
+    (void)Domain;
+    return false;
+#endif
+}
+
+uint64_t VulkanPhysicalDevice::HostTimestampToNanoseconds(uint64_t Timestamp)
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    // QueryPerformanceCounter ticks are converted the same way as by std::chrono::steady_clock
+    LARGE_INTEGER Frequency;
+    QueryPerformanceFrequency(&Frequency);
+    return Diligent::TicksToNanoseconds(Timestamp, static_cast<uint64_t>(Frequency.QuadPart));
+#else
+    // CLOCK_MONOTONIC is in nanoseconds
+    return Timestamp;
+#endif
+}
+
 bool VulkanPhysicalDevice::CheckPresentSupport(HardwareQueueIndex queueFamilyIndex, VkSurfaceKHR VkSurface) const
 {
     VkBool32 PresentSupport = VK_FALSE;
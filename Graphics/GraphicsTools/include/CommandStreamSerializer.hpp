@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Command stream format and serialization helpers shared by CommandStreamRecorder and CommandStreamPlayer
+
+#include <type_traits>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/BufferView.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "../../GraphicsEngine/interface/Sampler.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../../Common/interface/Serializer.hpp"
+#include "../../../Common/interface/DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+struct CommandStreamFormat
+{
+    static constexpr Uint32 HeaderMagicNumber = 0xDE00C5A0;
+    static constexpr Uint32 StreamVersion     = 1;
+
+    // All chunks start at offsets that are multiples of this value.
+    static constexpr size_t ChunkAlignment = 8;
+
+    struct StreamHeader
+    {
+        Uint32 MagicNumber = HeaderMagicNumber;
+        Uint32 Version     = StreamVersion;
+    };
+
+    enum class ChunkType : Uint32
+    {
+        Undefined = 0,
+
+        // Object chunks. The player creates all objects before replaying the commands.
+        CreateBuffer,
+        CreateBufferView,
+        CreateTexture,
+        CreateTextureView,
+        CreateSampler,
+        CreateShader,
+        CreatePipelineState,
+        PipelineStaticBindings,
+        CreateShaderResourceBinding,
+
+        // Command chunks
+        EndFrame,
+        SetPipelineState,
+        ShaderResourceBindings,
+        CommitShaderResources,
+        TransitionShaderResources,
+        SetStencilRef,
+        SetBlendFactors,
+        SetVertexBuffers,
+        SetIndexBuffer,
+        SetViewports,
+        SetScissorRects,
+        SetRenderTargets,
+        Draw,
+        DrawIndexed,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        DispatchCompute,
+        DispatchComputeIndirect,
+        ClearRenderTarget,
+        ClearDepthStencil,
+        UpdateBuffer,
+        CopyBuffer,
+        WriteBuffer,
+        UpdateTexture,
+        CopyTexture,
+        GenerateMips,
+        TransitionResourceStates,
+        InvalidateState,
+        Flush,
+        WaitForIdle,
+        BeginDebugGroup,
+        EndDebugGroup,
+        InsertDebugLabel,
+
+        Count
+    };
+
+    struct ChunkHeader
+    {
+        ChunkType Type = ChunkType::Undefined;
+        // Payload size, not including the header and the alignment padding.
+        Uint32 Size = 0;
+    };
+
+    static bool IsObjectChunk(ChunkType Type)
+    {
+        return Type >= ChunkType::CreateBuffer && Type <= ChunkType::CreateShaderResourceBinding;
+    }
+
+    // A single element of a shader resource variable.
+    struct ResourceBinding
+    {
+        SHADER_TYPE    ShaderType = SHADER_TYPE_UNKNOWN;
+        const Char*    Name       = nullptr;
+        Uint32         ArrayIndex = 0;
+        IDeviceObject* pObject    = nullptr;
+    };
+};
+static_assert(sizeof(CommandStreamFormat::ChunkHeader) == CommandStreamFormat::ChunkAlignment, "Chunk payloads must be aligned");
+static_assert(sizeof(CommandStreamFormat::StreamHeader) == CommandStreamFormat::ChunkAlignment, "Chunk payloads must be aligned");
+
+
+/// Maps objects to stream object IDs and back. ID 0 is reserved for null objects.
+class CommandStreamObjectResolver
+{
+public:
+    /// Returns the ID of the object. Called when writing the stream.
+    virtual Uint32 GetObjectId(IObject* pObject) = 0;
+
+    /// Returns the object with the given ID. Called when reading the stream.
+    virtual IObject* GetObject(Uint32 Id) = 0;
+};
+
+
+/// Serializes command stream chunk payloads.
+
+/// The same method is used to measure, write and read every payload, so that
+/// the recorder and the player can never disagree on the layout.
+template <SerializerMode Mode>
+class CommandStreamSerializer
+{
+public:
+    template <typename T>
+    using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
+
+    using ResourceBinding = CommandStreamFormat::ResourceBinding;
+
+    /// \param [in] Ser       - Underlying serializer.
+    /// \param [in] Resolver  - Object resolver.
+    /// \param [in] Allocator - Allocator for arrays and strings; must not be null in Read mode.
+    CommandStreamSerializer(Serializer<Mode>&            Ser,
+                            CommandStreamObjectResolver& Resolver,
+                            DynamicLinearAllocator*      Allocator) noexcept :
+        m_Ser{Ser},
+        m_Resolver{Resolver},
+        m_Allocator{Allocator}
+    {}
+
+    template <typename... ArgTypes>
+    bool operator()(ArgTypes&... Args)
+    {
+        return m_Ser(Args...);
+    }
+
+    bool SerializeBytes(typename Serializer<Mode>::VoidPtr pBytes, ConstQual<size_t>& Size)
+    {
+        return m_Ser.SerializeBytes(pBytes, Size);
+    }
+
+    /// Serializes the object as its ID.
+    template <typename PtrType>
+    bool SerializeObject(PtrType& pObject)
+    {
+        return SerializeObjectImpl(pObject, std::integral_constant<bool, Mode == SerializerMode::Read>{});
+    }
+
+    bool SerializeBufferDesc(ConstQual<BufferDesc>& Desc);
+    bool SerializeBufferViewDesc(ConstQual<BufferViewDesc>& Desc);
+    bool SerializeTextureDesc(ConstQual<TextureDesc>& Desc);
+    bool SerializeTextureViewDesc(ConstQual<TextureViewDesc>& Desc);
+    bool SerializeSamplerDesc(ConstQual<SamplerDesc>& Desc);
+    bool SerializeShaderMacros(ConstQual<const ShaderMacro*>& Macros);
+    bool SerializeShaderCreateInfo(ConstQual<ShaderCreateInfo>& CI);
+    bool SerializeGraphicsPipelineCreateInfo(ConstQual<GraphicsPipelineStateCreateInfo>& CI);
+    bool SerializeComputePipelineCreateInfo(ConstQual<ComputePipelineStateCreateInfo>& CI);
+    bool SerializeBindings(ConstQual<const ResourceBinding*>& Bindings, ConstQual<Uint32>& NumBindings);
+
+    bool SerializeDrawAttribs(ConstQual<DrawAttribs>& Attribs);
+    bool SerializeDrawIndexedAttribs(ConstQual<DrawIndexedAttribs>& Attribs);
+    bool SerializeDrawIndirectAttribs(ConstQual<DrawIndirectAttribs>& Attribs);
+    bool SerializeDrawIndexedIndirectAttribs(ConstQual<DrawIndexedIndirectAttribs>& Attribs);
+    bool SerializeDispatchComputeAttribs(ConstQual<DispatchComputeAttribs>& Attribs);
+    bool SerializeDispatchComputeIndirectAttribs(ConstQual<DispatchComputeIndirectAttribs>& Attribs);
+    bool SerializeSetRenderTargetsAttribs(ConstQual<SetRenderTargetsAttribs>& Attribs);
+    bool SerializeCopyTextureAttribs(ConstQual<CopyTextureAttribs>& Attribs);
+    bool SerializeViewports(ConstQual<const Viewport*>& Viewports, ConstQual<Uint32>& NumViewports);
+    bool SerializeRects(ConstQual<const Rect*>& Rects, ConstQual<Uint32>& NumRects);
+    bool SerializeBox(ConstQual<Box>& Box);
+    bool SerializeStateTransitions(ConstQual<const StateTransitionDesc*>& Barriers, ConstQual<Uint32>& NumBarriers);
+
+    /// Serializes an optional array of four floats, such as a clear color or blend factors.
+    bool SerializeFloat4(ConstQual<const float*>& pValues);
+
+private:
+    template <typename ObjectType>
+    bool SerializeObjectImpl(ObjectType* const& pObject, std::false_type /*IsReading*/)
+    {
+        Uint32 Id = pObject != nullptr ? m_Resolver.GetObjectId(pObject) : 0;
+        return m_Ser(Id);
+    }
+
+    template <typename ObjectType>
+    bool SerializeObjectImpl(ObjectType*& pObject, std::true_type /*IsReading*/)
+    {
+        Uint32 Id = 0;
+        if (!m_Ser(Id))
+            return false;
+        pObject = static_cast<ObjectType*>(Id != 0 ? m_Resolver.GetObject(Id) : nullptr);
+        return true;
+    }
+
+private:
+    Serializer<Mode>&            m_Ser;
+    CommandStreamObjectResolver& m_Resolver;
+    DynamicLinearAllocator*      m_Allocator;
+};
+
+} // namespace Diligent
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::BLASCompactionManager class
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/BottomLevelAS.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "GPUReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Compacts bottom-level acceleration structures without stalling the CPU.
+
+/// Enqueue() records IDeviceContext::WriteBLASCompactedSize() commands for a group of BLASes
+/// and reads the sizes back asynchronously through a GPUReadbackQueue. Once the sizes
+/// are available, Process() creates the compacted BLASes, records COPY_AS_MODE_COMPACT copies
+/// and passes every original BLAS together with its compacted copy to the callback, where the
+/// application replaces its references (e.g. in TLAS instances).
+///
+/// The compacted BLAS can be used right after the callback returns, because the copy is
+/// recorded in the same context before any later commands. The original BLAS may be released
+/// in the callback: the engine keeps the underlying resources alive until the GPU is done with them.
+///
+/// \note   All methods must be called from the thread that owns the device context.
+///         BLASes must be created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag and must have been
+///         built in the same context before they are enqueued.
+class BLASCompactionManager
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create the compacted BLASes.
+        IRenderDevice* pDevice = nullptr;
+
+        /// The maximum number of recycled compacted size buffers that are kept for reuse.
+        Uint32 MaxRecycledBuffers = 4;
+    };
+    explicit BLASCompactionManager(const CreateInfo& CI);
+    ~BLASCompactionManager();
+
+    // clang-format off
+    BLASCompactionManager           (const BLASCompactionManager&) = delete;
+    BLASCompactionManager& operator=(const BLASCompactionManager&) = delete;
+    BLASCompactionManager           (BLASCompactionManager&&)      = delete;
+    BLASCompactionManager& operator=(BLASCompactionManager&&)      = delete;
+    // clang-format on
+
+    /// Callback that receives the original BLAS and its compacted copy.
+    /// pCompacted is null if the BLAS could not be compacted, in which case the original BLAS
+    /// should be kept.
+    using CallbackType = std::function<void(IBottomLevelAS* pOriginal, IBottomLevelAS* pCompacted)>;
+
+    /// Enqueues compaction of NumBLASes acceleration structures.
+    /// The callback is invoked by Process() for every BLAS once it has been compacted.
+    void Enqueue(IDeviceContext*        pContext,
+                 IBottomLevelAS* const* ppBLASes,
+                 Uint32                 NumBLASes,
+                 CallbackType           Callback);
+
+    /// Compacts the BLASes whose compacted sizes have been read back.
+    /// This method should be called once per frame.
+    void Process(IDeviceContext* pContext);
+
+    /// Waits until all enqueued BLASes are compacted.
+    void Flush(IDeviceContext* pContext);
+
+    struct Statistics
+    {
+        /// The number of BLASes that have been compacted.
+        Uint64 NumCompacted = 0;
+
+        /// The number of BLASes that could not be compacted.
+        Uint64 NumFailed = 0;
+
+        /// The total size of the compacted BLASes, in bytes.
+        Uint64 CompactedSize = 0;
+    };
+    const Statistics& GetStatistics() const { return m_Stats; }
+
+    /// Returns the number of BLASes that have been enqueued, but not compacted yet.
+    size_t GetNumPendingBLASes() const;
+
+private:
+    struct Batch
+    {
+        std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes;
+        std::vector<Uint64>                        CompactedSizes;
+        RefCntAutoPtr<IBuffer>                     pSizeBuffer;
+        CallbackType                               Callback;
+        bool                                       SizesReady = false;
+    };
+
+    RefCntAutoPtr<IBuffer> GetSizeBuffer(Uint64 Size);
+    void                   Compact(IDeviceContext* pContext, Batch& B);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_MaxRecycledBuffers;
+
+    GPUReadbackQueue m_SizeReadback;
+
+    // Batches waiting for the compacted sizes, in submission order
+    std::deque<std::unique_ptr<Batch>> m_PendingBatches;
+
+    std::vector<RefCntAutoPtr<IBuffer>> m_RecycledBuffers;
+
+    Statistics m_Stats;
+};
+
+} // namespace Diligent
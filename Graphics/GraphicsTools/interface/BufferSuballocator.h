@@ -78,6 +78,23 @@ struct IBufferSuballocation : public IObject
 };
 
 
+/// The maximum number of size-class bins in a buffer suballocator,
+/// see Diligent::BufferSuballocatorCreateInfo::MaxBinnedAllocationSize.
+static constexpr Uint32 BufferSuballocatorMaxBinCount = 16;
+
+/// Usage stats of a buffer suballocator size-class bin.
+struct BufferSuballocatorBinUsageStats
+{
+    /// The size of the blocks served by this bin, in bytes.
+    Uint32 BlockSize = 0;
+
+    /// The current number of allocations served by this bin.
+    Uint32 AllocationCount = 0;
+
+    /// The total size of the buffer memory reserved by this bin, in bytes.
+    Uint64 ReservedSize = 0;
+};
+
 /// Buffer suballocator usage stats.
 struct BufferSuballocatorUsageStats
 {
@@ -92,6 +109,15 @@ struct BufferSuballocatorUsageStats
 
     /// The current number of allocations.
     Uint32 AllocationCount = 0;
+
+    /// The number of size-class bins.
+    Uint32 BinCount = 0;
+
+    /// Usage stats of the size-class bins, from the smallest block size to the largest.
+    /// Only the first BinCount elements are valid.
+    ///
+    /// \remarks   Memory reserved by the bins is included into UsedSize.
+    BufferSuballocatorBinUsageStats Bins[BufferSuballocatorMaxBinCount] = {};
 };
 
 /// Buffer suballocator.
@@ -119,6 +145,8 @@ struct IBufferSuballocator : public IObject
     ///                               stored.
     ///
     /// \remarks    The method is thread-safe and can be called from multiple threads simultaneously.
+    ///             Allocations served by size-class bins (see BufferSuballocatorCreateInfo::MaxBinnedAllocationSize)
+    ///             only lock the internal mutex when a bin needs to take more memory from the buffer.
     virtual void Allocate(Uint32                 Size,
                           Uint32                 Alignment,
                           IBufferSuballocation** ppSuballocation) = 0;
@@ -129,8 +157,34 @@ struct IBufferSuballocator : public IObject
 
 
     /// Returns internal buffer version. The version is incremented every time
-    /// the buffer is expanded.
+    /// the buffer is expanded or suballocations are moved by Defragment().
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Moves suballocations to lower offsets in the buffer to reduce fragmentation.
+
+    /// \param[in]  pDevice        - Pointer to the render device that will be used to create
+    ///                              the internal buffer and a scratch buffer, if necessary.
+    /// \param[in]  pContext       - Pointer to the device context that will be used to record
+    ///                              the copy commands.
+    /// \param[in]  MaxBytesToMove - The maximum total size of the suballocations to move, in bytes.
+    ///
+    /// \return     The total size of the moved suballocations, in bytes.
+    ///
+    /// \remarks    The method moves at most MaxBytesToMove bytes, so that it can be called
+    ///             every frame to incrementally compact the buffer. Suballocations served by
+    ///             size-class bins are never moved.
+    ///
+    ///             When any suballocation is moved, the version returned by GetVersion() is
+    ///             incremented, and the application must query the offsets of its suballocations
+    ///             again. The data is copied by commands recorded in pContext, so the moved
+    ///             suballocations must only be accessed through the same context or after
+    ///             the commands have been executed.
+    ///
+    ///             The method locks the internal mutex while the commands are recorded. Similar to
+    ///             GetBuffer(), it is not thread-safe and an application must externally synchronize
+    ///             the access.
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) = 0;
 };
 
 /// Buffer suballocator create information.
@@ -158,6 +212,25 @@ struct BufferSuballocatorCreateInfo
 
     /// If Desc.Usage == USAGE_SPARSE, the irtual buffer size; ignored otherwise.
     Uint64 VirtualSize = 0;
+
+
+    /// The maximum size of allocations served by size-class bins, in bytes.
+
+    /// Allocations whose size and alignment do not exceed this value are rounded up
+    /// to the next power of two (but no less than 16 bytes) and are served by lock-free
+    /// free lists of blocks of that size. Larger allocations use the general allocator.
+    /// Bins take memory from the buffer in chunks of BinChunkSize bytes and keep it
+    /// until the suballocator is destroyed.
+    ///
+    /// If zero, size-class bins are disabled.
+    /// The value must not exceed 16 << (BufferSuballocatorMaxBinCount - 1).
+    Uint32 MaxBinnedAllocationSize = 0;
+
+
+    /// The size of the chunks that size-class bins take from the buffer, in bytes.
+
+    /// Bins whose block size exceeds this value take one block at a time.
+    Uint32 BinChunkSize = 65536;
 };
 
 /// Creates a new buffer suballocator.
@@ -35,6 +35,10 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 struct BytecodeCacheCreateInfo
 {
     enum RENDER_DEVICE_TYPE DeviceType DEFAULT_INITIALIZER(RENDER_DEVICE_TYPE_UNDEFINED);
+
+    /// Whether to compress the byte code when the cache is stored.
+    /// Compressed byte code is decompressed on first request after the cache is loaded.
+    Bool CompressBytecode DEFAULT_INITIALIZER(False);
 };
 typedef struct BytecodeCacheCreateInfo BytecodeCacheCreateInfo;
 
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandStreamPlayer class
+
+#include <memory>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Replays command streams recorded by CommandStreamRecorder.
+
+/// The player creates all objects of the stream when it is loaded, so that replaying the stream
+/// only executes the commands. The frames are replayed back to back without any pacing, which makes
+/// the player suitable for measuring the CPU and GPU cost of the engine on a fixed workload.
+///
+/// The stream may be replayed on any backend, provided that the shaders were created from source
+/// and the device supports the recorded resources.
+///
+/// \remarks    Resources that were recorded without their contents (e.g. swap chain images) are
+///             created with undefined contents. Immutable resources of this kind are created as
+///             default-usage resources.
+class CommandStreamPlayer
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device to create the objects.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Immediate device context to replay the commands.
+        IDeviceContext* pContext = nullptr;
+    };
+
+    explicit CommandStreamPlayer(const CreateInfo& CI);
+    ~CommandStreamPlayer();
+
+    // clang-format off
+    CommandStreamPlayer           (const CommandStreamPlayer&) = delete;
+    CommandStreamPlayer& operator=(const CommandStreamPlayer&) = delete;
+    CommandStreamPlayer           (CommandStreamPlayer&&)      = delete;
+    CommandStreamPlayer& operator=(CommandStreamPlayer&&)      = delete;
+    // clang-format on
+
+    /// Loads the command stream and creates all its objects.
+
+    /// \param [in] pStreamData - Command stream data.
+    ///
+    /// \return     true if the stream has been loaded successfully, and false otherwise.
+    ///
+    /// \remarks    The player keeps a reference to the data blob. Objects that fail to be created
+    ///             are reported and counted by GetNumFailedObjects(); the commands that use them
+    ///             are skipped.
+    bool Load(IDataBlob* pStreamData);
+
+    /// Loads the command stream from a file, see Load().
+    bool LoadFromFile(const Char* FilePath);
+
+    /// Replay statistics.
+    struct ReplayStats
+    {
+        /// The number of replayed frames.
+        Uint32 NumFrames = 0;
+
+        /// The number of executed commands.
+        Uint32 NumCommands = 0;
+
+        /// The number of commands that were skipped because they use objects that could not be created.
+        Uint32 NumSkippedCommands = 0;
+
+        /// CPU time, in seconds, spent replaying the commands of every frame.
+        std::vector<double> FrameCPUTimes;
+
+        /// Total CPU time, in seconds, spent replaying the commands.
+        double CPUTime = 0;
+
+        /// Time, in seconds, from the start of the replay until the GPU has finished executing all commands.
+        double TotalTime = 0;
+    };
+
+    /// Replays all frames of the loaded stream.
+
+    /// \param [out] pStats - Optional pointer to the replay statistics.
+    ///
+    /// \return     true if the stream has been replayed successfully, and false otherwise.
+    ///
+    /// \remarks    Every frame is ended with IDeviceContext::FinishFrame(). The method waits
+    ///             for the GPU to become idle before it returns.
+    ///             The stream may be replayed multiple times.
+    bool Replay(ReplayStats* pStats = nullptr);
+
+    /// Returns the number of frames in the loaded stream.
+    Uint32 GetNumFrames() const
+    {
+        return m_NumFrames;
+    }
+
+    /// Returns the number of objects in the loaded stream.
+    Uint32 GetNumObjects() const
+    {
+        return m_NumObjects;
+    }
+
+    /// Returns the number of objects of the loaded stream that could not be created.
+    Uint32 GetNumFailedObjects() const
+    {
+        return m_NumFailedObjects;
+    }
+
+private:
+    class StreamReader;
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    std::unique_ptr<StreamReader> m_pReader;
+
+    Uint32 m_NumFrames        = 0;
+    Uint32 m_NumObjects       = 0;
+    Uint32 m_NumFailedObjects = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CommandStreamRecorder class
+
+#include <memory>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Records the commands of an immediate device context into a binary command stream
+/// that can be replayed by CommandStreamPlayer on any backend.
+
+/// The recorder provides a render device and a device context that forward all calls to the original
+/// objects and record them into the stream. The application must use these objects in place of
+/// the original ones to create resources and issue commands that should be recorded.
+/// Frame boundaries are detected automatically from IDeviceContext::GetFrameNumber(), so frames
+/// presented with ISwapChain::Present() are delimited correctly.
+///
+/// The stream contains:
+/// - Buffers, textures, and samplers created through the recording device, including the initial data.
+///   Resources that were created elsewhere (e.g. swap chain images) are recorded when they are first
+///   used, with their description only.
+/// - Texture and buffer views, and shader resource bindings, when they are first used.
+/// - Shaders created from source or bytecode through the recording device. Include files are unrolled.
+/// - Graphics and compute pipelines that use implicit resource signatures and no render pass.
+///   Pipeline create infos are serialized the same way as in device object archives.
+/// - Draw, dispatch, copy, clear, update, resource binding and state transition commands,
+///   buffer contents written through IDeviceContext::MapBuffer(), and debug groups.
+///
+/// Other commands (render passes, ray tracing, mesh shaders, queries, fences, command lists, etc.)
+/// are forwarded to the original context but are not recorded, and a warning is printed once per command.
+/// Buffer ranges and offsets set through IShaderResourceVariable are not recorded either.
+///
+/// \remarks    The recording objects must only be used to create resources and issue commands.
+///             Use the original device and context to create swap chains and wherever the engine
+///             expects its own implementation. The recording objects stop recording and only forward
+///             the calls after the recorder is destroyed.
+class CommandStreamRecorder
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Immediate device context whose commands are recorded.
+        IDeviceContext* pContext = nullptr;
+    };
+
+    explicit CommandStreamRecorder(const CreateInfo& CI);
+    ~CommandStreamRecorder();
+
+    // clang-format off
+    CommandStreamRecorder           (const CommandStreamRecorder&) = delete;
+    CommandStreamRecorder& operator=(const CommandStreamRecorder&) = delete;
+    CommandStreamRecorder           (CommandStreamRecorder&&)      = delete;
+    CommandStreamRecorder& operator=(CommandStreamRecorder&&)      = delete;
+    // clang-format on
+
+    /// Returns the render device that records the resources it creates.
+    IRenderDevice* GetDevice() const;
+
+    /// Returns the device context that records the commands.
+    IDeviceContext* GetContext() const;
+
+    /// Returns the command stream recorded so far.
+    std::vector<Uint8> GetStream() const;
+
+    /// Writes the command stream recorded so far to a file.
+    bool SaveToFile(const Char* FilePath) const;
+
+    /// Returns the number of frames that have been completed since the recording started.
+    Uint32 GetNumFrames() const;
+
+    /// Returns the number of commands that have been recorded.
+    Uint32 GetNumCommands() const;
+
+    /// Returns the number of objects that have been recorded.
+    Uint32 GetNumObjects() const;
+
+private:
+    class StreamWriter;
+    class RenderDeviceProxy;
+    class DeviceContextProxy;
+
+    std::unique_ptr<StreamWriter>    m_pWriter;
+    RefCntAutoPtr<RenderDeviceProxy>  m_pDeviceProxy;
+    RefCntAutoPtr<DeviceContextProxy> m_pContextProxy;
+};
+
+} // namespace Diligent
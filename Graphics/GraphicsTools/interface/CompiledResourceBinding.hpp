@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Resource binding table compiled from a shader resource binding layout and a resource mapping.
+
+/// BindResources() looks up every element of every variable in the resource mapping by name
+/// on every call. CompiledResourceBinding enumerates the variables once, resolves their names
+/// in the mapping with Resolve(), and then binds the resolved objects to any shader resource
+/// binding created from the same pipeline resource signature with a single
+/// IShaderResourceBinding::SetResources() call. When the mapping changes, Resolve() is called
+/// again and only the elements whose objects changed need to be rebound with ApplyChanges().
+///
+/// Usage:
+///
+///     CompiledResourceBinding Binding{pSRB, SHADER_TYPE_ALL_GRAPHICS, BIND_SHADER_RESOURCES_UPDATE_MUTABLE};
+///     Binding.Resolve(pResMapping);
+///     for (auto* pMaterialSRB : MaterialSRBs)
+///         Binding.Apply(pMaterialSRB);
+///     ...
+///     pResMapping->AddResource("g_ShadowMap", pNewShadowMapSRV, false);
+///     if (Binding.Resolve(pResMapping) > 0)
+///     {
+///         for (auto* pMaterialSRB : MaterialSRBs)
+///             Binding.ApplyChanges(pMaterialSRB);
+///     }
+class CompiledResourceBinding
+{
+public:
+    /// Enumerates the variables of the shader resource binding.
+
+    /// \param [in] pSRB         - Any shader resource binding created from the signature the table will be used with.
+    /// \param [in] ShaderStages - Shader stages whose variables are added to the table.
+    /// \param [in] Flags        - Flags that have the same meaning as in IShaderResourceBinding::BindResources().
+    ///                            BIND_SHADER_RESOURCES_UPDATE_* flags select the variable types that are added to the table.
+    CompiledResourceBinding(IShaderResourceBinding*     pSRB,
+                            SHADER_TYPE                 ShaderStages,
+                            BIND_SHADER_RESOURCES_FLAGS Flags = BIND_SHADER_RESOURCES_UPDATE_ALL);
+
+    /// Looks up all elements of the table in the resource mapping.
+
+    /// \param [in] pResMapping - Resource mapping to resolve the variable names in.
+    ///
+    /// \return     The number of elements whose objects have changed since the previous call.
+    ///
+    /// \remarks    Elements that are not found in the mapping are left unbound by Apply() and
+    ///             ApplyChanges(), same as BindResources() leaves them untouched.
+    Uint32 Resolve(IResourceMapping* pResMapping);
+
+    /// Binds all resolved objects to the shader resource binding.
+    void Apply(IShaderResourceBinding* pSRB) const;
+
+    /// Binds only the objects that have changed during the last call to Resolve().
+    void ApplyChanges(IShaderResourceBinding* pSRB) const;
+
+    /// Returns the total number of variable array elements in the table.
+    Uint32 GetNumElements() const { return static_cast<Uint32>(m_Elements.size()); }
+
+    /// Returns the number of elements that were found in the resource mapping during the last call to Resolve().
+    Uint32 GetNumResolvedElements() const { return static_cast<Uint32>(m_ResolvedLocations.size()); }
+
+private:
+    void Bind(IShaderResourceBinding*                            pSRB,
+              const std::vector<ShaderResourceVariableLocation>& Locations,
+              const std::vector<IDeviceObject*>&                 Objects) const;
+
+    struct ElementInfo
+    {
+        ShaderResourceVariableLocation Location;
+
+        // Index of the variable name in m_Names
+        Uint32 NameIdx = 0;
+
+        // Object resolved by the last call to Resolve()
+        RefCntAutoPtr<IDeviceObject> pObject;
+    };
+
+    const BIND_SHADER_RESOURCES_FLAGS m_Flags;
+
+    std::vector<std::string> m_Names;
+    std::vector<ElementInfo> m_Elements;
+
+    // Non-null objects of the last Resolve() and their locations, ready to be passed to SetResources()
+    std::vector<ShaderResourceVariableLocation> m_ResolvedLocations;
+    std::vector<IDeviceObject*>                 m_ResolvedObjects;
+
+    // Objects that have changed during the last Resolve()
+    std::vector<ShaderResourceVariableLocation> m_ChangedLocations;
+    std::vector<IDeviceObject*>                 m_ChangedObjects;
+};
+
+} // namespace Diligent
@@ -0,0 +1,189 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ConcurrentStreamingBuffer class
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Streaming buffer that multiple threads can allocate and write data to concurrently.
+
+/// Unlike StreamingBuffer, the buffer is never reset. Allocations are carved from a ring
+/// with a lock-free atomic bump of the head, and the space is returned to the ring when
+/// the GPU has passed the fence that Commit() signals after the data has been used.
+///
+/// The buffer is persistently mapped, and how the data reaches the GPU depends on the device:
+/// - If the device supports unified memory writable by the CPU (Vulkan), the GPU reads
+///   the data directly from the mapped USAGE_UNIFIED buffer.
+/// - In Direct3D12 and Vulkan, the data is written to a persistently mapped staging buffer and
+///   Commit() copies the committed range to the USAGE_DEFAULT buffer returned by GetBuffer().
+/// - In other backends, the data is written to CPU memory and Commit() uploads the committed
+///   range with IDeviceContext::UpdateBuffer().
+///
+/// Typical usage:
+///
+///     // Worker threads
+///     auto Alloc = Buffer.Allocate(Size);
+///     if (Alloc)
+///         memcpy(Alloc.pData, pVertices, Size);
+///
+///     // Render thread, after all workers have finished writing the frame's data
+///     Buffer.Commit(pImmediateCtx);
+///     // Draw using the allocations' offsets
+///
+/// \note   Allocate() and Write() are thread-safe. All other methods must be called from the
+///         thread that owns the immediate context.
+class ConcurrentStreamingBuffer
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Immediate context that is used to map the buffer and to commit the data.
+        IDeviceContext* pContext = nullptr;
+
+        /// Buffer description. Usage and CPU access flags are ignored.
+        BufferDesc Desc;
+
+        /// Allocation offset alignment, must be a power of two.
+        Uint32 Alignment = 16;
+    };
+
+    explicit ConcurrentStreamingBuffer(const CreateInfo& CI);
+    ~ConcurrentStreamingBuffer();
+
+    // clang-format off
+    ConcurrentStreamingBuffer           (const ConcurrentStreamingBuffer&) = delete;
+    ConcurrentStreamingBuffer& operator=(const ConcurrentStreamingBuffer&) = delete;
+    ConcurrentStreamingBuffer           (ConcurrentStreamingBuffer&&)      = delete;
+    ConcurrentStreamingBuffer& operator=(ConcurrentStreamingBuffer&&)      = delete;
+    // clang-format on
+
+    static constexpr Uint64 InvalidOffset = ~Uint64{0};
+
+    struct Allocation
+    {
+        /// Offset of the allocation in the buffer returned by GetBuffer(),
+        /// or InvalidOffset if the allocation failed.
+        Uint64 Offset = InvalidOffset;
+
+        /// CPU address to write the data to.
+        void* pData = nullptr;
+
+        explicit operator bool() const
+        {
+            return pData != nullptr;
+        }
+    };
+
+    /// Allocates Size bytes in the buffer.
+
+    /// \remarks    The method is thread-safe and lock-free. It fails if there is not
+    ///             enough space until the GPU is done with the previously committed data.
+    ///             The data must be written before the next call to Commit(), and can only
+    ///             be used by the GPU in commands recorded after that call.
+    Allocation Allocate(Uint64 Size);
+
+    /// Allocates space and copies the data to it. Returns the data offset, or InvalidOffset
+    /// if the allocation failed.
+    Uint64 Write(const void* pData, Uint64 Size);
+
+    /// Makes the data written since the previous call available to the GPU and releases
+    /// the space whose data has been used by the commands recorded before this call.
+    /// This method should be called once per frame before the commands that use the data.
+
+    /// \param [in] pContext - Immediate context that executes the commands that use the data.
+    void Commit(IDeviceContext* pContext);
+
+    /// Returns the buffer to bind to the pipeline.
+    IBuffer* GetBuffer() const
+    {
+        return m_pBuffer.RawPtr<IBuffer>();
+    }
+
+    /// Returns the number of bytes that are currently allocated, including the space
+    /// that is still in use by the GPU.
+    Uint64 GetUsedSize() const
+    {
+        return m_Head.load() - m_Tail.load();
+    }
+
+    /// Returns true if the GPU reads the data directly from the mapped memory.
+    bool IsZeroCopy() const
+    {
+        return !m_pStagingBuffer && !m_CPUData;
+    }
+
+private:
+    const Uint64 m_Size;
+    const Uint64 m_Alignment;
+
+    RefCntAutoPtr<IDeviceContext> m_pMapContext;
+    RefCntAutoPtr<IBuffer>        m_pBuffer;
+    RefCntAutoPtr<IBuffer>        m_pStagingBuffer;
+    std::unique_ptr<Uint8[]>      m_CPUData;
+    RefCntAutoPtr<IFence>         m_pFence;
+
+    // CPU address of the ring: mapped buffer memory or m_CPUData
+    Uint8* m_pMappedData      = nullptr;
+    bool   m_FlushMappedRange = false;
+
+    // Head and tail are monotonically increasing byte positions; the offset in the
+    // buffer is the position modulo the buffer size.
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+
+    // Head position at the previous Commit() call
+    Uint64 m_CommittedHead = 0;
+
+    Uint64 m_NextFenceValue = 1;
+
+    struct PendingRange
+    {
+        Uint64 FenceValue;
+        Uint64 Head;
+    };
+    // Ranges that are in use by the GPU, in fence order
+    std::deque<PendingRange> m_PendingRanges;
+};
+
+} // namespace Diligent
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::CrossDeviceCopyQueue class
+
+#include "GPUReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Copies buffer and texture data between resources created by different render devices.
+
+/// The helper is intended for applications that create one render device per GPU, for instance
+/// to distribute frames between several adapters (alternate-frame rendering) or to render parts
+/// of a frame on different adapters (split-frame rendering).
+/// Every copy reads the source data back into a staging resource of the source device
+/// (see Diligent::GPUReadbackQueue). Once the source GPU has finished the copy, Process()
+/// uploads the data to the destination resource using the destination device context.
+///
+/// \note   All methods must be called from the thread that owns both device contexts.
+class CrossDeviceCopyQueue
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that owns the source resources.
+        IRenderDevice* pSrcDevice = nullptr;
+
+        /// The maximum number of recycled staging resources that are kept for reuse.
+        Uint32 MaxRecycledResources = 16;
+    };
+    explicit CrossDeviceCopyQueue(const CreateInfo& CI);
+
+    // clang-format off
+    CrossDeviceCopyQueue           (const CrossDeviceCopyQueue&) = delete;
+    CrossDeviceCopyQueue& operator=(const CrossDeviceCopyQueue&) = delete;
+    CrossDeviceCopyQueue           (CrossDeviceCopyQueue&&)      = delete;
+    CrossDeviceCopyQueue& operator=(CrossDeviceCopyQueue&&)      = delete;
+    // clang-format on
+
+    /// Enqueues a copy of Size bytes from the source buffer starting at SrcOffset
+    /// to the destination buffer starting at DstOffset.
+
+    /// \remarks    The destination buffer must be created with USAGE_DEFAULT.
+    void CopyBuffer(IDeviceContext* pSrcContext,
+                    IBuffer*        pSrcBuffer,
+                    Uint64          SrcOffset,
+                    Uint64          Size,
+                    IBuffer*        pDstBuffer,
+                    Uint64          DstOffset);
+
+    /// Cross-device texture copy attributes.
+    struct TextureCopyAttribs
+    {
+        /// Source texture.
+        ITexture* pSrcTexture = nullptr;
+
+        /// Source mip level and array slice.
+        Uint32 SrcMipLevel = 0;
+        Uint32 SrcSlice    = 0;
+
+        /// Source region. If null, the entire subresource is copied.
+        const Box* pSrcBox = nullptr;
+
+        /// Destination texture. Must have the same format as the source texture
+        /// and be created with USAGE_DEFAULT.
+        ITexture* pDstTexture = nullptr;
+
+        /// Destination mip level and array slice.
+        Uint32 DstMipLevel = 0;
+        Uint32 DstSlice    = 0;
+
+        /// Destination region offset.
+        Uint32 DstX = 0;
+        Uint32 DstY = 0;
+        Uint32 DstZ = 0;
+    };
+
+    /// Enqueues a copy of the source texture region to the destination texture.
+    void CopyTexture(IDeviceContext* pSrcContext, const TextureCopyAttribs& Attribs);
+
+    /// Uploads the data of the copies that have been completed by the source GPU
+    /// to the destination resources.
+    /// This method should be called once per frame.
+    void Process(IDeviceContext* pSrcContext, IDeviceContext* pDstContext);
+
+    /// Waits until the source GPU completes all pending copies and uploads their data
+    /// to the destination resources.
+    void Flush(IDeviceContext* pSrcContext, IDeviceContext* pDstContext);
+
+    /// Returns the number of copies that have not been uploaded to the destination resources yet.
+    size_t GetNumPendingCopies() const
+    {
+        return m_Readbacks.GetNumPendingReadbacks();
+    }
+
+private:
+    GPUReadbackQueue m_Readbacks;
+
+    // Destination context that is only valid while Process() or Flush() is running,
+    // as readback callbacks are invoked by these methods.
+    IDeviceContext* m_pDstContext = nullptr;
+};
+
+} // namespace Diligent
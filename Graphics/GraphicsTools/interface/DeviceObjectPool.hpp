@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of DeviceObjectPool class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "GPUCompletionAwaitQueue.hpp"
+
+namespace Diligent
+{
+
+/// Pool that recycles buffers, textures and queries with matching descriptions.
+
+/// Instead of releasing an object, an application returns it to the pool with Recycle().
+/// The object becomes available again once the GPU has finished all commands recorded
+/// in the context before the object was recycled. Requesting an object whose description
+/// matches an available object then only pops it from the free list, avoiding a full
+/// backend creation/destruction cycle.
+///
+/// \remarks    Descriptions are compared with the structures' equality operators,
+///             so object names are ignored. The pool is not thread-safe.
+class DeviceObjectPool
+{
+public:
+    /// Pool statistics.
+    struct Statistics
+    {
+        /// The number of objects created by the pool.
+        Uint32 NumCreated = 0;
+
+        /// The number of requests served from the free lists.
+        Uint32 NumReused = 0;
+
+        /// The number of objects that are available for reuse.
+        Uint32 NumAvailable = 0;
+
+        /// The number of recycled objects the GPU may still be using.
+        Uint32 NumPending = 0;
+    };
+
+    explicit DeviceObjectPool(IRenderDevice* pDevice);
+
+    // clang-format off
+    DeviceObjectPool           (const DeviceObjectPool&)  = delete;
+    DeviceObjectPool& operator=(const DeviceObjectPool&)  = delete;
+    DeviceObjectPool           (      DeviceObjectPool&&) = delete;
+    DeviceObjectPool& operator=(      DeviceObjectPool&&) = delete;
+    // clang-format on
+
+    /// Returns a buffer with the given description, reusing a recycled buffer if possible.
+
+    /// \remarks    The contents of a reused buffer are undefined.
+    RefCntAutoPtr<IBuffer> GetBuffer(const BufferDesc& Desc);
+
+    /// Returns a texture with the given description, reusing a recycled texture if possible.
+
+    /// \remarks    The contents of a reused texture are undefined. Default views
+    ///             of the texture are reused together with the texture.
+    RefCntAutoPtr<ITexture> GetTexture(const TextureDesc& Desc);
+
+    /// Returns a query with the given description, reusing a recycled query if possible.
+    RefCntAutoPtr<IQuery> GetQuery(const QueryDesc& Desc);
+
+    /// Returns the buffer to the pool. The buffer becomes available once the GPU
+    /// has finished the commands recorded in pContext so far.
+    void Recycle(IDeviceContext* pContext, RefCntAutoPtr<IBuffer>&& pBuffer);
+
+    /// Returns the texture to the pool. The texture becomes available once the GPU
+    /// has finished the commands recorded in pContext so far.
+    void Recycle(IDeviceContext* pContext, RefCntAutoPtr<ITexture>&& pTexture);
+
+    /// Returns the query to the pool. The query becomes available once the GPU
+    /// has finished the commands recorded in pContext so far.
+    void Recycle(IDeviceContext* pContext, RefCntAutoPtr<IQuery>&& pQuery);
+
+    /// Releases all objects that are available for reuse.
+    void ReleaseAvailable();
+
+    /// Returns pool statistics.
+    Statistics GetStatistics() const;
+
+private:
+    template <typename ObjectType, typename DescType>
+    struct Bucket
+    {
+        DescType                               Desc;
+        std::vector<RefCntAutoPtr<ObjectType>> Objects;
+    };
+
+    template <typename ObjectType, typename DescType>
+    class TypedPool
+    {
+    public:
+        explicit TypedPool(IRenderDevice* pDevice) :
+            m_PendingObjects{pDevice}
+        {}
+
+        RefCntAutoPtr<ObjectType> Get(const DescType& Desc, Uint32& NumReused);
+        void                      Recycle(IDeviceContext* pContext, RefCntAutoPtr<ObjectType>&& pObject);
+        void                      ReleaseAvailable();
+        Uint32                    GetNumAvailable() const;
+
+        Uint32 NumPending = 0;
+
+    private:
+        void ProcessCompleted();
+
+        std::vector<Bucket<ObjectType, DescType>>          m_Buckets;
+        GPUCompletionAwaitQueue<RefCntAutoPtr<ObjectType>> m_PendingObjects;
+    };
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    TypedPool<IBuffer, BufferDesc>   m_Buffers;
+    TypedPool<ITexture, TextureDesc> m_Textures;
+    TypedPool<IQuery, QueryDesc>     m_Queries;
+
+    Statistics m_Stats;
+};
+
+} // namespace Diligent
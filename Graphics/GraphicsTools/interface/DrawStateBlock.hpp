@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <algorithm>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Captures the pipeline state, shader resource bindings, vertex and index buffers and
+/// the stencil reference value of a draw, and applies the whole set with one call.
+
+/// The block holds strong references to all objects. Applying a block whose state matches
+/// the state already set in the context is cheap: the device context filters out redundant
+/// pipeline state and buffer bindings (see IDeviceContext::GetStateFilterStats()), so
+/// sorted draw packets that share state only pay for what actually changes.
+class DrawStateBlock
+{
+public:
+    DrawStateBlock& SetPipelineState(IPipelineState* pPSO)
+    {
+        m_pPSO = pPSO;
+        return *this;
+    }
+
+    /// Adds a shader resource binding to commit; SRBs are committed in the order they are added.
+    DrawStateBlock& AddShaderResourceBinding(IShaderResourceBinding* pSRB)
+    {
+        VERIFY(m_NumSRBs < m_SRBs.size(), "Too many shader resource bindings");
+        m_SRBs[m_NumSRBs++] = pSRB;
+        return *this;
+    }
+
+    /// Sets the vertex buffers that are bound starting at slot 0; all other slots are reset.
+    DrawStateBlock& SetVertexBuffers(Uint32 NumBuffers, IBuffer* const* ppBuffers, const Uint64* pOffsets = nullptr)
+    {
+        VERIFY(NumBuffers <= MAX_BUFFER_SLOTS, "Too many vertex buffers");
+        for (Uint32 i = 0; i < std::max(NumBuffers, m_NumVertexBuffers); ++i)
+        {
+            m_VertexBuffers[i]    = i < NumBuffers ? ppBuffers[i] : nullptr;
+            m_pVertexBuffers[i]   = m_VertexBuffers[i];
+            m_VertexBuffOffset[i] = (i < NumBuffers && pOffsets != nullptr) ? pOffsets[i] : 0;
+        }
+        m_NumVertexBuffers = NumBuffers;
+        return *this;
+    }
+
+    DrawStateBlock& SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset = 0)
+    {
+        m_pIndexBuffer     = pIndexBuffer;
+        m_IndexBuffOffset  = ByteOffset;
+        m_IndexBufferIsSet = true;
+        return *this;
+    }
+
+    DrawStateBlock& SetStencilRef(Uint32 StencilRef)
+    {
+        m_StencilRef      = StencilRef;
+        m_StencilRefIsSet = true;
+        return *this;
+    }
+
+    /// Applies the captured state to the device context.
+
+    /// \param [in] pContext            - Device context.
+    /// \param [in] StateTransitionMode - State transition mode for the SRB resources and the buffers.
+    void Apply(IDeviceContext* pContext, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) const
+    {
+        VERIFY_EXPR(pContext != nullptr);
+
+        if (m_pPSO)
+            pContext->SetPipelineState(m_pPSO.RawPtr<IPipelineState>());
+
+        for (Uint32 i = 0; i < m_NumSRBs; ++i)
+            pContext->CommitShaderResources(m_SRBs[i].RawPtr<IShaderResourceBinding>(), StateTransitionMode);
+
+        // SetVertexBuffers() does not modify the array of buffer pointers
+        if (m_NumVertexBuffers > 0)
+            pContext->SetVertexBuffers(0, m_NumVertexBuffers, const_cast<IBuffer**>(m_pVertexBuffers.data()), m_VertexBuffOffset.data(), StateTransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        if (m_IndexBufferIsSet)
+            pContext->SetIndexBuffer(m_pIndexBuffer.RawPtr<IBuffer>(), m_IndexBuffOffset, StateTransitionMode);
+
+        if (m_StencilRefIsSet)
+            pContext->SetStencilRef(m_StencilRef);
+    }
+
+    void Clear()
+    {
+        *this = DrawStateBlock{};
+    }
+
+private:
+    RefCntAutoPtr<IPipelineState> m_pPSO;
+
+    std::array<RefCntAutoPtr<IShaderResourceBinding>, MAX_RESOURCE_SIGNATURES> m_SRBs;
+    Uint32                                                                      m_NumSRBs = 0;
+
+    std::array<RefCntAutoPtr<IBuffer>, MAX_BUFFER_SLOTS> m_VertexBuffers;
+    std::array<IBuffer*, MAX_BUFFER_SLOTS>               m_pVertexBuffers   = {};
+    std::array<Uint64, MAX_BUFFER_SLOTS>                 m_VertexBuffOffset = {};
+    Uint32                                               m_NumVertexBuffers = 0;
+
+    RefCntAutoPtr<IBuffer> m_pIndexBuffer;
+    Uint64                 m_IndexBuffOffset  = 0;
+    bool                   m_IndexBufferIsSet = false;
+
+    Uint32 m_StencilRef      = 0;
+    bool   m_StencilRefIsSet = false;
+};
+
+} // namespace Diligent
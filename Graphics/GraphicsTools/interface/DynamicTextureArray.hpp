@@ -30,6 +30,7 @@
 /// Declaration of DynamicTextureArray class
 
 #include <atomic>
+#include <vector>
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
@@ -37,6 +38,7 @@
 #include "../../GraphicsEngine/interface/Fence.h"
 #include "../../GraphicsEngine/interface/DeviceMemory.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
@@ -58,6 +60,28 @@ struct DynamicTextureArrayCreateInfo
     ///     This value is only relevant when Desc.Usage == USAGE_SPARSE and
     ///     defines the number of texture array slices in one memory page.
     Uint32 NumSlicesInMemoryPage = 1;
+
+    /// The number of slices in one chunk of a non-sparse texture array.
+
+    /// \remarks
+    ///     When this value is not zero and the array does not use a sparse texture (either
+    ///     because Desc.Usage is not USAGE_SPARSE, or because the device does not support
+    ///     the required sparse resource capabilities), the array is stored as a list of
+    ///     texture arrays (chunks) of NumSlicesInChunk slices each. Growing the array
+    ///     only creates new chunks and never copies the existing slices, so that no device
+    ///     context is required. Use GetSliceLocation() and GetChunkTexture() to address the slices.
+    ///
+    ///     When this value is zero, the whole array is a single texture that is recreated
+    ///     and copied every time the array is resized.
+    Uint32 NumSlicesInChunk = 0;
+
+    /// The maximum number of slices whose memory is bound by one sparse binding operation.
+
+    /// \remarks
+    ///     This value is only relevant when Desc.Usage == USAGE_SPARSE. When it is not zero,
+    ///     binding the memory of new slices is split into several operations that are submitted
+    ///     one after another. Zero means that all slices are bound by one operation.
+    Uint32 NumSlicesInSparseBindBatch = 0;
 };
 
 /// Dynamically resizable texture 2D array
@@ -94,6 +118,7 @@ public:
     /// \param[in] DiscardContent - Whether to discard previous texture content (for non-sparse textures).
     ///
     /// \return     Pointer to the new texture object after resize.
+    ///             In chunked mode, pointer to the texture of the first chunk.
     ///
     /// \remarks    The method operation depends on which of pDevice and pContext parameters
     ///             are not null:
@@ -109,6 +134,9 @@ public:
     ///
     ///             Typically pContext is null when the method is called from a worker thread.
     ///
+    ///             In chunked mode (see DynamicTextureArrayCreateInfo::NumSlicesInChunk), the new
+    ///             chunks are created when pDevice is not null, and the context is never used.
+    ///
     ///             If NewArraySize is zero, internal buffer will be released.
     ITexture* Resize(IRenderDevice*  pDevice,
                      IDeviceContext* pContext,
@@ -125,6 +153,7 @@ public:
     ///                       memory tiles (when using sparse textures), if necessary
     ///                       (see remarks).
     /// \return               The pointer to the texture object.
+    ///                       In chunked mode, the pointer to the texture of the first chunk.
     ///
     /// \remarks    If the texture has been resized, but internal texture object has not been
     ///             initialized, pDevice and pContext must not be null.
@@ -150,7 +179,8 @@ public:
     }
 
     /// Returns dynamic texture version.
-    /// The version is incremented every time a new internal texture is created.
+    /// The version is incremented every time a new internal texture is created
+    /// or the list of chunks changes.
     Uint32 GetVersion() const
     {
         return m_Version;
@@ -159,6 +189,51 @@ public:
     /// Returns the amount of memory currently used by the dynamic array, in bytes.
     Uint64 GetMemoryUsage() const;
 
+    /// Returns true if the array is stored as a list of chunks, see DynamicTextureArrayCreateInfo::NumSlicesInChunk.
+    bool IsChunked() const
+    {
+        return m_NumSlicesInChunk != 0 && m_Desc.Usage != USAGE_SPARSE;
+    }
+
+    /// Location of the array slice in the chunk list.
+    struct SliceLocation
+    {
+        /// Index of the chunk that contains the slice.
+        Uint32 Chunk = 0;
+
+        /// Index of the slice in the chunk texture.
+        Uint32 Slice = 0;
+    };
+
+    /// Returns the location of the array slice.
+    /// When the array is not chunked, the slice is always located in chunk 0.
+    SliceLocation GetSliceLocation(Uint32 Slice) const
+    {
+        return IsChunked() ?
+            SliceLocation{Slice / m_NumSlicesInChunk, Slice % m_NumSlicesInChunk} :
+            SliceLocation{0, Slice};
+    }
+
+    /// Returns the number of chunks.
+    /// When the array is not chunked, returns 1 if the texture is initialized and 0 otherwise.
+    Uint32 GetNumChunks() const
+    {
+        return IsChunked() ?
+            static_cast<Uint32>(m_Chunks.size()) :
+            (m_pTexture ? 1 : 0);
+    }
+
+    /// Returns the texture of the chunk. When the array is not chunked, chunk 0 is the whole array.
+
+    /// \remarks   Similar to GetTexture(), the texture must not be pending an update.
+    ITexture* GetChunkTexture(Uint32 Chunk) const
+    {
+        VERIFY_EXPR(Chunk < GetNumChunks());
+        return IsChunked() ?
+            m_Chunks[Chunk].RawPtr<ITexture>() :
+            m_pTexture.RawPtr<ITexture>();
+    }
+
 private:
     void CommitResize(IRenderDevice*  pDevice,
                       IDeviceContext* pContext,
@@ -166,6 +241,7 @@ private:
 
     void ResizeSparseTexture(IDeviceContext* pContext);
     void ResizeDefaultTexture(IDeviceContext* pContext);
+    void ResizeChunks(IRenderDevice* pDevice);
 
     void CreateSparseTexture(IRenderDevice* pDevice);
     void CreateResources(IRenderDevice* pDevice);
@@ -173,6 +249,8 @@ private:
     const std::string m_Name;
     TextureDesc       m_Desc;
     const Uint32      m_NumSlicesInPage;
+    const Uint32      m_NumSlicesInChunk;
+    const Uint32      m_NumSlicesInSparseBindBatch;
 
     std::atomic<Uint32> m_Version{0};
 
@@ -182,6 +260,9 @@ private:
     RefCntAutoPtr<ITexture>      m_pStaleTexture;
     RefCntAutoPtr<IDeviceMemory> m_pMemory;
 
+    // Chunk textures in chunked mode. m_pTexture references the first chunk.
+    std::vector<RefCntAutoPtr<ITexture>> m_Chunks;
+
     Uint64 m_MemoryPageSize = 0;
 
     Uint64 m_NextBeforeResizeFenceValue = 1;
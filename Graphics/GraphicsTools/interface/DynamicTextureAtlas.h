@@ -159,6 +159,19 @@ struct IDynamicTextureAtlas : public IObject
 };
 
 
+/// Dynamic texture atlas region packing mode.
+enum DYNAMIC_TEXTURE_ATLAS_PACKING_MODE : Uint8
+{
+    /// Free space is recursively split into rectangular regions (see Diligent::DynamicAtlasManager).
+    /// This mode handles regions of arbitrary sizes and aspect ratios well.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SPLIT = 0,
+
+    /// Regions are placed on horizontal shelves (see Diligent::ShelfAtlasManager).
+    /// This mode is considerably faster and packs regions of similar heights,
+    /// such as glyphs or uniform tiles, more tightly.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SHELF
+};
+
 /// Dynamic texture atlas create information.
 struct DynamicTextureAtlasCreateInfo
 {
@@ -223,6 +236,9 @@ struct DynamicTextureAtlasCreateInfo
 
     /// Silence allocation errors.
     bool Silent = false;
+
+    /// Region packing mode, see Diligent::DYNAMIC_TEXTURE_ATLAS_PACKING_MODE.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_MODE PackingMode = DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SPLIT;
 };
 
 /// Creates a new dynamic texture atlas.
@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <memory>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Compression format of the file data streamed by the FileStreamingQueue.
+enum FILE_STREAMING_COMPRESSION : Uint8
+{
+    /// The data is not compressed.
+    FILE_STREAMING_COMPRESSION_NONE = 0,
+
+    /// The data is compressed with GDeflate.
+    FILE_STREAMING_COMPRESSION_GDEFLATE
+};
+
+/// GDeflate decompression callback used by the CPU streaming path.
+
+/// The callback decompresses SrcSize bytes at pSrc into exactly DstSize bytes at pDst and
+/// returns true on success. It is invoked concurrently from the worker threads.
+using GDeflateDecompressCallbackType = std::function<bool(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)>;
+
+/// File streaming queue create info.
+struct FileStreamingQueueCreateInfo
+{
+    /// Render device that owns the destination resources.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Thread pool that reads and decompresses the file data in the CPU streaming path.
+    /// If null, the data is read by FileStreamingQueue::Update() on the calling thread.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The size of the persistently mapped staging buffer that the CPU streaming path
+    /// decompresses the data into in Direct3D12 and Vulkan backends.
+    /// Requests that do not fit into the staging buffer are uploaded from the CPU memory.
+    Uint64 StagingBufferSize = Uint64{32} << Uint64{20};
+
+    /// Whether to use DirectStorage in Direct3D12 backend.
+    /// The flag is ignored if the engine is built without DirectStorage support
+    /// (see DILIGENT_DSTORAGE_PATH CMake variable) or if the runtime is not available.
+    bool UseDirectStorage = true;
+
+    /// GDeflate decompression callback used by the CPU streaming path.
+    /// If null, the requests that use GDeflate compression fail unless they are
+    /// executed by DirectStorage that decompresses the data on the GPU.
+    GDeflateDecompressCallbackType DecompressGDeflate;
+};
+
+/// File data streaming request.
+struct FileStreamingRequest
+{
+    /// Path of the file to read the data from.
+    const Char* FilePath = nullptr;
+
+    /// Offset of the data in the file, in bytes.
+    Uint64 FileOffset = 0;
+
+    /// Size of the data in the file, in bytes.
+    Uint32 Size = 0;
+
+    /// Size of the data after decompression, in bytes.
+    /// Must be equal to Size if the data is not compressed.
+    Uint32 UncompressedSize = 0;
+
+    /// Compression format of the data.
+    FILE_STREAMING_COMPRESSION Compression = FILE_STREAMING_COMPRESSION_NONE;
+
+    /// Destination buffer. Must be null if pDstTexture is not null.
+    IBuffer* pDstBuffer = nullptr;
+
+    /// Offset in the destination buffer, in bytes.
+    Uint64 DstOffset = 0;
+
+    /// Destination texture. Must be null if pDstBuffer is not null.
+
+    /// \remarks    The uncompressed texture data must be laid out with the row stride
+    ///             aligned to 256 bytes and the depth stride equal to the row stride times
+    ///             the number of rows, see GetBufferToTextureCopyInfo().
+    ITexture* pDstTexture = nullptr;
+
+    /// Destination mip level.
+    Uint32 MipLevel = 0;
+
+    /// Destination array slice.
+    Uint32 ArraySlice = 0;
+
+    /// Destination region. If the region is empty, the entire subresource is updated.
+    Box Region;
+
+    /// Optional callback that is invoked by FileStreamingQueue::Update() after the GPU
+    /// has finished writing the data into the destination resource, or after the request
+    /// has failed.
+    std::function<void(bool Success)> OnCompleted;
+};
+
+/// Streams file data directly into buffers and textures.
+
+/// In Direct3D12 backend, when DirectStorage is available, the requests are submitted to
+/// a DirectStorage queue that reads the data from the file straight into the destination
+/// resources and decompresses GDeflate data on the GPU, so that the CPU does not touch the data.
+/// The destination resources must not be used by the GPU until the requests are completed.
+///
+/// In other cases, the data is read and decompressed by the worker threads. In Direct3D12
+/// and Vulkan backends, the data is decompressed directly into a persistently mapped staging
+/// buffer and is copied to the destination resources by FileStreamingQueue::Update().
+/// In other backends, the data is uploaded from the CPU memory.
+class FileStreamingQueue
+{
+public:
+    virtual ~FileStreamingQueue() {}
+
+    /// Enqueues the streaming request.
+
+    /// \remarks    The method is thread-safe.
+    virtual void Enqueue(const FileStreamingRequest& Request) = 0;
+
+    /// Submits the enqueued requests, records the copy commands for the requests whose data is ready,
+    /// and invokes the completion callbacks for the requests that have been completed by the GPU.
+
+    /// \remarks    The method must be called from the thread that owns the context.
+    ///             It should be called once per frame.
+    virtual void Update(IDeviceContext* pContext) = 0;
+
+    /// Waits until all enqueued requests are completed and invokes their completion callbacks.
+
+    /// \remarks    The method must be called from the thread that owns the context.
+    ///             The method must be called before the queue is destroyed if there are pending requests.
+    virtual void Flush(IDeviceContext* pContext) = 0;
+
+    /// Returns the number of requests that have not been completed yet.
+    virtual size_t GetNumPendingRequests() = 0;
+
+    /// Returns true if the queue uses DirectStorage.
+    virtual bool IsDirectStorageUsed() const = 0;
+};
+
+/// Creates the file streaming queue.
+std::unique_ptr<FileStreamingQueue> CreateFileStreamingQueue(const FileStreamingQueueCreateInfo& CI);
+
+} // namespace Diligent
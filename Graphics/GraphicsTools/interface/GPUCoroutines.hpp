@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Optional C++20 coroutine awaitables for GPU fences and readbacks, see AsyncCoroutine.hpp.
+
+#include "../../../Common/interface/AsyncCoroutine.hpp"
+
+#if DILIGENT_COROUTINES_SUPPORTED
+
+#    include <vector>
+#    include <mutex>
+#    include <cstring>
+
+#    include "../../GraphicsEngine/interface/Fence.h"
+#    include "GPUReadbackQueue.hpp"
+
+namespace Diligent
+{
+
+/// Lets coroutines wait for fence values without blocking threads or polling the fences.
+
+/// Coroutines await the results returned by WaitForValue(). The render thread calls Process()
+/// once per frame to check the fences and resume the coroutines whose fence values have been
+/// reached.
+///
+/// \remarks    WaitForValue() may be called from any thread. Process() must be called from
+///             the thread that is allowed to query the fences (in OpenGL backend, the thread
+///             that owns the immediate context).
+class GPUFenceAwaitQueue
+{
+public:
+    /// \param [in] pThreadPool - Thread pool to resume coroutines on. If null, coroutines are
+    ///                           resumed by Process() on the calling thread.
+    /// \param [in] Lane        - Thread pool lane to resume coroutines in.
+    explicit GPUFenceAwaitQueue(IThreadPool* pThreadPool = nullptr, THREAD_POOL_LANE Lane = THREAD_POOL_LANE_NORMAL) :
+        m_pThreadPool{pThreadPool},
+        m_Lane{Lane}
+    {}
+
+    // clang-format off
+    GPUFenceAwaitQueue           (const GPUFenceAwaitQueue&) = delete;
+    GPUFenceAwaitQueue& operator=(const GPUFenceAwaitQueue&) = delete;
+    GPUFenceAwaitQueue           (GPUFenceAwaitQueue&&)      = delete;
+    GPUFenceAwaitQueue& operator=(GPUFenceAwaitQueue&&)      = delete;
+    // clang-format on
+
+    ~GPUFenceAwaitQueue()
+    {
+        VERIFY(m_PendingWaits.empty(), "Destroying fence await queue with pending waits. The coroutines that await them will never be resumed.");
+    }
+
+    /// Returns the result that is set to the completed fence value once it reaches Value.
+    AsyncResult<Uint64> WaitForValue(IFence* pFence, Uint64 Value)
+    {
+        DEV_CHECK_ERR(pFence != nullptr, "Fence must not be null");
+
+        AsyncResult<Uint64> Result{m_pThreadPool, m_Lane};
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_PendingWaits.push_back({RefCntAutoPtr<IFence>{pFence}, Value, Result});
+        return Result;
+    }
+
+    /// Checks the fences and resumes the coroutines whose fence values have been reached.
+    void Process()
+    {
+        std::vector<PendingWait> CompletedWaits;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            for (auto it = m_PendingWaits.begin(); it != m_PendingWaits.end();)
+            {
+                if (it->pFence->GetCompletedValue() >= it->Value)
+                {
+                    CompletedWaits.emplace_back(std::move(*it));
+                    it = m_PendingWaits.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        // Set the results outside of the lock as coroutines may be resumed on this thread
+        for (auto& Wait : CompletedWaits)
+            Wait.Result.SetResult(Wait.pFence->GetCompletedValue());
+    }
+
+    /// Returns the number of waits that have not been completed yet.
+    size_t GetNumPendingWaits() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_PendingWaits.size();
+    }
+
+private:
+    struct PendingWait
+    {
+        RefCntAutoPtr<IFence> pFence;
+        Uint64                Value;
+        AsyncResult<Uint64>   Result;
+    };
+
+    IThreadPool* const     m_pThreadPool;
+    const THREAD_POOL_LANE m_Lane;
+
+    mutable std::mutex       m_Mtx;
+    std::vector<PendingWait> m_PendingWaits;
+};
+
+
+/// Data read back by ReadBufferAsync() or ReadTextureAsync().
+struct GPUReadbackResult
+{
+    /// Read back data. Empty if the staging resource could not be mapped.
+    std::vector<Uint8> Data;
+
+    /// Row stride, in bytes (for textures only).
+    Uint64 Stride = 0;
+
+    /// Depth slice stride, in bytes (for textures only).
+    Uint64 DepthStride = 0;
+};
+
+namespace Detail
+{
+
+inline GPUReadbackQueue::CallbackType MakeReadbackResultCallback(const AsyncResult<GPUReadbackResult>& Result)
+{
+    return [Result](const GPUReadbackQueue::ReadbackData& Data) {
+        GPUReadbackResult RB;
+        if (Data.pData != nullptr)
+        {
+            RB.Data.resize(static_cast<size_t>(Data.DataSize));
+            std::memcpy(RB.Data.data(), Data.pData, RB.Data.size());
+            RB.Stride      = Data.Stride;
+            RB.DepthStride = Data.DepthStride;
+        }
+        Result.SetResult(std::move(RB));
+    };
+}
+
+} // namespace Detail
+
+/// Enqueues a buffer readback into the readback queue and returns the result that may be
+/// awaited by a coroutine. The data is copied out of the staging buffer, so it stays valid
+/// after the coroutine is resumed.
+
+/// \remarks    Like GPUReadbackQueue::ReadBuffer(), this function must be called from the thread
+///             that owns the device context, while the result may be awaited on any thread.
+///             The coroutine is resumed on pThreadPool or, if it is null, on the thread that runs
+///             the readback callback (see GPUReadbackQueue::CreateInfo::pThreadPool).
+inline AsyncResult<GPUReadbackResult> ReadBufferAsync(GPUReadbackQueue& Queue,
+                                                      IDeviceContext*   pContext,
+                                                      IBuffer*          pBuffer,
+                                                      Uint64            Offset,
+                                                      Uint64            Size,
+                                                      IThreadPool*      pThreadPool = nullptr,
+                                                      THREAD_POOL_LANE  Lane        = THREAD_POOL_LANE_NORMAL)
+{
+    AsyncResult<GPUReadbackResult> Result{pThreadPool, Lane};
+    Queue.ReadBuffer(pContext, pBuffer, Offset, Size, Detail::MakeReadbackResultCallback(Result));
+    return Result;
+}
+
+/// Enqueues a texture readback into the readback queue and returns the result that may be
+/// awaited by a coroutine, see ReadBufferAsync().
+inline AsyncResult<GPUReadbackResult> ReadTextureAsync(GPUReadbackQueue& Queue,
+                                                       IDeviceContext*   pContext,
+                                                       ITexture*         pTexture,
+                                                       Uint32            MipLevel,
+                                                       Uint32            ArraySlice,
+                                                       const Box*        pRegion,
+                                                       IThreadPool*      pThreadPool = nullptr,
+                                                       THREAD_POOL_LANE  Lane        = THREAD_POOL_LANE_NORMAL)
+{
+    AsyncResult<GPUReadbackResult> Result{pThreadPool, Lane};
+    Queue.ReadTexture(pContext, pTexture, MipLevel, ArraySlice, pRegion, Detail::MakeReadbackResultCallback(Result));
+    return Result;
+}
+
+} // namespace Diligent
+
+#endif // DILIGENT_COROUTINES_SUPPORTED
@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::GPUInstanceCuller class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+class HiZPyramid;
+
+/// Culls instances on the GPU and generates indirect draw arguments for the visible ones.
+
+/// The culler processes an array of instances, each of which belongs to a draw group (e.g. a mesh
+/// with a material). Cull() records four compute passes:
+/// - resets the per-group visible instance counters;
+/// - tests the bounding sphere of every instance against the view frustum and counts the visible
+///   instances of every group;
+/// - computes the prefix sum of the counters and writes one DrawIndexedIndirect command for every
+///   group that has visible instances, so that the commands are tightly packed;
+/// - writes the indices of the visible instances to the visible instance buffer, so that the instances
+///   of every group occupy a contiguous range that starts at the FirstInstanceLocation of its command.
+///
+/// The visible instance buffer is a formatted VT_UINT32 buffer that can be bound as a per-instance
+/// vertex buffer, so that the vertex shader receives the index of the instance it draws. It can also
+/// be read in shaders through a shader resource view with VT_UINT32 format.
+///
+/// All draw commands can then be issued with a single IDeviceContext::DrawIndexedIndirect() call,
+/// see GetDrawIndexedIndirectAttribs(), so that the CPU cost does not depend on the number of instances.
+///
+/// Instances can additionally be culled against a Hi-Z pyramid in two phases, see CULL_MODE.
+/// The culler keeps the per-instance visibility from the last second phase, so every view
+/// that uses occlusion culling needs its own culler.
+///
+/// \note   The order of the instances within a group is not deterministic.
+///         The device must support DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT and
+///         DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE.
+class GPUInstanceCuller
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create the pipelines and buffers.
+        IRenderDevice* pDevice = nullptr;
+
+        /// The maximum number of instances that can be culled by one Cull() call.
+        Uint32 MaxInstances = 0;
+
+        /// The maximum number of draw groups.
+        Uint32 MaxDrawGroups = 0;
+
+        /// Compute shader thread group size.
+        Uint32 ThreadGroupSize = 64;
+    };
+    explicit GPUInstanceCuller(const CreateInfo& CI);
+    ~GPUInstanceCuller();
+
+    // clang-format off
+    GPUInstanceCuller           (const GPUInstanceCuller&) = delete;
+    GPUInstanceCuller& operator=(const GPUInstanceCuller&) = delete;
+    GPUInstanceCuller           (GPUInstanceCuller&&)      = delete;
+    GPUInstanceCuller& operator=(GPUInstanceCuller&&)      = delete;
+    // clang-format on
+
+    /// Instance data layout expected in the instance buffer.
+    struct InstanceData
+    {
+        /// World-space bounding sphere: center in xyz, radius in w.
+        float4 BoundingSphere;
+
+        /// Index of the draw group the instance belongs to.
+        /// Instances with out-of-range groups are culled.
+        Uint32 DrawGroup = 0;
+
+        Uint32 Padding[3] = {};
+    };
+    static_assert(sizeof(InstanceData) == 32, "The structure layout must match the shader");
+
+    /// Draw group data layout expected in the draw group buffer.
+    struct DrawGroupData
+    {
+        /// The number of indices to draw for every instance of the group.
+        Uint32 NumIndices = 0;
+
+        /// The location of the first index.
+        Uint32 FirstIndexLocation = 0;
+
+        /// The value added to every index before reading a vertex.
+        Uint32 BaseVertex = 0;
+
+        Uint32 Padding = 0;
+    };
+    static_assert(sizeof(DrawGroupData) == 16, "The structure layout must match the shader");
+
+    /// Culling mode.
+    enum CULL_MODE : Uint32
+    {
+        /// Instances are only culled against the view frustum.
+        CULL_MODE_FRUSTUM = 0,
+
+        /// The first phase of the two-phase occlusion culling:
+        /// instances that were visible after the last second phase are culled against the
+        /// view frustum. Draw them, then build the Hi-Z pyramid from the resulting depth buffer.
+        CULL_MODE_OCCLUSION_FIRST_PHASE,
+
+        /// The second phase of the two-phase occlusion culling:
+        /// all instances are culled against the view frustum and the Hi-Z pyramid built after
+        /// the first phase. Only the visible instances that were not drawn in the first phase are
+        /// output. The visibility of all instances is saved for the next first phase.
+        CULL_MODE_OCCLUSION_SECOND_PHASE,
+
+        CULL_MODE_COUNT
+    };
+
+    struct CullAttribs
+    {
+        /// Structured buffer of InstanceData elements.
+        /// The buffer must have BIND_SHADER_RESOURCE flag and ElementByteStride == sizeof(InstanceData).
+        IBuffer* pInstances = nullptr;
+
+        /// The number of instances to cull. Must not exceed CreateInfo::MaxInstances.
+        Uint32 NumInstances = 0;
+
+        /// Structured buffer of DrawGroupData elements.
+        /// The buffer must have BIND_SHADER_RESOURCE flag and ElementByteStride == sizeof(DrawGroupData).
+        IBuffer* pDrawGroups = nullptr;
+
+        /// The number of draw groups. Must not exceed CreateInfo::MaxDrawGroups.
+        Uint32 NumDrawGroups = 0;
+
+        /// World-space frustum planes. A point p is inside the plane if dot(p, Plane.xyz) + Plane.w >= 0.
+        float4 FrustumPlanes[6];
+
+        /// Culling mode, see CULL_MODE.
+        CULL_MODE Mode = CULL_MODE_FRUSTUM;
+
+        /// The Hi-Z pyramid to test the instances against. Required in CULL_MODE_OCCLUSION_SECOND_PHASE.
+        const HiZPyramid* pHiZPyramid = nullptr;
+
+        /// Row-major view-projection matrix that was used to render the depth buffer
+        /// of the Hi-Z pyramid. Only used in CULL_MODE_OCCLUSION_SECOND_PHASE.
+        float4x4 ViewProj;
+    };
+
+    /// Records the culling passes in the context.
+    void Cull(IDeviceContext* pContext, const CullAttribs& Attribs);
+
+    /// Returns the buffer with the indirect draw arguments written by the last Cull() call.
+    /// The buffer contains CreateInfo::MaxDrawGroups commands. The commands of the groups with visible
+    /// instances are packed at the beginning of the buffer. The remaining commands up to the number of
+    /// draw groups have zero instance count.
+    IBuffer* GetDrawArgsBuffer() const { return m_pDrawArgs.RawPtr<IBuffer>(); }
+
+    /// Returns the buffer with a single Uint32 value that contains the number of valid draw commands.
+    IBuffer* GetDrawCountBuffer() const { return m_pDrawCount.RawPtr<IBuffer>(); }
+
+    /// Returns the buffer with the indices of the visible instances.
+    IBuffer* GetVisibleInstancesBuffer() const { return m_pVisibleInstances.RawPtr<IBuffer>(); }
+
+    /// Returns the attributes for the IDeviceContext::DrawIndexedIndirect() call that draws the
+    /// visible instances of NumDrawGroups groups.
+    /// If the device supports DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER, the draw count is
+    /// read from the draw count buffer. Otherwise, NumDrawGroups commands are executed, and commands
+    /// of the groups without visible instances draw nothing.
+    DrawIndexedIndirectAttribs GetDrawIndexedIndirectAttribs(VALUE_TYPE IndexType, Uint32 NumDrawGroups) const;
+
+private:
+    void CreatePipelines();
+    void CreateBuffers();
+
+    enum PASS : Uint32
+    {
+        PASS_RESET_COUNTERS = 0,
+        PASS_COUNT_VISIBLE,
+        PASS_BUILD_DRAW_ARGS,
+        PASS_COMPACT,
+        PASS_COUNT
+    };
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_MaxInstances;
+    const Uint32 m_MaxDrawGroups;
+    const Uint32 m_ThreadGroupSize;
+
+    bool m_UseCounterBuffer = false;
+
+    // Passes that do not depend on the culling mode share the pipeline and the SRB
+    RefCntAutoPtr<IPipelineState>         m_pPSO[CULL_MODE_COUNT][PASS_COUNT];
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB[CULL_MODE_COUNT][PASS_COUNT];
+
+    RefCntAutoPtr<IBuffer> m_pCullAttribsCB;
+    RefCntAutoPtr<IBuffer> m_pGroupCounters;
+    RefCntAutoPtr<IBuffer> m_pGroupOffsets;
+    RefCntAutoPtr<IBuffer> m_pDrawArgs;
+    RefCntAutoPtr<IBuffer> m_pDrawCount;
+    RefCntAutoPtr<IBuffer> m_pVisibleInstances;
+    RefCntAutoPtr<IBuffer> m_pInstanceVisibility;
+};
+
+} // namespace Diligent
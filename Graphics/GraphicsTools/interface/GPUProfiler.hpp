@@ -0,0 +1,365 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GPUProfiler class
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <chrono>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Frame-scoped hierarchical GPU and CPU profiler.
+
+/// The profiler records a pair of timestamp queries and the CPU time for every scope. Queries of
+/// every frame are allocated from a ring of FrameLatency + 1 frames, and the results of a frame are
+/// read with a single IDeviceContext::GetQueryData() call at least FrameLatency frames later, so
+/// the CPU never waits for the GPU.
+///
+/// The profiler keeps rolling statistics of every scope over the last StatisticsWindow frames
+/// (see GetScopeStatistics()) and can export the last frames in Chrome trace event format
+/// (see ExportChromeTrace()) that can be viewed in chrome://tracing, Perfetto, or imported
+/// into Tracy with its import-chrome tool.
+///
+/// When the device supports timestamp calibration (see IDeviceContext::GetTimestampCalibration()),
+/// the GPU timestamps are converted to the CPU clock, so that the GPU frames are placed on the same
+/// timeline as the CPU frames. This gives the latency between the CPU and the GPU frame start
+/// and the time the GPU was idle between the frames.
+///
+/// The profiler works the same way in all backends. In Direct3D11, all timestamp queries of
+/// a frame share a single disjoint query that is ended by IDeviceContext::FinishFrame().
+class GPUProfiler
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device.
+        IRenderDevice* pDevice = nullptr;
+
+        /// The maximum number of scopes in one frame. Scopes that exceed the limit are not measured.
+        Uint32 MaxScopesPerFrame = 256;
+
+        /// The number of frames after which the results of a frame are read.
+        Uint32 FrameLatency = 3;
+
+        /// The number of frames over which the scope statistics are computed.
+        Uint32 StatisticsWindow = 120;
+
+        /// The number of the most recent frames that are kept for ExportChromeTrace().
+        /// Zero disables the export.
+        Uint32 TraceHistorySize = 0;
+
+        /// Whether to wrap every scope into a debug group, see IDeviceContext::BeginDebugGroup().
+        bool EmitDebugGroups = true;
+
+        /// Whether to calibrate the GPU timestamps against the CPU clock at the beginning of every frame.
+        /// The calibration is only performed if the device supports it.
+        bool CalibrateTimestamps = true;
+    };
+
+    explicit GPUProfiler(const CreateInfo& CI);
+
+    // clang-format off
+    GPUProfiler           (const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+    GPUProfiler           (GPUProfiler&&)      = default;
+    GPUProfiler& operator=(GPUProfiler&&)      = delete;
+    // clang-format on
+
+    /// Timing of a single profiling scope.
+    struct ScopeTiming
+    {
+        /// Scope name.
+        std::string Name;
+
+        /// Scope nesting level, 0 for top-level scopes.
+        Uint32 Depth = 0;
+
+        /// Index of the parent scope, or InvalidIndex for top-level scopes.
+        Uint32 ParentIndex = InvalidIndex;
+
+        /// Scope start time, in seconds, relative to the beginning of the frame.
+        double StartTime = 0;
+
+        /// Scope duration, in seconds.
+        double Duration = 0;
+
+        /// Time, in seconds, when the scope was begun on the CPU, relative to the CPU frame start.
+        double CPUStartTime = 0;
+
+        /// Time, in seconds, between the BeginScope() and EndScope() calls on the CPU.
+        double CPUDuration = 0;
+    };
+
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    /// Rolling statistics of a profiling scope.
+    struct ScopeStatistics
+    {
+        /// Scope path, which is the names of the scope and its parents separated with '/'.
+        std::string Path;
+
+        /// Scope nesting level, 0 for top-level scopes.
+        Uint32 Depth = 0;
+
+        /// The number of frames in the window that contain the scope.
+        /// If the scope is begun several times in a frame, the durations are added up.
+        Uint32 NumSamples = 0;
+
+        /// Minimum, average and maximum GPU durations, in seconds.
+        double MinDuration = 0;
+        double AvgDuration = 0;
+        double MaxDuration = 0;
+
+        /// Minimum, average and maximum CPU durations, in seconds.
+        double MinCPUDuration = 0;
+        double AvgCPUDuration = 0;
+        double MaxCPUDuration = 0;
+    };
+
+    /// Begins a new frame and reads the results of the previous frames that are available.
+
+    /// \param [in] pCtx - Immediate context to record the frame start timestamp.
+    ///                    All frames and scopes must be recorded in the same context.
+    void BeginFrame(IDeviceContext* pCtx);
+
+    /// Ends the frame.
+
+    /// \param [in] pCtx - Context to record the frame end timestamp.
+    ///
+    /// \remarks    The method must be called before IDeviceContext::FinishFrame().
+    void EndFrame(IDeviceContext* pCtx);
+
+    /// Begins a profiling scope. Scopes may be nested.
+
+    /// \param [in] pCtx - Context to record the scope start timestamp.
+    /// \param [in] Name - Scope name.
+    void BeginScope(IDeviceContext* pCtx, const char* Name);
+
+    /// Ends the last begun profiling scope.
+    void EndScope(IDeviceContext* pCtx);
+
+    /// Returns the timings of the scopes of the most recent frame whose results are available.
+    /// The scopes are listed in the order they were begun.
+    const std::vector<ScopeTiming>& GetScopeTimings() const
+    {
+        return m_Results;
+    }
+
+    /// Returns the GPU duration, in seconds, of the most recent frame whose results are available.
+    double GetFrameDuration() const
+    {
+        return m_ResultsFrameDuration;
+    }
+
+    /// Returns the CPU duration, in seconds, of the most recent frame whose results are available.
+    double GetCPUFrameDuration() const
+    {
+        return m_ResultsCPUFrameDuration;
+    }
+
+    /// Returns true if the GPU timestamps of the most recent frame whose results are available
+    /// have been converted to the CPU clock, see IDeviceContext::GetTimestampCalibration().
+    bool IsTimelineCalibrated() const
+    {
+        return m_ResultsCalibrated;
+    }
+
+    /// Returns the time, in seconds, between the BeginFrame() call on the CPU and the start of the frame
+    /// on the GPU for the most recent frame whose results are available, or 0 if the timeline is not calibrated.
+    double GetGPUStartLatency() const
+    {
+        return m_ResultsGPUStartLatency;
+    }
+
+    /// Returns the time, in seconds, the GPU was idle between the end of the previous frame and the start
+    /// of the most recent frame whose results are available, or 0 if it is unknown (e.g. the timeline
+    /// is not calibrated or the results of the previous frame have been dropped).
+    double GetGPUIdleTime() const
+    {
+        return m_ResultsGPUIdleTime;
+    }
+
+    /// Returns the statistics of all scopes that have been recorded in the last StatisticsWindow frames,
+    /// in the order the scopes were first seen.
+    std::vector<ScopeStatistics> GetScopeStatistics() const;
+
+    /// Returns the last TraceHistorySize frames in Chrome trace event JSON format.
+
+    /// \remarks    CPU and GPU scopes are exported as threads 'CPU' and 'GPU' of the same process.
+    ///             If the timeline is calibrated, GPU frames are placed at their actual start times
+    ///             on the CPU clock. Otherwise, the GPU timeline of every frame is aligned with
+    ///             the frame start on the CPU.
+    std::string ExportChromeTrace() const;
+
+    /// Returns the index of the frame, as counted by BeginFrame(), whose results are returned
+    /// by GetScopeTimings(), or ~Uint64{0} if no results are available yet.
+    Uint64 GetResultsFrameIndex() const
+    {
+        return m_ResultsFrameIndex;
+    }
+
+    /// Returns the number of frames whose results have been dropped because they were not
+    /// available when the queries had to be reused, or the timestamps were not reliable.
+    Uint32 GetNumDroppedFrames() const
+    {
+        return m_NumDroppedFrames;
+    }
+
+private:
+    struct FrameData
+    {
+        // Timestamp queries: frame start, frame end, and then the start and end of every scope.
+        std::vector<RefCntAutoPtr<IQuery>> Queries;
+        std::vector<IQuery*>               QueryPtrs;
+
+        std::vector<ScopeTiming> Scopes;
+
+        Uint32 NumScopes  = 0;
+        Uint64 FrameIndex = ~Uint64{0};
+        bool   IsPending  = false;
+
+        // CPU frame start time, in seconds since the profiler creation, and CPU frame duration
+        double CPUStartTime = 0;
+        double CPUDuration  = 0;
+
+        // GPU timestamp calibration sampled at the frame start
+        TimestampCalibration Calibration;
+        bool                 IsCalibrated = false;
+    };
+
+    struct ScopeHistory
+    {
+        std::string Path;
+        Uint32      Depth = 0;
+
+        // Ring buffers of the per-frame GPU and CPU durations
+        std::vector<float> Durations;
+        std::vector<float> CPUDurations;
+        Uint32             NumSamples = 0;
+        Uint32             NextSample = 0;
+        Uint64             LastFrame  = ~Uint64{0};
+    };
+
+    struct TraceFrame
+    {
+        Uint64                   FrameIndex   = 0;
+        double                   CPUStartTime = 0;
+        double                   CPUDuration  = 0;
+        double                   GPUStartTime = 0;
+        double                   Duration     = 0;
+        std::vector<ScopeTiming> Scopes;
+    };
+
+    bool ReadFrameResults(IDeviceContext* pCtx, FrameData& Frame);
+    void UpdateStatistics(Uint64 FrameIndex);
+
+    // Returns the CPU time, in seconds, since the profiler creation
+    double GetCPUTime() const;
+
+    const Uint32 m_MaxScopesPerFrame;
+    const Uint32 m_StatisticsWindow;
+    const Uint32 m_TraceHistorySize;
+    const bool   m_EmitDebugGroups;
+    const bool   m_CalibrateTimestamps;
+
+    // The profiler measures the CPU time with the steady clock, which is the domain
+    // of TimestampCalibration::CPUTime.
+    const std::chrono::steady_clock::time_point m_StartTime = std::chrono::steady_clock::now();
+
+    std::vector<FrameData> m_Frames;
+    Uint64                 m_FrameIndex = 0;
+    FrameData*             m_pCurrFrame = nullptr;
+
+    // Indices of the open scopes in the current frame
+    std::vector<Uint32> m_ScopeStack;
+
+    std::vector<QueryDataTimestamp> m_Timestamps;
+
+    std::vector<ScopeTiming> m_Results;
+    double                   m_ResultsFrameDuration    = 0;
+    double                   m_ResultsCPUFrameDuration = 0;
+    Uint64                   m_ResultsFrameIndex       = ~Uint64{0};
+    bool                     m_ResultsCalibrated       = false;
+    double                   m_ResultsGPUStartLatency  = 0;
+    double                   m_ResultsGPUIdleTime      = 0;
+
+    // GPU end time, on the CPU timeline, of the last calibrated frame whose results have been read
+    double m_LastGPUFrameEnd   = 0;
+    Uint64 m_LastGPUFrameIndex = ~Uint64{0};
+
+    Uint32 m_NumDroppedFrames = 0;
+
+    std::vector<ScopeHistory>               m_ScopeHistory;
+    std::unordered_map<std::string, size_t> m_ScopeHistoryIdx;
+    // Paths of the scopes in m_Results
+    std::vector<size_t> m_ResultHistoryIdx;
+
+    std::deque<TraceFrame> m_TraceHistory;
+};
+
+
+/// Helper class that begins a profiling scope in the constructor and ends it in the destructor.
+class GPUProfilerScope
+{
+public:
+    GPUProfilerScope(GPUProfiler& Profiler, IDeviceContext* pCtx, const char* Name) :
+        m_Profiler{Profiler},
+        m_pCtx{pCtx}
+    {
+        m_Profiler.BeginScope(m_pCtx, Name);
+    }
+
+    ~GPUProfilerScope()
+    {
+        m_Profiler.EndScope(m_pCtx);
+    }
+
+    // clang-format off
+    GPUProfilerScope           (const GPUProfilerScope&) = delete;
+    GPUProfilerScope& operator=(const GPUProfilerScope&) = delete;
+    GPUProfilerScope           (GPUProfilerScope&&)      = delete;
+    GPUProfilerScope& operator=(GPUProfilerScope&&)      = delete;
+    // clang-format on
+
+private:
+    GPUProfiler&    m_Profiler;
+    IDeviceContext* m_pCtx;
+};
+
+} // namespace Diligent
@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Asynchronously reads back buffer and texture data from the GPU.
+
+/// Every readback request copies the source data into a staging resource taken from
+/// the recycled staging pool and signals the fence. Once the GPU has passed the fence,
+/// Process() maps the staging resource and hands the mapped memory to the request's callback.
+/// If a thread pool is provided, callbacks run on its worker threads while the staging
+/// resource stays mapped, so that the data is not copied out of the mapped memory.
+/// In OpenGL backend, the data is copied to a CPU-side buffer and the staging resource is
+/// unmapped before the callback is invoked.
+///
+/// \note   All methods must be called from the thread that owns the device context.
+///         Callbacks may be invoked concurrently and in any order.
+class GPUReadbackQueue
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create staging resources.
+        IRenderDevice* pDevice = nullptr;
+
+        /// An optional thread pool to run readback callbacks on.
+        /// If null, callbacks are invoked by Process() on the calling thread.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The maximum number of recycled staging resources that are kept for reuse.
+        Uint32 MaxRecycledResources = 16;
+    };
+    explicit GPUReadbackQueue(const CreateInfo& CI);
+    ~GPUReadbackQueue();
+
+    // clang-format off
+    GPUReadbackQueue           (const GPUReadbackQueue&) = delete;
+    GPUReadbackQueue& operator=(const GPUReadbackQueue&) = delete;
+    GPUReadbackQueue           (GPUReadbackQueue&&)      = delete;
+    GPUReadbackQueue& operator=(GPUReadbackQueue&&)      = delete;
+    // clang-format on
+
+    /// Read back data passed to the callback.
+    struct ReadbackData
+    {
+        /// Pointer to the data. The pointer is only valid for the duration of the callback.
+        /// It is null if the staging resource could not be mapped.
+        const void* pData = nullptr;
+
+        /// Data size, in bytes.
+        Uint64 DataSize = 0;
+
+        /// Row stride, in bytes (for textures only).
+        Uint64 Stride = 0;
+
+        /// Depth slice stride, in bytes (for textures only).
+        Uint64 DepthStride = 0;
+    };
+    using CallbackType = std::function<void(const ReadbackData& Data)>;
+
+    /// Enqueues a readback of Size bytes of the buffer starting at Offset.
+    void ReadBuffer(IDeviceContext* pContext,
+                    IBuffer*        pBuffer,
+                    Uint64          Offset,
+                    Uint64          Size,
+                    CallbackType    Callback);
+
+    /// Enqueues a readback of the texture subresource region.
+    /// If pRegion is null, the entire subresource is read back.
+    void ReadTexture(IDeviceContext* pContext,
+                     ITexture*       pTexture,
+                     Uint32          MipLevel,
+                     Uint32          ArraySlice,
+                     const Box*      pRegion,
+                     CallbackType    Callback);
+
+    /// Dispatches callbacks for the readbacks that have been completed by the GPU, and
+    /// recycles the staging resources whose callbacks have finished.
+    /// This method should be called once per frame.
+    void Process(IDeviceContext* pContext);
+
+    /// Waits until all pending readbacks are completed and all callbacks are finished.
+    void Flush(IDeviceContext* pContext);
+
+    /// Returns the number of readbacks whose callbacks have not finished yet.
+    size_t GetNumPendingReadbacks() const
+    {
+        return m_PendingReadbacks.size() + m_MappedReadbacks.size();
+    }
+
+private:
+    struct Readback
+    {
+        RefCntAutoPtr<IBuffer>  pStagingBuffer;
+        RefCntAutoPtr<ITexture> pStagingTexture;
+
+        Uint64       DataSize   = 0;
+        Uint64       FenceValue = 0;
+        CallbackType Callback;
+
+        MappedTextureSubresource  MappedData;
+        std::vector<Uint8>        CopiedData;
+        RefCntAutoPtr<IAsyncTask> pTask;
+    };
+
+    std::unique_ptr<Readback> CreateReadback(CallbackType&& Callback);
+    void                      Enqueue(IDeviceContext* pContext, std::unique_ptr<Readback>&& pReadback);
+    void                      Dispatch(IDeviceContext* pContext, std::unique_ptr<Readback>&& pReadback);
+    void                      Unmap(IDeviceContext* pContext, Readback& RB);
+    void                      Recycle(Readback& RB);
+    void                      WaitForCallback(Readback& RB);
+
+    RefCntAutoPtr<IBuffer>  GetStagingBuffer(Uint64 Size);
+    RefCntAutoPtr<ITexture> GetStagingTexture(const TextureDesc& SrcDesc, Uint32 Width, Uint32 Height, Uint32 Depth);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IThreadPool>   m_pThreadPool;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    const Uint32 m_MaxRecycledResources;
+    const bool   m_ZeroCopy;
+
+    Uint64 m_NextFenceValue = 1;
+
+    // Readbacks waiting for the GPU, in fence order
+    std::deque<std::unique_ptr<Readback>> m_PendingReadbacks;
+    // Readbacks whose staging resources are mapped while callbacks are running
+    std::vector<std::unique_ptr<Readback>> m_MappedReadbacks;
+
+    std::vector<RefCntAutoPtr<IBuffer>>  m_RecycledBuffers;
+    std::vector<RefCntAutoPtr<ITexture>> m_RecycledTextures;
+};
+
+} // namespace Diligent
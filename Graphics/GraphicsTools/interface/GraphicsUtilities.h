@@ -112,6 +112,14 @@ struct ComputeMipLevelAttribs
     ///         A_new = max(A_old; 1/3 * A_old + 2/3 * AlphaCutoff)
     float AlphaCutoff          DEFAULT_INITIALIZER(0);
 
+    /// An optional thread pool to filter the coarse mip level rows in parallel.
+    ///
+    /// \remarks
+    ///     The calling thread filters rows as well. Tasks that have not started
+    ///     by the time all rows are processed are removed from the pool, so the
+    ///     function may also be called from a worker thread of the same pool.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr ComputeMipLevelAttribs() noexcept {}
 
@@ -123,7 +131,8 @@ struct ComputeMipLevelAttribs
                                      void*            _pCoarseMipData,
                                      size_t           _CoarseMipStride,
                                      MIP_FILTER_TYPE _FilterType  = ComputeMipLevelAttribs{}.FilterType,
-                                     float            _AlphaCutoff = ComputeMipLevelAttribs{}.AlphaCutoff) noexcept :
+                                     float            _AlphaCutoff = ComputeMipLevelAttribs{}.AlphaCutoff,
+                                     IThreadPool*     _pThreadPool = ComputeMipLevelAttribs{}.pThreadPool) noexcept :
         Format          {_Format},
         FineMipWidth    {_FineMipWidth},
         FineMipHeight   {_FineMipHeight},
@@ -132,7 +141,8 @@ struct ComputeMipLevelAttribs
         pCoarseMipData  {_pCoarseMipData},
         CoarseMipStride {_CoarseMipStride},
         FilterType      {_FilterType},
-        AlphaCutoff     {_AlphaCutoff}
+        AlphaCutoff     {_AlphaCutoff},
+        pThreadPool     {_pThreadPool}
     {} 
 #endif
 };
@@ -141,6 +151,77 @@ typedef struct ComputeMipLevelAttribs ComputeMipLevelAttribs;
 
 void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(const ComputeMipLevelAttribs REF Attribs);
 
+// clang-format off
+/// ComputeMipChain function attributes
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    TEXTURE_FORMAT Format     DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// Width of the most detailed mip level.
+    Uint32 Width              DEFAULT_INITIALIZER(0);
+
+    /// Height of the most detailed mip level.
+    Uint32 Height             DEFAULT_INITIALIZER(0);
+
+    /// The number of array slices.
+    Uint32 ArraySize          DEFAULT_INITIALIZER(1);
+
+    /// The number of mip levels. If 0, the full mip chain is computed.
+    Uint32 MipLevels          DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the array of ArraySize * MipLevels subresources.
+
+    /// Subresources use the same layout as TextureData::pSubResources: mip level M of
+    /// array slice S is pSubResources[S * MipLevels + M].
+    /// Mip level 0 of every slice contains the source data. The pData members
+    /// of all other levels must point to writable memory that receives the result.
+    const TextureSubResData* pSubResources DEFAULT_INITIALIZER(nullptr);
+
+    /// Filter type.
+    MIP_FILTER_TYPE FilterType DEFAULT_INITIALIZER(MIP_FILTER_TYPE_DEFAULT);
+
+    /// Alpha cutoff value, see ComputeMipLevelAttribs::AlphaCutoff.
+    float AlphaCutoff          DEFAULT_INITIALIZER(0);
+
+    /// An optional thread pool to compute the mip levels in parallel,
+    /// see ComputeMipLevelAttribs::pThreadPool.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ComputeMipChainAttribs() noexcept {}
+
+    constexpr ComputeMipChainAttribs(TEXTURE_FORMAT           _Format,
+                                     Uint32                   _Width,
+                                     Uint32                   _Height,
+                                     Uint32                   _ArraySize,
+                                     Uint32                   _MipLevels,
+                                     const TextureSubResData* _pSubResources,
+                                     MIP_FILTER_TYPE          _FilterType  = ComputeMipChainAttribs{}.FilterType,
+                                     float                    _AlphaCutoff = ComputeMipChainAttribs{}.AlphaCutoff,
+                                     IThreadPool*             _pThreadPool = ComputeMipChainAttribs{}.pThreadPool) noexcept :
+        Format       {_Format},
+        Width        {_Width},
+        Height       {_Height},
+        ArraySize    {_ArraySize},
+        MipLevels    {_MipLevels},
+        pSubResources{_pSubResources},
+        FilterType   {_FilterType},
+        AlphaCutoff  {_AlphaCutoff},
+        pThreadPool  {_pThreadPool}
+    {}
+#endif
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
+// clang-format on
+
+/// Computes all coarse mip levels of a 2D texture or texture array from the most detailed level.
+
+/// \remarks   The result is identical to calling ComputeMipLevel for every level
+///             of every slice, but the levels are computed in cache-friendly bands
+///             that are distributed between the threads of the optional thread pool.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
 /// For a Direct3D12 render device, returns the maximum supported shader version. For any other device type, returns 0.
 
 /// \param [in]  pDevice - a pointer to the render device object.
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::HiZPyramid class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+#include <vector>
+
+namespace Diligent
+{
+
+/// Builds a hierarchical depth (Hi-Z) pyramid from a depth buffer.
+
+/// Level 0 of the pyramid has the same size as the depth buffer. Every texel of the next levels
+/// contains the farthest depth of the texels it covers in the previous level: the maximum depth for
+/// the conventional depth range and the minimum depth for the reversed one. If the previous level has
+/// odd size, the last row and column of the next level also cover the extra row and column, so that
+/// every texel of a level is conservatively covered by exactly one texel of every coarser level.
+///
+/// The pyramid is kept per view: Build() recreates the texture when the depth buffer size changes.
+/// It is used by GPUInstanceCuller to perform occlusion culling on the GPU.
+///
+/// \note   The device must support compute shaders. Multisampled depth buffers are not supported.
+class HiZPyramid
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create the pipelines and the texture.
+        IRenderDevice* pDevice = nullptr;
+
+        /// Whether the depth buffer uses the reversed depth range, where
+        /// the near plane maps to 1 and the far plane maps to 0.
+        /// In this case, the pyramid is built using the minimum reduction.
+        bool ReverseDepth = false;
+
+        /// Compute shader thread group size in each dimension.
+        Uint32 ThreadGroupSize = 8;
+    };
+    explicit HiZPyramid(const CreateInfo& CI);
+    ~HiZPyramid();
+
+    // clang-format off
+    HiZPyramid           (const HiZPyramid&) = delete;
+    HiZPyramid& operator=(const HiZPyramid&) = delete;
+    HiZPyramid           (HiZPyramid&&)      = delete;
+    HiZPyramid& operator=(HiZPyramid&&)      = delete;
+    // clang-format on
+
+    /// Records the passes that build the pyramid from the depth buffer.
+
+    /// \param [in] pContext  - Device context to record the commands in.
+    /// \param [in] pDepthSRV - Shader resource view of a single-sampled 2D depth texture.
+    void Build(IDeviceContext* pContext, ITextureView* pDepthSRV);
+
+    /// Returns the pyramid texture, or null if Build() has not been called yet.
+    ITexture* GetTexture() const { return m_pTexture.RawPtr<ITexture>(); }
+
+    /// Returns the shader resource view of all levels of the pyramid.
+    ITextureView* GetSRV() const { return m_pTexture ? m_pTexture.RawPtr<ITexture>()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE) : nullptr; }
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+    Uint32 GetNumMipLevels() const { return static_cast<Uint32>(m_MipUAVs.size()); }
+
+    bool IsReverseDepth() const { return m_ReverseDepth; }
+
+private:
+    void CreatePipelines();
+    void CreateTexture(Uint32 Width, Uint32 Height);
+
+    enum PASS : Uint32
+    {
+        PASS_COPY_DEPTH = 0,
+        PASS_REDUCE,
+        PASS_COUNT
+    };
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const bool   m_ReverseDepth;
+    const Uint32 m_ThreadGroupSize;
+
+    Uint32 m_Width  = 0;
+    Uint32 m_Height = 0;
+
+    RefCntAutoPtr<IPipelineState> m_pPSO[PASS_COUNT];
+    RefCntAutoPtr<IBuffer>        m_pReduceAttribsCB;
+    RefCntAutoPtr<ITexture>       m_pTexture;
+
+    std::vector<RefCntAutoPtr<ITextureView>> m_MipUAVs;
+
+    // One SRB per level: SRB 0 copies the depth to level 0, SRB i reduces level i-1 to level i
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> m_SRBs;
+};
+
+} // namespace Diligent
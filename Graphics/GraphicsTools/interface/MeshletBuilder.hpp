@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines meshlet builder and meshlet culling helpers
+
+#include <vector>
+
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Meshlet description. The layout matches the MeshletDesc structure in the meshlet culling shader.
+struct MeshletDesc
+{
+    /// The offset of the first vertex in MeshletBuffer::Vertices.
+    Uint32 VertexOffset = 0;
+
+    /// The offset of the first triangle in MeshletBuffer::Triangles.
+    Uint32 TriangleOffset = 0;
+
+    /// The number of vertices.
+    Uint32 VertexCount = 0;
+
+    /// The number of triangles.
+    Uint32 TriangleCount = 0;
+};
+static_assert(sizeof(MeshletDesc) == 16, "The structure layout must match the shader");
+
+/// Meshlet culling bounds. The layout matches the MeshletBounds structure in the meshlet culling shader.
+struct MeshletBounds
+{
+    /// Bounding sphere: center in xyz, radius in w.
+    float4 Sphere;
+
+    /// Normal cone: axis in xyz, cutoff in w.
+    /// The meshlet is back-facing for every camera position C that satisfies
+    ///
+    ///     dot(Sphere.xyz - C, Cone.xyz) >= Cone.w * length(Sphere.xyz - C) + Sphere.w
+    ///
+    /// The cutoff is 1 if the triangle normals diverge too much, so that the meshlet is never cone-culled.
+    float4 Cone;
+};
+static_assert(sizeof(MeshletBounds) == 32, "The structure layout must match the shader");
+
+/// Meshlets of a triangle mesh.
+struct MeshletBuffer
+{
+    /// The maximum number of vertices in a meshlet.
+    Uint32 MaxVertices = 0;
+
+    /// The maximum number of triangles in a meshlet.
+    Uint32 MaxTriangles = 0;
+
+    /// Meshlet descriptions.
+    std::vector<MeshletDesc> Meshlets;
+
+    /// Culling bounds of every meshlet.
+    std::vector<MeshletBounds> Bounds;
+
+    /// Indices of the mesh vertices referenced by the meshlets.
+    std::vector<Uint32> Vertices;
+
+    /// Meshlet triangles. Every triangle is packed into one Uint32 as i0 | (i1 << 8) | (i2 << 16),
+    /// where i0, i1, i2 are the indices of the triangle vertices relative to MeshletDesc::VertexOffset.
+    std::vector<Uint32> Triangles;
+
+    /// Writes the meshlet buffer to a data blob.
+    void Store(IDataBlob** ppDataBlob) const;
+
+    /// Loads the meshlet buffer from the data blob written by Store().
+    /// Returns false if the data is not a valid meshlet buffer.
+    bool Load(IDataBlob* pDataBlob);
+
+    void Clear();
+};
+
+/// Attributes of the BuildMeshlets() function.
+struct BuildMeshletsAttribs
+{
+    /// Triangle list indices.
+    const Uint32* pIndices = nullptr;
+
+    /// The number of indices. Must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// Vertex positions. Every position is three floats.
+    const void* pPositions = nullptr;
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// The distance in bytes between consecutive positions.
+    Uint32 PositionStride = sizeof(float3);
+
+    /// The maximum number of vertices in a meshlet. Must be in the range [3, 256].
+    Uint32 MaxVertices = 64;
+
+    /// The maximum number of triangles in a meshlet. Must be at least 1.
+    Uint32 MaxTriangles = 124;
+
+    /// Whether the triangles are reordered for the post-transform vertex cache before
+    /// they are partitioned into meshlets.
+    bool OptimizeVertexCache = true;
+
+    /// The vertex cache size used by the optimization.
+    Uint32 VertexCacheSize = 16;
+
+    /// Whether front-facing triangles are counter-clockwise, see RasterizerStateDesc::FrontCounterClockwise.
+    /// Determines the direction of the normal cones. Positions are assumed to be in a left-handed coordinate system.
+    bool FrontCounterClockwise = false;
+};
+
+/// Splits an indexed triangle list into meshlets and computes their culling bounds.
+
+/// Triangles are first reordered for the vertex cache. Meshlets are then grown from the triangles that
+/// share the most vertices with the current meshlet, so that every meshlet is a connected patch and
+/// vertices are shared by as few meshlets as possible. Degenerate triangles are removed.
+///
+/// Returns false if the attributes are invalid.
+bool BuildMeshlets(const BuildMeshletsAttribs& Attribs, MeshletBuffer& Buffer);
+
+/// Computes the culling bounds of a meshlet.
+MeshletBounds ComputeMeshletBounds(const MeshletBuffer& Buffer,
+                                   Uint32               MeshletIndex,
+                                   const void*          pPositions,
+                                   Uint32               PositionStride        = sizeof(float3),
+                                   bool                 FrontCounterClockwise = false);
+
+/// Constant buffer layout of the amplification shader produced from GetMeshletCullingShaderSource().
+struct MeshletCullingConstants
+{
+    /// Transposed world matrix. It must only contain rotation, translation and uniform scale.
+    float4x4 World;
+
+    /// World-space frustum planes. A point p is inside the plane if dot(p, Plane.xyz) + Plane.w >= 0.
+    float4 FrustumPlanes[6];
+
+    /// World-space camera position.
+    float3 CameraPos;
+
+    /// The scale of the world matrix.
+    float Scale = 1;
+
+    /// The index of the first meshlet to process.
+    Uint32 FirstMeshlet = 0;
+
+    /// The number of meshlets to process.
+    Uint32 NumMeshlets = 0;
+
+    /// Whether cone culling is enabled.
+    Uint32 ConeCulling = 1;
+
+    Uint32 Padding = 0;
+};
+static_assert(sizeof(MeshletCullingConstants) == 192, "The structure layout must match the shader");
+
+/// Returns the HLSL source of the meshlet culling shader template.
+
+/// The source declares the MeshletDesc, MeshletBounds and MeshletPayload structures, the UnpackMeshletTriangle(),
+/// IsMeshletInFrustum() and IsMeshletBackFacing() functions that can be used by application shaders.
+/// If the MESHLET_CULLING_AS macro is defined, the source also defines the 'main' entry point of
+/// an amplification shader that culls meshlets against the frustum and the normal cone and launches
+/// one mesh shader group per visible meshlet. The mesh shader finds the meshlet index in
+/// MeshletPayload::MeshletIndices[SV_GroupID.x]. The shader uses the following resources:
+/// - cbMeshletCullingConstants - constant buffer with MeshletCullingConstants data;
+/// - g_MeshletBounds           - structured buffer of MeshletBounds elements.
+///
+/// The thread group size is defined by the MESHLET_AS_GROUP_SIZE macro (32 by default).
+const char* GetMeshletCullingShaderSource();
+
+} // namespace Diligent
@@ -0,0 +1,313 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of RenderGraph class
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "TransientResourceAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Render graph pass flags.
+enum RENDER_GRAPH_PASS_FLAGS : Uint32
+{
+    /// No flags.
+    RENDER_GRAPH_PASS_FLAG_NONE = 0u,
+
+    /// The pass only records compute and copy commands and may be executed
+    /// on the asynchronous compute context, see RenderGraphExecuteAttribs::pAsyncComputeContext.
+    RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE = 1u << 0,
+
+    /// The pass is never culled, even if none of its outputs is used.
+    RENDER_GRAPH_PASS_FLAG_NEVER_CULL = 1u << 1,
+};
+DEFINE_FLAG_ENUM_OPERATORS(RENDER_GRAPH_PASS_FLAGS);
+
+
+/// Render graph execution attributes.
+struct RenderGraphExecuteAttribs
+{
+    /// Immediate context that executes graphics passes. Must not be null.
+    IDeviceContext* pContext = nullptr;
+
+    /// Optional immediate context created for a compute queue.
+
+    /// \remarks    If this member is not null, passes with RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE flag
+    ///             are executed on this context, and the graph synchronizes the two contexts
+    ///             with fences where a pass depends on a pass executed on the other context.
+    ///             Every dependency is covered by the earliest fence value that includes it,
+    ///             and waits already implied by previous waits are skipped.
+    ///
+    ///             All resources used by such passes must be accessible from both contexts
+    ///             (see ImmediateContextMask in Diligent::TextureDesc and Diligent::BufferDesc).
+    ///             A pass that uses a resource not accessible from the compute context
+    ///             is executed on the graphics context instead.
+    ///
+    ///             Resources that are in a state not supported by the compute queue (e.g.
+    ///             RESOURCE_STATE_RENDER_TARGET) are transitioned on the graphics context
+    ///             before they are handed over to the compute context.
+    IDeviceContext* pAsyncComputeContext = nullptr;
+};
+
+
+/// Render graph execution statistics, see RenderGraph::GetExecutionStats().
+struct RenderGraphExecutionStats
+{
+    /// The number of passes executed on the graphics context.
+    Uint32 NumGraphicsPasses = 0;
+
+    /// The number of passes executed on the asynchronous compute context.
+    Uint32 NumAsyncComputePasses = 0;
+
+    /// The number of passes with RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE flag that were
+    /// executed on the graphics context because they use a resource that is not
+    /// accessible from the compute context.
+    Uint32 NumDemotedComputePasses = 0;
+
+    /// The number of asynchronous compute passes that are not ordered by fences
+    /// with respect to at least one graphics pass, and thus may overlap with it on the GPU.
+    Uint32 NumOverlappingComputePasses = 0;
+
+    /// The number of graphics passes that may overlap with at least one asynchronous compute pass.
+    Uint32 NumOverlappingGraphicsPasses = 0;
+
+    /// The number of fence signals enqueued by the graph.
+    Uint32 NumFenceSignals = 0;
+
+    /// The number of fence waits enqueued by the graph.
+    Uint32 NumFenceWaits = 0;
+
+    /// The number of resources transitioned on the graphics context out of the states
+    /// not supported by the compute queue before they were used by a compute pass.
+    Uint32 NumQueueHandoffTransitions = 0;
+};
+
+
+/// Render graph.
+
+/// An application adds passes to the graph and declares the resources that every pass
+/// reads and writes. Compile() then computes the execution order, culls the passes
+/// whose results are not used, and assigns asynchronous compute passes to the compute
+/// context. Execute() runs the pass callbacks, issuing one batch of state transitions
+/// at every pass boundary.
+///
+/// \remarks    Pass callbacks should use RESOURCE_STATE_TRANSITION_MODE_VERIFY or
+///             RESOURCE_STATE_TRANSITION_MODE_NONE for the resources declared in the graph,
+///             as the graph transitions them to the required states before the pass is executed.
+///
+///             A pass is kept alive if it has RENDER_GRAPH_PASS_FLAG_NEVER_CULL flag, writes
+///             an imported resource, or writes a resource read or written by a pass that is alive.
+///
+///             Textures created with CreateTexture() are only alive during the frame and
+///             are allocated by Diligent::TransientResourceAllocator, so that textures with
+///             non-overlapping lifetimes share the same physical object.
+class RenderGraph
+{
+public:
+    using ResourceHandle      = Uint32;
+    using PassHandle          = Uint32;
+    using ExecuteCallbackType = std::function<void(IDeviceContext* pContext)>;
+
+    static constexpr Uint32 InvalidHandle = ~0u;
+
+    explicit RenderGraph(IRenderDevice* pDevice);
+
+    // clang-format off
+    RenderGraph           (const RenderGraph&)  = delete;
+    RenderGraph& operator=(const RenderGraph&)  = delete;
+    RenderGraph           (      RenderGraph&&) = delete;
+    RenderGraph& operator=(      RenderGraph&&) = delete;
+    // clang-format on
+
+    /// Imports an external texture into the graph.
+
+    /// \remarks    The state of the texture must be known to the engine.
+    ///             Passes that write imported resources are never culled.
+    ResourceHandle ImportTexture(ITexture* pTexture);
+
+    /// Imports an external buffer into the graph.
+
+    /// \remarks    The state of the buffer must be known to the engine.
+    ///             Passes that write imported resources are never culled.
+    ResourceHandle ImportBuffer(IBuffer* pBuffer);
+
+    /// Declares a transient texture that is only alive during the frame.
+
+    /// \remarks    The physical texture can be obtained with GetTexture() from the pass callbacks.
+    ///
+    ///             If Desc.MiscFlags contains MISC_TEXTURE_FLAG_MEMORYLESS, the texture is created as a
+    ///             transient attachment that is not backed by device memory (lazily allocated memory in Vulkan).
+    ///             The pass must use it inside a render pass with load operations other than ATTACHMENT_LOAD_OP_LOAD
+    ///             and store operations other than ATTACHMENT_STORE_OP_STORE. The flag is ignored if the
+    ///             device does not support memoryless textures with the given bind flags
+    ///             (see Diligent::AdapterMemoryInfo::MemorylessTextureBindFlags), or if the texture is used by more
+    ///             than one pass or in a state other than an attachment state.
+    ResourceHandle CreateTexture(const TextureDesc& Desc);
+
+    /// Adds a pass to the graph.
+    PassHandle AddPass(const Char*             Name,
+                       RENDER_GRAPH_PASS_FLAGS Flags,
+                       ExecuteCallbackType     Execute);
+
+    /// Declares that the pass reads the resource in the given state.
+    void Read(PassHandle Pass, ResourceHandle Resource, RESOURCE_STATE State);
+
+    /// Declares that the pass writes the resource in the given state.
+    void Write(PassHandle Pass, ResourceHandle Resource, RESOURCE_STATE State);
+
+    /// Computes the execution order, culls unused passes and allocates transient textures.
+    void Compile();
+
+    /// Executes the compiled graph.
+    void Execute(const RenderGraphExecuteAttribs& Attribs);
+
+    /// Clears all passes and resources. Transient textures remain in the pool
+    /// and may be reused by the next frame.
+    void Reset();
+
+    /// Returns the texture associated with the handle.
+
+    /// \remarks    For transient textures, the method must only be called after Compile().
+    ITexture* GetTexture(ResourceHandle Resource) const;
+
+    /// Returns the buffer associated with the handle.
+    IBuffer* GetBuffer(ResourceHandle Resource) const;
+
+    /// Returns the passes in the order they are executed. Culled passes are not included.
+    const std::vector<PassHandle>& GetExecutionOrder() const
+    {
+        return m_ExecutionOrder;
+    }
+
+    /// Returns true if the pass has been culled by Compile().
+    bool IsPassCulled(PassHandle Pass) const;
+
+    /// Returns the statistics of the last Execute() call.
+    const RenderGraphExecutionStats& GetExecutionStats() const
+    {
+        return m_Stats;
+    }
+
+    /// Returns the transient resource allocator used by the graph.
+    const TransientResourceAllocator& GetTransientAllocator() const
+    {
+        return m_TransientAllocator;
+    }
+
+private:
+    struct ResourceInfo
+    {
+        std::string Name;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        RefCntAutoPtr<IBuffer>  pBuffer;
+
+        // Description of the transient texture
+        TextureDesc TransientDesc;
+        Uint32      TransientHandle = InvalidHandle;
+
+        bool IsImported = false;
+    };
+
+    struct ResourceAccess
+    {
+        ResourceHandle Resource = InvalidHandle;
+        RESOURCE_STATE State    = RESOURCE_STATE_UNKNOWN;
+        bool           IsWrite  = false;
+    };
+
+    struct PassInfo
+    {
+        std::string Name;
+
+        RENDER_GRAPH_PASS_FLAGS Flags = RENDER_GRAPH_PASS_FLAG_NONE;
+        ExecuteCallbackType     Execute;
+
+        std::vector<ResourceAccess> Accesses;
+
+        // All passes that must be executed before this pass
+        std::vector<PassHandle> Dependencies;
+        // Passes whose results are consumed by this pass
+        std::vector<PassHandle> Producers;
+
+        bool IsCulled  = false;
+        bool OnCompute = false;
+    };
+
+    enum QUEUE_ID : Uint32
+    {
+        QUEUE_ID_GRAPHICS = 0,
+        QUEUE_ID_COMPUTE,
+        QUEUE_ID_COUNT
+    };
+
+    void BuildDependencies();
+    void CullPasses();
+    void SortPasses();
+    void AllocateTransientTextures();
+
+    IDeviceObject* GetResourceObject(ResourceHandle Resource) const;
+    RESOURCE_STATE GetResourceState(ResourceHandle Resource) const;
+    Uint64         GetResourceContextMask(ResourceHandle Resource) const;
+
+    // Transitions the resources used by the pass to the required states and returns the number of barriers.
+    // If CurrStateFilter is not RESOURCE_STATE_UNKNOWN, only resources whose current state
+    // includes any of the filter bits are transitioned.
+    Uint32 TransitionPassResources(IDeviceContext* pContext, const PassInfo& Pass, RESOURCE_STATE CurrStateFilter = RESOURCE_STATE_UNKNOWN);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    std::vector<ResourceInfo> m_Resources;
+    std::vector<PassInfo>     m_Passes;
+    std::vector<PassHandle>   m_ExecutionOrder;
+
+    TransientResourceAllocator m_TransientAllocator;
+
+    std::vector<StateTransitionDesc> m_Barriers;
+
+    // Fences used to synchronize graphics and compute contexts
+    RefCntAutoPtr<IFence> m_pFences[QUEUE_ID_COUNT];
+    Uint64                m_NextFenceValue[QUEUE_ID_COUNT] = {};
+
+    RenderGraphExecutionStats m_Stats;
+
+    bool m_IsCompiled = false;
+};
+
+} // namespace Diligent
@@ -69,6 +69,10 @@ struct RenderStateCacheCreateInfo
     /// shaders. If null, original source factory will be used.
     IShaderSourceInputStreamFactory* pReloadSource DEFAULT_INITIALIZER(nullptr);
 
+    /// Whether to record the pipelines requested from the cache in the usage log,
+    /// see IRenderStateCache::WriteUsageLog.
+    bool EnableUsageLog DEFAULT_INITIALIZER(false);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr RenderStateCacheCreateInfo() noexcept
     {}
@@ -87,6 +91,33 @@ struct RenderStateCacheCreateInfo
 };
 typedef struct RenderStateCacheCreateInfo RenderStateCacheCreateInfo;
 
+/// Render state cache statistics.
+struct RenderStateCacheStats
+{
+    /// The number of shader requests that were served by an existing shader object.
+    Uint32 ShaderHitCount DEFAULT_INITIALIZER(0);
+
+    /// The number of shader requests that were not served by an existing shader object.
+    Uint32 ShaderMissCount DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline requests that were served by an existing pipeline state object.
+    Uint32 PipelineHitCount DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline requests that were not served by an existing pipeline state object.
+    Uint32 PipelineMissCount DEFAULT_INITIALIZER(0);
+
+    /// The number of times a thread had to wait for an internal lock held by another thread.
+    Uint32 LockContentionCount DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline requests that were served by a pipeline prefetched with
+    /// IRenderStateCache::PrefetchPipelines.
+    Uint32 PrefetchHitCount DEFAULT_INITIALIZER(0);
+
+    /// The number of prefetched pipelines that have not been unpacked yet.
+    Uint32 PendingPrefetchCount DEFAULT_INITIALIZER(0);
+};
+typedef struct RenderStateCacheStats RenderStateCacheStats;
+
 #if DILIGENT_C_INTERFACE
 #    define REF *
 #else
@@ -198,6 +229,102 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
     VIRTUAL Bool METHOD(WriteToStream)(THIS_
                                        IFileStream* pStream) PURE;
 
+    /// Appends render states created since the last write to a journal stream.
+
+    /// \param [in] pStream - A pointer to the journal file stream, e.g. a file opened for appending.
+    ///
+    /// \return     true if new render states were written or there were no new states,
+    ///             and false otherwise.
+    ///
+    /// \remarks    Unlike WriteToBlob and WriteToStream, this method only serializes the render states
+    ///             that have been added to the cache since the last call to any of these methods, so
+    ///             its cost does not depend on the size of the cache. Every call appends a self-contained
+    ///             record to the journal. Use LoadJournal to load the records, and CompactJournal to
+    ///             fold them into the main cache archive.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL Bool METHOD(AppendToJournal)(THIS_
+                                         IFileStream* pStream) PURE;
+
+    /// Loads render states from a journal written by AppendToJournal.
+
+    /// \param [in] pJournal - A pointer to the journal data.
+    ///
+    /// \return     true if the journal was loaded successfully, and false otherwise.
+    ///
+    /// \remarks    The journal is applied on top of the archives loaded with Load.
+    ///             An incomplete record at the end of the journal, for example left by an
+    ///             application that was terminated while writing it, is ignored.
+    ///             The records are copied, so the journal data may be released after the call.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL bool METHOD(LoadJournal)(THIS_
+                                     const IDataBlob* pJournal) PURE;
+
+    /// Folds the journal into the cache archive.
+
+    /// \param [in]  pArchive  - A pointer to the cache archive data. May be null.
+    /// \param [in]  pJournal  - A pointer to the journal data. May be null.
+    /// \param [out] ppArchive - Address of the memory location where a pointer to the data blob
+    ///                          containing the compacted archive will be written.
+    ///
+    /// \return     true if the archive was compacted successfully, and false otherwise.
+    ///
+    /// \remarks    The method does not use or modify the cache contents and is thread-safe,
+    ///             so it can be run in a background thread while the cache is in use.
+    ///             After the compacted archive has been saved, the journal may be truncated.
+    VIRTUAL Bool METHOD(CompactJournal)(THIS_
+                                        const IDataBlob* pArchive,
+                                        const IDataBlob* pJournal,
+                                        IDataBlob**      ppArchive) CONST PURE;
+
+    /// Writes the pipeline usage log.
+
+    /// \param [out] ppLog    - Address of the memory location where a pointer to the data blob
+    ///                         containing the usage log will be written.
+    /// \param [in]  ResetLog - Whether to clear the log after it has been written.
+    ///
+    /// \return     true if the log was written successfully, and false otherwise.
+    ///
+    /// \remarks    The usage log lists the pipelines requested from the cache since it was created
+    ///             or since the log was last reset, in the order of their first request. Usage
+    ///             logging must be enabled by the EnableUsageLog member of RenderStateCacheCreateInfo.
+    ///
+    ///             To record the pipelines used by a level or a scene, reset the log when the level is
+    ///             loaded and write it when the level is unloaded. On the next run, pass the log to
+    ///             PrefetchPipelines while the loading screen is shown.
+    VIRTUAL Bool METHOD(WriteUsageLog)(THIS_
+                                       IDataBlob** ppLog,
+                                       Bool        ResetLog DEFAULT_VALUE(true)) PURE;
+
+    /// Starts unpacking the pipelines listed in the usage log from the loaded archives.
+
+    /// \param [in] pUsageLog   - A pointer to the usage log written by WriteUsageLog.
+    /// \param [in] pThreadPool - An optional thread pool to unpack the pipelines in.
+    ///                           If null, the pipelines are unpacked by the calling thread
+    ///                           before the method returns.
+    ///
+    /// \return     The number of pipelines that were scheduled for unpacking.
+    ///
+    /// \remarks    The pipelines are unpacked in the order they are listed in the log, so that the
+    ///             pipelines that were requested first are ready first. The cache keeps the prefetched
+    ///             pipelines alive until they are requested with one of the Create*PipelineState methods
+    ///             or until the cache is reset.
+    ///
+    ///             If a pipeline is requested before it has been unpacked, the request does not wait for
+    ///             the remaining queue: a pipeline that has not been started is removed from the queue
+    ///             and created by the requesting thread, and a pipeline that is being unpacked is waited for.
+    ///
+    ///             Only the pipelines that are present in the loaded archives can be prefetched.
+    ///             Use GetStats to monitor the progress.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with Load, LoadJournal or Reset.
+    VIRTUAL Uint32 METHOD(PrefetchPipelines)(THIS_
+                                             const IDataBlob*    pUsageLog,
+                                             struct IThreadPool* pThreadPool DEFAULT_VALUE(nullptr)) PURE;
 
     /// Resets the cache to default state.
     VIRTUAL void METHOD(Reset)(THIS) PURE;
@@ -213,9 +340,20 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
     ///
     /// \remars     Reloading is only enabled if the cache was created with the EnableHotReload member of
     ///             RenderStateCacheCreateInfo member set to true.
+    ///
+    ///             Only shaders whose source files (including all included files) have been modified
+    ///             since they were last loaded are re-created, as well as pipelines that use these shaders.
+    ///             If ReloadGraphicsPipeline is not null, all graphics pipelines are re-created.
     VIRTUAL Uint32 METHOD(Reload)(THIS_
                                   ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline DEFAULT_VALUE(nullptr), 
                                   void*                              pUserData              DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Returns the render state cache statistics, see Diligent::RenderStateCacheStats.
+
+    /// \remarks    The counters are updated without synchronization with object creation
+    ///             and are intended for profiling purposes only.
+    VIRTUAL void METHOD(GetStats)(THIS_
+                                  RenderStateCacheStats REF Stats) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -232,8 +370,14 @@ DILIGENT_END_INTERFACE
 #    define IRenderStateCache_CreateTilePipelineState(This, ...)       CALL_IFACE_METHOD(RenderStateCache, CreateTilePipelineState,      This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToBlob(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, WriteToBlob,                  This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToStream(This, ...)                 CALL_IFACE_METHOD(RenderStateCache, WriteToStream,                This, __VA_ARGS__)
+#    define IRenderStateCache_AppendToJournal(This, ...)               CALL_IFACE_METHOD(RenderStateCache, AppendToJournal,              This, __VA_ARGS__)
+#    define IRenderStateCache_LoadJournal(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, LoadJournal,                  This, __VA_ARGS__)
+#    define IRenderStateCache_CompactJournal(This, ...)                CALL_IFACE_METHOD(RenderStateCache, CompactJournal,               This, __VA_ARGS__)
+#    define IRenderStateCache_WriteUsageLog(This, ...)                 CALL_IFACE_METHOD(RenderStateCache, WriteUsageLog,                This, __VA_ARGS__)
+#    define IRenderStateCache_PrefetchPipelines(This, ...)             CALL_IFACE_METHOD(RenderStateCache, PrefetchPipelines,            This, __VA_ARGS__)
 #    define IRenderStateCache_Reset(This)                              CALL_IFACE_METHOD(RenderStateCache, Reset,                        This)
 #    define IRenderStateCache_Reload(This, ...)                        CALL_IFACE_METHOD(RenderStateCache, Reload,                       This, __VA_ARGS__)
+#    define IRenderStateCache_GetStats(This, ...)                      CALL_IFACE_METHOD(RenderStateCache, GetStats,                     This, __VA_ARGS__)
 // clang-format on
 
 #endif
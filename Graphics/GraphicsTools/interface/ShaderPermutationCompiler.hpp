@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of ShaderPermutationCompiler class
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "BytecodeCache.h"
+#include "RenderStateCache.h"
+#include "ShaderPermutationSchema.hpp"
+#include "XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+class ShaderIncludeCache;
+
+/// Shader permutation compiler create info.
+struct ShaderPermutationCompilerCreateInfo
+{
+    /// Render device that is used to create shaders.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Optional render state cache. If not null, shaders are created through the cache.
+    IRenderStateCache* pStateCache = nullptr;
+
+    /// Optional bytecode cache that stores the byte code of compiled permutations.
+    /// The cache is keyed by the permutation contents rather than by the original create info.
+    IBytecodeCache* pBytecodeCache = nullptr;
+};
+
+/// Creates shaders while collapsing equivalent permutations into a single compilation.
+
+/// Shader permutations are identified by a content key that is computed from the source with all
+/// includes unrolled, comments and redundant white space removed, and only those macros that are
+/// referenced by the source, sorted by name. Shader names are ignored. All requests with
+/// the same key share one shader object. If a permutation is being compiled by another thread,
+/// the request waits for that compilation to finish instead of starting a new one.
+///
+/// \remarks    The class is thread-safe. Include files are read once and cached until Reset() is called.
+///             Compiler output (ShaderCreateInfo::ppCompilerOutput) is only written for the request
+///             that actually compiles the permutation.
+///             Macros that are only referenced through token pasting are not detected and must not
+///             be used with this class.
+///
+///             Uber-shaders with many permutations should declare their macros with ShaderPermutationSchema
+///             and use the CreateShader() overload that takes the source hash and the permutation key.
+///             Permutations that were requested before are then found by the (source hash, key) pair
+///             without unrolling includes or hashing the source and macro strings.
+class ShaderPermutationCompiler
+{
+public:
+    /// Compiler statistics.
+    struct Statistics
+    {
+        /// The total number of CreateShader() requests.
+        Uint32 NumRequests = 0;
+
+        /// The number of shaders created from source, either by the device or by the render state cache.
+        Uint32 NumCompiled = 0;
+
+        /// The number of shaders created from the byte code cache.
+        Uint32 NumBytecodeCacheHits = 0;
+
+        /// The number of requests that reused an existing or in-flight permutation.
+        Uint32 NumDeduplicated = 0;
+    };
+
+    explicit ShaderPermutationCompiler(const ShaderPermutationCompilerCreateInfo& CI);
+    ~ShaderPermutationCompiler();
+
+    // clang-format off
+    ShaderPermutationCompiler           (const ShaderPermutationCompiler&)  = delete;
+    ShaderPermutationCompiler& operator=(const ShaderPermutationCompiler&)  = delete;
+    ShaderPermutationCompiler           (      ShaderPermutationCompiler&&) = delete;
+    ShaderPermutationCompiler& operator=(      ShaderPermutationCompiler&&) = delete;
+    // clang-format on
+
+    /// Returns the shader for the given create info, compiling it only if no equivalent
+    /// permutation has been requested before. Returns null if the shader could not be created.
+    RefCntAutoPtr<IShader> CreateShader(const ShaderCreateInfo& ShaderCI);
+
+    /// Returns the shader permutation of the uber-shader identified by the source hash.
+
+    /// \param [in] ShaderCI   - Shader create info. The permutation macros are appended to ShaderCI.Macros,
+    ///                          which must not define any macro declared by the schema.
+    /// \param [in] SourceHash - The hash returned by ComputeSourceHash() for ShaderCI and Schema.
+    /// \param [in] Schema     - Permutation schema.
+    /// \param [in] Key        - Permutation key.
+    RefCntAutoPtr<IShader> CreateShader(const ShaderCreateInfo&        ShaderCI,
+                                        const XXH128Hash&              SourceHash,
+                                        const ShaderPermutationSchema& Schema,
+                                        ShaderPermutationKey           Key);
+
+    /// Computes the hash that identifies the uber-shader defined by the create info and the permutation schema.
+    /// The hash should be computed once and reused for all permutations.
+    XXH128Hash ComputeSourceHash(const ShaderCreateInfo& ShaderCI, const ShaderPermutationSchema& Schema) noexcept(false);
+
+    /// Computes the content key of the shader permutation.
+    static XXH128Hash ComputeKey(const ShaderCreateInfo& ShaderCI, RENDER_DEVICE_TYPE DeviceType) noexcept(false);
+
+    /// Releases all shaders and cached include files.
+    void Reset();
+
+    /// Returns compiler statistics.
+    Statistics GetStatistics() const;
+
+private:
+    RefCntAutoPtr<IShader> CreateShaderInternal(const ShaderCreateInfo& ShaderCI);
+
+    // pKeyCI is the content-addressed create info used as the byte code cache key.
+    // If it is null, the byte code cache is not used.
+    RefCntAutoPtr<IShader> CompilePermutation(const ShaderCreateInfo& ShaderCI, const ShaderCreateInfo* pKeyCI);
+
+    RefCntAutoPtr<IRenderDevice>     m_pDevice;
+    RefCntAutoPtr<IRenderStateCache> m_pStateCache;
+    RefCntAutoPtr<IBytecodeCache>    m_pBytecodeCache;
+    const RENDER_DEVICE_TYPE         m_DeviceType;
+
+    std::unique_ptr<ShaderIncludeCache> m_pIncludeCache;
+
+    std::mutex                                                                 m_PermutationsMtx;
+    std::unordered_map<XXH128Hash, std::shared_future<RefCntAutoPtr<IShader>>> m_Permutations;
+
+    struct KeyedPermutation
+    {
+        XXH128Hash           SourceHash;
+        ShaderPermutationKey Key;
+
+        bool operator==(const KeyedPermutation& RHS) const noexcept
+        {
+            return SourceHash == RHS.SourceHash && Key == RHS.Key;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const KeyedPermutation& Perm) const noexcept
+            {
+                return ComputeHash(Perm.SourceHash, Perm.Key);
+            }
+        };
+    };
+    std::mutex                                                                                                 m_KeyedPermutationsMtx;
+    std::unordered_map<KeyedPermutation, std::shared_future<RefCntAutoPtr<IShader>>, KeyedPermutation::Hasher> m_KeyedPermutations;
+
+    // IBytecodeCache is not thread-safe
+    std::mutex m_BytecodeCacheMtx;
+
+    std::atomic<Uint32> m_NumRequests{0};
+    std::atomic<Uint32> m_NumCompiled{0};
+    std::atomic<Uint32> m_NumBytecodeCacheHits{0};
+    std::atomic<Uint32> m_NumDeduplicated{0};
+};
+
+} // namespace Diligent
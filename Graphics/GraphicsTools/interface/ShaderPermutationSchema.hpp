@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of ShaderPermutationSchema class
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "ShaderMacroHelper.hpp"
+#include "XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+/// Shader permutation key that packs the values of all macros declared by a ShaderPermutationSchema.
+struct ShaderPermutationKey
+{
+    Uint64 Bits = 0;
+
+    constexpr bool operator==(const ShaderPermutationKey& RHS) const noexcept
+    {
+        return Bits == RHS.Bits;
+    }
+    constexpr bool operator!=(const ShaderPermutationKey& RHS) const noexcept
+    {
+        return Bits != RHS.Bits;
+    }
+};
+
+/// Describes the permutation macros of an uber-shader.
+
+/// Every macro is declared once as a bit field of a 64-bit ShaderPermutationKey. Macro definitions
+/// are generated when the field is added, so converting a key to macros does not allocate strings
+/// and selecting a permutation only requires setting a few bits.
+///
+/// \remarks    A field value is stored as the offset from the field's minimum value. The default
+///             key (all bits zero) thus selects the minimum value of every field.
+class ShaderPermutationSchema
+{
+public:
+    /// The maximum total number of bits used by all fields.
+    static constexpr Uint32 MaxKeyBits = 64;
+
+    /// The maximum number of values of a single field.
+    static constexpr Uint32 MaxFieldValues = 4096;
+
+    /// Adds a boolean macro that is defined as 0 or 1, and returns the field index.
+    Uint32 AddBool(const Char* Name) noexcept(false);
+
+    /// Adds an integer macro that takes values in the range [MinValue, MaxValue], and returns the field index.
+    Uint32 AddInt(const Char* Name, Int32 MinValue, Int32 MaxValue) noexcept(false);
+
+    /// Adds a macro whose value i is defined as Definitions[i], and returns the field index.
+    Uint32 AddEnum(const Char* Name, std::vector<std::string> Definitions) noexcept(false);
+
+    /// Sets the value of the field in the key.
+    void SetValue(ShaderPermutationKey& Key, Uint32 Field, Int32 Value) const;
+
+    /// Returns the value of the field in the key.
+    Int32 GetValue(ShaderPermutationKey Key, Uint32 Field) const;
+
+    /// Writes the null-terminated array of macros for the key to Macros.
+
+    /// Macro names and definitions point to the strings owned by the schema and
+    /// remain valid until the schema is modified or destroyed.
+    void GetMacros(ShaderPermutationKey Key, std::vector<ShaderMacro>& Macros) const;
+
+    /// Returns the macros for the key as ShaderMacroHelper.
+    ShaderMacroHelper GetMacroHelper(ShaderPermutationKey Key) const;
+
+    /// Computes the key from the null-terminated array of macros, e.g. the one produced by ShaderMacroHelper.
+
+    /// Macros that are not declared by the schema are ignored. Fields that are not defined take their
+    /// minimum value. Boolean and integer definitions may have the 'u' suffix.
+    /// Returns false if a definition does not match any value of its field.
+    bool GetKey(const ShaderMacro* Macros, ShaderPermutationKey& Key) const;
+
+    /// Returns the field index by name, or ~0u if the schema does not declare the macro.
+    Uint32 GetFieldIndex(const Char* Name) const;
+
+    /// Returns the number of fields.
+    Uint32 GetNumFields() const
+    {
+        return static_cast<Uint32>(m_Fields.size());
+    }
+
+    /// Returns the total number of key bits used by all fields.
+    Uint32 GetNumKeyBits() const
+    {
+        return m_NumKeyBits;
+    }
+
+    /// Returns the hash of the schema that includes field names, ranges and definitions.
+    const XXH128Hash& GetHash() const
+    {
+        return m_Hash;
+    }
+
+private:
+    enum FIELD_TYPE : Uint8
+    {
+        FIELD_TYPE_BOOL,
+        FIELD_TYPE_INT,
+        FIELD_TYPE_ENUM
+    };
+
+    struct Field
+    {
+        std::string              Name;
+        FIELD_TYPE               Type      = FIELD_TYPE_BOOL;
+        Int32                    MinValue  = 0;
+        Uint32                   NumValues = 0;
+        Uint32                   BitOffset = 0;
+        Uint32                   NumBits   = 0;
+        std::vector<std::string> Definitions;
+    };
+
+    Uint32 AddField(Field&& NewField) noexcept(false);
+
+    std::vector<Field>                      m_Fields;
+    std::unordered_map<std::string, Uint32> m_FieldIndices;
+
+    Uint32     m_NumKeyBits = 0;
+    XXH128Hash m_Hash;
+};
+
+} // namespace Diligent
+
+namespace std
+{
+
+template <>
+struct hash<Diligent::ShaderPermutationKey>
+{
+    size_t operator()(const Diligent::ShaderPermutationKey& Key) const
+    {
+        return hash<Diligent::Uint64>{}(Key.Bits);
+    }
+};
+
+} // namespace std
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Resolves shader resource variable names to locations once, so that resources can then be bound
+/// to any shader resource binding created from the same pipeline resource signature with a single
+/// IShaderResourceBinding::SetResources() call.
+///
+/// Usage:
+///
+///     ShaderResourceBindingLayout Layout;
+///     const auto DiffuseSlot = Layout.AddVariable(pSRB, SHADER_TYPE_PIXEL, "g_Diffuse");
+///     const auto NormalSlot  = Layout.AddVariable(pSRB, SHADER_TYPE_PIXEL, "g_Normal");
+///     ...
+///     IDeviceObject* Objects[2];
+///     Objects[DiffuseSlot] = pDiffuseSRV;
+///     Objects[NormalSlot]  = pNormalSRV;
+///     Layout.Bind(pMaterialSRB, Objects);
+class ShaderResourceBindingLayout
+{
+public:
+    static constexpr Uint32 InvalidSlot = ~0u;
+
+    /// Adds a mutable or dynamic variable to the layout.
+
+    /// \param [in] pSRB       - Any shader resource binding created from the signature the layout will be used with.
+    /// \param [in] ShaderType - Shader stage of the variable.
+    /// \param [in] Name       - Variable name.
+    /// \param [in] ArrayIndex - Array element.
+    ///
+    /// \return     Index of the object in the array passed to Bind(), or InvalidSlot if the variable is not found.
+    Uint32 AddVariable(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const Char* Name, Uint32 ArrayIndex = 0)
+    {
+        VERIFY_EXPR(pSRB != nullptr && Name != nullptr);
+        auto* pVar = pSRB->GetVariableByName(ShaderType, Name);
+        if (pVar == nullptr)
+            return InvalidSlot;
+
+        m_Locations.emplace_back(ShaderType, pVar->GetIndex(), ArrayIndex);
+        return static_cast<Uint32>(m_Locations.size() - 1);
+    }
+
+    /// Binds the objects to the variables of the layout.
+
+    /// \param [in] pSRB      - Shader resource binding to bind the objects to.
+    /// \param [in] ppObjects - Array of GetNumVariables() objects, in the order of the slots returned by AddVariable().
+    /// \param [in] Flags     - Flags, see Diligent::SET_SHADER_RESOURCE_FLAGS.
+    void Bind(IShaderResourceBinding* pSRB, IDeviceObject* const* ppObjects, SET_SHADER_RESOURCE_FLAGS Flags = SET_SHADER_RESOURCE_FLAG_NONE) const
+    {
+        VERIFY_EXPR(pSRB != nullptr);
+        pSRB->SetResources(m_Locations.data(), ppObjects, GetNumVariables(), Flags);
+    }
+
+    Uint32 GetNumVariables() const { return static_cast<Uint32>(m_Locations.size()); }
+
+    const ShaderResourceVariableLocation* GetLocations() const { return m_Locations.data(); }
+
+private:
+    std::vector<ShaderResourceVariableLocation> m_Locations;
+};
+
+} // namespace Diligent
@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Texture streaming queue create info.
+struct TextureStreamingQueueCreateInfo
+{
+    /// The maximum number of bytes that TextureStreamingQueue::Update() uploads in one call.
+    /// Zero means no limit.
+
+    /// \remarks    At least one request is always uploaded so that streaming makes progress.
+    Uint64 MaxBytesPerUpdate = 0;
+
+    /// The maximum number of copy commands that TextureStreamingQueue::Update() records in one call.
+    /// Zero means no limit.
+    Uint32 MaxCommandsPerUpdate = 0;
+};
+
+/// Prioritized texture streaming queue.
+
+/// Worker threads enqueue texture region uploads that are executed by the render thread
+/// in TextureStreamingQueue::Update() within the per-update byte and command budgets.
+/// Requests with higher priority are uploaded first. Among requests with the same priority,
+/// coarser mip levels are uploaded first so that the mip tail becomes resident before the
+/// detailed levels. Adjacent 2D regions of the same subresource are merged into a single
+/// copy command.
+///
+/// The queue may be used to stream tiles of sparse textures, provided that the application
+/// binds the memory to the tiles before the tiles are uploaded.
+class TextureStreamingQueue
+{
+public:
+    explicit TextureStreamingQueue(const TextureStreamingQueueCreateInfo& CI);
+
+    // clang-format off
+    TextureStreamingQueue           (const TextureStreamingQueue&) = delete;
+    TextureStreamingQueue& operator=(const TextureStreamingQueue&) = delete;
+    TextureStreamingQueue           (TextureStreamingQueue&&)      = delete;
+    TextureStreamingQueue& operator=(TextureStreamingQueue&&)      = delete;
+    // clang-format on
+
+    /// Request identifier. Zero is never used as a valid identifier.
+    using RequestId = Uint64;
+
+    /// Texture region upload request.
+    struct UploadRequest
+    {
+        /// Destination texture.
+        ITexture* pTexture = nullptr;
+
+        /// Destination mip level.
+        Uint32 MipLevel = 0;
+
+        /// Destination array slice.
+        Uint32 ArraySlice = 0;
+
+        /// Destination region. If the region is empty, the entire subresource is updated.
+        Box Region;
+
+        /// Source data. The data is copied by TextureStreamingQueue::Enqueue().
+        const void* pData = nullptr;
+
+        /// Source data row stride, in bytes.
+        Uint64 Stride = 0;
+
+        /// Source data depth stride, in bytes.
+        Uint64 DepthStride = 0;
+
+        /// Request priority. Requests with higher priority are uploaded first.
+        float Priority = 0;
+
+        /// Optional callback that is invoked by TextureStreamingQueue::Update()
+        /// after the copy command for the request has been recorded.
+        std::function<void()> OnUploaded;
+    };
+
+    /// Enqueues the upload request and returns its identifier.
+
+    /// \remarks    The method is thread-safe.
+    RequestId Enqueue(const UploadRequest& Request);
+
+    /// Cancels the request that has not been uploaded yet.
+
+    /// \return     true if the request has been removed from the queue, and false otherwise.
+    ///
+    /// \remarks    The method is thread-safe.
+    bool Cancel(RequestId Id);
+
+    /// Statistics of one TextureStreamingQueue::Update() call.
+    struct UpdateStats
+    {
+        /// The number of recorded copy commands.
+        Uint32 NumCommands = 0;
+
+        /// The number of uploaded requests.
+        Uint32 NumRequests = 0;
+
+        /// The number of uploaded bytes.
+        Uint64 NumBytes = 0;
+    };
+
+    /// Records copy commands for the pending requests within the budgets.
+
+    /// \remarks    The method must be called from the thread that owns the context.
+    UpdateStats Update(IDeviceContext* pContext);
+
+    /// Returns the number of pending requests.
+    size_t GetNumPendingRequests();
+
+    /// Returns the total size of the pending requests' data, in bytes.
+    Uint64 GetPendingBytes();
+
+private:
+    struct Request
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+
+        Uint32 MipLevel   = 0;
+        Uint32 ArraySlice = 0;
+        Box    Region;
+        float  Priority = 0;
+
+        // Region data packed with the minimal aligned strides
+        std::vector<Uint8> Data;
+        Uint64             Stride      = 0;
+        Uint64             DepthStride = 0;
+
+        std::function<void()> OnUploaded;
+    };
+
+    struct QueueKey
+    {
+        float     Priority;
+        Uint32    MipLevel;
+        RequestId Id;
+
+        bool operator<(const QueueKey& rhs) const
+        {
+            if (Priority != rhs.Priority)
+                return Priority > rhs.Priority;
+            if (MipLevel != rhs.MipLevel)
+                return MipLevel > rhs.MipLevel;
+            return Id < rhs.Id;
+        }
+    };
+
+    struct CopyCommand;
+
+    void RemoveRequest(RequestId Id);
+
+private:
+    const TextureStreamingQueueCreateInfo m_CI;
+
+    std::mutex m_Mtx;
+    RequestId  m_NextRequestId = 1;
+    Uint64     m_PendingBytes  = 0;
+
+    std::unordered_map<RequestId, Request> m_Requests;
+    std::set<QueueKey>                     m_Queue;
+
+    // Pending requests for every texture, used to find the regions that can be merged
+    std::unordered_map<const ITexture*, std::vector<RequestId>> m_TextureRequests;
+};
+
+} // namespace Diligent
@@ -66,6 +66,26 @@ public:
 /// Texture uploader description.
 struct TextureUploaderDesc
 {
+    /// Optional immediate context of a transfer or compute queue that will
+    /// execute the copy operations (Direct3D12 and Vulkan only).
+
+    /// \remarks   When the context is not null, staging textures are mapped and copied to the destination
+    ///            textures by this context. The context that calls ITextureUploader::RenderThreadUpdate() and
+    ///            ITextureUploader::ScheduleGPUCopy() is made to wait on the GPU for the copies to complete, so
+    ///            that streaming uploads overlap with rendering instead of being serialized with it.
+    ///
+    ///            The access to the copy context is not synchronized: it must only be used by the render thread.
+    ///            Destination textures must be created with ImmediateContextMask that includes both the
+    ///            copy context and the render context.
+    IDeviceContext* pCopyContext = nullptr;
+
+    /// The maximum number of bytes that ITextureUploader::RenderThreadUpdate() copies
+    /// from upload buffers to textures in one call (OpenGL only). Zero means no limit.
+
+    /// \remarks   Copies that do not fit into the budget are deferred to the next call,
+    ///            which bounds the time the render thread spends in the driver. At least
+    ///            one copy is always executed so that uploads make progress.
+    Uint64 MaxCopyBytesPerUpdate = 0;
 };
 
 
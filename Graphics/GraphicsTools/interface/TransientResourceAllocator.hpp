@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of TransientResourceAllocator class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Transient texture description.
+struct TransientTextureDesc
+{
+    /// Texture description.
+
+    /// \remarks    Desc.Usage must be USAGE_DEFAULT.
+    ///             Desc.Name must remain valid until Compile() returns.
+    TextureDesc Desc;
+
+    /// Index of the first pass that uses the texture.
+    Uint32 FirstPass = 0;
+
+    /// Index of the last pass that uses the texture.
+    Uint32 LastPass = 0;
+
+    /// The state the texture is transitioned to at the beginning of its lifetime,
+    /// see TransientResourceAllocator::BeginPass().
+
+    /// \remarks    If this value is RESOURCE_STATE_UNKNOWN, no transition is performed.
+    RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN;
+};
+
+/// Frame-graph-style transient texture allocator.
+
+/// An application declares the textures used by the frame together with the range of
+/// passes in which each texture is alive, and calls Compile(). The allocator then assigns
+/// every declared texture a physical texture so that textures with compatible descriptions
+/// and non-overlapping lifetimes share the same physical object. Physical textures are
+/// kept in a pool and are reused by subsequent frames.
+///
+/// \remarks    The allocator only aliases textures with identical descriptions (the name is ignored).
+///             When a physical texture starts a new lifetime, BeginPass() transitions it
+///             to the declared initial state with STATE_TRANSITION_FLAG_DISCARD_CONTENT, so the
+///             backend does not need to preserve the contents of the previous occupant.
+class TransientResourceAllocator
+{
+public:
+    static constexpr Uint32 InvalidHandle = ~0u;
+
+    /// Allocator statistics.
+    struct Statistics
+    {
+        /// The number of textures declared in the current frame.
+        Uint32 NumDeclaredTextures = 0;
+
+        /// The number of physical textures used by the current frame.
+        Uint32 NumPhysicalTextures = 0;
+
+        /// The number of physical textures created by the last Compile() call.
+        Uint32 NumCreatedTextures = 0;
+
+        /// The total memory size of all declared textures, in bytes.
+
+        /// \remarks    Memoryless textures (see Diligent::MISC_TEXTURE_FLAG_MEMORYLESS) are not counted.
+        Uint64 DeclaredMemorySize = 0;
+
+        /// The total memory size of the physical textures used by the current frame, in bytes.
+        Uint64 PhysicalMemorySize = 0;
+    };
+
+    explicit TransientResourceAllocator(IRenderDevice* pDevice);
+
+    // clang-format off
+    TransientResourceAllocator           (const TransientResourceAllocator&)  = delete;
+    TransientResourceAllocator& operator=(const TransientResourceAllocator&)  = delete;
+    TransientResourceAllocator           (      TransientResourceAllocator&&) = delete;
+    TransientResourceAllocator& operator=(      TransientResourceAllocator&&) = delete;
+    // clang-format on
+
+    /// Declares a transient texture for the current frame.
+
+    /// \param[in] Desc - Transient texture description, see Diligent::TransientTextureDesc.
+    /// \return           The handle of the texture that can be used to query the physical
+    ///                   texture after Compile() has been called, or InvalidHandle
+    ///                   if the description is invalid.
+    Uint32 DeclareTexture(const TransientTextureDesc& Desc);
+
+    /// Assigns physical textures to all textures declared in the current frame,
+    /// creating new physical textures if necessary.
+    void Compile();
+
+    /// Returns the physical texture assigned to the declared texture.
+
+    /// \remarks    The method must only be called after Compile().
+    ITexture* GetTexture(Uint32 Handle) const;
+
+    /// Transitions all textures whose lifetime starts at the given pass to their initial states.
+    void BeginPass(IDeviceContext* pContext, Uint32 Pass);
+
+    /// Clears all declarations. Physical textures remain in the pool and may be reused
+    /// by the next frame.
+    void Reset();
+
+    /// Releases all pooled physical textures that are not used by the current frame.
+    void ReleaseUnusedTextures();
+
+    /// Returns allocator statistics for the current frame.
+    const Statistics& GetStatistics() const
+    {
+        return m_Stats;
+    }
+
+private:
+    struct PhysicalTexture
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+
+        Uint64 MemorySize = 0;
+
+        // The last pass in the current frame that uses this texture, or InvalidHandle
+        // if the texture is not used by the current frame.
+        Uint32 LastPass = InvalidHandle;
+    };
+
+    struct DeclaredTexture
+    {
+        TransientTextureDesc Desc;
+
+        Uint32 PhysicalIdx = InvalidHandle;
+    };
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    std::vector<DeclaredTexture> m_Declared;
+    std::vector<PhysicalTexture> m_Physical;
+
+    std::vector<StateTransitionDesc> m_Barriers;
+
+    bool m_IsCompiled = false;
+
+    Statistics m_Stats;
+};
+
+} // namespace Diligent
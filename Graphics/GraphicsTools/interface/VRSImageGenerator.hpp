@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::VRSImageGenerator class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Generates a shading rate image from the previous frame on the GPU.
+
+/// Every texel of the shading rate image corresponds to a screen tile. The generator computes the
+/// largest luminance gradient of the previous frame within every tile, separately along the X and Y
+/// axes, and reduces the shading rate along the axes where the gradient is small:
+/// - the rate is reduced by 2 if the gradient is less than the contrast threshold;
+/// - the rate is reduced by 4 if three times the gradient is less than the threshold.
+///
+/// The luminance is compressed and gamma-corrected, so that the gradients approximate the perceived
+/// contrast. If motion vectors are provided, the previous frame is reprojected to the new frame, and
+/// the gradients of the tiles are divided by (1 + MotionSensitivity * Motion), where Motion is the
+/// smallest motion length, in pixels, within the tile: fast-moving content is blurred, so it can be
+/// shaded at a lower rate.
+///
+/// The image format depends on the device (see ShadingRateProperties::Format):
+/// - SHADING_RATE_FORMAT_PALETTE (Direct3D12, Vulkan fragment shading rate): R8_UINT texture
+///   with SHADING_RATE values. The rates are remapped to the closest rates supported by the device.
+/// - SHADING_RATE_FORMAT_UNORM8 (Vulkan fragment density map): RG8_UNORM texture with the
+///   fragment densities along the X and Y axes (1, 0.5 or 0.25).
+///
+/// \note   The device must support the VariableRateShading feature with the texture-based shading rate
+///         and compute shaders.
+class VRSImageGenerator
+{
+public:
+    struct CreateInfo
+    {
+        /// Render device that is used to create the pipelines and textures.
+        IRenderDevice* pDevice = nullptr;
+
+        /// The size of the screen tile that corresponds to one texel of the shading rate image.
+        /// If zero, ShadingRateProperties::MaxTileSize is used.
+        Uint32 TileSize = 0;
+
+        /// The sample count of the render targets that will be used with the shading rate image.
+        /// Only the shading rates supported for this sample count are written to the image.
+        Uint32 SampleCount = 1;
+    };
+    explicit VRSImageGenerator(const CreateInfo& CI);
+    ~VRSImageGenerator();
+
+    // clang-format off
+    VRSImageGenerator           (const VRSImageGenerator&) = delete;
+    VRSImageGenerator& operator=(const VRSImageGenerator&) = delete;
+    VRSImageGenerator           (VRSImageGenerator&&)      = delete;
+    VRSImageGenerator& operator=(VRSImageGenerator&&)      = delete;
+    // clang-format on
+
+    struct GenerateAttribs
+    {
+        /// Shader resource view of the previous frame color.
+        /// The size of the color texture defines the size of the frame.
+        ITextureView* pColorSRV = nullptr;
+
+        /// Optional shader resource view of the motion vectors. The RG channels contain
+        /// the screen-space motion of the pixel from the frame before the previous one.
+        ITextureView* pMotionVectorsSRV = nullptr;
+
+        /// The scale that converts the motion vectors to pixels, e.g. the frame size for the
+        /// motion vectors in texture coordinates.
+        float2 MotionVectorScale = float2{1, 1};
+
+        /// Luminance contrast threshold. Higher values reduce the shading rate in more tiles,
+        /// which improves performance at the cost of quality.
+        float ContrastThreshold = 0.05f;
+
+        /// How much the motion reduces the gradients. Zero disables the motion-based reduction.
+        float MotionSensitivity = 0.1f;
+    };
+
+    /// Records the commands that generate the shading rate image.
+    /// The image is recreated when the frame size changes.
+    void Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs);
+
+    /// Returns the shading rate image, or null if Generate() has not been called yet.
+    ITexture* GetTexture() const { return m_pTexture.RawPtr<ITexture>(); }
+
+    /// Returns the shading rate view of the image that can be used with SetRenderTargetsExt()
+    /// or as a shading rate attachment of a render pass.
+    ITextureView* GetShadingRateView() const { return m_pTexture ? m_pTexture.RawPtr<ITexture>()->GetDefaultView(TEXTURE_VIEW_SHADING_RATE) : nullptr; }
+
+    Uint32 GetTileSize() const { return m_TileSize; }
+
+private:
+    void CreatePipelines();
+    void CreateTextures(Uint32 FrameWidth, Uint32 FrameHeight);
+
+    enum PSO_INDEX : Uint32
+    {
+        PSO_INDEX_COLOR = 0,
+        PSO_INDEX_COLOR_AND_MOTION,
+        PSO_INDEX_COUNT
+    };
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint32 m_TileSize;
+    const bool   m_UseDensityMap;
+
+    // Supported shading rates, indexed by SHADING_RATE
+    Uint32 m_RateRemap[12] = {};
+
+    // Whether the image is written through an intermediate texture because
+    // the device does not allow unordered access to shading rate textures.
+    bool m_UseIntermediateTexture = false;
+
+    Uint32 m_FrameWidth  = 0;
+    Uint32 m_FrameHeight = 0;
+
+    RefCntAutoPtr<IPipelineState>         m_pPSO[PSO_INDEX_COUNT];
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB[PSO_INDEX_COUNT];
+
+    RefCntAutoPtr<IBuffer>  m_pAttribsCB;
+    RefCntAutoPtr<ITexture> m_pTexture;
+    RefCntAutoPtr<ITexture> m_pIntermediateTexture;
+};
+
+} // namespace Diligent
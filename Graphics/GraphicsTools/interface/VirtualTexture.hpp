@@ -0,0 +1,240 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/DeviceMemory.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+#include "GPUReadbackQueue.hpp"
+#include "TextureStreamingQueue.hpp"
+
+namespace Diligent
+{
+
+/// Virtual texture create info.
+struct VirtualTextureCreateInfo
+{
+    /// Texture name.
+    const char* Name = nullptr;
+
+    /// Texture width.
+    Uint32 Width = 0;
+
+    /// Texture height.
+    Uint32 Height = 0;
+
+    /// The number of mip levels. Zero means the full mip chain.
+    Uint32 MipLevels = 0;
+
+    /// Texture format.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// The number of physical pages (sparse memory blocks) in the pool.
+    /// This is the fixed video memory budget of the texture. The pool must be
+    /// large enough to keep the mip tail resident.
+    Uint32 NumPhysicalPages = 0;
+
+    /// The number of entries in the feedback buffer.
+    Uint32 FeedbackBufferSize = 4096;
+
+    /// An optional immediate context of the queue that supports sparse binding.
+    /// If null, the context passed to VirtualTexture::Update() is used.
+    IDeviceContext* pSparseBindingContext = nullptr;
+
+    /// An optional thread pool to load the tiles on.
+    /// If null, tiles are loaded by VirtualTexture::Update().
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Tile loader.
+
+    /// The loader is called with the mip level and the region of the tile, and must
+    /// write the tile data to pData using the specified row stride.
+    /// If a thread pool is provided, the loader is called from worker threads.
+    std::function<void(Uint32 MipLevel, const Box& Region, void* pData, Uint64 Stride)> LoadTile;
+
+    /// Tile upload budgets, see Diligent::TextureStreamingQueueCreateInfo.
+    TextureStreamingQueueCreateInfo Streaming;
+};
+
+
+/// Virtual texture statistics.
+struct VirtualTextureStats
+{
+    /// The number of tiles that are resident in the physical page pool.
+    Uint32 NumResidentTiles = 0;
+
+    /// The number of tiles that are being loaded or uploaded.
+    Uint32 NumLoadingTiles = 0;
+
+    /// The number of free physical pages.
+    Uint32 NumFreePages = 0;
+
+    /// The total number of evicted tiles.
+    Uint64 NumEvictions = 0;
+};
+
+
+/// Virtual texture that keeps the tiles requested by the GPU resident in a fixed pool of physical pages.
+
+/// The texture is a sparse texture whose tiles are backed by pages of a single device memory object.
+/// Shaders that sample the texture write the tiles they need to the feedback buffer (see GetFeedbackBuffer()).
+/// Every entry of the feedback buffer is either zero or the value returned by PackFeedback(). Shaders may
+/// write the entries to any location, e.g. hashed by the pixel position:
+///
+///     RWStructuredBuffer<uint> g_Feedback;
+///     uint PackFeedback(uint Mip, uint2 Tile) { return 0x80000000u | (Mip << 26u) | (Tile.y << 13u) | Tile.x; }
+///
+/// VirtualTexture::Update() asynchronously reads the feedback back, binds the physical pages to the
+/// requested tiles, evicting the least recently used tiles when the pool is full, and streams the tile
+/// data produced by the loader. The residency texture (see GetResidencyTexture()) contains one R8_UINT
+/// texel per mip level 0 tile, which is the finest resident mip level in that tile. Shaders should
+/// clamp the sampled LOD with it.
+class VirtualTexture
+{
+public:
+    VirtualTexture(IRenderDevice* pDevice, const VirtualTextureCreateInfo& CI);
+    ~VirtualTexture();
+
+    // clang-format off
+    VirtualTexture           (const VirtualTexture&) = delete;
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+    VirtualTexture           (VirtualTexture&&)      = delete;
+    VirtualTexture& operator=(VirtualTexture&&)      = delete;
+    // clang-format on
+
+    static constexpr Uint32 PackFeedback(Uint32 MipLevel, Uint32 TileX, Uint32 TileY)
+    {
+        return 0x80000000u | (MipLevel << 26u) | (TileY << 13u) | TileX;
+    }
+
+    /// Processes the feedback, binds and evicts tiles, and uploads the loaded tiles.
+    /// This method should be called once per frame after the feedback has been written.
+    void Update(IDeviceContext* pContext);
+
+    /// Returns the sparse texture.
+    ITexture* GetTexture() const { return m_pTexture.RawPtr<ITexture>(); }
+
+    /// Returns the residency texture.
+    ITexture* GetResidencyTexture() const { return m_pResidencyTex.RawPtr<ITexture>(); }
+
+    /// Returns the feedback buffer.
+    IBuffer* GetFeedbackBuffer() const { return m_pFeedbackBuffer.RawPtr<IBuffer>(); }
+
+    /// Returns the tile size in texels.
+    Uint32 GetTileWidth() const { return m_TileWidth; }
+    Uint32 GetTileHeight() const { return m_TileHeight; }
+
+    /// Returns virtual texture statistics.
+    VirtualTextureStats GetStats();
+
+private:
+    struct Tile
+    {
+        enum class State
+        {
+            Loading,
+            Resident
+        };
+        State  TileState    = State::Loading;
+        Uint32 Page         = 0;
+        Uint64 LastUseFrame = 0;
+
+        std::list<Uint32>::iterator LRUPos;
+    };
+
+    static constexpr Uint32 UnpackMip(Uint32 Key) { return (Key >> 26u) & 0x1Fu; }
+    static constexpr Uint32 UnpackTileX(Uint32 Key) { return Key & 0x1FFFu; }
+    static constexpr Uint32 UnpackTileY(Uint32 Key) { return (Key >> 13u) & 0x1FFFu; }
+
+    Box  GetTileRegion(Uint32 Key) const;
+    bool IsValidTile(Uint32 Key) const;
+
+    void InitMipTail();
+    void ProcessRequests();
+    void EvictTile(Uint32 Key);
+    void LoadTile(Uint32 MipLevel, const Box& Region, Uint32 Key);
+    void OnTileUploaded(Uint32 Key);
+    bool IsResident(Uint32 Key) const;
+    void UpdateResidency(Uint32 Key);
+    void BindPages(IDeviceContext* pContext);
+
+private:
+    const VirtualTextureCreateInfo m_CI;
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<ITexture>      m_pTexture;
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
+    RefCntAutoPtr<ITexture>      m_pResidencyTex;
+    RefCntAutoPtr<IBuffer>       m_pFeedbackBuffer;
+    RefCntAutoPtr<IFence>        m_pRenderFence;
+    RefCntAutoPtr<IFence>        m_pBindFence;
+
+    Uint32 m_TileWidth      = 0;
+    Uint32 m_TileHeight     = 0;
+    Uint32 m_FirstMipInTail = 0;
+    Uint64 m_PageSize       = 0;
+
+    Uint64 m_FrameId        = 0;
+    Uint64 m_RenderFenceVal = 0;
+    Uint64 m_BindFenceVal   = 0;
+    bool   m_MipTailLoaded  = false;
+
+    GPUReadbackQueue      m_FeedbackReadback;
+    TextureStreamingQueue m_StreamingQueue;
+
+    std::vector<Uint32> m_ZeroFeedback;
+
+    // Tiles requested by the GPU feedback
+    std::vector<Uint32> m_RequestedTiles;
+
+    std::unordered_map<Uint32, Tile> m_Tiles;
+    // Resident tiles, most recently used first
+    std::list<Uint32>   m_LRU;
+    std::vector<Uint32> m_FreePages;
+
+    std::vector<SparseTextureMemoryBindRange> m_PendingBinds;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_LoadTasks;
+
+    // Finest resident mip level for every mip level 0 tile
+    std::vector<Uint8> m_Residency;
+    Uint32             m_ResidencyWidth  = 0;
+    Uint32             m_ResidencyHeight = 0;
+    Box                m_DirtyResidency;
+
+    Uint64 m_NumEvictions = 0;
+};
+
+} // namespace Diligent
@@ -38,6 +38,8 @@ struct XXH3_state_s;
 namespace Diligent
 {
 
+class ShaderIncludeCache;
+
 struct XXH128Hash
 {
     Uint64 LowPart  = {};
@@ -123,6 +125,9 @@ struct XXH128State final
 
     void Update(const ShaderCreateInfo& ShaderCI) noexcept;
 
+    /// Same as Update(ShaderCI), but reads shader source files through the include cache.
+    void Update(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache& IncludeCache) noexcept;
+
     template <typename T>
     typename std::enable_if<(std::is_same<typename std::remove_cv<T>::type, SamplerDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, StencilOpDesc>::value ||
@@ -165,6 +170,9 @@ struct XXH128State final
 
     XXH128Hash Digest() noexcept;
 
+private:
+    void UpdateShaderCreateInfo(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache) noexcept;
+
 private:
     XXH3_state_s* m_State = nullptr;
 };
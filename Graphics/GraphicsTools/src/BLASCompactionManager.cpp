@@ -0,0 +1,215 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BLASCompactionManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+BLASCompactionManager::BLASCompactionManager(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_MaxRecycledBuffers{CI.MaxRecycledBuffers},
+    m_SizeReadback{GPUReadbackQueue::CreateInfo{CI.pDevice}}
+{
+    DEV_CHECK_ERR(m_pDevice, "Device must not be null");
+}
+
+BLASCompactionManager::~BLASCompactionManager()
+{
+    DEV_CHECK_ERR(m_PendingBatches.empty(), "The compaction manager is destroyed while ", GetNumPendingBLASes(),
+                  " BLASes are not compacted. Call Flush() before destroying the manager.");
+}
+
+size_t BLASCompactionManager::GetNumPendingBLASes() const
+{
+    size_t NumBLASes = 0;
+    for (const auto& pBatch : m_PendingBatches)
+        NumBLASes += pBatch->BLASes.size();
+    return NumBLASes;
+}
+
+RefCntAutoPtr<IBuffer> BLASCompactionManager::GetSizeBuffer(Uint64 Size)
+{
+    // Round the size up to the power of two so that the buffers can be reused
+    // by batches of similar sizes.
+    constexpr Uint64 MinSizeBufferSize = 256;
+
+    Uint64 BufferSize = MinSizeBufferSize;
+    while (BufferSize < Size)
+        BufferSize *= 2;
+
+    for (auto it = m_RecycledBuffers.begin(); it != m_RecycledBuffers.end(); ++it)
+    {
+        if ((*it)->GetDesc().Size == BufferSize)
+        {
+            auto pBuffer = std::move(*it);
+            m_RecycledBuffers.erase(it);
+            return pBuffer;
+        }
+    }
+
+    BufferDesc Desc;
+    Desc.Name = "BLAS compacted size buffer";
+    Desc.Size = BufferSize;
+    // Direct3D12 writes the compacted sizes through UAV
+    Desc.BindFlags = BIND_UNORDERED_ACCESS;
+    Desc.Mode      = BUFFER_MODE_RAW;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    DEV_CHECK_ERR(pBuffer, "Failed to create compacted size buffer");
+    return pBuffer;
+}
+
+void BLASCompactionManager::Enqueue(IDeviceContext*        pContext,
+                                    IBottomLevelAS* const* ppBLASes,
+                                    Uint32                 NumBLASes,
+                                    CallbackType           Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    DEV_CHECK_ERR(NumBLASes == 0 || ppBLASes != nullptr, "ppBLASes must not be null");
+    DEV_CHECK_ERR(Callback, "Callback must not be null");
+    if (NumBLASes == 0)
+        return;
+
+    std::unique_ptr<Batch> pBatch{new Batch{}};
+    pBatch->Callback    = std::move(Callback);
+    pBatch->pSizeBuffer = GetSizeBuffer(Uint64{NumBLASes} * sizeof(Uint64));
+    if (!pBatch->pSizeBuffer)
+        return;
+
+    pBatch->BLASes.reserve(NumBLASes);
+    pBatch->CompactedSizes.resize(NumBLASes);
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        DEV_CHECK_ERR(ppBLASes[i] != nullptr, "BLAS ", i, " is null");
+        DEV_CHECK_ERR((ppBLASes[i]->GetDesc().Flags & RAYTRACING_BUILD_AS_ALLOW_COMPACTION) != 0,
+                      "BLAS '", ppBLASes[i]->GetDesc().Name, "' was not created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag");
+        pBatch->BLASes.emplace_back(ppBLASes[i]);
+
+        WriteBLASCompactedSizeAttribs Attribs{
+            ppBLASes[i],
+            pBatch->pSizeBuffer,
+            Uint64{i} * sizeof(Uint64),
+            RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+            RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+        };
+        pContext->WriteBLASCompactedSize(Attribs);
+    }
+
+    // The batch is owned by m_PendingBatches, so the pointer stays valid until the callback is invoked.
+    Batch* pB = pBatch.get();
+    m_SizeReadback.ReadBuffer(pContext, pBatch->pSizeBuffer, 0, Uint64{NumBLASes} * sizeof(Uint64),
+                              [pB](const GPUReadbackQueue::ReadbackData& Data) {
+                                  if (Data.pData != nullptr)
+                                  {
+                                      const size_t Size = std::min(static_cast<size_t>(Data.DataSize), pB->CompactedSizes.size() * sizeof(Uint64));
+                                      memcpy(pB->CompactedSizes.data(), Data.pData, Size);
+                                  }
+                                  pB->SizesReady = true;
+                              });
+    m_PendingBatches.emplace_back(std::move(pBatch));
+}
+
+void BLASCompactionManager::Compact(IDeviceContext* pContext, Batch& B)
+{
+    for (size_t i = 0; i < B.BLASes.size(); ++i)
+    {
+        IBottomLevelAS* pBLAS         = B.BLASes[i];
+        const Uint64    CompactedSize = B.CompactedSizes[i];
+        const auto&     SrcDesc       = pBLAS->GetDesc();
+
+        RefCntAutoPtr<IBottomLevelAS> pCompacted;
+        if (CompactedSize != 0)
+        {
+            const std::string Name = SrcDesc.Name != nullptr ? std::string{SrcDesc.Name} + " (compacted)" : std::string{"Compacted BLAS"};
+
+            BottomLevelASDesc Desc;
+            Desc.Name                 = Name.c_str();
+            Desc.CompactedSize        = CompactedSize;
+            Desc.ImmediateContextMask = SrcDesc.ImmediateContextMask;
+            m_pDevice->CreateBLAS(Desc, &pCompacted);
+        }
+
+        if (pCompacted)
+        {
+            CopyBLASAttribs CopyAttribs;
+            CopyAttribs.pSrc              = pBLAS;
+            CopyAttribs.pDst              = pCompacted;
+            CopyAttribs.Mode              = COPY_AS_MODE_COMPACT;
+            CopyAttribs.SrcTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            CopyAttribs.DstTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            pContext->CopyBLAS(CopyAttribs);
+
+            ++m_Stats.NumCompacted;
+            m_Stats.CompactedSize += CompactedSize;
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Failed to compact BLAS '", (SrcDesc.Name != nullptr ? SrcDesc.Name : ""), "'");
+            ++m_Stats.NumFailed;
+        }
+
+        B.Callback(pBLAS, pCompacted);
+    }
+
+    if (m_RecycledBuffers.size() >= m_MaxRecycledBuffers && !m_RecycledBuffers.empty())
+        m_RecycledBuffers.erase(m_RecycledBuffers.begin());
+    if (m_MaxRecycledBuffers > 0)
+        m_RecycledBuffers.emplace_back(std::move(B.pSizeBuffer));
+}
+
+void BLASCompactionManager::Process(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+    // Readback callbacks are invoked on this thread and mark the batches whose sizes are available
+    m_SizeReadback.Process(pContext);
+
+    // Readbacks complete in submission order
+    while (!m_PendingBatches.empty() && m_PendingBatches.front()->SizesReady)
+    {
+        std::unique_ptr<Batch> pBatch = std::move(m_PendingBatches.front());
+        m_PendingBatches.pop_front();
+        Compact(pContext, *pBatch);
+    }
+}
+
+void BLASCompactionManager::Flush(IDeviceContext* pContext)
+{
+    m_SizeReadback.Flush(pContext);
+    Process(pContext);
+    VERIFY(m_PendingBatches.empty(), "All batches are expected to be compacted after the readback queue has been flushed");
+}
+
+} // namespace Diligent
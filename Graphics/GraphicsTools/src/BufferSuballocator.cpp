@@ -29,6 +29,10 @@
 
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -38,6 +42,7 @@
 #include "Align.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -52,19 +57,40 @@ public:
                             BufferSuballocatorImpl*                      pParentAllocator,
                             Uint32                                       Offset,
                             Uint32                                       Size,
+                            Uint32                                       Alignment,
                             VariableSizeAllocationsManager::Allocation&& Subregion) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
         VERIFY_EXPR(m_Subregion.IsValid());
     }
 
+    BufferSuballocationImpl(IReferenceCounters*     pRefCounters,
+                            BufferSuballocatorImpl* pParentAllocator,
+                            Uint32                  Offset,
+                            Uint32                  Size,
+                            Uint32                  BinIndex,
+                            Uint32                  BinBlock) :
+        // clang-format off
+        TBase             {pRefCounters},
+        m_pParentAllocator{pParentAllocator},
+        m_BinIndex        {BinIndex},
+        m_BinBlock        {BinBlock},
+        m_Offset          {Offset},
+        m_Size            {Size},
+        m_Alignment       {0}
+    // clang-format on
+    {
+        VERIFY_EXPR(m_pParentAllocator);
+    }
+
     ~BufferSuballocationImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BufferSuballocation, TBase)
@@ -83,7 +109,7 @@ public:
 
     virtual Uint32 GetOffset() const override final
     {
-        return m_Offset;
+        return m_Offset.load();
     }
 
     virtual Uint32 GetSize() const override final
@@ -103,13 +129,41 @@ public:
         return m_pUserData.RawPtr<IObject>();
     }
 
+    // The methods below are called by the parent allocator while its mutex is locked.
+
+    const VariableSizeAllocationsManager::Allocation& GetSubregion() const
+    {
+        return m_Subregion;
+    }
+
+    Uint32 GetAlignment() const
+    {
+        return m_Alignment;
+    }
+
+    // Moves the suballocation to the new subregion and returns the old one
+    VariableSizeAllocationsManager::Allocation Relocate(VariableSizeAllocationsManager::Allocation&& NewSubregion, Uint32 NewOffset)
+    {
+        VERIFY_EXPR(m_Subregion.IsValid() && NewSubregion.IsValid());
+        std::swap(m_Subregion, NewSubregion);
+        m_Offset.store(NewOffset);
+        return std::move(NewSubregion);
+    }
+
 private:
     RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
 
+    // Subregion of the general allocator; invalid if the suballocation is served by a size-class bin
     VariableSizeAllocationsManager::Allocation m_Subregion;
 
-    const Uint32 m_Offset;
-    const Uint32 m_Size;
+    // Size-class bin and the block index in the bin
+    const Uint32 m_BinIndex = ~0u;
+    const Uint32 m_BinBlock = ~0u;
+
+    // The offset changes when the suballocation is moved by IBufferSuballocator::Defragment()
+    std::atomic<Uint32> m_Offset;
+    const Uint32        m_Size;
+    const Uint32        m_Alignment;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -147,11 +201,35 @@ public:
             CreateInfo.SuballocationObjAllocationGranularity
         }
     // clang-format on
-    {}
+    {
+        if (CreateInfo.MaxBinnedAllocationSize != 0)
+        {
+            if (CreateInfo.MaxBinnedAllocationSize > (MinBinBlockSize << (BufferSuballocatorMaxBinCount - 1)))
+            {
+                LOG_ERROR_AND_THROW("Max binned allocation size (", CreateInfo.MaxBinnedAllocationSize, ") exceeds the maximum allowed value (",
+                                    MinBinBlockSize << (BufferSuballocatorMaxBinCount - 1), ")");
+            }
+
+            const Uint32 BinCount = GetBinIndex(CreateInfo.MaxBinnedAllocationSize) + 1;
+            m_Bins.reserve(BinCount);
+            for (Uint32 BinIdx = 0; BinIdx < BinCount; ++BinIdx)
+            {
+                const Uint32 BlockSize = MinBinBlockSize << BinIdx;
+                m_Bins.emplace_back(new SizeClassBin{BlockSize, std::max(CreateInfo.BinChunkSize / BlockSize, 1u)});
+            }
+        }
+    }
 
     ~BufferSuballocatorImpl()
     {
         VERIFY_EXPR(m_AllocationCount.load() == 0);
+
+        // Return the chunks to the manager that verifies that all space is free in debug mode
+        for (auto& pBin : m_Bins)
+        {
+            for (Uint32 ChunkIdx = 0; ChunkIdx < pBin->NumChunks.load(); ++ChunkIdx)
+                m_Mgr.Free(std::move(pBin->Chunks[ChunkIdx]->Region));
+        }
     }
 
     virtual IBuffer* GetBuffer(IRenderDevice* pDevice, IDeviceContext* pContext) override final
@@ -185,67 +263,187 @@ public:
             return;
         }
 
-        VariableSizeAllocationsManager::Allocation Subregion;
+        if (!m_Bins.empty() && std::max(Size, Alignment) <= m_Bins.back()->BlockSize)
         {
-            std::lock_guard<std::mutex> Lock{m_MgrMtx};
-
+            const Uint32 BinIdx = GetBinIndex(std::max(Size, Alignment));
+            Uint32       Block  = 0;
+            if (AllocateBinBlock(*m_Bins[BinIdx], Block))
             {
-                // After the resize, the actual buffer size may be larger due to alignment
-                // requirements (for sparse buffers, the size is aligned by the memory page size).
-                const auto BufferSize = m_BufferSize.load();
-                const auto MgrSize    = m_Mgr.GetMaxSize();
-                if (BufferSize > MgrSize)
-                {
-                    m_Mgr.Extend(StaticCast<size_t>(BufferSize - MgrSize));
-                    VERIFY_EXPR(m_Mgr.GetMaxSize() == BufferSize);
-                    m_MgrSize.store(m_Mgr.GetMaxSize());
-                }
+                // clang-format off
+                BufferSuballocationImpl* pSuballocation{
+                    NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+                    (
+                        this,
+                        m_Bins[BinIdx]->GetBlockOffset(Block),
+                        Size,
+                        BinIdx,
+                        Block
+                    )
+                };
+                // clang-format on
+
+                pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
+                m_AllocationCount.fetch_add(1);
+                return;
             }
+            // The bin has reached the maximum number of chunks - use the general allocator
+        }
 
-            Subregion = m_Mgr.Allocate(Size, Alignment);
-
-            while (!Subregion.IsValid())
-            {
-                auto ExtraSize = m_ExpansionSize != 0 ?
-                    std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
-                    m_Mgr.GetMaxSize();
-
-                m_Mgr.Extend(ExtraSize);
-                m_MgrSize.store(m_Mgr.GetMaxSize());
-
-                Subregion = m_Mgr.Allocate(Size, Alignment);
-            }
+        BufferSuballocationImpl* pSuballocation = nullptr;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
 
+            auto Subregion = AllocateSubregion(Size, Alignment);
             UpdateUsageStats();
-        }
 
-        // clang-format off
-        BufferSuballocationImpl* pSuballocation{
-            NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+            // clang-format off
+            pSuballocation = NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
             (
                 this,
                 AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
                 Size,
+                Alignment,
                 std::move(Subregion)
-            )
-        };
-        // clang-format on
+            );
+            // clang-format on
+
+            // Suballocations that may be moved by Defragment()
+            m_MovableSuballocations.insert(pSuballocation);
+        }
 
         pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
         m_AllocationCount.fetch_add(1);
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Subregion)
+    void Free(BufferSuballocationImpl* pSuballocation, VariableSizeAllocationsManager::Allocation&& Subregion)
     {
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
+        m_MovableSuballocations.erase(pSuballocation);
         m_Mgr.Free(std::move(Subregion));
         m_AllocationCount.fetch_add(-1);
         UpdateUsageStats();
     }
 
+    void FreeBinBlock(Uint32 BinIdx, Uint32 Block)
+    {
+        auto& Bin = *m_Bins[BinIdx];
+        Bin.PushFreeBlocks(Block, Block);
+        Bin.AllocationCount.fetch_add(-1);
+        m_AllocationCount.fetch_add(-1);
+    }
+
     virtual Uint32 GetVersion() const override final
     {
-        return m_Buffer.GetVersion();
+        return m_Buffer.GetVersion() + m_DefragmentationCount.load();
+    }
+
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) override final
+    {
+        DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr, "Device and context must not be null");
+
+        // Make sure that the buffer covers all the space of the allocations manager
+        IBuffer* pBuffer = GetBuffer(pDevice, pContext);
+        if (pBuffer == nullptr)
+            return 0;
+
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+        // Suballocations are moved from the end of the buffer
+        std::vector<BufferSuballocationImpl*> Suballocations{m_MovableSuballocations.begin(), m_MovableSuballocations.end()};
+        std::sort(Suballocations.begin(), Suballocations.end(),
+                  [](const BufferSuballocationImpl* lhs, const BufferSuballocationImpl* rhs) {
+                      return lhs->GetSubregion().UnalignedOffset > rhs->GetSubregion().UnalignedOffset;
+                  });
+
+        struct MoveInfo
+        {
+            Uint32 SrcOffset;
+            Uint32 DstOffset;
+            Uint32 Size;
+            Uint32 ScratchOffset;
+        };
+        std::vector<MoveInfo> Moves;
+
+        // The buffer may have been expanded by another thread after it was resized above
+        const auto BufferSize = m_BufferSize.load();
+
+        // Scratch buffer offsets are aligned to make copies efficient on all backends
+        constexpr Uint32 ScratchAlignment = 16;
+
+        Uint64 MovedBytes  = 0;
+        Uint32 ScratchSize = 0;
+        for (auto* pSuballocation : Suballocations)
+        {
+            const auto& OldSubregion = pSuballocation->GetSubregion();
+            const auto  Size         = pSuballocation->GetSize();
+            if (MovedBytes + Size > MaxBytesToMove)
+                break;
+
+            auto NewSubregion = m_Mgr.AllocateLowest(pSuballocation->GetSize(), pSuballocation->GetAlignment(), OldSubregion.UnalignedOffset);
+            if (!NewSubregion.IsValid())
+                continue;
+
+            if (NewSubregion.UnalignedOffset + NewSubregion.Size > BufferSize)
+            {
+                m_Mgr.Free(std::move(NewSubregion));
+                continue;
+            }
+
+            const auto SrcOffset = pSuballocation->GetOffset();
+            const auto DstOffset = AlignUp(static_cast<Uint32>(NewSubregion.UnalignedOffset), pSuballocation->GetAlignment());
+
+            ScratchSize = AlignUp(ScratchSize, ScratchAlignment);
+            Moves.push_back({SrcOffset, DstOffset, Size, ScratchSize});
+            ScratchSize += Size;
+            MovedBytes += Size;
+
+            // The old subregion can be reused right away as copy commands recorded before
+            // any new data is written to it are executed first.
+            m_Mgr.Free(pSuballocation->Relocate(std::move(NewSubregion), DstOffset));
+        }
+
+        if (Moves.empty())
+            return 0;
+
+        // The data is copied through a scratch buffer as not all backends allow copies
+        // between regions of the same buffer.
+        if (!m_pScratchBuffer || m_pScratchBuffer->GetDesc().Size < ScratchSize)
+        {
+            m_pScratchBuffer.Release();
+
+            std::string Name = "Defragmentation scratch buffer for '";
+            Name += m_Buffer.GetDesc().Name != nullptr ? m_Buffer.GetDesc().Name : "<unnamed>";
+            Name += "'";
+
+            BufferDesc ScratchDesc;
+            ScratchDesc.Name  = Name.c_str();
+            ScratchDesc.Size  = ScratchSize;
+            ScratchDesc.Usage = USAGE_DEFAULT;
+            pDevice->CreateBuffer(ScratchDesc, nullptr, &m_pScratchBuffer);
+            if (!m_pScratchBuffer)
+            {
+                UNEXPECTED("Failed to create defragmentation scratch buffer. Suballocation data is lost.");
+            }
+        }
+
+        if (m_pScratchBuffer)
+        {
+            for (const auto& Move : Moves)
+            {
+                pContext->CopyBuffer(pBuffer, Move.SrcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     m_pScratchBuffer, Move.ScratchOffset, Move.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+            for (const auto& Move : Moves)
+            {
+                pContext->CopyBuffer(m_pScratchBuffer, Move.ScratchOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     pBuffer, Move.DstOffset, Move.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+        }
+
+        UpdateUsageStats();
+        m_DefragmentationCount.fetch_add(1);
+
+        return MovedBytes;
     }
 
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) override final
@@ -255,9 +453,176 @@ public:
         UsageStats.UsedSize         = m_UsedSize.load();
         UsageStats.MaxFreeChunkSize = m_MaxFreeBlockSize.load();
         UsageStats.AllocationCount  = m_AllocationCount.load();
+
+        UsageStats.BinCount = static_cast<Uint32>(m_Bins.size());
+        for (size_t BinIdx = 0; BinIdx < m_Bins.size(); ++BinIdx)
+        {
+            const auto& Bin      = *m_Bins[BinIdx];
+            auto&       BinStats = UsageStats.Bins[BinIdx];
+
+            BinStats.BlockSize       = Bin.BlockSize;
+            BinStats.AllocationCount = Bin.AllocationCount.load();
+            BinStats.ReservedSize    = Uint64{Bin.NumChunks.load()} * Bin.BlocksPerChunk * Bin.BlockSize;
+        }
     }
 
 private:
+    // Size-class bin that serves allocations of up to BlockSize bytes from a lock-free
+    // list of free blocks. The bin takes memory from the general allocator in chunks
+    // of BlocksPerChunk blocks, and never returns it.
+    struct SizeClassBin
+    {
+        // The maximum number of chunks in a bin. The chunk array is allocated upfront so that
+        // it is never reallocated while other threads access it without the lock.
+        static constexpr Uint32 MaxChunks = 256;
+
+        struct Chunk
+        {
+            VariableSizeAllocationsManager::Allocation Region;
+
+            Uint32 Offset = 0;
+
+            // For every free block, index + 1 of the next block in the free list, or 0 for the list end.
+            std::unique_ptr<std::atomic<Uint32>[]> NextFreeBlock;
+        };
+
+        SizeClassBin(Uint32 _BlockSize, Uint32 _BlocksPerChunk) :
+            BlockSize{_BlockSize},
+            BlocksPerChunk{_BlocksPerChunk},
+            Chunks{new std::unique_ptr<Chunk>[MaxChunks]}
+        {}
+
+        std::atomic<Uint32>& GetNextFreeBlock(Uint32 Block) const
+        {
+            return Chunks[Block / BlocksPerChunk]->NextFreeBlock[Block % BlocksPerChunk];
+        }
+
+        Uint32 GetBlockOffset(Uint32 Block) const
+        {
+            return Chunks[Block / BlocksPerChunk]->Offset + (Block % BlocksPerChunk) * BlockSize;
+        }
+
+        bool PopFreeBlock(Uint32& Block)
+        {
+            auto Head = FreeListHead.load(std::memory_order_acquire);
+            while (static_cast<Uint32>(Head) != 0)
+            {
+                const Uint32 First = static_cast<Uint32>(Head) - 1;
+                // The block may be popped by another thread at the same time, in which case
+                // the tag will not match and the exchange will fail.
+                const Uint64 NewHead = (((Head >> 32) + 1) << 32) | GetNextFreeBlock(First).load(std::memory_order_relaxed);
+                if (FreeListHead.compare_exchange_weak(Head, NewHead, std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    Block = First;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Pushes the chain of blocks First -> ... -> Last to the free list
+        void PushFreeBlocks(Uint32 First, Uint32 Last)
+        {
+            auto Head = FreeListHead.load(std::memory_order_relaxed);
+            Uint64 NewHead = 0;
+            do
+            {
+                GetNextFreeBlock(Last).store(static_cast<Uint32>(Head), std::memory_order_relaxed);
+                NewHead = (((Head >> 32) + 1) << 32) | (First + 1);
+            } while (!FreeListHead.compare_exchange_weak(Head, NewHead, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        const Uint32 BlockSize;
+        const Uint32 BlocksPerChunk;
+
+        // The upper 32 bits contain the tag that is incremented by every update to prevent
+        // the ABA problem, the lower 32 bits contain index + 1 of the first free block.
+        std::atomic<Uint64> FreeListHead{0};
+
+        // Chunks are only added while m_MgrMtx is locked. A chunk is published through
+        // the free list, so threads that access its blocks always see it.
+        std::unique_ptr<std::unique_ptr<Chunk>[]> Chunks;
+        std::atomic<Uint32>                       NumChunks{0};
+
+        std::atomic<Int32> AllocationCount{0};
+    };
+
+    static constexpr Uint32 MinBinBlockSize = 16;
+
+    static Uint32 GetBinIndex(Uint32 Size)
+    {
+        return Size <= MinBinBlockSize ? 0 : PlatformMisc::GetMSB(Size - 1) + 1 - PlatformMisc::GetMSB(MinBinBlockSize);
+    }
+
+    bool AllocateBinBlock(SizeClassBin& Bin, Uint32& Block)
+    {
+        // Fast path: take a block from the free list without locking the mutex
+        while (!Bin.PopFreeBlock(Block))
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            // Other thread may have added a chunk while this thread was waiting for the lock
+            if (Bin.PopFreeBlock(Block))
+                break;
+
+            const Uint32 ChunkIdx = Bin.NumChunks.load();
+            if (ChunkIdx == SizeClassBin::MaxChunks)
+                return false;
+
+            std::unique_ptr<SizeClassBin::Chunk> pChunk{new SizeClassBin::Chunk};
+            pChunk->Region        = AllocateSubregion(Bin.BlocksPerChunk * Bin.BlockSize, Bin.BlockSize);
+            pChunk->Offset        = AlignUp(static_cast<Uint32>(pChunk->Region.UnalignedOffset), Bin.BlockSize);
+            pChunk->NextFreeBlock = std::unique_ptr<std::atomic<Uint32>[]>{new std::atomic<Uint32>[Bin.BlocksPerChunk]};
+
+            // Link the chunk blocks into a list. The last block is linked to the current head when the list is pushed.
+            const Uint32 FirstBlock = ChunkIdx * Bin.BlocksPerChunk;
+            for (Uint32 i = 0; i + 1 < Bin.BlocksPerChunk; ++i)
+                pChunk->NextFreeBlock[i].store(FirstBlock + i + 2, std::memory_order_relaxed);
+
+            Bin.Chunks[ChunkIdx] = std::move(pChunk);
+            Bin.NumChunks.store(ChunkIdx + 1);
+            Bin.PushFreeBlocks(FirstBlock, FirstBlock + Bin.BlocksPerChunk - 1);
+
+            UpdateUsageStats();
+        }
+
+        Bin.AllocationCount.fetch_add(1);
+        return true;
+    }
+
+    // m_MgrMtx must be locked
+    VariableSizeAllocationsManager::Allocation AllocateSubregion(Uint32 Size, Uint32 Alignment)
+    {
+        {
+            // After the resize, the actual buffer size may be larger due to alignment
+            // requirements (for sparse buffers, the size is aligned by the memory page size).
+            const auto BufferSize = m_BufferSize.load();
+            const auto MgrSize    = m_Mgr.GetMaxSize();
+            if (BufferSize > MgrSize)
+            {
+                m_Mgr.Extend(StaticCast<size_t>(BufferSize - MgrSize));
+                VERIFY_EXPR(m_Mgr.GetMaxSize() == BufferSize);
+                m_MgrSize.store(m_Mgr.GetMaxSize());
+            }
+        }
+
+        auto Subregion = m_Mgr.Allocate(Size, Alignment);
+
+        while (!Subregion.IsValid())
+        {
+            auto ExtraSize = m_ExpansionSize != 0 ?
+                std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
+                m_Mgr.GetMaxSize();
+
+            m_Mgr.Extend(ExtraSize);
+            m_MgrSize.store(m_Mgr.GetMaxSize());
+
+            Subregion = m_Mgr.Allocate(Size, Alignment);
+        }
+
+        return Subregion;
+    }
+
     void UpdateUsageStats()
     {
         m_UsedSize.store(m_Mgr.GetUsedSize());
@@ -280,12 +645,24 @@ private:
     std::atomic<Uint64> m_MaxFreeBlockSize{0};
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
+
+    std::vector<std::unique_ptr<SizeClassBin>> m_Bins;
+
+    // General allocator suballocations, protected by m_MgrMtx
+    std::unordered_set<BufferSuballocationImpl*> m_MovableSuballocations;
+
+    RefCntAutoPtr<IBuffer> m_pScratchBuffer;
+    std::atomic<Uint32>    m_DefragmentationCount{0};
 };
 
 
 BufferSuballocationImpl::~BufferSuballocationImpl()
 {
-    m_pParentAllocator->Free(std::move(m_Subregion));
+    // Note that m_Subregion may be changed by Defragment() until the parent's mutex is locked
+    if (m_BinIndex == ~0u)
+        m_pParentAllocator->Free(this, std::move(m_Subregion));
+    else
+        m_pParentAllocator->FreeBinBlock(m_BinIndex, m_BinBlock);
 }
 
 IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
@@ -25,6 +25,8 @@
  */
 
 #include <unordered_map>
+#include <vector>
+#include <cstring>
 
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
@@ -33,6 +35,7 @@
 #include "BytecodeCache.h"
 #include "XXH128Hasher.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "LZCompression.hpp"
 
 namespace Diligent
 {
@@ -46,7 +49,7 @@ public:
     struct BytecodeCacheHeader
     {
         static constexpr Uint32 HeaderMagic   = 0x7ADECACE;
-        static constexpr Uint32 HeaderVersion = 1;
+        static constexpr Uint32 HeaderVersion = 2;
 
         Uint32 Magic   = HeaderMagic;
         Uint32 Version = HeaderVersion;
@@ -65,18 +68,33 @@ public:
         XXH128Hash Hash     = {};
         size_t     DataSize = 0;
 
+        // The size of the compressed data that follows the header, or 0 if the data is not compressed.
+        size_t CompressedSize = 0;
+
         template <typename SerType>
         void Serialize(SerType& Stream)
         {
-            Stream(Hash.LowPart, Hash.HighPart, DataSize);
+            Stream(Hash.LowPart, Hash.HighPart, DataSize, CompressedSize);
         }
     };
 
+    struct BytecodeCacheEntry
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+
+        // Compressed byte code in one of the loaded cache data blobs
+        // that is decompressed when the byte code is requested.
+        const void* pCompressedData = nullptr;
+        size_t      CompressedSize  = 0;
+        size_t      DataSize        = 0;
+    };
+
 public:
     BytecodeCacheImpl(IReferenceCounters*            pRefCounters,
                       const BytecodeCacheCreateInfo& CreateInfo) :
         TBase{pRefCounters},
-        m_DeviceType{CreateInfo.DeviceType}
+        m_DeviceType{CreateInfo.DeviceType},
+        m_CompressBytecode{CreateInfo.CompressBytecode != False}
     {
     }
 
@@ -106,16 +124,39 @@ public:
             return false;
         }
 
+        bool HasCompressedData = false;
         for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
         {
             BytecodeCacheElementHeader ElementHeader;
             ElementHeader.Serialize(Stream);
 
-            auto pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
-            Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
-            m_HashMap.emplace(ElementHeader.Hash, pBytecode);
+            BytecodeCacheEntry Entry;
+            if (ElementHeader.CompressedSize != 0)
+            {
+                // Keep the compressed data in the source blob and decompress it on first request
+                const void* pData = nullptr;
+                size_t      Size  = 0;
+                if (!Stream.SerializeBytes(pData, Size) || Size != ElementHeader.CompressedSize)
+                {
+                    LOG_ERROR_MESSAGE("Bytecode cache data is corrupted");
+                    return false;
+                }
+                Entry.pCompressedData = pData;
+                Entry.CompressedSize  = ElementHeader.CompressedSize;
+                Entry.DataSize        = ElementHeader.DataSize;
+                HasCompressedData     = true;
+            }
+            else
+            {
+                Entry.pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
+                Stream.CopyBytes(Entry.pBytecode->GetDataPtr(), ElementHeader.DataSize);
+            }
+            m_HashMap.emplace(ElementHeader.Hash, std::move(Entry));
         }
 
+        if (HasCompressedData)
+            m_CompressedDataBlobs.emplace_back(pDataBlob);
+
         return true;
     }
 
@@ -126,7 +167,20 @@ public:
         const auto Iter = m_HashMap.find(Hash);
         if (Iter != m_HashMap.end())
         {
-            auto pObject = Iter->second;
+            auto& Entry = Iter->second;
+            if (!Entry.pBytecode && Entry.pCompressedData != nullptr)
+            {
+                auto pBytecode = DataBlobImpl::Create(Entry.DataSize);
+                if (!LZDecompress(Entry.pCompressedData, Entry.CompressedSize, pBytecode->GetDataPtr(), pBytecode->GetSize()))
+                {
+                    LOG_ERROR_MESSAGE("Failed to decompress the byte code of shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""), "'. The cache data may be corrupted.");
+                    m_HashMap.erase(Iter);
+                    return;
+                }
+                Entry.pBytecode = std::move(pBytecode);
+            }
+
+            auto pObject = Entry.pBytecode;
             *ppByteCode  = pObject.Detach();
         }
     }
@@ -134,10 +188,10 @@ public:
     virtual void DILIGENT_CALL_TYPE AddBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob* pByteCode) override final
     {
         VERIFY_EXPR(pByteCode != nullptr);
-        const auto Hash = ComputeHash(ShaderCI);
-        const auto Iter = m_HashMap.emplace(Hash, pByteCode);
-        if (!Iter.second)
-            Iter.first->second = pByteCode;
+        const auto         Hash = ComputeHash(ShaderCI);
+        BytecodeCacheEntry Entry;
+        Entry.pBytecode = pByteCode;
+        m_HashMap[Hash] = std::move(Entry);
     }
 
     virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
@@ -150,25 +204,64 @@ public:
     {
         VERIFY_EXPR(ppDataBlob != nullptr);
 
+        // Byte code of every entry is compressed individually, so that it can be decompressed on demand.
+        // Data that has not been requested since the cache was loaded is written as is.
+        std::vector<std::vector<Uint8>> CompressedData;
+        if (m_CompressBytecode)
+            CompressedData.resize(m_HashMap.size());
+
         auto WriteData = [&](auto& Stream) //
         {
             BytecodeCacheHeader Header{};
             Header.ElementCount = m_HashMap.size();
             Header.Serialize(Stream);
 
+            size_t EntryIdx = 0;
             for (auto const& Pair : m_HashMap)
             {
-                const auto& pBytecode = Pair.second;
+                const auto& Entry = Pair.second;
+
+                const void* pData          = Entry.pCompressedData;
+                size_t      CompressedSize = Entry.CompressedSize;
+                if (Entry.pBytecode && !CompressedData.empty() && !CompressedData[EntryIdx].empty())
+                {
+                    pData          = CompressedData[EntryIdx].data();
+                    CompressedSize = CompressedData[EntryIdx].size();
+                }
 
                 BytecodeCacheElementHeader ElementHeader;
-                ElementHeader.Hash     = Pair.first;
-                ElementHeader.DataSize = pBytecode->GetSize();
+                ElementHeader.Hash           = Pair.first;
+                ElementHeader.DataSize       = Entry.pBytecode ? Entry.pBytecode->GetSize() : Entry.DataSize;
+                ElementHeader.CompressedSize = pData != nullptr ? CompressedSize : 0;
                 ElementHeader.Serialize(Stream);
 
-                Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
+                if (ElementHeader.CompressedSize != 0)
+                    Stream.SerializeBytes(pData, ElementHeader.CompressedSize);
+                else
+                    Stream.CopyBytes(Entry.pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
+
+                ++EntryIdx;
             }
         };
 
+        if (m_CompressBytecode)
+        {
+            size_t EntryIdx = 0;
+            for (auto const& Pair : m_HashMap)
+            {
+                const auto& pBytecode = Pair.second.pBytecode;
+                auto&       Dst       = CompressedData[EntryIdx++];
+                if (!pBytecode)
+                    continue;
+
+                const auto DataSize = StaticCast<size_t>(pBytecode->GetSize());
+                Dst.resize(GetLZCompressedSizeBound(DataSize));
+                const auto CompressedSize = LZCompress(pBytecode->GetConstDataPtr(), DataSize, Dst.data(), Dst.size());
+                // Store the data uncompressed if compression does not help
+                Dst.resize(CompressedSize < DataSize ? CompressedSize : 0);
+            }
+        }
+
         Serializer<SerializerMode::Measure> MeasureStream{};
         WriteData(MeasureStream);
 
@@ -184,6 +277,7 @@ public:
     virtual void DILIGENT_CALL_TYPE Clear() override final
     {
         m_HashMap.clear();
+        m_CompressedDataBlobs.clear();
     }
 
 private:
@@ -196,8 +290,12 @@ private:
 
 private:
     RENDER_DEVICE_TYPE m_DeviceType;
+    const bool         m_CompressBytecode;
+
+    std::unordered_map<XXH128Hash, BytecodeCacheEntry> m_HashMap;
 
-    std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>> m_HashMap;
+    // Loaded cache data referenced by compressed entries
+    std::vector<RefCntAutoPtr<IDataBlob>> m_CompressedDataBlobs;
 };
 
 void CreateBytecodeCache(const BytecodeCacheCreateInfo& CreateInfo,
@@ -0,0 +1,867 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandStreamPlayer.hpp"
+
+#include <cstring>
+
+#include "CommandStreamSerializer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "Timer.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+class CommandStreamPlayer::StreamReader final : public CommandStreamObjectResolver
+{
+public:
+    using ChunkType       = CommandStreamFormat::ChunkType;
+    using ResourceBinding = CommandStreamFormat::ResourceBinding;
+
+    StreamReader(IRenderDevice* pDevice, IDeviceContext* pContext, IDataBlob* pStreamData) :
+        m_pDevice{pDevice},
+        m_pContext{pContext},
+        m_pStreamData{pStreamData},
+        m_Allocator{DefaultRawMemoryAllocator::GetAllocator(), 4096}
+    {}
+
+    bool Parse()
+    {
+        const Uint8* pData    = static_cast<const Uint8*>(m_pStreamData->GetConstDataPtr());
+        const size_t DataSize = m_pStreamData->GetSize();
+
+        CommandStreamFormat::StreamHeader Header;
+        if (DataSize < sizeof(Header))
+        {
+            LOG_ERROR_MESSAGE("The command stream is too small");
+            return false;
+        }
+        memcpy(&Header, pData, sizeof(Header));
+        if (Header.MagicNumber != CommandStreamFormat::HeaderMagicNumber)
+        {
+            LOG_ERROR_MESSAGE("The data is not a command stream");
+            return false;
+        }
+        if (Header.Version != CommandStreamFormat::StreamVersion)
+        {
+            LOG_ERROR_MESSAGE("Command stream version ", Header.Version, " is not supported. Expected version: ", CommandStreamFormat::StreamVersion);
+            return false;
+        }
+
+        bool   FrameHasCommands = false;
+        size_t Offset           = sizeof(Header);
+        while (Offset < DataSize)
+        {
+            CommandStreamFormat::ChunkHeader ChunkHeader;
+            if (Offset + sizeof(ChunkHeader) > DataSize)
+            {
+                LOG_ERROR_MESSAGE("Unexpected end of the command stream");
+                return false;
+            }
+            memcpy(&ChunkHeader, pData + Offset, sizeof(ChunkHeader));
+            Offset += sizeof(ChunkHeader);
+
+            if (ChunkHeader.Type == ChunkType::Undefined || ChunkHeader.Type >= ChunkType::Count)
+            {
+                LOG_ERROR_MESSAGE("Unexpected chunk type ", static_cast<Uint32>(ChunkHeader.Type), " in the command stream");
+                return false;
+            }
+            if (Offset + ChunkHeader.Size > DataSize)
+            {
+                LOG_ERROR_MESSAGE("Unexpected end of the command stream");
+                return false;
+            }
+
+            const ChunkInfo Chunk{ChunkHeader.Type, pData + Offset, ChunkHeader.Size};
+            if (CommandStreamFormat::IsObjectChunk(Chunk.Type))
+            {
+                m_ObjectChunks.push_back(Chunk);
+            }
+            else
+            {
+                m_Commands.push_back(Chunk);
+                if (Chunk.Type == ChunkType::EndFrame)
+                {
+                    ++m_NumFrames;
+                    FrameHasCommands = false;
+                }
+                else
+                {
+                    FrameHasCommands = true;
+                }
+            }
+
+            Offset += AlignUp(size_t{ChunkHeader.Size}, CommandStreamFormat::ChunkAlignment);
+        }
+
+        // The last frame may not be ended
+        if (FrameHasCommands)
+        {
+            m_Commands.push_back({ChunkType::EndFrame, nullptr, 0});
+            ++m_NumFrames;
+        }
+
+        return true;
+    }
+
+    void CreateObjects()
+    {
+        for (const ChunkInfo& Chunk : m_ObjectChunks)
+        {
+            BeginChunk(Chunk);
+            if (!CreateObject(Chunk.Type))
+                ++m_NumFailedObjects;
+        }
+        m_Allocator.Discard();
+    }
+
+    bool Replay(ReplayStats& Stats)
+    {
+        m_pContext->InvalidateState();
+
+        Timer  FrameTimer;
+        Timer  TotalTimer;
+        double FrameStartTime = FrameTimer.GetElapsedTime();
+        for (const ChunkInfo& Chunk : m_Commands)
+        {
+            if (Chunk.Type == ChunkType::EndFrame)
+            {
+                m_pContext->FinishFrame();
+
+                const double FrameEndTime = FrameTimer.GetElapsedTime();
+                Stats.FrameCPUTimes.push_back(FrameEndTime - FrameStartTime);
+                Stats.CPUTime += FrameEndTime - FrameStartTime;
+                ++Stats.NumFrames;
+                FrameStartTime = FrameEndTime;
+                continue;
+            }
+
+            BeginChunk(Chunk);
+            if (ExecuteCommand(Chunk.Type))
+                ++Stats.NumCommands;
+            else
+                ++Stats.NumSkippedCommands;
+            m_Allocator.Discard();
+        }
+
+        m_pContext->WaitForIdle();
+        Stats.TotalTime = TotalTimer.GetElapsedTime();
+
+        return true;
+    }
+
+    virtual Uint32 GetObjectId(IObject* /*pObject*/) override final
+    {
+        UNEXPECTED("The reader never writes objects");
+        return 0;
+    }
+
+    virtual IObject* GetObject(Uint32 Id) override final
+    {
+        IObject* pObject = Id < m_Objects.size() ? m_Objects[Id].RawPtr() : nullptr;
+        if (pObject == nullptr)
+            m_HasMissingObjects = true;
+        return pObject;
+    }
+
+    Uint32 GetNumFrames() const { return m_NumFrames; }
+    Uint32 GetNumObjects() const { return static_cast<Uint32>(m_ObjectChunks.size()); }
+    Uint32 GetNumFailedObjects() const { return m_NumFailedObjects; }
+
+private:
+    struct ChunkInfo
+    {
+        ChunkType    Type  = ChunkType::Undefined;
+        const Uint8* pData = nullptr;
+        Uint32       Size  = 0;
+    };
+
+    void BeginChunk(const ChunkInfo& Chunk)
+    {
+        m_ChunkData         = SerializedData{const_cast<Uint8*>(Chunk.pData), Chunk.Size};
+        m_HasMissingObjects = false;
+    }
+
+    void SetObject(Uint32 Id, IObject* pObject)
+    {
+        if (Id >= m_Objects.size())
+            m_Objects.resize(Id + 1);
+        m_Objects[Id] = pObject;
+    }
+
+    Uint64 GetContextMask() const
+    {
+        return Uint64{1} << m_pContext->GetDesc().ContextId;
+    }
+
+    bool CreateObject(ChunkType Type)
+    {
+        Serializer<SerializerMode::Read>              Ser{m_ChunkData};
+        CommandStreamSerializer<SerializerMode::Read> Reader{Ser, *this, &m_Allocator};
+
+        Uint32 Id = 0;
+        if (!Reader(Id))
+            return false;
+
+        static_assert(static_cast<Uint32>(ChunkType::CreateShaderResourceBinding) == 9, "Did you add a new object chunk type? Please handle it here.");
+        switch (Type)
+        {
+            case ChunkType::CreateBuffer:
+            {
+                BufferDesc  Desc;
+                const void* pData    = nullptr;
+                size_t      DataSize = 0;
+                if (!(Reader.SerializeBufferDesc(Desc) && Reader.SerializeBytes(pData, DataSize)))
+                    return false;
+
+                // Resources recorded without contents can't be immutable
+                if (pData == nullptr && Desc.Usage == USAGE_IMMUTABLE)
+                    Desc.Usage = USAGE_DEFAULT;
+                Desc.ImmediateContextMask = GetContextMask();
+
+                BufferData InitData{pData, DataSize, m_pContext};
+
+                RefCntAutoPtr<IBuffer> pBuffer;
+                m_pDevice->CreateBuffer(Desc, pData != nullptr ? &InitData : nullptr, &pBuffer);
+                SetObject(Id, pBuffer);
+                return pBuffer != nullptr;
+            }
+
+            case ChunkType::CreateTexture:
+            {
+                TextureDesc Desc;
+                Uint32      NumSubresources = 0;
+                if (!(Reader.SerializeTextureDesc(Desc) && Reader(NumSubresources)))
+                    return false;
+
+                std::vector<TextureSubResData> SubResources(NumSubresources);
+                for (TextureSubResData& SubRes : SubResources)
+                {
+                    size_t DataSize = 0;
+                    if (!(Reader(SubRes.Stride, SubRes.DepthStride) && Reader.SerializeBytes(SubRes.pData, DataSize)))
+                        return false;
+                }
+
+                if (NumSubresources == 0 && Desc.Usage == USAGE_IMMUTABLE)
+                    Desc.Usage = USAGE_DEFAULT;
+                Desc.ImmediateContextMask = GetContextMask();
+
+                TextureData InitData{SubResources.data(), NumSubresources, m_pContext};
+
+                RefCntAutoPtr<ITexture> pTexture;
+                m_pDevice->CreateTexture(Desc, NumSubresources > 0 ? &InitData : nullptr, &pTexture);
+                SetObject(Id, pTexture);
+                return pTexture != nullptr;
+            }
+
+            case ChunkType::CreateBufferView:
+            {
+                IBuffer*       pBuffer = nullptr;
+                BufferViewDesc Desc;
+                if (!(Reader.SerializeObject(pBuffer) && Reader.SerializeBufferViewDesc(Desc)) || pBuffer == nullptr)
+                    return false;
+
+                RefCntAutoPtr<IBufferView> pView;
+                pBuffer->CreateView(Desc, &pView);
+                SetObject(Id, pView);
+                return pView != nullptr;
+            }
+
+            case ChunkType::CreateTextureView:
+            {
+                ITexture*       pTexture = nullptr;
+                TextureViewDesc Desc;
+                if (!(Reader.SerializeObject(pTexture) && Reader.SerializeTextureViewDesc(Desc)) || pTexture == nullptr)
+                    return false;
+
+                RefCntAutoPtr<ITextureView> pView;
+                pTexture->CreateView(Desc, &pView);
+                SetObject(Id, pView);
+                return pView != nullptr;
+            }
+
+            case ChunkType::CreateSampler:
+            {
+                SamplerDesc Desc;
+                if (!Reader.SerializeSamplerDesc(Desc))
+                    return false;
+
+                RefCntAutoPtr<ISampler> pSampler;
+                m_pDevice->CreateSampler(Desc, &pSampler);
+                SetObject(Id, pSampler);
+                return pSampler != nullptr;
+            }
+
+            case ChunkType::CreateShader:
+            {
+                ShaderCreateInfo ShaderCI;
+                if (!Reader.SerializeShaderCreateInfo(ShaderCI))
+                    return false;
+
+                RefCntAutoPtr<IShader> pShader;
+                m_pDevice->CreateShader(ShaderCI, &pShader);
+                SetObject(Id, pShader);
+                return pShader != nullptr;
+            }
+
+            case ChunkType::CreatePipelineState:
+                return CreatePipelineState(Id, Reader);
+
+            case ChunkType::PipelineStaticBindings:
+            {
+                // The chunk references the pipeline instead of defining a new object
+                IPipelineState* pPSO = static_cast<IPipelineState*>(GetObject(Id));
+                if (pPSO == nullptr)
+                    return false;
+
+                const ResourceBinding* pBindings   = nullptr;
+                Uint32                 NumBindings = 0;
+                if (!Reader.SerializeBindings(pBindings, NumBindings))
+                    return false;
+
+                for (Uint32 i = 0; i < NumBindings; ++i)
+                {
+                    const ResourceBinding& Binding = pBindings[i];
+                    if (IShaderResourceVariable* pVar = pPSO->GetStaticVariableByName(Binding.ShaderType, Binding.Name))
+                        pVar->SetArray(&Binding.pObject, Binding.ArrayIndex, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+                }
+                return true;
+            }
+
+            case ChunkType::CreateShaderResourceBinding:
+            {
+                IPipelineState* pPSO = nullptr;
+                if (!Reader.SerializeObject(pPSO) || pPSO == nullptr)
+                    return false;
+
+                RefCntAutoPtr<IShaderResourceBinding> pSRB;
+                pPSO->CreateShaderResourceBinding(&pSRB, true);
+                SetObject(Id, pSRB);
+                return pSRB != nullptr;
+            }
+
+            default:
+                UNEXPECTED("Unexpected object chunk type");
+                return false;
+        }
+    }
+
+    bool CreatePipelineState(Uint32 Id, CommandStreamSerializer<SerializerMode::Read>& Reader)
+    {
+        PIPELINE_TYPE PipelineType = PIPELINE_TYPE_INVALID;
+        if (!Reader(PipelineType))
+            return false;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        if (PipelineType == PIPELINE_TYPE_COMPUTE)
+        {
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            if (!Reader.SerializeComputePipelineCreateInfo(PSOCreateInfo) || m_HasMissingObjects)
+                return false;
+
+            PSOCreateInfo.PSODesc.ImmediateContextMask = GetContextMask();
+            m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        }
+        else
+        {
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+            if (!Reader.SerializeGraphicsPipelineCreateInfo(PSOCreateInfo) || m_HasMissingObjects)
+                return false;
+
+            PSOCreateInfo.PSODesc.ImmediateContextMask = GetContextMask();
+            m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        }
+
+        SetObject(Id, pPSO);
+        return pPSO != nullptr;
+    }
+
+    // Returns false if the command was skipped.
+    bool ExecuteCommand(ChunkType Type)
+    {
+        Serializer<SerializerMode::Read>              Ser{m_ChunkData};
+        CommandStreamSerializer<SerializerMode::Read> Reader{Ser, *this, &m_Allocator};
+
+        IDeviceContext* pCtx = m_pContext;
+
+        static_assert(static_cast<Uint32>(ChunkType::Count) == 43, "Did you add a new chunk type? Please handle it here.");
+        switch (Type)
+        {
+            case ChunkType::SetPipelineState:
+            {
+                IPipelineState* pPSO = nullptr;
+                if (!Reader.SerializeObject(pPSO) || pPSO == nullptr)
+                    return false;
+                pCtx->SetPipelineState(pPSO);
+                return true;
+            }
+
+            case ChunkType::ShaderResourceBindings:
+            {
+                IShaderResourceBinding* pSRB = nullptr;
+                if (!Reader.SerializeObject(pSRB) || pSRB == nullptr)
+                    return false;
+
+                const ResourceBinding* pBindings   = nullptr;
+                Uint32                 NumBindings = 0;
+                if (!Reader.SerializeBindings(pBindings, NumBindings))
+                    return false;
+
+                for (Uint32 i = 0; i < NumBindings; ++i)
+                {
+                    const ResourceBinding& Binding = pBindings[i];
+                    if (Binding.pObject == nullptr)
+                        continue;
+                    if (IShaderResourceVariable* pVar = pSRB->GetVariableByName(Binding.ShaderType, Binding.Name))
+                        pVar->SetArray(&Binding.pObject, Binding.ArrayIndex, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+                }
+                return !m_HasMissingObjects;
+            }
+
+            case ChunkType::CommitShaderResources:
+            {
+                IShaderResourceBinding*        pSRB = nullptr;
+                RESOURCE_STATE_TRANSITION_MODE Mode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                if (!(Reader.SerializeObject(pSRB) && Reader(Mode)) || pSRB == nullptr)
+                    return false;
+                pCtx->CommitShaderResources(pSRB, Mode);
+                return true;
+            }
+
+            case ChunkType::TransitionShaderResources:
+            {
+                IShaderResourceBinding* pSRB = nullptr;
+                if (!Reader.SerializeObject(pSRB) || pSRB == nullptr)
+                    return false;
+                pCtx->TransitionShaderResources(nullptr, pSRB);
+                return true;
+            }
+
+            case ChunkType::SetStencilRef:
+            {
+                Uint32 StencilRef = 0;
+                if (!Reader(StencilRef))
+                    return false;
+                pCtx->SetStencilRef(StencilRef);
+                return true;
+            }
+
+            case ChunkType::SetBlendFactors:
+            {
+                const float* pBlendFactors = nullptr;
+                if (!Reader.SerializeFloat4(pBlendFactors))
+                    return false;
+                pCtx->SetBlendFactors(pBlendFactors);
+                return true;
+            }
+
+            case ChunkType::SetVertexBuffers:
+            {
+                Uint32                         StartSlot     = 0;
+                Uint32                         NumBuffersSet = 0;
+                RESOURCE_STATE_TRANSITION_MODE Mode          = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                SET_VERTEX_BUFFERS_FLAGS       Flags         = SET_VERTEX_BUFFERS_FLAG_NONE;
+                Uint8                          HasOffsets    = 0;
+                if (!Reader(StartSlot, NumBuffersSet, Mode, Flags, HasOffsets))
+                    return false;
+
+                IBuffer** ppBuffers = m_Allocator.ConstructArray<IBuffer*>(NumBuffersSet);
+                Uint64*   pOffsets  = HasOffsets ? m_Allocator.ConstructArray<Uint64>(NumBuffersSet) : nullptr;
+                for (Uint32 i = 0; i < NumBuffersSet; ++i)
+                {
+                    if (!Reader.SerializeObject(ppBuffers[i]) || (HasOffsets && !Reader(pOffsets[i])))
+                        return false;
+                }
+                pCtx->SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, Mode, Flags);
+                return !m_HasMissingObjects;
+            }
+
+            case ChunkType::SetIndexBuffer:
+            {
+                IBuffer*                       pIndexBuffer = nullptr;
+                Uint64                         ByteOffset   = 0;
+                RESOURCE_STATE_TRANSITION_MODE Mode         = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                if (!(Reader.SerializeObject(pIndexBuffer) && Reader(ByteOffset, Mode)))
+                    return false;
+                pCtx->SetIndexBuffer(pIndexBuffer, ByteOffset, Mode);
+                return !m_HasMissingObjects;
+            }
+
+            case ChunkType::SetViewports:
+            {
+                Uint32          NumViewports    = 0;
+                Uint32          RTWidth         = 0;
+                Uint32          RTHeight        = 0;
+                const Viewport* pViewports      = nullptr;
+                Uint32          NumViewportsSet = 0;
+                if (!(Reader(NumViewports, RTWidth, RTHeight) && Reader.SerializeViewports(pViewports, NumViewportsSet)))
+                    return false;
+                pCtx->SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+                return true;
+            }
+
+            case ChunkType::SetScissorRects:
+            {
+                Uint32      NumRects    = 0;
+                Uint32      RTWidth     = 0;
+                Uint32      RTHeight    = 0;
+                const Rect* pRects      = nullptr;
+                Uint32      NumRectsSet = 0;
+                if (!(Reader(NumRects, RTWidth, RTHeight) && Reader.SerializeRects(pRects, NumRectsSet)))
+                    return false;
+                pCtx->SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+                return true;
+            }
+
+            case ChunkType::SetRenderTargets:
+            {
+                SetRenderTargetsAttribs Attribs;
+                if (!Reader.SerializeSetRenderTargetsAttribs(Attribs) || m_HasMissingObjects)
+                    return false;
+                pCtx->SetRenderTargetsExt(Attribs);
+                return true;
+            }
+
+            case ChunkType::Draw:
+            {
+                DrawAttribs Attribs;
+                if (!Reader.SerializeDrawAttribs(Attribs))
+                    return false;
+                pCtx->Draw(Attribs);
+                return true;
+            }
+
+            case ChunkType::DrawIndexed:
+            {
+                DrawIndexedAttribs Attribs;
+                if (!Reader.SerializeDrawIndexedAttribs(Attribs))
+                    return false;
+                pCtx->DrawIndexed(Attribs);
+                return true;
+            }
+
+            case ChunkType::DrawIndirect:
+            {
+                DrawIndirectAttribs Attribs;
+                if (!Reader.SerializeDrawIndirectAttribs(Attribs) || m_HasMissingObjects)
+                    return false;
+                pCtx->DrawIndirect(Attribs);
+                return true;
+            }
+
+            case ChunkType::DrawIndexedIndirect:
+            {
+                DrawIndexedIndirectAttribs Attribs;
+                if (!Reader.SerializeDrawIndexedIndirectAttribs(Attribs) || m_HasMissingObjects)
+                    return false;
+                pCtx->DrawIndexedIndirect(Attribs);
+                return true;
+            }
+
+            case ChunkType::DispatchCompute:
+            {
+                DispatchComputeAttribs Attribs;
+                if (!Reader.SerializeDispatchComputeAttribs(Attribs))
+                    return false;
+                pCtx->DispatchCompute(Attribs);
+                return true;
+            }
+
+            case ChunkType::DispatchComputeIndirect:
+            {
+                DispatchComputeIndirectAttribs Attribs;
+                if (!Reader.SerializeDispatchComputeIndirectAttribs(Attribs) || m_HasMissingObjects)
+                    return false;
+                pCtx->DispatchComputeIndirect(Attribs);
+                return true;
+            }
+
+            case ChunkType::ClearRenderTarget:
+            {
+                ITextureView*                  pView = nullptr;
+                const float*                   RGBA  = nullptr;
+                RESOURCE_STATE_TRANSITION_MODE Mode  = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                if (!(Reader.SerializeObject(pView) && Reader.SerializeFloat4(RGBA) && Reader(Mode)) || pView == nullptr)
+                    return false;
+                pCtx->ClearRenderTarget(pView, RGBA, Mode);
+                return true;
+            }
+
+            case ChunkType::ClearDepthStencil:
+            {
+                ITextureView*                  pView      = nullptr;
+                CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags = CLEAR_DEPTH_FLAG_NONE;
+                float                          Depth      = 0;
+                Uint8                          Stencil    = 0;
+                RESOURCE_STATE_TRANSITION_MODE Mode       = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                if (!(Reader.SerializeObject(pView) && Reader(ClearFlags, Depth, Stencil, Mode)) || pView == nullptr)
+                    return false;
+                pCtx->ClearDepthStencil(pView, ClearFlags, Depth, Stencil, Mode);
+                return true;
+            }
+
+            case ChunkType::UpdateBuffer:
+            {
+                IBuffer*                       pBuffer  = nullptr;
+                Uint64                         Offset   = 0;
+                RESOURCE_STATE_TRANSITION_MODE Mode     = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                const void*                    pData    = nullptr;
+                size_t                         DataSize = 0;
+                if (!(Reader.SerializeObject(pBuffer) && Reader(Offset, Mode) && Reader.SerializeBytes(pData, DataSize)) || pBuffer == nullptr)
+                    return false;
+                pCtx->UpdateBuffer(pBuffer, Offset, DataSize, pData, Mode);
+                return true;
+            }
+
+            case ChunkType::CopyBuffer:
+            {
+                IBuffer*                       pSrcBuffer = nullptr;
+                IBuffer*                       pDstBuffer = nullptr;
+                Uint64                         SrcOffset  = 0;
+                Uint64                         DstOffset  = 0;
+                Uint64                         Size       = 0;
+                RESOURCE_STATE_TRANSITION_MODE SrcMode    = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                RESOURCE_STATE_TRANSITION_MODE DstMode    = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                if (!(Reader.SerializeObject(pSrcBuffer) && Reader(SrcOffset, SrcMode) &&
+                      Reader.SerializeObject(pDstBuffer) && Reader(DstOffset, Size, DstMode)) ||
+                    pSrcBuffer == nullptr || pDstBuffer == nullptr)
+                    return false;
+                pCtx->CopyBuffer(pSrcBuffer, SrcOffset, SrcMode, pDstBuffer, DstOffset, Size, DstMode);
+                return true;
+            }
+
+            case ChunkType::WriteBuffer:
+            {
+                IBuffer*    pBuffer  = nullptr;
+                MAP_FLAGS   MapFlags = MAP_FLAG_NONE;
+                const void* pData    = nullptr;
+                size_t      DataSize = 0;
+                if (!(Reader.SerializeObject(pBuffer) && Reader(MapFlags) && Reader.SerializeBytes(pData, DataSize)) || pBuffer == nullptr)
+                    return false;
+
+                PVoid pMappedData = nullptr;
+                pCtx->MapBuffer(pBuffer, MAP_WRITE, MapFlags, pMappedData);
+                if (pMappedData == nullptr)
+                    return false;
+                memcpy(pMappedData, pData, std::min(DataSize, StaticCast<size_t>(pBuffer->GetDesc().Size)));
+                pCtx->UnmapBuffer(pBuffer, MAP_WRITE);
+                return true;
+            }
+
+            case ChunkType::UpdateTexture:
+            {
+                ITexture*                      pTexture = nullptr;
+                Uint32                         MipLevel = 0;
+                Uint32                         Slice    = 0;
+                Box                            DstBox;
+                TextureSubResData              SubresData;
+                RESOURCE_STATE_TRANSITION_MODE Mode     = RESOURCE_STATE_TRANSITION_MODE_NONE;
+                size_t                         DataSize = 0;
+                if (!(Reader.SerializeObject(pTexture) && Reader(MipLevel, Slice) && Reader.SerializeBox(DstBox) &&
+                      Reader(SubresData.Stride, SubresData.DepthStride, Mode) && Reader.SerializeBytes(SubresData.pData, DataSize)) ||
+                    pTexture == nullptr)
+                    return false;
+                pCtx->UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, Mode);
+                return true;
+            }
+
+            case ChunkType::CopyTexture:
+            {
+                CopyTextureAttribs Attribs;
+                if (!Reader.SerializeCopyTextureAttribs(Attribs) || m_HasMissingObjects)
+                    return false;
+                pCtx->CopyTexture(Attribs);
+                return true;
+            }
+
+            case ChunkType::GenerateMips:
+            {
+                ITextureView* pView = nullptr;
+                if (!Reader.SerializeObject(pView) || pView == nullptr)
+                    return false;
+                pCtx->GenerateMips(pView);
+                return true;
+            }
+
+            case ChunkType::TransitionResourceStates:
+            {
+                const StateTransitionDesc* pBarriers   = nullptr;
+                Uint32                     NumBarriers = 0;
+                if (!Reader.SerializeStateTransitions(pBarriers, NumBarriers) || m_HasMissingObjects)
+                    return false;
+                pCtx->TransitionResourceStates(NumBarriers, pBarriers);
+                return true;
+            }
+
+            case ChunkType::InvalidateState:
+                pCtx->InvalidateState();
+                return true;
+
+            case ChunkType::Flush:
+                pCtx->Flush();
+                return true;
+
+            case ChunkType::WaitForIdle:
+                pCtx->WaitForIdle();
+                return true;
+
+            case ChunkType::BeginDebugGroup:
+            case ChunkType::InsertDebugLabel:
+            {
+                const Char*  Name   = nullptr;
+                const float* pColor = nullptr;
+                if (!(Reader(Name) && Reader.SerializeFloat4(pColor)))
+                    return false;
+                if (Type == ChunkType::BeginDebugGroup)
+                    pCtx->BeginDebugGroup(Name, pColor);
+                else
+                    pCtx->InsertDebugLabel(Name, pColor);
+                return true;
+            }
+
+            case ChunkType::EndDebugGroup:
+                pCtx->EndDebugGroup();
+                return true;
+
+            default:
+                UNEXPECTED("Unexpected command chunk type");
+                return false;
+        }
+    }
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    // Chunks and the data of the objects reference the stream data
+    RefCntAutoPtr<IDataBlob> m_pStreamData;
+
+    std::vector<ChunkInfo> m_ObjectChunks;
+    std::vector<ChunkInfo> m_Commands;
+
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+
+    DynamicLinearAllocator m_Allocator;
+    SerializedData         m_ChunkData;
+
+    Uint32 m_NumFrames        = 0;
+    Uint32 m_NumFailedObjects = 0;
+
+    // Set when the current chunk references an object that has not been created
+    bool m_HasMissingObjects = false;
+};
+
+
+CommandStreamPlayer::CommandStreamPlayer(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pContext{CI.pContext}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (m_pContext == nullptr)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+    if (m_pContext->GetDesc().IsDeferred)
+        LOG_ERROR_AND_THROW("Command streams can only be replayed by immediate device contexts");
+}
+
+CommandStreamPlayer::~CommandStreamPlayer()
+{
+}
+
+bool CommandStreamPlayer::Load(IDataBlob* pStreamData)
+{
+    m_pReader.reset();
+    m_NumFrames        = 0;
+    m_NumObjects       = 0;
+    m_NumFailedObjects = 0;
+
+    if (pStreamData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Command stream data must not be null");
+        return false;
+    }
+
+    auto pReader = std::make_unique<StreamReader>(m_pDevice, m_pContext, pStreamData);
+    if (!pReader->Parse())
+        return false;
+
+    pReader->CreateObjects();
+    if (pReader->GetNumFailedObjects() > 0)
+    {
+        LOG_WARNING_MESSAGE(pReader->GetNumFailedObjects(), " of ", pReader->GetNumObjects(),
+                            " command stream objects could not be created. The commands that use them will be skipped.");
+    }
+
+    m_NumFrames        = pReader->GetNumFrames();
+    m_NumObjects       = pReader->GetNumObjects();
+    m_NumFailedObjects = pReader->GetNumFailedObjects();
+    m_pReader          = std::move(pReader);
+
+    return true;
+}
+
+bool CommandStreamPlayer::LoadFromFile(const Char* FilePath)
+{
+    FileWrapper File{FilePath, EFileAccessMode::Read};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open command stream file '", FilePath, "'");
+        return false;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create(File->GetSize());
+    if (!File->Read(pData->GetDataPtr(), pData->GetSize()))
+    {
+        LOG_ERROR_MESSAGE("Failed to read command stream file '", FilePath, "'");
+        return false;
+    }
+
+    return Load(pData);
+}
+
+bool CommandStreamPlayer::Replay(ReplayStats* pStats)
+{
+    if (!m_pReader)
+    {
+        LOG_ERROR_MESSAGE("Command stream has not been loaded");
+        return false;
+    }
+
+    ReplayStats Stats;
+    Stats.FrameCPUTimes.reserve(m_NumFrames);
+
+    const bool Res = m_pReader->Replay(Stats);
+    if (pStats != nullptr)
+        *pStats = std::move(Stats);
+
+    return Res;
+}
+
+} // namespace Diligent
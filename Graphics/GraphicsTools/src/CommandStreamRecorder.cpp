@@ -0,0 +1,1594 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandStreamRecorder.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstring>
+
+#include "CommandStreamSerializer.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "FileWrapper.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Returns the size of the subresource data with the given strides that covers the region.
+size_t GetSubresourceDataSize(TEXTURE_FORMAT Format, const Box& Region, Uint64 Stride, Uint64 DepthStride)
+{
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Format);
+
+    const Uint32 BlockWidth  = std::max(Uint32{FmtAttribs.BlockWidth}, 1u);
+    const Uint32 BlockHeight = std::max(Uint32{FmtAttribs.BlockHeight}, 1u);
+    const Uint32 NumCols     = (Region.Width() + BlockWidth - 1) / BlockWidth;
+    const Uint32 NumRows     = (Region.Height() + BlockHeight - 1) / BlockHeight;
+    const Uint32 Depth       = Region.Depth();
+    if (NumCols == 0 || NumRows == 0 || Depth == 0)
+        return 0;
+
+    const Uint64 RowSize = Uint64{NumCols} * FmtAttribs.GetElementSize();
+    return StaticCast<size_t>(Uint64{Depth - 1} * DepthStride + Uint64{NumRows - 1} * Stride + RowSize);
+}
+
+} // namespace
+
+class CommandStreamRecorder::StreamWriter final : public CommandStreamObjectResolver
+{
+public:
+    using ChunkType       = CommandStreamFormat::ChunkType;
+    using ResourceBinding = CommandStreamFormat::ResourceBinding;
+
+    explicit StreamWriter(IDeviceContext* pContext) :
+        m_pContext{pContext},
+        m_FrameNumber{pContext->GetFrameNumber()}
+    {
+        CommandStreamFormat::StreamHeader Header;
+        m_Stream.resize(sizeof(Header));
+        memcpy(m_Stream.data(), &Header, sizeof(Header));
+    }
+
+    void RecordBuffer(IBuffer* pBuffer, const BufferData* pData)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        RecordBufferChunk(pBuffer, AddObject(pBuffer), pData);
+    }
+
+    void RecordTexture(ITexture* pTexture, const TextureData* pData)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        RecordTextureChunk(pTexture, AddObject(pTexture), pData);
+    }
+
+    void RecordShader(IShader* pShader, const ShaderCreateInfo& ShaderCI)
+    {
+        ShaderCreateInfo CI = ShaderCI;
+
+        std::string Source;
+        if (CI.ByteCode == nullptr)
+        {
+            // Unroll the include files so that the stream does not depend on the file system
+            try
+            {
+                Source = UnrollShaderIncludes(ShaderCI);
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Failed to unroll includes of shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""),
+                                  "'. The shader and pipelines that use it will not be recorded.");
+                return;
+            }
+            CI.Source       = Source.c_str();
+            CI.SourceLength = Source.length();
+        }
+        CI.FilePath                   = nullptr;
+        CI.pShaderSourceStreamFactory = nullptr;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        const Uint32 Id = AddObject(pShader);
+        WriteChunk(ChunkType::CreateShader,
+                   [&](auto& Ser) {
+                       return Ser(Id) && Ser.SerializeShaderCreateInfo(CI);
+                   });
+    }
+
+    template <typename CreateInfoType>
+    void RecordPipelineState(IPipelineState* pPSO, const CreateInfoType& PSOCreateInfo)
+    {
+        const Char* Name = PSOCreateInfo.PSODesc.Name != nullptr ? PSOCreateInfo.PSODesc.Name : "";
+        if (PSOCreateInfo.ResourceSignaturesCount != 0)
+        {
+            LOG_WARNING_MESSAGE("Pipeline state '", Name, "' uses explicit resource signatures and will not be recorded.");
+            return;
+        }
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        if (!AllShadersRecorded(PSOCreateInfo))
+        {
+            LOG_WARNING_MESSAGE("Pipeline state '", Name, "' uses shaders that have not been recorded and will not be recorded.");
+            return;
+        }
+
+        const Uint32 Id = AddObject(pPSO);
+        WriteChunk(ChunkType::CreatePipelineState,
+                   [&](auto& Ser) {
+                       PIPELINE_TYPE PipelineType = PSOCreateInfo.PSODesc.PipelineType;
+                       return Ser(Id, PipelineType) && SerializePipelineCreateInfo(Ser, PSOCreateInfo);
+                   });
+    }
+
+    void RecordSampler(ISampler* pSampler)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        GetObjectId(pSampler);
+    }
+
+    template <typename HandlerType>
+    void RecordCommand(ChunkType Type, HandlerType&& Handler)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        RecordCommandChunk(Type, std::forward<HandlerType>(Handler));
+    }
+
+    void RecordSetPipelineState(IPipelineState* pPSO)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_pCurrentPSO = pPSO;
+        RecordCommandChunk(ChunkType::SetPipelineState,
+                           [&](auto& Ser) {
+                               return Ser.SerializeObject(pPSO);
+                           });
+    }
+
+    void RecordCommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (pSRB == nullptr)
+            return;
+
+        RecordBindings(pSRB, m_pCurrentPSO);
+        RecordCommandChunk(ChunkType::CommitShaderResources,
+                           [&](auto& Ser) {
+                               return Ser.SerializeObject(pSRB) && Ser(StateTransitionMode);
+                           });
+    }
+
+    void RecordTransitionShaderResources(IPipelineState* pPSO, IShaderResourceBinding* pSRB)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (pSRB == nullptr)
+            return;
+
+        RecordBindings(pSRB, pPSO != nullptr ? pPSO : m_pCurrentPSO.RawPtr());
+        RecordCommandChunk(ChunkType::TransitionShaderResources,
+                           [&](auto& Ser) {
+                               return Ser.SerializeObject(pSRB);
+                           });
+    }
+
+    void OnMapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, void* pMappedData)
+    {
+        if (pBuffer == nullptr || pMappedData == nullptr || (MapType & MAP_WRITE) == 0)
+            return;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_MappedBuffers[pBuffer] = {pMappedData, MapFlags};
+    }
+
+    void OnUnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+    {
+        if (pBuffer == nullptr || (MapType & MAP_WRITE) == 0)
+            return;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_MappedBuffers.find(pBuffer);
+        if (it == m_MappedBuffers.end())
+            return;
+        const MappedBufferInfo MappedInfo = it->second;
+        m_MappedBuffers.erase(it);
+
+        // The buffer contents are recorded when it is unmapped, after the application has written the data
+        const void*  pData    = MappedInfo.pData;
+        const size_t DataSize = StaticCast<size_t>(pBuffer->GetDesc().Size);
+        RecordCommandChunk(ChunkType::WriteBuffer,
+                           [&](auto& Ser) {
+                               return Ser.SerializeObject(pBuffer) && Ser(MappedInfo.MapFlags) && Ser.SerializeBytes(pData, DataSize);
+                           });
+    }
+
+    virtual Uint32 GetObjectId(IObject* pObject) override final
+    {
+        VERIFY_EXPR(pObject != nullptr);
+
+        auto it = m_ObjectIds.find(pObject);
+        if (it != m_ObjectIds.end())
+        {
+            if (it->second.wpObject.IsValid())
+                return it->second.Id;
+
+            // The object has been destroyed and a new object has been allocated at the same address
+            m_ObjectIds.erase(it);
+        }
+
+        return RecordObject(pObject);
+    }
+
+    virtual IObject* GetObject(Uint32 /*Id*/) override final
+    {
+        UNEXPECTED("The writer never reads objects");
+        return nullptr;
+    }
+
+    std::vector<Uint8> GetStream() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Stream;
+    }
+
+    Uint32 GetNumFrames() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_NumFrames;
+    }
+
+    Uint32 GetNumCommands() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_NumCommands;
+    }
+
+    Uint32 GetNumObjects() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_NextObjectId - 1;
+    }
+
+private:
+    template <typename HandlerType>
+    void WriteChunk(ChunkType Type, HandlerType&& Handler)
+    {
+        // Measure the payload first. Objects that are referenced for the first time are recorded
+        // while measuring, so that their chunks precede the chunk that references them.
+        Serializer<SerializerMode::Measure>              MeasureSer;
+        CommandStreamSerializer<SerializerMode::Measure> Measure{MeasureSer, *this, nullptr};
+        if (!Handler(Measure))
+        {
+            UNEXPECTED("Failed to measure the chunk size");
+            return;
+        }
+
+        const size_t PayloadSize = MeasureSer.GetSize();
+
+        CommandStreamFormat::ChunkHeader Header;
+        Header.Type = Type;
+        Header.Size = StaticCast<Uint32>(PayloadSize);
+
+        const size_t Offset = m_Stream.size();
+        m_Stream.resize(Offset + sizeof(Header) + AlignUp(PayloadSize, CommandStreamFormat::ChunkAlignment));
+        memcpy(&m_Stream[Offset], &Header, sizeof(Header));
+
+        if (PayloadSize > 0)
+        {
+            SerializedData                                 Payload{&m_Stream[Offset + sizeof(Header)], PayloadSize};
+            Serializer<SerializerMode::Write>              WriteSer{Payload};
+            CommandStreamSerializer<SerializerMode::Write> Write{WriteSer, *this, nullptr};
+            if (!Handler(Write))
+                UNEXPECTED("Failed to write the chunk");
+            VERIFY(WriteSer.IsEnded(), "The chunk size does not match the measured size");
+        }
+    }
+
+    template <typename HandlerType>
+    void RecordCommandChunk(ChunkType Type, HandlerType&& Handler)
+    {
+        const Uint64 FrameNumber = m_pContext->GetFrameNumber();
+        if (FrameNumber != m_FrameNumber)
+        {
+            WriteChunk(ChunkType::EndFrame, [](auto&) { return true; });
+            m_FrameNumber = FrameNumber;
+            ++m_NumFrames;
+        }
+
+        WriteChunk(Type, std::forward<HandlerType>(Handler));
+        ++m_NumCommands;
+    }
+
+    Uint32 AddObject(IObject* pObject)
+    {
+        const Uint32 Id = m_NextObjectId++;
+        m_ObjectIds[pObject] = {Id, RefCntWeakPtr<IObject>{pObject}};
+        return Id;
+    }
+
+    Uint32 RecordObject(IObject* pObject)
+    {
+        if (RefCntAutoPtr<ITexture> pTexture{pObject, IID_Texture})
+        {
+            const Uint32 Id = AddObject(pObject);
+            RecordTextureChunk(pTexture, Id, nullptr);
+            return Id;
+        }
+
+        if (RefCntAutoPtr<IBuffer> pBuffer{pObject, IID_Buffer})
+        {
+            const Uint32 Id = AddObject(pObject);
+            RecordBufferChunk(pBuffer, Id, nullptr);
+            return Id;
+        }
+
+        if (RefCntAutoPtr<ITextureView> pView{pObject, IID_TextureView})
+        {
+            ITexture* pTexture = pView->GetTexture();
+            // Record the texture before the view ID is assigned
+            GetObjectId(pTexture);
+            const Uint32 Id = AddObject(pObject);
+            WriteChunk(ChunkType::CreateTextureView,
+                       [&](auto& Ser) {
+                           return Ser(Id) && Ser.SerializeObject(pTexture) && Ser.SerializeTextureViewDesc(pView->GetDesc());
+                       });
+            return Id;
+        }
+
+        if (RefCntAutoPtr<IBufferView> pView{pObject, IID_BufferView})
+        {
+            IBuffer* pBuffer = pView->GetBuffer();
+            GetObjectId(pBuffer);
+            const Uint32 Id = AddObject(pObject);
+            WriteChunk(ChunkType::CreateBufferView,
+                       [&](auto& Ser) {
+                           return Ser(Id) && Ser.SerializeObject(pBuffer) && Ser.SerializeBufferViewDesc(pView->GetDesc());
+                       });
+            return Id;
+        }
+
+        if (RefCntAutoPtr<ISampler> pSampler{pObject, IID_Sampler})
+        {
+            const Uint32 Id = AddObject(pObject);
+            WriteChunk(ChunkType::CreateSampler,
+                       [&](auto& Ser) {
+                           return Ser(Id) && Ser.SerializeSamplerDesc(pSampler->GetDesc());
+                       });
+            return Id;
+        }
+
+        if (RefCntAutoPtr<IShaderResourceBinding> pSRB{pObject, IID_ShaderResourceBinding})
+        {
+            // Shader resource bindings are created from the pipeline they are used with
+            IPipelineState* pPSO  = m_pSRBPipeline;
+            const auto      PSOIt = pPSO != nullptr ? m_ObjectIds.find(pPSO) : m_ObjectIds.end();
+            if (PSOIt != m_ObjectIds.end() && PSOIt->second.Id != 0 && PSOIt->second.wpObject.IsValid())
+            {
+                if (m_PSOsWithStaticBindings.insert(PSOIt->second.Id).second)
+                    RecordStaticBindings(pPSO);
+
+                const Uint32 Id = AddObject(pObject);
+                WriteChunk(ChunkType::CreateShaderResourceBinding,
+                           [&](auto& Ser) {
+                               return Ser(Id) && Ser.SerializeObject(pPSO);
+                           });
+                return Id;
+            }
+        }
+
+        // Objects that can't be recorded (pipelines and shaders created elsewhere, etc.) are mapped to null
+        m_ObjectIds[pObject] = {0, RefCntWeakPtr<IObject>{pObject}};
+        return 0;
+    }
+
+    void RecordBufferChunk(IBuffer* pBuffer, Uint32 Id, const BufferData* pData)
+    {
+        const void*  pInitData = pData != nullptr ? pData->pData : nullptr;
+        const size_t DataSize  = pInitData != nullptr ? StaticCast<size_t>(pData->DataSize) : 0;
+        WriteChunk(ChunkType::CreateBuffer,
+                   [&](auto& Ser) {
+                       return Ser(Id) && Ser.SerializeBufferDesc(pBuffer->GetDesc()) && Ser.SerializeBytes(pInitData, DataSize);
+                   });
+    }
+
+    void RecordTextureChunk(ITexture* pTexture, Uint32 Id, const TextureData* pData)
+    {
+        const TextureDesc& Desc = pTexture->GetDesc();
+
+        Uint32 NumSubresources = pData != nullptr ? pData->NumSubresources : 0;
+        for (Uint32 i = 0; i < NumSubresources; ++i)
+        {
+            if (pData->pSubResources[i].pData == nullptr)
+            {
+                LOG_WARNING_MESSAGE("Initial data of texture '", (Desc.Name != nullptr ? Desc.Name : ""),
+                                    "' is not in CPU memory and will not be recorded.");
+                NumSubresources = 0;
+                break;
+            }
+        }
+
+        WriteChunk(ChunkType::CreateTexture,
+                   [&](auto& Ser) {
+                       if (!(Ser(Id) && Ser.SerializeTextureDesc(Desc) && Ser(NumSubresources)))
+                           return false;
+
+                       for (Uint32 i = 0; i < NumSubresources; ++i)
+                       {
+                           const TextureSubResData& SubRes   = pData->pSubResources[i];
+                           const MipLevelProperties MipProps = GetMipLevelProperties(Desc, i % Desc.MipLevels);
+
+                           const Box    MipBox{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+                           const void*  pSubResData = SubRes.pData;
+                           const size_t DataSize    = GetSubresourceDataSize(Desc.Format, MipBox, SubRes.Stride, SubRes.DepthStride);
+                           if (!(Ser(SubRes.Stride, SubRes.DepthStride) && Ser.SerializeBytes(pSubResData, DataSize)))
+                               return false;
+                       }
+                       return true;
+                   });
+    }
+
+    template <typename SerializerType>
+    bool SerializePipelineCreateInfo(SerializerType& Ser, const GraphicsPipelineStateCreateInfo& CI)
+    {
+        return Ser.SerializeGraphicsPipelineCreateInfo(CI);
+    }
+
+    template <typename SerializerType>
+    bool SerializePipelineCreateInfo(SerializerType& Ser, const ComputePipelineStateCreateInfo& CI)
+    {
+        return Ser.SerializeComputePipelineCreateInfo(CI);
+    }
+
+    bool IsShaderRecorded(IShader* pShader) const
+    {
+        if (pShader == nullptr)
+            return true;
+
+        auto it = m_ObjectIds.find(pShader);
+        return it != m_ObjectIds.end() && it->second.Id != 0 && it->second.wpObject.IsValid();
+    }
+
+    bool AllShadersRecorded(const GraphicsPipelineStateCreateInfo& CI) const
+    {
+        return (IsShaderRecorded(CI.pVS) && IsShaderRecorded(CI.pPS) && IsShaderRecorded(CI.pDS) &&
+                IsShaderRecorded(CI.pHS) && IsShaderRecorded(CI.pGS) && IsShaderRecorded(CI.pAS) &&
+                IsShaderRecorded(CI.pMS));
+    }
+
+    bool AllShadersRecorded(const ComputePipelineStateCreateInfo& CI) const
+    {
+        return IsShaderRecorded(CI.pCS);
+    }
+
+    template <typename GetVariableCountType, typename GetVariableType>
+    void SnapshotBindings(GetVariableCountType&& GetVariableCount, GetVariableType&& GetVariable)
+    {
+        m_Bindings.clear();
+        for (Uint32 Stage = SHADER_TYPE_VERTEX; Stage <= SHADER_TYPE_LAST; Stage <<= 1)
+        {
+            const SHADER_TYPE ShaderType = static_cast<SHADER_TYPE>(Stage);
+
+            const Uint32 NumVars = GetVariableCount(ShaderType);
+            for (Uint32 v = 0; v < NumVars; ++v)
+            {
+                IShaderResourceVariable* pVar = GetVariable(ShaderType, v);
+                if (pVar == nullptr)
+                    continue;
+
+                ShaderResourceDesc ResDesc;
+                pVar->GetResourceDesc(ResDesc);
+                for (Uint32 Elem = 0; Elem < ResDesc.ArraySize; ++Elem)
+                {
+                    if (IDeviceObject* pObject = pVar->Get(Elem))
+                        m_Bindings.push_back({ShaderType, ResDesc.Name, Elem, pObject});
+                }
+            }
+        }
+    }
+
+    void RecordStaticBindings(IPipelineState* pPSO)
+    {
+        SnapshotBindings([pPSO](SHADER_TYPE ShaderType) { return pPSO->GetStaticVariableCount(ShaderType); },
+                         [pPSO](SHADER_TYPE ShaderType, Uint32 Index) { return pPSO->GetStaticVariableByIndex(ShaderType, Index); });
+
+        const ResourceBinding* pBindings   = !m_Bindings.empty() ? m_Bindings.data() : nullptr;
+        const Uint32           NumBindings = StaticCast<Uint32>(m_Bindings.size());
+        WriteChunk(ChunkType::PipelineStaticBindings,
+                   [&](auto& Ser) {
+                       return Ser.SerializeObject(pPSO) && Ser.SerializeBindings(pBindings, NumBindings);
+                   });
+    }
+
+    // Records the resources bound to the SRB if they have changed since the last time.
+    void RecordBindings(IShaderResourceBinding* pSRB, IPipelineState* pPSO)
+    {
+        m_pSRBPipeline       = pPSO;
+        const Uint32 SRBId   = GetObjectId(pSRB);
+        m_pSRBPipeline       = nullptr;
+        if (SRBId == 0)
+            return;
+
+        SnapshotBindings([pSRB](SHADER_TYPE ShaderType) { return pSRB->GetVariableCount(ShaderType); },
+                         [pSRB](SHADER_TYPE ShaderType, Uint32 Index) { return pSRB->GetVariableByIndex(ShaderType, Index); });
+
+        m_BindingIds.clear();
+        for (const ResourceBinding& Binding : m_Bindings)
+            m_BindingIds.push_back(GetObjectId(Binding.pObject));
+
+        std::vector<Uint32>& LastBindingIds = m_SRBBindingIds[SRBId];
+        if (LastBindingIds == m_BindingIds)
+            return;
+        LastBindingIds = m_BindingIds;
+
+        const ResourceBinding* pBindings   = !m_Bindings.empty() ? m_Bindings.data() : nullptr;
+        const Uint32           NumBindings = StaticCast<Uint32>(m_Bindings.size());
+        RecordCommandChunk(ChunkType::ShaderResourceBindings,
+                           [&](auto& Ser) {
+                               return Ser.SerializeObject(pSRB) && Ser.SerializeBindings(pBindings, NumBindings);
+                           });
+    }
+
+private:
+    mutable std::mutex m_Mtx;
+
+    IDeviceContext* const m_pContext;
+
+    std::vector<Uint8> m_Stream;
+
+    struct ObjectInfo
+    {
+        Uint32                 Id = 0;
+        RefCntWeakPtr<IObject> wpObject;
+    };
+    std::unordered_map<IObject*, ObjectInfo> m_ObjectIds;
+
+    Uint32 m_NextObjectId = 1;
+    Uint64 m_FrameNumber  = 0;
+    Uint32 m_NumFrames    = 0;
+    Uint32 m_NumCommands  = 0;
+
+    RefCntAutoPtr<IPipelineState> m_pCurrentPSO;
+
+    // The pipeline of the SRB that is being recorded
+    IPipelineState* m_pSRBPipeline = nullptr;
+
+    std::unordered_set<Uint32> m_PSOsWithStaticBindings;
+
+    // The IDs of the objects that were bound to every SRB when it was last committed
+    std::unordered_map<Uint32, std::vector<Uint32>> m_SRBBindingIds;
+
+    std::vector<ResourceBinding> m_Bindings;
+    std::vector<Uint32>          m_BindingIds;
+
+    struct MappedBufferInfo
+    {
+        void*     pData    = nullptr;
+        MAP_FLAGS MapFlags = MAP_FLAG_NONE;
+    };
+    std::unordered_map<IBuffer*, MappedBufferInfo> m_MappedBuffers;
+};
+
+
+class CommandStreamRecorder::RenderDeviceProxy final : public ObjectBase<IRenderDevice>
+{
+public:
+    using TBase = ObjectBase<IRenderDevice>;
+
+    RenderDeviceProxy(IReferenceCounters* pRefCounters,
+                      IRenderDevice*      pDevice,
+                      IDeviceContext*     pContext,
+                      StreamWriter*       pWriter) :
+        TBase{pRefCounters},
+        m_pDevice{pDevice},
+        m_pContext{pContext},
+        m_pWriter{pWriter}
+    {}
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        if (ppInterface == nullptr)
+            return;
+
+        if (IID == IID_RenderDevice || IID == IID_Unknown)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            // Backend-specific interfaces are provided by the original device
+            m_pDevice->QueryInterface(IID, ppInterface);
+        }
+    }
+
+    void Detach()
+    {
+        m_pWriter = nullptr;
+    }
+
+    void SetContextProxy(IDeviceContext* pContextProxy)
+    {
+        m_pContextProxy = pContextProxy;
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer) override final
+    {
+        BufferData Data;
+        if (pBuffData != nullptr)
+        {
+            Data = *pBuffData;
+            if (Data.pContext == m_pContextProxy)
+                Data.pContext = m_pContext;
+        }
+
+        m_pDevice->CreateBuffer(BuffDesc, pBuffData != nullptr ? &Data : nullptr, ppBuffer);
+        if (m_pWriter != nullptr && *ppBuffer != nullptr)
+            m_pWriter->RecordBuffer(*ppBuffer, pBuffData);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader) override final
+    {
+        m_pDevice->CreateShader(ShaderCI, ppShader);
+        if (m_pWriter != nullptr && *ppShader != nullptr)
+            m_pWriter->RecordShader(*ppShader, ShaderCI);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture) override final
+    {
+        TextureData Data;
+        if (pData != nullptr)
+        {
+            Data = *pData;
+            if (Data.pContext == m_pContextProxy)
+                Data.pContext = m_pContext;
+        }
+
+        m_pDevice->CreateTexture(TexDesc, pData != nullptr ? &Data : nullptr, ppTexture);
+        if (m_pWriter != nullptr && *ppTexture != nullptr)
+            m_pWriter->RecordTexture(*ppTexture, pData);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateSampler(const SamplerDesc& SamDesc, ISampler** ppSampler) override final
+    {
+        m_pDevice->CreateSampler(SamDesc, ppSampler);
+        if (m_pWriter != nullptr && *ppSampler != nullptr)
+            m_pWriter->RecordSampler(*ppSampler);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateResourceMapping(const ResourceMappingDesc& MappingDesc, IResourceMapping** ppMapping) override final
+    {
+        m_pDevice->CreateResourceMapping(MappingDesc, ppMapping);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPipelineState);
+        if (m_pWriter == nullptr || *ppPipelineState == nullptr)
+            return;
+
+        if (PSOCreateInfo.GraphicsPipeline.pRenderPass != nullptr)
+        {
+            LOG_WARNING_MESSAGE("Pipeline state '", (PSOCreateInfo.PSODesc.Name != nullptr ? PSOCreateInfo.PSODesc.Name : ""),
+                                "' uses a render pass and will not be recorded.");
+            return;
+        }
+        m_pWriter->RecordPipelineState(*ppPipelineState, PSOCreateInfo);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateDerivedGraphicsPipelineState(const DerivedGraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateDerivedGraphicsPipelineState(CreateInfo, ppPipelineState);
+        if (m_pWriter != nullptr && *ppPipelineState != nullptr)
+        {
+            LOG_WARNING_MESSAGE("Derived pipeline state '", (*ppPipelineState)->GetDesc().Name, "' will not be recorded.");
+        }
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateComputePipelineState(PSOCreateInfo, ppPipelineState);
+        if (m_pWriter != nullptr && *ppPipelineState != nullptr)
+            m_pWriter->RecordPipelineState(*ppPipelineState, PSOCreateInfo);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateRayTracingPipelineState(PSOCreateInfo, ppPipelineState);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateTilePipelineState(const TilePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateTilePipelineState(PSOCreateInfo, ppPipelineState);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateWorkGraphPipelineState(const WorkGraphPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final
+    {
+        m_pDevice->CreateWorkGraphPipelineState(PSOCreateInfo, ppPipelineState);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateFence(const FenceDesc& Desc, IFence** ppFence) override final
+    {
+        m_pDevice->CreateFence(Desc, ppFence);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateQuery(const QueryDesc& Desc, IQuery** ppQuery) override final
+    {
+        m_pDevice->CreateQuery(Desc, ppQuery);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass) override final
+    {
+        m_pDevice->CreateRenderPass(Desc, ppRenderPass);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateFramebuffer(const FramebufferDesc& Desc, IFramebuffer** ppFramebuffer) override final
+    {
+        m_pDevice->CreateFramebuffer(Desc, ppFramebuffer);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateBLAS(const BottomLevelASDesc& Desc, IBottomLevelAS** ppBLAS) override final
+    {
+        m_pDevice->CreateBLAS(Desc, ppBLAS);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateTLAS(const TopLevelASDesc& Desc, ITopLevelAS** ppTLAS) override final
+    {
+        m_pDevice->CreateTLAS(Desc, ppTLAS);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateSBT(const ShaderBindingTableDesc& Desc, IShaderBindingTable** ppSBT) override final
+    {
+        m_pDevice->CreateSBT(Desc, ppSBT);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreatePipelineResourceSignature(const PipelineResourceSignatureDesc& Desc, IPipelineResourceSignature** ppSignature) override final
+    {
+        m_pDevice->CreatePipelineResourceSignature(Desc, ppSignature);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateDeviceMemory(const DeviceMemoryCreateInfo& CreateInfo, IDeviceMemory** ppMemory) override final
+    {
+        m_pDevice->CreateDeviceMemory(CreateInfo, ppMemory);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo, IPipelineStateCache** ppPSOCache) override final
+    {
+        m_pDevice->CreatePipelineStateCache(CreateInfo, ppPSOCache);
+    }
+
+    virtual const RenderDeviceInfo& DILIGENT_CALL_TYPE GetDeviceInfo() const override final
+    {
+        return m_pDevice->GetDeviceInfo();
+    }
+
+    virtual const GraphicsAdapterInfo& DILIGENT_CALL_TYPE GetAdapterInfo() const override final
+    {
+        return m_pDevice->GetAdapterInfo();
+    }
+
+    virtual const TextureFormatInfo& DILIGENT_CALL_TYPE GetTextureFormatInfo(TEXTURE_FORMAT TexFormat) override final
+    {
+        return m_pDevice->GetTextureFormatInfo(TexFormat);
+    }
+
+    virtual const TextureFormatInfoExt& DILIGENT_CALL_TYPE GetTextureFormatInfoExt(TEXTURE_FORMAT TexFormat) override final
+    {
+        return m_pDevice->GetTextureFormatInfoExt(TexFormat);
+    }
+
+    virtual SparseTextureFormatInfo DILIGENT_CALL_TYPE GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
+                                                                                  RESOURCE_DIMENSION Dimension,
+                                                                                  Uint32             SampleCount) const override final
+    {
+        return m_pDevice->GetSparseTextureFormatInfo(TexFormat, Dimension, SampleCount);
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(Bool ForceRelease) override final
+    {
+        m_pDevice->ReleaseStaleResources(ForceRelease);
+    }
+
+    virtual void DILIGENT_CALL_TYPE IdleGPU() override final
+    {
+        m_pDevice->IdleGPU();
+    }
+
+    virtual IEngineFactory* DILIGENT_CALL_TYPE GetEngineFactory() const override final
+    {
+        return m_pDevice->GetEngineFactory();
+    }
+
+    virtual ICompilationStatistics* DILIGENT_CALL_TYPE GetCompilationStatistics() const override final
+    {
+        return m_pDevice->GetCompilationStatistics();
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE GetMemoryAllocationStatistics(MemoryAllocationStatistics& Stats) const override final
+    {
+        return m_pDevice->GetMemoryAllocationStatistics(Stats);
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE GetGPUMemoryStatistics(GPUMemoryStatistics& Stats) const override final
+    {
+        return m_pDevice->GetGPUMemoryStatistics(Stats);
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetGPUMemoryAllocations(GPUMemoryAllocationInfo* pAllocations, Uint32 MaxAllocations) const override final
+    {
+        return m_pDevice->GetGPUMemoryAllocations(pAllocations, MaxAllocations);
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetGPUMemoryReport(IDataBlob** ppReport) const override final
+    {
+        m_pDevice->GetGPUMemoryReport(ppReport);
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE GetMetrics(DeviceMetrics& Metrics) const override final
+    {
+        return m_pDevice->GetMetrics(Metrics);
+    }
+
+    virtual void DILIGENT_CALL_TYPE ResetMetrics() override final
+    {
+        m_pDevice->ResetMetrics();
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetStatistics(DeviceStatistics& Stats) const override final
+    {
+        m_pDevice->GetStatistics(Stats);
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetStartupStatistics(DeviceStartupStatistics& Stats) const override final
+    {
+        m_pDevice->GetStartupStatistics(Stats);
+    }
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    // Weak reference to avoid a cycle; only used to replace the recording context with the original one
+    IDeviceContext* m_pContextProxy = nullptr;
+    StreamWriter*   m_pWriter;
+};
+
+
+#define LOG_COMMAND_NOT_RECORDED(Command)                                                                              \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (m_pWriter != nullptr)                                                                                      \
+            LOG_WARNING_MESSAGE_ONCE(Command " is not supported by the command stream recorder and is not recorded."); \
+    } while (false)
+
+class CommandStreamRecorder::DeviceContextProxy final : public ObjectBase<IDeviceContext>
+{
+public:
+    using TBase     = ObjectBase<IDeviceContext>;
+    using ChunkType = CommandStreamFormat::ChunkType;
+
+    DeviceContextProxy(IReferenceCounters* pRefCounters,
+                       IDeviceContext*     pContext,
+                       StreamWriter*       pWriter) :
+        TBase{pRefCounters},
+        m_pContext{pContext},
+        m_pWriter{pWriter}
+    {}
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        if (ppInterface == nullptr)
+            return;
+
+        if (IID == IID_DeviceContext || IID == IID_Unknown)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            // Backend-specific interfaces are provided by the original context
+            m_pContext->QueryInterface(IID, ppInterface);
+        }
+    }
+
+    void Detach()
+    {
+        m_pWriter = nullptr;
+    }
+
+    template <typename HandlerType>
+    void Record(ChunkType Type, HandlerType&& Handler)
+    {
+        if (m_pWriter != nullptr)
+            m_pWriter->RecordCommand(Type, std::forward<HandlerType>(Handler));
+    }
+
+    virtual const DeviceContextDesc& DILIGENT_CALL_TYPE GetDesc() const override final
+    {
+        return m_pContext->GetDesc();
+    }
+
+    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final
+    {
+        m_pContext->Begin(ImmediateContextId);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final
+    {
+        m_pContext->SetPipelineState(pPipelineState);
+        if (m_pWriter != nullptr)
+            m_pWriter->RecordSetPipelineState(pPipelineState);
+    }
+
+    virtual void DILIGENT_CALL_TYPE TransitionShaderResources(IPipelineState* pPipelineState, IShaderResourceBinding* pShaderResourceBinding) override final
+    {
+        m_pContext->TransitionShaderResources(pPipelineState, pShaderResourceBinding);
+        if (m_pWriter != nullptr)
+            m_pWriter->RecordTransitionShaderResources(pPipelineState, pShaderResourceBinding);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->CommitShaderResources(pShaderResourceBinding, StateTransitionMode);
+        if (m_pWriter != nullptr)
+            m_pWriter->RecordCommitShaderResources(pShaderResourceBinding, StateTransitionMode);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(IShaderResourceVariable* pVariable, const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants) override final
+    {
+        m_pContext->SetInlineConstants(pVariable, pConstants, FirstConstant, NumConstants);
+        LOG_COMMAND_NOT_RECORDED("SetInlineConstants");
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final
+    {
+        m_pContext->SetStencilRef(StencilRef);
+        Record(ChunkType::SetStencilRef, [&](auto& Ser) { return Ser(StencilRef); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetBlendFactors(const float* pBlendFactors) override final
+    {
+        m_pContext->SetBlendFactors(pBlendFactors);
+        Record(ChunkType::SetBlendFactors, [&](auto& Ser) { return Ser.SerializeFloat4(pBlendFactors); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
+                                                     Uint32                         NumBuffersSet,
+                                                     IBuffer**                      ppBuffers,
+                                                     const Uint64*                  pOffsets,
+                                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                                     SET_VERTEX_BUFFERS_FLAGS       Flags) override final
+    {
+        m_pContext->SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+        Record(ChunkType::SetVertexBuffers,
+               [&](auto& Ser) {
+                   if (!Ser(StartSlot, NumBuffersSet, StateTransitionMode, Flags))
+                       return false;
+
+                   const Uint8 HasOffsets = pOffsets != nullptr ? 1 : 0;
+                   if (!Ser(HasOffsets))
+                       return false;
+
+                   for (Uint32 i = 0; i < NumBuffersSet; ++i)
+                   {
+                       IBuffer*     pBuffer = ppBuffers != nullptr ? ppBuffers[i] : nullptr;
+                       const Uint64 Offset  = pOffsets != nullptr ? pOffsets[i] : 0;
+                       if (!Ser.SerializeObject(pBuffer) || (HasOffsets && !Ser(Offset)))
+                           return false;
+                   }
+                   return true;
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE InvalidateState() override final
+    {
+        m_pContext->InvalidateState();
+        Record(ChunkType::InvalidateState, [](auto&) { return true; });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+        Record(ChunkType::SetIndexBuffer, [&](auto& Ser) { return Ser.SerializeObject(pIndexBuffer) && Ser(ByteOffset, StateTransitionMode); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight) override final
+    {
+        m_pContext->SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+        Record(ChunkType::SetViewports,
+               [&](auto& Ser) {
+                   // A single null viewport sets the viewport that covers the entire render target
+                   const Uint32 NumViewportsSet = pViewports != nullptr ? NumViewports : 0;
+                   return Ser(NumViewports, RTWidth, RTHeight) && Ser.SerializeViewports(pViewports, NumViewportsSet);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight) override final
+    {
+        m_pContext->SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+        Record(ChunkType::SetScissorRects,
+               [&](auto& Ser) {
+                   const Uint32 NumRectsSet = pRects != nullptr ? NumRects : 0;
+                   return Ser(NumRects, RTWidth, RTHeight) && Ser.SerializeRects(pRects, NumRectsSet);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetRenderTargets(Uint32                         NumRenderTargets,
+                                                     ITextureView*                  ppRenderTargets[],
+                                                     ITextureView*                  pDepthStencil,
+                                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil, StateTransitionMode);
+
+        SetRenderTargetsAttribs Attribs;
+        Attribs.NumRenderTargets    = ppRenderTargets != nullptr ? NumRenderTargets : 0;
+        Attribs.ppRenderTargets     = ppRenderTargets;
+        Attribs.pDepthStencil       = pDepthStencil;
+        Attribs.StateTransitionMode = StateTransitionMode;
+        Record(ChunkType::SetRenderTargets, [&](auto& Ser) { return Ser.SerializeSetRenderTargetsAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs) override final
+    {
+        m_pContext->SetRenderTargetsExt(Attribs);
+        Record(ChunkType::SetRenderTargets, [&](auto& Ser) { return Ser.SerializeSetRenderTargetsAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE BeginRenderPass(const BeginRenderPassAttribs& Attribs) override final
+    {
+        m_pContext->BeginRenderPass(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BeginRenderPass");
+    }
+
+    virtual void DILIGENT_CALL_TYPE NextSubpass() override final
+    {
+        m_pContext->NextSubpass();
+        LOG_COMMAND_NOT_RECORDED("NextSubpass");
+    }
+
+    virtual void DILIGENT_CALL_TYPE EndRenderPass() override final
+    {
+        m_pContext->EndRenderPass();
+        LOG_COMMAND_NOT_RECORDED("EndRenderPass");
+    }
+
+    virtual void DILIGENT_CALL_TYPE Draw(const DrawAttribs& Attribs) override final
+    {
+        m_pContext->Draw(Attribs);
+        Record(ChunkType::Draw, [&](auto& Ser) { return Ser.SerializeDrawAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DrawIndexed(const DrawIndexedAttribs& Attribs) override final
+    {
+        m_pContext->DrawIndexed(Attribs);
+        Record(ChunkType::DrawIndexed, [&](auto& Ser) { return Ser.SerializeDrawIndexedAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DrawIndirect(const DrawIndirectAttribs& Attribs) override final
+    {
+        m_pContext->DrawIndirect(Attribs);
+        Record(ChunkType::DrawIndirect, [&](auto& Ser) { return Ser.SerializeDrawIndirectAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs) override final
+    {
+        m_pContext->DrawIndexedIndirect(Attribs);
+        Record(ChunkType::DrawIndexedIndirect, [&](auto& Ser) { return Ser.SerializeDrawIndexedIndirectAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DrawMesh(const DrawMeshAttribs& Attribs) override final
+    {
+        m_pContext->DrawMesh(Attribs);
+        LOG_COMMAND_NOT_RECORDED("DrawMesh");
+    }
+
+    virtual void DILIGENT_CALL_TYPE DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs) override final
+    {
+        m_pContext->DrawMeshIndirect(Attribs);
+        LOG_COMMAND_NOT_RECORDED("DrawMeshIndirect");
+    }
+
+    virtual void DILIGENT_CALL_TYPE SubmitDrawPackets(const DrawPacket*              pPackets,
+                                                      Uint32                         NumPackets,
+                                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                                      SUBMIT_DRAW_PACKETS_FLAGS      Flags) override final
+    {
+        m_pContext->SubmitDrawPackets(pPackets, NumPackets, StateTransitionMode, Flags);
+        LOG_COMMAND_NOT_RECORDED("SubmitDrawPackets");
+    }
+
+    virtual void DILIGENT_CALL_TYPE DispatchCompute(const DispatchComputeAttribs& Attribs) override final
+    {
+        m_pContext->DispatchCompute(Attribs);
+        Record(ChunkType::DispatchCompute, [&](auto& Ser) { return Ser.SerializeDispatchComputeAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs) override final
+    {
+        m_pContext->DispatchComputeIndirect(Attribs);
+        Record(ChunkType::DispatchComputeIndirect, [&](auto& Ser) { return Ser.SerializeDispatchComputeIndirectAttribs(Attribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE DispatchTile(const DispatchTileAttribs& Attribs) override final
+    {
+        m_pContext->DispatchTile(Attribs);
+        LOG_COMMAND_NOT_RECORDED("DispatchTile");
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetTileSize(Uint32& TileSizeX, Uint32& TileSizeY) override final
+    {
+        m_pContext->GetTileSize(TileSizeX, TileSizeY);
+    }
+
+    virtual void DILIGENT_CALL_TYPE DispatchGraph(const DispatchGraphAttribs& Attribs) override final
+    {
+        m_pContext->DispatchGraph(Attribs);
+        LOG_COMMAND_NOT_RECORDED("DispatchGraph");
+    }
+
+    virtual void DILIGENT_CALL_TYPE ClearDepthStencil(ITextureView*                  pView,
+                                                      CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                                      float                          fDepth,
+                                                      Uint8                          Stencil,
+                                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->ClearDepthStencil(pView, ClearFlags, fDepth, Stencil, StateTransitionMode);
+        Record(ChunkType::ClearDepthStencil,
+               [&](auto& Ser) {
+                   return Ser.SerializeObject(pView) && Ser(ClearFlags, fDepth, Stencil, StateTransitionMode);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->ClearRenderTarget(pView, RGBA, StateTransitionMode);
+        Record(ChunkType::ClearRenderTarget,
+               [&](auto& Ser) {
+                   return Ser.SerializeObject(pView) && Ser.SerializeFloat4(RGBA) && Ser(StateTransitionMode);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE FinishCommandList(ICommandList** ppCommandList) override final
+    {
+        m_pContext->FinishCommandList(ppCommandList);
+        LOG_COMMAND_NOT_RECORDED("FinishCommandList");
+    }
+
+    virtual void DILIGENT_CALL_TYPE ExecuteCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists) override final
+    {
+        m_pContext->ExecuteCommandLists(NumCommandLists, ppCommandLists);
+        LOG_COMMAND_NOT_RECORDED("ExecuteCommandLists");
+    }
+
+    virtual void DILIGENT_CALL_TYPE EnqueueSignal(IFence* pFence, Uint64 Value) override final
+    {
+        m_pContext->EnqueueSignal(pFence, Value);
+    }
+
+    virtual void DILIGENT_CALL_TYPE DeviceWaitForFence(IFence* pFence, Uint64 Value) override final
+    {
+        m_pContext->DeviceWaitForFence(pFence, Value);
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForIdle() override final
+    {
+        m_pContext->WaitForIdle();
+        Record(ChunkType::WaitForIdle, [](auto&) { return true; });
+    }
+
+    virtual void DILIGENT_CALL_TYPE BeginQuery(IQuery* pQuery) override final
+    {
+        m_pContext->BeginQuery(pQuery);
+    }
+
+    virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final
+    {
+        m_pContext->EndQuery(pQuery);
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetQueryData(Uint32         NumQueries,
+                                                   IQuery* const* ppQueries,
+                                                   void*          pData,
+                                                   Uint32         DataSize,
+                                                   Bool*          pDataAvailable,
+                                                   Bool           AutoInvalidate) override final
+    {
+        return m_pContext->GetQueryData(NumQueries, ppQueries, pData, DataSize, pDataAvailable, AutoInvalidate);
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final
+    {
+        return m_pContext->GetTimestampCalibration(Calibration);
+    }
+
+    virtual void DILIGENT_CALL_TYPE Flush() override final
+    {
+        m_pContext->Flush();
+        Record(ChunkType::Flush, [](auto&) { return true; });
+    }
+
+    virtual void DILIGENT_CALL_TYPE UpdateBuffer(IBuffer*                       pBuffer,
+                                                 Uint64                         Offset,
+                                                 Uint64                         Size,
+                                                 const void*                    pData,
+                                                 RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final
+    {
+        m_pContext->UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+        Record(ChunkType::UpdateBuffer,
+               [&](auto& Ser) {
+                   const size_t DataSize = StaticCast<size_t>(Size);
+                   return Ser.SerializeObject(pBuffer) && Ser(Offset, StateTransitionMode) && Ser.SerializeBytes(pData, DataSize);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE CopyBuffer(IBuffer*                       pSrcBuffer,
+                                               Uint64                         SrcOffset,
+                                               RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                               IBuffer*                       pDstBuffer,
+                                               Uint64                         DstOffset,
+                                               Uint64                         Size,
+                                               RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode) override final
+    {
+        m_pContext->CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+        Record(ChunkType::CopyBuffer,
+               [&](auto& Ser) {
+                   return Ser.SerializeObject(pSrcBuffer) && Ser(SrcOffset, SrcBufferTransitionMode) &&
+                       Ser.SerializeObject(pDstBuffer) && Ser(DstOffset, Size, DstBufferTransitionMode);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData) override final
+    {
+        m_pContext->MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+        if (m_pWriter != nullptr)
+            m_pWriter->OnMapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+    }
+
+    virtual void DILIGENT_CALL_TYPE UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType) override final
+    {
+        // Record the contents before the memory becomes inaccessible
+        if (m_pWriter != nullptr)
+            m_pWriter->OnUnmapBuffer(pBuffer, MapType);
+        m_pContext->UnmapBuffer(pBuffer, MapType);
+    }
+
+    virtual void DILIGENT_CALL_TYPE UpdateTexture(ITexture*                      pTexture,
+                                                  Uint32                         MipLevel,
+                                                  Uint32                         Slice,
+                                                  const Box&                     DstBox,
+                                                  const TextureSubResData&       SubresData,
+                                                  RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                                  RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final
+    {
+        m_pContext->UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferTransitionMode, TextureTransitionMode);
+        if (SubresData.pData == nullptr)
+        {
+            LOG_COMMAND_NOT_RECORDED("UpdateTexture from a GPU buffer");
+            return;
+        }
+
+        Record(ChunkType::UpdateTexture,
+               [&](auto& Ser) {
+                   const void*  pData    = SubresData.pData;
+                   const size_t DataSize = GetSubresourceDataSize(pTexture->GetDesc().Format, DstBox, SubresData.Stride, SubresData.DepthStride);
+                   return Ser.SerializeObject(pTexture) && Ser(MipLevel, Slice) && Ser.SerializeBox(DstBox) &&
+                       Ser(SubresData.Stride, SubresData.DepthStride, TextureTransitionMode) && Ser.SerializeBytes(pData, DataSize);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final
+    {
+        m_pContext->CopyTexture(CopyAttribs);
+        Record(ChunkType::CopyTexture, [&](auto& Ser) { return Ser.SerializeCopyTextureAttribs(CopyAttribs); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE MapTextureSubresource(ITexture*                 pTexture,
+                                                          Uint32                    MipLevel,
+                                                          Uint32                    ArraySlice,
+                                                          MAP_TYPE                  MapType,
+                                                          MAP_FLAGS                 MapFlags,
+                                                          const Box*                pMapRegion,
+                                                          MappedTextureSubresource& MappedData) override final
+    {
+        m_pContext->MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
+        LOG_COMMAND_NOT_RECORDED("MapTextureSubresource");
+    }
+
+    virtual void DILIGENT_CALL_TYPE UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice) override final
+    {
+        m_pContext->UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
+    }
+
+    virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTextureView) override final
+    {
+        m_pContext->GenerateMips(pTextureView);
+        Record(ChunkType::GenerateMips, [&](auto& Ser) { return Ser.SerializeObject(pTextureView); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE FinishFrame() override final
+    {
+        // Frame boundaries are recorded from the frame number, see StreamWriter::RecordCommandChunk()
+        m_pContext->FinishFrame();
+    }
+
+    virtual Uint64 DILIGENT_CALL_TYPE GetFrameNumber() const override final
+    {
+        return m_pContext->GetFrameNumber();
+    }
+
+    virtual void DILIGENT_CALL_TYPE TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers) override final
+    {
+        m_pContext->TransitionResourceStates(BarrierCount, pResourceBarriers);
+        Record(ChunkType::TransitionResourceStates,
+               [&](auto& Ser) {
+                   const Uint32 NumBarriers = pResourceBarriers != nullptr ? BarrierCount : 0;
+                   return Ser.SerializeStateTransitions(pResourceBarriers, NumBarriers);
+               });
+    }
+
+    virtual void DILIGENT_CALL_TYPE ResolveTextureSubresource(ITexture*                               pSrcTexture,
+                                                              ITexture*                               pDstTexture,
+                                                              const ResolveTextureSubresourceAttribs& ResolveAttribs) override final
+    {
+        m_pContext->ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+        LOG_COMMAND_NOT_RECORDED("ResolveTextureSubresource");
+    }
+
+    virtual void DILIGENT_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final
+    {
+        m_pContext->BuildBLAS(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BuildBLAS");
+    }
+
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final
+    {
+        m_pContext->BuildBLASBatch(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BuildBLASBatch");
+    }
+
+    virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final
+    {
+        m_pContext->BuildTLAS(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BuildTLAS");
+    }
+
+    virtual void DILIGENT_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final
+    {
+        m_pContext->CopyBLAS(Attribs);
+        LOG_COMMAND_NOT_RECORDED("CopyBLAS");
+    }
+
+    virtual void DILIGENT_CALL_TYPE CopyTLAS(const CopyTLASAttribs& Attribs) override final
+    {
+        m_pContext->CopyTLAS(Attribs);
+        LOG_COMMAND_NOT_RECORDED("CopyTLAS");
+    }
+
+    virtual void DILIGENT_CALL_TYPE WriteBLASCompactedSize(const WriteBLASCompactedSizeAttribs& Attribs) override final
+    {
+        m_pContext->WriteBLASCompactedSize(Attribs);
+        LOG_COMMAND_NOT_RECORDED("WriteBLASCompactedSize");
+    }
+
+    virtual void DILIGENT_CALL_TYPE WriteTLASCompactedSize(const WriteTLASCompactedSizeAttribs& Attribs) override final
+    {
+        m_pContext->WriteTLASCompactedSize(Attribs);
+        LOG_COMMAND_NOT_RECORDED("WriteTLASCompactedSize");
+    }
+
+    virtual void DILIGENT_CALL_TYPE TraceRays(const TraceRaysAttribs& Attribs) override final
+    {
+        m_pContext->TraceRays(Attribs);
+        LOG_COMMAND_NOT_RECORDED("TraceRays");
+    }
+
+    virtual void DILIGENT_CALL_TYPE TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs) override final
+    {
+        m_pContext->TraceRaysIndirect(Attribs);
+        LOG_COMMAND_NOT_RECORDED("TraceRaysIndirect");
+    }
+
+    virtual void DILIGENT_CALL_TYPE UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs) override final
+    {
+        m_pContext->UpdateSBT(pSBT, pUpdateIndirectBufferAttribs);
+        LOG_COMMAND_NOT_RECORDED("UpdateSBT");
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override final
+    {
+        m_pContext->SetUserData(pUserData);
+    }
+
+    virtual IObject* DILIGENT_CALL_TYPE GetUserData() const override final
+    {
+        return m_pContext->GetUserData();
+    }
+
+    virtual void DILIGENT_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final
+    {
+        m_pContext->BeginDebugGroup(Name, pColor);
+        Record(ChunkType::BeginDebugGroup, [&](auto& Ser) { return Ser(Name) && Ser.SerializeFloat4(pColor); });
+    }
+
+    virtual void DILIGENT_CALL_TYPE EndDebugGroup() override final
+    {
+        m_pContext->EndDebugGroup();
+        Record(ChunkType::EndDebugGroup, [](auto&) { return true; });
+    }
+
+    virtual void DILIGENT_CALL_TYPE InsertDebugLabel(const Char* Label, const float* pColor) override final
+    {
+        m_pContext->InsertDebugLabel(Label, pColor);
+        Record(ChunkType::InsertDebugLabel, [&](auto& Ser) { return Ser(Label) && Ser.SerializeFloat4(pColor); });
+    }
+
+    virtual ICommandQueue* DILIGENT_CALL_TYPE LockCommandQueue() override final
+    {
+        return m_pContext->LockCommandQueue();
+    }
+
+    virtual void DILIGENT_CALL_TYPE UnlockCommandQueue() override final
+    {
+        m_pContext->UnlockCommandQueue();
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetShadingRate(SHADING_RATE BaseRate, SHADING_RATE_COMBINER PrimitiveCombiner, SHADING_RATE_COMBINER TextureCombiner) override final
+    {
+        m_pContext->SetShadingRate(BaseRate, PrimitiveCombiner, TextureCombiner);
+        LOG_COMMAND_NOT_RECORDED("SetShadingRate");
+    }
+
+    virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final
+    {
+        m_pContext->BindSparseResourceMemory(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BindSparseResourceMemory");
+    }
+
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final
+    {
+        m_pContext->BeginConditionalRendering(Attribs);
+        LOG_COMMAND_NOT_RECORDED("BeginConditionalRendering");
+    }
+
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final
+    {
+        m_pContext->EndConditionalRendering();
+        LOG_COMMAND_NOT_RECORDED("EndConditionalRendering");
+    }
+
+    virtual const DeviceContextStateFilterStats& DILIGENT_CALL_TYPE GetStateFilterStats() const override final
+    {
+        return m_pContext->GetStateFilterStats();
+    }
+
+    virtual const DeviceContextStatistics& DILIGENT_CALL_TYPE GetStatistics() const override final
+    {
+        return m_pContext->GetStatistics();
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetDebugGroupProfiling(Bool Enable) override final
+    {
+        m_pContext->SetDebugGroupProfiling(Enable);
+    }
+
+    virtual const DebugGroupProfile* DILIGENT_CALL_TYPE GetDebugGroupProfile(Uint32& NumGroups) const override final
+    {
+        return m_pContext->GetDebugGroupProfile(NumGroups);
+    }
+
+    virtual void DILIGENT_CALL_TYPE SetCommandValidation(Bool Enable) override final
+    {
+        m_pContext->SetCommandValidation(Enable);
+    }
+
+private:
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    StreamWriter*                 m_pWriter;
+};
+
+#undef LOG_COMMAND_NOT_RECORDED
+
+
+CommandStreamRecorder::CommandStreamRecorder(const CreateInfo& CI)
+{
+    if (CI.pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (CI.pContext == nullptr)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+    if (CI.pContext->GetDesc().IsDeferred)
+        LOG_ERROR_AND_THROW("Only immediate device contexts can be recorded");
+
+    m_pWriter       = std::make_unique<StreamWriter>(CI.pContext);
+    m_pContextProxy = MakeNewRCObj<DeviceContextProxy>()(CI.pContext, m_pWriter.get());
+    m_pDeviceProxy  = MakeNewRCObj<RenderDeviceProxy>()(CI.pDevice, CI.pContext, m_pWriter.get());
+    m_pDeviceProxy->SetContextProxy(m_pContextProxy);
+}
+
+CommandStreamRecorder::~CommandStreamRecorder()
+{
+    // The application may still hold references to the proxies
+    if (m_pDeviceProxy)
+        m_pDeviceProxy->Detach();
+    if (m_pContextProxy)
+        m_pContextProxy->Detach();
+}
+
+IRenderDevice* CommandStreamRecorder::GetDevice() const
+{
+    return m_pDeviceProxy.RawPtr<IRenderDevice>();
+}
+
+IDeviceContext* CommandStreamRecorder::GetContext() const
+{
+    return m_pContextProxy.RawPtr<IDeviceContext>();
+}
+
+std::vector<Uint8> CommandStreamRecorder::GetStream() const
+{
+    return m_pWriter->GetStream();
+}
+
+bool CommandStreamRecorder::SaveToFile(const Char* FilePath) const
+{
+    const std::vector<Uint8> Stream = GetStream();
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file '", FilePath, "' for writing");
+        return false;
+    }
+
+    if (!File->Write(Stream.data(), Stream.size()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write command stream to file '", FilePath, "'");
+        return false;
+    }
+
+    return true;
+}
+
+Uint32 CommandStreamRecorder::GetNumFrames() const
+{
+    return m_pWriter->GetNumFrames();
+}
+
+Uint32 CommandStreamRecorder::GetNumCommands() const
+{
+    return m_pWriter->GetNumCommands();
+}
+
+Uint32 CommandStreamRecorder::GetNumObjects() const
+{
+    return m_pWriter->GetNumObjects();
+}
+
+} // namespace Diligent
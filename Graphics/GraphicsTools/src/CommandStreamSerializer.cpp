@@ -0,0 +1,415 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandStreamSerializer.hpp"
+
+#include "PSOSerializer.hpp"
+
+namespace Diligent
+{
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeBufferDesc(ConstQual<BufferDesc>& Desc)
+{
+    return m_Ser(Desc.Name,
+                 Desc.Size,
+                 Desc.BindFlags,
+                 Desc.Usage,
+                 Desc.CPUAccessFlags,
+                 Desc.Mode,
+                 Desc.MiscFlags,
+                 Desc.ElementByteStride,
+                 Desc.ImmediateContextMask);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeBufferViewDesc(ConstQual<BufferViewDesc>& Desc)
+{
+    return m_Ser(Desc.Name,
+                 Desc.ViewType,
+                 Desc.Format.ValueType,
+                 Desc.Format.NumComponents,
+                 Desc.Format.IsNormalized,
+                 Desc.ByteOffset,
+                 Desc.ByteWidth);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeTextureDesc(ConstQual<TextureDesc>& Desc)
+{
+    return m_Ser(Desc.Name,
+                 Desc.Type,
+                 Desc.Width,
+                 Desc.Height,
+                 Desc.ArraySize, // Same as Depth
+                 Desc.Format,
+                 Desc.MipLevels,
+                 Desc.SampleCount,
+                 Desc.BindFlags,
+                 Desc.Usage,
+                 Desc.CPUAccessFlags,
+                 Desc.MiscFlags,
+                 Desc.ClearValue.Format,
+                 Desc.ClearValue.Color,
+                 Desc.ClearValue.DepthStencil.Depth,
+                 Desc.ClearValue.DepthStencil.Stencil,
+                 Desc.ImmediateContextMask);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeTextureViewDesc(ConstQual<TextureViewDesc>& Desc)
+{
+    return m_Ser(Desc.Name,
+                 Desc.ViewType,
+                 Desc.TextureDim,
+                 Desc.Format,
+                 Desc.MostDetailedMip,
+                 Desc.NumMipLevels,
+                 Desc.FirstArraySlice, // Same as FirstDepthSlice
+                 Desc.NumArraySlices,  // Same as NumDepthSlices
+                 Desc.AccessFlags,
+                 Desc.Flags);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeSamplerDesc(ConstQual<SamplerDesc>& Desc)
+{
+    return m_Ser(Desc.Name,
+                 Desc.MinFilter,
+                 Desc.MagFilter,
+                 Desc.MipFilter,
+                 Desc.AddressU,
+                 Desc.AddressV,
+                 Desc.AddressW,
+                 Desc.Flags,
+                 Desc.UnnormalizedCoords,
+                 Desc.MipLODBias,
+                 Desc.MaxAnisotropy,
+                 Desc.ComparisonFunc,
+                 Desc.BorderColor,
+                 Desc.MinLOD,
+                 Desc.MaxLOD);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeShaderMacros(ConstQual<const ShaderMacro*>& Macros)
+{
+    Uint32 NumMacros = 0;
+    if (Macros != nullptr)
+    {
+        while (Macros[NumMacros].Name != nullptr)
+            ++NumMacros;
+    }
+
+    if (!m_Ser(NumMacros))
+        return false;
+
+    for (Uint32 i = 0; i < NumMacros; ++i)
+    {
+        if (!m_Ser(Macros[i].Name, Macros[i].Definition))
+            return false;
+    }
+    return true;
+}
+
+template <>
+bool CommandStreamSerializer<SerializerMode::Read>::SerializeShaderMacros(ConstQual<const ShaderMacro*>& Macros)
+{
+    Uint32 NumMacros = 0;
+    if (!m_Ser(NumMacros))
+        return false;
+
+    Macros = nullptr;
+    if (NumMacros == 0)
+        return true;
+
+    // The array is terminated with an empty macro
+    ShaderMacro* pMacros = m_Allocator->ConstructArray<ShaderMacro>(NumMacros + 1);
+    for (Uint32 i = 0; i < NumMacros; ++i)
+    {
+        if (!m_Ser(pMacros[i].Name, pMacros[i].Definition))
+            return false;
+    }
+    Macros = pMacros;
+    return true;
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeShaderCreateInfo(ConstQual<ShaderCreateInfo>& CI)
+{
+    return ShaderSerializer<Mode>::SerializeCI(m_Ser, CI) &&
+        SerializeShaderMacros(CI.Macros) &&
+        m_Ser(CI.CompileFlags);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeGraphicsPipelineCreateInfo(ConstQual<GraphicsPipelineStateCreateInfo>& CI)
+{
+    // Only pipelines with implicit resource signatures and without render passes are supported
+    typename PSOSerializer<Mode>::TPRSNames PRSNames{};
+    const char*                             RenderPassName = nullptr;
+
+    return m_Ser(CI.PSODesc.Name) &&
+        PSOSerializer<Mode>::SerializeCreateInfo(m_Ser, CI, PRSNames, m_Allocator, RenderPassName) &&
+        SerializeObject(CI.pVS) &&
+        SerializeObject(CI.pPS) &&
+        SerializeObject(CI.pDS) &&
+        SerializeObject(CI.pHS) &&
+        SerializeObject(CI.pGS) &&
+        SerializeObject(CI.pAS) &&
+        SerializeObject(CI.pMS);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeComputePipelineCreateInfo(ConstQual<ComputePipelineStateCreateInfo>& CI)
+{
+    typename PSOSerializer<Mode>::TPRSNames PRSNames{};
+
+    return m_Ser(CI.PSODesc.Name) &&
+        PSOSerializer<Mode>::SerializeCreateInfo(m_Ser, CI, PRSNames, m_Allocator) &&
+        SerializeObject(CI.pCS);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeBindings(ConstQual<const ResourceBinding*>& Bindings, ConstQual<Uint32>& NumBindings)
+{
+    return m_Ser.SerializeArray(m_Allocator, Bindings, NumBindings,
+                                [this](Serializer<Mode>&           Ser,
+                                       ConstQual<ResourceBinding>& Binding) //
+                                {
+                                    return Ser(Binding.ShaderType, Binding.Name, Binding.ArrayIndex) &&
+                                        SerializeObject(Binding.pObject);
+                                });
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDrawAttribs(ConstQual<DrawAttribs>& Attribs)
+{
+    return m_Ser(Attribs.NumVertices,
+                 Attribs.Flags,
+                 Attribs.NumInstances,
+                 Attribs.StartVertexLocation,
+                 Attribs.FirstInstanceLocation);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDrawIndexedAttribs(ConstQual<DrawIndexedAttribs>& Attribs)
+{
+    return m_Ser(Attribs.NumIndices,
+                 Attribs.IndexType,
+                 Attribs.Flags,
+                 Attribs.NumInstances,
+                 Attribs.FirstIndexLocation,
+                 Attribs.BaseVertex,
+                 Attribs.FirstInstanceLocation);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDrawIndirectAttribs(ConstQual<DrawIndirectAttribs>& Attribs)
+{
+    return SerializeObject(Attribs.pAttribsBuffer) &&
+        m_Ser(Attribs.DrawArgsOffset,
+              Attribs.Flags,
+              Attribs.DrawCount,
+              Attribs.DrawArgsStride,
+              Attribs.AttribsBufferStateTransitionMode) &&
+        SerializeObject(Attribs.pCounterBuffer) &&
+        m_Ser(Attribs.CounterOffset,
+              Attribs.CounterBufferStateTransitionMode);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDrawIndexedIndirectAttribs(ConstQual<DrawIndexedIndirectAttribs>& Attribs)
+{
+    return m_Ser(Attribs.IndexType) &&
+        SerializeObject(Attribs.pAttribsBuffer) &&
+        m_Ser(Attribs.DrawArgsOffset,
+              Attribs.Flags,
+              Attribs.DrawCount,
+              Attribs.DrawArgsStride,
+              Attribs.AttribsBufferStateTransitionMode) &&
+        SerializeObject(Attribs.pCounterBuffer) &&
+        m_Ser(Attribs.CounterOffset,
+              Attribs.CounterBufferStateTransitionMode);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDispatchComputeAttribs(ConstQual<DispatchComputeAttribs>& Attribs)
+{
+    return m_Ser(Attribs.ThreadGroupCountX,
+                 Attribs.ThreadGroupCountY,
+                 Attribs.ThreadGroupCountZ,
+                 Attribs.MtlThreadGroupSizeX,
+                 Attribs.MtlThreadGroupSizeY,
+                 Attribs.MtlThreadGroupSizeZ);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeDispatchComputeIndirectAttribs(ConstQual<DispatchComputeIndirectAttribs>& Attribs)
+{
+    return SerializeObject(Attribs.pAttribsBuffer) &&
+        m_Ser(Attribs.AttribsBufferStateTransitionMode,
+              Attribs.DispatchArgsByteOffset,
+              Attribs.MtlThreadGroupSizeX,
+              Attribs.MtlThreadGroupSizeY,
+              Attribs.MtlThreadGroupSizeZ);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeSetRenderTargetsAttribs(ConstQual<SetRenderTargetsAttribs>& Attribs)
+{
+    if (!m_Ser(Attribs.NumRenderTargets))
+        return false;
+
+    if (Attribs.NumRenderTargets > 0)
+    {
+        if (Mode == SerializerMode::Read)
+        {
+            VERIFY_EXPR(m_Allocator != nullptr);
+            const_cast<ITextureView**&>(Attribs.ppRenderTargets) = m_Allocator->ConstructArray<ITextureView*>(Attribs.NumRenderTargets);
+        }
+
+        for (Uint32 i = 0; i < Attribs.NumRenderTargets; ++i)
+        {
+            if (!SerializeObject(Attribs.ppRenderTargets[i]))
+                return false;
+        }
+    }
+
+    return SerializeObject(Attribs.pDepthStencil) &&
+        SerializeObject(Attribs.pShadingRateMap) &&
+        m_Ser(Attribs.StateTransitionMode);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeCopyTextureAttribs(ConstQual<CopyTextureAttribs>& Attribs)
+{
+    if (!(SerializeObject(Attribs.pSrcTexture) &&
+          m_Ser(Attribs.SrcMipLevel,
+                Attribs.SrcSlice,
+                Attribs.SrcTextureTransitionMode)))
+        return false;
+
+    Uint8 HasSrcBox = Attribs.pSrcBox != nullptr ? 1 : 0;
+    if (!m_Ser(HasSrcBox))
+        return false;
+    if (HasSrcBox != 0)
+    {
+        if (Mode == SerializerMode::Read)
+        {
+            VERIFY_EXPR(m_Allocator != nullptr);
+            const_cast<const Box*&>(Attribs.pSrcBox) = m_Allocator->Construct<Box>();
+        }
+        if (!SerializeBox(*const_cast<ConstQual<Box>*>(Attribs.pSrcBox)))
+            return false;
+    }
+
+    return SerializeObject(Attribs.pDstTexture) &&
+        m_Ser(Attribs.DstMipLevel,
+              Attribs.DstSlice,
+              Attribs.DstX,
+              Attribs.DstY,
+              Attribs.DstZ,
+              Attribs.DstTextureTransitionMode);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeViewports(ConstQual<const Viewport*>& Viewports, ConstQual<Uint32>& NumViewports)
+{
+    return m_Ser.SerializeArray(m_Allocator, Viewports, NumViewports,
+                                [](Serializer<Mode>&    Ser,
+                                   ConstQual<Viewport>& VP) //
+                                {
+                                    return Ser(VP.TopLeftX, VP.TopLeftY, VP.Width, VP.Height, VP.MinDepth, VP.MaxDepth);
+                                });
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeRects(ConstQual<const Rect*>& Rects, ConstQual<Uint32>& NumRects)
+{
+    return m_Ser.SerializeArray(m_Allocator, Rects, NumRects,
+                                [](Serializer<Mode>& Ser,
+                                   ConstQual<Rect>&  R) //
+                                {
+                                    return Ser(R.left, R.top, R.right, R.bottom);
+                                });
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeBox(ConstQual<Box>& B)
+{
+    return m_Ser(B.MinX, B.MaxX, B.MinY, B.MaxY, B.MinZ, B.MaxZ);
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeStateTransitions(ConstQual<const StateTransitionDesc*>& Barriers, ConstQual<Uint32>& NumBarriers)
+{
+    return m_Ser.SerializeArray(m_Allocator, Barriers, NumBarriers,
+                                [this](Serializer<Mode>&               Ser,
+                                       ConstQual<StateTransitionDesc>& Barrier) //
+                                {
+                                    return SerializeObject(Barrier.pResourceBefore) &&
+                                        SerializeObject(Barrier.pResource) &&
+                                        Ser(Barrier.FirstMipLevel,
+                                            Barrier.MipLevelsCount,
+                                            Barrier.FirstArraySlice,
+                                            Barrier.ArraySliceCount,
+                                            Barrier.OldState,
+                                            Barrier.NewState,
+                                            Barrier.TransitionType,
+                                            Barrier.Flags);
+                                });
+}
+
+template <SerializerMode Mode>
+bool CommandStreamSerializer<Mode>::SerializeFloat4(ConstQual<const float*>& pValues)
+{
+    Uint8 HasValues = pValues != nullptr ? 1 : 0;
+    if (!m_Ser(HasValues))
+        return false;
+
+    if (HasValues != 0)
+    {
+        if (Mode == SerializerMode::Read)
+        {
+            VERIFY_EXPR(m_Allocator != nullptr);
+            const_cast<const float*&>(pValues) = m_Allocator->ConstructArray<float>(4);
+        }
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if (!m_Ser(const_cast<ConstQual<float>&>(pValues[i])))
+                return false;
+        }
+    }
+    return true;
+}
+
+template class CommandStreamSerializer<SerializerMode::Read>;
+template class CommandStreamSerializer<SerializerMode::Write>;
+template class CommandStreamSerializer<SerializerMode::Measure>;
+
+} // namespace Diligent
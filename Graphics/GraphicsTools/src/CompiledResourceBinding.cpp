@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CompiledResourceBinding.hpp"
+
+#include "PipelineResourceSignature.h"
+#include "BasicMath.hpp"
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+CompiledResourceBinding::CompiledResourceBinding(IShaderResourceBinding*     pSRB,
+                                                 SHADER_TYPE                 ShaderStages,
+                                                 BIND_SHADER_RESOURCES_FLAGS Flags) :
+    m_Flags{(Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) != 0 ? Flags : Flags | BIND_SHADER_RESOURCES_UPDATE_ALL}
+{
+    VERIFY_EXPR(pSRB != nullptr);
+
+    // Only query the stages that have resources in the signature: requesting variables
+    // of a stage that is not consistent with the pipeline type produces a warning.
+    SHADER_TYPE ActiveStages = SHADER_TYPE_UNKNOWN;
+    {
+        const auto& PRSDesc = pSRB->GetPipelineResourceSignature()->GetDesc();
+        for (Uint32 r = 0; r < PRSDesc.NumResources; ++r)
+            ActiveStages |= PRSDesc.Resources[r].ShaderStages;
+    }
+    ShaderStages &= ActiveStages;
+
+    while (ShaderStages != SHADER_TYPE_UNKNOWN)
+    {
+        const auto ShaderType = ExtractLSB(ShaderStages);
+
+        const auto NumVars = pSRB->GetVariableCount(ShaderType);
+        for (Uint32 v = 0; v < NumVars; ++v)
+        {
+            auto* pVar = pSRB->GetVariableByIndex(ShaderType, v);
+            VERIFY_EXPR(pVar != nullptr);
+            if ((m_Flags & (1u << pVar->GetType())) == 0)
+                continue;
+
+            ShaderResourceDesc ResDesc;
+            pVar->GetResourceDesc(ResDesc);
+
+            const auto NameIdx = static_cast<Uint32>(m_Names.size());
+            m_Names.emplace_back(ResDesc.Name);
+            for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+            {
+                ElementInfo Elem;
+                Elem.Location = {ShaderType, v, ArrInd};
+                Elem.NameIdx  = NameIdx;
+                m_Elements.emplace_back(std::move(Elem));
+            }
+        }
+    }
+}
+
+Uint32 CompiledResourceBinding::Resolve(IResourceMapping* pResMapping)
+{
+    DEV_CHECK_ERR(pResMapping != nullptr, "Failed to resolve resources: resource mapping is null");
+
+    m_ResolvedLocations.clear();
+    m_ResolvedObjects.clear();
+    m_ChangedLocations.clear();
+    m_ChangedObjects.clear();
+
+    Uint32 NumChanged = 0;
+    for (auto& Elem : m_Elements)
+    {
+        const auto& Name = m_Names[Elem.NameIdx];
+
+        auto* pObj = pResMapping->GetResource(Name.c_str(), Elem.Location.ArrayIndex);
+        if (pObj != Elem.pObject)
+        {
+            Elem.pObject = pObj;
+            ++NumChanged;
+            if (pObj != nullptr)
+            {
+                m_ChangedLocations.emplace_back(Elem.Location);
+                m_ChangedObjects.emplace_back(pObj);
+            }
+        }
+
+        if (pObj != nullptr)
+        {
+            m_ResolvedLocations.emplace_back(Elem.Location);
+            m_ResolvedObjects.emplace_back(pObj);
+        }
+        else if ((m_Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) != 0)
+        {
+            LOG_ERROR_MESSAGE("Unable to resolve resource for shader variable '", Name, "[", Elem.Location.ArrayIndex,
+                              "]' in ", GetShaderTypeLiteralName(Elem.Location.ShaderType), " stage: resource is not found in the resource mapping. "
+                              "Do not use BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED flag to suppress the message if this is not an issue.");
+        }
+    }
+
+    return NumChanged;
+}
+
+void CompiledResourceBinding::Bind(IShaderResourceBinding*                            pSRB,
+                                   const std::vector<ShaderResourceVariableLocation>& Locations,
+                                   const std::vector<IDeviceObject*>&                 Objects) const
+{
+    VERIFY_EXPR(pSRB != nullptr);
+    VERIFY_EXPR(Locations.size() == Objects.size());
+    if (Locations.empty())
+        return;
+
+    const auto SetResFlags = (m_Flags & BIND_SHADER_RESOURCES_ALLOW_OVERWRITE) != 0 ?
+        SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE :
+        SET_SHADER_RESOURCE_FLAG_NONE;
+
+    if ((m_Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) == 0)
+    {
+        pSRB->SetResources(Locations.data(), Objects.data(), static_cast<Uint32>(Locations.size()), SetResFlags);
+        return;
+    }
+
+    // Skip elements that are already bound
+    std::vector<ShaderResourceVariableLocation> UnboundLocations;
+    std::vector<IDeviceObject*>                 UnboundObjects;
+    UnboundLocations.reserve(Locations.size());
+    UnboundObjects.reserve(Objects.size());
+    for (size_t i = 0; i < Locations.size(); ++i)
+    {
+        const auto& Location = Locations[i];
+        auto*       pVar     = pSRB->GetVariableByIndex(Location.ShaderType, Location.VariableIndex);
+        if (pVar != nullptr && pVar->Get(Location.ArrayIndex) != nullptr)
+            continue;
+
+        UnboundLocations.emplace_back(Location);
+        UnboundObjects.emplace_back(Objects[i]);
+    }
+    if (!UnboundLocations.empty())
+        pSRB->SetResources(UnboundLocations.data(), UnboundObjects.data(), static_cast<Uint32>(UnboundLocations.size()), SetResFlags);
+}
+
+void CompiledResourceBinding::Apply(IShaderResourceBinding* pSRB) const
+{
+    Bind(pSRB, m_ResolvedLocations, m_ResolvedObjects);
+}
+
+void CompiledResourceBinding::ApplyChanges(IShaderResourceBinding* pSRB) const
+{
+    Bind(pSRB, m_ChangedLocations, m_ChangedObjects);
+}
+
+} // namespace Diligent
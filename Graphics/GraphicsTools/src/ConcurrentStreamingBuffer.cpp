@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ConcurrentStreamingBuffer.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+#include "Cast.hpp"
+
+namespace Diligent
+{
+
+ConcurrentStreamingBuffer::ConcurrentStreamingBuffer(const CreateInfo& CI) :
+    m_Size{AlignUp(CI.Desc.Size, Uint64{CI.Alignment})},
+    m_Alignment{CI.Alignment},
+    m_pMapContext{CI.pContext}
+{
+    DEV_CHECK_ERR(CI.pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(CI.pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(CI.Desc.Size > 0, "Buffer size must not be zero");
+    DEV_CHECK_ERR(IsPowerOfTwo(CI.Alignment), "Alignment (", CI.Alignment, ") must be a power of two");
+
+    const auto& DeviceInfo  = CI.pDevice->GetDeviceInfo();
+    const auto& AdapterInfo = CI.pDevice->GetAdapterInfo();
+
+    BufferDesc Desc = CI.Desc;
+    Desc.Size       = m_Size;
+
+    if (DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN && (AdapterInfo.Memory.UnifiedMemoryCPUAccess & CPU_ACCESS_WRITE) != 0)
+    {
+        // The GPU reads the data directly from the mapped memory
+        Desc.Usage          = USAGE_UNIFIED;
+        Desc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        CI.pDevice->CreateBuffer(Desc, nullptr, &m_pBuffer);
+    }
+
+    if (!m_pBuffer)
+    {
+        Desc.Usage          = USAGE_DEFAULT;
+        Desc.CPUAccessFlags = CPU_ACCESS_NONE;
+        CI.pDevice->CreateBuffer(Desc, nullptr, &m_pBuffer);
+        if (!m_pBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create concurrent streaming buffer '", (CI.Desc.Name != nullptr ? CI.Desc.Name : ""), "'");
+            return;
+        }
+
+        if (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 || DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN)
+        {
+            // Staging buffers may stay mapped while they are used by the GPU
+            const std::string StagingName = std::string{CI.Desc.Name != nullptr ? CI.Desc.Name : ""} + " - staging";
+
+            BufferDesc StagingDesc;
+            StagingDesc.Name           = StagingName.c_str();
+            StagingDesc.Size           = m_Size;
+            StagingDesc.Usage          = USAGE_STAGING;
+            StagingDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            CI.pDevice->CreateBuffer(StagingDesc, nullptr, &m_pStagingBuffer);
+        }
+
+        if (!m_pStagingBuffer)
+        {
+            m_CPUData.reset(new Uint8[StaticCast<size_t>(m_Size)]);
+            m_pMappedData = m_CPUData.get();
+        }
+    }
+
+    if (IBuffer* pMappedBuffer = m_pStagingBuffer ? m_pStagingBuffer.RawPtr<IBuffer>() : (m_CPUData ? nullptr : m_pBuffer.RawPtr<IBuffer>()))
+    {
+        PVoid pMappedData = nullptr;
+        m_pMapContext->MapBuffer(pMappedBuffer, MAP_WRITE, MAP_FLAG_NONE, pMappedData);
+        m_pMappedData      = static_cast<Uint8*>(pMappedData);
+        m_FlushMappedRange = (pMappedBuffer->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) == 0;
+        VERIFY(m_pMappedData != nullptr, "Failed to map the buffer");
+    }
+
+    FenceDesc FenceCI;
+    FenceCI.Name = "Concurrent streaming buffer fence";
+    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    CI.pDevice->CreateFence(FenceCI, &m_pFence);
+    VERIFY_EXPR(m_pFence);
+}
+
+ConcurrentStreamingBuffer::~ConcurrentStreamingBuffer()
+{
+    if (m_pMappedData != nullptr && !m_CPUData)
+    {
+        m_pMapContext->UnmapBuffer(m_pStagingBuffer ? m_pStagingBuffer.RawPtr<IBuffer>() : m_pBuffer.RawPtr<IBuffer>(), MAP_WRITE);
+    }
+}
+
+ConcurrentStreamingBuffer::Allocation ConcurrentStreamingBuffer::Allocate(Uint64 Size)
+{
+    VERIFY_EXPR(Size > 0);
+    if (m_pMappedData == nullptr || Size > m_Size)
+        return {};
+
+    Uint64 Head = m_Head.load();
+    Uint64 Start, End;
+    do
+    {
+        Start = AlignUp(Head, m_Alignment);
+
+        // Allocations never wrap around the end of the buffer
+        const auto Offset = Start % m_Size;
+        if (Offset + Size > m_Size)
+            Start += m_Size - Offset;
+
+        End = Start + Size;
+
+        // The tail only moves forward, so the stale value is conservative
+        if (End - m_Tail.load() > m_Size)
+            return {};
+    } while (!m_Head.compare_exchange_weak(Head, End));
+
+    Allocation Alloc;
+    Alloc.Offset = Start % m_Size;
+    Alloc.pData  = m_pMappedData + Alloc.Offset;
+    return Alloc;
+}
+
+Uint64 ConcurrentStreamingBuffer::Write(const void* pData, Uint64 Size)
+{
+    VERIFY_EXPR(pData != nullptr);
+    auto Alloc = Allocate(Size);
+    if (!Alloc)
+        return InvalidOffset;
+
+    memcpy(Alloc.pData, pData, StaticCast<size_t>(Size));
+    return Alloc.Offset;
+}
+
+void ConcurrentStreamingBuffer::Commit(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    if (m_pMappedData == nullptr)
+        return;
+
+    // The data committed by the previous call has been used by the commands recorded since then
+    const Uint64 LastPendingHead = m_PendingRanges.empty() ? m_Tail.load() : m_PendingRanges.back().Head;
+    if (m_CommittedHead != LastPendingHead)
+    {
+        pContext->EnqueueSignal(m_pFence, m_NextFenceValue);
+        m_PendingRanges.push_back({m_NextFenceValue, m_CommittedHead});
+        ++m_NextFenceValue;
+    }
+
+    // Release the space that is no longer used by the GPU
+    const auto CompletedValue = m_pFence->GetCompletedValue();
+    while (!m_PendingRanges.empty() && m_PendingRanges.front().FenceValue <= CompletedValue)
+    {
+        m_Tail.store(m_PendingRanges.front().Head);
+        m_PendingRanges.pop_front();
+    }
+
+    const Uint64 Head = m_Head.load();
+    if (Head == m_CommittedHead)
+        return;
+
+    VERIFY_EXPR(Head - m_CommittedHead <= m_Size);
+    const auto CommitRange = [&](Uint64 Offset, Uint64 Size) {
+        if (m_FlushMappedRange)
+        {
+            IBuffer* pMappedBuffer = m_pStagingBuffer ? m_pStagingBuffer.RawPtr<IBuffer>() : m_pBuffer.RawPtr<IBuffer>();
+            pMappedBuffer->FlushMappedRange(Offset, Size);
+        }
+
+        if (m_pStagingBuffer)
+            pContext->CopyBuffer(m_pStagingBuffer, Offset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, m_pBuffer, Offset, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        else if (m_CPUData)
+            pContext->UpdateBuffer(m_pBuffer, Offset, Size, m_CPUData.get() + Offset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    };
+
+    const Uint64 Offset = m_CommittedHead % m_Size;
+    const Uint64 Size   = Head - m_CommittedHead;
+    if (Offset + Size <= m_Size)
+    {
+        CommitRange(Offset, Size);
+    }
+    else
+    {
+        // The range wraps around the end of the buffer
+        CommitRange(Offset, m_Size - Offset);
+        CommitRange(0, Size - (m_Size - Offset));
+    }
+
+    m_CommittedHead = Head;
+}
+
+} // namespace Diligent
@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CrossDeviceCopyQueue.hpp"
+
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+GPUReadbackQueue::CreateInfo GetReadbackQueueCI(const CrossDeviceCopyQueue::CreateInfo& CI)
+{
+    GPUReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice              = CI.pSrcDevice;
+    ReadbackCI.MaxRecycledResources = CI.MaxRecycledResources;
+    // Callbacks upload the data with the destination context, so they must run
+    // on the thread that calls Process().
+    ReadbackCI.pThreadPool = nullptr;
+    return ReadbackCI;
+}
+
+} // namespace
+
+CrossDeviceCopyQueue::CrossDeviceCopyQueue(const CreateInfo& CI) :
+    m_Readbacks{GetReadbackQueueCI(CI)}
+{
+}
+
+void CrossDeviceCopyQueue::CopyBuffer(IDeviceContext* pSrcContext,
+                                      IBuffer*        pSrcBuffer,
+                                      Uint64          SrcOffset,
+                                      Uint64          Size,
+                                      IBuffer*        pDstBuffer,
+                                      Uint64          DstOffset)
+{
+    DEV_CHECK_ERR(pDstBuffer != nullptr, "Destination buffer must not be null");
+    DEV_CHECK_ERR(pDstBuffer->GetDesc().Usage == USAGE_DEFAULT, "Destination buffer '", pDstBuffer->GetDesc().Name, "' must be created with USAGE_DEFAULT");
+    DEV_CHECK_ERR(DstOffset + Size <= pDstBuffer->GetDesc().Size, "Destination region [", DstOffset, ", ", DstOffset + Size,
+                  ") is out of the buffer bounds");
+
+    RefCntAutoPtr<IBuffer> pDst{pDstBuffer};
+    m_Readbacks.ReadBuffer(pSrcContext, pSrcBuffer, SrcOffset, Size,
+                           [this, pDst, DstOffset](const GPUReadbackQueue::ReadbackData& Data) {
+                               VERIFY(m_pDstContext != nullptr, "Readback callbacks must only be invoked by Process() or Flush()");
+                               if (Data.pData == nullptr)
+                                   return;
+
+                               m_pDstContext->UpdateBuffer(pDst.RawPtr<IBuffer>(), DstOffset, Data.DataSize, Data.pData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                           });
+}
+
+void CrossDeviceCopyQueue::CopyTexture(IDeviceContext* pSrcContext, const TextureCopyAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.pSrcTexture != nullptr && Attribs.pDstTexture != nullptr, "Source and destination textures must not be null");
+
+    const auto& SrcDesc = Attribs.pSrcTexture->GetDesc();
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto& DstDesc = Attribs.pDstTexture->GetDesc();
+        DEV_CHECK_ERR(SrcDesc.Format == DstDesc.Format, "Source texture format (", GetTextureFormatAttribs(SrcDesc.Format).Name,
+                      ") does not match the destination texture format (", GetTextureFormatAttribs(DstDesc.Format).Name, ")");
+        DEV_CHECK_ERR(DstDesc.Usage == USAGE_DEFAULT, "Destination texture '", DstDesc.Name, "' must be created with USAGE_DEFAULT");
+        DEV_CHECK_ERR(Attribs.DstMipLevel < DstDesc.MipLevels, "Destination mip level ", Attribs.DstMipLevel, " is out of range");
+        DEV_CHECK_ERR(Attribs.DstSlice < DstDesc.GetArraySize(), "Destination array slice ", Attribs.DstSlice, " is out of range");
+    }
+#endif
+
+    Box SrcBox;
+    if (Attribs.pSrcBox != nullptr)
+    {
+        SrcBox = *Attribs.pSrcBox;
+    }
+    else
+    {
+        const auto MipProps = GetMipLevelProperties(SrcDesc, Attribs.SrcMipLevel);
+
+        SrcBox.MaxX = MipProps.LogicalWidth;
+        SrcBox.MaxY = MipProps.LogicalHeight;
+        SrcBox.MaxZ = MipProps.Depth;
+    }
+
+    Box DstBox;
+    DstBox.MinX = Attribs.DstX;
+    DstBox.MaxX = Attribs.DstX + SrcBox.Width();
+    DstBox.MinY = Attribs.DstY;
+    DstBox.MaxY = Attribs.DstY + SrcBox.Height();
+    DstBox.MinZ = Attribs.DstZ;
+    DstBox.MaxZ = Attribs.DstZ + SrcBox.Depth();
+
+    RefCntAutoPtr<ITexture> pDst{Attribs.pDstTexture};
+
+    const auto DstMipLevel = Attribs.DstMipLevel;
+    const auto DstSlice    = Attribs.DstSlice;
+    m_Readbacks.ReadTexture(pSrcContext, Attribs.pSrcTexture, Attribs.SrcMipLevel, Attribs.SrcSlice, &SrcBox,
+                            [this, pDst, DstMipLevel, DstSlice, DstBox](const GPUReadbackQueue::ReadbackData& Data) {
+                                VERIFY(m_pDstContext != nullptr, "Readback callbacks must only be invoked by Process() or Flush()");
+                                if (Data.pData == nullptr)
+                                    return;
+
+                                TextureSubResData SubresData;
+                                SubresData.pData       = Data.pData;
+                                SubresData.Stride      = Data.Stride;
+                                SubresData.DepthStride = Data.DepthStride;
+                                m_pDstContext->UpdateTexture(pDst.RawPtr<ITexture>(), DstMipLevel, DstSlice, DstBox, SubresData,
+                                                             RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                            });
+}
+
+void CrossDeviceCopyQueue::Process(IDeviceContext* pSrcContext, IDeviceContext* pDstContext)
+{
+    DEV_CHECK_ERR(pDstContext != nullptr, "Destination context must not be null");
+
+    m_pDstContext = pDstContext;
+    m_Readbacks.Process(pSrcContext);
+    m_pDstContext = nullptr;
+}
+
+void CrossDeviceCopyQueue::Flush(IDeviceContext* pSrcContext, IDeviceContext* pDstContext)
+{
+    DEV_CHECK_ERR(pDstContext != nullptr, "Destination context must not be null");
+
+    m_pDstContext = pDstContext;
+    m_Readbacks.Flush(pSrcContext);
+    m_pDstContext = nullptr;
+}
+
+} // namespace Diligent
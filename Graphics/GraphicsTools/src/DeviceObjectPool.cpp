@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DeviceObjectPool.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool IsCompatible(const BufferDesc& Desc1, const BufferDesc& Desc2)
+{
+    return Desc1 == Desc2 && Desc1.MiscFlags == Desc2.MiscFlags;
+}
+
+bool IsCompatible(const TextureDesc& Desc1, const TextureDesc& Desc2)
+{
+    return Desc1 == Desc2;
+}
+
+bool IsCompatible(const QueryDesc& Desc1, const QueryDesc& Desc2)
+{
+    return Desc1.Type == Desc2.Type;
+}
+
+void CreateObject(IRenderDevice* pDevice, const BufferDesc& Desc, IBuffer** ppBuffer)
+{
+    pDevice->CreateBuffer(Desc, nullptr, ppBuffer);
+}
+
+void CreateObject(IRenderDevice* pDevice, const TextureDesc& Desc, ITexture** ppTexture)
+{
+    pDevice->CreateTexture(Desc, nullptr, ppTexture);
+}
+
+void CreateObject(IRenderDevice* pDevice, const QueryDesc& Desc, IQuery** ppQuery)
+{
+    pDevice->CreateQuery(Desc, ppQuery);
+}
+
+} // namespace
+
+template <typename ObjectType, typename DescType>
+void DeviceObjectPool::TypedPool<ObjectType, DescType>::ProcessCompleted()
+{
+    while (auto pObject = m_PendingObjects.GetFirstCompleted())
+    {
+        VERIFY_EXPR(NumPending > 0);
+        --NumPending;
+
+        const auto& Desc = pObject->GetDesc();
+
+        auto it = std::find_if(m_Buckets.begin(), m_Buckets.end(),
+                               [&Desc](const Bucket<ObjectType, DescType>& B) { return IsCompatible(B.Desc, Desc); });
+        if (it == m_Buckets.end())
+        {
+            Bucket<ObjectType, DescType> NewBucket;
+            NewBucket.Desc = Desc;
+            // The name may not outlive the object
+            NewBucket.Desc.Name = nullptr;
+            m_Buckets.emplace_back(std::move(NewBucket));
+            it = m_Buckets.end() - 1;
+        }
+        it->Objects.emplace_back(std::move(pObject));
+    }
+}
+
+template <typename ObjectType, typename DescType>
+RefCntAutoPtr<ObjectType> DeviceObjectPool::TypedPool<ObjectType, DescType>::Get(const DescType& Desc, Uint32& NumReused)
+{
+    ProcessCompleted();
+
+    RefCntAutoPtr<ObjectType> pObject;
+
+    auto it = std::find_if(m_Buckets.begin(), m_Buckets.end(),
+                           [&Desc](const Bucket<ObjectType, DescType>& B) { return IsCompatible(B.Desc, Desc); });
+    if (it != m_Buckets.end() && !it->Objects.empty())
+    {
+        pObject = std::move(it->Objects.back());
+        it->Objects.pop_back();
+        ++NumReused;
+    }
+
+    return pObject;
+}
+
+template <typename ObjectType, typename DescType>
+void DeviceObjectPool::TypedPool<ObjectType, DescType>::Recycle(IDeviceContext* pContext, RefCntAutoPtr<ObjectType>&& pObject)
+{
+    VERIFY_EXPR(pContext != nullptr);
+    if (!pObject)
+        return;
+
+    m_PendingObjects.Enqueue(pContext, std::move(pObject));
+    ++NumPending;
+}
+
+template <typename ObjectType, typename DescType>
+void DeviceObjectPool::TypedPool<ObjectType, DescType>::ReleaseAvailable()
+{
+    ProcessCompleted();
+    m_Buckets.clear();
+}
+
+template <typename ObjectType, typename DescType>
+Uint32 DeviceObjectPool::TypedPool<ObjectType, DescType>::GetNumAvailable() const
+{
+    Uint32 NumAvailable = 0;
+    for (const auto& B : m_Buckets)
+        NumAvailable += static_cast<Uint32>(B.Objects.size());
+    return NumAvailable;
+}
+
+
+DeviceObjectPool::DeviceObjectPool(IRenderDevice* pDevice) :
+    m_pDevice{pDevice},
+    m_Buffers{pDevice},
+    m_Textures{pDevice},
+    m_Queries{pDevice}
+{
+    VERIFY_EXPR(m_pDevice);
+}
+
+RefCntAutoPtr<IBuffer> DeviceObjectPool::GetBuffer(const BufferDesc& Desc)
+{
+    if (auto pBuffer = m_Buffers.Get(Desc, m_Stats.NumReused))
+        return pBuffer;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    CreateObject(m_pDevice, Desc, &pBuffer);
+    DEV_CHECK_ERR(pBuffer, "Failed to create buffer '", (Desc.Name != nullptr ? Desc.Name : ""), "'");
+    if (pBuffer)
+        ++m_Stats.NumCreated;
+    return pBuffer;
+}
+
+RefCntAutoPtr<ITexture> DeviceObjectPool::GetTexture(const TextureDesc& Desc)
+{
+    if (auto pTexture = m_Textures.Get(Desc, m_Stats.NumReused))
+        return pTexture;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    CreateObject(m_pDevice, Desc, &pTexture);
+    DEV_CHECK_ERR(pTexture, "Failed to create texture '", (Desc.Name != nullptr ? Desc.Name : ""), "'");
+    if (pTexture)
+        ++m_Stats.NumCreated;
+    return pTexture;
+}
+
+RefCntAutoPtr<IQuery> DeviceObjectPool::GetQuery(const QueryDesc& Desc)
+{
+    if (auto pQuery = m_Queries.Get(Desc, m_Stats.NumReused))
+        return pQuery;
+
+    RefCntAutoPtr<IQuery> pQuery;
+    CreateObject(m_pDevice, Desc, &pQuery);
+    DEV_CHECK_ERR(pQuery, "Failed to create query '", (Desc.Name != nullptr ? Desc.Name : ""), "'");
+    if (pQuery)
+        ++m_Stats.NumCreated;
+    return pQuery;
+}
+
+void DeviceObjectPool::Recycle(IDeviceContext* pContext, RefCntAutoPtr<IBuffer>&& pBuffer)
+{
+    m_Buffers.Recycle(pContext, std::move(pBuffer));
+}
+
+void DeviceObjectPool::Recycle(IDeviceContext* pContext, RefCntAutoPtr<ITexture>&& pTexture)
+{
+    m_Textures.Recycle(pContext, std::move(pTexture));
+}
+
+void DeviceObjectPool::Recycle(IDeviceContext* pContext, RefCntAutoPtr<IQuery>&& pQuery)
+{
+    m_Queries.Recycle(pContext, std::move(pQuery));
+}
+
+void DeviceObjectPool::ReleaseAvailable()
+{
+    m_Buffers.ReleaseAvailable();
+    m_Textures.ReleaseAvailable();
+    m_Queries.ReleaseAvailable();
+}
+
+DeviceObjectPool::Statistics DeviceObjectPool::GetStatistics() const
+{
+    auto Stats         = m_Stats;
+    Stats.NumAvailable = m_Buffers.GetNumAvailable() + m_Textures.GetNumAvailable() + m_Queries.GetNumAvailable();
+    Stats.NumPending   = m_Buffers.NumPending + m_Textures.NumPending + m_Queries.NumPending;
+    return Stats;
+}
+
+} // namespace Diligent
@@ -27,6 +27,7 @@
 #include "DynamicTextureArray.hpp"
 
 #include <algorithm>
+#include <string>
 #include <vector>
 
 #include "DebugUtilities.hpp"
@@ -72,7 +73,9 @@ bool VerifySparseTextureCompatibility(IRenderDevice* pDevice, const TextureDesc&
 DynamicTextureArray::DynamicTextureArray(IRenderDevice* pDevice, const DynamicTextureArrayCreateInfo& CreateInfo) :
     m_Name{CreateInfo.Desc.Name != nullptr ? CreateInfo.Desc.Name : "Dynamic Texture"},
     m_Desc{CreateInfo.Desc},
-    m_NumSlicesInPage{std::max(CreateInfo.NumSlicesInMemoryPage, 1u)}
+    m_NumSlicesInPage{std::max(CreateInfo.NumSlicesInMemoryPage, 1u)},
+    m_NumSlicesInChunk{CreateInfo.NumSlicesInChunk},
+    m_NumSlicesInSparseBindBatch{CreateInfo.NumSlicesInSparseBindBatch}
 {
     m_Desc.Name = m_Name.c_str();
 
@@ -205,6 +208,13 @@ void DynamicTextureArray::CreateResources(IRenderDevice* pDevice)
     }
 
     // NB: m_Desc.Usage may be changed by CreateSparseTexture()
+    if (IsChunked())
+    {
+        // Chunks are created by ResizeChunks(), which also updates the version
+        ResizeChunks(pDevice);
+        return;
+    }
+
     if (m_Desc.Usage == USAGE_DEFAULT && m_PendingSize > 0)
     {
         auto Desc      = m_Desc;
@@ -316,21 +326,15 @@ void DynamicTextureArray::ResizeSparseTexture(IDeviceContext* pContext)
     VERIFY_EXPR(range_it == MipRanges.end());
     VERIFY_EXPR(CurrMemOffset == RequiredMemSize);
 
-    BindSparseResourceMemoryAttribs BindMemAttribs;
-    BindMemAttribs.NumTextureBinds = StaticCast<Uint32>(TexBinds.size());
-    BindMemAttribs.pTextureBinds   = TexBinds.data();
-
+    // Binding memory to the new slices does not affect the slices that may be in use by the commands
+    // in the context, so only unbinding the memory needs to wait for these commands to complete.
     Uint64  WaitFenceValue = 0;
     IFence* pWaitFence     = nullptr;
-    if (m_pBeforeResizeFence)
+    if (m_pBeforeResizeFence && m_PendingSize < m_Desc.ArraySize)
     {
         WaitFenceValue = m_NextBeforeResizeFenceValue++;
         pWaitFence     = m_pBeforeResizeFence;
 
-        BindMemAttribs.NumWaitFences    = 1;
-        BindMemAttribs.pWaitFenceValues = &WaitFenceValue;
-        BindMemAttribs.ppWaitFences     = &pWaitFence;
-
         pContext->EnqueueSignal(m_pBeforeResizeFence, WaitFenceValue);
     }
 
@@ -340,13 +344,36 @@ void DynamicTextureArray::ResizeSparseTexture(IDeviceContext* pContext)
     {
         SignalFenceValue = m_NextAfterResizeFenceValue++;
         pSignalFence     = m_pAfterResizeFence;
-
-        BindMemAttribs.NumSignalFences    = 1;
-        BindMemAttribs.pSignalFenceValues = &SignalFenceValue;
-        BindMemAttribs.ppSignalFences     = &pSignalFence;
     }
 
-    pContext->BindSparseResourceMemory(BindMemAttribs);
+    // Every slice uses the same number of bind infos
+    const size_t NumBindsInSlice = HasMipTail ? 2 : 1;
+    const size_t NumBindsInBatch = (m_NumSlicesInSparseBindBatch != 0 ? std::min(m_NumSlicesInSparseBindBatch, NumSlicesToBind) : NumSlicesToBind) * NumBindsInSlice;
+    for (size_t FirstBind = 0; FirstBind < TexBinds.size(); FirstBind += NumBindsInBatch)
+    {
+        const auto NumBinds = std::min(NumBindsInBatch, TexBinds.size() - FirstBind);
+
+        BindSparseResourceMemoryAttribs BindMemAttribs;
+        BindMemAttribs.NumTextureBinds = StaticCast<Uint32>(NumBinds);
+        BindMemAttribs.pTextureBinds   = &TexBinds[FirstBind];
+
+        // Batches are executed by the queue in order, so it is enough to
+        // wait before the first batch and signal after the last one.
+        if (pWaitFence != nullptr && FirstBind == 0)
+        {
+            BindMemAttribs.NumWaitFences    = 1;
+            BindMemAttribs.pWaitFenceValues = &WaitFenceValue;
+            BindMemAttribs.ppWaitFences     = &pWaitFence;
+        }
+        if (pSignalFence != nullptr && FirstBind + NumBinds == TexBinds.size())
+        {
+            BindMemAttribs.NumSignalFences    = 1;
+            BindMemAttribs.pSignalFenceValues = &SignalFenceValue;
+            BindMemAttribs.ppSignalFences     = &pSignalFence;
+        }
+
+        pContext->BindSparseResourceMemory(BindMemAttribs);
+    }
 
     if (RequiredMemSize < m_pMemory->GetCapacity())
         m_pMemory->Resize(RequiredMemSize); // Release unused memory
@@ -381,6 +408,63 @@ void DynamicTextureArray::ResizeDefaultTexture(IDeviceContext* pContext)
     m_pStaleTexture.Release();
 }
 
+void DynamicTextureArray::ResizeChunks(IRenderDevice* pDevice)
+{
+    VERIFY_EXPR(IsChunked());
+
+    m_PendingSize = AlignUp(m_PendingSize, m_NumSlicesInChunk);
+
+    const size_t NumChunks = m_PendingSize / m_NumSlicesInChunk;
+    if (NumChunks == m_Chunks.size())
+    {
+        // The new size fits into the existing chunks
+        m_Desc.ArraySize = m_PendingSize;
+        return;
+    }
+
+    if (NumChunks > m_Chunks.size())
+    {
+        VERIFY_EXPR(pDevice != nullptr);
+
+        auto Desc      = m_Desc;
+        Desc.ArraySize = m_NumSlicesInChunk;
+        while (m_Chunks.size() < NumChunks)
+        {
+            const auto ChunkName = m_Name + " - chunk " + std::to_string(m_Chunks.size());
+            Desc.Name            = ChunkName.c_str();
+
+            RefCntAutoPtr<ITexture> pChunk;
+            pDevice->CreateTexture(Desc, nullptr, &pChunk);
+            if (!pChunk)
+            {
+                LOG_ERROR_MESSAGE("Failed to create chunk ", m_Chunks.size(), " of dynamic texture array '", m_Name, "'");
+                break;
+            }
+            m_Chunks.emplace_back(std::move(pChunk));
+        }
+    }
+    else
+    {
+        m_Chunks.resize(NumChunks);
+    }
+
+    if (!m_Chunks.empty())
+        m_pTexture = m_Chunks[0];
+    else
+        m_pTexture.Release();
+
+    // If a chunk could not be created, the array only contains the slices of the existing chunks
+    m_Desc.ArraySize = StaticCast<Uint32>(m_Chunks.size()) * m_NumSlicesInChunk;
+    m_PendingSize    = m_Desc.ArraySize;
+
+    m_Version.fetch_add(1);
+
+    LOG_INFO_MESSAGE("Dynamic texture array: resizing texture '", m_Desc.Name,
+                     "' (", m_Desc.Width, " x ", m_Desc.Height, " ", m_Desc.MipLevels, "-mip ",
+                     GetTextureFormatAttribs(m_Desc.Format).Name, ") to ",
+                     m_Chunks.size(), " chunks of ", m_NumSlicesInChunk, " slices. Version: ", GetVersion());
+}
+
 void DynamicTextureArray::CommitResize(IRenderDevice*  pDevice,
                                        IDeviceContext* pContext,
                                        bool            AllowNull)
@@ -393,6 +477,20 @@ void DynamicTextureArray::CommitResize(IRenderDevice*  pDevice,
             DEV_CHECK_ERR(AllowNull, "Dynamic texture array must be initialized, but pDevice is null");
     }
 
+    if (IsChunked())
+    {
+        if (m_Desc.ArraySize != m_PendingSize)
+        {
+            // Existing chunks are never copied, so the context is not needed.
+            // Releasing the chunks does not require the device either.
+            if (pDevice != nullptr || m_PendingSize < m_Desc.ArraySize)
+                ResizeChunks(pDevice);
+            else
+                DEV_CHECK_ERR(AllowNull, "Dynamic texture array must be expanded, but pDevice is null. Use PendingUpdate() to check if the texture must be updated.");
+        }
+        return;
+    }
+
     if (m_pTexture && m_Desc.ArraySize != m_PendingSize)
     {
         if (pContext != nullptr)
@@ -425,7 +523,7 @@ ITexture* DynamicTextureArray::Resize(IRenderDevice*  pDevice,
     {
         m_PendingSize = NewArraySize;
 
-        if (m_Desc.Usage != USAGE_SPARSE)
+        if (m_Desc.Usage != USAGE_SPARSE && !IsChunked())
         {
             if (!m_pStaleTexture)
                 m_pStaleTexture = std::move(m_pTexture);
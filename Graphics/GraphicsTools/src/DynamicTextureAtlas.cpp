@@ -33,6 +33,9 @@
 #include <unordered_map>
 #include <map>
 #include <set>
+#include <vector>
+#include <memory>
+#include <tuple>
 
 #include "DynamicAtlasManager.hpp"
 #include "DynamicTextureArray.hpp"
@@ -138,9 +141,16 @@ namespace
 class ThreadSafeAtlasManager
 {
 public:
-    ThreadSafeAtlasManager(const uint2& Dim) noexcept :
-        Mgr{Dim.x, Dim.y}
-    {}
+    ThreadSafeAtlasManager(const uint2& Dim, DYNAMIC_TEXTURE_ATLAS_PACKING_MODE PackingMode) :
+        Mgr{
+            Dim.x,
+            Dim.y,
+            PackingMode == DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SHELF ?
+                DynamicAtlasManager::ALLOCATION_POLICY_SHELF :
+                DynamicAtlasManager::ALLOCATION_POLICY_BEST_FIT
+        }
+    {
+    }
 
     // clang-format off
     ThreadSafeAtlasManager           (const ThreadSafeAtlasManager&)  = delete;
@@ -198,7 +208,20 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.Allocate(Width, Height);
+            return pAtlasMgr->AllocateRegion(Width, Height);
+        }
+
+        // Allocates a region if the slice is not locked by another thread.
+        // Returns false if the slice is locked.
+        bool TryAllocate(Uint32 Width, Uint32 Height, DynamicAtlasManager::Region& R)
+        {
+            VERIFY_EXPR(pAtlasMgr != nullptr);
+            VERIFY_EXPR(pAtlasMgr->UseCount > 0);
+            std::unique_lock<std::mutex> Guard{pAtlasMgr->Mtx, std::try_to_lock};
+            if (!Guard.owns_lock())
+                return false;
+            R = pAtlasMgr->AllocateRegion(Width, Height);
+            return true;
         }
 
         // Frees a region and returns true if the atlas is empty
@@ -207,8 +230,8 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            pAtlasMgr->Mgr.Free(std::move(R));
-            return pAtlasMgr->Mgr.IsEmpty();
+            pAtlasMgr->FreeRegion(std::move(R));
+            return pAtlasMgr->IsEmptyUnsafe();
         }
 
         bool IsEmpty()
@@ -216,7 +239,7 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.IsEmpty();
+            return pAtlasMgr->IsEmptyUnsafe();
         }
 
     private:
@@ -258,8 +281,25 @@ private:
         return Uses;
     }
 
+    // The methods below must be called while Mtx is locked.
+
+    DynamicAtlasManager::Region AllocateRegion(Uint32 Width, Uint32 Height)
+    {
+        return Mgr.Allocate(Width, Height);
+    }
+
+    void FreeRegion(DynamicAtlasManager::Region&& R)
+    {
+        Mgr.Free(std::move(R));
+    }
+
+    bool IsEmptyUnsafe() const
+    {
+        return Mgr.IsEmpty();
+    }
+
 private:
-    std::mutex          Mtx;
+    std::mutex Mtx;
     DynamicAtlasManager Mgr;
 
     std::atomic_int UseCount{0};
@@ -268,8 +308,9 @@ private:
 
 struct SliceBatch
 {
-    SliceBatch(const uint2 AtlasDim) noexcept :
-        m_AtlasDim{AtlasDim}
+    SliceBatch(const uint2 AtlasDim, DYNAMIC_TEXTURE_ATLAS_PACKING_MODE PackingMode) noexcept :
+        m_AtlasDim{AtlasDim},
+        m_PackingMode{PackingMode}
     {}
 
     ~SliceBatch()
@@ -313,7 +354,7 @@ struct SliceBatch
         std::lock_guard<std::mutex> Guard{m_Mtx};
 
         VERIFY(m_Slices.find(Slice) == m_Slices.end(), "Slice ", Slice, " already present in the batch.");
-        auto it = m_Slices.emplace(Slice, m_AtlasDim).first;
+        auto it = m_Slices.emplace(std::piecewise_construct, std::forward_as_tuple(Slice), std::forward_as_tuple(m_AtlasDim, m_PackingMode)).first;
         // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
         return it->second.Lock();
     }
@@ -350,6 +391,8 @@ struct SliceBatch
 private:
     const uint2 m_AtlasDim;
 
+    const DYNAMIC_TEXTURE_ATLAS_PACKING_MODE m_PackingMode;
+
     std::mutex m_Mtx;
     // For every alignment, we keep a list of slice managers sorted by the slice index.
     std::map<Uint32, ThreadSafeAtlasManager> m_Slices;
@@ -378,6 +421,7 @@ public:
         },
         // clang-format off
         m_MinAlignment    {CreateInfo.MinAlignment},
+        m_PackingMode     {CreateInfo.PackingMode},
         m_ExtraSliceCount {CreateInfo.ExtraSliceCount},
         m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
         m_Silent          {CreateInfo.Silent},
@@ -504,6 +548,9 @@ public:
 
         DynamicAtlasManager::Region Subregion;
 
+        // Slices that were skipped because they were locked by other threads
+        std::vector<Uint32> SkippedSlices;
+
         Uint32 Slice = 0;
         while (Slice < m_MaxSliceCount)
         {
@@ -511,6 +558,23 @@ public:
             auto SliceMgr = pBatch->LockSliceAfter(Slice);
             if (!SliceMgr)
             {
+                // Before adding a new slice, wait for the slices that were locked by other threads
+                for (auto SkippedSlice : SkippedSlices)
+                {
+                    if (auto SkippedSliceMgr = pBatch->LockSlice(SkippedSlice))
+                    {
+                        Subregion = SkippedSliceMgr.Allocate(AlignedWidth / Alignment, AlignedHeight / Alignment);
+                        if (!Subregion.IsEmpty())
+                        {
+                            Slice = SkippedSlice;
+                            break;
+                        }
+                    }
+                }
+                SkippedSlices.clear();
+                if (!Subregion.IsEmpty())
+                    break;
+
                 const auto NewSlice = GetNextAvailableSlice();
                 if (NewSlice != ~Uint32{0})
                 {
@@ -529,8 +593,11 @@ public:
 
             if (SliceMgr)
             {
-                Subregion = SliceMgr.Allocate(AlignedWidth / Alignment, AlignedHeight / Alignment);
-                if (!Subregion.IsEmpty())
+                // Do not wait for the slices used by other threads, so that concurrent allocations
+                // are spread across the slices instead of being serialized.
+                if (!SliceMgr.TryAllocate(AlignedWidth / Alignment, AlignedHeight / Alignment, Subregion))
+                    SkippedSlices.push_back(Slice);
+                else if (!Subregion.IsEmpty())
                     break;
             }
 
@@ -702,7 +769,7 @@ private:
         // Get the list of slices for this alignment
         auto BatchIt = m_SliceBatchesByAlignment.find(Alignment);
         if (BatchIt == m_SliceBatchesByAlignment.end() && AtlasWidth != 0 && AtlasHeight != 0)
-            BatchIt = m_SliceBatchesByAlignment.emplace(Alignment, uint2{AtlasWidth, AtlasHeight}).first;
+            BatchIt = m_SliceBatchesByAlignment.emplace(std::piecewise_construct, std::forward_as_tuple(Alignment), std::forward_as_tuple(uint2{AtlasWidth, AtlasHeight}, m_PackingMode)).first;
 
         return BatchIt != m_SliceBatchesByAlignment.end() ? &BatchIt->second : nullptr;
     }
@@ -712,6 +779,9 @@ private:
     const TextureDesc m_Desc;
 
     const Uint32 m_MinAlignment;
+
+    const DYNAMIC_TEXTURE_ATLAS_PACKING_MODE m_PackingMode;
+
     const Uint32 m_ExtraSliceCount;
     const Uint32 m_MaxSliceCount;
     const bool   m_Silent;
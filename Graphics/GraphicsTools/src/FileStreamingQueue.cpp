@@ -0,0 +1,455 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FileStreamingQueue.hpp"
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+
+#include "FileStreamingQueueImpl.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "GraphicsAccessories.hpp"
+#include "FileWrapper.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Covers D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT as well as Vulkan buffer-image copy requirements
+constexpr Uint64 StagingAlignment = 512;
+
+class FileStreamingQueueCPU final : public FileStreamingQueue
+{
+public:
+    explicit FileStreamingQueueCPU(const FileStreamingQueueCreateInfo& CI) :
+        m_pDevice{CI.pDevice},
+        m_pThreadPool{CI.pThreadPool},
+        m_DecompressGDeflate{CI.DecompressGDeflate}
+    {
+        FenceDesc FncDesc;
+        FncDesc.Name = "File streaming queue fence";
+        m_pDevice->CreateFence(FncDesc, &m_pFence);
+        DEV_CHECK_ERR(m_pFence, "Failed to create fence");
+
+        const auto DeviceType = m_pDevice->GetDeviceInfo().Type;
+        if ((DeviceType == RENDER_DEVICE_TYPE_D3D12 || DeviceType == RENDER_DEVICE_TYPE_VULKAN) && CI.StagingBufferSize > 0)
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = "File streaming staging buffer";
+            BuffDesc.Size           = AlignUp(CI.StagingBufferSize, StagingAlignment);
+            BuffDesc.Usage          = USAGE_STAGING;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pStagingBuffer);
+            if (m_pStagingBuffer)
+            {
+                m_pStagingMgr       = std::make_unique<VariableSizeAllocationsManager>(BuffDesc.Size, DefaultRawMemoryAllocator::GetAllocator());
+                m_IsStagingCoherent = (m_pStagingBuffer->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) != 0;
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("Failed to create the file streaming staging buffer. The data will be uploaded from the CPU memory.");
+            }
+        }
+    }
+
+    ~FileStreamingQueueCPU()
+    {
+        DEV_CHECK_ERR(m_NumPendingRequests.load() == 0, "Destroying the file streaming queue with pending requests. Call Flush() first.");
+        for (auto& pReq : m_LoadingRequests)
+        {
+            if (pReq->pTask)
+                pReq->pTask->WaitForCompletion();
+        }
+    }
+
+    virtual void Enqueue(const FileStreamingRequest& Req) override final
+    {
+        DEV_CHECK_ERR(Req.FilePath != nullptr, "File path must not be null");
+        DEV_CHECK_ERR((Req.pDstBuffer != nullptr) != (Req.pDstTexture != nullptr), "Exactly one of pDstBuffer and pDstTexture must not be null");
+        DEV_CHECK_ERR(Req.Size > 0 && Req.UncompressedSize > 0, "Data size must not be zero");
+        DEV_CHECK_ERR(Req.Compression != FILE_STREAMING_COMPRESSION_NONE || Req.Size == Req.UncompressedSize,
+                      "Uncompressed size (", Req.UncompressedSize, ") must be equal to the size (", Req.Size, ") when the data is not compressed");
+
+        std::unique_ptr<Request> pReq{new Request{}};
+        pReq->FilePath         = Req.FilePath;
+        pReq->FileOffset       = Req.FileOffset;
+        pReq->Size             = Req.Size;
+        pReq->UncompressedSize = Req.UncompressedSize;
+        pReq->Compression      = Req.Compression;
+        pReq->pDstBuffer       = Req.pDstBuffer;
+        pReq->DstOffset        = Req.DstOffset;
+        pReq->pDstTexture      = Req.pDstTexture;
+        pReq->MipLevel         = Req.MipLevel;
+        pReq->ArraySlice       = Req.ArraySlice;
+        pReq->OnCompleted      = Req.OnCompleted;
+        pReq->DataSize         = Req.UncompressedSize;
+        if (Req.pDstTexture != nullptr)
+        {
+            const auto& TexDesc = Req.pDstTexture->GetDesc();
+            DEV_CHECK_ERR(Req.MipLevel < TexDesc.MipLevels, "Mip level ", Req.MipLevel, " is out of range");
+            DEV_CHECK_ERR(Req.ArraySlice < TexDesc.GetArraySize(), "Array slice ", Req.ArraySlice, " is out of range");
+
+            pReq->CopyInfo = GetFileStreamingTextureCopyInfo(TexDesc, Req.MipLevel, Req.Region);
+            DEV_CHECK_ERR(Req.UncompressedSize >= pReq->CopyInfo.MemorySize - pReq->CopyInfo.RowStride + pReq->CopyInfo.RowSize,
+                          "Uncompressed size (", Req.UncompressedSize, ") is not enough for the texture region");
+            // Make sure that the copy never reads past the end of the data
+            pReq->DataSize = std::max(Uint64{Req.UncompressedSize}, pReq->CopyInfo.MemorySize);
+        }
+        else
+        {
+            DEV_CHECK_ERR(Req.DstOffset + Req.UncompressedSize <= Req.pDstBuffer->GetDesc().Size, "The request is out of the destination buffer bounds");
+        }
+
+        ++m_NumPendingRequests;
+
+        std::lock_guard<std::mutex> Lock{m_NewRequestsMtx};
+        m_NewRequests.emplace_back(std::move(pReq));
+    }
+
+    virtual void Update(IDeviceContext* pContext) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+        StartNewRequests(pContext);
+        CopyLoadedRequests(pContext);
+        CompleteRequests();
+    }
+
+    virtual void Flush(IDeviceContext* pContext) override final
+    {
+        DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+        while (m_NumPendingRequests.load() > 0)
+        {
+            StartNewRequests(pContext);
+            for (auto& pReq : m_LoadingRequests)
+            {
+                if (pReq->pTask)
+                    pReq->pTask->WaitForCompletion();
+            }
+            CopyLoadedRequests(pContext);
+            if (!m_CopiedRequests.empty())
+            {
+                pContext->Flush();
+                m_pFence->Wait(m_CopiedRequests.back()->FenceValue);
+            }
+            CompleteRequests();
+        }
+
+        if (m_pStagingData != nullptr)
+        {
+            pContext->UnmapBuffer(m_pStagingBuffer, MAP_WRITE);
+            m_pStagingData = nullptr;
+        }
+    }
+
+    virtual size_t GetNumPendingRequests() override final
+    {
+        return m_NumPendingRequests.load();
+    }
+
+    virtual bool IsDirectStorageUsed() const override final
+    {
+        return false;
+    }
+
+private:
+    struct Request
+    {
+        String                     FilePath;
+        Uint64                     FileOffset       = 0;
+        Uint32                     Size             = 0;
+        Uint32                     UncompressedSize = 0;
+        FILE_STREAMING_COMPRESSION Compression      = FILE_STREAMING_COMPRESSION_NONE;
+
+        RefCntAutoPtr<IBuffer> pDstBuffer;
+        Uint64                 DstOffset = 0;
+
+        RefCntAutoPtr<ITexture> pDstTexture;
+        Uint32                  MipLevel   = 0;
+        Uint32                  ArraySlice = 0;
+        BufferToTextureCopyInfo CopyInfo;
+
+        std::function<void(bool Success)> OnCompleted;
+
+        // The size of the decompressed data including the texture row padding
+        Uint64 DataSize = 0;
+
+        // Either the staging buffer memory or the CPU memory that the data is decompressed into
+        VariableSizeAllocationsManager::Allocation StagingAllocation;
+        Uint64                                     StagingOffset = 0;
+        std::vector<Uint8>                         CPUData;
+        Uint8*                                     pData = nullptr;
+
+        RefCntAutoPtr<IAsyncTask> pTask;
+
+        bool   Success    = false;
+        Uint64 FenceValue = 0;
+    };
+
+    bool Load(Request& Req) const
+    {
+        FileWrapper File{Req.FilePath.c_str(), EFileAccessMode::Read};
+        if (!File)
+        {
+            LOG_ERROR_MESSAGE("Failed to open file ", Req.FilePath);
+            return false;
+        }
+
+        if (!File->SetPos(static_cast<size_t>(Req.FileOffset), FilePosOrigin::Start))
+        {
+            LOG_ERROR_MESSAGE("Failed to seek to offset ", Req.FileOffset, " in file ", Req.FilePath);
+            return false;
+        }
+
+        if (Req.Compression == FILE_STREAMING_COMPRESSION_NONE)
+        {
+            if (!File->Read(Req.pData, Req.Size))
+            {
+                LOG_ERROR_MESSAGE("Failed to read ", Req.Size, " bytes from file ", Req.FilePath);
+                return false;
+            }
+            return true;
+        }
+
+        VERIFY_EXPR(Req.Compression == FILE_STREAMING_COMPRESSION_GDEFLATE);
+        if (!m_DecompressGDeflate)
+        {
+            LOG_ERROR_MESSAGE("Unable to decompress GDeflate data from file ", Req.FilePath, ": decompression callback is not provided");
+            return false;
+        }
+
+        std::vector<Uint8> CompressedData(Req.Size);
+        if (!File->Read(CompressedData.data(), CompressedData.size()))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", Req.Size, " bytes from file ", Req.FilePath);
+            return false;
+        }
+
+        if (!m_DecompressGDeflate(CompressedData.data(), CompressedData.size(), Req.pData, Req.UncompressedSize))
+        {
+            LOG_ERROR_MESSAGE("Failed to decompress GDeflate data from file ", Req.FilePath);
+            return false;
+        }
+
+        return true;
+    }
+
+    void StartNewRequests(IDeviceContext* pContext)
+    {
+        std::vector<std::unique_ptr<Request>> NewRequests;
+        {
+            std::lock_guard<std::mutex> Lock{m_NewRequestsMtx};
+            NewRequests.swap(m_NewRequests);
+        }
+        if (NewRequests.empty())
+            return;
+
+        if (m_pStagingBuffer && m_pStagingData == nullptr)
+        {
+            // Staging buffers are persistently mapped in Direct3D12 and Vulkan backends,
+            // so the memory can be written by the worker threads at any time.
+            PVoid pMappedData = nullptr;
+            pContext->MapBuffer(m_pStagingBuffer, MAP_WRITE, MAP_FLAG_NONE, pMappedData);
+            m_pStagingData = static_cast<Uint8*>(pMappedData);
+        }
+
+        for (auto& pNewReq : NewRequests)
+        {
+            auto& Req = *pNewReq;
+            if (m_pStagingData != nullptr)
+            {
+                Req.StagingAllocation = m_pStagingMgr->Allocate(Req.DataSize, StagingAlignment);
+                if (Req.StagingAllocation.IsValid())
+                {
+                    Req.StagingOffset = AlignUp(Req.StagingAllocation.UnalignedOffset, StagingAlignment);
+                    Req.pData         = m_pStagingData + Req.StagingOffset;
+                }
+            }
+            if (Req.pData == nullptr)
+            {
+                Req.CPUData.resize(static_cast<size_t>(Req.DataSize));
+                Req.pData = Req.CPUData.data();
+            }
+
+            if (m_pThreadPool)
+            {
+                Req.pTask = EnqueueAsyncWork(m_pThreadPool,
+                                             [this, &Req](Uint32 /*ThreadId*/) {
+                                                 Req.Success = Load(Req);
+                                             });
+            }
+            else
+            {
+                Req.Success = Load(Req);
+            }
+            m_LoadingRequests.emplace_back(std::move(pNewReq));
+        }
+    }
+
+    void CopyLoadedRequests(IDeviceContext* pContext)
+    {
+        bool RequestsCopied = false;
+        for (auto it = m_LoadingRequests.begin(); it != m_LoadingRequests.end();)
+        {
+            auto& Req = **it;
+            if (Req.pTask && !Req.pTask->IsFinished())
+            {
+                ++it;
+                continue;
+            }
+
+            // Failed requests go through the same fence so that the callbacks are invoked in order
+            if (Req.Success)
+                RecordCopy(pContext, Req);
+            Req.FenceValue = m_NextFenceValue;
+            m_CopiedRequests.emplace_back(std::move(*it));
+            it             = m_LoadingRequests.erase(it);
+            RequestsCopied = true;
+        }
+
+        if (RequestsCopied)
+            pContext->EnqueueSignal(m_pFence, m_NextFenceValue++);
+    }
+
+    void RecordCopy(IDeviceContext* pContext, Request& Req)
+    {
+        const bool FromStaging = Req.StagingAllocation.IsValid();
+        if (FromStaging && !m_IsStagingCoherent)
+            m_pStagingBuffer->FlushMappedRange(Req.StagingOffset, Req.DataSize);
+
+        if (Req.pDstBuffer)
+        {
+            if (FromStaging)
+            {
+                pContext->CopyBuffer(m_pStagingBuffer, Req.StagingOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     Req.pDstBuffer, Req.DstOffset, Req.UncompressedSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+            else
+            {
+                pContext->UpdateBuffer(Req.pDstBuffer, Req.DstOffset, Req.UncompressedSize, Req.pData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+        }
+        else
+        {
+            TextureSubResData SubResData;
+            if (FromStaging)
+            {
+                SubResData.pSrcBuffer = m_pStagingBuffer;
+                SubResData.SrcOffset  = Req.StagingOffset;
+            }
+            else
+            {
+                SubResData.pData = Req.pData;
+            }
+            SubResData.Stride      = Req.CopyInfo.RowStride;
+            SubResData.DepthStride = Req.CopyInfo.DepthStride;
+            pContext->UpdateTexture(Req.pDstTexture, Req.MipLevel, Req.ArraySlice, Req.CopyInfo.Region, SubResData,
+                                    RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+
+    void CompleteRequests()
+    {
+        const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+        while (!m_CopiedRequests.empty() && m_CopiedRequests.front()->FenceValue <= CompletedFenceValue)
+        {
+            auto pReq = std::move(m_CopiedRequests.front());
+            m_CopiedRequests.pop_front();
+
+            if (pReq->StagingAllocation.IsValid())
+                m_pStagingMgr->Free(std::move(pReq->StagingAllocation));
+            if (pReq->OnCompleted)
+                pReq->OnCompleted(pReq->Success);
+            --m_NumPendingRequests;
+        }
+    }
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IThreadPool>   m_pThreadPool;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    const GDeflateDecompressCallbackType m_DecompressGDeflate;
+
+    RefCntAutoPtr<IBuffer>                          m_pStagingBuffer;
+    Uint8*                                          m_pStagingData      = nullptr;
+    bool                                            m_IsStagingCoherent = true;
+    std::unique_ptr<VariableSizeAllocationsManager> m_pStagingMgr;
+
+    Uint64 m_NextFenceValue = 1;
+
+    std::atomic<size_t> m_NumPendingRequests{0};
+
+    std::mutex                            m_NewRequestsMtx;
+    std::vector<std::unique_ptr<Request>> m_NewRequests;
+
+    // Requests whose data is being read by the worker threads
+    std::deque<std::unique_ptr<Request>> m_LoadingRequests;
+    // Requests whose copy commands have been recorded, in fence order
+    std::deque<std::unique_ptr<Request>> m_CopiedRequests;
+};
+
+} // namespace
+
+BufferToTextureCopyInfo GetFileStreamingTextureCopyInfo(const TextureDesc& TexDesc, Uint32 MipLevel, const Box& Region)
+{
+    Box CopyRegion = Region;
+    if (!CopyRegion.IsValid())
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, MipLevel);
+
+        CopyRegion = Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+    }
+    return GetBufferToTextureCopyInfo(TexDesc.Format, CopyRegion, FileStreamingTextureRowStrideAlignment);
+}
+
+std::unique_ptr<FileStreamingQueue> CreateFileStreamingQueue(const FileStreamingQueueCreateInfo& CI)
+{
+    DEV_CHECK_ERR(CI.pDevice != nullptr, "Device must not be null");
+
+#ifdef DILIGENT_ENABLE_DSTORAGE
+    if (CI.UseDirectStorage && CI.pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12)
+    {
+        if (auto pQueue = CreateFileStreamingQueueD3D12(CI))
+            return pQueue;
+
+        LOG_WARNING_MESSAGE("Failed to create DirectStorage queue. File data will be streamed through the CPU.");
+    }
+#endif
+
+    return std::make_unique<FileStreamingQueueCPU>(CI);
+}
+
+} // namespace Diligent
@@ -0,0 +1,355 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include "WinHPreface.h"
+#include <d3d12.h>
+#include <atlbase.h>
+#include <dstorage.h>
+#include "WinHPostface.h"
+
+#include "FileStreamingQueueImpl.hpp"
+#include "RenderDeviceD3D12.h"
+#include "BufferD3D12.h"
+#include "TextureD3D12.h"
+#include "FenceD3D12.h"
+#include "RefCntAutoPtr.hpp"
+#include "StringTools.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class FileStreamingQueueD3D12 final : public FileStreamingQueue
+{
+public:
+    FileStreamingQueueD3D12(IRenderDevice*        pDevice,
+                            IDStorageFactory*     pFactory,
+                            IDStorageQueue*       pQueue,
+                            IDStorageStatusArray* pStatusArray,
+                            IFence*               pFence) :
+        m_pDevice{pDevice},
+        m_pFactory{pFactory},
+        m_pQueue{pQueue},
+        m_pStatusArray{pStatusArray},
+        m_pFence{pFence},
+        m_pd3d12Fence{RefCntAutoPtr<IFenceD3D12>{pFence, IID_FenceD3D12}->GetD3D12Fence()}
+    {
+    }
+
+    ~FileStreamingQueueD3D12()
+    {
+        DEV_CHECK_ERR(m_NumPendingRequests.load() == 0, "Destroying the file streaming queue with pending requests. Call Flush() first.");
+    }
+
+    virtual void Enqueue(const FileStreamingRequest& Req) override final
+    {
+        DEV_CHECK_ERR(Req.FilePath != nullptr, "File path must not be null");
+        DEV_CHECK_ERR((Req.pDstBuffer != nullptr) != (Req.pDstTexture != nullptr), "Exactly one of pDstBuffer and pDstTexture must not be null");
+        DEV_CHECK_ERR(Req.Size > 0 && Req.UncompressedSize > 0, "Data size must not be zero");
+        DEV_CHECK_ERR(Req.Compression != FILE_STREAMING_COMPRESSION_NONE || Req.Size == Req.UncompressedSize,
+                      "Uncompressed size (", Req.UncompressedSize, ") must be equal to the size (", Req.Size, ") when the data is not compressed");
+
+        Request NewReq;
+        NewReq.Desc          = Req;
+        NewReq.FilePath      = Req.FilePath;
+        NewReq.Desc.FilePath = nullptr;
+        NewReq.pDstBuffer    = Req.pDstBuffer;
+        NewReq.pDstTexture   = Req.pDstTexture;
+
+        ++m_NumPendingRequests;
+
+        std::lock_guard<std::mutex> Lock{m_NewRequestsMtx};
+        m_NewRequests.emplace_back(std::move(NewReq));
+    }
+
+    virtual void Update(IDeviceContext* /*pContext*/) override final
+    {
+        SubmitNewRequests();
+        CompleteBatches();
+    }
+
+    virtual void Flush(IDeviceContext* /*pContext*/) override final
+    {
+        while (m_NumPendingRequests.load() > 0)
+        {
+            SubmitNewRequests();
+            if (!m_Batches.empty())
+                m_pFence->Wait(m_Batches.back().FenceValue);
+            CompleteBatches();
+        }
+        // Release the file handles
+        m_Files.clear();
+    }
+
+    virtual size_t GetNumPendingRequests() override final
+    {
+        return m_NumPendingRequests.load();
+    }
+
+    virtual bool IsDirectStorageUsed() const override final
+    {
+        return true;
+    }
+
+    // The maximum number of batches in flight, which is also the status array capacity
+    static constexpr Uint32 MaxBatches = 64;
+
+private:
+    struct Request
+    {
+        FileStreamingRequest Desc;
+        String               FilePath;
+
+        RefCntAutoPtr<IBuffer>  pDstBuffer;
+        RefCntAutoPtr<ITexture> pDstTexture;
+    };
+
+    // All requests submitted by one Update() call share the status entry and the fence value
+    struct Batch
+    {
+        std::vector<Request> Requests;
+        Uint32               StatusIndex = 0;
+        Uint64               FenceValue  = 0;
+    };
+
+    IDStorageFile* GetFile(const String& Path)
+    {
+        auto it = m_Files.find(Path);
+        if (it != m_Files.end())
+            return it->second;
+
+        CComPtr<IDStorageFile> pFile;
+        if (FAILED(m_pFactory->OpenFile(WidenString(Path).c_str(), IID_PPV_ARGS(&pFile))))
+        {
+            LOG_ERROR_MESSAGE("DirectStorage failed to open file ", Path);
+            return nullptr;
+        }
+        return m_Files.emplace(Path, pFile).first->second;
+    }
+
+    bool EnqueueRequest(Request& Req)
+    {
+        IDStorageFile* pFile = GetFile(Req.FilePath);
+        if (pFile == nullptr)
+            return false;
+
+        const auto& Desc = Req.Desc;
+
+        DSTORAGE_REQUEST d3dsReq{};
+        d3dsReq.Options.SourceType        = DSTORAGE_REQUEST_SOURCE_FILE;
+        d3dsReq.Options.CompressionFormat = Desc.Compression == FILE_STREAMING_COMPRESSION_GDEFLATE ?
+            DSTORAGE_COMPRESSION_FORMAT_GDEFLATE :
+            DSTORAGE_COMPRESSION_FORMAT_NONE;
+        d3dsReq.Source.File.Source = pFile;
+        d3dsReq.Source.File.Offset = Desc.FileOffset;
+        d3dsReq.Source.File.Size   = Desc.Size;
+        d3dsReq.UncompressedSize   = Desc.UncompressedSize;
+        d3dsReq.Name               = Req.FilePath.c_str();
+
+        if (Req.pDstBuffer)
+        {
+            RefCntAutoPtr<IBufferD3D12> pBufferD3D12{Req.pDstBuffer, IID_BufferD3D12};
+            VERIFY(pBufferD3D12, "Failed to query the IBufferD3D12 interface");
+
+            Uint64 DataStartOffset = 0;
+
+            d3dsReq.Options.DestinationType     = DSTORAGE_REQUEST_DESTINATION_BUFFER;
+            d3dsReq.Destination.Buffer.Resource = pBufferD3D12->GetD3D12Buffer(DataStartOffset, nullptr);
+            d3dsReq.Destination.Buffer.Offset   = DataStartOffset + Desc.DstOffset;
+            d3dsReq.Destination.Buffer.Size     = Desc.UncompressedSize;
+            if (d3dsReq.Destination.Buffer.Resource == nullptr)
+            {
+                LOG_ERROR_MESSAGE("DirectStorage can't write to dynamic buffer '", Req.pDstBuffer->GetDesc().Name, "'");
+                return false;
+            }
+        }
+        else
+        {
+            RefCntAutoPtr<ITextureD3D12> pTextureD3D12{Req.pDstTexture, IID_TextureD3D12};
+            VERIFY(pTextureD3D12, "Failed to query the ITextureD3D12 interface");
+
+            const auto& TexDesc  = Req.pDstTexture->GetDesc();
+            const auto  CopyInfo = GetFileStreamingTextureCopyInfo(TexDesc, Desc.MipLevel, Desc.Region);
+
+            d3dsReq.Options.DestinationType              = DSTORAGE_REQUEST_DESTINATION_TEXTURE_REGION;
+            d3dsReq.Destination.Texture.Resource         = pTextureD3D12->GetD3D12Texture();
+            d3dsReq.Destination.Texture.SubresourceIndex = Desc.MipLevel + Desc.ArraySlice * TexDesc.MipLevels;
+            d3dsReq.Destination.Texture.Region           = D3D12_BOX{
+                CopyInfo.Region.MinX, CopyInfo.Region.MinY, CopyInfo.Region.MinZ,
+                CopyInfo.Region.MaxX, CopyInfo.Region.MaxY, CopyInfo.Region.MaxZ};
+        }
+
+        m_pQueue->EnqueueRequest(&d3dsReq);
+        return true;
+    }
+
+    void SubmitNewRequests()
+    {
+        if (m_Batches.size() >= MaxBatches)
+            return;
+
+        Batch NewBatch;
+        {
+            std::lock_guard<std::mutex> Lock{m_NewRequestsMtx};
+            NewBatch.Requests.swap(m_NewRequests);
+        }
+        if (NewBatch.Requests.empty())
+            return;
+
+        for (auto it = NewBatch.Requests.begin(); it != NewBatch.Requests.end();)
+        {
+            if (EnqueueRequest(*it))
+            {
+                ++it;
+                continue;
+            }
+
+            if (it->Desc.OnCompleted)
+                it->Desc.OnCompleted(false);
+            --m_NumPendingRequests;
+            it = NewBatch.Requests.erase(it);
+        }
+        if (NewBatch.Requests.empty())
+            return;
+
+        NewBatch.StatusIndex = m_NextStatusIndex;
+        NewBatch.FenceValue  = m_NextFenceValue++;
+        m_NextStatusIndex    = (m_NextStatusIndex + 1) % MaxBatches;
+
+        m_pQueue->EnqueueStatus(m_pStatusArray, NewBatch.StatusIndex);
+        m_pQueue->EnqueueSignal(m_pd3d12Fence, NewBatch.FenceValue);
+        m_pQueue->Submit();
+
+        m_Batches.emplace_back(std::move(NewBatch));
+    }
+
+    void CompleteBatches()
+    {
+        const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+        while (!m_Batches.empty() && m_Batches.front().FenceValue <= CompletedFenceValue)
+        {
+            auto Batch = std::move(m_Batches.front());
+            m_Batches.pop_front();
+
+            VERIFY_EXPR(m_pStatusArray->IsComplete(Batch.StatusIndex));
+            const bool Success = SUCCEEDED(m_pStatusArray->GetHResult(Batch.StatusIndex));
+            if (!Success)
+            {
+                DSTORAGE_ERROR_RECORD ErrorRecord{};
+                m_pQueue->RetrieveErrorRecord(&ErrorRecord);
+                LOG_ERROR_MESSAGE("DirectStorage request failed with HRESULT 0x", std::hex, ErrorRecord.FirstFailure.HResult, std::dec,
+                                  ". The number of failed requests: ", ErrorRecord.FailureCount);
+            }
+
+            for (auto& Req : Batch.Requests)
+            {
+                // DirectStorage leaves the resources in the common state
+                if (Req.pDstBuffer && Req.pDstBuffer->GetState() != RESOURCE_STATE_UNKNOWN)
+                    Req.pDstBuffer->SetState(RESOURCE_STATE_COMMON);
+                if (Req.pDstTexture && Req.pDstTexture->GetState() != RESOURCE_STATE_UNKNOWN)
+                    Req.pDstTexture->SetState(RESOURCE_STATE_COMMON);
+
+                if (Req.Desc.OnCompleted)
+                    Req.Desc.OnCompleted(Success);
+                --m_NumPendingRequests;
+            }
+        }
+    }
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    CComPtr<IDStorageFactory>     m_pFactory;
+    CComPtr<IDStorageQueue>       m_pQueue;
+    CComPtr<IDStorageStatusArray> m_pStatusArray;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    ID3D12Fence*          m_pd3d12Fence = nullptr;
+
+    Uint64 m_NextFenceValue  = 1;
+    Uint32 m_NextStatusIndex = 0;
+
+    std::atomic<size_t> m_NumPendingRequests{0};
+
+    std::mutex           m_NewRequestsMtx;
+    std::vector<Request> m_NewRequests;
+
+    // Submitted batches, in fence order
+    std::deque<Batch> m_Batches;
+
+    std::unordered_map<String, CComPtr<IDStorageFile>> m_Files;
+};
+
+} // namespace
+
+std::unique_ptr<FileStreamingQueue> CreateFileStreamingQueueD3D12(const FileStreamingQueueCreateInfo& CI)
+{
+    RefCntAutoPtr<IRenderDeviceD3D12> pDeviceD3D12{CI.pDevice, IID_RenderDeviceD3D12};
+    if (!pDeviceD3D12)
+    {
+        UNEXPECTED("Failed to query the IRenderDeviceD3D12 interface");
+        return nullptr;
+    }
+
+    CComPtr<IDStorageFactory> pFactory;
+    if (FAILED(DStorageGetFactory(IID_PPV_ARGS(&pFactory))))
+        return nullptr;
+
+    DSTORAGE_QUEUE_DESC QueueDesc{};
+    QueueDesc.Capacity   = DSTORAGE_MAX_QUEUE_CAPACITY;
+    QueueDesc.Priority   = DSTORAGE_PRIORITY_NORMAL;
+    QueueDesc.SourceType = DSTORAGE_REQUEST_SOURCE_FILE;
+    QueueDesc.Name       = "Diligent file streaming queue";
+    QueueDesc.Device     = pDeviceD3D12->GetD3D12Device();
+
+    CComPtr<IDStorageQueue> pQueue;
+    if (FAILED(pFactory->CreateQueue(&QueueDesc, IID_PPV_ARGS(&pQueue))))
+        return nullptr;
+
+    CComPtr<IDStorageStatusArray> pStatusArray;
+    if (FAILED(pFactory->CreateStatusArray(FileStreamingQueueD3D12::MaxBatches, "Diligent file streaming status array", IID_PPV_ARGS(&pStatusArray))))
+        return nullptr;
+
+    FenceDesc FncDesc;
+    FncDesc.Name = "File streaming queue fence";
+
+    RefCntAutoPtr<IFence> pFence;
+    CI.pDevice->CreateFence(FncDesc, &pFence);
+    if (!pFence)
+        return nullptr;
+
+    return std::make_unique<FileStreamingQueueD3D12>(CI.pDevice, pFactory, pQueue, pStatusArray, pFence);
+}
+
+} // namespace Diligent
@@ -0,0 +1,557 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUInstanceCuller.hpp"
+#include "HiZPyramid.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+const char* const CullingShaderSource = R"(
+#ifndef THREAD_GROUP_SIZE
+#   define THREAD_GROUP_SIZE 64
+#endif
+
+#define CULL_MODE_FRUSTUM                0
+#define CULL_MODE_OCCLUSION_FIRST_PHASE  1
+#define CULL_MODE_OCCLUSION_SECOND_PHASE 2
+
+#ifndef CULL_MODE
+#   define CULL_MODE CULL_MODE_FRUSTUM
+#endif
+
+struct InstanceData
+{
+    float4 BoundingSphere;
+    uint   DrawGroup;
+    uint   Padding0;
+    uint   Padding1;
+    uint   Padding2;
+};
+
+struct DrawGroupData
+{
+    uint NumIndices;
+    uint FirstIndexLocation;
+    uint BaseVertex;
+    uint Padding;
+};
+
+cbuffer cbCullingAttribs
+{
+    float4   g_FrustumPlanes[6];
+    float4x4 g_ViewProj;
+    float4   g_NDCAttribs; // ZtoDepthScale, ZtoDepthBias, YtoVScale
+    uint     g_NumInstances;
+    uint     g_NumDrawGroups;
+    uint     g_MaxDrawGroups;
+    uint     g_HiZReverseDepth;
+    uint2    g_HiZSize;
+    uint     g_HiZNumMips;
+    uint     g_Padding;
+};
+
+StructuredBuffer<InstanceData>  g_Instances;
+StructuredBuffer<DrawGroupData> g_DrawGroups;
+
+RWBuffer<uint /*format = r32ui*/> g_GroupCounters;
+RWBuffer<uint /*format = r32ui*/> g_GroupOffsets;
+RWBuffer<uint /*format = r32ui*/> g_DrawArgs;
+RWBuffer<uint /*format = r32ui*/> g_DrawCount;
+RWBuffer<uint /*format = r32ui*/> g_VisibleInstances;
+
+#if CULL_MODE != CULL_MODE_FRUSTUM
+// Visibility of every instance after the last second phase
+RWBuffer<uint /*format = r32ui*/> g_InstanceVisibility;
+#endif
+
+#if CULL_MODE == CULL_MODE_OCCLUSION_SECOND_PHASE
+Texture2D<float> g_HiZPyramid;
+
+bool IsOccluded(float4 Sphere)
+{
+    float2 MinUV = float2(+1e+30, +1e+30);
+    float2 MaxUV = float2(-1e+30, -1e+30);
+    float  NearestDepth = g_HiZReverseDepth != 0u ? 0.0 : 1.0;
+    // Project the corners of the bounding box of the sphere
+    for (uint i = 0u; i < 8u; ++i)
+    {
+        float3 Offset;
+        Offset.x = (i & 1u) != 0u ? Sphere.w : -Sphere.w;
+        Offset.y = (i & 2u) != 0u ? Sphere.w : -Sphere.w;
+        Offset.z = (i & 4u) != 0u ? Sphere.w : -Sphere.w;
+
+        float4 Pos = mul(float4(Sphere.xyz + Offset, 1.0), g_ViewProj);
+        // The box crosses the plane of the camera
+        if (Pos.w <= 0.0)
+            return false;
+
+        float3 NDC = Pos.xyz / Pos.w;
+        float2 UV  = float2(NDC.x * 0.5 + 0.5, NDC.y * g_NDCAttribs.z + 0.5);
+        float Depth = NDC.z * g_NDCAttribs.x + g_NDCAttribs.y;
+
+        MinUV = min(MinUV, UV);
+        MaxUV = max(MaxUV, UV);
+        NearestDepth = g_HiZReverseDepth != 0u ? max(NearestDepth, Depth) : min(NearestDepth, Depth);
+    }
+
+    uint2 MinTexel = min(uint2(saturate(MinUV) * float2(g_HiZSize)), g_HiZSize - 1u);
+    uint2 MaxTexel = min(uint2(saturate(MaxUV) * float2(g_HiZSize)), g_HiZSize - 1u);
+
+    // Select the level where the box covers at most 2x2 texels
+    uint Extent = max(MaxTexel.x - MinTexel.x, MaxTexel.y - MinTexel.y);
+    uint Level  = Extent > 0u ? uint(firstbithigh(Extent)) + 1u : 0u;
+    Level = min(Level, g_HiZNumMips - 1u);
+
+    uint2 MipSize = max(g_HiZSize >> Level, uint2(1u, 1u));
+    MinTexel = min(MinTexel >> Level, MipSize - 1u);
+    MaxTexel = min(MaxTexel >> Level, MipSize - 1u);
+
+    float Depth00 = g_HiZPyramid.Load(int3(MinTexel.x, MinTexel.y, Level));
+    float Depth10 = g_HiZPyramid.Load(int3(MaxTexel.x, MinTexel.y, Level));
+    float Depth01 = g_HiZPyramid.Load(int3(MinTexel.x, MaxTexel.y, Level));
+    float Depth11 = g_HiZPyramid.Load(int3(MaxTexel.x, MaxTexel.y, Level));
+    if (g_HiZReverseDepth != 0u)
+        return NearestDepth < min(min(Depth00, Depth10), min(Depth01, Depth11));
+    else
+        return NearestDepth > max(max(Depth00, Depth10), max(Depth01, Depth11));
+}
+#endif
+
+bool IsVisible(InstanceData Inst)
+{
+    if (Inst.DrawGroup >= g_NumDrawGroups)
+        return false;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (dot(g_FrustumPlanes[i].xyz, Inst.BoundingSphere.xyz) + g_FrustumPlanes[i].w < -Inst.BoundingSphere.w)
+            return false;
+    }
+
+#if CULL_MODE == CULL_MODE_OCCLUSION_SECOND_PHASE
+    if (IsOccluded(Inst.BoundingSphere))
+        return false;
+#endif
+
+    return true;
+}
+
+// Returns true if the instance must be drawn in this phase
+bool ShouldDraw(uint InstanceId, bool Visible)
+{
+#if CULL_MODE == CULL_MODE_OCCLUSION_FIRST_PHASE
+    return Visible && g_InstanceVisibility[InstanceId] != 0u;
+#elif CULL_MODE == CULL_MODE_OCCLUSION_SECOND_PHASE
+    // Instances visible in the last frame were drawn in the first phase
+    return Visible && g_InstanceVisibility[InstanceId] == 0u;
+#else
+    return Visible;
+#endif
+}
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void ResetCountersCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x < g_NumDrawGroups)
+        g_GroupCounters[DTid.x] = 0u;
+}
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void CountVisibleCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x >= g_NumInstances)
+        return;
+
+    InstanceData Inst = g_Instances[DTid.x];
+    if (ShouldDraw(DTid.x, IsVisible(Inst)))
+        InterlockedAdd(g_GroupCounters[Inst.DrawGroup], 1u);
+}
+
+groupshared uint g_InstanceScan[THREAD_GROUP_SIZE];
+groupshared uint g_DrawScan[THREAD_GROUP_SIZE];
+
+// Runs as a single thread group that processes the draw groups in chunks of THREAD_GROUP_SIZE
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void BuildDrawArgsCS(uint3 GTid : SV_GroupThreadID)
+{
+    uint Thread        = GTid.x;
+    uint FirstInstance = 0u;
+    uint DrawCount     = 0u;
+    for (uint ChunkStart = 0u; ChunkStart < g_NumDrawGroups; ChunkStart += THREAD_GROUP_SIZE)
+    {
+        uint Group        = ChunkStart + Thread;
+        uint NumInstances = Group < g_NumDrawGroups ? g_GroupCounters[Group] : 0u;
+
+        g_InstanceScan[Thread] = NumInstances;
+        g_DrawScan[Thread]     = NumInstances > 0u ? 1u : 0u;
+        GroupMemoryBarrierWithGroupSync();
+
+        // Inclusive prefix sum of the instance counts and non-empty group flags
+        for (uint Offset = 1u; Offset < THREAD_GROUP_SIZE; Offset <<= 1u)
+        {
+            uint InstanceSum = g_InstanceScan[Thread];
+            uint DrawSum     = g_DrawScan[Thread];
+            if (Thread >= Offset)
+            {
+                InstanceSum += g_InstanceScan[Thread - Offset];
+                DrawSum     += g_DrawScan[Thread - Offset];
+            }
+            GroupMemoryBarrierWithGroupSync();
+            g_InstanceScan[Thread] = InstanceSum;
+            g_DrawScan[Thread]     = DrawSum;
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        if (Group < g_NumDrawGroups)
+        {
+            uint GroupFirstInstance = FirstInstance + g_InstanceScan[Thread] - NumInstances;
+            g_GroupOffsets[Group]   = GroupFirstInstance;
+            // The counter is used as the write cursor by the compaction pass
+            g_GroupCounters[Group] = 0u;
+            if (NumInstances > 0u)
+            {
+                DrawGroupData GroupData = g_DrawGroups[Group];
+
+                uint Draw = DrawCount + g_DrawScan[Thread] - 1u;
+                g_DrawArgs[Draw * 5u + 0u] = GroupData.NumIndices;
+                g_DrawArgs[Draw * 5u + 1u] = NumInstances;
+                g_DrawArgs[Draw * 5u + 2u] = GroupData.FirstIndexLocation;
+                g_DrawArgs[Draw * 5u + 3u] = GroupData.BaseVertex;
+                g_DrawArgs[Draw * 5u + 4u] = GroupFirstInstance;
+            }
+        }
+
+        FirstInstance += g_InstanceScan[THREAD_GROUP_SIZE - 1u];
+        DrawCount     += g_DrawScan[THREAD_GROUP_SIZE - 1u];
+        // Shared memory is overwritten by the next chunk
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    // Commands after the last valid one draw nothing, so that the arguments
+    // can also be used without the counter buffer.
+    for (uint Draw = DrawCount + Thread; Draw < g_NumDrawGroups; Draw += THREAD_GROUP_SIZE)
+    {
+        g_DrawArgs[Draw * 5u + 0u] = 0u;
+        g_DrawArgs[Draw * 5u + 1u] = 0u;
+        g_DrawArgs[Draw * 5u + 2u] = 0u;
+        g_DrawArgs[Draw * 5u + 3u] = 0u;
+        g_DrawArgs[Draw * 5u + 4u] = 0u;
+    }
+
+    if (Thread == 0u)
+        g_DrawCount[0] = DrawCount;
+}
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void CompactCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x >= g_NumInstances)
+        return;
+
+    InstanceData Inst    = g_Instances[DTid.x];
+    bool         Visible = IsVisible(Inst);
+    if (ShouldDraw(DTid.x, Visible))
+    {
+        uint Slot;
+        InterlockedAdd(g_GroupCounters[Inst.DrawGroup], 1u, Slot);
+        g_VisibleInstances[g_GroupOffsets[Inst.DrawGroup] + Slot] = DTid.x;
+    }
+
+#if CULL_MODE == CULL_MODE_OCCLUSION_SECOND_PHASE
+    // The history is only updated after it has been read by both passes
+    g_InstanceVisibility[DTid.x] = Visible ? 1u : 0u;
+#endif
+}
+)";
+// clang-format on
+
+struct CullingAttribsCB
+{
+    float4   FrustumPlanes[6];
+    float4x4 ViewProj;
+    float4   NDCAttribs;
+    Uint32   NumInstances;
+    Uint32   NumDrawGroups;
+    Uint32   MaxDrawGroups;
+    Uint32   HiZReverseDepth;
+    Uint32   HiZWidth;
+    Uint32   HiZHeight;
+    Uint32   HiZNumMips;
+    Uint32   Padding;
+};
+
+RefCntAutoPtr<IBuffer> CreateUintBuffer(IRenderDevice* pDevice, const char* Name, Uint32 NumElements, BIND_FLAGS BindFlags, const Uint32* pInitData = nullptr)
+{
+    BufferDesc Desc;
+    Desc.Name              = Name;
+    Desc.Size              = Uint64{std::max(NumElements, 1u)} * sizeof(Uint32);
+    Desc.BindFlags         = BindFlags | BIND_UNORDERED_ACCESS;
+    Desc.Mode              = BUFFER_MODE_FORMATTED;
+    Desc.ElementByteStride = sizeof(Uint32);
+
+    BufferData InitData{pInitData, Desc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(Desc, pInitData != nullptr ? &InitData : nullptr, &pBuffer);
+    if (!pBuffer)
+        LOG_ERROR_AND_THROW("Failed to create buffer '", Name, "'");
+    return pBuffer;
+}
+
+RefCntAutoPtr<IBufferView> CreateUintUAV(IBuffer* pBuffer)
+{
+    BufferViewDesc ViewDesc;
+    ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+
+    RefCntAutoPtr<IBufferView> pView;
+    pBuffer->CreateView(ViewDesc, &pView);
+    if (!pView)
+        LOG_ERROR_AND_THROW("Failed to create UAV for buffer '", pBuffer->GetDesc().Name, "'");
+    return pView;
+}
+
+void SetVariable(IShaderResourceBinding* pSRB, const char* Name, IDeviceObject* pObject)
+{
+    // Every pass only uses a subset of the resources
+    if (IShaderResourceVariable* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, Name))
+        pVar->Set(pObject);
+}
+
+} // namespace
+
+GPUInstanceCuller::GPUInstanceCuller(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_MaxInstances{CI.MaxInstances},
+    m_MaxDrawGroups{CI.MaxDrawGroups},
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_MaxInstances == 0 || m_MaxDrawGroups == 0)
+        LOG_ERROR_AND_THROW("The maximum number of instances and draw groups must not be zero");
+    if (m_ThreadGroupSize == 0 || (m_ThreadGroupSize & (m_ThreadGroupSize - 1)) != 0)
+        LOG_ERROR_AND_THROW("Thread group size (", m_ThreadGroupSize, ") must be a power of two");
+
+    const auto DrawCapFlags = m_pDevice->GetAdapterInfo().DrawCommand.CapFlags;
+    if ((DrawCapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT) == 0 ||
+        (DrawCapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE) == 0)
+    {
+        LOG_ERROR_AND_THROW("GPU instance culling requires indirect draw commands with the first instance location");
+    }
+    m_UseCounterBuffer = (DrawCapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER) != 0;
+
+    CreateBuffers();
+    CreatePipelines();
+}
+
+GPUInstanceCuller::~GPUInstanceCuller()
+{
+}
+
+void GPUInstanceCuller::CreateBuffers()
+{
+    CreateUniformBuffer(m_pDevice, sizeof(CullingAttribsCB), "GPU instance culler attribs CB", &m_pCullAttribsCB);
+    if (!m_pCullAttribsCB)
+        LOG_ERROR_AND_THROW("Failed to create culling attribs buffer");
+
+    m_pGroupCounters    = CreateUintBuffer(m_pDevice, "GPU instance culler group counters", m_MaxDrawGroups, BIND_NONE);
+    m_pGroupOffsets     = CreateUintBuffer(m_pDevice, "GPU instance culler group offsets", m_MaxDrawGroups, BIND_NONE);
+    m_pDrawArgs         = CreateUintBuffer(m_pDevice, "GPU instance culler draw args", m_MaxDrawGroups * 5, BIND_INDIRECT_DRAW_ARGS);
+    m_pDrawCount        = CreateUintBuffer(m_pDevice, "GPU instance culler draw count", 1, BIND_INDIRECT_DRAW_ARGS);
+    m_pVisibleInstances = CreateUintBuffer(m_pDevice, "GPU instance culler visible instances", m_MaxInstances, BIND_VERTEX_BUFFER | BIND_SHADER_RESOURCE);
+
+    // All instances are initially invisible, so the first phase of the first frame draws nothing
+    std::vector<Uint32> Zeros(m_MaxInstances);
+    m_pInstanceVisibility = CreateUintBuffer(m_pDevice, "GPU instance culler instance visibility", m_MaxInstances, BIND_NONE, Zeros.data());
+}
+
+void GPUInstanceCuller::CreatePipelines()
+{
+    static constexpr const char* EntryPoints[PASS_COUNT] = {
+        "ResetCountersCS",
+        "CountVisibleCS",
+        "BuildDrawArgsCS",
+        "CompactCS",
+    };
+
+    std::pair<const char*, RefCntAutoPtr<IBufferView>> UAVs[] = {
+        {"g_GroupCounters", CreateUintUAV(m_pGroupCounters)},
+        {"g_GroupOffsets", CreateUintUAV(m_pGroupOffsets)},
+        {"g_DrawArgs", CreateUintUAV(m_pDrawArgs)},
+        {"g_DrawCount", CreateUintUAV(m_pDrawCount)},
+        {"g_VisibleInstances", CreateUintUAV(m_pVisibleInstances)},
+        {"g_InstanceVisibility", CreateUintUAV(m_pInstanceVisibility)},
+    };
+
+    for (Uint32 Mode = 0; Mode < CULL_MODE_COUNT; ++Mode)
+    {
+        for (Uint32 Pass = 0; Pass < PASS_COUNT; ++Pass)
+        {
+            if (Mode != CULL_MODE_FRUSTUM && Pass != PASS_COUNT_VISIBLE && Pass != PASS_COMPACT)
+            {
+                m_pPSO[Mode][Pass] = m_pPSO[CULL_MODE_FRUSTUM][Pass];
+                m_pSRB[Mode][Pass] = m_pSRB[CULL_MODE_FRUSTUM][Pass];
+                continue;
+            }
+
+            ShaderMacroHelper Macros;
+            Macros.AddShaderMacro("THREAD_GROUP_SIZE", m_ThreadGroupSize);
+            Macros.AddShaderMacro("CULL_MODE", Mode);
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+            ShaderCI.Desc           = {EntryPoints[Pass], SHADER_TYPE_COMPUTE, true};
+            ShaderCI.EntryPoint     = EntryPoints[Pass];
+            ShaderCI.Source         = CullingShaderSource;
+            ShaderCI.Macros         = Macros;
+
+            RefCntAutoPtr<IShader> pCS;
+            m_pDevice->CreateShader(ShaderCI, &pCS);
+            if (!pCS)
+                LOG_ERROR_AND_THROW("Failed to create GPU instance culling shader '", EntryPoints[Pass], "'");
+
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            PSOCreateInfo.PSODesc.Name                               = EntryPoints[Pass];
+            PSOCreateInfo.PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+            PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+            PSOCreateInfo.pCS                                        = pCS;
+
+            auto& pPSO = m_pPSO[Mode][Pass];
+            m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+            if (!pPSO)
+                LOG_ERROR_AND_THROW("Failed to create GPU instance culling pipeline '", EntryPoints[Pass], "'");
+
+            auto& pSRB = m_pSRB[Mode][Pass];
+            pPSO->CreateShaderResourceBinding(&pSRB, true);
+            VERIFY_EXPR(pSRB);
+
+            SetVariable(pSRB, "cbCullingAttribs", m_pCullAttribsCB);
+            for (auto& UAV : UAVs)
+                SetVariable(pSRB, UAV.first, UAV.second);
+        }
+    }
+}
+
+void GPUInstanceCuller::Cull(IDeviceContext* pContext, const CullAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    DEV_CHECK_ERR(Attribs.NumInstances <= m_MaxInstances, "The number of instances (", Attribs.NumInstances, ") exceeds the maximum (", m_MaxInstances, ")");
+    DEV_CHECK_ERR(Attribs.NumDrawGroups <= m_MaxDrawGroups, "The number of draw groups (", Attribs.NumDrawGroups, ") exceeds the maximum (", m_MaxDrawGroups, ")");
+    DEV_CHECK_ERR(Attribs.pInstances != nullptr || Attribs.NumInstances == 0, "Instance buffer must not be null");
+    DEV_CHECK_ERR(Attribs.pDrawGroups != nullptr || Attribs.NumDrawGroups == 0, "Draw group buffer must not be null");
+    DEV_CHECK_ERR(Attribs.Mode < CULL_MODE_COUNT, "Invalid culling mode");
+    DEV_CHECK_ERR(Attribs.Mode != CULL_MODE_OCCLUSION_SECOND_PHASE || (Attribs.pHiZPyramid != nullptr && Attribs.pHiZPyramid->GetSRV() != nullptr),
+                  "The second phase of the occlusion culling requires a Hi-Z pyramid that has been built");
+    if (Attribs.NumDrawGroups == 0)
+        return;
+
+    const HiZPyramid* pHiZ = Attribs.Mode == CULL_MODE_OCCLUSION_SECOND_PHASE ? Attribs.pHiZPyramid : nullptr;
+    {
+        MapHelper<CullingAttribsCB> CBData{pContext, m_pCullAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+        for (size_t i = 0; i < _countof(CBData->FrustumPlanes); ++i)
+            CBData->FrustumPlanes[i] = Attribs.FrustumPlanes[i];
+
+        const auto& NDC         = m_pDevice->GetDeviceInfo().GetNDCAttribs();
+        CBData->ViewProj        = Attribs.ViewProj.Transpose();
+        CBData->NDCAttribs      = float4{NDC.ZtoDepthScale, NDC.GetZtoDepthBias(), NDC.YtoVScale, 0};
+        CBData->NumInstances    = Attribs.NumInstances;
+        CBData->NumDrawGroups   = Attribs.NumDrawGroups;
+        CBData->MaxDrawGroups   = m_MaxDrawGroups;
+        CBData->HiZReverseDepth = pHiZ != nullptr && pHiZ->IsReverseDepth() ? 1 : 0;
+        CBData->HiZWidth        = pHiZ != nullptr ? pHiZ->GetWidth() : 0;
+        CBData->HiZHeight       = pHiZ != nullptr ? pHiZ->GetHeight() : 0;
+        CBData->HiZNumMips      = pHiZ != nullptr ? pHiZ->GetNumMipLevels() : 0;
+        CBData->Padding         = 0;
+    }
+
+    IBufferView* pInstancesSRV  = Attribs.pInstances != nullptr ? Attribs.pInstances->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE) : nullptr;
+    IBufferView* pDrawGroupsSRV = Attribs.pDrawGroups->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+    DEV_CHECK_ERR(Attribs.pInstances == nullptr || pInstancesSRV != nullptr, "Instance buffer must be a structured buffer with BIND_SHADER_RESOURCE flag");
+    DEV_CHECK_ERR(pDrawGroupsSRV != nullptr, "Draw group buffer must be a structured buffer with BIND_SHADER_RESOURCE flag");
+
+    const Uint32 NumInstanceGroups = (Attribs.NumInstances + m_ThreadGroupSize - 1) / m_ThreadGroupSize;
+    const Uint32 NumDrawGroupGroups = (Attribs.NumDrawGroups + m_ThreadGroupSize - 1) / m_ThreadGroupSize;
+
+    const Uint32 ThreadGroupCounts[PASS_COUNT] = {
+        NumDrawGroupGroups, // PASS_RESET_COUNTERS
+        NumInstanceGroups,  // PASS_COUNT_VISIBLE
+        1,                  // PASS_BUILD_DRAW_ARGS
+        NumInstanceGroups,  // PASS_COMPACT
+    };
+
+    for (Uint32 Pass = 0; Pass < PASS_COUNT; ++Pass)
+    {
+        if (ThreadGroupCounts[Pass] == 0)
+            continue;
+
+        auto* pSRB = m_pSRB[Attribs.Mode][Pass].RawPtr();
+        SetVariable(pSRB, "g_Instances", pInstancesSRV);
+        SetVariable(pSRB, "g_DrawGroups", pDrawGroupsSRV);
+        if (pHiZ != nullptr)
+            SetVariable(pSRB, "g_HiZPyramid", pHiZ->GetSRV());
+
+        pContext->SetPipelineState(m_pPSO[Attribs.Mode][Pass]);
+        // Transitioning the resources also inserts UAV barriers between the passes
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{ThreadGroupCounts[Pass], 1, 1});
+    }
+}
+
+DrawIndexedIndirectAttribs GPUInstanceCuller::GetDrawIndexedIndirectAttribs(VALUE_TYPE IndexType, Uint32 NumDrawGroups) const
+{
+    DEV_CHECK_ERR(NumDrawGroups <= m_MaxDrawGroups, "The number of draw groups (", NumDrawGroups, ") exceeds the maximum (", m_MaxDrawGroups, ")");
+
+    DrawIndexedIndirectAttribs Attribs;
+    Attribs.IndexType                        = IndexType;
+    Attribs.pAttribsBuffer                   = GetDrawArgsBuffer();
+    Attribs.DrawCount                        = NumDrawGroups;
+    Attribs.DrawArgsStride                   = sizeof(Uint32) * 5;
+    Attribs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    if (m_UseCounterBuffer)
+    {
+        Attribs.pCounterBuffer                   = GetDrawCountBuffer();
+        Attribs.CounterBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    }
+    return Attribs;
+}
+
+} // namespace Diligent
@@ -0,0 +1,457 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUProfiler.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <limits>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+GPUProfiler::GPUProfiler(const CreateInfo& CI) :
+    m_MaxScopesPerFrame{CI.MaxScopesPerFrame},
+    m_StatisticsWindow{std::max(CI.StatisticsWindow, 1u)},
+    m_TraceHistorySize{CI.TraceHistorySize},
+    m_EmitDebugGroups{CI.EmitDebugGroups},
+    m_CalibrateTimestamps{CI.CalibrateTimestamps}
+{
+    DEV_CHECK_ERR(CI.pDevice != nullptr, "Render device must not be null");
+    if (!CI.pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        LOG_WARNING_MESSAGE("Timestamp queries are not supported by this device. GPU profiler is disabled.");
+        return;
+    }
+
+    QueryDesc queryDesc{QUERY_TYPE_TIMESTAMP};
+    queryDesc.Name = "GPU profiler timestamp query";
+
+    const Uint32 NumQueriesPerFrame = 2 + 2 * m_MaxScopesPerFrame;
+
+    m_Frames.resize(size_t{CI.FrameLatency} + 1);
+    for (auto& Frame : m_Frames)
+    {
+        Frame.Queries.resize(NumQueriesPerFrame);
+        Frame.QueryPtrs.resize(NumQueriesPerFrame);
+        for (Uint32 i = 0; i < NumQueriesPerFrame; ++i)
+        {
+            CI.pDevice->CreateQuery(queryDesc, &Frame.Queries[i]);
+            VERIFY(Frame.Queries[i], "Failed to create timestamp query");
+            Frame.QueryPtrs[i] = Frame.Queries[i];
+        }
+        Frame.Scopes.resize(m_MaxScopesPerFrame);
+    }
+    m_Timestamps.resize(NumQueriesPerFrame);
+    m_ScopeStack.reserve(16);
+    m_Results.reserve(m_MaxScopesPerFrame);
+    m_ResultHistoryIdx.reserve(m_MaxScopesPerFrame);
+}
+
+double GPUProfiler::GetCPUTime() const
+{
+    return std::chrono::duration<double>{std::chrono::steady_clock::now() - m_StartTime}.count();
+}
+
+bool GPUProfiler::ReadFrameResults(IDeviceContext* pCtx, FrameData& Frame)
+{
+    VERIFY_EXPR(Frame.IsPending);
+
+    // Read all timestamps of the frame at once. The queries are not invalidated as
+    // the frame may only be partially complete. Timestamp queries are reallocated
+    // anyway when they are ended again.
+    const Uint32 NumQueries   = 2 + 2 * Frame.NumScopes;
+    const Uint32 NumAvailable = pCtx->GetQueryData(NumQueries, Frame.QueryPtrs.data(), m_Timestamps.data(), sizeof(QueryDataTimestamp), nullptr, false);
+    if (NumAvailable < NumQueries)
+        return false;
+
+    Frame.IsPending = false;
+
+    // Zero frequency indicates that the timestamps are not reliable (e.g. disjoint query in Direct3D11)
+    for (Uint32 i = 0; i < NumQueries; ++i)
+    {
+        if (m_Timestamps[i].Frequency == 0)
+        {
+            ++m_NumDroppedFrames;
+            return true;
+        }
+    }
+
+    const auto ToSeconds = [this](Uint32 QueryIdx) {
+        const auto& FrameStart = m_Timestamps[0];
+        const auto& Timestamp  = m_Timestamps[QueryIdx];
+        return Timestamp.Counter >= FrameStart.Counter ?
+            static_cast<double>(Timestamp.Counter - FrameStart.Counter) / static_cast<double>(Timestamp.Frequency) :
+            0.0;
+    };
+
+    m_Results.resize(Frame.NumScopes);
+    for (Uint32 scope = 0; scope < Frame.NumScopes; ++scope)
+    {
+        const auto& Src = Frame.Scopes[scope];
+        auto&       Dst = m_Results[scope];
+
+        Dst.Name        = Src.Name;
+        Dst.Depth       = Src.Depth;
+        Dst.ParentIndex = Src.ParentIndex;
+        Dst.StartTime   = ToSeconds(2 + 2 * scope);
+        Dst.Duration    = std::max(ToSeconds(3 + 2 * scope) - Dst.StartTime, 0.0);
+
+        Dst.CPUStartTime = Src.CPUStartTime;
+        Dst.CPUDuration  = Src.CPUDuration;
+    }
+    m_ResultsFrameDuration    = ToSeconds(1);
+    m_ResultsCPUFrameDuration = Frame.CPUDuration;
+    m_ResultsFrameIndex       = Frame.FrameIndex;
+
+    m_ResultsCalibrated      = Frame.IsCalibrated && Frame.Calibration.GPUFrequency != 0;
+    m_ResultsGPUStartLatency = 0;
+    m_ResultsGPUIdleTime     = 0;
+
+    // Without the calibration, the GPU frame is aligned with the CPU frame start
+    double GPUStartTime = Frame.CPUStartTime;
+    if (m_ResultsCalibrated)
+    {
+        // Convert the frame start timestamp to the CPU clock. The calibration CPU time and the profiler
+        // start time are both in the steady clock domain, so their difference is the time on the profiler timeline.
+        const auto GPUStartNs = GPUTimestampToCPUTime(Frame.Calibration, m_Timestamps[0].Counter);
+        const auto StartNs    = static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_StartTime.time_since_epoch()).count());
+
+        GPUStartTime = GPUStartNs >= StartNs ?
+            static_cast<double>(GPUStartNs - StartNs) * 1e-9 :
+            -static_cast<double>(StartNs - GPUStartNs) * 1e-9;
+
+        m_ResultsGPUStartLatency = std::max(GPUStartTime - Frame.CPUStartTime, 0.0);
+        if (m_LastGPUFrameIndex != ~Uint64{0} && m_LastGPUFrameIndex + 1 == Frame.FrameIndex)
+            m_ResultsGPUIdleTime = std::max(GPUStartTime - m_LastGPUFrameEnd, 0.0);
+
+        m_LastGPUFrameEnd   = GPUStartTime + m_ResultsFrameDuration;
+        m_LastGPUFrameIndex = Frame.FrameIndex;
+    }
+
+    UpdateStatistics(Frame.FrameIndex);
+
+    if (m_TraceHistorySize > 0)
+    {
+        if (m_TraceHistory.size() >= m_TraceHistorySize)
+        {
+            // Reuse the oldest frame to avoid reallocating the scopes
+            m_TraceHistory.push_back(std::move(m_TraceHistory.front()));
+            m_TraceHistory.pop_front();
+        }
+        else
+        {
+            m_TraceHistory.emplace_back();
+        }
+
+        auto& TraceFrame{m_TraceHistory.back()};
+        TraceFrame.FrameIndex   = Frame.FrameIndex;
+        TraceFrame.CPUStartTime = Frame.CPUStartTime;
+        TraceFrame.CPUDuration  = Frame.CPUDuration;
+        TraceFrame.GPUStartTime = GPUStartTime;
+        TraceFrame.Duration     = m_ResultsFrameDuration;
+        TraceFrame.Scopes       = m_Results;
+    }
+
+    return true;
+}
+
+void GPUProfiler::UpdateStatistics(Uint64 FrameIndex)
+{
+    m_ResultHistoryIdx.resize(m_Results.size());
+
+    std::string Path;
+    for (size_t scope = 0; scope < m_Results.size(); ++scope)
+    {
+        const auto& Timing = m_Results[scope];
+        if (Timing.ParentIndex != InvalidIndex)
+        {
+            VERIFY_EXPR(Timing.ParentIndex < scope);
+            Path = m_ScopeHistory[m_ResultHistoryIdx[Timing.ParentIndex]].Path;
+            Path.push_back('/');
+            Path.append(Timing.Name);
+        }
+        else
+        {
+            Path = Timing.Name;
+        }
+
+        auto it = m_ScopeHistoryIdx.find(Path);
+        if (it == m_ScopeHistoryIdx.end())
+        {
+            it = m_ScopeHistoryIdx.emplace(Path, m_ScopeHistory.size()).first;
+            m_ScopeHistory.emplace_back();
+
+            auto& NewHistory = m_ScopeHistory.back();
+            NewHistory.Path  = Path;
+            NewHistory.Depth = Timing.Depth;
+            NewHistory.Durations.resize(m_StatisticsWindow);
+            NewHistory.CPUDurations.resize(m_StatisticsWindow);
+        }
+        m_ResultHistoryIdx[scope] = it->second;
+
+        auto& History = m_ScopeHistory[it->second];
+        if (History.LastFrame == FrameIndex)
+        {
+            // The scope has been begun several times in this frame - accumulate the durations
+            const auto LastSample = (History.NextSample + m_StatisticsWindow - 1) % m_StatisticsWindow;
+            History.Durations[LastSample] += static_cast<float>(Timing.Duration);
+            History.CPUDurations[LastSample] += static_cast<float>(Timing.CPUDuration);
+            continue;
+        }
+
+        // Frames in which the scope was not recorded leave the window
+        if (History.LastFrame != ~Uint64{0})
+        {
+            const auto NumSkipped = std::min<Uint64>(FrameIndex - History.LastFrame - 1, History.NumSamples);
+            History.NumSamples -= static_cast<Uint32>(NumSkipped);
+        }
+
+        History.Durations[History.NextSample]    = static_cast<float>(Timing.Duration);
+        History.CPUDurations[History.NextSample] = static_cast<float>(Timing.CPUDuration);
+        History.NextSample                       = (History.NextSample + 1) % m_StatisticsWindow;
+        History.NumSamples                       = std::min(History.NumSamples + 1, m_StatisticsWindow);
+        History.LastFrame                        = FrameIndex;
+    }
+}
+
+std::vector<GPUProfiler::ScopeStatistics> GPUProfiler::GetScopeStatistics() const
+{
+    std::vector<ScopeStatistics> Stats;
+    Stats.reserve(m_ScopeHistory.size());
+    for (const auto& History : m_ScopeHistory)
+    {
+        // Skip the scopes that have not been recorded within the window
+        if (History.NumSamples == 0 || m_ResultsFrameIndex - History.LastFrame >= m_StatisticsWindow)
+            continue;
+
+        // The number of samples that are still in the window
+        const auto NumSamples = std::min(History.NumSamples, static_cast<Uint32>(m_StatisticsWindow - (m_ResultsFrameIndex - History.LastFrame)));
+
+        Stats.emplace_back();
+        auto& Stat{Stats.back()};
+        Stat.Path           = History.Path;
+        Stat.Depth          = History.Depth;
+        Stat.NumSamples     = NumSamples;
+        Stat.MinDuration    = std::numeric_limits<double>::max();
+        Stat.MinCPUDuration = std::numeric_limits<double>::max();
+        for (Uint32 i = 0; i < NumSamples; ++i)
+        {
+            const auto Sample      = (History.NextSample + m_StatisticsWindow - 1 - i) % m_StatisticsWindow;
+            const auto Duration    = static_cast<double>(History.Durations[Sample]);
+            const auto CPUDuration = static_cast<double>(History.CPUDurations[Sample]);
+
+            Stat.MinDuration = std::min(Stat.MinDuration, Duration);
+            Stat.MaxDuration = std::max(Stat.MaxDuration, Duration);
+            Stat.AvgDuration += Duration;
+
+            Stat.MinCPUDuration = std::min(Stat.MinCPUDuration, CPUDuration);
+            Stat.MaxCPUDuration = std::max(Stat.MaxCPUDuration, CPUDuration);
+            Stat.AvgCPUDuration += CPUDuration;
+        }
+        Stat.AvgDuration /= NumSamples;
+        Stat.AvgCPUDuration /= NumSamples;
+    }
+    return Stats;
+}
+
+static void WriteJSONString(std::ostream& Stream, const std::string& Str)
+{
+    Stream << '"';
+    for (auto c : Str)
+    {
+        if (c == '"' || c == '\\')
+            Stream << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            Stream << ' ';
+        else
+            Stream << c;
+    }
+    Stream << '"';
+}
+
+std::string GPUProfiler::ExportChromeTrace() const
+{
+    constexpr int CPUThreadId = 0;
+    constexpr int GPUThreadId = 1;
+
+    std::stringstream Stream;
+    Stream.precision(3);
+    Stream << std::fixed;
+
+    Stream << "{\"traceEvents\":[\n"
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << CPUThreadId << ",\"args\":{\"name\":\"CPU\"}},\n"
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << GPUThreadId << ",\"args\":{\"name\":\"GPU\"}}";
+
+    const auto WriteEvent = [&Stream](const std::string& Name, int ThreadId, double Start, double Duration) {
+        Stream << ",\n{\"name\":";
+        WriteJSONString(Stream, Name);
+        // Timestamps and durations are in microseconds
+        Stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << ThreadId
+               << ",\"ts\":" << Start * 1e+6
+               << ",\"dur\":" << Duration * 1e+6 << '}';
+    };
+
+    for (const auto& Frame : m_TraceHistory)
+    {
+        const auto FrameName = std::string{"Frame "} + std::to_string(Frame.FrameIndex);
+        WriteEvent(FrameName, CPUThreadId, Frame.CPUStartTime, Frame.CPUDuration);
+        WriteEvent(FrameName, GPUThreadId, Frame.GPUStartTime, Frame.Duration);
+        for (const auto& Scope : Frame.Scopes)
+        {
+            WriteEvent(Scope.Name, CPUThreadId, Frame.CPUStartTime + Scope.CPUStartTime, Scope.CPUDuration);
+            WriteEvent(Scope.Name, GPUThreadId, Frame.GPUStartTime + Scope.StartTime, Scope.Duration);
+        }
+    }
+
+    Stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return Stream.str();
+}
+
+void GPUProfiler::BeginFrame(IDeviceContext* pCtx)
+{
+    if (m_Frames.empty())
+        return;
+
+    DEV_CHECK_ERR(m_pCurrFrame == nullptr, "BeginFrame() is called twice without matching EndFrame()");
+
+    // Read the results of all frames that are complete, starting with the oldest one
+    const auto NumFrames = static_cast<Uint64>(m_Frames.size());
+    for (Uint64 i = m_FrameIndex >= NumFrames ? m_FrameIndex - NumFrames : 0; i < m_FrameIndex; ++i)
+    {
+        auto& Frame = m_Frames[i % NumFrames];
+        if (!Frame.IsPending)
+            continue;
+        if (!ReadFrameResults(pCtx, Frame))
+            break;
+    }
+
+    auto& Frame = m_Frames[m_FrameIndex % NumFrames];
+    if (Frame.IsPending)
+    {
+        // The GPU is more than FrameLatency frames behind. Do not wait and drop the results.
+        Frame.IsPending = false;
+        ++m_NumDroppedFrames;
+    }
+
+    Frame.FrameIndex   = m_FrameIndex++;
+    Frame.NumScopes    = 0;
+    Frame.CPUStartTime = GetCPUTime();
+    Frame.CPUDuration  = 0;
+    Frame.IsCalibrated = m_CalibrateTimestamps && pCtx->GetTimestampCalibration(Frame.Calibration);
+    m_pCurrFrame       = &Frame;
+    m_ScopeStack.clear();
+
+    pCtx->EndQuery(Frame.QueryPtrs[0]);
+}
+
+void GPUProfiler::EndFrame(IDeviceContext* pCtx)
+{
+    if (m_Frames.empty())
+        return;
+
+    DEV_CHECK_ERR(m_pCurrFrame != nullptr, "EndFrame() is called without matching BeginFrame()");
+    if (m_pCurrFrame == nullptr)
+        return;
+
+    if (!m_ScopeStack.empty())
+    {
+        LOG_ERROR_MESSAGE(m_ScopeStack.size(), " GPU profiler scope(s) have not been ended before the end of the frame");
+        while (!m_ScopeStack.empty())
+            EndScope(pCtx);
+    }
+
+    pCtx->EndQuery(m_pCurrFrame->QueryPtrs[1]);
+    m_pCurrFrame->CPUDuration = GetCPUTime() - m_pCurrFrame->CPUStartTime;
+    m_pCurrFrame->IsPending   = true;
+    m_pCurrFrame            = nullptr;
+}
+
+void GPUProfiler::BeginScope(IDeviceContext* pCtx, const char* Name)
+{
+    if (m_EmitDebugGroups)
+        pCtx->BeginDebugGroup(Name != nullptr ? Name : "");
+
+    if (m_Frames.empty())
+        return;
+
+    DEV_CHECK_ERR(m_pCurrFrame != nullptr, "Profiling scopes must be recorded between BeginFrame() and EndFrame()");
+    if (m_pCurrFrame == nullptr)
+        return;
+
+    auto& Frame = *m_pCurrFrame;
+    if (Frame.NumScopes >= m_MaxScopesPerFrame)
+    {
+        // The scope is not measured, but still must be matched by EndScope()
+        m_ScopeStack.push_back(InvalidIndex);
+        return;
+    }
+
+    const auto ScopeIdx = Frame.NumScopes++;
+    auto&      Scope    = Frame.Scopes[ScopeIdx];
+
+    Scope.Name        = Name != nullptr ? Name : "";
+    Scope.Depth       = static_cast<Uint32>(m_ScopeStack.size());
+    Scope.ParentIndex = InvalidIndex;
+    for (auto it = m_ScopeStack.rbegin(); it != m_ScopeStack.rend() && Scope.ParentIndex == InvalidIndex; ++it)
+        Scope.ParentIndex = *it;
+    m_ScopeStack.push_back(ScopeIdx);
+
+    pCtx->EndQuery(Frame.QueryPtrs[2 + 2 * ScopeIdx]);
+    Scope.CPUStartTime = GetCPUTime() - Frame.CPUStartTime;
+    Scope.CPUDuration  = 0;
+}
+
+void GPUProfiler::EndScope(IDeviceContext* pCtx)
+{
+    if (m_EmitDebugGroups)
+        pCtx->EndDebugGroup();
+
+    if (m_Frames.empty())
+        return;
+
+    if (m_pCurrFrame == nullptr || m_ScopeStack.empty())
+    {
+        DEV_ERROR("EndScope() is called without matching BeginScope()");
+        return;
+    }
+
+    const auto ScopeIdx = m_ScopeStack.back();
+    m_ScopeStack.pop_back();
+    if (ScopeIdx != InvalidIndex)
+    {
+        auto& Scope       = m_pCurrFrame->Scopes[ScopeIdx];
+        Scope.CPUDuration = GetCPUTime() - m_pCurrFrame->CPUStartTime - Scope.CPUStartTime;
+        pCtx->EndQuery(m_pCurrFrame->QueryPtrs[3 + 2 * ScopeIdx]);
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,367 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUReadbackQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+GPUReadbackQueue::GPUReadbackQueue(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pThreadPool{CI.pThreadPool},
+    m_MaxRecycledResources{CI.MaxRecycledResources},
+    // Mapped OpenGL buffers can't be accessed by other threads while the context keeps
+    // working, so the data is copied out and the buffer is unmapped right away.
+    m_ZeroCopy{!CI.pDevice->GetDeviceInfo().IsGLDevice()}
+{
+    DEV_CHECK_ERR(m_pDevice, "Device must not be null");
+
+    FenceDesc Desc;
+    Desc.Name = "GPU readback queue fence";
+    Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    m_pDevice->CreateFence(Desc, &m_pFence);
+    DEV_CHECK_ERR(m_pFence, "Failed to create fence");
+}
+
+GPUReadbackQueue::~GPUReadbackQueue()
+{
+    // Callbacks reference the readbacks, so they must finish before the readbacks are destroyed.
+    for (auto& pReadback : m_MappedReadbacks)
+    {
+        WaitForCallback(*pReadback);
+        DEV_CHECK_ERR(!pReadback->pStagingBuffer && !pReadback->pStagingTexture,
+                      "The readback queue is destroyed while staging resources are mapped. Call Flush() before destroying the queue.");
+    }
+}
+
+std::unique_ptr<GPUReadbackQueue::Readback> GPUReadbackQueue::CreateReadback(CallbackType&& Callback)
+{
+    DEV_CHECK_ERR(Callback, "Callback must not be null");
+
+    std::unique_ptr<Readback> pReadback{new Readback{}};
+    pReadback->Callback = std::move(Callback);
+    return pReadback;
+}
+
+RefCntAutoPtr<IBuffer> GPUReadbackQueue::GetStagingBuffer(Uint64 Size)
+{
+    // Round the size up to the power of two so that staging buffers can be reused
+    // by requests of similar sizes.
+    constexpr Uint64 MinStagingBufferSize = 256;
+
+    Uint64 StagingSize = MinStagingBufferSize;
+    while (StagingSize < Size)
+        StagingSize *= 2;
+
+    for (auto it = m_RecycledBuffers.begin(); it != m_RecycledBuffers.end(); ++it)
+    {
+        if ((*it)->GetDesc().Size == StagingSize)
+        {
+            auto pBuffer = std::move(*it);
+            m_RecycledBuffers.erase(it);
+            return pBuffer;
+        }
+    }
+
+    BufferDesc Desc;
+    Desc.Name           = "GPU readback queue staging buffer";
+    Desc.Size           = StagingSize;
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    DEV_CHECK_ERR(pBuffer, "Failed to create staging buffer");
+    return pBuffer;
+}
+
+RefCntAutoPtr<ITexture> GPUReadbackQueue::GetStagingTexture(const TextureDesc& SrcDesc, Uint32 Width, Uint32 Height, Uint32 Depth)
+{
+    TextureDesc Desc;
+    Desc.Name           = "GPU readback queue staging texture";
+    Desc.Type           = SrcDesc.Is1D() ? RESOURCE_DIM_TEX_1D : (SrcDesc.Is3D() ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D);
+    Desc.Width          = Width;
+    Desc.Height         = Height;
+    Desc.Depth          = Depth;
+    Desc.Format         = SrcDesc.Format;
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    for (auto it = m_RecycledTextures.begin(); it != m_RecycledTextures.end(); ++it)
+    {
+        const auto& TexDesc = (*it)->GetDesc();
+        if (TexDesc.Type == Desc.Type &&
+            TexDesc.Width == Desc.Width &&
+            TexDesc.Height == Desc.Height &&
+            TexDesc.GetDepth() == Desc.GetDepth() &&
+            TexDesc.Format == Desc.Format)
+        {
+            auto pTexture = std::move(*it);
+            m_RecycledTextures.erase(it);
+            return pTexture;
+        }
+    }
+
+    RefCntAutoPtr<ITexture> pTexture;
+    m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+    DEV_CHECK_ERR(pTexture, "Failed to create staging texture");
+    return pTexture;
+}
+
+void GPUReadbackQueue::ReadBuffer(IDeviceContext* pContext,
+                                  IBuffer*        pBuffer,
+                                  Uint64          Offset,
+                                  Uint64          Size,
+                                  CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr && pBuffer != nullptr, "Context and buffer must not be null");
+    DEV_CHECK_ERR(Size != 0, "Readback size must not be zero");
+    DEV_CHECK_ERR(Offset + Size <= pBuffer->GetDesc().Size, "Readback region [", Offset, ", ", Offset + Size,
+                  ") is out of the buffer bounds");
+
+    auto pReadback            = CreateReadback(std::move(Callback));
+    pReadback->pStagingBuffer = GetStagingBuffer(Size);
+    pReadback->DataSize       = Size;
+    if (!pReadback->pStagingBuffer)
+        return;
+
+    pContext->CopyBuffer(pBuffer, Offset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pReadback->pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    Enqueue(pContext, std::move(pReadback));
+}
+
+void GPUReadbackQueue::ReadTexture(IDeviceContext* pContext,
+                                   ITexture*       pTexture,
+                                   Uint32          MipLevel,
+                                   Uint32          ArraySlice,
+                                   const Box*      pRegion,
+                                   CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr && pTexture != nullptr, "Context and texture must not be null");
+
+    const auto& TexDesc = pTexture->GetDesc();
+    DEV_CHECK_ERR(MipLevel < TexDesc.MipLevels, "Mip level ", MipLevel, " is out of range");
+    DEV_CHECK_ERR(ArraySlice < TexDesc.GetArraySize(), "Array slice ", ArraySlice, " is out of range");
+
+    Box Region;
+    if (pRegion != nullptr)
+    {
+        Region = *pRegion;
+    }
+    else
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, MipLevel);
+
+        Region.MaxX = MipProps.LogicalWidth;
+        Region.MaxY = MipProps.LogicalHeight;
+        Region.MaxZ = MipProps.Depth;
+    }
+    DEV_CHECK_ERR(Region.IsValid(), "Readback region must not be empty");
+
+    auto pReadback             = CreateReadback(std::move(Callback));
+    pReadback->pStagingTexture = GetStagingTexture(TexDesc, Region.Width(), Region.Height(), Region.Depth());
+    if (!pReadback->pStagingTexture)
+        return;
+
+    CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pReadback->pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    CopyAttribs.SrcMipLevel = MipLevel;
+    CopyAttribs.SrcSlice    = ArraySlice;
+    CopyAttribs.pSrcBox     = &Region;
+    pContext->CopyTexture(CopyAttribs);
+
+    Enqueue(pContext, std::move(pReadback));
+}
+
+void GPUReadbackQueue::Enqueue(IDeviceContext* pContext, std::unique_ptr<Readback>&& pReadback)
+{
+    pReadback->FenceValue = m_NextFenceValue++;
+    pContext->EnqueueSignal(m_pFence, pReadback->FenceValue);
+    m_PendingReadbacks.emplace_back(std::move(pReadback));
+}
+
+void GPUReadbackQueue::Unmap(IDeviceContext* pContext, Readback& RB)
+{
+    if (RB.MappedData.pData == nullptr)
+        return;
+
+    if (RB.pStagingBuffer)
+        pContext->UnmapBuffer(RB.pStagingBuffer, MAP_READ);
+    else if (RB.pStagingTexture)
+        pContext->UnmapTextureSubresource(RB.pStagingTexture, 0, 0);
+    RB.MappedData.pData = nullptr;
+}
+
+void GPUReadbackQueue::Recycle(Readback& RB)
+{
+    if (RB.pStagingBuffer)
+    {
+        if (m_RecycledBuffers.size() >= m_MaxRecycledResources && !m_RecycledBuffers.empty())
+            m_RecycledBuffers.erase(m_RecycledBuffers.begin());
+        m_RecycledBuffers.emplace_back(std::move(RB.pStagingBuffer));
+    }
+    else if (RB.pStagingTexture)
+    {
+        if (m_RecycledTextures.size() >= m_MaxRecycledResources && !m_RecycledTextures.empty())
+            m_RecycledTextures.erase(m_RecycledTextures.begin());
+        m_RecycledTextures.emplace_back(std::move(RB.pStagingTexture));
+    }
+}
+
+void GPUReadbackQueue::Dispatch(IDeviceContext* pContext, std::unique_ptr<Readback>&& pReadback)
+{
+    auto& RB = *pReadback;
+
+    ReadbackData Data;
+    if (RB.pStagingBuffer)
+    {
+        PVoid pData = nullptr;
+        pContext->MapBuffer(RB.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        RB.MappedData.pData = pData;
+        Data.DataSize       = RB.DataSize;
+    }
+    else
+    {
+        pContext->MapTextureSubresource(RB.pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, RB.MappedData);
+
+        const auto& TexDesc    = RB.pStagingTexture->GetDesc();
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        const auto  NumRows    = AlignUp(TexDesc.Height, Uint32{FmtAttribs.BlockHeight}) / FmtAttribs.BlockHeight;
+
+        Data.Stride      = RB.MappedData.Stride;
+        Data.DepthStride = RB.MappedData.DepthStride;
+        Data.DataSize    = Data.DepthStride * (TexDesc.GetDepth() - 1) + Data.Stride * NumRows;
+    }
+
+    if (RB.MappedData.pData == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to map the readback staging resource");
+        Data.DataSize = 0;
+    }
+    else if (!m_ZeroCopy)
+    {
+        RB.CopiedData.resize(static_cast<size_t>(Data.DataSize));
+        memcpy(RB.CopiedData.data(), RB.MappedData.pData, RB.CopiedData.size());
+        Unmap(pContext, RB);
+        Data.pData = RB.CopiedData.data();
+    }
+    else
+    {
+        Data.pData = RB.MappedData.pData;
+    }
+
+    if (!m_pThreadPool || Data.pData == nullptr)
+    {
+        RB.Callback(Data);
+        Unmap(pContext, RB);
+        Recycle(RB);
+        return;
+    }
+
+    if (!m_ZeroCopy)
+    {
+        // The data has been copied out, so the staging resource can be reused right away.
+        Recycle(RB);
+    }
+
+    RB.pTask = EnqueueAsyncWork(m_pThreadPool,
+                                [&RB, Data](Uint32 /*ThreadId*/) {
+                                    RB.Callback(Data);
+                                });
+    m_MappedReadbacks.emplace_back(std::move(pReadback));
+}
+
+void GPUReadbackQueue::WaitForCallback(Readback& RB)
+{
+    // If the task has not started yet, run the callback on this thread
+    // rather than wait for a worker to pick it up.
+    if (m_pThreadPool->RemoveTask(RB.pTask, /*CancelIfRunning = */ false))
+    {
+        if (!RB.pTask->IsFinished())
+        {
+            RB.pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+            RB.pTask->Run(0);
+        }
+    }
+    else
+    {
+        RB.pTask->WaitForCompletion();
+    }
+}
+
+void GPUReadbackQueue::Process(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+    for (size_t i = 0; i < m_MappedReadbacks.size();)
+    {
+        auto& RB = *m_MappedReadbacks[i];
+        if (RB.pTask->IsFinished())
+        {
+            Unmap(pContext, RB);
+            Recycle(RB);
+            std::swap(m_MappedReadbacks[i], m_MappedReadbacks.back());
+            m_MappedReadbacks.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+    while (!m_PendingReadbacks.empty() && m_PendingReadbacks.front()->FenceValue <= CompletedFenceValue)
+    {
+        auto pReadback = std::move(m_PendingReadbacks.front());
+        m_PendingReadbacks.pop_front();
+        Dispatch(pContext, std::move(pReadback));
+    }
+}
+
+void GPUReadbackQueue::Flush(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+    if (!m_PendingReadbacks.empty())
+    {
+        pContext->Flush();
+        m_pFence->Wait(m_PendingReadbacks.back()->FenceValue);
+    }
+    Process(pContext);
+
+    for (auto& pReadback : m_MappedReadbacks)
+        WaitForCallback(*pReadback);
+    Process(pContext);
+    VERIFY_EXPR(m_PendingReadbacks.empty() && m_MappedReadbacks.empty());
+}
+
+} // namespace Diligent
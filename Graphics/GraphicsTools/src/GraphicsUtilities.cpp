@@ -26,13 +26,18 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
+#include "ThreadPool.hpp"
+#include "Intrinsics.hpp"
 
 #define PI_F 3.1415926f
 
@@ -156,6 +161,34 @@ ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelT
     return static_cast<ChannelType>(fSRGBAverage);
 }
 
+// Converting every channel with FastSRGBToLinear is the most expensive part of sRGB filtering,
+// so 8-bit values are converted with a table that produces the exact same results.
+const std::array<float, 256>& GetFastSRGBToLinearTable()
+{
+    static const auto FastSRGBToLinearTable = []() {
+        std::array<float, 256> Table{};
+        for (Uint32 i = 0; i < Table.size(); ++i)
+            Table[i] = FastSRGBToLinear(static_cast<float>(i) * (1.f / 255.f));
+        return Table;
+    }();
+    return FastSRGBToLinearTable;
+}
+
+template <>
+Uint8 SRGBAverage<Uint8>(Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3, Uint32 /*col*/, Uint32 /*row*/)
+{
+    const auto& ToLinear = GetFastSRGBToLinearTable();
+
+    float fLinearAverage = (ToLinear[c0] + ToLinear[c1] + ToLinear[c2] + ToLinear[c3]) * 0.25f;
+    float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * 255.f;
+
+    // Clamping on both ends is essential because fast SRGB math is imprecise
+    fSRGBAverage = std::max(fSRGBAverage, 0.f);
+    fSRGBAverage = std::min(fSRGBAverage, 255.f);
+
+    return static_cast<Uint8>(fSRGBAverage);
+}
+
 template <typename ChannelType>
 ChannelType LinearAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3, Uint32 /*col*/, Uint32 /*row*/);
 
@@ -282,11 +315,210 @@ ChannelType MostFrequentSelector(ChannelType c0, ChannelType c1, ChannelType c2,
     }
 }
 
+// Row kernels filter the first coarse texels of the row that they can process with SIMD instructions
+// and return the number of filtered texels. The remaining texels are filtered by FilterMipLevel.
+// Row kernels are only used when the fine mip level width is at least 2, so that fine texel columns
+// 2 * col and 2 * col + 1 are always within the row.
+using MipRowKernelType = Uint32 (*)(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 NumChannels, Uint32 CoarseMipWidth);
+
+Uint32 BoxAverageRowUint8(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 NumChannels, Uint32 CoarseMipWidth)
+{
+    const auto* pSrc0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pSrc1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    Uint32 col = 0;
+    if (NumChannels == 1)
+    {
+#if DILIGENT_SSE2_ENABLED
+        const __m128i Zero = _mm_setzero_si128();
+        const __m128i One  = _mm_set1_epi16(1);
+        for (; col + 8 <= CoarseMipWidth; col += 8)
+        {
+            const __m128i Row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 2));
+            const __m128i Row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 2));
+
+            // Widen to 16 bits and add the rows
+            const __m128i Sum0 = _mm_add_epi16(_mm_unpacklo_epi8(Row0, Zero), _mm_unpacklo_epi8(Row1, Zero));
+            const __m128i Sum1 = _mm_add_epi16(_mm_unpackhi_epi8(Row0, Zero), _mm_unpackhi_epi8(Row1, Zero));
+
+            // Add adjacent columns
+            const __m128i Sum = _mm_packs_epi32(_mm_madd_epi16(Sum0, One), _mm_madd_epi16(Sum1, One));
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + col), _mm_packus_epi16(_mm_srli_epi16(Sum, 2), Zero));
+        }
+#elif DILIGENT_NEON_ENABLED
+        for (; col + 8 <= CoarseMipWidth; col += 8)
+        {
+            // Add adjacent columns and then the rows
+            const uint16x8_t Sum = vaddq_u16(vpaddlq_u8(vld1q_u8(pSrc0 + col * 2)), vpaddlq_u8(vld1q_u8(pSrc1 + col * 2)));
+            vst1_u8(pDst + col, vshrn_n_u16(Sum, 2));
+        }
+#endif
+    }
+    else if (NumChannels == 4)
+    {
+#if DILIGENT_SSE2_ENABLED
+        const __m128i Zero = _mm_setzero_si128();
+        for (; col + 4 <= CoarseMipWidth; col += 4)
+        {
+            const __m128i Row0_0123 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8));
+            const __m128i Row0_4567 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8 + 16));
+            const __m128i Row1_0123 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8));
+            const __m128i Row1_4567 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8 + 16));
+
+            // Widen to 16 bits and add the rows
+            const __m128i Sum01 = _mm_add_epi16(_mm_unpacklo_epi8(Row0_0123, Zero), _mm_unpacklo_epi8(Row1_0123, Zero));
+            const __m128i Sum23 = _mm_add_epi16(_mm_unpackhi_epi8(Row0_0123, Zero), _mm_unpackhi_epi8(Row1_0123, Zero));
+            const __m128i Sum45 = _mm_add_epi16(_mm_unpacklo_epi8(Row0_4567, Zero), _mm_unpacklo_epi8(Row1_4567, Zero));
+            const __m128i Sum67 = _mm_add_epi16(_mm_unpackhi_epi8(Row0_4567, Zero), _mm_unpackhi_epi8(Row1_4567, Zero));
+
+            // Add adjacent texels
+            const __m128i Sum0 = _mm_add_epi16(_mm_unpacklo_epi64(Sum01, Sum23), _mm_unpackhi_epi64(Sum01, Sum23));
+            const __m128i Sum1 = _mm_add_epi16(_mm_unpacklo_epi64(Sum45, Sum67), _mm_unpackhi_epi64(Sum45, Sum67));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), _mm_packus_epi16(_mm_srli_epi16(Sum0, 2), _mm_srli_epi16(Sum1, 2)));
+        }
+#elif DILIGENT_NEON_ENABLED
+        for (; col + 4 <= CoarseMipWidth; col += 4)
+        {
+            const uint8x16_t Row0_0123 = vld1q_u8(pSrc0 + col * 8);
+            const uint8x16_t Row0_4567 = vld1q_u8(pSrc0 + col * 8 + 16);
+            const uint8x16_t Row1_0123 = vld1q_u8(pSrc1 + col * 8);
+            const uint8x16_t Row1_4567 = vld1q_u8(pSrc1 + col * 8 + 16);
+
+            // Widen to 16 bits and add the rows
+            const uint16x8_t Sum01 = vaddl_u8(vget_low_u8(Row0_0123), vget_low_u8(Row1_0123));
+            const uint16x8_t Sum23 = vaddl_u8(vget_high_u8(Row0_0123), vget_high_u8(Row1_0123));
+            const uint16x8_t Sum45 = vaddl_u8(vget_low_u8(Row0_4567), vget_low_u8(Row1_4567));
+            const uint16x8_t Sum67 = vaddl_u8(vget_high_u8(Row0_4567), vget_high_u8(Row1_4567));
+
+            // Add adjacent texels
+            const uint16x8_t Sum0 = vcombine_u16(vadd_u16(vget_low_u16(Sum01), vget_high_u16(Sum01)), vadd_u16(vget_low_u16(Sum23), vget_high_u16(Sum23)));
+            const uint16x8_t Sum1 = vcombine_u16(vadd_u16(vget_low_u16(Sum45), vget_high_u16(Sum45)), vadd_u16(vget_low_u16(Sum67), vget_high_u16(Sum67)));
+
+            vst1q_u8(pDst + col * 4, vcombine_u8(vshrn_n_u16(Sum0, 2), vshrn_n_u16(Sum1, 2)));
+        }
+#endif
+    }
+
+    return col;
+}
+
+Uint32 BoxAverageRowFloat(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 NumChannels, Uint32 CoarseMipWidth)
+{
+    const auto* pSrc0 = static_cast<const float*>(pSrcRow0);
+    const auto* pSrc1 = static_cast<const float*>(pSrcRow1);
+    auto*       pDst  = static_cast<float*>(pDstRow);
+
+    // Note that the channels are added in the same order as in LinearAverage<float>,
+    // so that the results are identical.
+    Uint32 col = 0;
+    if (NumChannels == 1)
+    {
+#if DILIGENT_SSE2_ENABLED
+        const __m128 Quarter = _mm_set1_ps(0.25f);
+        for (; col + 4 <= CoarseMipWidth; col += 4)
+        {
+            const __m128 Row0_0123 = _mm_loadu_ps(pSrc0 + col * 2);
+            const __m128 Row0_4567 = _mm_loadu_ps(pSrc0 + col * 2 + 4);
+            const __m128 Row1_0123 = _mm_loadu_ps(pSrc1 + col * 2);
+            const __m128 Row1_4567 = _mm_loadu_ps(pSrc1 + col * 2 + 4);
+
+            const __m128 Row0Even = _mm_shuffle_ps(Row0_0123, Row0_4567, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 Row0Odd  = _mm_shuffle_ps(Row0_0123, Row0_4567, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 Row1Even = _mm_shuffle_ps(Row1_0123, Row1_4567, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 Row1Odd  = _mm_shuffle_ps(Row1_0123, Row1_4567, _MM_SHUFFLE(3, 1, 3, 1));
+
+            const __m128 Sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(Row0Even, Row0Odd), Row1Even), Row1Odd);
+            _mm_storeu_ps(pDst + col, _mm_mul_ps(Sum, Quarter));
+        }
+#elif DILIGENT_NEON_ENABLED
+        for (; col + 4 <= CoarseMipWidth; col += 4)
+        {
+            // Even columns go to val[0], odd columns to val[1]
+            const float32x4x2_t Row0 = vld2q_f32(pSrc0 + col * 2);
+            const float32x4x2_t Row1 = vld2q_f32(pSrc1 + col * 2);
+
+            const float32x4_t Sum = vaddq_f32(vaddq_f32(vaddq_f32(Row0.val[0], Row0.val[1]), Row1.val[0]), Row1.val[1]);
+            vst1q_f32(pDst + col, vmulq_n_f32(Sum, 0.25f));
+        }
+#endif
+    }
+    else if (NumChannels == 4)
+    {
+#if DILIGENT_SSE2_ENABLED
+        const __m128 Quarter = _mm_set1_ps(0.25f);
+        for (; col < CoarseMipWidth; ++col)
+        {
+            const __m128 Sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_loadu_ps(pSrc0 + col * 8), _mm_loadu_ps(pSrc0 + col * 8 + 4)),
+                                                     _mm_loadu_ps(pSrc1 + col * 8)),
+                                          _mm_loadu_ps(pSrc1 + col * 8 + 4));
+            _mm_storeu_ps(pDst + col * 4, _mm_mul_ps(Sum, Quarter));
+        }
+#elif DILIGENT_NEON_ENABLED
+        for (; col < CoarseMipWidth; ++col)
+        {
+            const float32x4_t Sum = vaddq_f32(vaddq_f32(vaddq_f32(vld1q_f32(pSrc0 + col * 8), vld1q_f32(pSrc0 + col * 8 + 4)),
+                                                        vld1q_f32(pSrc1 + col * 8)),
+                                              vld1q_f32(pSrc1 + col * 8 + 4));
+            vst1q_f32(pDst + col * 4, vmulq_n_f32(Sum, 0.25f));
+        }
+#endif
+    }
+
+    return col;
+}
+
+// Filters the row the same way as SRGBAverage<Uint8>, but converts the linear averages of a batch
+// of texels back to sRGB with one call to the batch version of FastLinearToSRGB.
+Uint32 SRGBAverageRowUint8(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 NumChannels, Uint32 CoarseMipWidth)
+{
+    const auto* pSrc0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pSrc1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const auto& ToLinear = GetFastSRGBToLinearTable();
+
+    constexpr Uint32 BatchSize = 256;
+    float            Batch[BatchSize];
+
+    const Uint32 TexelsInBatch = BatchSize / NumChannels;
+    for (Uint32 col = 0; col < CoarseMipWidth; col += TexelsInBatch)
+    {
+        const Uint32 NumTexels = std::min(TexelsInBatch, CoarseMipWidth - col);
+        for (Uint32 t = 0; t < NumTexels; ++t)
+        {
+            const Uint32 Offset0 = (col + t) * 2 * NumChannels;
+            const Uint32 Offset1 = Offset0 + NumChannels;
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                // Same order as in SRGBAverage<Uint8>
+                Batch[t * NumChannels + c] = (ToLinear[pSrc0[Offset0 + c]] + ToLinear[pSrc0[Offset1 + c]] +
+                                              ToLinear[pSrc1[Offset0 + c]] + ToLinear[pSrc1[Offset1 + c]]) *
+                    0.25f;
+            }
+        }
+
+        const Uint32 NumValues = NumTexels * NumChannels;
+        FastLinearToSRGB(Batch, Batch, NumValues);
+        for (Uint32 i = 0; i < NumValues; ++i)
+        {
+            const float fSRGB           = std::min(std::max(Batch[i] * 255.f, 0.f), 255.f);
+            pDst[col * NumChannels + i] = static_cast<Uint8>(fSRGB);
+        }
+    }
+
+    return CoarseMipWidth;
+}
+
 template <typename ChannelType,
-          typename FilterType>
+          ChannelType (*Filter)(ChannelType, ChannelType, ChannelType, ChannelType, Uint32, Uint32),
+          MipRowKernelType RowKernel = nullptr>
 void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                     Uint32                        NumChannels,
-                    FilterType                    Filter)
+                    Uint32                        StartRow,
+                    Uint32                        EndRow)
 {
     VERIFY_EXPR(Attribs.FineMipWidth > 0 && Attribs.FineMipHeight > 0);
     DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
@@ -295,16 +527,22 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
     const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
 
     VERIFY(CoarseMipHeight == 1 || Attribs.CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * NumChannels, "Coarse mip level stride is too small");
+    VERIFY_EXPR(StartRow <= EndRow && EndRow <= CoarseMipHeight);
 
-    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    for (Uint32 row = StartRow; row < EndRow; ++row)
     {
         auto src_row0 = row * 2;
         auto src_row1 = std::min(row * 2 + 1, Attribs.FineMipHeight - 1);
 
         auto pSrcRow0 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row0 * Attribs.FineMipStride);
         auto pSrcRow1 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row1 * Attribs.FineMipStride);
+        auto pDstRow  = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride);
 
-        for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+        Uint32 col = 0;
+        if (RowKernel != nullptr && Attribs.FineMipWidth > 1)
+            col = RowKernel(pSrcRow0, pSrcRow1, pDstRow, NumChannels, CoarseMipWidth);
+
+        for (; col < CoarseMipWidth; ++col)
         {
             auto src_col0 = col * 2;
             auto src_col1 = std::min(col * 2 + 1, Attribs.FineMipWidth - 1);
@@ -316,9 +554,7 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                 const auto Chnl01 = pSrcRow1[src_col0 * NumChannels + c];
                 const auto Chnl11 = pSrcRow1[src_col1 * NumChannels + c];
 
-                auto& DstCol = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride)[col * NumChannels + c];
-
-                DstCol = Filter(Chnl00, Chnl10, Chnl01, Chnl11, col, row);
+                pDstRow[col * NumChannels + c] = Filter(Chnl00, Chnl10, Chnl01, Chnl11, col, row);
             }
         }
     }
@@ -326,32 +562,39 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
 
 void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
                 Uint32                        NumChannels,
-                Uint32                        AlphaChannelInd)
+                Uint32                        AlphaChannelInd,
+                Uint32                        StartRow,
+                Uint32                        EndRow)
 {
-    const auto CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
-    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
-    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    // Remap alpha channel using the following formula to improve mip maps:
+    //
+    //      A_new = max(A_old; 1/3 * A_old + 2/3 * CutoffThreshold)
+    //
+    // https://asawicki.info/articles/alpha_test.php5
+    std::array<Uint8, 256> RemappedAlpha;
+    for (Uint32 Alpha = 0; Alpha < RemappedAlpha.size(); ++Alpha)
     {
+        auto AlphaNew        = std::min((static_cast<float>(Alpha) + 2.f * (Attribs.AlphaCutoff * 255.f)) / 3.f, 255.f);
+        RemappedAlpha[Alpha] = std::max(static_cast<Uint8>(Alpha), static_cast<Uint8>(AlphaNew));
+    }
+
+    const auto CoarseMipWidth = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
+    for (Uint32 row = StartRow; row < EndRow; ++row)
+    {
+        auto* pDstRow = reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride;
         for (Uint32 col = 0; col < CoarseMipWidth; ++col)
         {
-            auto& Alpha = (reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride)[col * NumChannels + AlphaChannelInd];
-
-            // Remap alpha channel using the following formula to improve mip maps:
-            //
-            //      A_new = max(A_old; 1/3 * A_old + 2/3 * CutoffThreshold)
-            //
-            // https://asawicki.info/articles/alpha_test.php5
-
-            auto AlphaNew = std::min((static_cast<float>(Alpha) + 2.f * (Attribs.AlphaCutoff * 255.f)) / 3.f, 255.f);
-
-            Alpha = std::max(Alpha, static_cast<Uint8>(AlphaNew));
+            auto& Alpha = pDstRow[col * NumChannels + AlphaChannelInd];
+            Alpha       = RemappedAlpha[Alpha];
         }
     }
 }
 
-template <typename ChannelType>
+template <typename ChannelType, MipRowKernelType BoxAverageRowKernel = nullptr>
 void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
-                             const TextureFormatAttribs&   FmtAttribs)
+                             const TextureFormatAttribs&   FmtAttribs,
+                             Uint32                        StartRow,
+                             Uint32                        EndRow)
 {
     auto FilterType = Attribs.FilterType;
     if (FilterType == MIP_FILTER_TYPE_DEFAULT)
@@ -361,37 +604,28 @@ void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
             MIP_FILTER_TYPE_BOX_AVERAGE;
     }
 
-    FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
-                                FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
-                                    LinearAverage<ChannelType> :
-                                    MostFrequentSelector<ChannelType>);
+    if (FilterType == MIP_FILTER_TYPE_BOX_AVERAGE)
+        FilterMipLevel<ChannelType, LinearAverage<ChannelType>, BoxAverageRowKernel>(Attribs, FmtAttribs.NumComponents, StartRow, EndRow);
+    else
+        FilterMipLevel<ChannelType, MostFrequentSelector<ChannelType>>(Attribs, FmtAttribs.NumComponents, StartRow, EndRow);
 }
 
-void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
+void ComputeMipLevelRows(const ComputeMipLevelAttribs& Attribs,
+                         const TextureFormatAttribs&   FmtAttribs,
+                         Uint32                        StartRow,
+                         Uint32                        EndRow)
 {
-    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
-    DEV_CHECK_ERR(Attribs.FineMipWidth != 0, "Fine mip width must not be zero");
-    DEV_CHECK_ERR(Attribs.FineMipHeight != 0, "Fine mip height must not be zero");
-    DEV_CHECK_ERR(Attribs.pFineMipData != nullptr, "Fine level data must not be null");
-    DEV_CHECK_ERR(Attribs.pCoarseMipData != nullptr, "Coarse level data must not be null");
-
-    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
-
-    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
-    VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
-           "Alpha remapping is only supported for 4-channel 8-bit textures");
-
     switch (FmtAttribs.ComponentType)
     {
         case COMPONENT_TYPE_UNORM_SRGB:
             VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents,
-                                  Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
-                                      MostFrequentSelector<Uint8> :
-                                      SRGBAverage<Uint8>);
+            if (Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT)
+                FilterMipLevel<Uint8, MostFrequentSelector<Uint8>>(Attribs, FmtAttribs.NumComponents, StartRow, EndRow);
+            else
+                FilterMipLevel<Uint8, SRGBAverage<Uint8>, SRGBAverageRowUint8>(Attribs, FmtAttribs.NumComponents, StartRow, EndRow);
             if (Attribs.AlphaCutoff > 0)
             {
-                RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
+                RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1, StartRow, EndRow);
             }
             break;
 
@@ -400,19 +634,19 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
             switch (FmtAttribs.ComponentSize)
             {
                 case 1:
-                    ComputeMipLevelInternal<Uint8>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Uint8, BoxAverageRowUint8>(Attribs, FmtAttribs, StartRow, EndRow);
                     if (Attribs.AlphaCutoff > 0)
                     {
-                        RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
+                        RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1, StartRow, EndRow);
                     }
                     break;
 
                 case 2:
-                    ComputeMipLevelInternal<Uint16>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Uint16>(Attribs, FmtAttribs, StartRow, EndRow);
                     break;
 
                 case 4:
-                    ComputeMipLevelInternal<Uint32>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Uint32>(Attribs, FmtAttribs, StartRow, EndRow);
                     break;
 
                 default:
@@ -425,15 +659,15 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
             switch (FmtAttribs.ComponentSize)
             {
                 case 1:
-                    ComputeMipLevelInternal<Int8>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Int8>(Attribs, FmtAttribs, StartRow, EndRow);
                     break;
 
                 case 2:
-                    ComputeMipLevelInternal<Int16>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Int16>(Attribs, FmtAttribs, StartRow, EndRow);
                     break;
 
                 case 4:
-                    ComputeMipLevelInternal<Int32>(Attribs, FmtAttribs);
+                    ComputeMipLevelInternal<Int32>(Attribs, FmtAttribs, StartRow, EndRow);
                     break;
 
                 default:
@@ -443,7 +677,7 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
 
         case COMPONENT_TYPE_FLOAT:
             VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
+            ComputeMipLevelInternal<Float32, BoxAverageRowFloat>(Attribs, FmtAttribs, StartRow, EndRow);
             break;
 
         default:
@@ -451,6 +685,160 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     }
 }
 
+// Calls Handler(Item) for every item in [0, NumItems). If a thread pool is given, items
+// are distributed between the calling thread and the pool's worker threads.
+template <typename HandlerType>
+void ProcessItemsInParallel(IThreadPool* pThreadPool, Uint32 NumItems, HandlerType&& Handler)
+{
+    if (pThreadPool == nullptr || NumItems < 2)
+    {
+        for (Uint32 Item = 0; Item < NumItems; ++Item)
+            Handler(Item);
+        return;
+    }
+
+    std::atomic<Uint32> NextItem{0};
+
+    const auto ProcessItems = [&]() {
+        for (Uint32 Item = NextItem.fetch_add(1); Item < NumItems; Item = NextItem.fetch_add(1))
+            Handler(Item);
+    };
+
+    // Every task processes items until none are left, so tasks beyond the number of
+    // worker threads only add the queueing overhead.
+    constexpr Uint32 MaxTasks = 32;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks(std::min(NumItems - 1, MaxTasks));
+    for (auto& pTask : Tasks)
+    {
+        pTask = EnqueueAsyncWork(pThreadPool,
+                                 [&ProcessItems](Uint32 /*ThreadId*/) {
+                                     ProcessItems();
+                                 });
+    }
+
+    // The calling thread processes items too, so that all items are handled even
+    // if no worker thread is available.
+    ProcessItems();
+
+    // The tasks reference local variables, so all of them must either be removed from the
+    // queue or be finished before returning. Tasks that have not started yet have no work left.
+    for (auto& pTask : Tasks)
+    {
+        if (!pThreadPool->RemoveTask(pTask, /*CancelIfRunning = */ false))
+            pTask->WaitForCompletion();
+    }
+}
+
+void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.FineMipWidth != 0, "Fine mip width must not be zero");
+    DEV_CHECK_ERR(Attribs.FineMipHeight != 0, "Fine mip height must not be zero");
+    DEV_CHECK_ERR(Attribs.pFineMipData != nullptr, "Fine level data must not be null");
+    DEV_CHECK_ERR(Attribs.pCoarseMipData != nullptr, "Coarse level data must not be null");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+
+    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
+    VERIFY(Attribs.AlphaCutoff == 0 || (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1),
+           "Alpha remapping is only supported for 4-channel 8-bit textures");
+
+    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+
+    // The number of coarse rows processed by one thread pool task at a time
+    constexpr Uint32 RowsPerBand = 32;
+
+    const Uint32 NumBands = (CoarseMipHeight + RowsPerBand - 1) / RowsPerBand;
+    ProcessItemsInParallel(Attribs.pThreadPool, NumBands,
+                           [&](Uint32 Band) {
+                               const Uint32 StartRow = Band * RowsPerBand;
+                               ComputeMipLevelRows(Attribs, FmtAttribs, StartRow, std::min(StartRow + RowsPerBand, CoarseMipHeight));
+                           });
+}
+
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.Width != 0, "Texture width must not be zero");
+    DEV_CHECK_ERR(Attribs.Height != 0, "Texture height must not be zero");
+    DEV_CHECK_ERR(Attribs.ArraySize != 0, "Array size must not be zero");
+    DEV_CHECK_ERR(Attribs.pSubResources != nullptr, "Subresources must not be null");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+    DEV_CHECK_ERR(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED, "Compressed formats are not supported");
+
+    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
+    VERIFY(Attribs.AlphaCutoff == 0 || (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1),
+           "Alpha remapping is only supported for 4-channel 8-bit textures");
+
+    const Uint32 MaxMipLevels = ComputeMipLevelsCount(Attribs.Width, Attribs.Height);
+    const Uint32 MipLevels    = Attribs.MipLevels != 0 ? Attribs.MipLevels : MaxMipLevels;
+    DEV_CHECK_ERR(MipLevels <= MaxMipLevels, "The number of mip levels (", MipLevels, ") exceeds the maximum number of mip levels (", MaxMipLevels,
+                  ") for a ", Attribs.Width, "x", Attribs.Height, " texture");
+    if (MipLevels < 2)
+        return;
+
+    for (Uint32 Slice = 0; Slice < Attribs.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < MipLevels; ++Mip)
+        {
+            const auto& SubRes = Attribs.pSubResources[Slice * MipLevels + Mip];
+            DEV_CHECK_ERR(SubRes.pData != nullptr, "Data of mip level ", Mip, " of slice ", Slice, " must not be null");
+            DEV_CHECK_ERR(SubRes.pSrcBuffer == nullptr, "GPU buffers are not supported as subresource data");
+        }
+    }
+
+    const auto GetMipLevelAttribs = [&](Uint32 Slice, Uint32 FineMip) {
+        const auto& FineSubRes   = Attribs.pSubResources[Slice * MipLevels + FineMip];
+        const auto& CoarseSubRes = Attribs.pSubResources[Slice * MipLevels + FineMip + 1];
+
+        ComputeMipLevelAttribs MipAttribs;
+        MipAttribs.Format          = Attribs.Format;
+        MipAttribs.FineMipWidth    = std::max(Attribs.Width >> FineMip, Uint32{1});
+        MipAttribs.FineMipHeight   = std::max(Attribs.Height >> FineMip, Uint32{1});
+        MipAttribs.pFineMipData    = FineSubRes.pData;
+        MipAttribs.FineMipStride   = StaticCast<size_t>(FineSubRes.Stride);
+        // Subresource data of the coarser levels is the output of this function
+        MipAttribs.pCoarseMipData  = const_cast<void*>(CoarseSubRes.pData);
+        MipAttribs.CoarseMipStride = StaticCast<size_t>(CoarseSubRes.Stride);
+        MipAttribs.FilterType      = Attribs.FilterType;
+        MipAttribs.AlphaCutoff     = Attribs.AlphaCutoff;
+        return MipAttribs;
+    };
+
+    // Mip levels are processed in groups of up to MipsPerGroup levels below the group's
+    // base level. Every group is split into bands of (1 << MipsPerGroup) base level rows,
+    // and a band computes all its levels before moving on, so that the rows it reads from
+    // the previous level are still in the cache. Coarse row r only depends on fine rows
+    // 2r and 2r+1, so bands are independent of each other and of the other slices.
+    constexpr Uint32 MipsPerGroup = 4;
+
+    for (Uint32 BaseMip = 0; BaseMip + 1 < MipLevels; BaseMip += MipsPerGroup)
+    {
+        const Uint32 LastMip    = std::min(BaseMip + MipsPerGroup, MipLevels - 1);
+        const Uint32 BaseHeight = std::max(Attribs.Height >> BaseMip, Uint32{1});
+        const Uint32 BandHeight = 1u << (LastMip - BaseMip);
+        const Uint32 NumBands   = (BaseHeight + BandHeight - 1) / BandHeight;
+
+        ProcessItemsInParallel(Attribs.pThreadPool, Attribs.ArraySize * NumBands,
+                               [&](Uint32 Item) {
+                                   const Uint32 Slice = Item / NumBands;
+                                   const Uint32 Band  = Item % NumBands;
+                                   for (Uint32 Mip = BaseMip + 1; Mip <= LastMip; ++Mip)
+                                   {
+                                       const Uint32 MipHeight     = std::max(Attribs.Height >> Mip, Uint32{1});
+                                       const Uint32 MipBandHeight = 1u << (LastMip - Mip);
+                                       const Uint32 StartRow      = Band * MipBandHeight;
+                                       const Uint32 EndRow        = std::min(StartRow + MipBandHeight, MipHeight);
+                                       if (StartRow >= EndRow)
+                                           break;
+                                       ComputeMipLevelRows(GetMipLevelAttribs(Slice, Mip - 1), FmtAttribs, StartRow, EndRow);
+                                   }
+                               });
+    }
+}
+
 } // namespace Diligent
 
 
@@ -483,4 +871,9 @@ extern "C"
     {
         Diligent::ComputeMipLevel(Attribs);
     }
+
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs& Attribs)
+    {
+        Diligent::ComputeMipChain(Attribs);
+    }
 }
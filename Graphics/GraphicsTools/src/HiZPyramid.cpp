@@ -0,0 +1,264 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HiZPyramid.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+const char* const HiZShaderSource = R"(
+#ifndef THREAD_GROUP_SIZE
+#   define THREAD_GROUP_SIZE 8
+#endif
+
+#if REVERSE_DEPTH
+#   define REDUCE_DEPTH min
+#else
+#   define REDUCE_DEPTH max
+#endif
+
+cbuffer cbReduceAttribs
+{
+    uint2 g_SrcSize;
+    uint2 g_DstSize;
+};
+
+Texture2D<float> g_Depth;
+
+RWTexture2D<float /*format = r32f*/> g_SrcMip;
+RWTexture2D<float /*format = r32f*/> g_DstMip;
+
+[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]
+void CopyDepthCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x < g_DstSize.x && DTid.y < g_DstSize.y)
+        g_DstMip[DTid.xy] = g_Depth.Load(int3(DTid.xy, 0));
+}
+
+[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]
+void ReduceCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x >= g_DstSize.x || DTid.y >= g_DstSize.y)
+        return;
+
+    uint2 SrcStart = DTid.xy * 2u;
+    uint2 SrcEnd   = SrcStart + uint2(2u, 2u);
+    // The last row and column also cover the extra texels of odd-sized source levels
+    if (DTid.x == g_DstSize.x - 1u)
+        SrcEnd.x = g_SrcSize.x;
+    if (DTid.y == g_DstSize.y - 1u)
+        SrcEnd.y = g_SrcSize.y;
+    SrcEnd = min(SrcEnd, g_SrcSize);
+
+    float Depth = g_SrcMip[SrcStart];
+    for (uint y = SrcStart.y; y < SrcEnd.y; ++y)
+    {
+        for (uint x = SrcStart.x; x < SrcEnd.x; ++x)
+            Depth = REDUCE_DEPTH(Depth, g_SrcMip[uint2(x, y)]);
+    }
+    g_DstMip[DTid.xy] = Depth;
+}
+)";
+// clang-format on
+
+struct ReduceAttribsCB
+{
+    Uint32 SrcWidth;
+    Uint32 SrcHeight;
+    Uint32 DstWidth;
+    Uint32 DstHeight;
+};
+
+} // namespace
+
+HiZPyramid::HiZPyramid(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_ReverseDepth{CI.ReverseDepth},
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_ThreadGroupSize == 0)
+        LOG_ERROR_AND_THROW("Thread group size must not be zero");
+    if (!m_pDevice->GetDeviceInfo().Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("Hi-Z pyramid requires compute shaders");
+
+    CreateUniformBuffer(m_pDevice, sizeof(ReduceAttribsCB), "Hi-Z pyramid reduce attribs CB", &m_pReduceAttribsCB);
+    if (!m_pReduceAttribsCB)
+        LOG_ERROR_AND_THROW("Failed to create reduce attribs buffer");
+
+    CreatePipelines();
+}
+
+HiZPyramid::~HiZPyramid()
+{
+}
+
+void HiZPyramid::CreatePipelines()
+{
+    static constexpr const char* EntryPoints[PASS_COUNT] = {
+        "CopyDepthCS",
+        "ReduceCS",
+    };
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", m_ThreadGroupSize);
+    Macros.AddShaderMacro("REVERSE_DEPTH", m_ReverseDepth);
+
+    for (Uint32 Pass = 0; Pass < PASS_COUNT; ++Pass)
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Desc           = {EntryPoints[Pass], SHADER_TYPE_COMPUTE, true};
+        ShaderCI.EntryPoint     = EntryPoints[Pass];
+        ShaderCI.Source         = HiZShaderSource;
+        ShaderCI.Macros         = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            LOG_ERROR_AND_THROW("Failed to create Hi-Z pyramid shader '", EntryPoints[Pass], "'");
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = EntryPoints[Pass];
+        PSOCreateInfo.PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        PSOCreateInfo.pCS                                        = pCS;
+
+        m_pDevice->CreateComputePipelineState(PSOCreateInfo, &m_pPSO[Pass]);
+        if (!m_pPSO[Pass])
+            LOG_ERROR_AND_THROW("Failed to create Hi-Z pyramid pipeline '", EntryPoints[Pass], "'");
+    }
+}
+
+void HiZPyramid::CreateTexture(Uint32 Width, Uint32 Height)
+{
+    m_pTexture.Release();
+    m_MipUAVs.clear();
+    m_SRBs.clear();
+    m_Width  = 0;
+    m_Height = 0;
+
+    TextureDesc Desc;
+    Desc.Name      = "Hi-Z pyramid";
+    Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Desc.Width     = Width;
+    Desc.Height    = Height;
+    Desc.Format    = TEX_FORMAT_R32_FLOAT;
+    Desc.MipLevels = 0; // Full mip chain
+    Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+
+    m_pDevice->CreateTexture(Desc, nullptr, &m_pTexture);
+    if (!m_pTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to create ", Width, "x", Height, " Hi-Z pyramid texture");
+        return;
+    }
+
+    const Uint32 NumMips = m_pTexture->GetDesc().MipLevels;
+    m_MipUAVs.resize(NumMips);
+    m_SRBs.resize(NumMips);
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+    {
+        TextureViewDesc ViewDesc;
+        ViewDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+        ViewDesc.MostDetailedMip = Mip;
+        ViewDesc.NumMipLevels    = 1;
+        m_pTexture->CreateView(ViewDesc, &m_MipUAVs[Mip]);
+        VERIFY_EXPR(m_MipUAVs[Mip]);
+    }
+
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+    {
+        auto& pSRB = m_SRBs[Mip];
+        m_pPSO[Mip == 0 ? PASS_COPY_DEPTH : PASS_REDUCE]->CreateShaderResourceBinding(&pSRB, true);
+        VERIFY_EXPR(pSRB);
+
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbReduceAttribs")->Set(m_pReduceAttribsCB);
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DstMip")->Set(m_MipUAVs[Mip]);
+        if (Mip > 0)
+            pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_SrcMip")->Set(m_MipUAVs[Mip - 1]);
+    }
+
+    m_Width  = Width;
+    m_Height = Height;
+}
+
+void HiZPyramid::Build(IDeviceContext* pContext, ITextureView* pDepthSRV)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    DEV_CHECK_ERR(pDepthSRV != nullptr, "Depth buffer view must not be null");
+    DEV_CHECK_ERR(pDepthSRV->GetDesc().ViewType == TEXTURE_VIEW_SHADER_RESOURCE, "Depth buffer view must be a shader resource view");
+
+    const auto& DepthDesc = pDepthSRV->GetTexture()->GetDesc();
+    DEV_CHECK_ERR(DepthDesc.Type == RESOURCE_DIM_TEX_2D && DepthDesc.SampleCount == 1, "Depth buffer must be a single-sampled 2D texture");
+
+    if (!m_pTexture || m_Width != DepthDesc.Width || m_Height != DepthDesc.Height)
+    {
+        CreateTexture(DepthDesc.Width, DepthDesc.Height);
+        if (!m_pTexture)
+            return;
+    }
+
+    m_SRBs[0]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Depth")->Set(pDepthSRV);
+
+    for (Uint32 Mip = 0; Mip < m_SRBs.size(); ++Mip)
+    {
+        const Uint32 DstWidth  = std::max(m_Width >> Mip, 1u);
+        const Uint32 DstHeight = std::max(m_Height >> Mip, 1u);
+        {
+            MapHelper<ReduceAttribsCB> CBData{pContext, m_pReduceAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+            CBData->SrcWidth  = Mip > 0 ? std::max(m_Width >> (Mip - 1), 1u) : m_Width;
+            CBData->SrcHeight = Mip > 0 ? std::max(m_Height >> (Mip - 1), 1u) : m_Height;
+            CBData->DstWidth  = DstWidth;
+            CBData->DstHeight = DstHeight;
+        }
+
+        pContext->SetPipelineState(m_pPSO[Mip == 0 ? PASS_COPY_DEPTH : PASS_REDUCE]);
+        // The pyramid stays in the unordered access state, so transitioning the resources
+        // inserts the UAV barrier between writing one level and reading it in the next pass.
+        pContext->CommitShaderResources(m_SRBs[Mip], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        DispatchComputeAttribs DispatchAttribs;
+        DispatchAttribs.ThreadGroupCountX = (DstWidth + m_ThreadGroupSize - 1) / m_ThreadGroupSize;
+        DispatchAttribs.ThreadGroupCountY = (DstHeight + m_ThreadGroupSize - 1) / m_ThreadGroupSize;
+        pContext->DispatchCompute(DispatchAttribs);
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,709 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "DebugUtilities.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "Serializer.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+const char* const MeshletCullingShaderSource = R"(
+#ifndef MESHLET_AS_GROUP_SIZE
+#   define MESHLET_AS_GROUP_SIZE 32
+#endif
+
+struct MeshletDesc
+{
+    uint VertexOffset;
+    uint TriangleOffset;
+    uint VertexCount;
+    uint TriangleCount;
+};
+
+struct MeshletBounds
+{
+    float4 Sphere; // Center in xyz, radius in w
+    float4 Cone;   // Axis in xyz, cutoff in w
+};
+
+struct MeshletPayload
+{
+    uint MeshletIndices[MESHLET_AS_GROUP_SIZE];
+};
+
+// Returns the indices of the triangle vertices relative to MeshletDesc.VertexOffset
+uint3 UnpackMeshletTriangle(uint Packed)
+{
+    return uint3(Packed & 0xFFu, (Packed >> 8u) & 0xFFu, (Packed >> 16u) & 0xFFu);
+}
+
+bool IsMeshletInFrustum(float4 Sphere, float4 FrustumPlanes[6])
+{
+    for (uint i = 0u; i < 6u; ++i)
+    {
+        if (dot(Sphere.xyz, FrustumPlanes[i].xyz) + FrustumPlanes[i].w < -Sphere.w)
+            return false;
+    }
+    return true;
+}
+
+// Sphere, cone axis and camera position must be in the same space
+bool IsMeshletBackFacing(float4 Sphere, float4 Cone, float3 CameraPos)
+{
+    float3 Dir = Sphere.xyz - CameraPos;
+    return dot(Dir, Cone.xyz) >= Cone.w * length(Dir) + Sphere.w;
+}
+
+#ifdef MESHLET_CULLING_AS
+cbuffer cbMeshletCullingConstants
+{
+    float4x4 g_World;
+    float4   g_FrustumPlanes[6];
+    float3   g_CameraPos;
+    float    g_Scale;
+    uint     g_FirstMeshlet;
+    uint     g_NumMeshlets;
+    uint     g_ConeCulling;
+    uint     g_Padding;
+};
+
+StructuredBuffer<MeshletBounds> g_MeshletBounds;
+
+groupshared MeshletPayload s_Payload;
+groupshared uint           s_NumVisible;
+
+[numthreads(MESHLET_AS_GROUP_SIZE, 1, 1)]
+void main(uint DTid : SV_DispatchThreadID,
+          uint GI   : SV_GroupIndex)
+{
+    if (GI == 0u)
+        s_NumVisible = 0u;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint MeshletIdx = g_FirstMeshlet + DTid;
+    if (DTid < g_NumMeshlets)
+    {
+        MeshletBounds Bounds = g_MeshletBounds[MeshletIdx];
+
+        float4 Sphere = float4(mul(float4(Bounds.Sphere.xyz, 1.0), g_World).xyz, Bounds.Sphere.w * g_Scale);
+        bool   Visible = IsMeshletInFrustum(Sphere, g_FrustumPlanes);
+        if (Visible && g_ConeCulling != 0u && Bounds.Cone.w < 1.0)
+        {
+            float3 Axis = normalize(mul(float4(Bounds.Cone.xyz, 0.0), g_World).xyz);
+            Visible = !IsMeshletBackFacing(Sphere, float4(Axis, Bounds.Cone.w), g_CameraPos);
+        }
+
+        if (Visible)
+        {
+            uint Index;
+            InterlockedAdd(s_NumVisible, 1u, Index);
+            s_Payload.MeshletIndices[Index] = MeshletIdx;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(s_NumVisible, 1, 1, s_Payload);
+}
+#endif
+)";
+// clang-format on
+
+struct MeshletBufferHeader
+{
+    static constexpr Uint32 HeaderMagic   = 0x4D53484C;
+    static constexpr Uint32 HeaderVersion = 1;
+
+    Uint32 Magic        = HeaderMagic;
+    Uint32 Version      = HeaderVersion;
+    Uint32 MaxVertices  = 0;
+    Uint32 MaxTriangles = 0;
+    Uint32 NumMeshlets  = 0;
+    Uint32 NumVertices  = 0;
+    Uint32 NumTriangles = 0;
+    Uint32 Padding      = 0;
+
+    template <typename SerType>
+    void Serialize(SerType& Stream)
+    {
+        Stream(Magic, Version, MaxVertices, MaxTriangles, NumMeshlets, NumVertices, NumTriangles, Padding);
+    }
+};
+
+constexpr Uint32 InvalidIndex = ~0u;
+
+// Triangles adjacent to every vertex in compressed sparse row format
+struct VertexAdjacency
+{
+    std::vector<Uint32> Offsets;
+    std::vector<Uint32> Triangles;
+
+    VertexAdjacency(const std::vector<Uint32>& Indices, Uint32 NumVertices) :
+        Offsets(size_t{NumVertices} + 1, 0),
+        Triangles(Indices.size())
+    {
+        for (auto Idx : Indices)
+            ++Offsets[Idx + 1];
+        for (size_t v = 0; v < NumVertices; ++v)
+            Offsets[v + 1] += Offsets[v];
+
+        std::vector<Uint32> Fill{Offsets.begin(), Offsets.end() - 1};
+        for (size_t i = 0; i < Indices.size(); ++i)
+            Triangles[Fill[Indices[i]]++] = static_cast<Uint32>(i / 3);
+    }
+
+    const Uint32* begin(Uint32 v) const { return Triangles.data() + Offsets[v]; }
+    const Uint32* end(Uint32 v) const { return Triangles.data() + Offsets[v + 1]; }
+    Uint32        GetValence(Uint32 v) const { return Offsets[v + 1] - Offsets[v]; }
+};
+
+// Reorders triangles for the post-transform vertex cache using the Tipsify algorithm
+// (Sander, Nehab, Barczak - Fast Triangle Reordering for Vertex Locality and Reduced Overdraw, 2007).
+std::vector<Uint32> OptimizeTriangleOrder(const std::vector<Uint32>& Indices,
+                                          Uint32                     NumVertices,
+                                          const VertexAdjacency&     Adjacency,
+                                          Uint32                     CacheSize)
+{
+    const auto NumTriangles = static_cast<Uint32>(Indices.size() / 3);
+
+    std::vector<Uint32> Order;
+    Order.reserve(NumTriangles);
+
+    std::vector<Uint32> LiveTriangles(NumVertices);
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        LiveTriangles[v] = Adjacency.GetValence(v);
+
+    std::vector<Uint32> CacheTime(NumVertices, 0);
+    std::vector<bool>   Emitted(NumTriangles, false);
+    std::vector<Uint32> DeadEnd;
+    std::vector<Uint32> Candidates;
+
+    Uint32 Time   = CacheSize + 1;
+    Uint32 Cursor = 0;
+
+    const auto SkipDeadEnd = [&]() {
+        while (!DeadEnd.empty())
+        {
+            const auto v = DeadEnd.back();
+            DeadEnd.pop_back();
+            if (LiveTriangles[v] > 0)
+                return v;
+        }
+        for (; Cursor < NumVertices; ++Cursor)
+        {
+            if (LiveTriangles[Cursor] > 0)
+                return Cursor;
+        }
+        return InvalidIndex;
+    };
+
+    auto Fan = SkipDeadEnd();
+    while (Fan != InvalidIndex)
+    {
+        Candidates.clear();
+        for (auto it = Adjacency.begin(Fan); it != Adjacency.end(Fan); ++it)
+        {
+            const auto t = *it;
+            if (Emitted[t])
+                continue;
+
+            Order.push_back(t);
+            Emitted[t] = true;
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const auto v = Indices[t * 3 + i];
+                DeadEnd.push_back(v);
+                Candidates.push_back(v);
+                --LiveTriangles[v];
+                if (Time - CacheTime[v] > CacheSize)
+                    CacheTime[v] = Time++;
+            }
+        }
+
+        // Select the vertex that will still be in the cache after all its triangles are emitted
+        Fan               = InvalidIndex;
+        Uint32 MaxPriority = 0;
+        for (auto v : Candidates)
+        {
+            if (LiveTriangles[v] == 0)
+                continue;
+
+            const auto Age = Time - CacheTime[v];
+            if (Age + 2 * LiveTriangles[v] <= CacheSize && Age > MaxPriority)
+            {
+                MaxPriority = Age;
+                Fan         = v;
+            }
+        }
+        if (Fan == InvalidIndex)
+            Fan = SkipDeadEnd();
+    }
+    VERIFY_EXPR(Order.size() == NumTriangles);
+
+    return Order;
+}
+
+float3 ReadPosition(const void* pPositions, Uint32 Stride, Uint32 Vertex)
+{
+    float3 Pos;
+    memcpy(&Pos, static_cast<const Uint8*>(pPositions) + size_t{Stride} * Vertex, sizeof(Pos));
+    return Pos;
+}
+
+} // namespace
+
+void MeshletBuffer::Store(IDataBlob** ppDataBlob) const
+{
+    VERIFY_EXPR(ppDataBlob != nullptr);
+    VERIFY(Bounds.size() == Meshlets.size(), "The number of bounds must match the number of meshlets");
+
+    auto WriteData = [&](auto& Stream) //
+    {
+        MeshletBufferHeader Header;
+        Header.MaxVertices  = MaxVertices;
+        Header.MaxTriangles = MaxTriangles;
+        Header.NumMeshlets  = static_cast<Uint32>(Meshlets.size());
+        Header.NumVertices  = static_cast<Uint32>(Vertices.size());
+        Header.NumTriangles = static_cast<Uint32>(Triangles.size());
+        Header.Serialize(Stream);
+
+        Stream.CopyBytes(Meshlets.data(), Meshlets.size() * sizeof(MeshletDesc));
+        Stream.CopyBytes(Bounds.data(), Bounds.size() * sizeof(MeshletBounds));
+        Stream.CopyBytes(Vertices.data(), Vertices.size() * sizeof(Uint32));
+        Stream.CopyBytes(Triangles.data(), Triangles.size() * sizeof(Uint32));
+    };
+
+    Serializer<SerializerMode::Measure> MeasureStream{};
+    WriteData(MeasureStream);
+
+    const auto Memory = MeasureStream.AllocateData(DefaultRawMemoryAllocator::GetAllocator());
+
+    Serializer<SerializerMode::Write> WriteStream{Memory};
+    WriteData(WriteStream);
+    VERIFY_EXPR(WriteStream.IsEnded());
+
+    *ppDataBlob = DataBlobImpl::Create(Memory.Size(), Memory.Ptr()).Detach();
+}
+
+bool MeshletBuffer::Load(IDataBlob* pDataBlob)
+{
+    Clear();
+
+    if (pDataBlob == nullptr)
+    {
+        UNEXPECTED("Data blob must not be null");
+        return false;
+    }
+
+    if (pDataBlob->GetSize() < sizeof(MeshletBufferHeader))
+    {
+        LOG_ERROR_MESSAGE("The data blob is too small to contain a meshlet buffer.");
+        return false;
+    }
+
+    Serializer<SerializerMode::Read> Stream{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
+
+    MeshletBufferHeader Header;
+    Header.Serialize(Stream);
+    if (Header.Magic != MeshletBufferHeader::HeaderMagic)
+    {
+        LOG_ERROR_MESSAGE("Incorrect meshlet buffer header magic number.");
+        return false;
+    }
+    if (Header.Version != MeshletBufferHeader::HeaderVersion)
+    {
+        LOG_ERROR_MESSAGE("Incorrect meshlet buffer version (", Header.Version, "). ", Uint32{MeshletBufferHeader::HeaderVersion}, " is expected.");
+        return false;
+    }
+
+    const auto DataSize = size_t{Header.NumMeshlets} * (sizeof(MeshletDesc) + sizeof(MeshletBounds)) +
+        (size_t{Header.NumVertices} + size_t{Header.NumTriangles}) * sizeof(Uint32);
+    if (Stream.GetRemainingSize() != DataSize)
+    {
+        LOG_ERROR_MESSAGE("The size of the meshlet buffer data (", Stream.GetRemainingSize(), ") does not match the expected size (", DataSize, ").");
+        return false;
+    }
+
+    MaxVertices  = Header.MaxVertices;
+    MaxTriangles = Header.MaxTriangles;
+    Meshlets.resize(Header.NumMeshlets);
+    Bounds.resize(Header.NumMeshlets);
+    Vertices.resize(Header.NumVertices);
+    Triangles.resize(Header.NumTriangles);
+    Stream.CopyBytes(Meshlets.data(), Meshlets.size() * sizeof(MeshletDesc));
+    Stream.CopyBytes(Bounds.data(), Bounds.size() * sizeof(MeshletBounds));
+    Stream.CopyBytes(Vertices.data(), Vertices.size() * sizeof(Uint32));
+    Stream.CopyBytes(Triangles.data(), Triangles.size() * sizeof(Uint32));
+    VERIFY_EXPR(Stream.IsEnded());
+
+    bool IsValid = MaxVertices <= 256;
+    for (size_t i = 0; i < Meshlets.size() && IsValid; ++i)
+    {
+        const auto& Meshlet = Meshlets[i];
+
+        IsValid = (Meshlet.VertexCount <= MaxVertices &&
+                   Meshlet.TriangleCount <= MaxTriangles &&
+                   Meshlet.VertexOffset <= Vertices.size() &&
+                   Meshlet.VertexCount <= Vertices.size() - Meshlet.VertexOffset &&
+                   Meshlet.TriangleOffset <= Triangles.size() &&
+                   Meshlet.TriangleCount <= Triangles.size() - Meshlet.TriangleOffset);
+
+        for (Uint32 t = 0; t < Meshlet.TriangleCount && IsValid; ++t)
+        {
+            const auto Tri = Triangles[size_t{Meshlet.TriangleOffset} + t];
+
+            IsValid = (Tri >> 24u) == 0;
+            for (Uint32 i = 0; i < 3; ++i)
+                IsValid = IsValid && ((Tri >> (i * 8u)) & 0xFFu) < Meshlet.VertexCount;
+        }
+    }
+
+    if (!IsValid)
+    {
+        LOG_ERROR_MESSAGE("The meshlet buffer data is corrupted.");
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+void MeshletBuffer::Clear()
+{
+    MaxVertices  = 0;
+    MaxTriangles = 0;
+    Meshlets.clear();
+    Bounds.clear();
+    Vertices.clear();
+    Triangles.clear();
+}
+
+bool BuildMeshlets(const BuildMeshletsAttribs& Attribs, MeshletBuffer& Buffer)
+{
+    Buffer.Clear();
+
+    if (Attribs.pIndices == nullptr && Attribs.NumIndices > 0)
+    {
+        LOG_ERROR_MESSAGE("pIndices must not be null");
+        return false;
+    }
+    if (Attribs.pPositions == nullptr && Attribs.NumVertices > 0)
+    {
+        LOG_ERROR_MESSAGE("pPositions must not be null");
+        return false;
+    }
+    if (Attribs.NumIndices % 3 != 0)
+    {
+        LOG_ERROR_MESSAGE("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+        return false;
+    }
+    if (Attribs.PositionStride < sizeof(float3))
+    {
+        LOG_ERROR_MESSAGE("Position stride (", Attribs.PositionStride, ") must be at least ", sizeof(float3), " bytes");
+        return false;
+    }
+    if (Attribs.MaxVertices < 3 || Attribs.MaxVertices > 256)
+    {
+        LOG_ERROR_MESSAGE("The maximum number of meshlet vertices (", Attribs.MaxVertices, ") must be in the range [3, 256]");
+        return false;
+    }
+    if (Attribs.MaxTriangles == 0)
+    {
+        LOG_ERROR_MESSAGE("The maximum number of meshlet triangles must not be zero");
+        return false;
+    }
+
+    Buffer.MaxVertices  = Attribs.MaxVertices;
+    Buffer.MaxTriangles = Attribs.MaxTriangles;
+
+    // Remove degenerate triangles
+    std::vector<Uint32> Indices;
+    Indices.reserve(Attribs.NumIndices);
+    for (Uint32 i = 0; i < Attribs.NumIndices; i += 3)
+    {
+        const auto* Tri = Attribs.pIndices + i;
+        if (Tri[0] >= Attribs.NumVertices || Tri[1] >= Attribs.NumVertices || Tri[2] >= Attribs.NumVertices)
+        {
+            LOG_ERROR_MESSAGE("Triangle ", i / 3, " references a vertex that is out of range [0, ", Attribs.NumVertices, ")");
+            Buffer.Clear();
+            return false;
+        }
+        if (Tri[0] != Tri[1] && Tri[1] != Tri[2] && Tri[0] != Tri[2])
+            Indices.insert(Indices.end(), Tri, Tri + 3);
+    }
+
+    const auto NumTriangles = static_cast<Uint32>(Indices.size() / 3);
+    if (NumTriangles == 0)
+        return true;
+
+    const VertexAdjacency Adjacency{Indices, Attribs.NumVertices};
+
+    std::vector<Uint32> Order;
+    if (Attribs.OptimizeVertexCache)
+    {
+        Order = OptimizeTriangleOrder(Indices, Attribs.NumVertices, Adjacency, std::max(Attribs.VertexCacheSize, 3u));
+    }
+    else
+    {
+        Order.resize(NumTriangles);
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+            Order[t] = t;
+    }
+
+    std::vector<Uint32> OrderPos(NumTriangles);
+    for (Uint32 i = 0; i < NumTriangles; ++i)
+        OrderPos[Order[i]] = i;
+
+    std::vector<Uint32> LiveTriangles(Attribs.NumVertices);
+    for (Uint32 v = 0; v < Attribs.NumVertices; ++v)
+        LiveTriangles[v] = Adjacency.GetValence(v);
+
+    // Index of every vertex in the current meshlet
+    std::vector<Uint32> LocalIndex(Attribs.NumVertices, InvalidIndex);
+    std::vector<bool>   Assigned(NumTriangles, false);
+
+    MeshletDesc Meshlet;
+
+    const auto GetNumNewVertices = [&](Uint32 t) {
+        Uint32 NumNew = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+            NumNew += LocalIndex[Indices[t * 3 + i]] == InvalidIndex ? 1 : 0;
+        return NumNew;
+    };
+
+    const auto AddTriangle = [&](Uint32 t) {
+        Uint32 Packed = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            const auto v = Indices[t * 3 + i];
+            if (LocalIndex[v] == InvalidIndex)
+            {
+                LocalIndex[v] = Meshlet.VertexCount++;
+                Buffer.Vertices.push_back(v);
+            }
+            Packed |= LocalIndex[v] << (i * 8);
+            --LiveTriangles[v];
+        }
+        Buffer.Triangles.push_back(Packed);
+        ++Meshlet.TriangleCount;
+        Assigned[t] = true;
+    };
+
+    const auto FinishMeshlet = [&]() {
+        if (Meshlet.TriangleCount == 0)
+            return;
+
+        for (size_t i = Meshlet.VertexOffset; i < Buffer.Vertices.size(); ++i)
+            LocalIndex[Buffer.Vertices[i]] = InvalidIndex;
+        Buffer.Meshlets.push_back(Meshlet);
+
+        Meshlet                = {};
+        Meshlet.VertexOffset   = static_cast<Uint32>(Buffer.Vertices.size());
+        Meshlet.TriangleOffset = static_cast<Uint32>(Buffer.Triangles.size());
+    };
+
+    Uint32 OrderCursor = 0;
+    while (true)
+    {
+        auto Next        = InvalidIndex;
+        bool HasAdjacent = false;
+        if (Meshlet.TriangleCount > 0 && Meshlet.TriangleCount < Attribs.MaxTriangles)
+        {
+            // Grow the meshlet with the adjacent triangle that adds the fewest vertices
+            Uint32 MinNewVertices = 4;
+            for (size_t i = Meshlet.VertexOffset; i < Buffer.Vertices.size(); ++i)
+            {
+                const auto v = Buffer.Vertices[i];
+                if (LiveTriangles[v] == 0)
+                    continue;
+
+                for (auto it = Adjacency.begin(v); it != Adjacency.end(v); ++it)
+                {
+                    const auto t = *it;
+                    if (Assigned[t])
+                        continue;
+
+                    HasAdjacent = true;
+
+                    const auto NumNew = GetNumNewVertices(t);
+                    if (Meshlet.VertexCount + NumNew > Attribs.MaxVertices)
+                        continue;
+
+                    if (NumNew < MinNewVertices || (NumNew == MinNewVertices && OrderPos[t] < OrderPos[Next]))
+                    {
+                        MinNewVertices = NumNew;
+                        Next           = t;
+                    }
+                }
+            }
+        }
+
+        if (Next == InvalidIndex)
+        {
+            // Start a new meshlet if the current one is full or can't grow any further
+            if (HasAdjacent || Meshlet.TriangleCount == Attribs.MaxTriangles)
+                FinishMeshlet();
+
+            while (OrderCursor < NumTriangles && Assigned[Order[OrderCursor]])
+                ++OrderCursor;
+            if (OrderCursor == NumTriangles)
+                break;
+
+            Next = Order[OrderCursor];
+            if (Meshlet.VertexCount + GetNumNewVertices(Next) > Attribs.MaxVertices)
+                FinishMeshlet();
+        }
+
+        AddTriangle(Next);
+    }
+    FinishMeshlet();
+
+    Buffer.Bounds.resize(Buffer.Meshlets.size());
+    for (Uint32 m = 0; m < Buffer.Meshlets.size(); ++m)
+        Buffer.Bounds[m] = ComputeMeshletBounds(Buffer, m, Attribs.pPositions, Attribs.PositionStride, Attribs.FrontCounterClockwise);
+
+    return true;
+}
+
+MeshletBounds ComputeMeshletBounds(const MeshletBuffer& Buffer,
+                                   Uint32               MeshletIndex,
+                                   const void*          pPositions,
+                                   Uint32               PositionStride,
+                                   bool                 FrontCounterClockwise)
+{
+    VERIFY_EXPR(MeshletIndex < Buffer.Meshlets.size());
+    const auto& Meshlet = Buffer.Meshlets[MeshletIndex];
+
+    MeshletBounds Bounds;
+    if (Meshlet.VertexCount == 0)
+        return Bounds;
+
+    const auto GetPosition = [&](Uint32 LocalIdx) {
+        return ReadPosition(pPositions, PositionStride, Buffer.Vertices[size_t{Meshlet.VertexOffset} + LocalIdx]);
+    };
+
+    // Ritter's bounding sphere: start with the most separated pair of the axis-aligned extreme points
+    Uint32 MinIdx[3] = {};
+    Uint32 MaxIdx[3] = {};
+    for (Uint32 i = 1; i < Meshlet.VertexCount; ++i)
+    {
+        const auto Pos = GetPosition(i);
+        for (int c = 0; c < 3; ++c)
+        {
+            if (Pos[c] < GetPosition(MinIdx[c])[c])
+                MinIdx[c] = i;
+            if (Pos[c] > GetPosition(MaxIdx[c])[c])
+                MaxIdx[c] = i;
+        }
+    }
+
+    int   Axis      = 0;
+    float MaxDistSq = -1;
+    for (int c = 0; c < 3; ++c)
+    {
+        const auto Diff   = GetPosition(MaxIdx[c]) - GetPosition(MinIdx[c]);
+        const auto DistSq = dot(Diff, Diff);
+        if (DistSq > MaxDistSq)
+        {
+            MaxDistSq = DistSq;
+            Axis      = c;
+        }
+    }
+
+    auto  Center = (GetPosition(MinIdx[Axis]) + GetPosition(MaxIdx[Axis])) * 0.5f;
+    float Radius = std::sqrt(MaxDistSq) * 0.5f;
+    for (Uint32 i = 0; i < Meshlet.VertexCount; ++i)
+    {
+        const auto Pos  = GetPosition(i);
+        const auto Dist = length(Pos - Center);
+        if (Dist > Radius)
+        {
+            const auto NewRadius = (Radius + Dist) * 0.5f;
+            Center += (Pos - Center) * ((NewRadius - Radius) / Dist);
+            Radius = NewRadius;
+        }
+    }
+    Bounds.Sphere = float4{Center, Radius};
+
+    // Normal cone
+    std::vector<float3> Normals;
+    Normals.reserve(Meshlet.TriangleCount);
+    float3 AxisSum;
+    for (Uint32 t = 0; t < Meshlet.TriangleCount; ++t)
+    {
+        const auto Tri = Buffer.Triangles[size_t{Meshlet.TriangleOffset} + t];
+        const auto P0  = GetPosition(Tri & 0xFFu);
+        const auto P1  = GetPosition((Tri >> 8u) & 0xFFu);
+        const auto P2  = GetPosition((Tri >> 16u) & 0xFFu);
+
+        auto       Normal = cross(P1 - P0, P2 - P0);
+        const auto Len    = length(Normal);
+        if (Len == 0)
+            continue;
+
+        Normal /= FrontCounterClockwise ? -Len : Len;
+        Normals.push_back(Normal);
+        AxisSum += Normal;
+    }
+
+    const auto AxisLen = length(AxisSum);
+    // The cone can't be built if all triangles are degenerate or the normals cancel out
+    Bounds.Cone = float4{0, 0, 1, 1};
+    if (AxisLen > 0)
+    {
+        const auto ConeAxis = AxisSum / AxisLen;
+
+        float MinDot = 1;
+        for (const auto& Normal : Normals)
+            MinDot = std::min(MinDot, dot(Normal, ConeAxis));
+
+        // The cone is too wide to ever cull the meshlet
+        Bounds.Cone = MinDot > 0.1f ?
+            float4{ConeAxis, std::sqrt(1 - MinDot * MinDot)} :
+            float4{ConeAxis, 1};
+    }
+
+    return Bounds;
+}
+
+const char* GetMeshletCullingShaderSource()
+{
+    return MeshletCullingShaderSource;
+}
+
+} // namespace Diligent
@@ -0,0 +1,699 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void AddUnique(std::vector<RenderGraph::PassHandle>& Passes, RenderGraph::PassHandle Pass)
+{
+    if (std::find(Passes.begin(), Passes.end(), Pass) == Passes.end())
+        Passes.push_back(Pass);
+}
+
+// States that are not supported by compute queues. Resources in these states
+// must be transitioned on the graphics queue before a compute pass can use them.
+constexpr RESOURCE_STATE GraphicsOnlyStates =
+    RESOURCE_STATE_VERTEX_BUFFER |
+    RESOURCE_STATE_INDEX_BUFFER |
+    RESOURCE_STATE_RENDER_TARGET |
+    RESOURCE_STATE_DEPTH_WRITE |
+    RESOURCE_STATE_DEPTH_READ |
+    RESOURCE_STATE_STREAM_OUT |
+    RESOURCE_STATE_RESOLVE_DEST |
+    RESOURCE_STATE_RESOLVE_SOURCE |
+    RESOURCE_STATE_INPUT_ATTACHMENT |
+    RESOURCE_STATE_PRESENT |
+    RESOURCE_STATE_SHADING_RATE;
+
+} // namespace
+
+RenderGraph::RenderGraph(IRenderDevice* pDevice) :
+    m_pDevice{pDevice},
+    m_TransientAllocator{pDevice}
+{
+    VERIFY_EXPR(m_pDevice);
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportTexture(ITexture* pTexture)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Resources can't be added after Compile() has been called. Call Reset() to start a new frame.");
+    DEV_CHECK_ERR(pTexture != nullptr, "Imported texture must not be null");
+
+    ResourceInfo Res;
+    Res.Name       = pTexture->GetDesc().Name != nullptr ? pTexture->GetDesc().Name : "";
+    Res.pTexture   = pTexture;
+    Res.IsImported = true;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportBuffer(IBuffer* pBuffer)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Resources can't be added after Compile() has been called. Call Reset() to start a new frame.");
+    DEV_CHECK_ERR(pBuffer != nullptr, "Imported buffer must not be null");
+
+    ResourceInfo Res;
+    Res.Name       = pBuffer->GetDesc().Name != nullptr ? pBuffer->GetDesc().Name : "";
+    Res.pBuffer    = pBuffer;
+    Res.IsImported = true;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTexture(const TextureDesc& Desc)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Resources can't be added after Compile() has been called. Call Reset() to start a new frame.");
+
+    ResourceInfo Res;
+    Res.Name          = Desc.Name != nullptr ? Desc.Name : "";
+    Res.TransientDesc = Desc;
+    // The name is set by AllocateTransientTextures()
+    Res.TransientDesc.Name = nullptr;
+
+    if ((Res.TransientDesc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0)
+    {
+        // Fall back to regular memory on devices that do not support memoryless textures with these bind flags
+        const auto MemorylessBindFlags = m_pDevice->GetAdapterInfo().Memory.MemorylessTextureBindFlags;
+        if ((Desc.BindFlags & MemorylessBindFlags) != Desc.BindFlags)
+            Res.TransientDesc.MiscFlags &= ~MISC_TEXTURE_FLAG_MEMORYLESS;
+    }
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::PassHandle RenderGraph::AddPass(const Char*             Name,
+                                             RENDER_GRAPH_PASS_FLAGS Flags,
+                                             ExecuteCallbackType     Execute)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Passes can't be added after Compile() has been called. Call Reset() to start a new frame.");
+
+    PassInfo Pass;
+    Pass.Name    = Name != nullptr ? Name : "";
+    Pass.Flags   = Flags;
+    Pass.Execute = std::move(Execute);
+    m_Passes.emplace_back(std::move(Pass));
+    return static_cast<PassHandle>(m_Passes.size() - 1);
+}
+
+void RenderGraph::Read(PassHandle Pass, ResourceHandle Resource, RESOURCE_STATE State)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Resource accesses can't be declared after Compile() has been called");
+    DEV_CHECK_ERR(Pass < m_Passes.size(), "Pass handle (", Pass, ") is out of range");
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Resource handle (", Resource, ") is out of range");
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN && State != RESOURCE_STATE_UNDEFINED, "Resource state must be defined");
+
+    m_Passes[Pass].Accesses.push_back({Resource, State, false});
+}
+
+void RenderGraph::Write(PassHandle Pass, ResourceHandle Resource, RESOURCE_STATE State)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Resource accesses can't be declared after Compile() has been called");
+    DEV_CHECK_ERR(Pass < m_Passes.size(), "Pass handle (", Pass, ") is out of range");
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Resource handle (", Resource, ") is out of range");
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN && State != RESOURCE_STATE_UNDEFINED, "Resource state must be defined");
+
+    m_Passes[Pass].Accesses.push_back({Resource, State, true});
+}
+
+void RenderGraph::BuildDependencies()
+{
+    struct ResourceUsage
+    {
+        PassHandle              LastWriter = InvalidHandle;
+        std::vector<PassHandle> Readers;
+    };
+    std::vector<ResourceUsage> Usages(m_Resources.size());
+
+    // Passes are declared in a valid order, so every access only depends on the accesses declared before it
+    for (PassHandle p = 0; p < m_Passes.size(); ++p)
+    {
+        auto& Pass = m_Passes[p];
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite)
+                continue;
+
+            auto& Usage = Usages[Access.Resource];
+            if (Usage.LastWriter != InvalidHandle && Usage.LastWriter != p)
+            {
+                // Read after write
+                AddUnique(Pass.Dependencies, Usage.LastWriter);
+                AddUnique(Pass.Producers, Usage.LastWriter);
+            }
+            AddUnique(Usage.Readers, p);
+        }
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (!Access.IsWrite)
+                continue;
+
+            auto& Usage = Usages[Access.Resource];
+            if (Usage.LastWriter != InvalidHandle && Usage.LastWriter != p)
+            {
+                // Write after write: the pass may e.g. blend on top of the previous contents
+                AddUnique(Pass.Dependencies, Usage.LastWriter);
+                AddUnique(Pass.Producers, Usage.LastWriter);
+            }
+            for (auto Reader : Usage.Readers)
+            {
+                // Write after read
+                if (Reader != p)
+                    AddUnique(Pass.Dependencies, Reader);
+            }
+            Usage.LastWriter = p;
+            Usage.Readers.clear();
+        }
+    }
+}
+
+void RenderGraph::CullPasses()
+{
+    std::vector<PassHandle> AlivePasses;
+    for (PassHandle p = 0; p < m_Passes.size(); ++p)
+    {
+        auto& Pass    = m_Passes[p];
+        Pass.IsCulled = true;
+
+        bool IsRoot = (Pass.Flags & RENDER_GRAPH_PASS_FLAG_NEVER_CULL) != 0;
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite && m_Resources[Access.Resource].IsImported)
+                IsRoot = true;
+        }
+
+        if (IsRoot)
+        {
+            Pass.IsCulled = false;
+            AlivePasses.push_back(p);
+        }
+    }
+
+    while (!AlivePasses.empty())
+    {
+        const auto p = AlivePasses.back();
+        AlivePasses.pop_back();
+        for (auto Producer : m_Passes[p].Producers)
+        {
+            if (m_Passes[Producer].IsCulled)
+            {
+                m_Passes[Producer].IsCulled = false;
+                AlivePasses.push_back(Producer);
+            }
+        }
+    }
+}
+
+void RenderGraph::SortPasses()
+{
+    m_ExecutionOrder.clear();
+
+    std::vector<Uint32>                  NumPendingDeps(m_Passes.size());
+    std::vector<std::vector<PassHandle>> Dependents(m_Passes.size());
+    std::vector<PassHandle>              ReadyPasses;
+    for (PassHandle p = 0; p < m_Passes.size(); ++p)
+    {
+        const auto& Pass = m_Passes[p];
+        if (Pass.IsCulled)
+            continue;
+
+        for (auto Dep : Pass.Dependencies)
+        {
+            if (m_Passes[Dep].IsCulled)
+                continue;
+            ++NumPendingDeps[p];
+            Dependents[Dep].push_back(p);
+        }
+        if (NumPendingDeps[p] == 0)
+            ReadyPasses.push_back(p);
+    }
+
+    while (!ReadyPasses.empty())
+    {
+        // Start asynchronous compute passes as early as possible to give them more
+        // work on the graphics queue to overlap with. Otherwise, keep the declaration order.
+        auto NextIt = std::min_element(ReadyPasses.begin(), ReadyPasses.end(),
+                                       [this](PassHandle lhs, PassHandle rhs) {
+                                           const bool lhsAsync = (m_Passes[lhs].Flags & RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE) != 0;
+                                           const bool rhsAsync = (m_Passes[rhs].Flags & RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE) != 0;
+                                           return lhsAsync != rhsAsync ? lhsAsync : lhs < rhs;
+                                       });
+
+        const auto p = *NextIt;
+        ReadyPasses.erase(NextIt);
+        m_ExecutionOrder.push_back(p);
+
+        for (auto Dependent : Dependents[p])
+        {
+            VERIFY_EXPR(NumPendingDeps[Dependent] > 0);
+            if (--NumPendingDeps[Dependent] == 0)
+                ReadyPasses.push_back(Dependent);
+        }
+    }
+    VERIFY(m_ExecutionOrder.size() == static_cast<size_t>(std::count_if(m_Passes.begin(), m_Passes.end(), [](const PassInfo& Pass) { return !Pass.IsCulled; })),
+           "Not all passes have been scheduled. This indicates a dependency cycle, which should never happen as dependencies always point to earlier passes.");
+
+    // Compute the passes that each pass transitively depends on.
+    // Ancestors[i][j] is true if the pass at position j must complete before the pass at position i.
+    const auto NumAlive = m_ExecutionOrder.size();
+
+    std::vector<Uint32> Positions(m_Passes.size(), InvalidHandle);
+    for (Uint32 i = 0; i < NumAlive; ++i)
+        Positions[m_ExecutionOrder[i]] = i;
+
+    std::vector<std::vector<bool>> Ancestors(NumAlive, std::vector<bool>(NumAlive));
+    for (Uint32 i = 0; i < NumAlive; ++i)
+    {
+        for (auto Dep : m_Passes[m_ExecutionOrder[i]].Dependencies)
+        {
+            const auto DepPos = Positions[Dep];
+            if (DepPos == InvalidHandle)
+                continue;
+            VERIFY_EXPR(DepPos < i);
+            Ancestors[i][DepPos] = true;
+            for (Uint32 j = 0; j < DepPos; ++j)
+            {
+                if (Ancestors[DepPos][j])
+                    Ancestors[i][j] = true;
+            }
+        }
+    }
+
+    // Only move a pass to the compute queue if there is a graphics pass it can run in parallel with.
+    for (Uint32 i = 0; i < NumAlive; ++i)
+    {
+        auto& Pass     = m_Passes[m_ExecutionOrder[i]];
+        Pass.OnCompute = false;
+        if ((Pass.Flags & RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE) == 0)
+            continue;
+
+        for (Uint32 j = 0; j < NumAlive && !Pass.OnCompute; ++j)
+        {
+            if (i == j || (m_Passes[m_ExecutionOrder[j]].Flags & RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE) != 0)
+                continue;
+            if (!Ancestors[i][j] && !Ancestors[j][i])
+                Pass.OnCompute = true;
+        }
+    }
+}
+
+void RenderGraph::AllocateTransientTextures()
+{
+    // Lifetimes are expressed as positions in the execution order
+    for (ResourceHandle r = 0; r < m_Resources.size(); ++r)
+    {
+        auto& Res = m_Resources[r];
+        if (Res.IsImported)
+            continue;
+
+        TransientTextureDesc TransientDesc;
+        TransientDesc.Desc      = Res.TransientDesc;
+        TransientDesc.Desc.Name = Res.Name.c_str();
+        TransientDesc.FirstPass = InvalidHandle;
+        TransientDesc.LastPass  = 0;
+        for (Uint32 i = 0; i < m_ExecutionOrder.size(); ++i)
+        {
+            const auto& Pass = m_Passes[m_ExecutionOrder[i]];
+            for (const auto& Access : Pass.Accesses)
+            {
+                if (Access.Resource != r)
+                    continue;
+                TransientDesc.FirstPass = std::min(TransientDesc.FirstPass, i);
+                TransientDesc.LastPass  = std::max(TransientDesc.LastPass, i);
+
+                constexpr auto AttachmentStates = RESOURCE_STATE_RENDER_TARGET | RESOURCE_STATE_DEPTH_WRITE | RESOURCE_STATE_DEPTH_READ | RESOURCE_STATE_INPUT_ATTACHMENT;
+                if ((TransientDesc.Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0 && (Access.State & ~AttachmentStates) != 0)
+                {
+                    LOG_WARNING_MESSAGE("Memoryless texture '", Res.Name, "' is accessed by pass '", Pass.Name, "' in state ",
+                                        GetResourceStateString(Access.State), ", which is not an attachment state. The texture will be allocated in regular memory.");
+                    TransientDesc.Desc.MiscFlags &= ~MISC_TEXTURE_FLAG_MEMORYLESS;
+                }
+            }
+        }
+
+        // The contents of a memoryless texture only exist on chip while the render pass is active
+        // and can't be preserved between passes.
+        if ((TransientDesc.Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0 && TransientDesc.FirstPass != TransientDesc.LastPass)
+        {
+            LOG_WARNING_MESSAGE("Memoryless texture '", Res.Name, "' is used by more than one pass. The texture will be allocated in regular memory.");
+            TransientDesc.Desc.MiscFlags &= ~MISC_TEXTURE_FLAG_MEMORYLESS;
+        }
+
+        // Textures that are only used by culled passes are not allocated
+        if (TransientDesc.FirstPass != InvalidHandle)
+            Res.TransientHandle = m_TransientAllocator.DeclareTexture(TransientDesc);
+    }
+
+    m_TransientAllocator.Compile();
+}
+
+void RenderGraph::Compile()
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "The graph has already been compiled. Call Reset() to start a new frame.");
+
+    BuildDependencies();
+    CullPasses();
+    SortPasses();
+    AllocateTransientTextures();
+
+    m_IsCompiled = true;
+}
+
+IDeviceObject* RenderGraph::GetResourceObject(ResourceHandle Resource) const
+{
+    const auto& Res = m_Resources[Resource];
+    if (Res.pBuffer)
+        return Res.pBuffer.RawPtr<IBuffer>();
+    return GetTexture(Resource);
+}
+
+RESOURCE_STATE RenderGraph::GetResourceState(ResourceHandle Resource) const
+{
+    const auto& Res = m_Resources[Resource];
+    if (Res.pBuffer)
+        return Res.pBuffer.RawPtr<IBuffer>()->GetState();
+
+    auto* pTexture = GetTexture(Resource);
+    return pTexture != nullptr ? pTexture->GetState() : RESOURCE_STATE_UNKNOWN;
+}
+
+Uint64 RenderGraph::GetResourceContextMask(ResourceHandle Resource) const
+{
+    const auto& Res = m_Resources[Resource];
+    if (Res.pBuffer)
+        return Res.pBuffer.RawPtr<IBuffer>()->GetDesc().ImmediateContextMask;
+
+    auto* pTexture = GetTexture(Resource);
+    return pTexture != nullptr ? pTexture->GetDesc().ImmediateContextMask : ~Uint64{0};
+}
+
+Uint32 RenderGraph::TransitionPassResources(IDeviceContext* pContext, const PassInfo& Pass, RESOURCE_STATE CurrStateFilter)
+{
+    // Combine all states in which the pass accesses each resource
+    std::vector<std::pair<ResourceHandle, RESOURCE_STATE>> RequiredStates;
+    for (const auto& Access : Pass.Accesses)
+    {
+        auto it = std::find_if(RequiredStates.begin(), RequiredStates.end(),
+                               [&Access](const std::pair<ResourceHandle, RESOURCE_STATE>& Item) { return Item.first == Access.Resource; });
+        if (it != RequiredStates.end())
+            it->second |= Access.State;
+        else
+            RequiredStates.emplace_back(Access.Resource, Access.State);
+    }
+
+    m_Barriers.clear();
+    for (const auto& ResState : RequiredStates)
+    {
+        auto* pObject = GetResourceObject(ResState.first);
+        if (pObject == nullptr)
+            continue;
+
+        const auto CurrState = GetResourceState(ResState.first);
+        if (CurrState == RESOURCE_STATE_UNKNOWN)
+        {
+            LOG_ERROR_MESSAGE("The state of resource '", m_Resources[ResState.first].Name, "' used by render graph pass '", Pass.Name,
+                              "' is unknown to the engine and can't be transitioned");
+            continue;
+        }
+
+        if (CurrStateFilter != RESOURCE_STATE_UNKNOWN && (CurrState & CurrStateFilter) == 0)
+            continue;
+
+        // Unordered access requires a barrier between consecutive passes even if the state does not change
+        if (CurrState == ResState.second && ResState.second != RESOURCE_STATE_UNORDERED_ACCESS)
+            continue;
+
+        StateTransitionDesc Barrier;
+        Barrier.pResource = pObject;
+        Barrier.OldState  = RESOURCE_STATE_UNKNOWN;
+        Barrier.NewState  = ResState.second;
+        Barrier.Flags     = STATE_TRANSITION_FLAG_UPDATE_STATE;
+        m_Barriers.push_back(Barrier);
+    }
+
+    if (!m_Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    return static_cast<Uint32>(m_Barriers.size());
+}
+
+void RenderGraph::Execute(const RenderGraphExecuteAttribs& Attribs)
+{
+    DEV_CHECK_ERR(m_IsCompiled, "The graph must be compiled before it can be executed");
+    DEV_CHECK_ERR(Attribs.pContext != nullptr, "Graphics context must not be null");
+    if (!m_IsCompiled || Attribs.pContext == nullptr)
+        return;
+
+    const bool UseAsyncCompute = Attribs.pAsyncComputeContext != nullptr && Attribs.pAsyncComputeContext != Attribs.pContext;
+    if (UseAsyncCompute && !m_pFences[QUEUE_ID_GRAPHICS])
+    {
+        FenceDesc Desc;
+        Desc.Type = FENCE_TYPE_GENERAL;
+
+        Desc.Name = "Render graph graphics fence";
+        m_pDevice->CreateFence(Desc, &m_pFences[QUEUE_ID_GRAPHICS]);
+        Desc.Name = "Render graph compute fence";
+        m_pDevice->CreateFence(Desc, &m_pFences[QUEUE_ID_COMPUTE]);
+        DEV_CHECK_ERR(m_pFences[QUEUE_ID_GRAPHICS] && m_pFences[QUEUE_ID_COMPUTE], "Failed to create render graph fences");
+    }
+
+    IDeviceContext* const Contexts[QUEUE_ID_COUNT] = {
+        Attribs.pContext,
+        UseAsyncCompute ? Attribs.pAsyncComputeContext : Attribs.pContext,
+    };
+    const Uint64 ComputeContextMask = UseAsyncCompute ? Uint64{1} << Attribs.pAsyncComputeContext->GetDesc().ContextId : 0;
+
+    m_Stats = {};
+
+    // The number of passes recorded on each queue, and the number of passes
+    // covered by the last fence signal on that queue.
+    Uint32 NumRecorded[QUEUE_ID_COUNT]         = {};
+    Uint32 NumRecordedAtSignal[QUEUE_ID_COUNT] = {};
+    // The number of passes covered by every fence value signaled during this frame.
+    // Fence values are consecutive, so the value of the i-th signal is FirstSignalValue + i.
+    std::vector<Uint32> SignaledPasses[QUEUE_ID_COUNT];
+    const Uint64        FirstSignalValue[QUEUE_ID_COUNT] = {m_NextFenceValue[QUEUE_ID_GRAPHICS] + 1, m_NextFenceValue[QUEUE_ID_COMPUTE] + 1};
+    // The value of the other queue's fence that each queue has already waited for,
+    // and the number of the other queue's passes covered by that wait.
+    Uint64 WaitedValue[QUEUE_ID_COUNT]  = {};
+    Uint32 WaitedPasses[QUEUE_ID_COUNT] = {};
+
+    auto SignalQueue = [&](QUEUE_ID Queue) {
+        Contexts[Queue]->EnqueueSignal(m_pFences[Queue], ++m_NextFenceValue[Queue]);
+        // Without native fences, the value must be pending before another context can wait for it
+        Contexts[Queue]->Flush();
+        NumRecordedAtSignal[Queue] = NumRecorded[Queue];
+        SignaledPasses[Queue].push_back(NumRecorded[Queue]);
+        ++m_Stats.NumFenceSignals;
+    };
+
+    // Returns the earliest fence value that covers the pass at the given position in the queue
+    auto GetCoveringValue = [&](QUEUE_ID Queue, Uint32 Position) {
+        if (Position >= NumRecordedAtSignal[Queue])
+            SignalQueue(Queue);
+        const auto& Signaled = SignaledPasses[Queue];
+        const auto  it       = std::upper_bound(Signaled.begin(), Signaled.end(), Position);
+        VERIFY_EXPR(it != Signaled.end());
+        return FirstSignalValue[Queue] + static_cast<Uint64>(it - Signaled.begin());
+    };
+
+    struct ExecutedPassInfo
+    {
+        QUEUE_ID Queue;
+        // Position of the pass in its queue
+        Uint32 Position;
+        // The number of the other queue's passes that are guaranteed to complete before this pass starts
+        Uint32 WaitedPasses;
+    };
+    std::vector<ExecutedPassInfo> ExecutedPasses;
+    ExecutedPasses.reserve(m_ExecutionOrder.size());
+
+    std::vector<Uint32>   PositionInQueue(m_Passes.size(), InvalidHandle);
+    std::vector<QUEUE_ID> PassQueue(m_Passes.size(), QUEUE_ID_GRAPHICS);
+    for (auto p : m_ExecutionOrder)
+    {
+        const auto& Pass  = m_Passes[p];
+        auto        Queue = QUEUE_ID_GRAPHICS;
+        if (UseAsyncCompute && Pass.OnCompute)
+        {
+            const auto InaccessibleRes = std::find_if(Pass.Accesses.begin(), Pass.Accesses.end(),
+                                                      [&](const ResourceAccess& Access) { return (GetResourceContextMask(Access.Resource) & ComputeContextMask) == 0; });
+            if (InaccessibleRes == Pass.Accesses.end())
+            {
+                Queue = QUEUE_ID_COMPUTE;
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE_ONCE("Resource '", m_Resources[InaccessibleRes->Resource].Name, "' used by render graph pass '", Pass.Name,
+                                         "' is not accessible from the async compute context. The pass will be executed on the graphics context.");
+                ++m_Stats.NumDemotedComputePasses;
+            }
+        }
+        PassQueue[p] = Queue;
+
+        if (UseAsyncCompute)
+        {
+            const auto OtherQueue = Queue == QUEUE_ID_GRAPHICS ? QUEUE_ID_COMPUTE : QUEUE_ID_GRAPHICS;
+
+            Uint64 RequiredValue = 0;
+            if (Queue == QUEUE_ID_COMPUTE)
+            {
+                // Compute queues can't transition resources out of graphics-specific states,
+                // so hand them over on the graphics queue. The fence that covers the transitions
+                // also covers all graphics passes recorded so far.
+                const auto NumHandoffs = TransitionPassResources(Contexts[QUEUE_ID_GRAPHICS], Pass, GraphicsOnlyStates);
+                if (NumHandoffs > 0)
+                {
+                    SignalQueue(QUEUE_ID_GRAPHICS);
+                    RequiredValue = m_NextFenceValue[QUEUE_ID_GRAPHICS];
+                    m_Stats.NumQueueHandoffTransitions += NumHandoffs;
+                }
+            }
+
+            for (auto Dep : Pass.Dependencies)
+            {
+                if (m_Passes[Dep].IsCulled || PassQueue[Dep] == Queue)
+                    continue;
+
+                VERIFY_EXPR(PositionInQueue[Dep] != InvalidHandle);
+                // Dependencies covered by a previous wait do not require a new one
+                if (PositionInQueue[Dep] < WaitedPasses[Queue])
+                    continue;
+
+                RequiredValue = std::max(RequiredValue, GetCoveringValue(OtherQueue, PositionInQueue[Dep]));
+            }
+
+
+            if (RequiredValue > WaitedValue[Queue])
+            {
+                Contexts[Queue]->DeviceWaitForFence(m_pFences[OtherQueue], RequiredValue);
+                WaitedValue[Queue]  = RequiredValue;
+                WaitedPasses[Queue] = SignaledPasses[OtherQueue][static_cast<size_t>(RequiredValue - FirstSignalValue[OtherQueue])];
+                ++m_Stats.NumFenceWaits;
+            }
+        }
+
+        TransitionPassResources(Contexts[Queue], Pass);
+        if (Pass.Execute)
+            Pass.Execute(Contexts[Queue]);
+
+        PositionInQueue[p] = NumRecorded[Queue]++;
+        ExecutedPasses.push_back({Queue, PositionInQueue[p], WaitedPasses[Queue]});
+    }
+
+    m_Stats.NumGraphicsPasses     = NumRecorded[QUEUE_ID_GRAPHICS];
+    m_Stats.NumAsyncComputePasses = UseAsyncCompute ? NumRecorded[QUEUE_ID_COMPUTE] : 0;
+
+    // A compute pass and a graphics pass may overlap unless one of them waited
+    // for a fence value that covers the other one. Since waits are monotonic
+    // within a queue, transitive orderings are captured by the direct check.
+    if (m_Stats.NumAsyncComputePasses > 0)
+    {
+        std::vector<bool> GraphicsOverlaps(NumRecorded[QUEUE_ID_GRAPHICS]);
+        for (const auto& CompPass : ExecutedPasses)
+        {
+            if (CompPass.Queue != QUEUE_ID_COMPUTE)
+                continue;
+
+            bool Overlaps = false;
+            for (const auto& GfxPass : ExecutedPasses)
+            {
+                if (GfxPass.Queue != QUEUE_ID_GRAPHICS)
+                    continue;
+
+                if (GfxPass.Position >= CompPass.WaitedPasses && CompPass.Position >= GfxPass.WaitedPasses)
+                {
+                    Overlaps                           = true;
+                    GraphicsOverlaps[GfxPass.Position] = true;
+                }
+            }
+            if (Overlaps)
+                ++m_Stats.NumOverlappingComputePasses;
+        }
+        m_Stats.NumOverlappingGraphicsPasses = static_cast<Uint32>(std::count(GraphicsOverlaps.begin(), GraphicsOverlaps.end(), true));
+    }
+
+    // Make the graphics queue wait for all compute work so that the next frame
+    // may safely reuse transient resources.
+    if (UseAsyncCompute && NumRecorded[QUEUE_ID_COMPUTE] > WaitedPasses[QUEUE_ID_GRAPHICS])
+    {
+        Contexts[QUEUE_ID_GRAPHICS]->DeviceWaitForFence(m_pFences[QUEUE_ID_COMPUTE], GetCoveringValue(QUEUE_ID_COMPUTE, NumRecorded[QUEUE_ID_COMPUTE] - 1));
+        ++m_Stats.NumFenceWaits;
+    }
+}
+
+void RenderGraph::Reset()
+{
+    m_Resources.clear();
+    m_Passes.clear();
+    m_ExecutionOrder.clear();
+    m_TransientAllocator.Reset();
+    m_IsCompiled = false;
+}
+
+ITexture* RenderGraph::GetTexture(ResourceHandle Resource) const
+{
+    if (Resource >= m_Resources.size())
+    {
+        DEV_ERROR("Resource handle (", Resource, ") is out of range");
+        return nullptr;
+    }
+
+    const auto& Res = m_Resources[Resource];
+    if (Res.IsImported)
+        return Res.pTexture.RawPtr<ITexture>();
+
+    DEV_CHECK_ERR(m_IsCompiled, "Transient textures can only be queried after the graph has been compiled");
+    return Res.TransientHandle != InvalidHandle ? m_TransientAllocator.GetTexture(Res.TransientHandle) : nullptr;
+}
+
+IBuffer* RenderGraph::GetBuffer(ResourceHandle Resource) const
+{
+    if (Resource >= m_Resources.size())
+    {
+        DEV_ERROR("Resource handle (", Resource, ") is out of range");
+        return nullptr;
+    }
+    return m_Resources[Resource].pBuffer.RawPtr<IBuffer>();
+}
+
+bool RenderGraph::IsPassCulled(PassHandle Pass) const
+{
+    DEV_CHECK_ERR(m_IsCompiled, "The graph must be compiled before culling information can be queried");
+    return Pass < m_Passes.size() ? m_Passes[Pass].IsCulled : true;
+}
+
+} // namespace Diligent
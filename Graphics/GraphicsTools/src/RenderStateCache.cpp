@@ -29,10 +29,14 @@
 #include <array>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <unordered_set>
 #include <string>
+#include <cstring>
+#include <type_traits>
 
 #include "Archiver.h"
 #include "Dearchiver.h"
@@ -47,6 +51,9 @@
 #include "XXH128Hasher.hpp"
 #include "CallbackWrapper.hpp"
 #include "GraphicsUtilities.h"
+#include "DataBlobImpl.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -95,6 +102,146 @@ namespace Diligent
 
 class RenderStateCacheImpl;
 
+/// Thread-safe map of weak object references that is split into independently
+/// locked shards. Lookups only take a shared lock of a single shard, so that
+/// concurrent cache hits do not serialize on a single mutex.
+template <typename KeyType, typename ObjectType>
+class ShardedObjectMap
+{
+public:
+    /// Returns a strong reference to the object with the given key, or null
+    /// if there is no such object or it has been destroyed.
+    RefCntAutoPtr<ObjectType> Find(const KeyType& Key)
+    {
+        auto& Shard = GetShard(Key);
+
+        RefCntWeakPtr<ObjectType> pWeakObject;
+        {
+            std::shared_lock<std::shared_timed_mutex> Lock{Shard.Mtx, std::try_to_lock};
+            if (!Lock.owns_lock())
+            {
+                m_ContentionCount.fetch_add(1, std::memory_order_relaxed);
+                Lock.lock();
+            }
+
+            auto it = Shard.Map.find(Key);
+            if (it == Shard.Map.end())
+            {
+                m_MissCount.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+
+            // Note that RefCntWeakPtr::Lock() releases the expired pointer, so
+            // it must not be called on the shared map entry under the shared lock.
+            pWeakObject = it->second;
+        }
+
+        if (auto pObject = pWeakObject.Lock())
+        {
+            m_HitCount.fetch_add(1, std::memory_order_relaxed);
+            return pObject;
+        }
+
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+
+        // The object has been destroyed - remove the stale entry
+        {
+            auto Lock = LockExclusive(Shard);
+
+            auto it = Shard.Map.find(Key);
+            if (it != Shard.Map.end() && !it->second.IsValid())
+                Shard.Map.erase(it);
+        }
+
+        return {};
+    }
+
+    /// Adds the object to the map. If the map already contains an object with the same key
+    /// that is still alive, the existing object is kept.
+    void Add(const KeyType& Key, ObjectType* pObject)
+    {
+        auto& Shard = GetShard(Key);
+        auto  Lock  = LockExclusive(Shard);
+
+        auto it_inserted = Shard.Map.emplace(Key, RefCntWeakPtr<ObjectType>{pObject});
+        if (!it_inserted.second && !it_inserted.first->second.IsValid())
+            it_inserted.first->second = RefCntWeakPtr<ObjectType>{pObject};
+    }
+
+    /// Returns strong references to all live objects in the map.
+    std::vector<RefCntAutoPtr<ObjectType>> GetObjects()
+    {
+        std::vector<RefCntAutoPtr<ObjectType>> Objects;
+        for (auto& Shard : m_Shards)
+        {
+            auto Lock = LockExclusive(Shard);
+            for (auto it = Shard.Map.begin(); it != Shard.Map.end();)
+            {
+                if (auto pObject = it->second.Lock())
+                {
+                    Objects.emplace_back(std::move(pObject));
+                    ++it;
+                }
+                else
+                {
+                    it = Shard.Map.erase(it);
+                }
+            }
+        }
+        return Objects;
+    }
+
+    void Clear()
+    {
+        for (auto& Shard : m_Shards)
+        {
+            auto Lock = LockExclusive(Shard);
+            Shard.Map.clear();
+        }
+    }
+
+    Uint32 GetHitCount() const { return m_HitCount.load(std::memory_order_relaxed); }
+    Uint32 GetMissCount() const { return m_MissCount.load(std::memory_order_relaxed); }
+    Uint32 GetContentionCount() const { return m_ContentionCount.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr Uint32 ShardBits = 4;
+    static constexpr Uint32 NumShards = 1u << ShardBits;
+
+    struct MapShard
+    {
+        std::shared_timed_mutex                                Mtx;
+        std::unordered_map<KeyType, RefCntWeakPtr<ObjectType>> Map;
+    };
+
+    MapShard& GetShard(const KeyType& Key)
+    {
+        // Use Fibonacci hashing to pick the shard from the high bits of the mixed hash,
+        // so that shards are not correlated with the buckets of the per-shard maps and
+        // aligned pointer keys are distributed evenly.
+        const Uint64 Hash = static_cast<Uint64>(std::hash<KeyType>{}(Key)) * Uint64{0x9E3779B97F4A7C15ull};
+        return m_Shards[static_cast<size_t>(Hash >> (64u - ShardBits))];
+    }
+
+    std::unique_lock<std::shared_timed_mutex> LockExclusive(MapShard& Shard)
+    {
+        std::unique_lock<std::shared_timed_mutex> Lock{Shard.Mtx, std::try_to_lock};
+        if (!Lock.owns_lock())
+        {
+            m_ContentionCount.fetch_add(1, std::memory_order_relaxed);
+            Lock.lock();
+        }
+        return Lock;
+    }
+
+private:
+    std::array<MapShard, NumShards> m_Shards;
+
+    std::atomic<Uint32> m_HitCount{0};
+    std::atomic<Uint32> m_MissCount{0};
+    std::atomic<Uint32> m_ContentionCount{0};
+};
+
 
 /// Reloadable shader implements the IShader interface and delegates all
 /// calls to the internal shader object, which can be replaced at run-time.
@@ -110,7 +257,8 @@ public:
     ReloadableShader(IReferenceCounters*     pRefCounters,
                      RenderStateCacheImpl*   pStateCache,
                      IShader*                pShader,
-                     const ShaderCreateInfo& CreateInfo);
+                     const ShaderCreateInfo& CreateInfo,
+                     bool                    ReloadRequired);
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
     {
@@ -149,15 +297,17 @@ public:
     PROXY_CONST_METHOD(m_pShader, Uint32, GetResourceCount)
     PROXY_CONST_METHOD2(m_pShader, void, GetResourceDesc, Uint32, Index, ShaderResourceDesc&, ResourceDesc)
     PROXY_CONST_METHOD2(m_pShader, void, GetBytecode, const void**, ppBytecode, Uint64&, Size)
+    PROXY_METHOD1(m_pShader, SHADER_STATUS, GetStatus, bool, WaitForCompletion)
 
     static void Create(RenderStateCacheImpl*   pStateCache,
                        IShader*                pShader,
                        const ShaderCreateInfo& CreateInfo,
+                       bool                    ReloadRequired,
                        IShader**               ppReloadableShader)
     {
         try
         {
-            RefCntAutoPtr<ReloadableShader> pReloadableShader{MakeNewRCObj<ReloadableShader>()(pStateCache, pShader, CreateInfo)};
+            RefCntAutoPtr<ReloadableShader> pReloadableShader{MakeNewRCObj<ReloadableShader>()(pStateCache, pShader, CreateInfo, ReloadRequired)};
             *ppReloadableShader = pReloadableShader.Detach();
         }
         catch (...)
@@ -168,10 +318,23 @@ public:
 
     bool Reload();
 
+    // Returns true if the shader needs to be reloaded after the given source files have been modified.
+    bool DependsOnFiles(const std::unordered_set<std::string>& ModifiedFiles) const;
+
+private:
+    void UpdateSourceFiles();
+
 private:
     RefCntAutoPtr<RenderStateCacheImpl> m_pStateCache;
     RefCntAutoPtr<IShader>              m_pShader;
     ShaderCreateInfoWrapper             m_CreateInfo;
+
+    // Paths of all source files the shader was compiled from, including the main file
+    std::vector<std::string> m_SourceFiles;
+
+    // Set when the source files are not known, or when the shader was not compiled
+    // from the reload source and must be reloaded regardless of file modifications.
+    bool m_ReloadRequired = false;
 };
 
 constexpr INTERFACE_ID ReloadableShader::IID_InternalImpl;
@@ -232,6 +395,7 @@ public:
     PROXY_CONST_METHOD1(m_pPipeline, bool, IsCompatibleWith, const IPipelineState*, pPSO)
     PROXY_CONST_METHOD(m_pPipeline, Uint32, GetResourceSignatureCount)
     PROXY_CONST_METHOD1(m_pPipeline, IPipelineResourceSignature*, GetResourceSignature, Uint32, Index)
+    PROXY_METHOD1(m_pPipeline, PIPELINE_STATE_STATUS, GetStatus, bool, WaitForCompletion)
 
     static void Create(RenderStateCacheImpl*          pStateCache,
                        IPipelineState*                pPipeline,
@@ -249,11 +413,15 @@ public:
         }
     }
 
-    bool Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
+    bool Reload(const std::unordered_set<const IShader*>& ReloadedShaders,
+                ReloadGraphicsPipelineCallbackType        ReloadGraphicsPipeline,
+                void*                                     pUserData);
 
 private:
     template <typename CreateInfoType>
-    bool Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
+    bool Reload(const std::unordered_set<const IShader*>& ReloadedShaders,
+                ReloadGraphicsPipelineCallbackType        ReloadGraphicsPipeline,
+                void*                                     pUserData);
 
     struct DynamicHeapObjectBase
     {
@@ -285,6 +453,11 @@ public:
     RenderStateCacheImpl(IReferenceCounters*               pRefCounters,
                          const RenderStateCacheCreateInfo& CreateInfo);
 
+    ~RenderStateCacheImpl()
+    {
+        CancelPrefetch();
+    }
+
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderStateCache, TBase);
 
     virtual bool DILIGENT_CALL_TYPE Load(const IDataBlob* pArchive,
@@ -327,22 +500,9 @@ public:
     virtual Bool DILIGENT_CALL_TYPE WriteToBlob(IDataBlob** ppBlob) override final
     {
         // Load new render states from archiver to dearchiver
-
         RefCntAutoPtr<IDataBlob> pNewData;
-        m_pArchiver->SerializeToBlob(&pNewData);
-        if (!pNewData)
-        {
-            LOG_ERROR_MESSAGE("Failed to serialize render state data");
-            return false;
-        }
-
-        if (!m_pDearchiver->LoadArchive(pNewData))
-        {
-            LOG_ERROR_MESSAGE("Failed to add new render state data to existing archive");
+        if (!MoveNewStatesToDearchiver(pNewData))
             return false;
-        }
-
-        m_pArchiver->Reset();
 
         return m_pDearchiver->Store(ppBlob);
     }
@@ -360,14 +520,57 @@ public:
         return pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
     }
 
+    virtual Bool DILIGENT_CALL_TYPE AppendToJournal(IFileStream* pStream) override final;
+
+    virtual bool DILIGENT_CALL_TYPE LoadJournal(const IDataBlob* pJournal) override final
+    {
+        DEV_CHECK_ERR(pJournal != nullptr, "pJournal must not be null");
+        if (pJournal == nullptr)
+            return false;
+
+        return ParseJournal(pJournal, [this](IDataBlob* pRecord) {
+            return m_pDearchiver->LoadArchive(pRecord);
+        });
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE CompactJournal(const IDataBlob* pArchive,
+                                                   const IDataBlob* pJournal,
+                                                   IDataBlob**      ppArchive) const override final;
+
+    virtual Bool DILIGENT_CALL_TYPE WriteUsageLog(IDataBlob** ppLog, Bool ResetLog) override final;
+
+    virtual Uint32 DILIGENT_CALL_TYPE PrefetchPipelines(const IDataBlob* pUsageLog, IThreadPool* pThreadPool) override final;
+
     virtual void DILIGENT_CALL_TYPE Reset() override final
     {
+        // Prefetch tasks use the dearchiver, so they must be finished first
+        CancelPrefetch();
+        {
+            std::lock_guard<std::mutex> Lock{m_UsageLogMtx};
+            m_UsageLog.clear();
+            m_LoggedPipelines.clear();
+        }
         m_pDearchiver->Reset();
         m_pArchiver->Reset();
-        m_Shaders.clear();
-        m_ReloadableShaders.clear();
-        m_Pipelines.clear();
-        m_ReloadablePipelines.clear();
+        m_NumNewStates.store(0);
+        m_Shaders.Clear();
+        m_ReloadableShaders.Clear();
+        m_Pipelines.Clear();
+        m_ReloadablePipelines.Clear();
+    }
+
+    virtual void DILIGENT_CALL_TYPE GetStats(RenderStateCacheStats& Stats) const override final
+    {
+        Stats.ShaderHitCount      = m_Shaders.GetHitCount();
+        Stats.ShaderMissCount     = m_Shaders.GetMissCount();
+        Stats.PipelineHitCount    = m_Pipelines.GetHitCount();
+        Stats.PipelineMissCount   = m_Pipelines.GetMissCount();
+        Stats.PrefetchHitCount    = m_PrefetchHitCount.load(std::memory_order_relaxed);
+        Stats.PendingPrefetchCount = m_NumPendingPrefetches.load(std::memory_order_relaxed);
+        Stats.LockContentionCount = m_Shaders.GetContentionCount() +
+            m_ReloadableShaders.GetContentionCount() +
+            m_Pipelines.GetContentionCount() +
+            m_ReloadablePipelines.GetContentionCount();
     }
 
     virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData) override final;
@@ -381,20 +584,65 @@ public:
 
     RefCntAutoPtr<IShader> FindReloadableShader(IShader* pShader)
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
+        return m_ReloadableShaders.Find(pShader);
+    }
 
-        auto it = m_ReloadableShaders.find(pShader);
-        if (it == m_ReloadableShaders.end())
-            return {};
+    // Collects the paths of all source files of the shader, including the main file.
+    // Returns false if the files could not be processed.
+    bool GetShaderSourceFiles(const ShaderCreateInfo& ShaderCI, std::vector<std::string>& SourceFiles);
 
-        auto pReloadableShader = it->second.Lock();
-        if (!pReloadableShader)
-            m_ReloadableShaders.erase(it);
+private:
+    struct JournalRecordHeader
+    {
+        static constexpr Uint32 ExpectedMagic = 0x4C4E524A; // 'JRNL'
+
+        Uint32 Magic    = ExpectedMagic;
+        Uint32 Size     = 0;
+        Uint64 Checksum = 0;
+    };
+    static_assert(sizeof(JournalRecordHeader) == 16, "Journal record header must not contain padding");
 
-        return pReloadableShader;
+    static Uint64 ComputeJournalChecksum(const void* pData, size_t Size)
+    {
+        XXH128State Hasher;
+        Hasher.UpdateRaw(pData, Size);
+        return Hasher.Digest().LowPart;
+    }
+
+    // Calls the handler for every valid record in the journal.
+    // An incomplete or corrupted record terminates the journal, as it is
+    // most likely the result of the application being terminated while writing it.
+    template <typename HandlerType>
+    static bool ParseJournal(const IDataBlob* pJournal, HandlerType&& Handler);
+
+    // Serializes the states added to the archiver and loads them into the dearchiver.
+    // pNewData is null if there are no new states.
+    bool MoveNewStatesToDearchiver(RefCntAutoPtr<IDataBlob>& pNewData)
+    {
+        const auto NumNewStates = m_NumNewStates.exchange(0);
+        if (NumNewStates == 0)
+            return true;
+
+        m_pArchiver->SerializeToBlob(&pNewData);
+        if (!pNewData)
+        {
+            LOG_ERROR_MESSAGE("Failed to serialize render state data");
+            m_NumNewStates.fetch_add(NumNewStates);
+            return false;
+        }
+
+        if (!m_pDearchiver->LoadArchive(pNewData))
+        {
+            LOG_ERROR_MESSAGE("Failed to add new render state data to existing archive");
+            pNewData.Release();
+            m_NumNewStates.fetch_add(NumNewStates);
+            return false;
+        }
+
+        m_pArchiver->Reset();
+        return true;
     }
 
-private:
     static std::string HashToStr(Uint64 Low, Uint64 High)
     {
         static constexpr std::array<char, 16> Symbols = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
@@ -417,6 +665,20 @@ private:
         return HashStr;
     }
 
+    // Unpacks the pipeline with the given hash from the dearchiver and restores its original name.
+    RefCntAutoPtr<IPipelineState> UnpackPipeline(PIPELINE_TYPE PipelineType, const XXH128Hash& Hash, const char* Name);
+
+    // Adds the pipeline to the usage log if it is not there yet.
+    void LogPipelineUsage(PIPELINE_TYPE PipelineType, const XXH128Hash& Hash, const char* Name);
+
+    // Returns the prefetched pipeline with the given hash, or null if the pipeline
+    // has not been prefetched or failed to unpack.
+    RefCntAutoPtr<IPipelineState> TakePrefetchedPipeline(const XXH128Hash& Hash);
+
+    // Removes pending prefetch tasks from the queue, waits for the running tasks
+    // and releases all prefetched pipelines.
+    void CancelPrefetch();
+
     template <typename CreateInfoType>
     struct SerializedPsoCIWrapperBase;
 
@@ -436,17 +698,52 @@ private:
     RefCntAutoPtr<IArchiver>                       m_pArchiver;
     RefCntAutoPtr<IDearchiver>                     m_pDearchiver;
 
-    std::mutex                                             m_ShadersMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IShader>> m_Shaders;
+    ShardedObjectMap<XXH128Hash, IShader>             m_Shaders;
+    ShardedObjectMap<IShader*, IShader>               m_ReloadableShaders;
+    ShardedObjectMap<XXH128Hash, IPipelineState>      m_Pipelines;
+    ShardedObjectMap<IPipelineState*, IPipelineState> m_ReloadablePipelines;
 
-    std::mutex                                           m_ReloadableShadersMtx;
-    std::unordered_map<IShader*, RefCntWeakPtr<IShader>> m_ReloadableShaders;
+    // Shader source files read when computing shader hashes
+    ShaderIncludeCache m_IncludeCache;
 
-    std::mutex                                                    m_PipelinesMtx;
-    std::unordered_map<XXH128Hash, RefCntWeakPtr<IPipelineState>> m_Pipelines;
+    // The number of states added to the archiver since the last time it was serialized
+    std::atomic<Uint32> m_NumNewStates{0};
 
-    std::mutex                                                         m_ReloadablePipelinesMtx;
-    std::unordered_map<IPipelineState*, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
+    struct UsageLogEntry
+    {
+        PIPELINE_TYPE PipelineType = PIPELINE_TYPE_INVALID;
+        XXH128Hash    Hash;
+        std::string   Name;
+    };
+    struct UsageLogHeader
+    {
+        static constexpr Uint32 ExpectedMagic   = 0x4C535550; // 'PUSL'
+        static constexpr Uint32 ExpectedVersion = 1;
+
+        Uint32 Magic      = ExpectedMagic;
+        Uint32 Version    = ExpectedVersion;
+        Uint32 NumEntries = 0;
+        Uint32 Padding    = 0;
+    };
+    static_assert(sizeof(UsageLogHeader) == 16, "Usage log header must not contain padding");
+
+    // Pipelines in the order of their first request
+    std::mutex                     m_UsageLogMtx;
+    std::vector<UsageLogEntry>     m_UsageLog;
+    std::unordered_set<XXH128Hash> m_LoggedPipelines;
+
+    struct PrefetchedPipeline
+    {
+        RefCntAutoPtr<IThreadPool>    pThreadPool;
+        RefCntAutoPtr<IAsyncTask>     pTask;
+        RefCntAutoPtr<IPipelineState> pPSO;
+        bool                          IsUnpacked = false;
+    };
+    std::mutex                                         m_PrefetchMtx;
+    std::unordered_map<XXH128Hash, PrefetchedPipeline> m_PrefetchedPipelines;
+
+    std::atomic<Uint32> m_NumPendingPrefetches{0};
+    std::atomic<Uint32> m_PrefetchHitCount{0};
 };
 
 RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRefCounters,
@@ -529,6 +826,114 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
         }                                                          \
     } while (false)
 
+constexpr Uint32 RenderStateCacheImpl::JournalRecordHeader::ExpectedMagic;
+constexpr Uint32 RenderStateCacheImpl::UsageLogHeader::ExpectedMagic;
+constexpr Uint32 RenderStateCacheImpl::UsageLogHeader::ExpectedVersion;
+
+Bool RenderStateCacheImpl::AppendToJournal(IFileStream* pStream)
+{
+    DEV_CHECK_ERR(pStream != nullptr, "pStream must not be null");
+    if (pStream == nullptr)
+        return false;
+
+    RefCntAutoPtr<IDataBlob> pNewData;
+    if (!MoveNewStatesToDearchiver(pNewData))
+        return false;
+
+    if (!pNewData)
+        return true;
+
+    JournalRecordHeader Header;
+    Header.Size     = StaticCast<Uint32>(pNewData->GetSize());
+    Header.Checksum = ComputeJournalChecksum(pNewData->GetConstDataPtr(), pNewData->GetSize());
+    if (!pStream->Write(&Header, sizeof(Header)) || !pStream->Write(pNewData->GetConstDataPtr(), pNewData->GetSize()))
+    {
+        LOG_ERROR_MESSAGE("Failed to write render state cache journal record");
+        return false;
+    }
+
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Appended ", Header.Size, " bytes to the journal.");
+    return true;
+}
+
+
+template <typename HandlerType>
+bool RenderStateCacheImpl::ParseJournal(const IDataBlob* pJournal, HandlerType&& Handler)
+{
+    const auto* pData = static_cast<const Uint8*>(pJournal->GetConstDataPtr());
+    const auto  Size  = pJournal->GetSize();
+
+    size_t Offset = 0;
+    while (Offset < Size)
+    {
+        JournalRecordHeader Header;
+        if (Size - Offset < sizeof(Header))
+        {
+            LOG_WARNING_MESSAGE("Render state cache journal ends with an incomplete record header. The remaining ", Size - Offset, " bytes are ignored.");
+            break;
+        }
+        std::memcpy(&Header, pData + Offset, sizeof(Header));
+        Offset += sizeof(Header);
+
+        if (Header.Magic != JournalRecordHeader::ExpectedMagic)
+        {
+            LOG_ERROR_MESSAGE("Render state cache journal is corrupted");
+            return false;
+        }
+
+        if (Size - Offset < Header.Size || ComputeJournalChecksum(pData + Offset, Header.Size) != Header.Checksum)
+        {
+            LOG_WARNING_MESSAGE("Render state cache journal ends with an incomplete or corrupted record. The remaining ", Size - Offset, " bytes are ignored.");
+            break;
+        }
+
+        auto pRecord = DataBlobImpl::Create(Header.Size, pData + Offset);
+        Offset += Header.Size;
+
+        if (!Handler(pRecord.RawPtr<IDataBlob>()))
+        {
+            LOG_ERROR_MESSAGE("Failed to load render state cache journal record");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Bool RenderStateCacheImpl::CompactJournal(const IDataBlob* pArchive,
+                                          const IDataBlob* pJournal,
+                                          IDataBlob**      ppArchive) const
+{
+    DEV_CHECK_ERR(ppArchive != nullptr, "ppArchive must not be null");
+    if (ppArchive == nullptr)
+        return false;
+
+    // Use a separate dearchiver so that compaction does not interfere with the cache state
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    m_pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCreateInfo{}, &pDearchiver);
+    if (!pDearchiver)
+    {
+        LOG_ERROR_MESSAGE("Failed to create dearchiver");
+        return false;
+    }
+
+    if (pArchive != nullptr && !pDearchiver->LoadArchive(pArchive))
+    {
+        LOG_ERROR_MESSAGE("Failed to load render state cache archive");
+        return false;
+    }
+
+    if (pJournal != nullptr)
+    {
+        if (!ParseJournal(pJournal, [&pDearchiver](IDataBlob* pRecord) {
+                return pDearchiver->LoadArchive(pRecord);
+            }))
+            return false;
+    }
+
+    return pDearchiver->Store(ppArchive);
+}
+
 bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
                                         IShader**               ppShader)
 {
@@ -550,28 +955,19 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
     if (m_CI.EnableHotReload)
     {
         // Wrap shader in a reloadable shader object
-        {
-            std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-
-            auto it = m_ReloadableShaders.find(pShader);
-            if (it != m_ReloadableShaders.end())
-            {
-                if (auto pReloadableShader = it->second.Lock())
-                    *ppShader = pReloadableShader.Detach();
-                else
-                    m_ReloadableShaders.erase(it);
-            }
-        }
+        if (auto pReloadableShader = m_ReloadableShaders.Find(pShader))
+            *ppShader = pReloadableShader.Detach();
 
         if (*ppShader == nullptr)
         {
             auto _ShaderCI = ShaderCI;
             if (m_pReloadSource)
                 _ShaderCI.pShaderSourceStreamFactory = m_pReloadSource;
-            ReloadableShader::Create(this, pShader, _ShaderCI, ppShader);
-
-            std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-            m_ReloadableShaders.emplace(pShader, RefCntWeakPtr<IShader>{*ppShader});
+            // If the reload source is different from the original one, the files may differ even
+            // if they are never modified, so the shader must be reloaded the first time.
+            const bool ReloadRequired = _ShaderCI.pShaderSourceStreamFactory != ShaderCI.pShaderSourceStreamFactory;
+            ReloadableShader::Create(this, pShader, _ShaderCI, ReloadRequired, ppShader);
+            m_ReloadableShaders.Add(pShader, *ppShader);
         }
     }
     else
@@ -593,27 +989,16 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
 #else
     constexpr bool IsDebug = false;
 #endif
-    Hasher.Update(ShaderCI, m_DeviceType, IsDebug);
+    Hasher.Update(ShaderCI, m_IncludeCache);
+    Hasher.Update(m_DeviceType, IsDebug);
     const auto Hash = Hasher.Digest();
 
     // First, try to check if the shader has already been requested
+    if (auto pShader = m_Shaders.Find(Hash))
     {
-        std::lock_guard<std::mutex> Guard{m_ShadersMtx};
-
-        auto it = m_Shaders.find(Hash);
-        if (it != m_Shaders.end())
-        {
-            if (auto pShader = it->second.Lock())
-            {
-                *ppShader = pShader.Detach();
-                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing shader '", (ShaderCI.Desc.Name ? ShaderCI.Desc.Name : ""), "'.");
-                return true;
-            }
-            else
-            {
-                m_Shaders.erase(it);
-            }
-        }
+        *ppShader = pShader.Detach();
+        RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing shader '", (ShaderCI.Desc.Name ? ShaderCI.Desc.Name : ""), "'.");
+        return true;
     }
 
     class AddShaderHelper
@@ -629,10 +1014,7 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         ~AddShaderHelper()
         {
             if (*m_ppShader != nullptr)
-            {
-                std::lock_guard<std::mutex> Guard{m_Cache.m_ShadersMtx};
-                m_Cache.m_Shaders.emplace(m_Hash, *m_ppShader);
-            }
+                m_Cache.m_Shaders.Add(m_Hash, *m_ppShader);
         }
 
     private:
@@ -688,7 +1070,10 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         if (pArchivedShader)
         {
             if (m_pArchiver->AddShader(pArchivedShader))
+            {
+                m_NumNewStates.fetch_add(1);
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added shader '", HashStr, "'.");
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive shader '", HashStr, "'.");
         }
@@ -988,25 +1373,13 @@ bool RenderStateCacheImpl::CreatePipelineState(const CreateInfoType& PSOCreateIn
 
     if (m_CI.EnableHotReload)
     {
-        {
-            std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-
-            auto it = m_ReloadablePipelines.find(pPSO);
-            if (it != m_ReloadablePipelines.end())
-            {
-                if (auto pReloadablePSO = it->second.Lock())
-                    *ppPipelineState = pReloadablePSO.Detach();
-                else
-                    m_ReloadablePipelines.erase(it);
-            }
-        }
+        if (auto pReloadablePSO = m_ReloadablePipelines.Find(pPSO))
+            *ppPipelineState = pReloadablePSO.Detach();
 
         if (*ppPipelineState == nullptr)
         {
             ReloadablePipelineState::Create(this, pPSO, PSOCreateInfo, ppPipelineState);
-
-            std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-            m_ReloadablePipelines.emplace(pPSO, RefCntWeakPtr<IPipelineState>(*ppPipelineState));
+            m_ReloadablePipelines.Add(pPSO, *ppPipelineState);
         }
     }
     else
@@ -1027,44 +1400,28 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     Hasher.Update(PSOCreateInfo, m_DeviceType);
     const auto Hash = Hasher.Digest();
 
+    if (m_CI.EnableUsageLog)
+        LogPipelineUsage(PSOCreateInfo.PSODesc.PipelineType, Hash, PSOCreateInfo.PSODesc.Name);
+
     // First, try to check if the PSO has already been requested
+    if (auto pPSO = m_Pipelines.Find(Hash))
     {
-        std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
-
-        auto it = m_Pipelines.find(Hash);
-        if (it != m_Pipelines.end())
-        {
-            if (auto pPSO = it->second.Lock())
-            {
-                *ppPipelineState = pPSO.Detach();
-                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
-                return true;
-            }
-            else
-            {
-                m_Pipelines.erase(it);
-            }
-        }
+        *ppPipelineState = pPSO.Detach();
+        RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
+        return true;
     }
 
     const auto HashStr = MakeHashStr(PSOCreateInfo.PSODesc.Name, Hash);
 
     bool FoundInCache = false;
-    // Try to find PSO in the loaded archive
+    // Try to find PSO among the prefetched pipelines or in the loaded archive
     {
-        auto Callback = MakeCallback(
-            [&PSOCreateInfo](PipelineStateCreateInfo& CI) {
-                CI.PSODesc.Name = PSOCreateInfo.PSODesc.Name;
-            });
+        auto pPSO = TakePrefetchedPipeline(Hash);
+        if (pPSO)
+            m_PrefetchHitCount.fetch_add(1, std::memory_order_relaxed);
+        else
+            pPSO = UnpackPipeline(PSOCreateInfo.PSODesc.PipelineType, Hash, PSOCreateInfo.PSODesc.Name);
 
-        PipelineStateUnpackInfo UnpackInfo;
-        UnpackInfo.PipelineType                  = PSOCreateInfo.PSODesc.PipelineType;
-        UnpackInfo.Name                          = HashStr.c_str();
-        UnpackInfo.pDevice                       = m_pDevice;
-        UnpackInfo.ModifyPipelineStateCreateInfo = Callback;
-        UnpackInfo.pUserData                     = Callback;
-        RefCntAutoPtr<IPipelineState> pPSO;
-        m_pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
         if (pPSO)
         {
             if (pPSO->GetDesc() == PSOCreateInfo.PSODesc)
@@ -1088,10 +1445,7 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
             return false;
     }
 
-    {
-        std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
-        m_Pipelines.emplace(Hash, *ppPipelineState);
-    }
+    m_Pipelines.Add(Hash, *ppPipelineState);
 
     if (FoundInCache)
     {
@@ -1116,7 +1470,10 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
         if (pSerializedPSO)
         {
             if (m_pArchiver->AddPipelineState(pSerializedPSO))
+            {
+                m_NumNewStates.fetch_add(1);
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added pipeline '", HashStr, "'.");
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive PSO '", HashStr, "'.");
         }
@@ -1128,6 +1485,288 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     return false;
 }
 
+RefCntAutoPtr<IPipelineState> RenderStateCacheImpl::UnpackPipeline(PIPELINE_TYPE PipelineType, const XXH128Hash& Hash, const char* Name)
+{
+    const auto HashStr = MakeHashStr(Name, Hash);
+
+    auto Callback = MakeCallback(
+        [Name](PipelineStateCreateInfo& CI) {
+            CI.PSODesc.Name = Name;
+        });
+
+    PipelineStateUnpackInfo UnpackInfo;
+    UnpackInfo.PipelineType                  = PipelineType;
+    UnpackInfo.Name                          = HashStr.c_str();
+    UnpackInfo.pDevice                       = m_pDevice;
+    UnpackInfo.ModifyPipelineStateCreateInfo = Callback;
+    UnpackInfo.pUserData                     = Callback;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    m_pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+    return pPSO;
+}
+
+void RenderStateCacheImpl::LogPipelineUsage(PIPELINE_TYPE PipelineType, const XXH128Hash& Hash, const char* Name)
+{
+    std::lock_guard<std::mutex> Lock{m_UsageLogMtx};
+    if (!m_LoggedPipelines.insert(Hash).second)
+        return;
+
+    UsageLogEntry Entry;
+    Entry.PipelineType = PipelineType;
+    Entry.Hash         = Hash;
+    Entry.Name         = Name != nullptr ? Name : "";
+    m_UsageLog.emplace_back(std::move(Entry));
+}
+
+Bool RenderStateCacheImpl::WriteUsageLog(IDataBlob** ppLog, Bool ResetLog)
+{
+    DEV_CHECK_ERR(ppLog != nullptr, "ppLog must not be null");
+    if (ppLog == nullptr)
+        return false;
+    DEV_CHECK_ERR(*ppLog == nullptr, "Overwriting reference to existing data blob may cause memory leaks");
+
+    if (!m_CI.EnableUsageLog)
+    {
+        DEV_ERROR("This render state cache was not created with usage log enabled. Set EnableUsageLog to true.");
+        return false;
+    }
+
+    std::vector<UsageLogEntry> UsageLog;
+    {
+        std::lock_guard<std::mutex> Lock{m_UsageLogMtx};
+        if (ResetLog)
+        {
+            UsageLog.swap(m_UsageLog);
+            m_LoggedPipelines.clear();
+        }
+        else
+        {
+            UsageLog = m_UsageLog;
+        }
+    }
+
+    // Entry layout: hash (16 bytes), pipeline type (4 bytes), name length (4 bytes), name
+    constexpr size_t EntryHeaderSize = sizeof(Uint64) * 2 + sizeof(Uint32) * 2;
+
+    size_t Size = sizeof(UsageLogHeader);
+    for (const auto& Entry : UsageLog)
+        Size += EntryHeaderSize + Entry.Name.length();
+
+    auto  pLog  = DataBlobImpl::Create(Size);
+    auto* pDst  = static_cast<Uint8*>(pLog->GetDataPtr());
+    auto  Write = [&pDst](const void* pData, size_t DataSize) {
+        if (DataSize > 0)
+            std::memcpy(pDst, pData, DataSize);
+        pDst += DataSize;
+    };
+
+    UsageLogHeader Header;
+    Header.NumEntries = StaticCast<Uint32>(UsageLog.size());
+    Write(&Header, sizeof(Header));
+    for (const auto& Entry : UsageLog)
+    {
+        const Uint32 PipelineType = Entry.PipelineType;
+        const Uint32 NameLength   = StaticCast<Uint32>(Entry.Name.length());
+        Write(&Entry.Hash.LowPart, sizeof(Entry.Hash.LowPart));
+        Write(&Entry.Hash.HighPart, sizeof(Entry.Hash.HighPart));
+        Write(&PipelineType, sizeof(PipelineType));
+        Write(&NameLength, sizeof(NameLength));
+        Write(Entry.Name.data(), NameLength);
+    }
+    VERIFY_EXPR(pDst == static_cast<Uint8*>(pLog->GetDataPtr()) + Size);
+
+    *ppLog = pLog.Detach();
+    return true;
+}
+
+Uint32 RenderStateCacheImpl::PrefetchPipelines(const IDataBlob* pUsageLog, IThreadPool* pThreadPool)
+{
+    DEV_CHECK_ERR(pUsageLog != nullptr, "pUsageLog must not be null");
+    if (pUsageLog == nullptr)
+        return 0;
+
+    const auto* pSrc    = static_cast<const Uint8*>(pUsageLog->GetConstDataPtr());
+    const auto* pSrcEnd = pSrc + pUsageLog->GetSize();
+    auto        Read    = [&pSrc, pSrcEnd](void* pData, size_t DataSize) {
+        if (static_cast<size_t>(pSrcEnd - pSrc) < DataSize)
+            return false;
+        if (DataSize > 0)
+            std::memcpy(pData, pSrc, DataSize);
+        pSrc += DataSize;
+        return true;
+    };
+
+    UsageLogHeader Header;
+    if (!Read(&Header, sizeof(Header)) || Header.Magic != UsageLogHeader::ExpectedMagic)
+    {
+        LOG_ERROR_MESSAGE("Pipeline usage log is corrupted");
+        return 0;
+    }
+    if (Header.Version != UsageLogHeader::ExpectedVersion)
+    {
+        LOG_ERROR_MESSAGE("Pipeline usage log version ", Header.Version, " is not supported. Expected version: ", Uint32{UsageLogHeader::ExpectedVersion}, '.');
+        return 0;
+    }
+
+    std::vector<UsageLogEntry> UsageLog;
+    UsageLog.reserve(Header.NumEntries);
+    for (Uint32 i = 0; i < Header.NumEntries; ++i)
+    {
+        UsageLogEntry Entry;
+        Uint32        PipelineType = 0;
+        Uint32        NameLength   = 0;
+        if (!Read(&Entry.Hash.LowPart, sizeof(Entry.Hash.LowPart)) ||
+            !Read(&Entry.Hash.HighPart, sizeof(Entry.Hash.HighPart)) ||
+            !Read(&PipelineType, sizeof(PipelineType)) ||
+            !Read(&NameLength, sizeof(NameLength)) ||
+            static_cast<size_t>(pSrcEnd - pSrc) < NameLength)
+        {
+            LOG_ERROR_MESSAGE("Pipeline usage log is corrupted");
+            return 0;
+        }
+        Entry.PipelineType = static_cast<PIPELINE_TYPE>(PipelineType);
+        Entry.Name.assign(reinterpret_cast<const char*>(pSrc), NameLength);
+        pSrc += NameLength;
+        UsageLog.emplace_back(std::move(Entry));
+    }
+
+    Uint32 NumScheduled = 0;
+    for (size_t i = 0; i < UsageLog.size(); ++i)
+    {
+        const auto Hash = UsageLog[i].Hash;
+
+        auto Unpack = [this, Entry = std::move(UsageLog[i])](Uint32 ThreadId) {
+            auto pPSO = UnpackPipeline(Entry.PipelineType, Entry.Hash, Entry.Name.c_str());
+            if (!pPSO)
+                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Pipeline '", MakeHashStr(Entry.Name.c_str(), Entry.Hash), "' from the usage log is not found in the archive.");
+
+            std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+
+            auto it = m_PrefetchedPipelines.find(Entry.Hash);
+            if (it != m_PrefetchedPipelines.end() && !it->second.IsUnpacked)
+            {
+                it->second.pPSO       = std::move(pPSO);
+                it->second.IsUnpacked = true;
+                m_NumPendingPrefetches.fetch_sub(1);
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+
+            auto it_inserted = m_PrefetchedPipelines.emplace(Hash, PrefetchedPipeline{});
+            if (!it_inserted.second)
+                continue;
+            m_NumPendingPrefetches.fetch_add(1);
+
+            if (pThreadPool != nullptr)
+            {
+                // The task is enqueued under the lock so that it is always tracked by the entry.
+                // Pipelines that were requested first get the highest priority.
+                auto& Prefetched       = it_inserted.first->second;
+                Prefetched.pThreadPool = pThreadPool;
+                Prefetched.pTask       = EnqueueAsyncWork(pThreadPool, std::move(Unpack), static_cast<float>(UsageLog.size() - i));
+            }
+        }
+
+        if (pThreadPool == nullptr)
+            Unpack(0);
+
+        ++NumScheduled;
+    }
+
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Scheduled ", NumScheduled, " pipelines for prefetching.");
+    return NumScheduled;
+}
+
+RefCntAutoPtr<IPipelineState> RenderStateCacheImpl::TakePrefetchedPipeline(const XXH128Hash& Hash)
+{
+    RefCntAutoPtr<IAsyncTask> pRunningTask;
+    {
+        std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+
+        auto it = m_PrefetchedPipelines.find(Hash);
+        if (it == m_PrefetchedPipelines.end())
+            return {};
+
+        auto& Prefetched = it->second;
+        if (!Prefetched.IsUnpacked && Prefetched.pTask)
+        {
+            // If the task has not started yet, the pipeline will be created by the calling
+            // thread, which is faster than waiting for the tasks ahead of it in the queue.
+            if (Prefetched.pThreadPool->RemoveTask(Prefetched.pTask, /*CancelIfRunning = */ false) &&
+                Prefetched.pTask->GetStatus() != ASYNC_TASK_STATUS_COMPLETE)
+            {
+                m_NumPendingPrefetches.fetch_sub(1);
+                m_PrefetchedPipelines.erase(it);
+                return {};
+            }
+            pRunningTask = Prefetched.pTask;
+        }
+        else
+        {
+            if (!Prefetched.IsUnpacked)
+                m_NumPendingPrefetches.fetch_sub(1);
+            auto pPSO = std::move(Prefetched.pPSO);
+            m_PrefetchedPipelines.erase(it);
+            return pPSO;
+        }
+    }
+
+    // The task is running - wait for it to finish
+    pRunningTask->WaitForCompletion();
+
+    std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+
+    auto it = m_PrefetchedPipelines.find(Hash);
+    if (it == m_PrefetchedPipelines.end())
+        return {};
+
+    auto pPSO = std::move(it->second.pPSO);
+    m_PrefetchedPipelines.erase(it);
+    return pPSO;
+}
+
+void RenderStateCacheImpl::CancelPrefetch()
+{
+    std::vector<std::pair<RefCntAutoPtr<IThreadPool>, RefCntAutoPtr<IAsyncTask>>> Tasks;
+    {
+        std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+        for (auto& it : m_PrefetchedPipelines)
+        {
+            if (it.second.pTask)
+                Tasks.emplace_back(std::move(it.second.pThreadPool), std::move(it.second.pTask));
+        }
+    }
+
+    // Tasks reference the cache and must be finished before the cache is reset or destroyed
+    for (auto& Task : Tasks)
+    {
+        if (!Task.first->RemoveTask(Task.second, /*CancelIfRunning = */ false))
+            Task.second->WaitForCompletion();
+    }
+
+    std::lock_guard<std::mutex> Lock{m_PrefetchMtx};
+    m_PrefetchedPipelines.clear();
+    m_NumPendingPrefetches.store(0);
+}
+
+bool RenderStateCacheImpl::GetShaderSourceFiles(const ShaderCreateInfo& ShaderCI, std::vector<std::string>& SourceFiles)
+{
+    SourceFiles.clear();
+    if (ShaderCI.ByteCode != nullptr)
+        return true;
+
+    return ProcessShaderIncludes(
+        ShaderCI,
+        [&SourceFiles](const ShaderIncludePreprocessInfo& FileInfo) {
+            // The path is empty for the source provided in the create info
+            if (!FileInfo.FilePath.empty())
+                SourceFiles.emplace_back(FileInfo.FilePath);
+        },
+        &m_IncludeCache);
+}
+
 Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
 {
     if (!m_CI.EnableHotReload)
@@ -1136,49 +1775,45 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
         return 0;
     }
 
+    // Only the shaders that depend on the modified source files need to be reloaded
+    const auto ModifiedFiles = m_IncludeCache.RemoveModifiedFiles();
+
     Uint32 NumStatesReloaded = 0;
 
-    // Reload all shaders first
+    // Reload shaders first
+    std::unordered_set<const IShader*> ReloadedShaders;
+    for (auto& pShader : m_ReloadableShaders.GetObjects())
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
-        for (auto shader_it : m_ReloadableShaders)
+        RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
+        if (pReloadableShader)
         {
-            if (auto pShader = shader_it.second.Lock())
-            {
-                RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
-                if (pReloadableShader)
-                {
-                    if (pReloadableShader->Reload())
-                        ++NumStatesReloaded;
-                }
-                else
-                {
-                    UNEXPECTED("Shader object is not a ReloadableShader");
-                }
-            }
+            if (!pReloadableShader->DependsOnFiles(ModifiedFiles))
+                continue;
+
+            if (pReloadableShader->Reload())
+                ++NumStatesReloaded;
+            ReloadedShaders.emplace(pShader);
+        }
+        else
+        {
+            UNEXPECTED("Shader object is not a ReloadableShader");
         }
     }
 
-    // Reload pipelines.
+    // Reload pipelines that use reloaded shaders.
     // Note that create info structs reference reloadable shaders, so that when pipelines
     // are re-created, they will automatically use reloaded shaders.
+    for (auto& pPSO : m_ReloadablePipelines.GetObjects())
     {
-        std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
-        for (auto pso_it : m_ReloadablePipelines)
+        RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
+        if (pReloadablePSO)
         {
-            if (auto pPSO = pso_it.second.Lock())
-            {
-                RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
-                if (pPSO)
-                {
-                    if (pReloadablePSO->Reload(ReloadGraphicsPipeline, pUserData))
-                        ++NumStatesReloaded;
-                }
-                else
-                {
-                    UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
-                }
-            }
+            if (pReloadablePSO->Reload(ReloadedShaders, ReloadGraphicsPipeline, pUserData))
+                ++NumStatesReloaded;
+        }
+        else
+        {
+            UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
         }
     }
 
@@ -1252,6 +1887,17 @@ struct ReloadablePipelineState::CreateInfoWrapperBase : DynamicHeapObjectBase
         }
 
         m_Objects.emplace_back(pShader);
+        m_Shaders.emplace_back(pShader);
+    }
+
+    bool UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const
+    {
+        for (const auto* pShader : m_Shaders)
+        {
+            if (Shaders.find(pShader) != Shaders.end())
+                return true;
+        }
+        return false;
     }
 
 protected:
@@ -1262,6 +1908,7 @@ protected:
     std::vector<ImmutableSamplerDesc>        m_ImtblSamplers;
     std::vector<IPipelineResourceSignature*> m_ppSignatures;
     std::vector<RefCntAutoPtr<IObject>>      m_Objects;
+    std::vector<const IShader*>              m_Shaders;
 };
 
 template <>
@@ -1335,12 +1982,35 @@ private:
 ReloadableShader::ReloadableShader(IReferenceCounters*     pRefCounters,
                                    RenderStateCacheImpl*   pStateCache,
                                    IShader*                pShader,
-                                   const ShaderCreateInfo& CreateInfo) :
+                                   const ShaderCreateInfo& CreateInfo,
+                                   bool                    ReloadRequired) :
     TBase{pRefCounters},
     m_pStateCache{pStateCache},
     m_pShader{pShader},
-    m_CreateInfo{CreateInfo, GetRawAllocator()}
+    m_CreateInfo{CreateInfo, GetRawAllocator()},
+    m_ReloadRequired{ReloadRequired}
 {
+    if (!m_ReloadRequired)
+        UpdateSourceFiles();
+}
+
+void ReloadableShader::UpdateSourceFiles()
+{
+    // Source files are loaded through the include cache, so that their modifications are detected by the next reload
+    m_ReloadRequired = !m_pStateCache->GetShaderSourceFiles(m_CreateInfo, m_SourceFiles);
+}
+
+bool ReloadableShader::DependsOnFiles(const std::unordered_set<std::string>& ModifiedFiles) const
+{
+    if (m_ReloadRequired)
+        return true;
+
+    for (const auto& File : m_SourceFiles)
+    {
+        if (ModifiedFiles.find(File) != ModifiedFiles.end())
+            return true;
+    }
+    return false;
 }
 
 bool ReloadableShader::Reload()
@@ -1356,6 +2026,8 @@ bool ReloadableShader::Reload()
         const auto* Name = m_CreateInfo.Get().Desc.Name;
         LOG_ERROR_MESSAGE("Failed to reload shader '", (Name ? Name : "<unnamed>"), "'.");
     }
+    // Includes may have changed
+    UpdateSourceFiles();
     return !FoundInCache;
 }
 
@@ -1369,7 +2041,7 @@ ReloadablePipelineState::ReloadablePipelineState(IReferenceCounters*
     m_pPipeline{pPipeline},
     m_Type{CreateInfo.PSODesc.PipelineType}
 {
-    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
+    static_assert(PIPELINE_TYPE_COUNT == 6, "Did you add a new pipeline type? You may need to handle it here.");
     switch (CreateInfo.PSODesc.PipelineType)
     {
         case PIPELINE_TYPE_GRAPHICS:
@@ -1389,6 +2061,10 @@ ReloadablePipelineState::ReloadablePipelineState(IReferenceCounters*
             m_pCreateInfo = std::make_unique<CreateInfoWrapper<TilePipelineStateCreateInfo>>(static_cast<const TilePipelineStateCreateInfo&>(CreateInfo));
             break;
 
+        case PIPELINE_TYPE_WORK_GRAPH:
+            UNSUPPORTED("Work graph pipelines are not supported by the render state cache");
+            break;
+
         default:
             UNEXPECTED("Unexpected pipeline type");
     }
@@ -1409,9 +2085,17 @@ void ModifyPsoCreateInfo(GraphicsPipelineStateCreateInfo& PsoCreateInfo, ReloadG
 }
 
 template <typename CreateInfoType>
-bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
+bool ReloadablePipelineState::Reload(const std::unordered_set<const IShader*>& ReloadedShaders,
+                                     ReloadGraphicsPipelineCallbackType        ReloadGraphicsPipeline,
+                                     void*                                     pUserData)
 {
     auto& CreateInfo = static_cast<CreateInfoWrapper<CreateInfoType>&>(*m_pCreateInfo);
+
+    // The callback may modify graphics pipeline states, so graphics pipelines are always re-created when it is provided
+    const bool HasCallback = ReloadGraphicsPipeline != nullptr && std::is_same<CreateInfoType, GraphicsPipelineStateCreateInfo>::value;
+    if (!HasCallback && !CreateInfo.UsesAnyShader(ReloadedShaders))
+        return false;
+
     ModifyPsoCreateInfo<CreateInfoType>(static_cast<CreateInfoType&>(CreateInfo), ReloadGraphicsPipeline, pUserData);
 
     RefCntAutoPtr<IPipelineState> pNewPSO;
@@ -1436,25 +2120,31 @@ bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGr
 }
 
 
-bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData)
+bool ReloadablePipelineState::Reload(const std::unordered_set<const IShader*>& ReloadedShaders,
+                                     ReloadGraphicsPipelineCallbackType        ReloadGraphicsPipeline,
+                                     void*                                     pUserData)
 {
-    static_assert(PIPELINE_TYPE_COUNT == 5, "Did you add a new pipeline type? You may need to handle it here.");
+    static_assert(PIPELINE_TYPE_COUNT == 6, "Did you add a new pipeline type? You may need to handle it here.");
     // Note that all shaders in Create Info are reloadable shaders, so they will automatically redirect all calls
     // to the updated internal shader
     switch (m_Type)
     {
         case PIPELINE_TYPE_GRAPHICS:
         case PIPELINE_TYPE_MESH:
-            return Reload<GraphicsPipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
+            return Reload<GraphicsPipelineStateCreateInfo>(ReloadedShaders, ReloadGraphicsPipeline, pUserData);
 
         case PIPELINE_TYPE_COMPUTE:
-            return Reload<ComputePipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
+            return Reload<ComputePipelineStateCreateInfo>(ReloadedShaders, ReloadGraphicsPipeline, pUserData);
 
         case PIPELINE_TYPE_RAY_TRACING:
-            return Reload<RayTracingPipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
+            return Reload<RayTracingPipelineStateCreateInfo>(ReloadedShaders, ReloadGraphicsPipeline, pUserData);
 
         case PIPELINE_TYPE_TILE:
-            return Reload<TilePipelineStateCreateInfo>(ReloadGraphicsPipeline, pUserData);
+            return Reload<TilePipelineStateCreateInfo>(ReloadedShaders, ReloadGraphicsPipeline, pUserData);
+
+        case PIPELINE_TYPE_WORK_GRAPH:
+            UNSUPPORTED("Work graph pipelines are not supported by the render state cache");
+            return false;
 
         default:
             UNEXPECTED("Unexpected pipeline type");
@@ -0,0 +1,499 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderPermutationCompiler.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "DebugUtilities.hpp"
+#include "Cast.hpp"
+#include "ShaderToolsCommon.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool IsIdentifierStart(char c)
+{
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Removes comments, empty lines and redundant white space. Line breaks are preserved
+// as preprocessor directives are terminated by them.
+std::string NormalizeShaderSource(const std::string& Source)
+{
+    std::string Normalized;
+    Normalized.reserve(Source.length());
+
+    bool PendingSpace = false;
+
+    const auto AddChar = [&](char c) {
+        if (PendingSpace && !Normalized.empty() && Normalized.back() != '\n')
+            Normalized.push_back(' ');
+        PendingSpace = false;
+        Normalized.push_back(c);
+    };
+
+    const auto AddLineBreak = [&]() {
+        PendingSpace = false;
+        if (!Normalized.empty() && Normalized.back() != '\n')
+            Normalized.push_back('\n');
+    };
+
+    const size_t Len = Source.length();
+    for (size_t i = 0; i < Len;)
+    {
+        const char c = Source[i];
+        if (c == '\\' && (i + 1 < Len && Source[i + 1] == '\n'))
+        {
+            // Line continuation
+            PendingSpace = true;
+            i += 2;
+        }
+        else if (c == '\\' && (i + 2 < Len && Source[i + 1] == '\r' && Source[i + 2] == '\n'))
+        {
+            PendingSpace = true;
+            i += 3;
+        }
+        else if (c == '/' && i + 1 < Len && Source[i + 1] == '/')
+        {
+            // Single-line comment. The line break is processed by the next iteration.
+            i = Source.find('\n', i);
+            if (i == std::string::npos)
+                i = Len;
+        }
+        else if (c == '/' && i + 1 < Len && Source[i + 1] == '*')
+        {
+            const auto End = Source.find("*/", i + 2);
+            i              = End != std::string::npos ? End + 2 : Len;
+            PendingSpace   = true;
+        }
+        else if (c == '"')
+        {
+            // Copy string literals as is
+            AddChar(c);
+            for (++i; i < Len && Source[i] != '"' && Source[i] != '\n'; ++i)
+            {
+                Normalized.push_back(Source[i]);
+                if (Source[i] == '\\' && i + 1 < Len)
+                    Normalized.push_back(Source[++i]);
+            }
+            if (i < Len && Source[i] == '"')
+            {
+                Normalized.push_back('"');
+                ++i;
+            }
+        }
+        else if (c == '\n')
+        {
+            AddLineBreak();
+            ++i;
+        }
+        else if (std::isspace(static_cast<unsigned char>(c)))
+        {
+            PendingSpace = true;
+            ++i;
+        }
+        else
+        {
+            AddChar(c);
+            ++i;
+        }
+    }
+    AddLineBreak();
+
+    return Normalized;
+}
+
+void CollectIdentifiers(const char* Str, std::unordered_set<std::string>& Identifiers)
+{
+    if (Str == nullptr)
+        return;
+
+    while (*Str != '\0')
+    {
+        if (IsIdentifierStart(*Str))
+        {
+            const auto* Start = Str;
+            while (IsIdentifierChar(*Str))
+                ++Str;
+            Identifiers.emplace(Start, Str);
+        }
+        else if (std::isdigit(static_cast<unsigned char>(*Str)))
+        {
+            // Skip numeric literals such as 1.0e5f
+            while (IsIdentifierChar(*Str) || *Str == '.')
+                ++Str;
+        }
+        else
+        {
+            ++Str;
+        }
+    }
+}
+
+// Returns the macros that are referenced by the source directly or through other referenced macros,
+// sorted by name. If a macro is defined multiple times, the last definition is used.
+std::vector<ShaderMacro> GetReferencedMacros(const ShaderMacro* Macros, const std::string& Source)
+{
+    std::vector<ShaderMacro> Referenced;
+    if (Macros == nullptr)
+        return Referenced;
+
+    std::unordered_map<std::string, const ShaderMacro*> Definitions;
+    for (const auto* Macro = Macros; *Macro != ShaderMacro{}; ++Macro)
+    {
+        if (Macro->Name != nullptr)
+            Definitions[Macro->Name] = Macro;
+    }
+
+    std::unordered_set<std::string> Identifiers;
+    CollectIdentifiers(Source.c_str(), Identifiers);
+
+    std::unordered_set<std::string> Used;
+    for (bool Added = true; Added;)
+    {
+        Added = false;
+        for (const auto& Def : Definitions)
+        {
+            if (Used.find(Def.first) == Used.end() && Identifiers.find(Def.first) != Identifiers.end())
+            {
+                Used.emplace(Def.first);
+                CollectIdentifiers(Def.second->Definition, Identifiers);
+                Added = true;
+            }
+        }
+    }
+
+    Referenced.reserve(Used.size());
+    for (const auto& Def : Definitions)
+    {
+        if (Used.find(Def.first) != Used.end())
+            Referenced.push_back(*Def.second);
+    }
+    std::sort(Referenced.begin(), Referenced.end(), [](const ShaderMacro& M1, const ShaderMacro& M2) {
+        return strcmp(M1.Name, M2.Name) < 0;
+    });
+
+    return Referenced;
+}
+
+struct PermutationKey
+{
+    std::string              Source;
+    std::vector<ShaderMacro> Macros;
+    ShaderCreateInfo         CI;
+    XXH128Hash               Hash;
+};
+
+void BuildPermutationKey(const ShaderCreateInfo& ShaderCI,
+                         RENDER_DEVICE_TYPE      DeviceType,
+                         ShaderIncludeCache*     pIncludeCache,
+                         PermutationKey&         Key) noexcept(false)
+{
+    Key.CI                    = ShaderCI;
+    Key.CI.Desc.Name          = nullptr;
+    Key.CI.ppConversionStream = nullptr;
+    Key.CI.ppCompilerOutput   = nullptr;
+
+    if (ShaderCI.ByteCode == nullptr)
+    {
+        Key.Source = NormalizeShaderSource(UnrollShaderIncludes(ShaderCI, pIncludeCache));
+        Key.Macros = GetReferencedMacros(ShaderCI.Macros, Key.Source);
+        if (!Key.Macros.empty())
+            Key.Macros.emplace_back();
+
+        Key.CI.FilePath                   = nullptr;
+        Key.CI.pShaderSourceStreamFactory = nullptr;
+        Key.CI.Source                     = Key.Source.c_str();
+        Key.CI.SourceLength               = Key.Source.length();
+        Key.CI.Macros                     = !Key.Macros.empty() ? Key.Macros.data() : nullptr;
+    }
+
+    XXH128State Hasher;
+    Hasher.Update(Key.CI, DeviceType);
+    Key.Hash = Hasher.Digest();
+}
+
+} // namespace
+
+ShaderPermutationCompiler::ShaderPermutationCompiler(const ShaderPermutationCompilerCreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pStateCache{CI.pStateCache},
+    m_pBytecodeCache{CI.pBytecodeCache},
+    m_DeviceType{CI.pDevice != nullptr ? CI.pDevice->GetDeviceInfo().Type : RENDER_DEVICE_TYPE_UNDEFINED},
+    m_pIncludeCache{std::make_unique<ShaderIncludeCache>()}
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+}
+
+ShaderPermutationCompiler::~ShaderPermutationCompiler()
+{
+}
+
+XXH128Hash ShaderPermutationCompiler::ComputeKey(const ShaderCreateInfo& ShaderCI, RENDER_DEVICE_TYPE DeviceType) noexcept(false)
+{
+    PermutationKey Key;
+    BuildPermutationKey(ShaderCI, DeviceType, nullptr, Key);
+    return Key.Hash;
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationCompiler::CreateShader(const ShaderCreateInfo& ShaderCI)
+{
+    m_NumRequests.fetch_add(1);
+    return CreateShaderInternal(ShaderCI);
+}
+
+XXH128Hash ShaderPermutationCompiler::ComputeSourceHash(const ShaderCreateInfo& ShaderCI, const ShaderPermutationSchema& Schema) noexcept(false)
+{
+    PermutationKey Key;
+    BuildPermutationKey(ShaderCI, m_DeviceType, m_pIncludeCache.get(), Key);
+
+    XXH128State Hasher;
+    Hasher.Update(Key.Hash.LowPart, Key.Hash.HighPart, Schema.GetHash().LowPart, Schema.GetHash().HighPart);
+    return Hasher.Digest();
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationCompiler::CreateShader(const ShaderCreateInfo&        ShaderCI,
+                                                               const XXH128Hash&              SourceHash,
+                                                               const ShaderPermutationSchema& Schema,
+                                                               ShaderPermutationKey           Key)
+{
+    m_NumRequests.fetch_add(1);
+
+    const KeyedPermutation Perm{SourceHash, Key};
+
+    std::promise<RefCntAutoPtr<IShader>> Promise;
+    {
+        std::unique_lock<std::mutex> Lock{m_KeyedPermutationsMtx};
+
+        auto it = m_KeyedPermutations.find(Perm);
+        if (it != m_KeyedPermutations.end())
+        {
+            auto Future = it->second;
+            Lock.unlock();
+
+            m_NumDeduplicated.fetch_add(1);
+            return Future.get();
+        }
+
+        m_KeyedPermutations.emplace(Perm, Promise.get_future().share());
+    }
+
+    RefCntAutoPtr<IShader> pShader;
+    try
+    {
+        std::vector<ShaderMacro> Macros;
+        Schema.GetMacros(Key, Macros);
+        if (ShaderCI.Macros != nullptr)
+        {
+            // Permutation macros go last so that they take precedence over the base macros
+            Macros.pop_back();
+            size_t NumBaseMacros = 0;
+            while (ShaderCI.Macros[NumBaseMacros].Name != nullptr && ShaderCI.Macros[NumBaseMacros].Definition != nullptr)
+                ++NumBaseMacros;
+            Macros.insert(Macros.begin(), ShaderCI.Macros, ShaderCI.Macros + NumBaseMacros);
+            Macros.emplace_back(nullptr, nullptr);
+        }
+
+        ShaderCreateInfo PermutationCI{ShaderCI};
+        PermutationCI.Macros = Macros.data();
+
+        // Equivalent permutations of different uber-shaders are still collapsed by the content key
+        pShader = CreateShaderInternal(PermutationCI);
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""), "'.");
+    }
+
+    if (!pShader)
+    {
+        std::lock_guard<std::mutex> Lock{m_KeyedPermutationsMtx};
+        m_KeyedPermutations.erase(Perm);
+    }
+    Promise.set_value(pShader);
+
+    return pShader;
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationCompiler::CreateShaderInternal(const ShaderCreateInfo& ShaderCI)
+{
+    PermutationKey Key;
+    try
+    {
+        BuildPermutationKey(ShaderCI, m_DeviceType, m_pIncludeCache.get(), Key);
+    }
+    catch (...)
+    {
+        // Let the device report the error
+        LOG_WARNING_MESSAGE("Failed to compute the permutation key of shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""),
+                            "'. The shader will be created without deduplication.");
+        return CompilePermutation(ShaderCI, nullptr);
+    }
+
+    std::promise<RefCntAutoPtr<IShader>> Promise;
+    {
+        std::unique_lock<std::mutex> Lock{m_PermutationsMtx};
+
+        auto it = m_Permutations.find(Key.Hash);
+        if (it != m_Permutations.end())
+        {
+            auto Future = it->second;
+            Lock.unlock();
+
+            m_NumDeduplicated.fetch_add(1);
+            // Wait for the compilation if it is still in progress
+            return Future.get();
+        }
+
+        m_Permutations.emplace(Key.Hash, Promise.get_future().share());
+    }
+
+    RefCntAutoPtr<IShader> pShader;
+    try
+    {
+        pShader = CompilePermutation(ShaderCI, &Key.CI);
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to create shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""), "'.");
+    }
+
+    if (!pShader)
+    {
+        // Let subsequent requests try again
+        std::lock_guard<std::mutex> Lock{m_PermutationsMtx};
+        m_Permutations.erase(Key.Hash);
+    }
+    Promise.set_value(pShader);
+
+    return pShader;
+}
+
+RefCntAutoPtr<IShader> ShaderPermutationCompiler::CompilePermutation(const ShaderCreateInfo& ShaderCI, const ShaderCreateInfo* pKeyCI)
+{
+    const auto CreateShaderObject = [this](const ShaderCreateInfo& CI) {
+        RefCntAutoPtr<IShader> pShader;
+        if (m_pStateCache)
+            m_pStateCache->CreateShader(CI, &pShader);
+        else
+            m_pDevice->CreateShader(CI, &pShader);
+        return pShader;
+    };
+
+    // OpenGL backend does not support creating shaders from byte code
+    const bool UseBytecodeCache = (m_pBytecodeCache &&
+                                   pKeyCI != nullptr &&
+                                   ShaderCI.ByteCode == nullptr &&
+                                   m_DeviceType != RENDER_DEVICE_TYPE_GL &&
+                                   m_DeviceType != RENDER_DEVICE_TYPE_GLES);
+
+    if (UseBytecodeCache)
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        {
+            std::lock_guard<std::mutex> Lock{m_BytecodeCacheMtx};
+            m_pBytecodeCache->GetBytecode(*pKeyCI, &pBytecode);
+        }
+
+        if (pBytecode)
+        {
+            ShaderCreateInfo BytecodeCI{ShaderCI};
+            BytecodeCI.FilePath     = nullptr;
+            BytecodeCI.Source       = nullptr;
+            BytecodeCI.Macros       = nullptr;
+            BytecodeCI.ByteCode     = pBytecode->GetConstDataPtr();
+            BytecodeCI.ByteCodeSize = StaticCast<size_t>(pBytecode->GetSize());
+            if (auto pShader = CreateShaderObject(BytecodeCI))
+            {
+                m_NumBytecodeCacheHits.fetch_add(1);
+                return pShader;
+            }
+        }
+    }
+
+    auto pShader = CreateShaderObject(ShaderCI);
+    if (!pShader)
+        return {};
+
+    m_NumCompiled.fetch_add(1);
+
+    if (UseBytecodeCache && pShader->GetStatus() == SHADER_STATUS_READY)
+    {
+        const void* pBytecode    = nullptr;
+        Uint64      BytecodeSize = 0;
+        pShader->GetBytecode(&pBytecode, BytecodeSize);
+        if (pBytecode != nullptr && BytecodeSize != 0)
+        {
+            auto pBytecodeBlob = DataBlobImpl::Create(StaticCast<size_t>(BytecodeSize), pBytecode);
+
+            std::lock_guard<std::mutex> Lock{m_BytecodeCacheMtx};
+            m_pBytecodeCache->AddBytecode(*pKeyCI, pBytecodeBlob);
+        }
+    }
+
+    return pShader;
+}
+
+void ShaderPermutationCompiler::Reset()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_PermutationsMtx};
+        m_Permutations.clear();
+    }
+    {
+        std::lock_guard<std::mutex> Lock{m_KeyedPermutationsMtx};
+        m_KeyedPermutations.clear();
+    }
+    m_pIncludeCache->Clear();
+}
+
+ShaderPermutationCompiler::Statistics ShaderPermutationCompiler::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumRequests          = m_NumRequests.load();
+    Stats.NumCompiled          = m_NumCompiled.load();
+    Stats.NumBytecodeCacheHits = m_NumBytecodeCacheHits.load();
+    Stats.NumDeduplicated      = m_NumDeduplicated.load();
+    return Stats;
+}
+
+} // namespace Diligent
@@ -0,0 +1,234 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderPermutationSchema.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 ShaderPermutationSchema::MaxKeyBits;
+constexpr Uint32 ShaderPermutationSchema::MaxFieldValues;
+
+Uint32 ShaderPermutationSchema::AddBool(const Char* Name) noexcept(false)
+{
+    Field NewField;
+    NewField.Name        = Name != nullptr ? Name : "";
+    NewField.Type        = FIELD_TYPE_BOOL;
+    NewField.NumValues   = 2;
+    NewField.Definitions = {"0", "1"};
+    return AddField(std::move(NewField));
+}
+
+Uint32 ShaderPermutationSchema::AddInt(const Char* Name, Int32 MinValue, Int32 MaxValue) noexcept(false)
+{
+    if (MaxValue < MinValue)
+        LOG_ERROR_AND_THROW("Invalid range [", MinValue, ", ", MaxValue, "] of permutation macro '", (Name != nullptr ? Name : ""), "'.");
+
+    const auto NumValues = static_cast<Int64>(MaxValue) - static_cast<Int64>(MinValue) + 1;
+    if (NumValues > MaxFieldValues)
+        LOG_ERROR_AND_THROW("Permutation macro '", (Name != nullptr ? Name : ""), "' has ", NumValues, " values, which exceeds the limit (", MaxFieldValues, ").");
+
+    Field NewField;
+    NewField.Name      = Name != nullptr ? Name : "";
+    NewField.Type      = FIELD_TYPE_INT;
+    NewField.MinValue  = MinValue;
+    NewField.NumValues = static_cast<Uint32>(NumValues);
+    NewField.Definitions.reserve(NewField.NumValues);
+    for (Int64 Value = MinValue; Value <= MaxValue; ++Value)
+        NewField.Definitions.emplace_back(std::to_string(Value));
+    return AddField(std::move(NewField));
+}
+
+Uint32 ShaderPermutationSchema::AddEnum(const Char* Name, std::vector<std::string> Definitions) noexcept(false)
+{
+    if (Definitions.empty())
+        LOG_ERROR_AND_THROW("Permutation macro '", (Name != nullptr ? Name : ""), "' must have at least one definition.");
+    if (Definitions.size() > MaxFieldValues)
+        LOG_ERROR_AND_THROW("Permutation macro '", (Name != nullptr ? Name : ""), "' has ", Definitions.size(), " values, which exceeds the limit (", MaxFieldValues, ").");
+
+    Field NewField;
+    NewField.Name        = Name != nullptr ? Name : "";
+    NewField.Type        = FIELD_TYPE_ENUM;
+    NewField.NumValues   = static_cast<Uint32>(Definitions.size());
+    NewField.Definitions = std::move(Definitions);
+    return AddField(std::move(NewField));
+}
+
+Uint32 ShaderPermutationSchema::AddField(Field&& NewField) noexcept(false)
+{
+    if (NewField.Name.empty())
+        LOG_ERROR_AND_THROW("Permutation macro name must not be empty.");
+    if (m_FieldIndices.find(NewField.Name) != m_FieldIndices.end())
+        LOG_ERROR_AND_THROW("Permutation macro '", NewField.Name, "' is already declared.");
+
+    NewField.NumBits   = NewField.NumValues > 1 ? PlatformMisc::GetMSB(NewField.NumValues - 1) + 1 : 0;
+    NewField.BitOffset = m_NumKeyBits;
+    if (m_NumKeyBits + NewField.NumBits > MaxKeyBits)
+        LOG_ERROR_AND_THROW("Permutation macro '", NewField.Name, "' requires ", NewField.NumBits, " bits, but only ",
+                            MaxKeyBits - m_NumKeyBits, " bits of the permutation key are available.");
+
+    const auto Index = static_cast<Uint32>(m_Fields.size());
+    m_FieldIndices.emplace(NewField.Name, Index);
+    m_NumKeyBits += NewField.NumBits;
+    m_Fields.emplace_back(std::move(NewField));
+
+    XXH128State Hasher;
+    for (const auto& F : m_Fields)
+    {
+        Hasher.Update(F.Name, F.Type, F.MinValue, F.NumValues);
+        for (const auto& Def : F.Definitions)
+            Hasher.Update(Def);
+    }
+    m_Hash = Hasher.Digest();
+
+    return Index;
+}
+
+void ShaderPermutationSchema::SetValue(ShaderPermutationKey& Key, Uint32 Field, Int32 Value) const
+{
+    VERIFY_EXPR(Field < m_Fields.size());
+    const auto& F = m_Fields[Field];
+
+    const auto Offset = static_cast<Int64>(Value) - static_cast<Int64>(F.MinValue);
+    DEV_CHECK_ERR(Offset >= 0 && Offset < F.NumValues, "Value ", Value, " is out of range of permutation macro '", F.Name, "'.");
+    if (F.NumBits == 0)
+        return;
+
+    const auto Mask = ((Uint64{1} << F.NumBits) - 1) << F.BitOffset;
+    Key.Bits        = (Key.Bits & ~Mask) | ((static_cast<Uint64>(Offset) << F.BitOffset) & Mask);
+}
+
+Int32 ShaderPermutationSchema::GetValue(ShaderPermutationKey Key, Uint32 Field) const
+{
+    VERIFY_EXPR(Field < m_Fields.size());
+    const auto& F = m_Fields[Field];
+    if (F.NumBits == 0)
+        return F.MinValue;
+
+    const auto Offset = (Key.Bits >> F.BitOffset) & ((Uint64{1} << F.NumBits) - 1);
+    return static_cast<Int32>(static_cast<Int64>(F.MinValue) + static_cast<Int64>(Offset));
+}
+
+void ShaderPermutationSchema::GetMacros(ShaderPermutationKey Key, std::vector<ShaderMacro>& Macros) const
+{
+    Macros.clear();
+    Macros.reserve(m_Fields.size() + 1);
+    for (Uint32 i = 0; i < m_Fields.size(); ++i)
+    {
+        const auto& F = m_Fields[i];
+
+        auto Offset = static_cast<Uint32>(GetValue(Key, i) - F.MinValue);
+        DEV_CHECK_ERR(Offset < F.NumValues, "The key contains invalid value of permutation macro '", F.Name, "'.");
+        Offset = std::min(Offset, F.NumValues - 1);
+
+        Macros.emplace_back(F.Name.c_str(), F.Definitions[Offset].c_str());
+    }
+    Macros.emplace_back(nullptr, nullptr);
+}
+
+ShaderMacroHelper ShaderPermutationSchema::GetMacroHelper(ShaderPermutationKey Key) const
+{
+    std::vector<ShaderMacro> Macros;
+    GetMacros(Key, Macros);
+
+    ShaderMacroHelper Helper;
+    for (const auto& Macro : Macros)
+    {
+        if (Macro.Name != nullptr)
+            Helper.AddShaderMacro(Macro.Name, Macro.Definition);
+    }
+    return Helper;
+}
+
+bool ShaderPermutationSchema::GetKey(const ShaderMacro* Macros, ShaderPermutationKey& Key) const
+{
+    Key = {};
+    if (Macros == nullptr)
+        return true;
+
+    bool Res = true;
+    for (; Macros->Name != nullptr && Macros->Definition != nullptr; ++Macros)
+    {
+        const auto Index = GetFieldIndex(Macros->Name);
+        if (Index == ~0u)
+            continue;
+
+        const auto& F = m_Fields[Index];
+
+        bool Found = false;
+        if (F.Type == FIELD_TYPE_ENUM)
+        {
+            for (Uint32 i = 0; i < F.NumValues && !Found; ++i)
+            {
+                if (F.Definitions[i] == Macros->Definition)
+                {
+                    SetValue(Key, Index, static_cast<Int32>(static_cast<Int64>(F.MinValue) + i));
+                    Found = true;
+                }
+            }
+        }
+        else
+        {
+            Char*      pEnd  = nullptr;
+            const auto Value = std::strtoll(Macros->Definition, &pEnd, 10);
+            if (pEnd != Macros->Definition && (*pEnd == 'u' || *pEnd == 'U'))
+                ++pEnd;
+            if (pEnd != Macros->Definition && *pEnd == '\0' &&
+                Value >= F.MinValue && Value < static_cast<Int64>(F.MinValue) + F.NumValues)
+            {
+                SetValue(Key, Index, static_cast<Int32>(Value));
+                Found = true;
+            }
+        }
+
+        if (!Found)
+        {
+            LOG_ERROR_MESSAGE("Definition '", Macros->Definition, "' of macro '", F.Name, "' does not match any value declared by the permutation schema.");
+            Res = false;
+        }
+    }
+
+    return Res;
+}
+
+Uint32 ShaderPermutationSchema::GetFieldIndex(const Char* Name) const
+{
+    if (Name == nullptr)
+        return ~0u;
+
+    auto it = m_FieldIndices.find(Name);
+    return it != m_FieldIndices.end() ? it->second : ~0u;
+}
+
+} // namespace Diligent
@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureStreamingQueue.hpp"
+
+#include <algorithm>
+
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 StreamingRowStrideAlignment = 4;
+
+bool AreRegionsAdjacent(const Box& Rgn0, const Box& Rgn1)
+{
+    if (Rgn0.MinX == Rgn1.MinX && Rgn0.MaxX == Rgn1.MaxX)
+        return Rgn0.MaxY == Rgn1.MinY || Rgn1.MaxY == Rgn0.MinY;
+    if (Rgn0.MinY == Rgn1.MinY && Rgn0.MaxY == Rgn1.MaxY)
+        return Rgn0.MaxX == Rgn1.MinX || Rgn1.MaxX == Rgn0.MinX;
+    return false;
+}
+
+} // namespace
+
+struct TextureStreamingQueue::CopyCommand
+{
+    RefCntAutoPtr<ITexture> pTexture;
+
+    Uint32 MipLevel   = 0;
+    Uint32 ArraySlice = 0;
+    Box    Region;
+
+    std::vector<Uint8> Data;
+    Uint64             Stride      = 0;
+    Uint64             DepthStride = 0;
+
+    std::vector<std::function<void()>> Callbacks;
+};
+
+TextureStreamingQueue::TextureStreamingQueue(const TextureStreamingQueueCreateInfo& CI) :
+    m_CI{CI}
+{
+}
+
+TextureStreamingQueue::RequestId TextureStreamingQueue::Enqueue(const UploadRequest& Req)
+{
+    DEV_CHECK_ERR(Req.pTexture != nullptr, "Texture must not be null");
+    DEV_CHECK_ERR(Req.pData != nullptr, "Data must not be null");
+
+    const auto& TexDesc = Req.pTexture->GetDesc();
+    DEV_CHECK_ERR(Req.MipLevel < TexDesc.MipLevels, "Mip level ", Req.MipLevel, " is out of range");
+    DEV_CHECK_ERR(Req.ArraySlice < TexDesc.GetArraySize(), "Array slice ", Req.ArraySlice, " is out of range");
+
+    Request NewReq;
+    NewReq.pTexture   = Req.pTexture;
+    NewReq.MipLevel   = Req.MipLevel;
+    NewReq.ArraySlice = Req.ArraySlice;
+    NewReq.Region     = Req.Region;
+    NewReq.Priority   = Req.Priority;
+    NewReq.OnUploaded = Req.OnUploaded;
+    if (!NewReq.Region.IsValid())
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, Req.MipLevel);
+
+        NewReq.Region = Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+    }
+
+    const auto CopyInfo = GetBufferToTextureCopyInfo(TexDesc.Format, NewReq.Region, StreamingRowStrideAlignment);
+
+    NewReq.Stride      = CopyInfo.RowStride;
+    NewReq.DepthStride = CopyInfo.DepthStride;
+    NewReq.Data.resize(static_cast<size_t>(CopyInfo.MemorySize));
+    CopyTextureSubresource(TextureSubResData{Req.pData, Req.Stride, Req.DepthStride},
+                           CopyInfo.RowCount, NewReq.Region.Depth(), CopyInfo.RowSize,
+                           NewReq.Data.data(), CopyInfo.RowStride, CopyInfo.DepthStride);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto Id = m_NextRequestId++;
+    m_Queue.emplace(QueueKey{NewReq.Priority, NewReq.MipLevel, Id});
+    m_TextureRequests[NewReq.pTexture].push_back(Id);
+    m_PendingBytes += NewReq.Data.size();
+    m_Requests.emplace(Id, std::move(NewReq));
+
+    return Id;
+}
+
+void TextureStreamingQueue::RemoveRequest(RequestId Id)
+{
+    auto it = m_Requests.find(Id);
+    VERIFY_EXPR(it != m_Requests.end());
+    const auto& Req = it->second;
+
+    m_Queue.erase(QueueKey{Req.Priority, Req.MipLevel, Id});
+
+    auto tex_it = m_TextureRequests.find(Req.pTexture);
+    VERIFY_EXPR(tex_it != m_TextureRequests.end());
+    auto& TexRequests = tex_it->second;
+    TexRequests.erase(std::find(TexRequests.begin(), TexRequests.end(), Id));
+    if (TexRequests.empty())
+        m_TextureRequests.erase(tex_it);
+
+    m_PendingBytes -= Req.Data.size();
+    m_Requests.erase(it);
+}
+
+bool TextureStreamingQueue::Cancel(RequestId Id)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (m_Requests.find(Id) == m_Requests.end())
+        return false;
+
+    RemoveRequest(Id);
+    return true;
+}
+
+TextureStreamingQueue::UpdateStats TextureStreamingQueue::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+
+    UpdateStats Stats;
+
+    // Build the commands under the lock, but record them after it is released so that
+    // worker threads are not blocked while the render thread is in the driver.
+    std::vector<CopyCommand> Commands;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        const auto FitsBudget = [&](Uint64 Size) {
+            return m_CI.MaxBytesPerUpdate == 0 || Stats.NumBytes + Size <= m_CI.MaxBytesPerUpdate;
+        };
+
+        while (!m_Queue.empty())
+        {
+            if (m_CI.MaxCommandsPerUpdate != 0 && Stats.NumCommands >= m_CI.MaxCommandsPerUpdate)
+                break;
+
+            const auto HeadId = m_Queue.begin()->Id;
+            auto&      Head   = m_Requests[HeadId];
+            if (Stats.NumRequests > 0 && !FitsBudget(Head.Data.size()))
+                break;
+
+            // Greedily grow the region by the adjacent requests for the same subresource.
+            // Every merged request extends the region by a full row or column, so the
+            // region always remains a rectangle that is exactly covered by the requests.
+            std::vector<RequestId> Group{HeadId};
+            Box                    Region    = Head.Region;
+            Uint64                 GroupSize = Head.Data.size();
+            if (Region.Depth() == 1)
+            {
+                const auto& TexRequests = m_TextureRequests[Head.pTexture];
+                for (bool Merged = true; Merged;)
+                {
+                    Merged = false;
+                    for (auto Id : TexRequests)
+                    {
+                        const auto& Req = m_Requests[Id];
+                        if (Req.MipLevel != Head.MipLevel ||
+                            Req.ArraySlice != Head.ArraySlice ||
+                            Req.Region.Depth() != 1 ||
+                            !AreRegionsAdjacent(Region, Req.Region) ||
+                            !FitsBudget(GroupSize + Req.Data.size()) ||
+                            std::find(Group.begin(), Group.end(), Id) != Group.end())
+                            continue;
+
+                        Region.MinX = std::min(Region.MinX, Req.Region.MinX);
+                        Region.MaxX = std::max(Region.MaxX, Req.Region.MaxX);
+                        Region.MinY = std::min(Region.MinY, Req.Region.MinY);
+                        Region.MaxY = std::max(Region.MaxY, Req.Region.MaxY);
+                        GroupSize += Req.Data.size();
+                        Group.push_back(Id);
+                        Merged = true;
+                    }
+                }
+            }
+
+            Commands.emplace_back();
+            auto& Cmd      = Commands.back();
+            Cmd.pTexture   = Head.pTexture;
+            Cmd.MipLevel   = Head.MipLevel;
+            Cmd.ArraySlice = Head.ArraySlice;
+            Cmd.Region     = Region;
+            if (Group.size() == 1)
+            {
+                Cmd.Data.swap(Head.Data);
+                Cmd.Stride      = Head.Stride;
+                Cmd.DepthStride = Head.DepthStride;
+                // The data has been moved out, so RemoveRequest() will not account for it
+                m_PendingBytes -= Cmd.Data.size();
+            }
+            else
+            {
+                const auto& FmtAttribs = GetTextureFormatAttribs(Head.pTexture->GetDesc().Format);
+                const auto  CopyInfo   = GetBufferToTextureCopyInfo(Head.pTexture->GetDesc().Format, Region, StreamingRowStrideAlignment);
+
+                Cmd.Stride      = CopyInfo.RowStride;
+                Cmd.DepthStride = CopyInfo.DepthStride;
+                Cmd.Data.resize(static_cast<size_t>(CopyInfo.MemorySize));
+                for (auto Id : Group)
+                {
+                    const auto& Req       = m_Requests[Id];
+                    const auto  DstOffset = (Req.Region.MinY - Region.MinY) / FmtAttribs.BlockHeight * CopyInfo.RowStride +
+                        Uint64{(Req.Region.MinX - Region.MinX) / FmtAttribs.BlockWidth} * FmtAttribs.GetElementSize();
+                    const auto ReqCopyInfo = GetBufferToTextureCopyInfo(Head.pTexture->GetDesc().Format, Req.Region, StreamingRowStrideAlignment);
+                    CopyTextureSubresource(TextureSubResData{Req.Data.data(), Req.Stride},
+                                           ReqCopyInfo.RowCount, 1, ReqCopyInfo.RowSize,
+                                           &Cmd.Data[static_cast<size_t>(DstOffset)], CopyInfo.RowStride, CopyInfo.DepthStride);
+                }
+            }
+
+            for (auto Id : Group)
+            {
+                auto& Req = m_Requests[Id];
+                if (Req.OnUploaded)
+                    Cmd.Callbacks.emplace_back(std::move(Req.OnUploaded));
+                RemoveRequest(Id);
+            }
+
+            ++Stats.NumCommands;
+            Stats.NumRequests += static_cast<Uint32>(Group.size());
+            Stats.NumBytes += GroupSize;
+        }
+    }
+
+    for (auto& Cmd : Commands)
+    {
+        TextureSubResData SubresData{Cmd.Data.data(), Cmd.Stride, Cmd.DepthStride};
+        pContext->UpdateTexture(Cmd.pTexture, Cmd.MipLevel, Cmd.ArraySlice, Cmd.Region, SubresData,
+                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        for (auto& Callback : Cmd.Callbacks)
+            Callback();
+    }
+
+    return Stats;
+}
+
+size_t TextureStreamingQueue::GetNumPendingRequests()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Requests.size();
+}
+
+Uint64 TextureStreamingQueue::GetPendingBytes()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_PendingBytes;
+}
+
+} // namespace Diligent
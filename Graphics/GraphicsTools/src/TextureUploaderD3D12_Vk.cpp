@@ -166,10 +166,17 @@ struct TextureUploaderD3D12_Vk::InternalData
         // clang-format on
     };
 
-    InternalData(IRenderDevice* pDevice)
+    InternalData(IRenderDevice* pDevice, const TextureUploaderDesc& Desc) :
+        m_pCopyContext{Desc.pCopyContext}
     {
         FenceDesc fenceDesc;
         fenceDesc.Name = "Texture uploader sync fence";
+        if (m_pCopyContext)
+        {
+            DEV_CHECK_ERR(!m_pCopyContext->GetDesc().IsDeferred, "Copy context must be an immediate context");
+            // The render context waits for the fence on the GPU
+            fenceDesc.Type = FENCE_TYPE_GENERAL;
+        }
         pDevice->CreateFence(fenceDesc, &m_pFence);
     }
 
@@ -212,10 +219,32 @@ struct TextureUploaderD3D12_Vk::InternalData
         // Fences can't be accessed from multiple threads simultaneously even
         // when protected by mutex
         auto FenceValue = m_NextFenceValue++;
-        pContext->EnqueueSignal(m_pFence, FenceValue);
+        if (m_pCopyContext)
+        {
+            m_pCopyContext->EnqueueSignal(m_pFence, FenceValue);
+            // Submit the copies now so that they run in parallel with the rendering commands
+            m_pCopyContext->Flush();
+            // Destination textures must not be accessed by the render context until the copies are complete
+            pContext->DeviceWaitForFence(m_pFence, FenceValue);
+        }
+        else
+        {
+            pContext->EnqueueSignal(m_pFence, FenceValue);
+        }
         return FenceValue;
     }
 
+    // Returns the context that maps the staging textures and records the copy commands
+    IDeviceContext* GetCopyContext(IDeviceContext* pRenderContext) const
+    {
+        return m_pCopyContext ? m_pCopyContext.RawPtr<IDeviceContext>() : pRenderContext;
+    }
+
+    Uint64 GetStagingTextureContextMask() const
+    {
+        return m_pCopyContext ? (Uint64{1} << Uint64{m_pCopyContext->GetDesc().ContextId}) : TextureDesc{}.ImmediateContextMask;
+    }
+
     void UpdatedCompletedFenceValue()
     {
         // Fences can't be accessed from multiple threads simultaneously even
@@ -269,6 +298,8 @@ private:
     std::mutex                                                                     m_UploadTexturesCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_UploadTexturesCache;
 
+    RefCntAutoPtr<IDeviceContext> m_pCopyContext;
+
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
     Uint64                m_CompletedFenceValue = 0;
@@ -276,7 +307,7 @@ private:
 
 TextureUploaderD3D12_Vk::TextureUploaderD3D12_Vk(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData(pDevice)}
+    m_pInternalData{new InternalData(pDevice, Desc)}
 {
 }
 
@@ -326,9 +357,10 @@ void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 }
 
 
-void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pContext,
+void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pRenderContext,
                                                     PendingBufferOperation& OperationInfo)
 {
+    auto*       pContext       = GetCopyContext(pRenderContext);
     auto&       pUploadTex     = OperationInfo.pUploadTexture;
     const auto& StagingTexDesc = pUploadTex->GetDesc();
 
@@ -394,6 +426,8 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
         StagingTexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
         StagingTexDesc.Usage          = USAGE_STAGING;
 
+        StagingTexDesc.ImmediateContextMask = m_pInternalData->GetStagingTextureContextMask();
+
         RefCntAutoPtr<ITexture> pStagingTexture;
         m_pDevice->CreateTexture(StagingTexDesc, nullptr, &pStagingTexture);
 
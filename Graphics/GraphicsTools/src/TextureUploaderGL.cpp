@@ -30,6 +30,7 @@
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 
 #include "TextureUploaderGL.hpp"
 #include "ThreadSignal.hpp"
@@ -88,8 +89,9 @@ public:
         m_BufferMappedSignal.Trigger();
     }
 
-    void SignalCopyScheduled()
+    void SignalCopyScheduled(Uint64 FenceValue)
     {
+        m_CopyScheduledFenceValue = FenceValue;
         m_CopyScheduledSignal.Trigger();
     }
 
@@ -99,6 +101,15 @@ public:
     }
 
     bool DbgIsCopyScheduled() const { return m_CopyScheduledSignal.IsTriggered(); }
+    bool DbgIsMapped() const { return m_BufferMappedSignal.IsTriggered(); }
+
+    // Returns the value of the uploader fence that is signaled when the GPU has finished
+    // reading the staging buffer.
+    Uint64 GetCopyScheduledFenceValue() const
+    {
+        VERIFY(m_CopyScheduledFenceValue != 0, "Fence value has not been initialized");
+        return m_CopyScheduledFenceValue;
+    }
 
     void SetDataPtr(Uint8* pBufferData)
     {
@@ -121,6 +132,7 @@ public:
     {
         m_BufferMappedSignal.Reset();
         m_CopyScheduledSignal.Reset();
+        m_CopyScheduledFenceValue = 0;
         UploadBufferBase::Reset();
     }
 
@@ -142,6 +154,7 @@ private:
     RefCntAutoPtr<IBuffer> m_pStagingBuffer;
     std::vector<Uint32>    m_SubresourceOffsets;
     std::vector<Uint32>    m_SubresourceStrides;
+    Uint64                 m_CopyScheduledFenceValue = 0;
 };
 
 } // namespace
@@ -149,6 +162,14 @@ private:
 
 struct TextureUploaderGL::InternalData
 {
+    InternalData(IRenderDevice* pDevice, const TextureUploaderDesc& Desc) :
+        m_MaxCopyBytesPerUpdate{Desc.MaxCopyBytesPerUpdate}
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Name = "Texture uploader sync fence";
+        pDevice->CreateFence(fenceDesc, &m_pFence);
+    }
+
     void SwapMapQueues()
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
@@ -195,6 +216,52 @@ struct TextureUploaderGL::InternalData
         // clang-format on
     };
 
+    // Returns the operations that were deferred because they did not fit into the copy budget
+    // back to the front of the queue.
+    void ReturnDeferredOperations()
+    {
+        std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
+        m_PendingOperations.insert(m_PendingOperations.begin(),
+                                   std::make_move_iterator(m_DeferredOperations.begin()),
+                                   std::make_move_iterator(m_DeferredOperations.end()));
+        m_DeferredOperations.clear();
+    }
+
+    Uint64 SignalFence(IDeviceContext* pContext)
+    {
+        // Fences can't be accessed from multiple threads simultaneously even
+        // when protected by mutex
+        auto FenceValue = m_NextFenceValue++;
+        pContext->EnqueueSignal(m_pFence, FenceValue);
+        return FenceValue;
+    }
+
+    void UpdateCompletedFenceValue()
+    {
+        // Fences can't be accessed from multiple threads simultaneously even
+        // when protected by mutex
+        m_CompletedFenceValue = m_pFence->GetCompletedValue();
+    }
+
+    // Maps recycled buffers that are no longer used by the GPU, so that worker threads
+    // can write to them without waiting for the render thread.
+    void MapRecycledBuffers(IRenderDevice* pDevice, IDeviceContext* pContext);
+
+    // Unmaps the buffers that were mapped by MapRecycledBuffers() and were never used.
+    void UnmapCachedBuffers();
+
+    struct CachedBuffers
+    {
+        // Buffers that are mapped and ready to be written to
+        std::deque<RefCntAutoPtr<UploadBufferGL>> Mapped;
+
+        // Buffers that may still be used by the GPU, in the order they were recycled
+        std::deque<RefCntAutoPtr<UploadBufferGL>> Recycled;
+    };
+
+    // Returns a cached buffer and whether it is already mapped
+    RefCntAutoPtr<UploadBufferGL> FindCachedBuffer(const UploadBufferDesc& Desc, bool& IsMapped);
+
     void Execute(IRenderDevice*          pDevice,
                  IDeviceContext*         pContext,
                  PendingBufferOperation& OperationInfo);
@@ -202,14 +269,24 @@ struct TextureUploaderGL::InternalData
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
+    std::vector<PendingBufferOperation> m_DeferredOperations;
+
+    std::mutex                                          m_UploadBuffCacheMtx;
+    std::unordered_map<UploadBufferDesc, CachedBuffers> m_UploadBufferCache;
+
+    const Uint64 m_MaxCopyBytesPerUpdate;
 
-    std::mutex                                                                      m_UploadBuffCacheMtx;
-    std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadBufferGL>>> m_UploadBufferCache;
+    // The context that mapped the cached buffers
+    RefCntAutoPtr<IDeviceContext> m_pMapContext;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue      = 1;
+    Uint64                m_CompletedFenceValue = 0;
 };
 
 TextureUploaderGL::TextureUploaderGL(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData{}}
+    m_pInternalData{new InternalData{pDevice, Desc}}
 {
 }
 
@@ -224,29 +301,140 @@ TextureUploaderGL::~TextureUploaderGL()
                             ", they may deadlock.");
     }
 
-    for (auto BuffQueueIt : m_pInternalData->m_UploadBufferCache)
+    for (const auto& BuffQueueIt : m_pInternalData->m_UploadBufferCache)
     {
-        if (BuffQueueIt.second.size())
+        const auto NumBuffers = BuffQueueIt.second.Mapped.size() + BuffQueueIt.second.Recycled.size();
+        if (NumBuffers != 0)
         {
             const auto& desc    = BuffQueueIt.first;
             auto&       FmtInfo = m_pDevice->GetTextureFormatInfo(desc.Format);
-            LOG_INFO_MESSAGE("TextureUploaderGL: releasing ", BuffQueueIt.second.size(), ' ', desc.Width, 'x',
-                             desc.Height, 'x', desc.Depth, ' ', FmtInfo.Name, " upload buffer", (BuffQueueIt.second.size() != 1 ? "s" : ""));
+            LOG_INFO_MESSAGE("TextureUploaderGL: releasing ", NumBuffers, ' ', desc.Width, 'x',
+                             desc.Height, 'x', desc.Depth, ' ', FmtInfo.Name, " upload buffer", (NumBuffers != 1 ? "s" : ""));
         }
     }
+
+    // Like all other GL objects, the uploader must be released by the render thread
+    m_pInternalData->UnmapCachedBuffers();
 }
 
 void TextureUploaderGL::RenderThreadUpdate(IDeviceContext* pContext)
 {
-    m_pInternalData->SwapMapQueues();
-    if (!m_pInternalData->m_InWorkOperations.empty())
+    auto& Data = *m_pInternalData;
+
+    Data.SwapMapQueues();
+    auto& InWorkOperations = Data.m_InWorkOperations;
+    if (!InWorkOperations.empty())
     {
-        for (auto& OperationInfo : m_pInternalData->m_InWorkOperations)
+        Uint64 NumBytesCopied    = 0;
+        Uint32 NumCopyOperations = 0;
+        for (auto& OperationInfo : InWorkOperations)
         {
-            m_pInternalData->Execute(m_pDevice, pContext, OperationInfo);
+            if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
+            {
+                // Copies that exceed the budget are deferred to the next update. At least one copy is
+                // always executed so that large uploads make progress.
+                const auto CopySize = OperationInfo.pUploadBuffer->GetTotalSize();
+                if (Data.m_MaxCopyBytesPerUpdate != 0 && NumCopyOperations > 0 && NumBytesCopied + CopySize > Data.m_MaxCopyBytesPerUpdate)
+                {
+                    Data.m_DeferredOperations.emplace_back(std::move(OperationInfo));
+                    continue;
+                }
+                NumBytesCopied += CopySize;
+                ++NumCopyOperations;
+            }
+            Data.Execute(m_pDevice, pContext, OperationInfo);
         }
-        m_pInternalData->m_InWorkOperations.clear();
+
+        if (NumCopyOperations > 0)
+        {
+            // The buffer may be recycled immediately after the copy scheduled is signaled,
+            // so we must signal the fence first.
+            auto SignaledFenceValue = Data.SignalFence(pContext);
+
+            for (auto& OperationInfo : InWorkOperations)
+            {
+                // Deferred operations have been moved out and have null buffers
+                if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy && OperationInfo.pUploadBuffer)
+                    OperationInfo.pUploadBuffer->SignalCopyScheduled(SignaledFenceValue);
+            }
+        }
+
+        if (!Data.m_DeferredOperations.empty())
+            Data.ReturnDeferredOperations();
+
+        InWorkOperations.clear();
     }
+
+    // This must be called by the same thread that signals the fence
+    Data.UpdateCompletedFenceValue();
+
+    Data.MapRecycledBuffers(m_pDevice, pContext);
+}
+
+void TextureUploaderGL::InternalData::MapRecycledBuffers(IRenderDevice* pDevice, IDeviceContext* pContext)
+{
+    std::lock_guard<std::mutex> CacheLock(m_UploadBuffCacheMtx);
+    for (auto& CacheIt : m_UploadBufferCache)
+    {
+        auto& Recycled = CacheIt.second.Recycled;
+        while (!Recycled.empty() && Recycled.front()->GetCopyScheduledFenceValue() <= m_CompletedFenceValue)
+        {
+            // The GPU has finished reading the staging buffer, so mapping it will not stall
+            RefCntAutoPtr<UploadBufferGL> pBuffer = std::move(Recycled.front());
+            Recycled.pop_front();
+            pBuffer->Reset();
+
+            PendingBufferOperation MapOp{PendingBufferOperation::Operation::Map, pBuffer};
+            Execute(pDevice, pContext, MapOp);
+            CacheIt.second.Mapped.emplace_back(std::move(pBuffer));
+
+            m_pMapContext = pContext;
+        }
+    }
+}
+
+void TextureUploaderGL::InternalData::UnmapCachedBuffers()
+{
+    std::lock_guard<std::mutex> CacheLock(m_UploadBuffCacheMtx);
+    for (auto& CacheIt : m_UploadBufferCache)
+    {
+        for (auto& pBuffer : CacheIt.second.Mapped)
+        {
+            VERIFY_EXPR(m_pMapContext);
+            m_pMapContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
+        }
+        CacheIt.second.Mapped.clear();
+    }
+}
+
+RefCntAutoPtr<UploadBufferGL> TextureUploaderGL::InternalData::FindCachedBuffer(const UploadBufferDesc& Desc, bool& IsMapped)
+{
+    IsMapped = false;
+
+    RefCntAutoPtr<UploadBufferGL> pUploadBuffer;
+    std::lock_guard<std::mutex>   CacheLock(m_UploadBuffCacheMtx);
+
+    auto CacheIt = m_UploadBufferCache.find(Desc);
+    if (CacheIt != m_UploadBufferCache.end())
+    {
+        auto& Mapped   = CacheIt->second.Mapped;
+        auto& Recycled = CacheIt->second.Recycled;
+        if (!Mapped.empty())
+        {
+            pUploadBuffer = std::move(Mapped.front());
+            Mapped.pop_front();
+            IsMapped = true;
+        }
+        else if (!Recycled.empty())
+        {
+            // The buffer will be mapped by the render thread
+            pUploadBuffer = std::move(Recycled.front());
+            Recycled.pop_front();
+            pUploadBuffer->Reset();
+        }
+    }
+
+    return pUploadBuffer;
 }
 
 void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
@@ -300,7 +488,6 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
                                             SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
                 }
             }
-            pBuffer->SignalCopyScheduled();
         }
         break;
     }
@@ -311,26 +498,9 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
                                              IUploadBuffer**         ppBuffer)
 {
     *ppBuffer = nullptr;
-    RefCntAutoPtr<UploadBufferGL> pUploadBuffer;
-
-    {
-        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
-        auto&                       Cache = m_pInternalData->m_UploadBufferCache;
-        if (!Cache.empty())
-        {
-            auto DequeIt = Cache.find(Desc);
-            if (DequeIt != Cache.end())
-            {
-                auto& Deque = DequeIt->second;
-                if (!Deque.empty())
-                {
-                    pUploadBuffer.Attach(Deque.front().Detach());
-                    Deque.pop_front();
-                }
-            }
-        }
-    }
 
+    bool IsMapped      = false;
+    auto pUploadBuffer = m_pInternalData->FindCachedBuffer(Desc, IsMapped);
     if (!pUploadBuffer)
     {
         pUploadBuffer = MakeNewRCObj<UploadBufferGL>()(Desc);
@@ -339,7 +509,12 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " texture");
     }
 
-    if (pContext != nullptr)
+    if (IsMapped)
+    {
+        // The buffer was mapped by the render thread when the GPU finished reading it
+        VERIFY_EXPR(pUploadBuffer->DbgIsMapped());
+    }
+    else if (pContext != nullptr)
     {
         // Render thread
         InternalData::PendingBufferOperation MapOp{InternalData::PendingBufferOperation::Operation::Map, pUploadBuffer};
@@ -373,6 +548,10 @@ void TextureUploaderGL::ScheduleGPUCopy(IDeviceContext* pContext,
                 MipLevel //
             };
         m_pInternalData->Execute(m_pDevice, pContext, CopyOp);
+
+        auto SignaledFenceValue = m_pInternalData->SignalFence(pContext);
+        pUploadBufferGL->SignalCopyScheduled(SignaledFenceValue);
+        m_pInternalData->UpdateCompletedFenceValue();
     }
     else
     {
@@ -385,12 +564,12 @@ void TextureUploaderGL::RecycleBuffer(IUploadBuffer* pUploadBuffer)
 {
     auto* pUploadBufferGL = ClassPtrCast<UploadBufferGL>(pUploadBuffer);
     VERIFY(pUploadBufferGL->DbgIsCopyScheduled(), "Upload buffer must be recycled only after copy operation has been scheduled on the GPU");
-    pUploadBufferGL->Reset();
 
+    // The buffer is reset and mapped again by the render thread when the GPU is done with it
     std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
 
     auto& Cache = m_pInternalData->m_UploadBufferCache;
-    auto& Deque = Cache[pUploadBufferGL->GetDesc()];
+    auto& Deque = Cache[pUploadBufferGL->GetDesc()].Recycled;
     Deque.emplace_back(pUploadBufferGL);
 }
 
@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+TransientResourceAllocator::TransientResourceAllocator(IRenderDevice* pDevice) :
+    m_pDevice{pDevice}
+{
+    VERIFY_EXPR(m_pDevice);
+}
+
+Uint32 TransientResourceAllocator::DeclareTexture(const TransientTextureDesc& Desc)
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "Textures can't be declared after Compile() has been called. Call Reset() to start a new frame.");
+    DEV_CHECK_ERR(Desc.FirstPass <= Desc.LastPass, "First pass (", Desc.FirstPass, ") of transient texture '",
+                  (Desc.Desc.Name != nullptr ? Desc.Desc.Name : ""), "' must not be greater than the last pass (", Desc.LastPass, ")");
+    DEV_CHECK_ERR(Desc.Desc.Usage == USAGE_DEFAULT, "Transient texture '", (Desc.Desc.Name != nullptr ? Desc.Desc.Name : ""),
+                  "' must use USAGE_DEFAULT");
+    if (m_IsCompiled || Desc.FirstPass > Desc.LastPass || Desc.Desc.Usage != USAGE_DEFAULT)
+        return InvalidHandle;
+
+    const auto Handle = static_cast<Uint32>(m_Declared.size());
+    m_Declared.push_back({Desc});
+    return Handle;
+}
+
+void TransientResourceAllocator::Compile()
+{
+    DEV_CHECK_ERR(!m_IsCompiled, "The allocator has already been compiled. Call Reset() to start a new frame.");
+
+    m_Stats = {};
+
+    m_Stats.NumDeclaredTextures = static_cast<Uint32>(m_Declared.size());
+
+    // Process textures in the order of their first use
+    std::vector<Uint32> Order(m_Declared.size());
+    std::iota(Order.begin(), Order.end(), 0u);
+    std::stable_sort(Order.begin(), Order.end(),
+                     [this](Uint32 lhs, Uint32 rhs) {
+                         return m_Declared[lhs].Desc.FirstPass < m_Declared[rhs].Desc.FirstPass;
+                     });
+
+    for (auto DeclIdx : Order)
+    {
+        auto& Decl = m_Declared[DeclIdx];
+
+        // Find a compatible physical texture that is free at the first pass.
+        // Prefer the texture that was released most recently to keep the others available
+        // for longer-living resources.
+        Uint32 BestIdx = InvalidHandle;
+        for (Uint32 i = 0; i < m_Physical.size(); ++i)
+        {
+            const auto& Phys = m_Physical[i];
+            if (Phys.LastPass != InvalidHandle && Phys.LastPass >= Decl.Desc.FirstPass)
+                continue;
+            if (!(Phys.pTexture->GetDesc() == Decl.Desc.Desc))
+                continue;
+
+            if (BestIdx == InvalidHandle)
+            {
+                BestIdx = i;
+            }
+            else
+            {
+                const auto BestLastPass = m_Physical[BestIdx].LastPass;
+                if (BestLastPass == InvalidHandle || (Phys.LastPass != InvalidHandle && Phys.LastPass > BestLastPass))
+                    BestIdx = i;
+            }
+        }
+
+        if (BestIdx == InvalidHandle)
+        {
+            PhysicalTexture Phys;
+            m_pDevice->CreateTexture(Decl.Desc.Desc, nullptr, &Phys.pTexture);
+            if (!Phys.pTexture)
+            {
+                LOG_ERROR_MESSAGE("Failed to create transient texture '", (Decl.Desc.Desc.Name != nullptr ? Decl.Desc.Desc.Name : ""), "'");
+                continue;
+            }
+
+            // Use the actual texture description as the number of mip levels may have been computed by the engine.
+            const auto& TexDesc = Phys.pTexture->GetDesc();
+            // Memoryless textures are not backed by device memory
+            Phys.MemorySize = (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0 ?
+                GetStagingTextureSubresourceOffset(TexDesc, TexDesc.GetArraySize(), 0, 4) :
+                0;
+
+            BestIdx = static_cast<Uint32>(m_Physical.size());
+            m_Physical.emplace_back(std::move(Phys));
+            ++m_Stats.NumCreatedTextures;
+        }
+
+        auto& Phys = m_Physical[BestIdx];
+        if (Phys.LastPass == InvalidHandle)
+        {
+            ++m_Stats.NumPhysicalTextures;
+            m_Stats.PhysicalMemorySize += Phys.MemorySize;
+        }
+        Phys.LastPass    = Decl.Desc.LastPass;
+        Decl.PhysicalIdx = BestIdx;
+
+        m_Stats.DeclaredMemorySize += Phys.MemorySize;
+    }
+
+    m_IsCompiled = true;
+}
+
+ITexture* TransientResourceAllocator::GetTexture(Uint32 Handle) const
+{
+    DEV_CHECK_ERR(m_IsCompiled, "Compile() must be called before physical textures can be queried");
+    if (Handle >= m_Declared.size())
+    {
+        DEV_ERROR("Transient texture handle (", Handle, ") is out of range");
+        return nullptr;
+    }
+
+    const auto PhysIdx = m_Declared[Handle].PhysicalIdx;
+    return PhysIdx != InvalidHandle ? m_Physical[PhysIdx].pTexture.RawPtr<ITexture>() : nullptr;
+}
+
+void TransientResourceAllocator::BeginPass(IDeviceContext* pContext, Uint32 Pass)
+{
+    DEV_CHECK_ERR(m_IsCompiled, "Compile() must be called before BeginPass()");
+    VERIFY_EXPR(pContext != nullptr);
+
+    m_Barriers.clear();
+    for (const auto& Decl : m_Declared)
+    {
+        if (Decl.Desc.FirstPass != Pass || Decl.Desc.InitialState == RESOURCE_STATE_UNKNOWN || Decl.PhysicalIdx == InvalidHandle)
+            continue;
+
+        // The previous contents of the physical texture belong to another transient
+        // resource (or to the previous frame) and can be discarded.
+        m_Barriers.emplace_back(m_Physical[Decl.PhysicalIdx].pTexture, RESOURCE_STATE_UNKNOWN, Decl.Desc.InitialState,
+                                STATE_TRANSITION_FLAG_UPDATE_STATE | STATE_TRANSITION_FLAG_DISCARD_CONTENT);
+    }
+
+    if (!m_Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+}
+
+void TransientResourceAllocator::Reset()
+{
+    m_Declared.clear();
+    for (auto& Phys : m_Physical)
+        Phys.LastPass = InvalidHandle;
+
+    m_IsCompiled = false;
+    m_Stats      = {};
+}
+
+void TransientResourceAllocator::ReleaseUnusedTextures()
+{
+    VERIFY(m_Declared.empty() || m_IsCompiled, "Releasing unused textures between declaration and compilation is not allowed");
+
+    // Remap physical indices of the declared textures
+    std::vector<Uint32> NewIndices(m_Physical.size(), InvalidHandle);
+
+    Uint32 NumKept = 0;
+    for (Uint32 i = 0; i < m_Physical.size(); ++i)
+    {
+        if (m_Physical[i].LastPass == InvalidHandle)
+            continue;
+
+        NewIndices[i] = NumKept;
+        if (NumKept != i)
+            m_Physical[NumKept] = std::move(m_Physical[i]);
+        ++NumKept;
+    }
+    m_Physical.resize(NumKept);
+
+    for (auto& Decl : m_Declared)
+    {
+        if (Decl.PhysicalIdx != InvalidHandle)
+            Decl.PhysicalIdx = NewIndices[Decl.PhysicalIdx];
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,353 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "VRSImageGenerator.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsUtilities.h"
+#include "MapHelper.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+const char* const VRSShaderSource = R"(
+#ifndef TILE_SIZE
+#   define TILE_SIZE 16
+#endif
+
+#define THREAD_GROUP_SIZE 8
+
+cbuffer cbVRSAttribs
+{
+    uint2  g_FrameSize;
+    uint2  g_ImageSize;
+    float2 g_MotionVectorScale;
+    float  g_ContrastThreshold;
+    float  g_MotionSensitivity;
+    uint4  g_RateRemap[3];
+};
+
+Texture2D<float4> g_Color;
+
+#if USE_MOTION_VECTORS
+Texture2D<float4> g_MotionVectors;
+#endif
+
+#if OUTPUT_DENSITY_MAP
+RWTexture2D<float2 /*format = rg8*/> g_RateImage;
+#else
+RWTexture2D<uint /*format = r8ui*/> g_RateImage;
+#endif
+
+groupshared float2 g_MaxGradient[THREAD_GROUP_SIZE * THREAD_GROUP_SIZE];
+groupshared float  g_MinMotion[THREAD_GROUP_SIZE * THREAD_GROUP_SIZE];
+
+float PerceivedLuminance(int2 Pixel)
+{
+    Pixel = clamp(Pixel, int2(0, 0), int2(g_FrameSize) - int2(1, 1));
+    float3 Color = g_Color.Load(int3(Pixel, 0)).rgb;
+    float  Luminance = max(dot(Color, float3(0.2126, 0.7152, 0.0722)), 0.0);
+    // Compress HDR values and apply approximate gamma
+    return sqrt(Luminance / (1.0 + Luminance));
+}
+
+// Returns the rate reduction along one axis: 0 - 1x, 1 - 2x, 2 - 4x
+uint GetAxisRate(float Gradient)
+{
+    if (Gradient * 3.0 < g_ContrastThreshold)
+        return 2u;
+    else if (Gradient < g_ContrastThreshold)
+        return 1u;
+    else
+        return 0u;
+}
+
+[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]
+void GenerateCS(uint3 Gid  : SV_GroupID,
+                uint3 GTid : SV_GroupThreadID,
+                uint  GI   : SV_GroupIndex)
+{
+    float2 MaxGradient = float2(0.0, 0.0);
+    float  MinMotion   = 1e+30;
+    for (uint y = GTid.y; y < TILE_SIZE; y += THREAD_GROUP_SIZE)
+    {
+        for (uint x = GTid.x; x < TILE_SIZE; x += THREAD_GROUP_SIZE)
+        {
+            uint2 Pixel = Gid.xy * TILE_SIZE + uint2(x, y);
+            if (Pixel.x >= g_FrameSize.x || Pixel.y >= g_FrameSize.y)
+                continue;
+
+            float2 Motion = float2(0.0, 0.0);
+#if USE_MOTION_VECTORS
+            Motion = g_MotionVectors.Load(int3(Pixel, 0)).xy * g_MotionVectorScale;
+#endif
+            // Assume that the motion continues and find the pixel in the previous frame
+            int2 SrcPixel = int2(floor(float2(Pixel) - Motion + float2(0.5, 0.5)));
+
+            float Luminance  = PerceivedLuminance(SrcPixel);
+            float LuminanceX = PerceivedLuminance(SrcPixel + int2(1, 0));
+            float LuminanceY = PerceivedLuminance(SrcPixel + int2(0, 1));
+            MaxGradient = max(MaxGradient, abs(float2(LuminanceX, LuminanceY) - float2(Luminance, Luminance)));
+            MinMotion   = min(MinMotion, length(Motion));
+        }
+    }
+    g_MaxGradient[GI] = MaxGradient;
+    g_MinMotion[GI]   = MinMotion;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (GI != 0u || Gid.x >= g_ImageSize.x || Gid.y >= g_ImageSize.y)
+        return;
+
+    for (uint i = 1u; i < THREAD_GROUP_SIZE * THREAD_GROUP_SIZE; ++i)
+    {
+        MaxGradient = max(MaxGradient, g_MaxGradient[i]);
+        MinMotion   = min(MinMotion, g_MinMotion[i]);
+    }
+    // Fast-moving content is blurred and can be shaded at a lower rate
+    MaxGradient /= 1.0 + g_MotionSensitivity * MinMotion;
+
+    uint RateX = GetAxisRate(MaxGradient.x);
+    uint RateY = GetAxisRate(MaxGradient.y);
+#if OUTPUT_DENSITY_MAP
+    g_RateImage[Gid.xy] = float2(1.0 / float(1u << RateX), 1.0 / float(1u << RateY));
+#else
+    uint Rate = (RateX << 2u) | RateY;
+    g_RateImage[Gid.xy] = g_RateRemap[Rate / 4u][Rate % 4u];
+#endif
+}
+)";
+// clang-format on
+
+struct VRSAttribsCB
+{
+    Uint32 FrameWidth;
+    Uint32 FrameHeight;
+    Uint32 ImageWidth;
+    Uint32 ImageHeight;
+    float2 MotionVectorScale;
+    float  ContrastThreshold;
+    float  MotionSensitivity;
+    Uint32 RateRemap[12];
+};
+
+Uint32 GetDefaultTileSize(IRenderDevice* pDevice)
+{
+    const auto& SRProps = pDevice->GetAdapterInfo().ShadingRate;
+    return std::max(SRProps.MaxTileSize[0], SRProps.MaxTileSize[1]);
+}
+
+} // namespace
+
+VRSImageGenerator::VRSImageGenerator(const CreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_TileSize{CI.TileSize != 0 || CI.pDevice == nullptr ? CI.TileSize : GetDefaultTileSize(CI.pDevice)},
+    m_UseDensityMap{CI.pDevice != nullptr && CI.pDevice->GetAdapterInfo().ShadingRate.Format == SHADING_RATE_FORMAT_UNORM8}
+{
+    if (!m_pDevice)
+        LOG_ERROR_AND_THROW("Device must not be null");
+
+    const auto& DeviceInfo = m_pDevice->GetDeviceInfo();
+    const auto& SRProps    = m_pDevice->GetAdapterInfo().ShadingRate;
+    if (!DeviceInfo.Features.VariableRateShading || (SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0)
+        LOG_ERROR_AND_THROW("Texture-based variable rate shading is not supported by this device");
+    if (!DeviceInfo.Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("VRS image generator requires compute shaders");
+    if (SRProps.Format != SHADING_RATE_FORMAT_PALETTE && SRProps.Format != SHADING_RATE_FORMAT_UNORM8)
+        LOG_ERROR_AND_THROW("Shading rate texture format is not supported");
+    if (m_TileSize == 0 || (m_TileSize & (m_TileSize - 1)) != 0)
+        LOG_ERROR_AND_THROW("Tile size (", m_TileSize, ") must be a power of two");
+
+    // Find the supported rate that does not exceed the rate along any axis and reduces the shading most
+    for (Uint32 Rate = 0; Rate < _countof(m_RateRemap); ++Rate)
+    {
+        const Uint32 RateX   = Rate >> DILIGENT_SHADING_RATE_X_SHIFT;
+        const Uint32 RateY   = Rate & ((1u << DILIGENT_SHADING_RATE_X_SHIFT) - 1u);
+        Uint32       BestSum = 0;
+        m_RateRemap[Rate]    = SHADING_RATE_1X1;
+        for (Uint32 i = 0; i < SRProps.NumShadingRates; ++i)
+        {
+            const auto& Mode = SRProps.ShadingRates[i];
+            if (!Mode.HasSampleCount(CI.SampleCount))
+                continue;
+
+            const Uint32 ModeX = Mode.Rate >> DILIGENT_SHADING_RATE_X_SHIFT;
+            const Uint32 ModeY = Mode.Rate & ((1u << DILIGENT_SHADING_RATE_X_SHIFT) - 1u);
+            if (ModeX <= RateX && ModeY <= RateY && ModeX + ModeY > BestSum)
+            {
+                m_RateRemap[Rate] = Mode.Rate;
+                BestSum           = ModeX + ModeY;
+            }
+        }
+    }
+
+    m_UseIntermediateTexture = (SRProps.BindFlags & BIND_UNORDERED_ACCESS) == 0;
+
+    CreateUniformBuffer(m_pDevice, sizeof(VRSAttribsCB), "VRS image generator attribs CB", &m_pAttribsCB);
+    if (!m_pAttribsCB)
+        LOG_ERROR_AND_THROW("Failed to create VRS attribs buffer");
+
+    CreatePipelines();
+}
+
+VRSImageGenerator::~VRSImageGenerator()
+{
+}
+
+void VRSImageGenerator::CreatePipelines()
+{
+    for (Uint32 PSOIdx = 0; PSOIdx < PSO_INDEX_COUNT; ++PSOIdx)
+    {
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro("TILE_SIZE", m_TileSize);
+        Macros.AddShaderMacro("USE_MOTION_VECTORS", PSOIdx == PSO_INDEX_COLOR_AND_MOTION);
+        Macros.AddShaderMacro("OUTPUT_DENSITY_MAP", m_UseDensityMap);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Desc           = {"VRS image generator CS", SHADER_TYPE_COMPUTE, true};
+        ShaderCI.EntryPoint     = "GenerateCS";
+        ShaderCI.Source         = VRSShaderSource;
+        ShaderCI.Macros         = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            LOG_ERROR_AND_THROW("Failed to create VRS image generator shader");
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = "VRS image generator PSO";
+        PSOCreateInfo.PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        PSOCreateInfo.pCS                                        = pCS;
+
+        m_pDevice->CreateComputePipelineState(PSOCreateInfo, &m_pPSO[PSOIdx]);
+        if (!m_pPSO[PSOIdx])
+            LOG_ERROR_AND_THROW("Failed to create VRS image generator pipeline");
+
+        m_pPSO[PSOIdx]->CreateShaderResourceBinding(&m_pSRB[PSOIdx], true);
+        VERIFY_EXPR(m_pSRB[PSOIdx]);
+        m_pSRB[PSOIdx]->GetVariableByName(SHADER_TYPE_COMPUTE, "cbVRSAttribs")->Set(m_pAttribsCB);
+    }
+}
+
+void VRSImageGenerator::CreateTextures(Uint32 FrameWidth, Uint32 FrameHeight)
+{
+    m_pTexture.Release();
+    m_pIntermediateTexture.Release();
+    m_FrameWidth  = 0;
+    m_FrameHeight = 0;
+
+    TextureDesc Desc;
+    Desc.Name      = "VRS image";
+    Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Desc.Width     = (FrameWidth + m_TileSize - 1) / m_TileSize;
+    Desc.Height    = (FrameHeight + m_TileSize - 1) / m_TileSize;
+    Desc.Format    = m_UseDensityMap ? TEX_FORMAT_RG8_UNORM : TEX_FORMAT_R8_UINT;
+    Desc.BindFlags = BIND_SHADING_RATE | (m_UseIntermediateTexture ? BIND_NONE : BIND_UNORDERED_ACCESS);
+
+    m_pDevice->CreateTexture(Desc, nullptr, &m_pTexture);
+    if (!m_pTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to create ", Desc.Width, "x", Desc.Height, " VRS image");
+        return;
+    }
+
+    if (m_UseIntermediateTexture)
+    {
+        Desc.Name      = "VRS image intermediate texture";
+        Desc.BindFlags = BIND_UNORDERED_ACCESS;
+        m_pDevice->CreateTexture(Desc, nullptr, &m_pIntermediateTexture);
+        if (!m_pIntermediateTexture)
+        {
+            LOG_ERROR_MESSAGE("Failed to create VRS image intermediate texture");
+            m_pTexture.Release();
+            return;
+        }
+    }
+
+    auto* pOutputTexture = m_UseIntermediateTexture ? m_pIntermediateTexture.RawPtr() : m_pTexture.RawPtr();
+    for (auto& pSRB : m_pSRB)
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_RateImage")->Set(pOutputTexture->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    m_FrameWidth  = FrameWidth;
+    m_FrameHeight = FrameHeight;
+}
+
+void VRSImageGenerator::Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    DEV_CHECK_ERR(Attribs.pColorSRV != nullptr, "Color view must not be null");
+    DEV_CHECK_ERR(Attribs.ContrastThreshold >= 0, "Contrast threshold must not be negative");
+
+    const auto& ColorDesc = Attribs.pColorSRV->GetTexture()->GetDesc();
+    if (!m_pTexture || m_FrameWidth != ColorDesc.Width || m_FrameHeight != ColorDesc.Height)
+    {
+        CreateTextures(ColorDesc.Width, ColorDesc.Height);
+        if (!m_pTexture)
+            return;
+    }
+
+    const auto& ImageDesc = m_pTexture->GetDesc();
+    {
+        MapHelper<VRSAttribsCB> CBData{pContext, m_pAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+        CBData->FrameWidth        = m_FrameWidth;
+        CBData->FrameHeight       = m_FrameHeight;
+        CBData->ImageWidth        = ImageDesc.Width;
+        CBData->ImageHeight       = ImageDesc.Height;
+        CBData->MotionVectorScale = Attribs.MotionVectorScale;
+        CBData->ContrastThreshold = Attribs.ContrastThreshold;
+        CBData->MotionSensitivity = Attribs.MotionSensitivity;
+        for (size_t i = 0; i < _countof(m_RateRemap); ++i)
+            CBData->RateRemap[i] = m_RateRemap[i];
+    }
+
+    const auto PSOIdx = Attribs.pMotionVectorsSRV != nullptr ? PSO_INDEX_COLOR_AND_MOTION : PSO_INDEX_COLOR;
+    auto*      pSRB   = m_pSRB[PSOIdx].RawPtr();
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Color")->Set(Attribs.pColorSRV);
+    if (Attribs.pMotionVectorsSRV != nullptr)
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MotionVectors")->Set(Attribs.pMotionVectorsSRV);
+
+    pContext->SetPipelineState(m_pPSO[PSOIdx]);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchComputeAttribs{ImageDesc.Width, ImageDesc.Height, 1});
+
+    if (m_pIntermediateTexture)
+    {
+        CopyTextureAttribs CopyAttribs{m_pIntermediateTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                       m_pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+    }
+}
+
+} // namespace Diligent
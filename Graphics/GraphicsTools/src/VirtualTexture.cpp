@@ -0,0 +1,503 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "VirtualTexture.hpp"
+
+#include <algorithm>
+
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+VirtualTexture::VirtualTexture(IRenderDevice* pDevice, const VirtualTextureCreateInfo& CI) :
+    m_CI{CI},
+    m_pDevice{pDevice},
+    // Feedback callbacks only decode the requests, so they run on the render thread
+    m_FeedbackReadback{GPUReadbackQueue::CreateInfo{pDevice, nullptr}},
+    m_StreamingQueue{CI.Streaming}
+{
+    DEV_CHECK_ERR(m_pDevice, "Device must not be null");
+    DEV_CHECK_ERR(m_CI.Width > 0 && m_CI.Height > 0, "Texture dimensions must not be zero");
+    DEV_CHECK_ERR(m_CI.NumPhysicalPages > 0, "The number of physical pages must not be zero");
+    DEV_CHECK_ERR(m_CI.FeedbackBufferSize > 0, "Feedback buffer size must not be zero");
+    DEV_CHECK_ERR(m_CI.LoadTile, "Tile loader must not be null");
+
+    if (m_pDevice->GetDeviceInfo().IsMetalDevice())
+    {
+        // In Metal, sparse textures must be created from the memory object by IRenderDeviceMtl::CreateSparseTexture()
+        LOG_ERROR_MESSAGE("Virtual textures are not currently supported in Metal");
+        return;
+    }
+
+    {
+        TextureDesc Desc;
+        Desc.Name      = m_CI.Name;
+        Desc.Type      = RESOURCE_DIM_TEX_2D;
+        Desc.Width     = m_CI.Width;
+        Desc.Height    = m_CI.Height;
+        Desc.MipLevels = m_CI.MipLevels;
+        Desc.Format    = m_CI.Format;
+        Desc.BindFlags = BIND_SHADER_RESOURCE;
+        Desc.Usage     = USAGE_SPARSE;
+        m_pDevice->CreateTexture(Desc, nullptr, &m_pTexture);
+        if (!m_pTexture)
+        {
+            LOG_ERROR_MESSAGE("Failed to create sparse texture '", (m_CI.Name != nullptr ? m_CI.Name : ""), "'");
+            return;
+        }
+    }
+
+    const auto& TexDesc = m_pTexture->GetDesc();
+    const auto& Props   = m_pTexture->GetSparseProperties();
+
+    m_TileWidth      = Props.TileSize[0];
+    m_TileHeight     = Props.TileSize[1];
+    m_FirstMipInTail = std::min(Props.FirstMipInTail, TexDesc.MipLevels);
+    m_PageSize       = Props.BlockSize;
+    VERIFY(m_FirstMipInTail < 32, "Mip level must fit into the feedback encoding");
+
+    // The mip tail is always resident and occupies the first pages of the pool
+    const auto NumMipTailPages = static_cast<Uint32>(m_FirstMipInTail < TexDesc.MipLevels ? Props.MipTailSize / m_PageSize : 0);
+    if (m_CI.NumPhysicalPages <= NumMipTailPages)
+    {
+        LOG_ERROR_MESSAGE("The physical page pool (", m_CI.NumPhysicalPages, " pages) must be larger than the mip tail (", NumMipTailPages, " pages)");
+        m_pTexture.Release();
+        return;
+    }
+    m_FreePages.reserve(m_CI.NumPhysicalPages - NumMipTailPages);
+    for (Uint32 Page = m_CI.NumPhysicalPages; Page > NumMipTailPages; --Page)
+        m_FreePages.push_back(Page - 1);
+
+    {
+        IDeviceObject* pCompatibleRes = m_pTexture;
+
+        DeviceMemoryCreateInfo MemCI;
+        MemCI.Desc.Name             = "Virtual texture page pool";
+        MemCI.Desc.Type             = DEVICE_MEMORY_TYPE_SPARSE;
+        MemCI.Desc.PageSize         = m_PageSize;
+        MemCI.InitialSize           = Uint64{m_CI.NumPhysicalPages} * m_PageSize;
+        MemCI.ppCompatibleResources = &pCompatibleRes;
+        MemCI.NumResources          = 1;
+        m_pDevice->CreateDeviceMemory(MemCI, &m_pMemory);
+        if (!m_pMemory)
+        {
+            LOG_ERROR_MESSAGE("Failed to create the physical page pool");
+            m_pTexture.Release();
+            return;
+        }
+    }
+
+    {
+        m_ResidencyWidth  = (m_CI.Width + m_TileWidth - 1) / m_TileWidth;
+        m_ResidencyHeight = (m_CI.Height + m_TileHeight - 1) / m_TileHeight;
+        m_Residency.resize(size_t{m_ResidencyWidth} * size_t{m_ResidencyHeight}, static_cast<Uint8>(m_FirstMipInTail));
+
+        TextureDesc Desc;
+        Desc.Name      = "Virtual texture residency";
+        Desc.Type      = RESOURCE_DIM_TEX_2D;
+        Desc.Width     = m_ResidencyWidth;
+        Desc.Height    = m_ResidencyHeight;
+        Desc.Format    = TEX_FORMAT_R8_UINT;
+        Desc.BindFlags = BIND_SHADER_RESOURCE;
+        Desc.Usage     = USAGE_DEFAULT;
+
+        TextureSubResData SubresData{m_Residency.data(), m_ResidencyWidth};
+        TextureData       InitData{&SubresData, 1};
+        m_pDevice->CreateTexture(Desc, &InitData, &m_pResidencyTex);
+        DEV_CHECK_ERR(m_pResidencyTex, "Failed to create residency texture");
+    }
+
+    {
+        m_ZeroFeedback.resize(m_CI.FeedbackBufferSize);
+
+        BufferDesc Desc;
+        Desc.Name              = "Virtual texture feedback";
+        Desc.Size              = Uint64{m_CI.FeedbackBufferSize} * sizeof(Uint32);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_SHADER_RESOURCE;
+        Desc.Mode              = BUFFER_MODE_STRUCTURED;
+        Desc.ElementByteStride = sizeof(Uint32);
+        Desc.Usage             = USAGE_DEFAULT;
+
+        BufferData InitData{m_ZeroFeedback.data(), Desc.Size};
+        m_pDevice->CreateBuffer(Desc, &InitData, &m_pFeedbackBuffer);
+        DEV_CHECK_ERR(m_pFeedbackBuffer, "Failed to create feedback buffer");
+    }
+
+    {
+        FenceDesc Desc;
+        Desc.Type = FENCE_TYPE_GENERAL;
+
+        Desc.Name = "Virtual texture render fence";
+        m_pDevice->CreateFence(Desc, &m_pRenderFence);
+        Desc.Name = "Virtual texture bind fence";
+        m_pDevice->CreateFence(Desc, &m_pBindFence);
+        DEV_CHECK_ERR(m_pRenderFence && m_pBindFence, "Failed to create fences");
+    }
+
+    // Bind the mip tail to the first pages of the pool
+    for (Uint64 OffsetInMipTail = 0; OffsetInMipTail < Uint64{NumMipTailPages} * m_PageSize; OffsetInMipTail += m_PageSize)
+    {
+        m_PendingBinds.emplace_back();
+        auto& Range           = m_PendingBinds.back();
+        Range.MipLevel        = m_FirstMipInTail;
+        Range.OffsetInMipTail = OffsetInMipTail;
+        Range.MemoryOffset    = OffsetInMipTail;
+        Range.MemorySize      = m_PageSize;
+        Range.pMemory         = m_pMemory;
+    }
+}
+
+VirtualTexture::~VirtualTexture()
+{
+    // Load tasks reference this object
+    for (auto& pTask : m_LoadTasks)
+    {
+        if (!m_CI.pThreadPool->RemoveTask(pTask, /*CancelIfRunning = */ false))
+            pTask->WaitForCompletion();
+    }
+}
+
+Box VirtualTexture::GetTileRegion(Uint32 Key) const
+{
+    const auto Mip       = UnpackMip(Key);
+    const auto MipWidth  = std::max(m_CI.Width >> Mip, 1u);
+    const auto MipHeight = std::max(m_CI.Height >> Mip, 1u);
+
+    Box Region;
+    Region.MinX = UnpackTileX(Key) * m_TileWidth;
+    Region.MaxX = std::min(Region.MinX + m_TileWidth, MipWidth);
+    Region.MinY = UnpackTileY(Key) * m_TileHeight;
+    Region.MaxY = std::min(Region.MinY + m_TileHeight, MipHeight);
+    return Region;
+}
+
+bool VirtualTexture::IsValidTile(Uint32 Key) const
+{
+    const auto Mip = UnpackMip(Key);
+    if (Mip >= m_FirstMipInTail)
+        return false;
+
+    return UnpackTileX(Key) * m_TileWidth < std::max(m_CI.Width >> Mip, 1u) &&
+        UnpackTileY(Key) * m_TileHeight < std::max(m_CI.Height >> Mip, 1u);
+}
+
+bool VirtualTexture::IsResident(Uint32 Key) const
+{
+    auto it = m_Tiles.find(Key);
+    return it != m_Tiles.end() && it->second.TileState == Tile::State::Resident;
+}
+
+void VirtualTexture::LoadTile(Uint32 MipLevel, const Box& Region, Uint32 Key)
+{
+    auto Load = [this, MipLevel, Region, Key]() {
+        const auto CopyInfo = GetBufferToTextureCopyInfo(m_CI.Format, Region, 4);
+
+        std::vector<Uint8> Data(static_cast<size_t>(CopyInfo.MemorySize));
+        m_CI.LoadTile(MipLevel, Region, Data.data(), CopyInfo.RowStride);
+
+        TextureStreamingQueue::UploadRequest Req;
+        Req.pTexture = m_pTexture;
+        Req.MipLevel = MipLevel;
+        Req.Region   = Region;
+        Req.pData    = Data.data();
+        Req.Stride   = CopyInfo.RowStride;
+        if (Key != 0)
+            Req.OnUploaded = [this, Key]() { OnTileUploaded(Key); };
+        m_StreamingQueue.Enqueue(Req);
+    };
+
+    if (m_CI.pThreadPool != nullptr)
+    {
+        m_LoadTasks.emplace_back(EnqueueAsyncWork(m_CI.pThreadPool,
+                                                  [Load](Uint32 /*ThreadId*/) {
+                                                      Load();
+                                                  }));
+    }
+    else
+    {
+        Load();
+    }
+}
+
+void VirtualTexture::InitMipTail()
+{
+    const auto& TexDesc = m_pTexture->GetDesc();
+    for (Uint32 Mip = m_FirstMipInTail; Mip < TexDesc.MipLevels; ++Mip)
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, Mip);
+        LoadTile(Mip, Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight}, 0);
+    }
+    m_MipTailLoaded = true;
+}
+
+void VirtualTexture::EvictTile(Uint32 Key)
+{
+    auto it = m_Tiles.find(Key);
+    VERIFY_EXPR(it != m_Tiles.end() && it->second.TileState == Tile::State::Resident);
+
+    m_LRU.erase(it->second.LRUPos);
+    m_FreePages.push_back(it->second.Page);
+    m_Tiles.erase(it);
+    UpdateResidency(Key);
+
+    m_PendingBinds.emplace_back();
+    auto& Range      = m_PendingBinds.back();
+    Range.MipLevel   = UnpackMip(Key);
+    Range.Region     = GetTileRegion(Key);
+    Range.MemorySize = m_PageSize;
+    Range.pMemory    = nullptr;
+
+    ++m_NumEvictions;
+}
+
+void VirtualTexture::ProcessRequests()
+{
+    std::vector<Uint32> Requests;
+    Requests.swap(m_RequestedTiles);
+
+    // Request the coarser tiles as well, so that the mip chain above every requested tile becomes resident
+    const auto NumRequests = Requests.size();
+    for (size_t i = 0; i < NumRequests; ++i)
+    {
+        auto       TileX = UnpackTileX(Requests[i]);
+        auto       TileY = UnpackTileY(Requests[i]);
+        const auto Mip   = UnpackMip(Requests[i]);
+        for (Uint32 ParentMip = Mip + 1; ParentMip < m_FirstMipInTail; ++ParentMip)
+        {
+            // Tiles have the same size in texels on every level
+            TileX /= 2;
+            TileY /= 2;
+            Requests.push_back(PackFeedback(ParentMip, TileX, TileY));
+        }
+    }
+    std::sort(Requests.begin(), Requests.end(),
+              [](Uint32 Key0, Uint32 Key1) {
+                  return UnpackMip(Key0) != UnpackMip(Key1) ? UnpackMip(Key0) < UnpackMip(Key1) : Key0 < Key1;
+              });
+    Requests.erase(std::unique(Requests.begin(), Requests.end()), Requests.end());
+    Requests.erase(std::remove_if(Requests.begin(), Requests.end(), [this](Uint32 Key) { return !IsValidTile(Key); }), Requests.end());
+
+    // Touch the resident tiles from fine to coarse, so that coarser tiles are more recently
+    // used and are evicted after their children.
+    for (auto Key : Requests)
+    {
+        auto it = m_Tiles.find(Key);
+        if (it == m_Tiles.end())
+            continue;
+
+        it->second.LastUseFrame = m_FrameId;
+        if (it->second.TileState == Tile::State::Resident)
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+    }
+
+    // Allocate pages from coarse to fine, so that the coarser tiles get pages first
+    // when the pool is exhausted.
+    for (auto req_it = Requests.rbegin(); req_it != Requests.rend(); ++req_it)
+    {
+        const auto Key = *req_it;
+        if (m_Tiles.find(Key) != m_Tiles.end())
+            continue;
+
+        if (m_FreePages.empty())
+        {
+            // Tiles used in this frame are never evicted
+            if (m_LRU.empty() || m_Tiles[m_LRU.back()].LastUseFrame == m_FrameId)
+                break;
+            EvictTile(m_LRU.back());
+        }
+
+        Tile NewTile;
+        NewTile.Page         = m_FreePages.back();
+        NewTile.LastUseFrame = m_FrameId;
+        m_FreePages.pop_back();
+        m_Tiles.emplace(Key, NewTile);
+
+        const auto Region = GetTileRegion(Key);
+
+        m_PendingBinds.emplace_back();
+        auto& Range        = m_PendingBinds.back();
+        Range.MipLevel     = UnpackMip(Key);
+        Range.Region       = Region;
+        Range.MemoryOffset = Uint64{NewTile.Page} * m_PageSize;
+        Range.MemorySize   = m_PageSize;
+        Range.pMemory      = m_pMemory;
+
+        LoadTile(UnpackMip(Key), Region, Key);
+    }
+}
+
+void VirtualTexture::BindPages(IDeviceContext* pContext)
+{
+    if (m_PendingBinds.empty())
+        return;
+
+    SparseTextureMemoryBindInfo SparseTexBind;
+    SparseTexBind.pTexture  = m_pTexture;
+    SparseTexBind.NumRanges = static_cast<Uint32>(m_PendingBinds.size());
+    SparseTexBind.pRanges   = m_PendingBinds.data();
+
+    BindSparseResourceMemoryAttribs BindAttribs;
+    BindAttribs.NumTextureBinds = 1;
+    BindAttribs.pTextureBinds   = &SparseTexBind;
+
+    auto* pBindCtx = m_CI.pSparseBindingContext != nullptr ? m_CI.pSparseBindingContext : pContext;
+    if (pBindCtx != pContext)
+    {
+        // Evicted pages may still be used by the rendering commands, so the binding queue
+        // waits for them, and the render queue waits for the binding before the uploads.
+        IFence*      pRenderFence = m_pRenderFence;
+        const Uint64 RenderValue  = ++m_RenderFenceVal;
+        pContext->EnqueueSignal(m_pRenderFence, RenderValue);
+        pContext->Flush();
+
+        IFence*      pBindFence = m_pBindFence;
+        const Uint64 BindValue  = ++m_BindFenceVal;
+
+        BindAttribs.ppWaitFences       = &pRenderFence;
+        BindAttribs.pWaitFenceValues   = &RenderValue;
+        BindAttribs.NumWaitFences      = 1;
+        BindAttribs.ppSignalFences     = &pBindFence;
+        BindAttribs.pSignalFenceValues = &BindValue;
+        BindAttribs.NumSignalFences    = 1;
+        pBindCtx->BindSparseResourceMemory(BindAttribs);
+
+        pContext->DeviceWaitForFence(m_pBindFence, BindValue);
+    }
+    else
+    {
+        pContext->BindSparseResourceMemory(BindAttribs);
+    }
+
+    m_PendingBinds.clear();
+}
+
+void VirtualTexture::OnTileUploaded(Uint32 Key)
+{
+    auto it = m_Tiles.find(Key);
+    VERIFY_EXPR(it != m_Tiles.end() && it->second.TileState == Tile::State::Loading);
+
+    auto& T     = it->second;
+    T.TileState = Tile::State::Resident;
+    m_LRU.push_front(Key);
+    T.LRUPos = m_LRU.begin();
+
+    UpdateResidency(Key);
+}
+
+void VirtualTexture::UpdateResidency(Uint32 Key)
+{
+    const auto Mip = UnpackMip(Key);
+
+    // Residency texels covered by the tile
+    const auto MinX = UnpackTileX(Key) << Mip;
+    const auto MinY = UnpackTileY(Key) << Mip;
+    const auto MaxX = std::min(MinX + (1u << Mip), m_ResidencyWidth);
+    const auto MaxY = std::min(MinY + (1u << Mip), m_ResidencyHeight);
+
+    for (Uint32 y = MinY; y < MaxY; ++y)
+    {
+        for (Uint32 x = MinX; x < MaxX; ++x)
+        {
+            // The finest level whose tile and all coarser tiles are resident
+            Uint32 FinestMip = m_FirstMipInTail;
+            while (FinestMip > 0 && IsResident(PackFeedback(FinestMip - 1, x >> (FinestMip - 1), y >> (FinestMip - 1))))
+                --FinestMip;
+            m_Residency[size_t{y} * m_ResidencyWidth + x] = static_cast<Uint8>(FinestMip);
+        }
+    }
+
+    if (m_DirtyResidency.IsValid())
+    {
+        m_DirtyResidency.MinX = std::min(m_DirtyResidency.MinX, MinX);
+        m_DirtyResidency.MaxX = std::max(m_DirtyResidency.MaxX, MaxX);
+        m_DirtyResidency.MinY = std::min(m_DirtyResidency.MinY, MinY);
+        m_DirtyResidency.MaxY = std::max(m_DirtyResidency.MaxY, MaxY);
+    }
+    else
+    {
+        m_DirtyResidency = Box{MinX, MaxX, MinY, MaxY};
+    }
+}
+
+void VirtualTexture::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Context must not be null");
+    if (!m_pTexture)
+        return;
+
+    ++m_FrameId;
+
+    if (!m_MipTailLoaded)
+        InitMipTail();
+
+    // Read back the feedback written by the commands recorded so far, and clear it for the next frame
+    const auto FeedbackSize = Uint64{m_CI.FeedbackBufferSize} * sizeof(Uint32);
+    m_FeedbackReadback.ReadBuffer(pContext, m_pFeedbackBuffer, 0, FeedbackSize,
+                                  [this](const GPUReadbackQueue::ReadbackData& Data) {
+                                      if (Data.pData == nullptr)
+                                          return;
+                                      const auto* pEntries = static_cast<const Uint32*>(Data.pData);
+                                      for (size_t i = 0; i < Data.DataSize / sizeof(Uint32); ++i)
+                                      {
+                                          if (pEntries[i] != 0)
+                                              m_RequestedTiles.push_back(pEntries[i]);
+                                      }
+                                  });
+    pContext->UpdateBuffer(m_pFeedbackBuffer, 0, FeedbackSize, m_ZeroFeedback.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    m_FeedbackReadback.Process(pContext);
+
+    ProcessRequests();
+    BindPages(pContext);
+
+    m_StreamingQueue.Update(pContext);
+
+    m_LoadTasks.erase(std::remove_if(m_LoadTasks.begin(), m_LoadTasks.end(),
+                                     [](const RefCntAutoPtr<IAsyncTask>& pTask) { return pTask->IsFinished(); }),
+                      m_LoadTasks.end());
+
+    if (m_DirtyResidency.IsValid())
+    {
+        TextureSubResData SubresData{&m_Residency[size_t{m_DirtyResidency.MinY} * m_ResidencyWidth + m_DirtyResidency.MinX], m_ResidencyWidth};
+        pContext->UpdateTexture(m_pResidencyTex, 0, 0, m_DirtyResidency, SubresData,
+                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_DirtyResidency = Box{};
+    }
+}
+
+VirtualTextureStats VirtualTexture::GetStats()
+{
+    VirtualTextureStats Stats;
+    Stats.NumResidentTiles = static_cast<Uint32>(m_LRU.size());
+    Stats.NumLoadingTiles  = static_cast<Uint32>(m_Tiles.size() - m_LRU.size());
+    Stats.NumFreePages     = static_cast<Uint32>(m_FreePages.size());
+    Stats.NumEvictions     = m_NumEvictions;
+    return Stats;
+}
+
+} // namespace Diligent
@@ -61,6 +61,16 @@ XXH128Hash XXH128State::Digest() noexcept
 }
 
 void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
+{
+    UpdateShaderCreateInfo(ShaderCI, nullptr);
+}
+
+void XXH128State::Update(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache& IncludeCache) noexcept
+{
+    UpdateShaderCreateInfo(ShaderCI, &IncludeCache);
+}
+
+void XXH128State::UpdateShaderCreateInfo(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache) noexcept
 {
     ASSERT_SIZEOF64(ShaderCI, 144, "Did you add new members to ShaderCreateInfo? Please handle them here.");
 
@@ -78,9 +88,11 @@ void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "ShaderCI.ByteCode must be null when either Source or FilePath is specified");
-        ProcessShaderIncludes(ShaderCI, [this](const ShaderIncludePreprocessInfo& ProcessInfo) {
-            UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
-        });
+        ProcessShaderIncludes(
+            ShaderCI, [this](const ShaderIncludePreprocessInfo& ProcessInfo) {
+                UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
+            },
+            pIncludeCache);
     }
     else if (ShaderCI.ByteCode != nullptr && ShaderCI.ByteCodeSize != 0)
     {
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -88,6 +90,8 @@ struct FunctionStubHashKey
     };
 };
 
+class HLSL2GLSLTokenCache;
+
 /// HLSL to GLSL shader source code converter implementation
 class HLSL2GLSLConverterImpl
 {
@@ -134,6 +138,10 @@ public:
         /// This requires separate shader objects extension:
         /// https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
         bool                                UseInOutLocationQualifiers = true;
+
+        /// Optional cache of tokenized sources. If not null, sources that are identical after
+        /// the includes are inserted are tokenized only once.
+        HLSL2GLSLTokenCache*                pTokenCache                = nullptr;
     };
 
     // clang-format on
@@ -156,13 +164,20 @@ public:
     ///                             the input stream factory using InputFileName.
     /// \param [in] NumSymbols    - Number of symbols in the HLSLSource string
     /// \prarm [out] ppStream     - Memory address where pointer to the created stream will be written
+    /// \param [in] pTokenCache   - Optional cache of tokenized sources.
+    ///
+    /// \remarks   The stream does not modify the tokenized source, so it can be used
+    ///            by multiple threads simultaneously.
     void CreateStream(const Char*                      InputFileName,
                       IShaderSourceInputStreamFactory* pSourceStreamFactory,
                       const Char*                      HLSLSource,
                       size_t                           NumSymbols,
-                      IHLSL2GLSLConversionStream**     ppStream) const;
+                      IHLSL2GLSLConversionStream**     ppStream,
+                      HLSL2GLSLTokenCache*             pTokenCache = nullptr) const;
 
 private:
+    friend HLSL2GLSLTokenCache;
+
     HLSL2GLSLConverterImpl();
 
     struct HLSLObjectInfo
@@ -348,6 +363,8 @@ private:
     };
     typedef std::list<TokenInfo> TokenListType;
 
+    TokenListType Tokenize(const String& Source) const;
+
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
     {
@@ -369,13 +386,16 @@ private:
         /// \param [in] NumSymbols    - Number of symbols in the HLSLSource string
         /// \param [in] bPreserveTokens - Whether to preserve original tokens. This must be set to true if the stream
         ///                               will be used for multiple conversions.
+        /// \param [in] pTokenCache   - Optional cache of tokenized sources. If not null, the tokens are
+        ///                             taken from the cache and are always preserved.
         ConversionStream(IReferenceCounters*              pRefCounters,
                          const HLSL2GLSLConverterImpl&    Converter,
                          const char*                      InputFileName,
                          IShaderSourceInputStreamFactory* pInputStreamFactory,
                          const Char*                      HLSLSource,
                          size_t                           NumSymbols,
-                         bool                             bPreserveTokens);
+                         bool                             bPreserveTokens,
+                         HLSL2GLSLTokenCache*             pTokenCache = nullptr);
 
         String Convert(const Char* EntryPoint,
                        SHADER_TYPE ShaderType,
@@ -395,8 +415,12 @@ private:
         const String& GetInputFileName() const { return m_InputFileName; }
 
     private:
-        void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
-        void Tokenize(const String& Source);
+        // Creates a single-use stream that converts a copy of the preserved tokens
+        ConversionStream(const HLSL2GLSLConverterImpl& Converter,
+                         const String&                 InputFileName,
+                         const TokenListType&          Tokens);
+
+        static void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
 
         typedef std::unordered_map<String, bool> SamplerHashType;
 
@@ -593,8 +617,11 @@ private:
         //           defined as function arguments
         std::vector<ObjectsTypeHashType> m_Objects;
 
-        const bool m_bPreserveTokens;
-        bool       m_bUseInOutLocationQualifiers = true;
+        // Original tokens that are preserved for multiple conversions.
+        // The tokens are never modified and may be shared with other streams.
+        std::shared_ptr<const TokenListType> m_pSourceTokens;
+
+        bool m_bUseInOutLocationQualifiers = true;
 
         const HLSL2GLSLConverterImpl& m_Converter;
 
@@ -623,6 +650,30 @@ private:
     std::array<std::array<std::unordered_map<HashMapStringKey, String>, 2>, MaxShaderStages> m_HLSLSemanticToGLSLVar;
 };
 
+/// Thread-safe cache of tokenized HLSL sources.
+///
+/// Sources are identified by their contents after the includes are inserted, so that
+/// all entry points defined in the same file share one immutable token list.
+///
+/// \remarks   The cache keeps all sources until Clear() is called.
+class HLSL2GLSLTokenCache
+{
+public:
+    /// Returns the tokens of the source, tokenizing the source if it is not in the cache.
+    std::shared_ptr<const HLSL2GLSLConverterImpl::TokenListType> GetTokens(const HLSL2GLSLConverterImpl& Converter, const String& Source);
+
+    /// Removes all sources from the cache.
+    void Clear();
+
+    /// Returns the number of sources in the cache.
+    size_t GetNumSources() const;
+
+private:
+    mutable std::mutex m_Mtx;
+
+    std::unordered_map<HashMapStringKey, std::shared_ptr<const HLSL2GLSLConverterImpl::TokenListType>> m_Sources;
+};
+
 } // namespace Diligent
 
 //  Intro
@@ -802,14 +802,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
 }
 
 // The function converts source code into a token list
-void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
+HLSL2GLSLConverterImpl::TokenListType HLSL2GLSLConverterImpl::Tokenize(const String& Source) const
 {
-    m_Tokens = Parsing::Tokenize<TokenInfo, decltype(m_Tokens)>(
+    return Parsing::Tokenize<TokenInfo, TokenListType>(
         Source.begin(), Source.end(), TokenInfo::Create,
         [&](const std::string::const_iterator& Start, const std::string::const_iterator& End) //
         {
-            auto KeywordIt = m_Converter.m_HLSLKeywords.find(HashMapStringKey{std::string{Start, End}});
-            if (KeywordIt != m_Converter.m_HLSLKeywords.end())
+            auto KeywordIt = m_HLSLKeywords.find(HashMapStringKey{std::string{Start, End}});
+            if (KeywordIt != m_HLSLKeywords.end())
             {
                 VERIFY(std::string(Start, End) == KeywordIt->second.Literal, "Inconsistent literal");
                 return KeywordIt->second.Type;
@@ -4282,12 +4282,12 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            IShaderSourceInputStreamFactory* pInputStreamFactory,
                                                            const Char*                      HLSLSource,
                                                            size_t                           NumSymbols,
-                                                           bool                             bPreserveTokens) :
+                                                           bool                             bPreserveTokens,
+                                                           HLSL2GLSLTokenCache*             pTokenCache) :
     // clang-format off
-    TBase            {pRefCounters   },
-    m_bPreserveTokens{bPreserveTokens},
-    m_Converter      {Converter      },
-    m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
+    TBase          {pRefCounters},
+    m_Converter    {Converter   },
+    m_InputFileName{InputFileName != nullptr ? InputFileName : "<Unknown>"}
 // clang-format on
 {
     RefCntAutoPtr<IDataBlob> pFileData;
@@ -4314,7 +4314,24 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
 
     InsertIncludes(Source, pInputStreamFactory);
 
-    Tokenize(Source);
+    if (pTokenCache != nullptr)
+        m_pSourceTokens = pTokenCache->GetTokens(m_Converter, Source);
+    else if (bPreserveTokens)
+        m_pSourceTokens = std::make_shared<const TokenListType>(m_Converter.Tokenize(Source));
+    else
+        m_Tokens = m_Converter.Tokenize(Source);
+}
+
+HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(const HLSL2GLSLConverterImpl& Converter,
+                                                           const String&                 InputFileName,
+                                                           const TokenListType&          Tokens) :
+    // clang-format off
+    TBase          {nullptr      },
+    m_Tokens       {Tokens       },
+    m_Converter    {Converter    },
+    m_InputFileName{InputFileName}
+// clang-format on
+{
 }
 
 
@@ -4324,7 +4341,7 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
     {
         try
         {
-            ConversionStream Stream(nullptr, *this, Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, false);
+            ConversionStream Stream(nullptr, *this, Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, false, Attribs.pTokenCache);
             return Stream.Convert(Attribs.EntryPoint, Attribs.ShaderType, Attribs.IncludeDefinitions, Attribs.SamplerSuffix, Attribs.UseInOutLocationQualifiers);
         }
         catch (std::runtime_error&)
@@ -4350,7 +4367,7 @@ String HLSL2GLSLConverterImpl::Convert(ConversionAttribs& Attribs) const
 
         if (*Attribs.ppConversionStream == nullptr)
         {
-            CreateStream(Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, Attribs.ppConversionStream);
+            CreateStream(Attribs.InputFileName, Attribs.pSourceStreamFactory, Attribs.HLSLSource, Attribs.NumSymbols, Attribs.ppConversionStream, Attribs.pTokenCache);
             pStream = ClassPtrCast<ConversionStream>(*Attribs.ppConversionStream);
         }
 
@@ -4362,11 +4379,12 @@ void HLSL2GLSLConverterImpl::CreateStream(const Char*                      Input
                                           IShaderSourceInputStreamFactory* pSourceStreamFactory,
                                           const Char*                      HLSLSource,
                                           size_t                           NumSymbols,
-                                          IHLSL2GLSLConversionStream**     ppStream) const
+                                          IHLSL2GLSLConversionStream**     ppStream,
+                                          HLSL2GLSLTokenCache*             pTokenCache) const
 {
     try
     {
-        auto* pStream = NEW_RC_OBJ(GetRawAllocator(), "HLSL2GLSLConverterImpl::ConversionStream object instance", ConversionStream)(*this, InputFileName, pSourceStreamFactory, HLSLSource, NumSymbols, true);
+        auto* pStream = NEW_RC_OBJ(GetRawAllocator(), "HLSL2GLSLConverterImpl::ConversionStream object instance", ConversionStream)(*this, InputFileName, pSourceStreamFactory, HLSLSource, NumSymbols, true, pTokenCache);
         pStream->QueryInterface(IID_HLSL2GLSLConversionStream, reinterpret_cast<IObject**>(ppStream));
     }
     catch (std::runtime_error&)
@@ -4400,8 +4418,15 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          const char* SamplerSuffix,
                                                          bool        UseInOutLocationQualifiers)
 {
+    if (m_pSourceTokens)
+    {
+        // Preserved tokens are never modified, which allows the stream to be used
+        // by multiple threads. Every conversion processes its own copy of the tokens.
+        ConversionStream Stream{m_Converter, m_InputFileName, *m_pSourceTokens};
+        return Stream.Convert(EntryPoint, ShaderType, IncludeDefintions, SamplerSuffix, UseInOutLocationQualifiers);
+    }
+
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
 
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
@@ -4632,17 +4657,41 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
 
     auto GLSLSource = BuildGLSLSource();
 
-    if (m_bPreserveTokens)
-    {
-        m_Tokens.swap(TokensCopy);
-        m_StructDefinitions.clear();
-        m_Objects.clear();
-    }
-
     if (IncludeDefintions)
         GLSLSource.insert(0, g_GLSLDefinitions);
 
     return GLSLSource;
 }
 
+
+std::shared_ptr<const HLSL2GLSLConverterImpl::TokenListType> HLSL2GLSLTokenCache::GetTokens(const HLSL2GLSLConverterImpl& Converter, const String& Source)
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Sources.find(HashMapStringKey{Source.c_str()});
+        if (it != m_Sources.end())
+            return it->second;
+    }
+
+    // Tokenize the source without holding the lock
+    auto pTokens = std::make_shared<const HLSL2GLSLConverterImpl::TokenListType>(Converter.Tokenize(Source));
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // Another thread may have tokenized the same source in the meantime
+    return m_Sources.emplace(HashMapStringKey{Source}, std::move(pTokens)).first->second;
+}
+
+void HLSL2GLSLTokenCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Sources.clear();
+}
+
+size_t HLSL2GLSLTokenCache::GetNumSources() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Sources.size();
+}
+
 } // namespace Diligent
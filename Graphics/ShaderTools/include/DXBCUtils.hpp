@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "Constants.h"
 #include "Shader.h"
 #include "ResourceBindingMap.hpp"
@@ -41,14 +44,64 @@ using BindInfo            = ResourceBinding::BindInfo;
 using TResourceBindingMap = ResourceBinding::TMap;
 
 
+/// Locations of the resource bindings in DXBC byte code.
+
+/// The table is filled by RemapResourceBindings() and lets PatchResourceBindings()
+/// remap the bindings of the same byte code without parsing it again.
+struct ResourceBindingPatchTable
+{
+    enum class PatchField : Uint8
+    {
+        BindPoint,     // BindInfo::BindPoint + ArrayIndex
+        LastBindPoint, // BindInfo::BindPoint + BindInfo::ArraySize - 1
+        Space          // BindInfo::Space
+    };
+
+    struct Patch
+    {
+        Uint32     Offset     = 0; // Byte offset of the value in the byte code
+        Uint32     Resource   = 0; // Index in Resources
+        Uint32     ArrayIndex = 0;
+        PatchField Field      = PatchField::BindPoint;
+    };
+
+    /// Names of the resources in the byte code.
+    std::vector<std::string> Resources;
+
+    std::vector<Patch> Patches;
+
+    /// The size of the byte code the table was computed for.
+    size_t BytecodeSize = 0;
+
+    /// Whether the byte code supports register spaces (SM5.1).
+    bool SpacesSupported = false;
+};
+
+
 /// Remaps resource bindings in the given DXBC byte code.
 
 /// \param [in]    ResourceMap - Resource binding map. For every resource in the
 ///                              byte code it must define the binding (shader register).
 /// \param [inout] pBytecode   - Byte code that will be patched.
+/// \param [out]   pPatchTable - Optional table that receives the locations of all patched values.
 bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
                            void*                      pBytecode,
-                           size_t                     Size);
+                           size_t                     Size,
+                           ResourceBindingPatchTable* pPatchTable = nullptr);
+
+/// Remaps resource bindings in the byte code using the table computed by RemapResourceBindings().
+
+/// \param [in]    PatchTable  - Patch table computed for the original byte code.
+/// \param [in]    ResourceMap - Resource binding map.
+/// \param [inout] pBytecode   - A copy of the original byte code that will be patched.
+///
+/// \remarks   Unlike RemapResourceBindings(), this function does not parse the byte code
+///            and only writes the new bindings and the checksum.
+bool PatchResourceBindings(const ResourceBindingPatchTable& PatchTable,
+                           const TResourceBindingMap&       ResourceMap,
+                           void*                            pBytecode,
+                           size_t                           Size);
+
 }; // namespace DXBCUtils
 
 } // namespace Diligent
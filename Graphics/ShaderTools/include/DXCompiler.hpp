@@ -61,6 +61,12 @@ public:
 
     virtual bool IsLoaded() = 0;
 
+    /// Starts loading the compiler library on a worker thread.
+
+    /// \remarks   Methods that require the library wait until the load completes.
+    ///            The method must not be called concurrently from multiple threads.
+    virtual void LoadAsync() = 0;
+
     virtual void GetVersion(Uint32& MajorVersion, Uint32& MinorVersion) const = 0;
 
     struct CompileAttribs
@@ -76,6 +82,8 @@ public:
         IShaderSourceInputStreamFactory* pShaderSourceStreamFactory = nullptr;
         IDxcBlob**                       ppBlobOut                  = nullptr;
         IDxcBlob**                       ppCompilerOutput           = nullptr;
+        // Reuse include files loaded by previous compilations from the same stream factory
+        bool CacheIncludes = false;
     };
     virtual bool Compile(const CompileAttribs& Attribs) = 0;
 
@@ -34,6 +34,8 @@
 namespace Diligent
 {
 
+class HLSL2GLSLTokenCache;
+
 enum class TargetGLSLCompiler
 {
     glslang,
@@ -44,6 +46,7 @@ String BuildGLSLSourceString(const ShaderCreateInfo&    ShaderCI,
                              const RenderDeviceInfo&    DeviceInfo,
                              const GraphicsAdapterInfo& AdapterInfo,
                              TargetGLSLCompiler         TargetCompiler,
-                             const char*                ExtraDefinitions = nullptr) noexcept(false);
+                             const char*                ExtraDefinitions     = nullptr,
+                             HLSL2GLSLTokenCache*       pHLSL2GLSLTokenCache = nullptr) noexcept(false);
 
 } // namespace Diligent
@@ -50,6 +50,8 @@ enum class SpirvVersion
     Count
 };
 
+// Initializes glslang process state. The calls are reference-counted and may be made
+// from any thread; every call must be matched by a call to FinalizeGlslang().
 void InitializeGlslang();
 void FinalizeGlslang();
 
@@ -63,8 +65,13 @@ struct GLSLtoSPIRVAttribs
     SpirvVersion                     Version                    = SpirvVersion::Vk100;
     IDataBlob**                      ppCompilerOutput           = nullptr;
     bool                             AssignBindings             = true;
+
+    // Only SHADER_COMPILE_FLAG_MINIMAL_OPTIMIZATION and SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE
+    // flags are used to select the SPIR-V optimization level.
+    SHADER_COMPILE_FLAGS CompileFlags = SHADER_COMPILE_FLAG_NONE;
 };
 
+// GLSLtoSPIRV and HLSLtoSPIRV may be called concurrently from multiple threads.
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs);
 
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
@@ -46,6 +46,7 @@
 #include "STDAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "StringPool.hpp"
+#include "Serializer.hpp"
 
 #ifdef DILIGENT_SPIRV_CROSS_NAMESPACE
 #    define diligent_spirv_cross DILIGENT_SPIRV_CROSS_NAMESPACE
@@ -111,6 +112,16 @@ struct SPIRVShaderResourceAttribs
                                Uint32                                _BufferStaticSize = 0,
                                Uint32                                _BufferStride     = 0) noexcept;
 
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               ResourceType       _Type,
+                               Uint16             _ArraySize,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept;
+
     ShaderResourceDesc GetResourceDesc() const
     {
         return ShaderResourceDesc{Name, GetShaderResourceType(Type), ArraySize};
@@ -154,6 +165,16 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    /// Creates shader resources from the reflection data produced by SerializeReflection()
+    /// without parsing the SPIR-V with SPIRV-Cross.
+    /// Throws an exception if the data is invalid or does not match the SPIR-V.
+    SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                         const SerializedData&        ReflectionData,
+                         const std::vector<uint32_t>& spirv_binary,
+                         const ShaderDesc&            shaderDesc,
+                         const char*                  CombinedSamplerSuffix,
+                         std::string&                 EntryPoint) noexcept(false);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -306,6 +327,13 @@ public:
 
     std::string DumpResources();
 
+    /// Serializes the resources into a compact form that can be stored next to the SPIR-V
+    /// bytecode. The reflection data remains valid as long as the SPIR-V layout does not change,
+    /// i.e. only the values of binding, descriptor set and location decorations are modified.
+    SerializedData SerializeReflection(const std::vector<uint32_t>& spirv_binary,
+                                       const char*                  EntryPoint,
+                                       IMemoryAllocator&            Allocator) const;
+
     // clang-format off
 
     const char* GetCombinedSamplerSuffix() const { return m_CombinedSamplerSuffix; }
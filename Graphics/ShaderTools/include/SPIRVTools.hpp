@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "FlagEnum.h"
+#include "Shader.h"
 
 #include "spirv-tools/libspirv.h"
 
@@ -40,13 +41,64 @@ enum SPIRV_OPTIMIZATION_FLAGS : Uint32
     SPIRV_OPTIMIZATION_FLAG_NONE             = 0u,
     SPIRV_OPTIMIZATION_FLAG_LEGALIZATION     = 1u << 0u,
     SPIRV_OPTIMIZATION_FLAG_PERFORMANCE      = 1u << 1u,
-    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u
+    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u,
+    SPIRV_OPTIMIZATION_FLAG_SIZE             = 1u << 3u
 };
 DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS);
 
+/// SPIR-V optimization level
+enum SPIRV_OPTIMIZATION_LEVEL : Uint8
+{
+    /// Only run the passes that are required to produce valid SPIR-V.
+    SPIRV_OPTIMIZATION_LEVEL_FAST_DEV = 0,
+
+    /// Run the passes that reduce the SPIR-V size.
+    SPIRV_OPTIMIZATION_LEVEL_SIZE,
+
+    /// Run the passes that improve the shader performance.
+    SPIRV_OPTIMIZATION_LEVEL_PERFORMANCE
+};
+
+/// Returns the optimization level requested by the shader compile flags.
+SPIRV_OPTIMIZATION_LEVEL GetSPIRVOptimizationLevel(SHADER_COMPILE_FLAGS CompileFlags);
+
+/// Returns the optimization passes for the given level.
+/// Legalization passes are required for SPIR-V generated from HLSL.
+SPIRV_OPTIMIZATION_FLAGS GetSPIRVOptimizationFlags(SPIRV_OPTIMIZATION_LEVEL Level, bool Legalize);
+
+/// SPIR-V module statistics
+struct SPIRVStatistics
+{
+    /// Module size in bytes
+    size_t Size = 0;
+
+    /// The total number of instructions, including the debug instructions
+    Uint32 NumInstructions = 0;
+
+    /// The number of functions
+    Uint32 NumFunctions = 0;
+};
+
+/// Computes the statistics of the SPIR-V module.
+SPIRVStatistics GetSPIRVStatistics(const std::vector<uint32_t>& SPIRV);
+
+/// Optimizes SPIR-V using the given passes.
 
+/// \param [in]  SrcSPIRV   - Source SPIR-V.
+/// \param [in]  TargetEnv  - Target environment. If SPV_ENV_MAX, the environment
+///                           is derived from the SPIR-V version.
+/// \param [in]  Passes     - Optimization passes, see Diligent::SPIRV_OPTIMIZATION_FLAGS.
+/// \param [out] pSrcStats  - Optional pointer to the source SPIR-V statistics.
+/// \param [out] pDstStats  - Optional pointer to the optimized SPIR-V statistics.
+///
+/// \return     Optimized SPIR-V, or an empty vector if the optimization failed.
+///
+/// \remarks    Optimizers are configured once per thread for every combination of
+///             the target environment and the passes, and are reused by subsequent calls.
 std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
                                     spv_target_env               TargetEnv,
-                                    SPIRV_OPTIMIZATION_FLAGS     Passes);
+                                    SPIRV_OPTIMIZATION_FLAGS     Passes,
+                                    SPIRVStatistics*             pSrcStats = nullptr,
+                                    SPIRVStatistics*             pDstStats = nullptr);
 
 } // namespace Diligent
@@ -28,6 +28,12 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "GraphicsTypes.h"
 #include "Shader.h"
@@ -92,6 +98,87 @@ inline ShaderSourceFileData ReadShaderSourceFile(const ShaderCreateInfo& ShaderC
 void AppendShaderSourceCode(std::string& Source, const ShaderCreateInfo& ShaderCI) noexcept(false);
 
 
+/// Thread-safe cache of shader source files loaded from shader source input stream factories.
+///
+/// The cache keeps the contents of every file together with the list of include directives found in it,
+/// so that ProcessShaderIncludes and UnrollShaderIncludes read and parse every file only once.
+/// Files are identified by their path and the stream factory they were loaded from.
+///
+/// \remarks   The cache does not track file modifications. The application must call Clear()
+///            or RemoveModifiedFiles() when the source files may have changed, e.g. before
+///            reloading shaders.
+class ShaderIncludeCache
+{
+public:
+    struct IncludeInfo
+    {
+        /// The path of the included file.
+        std::string Path;
+
+        /// The position of the first character of the include directive in the source.
+        size_t Start = 0;
+
+        /// The position after the last character of the include directive in the source.
+        size_t End = 0;
+    };
+
+    struct FileInfo
+    {
+        RefCntAutoPtr<IDataBlob> pFileData;
+
+        const Char* Source       = nullptr;
+        size_t      SourceLength = 0;
+
+        /// The hash of the file contents.
+        size_t Hash = 0;
+
+        /// Include directives in the order they appear in the file.
+        std::vector<IncludeInfo> Includes;
+    };
+
+    /// Returns the file info, loading and parsing the file if it is not in the cache.
+    /// Throws an exception if the file can't be loaded or parsed.
+    std::shared_ptr<const FileInfo> GetFile(IShaderSourceInputStreamFactory* pStreamFactory, const char* FilePath) noexcept(false);
+
+    /// Removes all files from the cache.
+    void Clear();
+
+    /// Loads every file in the cache again and removes the files whose contents have changed
+    /// or that can no longer be loaded. Returns the paths of the removed files.
+    std::unordered_set<std::string> RemoveModifiedFiles();
+
+    /// Returns the number of files in the cache.
+    size_t GetNumFiles() const;
+
+private:
+    struct FileKey
+    {
+        const IShaderSourceInputStreamFactory* pStreamFactory = nullptr;
+        std::string                            Path;
+
+        bool operator==(const FileKey& RHS) const noexcept
+        {
+            return pStreamFactory == RHS.pStreamFactory && Path == RHS.Path;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const FileKey& Key) const noexcept;
+        };
+    };
+
+    struct CacheEntry
+    {
+        // Detects that the factory was released and another one was created at the same address
+        RefCntWeakPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+        std::shared_ptr<const FileInfo>                pFileInfo;
+    };
+
+    mutable std::mutex                                       m_Mtx;
+    std::unordered_map<FileKey, CacheEntry, FileKey::Hasher> m_Files;
+};
+
+
 /// Shader include preprocess info.
 struct ShaderIncludePreprocessInfo
 {
@@ -108,9 +195,13 @@ struct ShaderIncludePreprocessInfo
 /// The function recursively finds all include files in the shader and calls the
 /// IncludeHandler function for all source files, including the original one.
 /// Includes are processed in a depth-first order such that original source file is processed last.
-bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler) noexcept;
+/// If pIncludeCache is not null, files loaded from the stream factory are taken from the cache.
+bool ProcessShaderIncludes(const ShaderCreateInfo&                                  ShaderCI,
+                           std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler,
+                           ShaderIncludeCache*                                      pIncludeCache = nullptr) noexcept;
 
 ///  Unrolls all include files into a single file
-std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false);
+///  If pIncludeCache is not null, files loaded from the stream factory are taken from the cache.
+std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache = nullptr) noexcept(false);
 
 } // namespace Diligent
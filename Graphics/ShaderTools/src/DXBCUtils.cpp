@@ -558,6 +558,67 @@ struct ResourceExtendedInfo
 using ResourceBindingPerType = std::array<std::vector<DXBCUtils::BindInfo const*>, RES_TYPE_COUNT + 1>;
 using TExtendedResourceMap   = std::unordered_map<DXBCUtils::BindInfo const*, ResourceExtendedInfo>;
 
+// Writes the new bindings and, if the patch table is provided, records their locations
+class BindingWriter
+{
+public:
+    using PatchField = DXBCUtils::ResourceBindingPatchTable::PatchField;
+
+    BindingWriter(const void* pBytecode, DXBCUtils::ResourceBindingPatchTable* pPatchTable) :
+        m_pBytecode{static_cast<const char*>(pBytecode)},
+        m_pPatchTable{pPatchTable}
+    {}
+
+    void AddResource(const DXBCUtils::BindInfo& Info, const char* Name)
+    {
+        if (m_pPatchTable == nullptr)
+            return;
+
+        if (m_ResourceIndices.emplace(&Info, static_cast<Uint32>(m_pPatchTable->Resources.size())).second)
+            m_pPatchTable->Resources.emplace_back(Name);
+    }
+
+    void SetBindPoint(Uint32& Dst, const DXBCUtils::BindInfo& Info, Uint32 ArrayIndex)
+    {
+        Dst = Info.BindPoint + ArrayIndex;
+        Record(Dst, Info, PatchField::BindPoint, ArrayIndex);
+    }
+
+    void SetLastBindPoint(Uint32& Dst, const DXBCUtils::BindInfo& Info)
+    {
+        Dst = Info.BindPoint + Info.ArraySize - 1;
+        Record(Dst, Info, PatchField::LastBindPoint, 0);
+    }
+
+    void SetSpace(Uint32& Dst, const DXBCUtils::BindInfo& Info)
+    {
+        Dst = Info.Space;
+        Record(Dst, Info, PatchField::Space, 0);
+    }
+
+private:
+    void Record(const Uint32& Dst, const DXBCUtils::BindInfo& Info, PatchField Field, Uint32 ArrayIndex)
+    {
+        if (m_pPatchTable == nullptr)
+            return;
+
+        const auto it = m_ResourceIndices.find(&Info);
+        if (it == m_ResourceIndices.end())
+            LOG_ERROR_AND_THROW("The binding is patched for a resource that is not defined in the resource definition chunk.");
+
+        DXBCUtils::ResourceBindingPatchTable::Patch Patch;
+        Patch.Offset     = static_cast<Uint32>(reinterpret_cast<const char*>(&Dst) - m_pBytecode);
+        Patch.Resource   = it->second;
+        Patch.ArrayIndex = ArrayIndex;
+        Patch.Field      = Field;
+        m_pPatchTable->Patches.push_back(Patch);
+    }
+
+    const char* const                                       m_pBytecode;
+    DXBCUtils::ResourceBindingPatchTable* const             m_pPatchTable;
+    std::unordered_map<DXBCUtils::BindInfo const*, Uint32> m_ResourceIndices;
+};
+
 
 #define FOURCC(a, b, c, d) (Uint32{(d) << 24} | Uint32{(c) << 16} | Uint32{(b) << 8} | Uint32{a})
 
@@ -856,21 +917,21 @@ Uint32 GetNumOperands(D3D10_SB_OPCODE_TYPE Opcode)
     }
 }
 
-inline bool PatchSpace(ResourceBindingInfo51& Res, ResourceExtendedInfo& Ext, const DXBCUtils::BindInfo& Info)
+inline bool PatchSpace(ResourceBindingInfo51& Res, ResourceExtendedInfo& Ext, const DXBCUtils::BindInfo& Info, BindingWriter& Writer)
 {
     Ext.SrcSpace = Res.Space;
-    Res.Space    = Info.Space;
+    Writer.SetSpace(Res.Space, Info);
     return true;
 }
 
-inline bool PatchSpace(ResourceBindingInfo50&, ResourceExtendedInfo& Ext, const DXBCUtils::BindInfo& Info)
+inline bool PatchSpace(ResourceBindingInfo50&, ResourceExtendedInfo& Ext, const DXBCUtils::BindInfo& Info, BindingWriter&)
 {
     VERIFY_EXPR(Ext.SrcSpace == ~0u);
     return Info.Space == 0 || Info.Space == ~0U;
 }
 
 template <typename ResourceBindingInfoType>
-void RemapShaderResources(const DXBCUtils::TResourceBindingMap& ResourceMap, const void* EndPtr, ResourceDefChunkHeader* RDEFHeader, TExtendedResourceMap& ExtResMap, ResourceBindingPerType& BindingsPerType)
+void RemapShaderResources(const DXBCUtils::TResourceBindingMap& ResourceMap, const void* EndPtr, ResourceDefChunkHeader* RDEFHeader, TExtendedResourceMap& ExtResMap, ResourceBindingPerType& BindingsPerType, BindingWriter& Writer)
 {
     VERIFY_EXPR(RDEFHeader->Magic == RDEFFourCC);
 
@@ -953,9 +1014,10 @@ void RemapShaderResources(const DXBCUtils::TResourceBindingMap& ResourceMap, con
 #endif
         Ext.Type         = ResType;
         Ext.SrcBindPoint = Res.BindPoint - ArrayInd;
-        Res.BindPoint    = Iter->second.BindPoint + ArrayInd;
+        Writer.AddResource(Iter->second, TempName.c_str());
+        Writer.SetBindPoint(Res.BindPoint, Iter->second, ArrayInd);
 
-        if (!PatchSpace(Res, Ext, Iter->second))
+        if (!PatchSpace(Res, Ext, Iter->second, Writer))
         {
             LOG_ERROR_AND_THROW("Can not change space for resource '", TempName, "' because the shader was not compiled for SM 5.1.");
         }
@@ -966,8 +1028,8 @@ void RemapShaderResources(const DXBCUtils::TResourceBindingMap& ResourceMap, con
 struct ShaderBytecodeRemapper
 {
 public:
-    ShaderBytecodeRemapper(ShaderChunkHeader const& _Header, TExtendedResourceMap& _ExtResMap, ResourceBindingPerType const& _BindingsPerType) :
-        Header{_Header}, ExtResourceMap{_ExtResMap}, BindingsPerType{_BindingsPerType}
+    ShaderBytecodeRemapper(ShaderChunkHeader const& _Header, TExtendedResourceMap& _ExtResMap, ResourceBindingPerType const& _BindingsPerType, BindingWriter& _Writer) :
+        Header{_Header}, ExtResourceMap{_ExtResMap}, BindingsPerType{_BindingsPerType}, Writer{_Writer}
     {}
 
     void PatchBytecode(Uint32* Token, const void* EndPtr) noexcept(false);
@@ -976,6 +1038,7 @@ private:
     ShaderChunkHeader const&      Header;
     TExtendedResourceMap&         ExtResourceMap;
     ResourceBindingPerType const& BindingsPerType;
+    BindingWriter&                Writer;
 
     static constexpr Uint32 RuntimeSizedArraySize = ~0u;
 
@@ -1026,7 +1089,7 @@ void ShaderBytecodeRemapper::RemapResourceOperandSM50(const OperandToken& Operan
             const auto& Ext = ExtResourceMap[Info];
             if (Token >= Ext.SrcBindPoint && Token < Ext.SrcBindPoint + Info->ArraySize)
             {
-                Token = Info->BindPoint + (Token - Ext.SrcBindPoint);
+                Writer.SetBindPoint(Token, *Info, Token - Ext.SrcBindPoint);
                 VERIFY_EXPR(Ext.Type == Type);
                 return true;
             }
@@ -1111,7 +1174,7 @@ void ShaderBytecodeRemapper::RemapResourceOperandSM51_2(const OperandToken& Oper
             if (Token[1] < Ext.SrcBindPoint || Token[1] >= Ext.SrcBindPoint + Info.ArraySize)
                 LOG_ERROR_AND_THROW("Invalid bind point (", Token[1], "), expected to be in the range (", Ext.SrcBindPoint, "..", Ext.SrcBindPoint + Info.ArraySize - 1, ").");
 
-            Token[1] = Info.BindPoint + (Token[1] - Ext.SrcBindPoint);
+            Writer.SetBindPoint(Token[1], Info, Token[1] - Ext.SrcBindPoint);
             break;
         }
         case D3D10_SB_OPERAND_INDEX_RELATIVE:
@@ -1124,7 +1187,7 @@ void ShaderBytecodeRemapper::RemapResourceOperandSM51_2(const OperandToken& Oper
             if (Token[2] < Ext.SrcBindPoint || Token[2] >= Ext.SrcBindPoint + Info.ArraySize)
                 LOG_ERROR_AND_THROW("Invalid bind point (", Token[2], "), expected to be in the range (", Ext.SrcBindPoint, "..", Ext.SrcBindPoint + Info.ArraySize - 1, ").");
 
-            Token[2] = Info.BindPoint + (Token[2] - Ext.SrcBindPoint);
+            Writer.SetBindPoint(Token[2], Info, Token[2] - Ext.SrcBindPoint);
             break;
         }
         default:
@@ -1232,9 +1295,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid cbuffer register space (", Token[5], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[5] = Info.Space;
+            Writer.SetSpace(Token[5], Info);
             break;
         }
 
@@ -1269,9 +1332,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid sampler register space (", Token[4], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[4] = Info.Space;
+            Writer.SetSpace(Token[4], Info);
             break;
         }
 
@@ -1309,9 +1372,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid texture register space (", Token[5], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[5] = Info.Space;
+            Writer.SetSpace(Token[5], Info);
             break;
         }
         case D3D11_SB_OPCODE_DCL_RESOURCE_RAW:
@@ -1345,9 +1408,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid texture register space (", Token[4], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[4] = Info.Space;
+            Writer.SetSpace(Token[4], Info);
             break;
         }
 
@@ -1385,9 +1448,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid UAV register space (", Token[5], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[5] = Info.Space;
+            Writer.SetSpace(Token[5], Info);
             break;
         }
         case D3D11_SB_OPCODE_DCL_UNORDERED_ACCESS_VIEW_RAW:
@@ -1421,9 +1484,9 @@ void ShaderBytecodeRemapper::RemapResourceBindingSM51(const OpcodeToken& Opcode,
                 LOG_ERROR_AND_THROW("Invalid UAV register space (", Token[4], "), expected (", Ext.SrcSpace, ").");
 
             if (Token[3] != RuntimeSizedArraySize)
-                Token[3] = Info.BindPoint + Info.ArraySize - 1;
+                Writer.SetLastBindPoint(Token[3], Info);
 
-            Token[4] = Info.Space;
+            Writer.SetSpace(Token[4], Info);
             break;
         }
     }
@@ -1682,6 +1745,15 @@ void ShaderBytecodeRemapper::PatchBytecode(Uint32* Token, const void* EndPtr) no
     }
 }
 
+void UpdateChecksum(DXBCHeader& Header, size_t Size)
+{
+    DWORD Checksum[4] = {};
+    CalculateDXBCChecksum(reinterpret_cast<BYTE*>(&Header), static_cast<DWORD>(Size), Checksum);
+
+    static_assert(sizeof(Header.Checksum) == sizeof(Checksum), "Unexpected checksum size");
+    memcpy(Header.Checksum, Checksum, sizeof(Header.Checksum));
+}
+
 } // namespace
 
 
@@ -1690,8 +1762,12 @@ namespace DXBCUtils
 
 bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
                            void*                      pBytecode,
-                           size_t                     Size)
+                           size_t                     Size,
+                           ResourceBindingPatchTable* pPatchTable)
 {
+    if (pPatchTable != nullptr)
+        *pPatchTable = {};
+
     if (pBytecode == nullptr)
     {
         LOG_ERROR_MESSAGE("pBytecode must not be null.");
@@ -1737,6 +1813,7 @@ bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
     const Uint32*          Chunks = reinterpret_cast<Uint32*>(Ptr + sizeof(Header));
     ResourceBindingPerType BindingsPerType;
     TExtendedResourceMap   ExtResourceMap;
+    BindingWriter          Writer{Ptr, pPatchTable};
 
     bool RemapResDef   = false;
     bool RemapBytecode = false;
@@ -1762,12 +1839,14 @@ bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
 
                 if (RDEFHeader->MajorVersion == 5 && RDEFHeader->MinorVersion == 1)
                 {
-                    RemapShaderResources<ResourceBindingInfo51>(ResourceMap, EndPtr, RDEFHeader, ExtResourceMap, BindingsPerType);
+                    RemapShaderResources<ResourceBindingInfo51>(ResourceMap, EndPtr, RDEFHeader, ExtResourceMap, BindingsPerType, Writer);
                     RemapResDef = true;
+                    if (pPatchTable != nullptr)
+                        pPatchTable->SpacesSupported = true;
                 }
                 else if (RDEFHeader->MajorVersion == 5 && RDEFHeader->MinorVersion == 0 || RDEFHeader->MajorVersion < 5)
                 {
-                    RemapShaderResources<ResourceBindingInfo50>(ResourceMap, EndPtr, RDEFHeader, ExtResourceMap, BindingsPerType);
+                    RemapShaderResources<ResourceBindingInfo50>(ResourceMap, EndPtr, RDEFHeader, ExtResourceMap, BindingsPerType, Writer);
                     RemapResDef = true;
                 }
                 else
@@ -1780,7 +1859,7 @@ bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
             {
                 Uint32*                Token    = reinterpret_cast<Uint32*>(Ptr + Chunks[i] + sizeof(ShaderChunkHeader));
                 const auto&            SBHeader = *reinterpret_cast<ShaderChunkHeader*>(pChunk);
-                ShaderBytecodeRemapper Remapper{SBHeader, ExtResourceMap, BindingsPerType};
+                ShaderBytecodeRemapper Remapper{SBHeader, ExtResourceMap, BindingsPerType, Writer};
 
                 Remapper.PatchBytecode(Token, EndPtr);
                 RemapBytecode = true;
@@ -1804,12 +1883,88 @@ bool RemapResourceBindings(const TResourceBindingMap& ResourceMap,
         return false;
     }
 
-    // update checksum
-    DWORD Checksum[4] = {};
-    CalculateDXBCChecksum(reinterpret_cast<BYTE*>(Ptr), static_cast<DWORD>(Size), Checksum);
+    UpdateChecksum(Header, Size);
 
-    static_assert(sizeof(Header.Checksum) == sizeof(Checksum), "Unexpected checksum size");
-    memcpy(Header.Checksum, Checksum, sizeof(Header.Checksum));
+    if (pPatchTable != nullptr)
+        pPatchTable->BytecodeSize = Size;
+
+    return true;
+}
+
+bool PatchResourceBindings(const ResourceBindingPatchTable& PatchTable,
+                           const TResourceBindingMap&       ResourceMap,
+                           void*                            pBytecode,
+                           size_t                           Size)
+{
+    if (pBytecode == nullptr)
+    {
+        LOG_ERROR_MESSAGE("pBytecode must not be null.");
+        return false;
+    }
+
+    if (Size != PatchTable.BytecodeSize)
+    {
+        LOG_ERROR_MESSAGE("The byte code size (", Size, ") does not match the size of the byte code the patch table was computed for (", PatchTable.BytecodeSize, ").");
+        return false;
+    }
+
+    auto& Header = *static_cast<DXBCHeader*>(pBytecode);
+    if (Header.Magic != DXBCFourCC || Header.TotalSize != Size)
+    {
+        LOG_ERROR_MESSAGE("Invalid DXBC header. The byte code may be corrupted.");
+        return false;
+    }
+
+    std::vector<const BindInfo*> Bindings(PatchTable.Resources.size());
+    for (size_t r = 0; r < PatchTable.Resources.size(); ++r)
+    {
+        const auto& Name = PatchTable.Resources[r];
+
+        auto Iter = ResourceMap.find(HashMapStringKey{Name.c_str(), false});
+        if (Iter == ResourceMap.end())
+        {
+            LOG_ERROR_MESSAGE("Failed to find '", Name, "' in the resource mapping.");
+            return false;
+        }
+
+        if (!PatchTable.SpacesSupported && Iter->second.Space != 0 && Iter->second.Space != ~0u)
+        {
+            LOG_ERROR_MESSAGE("Can not change space for resource '", Name, "' because the shader was not compiled for SM 5.1.");
+            return false;
+        }
+
+        Bindings[r] = &Iter->second;
+    }
+
+    auto* const Ptr = static_cast<char*>(pBytecode);
+    for (const auto& Patch : PatchTable.Patches)
+    {
+        VERIFY_EXPR(Patch.Offset + sizeof(Uint32) <= Size);
+        VERIFY_EXPR(Patch.Resource < Bindings.size());
+
+        const auto& Info  = *Bindings[Patch.Resource];
+        Uint32      Value = 0;
+        switch (Patch.Field)
+        {
+            case ResourceBindingPatchTable::PatchField::BindPoint:
+                Value = Info.BindPoint + Patch.ArrayIndex;
+                break;
+
+            case ResourceBindingPatchTable::PatchField::LastBindPoint:
+                Value = Info.BindPoint + Info.ArraySize - 1;
+                break;
+
+            case ResourceBindingPatchTable::PatchField::Space:
+                Value = Info.Space;
+                break;
+
+            default:
+                UNEXPECTED("Unexpected patch field");
+        }
+        memcpy(Ptr + Patch.Offset, &Value, sizeof(Value));
+    }
+
+    UpdateChecksum(Header, Size);
 
     return true;
 }
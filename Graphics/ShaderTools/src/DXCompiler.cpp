@@ -32,6 +32,9 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
 
 // Platforms that support DXCompiler.
 #if PLATFORM_WIN32
@@ -47,6 +50,7 @@
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 #if D3D12_SUPPORTED
 #    include "WinHPreface.h"
@@ -83,6 +87,12 @@ public:
         m_APIVersion{APIVersion}
     {}
 
+    ~DXCompilerImpl()
+    {
+        if (m_LoadThread.joinable())
+            m_LoadThread.join();
+    }
+
     ShaderVersion GetMaxShaderModel() override final
     {
         Load();
@@ -95,6 +105,14 @@ public:
         return GetCreateInstanceProc() != nullptr;
     }
 
+    void LoadAsync() override final
+    {
+        if (m_IsInitialized.load(std::memory_order_acquire) || m_LoadThread.joinable())
+            return;
+
+        m_LoadThread = std::thread{[this]() { Load(); }};
+    }
+
     DxcCreateInstanceProc GetCreateInstanceProc()
     {
         return Load();
@@ -125,12 +143,17 @@ public:
 private:
     DxcCreateInstanceProc Load()
     {
+        // Fast path that does not require the lock
+        if (m_IsInitialized.load(std::memory_order_acquire))
+            return m_pCreateInstance;
+
         std::unique_lock<std::mutex> lock{m_Guard};
 
-        if (m_IsInitialized)
+        if (m_IsInitialized.load(std::memory_order_relaxed))
             return m_pCreateInstance;
 
-        m_IsInitialized   = true;
+        const auto LoadStart = std::chrono::steady_clock::now();
+
         m_pCreateInstance = DXCompilerBase::Load(m_Target, m_LibName);
 
         if (m_pCreateInstance)
@@ -147,13 +170,32 @@ private:
                 }
             }
 
-            LOG_INFO_MESSAGE("Loaded DX Shader Compiler ", m_MajorVer, ".", m_MinorVer, ". Max supported shader model: ", m_MaxShaderModel.Major, '.', m_MaxShaderModel.Minor);
+            const auto LoadTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - LoadStart).count();
+            LOG_INFO_MESSAGE("Loaded DX Shader Compiler ", m_MajorVer, ".", m_MinorVer, " in ", LoadTime, " ms. Max supported shader model: ", m_MaxShaderModel.Major, '.', m_MaxShaderModel.Minor);
         }
 
+        m_IsInitialized.store(true, std::memory_order_release);
+
         return m_pCreateInstance;
     }
 
-    bool ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
+    using IncludeCacheType = std::unordered_map<String, RefCntAutoPtr<IDataBlob>>;
+
+    // DXC objects are not thread-safe and should be created and used on the same thread,
+    // so every thread gets its own set of instances that is reused by all compilations on that thread.
+    struct ThreadInstances
+    {
+        CComPtr<IDxcLibrary>   pLibrary;
+        CComPtr<IDxcCompiler>  pCompiler;
+        CComPtr<IDxcValidator> pValidator;
+
+        // Include files loaded from pIncludeStreamFactory, see SHADER_COMPILE_FLAG_CACHE_INCLUDES
+        RefCntWeakPtr<IShaderSourceInputStreamFactory> pIncludeStreamFactory;
+        IncludeCacheType                               IncludeCache;
+    };
+    ThreadInstances& GetThreadInstances(DxcCreateInstanceProc CreateInstance) noexcept(false);
+
+    bool ValidateAndSign(IDxcValidator* pdxcValidator, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
 
     enum RES_TYPE : Uint32
     {
@@ -183,7 +225,7 @@ private:
 
 private:
     DxcCreateInstanceProc  m_pCreateInstance = nullptr;
-    bool                   m_IsInitialized   = false;
+    std::atomic<bool>      m_IsInitialized{false};
     ShaderVersion          m_MaxShaderModel;
     std::mutex             m_Guard;
     const String           m_LibName;
@@ -192,6 +234,13 @@ private:
     // Compiler version
     UINT32 m_MajorVer = 0;
     UINT32 m_MinorVer = 0;
+
+    // Must be destroyed before the compiler library is unloaded by ~DXCompilerBase()
+    std::mutex                                                            m_ThreadInstancesMtx;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadInstances>> m_ThreadInstances;
+
+    // Background thread started by LoadAsync(); joined by the destructor
+    std::thread m_LoadThread;
 };
 
 #define CHECK_D3D_RESULT(Expr, Message)   \
@@ -207,9 +256,14 @@ private:
 class DxcIncludeHandlerImpl final : public IDxcIncludeHandler
 {
 public:
-    explicit DxcIncludeHandlerImpl(IShaderSourceInputStreamFactory* pStreamFactory, CComPtr<IDxcLibrary> pdxcLibrary) :
+    using IncludeCacheType = std::unordered_map<String, RefCntAutoPtr<IDataBlob>>;
+
+    DxcIncludeHandlerImpl(IShaderSourceInputStreamFactory* pStreamFactory,
+                          CComPtr<IDxcLibrary>             pdxcLibrary,
+                          IncludeCacheType*                pIncludeCache = nullptr) :
         m_pdxcLibrary{std::move(pdxcLibrary)},
-        m_pStreamFactory{pStreamFactory}
+        m_pStreamFactory{pStreamFactory},
+        m_pIncludeCache{pIncludeCache}
     {
     }
 
@@ -235,16 +289,30 @@ public:
         if (fileName.size() > 2 && fileName[0] == '.' && (fileName[1] == '\\' || fileName[1] == '/'))
             fileName.erase(0, 2);
 
-        RefCntAutoPtr<IFileStream> pSourceStream;
-        m_pStreamFactory->CreateInputStream(fileName.c_str(), &pSourceStream);
-        if (pSourceStream == nullptr)
+        RefCntAutoPtr<IDataBlob> pFileData;
+        if (m_pIncludeCache != nullptr)
         {
-            LOG_ERROR("Failed to open shader include file ", fileName, ". Check that the file exists");
-            return E_FAIL;
+            auto it = m_pIncludeCache->find(fileName);
+            if (it != m_pIncludeCache->end())
+                pFileData = it->second;
         }
 
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
+        if (!pFileData)
+        {
+            RefCntAutoPtr<IFileStream> pSourceStream;
+            m_pStreamFactory->CreateInputStream(fileName.c_str(), &pSourceStream);
+            if (pSourceStream == nullptr)
+            {
+                LOG_ERROR("Failed to open shader include file ", fileName, ". Check that the file exists");
+                return E_FAIL;
+            }
+
+            pFileData = DataBlobImpl::Create();
+            pSourceStream->ReadBlob(pFileData);
+
+            if (m_pIncludeCache != nullptr)
+                m_pIncludeCache->emplace(fileName, pFileData);
+        }
 
         CComPtr<IDxcBlobEncoding> pSourceBlob;
 
@@ -280,6 +348,7 @@ public:
 private:
     CComPtr<IDxcLibrary>                   m_pdxcLibrary;
     IShaderSourceInputStreamFactory* const m_pStreamFactory;
+    IncludeCacheType* const                m_pIncludeCache;
     std::atomic_long                       m_RefCount{0};
     std::vector<RefCntAutoPtr<IDataBlob>>  m_FileDataCache;
 };
@@ -357,6 +426,29 @@ float4 main() : SV_Target0
     }
 }
 
+DXCompilerImpl::ThreadInstances& DXCompilerImpl::GetThreadInstances(DxcCreateInstanceProc CreateInstance) noexcept(false)
+{
+    ThreadInstances* pInstances = nullptr;
+    {
+        std::lock_guard<std::mutex> Lock{m_ThreadInstancesMtx};
+
+        auto& pThreadInstances = m_ThreadInstances[std::this_thread::get_id()];
+        if (!pThreadInstances)
+            pThreadInstances = std::make_unique<ThreadInstances>();
+        pInstances = pThreadInstances.get();
+    }
+
+    // The instances are only accessed by this thread, so they can be initialized without the lock
+    if (!pInstances->pLibrary)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pInstances->pLibrary)), "Failed to create DXC Library");
+    if (!pInstances->pCompiler)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pInstances->pCompiler)), "Failed to create DXC Compiler");
+    if (!pInstances->pValidator && m_Target == DXCompilerTarget::Direct3D12)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&pInstances->pValidator)), "Failed to create DXC Validator");
+
+    return *pInstances;
+}
+
 bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
 {
     try
@@ -373,22 +465,35 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         DEV_CHECK_ERR(Attribs.ppBlobOut != nullptr, "'ppBlobOut' must not be null");
         DEV_CHECK_ERR(Attribs.ppCompilerOutput != nullptr, "'ppCompilerOutput' must not be null");
 
+        CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+
         HRESULT hr;
 
         // NOTE: The call to DxcCreateInstance is thread-safe, but objects created by DxcCreateInstance aren't thread-safe.
         // Compiler objects should be created and then used on the same thread.
         // https://github.com/microsoft/DirectXShaderCompiler/wiki/Using-dxc.exe-and-dxcompiler.dll#dxcompiler-dll-interface
 
-        CComPtr<IDxcLibrary> pdxcLibrary;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
+        auto& Instances = GetThreadInstances(CreateInstance);
 
-        CComPtr<IDxcCompiler> pdxcCompiler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
+        IDxcLibrary* const  pdxcLibrary  = Instances.pLibrary;
+        IDxcCompiler* const pdxcCompiler = Instances.pCompiler;
 
         CComPtr<IDxcBlobEncoding> pSourceBlob;
         CHECK_D3D_RESULT(pdxcLibrary->CreateBlobWithEncodingFromPinned(Attribs.Source, UINT32{Attribs.SourceLength}, CP_UTF8, &pSourceBlob), "Failed to create DXC Blob Encoding");
 
-        DxcIncludeHandlerImpl IncludeHandler{Attribs.pShaderSourceStreamFactory, pdxcLibrary};
+        IncludeCacheType* pIncludeCache = nullptr;
+        if (Attribs.CacheIncludes && Attribs.pShaderSourceStreamFactory != nullptr)
+        {
+            // The cache is only valid for the stream factory the files were loaded from
+            if (Instances.pIncludeStreamFactory.Lock().RawPtr() != Attribs.pShaderSourceStreamFactory)
+            {
+                Instances.IncludeCache.clear();
+                Instances.pIncludeStreamFactory = RefCntWeakPtr<IShaderSourceInputStreamFactory>{Attribs.pShaderSourceStreamFactory};
+            }
+            pIncludeCache = &Instances.IncludeCache;
+        }
+
+        DxcIncludeHandlerImpl IncludeHandler{Attribs.pShaderSourceStreamFactory, pdxcLibrary, pIncludeCache};
 
         CComPtr<IDxcOperationResult> pdxcResult;
         hr = pdxcCompiler->Compile(
@@ -429,7 +534,7 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         // Validate and sign
         if (m_Target == DXCompilerTarget::Direct3D12)
         {
-            return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
+            return ValidateAndSign(Instances.pValidator, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
         }
         else
         {
@@ -443,10 +548,9 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
     }
 }
 
-bool DXCompilerImpl::ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
+bool DXCompilerImpl::ValidateAndSign(IDxcValidator* pdxcValidator, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
 {
-    CComPtr<IDxcValidator> pdxcValidator;
-    CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&pdxcValidator)), "Failed to create DXC Validator");
+    VERIFY_EXPR(pdxcValidator != nullptr);
 
     CComPtr<IDxcOperationResult> pdxcResult;
     CHECK_D3D_RESULT(pdxcValidator->Validate(compiled, DxcValidatorFlags_InPlaceEdit, &pdxcResult), "Failed to validate shader bytecode");
@@ -824,6 +928,7 @@ void DXCompilerImpl::Compile(const ShaderCreateInfo& ShaderCI,
     CA.pArgs                      = DxilArgs.data();
     CA.ArgsCount                  = static_cast<Uint32>(DxilArgs.size());
     CA.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
+    CA.CacheIncludes              = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_CACHE_INCLUDES) != 0;
     CA.ppBlobOut                  = &pDXIL;
     CA.ppCompilerOutput           = &pDxcLog;
 
@@ -1030,7 +1135,8 @@ bool DXCompilerImpl::PatchDXIL(const TResourceBindingMap& ResourceMap, TExtended
 {
     try
     {
-        if ((ShaderType & SHADER_TYPE_ALL_RAY_TRACING) != 0)
+        // Ray tracing and work graph shaders are compiled as libraries
+        if ((ShaderType & (SHADER_TYPE_ALL_RAY_TRACING | SHADER_TYPE_WORK_GRAPH)) != 0)
         {
             PatchResourceDeclarationRT(ResourceMap, ExtResMap, DXIL);
         }
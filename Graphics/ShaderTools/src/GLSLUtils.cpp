@@ -36,6 +36,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -44,7 +45,8 @@ String BuildGLSLSourceString(const ShaderCreateInfo&    ShaderCI,
                              const RenderDeviceInfo&    DeviceInfo,
                              const GraphicsAdapterInfo& AdapterInfo,
                              TargetGLSLCompiler         TargetCompiler,
-                             const char*                ExtraDefinitions) noexcept(false)
+                             const char*                ExtraDefinitions,
+                             HLSL2GLSLTokenCache*       pHLSL2GLSLTokenCache) noexcept(false)
 {
     // clang-format off
     VERIFY(ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
@@ -53,6 +55,8 @@ String BuildGLSLSourceString(const ShaderCreateInfo&    ShaderCI,
            "Unsupported shader source language");
     // clang-format on
 
+    CompilationStageTimer Timer{COMPILATION_STAGE_PREPROCESS};
+
     String GLSLSource;
 
     const auto ShaderType = ShaderCI.Desc.ShaderType;
@@ -124,6 +128,9 @@ String BuildGLSLSourceString(const ShaderCreateInfo&    ShaderCI,
     if ((ShaderType == SHADER_TYPE_HULL || ShaderType == SHADER_TYPE_DOMAIN) && !IsES32OrAbove)
         GLSLSource.append("#extension GL_EXT_tessellation_shader : enable\n");
 
+    if (ShaderType == SHADER_TYPE_PIXEL && DeviceInfo.Features.SubpassFramebufferFetch)
+        GLSLSource.append("#extension GL_EXT_shader_framebuffer_fetch : enable\n");
+
     GLSLSource.append(
         "#ifndef GL_ES\n"
         "#  define GL_ES 1\n"
@@ -302,6 +309,7 @@ String BuildGLSLSourceString(const ShaderCreateInfo&    ShaderCI,
         // https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_separate_shader_objects.txt
         // (search for "Input Layout Qualifiers" and "Output Layout Qualifiers").
         Attribs.UseInOutLocationQualifiers = DeviceInfo.Features.SeparablePrograms;
+        Attribs.pTokenCache                = pHLSL2GLSLTokenCache;
         auto ConvertedSource               = Converter.Convert(Attribs);
 
         GLSLSource.append(ConvertedSource);
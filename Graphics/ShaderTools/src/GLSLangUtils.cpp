@@ -29,6 +29,8 @@
 #include <unordered_map>
 #include <memory>
 #include <array>
+#include <mutex>
+#include <string>
 
 #if (defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_MACOS_MVK))
 #    include <MoltenGLSLToSPIRVConverter/GLSLToSPIRVConverter.h>
@@ -45,6 +47,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 // clang-format off
 static constexpr char g_HLSLDefinitions[] =
@@ -59,14 +62,29 @@ namespace Diligent
 namespace GLSLangUtils
 {
 
+namespace
+{
+
+// glslang process state is global, while several render devices and serialization
+// devices may initialize and finalize it independently and from different threads.
+std::mutex g_GlslangInitMtx;
+Uint32     g_GlslangInitCounter = 0;
+
+} // namespace
+
 void InitializeGlslang()
 {
-    ::glslang::InitializeProcess();
+    std::lock_guard<std::mutex> Lock{g_GlslangInitMtx};
+    if (g_GlslangInitCounter++ == 0)
+        ::glslang::InitializeProcess();
 }
 
 void FinalizeGlslang()
 {
-    ::glslang::FinalizeProcess();
+    std::lock_guard<std::mutex> Lock{g_GlslangInitMtx};
+    VERIFY(g_GlslangInitCounter > 0, "FinalizeGlslang() is called more times than InitializeGlslang()");
+    if (g_GlslangInitCounter > 0 && --g_GlslangInitCounter == 0)
+        ::glslang::FinalizeProcess();
 }
 
 namespace
@@ -74,7 +92,7 @@ namespace
 
 EShLanguage ShaderTypeToShLanguage(SHADER_TYPE ShaderType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please handle the new shader type in the switch below");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please handle the new shader type in the switch below");
     switch (ShaderType)
     {
         // clang-format off
@@ -94,6 +112,7 @@ EShLanguage ShaderTypeToShLanguage(SHADER_TYPE ShaderType)
         case SHADER_TYPE_CALLABLE:         return EShLangCallable;
         // clang-format on
         case SHADER_TYPE_TILE:
+        case SHADER_TYPE_WORK_GRAPH:
             UNEXPECTED("Unsupported shader type");
             return EShLangCount;
         default:
@@ -215,6 +234,35 @@ TBuiltInResource InitResources()
     return Resources;
 }
 
+// The limits never change, so they are initialized once and shared by all threads.
+const TBuiltInResource& GetResources()
+{
+    static const TBuiltInResource Resources = InitResources();
+    return Resources;
+}
+
+// The part of the HLSL preamble that does not depend on the shader.
+const std::string& GetHLSLPreamblePrefix()
+{
+    static const std::string Prefix = std::string{"#define GLSLANG\n\n"} + g_HLSLDefinitions;
+    return Prefix;
+}
+
+// glslang shaders and programs are single-use objects, but the rest of the compiler
+// state is kept per thread so that concurrent compilations do not share any
+// mutable data and do not reallocate it every time.
+struct CompilerThreadContext
+{
+    // The preamble must stay alive until the shader is parsed.
+    std::string Preamble;
+};
+
+CompilerThreadContext& GetThreadContext()
+{
+    static thread_local CompilerThreadContext Context;
+    return Context;
+}
+
 void LogCompilerError(const char* DebugOutputMessage,
                       const char* InfoLog,
                       const char* InfoDebugLog,
@@ -249,9 +297,11 @@ std::vector<unsigned int> CompileShaderInternal(::glslang::TShader&           Sh
                                                 ::EProfile                    shProfile,
                                                 IDataBlob**                   ppCompilerOutput)
 {
+    CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+
     Shader.setAutoMapBindings(true);
     Shader.setAutoMapLocations(true);
-    TBuiltInResource Resources = InitResources();
+    const TBuiltInResource& Resources = GetResources();
 
     auto ParseResult = pIncluder != nullptr ?
         Shader.parse(&Resources, 100, shProfile, false, false, messages, *pIncluder) :
@@ -422,8 +472,8 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     const auto SourceData = ReadShaderSourceFile(ShaderCI);
 
-    std::string Defines{"#define GLSLANG\n\n"};
-    Defines.append(g_HLSLDefinitions);
+    std::string& Defines = GetThreadContext().Preamble;
+    Defines.assign(GetHLSLPreamblePrefix());
     AppendShaderTypeDefinitions(Defines, ShaderCI.Desc.ShaderType);
 
     if (ExtraDefinitions != nullptr)
@@ -453,7 +503,8 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
-    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION | SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    const auto Passes         = GetSPIRVOptimizationFlags(GetSPIRVOptimizationLevel(ShaderCI.CompileFlags), /*Legalize = */ true);
+    auto       LegalizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, Passes);
     if (!LegalizedSPIRV.empty())
     {
         return LegalizedSPIRV;
@@ -485,7 +536,8 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
     int         Lengths[]       = {Attribs.SourceCodeLen};
     Shader.setStringsWithLengths(ShaderStrings, Lengths, 1);
 
-    std::string Defines{"#define GLSLANG\n\n"};
+    std::string& Defines = GetThreadContext().Preamble;
+    Defines.assign("#define GLSLANG\n\n");
     if (Attribs.Macros != nullptr)
         AppendShaderMacros(Defines, Attribs.Macros);
     Shader.setPreamble(Defines.c_str());
@@ -496,7 +548,11 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
     if (SPIRV.empty())
         return SPIRV;
 
-    auto OptimizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    const auto Passes = GetSPIRVOptimizationFlags(GetSPIRVOptimizationLevel(Attribs.CompileFlags), /*Legalize = */ false);
+    if (Passes == SPIRV_OPTIMIZATION_FLAG_NONE)
+        return SPIRV;
+
+    auto OptimizedSPIRV = OptimizeSPIRV(SPIRV, spvTarget, Passes);
     if (!OptimizedSPIRV.empty())
     {
         return OptimizedSPIRV;
@@ -31,6 +31,7 @@
 #include "HLSLUtils.hpp"
 #include "DebugUtilities.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 namespace Diligent
 {
@@ -46,6 +47,8 @@ static constexpr char g_HLSLDefinitions[] =
 String BuildHLSLSourceString(const ShaderCreateInfo& ShaderCI,
                              const char*             ExtraDefinitions) noexcept(false)
 {
+    CompilationStageTimer Timer{COMPILATION_STAGE_PREPROCESS};
+
     String HLSLSource;
 
     HLSLSource.append(g_HLSLDefinitions);
@@ -69,7 +72,7 @@ String GetHLSLProfileString(SHADER_TYPE ShaderType, ShaderVersion ShaderModel)
 {
     String strShaderProfile;
 
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     switch (ShaderType)
     {
         // clang-format off
@@ -86,7 +89,8 @@ String GetHLSLProfileString(SHADER_TYPE ShaderType, ShaderVersion ShaderModel)
         case SHADER_TYPE_RAY_CLOSEST_HIT:
         case SHADER_TYPE_RAY_ANY_HIT:
         case SHADER_TYPE_RAY_INTERSECTION:
-        case SHADER_TYPE_CALLABLE:         strShaderProfile = "lib"; break;
+        case SHADER_TYPE_CALLABLE:
+        case SHADER_TYPE_WORK_GRAPH:       strShaderProfile = "lib"; break;
         case SHADER_TYPE_TILE:
             UNSUPPORTED("Unsupported shader type");
             break;
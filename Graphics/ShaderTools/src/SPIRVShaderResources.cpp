@@ -124,6 +124,28 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cros
 // clang-format on
 {}
 
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       ResourceType       _Type,
+                                                       Uint16             _ArraySize,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       uint32_t           _BindingDecorationOffset,
+                                                       uint32_t           _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
+    // clang-format off
+    Name                          {_Name},
+    ArraySize                     {_ArraySize},
+    Type                          {_Type},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+    BufferStaticSize              {_BufferStaticSize},
+    BufferStride                  {_BufferStride}
+// clang-format on
+{}
+
 
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
@@ -194,7 +216,7 @@ PIPELINE_RESOURCE_FLAGS SPIRVShaderResourceAttribs::GetPipelineResourceFlags(Res
 
 spv::ExecutionModel ShaderTypeToSpvExecutionModel(SHADER_TYPE ShaderType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please handle the new shader type in the switch below");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please handle the new shader type in the switch below");
     switch (ShaderType)
     {
         // clang-format off
@@ -214,6 +236,7 @@ spv::ExecutionModel ShaderTypeToSpvExecutionModel(SHADER_TYPE ShaderType)
         case SHADER_TYPE_CALLABLE:         return spv::ExecutionModelCallableKHR;
         // clang-format on
         case SHADER_TYPE_TILE:
+        case SHADER_TYPE_WORK_GRAPH:
             UNEXPECTED("Unsupported shader type");
             return spv::ExecutionModelMax;
         default:
@@ -652,6 +675,211 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
     }
 }
 
+// Serialized reflection data layout:
+//
+//  | Header | Group offsets | Resources | Stage inputs |
+//
+// Resource names and stage input semantics are stored inline as null-terminated strings.
+static constexpr Uint32 SPIRVReflectionMagic   = 0x46525053; // 'SPRF'
+static constexpr Uint32 SPIRVReflectionVersion = 1;
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                                           const SerializedData&        ReflectionData,
+                                           const std::vector<uint32_t>& spirv_binary,
+                                           const ShaderDesc&            shaderDesc,
+                                           const char*                  CombinedSamplerSuffix,
+                                           std::string&                 EntryPoint) noexcept(false) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    Serializer<SerializerMode::Read> Ser{ReflectionData};
+
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+    if (!Ser(Magic, Version) || Magic != SPIRVReflectionMagic || Version != SPIRVReflectionVersion)
+        LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is invalid or has unsupported version");
+
+    Uint32      SPIRVSize      = 0;
+    SHADER_TYPE ShaderType     = SHADER_TYPE_UNKNOWN;
+    Uint8       IsHLSLSource   = 0;
+    const char* EntryPointName = nullptr;
+    if (!Ser(SPIRVSize, ShaderType, IsHLSLSource, m_ComputeGroupSize[0], m_ComputeGroupSize[1], m_ComputeGroupSize[2], EntryPointName))
+        LOG_ERROR_AND_THROW("Failed to read reflection data of shader '", shaderDesc.Name, "'");
+
+    if (SPIRVSize != spirv_binary.size() || ShaderType != shaderDesc.ShaderType)
+        LOG_ERROR_AND_THROW("Reflection data does not match the SPIR-V of shader '", shaderDesc.Name, "'");
+
+    // Offsets of the resource groups in the order they are stored in the memory buffer
+    std::array<OffsetType, 9> GroupEnds{};
+    OffsetType                NumShaderStageInputs = 0;
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please update the group offsets for the new resource type");
+    for (auto& GroupEnd : GroupEnds)
+    {
+        if (!Ser(GroupEnd))
+            LOG_ERROR_AND_THROW("Failed to read reflection data of shader '", shaderDesc.Name, "'");
+    }
+    if (!Ser(NumShaderStageInputs))
+        LOG_ERROR_AND_THROW("Failed to read reflection data of shader '", shaderDesc.Name, "'");
+
+    for (size_t i = 1; i < GroupEnds.size(); ++i)
+    {
+        if (GroupEnds[i] < GroupEnds[i - 1])
+            LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is corrupted");
+    }
+
+    struct ResourceData
+    {
+        const char* Name                          = nullptr;
+        Uint8       Type                          = 0;
+        Uint16      ArraySize                     = 0;
+        Uint8       ResourceDim                   = 0;
+        Uint8       IsMS                          = 0;
+        Uint32      BindingDecorationOffset       = 0;
+        Uint32      DescriptorSetDecorationOffset = 0;
+        Uint32      BufferStaticSize              = 0;
+        Uint32      BufferStride                  = 0;
+    };
+    std::vector<ResourceData> Resources(GroupEnds.back());
+
+    size_t ResourceNamesPoolSize = 0;
+    for (auto& Res : Resources)
+    {
+        if (!Ser(Res.Name, Res.Type, Res.ArraySize, Res.ResourceDim, Res.IsMS, Res.BindingDecorationOffset,
+                 Res.DescriptorSetDecorationOffset, Res.BufferStaticSize, Res.BufferStride))
+            LOG_ERROR_AND_THROW("Failed to read reflection data of shader '", shaderDesc.Name, "'");
+
+        if (Res.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes ||
+            Res.BindingDecorationOffset >= SPIRVSize ||
+            Res.DescriptorSetDecorationOffset >= SPIRVSize)
+            LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is corrupted");
+
+        ResourceNamesPoolSize += strlen(Res.Name) + 1;
+    }
+
+    std::vector<std::pair<const char*, Uint32>> StageInputs(NumShaderStageInputs);
+    for (auto& Input : StageInputs)
+    {
+        if (!Ser(Input.first, Input.second))
+            LOG_ERROR_AND_THROW("Failed to read reflection data of shader '", shaderDesc.Name, "'");
+
+        if (Input.second >= SPIRVSize)
+            LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is corrupted");
+
+        ResourceNamesPoolSize += strlen(Input.first) + 1;
+    }
+
+    if (!Ser.IsEnded())
+        LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is corrupted");
+
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs          = GroupEnds[0];
+    ResCounters.NumSBs          = GroupEnds[1] - GroupEnds[0];
+    ResCounters.NumImgs         = GroupEnds[2] - GroupEnds[1];
+    ResCounters.NumSmpldImgs    = GroupEnds[3] - GroupEnds[2];
+    ResCounters.NumACs          = GroupEnds[4] - GroupEnds[3];
+    ResCounters.NumSepSmplrs    = GroupEnds[5] - GroupEnds[4];
+    ResCounters.NumSepImgs      = GroupEnds[6] - GroupEnds[5];
+    ResCounters.NumInptAtts     = GroupEnds[7] - GroupEnds[6];
+    ResCounters.NumAccelStructs = GroupEnds[8] - GroupEnds[7];
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+
+    for (Uint32 n = 0; n < Resources.size(); ++n)
+    {
+        const auto& Res = Resources[n];
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                ResourceNamesPool.CopyString(Res.Name),
+                static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type),
+                Res.ArraySize,
+                static_cast<RESOURCE_DIMENSION>(Res.ResourceDim),
+                Res.IsMS != 0,
+                Res.BindingDecorationOffset,
+                Res.DescriptorSetDecorationOffset,
+                Res.BufferStaticSize,
+                Res.BufferStride //
+            };
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+    }
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    for (Uint32 i = 0; i < StageInputs.size(); ++i)
+    {
+        new (&GetShaderStageInputAttribs(i)) SPIRVShaderStageInputAttribs //
+            {
+                ResourceNamesPool.CopyString(StageInputs[i].first),
+                StageInputs[i].second //
+            };
+    }
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+
+    m_IsHLSLSource = IsHLSLSource != 0;
+    EntryPoint     = EntryPointName;
+}
+
+SerializedData SPIRVShaderResources::SerializeReflection(const std::vector<uint32_t>& spirv_binary,
+                                                         const char*                  EntryPoint,
+                                                         IMemoryAllocator&            Allocator) const
+{
+    auto SerializeData = [&](auto& Ser) {
+        const Uint32 Magic        = SPIRVReflectionMagic;
+        const Uint32 Version      = SPIRVReflectionVersion;
+        const Uint32 SPIRVSize    = static_cast<Uint32>(spirv_binary.size());
+        const Uint8  IsHLSLSource = m_IsHLSLSource ? 1 : 0;
+        if (!Ser(Magic, Version, SPIRVSize, m_ShaderType, IsHLSLSource, m_ComputeGroupSize[0], m_ComputeGroupSize[1], m_ComputeGroupSize[2], EntryPoint))
+            return false;
+
+        static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please serialize the new resource type offset");
+        if (!Ser(m_StorageBufferOffset, m_StorageImageOffset, m_SampledImageOffset, m_AtomicCounterOffset, m_SeparateSamplerOffset,
+                 m_SeparateImageOffset, m_InputAttachmentOffset, m_AccelStructOffset, m_TotalResources, m_NumShaderStageInputs))
+            return false;
+
+        for (Uint32 n = 0; n < GetTotalResources(); ++n)
+        {
+            const auto&  Res         = GetResource(n);
+            const Uint8  ResourceDim = Res.ResourceDim;
+            const Uint8  IsMS        = Res.IsMS;
+            const Uint32 BindingOffs = Res.BindingDecorationOffset;
+            const Uint32 DescSetOffs = Res.DescriptorSetDecorationOffset;
+            if (!Ser(Res.Name, Res.Type, Res.ArraySize, ResourceDim, IsMS, BindingOffs, DescSetOffs, Res.BufferStaticSize, Res.BufferStride))
+                return false;
+        }
+
+        for (Uint32 i = 0; i < GetNumShaderStageInputs(); ++i)
+        {
+            const auto&  Input        = GetShaderStageInputAttribs(i);
+            const Uint32 LocationOffs = Input.LocationDecorationOffset;
+            if (!Ser(Input.Semantic, LocationOffs))
+                return false;
+        }
+
+        return true;
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeData(MeasureSer);
+
+    auto Data = MeasureSer.AllocateData(Allocator);
+
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    SerializeData(WriteSer);
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    return Data;
+}
+
 SPIRVShaderResources::~SPIRVShaderResources()
 {
     for (Uint32 n = 0; n < GetNumUBs(); ++n)
@@ -24,8 +24,12 @@
  *  of the possibility of such damages.
  */
 
+#include <memory>
+#include <unordered_map>
+
 #include "SPIRVTools.hpp"
 #include "DebugUtilities.hpp"
+#include "CompilationStatisticsImpl.hpp"
 
 #include "spirv-tools/optimizer.hpp"
 
@@ -105,16 +109,11 @@ spv_target_env SpvTargetEnvFromSPIRV(const std::vector<uint32_t>& SPIRV)
     }
 }
 
-} // namespace
-
-std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+std::unique_ptr<spvtools::Optimizer> CreateOptimizer(spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
 {
-    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
-
-    if (TargetEnv == SPV_ENV_MAX)
-        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+    auto pOptimizer = std::make_unique<spvtools::Optimizer>(TargetEnv);
 
-    spvtools::Optimizer SpirvOptimizer(TargetEnv);
+    auto& SpirvOptimizer = *pOptimizer;
     SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
 
     // SPIR-V bytecode generated from HLSL must be legalized to
@@ -129,6 +128,11 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_t
         SpirvOptimizer.RegisterPerformancePasses();
     }
 
+    if (Passes & SPIRV_OPTIMIZATION_FLAG_SIZE)
+    {
+        SpirvOptimizer.RegisterSizePasses();
+    }
+
     if (Passes & SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION)
     {
         // Decorations defined in SPV_GOOGLE_hlsl_functionality1 are the only instructions
@@ -136,10 +140,111 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_t
         SpirvOptimizer.RegisterPass(spvtools::CreateStripReflectInfoPass());
     }
 
+    return pOptimizer;
+}
+
+// Registering the passes is expensive, so every thread keeps the optimizers it has configured.
+// An optimizer must not be run by multiple threads at the same time.
+spvtools::Optimizer& GetThreadOptimizer(spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
+    static_assert(SPV_ENV_MAX < (1u << 16u), "Target environment does not fit into 16 bits");
+    const Uint32 Key = (static_cast<Uint32>(TargetEnv) << 16u) | static_cast<Uint32>(Passes);
+
+    thread_local std::unordered_map<Uint32, std::unique_ptr<spvtools::Optimizer>> Optimizers;
+
+    auto& pOptimizer = Optimizers[Key];
+    if (!pOptimizer)
+        pOptimizer = CreateOptimizer(TargetEnv, Passes);
+    return *pOptimizer;
+}
+
+} // namespace
+
+SPIRV_OPTIMIZATION_LEVEL GetSPIRVOptimizationLevel(SHADER_COMPILE_FLAGS CompileFlags)
+{
+    if (CompileFlags & SHADER_COMPILE_FLAG_MINIMAL_OPTIMIZATION)
+        return SPIRV_OPTIMIZATION_LEVEL_FAST_DEV;
+    else if (CompileFlags & SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE)
+        return SPIRV_OPTIMIZATION_LEVEL_SIZE;
+    else
+        return SPIRV_OPTIMIZATION_LEVEL_PERFORMANCE;
+}
+
+SPIRV_OPTIMIZATION_FLAGS GetSPIRVOptimizationFlags(SPIRV_OPTIMIZATION_LEVEL Level, bool Legalize)
+{
+    SPIRV_OPTIMIZATION_FLAGS Flags = Legalize ? SPIRV_OPTIMIZATION_FLAG_LEGALIZATION : SPIRV_OPTIMIZATION_FLAG_NONE;
+    switch (Level)
+    {
+        case SPIRV_OPTIMIZATION_LEVEL_FAST_DEV:
+            break;
+
+        case SPIRV_OPTIMIZATION_LEVEL_SIZE:
+            Flags |= SPIRV_OPTIMIZATION_FLAG_SIZE;
+            break;
+
+        case SPIRV_OPTIMIZATION_LEVEL_PERFORMANCE:
+            Flags |= SPIRV_OPTIMIZATION_FLAG_PERFORMANCE;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected optimization level");
+    }
+    return Flags;
+}
+
+SPIRVStatistics GetSPIRVStatistics(const std::vector<uint32_t>& SPIRV)
+{
+    // The module starts with the 5-word header: magic number, version, generator, bound, schema
+    constexpr size_t HeaderSize = 5;
+    // Upper 16 bits of the first instruction word contain the word count, lower 16 bits contain the opcode
+    constexpr uint32_t OpFunction = 54;
+
+    SPIRVStatistics Stats;
+    Stats.Size = SPIRV.size() * sizeof(uint32_t);
+
+    for (size_t Pos = HeaderSize; Pos < SPIRV.size();)
+    {
+        const uint32_t WordCount = SPIRV[Pos] >> 16u;
+        const uint32_t OpCode    = SPIRV[Pos] & 0xFFFFu;
+        if (WordCount == 0)
+        {
+            UNEXPECTED("Invalid SPIR-V instruction at word ", Pos);
+            break;
+        }
+
+        ++Stats.NumInstructions;
+        if (OpCode == OpFunction)
+            ++Stats.NumFunctions;
+
+        Pos += WordCount;
+    }
+
+    return Stats;
+}
+
+std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
+                                    spv_target_env               TargetEnv,
+                                    SPIRV_OPTIMIZATION_FLAGS     Passes,
+                                    SPIRVStatistics*             pSrcStats,
+                                    SPIRVStatistics*             pDstStats)
+{
+    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    CompilationStageTimer Timer{COMPILATION_STAGE_OPTIMIZE};
+
+    if (TargetEnv == SPV_ENV_MAX)
+        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+
+    if (pSrcStats != nullptr)
+        *pSrcStats = GetSPIRVStatistics(SrcSPIRV);
+
     std::vector<uint32_t> OptimizedSPIRV;
-    if (!SpirvOptimizer.Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
+    if (!GetThreadOptimizer(TargetEnv, Passes).Run(SrcSPIRV.data(), SrcSPIRV.size(), &OptimizedSPIRV))
         OptimizedSPIRV.clear();
 
+    if (pDstStats != nullptr)
+        *pDstStats = GetSPIRVStatistics(OptimizedSPIRV);
+
     return OptimizedSPIRV;
 }
 
@@ -28,11 +28,13 @@
 #include "ShaderToolsCommon.hpp"
 
 #include <unordered_set>
+#include <cstring>
 
 #include "BasicFileSystem.hpp"
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
 #include "StringDataBlobImpl.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -54,12 +56,13 @@ const ShaderMacro RCHMacros[] = {{"RAY_CLOSEST_HIT_SHADER", "1"}, {}};
 const ShaderMacro RAHMacros[] = {{"RAY_ANY_HIT_SHADER", "1"}, {}};
 const ShaderMacro RIMacros[]  = {{"RAY_INTERSECTION_SHADER", "1"}, {}};
 const ShaderMacro RCMacros[]  = {{"RAY_CALLABLE_SHADER", "1"}, {}};
+const ShaderMacro WGMacros[]  = {{"WORK_GRAPH_SHADER", "1"}, {}};
 
 } // namespace
 
 const ShaderMacro* GetShaderTypeMacros(SHADER_TYPE Type)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the switch below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the switch below to handle the new shader type");
     switch (Type)
     {
         // clang-format off
@@ -77,6 +80,7 @@ const ShaderMacro* GetShaderTypeMacros(SHADER_TYPE Type)
         case SHADER_TYPE_RAY_ANY_HIT:      return RAHMacros;
         case SHADER_TYPE_RAY_INTERSECTION: return RIMacros;
         case SHADER_TYPE_CALLABLE:         return RCMacros;
+        case SHADER_TYPE_WORK_GRAPH:       return WGMacros;
         // clang-format on
         case SHADER_TYPE_TILE:
             UNEXPECTED("Unsupported shader type");
@@ -131,6 +135,8 @@ ShaderSourceFileData ReadShaderSourceFile(const char*                      Sourc
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
+                // Always copy the contents: the source may be kept after the read (e.g. by the include
+                // cache), while the view of a memory-mapped file changes when the file is modified on disk.
                 SourceData.pFileData = DataBlobImpl::Create();
                 pSourceStream->ReadBlob(SourceData.pFileData);
                 SourceData.Source       = reinterpret_cast<char*>(SourceData.pFileData->GetDataPtr());
@@ -360,41 +366,175 @@ static void ProcessIncludeErrorHandler(const ShaderCreateInfo& ShaderCI, const s
     throw std::pair<std::string, std::string>{std::move(FileInfo), Error};
 }
 
-template <typename IncludeHandlerType>
-void ProcessShaderIncludesImpl(const ShaderCreateInfo& ShaderCI, std::unordered_set<std::string>& Includes, IncludeHandlerType&& IncludeHandler) noexcept(false)
-{
-    const auto SourceData = ReadShaderSourceFile(ShaderCI);
+using ShaderFileInfo = ShaderIncludeCache::FileInfo;
 
-    ShaderIncludePreprocessInfo FileInfo;
-    FileInfo.Source       = SourceData.Source;
-    FileInfo.SourceLength = SourceData.SourceLength;
-    FileInfo.FilePath     = ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "";
+template <typename ErrorHandlerType>
+static std::shared_ptr<ShaderFileInfo> ParseShaderSourceFile(ShaderSourceFileData SourceData, ErrorHandlerType&& ErrorHandler) noexcept(false)
+{
+    auto pFileInfo          = std::make_shared<ShaderFileInfo>();
+    pFileInfo->pFileData    = std::move(SourceData.pFileData);
+    pFileInfo->Source       = SourceData.Source;
+    pFileInfo->SourceLength = SourceData.SourceLength;
+    pFileInfo->Hash         = ComputeHashRaw(pFileInfo->Source, pFileInfo->SourceLength);
 
     FindIncludes(
-        FileInfo.Source, FileInfo.SourceLength,
+        pFileInfo->Source, pFileInfo->SourceLength,
         [&](const std::string& FilePath, size_t Start, size_t End) //
         {
-            if (!Includes.insert(FilePath).second)
-                return;
-
-            auto IncludeCI{ShaderCI};
-            IncludeCI.FilePath     = FilePath.c_str();
-            IncludeCI.Source       = nullptr;
-            IncludeCI.SourceLength = 0;
-            ProcessShaderIncludesImpl(IncludeCI, Includes, IncludeHandler);
+            pFileInfo->Includes.push_back({FilePath, Start, End});
         },
-        std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+        std::forward<ErrorHandlerType>(ErrorHandler));
+
+    return pFileInfo;
+}
+
+size_t ShaderIncludeCache::FileKey::Hasher::operator()(const FileKey& Key) const noexcept
+{
+    return ComputeHash(Key.pStreamFactory, Key.Path);
+}
+
+std::shared_ptr<const ShaderIncludeCache::FileInfo> ShaderIncludeCache::GetFile(IShaderSourceInputStreamFactory* pStreamFactory, const char* FilePath) noexcept(false)
+{
+    VERIFY_EXPR(pStreamFactory != nullptr && FilePath != nullptr);
+
+    FileKey Key{pStreamFactory, FilePath};
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Files.find(Key);
+        if (it != m_Files.end())
+        {
+            if (it->second.pStreamFactory.Lock().RawPtr() == pStreamFactory)
+                return it->second.pFileInfo;
+
+            // The file was loaded from a different factory that has been released
+            m_Files.erase(it);
+        }
+    }
+
+    // Load and parse the file without holding the lock
+    std::shared_ptr<const FileInfo> pFileInfo;
+    try
+    {
+        pFileInfo = ParseShaderSourceFile(ReadShaderSourceFile(nullptr, 0, pStreamFactory, FilePath),
+                                          [](const std::string& Error) {
+                                              throw Error;
+                                          });
+    }
+    catch (const std::string& Error)
+    {
+        LOG_ERROR_AND_THROW("Failed to process includes in file '", FilePath, "': ", Error);
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // Another thread may have added the same file in the meantime
+    auto it = m_Files.emplace(std::move(Key), CacheEntry{RefCntWeakPtr<IShaderSourceInputStreamFactory>{pStreamFactory}, pFileInfo}).first;
+    return it->second.pFileInfo;
+}
+
+void ShaderIncludeCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Files.clear();
+}
+
+std::unordered_set<std::string> ShaderIncludeCache::RemoveModifiedFiles()
+{
+    // Load the files without holding the lock
+    std::vector<std::pair<FileKey, CacheEntry>> Files;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        Files.assign(m_Files.begin(), m_Files.end());
+    }
+
+    std::unordered_set<std::string> ModifiedFiles;
+    for (auto& File : Files)
+    {
+        const auto& pFileInfo = File.second.pFileInfo;
+
+        bool IsModified = true;
+        if (auto pStreamFactory = File.second.pStreamFactory.Lock())
+        {
+            try
+            {
+                const auto SourceData = ReadShaderSourceFile(nullptr, 0, pStreamFactory, File.first.Path.c_str());
+                IsModified = (SourceData.SourceLength != pFileInfo->SourceLength ||
+                              memcmp(SourceData.Source, pFileInfo->Source, SourceData.SourceLength) != 0);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        if (!IsModified)
+            continue;
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            auto it = m_Files.find(File.first);
+            // The entry may have been replaced by another thread
+            if (it != m_Files.end() && it->second.pFileInfo == pFileInfo)
+                m_Files.erase(it);
+        }
+        ModifiedFiles.emplace(File.first.Path);
+    }
+
+    return ModifiedFiles;
+}
+
+size_t ShaderIncludeCache::GetNumFiles() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Files.size();
+}
+
+static std::shared_ptr<const ShaderFileInfo> LoadShaderSourceFile(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache) noexcept(false)
+{
+    if (pIncludeCache != nullptr && ShaderCI.Source == nullptr && ShaderCI.FilePath != nullptr && ShaderCI.pShaderSourceStreamFactory != nullptr)
+        return pIncludeCache->GetFile(ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath);
+
+    return ParseShaderSourceFile(ReadShaderSourceFile(ShaderCI), std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+}
+
+template <typename IncludeHandlerType>
+void ProcessShaderIncludesImpl(const ShaderCreateInfo&          ShaderCI,
+                               ShaderIncludeCache*              pIncludeCache,
+                               std::unordered_set<std::string>& Includes,
+                               IncludeHandlerType&&             IncludeHandler) noexcept(false)
+{
+    const auto pFileInfo = LoadShaderSourceFile(ShaderCI, pIncludeCache);
+
+    for (const auto& Include : pFileInfo->Includes)
+    {
+        if (!Includes.insert(Include.Path).second)
+            continue;
+
+        auto IncludeCI{ShaderCI};
+        IncludeCI.FilePath     = Include.Path.c_str();
+        IncludeCI.Source       = nullptr;
+        IncludeCI.SourceLength = 0;
+        ProcessShaderIncludesImpl(IncludeCI, pIncludeCache, Includes, IncludeHandler);
+    }
 
     if (IncludeHandler)
+    {
+        ShaderIncludePreprocessInfo FileInfo;
+        FileInfo.Source       = pFileInfo->Source;
+        FileInfo.SourceLength = pFileInfo->SourceLength;
+        FileInfo.FilePath     = ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "";
         IncludeHandler(FileInfo);
+    }
 }
 
-bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler) noexcept
+bool ProcessShaderIncludes(const ShaderCreateInfo&                                  ShaderCI,
+                           std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler,
+                           ShaderIncludeCache*                                      pIncludeCache) noexcept
 {
     try
     {
         std::unordered_set<std::string> Includes;
-        ProcessShaderIncludesImpl(ShaderCI, Includes, IncludeHandler);
+        ProcessShaderIncludesImpl(ShaderCI, pIncludeCache, Includes, IncludeHandler);
         return true;
     }
     catch (const std::pair<std::string, std::string>& ErrInfo)
@@ -409,44 +549,38 @@ bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(
     }
 }
 
-static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unordered_set<std::string>& AllIncludes) noexcept(false)
+static std::string UnrollShaderIncludesImpl(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache, std::unordered_set<std::string>& AllIncludes) noexcept(false)
 {
-    const auto SourceData = ReadShaderSourceFile(ShaderCI);
-
-    ShaderCI.Source       = SourceData.Source;
-    ShaderCI.SourceLength = SourceData.SourceLength;
-    ShaderCI.FilePath     = nullptr;
+    const auto pFileInfo = LoadShaderSourceFile(ShaderCI, pIncludeCache);
 
     std::stringstream Stream;
     size_t            PrevIncludeEnd = 0;
 
-    FindIncludes(
-        ShaderCI.Source, ShaderCI.SourceLength, [&](const std::string& Path, size_t IncludeStart, size_t IncludeEnd) {
-            // Insert text before the include start
-            Stream.write(ShaderCI.Source + PrevIncludeEnd, IncludeStart - PrevIncludeEnd);
+    for (const auto& Include : pFileInfo->Includes)
+    {
+        // Insert text before the include start
+        Stream.write(pFileInfo->Source + PrevIncludeEnd, Include.Start - PrevIncludeEnd);
 
-            if (AllIncludes.insert(Path).second)
-            {
-                // Process the #include directive
-                ShaderCreateInfo IncludeCI{ShaderCI};
-                IncludeCI.Source       = nullptr;
-                IncludeCI.SourceLength = 0;
-                IncludeCI.FilePath     = Path.c_str();
-                auto UnrolledInclude   = UnrollShaderIncludesImpl(IncludeCI, AllIncludes);
-                Stream << UnrolledInclude;
-            }
+        if (AllIncludes.insert(Include.Path).second)
+        {
+            // Process the #include directive
+            ShaderCreateInfo IncludeCI{ShaderCI};
+            IncludeCI.Source       = nullptr;
+            IncludeCI.SourceLength = 0;
+            IncludeCI.FilePath     = Include.Path.c_str();
+            Stream << UnrollShaderIncludesImpl(IncludeCI, pIncludeCache, AllIncludes);
+        }
 
-            PrevIncludeEnd = IncludeEnd;
-        },
-        std::bind(ProcessIncludeErrorHandler, ShaderCI, std::placeholders::_1));
+        PrevIncludeEnd = Include.End;
+    }
 
     // Insert text after the last include
-    Stream.write(ShaderCI.Source + PrevIncludeEnd, ShaderCI.SourceLength - PrevIncludeEnd);
+    Stream.write(pFileInfo->Source + PrevIncludeEnd, pFileInfo->SourceLength - PrevIncludeEnd);
 
     return Stream.str();
 }
 
-std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false)
+std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI, ShaderIncludeCache* pIncludeCache) noexcept(false)
 {
     std::unordered_set<std::string> Includes;
     if (ShaderCI.FilePath != nullptr)
@@ -454,7 +588,7 @@ std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(fals
 
     try
     {
-        return UnrollShaderIncludesImpl(ShaderCI, Includes);
+        return UnrollShaderIncludesImpl(ShaderCI, pIncludeCache, Includes);
     }
     catch (const std::pair<std::string, std::string>& ErrInfo)
     {
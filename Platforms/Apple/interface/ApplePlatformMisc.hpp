@@ -36,6 +36,28 @@ namespace Diligent
 
 struct AppleMisc : public LinuxMisc
 {
+    /// Apple platforms do not support thread affinity, so this method always fails and returns 0.
+    static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    static ThreadPriority GetCurrentThreadPriority();
+
+    /// Sets the current thread priority and on success returns the previous priority.
+    /// On failure, returns ThreadPriority::Unknown.
+    ///
+    /// \remarks   Thread priorities are mapped to QoS classes, from QOS_CLASS_BACKGROUND for
+    ///            ThreadPriority::Lowest to QOS_CLASS_USER_INTERACTIVE for ThreadPriority::Highest.
+    ///            On Apple silicon, the OS schedules low-QoS threads on the efficiency cores.
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the mask of all cores for CPUCoreType::Any and 0 otherwise, since threads can't be
+    /// pinned to specific cores. Use SetCurrentThreadPriority() to direct threads to the efficiency cores.
+    static Uint64 GetCPUCoreMask(CPUCoreType Type);
+
+    /// Returns the CPU information, see BasicPlatformMisc::GetCPUInfo().
+    ///
+    /// \remarks   The core topology and cache sizes are queried with sysctl. On Apple silicon,
+    ///            the cores of the first performance level are reported as performance cores.
+    static const CPUInfo& GetCPUInfo();
 };
 
 } // namespace Diligent
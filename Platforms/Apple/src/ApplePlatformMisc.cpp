@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ApplePlatformMisc.hpp"
+
+#include <unistd.h>
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <sys/sysctl.h>
+
+namespace Diligent
+{
+
+Uint64 AppleMisc::SetCurrentThreadAffinity(Uint64 Mask)
+{
+    LOG_WARNING_MESSAGE_ONCE("Thread affinity is not supported on Apple platforms.");
+    return 0;
+}
+
+
+static ThreadPriority QoSClassToThreadPriority(qos_class_t QoS)
+{
+    switch (QoS)
+    {
+        // clang-format off
+        case QOS_CLASS_BACKGROUND:       return ThreadPriority::Lowest;
+        case QOS_CLASS_UTILITY:          return ThreadPriority::BelowNormal;
+        case QOS_CLASS_DEFAULT:          return ThreadPriority::Normal;
+        case QOS_CLASS_UNSPECIFIED:      return ThreadPriority::Normal;
+        case QOS_CLASS_USER_INITIATED:   return ThreadPriority::AboveNormal;
+        case QOS_CLASS_USER_INTERACTIVE: return ThreadPriority::Highest;
+        default:                         return ThreadPriority::Unknown;
+            // clang-format on
+    }
+}
+
+static qos_class_t ThreadPriorityToQoSClass(ThreadPriority Priority)
+{
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:      return QOS_CLASS_BACKGROUND;
+        case ThreadPriority::BelowNormal: return QOS_CLASS_UTILITY;
+        case ThreadPriority::Normal:      return QOS_CLASS_DEFAULT;
+        case ThreadPriority::AboveNormal: return QOS_CLASS_USER_INITIATED;
+        case ThreadPriority::Highest:     return QOS_CLASS_USER_INTERACTIVE;
+        default:                          return QOS_CLASS_DEFAULT;
+            // clang-format on
+    }
+}
+
+ThreadPriority AppleMisc::GetCurrentThreadPriority()
+{
+    qos_class_t QoS              = QOS_CLASS_UNSPECIFIED;
+    int         RelativePriority = 0;
+    if (pthread_get_qos_class_np(pthread_self(), &QoS, &RelativePriority) != 0)
+        return ThreadPriority::Unknown;
+
+    return QoSClassToThreadPriority(QoS);
+}
+
+ThreadPriority AppleMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    const auto OrigPriority = GetCurrentThreadPriority();
+    if (pthread_set_qos_class_self_np(ThreadPriorityToQoSClass(Priority), 0) == 0)
+        return OrigPriority;
+    else
+        return ThreadPriority::Unknown;
+}
+
+Uint64 AppleMisc::GetCPUCoreMask(CPUCoreType Type)
+{
+    if (Type != CPUCoreType::Any)
+        return 0;
+
+    const long NumCores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (NumCores <= 0)
+        return 0;
+
+    return NumCores >= 64 ? ~Uint64{0} : (Uint64{1} << NumCores) - 1;
+}
+
+// Returns the value of the integer sysctl variable or 0 if the variable does not exist
+static Uint32 GetSysctlValue(const char* Name)
+{
+    // The variables are either 32- or 64-bit
+    Uint64 Value = 0;
+    size_t Size  = sizeof(Value);
+    if (sysctlbyname(Name, &Value, &Size, nullptr, 0) != 0)
+        return 0;
+
+    return Size == sizeof(Uint32) ? *reinterpret_cast<const Uint32*>(&Value) : static_cast<Uint32>(Value);
+}
+
+const CPUInfo& AppleMisc::GetCPUInfo()
+{
+    static const CPUInfo CachedInfo = [] {
+        CPUInfo Info = QueryBasicCPUInfo();
+
+        if (const Uint32 NumLogicalCores = GetSysctlValue("hw.logicalcpu"))
+            Info.NumLogicalCores = NumLogicalCores;
+        Info.NumPhysicalCores = GetSysctlValue("hw.physicalcpu");
+        if (Info.NumPhysicalCores == 0)
+            Info.NumPhysicalCores = Info.NumLogicalCores;
+
+        // Apple silicon reports performance levels starting with the highest-performance one
+        if (GetSysctlValue("hw.nperflevels") > 1)
+        {
+            Info.NumPerformanceCores = GetSysctlValue("hw.perflevel0.logicalcpu");
+            Info.NumEfficiencyCores  = GetSysctlValue("hw.perflevel1.logicalcpu");
+        }
+        else
+        {
+            Info.NumPerformanceCores = Info.NumLogicalCores;
+        }
+
+        if (const Uint32 CacheLineSize = GetSysctlValue("hw.cachelinesize"))
+            Info.CacheLineSize = CacheLineSize;
+        Info.L1DataCacheSize = GetSysctlValue("hw.l1dcachesize");
+        Info.L2CacheSize     = GetSysctlValue("hw.l2cachesize");
+        Info.L3CacheSize     = GetSysctlValue("hw.l3cachesize");
+
+        return Info;
+    }();
+    return CachedInfo;
+}
+
+} // namespace Diligent
@@ -28,6 +28,7 @@
 #pragma once
 
 #include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/FlagEnum.h"
 
 namespace Diligent
 {
@@ -42,6 +43,88 @@ enum class ThreadPriority
     Highest
 };
 
+enum class CPUCoreType
+{
+    /// All cores available to the process.
+    Any,
+
+    /// High-performance cores (e.g. P-cores of hybrid Intel CPUs or big cores of ARM big.LITTLE CPUs).
+    Performance,
+
+    /// Energy-efficient cores (e.g. E-cores of hybrid Intel CPUs or LITTLE cores of ARM CPUs).
+    Efficiency
+};
+
+/// CPU instruction set extensions.
+enum CPU_FEATURE_FLAGS : Uint32
+{
+    CPU_FEATURE_FLAG_NONE = 0u,
+
+    /// x86 SSE2 instructions.
+    CPU_FEATURE_FLAG_SSE2 = 1u << 0u,
+
+    /// x86 SSE4.1 instructions.
+    CPU_FEATURE_FLAG_SSE4_1 = 1u << 1u,
+
+    /// x86 SSE4.2 instructions.
+    CPU_FEATURE_FLAG_SSE4_2 = 1u << 2u,
+
+    /// x86 AVX instructions. The flag is only set if the OS saves the AVX registers.
+    CPU_FEATURE_FLAG_AVX = 1u << 3u,
+
+    /// x86 AVX2 instructions.
+    CPU_FEATURE_FLAG_AVX2 = 1u << 4u,
+
+    /// x86 fused multiply-add (FMA3) instructions.
+    CPU_FEATURE_FLAG_FMA = 1u << 5u,
+
+    /// x86 AVX-512 foundation instructions. The flag is only set if the OS saves the AVX-512 registers.
+    CPU_FEATURE_FLAG_AVX512F = 1u << 6u,
+
+    /// ARM NEON (Advanced SIMD) instructions.
+    CPU_FEATURE_FLAG_NEON = 1u << 7u,
+
+    /// ARM Scalable Vector Extension.
+    CPU_FEATURE_FLAG_SVE = 1u << 8u,
+
+    CPU_FEATURE_FLAG_LAST = CPU_FEATURE_FLAG_SVE
+};
+DEFINE_FLAG_ENUM_OPERATORS(CPU_FEATURE_FLAGS)
+
+/// CPU information, see BasicPlatformMisc::GetCPUInfo().
+
+/// \remarks   Members that can't be determined on the current platform are zero.
+struct CPUInfo
+{
+    /// Supported instruction set extensions.
+    CPU_FEATURE_FLAGS Features = CPU_FEATURE_FLAG_NONE;
+
+    /// The number of logical processors (hardware threads).
+    Uint32 NumLogicalCores = 0;
+
+    /// The number of physical cores. On CPUs with simultaneous multithreading,
+    /// this is less than the number of logical cores.
+    Uint32 NumPhysicalCores = 0;
+
+    /// The number of logical processors on performance cores, see CPUCoreType::Performance.
+    Uint32 NumPerformanceCores = 0;
+
+    /// The number of logical processors on efficiency cores, see CPUCoreType::Efficiency.
+    Uint32 NumEfficiencyCores = 0;
+
+    /// The size of the cache line, in bytes.
+    Uint32 CacheLineSize = 0;
+
+    /// The size of the L1 data cache of one core, in bytes.
+    Uint32 L1DataCacheSize = 0;
+
+    /// The size of the L2 cache, in bytes.
+    Uint32 L2CacheSize = 0;
+
+    /// The size of the L3 cache, in bytes.
+    Uint32 L3CacheSize = 0;
+};
+
 struct BasicPlatformMisc
 {
     template <typename Type>
@@ -107,6 +190,22 @@ struct BasicPlatformMisc
     /// On failure, returns ThreadPriority::Unknown.
     static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
 
+    /// Returns the affinity mask of the cores of the given type.
+    /// Returns 0 if the core types can't be determined or if the system has no cores of this type.
+    /// On systems where all cores are identical, all cores are reported as performance cores.
+    static Uint64 GetCPUCoreMask(CPUCoreType Type);
+
+    /// Returns the CPU information. The information is queried once and cached.
+
+    /// \remarks   The basic implementation only detects the instruction set extensions and
+    ///            the number of logical cores, and reports every logical core as a physical one.
+    static const CPUInfo& GetCPUInfo();
+
+protected:
+    /// Detects the instruction set extensions supported by the CPU and the OS,
+    /// the number of logical cores and, on x86, the cache line size.
+    static CPUInfo QueryBasicCPUInfo();
+
 private:
     static void SwapBytes16(Uint16& Val)
     {
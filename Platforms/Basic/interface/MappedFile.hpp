@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+#if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_ANDROID
+/// Memory-mapped files are supported on the target platform
+#    define DILIGENT_MAPPED_FILE_SUPPORTED 1
+#else
+#    define DILIGENT_MAPPED_FILE_SUPPORTED 0
+#endif
+
+namespace Diligent
+{
+
+/// Read-only memory-mapped file.
+
+/// The file contents are mapped into the address space of the process, and the pages
+/// are only loaded from disk when they are accessed for the first time.
+///
+/// \warning   The mapping is a view of the file on disk: if the file is modified in place,
+///            the mapped contents may change, and accessing the pages past the end of
+///            a truncated file may raise a bus error. Data that is kept after the file
+///            has been read (e.g. cached shader sources) should be copied.
+class MappedFile
+{
+public:
+    /// Maps the file into memory.
+
+    /// \param [in] Path - Path to the file to map.
+    ///
+    /// \remarks    The constructor throws an exception if the file can't be mapped.
+    explicit MappedFile(const char* Path) noexcept(false);
+    ~MappedFile();
+
+    // clang-format off
+    MappedFile           (const MappedFile&)  = delete;
+    MappedFile& operator=(const MappedFile&)  = delete;
+    MappedFile           (      MappedFile&&) = delete;
+    MappedFile& operator=(      MappedFile&&) = delete;
+    // clang-format on
+
+    /// Returns the pointer to the mapped file contents.
+    const void* GetData() const { return m_pData; }
+
+    /// Returns the size of the file, in bytes.
+    size_t GetSize() const { return m_Size; }
+
+private:
+    void Unmap();
+
+private:
+    const void* m_pData = nullptr;
+    size_t      m_Size  = 0;
+
+#if PLATFORM_WIN32
+    void* m_hFile    = nullptr;
+    void* m_hMapping = nullptr;
+#endif
+};
+
+} // namespace Diligent
@@ -25,8 +25,20 @@
  */
 
 #include "BasicPlatformMisc.hpp"
+
+#include <thread>
+
 #include "DebugUtilities.hpp"
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#    define DILIGENT_CPU_X86 1
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#endif
+
 namespace Diligent
 {
 
@@ -42,4 +54,113 @@ ThreadPriority BasicPlatformMisc::SetCurrentThreadPriority(ThreadPriority Priori
     return ThreadPriority::Unknown;
 }
 
+Uint64 BasicPlatformMisc::GetCPUCoreMask(CPUCoreType Type)
+{
+    LOG_WARNING_MESSAGE_ONCE("GetCPUCoreMask is not implemented on this platform.");
+    return 0;
+}
+
+#if DILIGENT_CPU_X86
+
+static void CPUID(Uint32 Leaf, Uint32 SubLeaf, Uint32 Regs[4])
+{
+#    if defined(_MSC_VER)
+    int Info[4] = {};
+    __cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+    for (size_t i = 0; i < 4; ++i)
+        Regs[i] = static_cast<Uint32>(Info[i]);
+#    else
+    __cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+#    endif
+}
+
+// Returns the XCR0 register that indicates which register states the OS saves on context switches
+static Uint64 GetXCR0()
+{
+#    if defined(_MSC_VER)
+    return _xgetbv(0);
+#    else
+    // Use the raw instruction so that the file does not need to be compiled with -mxsave
+    Uint32 Lo = 0, Hi = 0;
+    __asm__ volatile("xgetbv"
+                     : "=a"(Lo), "=d"(Hi)
+                     : "c"(0));
+    return (Uint64{Hi} << 32u) | Lo;
+#    endif
+}
+
+static void QueryX86Features(CPUInfo& Info)
+{
+    Uint32 Regs[4] = {}; // EAX, EBX, ECX, EDX
+    CPUID(0, 0, Regs);
+    const Uint32 MaxLeaf = Regs[0];
+    if (MaxLeaf < 1)
+        return;
+
+    CPUID(1, 0, Regs);
+    const Uint32 ECX1 = Regs[2];
+    const Uint32 EDX1 = Regs[3];
+
+    // CLFLUSH line size, in 8-byte units
+    Info.CacheLineSize = ((Regs[1] >> 8u) & 0xFFu) * 8u;
+
+    if (EDX1 & (1u << 26u))
+        Info.Features |= CPU_FEATURE_FLAG_SSE2;
+    if (ECX1 & (1u << 19u))
+        Info.Features |= CPU_FEATURE_FLAG_SSE4_1;
+    if (ECX1 & (1u << 20u))
+        Info.Features |= CPU_FEATURE_FLAG_SSE4_2;
+
+    // AVX instructions can only be used if the OS saves the YMM registers (XCR0 bits 1 and 2)
+    // and AVX-512 - if it also saves the opmask and ZMM registers (XCR0 bits 5, 6, 7).
+    const bool   OSXSave  = (ECX1 & (1u << 27u)) != 0;
+    const Uint64 XCR0     = OSXSave ? GetXCR0() : 0;
+    const bool   OSAVX    = (XCR0 & 0x06u) == 0x06u;
+    const bool   OSAVX512 = (XCR0 & 0xE6u) == 0xE6u;
+    if (!OSAVX)
+        return;
+
+    if (ECX1 & (1u << 28u))
+        Info.Features |= CPU_FEATURE_FLAG_AVX;
+    if (ECX1 & (1u << 12u))
+        Info.Features |= CPU_FEATURE_FLAG_FMA;
+
+    if (MaxLeaf >= 7)
+    {
+        CPUID(7, 0, Regs);
+        const Uint32 EBX7 = Regs[1];
+        if (EBX7 & (1u << 5u))
+            Info.Features |= CPU_FEATURE_FLAG_AVX2;
+        if (OSAVX512 && (EBX7 & (1u << 16u)))
+            Info.Features |= CPU_FEATURE_FLAG_AVX512F;
+    }
+}
+
+#endif
+
+CPUInfo BasicPlatformMisc::QueryBasicCPUInfo()
+{
+    CPUInfo Info;
+    Info.NumLogicalCores = std::thread::hardware_concurrency();
+
+#if DILIGENT_CPU_X86
+    QueryX86Features(Info);
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    // NEON is mandatory on AArch64. On 32-bit ARM, we only rely on it when the code is compiled with NEON.
+    Info.Features |= CPU_FEATURE_FLAG_NEON;
+#endif
+
+    return Info;
+}
+
+const CPUInfo& BasicPlatformMisc::GetCPUInfo()
+{
+    static const CPUInfo CachedInfo = [] {
+        CPUInfo Info          = QueryBasicCPUInfo();
+        Info.NumPhysicalCores = Info.NumLogicalCores;
+        return Info;
+    }();
+    return CachedInfo;
+}
+
 } // namespace Diligent
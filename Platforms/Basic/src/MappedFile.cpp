@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+#if PLATFORM_WIN32
+#    include "../../../Common/interface/StringTools.hpp"
+#    include "../../Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Win32/interface/WinHPostface.h"
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Diligent
+{
+
+#if PLATFORM_WIN32
+
+MappedFile::MappedFile(const char* Path) noexcept(false)
+{
+    VERIFY_EXPR(Path != nullptr);
+
+    HANDLE hFile = CreateFileW(WidenString(Path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        LOG_ERROR_AND_THROW("Failed to open file '", Path, "'. Error code: ", GetLastError());
+    m_hFile = hFile;
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(hFile, &FileSize))
+    {
+        const auto Error = GetLastError();
+        Unmap();
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", Path, "'. Error code: ", Error);
+    }
+
+    m_Size = static_cast<size_t>(FileSize.QuadPart);
+    if (m_Size == 0)
+        return; // Empty files can't be mapped
+
+    m_hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr)
+    {
+        const auto Error = GetLastError();
+        Unmap();
+        LOG_ERROR_AND_THROW("Failed to create file mapping for '", Path, "'. Error code: ", Error);
+    }
+
+    m_pData = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pData == nullptr)
+    {
+        const auto Error = GetLastError();
+        Unmap();
+        LOG_ERROR_AND_THROW("Failed to map file '", Path, "'. Error code: ", Error);
+    }
+}
+
+void MappedFile::Unmap()
+{
+    if (m_pData != nullptr)
+    {
+        UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+
+    if (m_hMapping != nullptr)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+
+    if (m_hFile != nullptr)
+    {
+        CloseHandle(m_hFile);
+        m_hFile = nullptr;
+    }
+
+    m_Size = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const char* Path) noexcept(false)
+{
+    VERIFY_EXPR(Path != nullptr);
+
+    const auto fd = open(Path, O_RDONLY);
+    if (fd < 0)
+        LOG_ERROR_AND_THROW("Failed to open file '", Path, "'.\nThe following error occurred: ", strerror(errno));
+
+    struct stat FileStat;
+    if (fstat(fd, &FileStat) != 0)
+    {
+        const auto Error = errno;
+        close(fd);
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", Path, "'.\nThe following error occurred: ", strerror(Error));
+    }
+
+    m_Size = static_cast<size_t>(FileStat.st_size);
+    if (m_Size > 0)
+    {
+        auto* pData = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pData == MAP_FAILED)
+        {
+            const auto Error = errno;
+            close(fd);
+            LOG_ERROR_AND_THROW("Failed to map file '", Path, "'.\nThe following error occurred: ", strerror(Error));
+        }
+        m_pData = pData;
+    }
+
+    // The mapping remains valid after the file descriptor is closed
+    close(fd);
+}
+
+void MappedFile::Unmap()
+{
+    if (m_pData != nullptr)
+    {
+        munmap(const_cast<void*>(m_pData), m_Size);
+        m_pData = nullptr;
+    }
+    m_Size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    Unmap();
+}
+
+} // namespace Diligent
@@ -33,6 +33,13 @@ namespace Diligent
 {
 
 struct EmscriptenMisc : public LinuxMisc
-{};
+{
+    /// Returns the CPU information, see BasicPlatformMisc::GetCPUInfo().
+    /// The CPU topology is not exposed to WebAssembly, so only the number of logical cores is reported.
+    static const CPUInfo& GetCPUInfo()
+    {
+        return BasicPlatformMisc::GetCPUInfo();
+    }
+};
 
 } // namespace Diligent
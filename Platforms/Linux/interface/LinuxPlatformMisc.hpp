@@ -111,6 +111,29 @@ struct LinuxMisc : public BasicPlatformMisc
     /// Sets the current thread affinity mask and on success returns the previous mask.
     /// On failure, returns 0.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    static ThreadPriority GetCurrentThreadPriority();
+
+    /// Sets the current thread priority and on success returns the previous priority.
+    /// On failure, returns ThreadPriority::Unknown.
+    ///
+    /// \remarks   The priority is set through the thread nice value. Raising the priority
+    ///            above ThreadPriority::Normal requires the CAP_SYS_NICE capability or
+    ///            a sufficient RLIMIT_NICE limit.
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the affinity mask of the cores of the given type, see BasicPlatformMisc::GetCPUCoreMask().
+    ///
+    /// \remarks   Hybrid Intel CPUs are detected through the cpu_core and cpu_atom devices.
+    ///            On other CPUs, the cores with the lowest capacity (or maximum frequency)
+    ///            are reported as efficiency cores.
+    static Uint64 GetCPUCoreMask(CPUCoreType Type);
+
+    /// Returns the CPU information, see BasicPlatformMisc::GetCPUInfo().
+    ///
+    /// \remarks   The core topology and cache sizes are read from /sys/devices/system/cpu.
+    ///            On ARM, SVE (and NEON on 32-bit ARM) support is detected through the auxiliary vector.
+    static const CPUInfo& GetCPUInfo();
 };
 
 } // namespace Diligent
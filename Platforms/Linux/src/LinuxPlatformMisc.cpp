@@ -26,19 +26,34 @@
 
 #include "LinuxPlatformMisc.hpp"
 
-#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#if defined(__aarch64__) || defined(__arm__)
+#    include <sys/auxv.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
 
 namespace Diligent
 {
 
 Uint64 LinuxMisc::SetCurrentThreadAffinity(Uint64 Mask)
 {
-    const auto CurrThread = pthread_self();
-
+    // NB: sched_getaffinity/sched_setaffinity with zero pid apply to the calling thread.
+    //     Unlike pthread_setaffinity_np, they are also available on Android.
     Uint64 CurrAffinity = 0;
 
     cpu_set_t CPUSet;
-    if (pthread_getaffinity_np(CurrThread, sizeof(CPUSet), &CPUSet) == 0)
+    CPU_ZERO(&CPUSet);
+    if (sched_getaffinity(0, sizeof(CPUSet), &CPUSet) == 0)
     {
         for (Uint32 j = 0; j < 64; ++j)
         {
@@ -54,10 +69,285 @@ Uint64 LinuxMisc::SetCurrentThreadAffinity(Uint64 Mask)
             CPU_SET(j, &CPUSet);
     }
 
-    if (pthread_setaffinity_np(CurrThread, sizeof(CPUSet), &CPUSet) == 0)
+    if (sched_setaffinity(0, sizeof(CPUSet), &CPUSet) == 0)
         return CurrAffinity;
     else
         return 0;
 }
 
+
+static ThreadPriority NiceValueToThreadPriority(int Nice)
+{
+    if (Nice >= 15)
+        return ThreadPriority::Lowest;
+    else if (Nice > 0)
+        return ThreadPriority::BelowNormal;
+    else if (Nice == 0)
+        return ThreadPriority::Normal;
+    else if (Nice > -10)
+        return ThreadPriority::AboveNormal;
+    else
+        return ThreadPriority::Highest;
+}
+
+static int ThreadPriorityToNiceValue(ThreadPriority Priority)
+{
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:        return 19;
+        case ThreadPriority::BelowNormal:   return 10;
+        case ThreadPriority::Normal:        return 0;
+        case ThreadPriority::AboveNormal:   return -5;
+        case ThreadPriority::Highest:       return -10;
+        default:                            return 0;
+            // clang-format on
+    }
+}
+
+// On Linux, the nice value is a per-thread attribute
+static id_t GetCurrentThreadTid()
+{
+    return static_cast<id_t>(syscall(SYS_gettid));
+}
+
+ThreadPriority LinuxMisc::GetCurrentThreadPriority()
+{
+    // getpriority() may legitimately return -1, so errno must be checked
+    errno          = 0;
+    const int Nice = getpriority(PRIO_PROCESS, GetCurrentThreadTid());
+    return errno == 0 ? NiceValueToThreadPriority(Nice) : ThreadPriority::Unknown;
+}
+
+ThreadPriority LinuxMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    const auto OrigPriority = GetCurrentThreadPriority();
+    if (setpriority(PRIO_PROCESS, GetCurrentThreadTid(), ThreadPriorityToNiceValue(Priority)) == 0)
+        return OrigPriority;
+    else
+        return ThreadPriority::Unknown;
+}
+
+
+// Parses a CPU list such as "0-3,8,10-11" and returns the corresponding mask.
+// Returns 0 if the file can't be read.
+static Uint64 ReadCPUList(const char* Path)
+{
+    std::ifstream File{Path};
+    std::string   List;
+    if (!File || !std::getline(File, List))
+        return 0;
+
+    Uint64      Mask = 0;
+    const char* Pos  = List.c_str();
+    while (*Pos != '\0')
+    {
+        char*               End   = nullptr;
+        const unsigned long First = std::strtoul(Pos, &End, 10);
+        if (End == Pos)
+            break;
+
+        unsigned long Last = First;
+        Pos                = End;
+        if (*Pos == '-')
+        {
+            Last = std::strtoul(Pos + 1, &End, 10);
+            Pos  = End;
+        }
+
+        for (unsigned long Core = First; Core <= Last && Core < 64; ++Core)
+            Mask |= Uint64{1} << Core;
+
+        if (*Pos == ',')
+            ++Pos;
+        else
+            break;
+    }
+    return Mask;
+}
+
+// Returns the relative core capacity or, if it is not available, the maximum core frequency.
+// Returns 0 if neither is known.
+static Uint64 ReadCoreCapacity(Uint32 Core)
+{
+    static constexpr const char* Paths[] = {
+        "/sys/devices/system/cpu/cpu%u/cpu_capacity",
+        "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq",
+    };
+    for (const char* Fmt : Paths)
+    {
+        char Path[128];
+        std::snprintf(Path, sizeof(Path), Fmt, Core);
+
+        std::ifstream File{Path};
+        Uint64        Value = 0;
+        if (File >> Value && Value != 0)
+            return Value;
+    }
+    return 0;
+}
+
+Uint64 LinuxMisc::GetCPUCoreMask(CPUCoreType Type)
+{
+    const Uint64 AllCores = ReadCPUList("/sys/devices/system/cpu/online");
+    if (Type == CPUCoreType::Any || AllCores == 0)
+        return AllCores;
+
+    // Hybrid Intel CPUs expose separate PMU devices for the P-cores and the E-cores
+    Uint64 PerfCores = ReadCPUList("/sys/devices/cpu_core/cpus") & AllCores;
+    Uint64 EffCores  = ReadCPUList("/sys/devices/cpu_atom/cpus") & AllCores;
+    if (PerfCores == 0 && EffCores == 0)
+    {
+        // Classify the cores by their capacity. The cores with the lowest capacity are
+        // efficiency cores. All other cores (e.g. big and prime cores of ARM CPUs) are
+        // performance cores.
+        Uint64 Capacities[64] = {};
+        Uint64 MinCapacity    = ~Uint64{0};
+        Uint64 MaxCapacity    = 0;
+        for (Uint32 Core = 0; Core < 64; ++Core)
+        {
+            if ((AllCores & (Uint64{1} << Core)) == 0)
+                continue;
+
+            Capacities[Core] = ReadCoreCapacity(Core);
+            if (Capacities[Core] == 0)
+            {
+                // Core capacities are unknown: treat all cores as identical
+                MinCapacity = MaxCapacity;
+                break;
+            }
+            MinCapacity = std::min(MinCapacity, Capacities[Core]);
+            MaxCapacity = std::max(MaxCapacity, Capacities[Core]);
+        }
+
+        if (MinCapacity >= MaxCapacity)
+        {
+            // All cores are identical
+            PerfCores = AllCores;
+        }
+        else
+        {
+            for (Uint32 Core = 0; Core < 64; ++Core)
+            {
+                if ((AllCores & (Uint64{1} << Core)) == 0)
+                    continue;
+
+                if (Capacities[Core] == MinCapacity)
+                    EffCores |= Uint64{1} << Core;
+                else
+                    PerfCores |= Uint64{1} << Core;
+            }
+        }
+    }
+
+    return Type == CPUCoreType::Performance ? PerfCores : EffCores;
+}
+
+// Reads the cache size in bytes from a string such as "48K" or "32M".
+// Returns 0 if the file can't be read.
+static Uint32 ReadCacheSize(const char* Path)
+{
+    std::ifstream File{Path};
+    Uint32        Size   = 0;
+    char          Suffix = '\0';
+    if (!(File >> Size))
+        return 0;
+
+    if (File >> Suffix)
+    {
+        if (Suffix == 'K')
+            Size *= 1024u;
+        else if (Suffix == 'M')
+            Size *= 1024u * 1024u;
+    }
+    return Size;
+}
+
+static void QueryLinuxCacheSizes(CPUInfo& Info)
+{
+    // Caches are described by the cpuN/cache/indexM directories. Use the caches
+    // of the first core, which on hybrid CPUs is normally a performance core.
+    for (Uint32 Index = 0; Index < 16; ++Index)
+    {
+        char Dir[128];
+        std::snprintf(Dir, sizeof(Dir), "/sys/devices/system/cpu/cpu0/cache/index%u", Index);
+
+        const std::string DirStr{Dir};
+
+        std::ifstream LevelFile{DirStr + "/level"};
+        Uint32        Level = 0;
+        if (!(LevelFile >> Level))
+            break;
+
+        std::ifstream TypeFile{DirStr + "/type"};
+        std::string   Type;
+        TypeFile >> Type;
+        if (Type == "Instruction")
+            continue;
+
+        const Uint32 Size = ReadCacheSize((DirStr + "/size").c_str());
+        if (Level == 1)
+            Info.L1DataCacheSize = Size;
+        else if (Level == 2)
+            Info.L2CacheSize = Size;
+        else if (Level == 3)
+            Info.L3CacheSize = Size;
+
+        std::ifstream LineSizeFile{DirStr + "/coherency_line_size"};
+        Uint32        LineSize = 0;
+        if (Level == 1 && LineSizeFile >> LineSize && LineSize != 0)
+            Info.CacheLineSize = LineSize;
+    }
+}
+
+const CPUInfo& LinuxMisc::GetCPUInfo()
+{
+    static const CPUInfo CachedInfo = [] {
+        CPUInfo Info = QueryBasicCPUInfo();
+
+#if defined(__aarch64__)
+        // HWCAP_SVE
+        if (getauxval(AT_HWCAP) & (1ul << 22u))
+            Info.Features |= CPU_FEATURE_FLAG_SVE;
+#elif defined(__arm__)
+        // HWCAP_NEON
+        if (getauxval(AT_HWCAP) & (1ul << 12u))
+            Info.Features |= CPU_FEATURE_FLAG_NEON;
+#endif
+
+        const Uint64 AllCores = GetCPUCoreMask(CPUCoreType::Any);
+        if (AllCores != 0)
+            Info.NumLogicalCores = CountOneBits(AllCores);
+
+        // Logical cores of the same physical core have identical thread sibling lists
+        std::vector<Uint64> CoreSiblings;
+        for (Uint32 Core = 0; Core < 64; ++Core)
+        {
+            if ((AllCores & (Uint64{1} << Core)) == 0)
+                continue;
+
+            char Path[128];
+            std::snprintf(Path, sizeof(Path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", Core);
+
+            const Uint64 Siblings = ReadCPUList(Path);
+            if (Siblings == 0)
+            {
+                CoreSiblings.clear();
+                break;
+            }
+            if (std::find(CoreSiblings.begin(), CoreSiblings.end(), Siblings) == CoreSiblings.end())
+                CoreSiblings.push_back(Siblings);
+        }
+        Info.NumPhysicalCores = !CoreSiblings.empty() ? static_cast<Uint32>(CoreSiblings.size()) : Info.NumLogicalCores;
+
+        Info.NumPerformanceCores = CountOneBits(GetCPUCoreMask(CPUCoreType::Performance));
+        Info.NumEfficiencyCores  = CountOneBits(GetCPUCoreMask(CPUCoreType::Efficiency));
+
+        QueryLinuxCacheSizes(Info);
+
+        return Info;
+    }();
+    return CachedInfo;
+}
+
 } // namespace Diligent
@@ -172,6 +172,27 @@ struct WindowsMisc : public BasicPlatformMisc
     /// Sets the current thread priority and on success returns the previous priority.
     /// On failure, returns ThreadPriority::Unknown.
     static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the affinity mask of the cores of the given type, see BasicPlatformMisc::GetCPUCoreMask().
+    ///
+    /// \remarks   Core types are determined from the CPU set efficiency classes, which
+    ///            requires Windows 10. Only the cores of the first processor group are reported.
+    static Uint64 GetCPUCoreMask(CPUCoreType Type);
+
+    /// Returns the CPU information, see BasicPlatformMisc::GetCPUInfo().
+    ///
+    /// \remarks   The core topology and cache sizes are queried with GetLogicalProcessorInformationEx.
+    ///            The numbers of performance and efficiency cores are only reported for the first
+    ///            processor group, see GetCPUCoreMask(). On the Universal Windows Platform,
+    ///            only the basic information is reported.
+#if PLATFORM_UNIVERSAL_WINDOWS
+    static const CPUInfo& GetCPUInfo()
+    {
+        return BasicPlatformMisc::GetCPUInfo();
+    }
+#else
+    static const CPUInfo& GetCPUInfo();
+#endif
 };
 
 } // namespace Diligent
@@ -30,6 +30,9 @@
 #include <Windows.h>
 #include "WinHPostface.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace Diligent
 {
 
@@ -88,4 +91,133 @@ ThreadPriority WindowsMisc::SetCurrentThreadPriority(ThreadPriority Priority)
         return ThreadPriority::Unknown;
 }
 
+Uint64 WindowsMisc::GetCPUCoreMask(CPUCoreType Type)
+{
+    DWORD_PTR ProcessAffinity = 0;
+    DWORD_PTR SystemAffinity  = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &ProcessAffinity, &SystemAffinity))
+        return 0;
+
+    const Uint64 AllCores = static_cast<Uint64>(ProcessAffinity);
+    if (Type == CPUCoreType::Any)
+        return AllCores;
+
+    // GetSystemCpuSetInformation is only available starting with Windows 10,
+    // so load it dynamically.
+    using GetSystemCpuSetInformationProcType = BOOL(WINAPI*)(PSYSTEM_CPU_SET_INFORMATION, ULONG, PULONG, HANDLE, ULONG);
+
+    const auto GetSystemCpuSetInformationProc = reinterpret_cast<GetSystemCpuSetInformationProcType>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "GetSystemCpuSetInformation"));
+
+    std::vector<BYTE> Buffer;
+    if (GetSystemCpuSetInformationProc != nullptr)
+    {
+        ULONG Size = 0;
+        GetSystemCpuSetInformationProc(nullptr, 0, &Size, GetCurrentProcess(), 0);
+        Buffer.resize(Size);
+        if (Size == 0 || !GetSystemCpuSetInformationProc(reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(Buffer.data()), Size, &Size, GetCurrentProcess(), 0))
+            Buffer.clear();
+    }
+
+    // Higher efficiency class means higher performance. The cores with the lowest
+    // efficiency class are efficiency cores. All other cores are performance cores.
+    BYTE EfficiencyClasses[64] = {};
+    BYTE MinClass              = 0xFF;
+    BYTE MaxClass              = 0;
+    for (size_t Offset = 0; Offset < Buffer.size();)
+    {
+        const auto& Info = *reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(&Buffer[Offset]);
+        if (Info.Size == 0)
+            break;
+
+        if (Info.Type == CpuSetInformation && Info.CpuSet.Group == 0 && Info.CpuSet.LogicalProcessorIndex < 64)
+        {
+            const auto Core         = Info.CpuSet.LogicalProcessorIndex;
+            EfficiencyClasses[Core] = Info.CpuSet.EfficiencyClass;
+            if ((AllCores & (Uint64{1} << Core)) != 0)
+            {
+                MinClass = std::min(MinClass, Info.CpuSet.EfficiencyClass);
+                MaxClass = std::max(MaxClass, Info.CpuSet.EfficiencyClass);
+            }
+        }
+        Offset += Info.Size;
+    }
+
+    if (MinClass >= MaxClass)
+    {
+        // All cores are identical or core types are unknown
+        return Type == CPUCoreType::Performance ? AllCores : 0;
+    }
+
+    Uint64 Mask = 0;
+    for (Uint32 Core = 0; Core < 64; ++Core)
+    {
+        if ((AllCores & (Uint64{1} << Core)) == 0)
+            continue;
+
+        const bool IsEfficiencyCore = EfficiencyClasses[Core] == MinClass;
+        if (IsEfficiencyCore == (Type == CPUCoreType::Efficiency))
+            Mask |= Uint64{1} << Core;
+    }
+    return Mask;
+}
+
+const CPUInfo& WindowsMisc::GetCPUInfo()
+{
+    static const CPUInfo CachedInfo = [] {
+        CPUInfo Info = QueryBasicCPUInfo();
+
+        DWORD Size = 0;
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &Size);
+        std::vector<BYTE> Buffer(Size);
+        if (Size == 0 || !GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(Buffer.data()), &Size))
+            Buffer.clear();
+
+        Uint32 NumLogicalCores  = 0;
+        Uint32 NumPhysicalCores = 0;
+        for (size_t Offset = 0; Offset < Buffer.size();)
+        {
+            const auto& ProcInfo = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(&Buffer[Offset]);
+            if (ProcInfo.Size == 0)
+                break;
+
+            if (ProcInfo.Relationship == RelationProcessorCore)
+            {
+                ++NumPhysicalCores;
+                for (WORD Group = 0; Group < ProcInfo.Processor.GroupCount; ++Group)
+                    NumLogicalCores += CountOneBits(static_cast<Uint64>(ProcInfo.Processor.GroupMask[Group].Mask));
+            }
+            else if (ProcInfo.Relationship == RelationCache && ProcInfo.Cache.Type != CacheInstruction)
+            {
+                // All cores of the same level normally have identical caches, so use the first one
+                const auto& Cache = ProcInfo.Cache;
+                if (Cache.Level == 1 && Info.L1DataCacheSize == 0)
+                {
+                    Info.L1DataCacheSize = Cache.CacheSize;
+                    Info.CacheLineSize   = Cache.LineSize;
+                }
+                else if (Cache.Level == 2 && Info.L2CacheSize == 0)
+                {
+                    Info.L2CacheSize = Cache.CacheSize;
+                }
+                else if (Cache.Level == 3 && Info.L3CacheSize == 0)
+                {
+                    Info.L3CacheSize = Cache.CacheSize;
+                }
+            }
+            Offset += ProcInfo.Size;
+        }
+
+        if (NumLogicalCores != 0)
+            Info.NumLogicalCores = NumLogicalCores;
+        Info.NumPhysicalCores = NumPhysicalCores != 0 ? NumPhysicalCores : Info.NumLogicalCores;
+
+        Info.NumPerformanceCores = CountOneBits(GetCPUCoreMask(CPUCoreType::Performance));
+        Info.NumEfficiencyCores  = CountOneBits(GetCPUCoreMask(CPUCoreType::Efficiency));
+
+        return Info;
+    }();
+    return CachedInfo;
+}
+
 } // namespace Diligent
@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <initializer_list>
+#include <utility>
+
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+/// Returns true if the CPU supports all of the given instruction set extensions.
+inline bool IsCPUFeatureSupported(CPU_FEATURE_FLAGS Features)
+{
+    return (PlatformMisc::GetCPUInfo().Features & Features) == Features;
+}
+
+/// Selects the implementation of a function for the instruction set extensions supported by the CPU.
+
+/// \param [in] Kernels  - Pairs of the required extensions and the function implementations,
+///                        from the most to the least specialized one.
+/// \param [in] Fallback - The implementation to use if the CPU supports none of the extensions.
+///
+/// \return     The first implementation in Kernels whose extensions are all supported, or Fallback.
+///
+/// \remarks    The result should be cached by the caller, for example:
+///
+///                 static const auto Kernel = SelectCPUKernel<ProcessFunc>(
+///                     {
+///                         {CPU_FEATURE_FLAG_AVX2 | CPU_FEATURE_FLAG_FMA, ProcessAVX2},
+///                         {CPU_FEATURE_FLAG_SSE4_1, ProcessSSE41},
+///                     },
+///                     ProcessGeneric);
+///
+///             Implementations that use the extensions not enabled for the whole translation unit
+///             must be compiled for them, e.g. with the DILIGENT_TARGET_AVX2 attribute.
+template <typename FuncType>
+FuncType SelectCPUKernel(std::initializer_list<std::pair<CPU_FEATURE_FLAGS, FuncType>> Kernels, FuncType Fallback)
+{
+    for (const auto& Kernel : Kernels)
+    {
+        if (Kernel.second != nullptr && IsCPUFeatureSupported(Kernel.first))
+            return Kernel.second;
+    }
+    return Fallback;
+}
+
+} // namespace Diligent
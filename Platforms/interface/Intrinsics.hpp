@@ -34,3 +34,20 @@
 #if DILIGENT_AVX2_SUPPORTED && defined(__AVX2__)
 #    define DILIGENT_AVX2_ENABLED 1
 #endif
+
+// Compiles a function for AVX2 so that it can be selected at run time (see SelectCPUKernel)
+// when AVX2 is not enabled for the whole translation unit. MSVC always allows AVX2 intrinsics.
+#if DILIGENT_AVX2_SUPPORTED && (defined(__clang__) || defined(__GNUC__))
+#    define DILIGENT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#    define DILIGENT_TARGET_AVX2
+#endif
+
+#if DILIGENT_AVX2_SUPPORTED && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define DILIGENT_SSE2_ENABLED 1
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define DILIGENT_NEON_ENABLED 1
+#endif
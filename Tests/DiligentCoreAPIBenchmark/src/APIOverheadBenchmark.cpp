@@ -0,0 +1,409 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <string>
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkRunner.hpp"
+#include "MapHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+namespace HLSL
+{
+
+const std::string BenchmarkVS{R"(
+cbuffer cbData
+{
+    float4 g_Offset;
+};
+
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+void main(in uint VertId : SV_VertexID, out PSInput PSIn)
+{
+    float2 Pos[3];
+    Pos[0] = float2(-1.0, -1.0);
+    Pos[1] = float2( 0.0, +1.0);
+    Pos[2] = float2(+1.0, -1.0);
+    PSIn.Pos = float4(Pos[VertId] * 0.1 + g_Offset.xy, 0.0, 1.0);
+}
+)"};
+
+const std::string BenchmarkPS{R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)"};
+
+} // namespace HLSL
+
+// The number of draws, commits or state changes recorded per benchmark iteration.
+// Every iteration ends with Flush() and FinishFrame() so that the command and
+// dynamic memory does not grow unbounded.
+constexpr Uint32 NumItemsPerIteration = 1024;
+
+constexpr Uint32 NumConstantBuffers = 16;
+constexpr Uint32 NumTextures        = 16;
+
+class APIOverheadBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+        sm_pRenderTarget = pEnv->CreateTexture("API overhead benchmark render target", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, 64, 64);
+        ASSERT_NE(sm_pRenderTarget, nullptr);
+
+        for (Uint32 i = 0; i < NumTextures; ++i)
+        {
+            sm_Textures[i] = pEnv->CreateTexture("API overhead benchmark texture", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET | BIND_SHADER_RESOURCE, 16, 16);
+            ASSERT_NE(sm_Textures[i], nullptr);
+        }
+
+        for (Uint32 i = 0; i < NumConstantBuffers; ++i)
+        {
+            const float4 Offset{-0.5f + static_cast<float>(i) / NumConstantBuffers, 0, 0, 0};
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name      = "API overhead benchmark constant buffer";
+            BuffDesc.Size      = sizeof(Offset);
+            BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+            BuffDesc.Usage     = USAGE_DEFAULT;
+
+            BufferData InitData{&Offset, sizeof(Offset)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &sm_ConstantBuffers[i]);
+            ASSERT_NE(sm_ConstantBuffers[i], nullptr);
+        }
+
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = "API overhead benchmark dynamic buffer";
+            BuffDesc.Size           = sizeof(float4);
+            BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+            BuffDesc.Usage          = USAGE_DYNAMIC;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pDynamicBuffer);
+            ASSERT_NE(sm_pDynamicBuffer, nullptr);
+        }
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc   = {"API overhead benchmark VS", SHADER_TYPE_VERTEX, true};
+            ShaderCI.Source = HLSL::BenchmarkVS.c_str();
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc   = {"API overhead benchmark PS", SHADER_TYPE_PIXEL, true};
+            ShaderCI.Source = HLSL::BenchmarkPS.c_str();
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        auto CreatePSO = [&](const char* Name, SHADER_RESOURCE_VARIABLE_TYPE VarType, CULL_MODE CullMode, RefCntAutoPtr<IPipelineState>& pPSO) {
+            GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+            auto& PSODesc          = PSOCreateInfo.PSODesc;
+            auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+            PSODesc.Name = Name;
+
+            PSODesc.ResourceLayout.DefaultVariableType = VarType;
+
+            GraphicsPipeline.NumRenderTargets             = 1;
+            GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+            GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            GraphicsPipeline.RasterizerDesc.CullMode      = CullMode;
+            GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+            PSOCreateInfo.pVS = pVS;
+            PSOCreateInfo.pPS = pPS;
+
+            pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        };
+
+        CreatePSO("API overhead benchmark - static variable", SHADER_RESOURCE_VARIABLE_TYPE_STATIC, CULL_MODE_NONE, sm_pStaticPSO);
+        ASSERT_NE(sm_pStaticPSO, nullptr);
+        CreatePSO("API overhead benchmark - static variable, back-face culling", SHADER_RESOURCE_VARIABLE_TYPE_STATIC, CULL_MODE_BACK, sm_pStaticPSO2);
+        ASSERT_NE(sm_pStaticPSO2, nullptr);
+        CreatePSO("API overhead benchmark - mutable variable", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, CULL_MODE_NONE, sm_pMutablePSO);
+        ASSERT_NE(sm_pMutablePSO, nullptr);
+        CreatePSO("API overhead benchmark - dynamic variable", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, CULL_MODE_NONE, sm_pDynamicPSO);
+        ASSERT_NE(sm_pDynamicPSO, nullptr);
+
+        for (auto* pPSO : {sm_pStaticPSO.RawPtr(), sm_pStaticPSO2.RawPtr()})
+        {
+            auto* pVar = pPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "cbData");
+            ASSERT_NE(pVar, nullptr);
+            pVar->Set(sm_ConstantBuffers[0]);
+        }
+        sm_pStaticPSO->CreateShaderResourceBinding(&sm_pStaticSRB, true);
+        ASSERT_NE(sm_pStaticSRB, nullptr);
+        sm_pStaticPSO2->CreateShaderResourceBinding(&sm_pStaticSRB2, true);
+        ASSERT_NE(sm_pStaticSRB2, nullptr);
+
+        for (Uint32 i = 0; i < NumConstantBuffers; ++i)
+        {
+            sm_pMutablePSO->CreateShaderResourceBinding(&sm_MutableSRBs[i], true);
+            ASSERT_NE(sm_MutableSRBs[i], nullptr);
+            auto* pVar = sm_MutableSRBs[i]->GetVariableByName(SHADER_TYPE_VERTEX, "cbData");
+            ASSERT_NE(pVar, nullptr);
+            pVar->Set(sm_ConstantBuffers[i]);
+        }
+
+        sm_pDynamicPSO->CreateShaderResourceBinding(&sm_pDynamicSRB, true);
+        ASSERT_NE(sm_pDynamicSRB, nullptr);
+        sm_pDynamicVar = sm_pDynamicSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbData");
+        ASSERT_NE(sm_pDynamicVar, nullptr);
+
+        // Transition all resources once, so that the benchmarks can use RESOURCE_STATE_TRANSITION_MODE_NONE
+        std::vector<StateTransitionDesc> Barriers;
+        for (auto& pBuffer : sm_ConstantBuffers)
+            Barriers.emplace_back(pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        for (auto& pTexture : sm_Textures)
+            Barriers.emplace_back(pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        Barriers.emplace_back(sm_pRenderTarget, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE);
+
+        auto* pContext = pEnv->GetDeviceContext();
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+        pContext->Flush();
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pStaticPSO.Release();
+        sm_pStaticPSO2.Release();
+        sm_pMutablePSO.Release();
+        sm_pDynamicPSO.Release();
+        sm_pStaticSRB.Release();
+        sm_pStaticSRB2.Release();
+        for (auto& pSRB : sm_MutableSRBs)
+            pSRB.Release();
+        sm_pDynamicSRB.Release();
+        sm_pDynamicVar = nullptr;
+        for (auto& pBuffer : sm_ConstantBuffers)
+            pBuffer.Release();
+        sm_pDynamicBuffer.Release();
+        for (auto& pTexture : sm_Textures)
+            pTexture.Release();
+        sm_pRenderTarget.Release();
+
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    // Runs the benchmark on the immediate context and, if available, on a deferred context.
+    // RecordCommands records NumItemsPerIteration items into the given context.
+    template <typename RecordCommandsType>
+    static void RunOnAllContexts(const char* Name, const RecordCommandsType& RecordCommands)
+    {
+        RunContextBenchmark(Name, false, RecordCommands);
+
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        if (pEnv->GetNumDeferredContexts() > 0)
+            RunContextBenchmark(Name, true, RecordCommands);
+    }
+
+    template <typename RecordCommandsType>
+    static void RunContextBenchmark(const char* Name, bool UseDeferredContext, const RecordCommandsType& RecordCommands)
+    {
+        auto* pEnv          = GPUTestingEnvironment::GetInstance();
+        auto* pImmediateCtx = pEnv->GetDeviceContext();
+        auto* pDeferredCtx  = UseDeferredContext ? pEnv->GetDeferredContext(0) : nullptr;
+
+        ITextureView* pRTVs[] = {sm_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+
+        const std::string FullName = std::string{Name} + (UseDeferredContext ? "_Deferred" : "_Immediate");
+        RunBenchmark(
+            FullName.c_str(), [&]() {
+                if (pDeferredCtx != nullptr)
+                {
+                    pDeferredCtx->Begin(0);
+                    pDeferredCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                    RecordCommands(pDeferredCtx);
+
+                    RefCntAutoPtr<ICommandList> pCmdList;
+                    pDeferredCtx->FinishCommandList(&pCmdList);
+                    ICommandList* pCmdLists[] = {pCmdList};
+                    pImmediateCtx->ExecuteCommandLists(1, pCmdLists);
+                    pDeferredCtx->FinishFrame();
+                }
+                else
+                {
+                    pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                    RecordCommands(pImmediateCtx);
+                }
+                pImmediateCtx->Flush();
+                pImmediateCtx->FinishFrame();
+            },
+            NumItemsPerIteration);
+
+        pImmediateCtx->WaitForIdle();
+    }
+
+    static RefCntAutoPtr<ITexture>                                               sm_pRenderTarget;
+    static std::array<RefCntAutoPtr<ITexture>, NumTextures>                      sm_Textures;
+    static std::array<RefCntAutoPtr<IBuffer>, NumConstantBuffers>                sm_ConstantBuffers;
+    static RefCntAutoPtr<IBuffer>                                                sm_pDynamicBuffer;
+    static RefCntAutoPtr<IPipelineState>                                         sm_pStaticPSO;
+    static RefCntAutoPtr<IPipelineState>                                         sm_pStaticPSO2;
+    static RefCntAutoPtr<IPipelineState>                                         sm_pMutablePSO;
+    static RefCntAutoPtr<IPipelineState>                                         sm_pDynamicPSO;
+    static RefCntAutoPtr<IShaderResourceBinding>                                 sm_pStaticSRB;
+    static RefCntAutoPtr<IShaderResourceBinding>                                 sm_pStaticSRB2;
+    static std::array<RefCntAutoPtr<IShaderResourceBinding>, NumConstantBuffers> sm_MutableSRBs;
+    static RefCntAutoPtr<IShaderResourceBinding>                                 sm_pDynamicSRB;
+    static IShaderResourceVariable*                                              sm_pDynamicVar;
+};
+
+RefCntAutoPtr<ITexture>                                               APIOverheadBenchmark::sm_pRenderTarget;
+std::array<RefCntAutoPtr<ITexture>, NumTextures>                      APIOverheadBenchmark::sm_Textures;
+std::array<RefCntAutoPtr<IBuffer>, NumConstantBuffers>                APIOverheadBenchmark::sm_ConstantBuffers;
+RefCntAutoPtr<IBuffer>                                                APIOverheadBenchmark::sm_pDynamicBuffer;
+RefCntAutoPtr<IPipelineState>                                         APIOverheadBenchmark::sm_pStaticPSO;
+RefCntAutoPtr<IPipelineState>                                         APIOverheadBenchmark::sm_pStaticPSO2;
+RefCntAutoPtr<IPipelineState>                                         APIOverheadBenchmark::sm_pMutablePSO;
+RefCntAutoPtr<IPipelineState>                                         APIOverheadBenchmark::sm_pDynamicPSO;
+RefCntAutoPtr<IShaderResourceBinding>                                 APIOverheadBenchmark::sm_pStaticSRB;
+RefCntAutoPtr<IShaderResourceBinding>                                 APIOverheadBenchmark::sm_pStaticSRB2;
+std::array<RefCntAutoPtr<IShaderResourceBinding>, NumConstantBuffers> APIOverheadBenchmark::sm_MutableSRBs;
+RefCntAutoPtr<IShaderResourceBinding>                                 APIOverheadBenchmark::sm_pDynamicSRB;
+IShaderResourceVariable*                                              APIOverheadBenchmark::sm_pDynamicVar = nullptr;
+
+constexpr DrawAttribs BenchmarkDrawAttribs{3, DRAW_FLAG_NONE};
+
+TEST_F(APIOverheadBenchmark, Draw)
+{
+    RunOnAllContexts("Draw", [](IDeviceContext* pCtx) {
+        pCtx->SetPipelineState(sm_pStaticPSO);
+        pCtx->CommitShaderResources(sm_pStaticSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+            pCtx->Draw(BenchmarkDrawAttribs);
+    });
+}
+
+// Every item below includes the cost of one draw call, see the Draw benchmark for the baseline.
+
+TEST_F(APIOverheadBenchmark, CommitShaderResources)
+{
+    RunOnAllContexts("CommitStaticSRB", [](IDeviceContext* pCtx) {
+        pCtx->SetPipelineState(sm_pStaticPSO);
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+        {
+            pCtx->CommitShaderResources(sm_pStaticSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            pCtx->Draw(BenchmarkDrawAttribs);
+        }
+    });
+
+    RunOnAllContexts("CommitMutableSRB", [](IDeviceContext* pCtx) {
+        pCtx->SetPipelineState(sm_pMutablePSO);
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+        {
+            pCtx->CommitShaderResources(sm_MutableSRBs[i % NumConstantBuffers], RESOURCE_STATE_TRANSITION_MODE_NONE);
+            pCtx->Draw(BenchmarkDrawAttribs);
+        }
+    });
+
+    RunOnAllContexts("CommitDynamicVariable", [](IDeviceContext* pCtx) {
+        pCtx->SetPipelineState(sm_pDynamicPSO);
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+        {
+            sm_pDynamicVar->Set(sm_ConstantBuffers[i % NumConstantBuffers]);
+            pCtx->CommitShaderResources(sm_pDynamicSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            pCtx->Draw(BenchmarkDrawAttribs);
+        }
+    });
+}
+
+TEST_F(APIOverheadBenchmark, SetPipelineState)
+{
+    RunOnAllContexts("SetPipelineState", [](IDeviceContext* pCtx) {
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+        {
+            const bool Odd = (i & 0x01) != 0;
+            pCtx->SetPipelineState(Odd ? sm_pStaticPSO2 : sm_pStaticPSO);
+            pCtx->CommitShaderResources(Odd ? sm_pStaticSRB2 : sm_pStaticSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            pCtx->Draw(BenchmarkDrawAttribs);
+        }
+    });
+}
+
+TEST_F(APIOverheadBenchmark, MapBufferDiscard)
+{
+    RunContextBenchmark("MapBufferDiscard", false, [](IDeviceContext* pCtx) {
+        for (Uint32 i = 0; i < NumItemsPerIteration; ++i)
+        {
+            MapHelper<float4> Data{pCtx, sm_pDynamicBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            *Data = float4{static_cast<float>(i), 0, 0, 0};
+        }
+    });
+}
+
+TEST_F(APIOverheadBenchmark, TransitionResourceStates)
+{
+    // Each item is one state transition of one texture
+    RunContextBenchmark("TransitionResourceStates", false, [](IDeviceContext* pCtx) {
+        std::array<StateTransitionDesc, NumTextures> Barriers;
+        for (Uint32 i = 0; i < NumItemsPerIteration; i += NumTextures)
+        {
+            const auto NewState = ((i / NumTextures) & 0x01) == 0 ? RESOURCE_STATE_RENDER_TARGET : RESOURCE_STATE_SHADER_RESOURCE;
+            for (Uint32 t = 0; t < NumTextures; ++t)
+                Barriers[t] = StateTransitionDesc{sm_Textures[t], RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE};
+            pCtx->TransitionResourceStates(NumTextures, Barriers.data());
+        }
+    });
+}
+
+} // namespace
@@ -0,0 +1,313 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+namespace HLSL
+{
+
+const std::string BenchmarkVS{R"(
+cbuffer cbData
+{
+    float4 g_Offset;
+};
+
+void main(out float4 Pos : SV_POSITION)
+{
+    Pos = g_Offset;
+}
+)"};
+
+const std::string BenchmarkPS{R"(
+Texture2D    g_Tex;
+SamplerState g_Tex_sampler;
+
+float4 main(in float4 Pos : SV_POSITION) : SV_Target
+{
+    return g_Tex.Sample(g_Tex_sampler, float2(0.5, 0.5));
+}
+)"};
+
+} // namespace HLSL
+
+// The number of objects every thread creates and destroys.
+constexpr Uint32 NumItemsPerThread = 256;
+
+// Measures how the creation and destruction of device objects scales with the number
+// of threads. Every object type is dominated by a different shared lock in the engine:
+//
+// | Benchmark   | Lock                                                          |
+// |-------------|---------------------------------------------------------------|
+// | Buffer      | VulkanMemoryManager pages mutex, D3D12 CPU descriptor heaps   |
+// | Texture     | VulkanMemoryManager pages mutex, D3D12 CPU descriptor heaps   |
+// | TextureView | CPUDescriptorHeap pool mutex (D3D12), object allocators       |
+// | Sampler     | StateObjectsRegistry                                          |
+// | SRB         | FixedBlockMemoryAllocator mutex, descriptor allocators        |
+//
+// The engine does not expose counters for these locks, so contention shows up as
+// scaling efficiency below 100%: the throughput with N threads divided by N times
+// the single-threaded throughput.
+class MTResourceCreationBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        if (!pDevice->GetDeviceInfo().Features.MultithreadedResourceCreation)
+            return;
+
+        sm_pTexture = pEnv->CreateTexture("MT resource creation benchmark texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+        ASSERT_NE(sm_pTexture, nullptr);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc   = {"MT resource creation benchmark VS", SHADER_TYPE_VERTEX, true};
+            ShaderCI.Source = HLSL::BenchmarkVS.c_str();
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc   = {"MT resource creation benchmark PS", SHADER_TYPE_PIXEL, true};
+            ShaderCI.Source = HLSL::BenchmarkPS.c_str();
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSOCreateInfo.PSODesc.Name = "MT resource creation benchmark PSO";
+
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+        SamplerDesc          SamLinearClampDesc;
+        ImmutableSamplerDesc ImtblSamplers[] = {{SHADER_TYPE_PIXEL, "g_Tex", SamLinearClampDesc}};
+        PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers    = ImtblSamplers;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_POINT_LIST;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+        sm_pTexture.Release();
+
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    void SetUp() override
+    {
+        auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().Features.MultithreadedResourceCreation)
+            GTEST_SKIP() << "This device does not support multithreaded resource creation";
+    }
+
+    // Runs CreateAndDestroy(ThreadIdx, ItemIdx) NumItemsPerThread times on every thread
+    // for 1, 2, 4, ... threads up to the number of hardware threads, and reports the
+    // time per item and the scaling efficiency for every thread count.
+    template <typename CreateAndDestroyType>
+    static void RunScalingBenchmark(const char* Name, const CreateAndDestroyType& CreateAndDestroy)
+    {
+        const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+        std::vector<Uint32> ThreadCounts;
+        for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+            ThreadCounts.push_back(NumThreads);
+        ThreadCounts.push_back(MaxThreads);
+
+        // Warm up allocators and caches
+        for (Uint32 i = 0; i < NumItemsPerThread; ++i)
+            CreateAndDestroy(0, i);
+        GPUTestingEnvironment::GetInstance()->ReleaseResources();
+
+        double SingleThreadedNsPerItem = 0;
+        for (const auto NumThreads : ThreadCounts)
+        {
+            std::atomic<Uint32> NumThreadsReady{0};
+            std::atomic<bool>   Start{false};
+
+            std::vector<std::thread> Workers(NumThreads);
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Workers[t] = std::thread{
+                    [&, t]() {
+                        NumThreadsReady.fetch_add(1);
+                        while (!Start.load())
+                            std::this_thread::yield();
+
+                        for (Uint32 i = 0; i < NumItemsPerThread; ++i)
+                            CreateAndDestroy(t, i);
+                    }};
+            }
+
+            // Exclude the thread startup time from the measurement
+            while (NumThreadsReady.load() < NumThreads)
+                std::this_thread::yield();
+
+            Timer T;
+            Start.store(true);
+            for (auto& Worker : Workers)
+                Worker.join();
+            const double ElapsedTime = T.GetElapsedTime();
+
+            const std::string FullName  = std::string{Name} + "_T" + std::to_string(NumThreads);
+            const double      NsPerItem = ReportBenchmarkResult(FullName.c_str(), ElapsedTime, Uint64{NumItemsPerThread} * NumThreads);
+            if (NumThreads == 1)
+                SingleThreadedNsPerItem = NsPerItem;
+
+            // Throughput with N threads relative to N times the single-threaded throughput.
+            // Values well below 100% indicate that the threads serialize on a shared lock.
+            const double Efficiency = SingleThreadedNsPerItem / (NsPerItem * NumThreads) * 100.0;
+            std::cout << "[ BENCH    ] " << std::left << std::setw(40) << (FullName + " efficiency") << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(14) << Efficiency << " %" << std::endl;
+            RecordProperty(FullName + "_efficiency", std::to_string(Efficiency));
+
+            GPUTestingEnvironment::GetInstance()->ReleaseResources();
+        }
+    }
+
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+    static RefCntAutoPtr<ITexture>       sm_pTexture;
+};
+
+RefCntAutoPtr<IPipelineState> MTResourceCreationBenchmark::sm_pPSO;
+RefCntAutoPtr<ITexture>       MTResourceCreationBenchmark::sm_pTexture;
+
+TEST_F(MTResourceCreationBenchmark, Buffer)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+    RunScalingBenchmark("CreateBuffer", [pDevice](Uint32, Uint32) {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "MT resource creation benchmark buffer";
+        BuffDesc.Size      = 256;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        BuffDesc.Usage     = USAGE_DEFAULT;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        EXPECT_NE(pBuffer, nullptr);
+    });
+}
+
+TEST_F(MTResourceCreationBenchmark, Texture)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+    RunScalingBenchmark("CreateTexture", [pDevice](Uint32, Uint32) {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "MT resource creation benchmark texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.Usage     = USAGE_DEFAULT;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        EXPECT_NE(pTexture, nullptr);
+    });
+}
+
+TEST_F(MTResourceCreationBenchmark, TextureView)
+{
+    RunScalingBenchmark("CreateTextureView", [](Uint32, Uint32) {
+        TextureViewDesc ViewDesc;
+        ViewDesc.Name     = "MT resource creation benchmark texture view";
+        ViewDesc.ViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+
+        RefCntAutoPtr<ITextureView> pView;
+        sm_pTexture->CreateView(ViewDesc, &pView);
+        EXPECT_NE(pView, nullptr);
+    });
+}
+
+TEST_F(MTResourceCreationBenchmark, Sampler)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    // Samplers with identical descriptions are shared through the state objects registry,
+    // so every thread creates its own set of distinct samplers to exercise both
+    // the registry look-up and the object creation.
+    RunScalingBenchmark("CreateSampler", [pDevice](Uint32 ThreadIdx, Uint32 ItemIdx) {
+        SamplerDesc SamDesc;
+        SamDesc.Name       = "MT resource creation benchmark sampler";
+        SamDesc.MipLODBias = static_cast<float>(ThreadIdx) + static_cast<float>(ItemIdx % 16) / 16.f;
+
+        RefCntAutoPtr<ISampler> pSampler;
+        pDevice->CreateSampler(SamDesc, &pSampler);
+        EXPECT_NE(pSampler, nullptr);
+    });
+}
+
+TEST_F(MTResourceCreationBenchmark, SRB)
+{
+    RunScalingBenchmark("CreateSRB", [](Uint32, Uint32) {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        sm_pPSO->CreateShaderResourceBinding(&pSRB, true);
+        EXPECT_NE(pSRB, nullptr);
+    });
+}
+
+} // namespace
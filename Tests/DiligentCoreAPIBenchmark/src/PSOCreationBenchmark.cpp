@@ -0,0 +1,483 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkRunner.hpp"
+#include "BytecodeCache.h"
+#include "DataBlobImpl.hpp"
+#include "ShaderMacroHelper.hpp"
+
+#if ARCHIVER_SUPPORTED
+#    include "RenderStateCache.h"
+#    include "Dearchiver.h"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+namespace HLSL
+{
+
+// Every pipeline uses its own permutation of the shaders, so that no
+// two pipelines can share compiled byte code.
+const std::string BenchmarkVS{R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+void main(in uint VertId : SV_VertexID, out PSInput PSIn)
+{
+    float2 Pos[3];
+    Pos[0] = float2(-1.0, -1.0);
+    Pos[1] = float2( 0.0, +1.0);
+    Pos[2] = float2(+1.0, -1.0);
+    PSIn.Pos = float4(Pos[VertId] * (1.0 + float(PERMUTATION) * 0.01), 0.0, 1.0);
+}
+)"};
+
+const std::string BenchmarkPS{R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return float4(float(PERMUTATION) / 256.0, 0.0, 1.0, 1.0);
+}
+)"};
+
+} // namespace HLSL
+
+// The number of distinct pipelines created by every benchmark phase.
+constexpr Uint32 NumPipelines = 64;
+
+class PSOCreationBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        sm_Macros.resize(NumPipelines);
+        sm_PSONames.resize(NumPipelines);
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+        {
+            sm_Macros[i].AddShaderMacro("PERMUTATION", i);
+            // Finalize the macros now so that worker threads only read them
+            sm_Macros[i].Finalize();
+            sm_PSONames[i] = "PSO creation benchmark " + std::to_string(i);
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_Macros.clear();
+        sm_PSONames.clear();
+
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    static ShaderCreateInfo GetShaderCI(SHADER_TYPE Type, Uint32 Idx)
+    {
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+        ShaderCI.Desc           = {Type == SHADER_TYPE_VERTEX ? "PSO creation benchmark VS" : "PSO creation benchmark PS", Type, true};
+        ShaderCI.Source         = Type == SHADER_TYPE_VERTEX ? HLSL::BenchmarkVS.c_str() : HLSL::BenchmarkPS.c_str();
+        ShaderCI.Macros         = sm_Macros[Idx];
+        return ShaderCI;
+    }
+
+    static GraphicsPipelineStateCreateInfo GetPSOCI(Uint32 Idx, IShader* pVS, IShader* pPS, IPipelineStateCache* pPSOCache = nullptr)
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSOCreateInfo.PSODesc.Name = sm_PSONames[Idx].c_str();
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PSOCreateInfo.pVS       = pVS;
+        PSOCreateInfo.pPS       = pPS;
+        PSOCreateInfo.pPSOCache = pPSOCache;
+        return PSOCreateInfo;
+    }
+
+    // Calls Body(Multithreaded) single-threaded and, if the device supports it, multithreaded.
+    template <typename BodyType>
+    static void ForEachThreadingMode(const BodyType& Body)
+    {
+        Body(false);
+
+        auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+        if (pDevice->GetDeviceInfo().Features.MultithreadedResourceCreation)
+            Body(true);
+    }
+
+    // Creates all pipelines with CreatePipeline(Idx) and reports the time per pipeline.
+    // In multithreaded mode, the pipelines are distributed between worker threads.
+    // The pipelines are released after the time is measured.
+    template <typename CreatePipelineType>
+    static void MeasurePhase(const char* Name, bool Multithreaded, const CreatePipelineType& CreatePipeline)
+    {
+        std::vector<RefCntAutoPtr<IPipelineState>> Pipelines(NumPipelines);
+
+        const Uint32 NumThreads = Multithreaded ? std::max(std::thread::hardware_concurrency(), 2u) : 1;
+
+        Timer T;
+        if (NumThreads > 1)
+        {
+            std::vector<std::thread> Workers(NumThreads);
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Workers[t] = std::thread{
+                    [&, t]() {
+                        for (Uint32 i = t; i < NumPipelines; i += NumThreads)
+                            Pipelines[i] = CreatePipeline(i);
+                    }};
+            }
+            for (auto& Worker : Workers)
+                Worker.join();
+        }
+        else
+        {
+            for (Uint32 i = 0; i < NumPipelines; ++i)
+                Pipelines[i] = CreatePipeline(i);
+        }
+        const double ElapsedTime = T.GetElapsedTime();
+
+        for (const auto& pPSO : Pipelines)
+            EXPECT_NE(pPSO, nullptr) << Name;
+
+        const std::string FullName = std::string{Name} + (Multithreaded ? "_MT" : "_ST");
+        ReportBenchmarkResult(FullName.c_str(), ElapsedTime, NumPipelines);
+
+        Pipelines.clear();
+        GPUTestingEnvironment::GetInstance()->ReleaseResources();
+    }
+
+    static RefCntAutoPtr<IPipelineStateCache> CreatePSOCache(PSO_CACHE_MODE Mode, IDataBlob* pData = nullptr)
+    {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name = "PSO creation benchmark cache";
+        CacheCI.Desc.Mode = Mode;
+        if (pData != nullptr)
+        {
+            CacheCI.pCacheData    = pData->GetConstDataPtr();
+            CacheCI.CacheDataSize = static_cast<Uint32>(pData->GetSize());
+        }
+
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        GPUTestingEnvironment::GetInstance()->GetDevice()->CreatePipelineStateCache(CacheCI, &pCache);
+        return pCache;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreateFromSource(Uint32 Idx, IPipelineStateCache* pPSOCache = nullptr)
+    {
+        auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+        RefCntAutoPtr<IShader> pVS;
+        pDevice->CreateShader(GetShaderCI(SHADER_TYPE_VERTEX, Idx), &pVS);
+        RefCntAutoPtr<IShader> pPS;
+        pDevice->CreateShader(GetShaderCI(SHADER_TYPE_PIXEL, Idx), &pPS);
+        if (!pVS || !pPS)
+            return {};
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(GetPSOCI(Idx, pVS, pPS, pPSOCache), &pPSO);
+        return pPSO;
+    }
+
+    static std::vector<ShaderMacroHelper> sm_Macros;
+    static std::vector<std::string>       sm_PSONames;
+};
+
+std::vector<ShaderMacroHelper> PSOCreationBenchmark::sm_Macros;
+std::vector<std::string>       PSOCreationBenchmark::sm_PSONames;
+
+TEST_F(PSOCreationBenchmark, FromSource)
+{
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ForEachThreadingMode([](bool Multithreaded) {
+        MeasurePhase("PSOFromSource", Multithreaded, [](Uint32 Idx) {
+            return CreateFromSource(Idx);
+        });
+    });
+}
+
+TEST_F(PSOCreationBenchmark, PipelineStateCache)
+{
+    if (!CreatePSOCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE))
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ForEachThreadingMode([](bool Multithreaded) {
+        auto pColdCache = CreatePSOCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
+        ASSERT_NE(pColdCache, nullptr);
+        MeasurePhase("PSOCache_Cold", Multithreaded, [&](Uint32 Idx) {
+            return CreateFromSource(Idx, pColdCache);
+        });
+
+        RefCntAutoPtr<IDataBlob> pData;
+        pColdCache->GetData(&pData);
+        ASSERT_NE(pData, nullptr);
+
+        auto pWarmCache = CreatePSOCache(PSO_CACHE_MODE_LOAD, pData);
+        ASSERT_NE(pWarmCache, nullptr);
+        MeasurePhase("PSOCache_Warm", Multithreaded, [&](Uint32 Idx) {
+            return CreateFromSource(Idx, pWarmCache);
+        });
+    });
+}
+
+TEST_F(PSOCreationBenchmark, BytecodeCache)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceInfo().IsGLDevice())
+        GTEST_SKIP() << "OpenGL shaders are always created from source";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ForEachThreadingMode([pDevice](bool Multithreaded) {
+        const BytecodeCacheCreateInfo CacheCI{pDevice->GetDeviceInfo().Type};
+
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        // IBytecodeCache is not thread-safe
+        std::mutex CacheMtx;
+
+        auto CreateShader = [&](SHADER_TYPE Type, Uint32 Idx) {
+            const auto ShaderCI = GetShaderCI(Type, Idx);
+
+            RefCntAutoPtr<IDataBlob> pBytecode;
+            {
+                std::lock_guard<std::mutex> Lock{CacheMtx};
+                pCache->GetBytecode(ShaderCI, &pBytecode);
+            }
+
+            RefCntAutoPtr<IShader> pShader;
+            if (pBytecode)
+            {
+                auto BytecodeCI         = ShaderCI;
+                BytecodeCI.Source       = nullptr;
+                BytecodeCI.ByteCode     = pBytecode->GetConstDataPtr();
+                BytecodeCI.ByteCodeSize = pBytecode->GetSize();
+                pDevice->CreateShader(BytecodeCI, &pShader);
+            }
+            else
+            {
+                pDevice->CreateShader(ShaderCI, &pShader);
+                if (pShader)
+                {
+                    const void* pData    = nullptr;
+                    Uint64      DataSize = 0;
+                    pShader->GetBytecode(&pData, DataSize);
+                    auto pNewBytecode = DataBlobImpl::Create(static_cast<size_t>(DataSize), pData);
+
+                    std::lock_guard<std::mutex> Lock{CacheMtx};
+                    pCache->AddBytecode(ShaderCI, pNewBytecode);
+                }
+            }
+            return pShader;
+        };
+
+        auto CreatePipeline = [&](Uint32 Idx) {
+            auto pVS = CreateShader(SHADER_TYPE_VERTEX, Idx);
+            auto pPS = CreateShader(SHADER_TYPE_PIXEL, Idx);
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            if (pVS && pPS)
+                pDevice->CreateGraphicsPipelineState(GetPSOCI(Idx, pVS, pPS), &pPSO);
+            return pPSO;
+        };
+
+        MeasurePhase("BytecodeCache_Cold", Multithreaded, CreatePipeline);
+
+        RefCntAutoPtr<IDataBlob> pData;
+        pCache->Store(&pData);
+        ASSERT_NE(pData, nullptr);
+
+        // Load the stored byte code into a new cache to simulate the next application run
+        pCache.Release();
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pData));
+
+        MeasurePhase("BytecodeCache_Warm", Multithreaded, CreatePipeline);
+    });
+}
+
+#if ARCHIVER_SUPPORTED
+
+TEST_F(PSOCreationBenchmark, RenderStateCache)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ForEachThreadingMode([pDevice](bool Multithreaded) {
+        const RenderStateCacheCreateInfo CacheCI{pDevice, RENDER_STATE_CACHE_LOG_LEVEL_DISABLED};
+
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        auto CreatePipeline = [&](Uint32 Idx) {
+            RefCntAutoPtr<IShader> pVS;
+            pCache->CreateShader(GetShaderCI(SHADER_TYPE_VERTEX, Idx), &pVS);
+            RefCntAutoPtr<IShader> pPS;
+            pCache->CreateShader(GetShaderCI(SHADER_TYPE_PIXEL, Idx), &pPS);
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            if (pVS && pPS)
+                pCache->CreateGraphicsPipelineState(GetPSOCI(Idx, pVS, pPS), &pPSO);
+            return pPSO;
+        };
+
+        MeasurePhase("RenderStateCache_Cold", Multithreaded, CreatePipeline);
+
+        RefCntAutoPtr<IDataBlob> pData;
+        pCache->WriteToBlob(&pData);
+        ASSERT_NE(pData, nullptr);
+
+        // Load the blob into a new cache to simulate the next application run
+        pCache.Release();
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pData));
+
+        MeasurePhase("RenderStateCache_Warm", Multithreaded, CreatePipeline);
+    });
+}
+
+TEST_F(PSOCreationBenchmark, Dearchiver)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCreateInfo{}, &pDearchiver);
+    if (!pDearchiver || !pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto DeviceFlag = static_cast<ARCHIVE_DEVICE_DATA_FLAGS>(1u << pDevice->GetDeviceInfo().Type);
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    {
+        RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+        pArchiverFactory->CreateSerializationDevice(SerializationDeviceCreateInfo{}, &pSerializationDevice);
+        ASSERT_NE(pSerializationDevice, nullptr);
+
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        ASSERT_NE(pArchiver, nullptr);
+
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+        {
+            RefCntAutoPtr<IShader> pVS;
+            pSerializationDevice->CreateShader(GetShaderCI(SHADER_TYPE_VERTEX, i), ShaderArchiveInfo{DeviceFlag}, &pVS);
+            ASSERT_NE(pVS, nullptr);
+            RefCntAutoPtr<IShader> pPS;
+            pSerializationDevice->CreateShader(GetShaderCI(SHADER_TYPE_PIXEL, i), ShaderArchiveInfo{DeviceFlag}, &pPS);
+            ASSERT_NE(pPS, nullptr);
+
+            PipelineStateArchiveInfo ArchiveInfo;
+            ArchiveInfo.DeviceFlags = DeviceFlag;
+
+            RefCntAutoPtr<IPipelineState> pSerializedPSO;
+            pSerializationDevice->CreateGraphicsPipelineState(GetPSOCI(i, pVS, pPS), ArchiveInfo, &pSerializedPSO);
+            ASSERT_NE(pSerializedPSO, nullptr);
+            ASSERT_TRUE(pArchiver->AddPipelineState(pSerializedPSO));
+        }
+
+        pArchiver->SerializeToBlob(&pArchive);
+        ASSERT_NE(pArchive, nullptr);
+    }
+
+    // A new dearchiver is used by every phase since the dearchiver keeps the unpacked objects
+    auto UnpackPipelines = [&](const char* Name, bool Multithreaded, IPipelineStateCache* pPSOCache) {
+        RefCntAutoPtr<IDearchiver> pPhaseDearchiver;
+        pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCreateInfo{}, &pPhaseDearchiver);
+        ASSERT_NE(pPhaseDearchiver, nullptr);
+        ASSERT_TRUE(pPhaseDearchiver->LoadArchive(pArchive));
+
+        MeasurePhase(Name, Multithreaded, [&](Uint32 Idx) {
+            PipelineStateUnpackInfo UnpackInfo;
+            UnpackInfo.Name         = sm_PSONames[Idx].c_str();
+            UnpackInfo.pDevice      = pDevice;
+            UnpackInfo.PipelineType = PIPELINE_TYPE_GRAPHICS;
+            UnpackInfo.pCache       = pPSOCache;
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            pPhaseDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+            return pPSO;
+        });
+    };
+
+    ForEachThreadingMode([&](bool Multithreaded) {
+        UnpackPipelines("Dearchiver", Multithreaded, nullptr);
+
+        auto pPSOCache = CreatePSOCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
+        if (pPSOCache)
+        {
+            UnpackPipelines("Dearchiver_PSOCache_Cold", Multithreaded, pPSOCache);
+            UnpackPipelines("Dearchiver_PSOCache_Warm", Multithreaded, pPSOCache);
+        }
+    });
+}
+
+#endif // ARCHIVER_SUPPORTED
+
+} // namespace
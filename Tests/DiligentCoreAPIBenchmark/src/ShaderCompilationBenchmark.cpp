@@ -0,0 +1,231 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <atomic>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkRunner.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+namespace GLSL
+{
+
+const std::string BenchmarkVS{R"(
+#version 450
+
+layout(std140) uniform cbData
+{
+    vec4 g_Offset;
+    mat4 g_Transform;
+};
+
+layout(location = 0) in vec3 in_Pos;
+layout(location = 1) in vec2 in_UV;
+
+layout(location = 0) out vec2 out_UV;
+
+void main()
+{
+    gl_Position = g_Transform * vec4(in_Pos, 1.0) + g_Offset;
+    out_UV      = in_UV;
+}
+)"};
+
+const std::string BenchmarkPS{R"(
+#version 450
+
+uniform sampler2D g_Tex;
+
+layout(location = 0) in vec2 in_UV;
+
+layout(location = 0) out vec4 out_Color;
+
+void main()
+{
+    vec4 Color = vec4(0.0);
+    for (int i = 0; i < 4; ++i)
+        Color += texture(g_Tex, in_UV + vec2(float(i) * 0.01, 0.0));
+    out_Color = Color * 0.25;
+}
+)"};
+
+} // namespace GLSL
+
+// The number of shaders every thread compiles.
+constexpr Uint32 NumItemsPerThread = 16;
+
+// Measures how GLSL compilation scales with the number of threads, both when shaders
+// are created by the render device (glslang front-end in Vulkan, driver compiler in GL)
+// and when they are compiled by the archiver for the Vulkan and GL back-ends.
+// Scaling efficiency is the throughput with N threads divided by N times the
+// single-threaded throughput; values well below 100% indicate shared state
+// in the compiler front-end.
+class ShaderCompilationBenchmark : public ::testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    static ShaderCreateInfo GetShaderCI(Uint32 ItemIdx)
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.EntryPoint     = "main";
+        if (ItemIdx % 2 == 0)
+        {
+            ShaderCI.Desc   = {"Shader compilation benchmark VS", SHADER_TYPE_VERTEX, true};
+            ShaderCI.Source = GLSL::BenchmarkVS.c_str();
+        }
+        else
+        {
+            ShaderCI.Desc   = {"Shader compilation benchmark PS", SHADER_TYPE_PIXEL, true};
+            ShaderCI.Source = GLSL::BenchmarkPS.c_str();
+        }
+        return ShaderCI;
+    }
+
+    // Runs Compile(ThreadIdx, ItemIdx) NumItemsPerThread times on every thread
+    // for 1, 2, 4, ... threads up to the number of hardware threads, and reports the
+    // time per shader and the scaling efficiency for every thread count.
+    template <typename CompileType>
+    static void RunScalingBenchmark(const char* Name, const CompileType& Compile)
+    {
+        const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+        std::vector<Uint32> ThreadCounts;
+        for (Uint32 NumThreads = 1; NumThreads < MaxThreads; NumThreads *= 2)
+            ThreadCounts.push_back(NumThreads);
+        ThreadCounts.push_back(MaxThreads);
+
+        // Warm up the compiler built-in symbol tables and allocators
+        for (Uint32 i = 0; i < 2; ++i)
+            Compile(0, i);
+        GPUTestingEnvironment::GetInstance()->ReleaseResources();
+
+        double SingleThreadedNsPerItem = 0;
+        for (const auto NumThreads : ThreadCounts)
+        {
+            std::atomic<Uint32> NumThreadsReady{0};
+            std::atomic<bool>   Start{false};
+
+            std::vector<std::thread> Workers(NumThreads);
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Workers[t] = std::thread{
+                    [&, t]() {
+                        NumThreadsReady.fetch_add(1);
+                        while (!Start.load())
+                            std::this_thread::yield();
+
+                        for (Uint32 i = 0; i < NumItemsPerThread; ++i)
+                            Compile(t, i);
+                    }};
+            }
+
+            // Exclude the thread startup time from the measurement
+            while (NumThreadsReady.load() < NumThreads)
+                std::this_thread::yield();
+
+            Timer T;
+            Start.store(true);
+            for (auto& Worker : Workers)
+                Worker.join();
+            const double ElapsedTime = T.GetElapsedTime();
+
+            const std::string FullName  = std::string{Name} + "_T" + std::to_string(NumThreads);
+            const double      NsPerItem = ReportBenchmarkResult(FullName.c_str(), ElapsedTime, Uint64{NumItemsPerThread} * NumThreads);
+            if (NumThreads == 1)
+                SingleThreadedNsPerItem = NsPerItem;
+
+            const double Efficiency = SingleThreadedNsPerItem / (NsPerItem * NumThreads) * 100.0;
+            std::cout << "[ BENCH    ] " << std::left << std::setw(40) << (FullName + " efficiency") << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(14) << Efficiency << " %" << std::endl;
+            RecordProperty(FullName + "_efficiency", std::to_string(Efficiency));
+
+            GPUTestingEnvironment::GetInstance()->ReleaseResources();
+        }
+    }
+};
+
+TEST_F(ShaderCompilationBenchmark, CreateShader)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.IsVulkanDevice() && !DeviceInfo.IsGLDevice())
+        GTEST_SKIP() << "GLSL shaders are compiled by glslang or the GL driver only in Vulkan and OpenGL back-ends";
+    if (!DeviceInfo.Features.MultithreadedResourceCreation)
+        GTEST_SKIP() << "This device does not support multithreaded resource creation";
+
+    RunScalingBenchmark("CreateShaderGLSL", [pDevice](Uint32, Uint32 ItemIdx) {
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(GetShaderCI(ItemIdx), &pShader);
+        EXPECT_NE(pShader, nullptr);
+    });
+}
+
+#if ARCHIVER_SUPPORTED
+TEST_F(ShaderCompilationBenchmark, Archiver)
+{
+    auto* pArchiverFactory = GPUTestingEnvironment::GetInstance()->GetArchiverFactory();
+    ASSERT_NE(pArchiverFactory, nullptr);
+
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    pArchiverFactory->CreateSerializationDevice(SerializationDeviceCreateInfo{}, &pSerializationDevice);
+    ASSERT_NE(pSerializationDevice, nullptr);
+
+    ShaderArchiveInfo ArchiveInfo;
+    ArchiveInfo.DeviceFlags = pSerializationDevice->GetSupportedDeviceFlags() &
+        (ARCHIVE_DEVICE_DATA_FLAG_VULKAN | ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+    if (ArchiveInfo.DeviceFlags == ARCHIVE_DEVICE_DATA_FLAG_NONE)
+        GTEST_SKIP() << "The archiver is built without Vulkan and OpenGL support";
+
+    RunScalingBenchmark("ArchiveShaderGLSL", [&](Uint32, Uint32 ItemIdx) {
+        RefCntAutoPtr<IShader> pShader;
+        pSerializationDevice->CreateShader(GetShaderCI(ItemIdx), ArchiveInfo, &pShader);
+        EXPECT_NE(pShader, nullptr);
+    });
+}
+#endif
+
+} // namespace
@@ -0,0 +1,489 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "BenchmarkRunner.hpp"
+#include "MapHelper.hpp"
+#include "StreamingBuffer.hpp"
+#include "TextureUploader.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Upload sizes from 256 bytes to 64 MB. Texture uploads use square RGBA8 textures of the same size.
+constexpr Uint32 UploadSizes[] = {256, 4 << 10, 64 << 10, 1 << 20, 16 << 20, 64 << 20};
+
+// Dynamic buffers are suballocated from the per-frame dynamic heap in Direct3D12 and Vulkan,
+// and are meant for small per-frame data. Larger uploads through dynamic buffers are not measured.
+constexpr Uint32 MaxDynamicUploadSize = 1 << 20;
+
+// The amount of data uploaded by every benchmark, and the limits on the number of uploads.
+constexpr Uint64 TotalBytesPerBenchmark = Uint64{256} << 20;
+constexpr Uint32 MinUploadsPerBenchmark = 4;
+constexpr Uint32 MaxUploadsPerBenchmark = 1024;
+
+// The context is flushed and the frame is finished after this many uploads or bytes,
+// whatever comes first, to emulate uploads spread over frames.
+constexpr Uint32 MaxUploadsPerFrame = 64;
+constexpr Uint64 MaxBytesPerFrame   = Uint64{4} << 20;
+
+class UploadBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+        sm_SrcData.resize(UploadSizes[_countof(UploadSizes) - 1]);
+        for (size_t i = 0; i < sm_SrcData.size(); ++i)
+            sm_SrcData[i] = static_cast<Uint8>(i * 7 + (i >> 8));
+
+        constexpr auto QueueTypeMask = COMMAND_QUEUE_TYPE_GRAPHICS | COMMAND_QUEUE_TYPE_COMPUTE | COMMAND_QUEUE_TYPE_TRANSFER;
+        for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+        {
+            auto* pCtx = pEnv->GetDeviceContext(CtxInd);
+            if ((pCtx->GetDesc().QueueType & QueueTypeMask) == COMMAND_QUEUE_TYPE_TRANSFER)
+            {
+                sm_pTransferCtx = pCtx;
+                break;
+            }
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_SrcData.clear();
+        sm_SrcData.shrink_to_fit();
+        sm_pTransferCtx = nullptr;
+
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    // Returns the contexts to run the benchmark on: the main immediate context and,
+    // if the device has one, the transfer queue context.
+    static std::vector<IDeviceContext*> GetUploadContexts()
+    {
+        std::vector<IDeviceContext*> Contexts{GPUTestingEnvironment::GetInstance()->GetDeviceContext()};
+        if (sm_pTransferCtx != nullptr)
+            Contexts.push_back(sm_pTransferCtx);
+        return Contexts;
+    }
+
+    // Resources must be usable by the main context as well as by the transfer context.
+    static Uint64 GetImmediateContextMask()
+    {
+        auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+        Uint64 Mask = Uint64{1} << pEnv->GetDeviceContext()->GetDesc().ContextId;
+        if (sm_pTransferCtx != nullptr)
+            Mask |= Uint64{1} << sm_pTransferCtx->GetDesc().ContextId;
+        return Mask;
+    }
+
+    static std::string GetBenchmarkName(const char* Path, Uint32 Size, IDeviceContext* pCtx)
+    {
+        std::string Name{Path};
+        Name += '_';
+        Name += Size >= (1 << 20) ? std::to_string(Size >> 20) + "MB" : (Size >= (1 << 10) ? std::to_string(Size >> 10) + "KB" : std::to_string(Size) + "B");
+        if (pCtx == sm_pTransferCtx)
+            Name += "_CopyQueue";
+        return Name;
+    }
+
+    // Returns the width and height of the square RGBA8 texture of the given size.
+    static Uint32 GetTextureDim(Uint32 Size)
+    {
+        Uint32 Dim = 1;
+        while (Dim * Dim * 4 < Size)
+            Dim *= 2;
+        return Dim;
+    }
+
+    static void CopyRows(void* pDst, Uint64 DstStride, Uint32 RowSize, Uint32 NumRows)
+    {
+        for (Uint32 row = 0; row < NumRows; ++row)
+            memcpy(reinterpret_cast<Uint8*>(pDst) + row * DstStride, &sm_SrcData[size_t{row} * RowSize], RowSize);
+    }
+
+    // Calls Upload(pCtx) repeatedly and reports the end-to-end bandwidth, including the time
+    // the GPU takes to complete the uploads, and the CPU time spent in the upload path per MB.
+    // OnFinishFrame is called after every FinishFrame().
+    template <typename UploadType>
+    static void MeasureUpload(const std::string& Name, Uint32 Size, IDeviceContext* pCtx, const UploadType& Upload, const std::function<void()>& OnFinishFrame = nullptr)
+    {
+        auto FinishFrame = [&]() {
+            pCtx->Flush();
+            pCtx->FinishFrame();
+            if (OnFinishFrame)
+                OnFinishFrame();
+        };
+
+        // Warm up the upload heaps and staging resources
+        Upload(pCtx);
+        FinishFrame();
+        pCtx->WaitForIdle();
+
+        const Uint32 NumUploads = static_cast<Uint32>(std::min(std::max(TotalBytesPerBenchmark / Size, Uint64{MinUploadsPerBenchmark}), Uint64{MaxUploadsPerBenchmark}));
+
+        Timer  T;
+        Uint32 NumUploadsInFrame = 0;
+        Uint64 NumBytesInFrame   = 0;
+        for (Uint32 i = 0; i < NumUploads; ++i)
+        {
+            Upload(pCtx);
+
+            ++NumUploadsInFrame;
+            NumBytesInFrame += Size;
+            if (NumUploadsInFrame >= MaxUploadsPerFrame || NumBytesInFrame >= MaxBytesPerFrame || i + 1 == NumUploads)
+            {
+                FinishFrame();
+                NumUploadsInFrame = 0;
+                NumBytesInFrame   = 0;
+            }
+        }
+        const double CPUTime = T.GetElapsedTime();
+        pCtx->WaitForIdle();
+        const double TotalTime = T.GetElapsedTime();
+
+        const double TotalBytes = static_cast<double>(Size) * NumUploads;
+        const double GBPerSec   = TotalBytes / TotalTime * 1e-9;
+        const double CPUmsPerMB = CPUTime * 1e+3 / (TotalBytes / (1 << 20));
+
+        std::cout << "[ BENCH    ] " << std::left << std::setw(40) << Name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << GBPerSec << " GB/s" << std::setw(12) << CPUmsPerMB << " CPU ms/MB  (" << NumUploads << " uploads)" << std::endl;
+
+        RecordProperty(Name + "_GBps", std::to_string(GBPerSec));
+        RecordProperty(Name + "_cpu_ms_per_MB", std::to_string(CPUmsPerMB));
+    }
+
+    static std::vector<Uint8> sm_SrcData;
+    static IDeviceContext*    sm_pTransferCtx;
+};
+
+std::vector<Uint8> UploadBenchmark::sm_SrcData;
+IDeviceContext*    UploadBenchmark::sm_pTransferCtx = nullptr;
+
+TEST_F(UploadBenchmark, UpdateBuffer)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (auto* pCtx : GetUploadContexts())
+    {
+        for (const auto Size : UploadSizes)
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name                 = "Upload benchmark buffer";
+            BuffDesc.Size                 = Size;
+            BuffDesc.BindFlags            = BIND_VERTEX_BUFFER;
+            BuffDesc.Usage                = USAGE_DEFAULT;
+            BuffDesc.ImmediateContextMask = GetImmediateContextMask();
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+            ASSERT_NE(pBuffer, nullptr);
+
+            MeasureUpload(GetBenchmarkName("UpdateBuffer", Size, pCtx), Size, pCtx, [&](IDeviceContext* pContext) {
+                pContext->UpdateBuffer(pBuffer, 0, Size, sm_SrcData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            });
+        }
+    }
+}
+
+TEST_F(UploadBenchmark, MapStagingBuffer)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (auto* pCtx : GetUploadContexts())
+    {
+        for (const auto Size : UploadSizes)
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name                 = "Upload benchmark buffer";
+            BuffDesc.Size                 = Size;
+            BuffDesc.BindFlags            = BIND_VERTEX_BUFFER;
+            BuffDesc.Usage                = USAGE_DEFAULT;
+            BuffDesc.ImmediateContextMask = GetImmediateContextMask();
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+            ASSERT_NE(pBuffer, nullptr);
+
+            BuffDesc.Name           = "Upload benchmark staging buffer";
+            BuffDesc.BindFlags      = BIND_NONE;
+            BuffDesc.Usage          = USAGE_STAGING;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+            RefCntAutoPtr<IBuffer> pStagingBuffer;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+            ASSERT_NE(pStagingBuffer, nullptr);
+
+            // The staging buffer may be overwritten while the GPU still reads it,
+            // which does not affect the timings.
+            MeasureUpload(GetBenchmarkName("MapStagingBuffer", Size, pCtx), Size, pCtx, [&](IDeviceContext* pContext) {
+                {
+                    MapHelper<Uint8> StagingData{pContext, pStagingBuffer, MAP_WRITE, MAP_FLAG_NONE};
+                    memcpy(StagingData, sm_SrcData.data(), Size);
+                }
+                pContext->CopyBuffer(pStagingBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     pBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            });
+        }
+    }
+}
+
+TEST_F(UploadBenchmark, MapDynamicBuffer)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (const auto Size : UploadSizes)
+    {
+        if (Size > MaxDynamicUploadSize)
+            break;
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Upload benchmark dynamic buffer";
+        BuffDesc.Size           = Size;
+        BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+
+        MeasureUpload(GetBenchmarkName("MapDynamicBuffer", Size, pCtx), Size, pCtx, [&](IDeviceContext* pContext) {
+            MapHelper<Uint8> Data{pContext, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            memcpy(Data, sm_SrcData.data(), Size);
+        });
+    }
+}
+
+TEST_F(UploadBenchmark, StreamingBuffer)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (const auto Size : UploadSizes)
+    {
+        if (Size > MaxDynamicUploadSize)
+            break;
+
+        StreamingBufferCreateInfo StreamingBuffCI;
+        StreamingBuffCI.pDevice                 = pDevice;
+        StreamingBuffCI.BuffDesc.Name           = "Upload benchmark streaming buffer";
+        StreamingBuffCI.BuffDesc.Size           = MaxDynamicUploadSize * 4;
+        StreamingBuffCI.BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+        StreamingBuffCI.BuffDesc.Usage          = USAGE_DYNAMIC;
+        StreamingBuffCI.BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        StreamingBuffCI.AllowPersistentMapping  = true;
+
+        StreamingBuffer StreamBuff{StreamingBuffCI};
+        ASSERT_NE(StreamBuff.GetBuffer(), nullptr);
+
+        // Dynamic allocations are only valid until the end of the frame, so the buffer
+        // is reset after every frame.
+        MeasureUpload(
+            GetBenchmarkName("StreamingBuffer", Size, pCtx), Size, pCtx,
+            [&](IDeviceContext* pContext) {
+                StreamBuff.Update(pContext, pDevice, sm_SrcData.data(), Size);
+            },
+            [&]() {
+                StreamBuff.Reset();
+            });
+        StreamBuff.Reset();
+    }
+}
+
+TEST_F(UploadBenchmark, UpdateTexture)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (auto* pCtx : GetUploadContexts())
+    {
+        for (const auto Size : UploadSizes)
+        {
+            const auto Dim = GetTextureDim(Size);
+
+            TextureDesc TexDesc;
+            TexDesc.Name                 = "Upload benchmark texture";
+            TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width                = Dim;
+            TexDesc.Height               = Dim;
+            TexDesc.Format               = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.BindFlags            = BIND_SHADER_RESOURCE;
+            TexDesc.Usage                = USAGE_DEFAULT;
+            TexDesc.ImmediateContextMask = GetImmediateContextMask();
+
+            RefCntAutoPtr<ITexture> pTexture;
+            pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+            ASSERT_NE(pTexture, nullptr);
+
+            const Box               UpdateBox{0, Dim, 0, Dim};
+            const TextureSubResData SubresData{sm_SrcData.data(), Uint64{Dim} * 4};
+
+            MeasureUpload(GetBenchmarkName("UpdateTexture", Size, pCtx), Size, pCtx, [&](IDeviceContext* pContext) {
+                pContext->UpdateTexture(pTexture, 0, 0, UpdateBox, SubresData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            });
+        }
+    }
+}
+
+TEST_F(UploadBenchmark, MapStagingTexture)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (auto* pCtx : GetUploadContexts())
+    {
+        for (const auto Size : UploadSizes)
+        {
+            const auto Dim = GetTextureDim(Size);
+
+            TextureDesc TexDesc;
+            TexDesc.Name                 = "Upload benchmark texture";
+            TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width                = Dim;
+            TexDesc.Height               = Dim;
+            TexDesc.Format               = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.BindFlags            = BIND_SHADER_RESOURCE;
+            TexDesc.Usage                = USAGE_DEFAULT;
+            TexDesc.ImmediateContextMask = GetImmediateContextMask();
+
+            RefCntAutoPtr<ITexture> pTexture;
+            pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+            ASSERT_NE(pTexture, nullptr);
+
+            TexDesc.Name           = "Upload benchmark staging texture";
+            TexDesc.BindFlags      = BIND_NONE;
+            TexDesc.Usage          = USAGE_STAGING;
+            TexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+            RefCntAutoPtr<ITexture> pStagingTexture;
+            pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
+            ASSERT_NE(pStagingTexture, nullptr);
+
+            // The staging texture may be overwritten while the GPU still reads it,
+            // which does not affect the timings.
+            MeasureUpload(GetBenchmarkName("MapStagingTexture", Size, pCtx), Size, pCtx, [&](IDeviceContext* pContext) {
+                MappedTextureSubresource MappedData;
+                pContext->MapTextureSubresource(pStagingTexture, 0, 0, MAP_WRITE, MAP_FLAG_NONE, nullptr, MappedData);
+                CopyRows(MappedData.pData, MappedData.Stride, Dim * 4, Dim);
+                pContext->UnmapTextureSubresource(pStagingTexture, 0, 0);
+
+                pContext->CopyTexture(CopyTextureAttribs{pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                                         pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+            });
+        }
+    }
+}
+
+TEST_F(UploadBenchmark, TextureUploader)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    // The uploader always runs on the main context. Copy contexts are only supported
+    // by the Direct3D12 and Vulkan uploaders.
+    std::vector<IDeviceContext*> CopyContexts{nullptr};
+    if (sm_pTransferCtx != nullptr && (pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12 || pDevice->GetDeviceInfo().IsVulkanDevice()))
+        CopyContexts.push_back(sm_pTransferCtx);
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+    for (auto* pCopyCtx : CopyContexts)
+    {
+        TextureUploaderDesc UploaderDesc;
+        UploaderDesc.pCopyContext = pCopyCtx;
+
+        RefCntAutoPtr<ITextureUploader> pUploader;
+        CreateTextureUploader(pDevice, UploaderDesc, &pUploader);
+        ASSERT_NE(pUploader, nullptr);
+
+        for (const auto Size : UploadSizes)
+        {
+            const auto Dim = GetTextureDim(Size);
+
+            TextureDesc TexDesc;
+            TexDesc.Name                 = "Upload benchmark texture";
+            TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+            TexDesc.Width                = Dim;
+            TexDesc.Height               = Dim;
+            TexDesc.Format               = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.BindFlags            = BIND_SHADER_RESOURCE;
+            TexDesc.Usage                = USAGE_DEFAULT;
+            TexDesc.ImmediateContextMask = GetImmediateContextMask();
+
+            RefCntAutoPtr<ITexture> pTexture;
+            pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+            ASSERT_NE(pTexture, nullptr);
+
+            UploadBufferDesc UploadBuffDesc;
+            UploadBuffDesc.Width  = Dim;
+            UploadBuffDesc.Height = Dim;
+            UploadBuffDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+
+            auto Name = GetBenchmarkName("TextureUploader", Size, pCtx);
+            if (pCopyCtx != nullptr)
+                Name += "_CopyQueue";
+
+            MeasureUpload(Name, Size, pCtx, [&](IDeviceContext* pContext) {
+                RefCntAutoPtr<IUploadBuffer> pUploadBuffer;
+                pUploader->AllocateUploadBuffer(pContext, UploadBuffDesc, &pUploadBuffer);
+
+                const auto MappedData = pUploadBuffer->GetMappedData(0, 0);
+                CopyRows(MappedData.pData, MappedData.Stride, Dim * 4, Dim);
+
+                pUploader->ScheduleGPUCopy(pContext, pTexture, 0, 0, pUploadBuffer);
+                pUploader->RecycleBuffer(pUploadBuffer);
+            });
+        }
+    }
+}
+
+} // namespace
@@ -35,6 +35,7 @@
 #include "SerializedPipelineState.h"
 #include "SerializedShader.h"
 #include "ShaderMacroHelper.hpp"
+#include "ThreadPool.hpp"
 
 #include "ResourceLayoutTestCommon.hpp"
 #include "gtest/gtest.h"
@@ -1274,6 +1275,56 @@ void CreateComputeShader(IRenderDevice*        pDevice,
     }
 }
 
+TEST(ArchiveTest, ParallelShaderCompilation)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+    if (!pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto SerializeComputeShader = [&](IThreadPool* pThreadPool) {
+        SerializationDeviceCreateInfo SerDeviceCI;
+        SerDeviceCI.pCompilationThreadPool = pThreadPool;
+        RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+        pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+        if (!pSerializationDevice)
+            return RefCntAutoPtr<IDataBlob>{};
+
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        if (!pArchiver)
+            return RefCntAutoPtr<IDataBlob>{};
+
+        ShaderCreateInfo       ShaderCI;
+        RefCntAutoPtr<IShader> pSerializedCS;
+        CreateComputeShader(pDevice, pSerializationDevice, ShaderCI, nullptr, &pSerializedCS);
+        if (!pSerializedCS || !pArchiver->AddShader(pSerializedCS))
+            return RefCntAutoPtr<IDataBlob>{};
+
+        RefCntAutoPtr<IDataBlob> pArchive;
+        pArchiver->SerializeToBlob(&pArchive);
+        return pArchive;
+    };
+
+    auto pRefArchive = SerializeComputeShader(nullptr);
+    ASSERT_NE(pRefArchive, nullptr);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Archives produced with and without the thread pool must be identical
+    auto pArchive = SerializeComputeShader(pThreadPool);
+    ASSERT_NE(pArchive, nullptr);
+    ASSERT_EQ(pArchive->GetSize(), pRefArchive->GetSize());
+    EXPECT_EQ(memcmp(pArchive->GetConstDataPtr(), pRefArchive->GetConstDataPtr(), pArchive->GetSize()), 0);
+}
+
 void TestComputePipeline(PSO_ARCHIVE_FLAGS ArchiveFlags)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
@@ -1468,6 +1519,167 @@ TEST(ArchiveTest, ComputePipeline_NoReflection_SplitArchive)
     TestComputePipeline(PSO_ARCHIVE_FLAG_STRIP_REFLECTION | PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES);
 }
 
+TEST(ArchiveTest, SharedShaders)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    DearchiverCreateInfo       DearchiverCI{};
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pDearchiver);
+    if (!pDearchiver || !pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by device";
+
+    constexpr char    PRSName[]  = "ArchiveTest.SharedShaders - PRS";
+    const char* const PSONames[] = {"ArchiveTest.SharedShaders - PSO 0", "ArchiveTest.SharedShaders - PSO 1"};
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    SerializationDeviceCreateInfo SerDeviceCI;
+    SerDeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+    ASSERT_NE(pSerializationDevice, nullptr);
+
+    ShaderCreateInfo       ShaderCI;
+    RefCntAutoPtr<IShader> pSerializedCS;
+    CreateComputeShader(pDevice, pSerializationDevice, ShaderCI, nullptr, &pSerializedCS);
+    ASSERT_NE(pSerializedCS, nullptr);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pSerializedPRS;
+    {
+        constexpr PipelineResourceDesc Resources[] = {{SHADER_TYPE_COMPUTE, "g_tex2DUAV", 1, SHADER_RESOURCE_TYPE_TEXTURE_UAV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}};
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = PRSName;
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+
+        pSerializationDevice->CreatePipelineResourceSignature(PRSDesc, ResourceSignatureArchiveInfo{GetDeviceBits()}, &pSerializedPRS);
+        ASSERT_NE(pSerializedPRS, nullptr);
+    }
+
+    // The signature and the standalone shader are stored in the common archive
+    {
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        ASSERT_NE(pArchiver, nullptr);
+        ASSERT_TRUE(pArchiver->AddPipelineResourceSignature(pSerializedPRS));
+        ASSERT_TRUE(pArchiver->AddShader(pSerializedCS));
+
+        RefCntAutoPtr<IDataBlob> pArchive;
+        pArchiver->SerializeToBlob(&pArchive);
+        ASSERT_NE(pArchive, nullptr);
+        ASSERT_TRUE(pDearchiver->LoadArchive(pArchive));
+    }
+
+    // Every pipeline is stored in its own archive, and both pipelines use the same shader
+    for (const char* PSOName : PSONames)
+    {
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        ASSERT_NE(pArchiver, nullptr);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = PSOName;
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.pCS                  = pSerializedCS;
+
+        IPipelineResourceSignature* Signatures[] = {pSerializedPRS};
+        PSOCreateInfo.ResourceSignaturesCount    = _countof(Signatures);
+        PSOCreateInfo.ppResourceSignatures       = Signatures;
+
+        PipelineStateArchiveInfo ArchiveInfo;
+        ArchiveInfo.DeviceFlags = GetDeviceBits();
+#if PLATFORM_MACOS
+        // Compute shaders are not supported in OpenGL on MacOS
+        ArchiveInfo.DeviceFlags &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+        ArchiveInfo.PSOFlags = PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES;
+
+        RefCntAutoPtr<IPipelineState> pSerializedPSO;
+        pSerializationDevice->CreateComputePipelineState(PSOCreateInfo, ArchiveInfo, &pSerializedPSO);
+        ASSERT_NE(pSerializedPSO, nullptr);
+        ASSERT_TRUE(pArchiver->AddPipelineState(pSerializedPSO));
+
+        RefCntAutoPtr<IDataBlob> pArchive;
+        pArchiver->SerializeToBlob(&pArchive);
+        ASSERT_NE(pArchive, nullptr);
+        ASSERT_TRUE(pDearchiver->LoadArchive(pArchive));
+    }
+
+    // Unpacks the pipeline and returns the shader it was created with
+    auto UnpackPSO = [&](const char* Name, RefCntAutoPtr<IShader>& pCS) {
+        PipelineStateUnpackInfo UnpackInfo;
+        UnpackInfo.Name         = Name;
+        UnpackInfo.pDevice      = pDevice;
+        UnpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
+        UnpackInfo.pUserData    = &pCS;
+
+        UnpackInfo.ModifyPipelineStateCreateInfo = [](PipelineStateCreateInfo& PipelineCI, void* pUserData) {
+            auto& pCS = *static_cast<RefCntAutoPtr<IShader>*>(pUserData);
+            pCS       = static_cast<ComputePipelineStateCreateInfo&>(PipelineCI).pCS;
+        };
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+        return pPSO;
+    };
+
+    auto UnpackShader = [&]() {
+        ShaderUnpackInfo UnpackInfo;
+        UnpackInfo.Name    = ShaderCI.Desc.Name;
+        UnpackInfo.pDevice = pDevice;
+
+        RefCntAutoPtr<IShader> pShader;
+        pDearchiver->UnpackShader(UnpackInfo, &pShader);
+        return pShader;
+    };
+
+    {
+        RefCntAutoPtr<IShader> pCS0, pCS1;
+
+        auto pPSO0 = UnpackPSO(PSONames[0], pCS0);
+        auto pPSO1 = UnpackPSO(PSONames[1], pCS1);
+        ASSERT_NE(pPSO0, nullptr);
+        ASSERT_NE(pPSO1, nullptr);
+        ASSERT_NE(pCS0, nullptr);
+        // Identical shaders from different archives resolve to the same object
+        EXPECT_EQ(pCS0, pCS1);
+    }
+
+    {
+        auto pShader = UnpackShader();
+        ASSERT_NE(pShader, nullptr);
+        EXPECT_EQ(UnpackShader(), pShader);
+
+        // The cache does not keep the shader alive: the entry is dropped once all users are released
+        RefCntWeakPtr<IShader> pWeakShader{pShader};
+        pShader.Release();
+        EXPECT_FALSE(pWeakShader.Lock());
+
+        pShader = UnpackShader();
+        ASSERT_NE(pShader, nullptr);
+        EXPECT_FALSE(pWeakShader.Lock());
+    }
+
+    // Shaders of the unpacked pipelines are kept by the archive until the dearchiver is reset
+    RefCntWeakPtr<IShader> pWeakCS;
+    {
+        RefCntAutoPtr<IShader> pCS;
+        auto                   pPSO = UnpackPSO(PSONames[0], pCS);
+        ASSERT_NE(pCS, nullptr);
+        pWeakCS = RefCntWeakPtr<IShader>{pCS};
+    }
+    EXPECT_TRUE(pWeakCS.Lock());
+    pDearchiver->Reset();
+    EXPECT_FALSE(pWeakCS.Lock());
+}
+
 TEST(ArchiveTest, RayTracingPipeline)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
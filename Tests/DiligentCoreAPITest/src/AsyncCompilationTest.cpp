@@ -0,0 +1,262 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadSignal.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+void VSMain(out float4 pos : SV_POSITION)
+{
+    pos = float4(0.0, 0.0, 0.0, 0.0);
+}
+
+void PSMain(out float4 col : SV_TARGET)
+{
+    col = float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+static const char g_BrokenPSSource[] = R"(
+void PSMain(out float4 col : SV_TARGET)
+{
+    col = float3(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+// Occupies all worker threads of the shader compilation thread pool so that
+// the tasks that are enqueued while the blocker is active stay in the queue.
+class ThreadPoolBlocker
+{
+public:
+    explicit ThreadPoolBlocker(IThreadPool* pThreadPool)
+    {
+        for (Uint32 i = 0; i < GPUTestingEnvironment::NumShaderCompilationThreads; ++i)
+        {
+            m_Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                                  [this](Uint32) {
+                                                      m_Signal.Wait();
+                                                  }));
+        }
+        for (auto& pTask : m_Tasks)
+            pTask->WaitUntilRunning();
+    }
+
+    ~ThreadPoolBlocker()
+    {
+        Unblock();
+    }
+
+    void Unblock()
+    {
+        m_Signal.Trigger(true);
+        for (auto& pTask : m_Tasks)
+            pTask->WaitForCompletion();
+        m_Tasks.clear();
+    }
+
+private:
+    Threading::Signal                      m_Signal;
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_Tasks;
+};
+
+class AsyncCompilationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
+        if (DeviceInfo.IsGLDevice() || DeviceInfo.IsMetalDevice())
+        {
+            GTEST_SKIP() << "Asynchronous compilation is not supported by this backend";
+        }
+    }
+
+    static RefCntAutoPtr<IShader> CreateShader(const char* Name, const char* Source, const char* EntryPoint, SHADER_TYPE ShaderType)
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source         = Source;
+        ShaderCI.EntryPoint     = EntryPoint;
+        ShaderCI.Desc           = {Name, ShaderType, true};
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.CompileFlags   = SHADER_COMPILE_FLAG_ASYNCHRONOUS;
+
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(ShaderCI, &pShader);
+        return pShader;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(IShader* pVS, IShader* pPS)
+    {
+        auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                       = "Async compilation test PSO";
+        PSOCreateInfo.Flags                              = PSO_CREATE_FLAG_ASYNCHRONOUS;
+        PSOCreateInfo.pVS                                = pVS;
+        PSOCreateInfo.pPS                                = pPS;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets  = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+};
+
+TEST_F(AsyncCompilationTest, CompilingToReady)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ThreadPoolBlocker Blocker{pEnv->GetShaderCompilationThreadPool()};
+
+    auto pVS = CreateShader("Async compilation test VS", g_ShaderSource, "VSMain", SHADER_TYPE_VERTEX);
+    auto pPS = CreateShader("Async compilation test PS", g_ShaderSource, "PSMain", SHADER_TYPE_PIXEL);
+    ASSERT_TRUE(pVS && pPS);
+    EXPECT_EQ(pVS->GetStatus(), SHADER_STATUS_COMPILING);
+    EXPECT_EQ(pPS->GetStatus(), SHADER_STATUS_COMPILING);
+
+    auto pPSO = CreatePSO(pVS, pPS);
+    ASSERT_TRUE(pPSO);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_COMPILING);
+
+    Blocker.Unblock();
+
+    EXPECT_EQ(pVS->GetStatus(/*WaitForCompletion = */ true), SHADER_STATUS_READY);
+    EXPECT_EQ(pPS->GetStatus(/*WaitForCompletion = */ true), SHADER_STATUS_READY);
+
+    // Poll the status without waiting
+    while (pPSO->GetStatus() == PIPELINE_STATE_STATUS_COMPILING)
+        std::this_thread::yield();
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    EXPECT_EQ(pPSO->GetStatus(/*WaitForCompletion = */ true), PIPELINE_STATE_STATUS_READY);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    EXPECT_TRUE(pSRB);
+}
+
+TEST_F(AsyncCompilationTest, CompileError)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    pEnv->SetErrorAllowance(4, "\n\nNo worries, testing broken shader...\n\n");
+
+    // The object is created even though the source is invalid. The error is reported through the status.
+    auto pPS = CreateShader("Async compilation test broken PS", g_BrokenPSSource, "PSMain", SHADER_TYPE_PIXEL);
+    ASSERT_TRUE(pPS);
+    EXPECT_EQ(pPS->GetStatus(/*WaitForCompletion = */ true), SHADER_STATUS_FAILED);
+}
+
+TEST_F(AsyncCompilationTest, FailedShaderFailsPipeline)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    pEnv->SetErrorAllowance(6, "\n\nNo worries, testing broken shader...\n\n");
+
+    ThreadPoolBlocker Blocker{pEnv->GetShaderCompilationThreadPool()};
+
+    auto pVS = CreateShader("Async compilation test VS", g_ShaderSource, "VSMain", SHADER_TYPE_VERTEX);
+    auto pPS = CreateShader("Async compilation test broken PS", g_BrokenPSSource, "PSMain", SHADER_TYPE_PIXEL);
+    ASSERT_TRUE(pVS && pPS);
+
+    // The pipeline is initialized after the shaders, so it sees the compile error
+    auto pPSO = CreatePSO(pVS, pPS);
+    ASSERT_TRUE(pPSO);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_COMPILING);
+
+    Blocker.Unblock();
+
+    EXPECT_EQ(pPSO->GetStatus(/*WaitForCompletion = */ true), PIPELINE_STATE_STATUS_FAILED);
+    EXPECT_EQ(pVS->GetStatus(), SHADER_STATUS_READY);
+    EXPECT_EQ(pPS->GetStatus(), SHADER_STATUS_FAILED);
+}
+
+TEST_F(AsyncCompilationTest, ReleasePending)
+{
+    auto* pEnv        = GPUTestingEnvironment::GetInstance();
+    auto* pThreadPool = pEnv->GetShaderCompilationThreadPool();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    {
+        ThreadPoolBlocker Blocker{pThreadPool};
+
+        auto pVS = CreateShader("Async compilation test VS", g_ShaderSource, "VSMain", SHADER_TYPE_VERTEX);
+        auto pPS = CreateShader("Async compilation test PS", g_ShaderSource, "PSMain", SHADER_TYPE_PIXEL);
+        ASSERT_TRUE(pVS && pPS);
+
+        auto pPSO = CreatePSO(pVS, pPS);
+        ASSERT_TRUE(pPSO);
+        EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_COMPILING);
+
+        // The pipeline and the shaders remove their tasks from the queue when they are destroyed
+        pPSO.Release();
+        pVS.Release();
+        pPS.Release();
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    }
+
+    // Destroy the pipeline while its task is queued or running
+    {
+        auto pVS = CreateShader("Async compilation test VS", g_ShaderSource, "VSMain", SHADER_TYPE_VERTEX);
+        auto pPS = CreateShader("Async compilation test PS", g_ShaderSource, "PSMain", SHADER_TYPE_PIXEL);
+        ASSERT_TRUE(pVS && pPS);
+
+        auto pPSO = CreatePSO(pVS, pPS);
+        ASSERT_TRUE(pPSO);
+        pPSO.Release();
+    }
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <vector>
+
+#include "BLASCompactionManager.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "RayTracingTestConstants.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(BLASCompactionManagerTest, Compact)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Triangle vertices";
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = sizeof(Vertices);
+        BufferData BuffData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &BuffData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangle";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = 1;
+
+    BLASBuildTriangleData TriangleData;
+    TriangleData.GeometryName         = TriangleDesc.GeometryName;
+    TriangleData.pVertexBuffer        = pVertexBuffer;
+    TriangleData.VertexStride         = sizeof(Vertices[0]);
+    TriangleData.VertexCount          = TriangleDesc.MaxVertexCount;
+    TriangleData.VertexValueType      = TriangleDesc.VertexValueType;
+    TriangleData.VertexComponentCount = TriangleDesc.VertexComponentCount;
+    TriangleData.PrimitiveCount       = 1;
+    TriangleData.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    constexpr Uint32 NumBatches      = 3;
+    constexpr Uint32 NumBLASPerBatch = 8;
+
+    BLASCompactionManager Compactor{BLASCompactionManager::CreateInfo{pDevice}};
+
+    std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes;
+    std::vector<RefCntAutoPtr<IBottomLevelAS>> CompactedBLASes;
+    Uint32                                     NumErrors = 0;
+    for (Uint32 batch = 0; batch < NumBatches; ++batch)
+    {
+        std::vector<IBottomLevelAS*>  pBatchBLASes(NumBLASPerBatch);
+        std::vector<BuildBLASAttribs> Builds(NumBLASPerBatch);
+        for (Uint32 i = 0; i < NumBLASPerBatch; ++i)
+        {
+            BottomLevelASDesc ASDesc;
+            ASDesc.Name          = "BLAS for compaction";
+            ASDesc.Flags         = RAYTRACING_BUILD_AS_ALLOW_COMPACTION | RAYTRACING_BUILD_AS_PREFER_FAST_TRACE;
+            ASDesc.pTriangles    = &TriangleDesc;
+            ASDesc.TriangleCount = 1;
+
+            RefCntAutoPtr<IBottomLevelAS> pBLAS;
+            pDevice->CreateBLAS(ASDesc, &pBLAS);
+            ASSERT_NE(pBLAS, nullptr);
+
+            auto& Attribs                  = Builds[i];
+            Attribs.pBLAS                  = pBLAS;
+            Attribs.BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            Attribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            Attribs.pTriangleData          = &TriangleData;
+            Attribs.TriangleDataCount      = 1;
+
+            pBatchBLASes[i] = pBLAS;
+            BLASes.emplace_back(std::move(pBLAS));
+        }
+
+        BuildBLASBatchAttribs BatchAttribs;
+        BatchAttribs.pBuilds    = Builds.data();
+        BatchAttribs.BuildCount = NumBLASPerBatch;
+        pContext->BuildBLASBatch(BatchAttribs);
+
+        Compactor.Enqueue(pContext, pBatchBLASes.data(), NumBLASPerBatch,
+                          [&](IBottomLevelAS* pOriginal, IBottomLevelAS* pCompacted) {
+                              if (pOriginal == nullptr || pCompacted == nullptr)
+                              {
+                                  ++NumErrors;
+                                  return;
+                              }
+                              if (pCompacted->GetDesc().CompactedSize == 0)
+                                  ++NumErrors;
+                              CompactedBLASes.emplace_back(pCompacted);
+                          });
+        EXPECT_EQ(Compactor.GetNumPendingBLASes(), size_t{(batch + 1) * NumBLASPerBatch} - CompactedBLASes.size());
+
+        pContext->Flush();
+        Compactor.Process(pContext);
+    }
+
+    Compactor.Flush(pContext);
+    EXPECT_EQ(Compactor.GetNumPendingBLASes(), size_t{0});
+    EXPECT_EQ(CompactedBLASes.size(), size_t{NumBatches * NumBLASPerBatch});
+    EXPECT_EQ(NumErrors, Uint32{0});
+
+    const auto& Stats = Compactor.GetStatistics();
+    EXPECT_EQ(Stats.NumCompacted, Uint64{NumBatches * NumBLASPerBatch});
+    EXPECT_EQ(Stats.NumFailed, Uint64{0});
+    EXPECT_GT(Stats.CompactedSize, Uint64{0});
+
+    // The original BLASes can be released right away
+    BLASes.clear();
+
+    for (const auto& pBLAS : CompactedBLASes)
+        EXPECT_EQ(pBLAS->GetState(), RESOURCE_STATE_BUILD_AS_WRITE);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -126,6 +126,39 @@ TEST(BufferAccessTest, UpdateBufferData)
     VerifyBufferData(pBuffer);
 }
 
+// Small consecutive updates may be merged into one copy command.
+// Overlapping updates must be applied in the order they were issued.
+TEST(BufferAccessTest, UpdateBufferDataPiecewise)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Test default buffer";
+    BuffDesc.Usage     = USAGE_DEFAULT;
+    BuffDesc.Size      = sizeof(TestBufferData);
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr) << "Buffer desc:\n"
+                                << BuffDesc;
+
+    constexpr float Garbage[_countof(TestBufferData)] = {};
+    pContext->UpdateBuffer(pBuffer, 0, sizeof(Garbage), Garbage, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    for (Uint32 i = 0; i < _countof(TestBufferData); i += 2)
+    {
+        const float Wrong = -1;
+        pContext->UpdateBuffer(pBuffer, i * sizeof(float), sizeof(float), &Wrong, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->UpdateBuffer(pBuffer, i * sizeof(float), sizeof(float) * 2, &TestBufferData[i], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    VerifyBufferData(pBuffer);
+}
+
 TEST(BufferAccessTest, MapWriteDiscard)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
@@ -154,6 +187,50 @@ TEST(BufferAccessTest, MapWriteDiscard)
     VerifyBufferData(pBuffer);
 }
 
+// Only the contents written by the last map must be visible.
+// In Direct3D11, the contents of every map may be suballocated from the dynamic constant ring.
+TEST(BufferAccessTest, MapWriteDiscardMultiple)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Test dynamic buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.Size           = sizeof(TestBufferData);
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr) << "Buffer desc:\n"
+                                << BuffDesc;
+
+    for (Uint32 i = 0; i < 64; ++i)
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        if (i < 63)
+        {
+            float Garbage[_countof(TestBufferData)];
+            for (auto& f : Garbage)
+                f = static_cast<float>(i);
+            memcpy(pData, Garbage, sizeof(Garbage));
+        }
+        else
+        {
+            memcpy(pData, TestBufferData, sizeof(TestBufferData));
+        }
+        pContext->UnmapBuffer(pBuffer, MAP_WRITE);
+    }
+
+    VerifyBufferData(pBuffer);
+}
+
 TEST(BufferAccessTest, CopyFromStaging)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
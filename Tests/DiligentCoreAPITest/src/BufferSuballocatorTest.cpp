@@ -149,4 +149,173 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, AllocateBinned)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name               = "Buffer Suballocator Test";
+    CI.Desc.BindFlags          = BIND_VERTEX_BUFFER;
+    CI.Desc.Size               = 1024;
+    CI.MaxBinnedAllocationSize = 256;
+    CI.BinChunkSize            = 1024;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_TRUE(pAllocator);
+
+    const size_t NumThreads     = std::max(4u, std::thread::hardware_concurrency());
+    const size_t NumAllocations = 256;
+
+    std::vector<std::vector<RefCntAutoPtr<IBufferSuballocation>>> pSubAllocations(NumThreads);
+    for (auto& Allocs : pSubAllocations)
+        Allocs.resize(NumAllocations);
+
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (size_t t = 0; t < Threads.size(); ++t)
+        {
+            Threads[t] = std::thread{
+                [&](size_t thread_id) //
+                {
+                    // Sizes above MaxBinnedAllocationSize are served by the general allocator
+                    FastRandInt rnd{static_cast<unsigned int>(thread_id), 4, 400};
+
+                    auto& Allocs = pSubAllocations[thread_id];
+                    for (size_t i = 0; i < Allocs.size(); ++i)
+                    {
+                        Uint32 size = static_cast<Uint32>(rnd());
+                        pAllocator->Allocate(size, 16, &Allocs[i]);
+                        ASSERT_TRUE(Allocs[i]);
+                        EXPECT_EQ(Allocs[i]->GetSize(), size);
+                        EXPECT_EQ(Allocs[i]->GetOffset() % 16, 0u);
+                        // Free every other allocation to exercise block reuse
+                        if (i % 2 == 1)
+                            Allocs[i - 1].Release();
+                    }
+                },
+                t //
+            };
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    std::vector<std::pair<Uint32, Uint32>> Ranges;
+    for (const auto& Allocs : pSubAllocations)
+    {
+        for (const auto& Alloc : Allocs)
+        {
+            if (Alloc)
+                Ranges.emplace_back(Alloc->GetOffset(), Alloc->GetSize());
+        }
+    }
+    std::sort(Ranges.begin(), Ranges.end());
+    for (size_t i = 1; i < Ranges.size(); ++i)
+        EXPECT_LE(Ranges[i - 1].first + Ranges[i - 1].second, Ranges[i].first) << "Suballocations overlap";
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, Ranges.size());
+    EXPECT_EQ(Stats.BinCount, 5u);
+
+    Uint32 BinnedAllocationCount = 0;
+    for (Uint32 i = 0; i < Stats.BinCount; ++i)
+    {
+        EXPECT_EQ(Stats.Bins[i].BlockSize, 16u << i);
+        BinnedAllocationCount += Stats.Bins[i].AllocationCount;
+    }
+    EXPECT_GT(BinnedAllocationCount, 0u);
+    EXPECT_LT(BinnedAllocationCount, Stats.AllocationCount);
+
+    auto* pBuffer = pAllocator->GetBuffer(pDevice, pContext);
+    EXPECT_NE(pBuffer, nullptr);
+
+    pSubAllocations.clear();
+
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 0u);
+    for (Uint32 i = 0; i < Stats.BinCount; ++i)
+        EXPECT_EQ(Stats.Bins[i].AllocationCount, 0u);
+}
+
+TEST(BufferSuballocatorTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name      = "Buffer Suballocator Test";
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    CI.Desc.Size      = 1024;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_TRUE(pAllocator);
+
+    constexpr Uint32 NumAllocations = 64;
+    constexpr Uint32 AllocSize      = 64;
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> pSubAllocations(NumAllocations);
+    for (auto& pAlloc : pSubAllocations)
+    {
+        pAllocator->Allocate(AllocSize, 16, &pAlloc);
+        ASSERT_TRUE(pAlloc);
+    }
+    pAllocator->GetBuffer(pDevice, pContext);
+
+    // Free the first half of the allocations to create a hole at the start of the buffer
+    for (Uint32 i = 0; i < NumAllocations / 2; ++i)
+        pSubAllocations[i].Release();
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    const auto UsedSize = Stats.UsedSize;
+
+    const auto Version = pAllocator->GetVersion();
+
+    // Move at most four allocations at a time
+    Uint64 TotalMovedBytes = 0;
+    for (Uint32 Pass = 0; Pass < NumAllocations; ++Pass)
+    {
+        const auto MovedBytes = pAllocator->Defragment(pDevice, pContext, AllocSize * 4);
+        EXPECT_LE(MovedBytes, AllocSize * 4);
+        if (MovedBytes == 0)
+            break;
+        TotalMovedBytes += MovedBytes;
+    }
+    EXPECT_GT(TotalMovedBytes, 0u);
+    EXPECT_GT(pAllocator->GetVersion(), Version);
+
+    pContext->Flush();
+    pContext->FinishFrame();
+
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.UsedSize, UsedSize);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+
+    // All live allocations must now be located in the first half of the buffer
+    std::vector<std::pair<Uint32, Uint32>> Ranges;
+    for (const auto& pAlloc : pSubAllocations)
+    {
+        if (pAlloc)
+        {
+            EXPECT_EQ(pAlloc->GetOffset() % 16, 0u);
+            EXPECT_LT(pAlloc->GetOffset(), NumAllocations / 2 * AllocSize);
+            Ranges.emplace_back(pAlloc->GetOffset(), pAlloc->GetSize());
+        }
+    }
+    std::sort(Ranges.begin(), Ranges.end());
+    for (size_t i = 1; i < Ranges.size(); ++i)
+        EXPECT_LE(Ranges[i - 1].first + Ranges[i - 1].second, Ranges[i].first) << "Suballocations overlap";
+}
+
 } // namespace
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <array>
+
+#include "CommandStreamRecorder.hpp"
+#include "CommandStreamPlayer.hpp"
+#include "DataBlobImpl.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(CommandStreamTest, RecordAndReplay)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    std::vector<Uint8> Stream;
+    {
+        CommandStreamRecorder Recorder{{pDevice, pContext}};
+
+        IRenderDevice*  pRecDevice  = Recorder.GetDevice();
+        IDeviceContext* pRecContext = Recorder.GetContext();
+
+        std::array<Uint32, 64> BufferData{};
+        for (Uint32 i = 0; i < BufferData.size(); ++i)
+            BufferData[i] = i;
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Command stream test source buffer";
+        BuffDesc.Size      = sizeof(BufferData);
+        BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage     = USAGE_DEFAULT;
+
+        Diligent::BufferData InitData{BufferData.data(), sizeof(BufferData)};
+
+        RefCntAutoPtr<IBuffer> pSrcBuffer;
+        pRecDevice->CreateBuffer(BuffDesc, &InitData, &pSrcBuffer);
+        ASSERT_NE(pSrcBuffer, nullptr);
+
+        BuffDesc.Name = "Command stream test destination buffer";
+        RefCntAutoPtr<IBuffer> pDstBuffer;
+        pRecDevice->CreateBuffer(BuffDesc, nullptr, &pDstBuffer);
+        ASSERT_NE(pDstBuffer, nullptr);
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Command stream test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        pRecDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        ASSERT_NE(pTexture, nullptr);
+        ITextureView* pRTV = pTexture->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+        constexpr Uint32 NumFrames = 3;
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            pRecContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            const float ClearColor[] = {0.25f * frame, 0.5f, 0.75f, 1.f};
+            pRecContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            BufferData[0] = frame;
+            pRecContext->UpdateBuffer(pSrcBuffer, 0, sizeof(Uint32), BufferData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            pRecContext->CopyBuffer(pSrcBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                    pDstBuffer, 0, sizeof(BufferData), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            pRecContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            pRecContext->Flush();
+            pRecContext->FinishFrame();
+        }
+
+        // The last frame is ended by the next recorded command
+        EXPECT_EQ(Recorder.GetNumFrames(), NumFrames - 1);
+        EXPECT_EQ(Recorder.GetNumCommands(), NumFrames * 6);
+        // Two buffers, the texture and its render target view
+        EXPECT_EQ(Recorder.GetNumObjects(), 4u);
+
+        Stream = Recorder.GetStream();
+    }
+    ASSERT_FALSE(Stream.empty());
+
+    CommandStreamPlayer Player{{pDevice, pContext}};
+
+    RefCntAutoPtr<DataBlobImpl> pStreamData = DataBlobImpl::Create(Stream.size(), Stream.data());
+    ASSERT_TRUE(Player.Load(pStreamData));
+    EXPECT_EQ(Player.GetNumFrames(), 3u);
+    EXPECT_EQ(Player.GetNumObjects(), 4u);
+    EXPECT_EQ(Player.GetNumFailedObjects(), 0u);
+
+    CommandStreamPlayer::ReplayStats Stats;
+    ASSERT_TRUE(Player.Replay(&Stats));
+    EXPECT_EQ(Stats.NumFrames, 3u);
+    EXPECT_EQ(Stats.NumCommands, 18u);
+    EXPECT_EQ(Stats.NumSkippedCommands, 0u);
+    EXPECT_EQ(Stats.FrameCPUTimes.size(), size_t{3});
+    EXPECT_LE(Stats.CPUTime, Stats.TotalTime + 1e-6);
+
+    // Replaying the same stream again reuses the objects
+    ASSERT_TRUE(Player.Replay(&Stats));
+    EXPECT_EQ(Stats.NumFrames, 3u);
+}
+
+TEST(CommandStreamTest, InvalidStream)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    CommandStreamPlayer Player{{pDevice, pContext}};
+
+    pEnv->SetErrorAllowance(2, "Errors below are expected: testing invalid command streams\n");
+
+    const Uint8 Garbage[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create(sizeof(Garbage), Garbage);
+    EXPECT_FALSE(Player.Load(pData));
+    EXPECT_FALSE(Player.Replay());
+}
+
+} // namespace
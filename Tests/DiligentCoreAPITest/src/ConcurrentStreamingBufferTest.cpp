@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentStreamingBuffer.hpp"
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ConcurrentStreamingBufferTest, ConcurrentWrites)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumThreads        = 4;
+    constexpr Uint32 NumChunksPerThread = 32;
+    constexpr Uint32 ChunkSize         = 4 * sizeof(Uint32);
+
+    ConcurrentStreamingBuffer::CreateInfo CI;
+    CI.pDevice        = pDevice;
+    CI.pContext       = pContext;
+    CI.Desc.Name      = "Concurrent streaming buffer test";
+    CI.Desc.Size      = 4096;
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    ConcurrentStreamingBuffer Buffer{CI};
+    ASSERT_NE(Buffer.GetBuffer(), nullptr);
+
+    std::vector<Uint64> Offsets(NumThreads * NumChunksPerThread);
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            for (Uint32 i = 0; i < NumChunksPerThread; ++i)
+            {
+                const Uint32 Value    = (t << 16u) | i;
+                const Uint32 Data[4]  = {Value, Value + 1, Value + 2, Value + 3};
+                const auto   ChunkIdx = t * NumChunksPerThread + i;
+                Offsets[ChunkIdx]     = Buffer.Write(Data, ChunkSize);
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    Buffer.Commit(pContext);
+    EXPECT_EQ(Buffer.GetUsedSize(), Uint64{NumThreads * NumChunksPerThread * ChunkSize});
+
+    GPUReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice = pDevice;
+    GPUReadbackQueue ReadbackQueue{ReadbackCI};
+
+    std::atomic<Uint32> NumErrors{0};
+    ReadbackQueue.ReadBuffer(pContext, Buffer.GetBuffer(), 0, CI.Desc.Size,
+                             [&](const GPUReadbackQueue::ReadbackData& Data) {
+                                 if (Data.pData == nullptr)
+                                 {
+                                     NumErrors.fetch_add(1);
+                                     return;
+                                 }
+                                 for (Uint32 t = 0; t < NumThreads; ++t)
+                                 {
+                                     for (Uint32 i = 0; i < NumChunksPerThread; ++i)
+                                     {
+                                         const auto Offset = Offsets[t * NumChunksPerThread + i];
+                                         if (Offset == ConcurrentStreamingBuffer::InvalidOffset || Offset % CI.Alignment != 0)
+                                         {
+                                             NumErrors.fetch_add(1);
+                                             continue;
+                                         }
+                                         const Uint32 Value   = (t << 16u) | i;
+                                         const Uint32 Ref[4]  = {Value, Value + 1, Value + 2, Value + 3};
+                                         const auto*  pChunk  = static_cast<const Uint8*>(Data.pData) + Offset;
+                                         if (memcmp(pChunk, Ref, ChunkSize) != 0)
+                                             NumErrors.fetch_add(1);
+                                     }
+                                 }
+                             });
+    ReadbackQueue.Flush(pContext);
+    EXPECT_EQ(NumErrors.load(), Uint32{0});
+}
+
+TEST(ConcurrentStreamingBufferTest, Wraparound)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ConcurrentStreamingBuffer::CreateInfo CI;
+    CI.pDevice        = pDevice;
+    CI.pContext       = pContext;
+    CI.Desc.Name      = "Concurrent streaming buffer wraparound test";
+    CI.Desc.Size      = 1024;
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    ConcurrentStreamingBuffer Buffer{CI};
+    ASSERT_NE(Buffer.GetBuffer(), nullptr);
+
+    EXPECT_FALSE(Buffer.Allocate(2048)) << "Allocation larger than the buffer must fail";
+
+    // Without the GPU releasing the space, the ring eventually runs out of space
+    Uint32 NumAllocations = 0;
+    while (Buffer.Allocate(100))
+        ++NumAllocations;
+    EXPECT_GT(NumAllocations, 0u);
+    EXPECT_LE(NumAllocations * 100, CI.Desc.Size);
+
+    // The data is released by the fence that is signaled by the Commit() call following the one that
+    // committed the data, and the space is returned to the ring once the GPU has passed the fence.
+    auto ReleaseSpace = [&]() {
+        Buffer.Commit(pContext);
+        pContext->WaitForIdle();
+        Buffer.Commit(pContext);
+        pContext->WaitForIdle();
+        Buffer.Commit(pContext);
+    };
+    ReleaseSpace();
+    EXPECT_EQ(Buffer.GetUsedSize(), Uint64{0});
+
+    for (Uint32 frame = 0; frame < 16; ++frame)
+    {
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            const auto Alloc = Buffer.Allocate(100);
+            EXPECT_TRUE(Alloc) << "Frame " << frame << ", allocation " << i;
+            if (Alloc)
+            {
+                EXPECT_EQ(Alloc.Offset % CI.Alignment, 0u);
+                EXPECT_LE(Alloc.Offset + 100, CI.Desc.Size);
+                memset(Alloc.pData, static_cast<int>(frame), 100);
+            }
+        }
+        ReleaseSpace();
+        pContext->FinishFrame();
+    }
+}
+
+} // namespace
@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstring>
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const char* CounterCS = R"(
+RWStructuredBuffer<uint> g_Counter;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Counter[0] = g_Counter[0] + 1u;
+}
+)";
+
+TEST(ConditionalRenderingTest, PredicatedDispatch)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ConditionalRendering || !pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Conditional rendering is not supported by this device";
+    }
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Conditional rendering test CS", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = CounterCS;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+
+    PSOCreateInfo.PSODesc.Name         = "Conditional rendering test";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IBuffer> pCounter;
+    {
+        const Uint32 Zero = 0;
+
+        BufferDesc Desc;
+        Desc.Name              = "Conditional rendering test counter";
+        Desc.Size              = sizeof(Zero);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS;
+        Desc.Mode              = BUFFER_MODE_STRUCTURED;
+        Desc.ElementByteStride = sizeof(Zero);
+
+        BufferData InitData{&Zero, sizeof(Zero)};
+        pDevice->CreateBuffer(Desc, &InitData, &pCounter);
+        ASSERT_NE(pCounter, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pPredicate;
+    {
+        // Predicate values are 64-bit; the first one is zero, the second one is non-zero.
+        const Uint64 Predicates[] = {0, 1};
+
+        BufferDesc Desc;
+        Desc.Name      = "Conditional rendering test predicate";
+        Desc.Size      = sizeof(Predicates);
+        Desc.BindFlags = BIND_INDIRECT_DRAW_ARGS;
+        Desc.Usage     = USAGE_IMMUTABLE;
+
+        BufferData InitData{Predicates, sizeof(Predicates)};
+        pDevice->CreateBuffer(Desc, &InitData, &pPredicate);
+        ASSERT_NE(pPredicate, nullptr);
+    }
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Counter")->Set(pCounter->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(pPSO);
+
+    struct PredicatedDispatch
+    {
+        Uint64                      Offset;
+        CONDITIONAL_RENDERING_FLAGS Flags;
+    };
+    constexpr PredicatedDispatch Dispatches[] = {
+        {0, CONDITIONAL_RENDERING_FLAG_NONE},     // Zero value - skipped
+        {8, CONDITIONAL_RENDERING_FLAG_NONE},     // Non-zero value - executed
+        {0, CONDITIONAL_RENDERING_FLAG_INVERTED}, // Zero value, inverted - executed
+        {8, CONDITIONAL_RENDERING_FLAG_INVERTED}, // Non-zero value, inverted - skipped
+    };
+    for (const auto& Dispatch : Dispatches)
+    {
+        // Transition the counter before every dispatch to make sure that the previous write is visible.
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        pContext->BeginConditionalRendering({pPredicate, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, Dispatch.Offset, Dispatch.Flags});
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+        pContext->EndConditionalRendering();
+    }
+
+    // Commands outside of the conditional rendering block must not be affected.
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+    BufferDesc StagingDesc;
+    StagingDesc.Name           = "Conditional rendering test staging buffer";
+    StagingDesc.Size           = sizeof(Uint32);
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStaging;
+    pDevice->CreateBuffer(StagingDesc, nullptr, &pStaging);
+    ASSERT_NE(pStaging, nullptr);
+
+    pContext->CopyBuffer(pCounter, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStaging, 0, sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStaging, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    Uint32 Counter = 0;
+    memcpy(&Counter, pData, sizeof(Counter));
+    pContext->UnmapBuffer(pStaging, MAP_READ);
+
+    EXPECT_EQ(Counter, 3u);
+}
+
+} // namespace
@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstring>
+#include <vector>
+
+#include "CrossDeviceCopyQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The testing environment creates a single device, so it is used as both the source
+// and the destination device. This exercises the same readback and upload path as
+// copies between different devices.
+
+TEST(CrossDeviceCopyQueueTest, CopyBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr float TestData[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Cross device copy test source";
+    BuffDesc.Size      = sizeof(TestData);
+    BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pSrcBuffer;
+    BufferData             InitData{TestData, sizeof(TestData)};
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pSrcBuffer);
+    ASSERT_NE(pSrcBuffer, nullptr);
+
+    BuffDesc.Name = "Cross device copy test destination";
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pDstBuffer);
+    ASSERT_NE(pDstBuffer, nullptr);
+
+    CrossDeviceCopyQueue::CreateInfo CI;
+    CI.pSrcDevice = pDevice;
+    CrossDeviceCopyQueue CopyQueue{CI};
+
+    // Copy the second half of the source buffer to the first half of the destination buffer
+    CopyQueue.CopyBuffer(pContext, pSrcBuffer, sizeof(TestData) / 2, sizeof(TestData) / 2, pDstBuffer, 0);
+    EXPECT_EQ(CopyQueue.GetNumPendingCopies(), size_t{1});
+    CopyQueue.Flush(pContext, pContext);
+    EXPECT_EQ(CopyQueue.GetNumPendingCopies(), size_t{0});
+
+    GPUReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice = pDevice;
+    GPUReadbackQueue ReadbackQueue{ReadbackCI};
+
+    bool DataValid = false;
+    ReadbackQueue.ReadBuffer(pContext, pDstBuffer, 0, sizeof(TestData) / 2,
+                             [&](const GPUReadbackQueue::ReadbackData& Data) {
+                                 DataValid = Data.pData != nullptr && memcmp(Data.pData, &TestData[8], sizeof(TestData) / 2) == 0;
+                             });
+    ReadbackQueue.Flush(pContext);
+    EXPECT_TRUE(DataValid);
+}
+
+TEST(CrossDeviceCopyQueueTest, CopyTexture)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 32;
+
+    std::vector<Uint32> TexData(Width * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            TexData[x + y * Width] = x | (y << 8u) | 0xFF000000u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Cross device copy test source";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    TextureSubResData SubresData{TexData.data(), Width * 4};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pSrcTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pSrcTexture);
+    ASSERT_NE(pSrcTexture, nullptr);
+
+    TexDesc.Name = "Cross device copy test destination";
+    RefCntAutoPtr<ITexture> pDstTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDstTexture);
+    ASSERT_NE(pDstTexture, nullptr);
+
+    CrossDeviceCopyQueue::CreateInfo CI;
+    CI.pSrcDevice = pDevice;
+    CrossDeviceCopyQueue CopyQueue{CI};
+
+    const Box SrcRegion{8, 24, 4, 20};
+
+    CrossDeviceCopyQueue::TextureCopyAttribs CopyAttribs;
+    CopyAttribs.pSrcTexture = pSrcTexture;
+    CopyAttribs.pSrcBox     = &SrcRegion;
+    CopyAttribs.pDstTexture = pDstTexture;
+    CopyAttribs.DstX        = 32;
+    CopyAttribs.DstY        = 2;
+    CopyQueue.CopyTexture(pContext, CopyAttribs);
+    CopyQueue.Flush(pContext, pContext);
+
+    GPUReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice = pDevice;
+    GPUReadbackQueue ReadbackQueue{ReadbackCI};
+
+    const Box DstRegion{CopyAttribs.DstX, CopyAttribs.DstX + SrcRegion.Width(), CopyAttribs.DstY, CopyAttribs.DstY + SrcRegion.Height()};
+
+    Uint32 NumErrors = 0;
+    ReadbackQueue.ReadTexture(pContext, pDstTexture, 0, 0, &DstRegion,
+                              [&](const GPUReadbackQueue::ReadbackData& Data) {
+                                  if (Data.pData == nullptr)
+                                  {
+                                      ++NumErrors;
+                                      return;
+                                  }
+                                  for (Uint32 y = SrcRegion.MinY; y < SrcRegion.MaxY; ++y)
+                                  {
+                                      const auto* pRow = static_cast<const Uint8*>(Data.pData) + Data.Stride * (y - SrcRegion.MinY);
+                                      if (memcmp(pRow, &TexData[SrcRegion.MinX + y * Width], SrcRegion.Width() * 4) != 0)
+                                          ++NumErrors;
+                                  }
+                              });
+    ReadbackQueue.Flush(pContext);
+    EXPECT_EQ(NumErrors, Uint32{0});
+}
+
+} // namespace
@@ -27,6 +27,7 @@
 
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "WinHPreface.h"
 #include <atlcomcli.h>
@@ -57,7 +58,21 @@ void TestDXBCRemapping(const char* Source, const char* Entry, const char* Profil
     }
     ASSERT_HRESULT_SUCCEEDED(hr);
 
-    ASSERT_TRUE(DXBCUtils::RemapResourceBindings(ResMap, Blob->GetBufferPointer(), Blob->GetBufferSize()));
+    const std::vector<Uint8> OriginalBytecode{
+        static_cast<const Uint8*>(Blob->GetBufferPointer()),
+        static_cast<const Uint8*>(Blob->GetBufferPointer()) + Blob->GetBufferSize()};
+
+    DXBCUtils::ResourceBindingPatchTable PatchTable;
+    ASSERT_TRUE(DXBCUtils::RemapResourceBindings(ResMap, Blob->GetBufferPointer(), Blob->GetBufferSize(), &PatchTable));
+    EXPECT_EQ(PatchTable.BytecodeSize, Blob->GetBufferSize());
+    EXPECT_FALSE(PatchTable.Patches.empty());
+
+    // Patching the original byte code with the table must produce the same result
+    {
+        auto PatchedBytecode = OriginalBytecode;
+        ASSERT_TRUE(DXBCUtils::PatchResourceBindings(PatchTable, ResMap, PatchedBytecode.data(), PatchedBytecode.size()));
+        EXPECT_EQ(memcmp(PatchedBytecode.data(), Blob->GetBufferPointer(), PatchedBytecode.size()), 0);
+    }
 
     CComPtr<ID3D12ShaderReflection> ShaderReflection;
 
@@ -25,6 +25,7 @@
  */
 
 #include "DynamicBuffer.hpp"
+#include "DrawStateBlock.hpp"
 #include "GPUTestingEnvironment.hpp"
 
 #include "gtest/gtest.h"
@@ -50,4 +51,101 @@ TEST(DeviceContextTest, DebugGroups)
     pCtx->EndDebugGroup();
 }
 
+TEST(DeviceContextTest, RedundantStateFilter)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IBuffer> pVB0, pVB1, pIB;
+    {
+        BufferDesc BuffDesc{"Redundant state filter test VB", 256, BIND_VERTEX_BUFFER, USAGE_DEFAULT};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pVB0);
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pVB1);
+        BuffDesc.Name      = "Redundant state filter test IB";
+        BuffDesc.BindFlags = BIND_INDEX_BUFFER;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pIB);
+    }
+    ASSERT_TRUE(pVB0 && pVB1 && pIB);
+
+    pCtx->InvalidateState();
+    const auto StartStats = pCtx->GetStateFilterStats();
+
+    IBuffer* pVBs[]    = {pVB0, pVB1};
+    Uint64   Offsets[] = {0, 16};
+    pCtx->SetVertexBuffers(0, 2, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pCtx->SetVertexBuffers(0, 2, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
+    EXPECT_EQ(pCtx->GetStateFilterStats().VertexBuffers, StartStats.VertexBuffers + 1);
+
+    // Different offset is not redundant
+    Offsets[1] = 32;
+    pCtx->SetVertexBuffers(0, 2, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
+    EXPECT_EQ(pCtx->GetStateFilterStats().VertexBuffers, StartStats.VertexBuffers + 1);
+
+    // Resetting the second slot changes the state
+    pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
+    EXPECT_EQ(pCtx->GetStateFilterStats().VertexBuffers, StartStats.VertexBuffers + 1);
+
+    pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    pCtx->SetIndexBuffer(pIB, 4, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    EXPECT_EQ(pCtx->GetStateFilterStats().IndexBuffers, StartStats.IndexBuffers + 1);
+
+    pCtx->SetStencilRef(7);
+    pCtx->SetStencilRef(7);
+    EXPECT_EQ(pCtx->GetStateFilterStats().StencilRefs, StartStats.StencilRefs + 1);
+
+    // Applying the same draw state block twice filters out all buffer bindings the second time
+    DrawStateBlock StateBlock;
+    StateBlock.SetVertexBuffers(2, pVBs, Offsets).SetIndexBuffer(pIB).SetStencilRef(3);
+    StateBlock.Apply(pCtx, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    const auto BlockStats = pCtx->GetStateFilterStats();
+    StateBlock.Apply(pCtx, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    EXPECT_EQ(pCtx->GetStateFilterStats().VertexBuffers, BlockStats.VertexBuffers + 1);
+    EXPECT_EQ(pCtx->GetStateFilterStats().IndexBuffers, BlockStats.IndexBuffers + 1);
+    EXPECT_EQ(pCtx->GetStateFilterStats().StencilRefs, BlockStats.StencilRefs + 1);
+
+    pCtx->InvalidateState();
+}
+
+TEST(DeviceContextTest, Statistics)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    const auto DeviceType = pDevice->GetDeviceInfo().Type;
+    if (DeviceType != RENDER_DEVICE_TYPE_D3D12 && DeviceType != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "Device context statistics are only collected by Direct3D12 and Vulkan contexts";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BufferDesc{"Statistics test buffer", 256, BIND_VERTEX_BUFFER, USAGE_DEFAULT}, nullptr, &pBuffer);
+    ASSERT_TRUE(pBuffer);
+
+    pCtx->Flush();
+    const DeviceContextStatistics StartCtxStats = pCtx->GetStatistics();
+    DeviceStatistics              StartDevStats;
+    pDevice->GetStatistics(StartDevStats);
+
+    const Uint8 Data[128] = {};
+    pCtx->UpdateBuffer(pBuffer, 0, sizeof(Data), Data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    // Copy destination -> vertex buffer transition always requires a barrier
+    StateTransitionDesc Barrier{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pCtx->TransitionResourceStates(1, &Barrier);
+    pCtx->Flush();
+
+    const DeviceContextStatistics& CtxStats = pCtx->GetStatistics();
+    EXPECT_GE(CtxStats.DynamicHeapBytes, StartCtxStats.DynamicHeapBytes + sizeof(Data));
+    EXPECT_GT(CtxStats.BarrierCount, StartCtxStats.BarrierCount);
+    EXPECT_EQ(CtxStats.CommandBufferCount, StartCtxStats.CommandBufferCount + 1);
+
+    DeviceStatistics DevStats;
+    pDevice->GetStatistics(DevStats);
+    EXPECT_GT(DevStats.CommandBufferCount, StartDevStats.CommandBufferCount);
+}
+
 } // namespace
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DeviceObjectPool.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(DeviceObjectPoolTest, RecycleBuffers)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DeviceObjectPool Pool{pDevice};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Device object pool test buffer";
+    BuffDesc.Size      = 256;
+    BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    auto pBuffer = Pool.GetBuffer(BuffDesc);
+    ASSERT_NE(pBuffer, nullptr);
+    IBuffer* const pRawBuffer = pBuffer;
+
+    Pool.Recycle(pContext, std::move(pBuffer));
+    EXPECT_EQ(Pool.GetStatistics().NumPending, 1u);
+
+    pContext->WaitForIdle();
+
+    // A buffer with a different description must not be reused
+    auto BuffDesc2 = BuffDesc;
+    BuffDesc2.Size = 512;
+    auto pBuffer2  = Pool.GetBuffer(BuffDesc2);
+    ASSERT_NE(pBuffer2, nullptr);
+    EXPECT_NE(pBuffer2.RawPtr(), pRawBuffer);
+
+    auto pBuffer3 = Pool.GetBuffer(BuffDesc);
+    EXPECT_EQ(pBuffer3.RawPtr(), pRawBuffer);
+
+    auto Stats = Pool.GetStatistics();
+    EXPECT_EQ(Stats.NumCreated, 2u);
+    EXPECT_EQ(Stats.NumReused, 1u);
+    EXPECT_EQ(Stats.NumPending, 0u);
+    EXPECT_EQ(Stats.NumAvailable, 0u);
+
+    Pool.Recycle(pContext, std::move(pBuffer2));
+    Pool.Recycle(pContext, std::move(pBuffer3));
+    pContext->WaitForIdle();
+
+    QueryDesc QryDesc{QUERY_TYPE_TIMESTAMP};
+    if (pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        auto pQuery = Pool.GetQuery(QryDesc);
+        EXPECT_NE(pQuery, nullptr);
+    }
+
+    EXPECT_EQ(Pool.GetStatistics().NumAvailable, 2u);
+    Pool.ReleaseAvailable();
+    EXPECT_EQ(Pool.GetStatistics().NumAvailable, 0u);
+}
+
+} // namespace
@@ -773,6 +773,65 @@ TEST_F(DrawCommandTest, Draw)
     Present();
 }
 
+// Checks that draw command recording, submission and resource release do not
+// allocate memory once the frame has reached a steady state.
+TEST_F(DrawCommandTest, SteadyStateFrameAllocations)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    // The tracking allocator is process-wide and is selected when the device is created,
+    // so it can't be enabled for this test only. It is off by default to not affect other tests.
+    MemoryAllocationStatistics Stats;
+    if (!pDevice->GetMemoryAllocationStatistics(Stats))
+    {
+        GTEST_SKIP() << "Memory tracking is not enabled. Run with --memory_tracking --gtest_filter=DrawCommandTest.SteadyStateFrameAllocations";
+    }
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    // clang-format on
+
+    auto     pVB    = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[] = {pVB};
+
+    auto RenderFrame = [&]() {
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {0, 0, 0, 0};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        pContext->SetPipelineState(sm_pDrawPSO);
+        pContext->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+        DrawAttribs drawAttrs{6, DRAW_FLAG_VERIFY_ALL};
+        pContext->Draw(drawAttrs);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    };
+
+    // Warm up the scratch arenas, the release queues and other pools
+    constexpr Uint32 NumWarmUpFrames = 8;
+    for (Uint32 i = 0; i < NumWarmUpFrames; ++i)
+        RenderFrame();
+
+    RenderFrame();
+
+    pDevice->GetMemoryAllocationStatistics(Stats);
+    EXPECT_EQ(Stats.Tags[MEMORY_ALLOCATION_TAG_DEVICE_CONTEXT].FrameAllocationCount, 0u);
+    EXPECT_EQ(Stats.Tags[MEMORY_ALLOCATION_TAG_RELEASE_QUEUE].FrameAllocationCount, 0u);
+
+    pContext->InvalidateState();
+}
+
 TEST_F(DrawCommandTest, Draw_StartVertex)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
@@ -921,6 +980,44 @@ TEST_F(DrawCommandTest, DrawIndexed)
     Present();
 }
 
+TEST_F(DrawCommandTest, SubmitDrawPackets)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        {}, {}, Vert[3], Vert[5], Vert[4]
+    };
+    const Uint32 Indices[] = {5,7,6};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[] = {pVB};
+
+    DrawPacket Packets[2];
+    for (auto& Packet : Packets)
+    {
+        Packet.pPipelineState   = sm_pDrawPSO;
+        Packet.NumVertexBuffers = 1;
+        Packet.ppVertexBuffers  = pVBs;
+    }
+    Packets[0].Attribs = DrawAttribs{3, DRAW_FLAG_VERIFY_ALL};
+
+    Packets[1].pIndexBuffer   = pIB;
+    Packets[1].IndexedAttribs = DrawIndexedAttribs{3, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+
+    pContext->SubmitDrawPackets(Packets, _countof(Packets), RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SUBMIT_DRAW_PACKETS_FLAG_ALLOW_REORDER);
+
+    Present();
+}
+
 TEST_F(DrawCommandTest, DrawIndexed_IBOffset)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
@@ -306,4 +306,60 @@ INSTANTIATE_TEST_SUITE_P(DynamicTextureArray,
                              testing::Values<TEXTURE_FORMAT>(TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_BC1_UNORM_SRGB)),
                          GetTestName); //
 
+
+TEST(DynamicTextureArrayTest, ChunkedResize)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicTextureArrayCreateInfo DynTexArrCI;
+    DynTexArrCI.NumSlicesInChunk = 4;
+
+    auto& Desc{DynTexArrCI.Desc};
+    Desc.Name      = "Dynamic texture array chunked resize test";
+    Desc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    Desc.BindFlags = BIND_SHADER_RESOURCE;
+    Desc.Width     = 256;
+    Desc.Height    = 256;
+    Desc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    Desc.ArraySize = 0;
+
+    DynamicTextureArray DynTexArray{pDevice, DynTexArrCI};
+    EXPECT_TRUE(DynTexArray.IsChunked());
+    EXPECT_EQ(DynTexArray.GetNumChunks(), 0u);
+
+    // Chunks are created without the context
+    auto* pFirstChunk = DynTexArray.Resize(pDevice, nullptr, 3);
+    ASSERT_NE(pFirstChunk, nullptr);
+    EXPECT_FALSE(DynTexArray.PendingUpdate());
+    EXPECT_EQ(DynTexArray.GetDesc().ArraySize, 4u);
+    EXPECT_EQ(DynTexArray.GetNumChunks(), 1u);
+    EXPECT_EQ(pFirstChunk->GetDesc().ArraySize, 4u);
+
+    DynTexArray.Resize(nullptr, nullptr, 10);
+    EXPECT_TRUE(DynTexArray.PendingUpdate());
+    EXPECT_EQ(DynTexArray.GetTexture(pDevice, nullptr), pFirstChunk);
+    EXPECT_EQ(DynTexArray.GetDesc().ArraySize, 12u);
+    ASSERT_EQ(DynTexArray.GetNumChunks(), 3u);
+    // Existing chunks are preserved
+    EXPECT_EQ(DynTexArray.GetChunkTexture(0), pFirstChunk);
+
+    const auto Location = DynTexArray.GetSliceLocation(9);
+    EXPECT_EQ(Location.Chunk, 2u);
+    EXPECT_EQ(Location.Slice, 1u);
+    EXPECT_NE(DynTexArray.GetChunkTexture(Location.Chunk), nullptr);
+
+    // Shrinking only releases the chunks
+    DynTexArray.Resize(nullptr, nullptr, 5);
+    EXPECT_FALSE(DynTexArray.PendingUpdate());
+    EXPECT_EQ(DynTexArray.GetNumChunks(), 2u);
+    EXPECT_EQ(DynTexArray.GetChunkTexture(0), pFirstChunk);
+
+    DynTexArray.Resize(nullptr, nullptr, 0);
+    EXPECT_EQ(DynTexArray.GetNumChunks(), 0u);
+    EXPECT_EQ(DynTexArray.GetTexture(nullptr, nullptr), nullptr);
+}
+
 } // namespace
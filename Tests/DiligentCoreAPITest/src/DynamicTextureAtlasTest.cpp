@@ -143,7 +143,7 @@ TEST(DynamicTextureAtlas, CreateArray)
     }
 }
 
-TEST(DynamicTextureAtlas, Allocate)
+void TestAllocate(DYNAMIC_TEXTURE_ATLAS_PACKING_MODE PackingMode)
 {
     auto* const pEnv     = GPUTestingEnvironment::GetInstance();
     auto* const pDevice  = pEnv->GetDevice();
@@ -161,6 +161,7 @@ TEST(DynamicTextureAtlas, Allocate)
     CI.Desc.Width      = 512;
     CI.Desc.Height     = 512;
     CI.Desc.ArraySize  = 1;
+    CI.PackingMode     = PackingMode;
 
     RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
     CreateDynamicTextureAtlas(pDevice, CI, &pAtlas);
@@ -233,6 +234,17 @@ TEST(DynamicTextureAtlas, Allocate)
 }
 
 
+TEST(DynamicTextureAtlas, Allocate)
+{
+    TestAllocate(DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SPLIT);
+}
+
+TEST(DynamicTextureAtlas, AllocateShelf)
+{
+    TestAllocate(DYNAMIC_TEXTURE_ATLAS_PACKING_MODE_SHELF);
+}
+
+
 // Allocate more regions than the atlas can hold
 TEST(DynamicTextureAtlas, Overflow)
 {
@@ -24,6 +24,10 @@
  *  of the possibility of such damages.
  */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "BasicMath.hpp"
@@ -325,4 +329,59 @@ TEST_F(FenceTest, ContextWaitForAnotherContext)
     pSwapChain->Present();
 }
 
+TEST_F(FenceTest, CompletionCallbacks)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    FenceDesc FenceCI;
+    FenceCI.Name = "Fence completion callback test";
+    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+
+    RefCntAutoPtr<IFence> pFence;
+    pDevice->CreateFence(FenceCI, &pFence);
+    ASSERT_NE(pFence, nullptr);
+
+    struct CallbackData
+    {
+        std::atomic<Uint32> NumCalls{0};
+        std::atomic<Uint64> MaxCompletedValue{0};
+    };
+    CallbackData Data;
+
+    auto Callback = [](Uint64 CompletedValue, void* pUserData) {
+        auto& Data = *static_cast<CallbackData*>(pUserData);
+        Uint64 MaxValue = Data.MaxCompletedValue.load();
+        while (!Data.MaxCompletedValue.compare_exchange_weak(MaxValue, std::max(MaxValue, CompletedValue)))
+        {
+        }
+        // Must be the last access as the test may finish once the counter is incremented
+        Data.NumCalls.fetch_add(1);
+    };
+    pFence->EnqueueCompletionCallback(1, Callback, &Data);
+    pFence->EnqueueCompletionCallback(2, Callback, &Data);
+    // Never reached: discarded when the fence is released
+    pFence->EnqueueCompletionCallback(3, Callback, &Data);
+
+    pContext->EnqueueSignal(pFence, 2);
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    // In Direct3D11 and OpenGL backends, callbacks are invoked by FinishFrame()
+    const auto StartTime = std::chrono::steady_clock::now();
+    while (Data.NumCalls.load() < 2 && std::chrono::steady_clock::now() - StartTime < std::chrono::seconds{10})
+    {
+        pContext->FinishFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_EQ(Data.NumCalls.load(), 2u);
+    EXPECT_GE(Data.MaxCompletedValue.load(), Uint64{2});
+
+    pFence.Release();
+    EXPECT_EQ(Data.NumCalls.load(), 2u);
+}
+
 } // namespace
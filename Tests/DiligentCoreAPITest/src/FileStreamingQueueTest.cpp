@@ -0,0 +1,239 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "FileStreamingQueue.hpp"
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "TempDirectory.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::string WriteTestFile(const std::string& DirPath, const std::vector<Uint32>& Data)
+{
+    const auto FilePath = DirPath + FileSystem::SlashSymbol + "FileStreamingQueueTest.bin";
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (File)
+        File->Write(Data.data(), Data.size() * sizeof(Data[0]));
+
+    return FilePath;
+}
+
+std::vector<Uint32> ReadBackBuffer(IBuffer* pBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUReadbackQueue::CreateInfo CI;
+    CI.pDevice = pDevice;
+    GPUReadbackQueue ReadbackQueue{CI};
+
+    std::vector<Uint32> Data;
+    ReadbackQueue.ReadBuffer(pContext, pBuffer, 0, pBuffer->GetDesc().Size,
+                             [&Data](const GPUReadbackQueue::ReadbackData& RBData) {
+                                 if (RBData.pData != nullptr)
+                                 {
+                                     Data.resize(static_cast<size_t>(RBData.DataSize / sizeof(Uint32)));
+                                     memcpy(Data.data(), RBData.pData, Data.size() * sizeof(Uint32));
+                                 }
+                             });
+    ReadbackQueue.Flush(pContext);
+    return Data;
+}
+
+void TestStreamBuffer(IThreadPool* pThreadPool, Uint64 StagingBufferSize, bool Compressed)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumChunks    = 8;
+    constexpr Uint32 ChunkSize    = 1024;
+    constexpr Uint32 NumChunkElem = ChunkSize / sizeof(Uint32);
+
+    std::vector<Uint32> RefData(NumChunks * NumChunkElem);
+    for (size_t i = 0; i < RefData.size(); ++i)
+        RefData[i] = static_cast<Uint32>(i * 17 + 3);
+
+    // The test "compression" reverses the order of the elements in every chunk
+    std::vector<Uint32> FileData = RefData;
+    if (Compressed)
+    {
+        for (Uint32 chunk = 0; chunk < NumChunks; ++chunk)
+            std::reverse(FileData.begin() + chunk * NumChunkElem, FileData.begin() + (chunk + 1) * NumChunkElem);
+    }
+
+    TempDirectory TmpDir;
+    const auto    FilePath = WriteTestFile(TmpDir.Get(), FileData);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "File streaming queue test buffer";
+    BuffDesc.Size      = RefData.size() * sizeof(Uint32);
+    BuffDesc.BindFlags = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode      = BUFFER_MODE_RAW;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    FileStreamingQueueCreateInfo CI;
+    CI.pDevice           = pDevice;
+    CI.pThreadPool       = pThreadPool;
+    CI.StagingBufferSize = StagingBufferSize;
+    CI.UseDirectStorage  = false;
+    CI.DecompressGDeflate = [](const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize) {
+        if (SrcSize != DstSize)
+            return false;
+        const auto* pSrcElems = static_cast<const Uint32*>(pSrc);
+        std::reverse_copy(pSrcElems, pSrcElems + SrcSize / sizeof(Uint32), static_cast<Uint32*>(pDst));
+        return true;
+    };
+    auto pQueue = CreateFileStreamingQueue(CI);
+    ASSERT_NE(pQueue, nullptr);
+    EXPECT_FALSE(pQueue->IsDirectStorageUsed());
+
+    std::atomic<Uint32> NumCompleted{0};
+    std::atomic<Uint32> NumFailed{0};
+    for (Uint32 chunk = 0; chunk < NumChunks; ++chunk)
+    {
+        FileStreamingRequest Req;
+        Req.FilePath         = FilePath.c_str();
+        Req.FileOffset       = chunk * ChunkSize;
+        Req.Size             = ChunkSize;
+        Req.UncompressedSize = ChunkSize;
+        Req.Compression      = Compressed ? FILE_STREAMING_COMPRESSION_GDEFLATE : FILE_STREAMING_COMPRESSION_NONE;
+        Req.pDstBuffer       = pBuffer;
+        Req.DstOffset        = chunk * ChunkSize;
+        Req.OnCompleted      = [&](bool Success) {
+            NumCompleted.fetch_add(1);
+            if (!Success)
+                NumFailed.fetch_add(1);
+        };
+        pQueue->Enqueue(Req);
+
+        if (chunk % 2 == 1)
+            pQueue->Update(pContext);
+    }
+
+    pQueue->Flush(pContext);
+    EXPECT_EQ(pQueue->GetNumPendingRequests(), size_t{0});
+    EXPECT_EQ(NumCompleted.load(), NumChunks);
+    EXPECT_EQ(NumFailed.load(), Uint32{0});
+
+    EXPECT_EQ(ReadBackBuffer(pBuffer), RefData);
+}
+
+TEST(FileStreamingQueueTest, StreamBuffer)
+{
+    TestStreamBuffer(nullptr, 1 << 20, false);
+}
+
+TEST(FileStreamingQueueTest, StreamBufferAsync)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestStreamBuffer(pThreadPool, 1 << 20, false);
+}
+
+TEST(FileStreamingQueueTest, StreamCompressedBuffer)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestStreamBuffer(pThreadPool, 1 << 20, true);
+}
+
+TEST(FileStreamingQueueTest, StreamBufferNoStaging)
+{
+    // Only two chunks fit into the staging buffer, the rest is uploaded from the CPU memory
+    TestStreamBuffer(nullptr, 2048, false);
+}
+
+TEST(FileStreamingQueueTest, MissingFile)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "File streaming queue test buffer";
+    BuffDesc.Size      = 256;
+    BuffDesc.BindFlags = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode      = BUFFER_MODE_RAW;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    FileStreamingQueueCreateInfo CI;
+    CI.pDevice = pDevice;
+    auto pQueue = CreateFileStreamingQueue(CI);
+    ASSERT_NE(pQueue, nullptr);
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "NonExistentFile.bin";
+
+    pEnv->SetErrorAllowance(2, "Errors below are expected: the file does not exist\n");
+
+    bool Completed = false;
+    bool Succeeded = true;
+
+    FileStreamingRequest Req;
+    Req.FilePath         = FilePath.c_str();
+    Req.Size             = 256;
+    Req.UncompressedSize = 256;
+    Req.pDstBuffer       = pBuffer;
+    Req.OnCompleted      = [&](bool Success) {
+        Completed = true;
+        Succeeded = Success;
+    };
+    pQueue->Enqueue(Req);
+    pQueue->Flush(pContext);
+
+    EXPECT_TRUE(Completed);
+    EXPECT_FALSE(Succeeded);
+}
+
+} // namespace
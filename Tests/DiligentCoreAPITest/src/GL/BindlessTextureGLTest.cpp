@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "TextureViewGL.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(BindlessTextureGLTest, GetBindlessHandle)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Bindless handles are only exposed by the OpenGL backend";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pTex = pEnv->CreateTexture("Bindless texture test", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pTex, nullptr);
+
+    RefCntAutoPtr<ITextureViewGL> pSRVGL{pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), IID_TextureViewGL};
+    ASSERT_NE(pSRVGL, nullptr);
+
+    const auto Handle = pSRVGL->GetBindlessHandle();
+    if (Handle == 0)
+    {
+        GTEST_SKIP() << "GL_ARB_bindless_texture is not supported by this device";
+    }
+    // The handle must be created once and stay the same for the lifetime of the view
+    EXPECT_EQ(pSRVGL->GetBindlessHandle(), Handle);
+
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamplerDesc{}, &pSampler);
+    ASSERT_NE(pSampler, nullptr);
+
+    TextureViewDesc ViewDesc{"Bindless texture test - sampled view", TEXTURE_VIEW_SHADER_RESOURCE, RESOURCE_DIM_TEX_2D};
+    RefCntAutoPtr<ITextureView> pSampledView;
+    pTex->CreateView(ViewDesc, &pSampledView);
+    ASSERT_NE(pSampledView, nullptr);
+    pSampledView->SetSampler(pSampler);
+
+    RefCntAutoPtr<ITextureViewGL> pSampledViewGL{pSampledView, IID_TextureViewGL};
+    ASSERT_NE(pSampledViewGL, nullptr);
+    const auto SampledHandle = pSampledViewGL->GetBindlessHandle();
+    EXPECT_NE(SampledHandle, Uint64{0});
+    EXPECT_NE(SampledHandle, Handle);
+}
+
+} // namespace
@@ -0,0 +1,308 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <vector>
+
+#include "GPUInstanceCuller.hpp"
+#include "HiZPyramid.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+template <typename T>
+RefCntAutoPtr<IBuffer> CreateStructuredBuffer(IRenderDevice* pDevice, const std::vector<T>& Data)
+{
+    BufferDesc Desc;
+    Desc.Name              = "GPU instance culler test buffer";
+    Desc.Size              = sizeof(T) * Data.size();
+    Desc.BindFlags         = BIND_SHADER_RESOURCE;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = sizeof(T);
+
+    BufferData InitData{Data.data(), Desc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+    return pBuffer;
+}
+
+std::vector<Uint32> ReadBuffer(IBuffer* pBuffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    BufferDesc Desc;
+    Desc.Name           = "GPU instance culler staging buffer";
+    Desc.Size           = pBuffer->GetDesc().Size;
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStaging;
+    pDevice->CreateBuffer(Desc, nullptr, &pStaging);
+    if (!pStaging)
+        return {};
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStaging, 0, Desc.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    std::vector<Uint32> Data(static_cast<size_t>(Desc.Size / sizeof(Uint32)));
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStaging, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData == nullptr)
+        return {};
+    memcpy(Data.data(), pData, Data.size() * sizeof(Uint32));
+    pContext->UnmapBuffer(pStaging, MAP_READ);
+    return Data;
+}
+
+bool IsGPUCullingSupported(IRenderDevice* pDevice)
+{
+    const auto DrawCapFlags = pDevice->GetAdapterInfo().DrawCommand.CapFlags;
+    return (DrawCapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT) != 0 &&
+        (DrawCapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE) != 0 &&
+        pDevice->GetDeviceInfo().Features.ComputeShaders;
+}
+
+void SetUnitCubeFrustum(GPUInstanceCuller::CullAttribs& Attribs)
+{
+    Attribs.FrustumPlanes[0] = float4{+1, 0, 0, 1};
+    Attribs.FrustumPlanes[1] = float4{-1, 0, 0, 1};
+    Attribs.FrustumPlanes[2] = float4{0, +1, 0, 1};
+    Attribs.FrustumPlanes[3] = float4{0, -1, 0, 1};
+    Attribs.FrustumPlanes[4] = float4{0, 0, +1, 1};
+    Attribs.FrustumPlanes[5] = float4{0, 0, -1, 1};
+}
+
+TEST(GPUInstanceCullerTest, FrustumCulling)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!IsGPUCullingSupported(pDevice))
+    {
+        GTEST_SKIP() << "Indirect draw with first instance or compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    constexpr Uint32 NumDrawGroups = 4;
+
+    // Group 2 has no visible instances
+    std::vector<GPUInstanceCuller::InstanceData> Instances;
+    auto AddInstance = [&](float x, Uint32 Group) {
+        GPUInstanceCuller::InstanceData Inst;
+        Inst.BoundingSphere = float4{x, 0, 0, 0.5f};
+        Inst.DrawGroup      = Group;
+        Instances.push_back(Inst);
+    };
+    AddInstance(0.0f, 1);
+    AddInstance(5.0f, 0);
+    AddInstance(0.5f, 0);
+    AddInstance(1.2f, 3); // Intersects the frustum
+    AddInstance(-3.f, 2);
+    AddInstance(-0.5f, 1);
+    AddInstance(0.25f, 3);
+    AddInstance(0.0f, 7); // Out-of-range group
+
+    std::vector<GPUInstanceCuller::DrawGroupData> DrawGroups(NumDrawGroups);
+    for (Uint32 i = 0; i < NumDrawGroups; ++i)
+    {
+        DrawGroups[i].NumIndices         = 3 * (i + 1);
+        DrawGroups[i].FirstIndexLocation = 100 * i;
+        DrawGroups[i].BaseVertex         = 10 * i;
+    }
+
+    auto pInstances  = CreateStructuredBuffer(pDevice, Instances);
+    auto pDrawGroups = CreateStructuredBuffer(pDevice, DrawGroups);
+    ASSERT_TRUE(pInstances && pDrawGroups);
+
+    GPUInstanceCuller::CreateInfo CI;
+    CI.pDevice       = pDevice;
+    CI.MaxInstances  = 16;
+    CI.MaxDrawGroups = 8;
+    GPUInstanceCuller Culler{CI};
+
+    GPUInstanceCuller::CullAttribs Attribs;
+    Attribs.pInstances    = pInstances;
+    Attribs.NumInstances  = static_cast<Uint32>(Instances.size());
+    Attribs.pDrawGroups   = pDrawGroups;
+    Attribs.NumDrawGroups = NumDrawGroups;
+    SetUnitCubeFrustum(Attribs);
+    Culler.Cull(pContext, Attribs);
+
+    const auto DrawCount        = ReadBuffer(Culler.GetDrawCountBuffer());
+    const auto DrawArgs         = ReadBuffer(Culler.GetDrawArgsBuffer());
+    const auto VisibleInstances = ReadBuffer(Culler.GetVisibleInstancesBuffer());
+    ASSERT_FALSE(DrawCount.empty() || DrawArgs.empty() || VisibleInstances.empty());
+
+    // Expected visible instances of groups 0, 1 and 3
+    const std::vector<std::vector<Uint32>> RefGroups = {{2}, {0, 5}, {3, 6}};
+    const Uint32                           RefGroupIds[] = {0, 1, 3};
+
+    EXPECT_EQ(DrawCount[0], 3u);
+    Uint32 FirstInstance = 0;
+    for (Uint32 Draw = 0; Draw < RefGroups.size(); ++Draw)
+    {
+        const auto  Group = RefGroupIds[Draw];
+        const auto* Args  = &DrawArgs[Draw * 5];
+        EXPECT_EQ(Args[0], DrawGroups[Group].NumIndices);
+        EXPECT_EQ(Args[1], RefGroups[Draw].size());
+        EXPECT_EQ(Args[2], DrawGroups[Group].FirstIndexLocation);
+        EXPECT_EQ(Args[3], DrawGroups[Group].BaseVertex);
+        EXPECT_EQ(Args[4], FirstInstance);
+
+        std::vector<Uint32> Visible{VisibleInstances.begin() + Args[4], VisibleInstances.begin() + Args[4] + Args[1]};
+        std::sort(Visible.begin(), Visible.end());
+        EXPECT_EQ(Visible, RefGroups[Draw]) << "Draw group " << Group;
+
+        FirstInstance += Args[1];
+    }
+
+    // The remaining commands must draw nothing
+    EXPECT_EQ(DrawArgs[3 * 5 + 1], 0u);
+}
+
+TEST(GPUInstanceCullerTest, TwoPhaseOcclusionCulling)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!IsGPUCullingSupported(pDevice))
+    {
+        GTEST_SKIP() << "Indirect draw with first instance or compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    // The view-projection matrix is identity, so the depth buffer is an occluder at NDC z = 0.5
+    const auto& NDC           = pDevice->GetDeviceInfo().GetNDCAttribs();
+    const float OccluderDepth = 0.5f * NDC.ZtoDepthScale + NDC.GetZtoDepthBias();
+
+    TextureDesc DepthDesc;
+    DepthDesc.Name      = "Hi-Z test depth buffer";
+    DepthDesc.Type      = RESOURCE_DIM_TEX_2D;
+    DepthDesc.Width     = 67;
+    DepthDesc.Height    = 33;
+    DepthDesc.Format    = TEX_FORMAT_D32_FLOAT;
+    DepthDesc.BindFlags = BIND_DEPTH_STENCIL | BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pDepth;
+    pDevice->CreateTexture(DepthDesc, nullptr, &pDepth);
+    ASSERT_NE(pDepth, nullptr);
+
+    auto* pDSV = pDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+    pContext->SetRenderTargets(0, nullptr, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, OccluderDepth, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    std::vector<GPUInstanceCuller::InstanceData> Instances(4);
+    Instances[0].BoundingSphere = float4{0.0f, 0.0f, 0.1f, 0.05f}; // In front of the occluder
+    Instances[1].BoundingSphere = float4{0.5f, 0.5f, 0.9f, 0.05f}; // Behind the occluder
+    Instances[2].BoundingSphere = float4{-0.5f, 0.3f, 0.2f, 0.05f};
+    Instances[2].DrawGroup      = 1;
+    Instances[3].BoundingSphere = float4{5.0f, 0.0f, 0.1f, 0.05f}; // Outside of the frustum
+    Instances[3].DrawGroup      = 1;
+
+    std::vector<GPUInstanceCuller::DrawGroupData> DrawGroups(2);
+    DrawGroups[0].NumIndices = 3;
+    DrawGroups[1].NumIndices = 6;
+
+    auto pInstances  = CreateStructuredBuffer(pDevice, Instances);
+    auto pDrawGroups = CreateStructuredBuffer(pDevice, DrawGroups);
+    ASSERT_TRUE(pInstances && pDrawGroups);
+
+    HiZPyramid::CreateInfo HiZCI;
+    HiZCI.pDevice = pDevice;
+    HiZPyramid HiZ{HiZCI};
+
+    GPUInstanceCuller::CreateInfo CI;
+    CI.pDevice       = pDevice;
+    CI.MaxInstances  = 4;
+    CI.MaxDrawGroups = 2;
+    GPUInstanceCuller Culler{CI};
+
+    GPUInstanceCuller::CullAttribs Attribs;
+    Attribs.pInstances    = pInstances;
+    Attribs.NumInstances  = static_cast<Uint32>(Instances.size());
+    Attribs.pDrawGroups   = pDrawGroups;
+    Attribs.NumDrawGroups = static_cast<Uint32>(DrawGroups.size());
+    Attribs.pHiZPyramid   = &HiZ;
+    Attribs.ViewProj      = float4x4::Identity();
+    SetUnitCubeFrustum(Attribs);
+
+    // Returns the sorted indices of the instances drawn by the culler
+    auto GetDrawnInstances = [&]() {
+        const auto DrawCount        = ReadBuffer(Culler.GetDrawCountBuffer());
+        const auto DrawArgs         = ReadBuffer(Culler.GetDrawArgsBuffer());
+        const auto VisibleInstances = ReadBuffer(Culler.GetVisibleInstancesBuffer());
+
+        std::vector<Uint32> Drawn;
+        if (DrawCount.empty() || DrawArgs.empty() || VisibleInstances.empty())
+        {
+            ADD_FAILURE() << "Failed to read the culler buffers";
+            return Drawn;
+        }
+        for (Uint32 Draw = 0; Draw < DrawCount[0]; ++Draw)
+        {
+            const auto* Args = &DrawArgs[Draw * 5];
+            Drawn.insert(Drawn.end(), VisibleInstances.begin() + Args[4], VisibleInstances.begin() + Args[4] + Args[1]);
+        }
+        std::sort(Drawn.begin(), Drawn.end());
+        return Drawn;
+    };
+
+    for (Uint32 Frame = 0; Frame < 2; ++Frame)
+    {
+        // No instances were visible before the first frame, so all of them are drawn in the second phase
+        Attribs.Mode = GPUInstanceCuller::CULL_MODE_OCCLUSION_FIRST_PHASE;
+        Culler.Cull(pContext, Attribs);
+        EXPECT_EQ(GetDrawnInstances(), (Frame == 0 ? std::vector<Uint32>{} : std::vector<Uint32>{0, 2})) << "Frame " << Frame;
+
+        HiZ.Build(pContext, pDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        EXPECT_EQ(HiZ.GetWidth(), DepthDesc.Width);
+        EXPECT_EQ(HiZ.GetHeight(), DepthDesc.Height);
+        EXPECT_EQ(HiZ.GetNumMipLevels(), 7u);
+
+        Attribs.Mode = GPUInstanceCuller::CULL_MODE_OCCLUSION_SECOND_PHASE;
+        Culler.Cull(pContext, Attribs);
+        EXPECT_EQ(GetDrawnInstances(), (Frame == 0 ? std::vector<Uint32>{0, 2} : std::vector<Uint32>{})) << "Frame " << Frame;
+    }
+}
+
+} // namespace
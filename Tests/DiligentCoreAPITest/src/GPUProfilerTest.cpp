@@ -0,0 +1,239 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUProfiler.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GPUProfilerTest, NestedScopes)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfiler::CreateInfo CI;
+    CI.pDevice           = pDevice;
+    CI.MaxScopesPerFrame = 3;
+    CI.FrameLatency      = 2;
+    GPUProfiler Profiler{CI};
+
+    auto RecordFrame = [&]() {
+        Profiler.BeginFrame(pContext);
+        Profiler.BeginScope(pContext, "Scope 0");
+        {
+            Profiler.BeginScope(pContext, "Scope 0.0");
+            Profiler.EndScope(pContext);
+            Profiler.BeginScope(pContext, "Scope 0.1");
+            {
+                // Exceeds the scope limit and is not measured
+                Profiler.BeginScope(pContext, "Scope 0.1.0");
+                Profiler.EndScope(pContext);
+            }
+            Profiler.EndScope(pContext);
+        }
+        Profiler.EndScope(pContext);
+        Profiler.EndFrame(pContext);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    };
+
+    for (Uint32 frame = 0; frame < 8; ++frame)
+        RecordFrame();
+
+    // Queries may not become available immediately after idling the context in OpenGL
+    for (Uint32 attempt = 0; attempt < 100 && Profiler.GetResultsFrameIndex() == ~Uint64{0}; ++attempt)
+    {
+        pContext->WaitForIdle();
+        RecordFrame();
+    }
+    ASSERT_NE(Profiler.GetResultsFrameIndex(), ~Uint64{0}) << "Profiler results must be available after idling the context";
+
+    const auto& Timings = Profiler.GetScopeTimings();
+    ASSERT_EQ(Timings.size(), size_t{3});
+
+    EXPECT_EQ(Timings[0].Name, "Scope 0");
+    EXPECT_EQ(Timings[0].Depth, 0u);
+    EXPECT_EQ(Timings[0].ParentIndex, GPUProfiler::InvalidIndex);
+
+    EXPECT_EQ(Timings[1].Name, "Scope 0.0");
+    EXPECT_EQ(Timings[1].Depth, 1u);
+    EXPECT_EQ(Timings[1].ParentIndex, 0u);
+
+    EXPECT_EQ(Timings[2].Name, "Scope 0.1");
+    EXPECT_EQ(Timings[2].Depth, 1u);
+    EXPECT_EQ(Timings[2].ParentIndex, 0u);
+
+    for (const auto& Timing : Timings)
+    {
+        EXPECT_GE(Timing.StartTime, 0.0);
+        EXPECT_GE(Timing.Duration, 0.0);
+        EXPECT_LE(Timing.StartTime + Timing.Duration, Profiler.GetFrameDuration() + 1e-6);
+        EXPECT_GE(Timing.CPUStartTime, 0.0);
+        EXPECT_GE(Timing.CPUDuration, 0.0);
+        EXPECT_LE(Timing.CPUStartTime + Timing.CPUDuration, Profiler.GetCPUFrameDuration() + 1e-6);
+    }
+}
+
+TEST(GPUProfilerTest, StatisticsAndTrace)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfiler::CreateInfo CI;
+    CI.pDevice          = pDevice;
+    CI.FrameLatency     = 2;
+    CI.StatisticsWindow = 4;
+    CI.TraceHistorySize = 2;
+    GPUProfiler Profiler{CI};
+
+    auto RecordFrame = [&]() {
+        Profiler.BeginFrame(pContext);
+        {
+            GPUProfilerScope Scope{Profiler, pContext, "Outer"};
+            for (int i = 0; i < 2; ++i)
+            {
+                // Repeated scopes are accumulated in the statistics
+                GPUProfilerScope InnerScope{Profiler, pContext, "Inner \"quoted\""};
+            }
+        }
+        Profiler.EndFrame(pContext);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    };
+
+    for (Uint32 frame = 0; frame < 8; ++frame)
+        RecordFrame();
+
+    for (Uint32 attempt = 0; attempt < 100 && Profiler.GetResultsFrameIndex() == ~Uint64{0}; ++attempt)
+    {
+        pContext->WaitForIdle();
+        RecordFrame();
+    }
+    ASSERT_NE(Profiler.GetResultsFrameIndex(), ~Uint64{0}) << "Profiler results must be available after idling the context";
+
+    const auto Stats = Profiler.GetScopeStatistics();
+    ASSERT_EQ(Stats.size(), size_t{2});
+
+    EXPECT_EQ(Stats[0].Path, "Outer");
+    EXPECT_EQ(Stats[0].Depth, 0u);
+    EXPECT_EQ(Stats[1].Path, "Outer/Inner \"quoted\"");
+    EXPECT_EQ(Stats[1].Depth, 1u);
+    for (const auto& Stat : Stats)
+    {
+        EXPECT_GE(Stat.NumSamples, 1u);
+        EXPECT_LE(Stat.NumSamples, CI.StatisticsWindow);
+        EXPECT_LE(Stat.MinDuration, Stat.AvgDuration + 1e-6);
+        EXPECT_LE(Stat.AvgDuration, Stat.MaxDuration + 1e-6);
+        EXPECT_LE(Stat.MinCPUDuration, Stat.AvgCPUDuration + 1e-6);
+        EXPECT_LE(Stat.AvgCPUDuration, Stat.MaxCPUDuration + 1e-6);
+    }
+
+    const auto Trace = Profiler.ExportChromeTrace();
+    EXPECT_EQ(Trace.front(), '{');
+    EXPECT_NE(Trace.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"Outer\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"Inner \\\"quoted\\\"\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"ph\":\"X\""), std::string::npos);
+}
+
+TEST(GPUProfilerTest, CalibratedTimeline)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    TimestampCalibration Calibration;
+    if (!pContext->GetTimestampCalibration(Calibration))
+    {
+        GTEST_SKIP() << "Timestamp calibration is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfiler::CreateInfo CI;
+    CI.pDevice      = pDevice;
+    CI.FrameLatency = 2;
+    GPUProfiler Profiler{CI};
+
+    auto RecordFrame = [&]() {
+        Profiler.BeginFrame(pContext);
+        {
+            GPUProfilerScope Scope{Profiler, pContext, "Frame scope"};
+        }
+        Profiler.EndFrame(pContext);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    };
+
+    for (Uint32 frame = 0; frame < 8; ++frame)
+        RecordFrame();
+
+    for (Uint32 attempt = 0; attempt < 100 && Profiler.GetResultsFrameIndex() == ~Uint64{0}; ++attempt)
+    {
+        pContext->WaitForIdle();
+        RecordFrame();
+    }
+    ASSERT_NE(Profiler.GetResultsFrameIndex(), ~Uint64{0}) << "Profiler results must be available after idling the context";
+
+    EXPECT_TRUE(Profiler.IsTimelineCalibrated());
+    // The GPU can't start the frame long before the CPU begins recording it
+    EXPECT_GE(Profiler.GetGPUStartLatency(), 0.0);
+    EXPECT_LT(Profiler.GetGPUStartLatency(), 10.0);
+    EXPECT_GE(Profiler.GetGPUIdleTime(), 0.0);
+}
+
+} // namespace
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <atomic>
+#include <cstring>
+
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void TestReadBackBuffers(IThreadPool* pThreadPool)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 NumTestBuffs = 3;
+    constexpr float  TestData[NumTestBuffs][16] =
+        {
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+            {4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3},
+            {9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8} //
+        };
+    constexpr auto BuffSize = sizeof(TestData[0]);
+
+    RefCntAutoPtr<IBuffer> pBuffer[NumTestBuffs];
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "GPU Readback Queue Test";
+        BuffDesc.Size      = BuffSize;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        BuffDesc.Usage     = USAGE_DEFAULT;
+
+        for (Uint32 buff = 0; buff < NumTestBuffs; ++buff)
+        {
+            BufferData InitData{TestData[buff], BuffSize};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer[buff]);
+            ASSERT_NE(pBuffer[buff], nullptr);
+        }
+    }
+
+    GPUReadbackQueue::CreateInfo CI;
+    CI.pDevice     = pDevice;
+    CI.pThreadPool = pThreadPool;
+    GPUReadbackQueue ReadbackQueue{CI};
+
+    constexpr Uint32 NumFrames = 4;
+
+    std::atomic<Uint32> NumCallbacks{0};
+    std::atomic<Uint32> NumErrors{0};
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        for (Uint32 buff = 0; buff < NumTestBuffs; ++buff)
+        {
+            // Read back the second half of the buffer
+            const auto* pRefData = &TestData[(buff + frame) % NumTestBuffs][8];
+            ReadbackQueue.ReadBuffer(pContext, pBuffer[(buff + frame) % NumTestBuffs], BuffSize / 2, BuffSize / 2,
+                                     [&, pRefData](const GPUReadbackQueue::ReadbackData& Data) {
+                                         if (Data.pData == nullptr || Data.DataSize != BuffSize / 2 || memcmp(Data.pData, pRefData, BuffSize / 2) != 0)
+                                             NumErrors.fetch_add(1);
+                                         NumCallbacks.fetch_add(1);
+                                     });
+        }
+        pContext->Flush();
+        ReadbackQueue.Process(pContext);
+    }
+
+    ReadbackQueue.Flush(pContext);
+    EXPECT_EQ(ReadbackQueue.GetNumPendingReadbacks(), size_t{0});
+    EXPECT_EQ(NumCallbacks.load(), NumFrames * NumTestBuffs);
+    EXPECT_EQ(NumErrors.load(), Uint32{0});
+}
+
+TEST(GPUReadbackQueueTest, ReadBackBuffers)
+{
+    TestReadBackBuffers(nullptr);
+}
+
+TEST(GPUReadbackQueueTest, ReadBackBuffersAsync)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestReadBackBuffers(pThreadPool);
+}
+
+TEST(GPUReadbackQueueTest, ReadBackTexture)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 32;
+
+    std::vector<Uint32> TexData(Width * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            TexData[x + y * Width] = x | (y << 8u) | 0xFF000000u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU Readback Queue Test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    TextureSubResData SubresData{TexData.data(), Width * 4};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    GPUReadbackQueue::CreateInfo CI;
+    CI.pDevice     = pDevice;
+    CI.pThreadPool = pThreadPool;
+    GPUReadbackQueue ReadbackQueue{CI};
+
+    const Box Region{8, 24, 4, 20};
+
+    std::atomic<Uint32> NumCallbacks{0};
+    std::atomic<Uint32> NumErrors{0};
+
+    const auto Callback = [&](const GPUReadbackQueue::ReadbackData& Data) {
+        if (Data.pData != nullptr)
+        {
+            for (Uint32 y = Region.MinY; y < Region.MaxY; ++y)
+            {
+                const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(Data.pData) + Data.Stride * (y - Region.MinY));
+                if (memcmp(pRow, &TexData[Region.MinX + y * Width], Region.Width() * 4) != 0)
+                    NumErrors.fetch_add(1);
+            }
+        }
+        else
+        {
+            NumErrors.fetch_add(1);
+        }
+        NumCallbacks.fetch_add(1);
+    };
+
+    ReadbackQueue.ReadTexture(pContext, pTexture, 0, 0, &Region, Callback);
+    ReadbackQueue.ReadTexture(pContext, pTexture, 0, 0, &Region, Callback);
+    ReadbackQueue.Flush(pContext);
+
+    EXPECT_EQ(NumCallbacks.load(), Uint32{2});
+    EXPECT_EQ(NumErrors.load(), Uint32{0});
+}
+
+} // namespace
@@ -25,6 +25,10 @@
  *  of the possibility of such damages.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "GPUTestingEnvironment.hpp"
 
 #include "gtest/gtest.h"
@@ -130,4 +134,108 @@ TEST(GenerateMipsTest, GenerateMips)
     }
 }
 
+// Generates a long mip chain for a texture array with more slices than a single
+// dispatch of the single-pass downsampler processes, and checks the coarsest levels.
+TEST(GenerateMipsTest, ConstantColor)
+{
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Mips generation constant color test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Format    = TEX_FORMAT_RGBA32_FLOAT;
+    TexDesc.Width     = 512;
+    TexDesc.Height    = 256;
+    TexDesc.ArraySize = 8;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.MipLevels = 10;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+
+    constexpr float Color[] = {0.25f, 0.5f, 0.75f, 1.0f};
+
+    std::vector<float> ColorData(size_t{TexDesc.Width} * size_t{TexDesc.Height} * 4);
+    for (size_t i = 0; i < ColorData.size(); ++i)
+        ColorData[i] = Color[i % 4];
+    std::vector<float> ZeroData(ColorData.size());
+
+    std::vector<TextureSubResData> SubresData(TexDesc.MipLevels * TexDesc.ArraySize);
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+        {
+            auto& MipLevelData  = SubresData[slice * TexDesc.MipLevels + mip];
+            MipLevelData.pData  = mip == 0 ? ColorData.data() : ZeroData.data();
+            MipLevelData.Stride = std::max(TexDesc.Width >> mip, 1u) * 16;
+        }
+    }
+    TextureData InitData{SubresData.data(), static_cast<Uint32>(SubresData.size())};
+
+    RefCntAutoPtr<ITexture> pTex;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTex);
+    ASSERT_NE(pTex, nullptr) << "Failed to create texture: " << TexDesc;
+
+    pContext->GenerateMips(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+    TexDesc.Name           = "Mips generation constant color staging texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.BindFlags      = BIND_NONE;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    TexDesc.MiscFlags      = MISC_TEXTURE_FLAG_NONE;
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr) << "Failed to create staging texture: " << TexDesc;
+
+    // Mip 6 is the last level generated by every thread group of the single-pass downsampler,
+    // the levels below are generated by the last group only.
+    const Uint32 TestMips[] = {1, 6, TexDesc.MipLevels - 1};
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (auto mip : TestMips)
+        {
+            CopyTextureAttribs CopyAttribs{pTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcSlice    = slice;
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.DstSlice    = slice;
+            CopyAttribs.DstMipLevel = mip;
+            pContext->CopyTexture(CopyAttribs);
+        }
+    }
+    pContext->WaitForIdle();
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (auto mip : TestMips)
+        {
+            MappedTextureSubresource MappedSubres;
+            pContext->MapTextureSubresource(pStagingTex, mip, slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedSubres);
+            ASSERT_NE(MappedSubres.pData, nullptr);
+
+            const auto MipWidth  = std::max(TexDesc.Width >> mip, 1u);
+            const auto MipHeight = std::max(TexDesc.Height >> mip, 1u);
+
+            bool DataOK = true;
+            for (Uint32 row = 0; row < MipHeight && DataOK; ++row)
+            {
+                const auto* pRow = reinterpret_cast<const float*>(reinterpret_cast<const Uint8*>(MappedSubres.pData) + row * MappedSubres.Stride);
+                for (Uint32 i = 0; i < MipWidth * 4; ++i)
+                {
+                    if (std::abs(pRow[i] - Color[i % 4]) > 1e-6f)
+                    {
+                        DataOK = false;
+                        break;
+                    }
+                }
+            }
+            EXPECT_TRUE(DataOK) << "Slice: " << slice << ", Mip: " << mip;
+
+            pContext->UnmapTextureSubresource(pStagingTex, mip, slice);
+        }
+    }
+}
+
 } // namespace
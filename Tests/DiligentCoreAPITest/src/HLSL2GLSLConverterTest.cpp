@@ -25,6 +25,10 @@
  *  of the possibility of such damages.
  */
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "GPUTestingEnvironment.hpp"
 #include "HLSL2GLSLConverter.h"
 
@@ -146,4 +150,70 @@ TEST(HLSL2GLSLConverterTest, GS)
     EXPECT_NE(pGS, nullptr);
 }
 
+TEST(HLSL2GLSLConverterTest, ParallelConversion)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    RefCntAutoPtr<IHLSL2GLSLConverter> pConverter;
+    CreateHLSL2GLSLConverter(&pConverter);
+    ASSERT_NE(pConverter, nullptr);
+
+    RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+    pConverter->CreateStream("VS_PS.hlsl", pShaderSourceFactory, nullptr, 0, &pStream);
+    ASSERT_NE(pStream, nullptr);
+
+    struct EntryPointInfo
+    {
+        const char* Name;
+        SHADER_TYPE Type;
+    };
+    const EntryPointInfo EntryPoints[] = {
+        {"TestVS", SHADER_TYPE_VERTEX},
+        {"TestPS", SHADER_TYPE_PIXEL},
+    };
+
+    std::vector<std::string> RefSources;
+    for (const auto& EntryPoint : EntryPoints)
+    {
+        RefCntAutoPtr<IDataBlob> pGLSL;
+        pStream->Convert(EntryPoint.Name, EntryPoint.Type, true, "_sampler", true, &pGLSL);
+        ASSERT_NE(pGLSL, nullptr);
+        RefSources.emplace_back(static_cast<const char*>(pGLSL->GetConstDataPtr()), pGLSL->GetSize());
+    }
+
+    // The stream does not modify the tokenized source, so all threads can share it
+    constexpr size_t NumThreads    = 8;
+    constexpr size_t NumIterations = 4;
+
+    std::atomic<Uint32>      NumMismatches{0};
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&, t]() {
+                for (size_t i = 0; i < NumIterations; ++i)
+                {
+                    const auto  Idx        = (t + i) % _countof(EntryPoints);
+                    const auto& EntryPoint = EntryPoints[Idx];
+
+                    RefCntAutoPtr<IDataBlob> pGLSL;
+                    pStream->Convert(EntryPoint.Name, EntryPoint.Type, true, "_sampler", true, &pGLSL);
+                    if (!pGLSL || RefSources[Idx] != std::string{static_cast<const char*>(pGLSL->GetConstDataPtr()), pGLSL->GetSize()})
+                        NumMismatches.fetch_add(1);
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumMismatches.load(), 0u);
+}
+
 } // namespace
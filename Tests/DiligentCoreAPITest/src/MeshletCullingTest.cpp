@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshletBuilder.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(MeshletCullingTest, CompileAmplificationShader)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.MeshShaders)
+    {
+        GTEST_SKIP() << "Mesh shader is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const ShaderMacro Macros[] = {{"MESHLET_CULLING_AS", "1"}, {"MESHLET_AS_GROUP_SIZE", "64"}, {}};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = SHADER_COMPILER_DXC;
+    ShaderCI.Desc           = {"Meshlet culling test - AS", SHADER_TYPE_AMPLIFICATION, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = GetMeshletCullingShaderSource();
+    ShaderCI.Macros         = Macros;
+
+    RefCntAutoPtr<IShader> pAS;
+    pDevice->CreateShader(ShaderCI, &pAS);
+    ASSERT_NE(pAS, nullptr);
+
+    const auto NumResources = pAS->GetResourceCount();
+    EXPECT_EQ(NumResources, 2u);
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        ShaderResourceDesc ResDesc;
+        pAS->GetResourceDesc(i, ResDesc);
+        if (ResDesc.Type == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER)
+            EXPECT_STREQ(ResDesc.Name, "cbMeshletCullingConstants");
+        else
+            EXPECT_STREQ(ResDesc.Name, "g_MeshletBounds");
+    }
+}
+
+} // namespace
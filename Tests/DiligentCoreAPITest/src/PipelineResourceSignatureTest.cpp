@@ -31,6 +31,8 @@
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "ShaderMacroHelper.hpp"
+#include "ShaderResourceBindingLayout.hpp"
+#include "CompiledResourceBinding.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ResourceLayoutTestCommon.hpp"
 
@@ -2013,4 +2015,303 @@ TEST_F(PipelineResourceSignatureTest, UnusedNullResources)
     pSwapChain->Present();
 }
 
+TEST_F(PipelineResourceSignatureTest, SetResources)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "SetResources test";
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_VERTEX, "g_Buffer",       1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_Textures",     2, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_DynTexture",   1, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+    };
+    // clang-format on
+
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    pPRS->CreateShaderResourceBinding(&pSRB0, true);
+    pPRS->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_TRUE(pSRB0 && pSRB1);
+
+    // Locations are resolved using one SRB and used with another
+    ShaderResourceBindingLayout Layout;
+    const auto BufferSlot  = Layout.AddVariable(pSRB0, SHADER_TYPE_VERTEX, "g_Buffer");
+    const auto Tex0Slot    = Layout.AddVariable(pSRB0, SHADER_TYPE_PIXEL, "g_Textures", 0);
+    const auto Tex1Slot    = Layout.AddVariable(pSRB0, SHADER_TYPE_PIXEL, "g_Textures", 1);
+    const auto DynTexSlot  = Layout.AddVariable(pSRB0, SHADER_TYPE_PIXEL, "g_DynTexture");
+    const auto MissingSlot = Layout.AddVariable(pSRB0, SHADER_TYPE_PIXEL, "g_Missing");
+    EXPECT_EQ(MissingSlot, ShaderResourceBindingLayout::InvalidSlot);
+    ASSERT_EQ(Layout.GetNumVariables(), 4u);
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc{"SetResources test buffer", 256, BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    }
+    ASSERT_TRUE(pBuffer);
+
+    auto pTex0 = pEnv->CreateTexture("SetResources test texture 0", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    auto pTex1 = pEnv->CreateTexture("SetResources test texture 1", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_TRUE(pTex0 && pTex1);
+    auto* pSRV0 = pTex0->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    auto* pSRV1 = pTex1->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    IDeviceObject* Objects[4] = {};
+    Objects[BufferSlot]       = pBuffer;
+    Objects[Tex0Slot]         = pSRV0;
+    Objects[Tex1Slot]         = pSRV1;
+    Objects[DynTexSlot]       = pSRV0;
+    Layout.Bind(pSRB1, Objects);
+
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_VERTEX, "g_Buffer")->Get(), pBuffer.RawPtr());
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Get(0), pSRV0);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Get(1), pSRV1);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Get(), pSRV0);
+    EXPECT_EQ(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Get(), nullptr);
+
+    // Rebinding the same objects is a no-op; only the dynamic texture changes
+    Objects[DynTexSlot] = pSRV1;
+    Layout.Bind(pSRB1, Objects);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Get(0), pSRV0);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Get(), pSRV1);
+}
+
+TEST_F(PipelineResourceSignatureTest, CompiledResourceBinding)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Compiled resource binding test";
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_VERTEX, "g_Buffer",     1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_Textures",   2, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_DynTexture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+    };
+    // clang-format on
+
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    pPRS->CreateShaderResourceBinding(&pSRB0, true);
+    pPRS->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_TRUE(pSRB0 && pSRB1);
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc{"Compiled resource binding test buffer", 256, BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    }
+    ASSERT_TRUE(pBuffer);
+
+    auto pTex0 = pEnv->CreateTexture("Compiled resource binding test texture 0", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    auto pTex1 = pEnv->CreateTexture("Compiled resource binding test texture 1", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_TRUE(pTex0 && pTex1);
+    IDeviceObject* pSRV0 = pTex0->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    IDeviceObject* pSRV1 = pTex1->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    RefCntAutoPtr<IResourceMapping> pResMapping;
+    pDevice->CreateResourceMapping(ResourceMappingDesc{}, &pResMapping);
+    ASSERT_TRUE(pResMapping);
+    pResMapping->AddResource("g_Buffer", pBuffer, false);
+    pResMapping->AddResourceArray("g_Textures", 0, &pSRV0, 1, false);
+    pResMapping->AddResource("g_DynTexture", pSRV0, false);
+
+    // Only mutable variables are added to the table
+    CompiledResourceBinding Binding{pSRB0, SHADER_TYPE_ALL, BIND_SHADER_RESOURCES_UPDATE_MUTABLE};
+    EXPECT_EQ(Binding.GetNumElements(), 3u);
+
+    // g_Textures[1] is not in the mapping
+    EXPECT_EQ(Binding.Resolve(pResMapping), 2u);
+    EXPECT_EQ(Binding.GetNumResolvedElements(), 2u);
+    Binding.Apply(pSRB1);
+
+    auto* pTexVar = pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures");
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_VERTEX, "g_Buffer")->Get(), pBuffer.RawPtr());
+    EXPECT_EQ(pTexVar->Get(0), pSRV0);
+    EXPECT_EQ(pTexVar->Get(1), nullptr);
+    EXPECT_EQ(pSRB1->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Get(), nullptr);
+    EXPECT_EQ(pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Get(0), nullptr);
+
+    // Nothing has changed
+    EXPECT_EQ(Binding.Resolve(pResMapping), 0u);
+
+    // Only the changed element is rebound
+    pResMapping->AddResourceArray("g_Textures", 1, &pSRV1, 1, false);
+    EXPECT_EQ(Binding.Resolve(pResMapping), 1u);
+    EXPECT_EQ(Binding.GetNumResolvedElements(), 3u);
+    Binding.ApplyChanges(pSRB1);
+    EXPECT_EQ(pTexVar->Get(0), pSRV0);
+    EXPECT_EQ(pTexVar->Get(1), pSRV1);
+
+    // The result is the same as with BindResources()
+    pSRB0->BindResources(SHADER_TYPE_ALL, pResMapping, BIND_SHADER_RESOURCES_UPDATE_MUTABLE);
+    EXPECT_EQ(pSRB0->CheckResources(SHADER_TYPE_ALL, pResMapping, BIND_SHADER_RESOURCES_UPDATE_MUTABLE), SHADER_RESOURCE_VARIABLE_TYPE_FLAG_NONE);
+    EXPECT_EQ(pSRB1->CheckResources(SHADER_TYPE_ALL, pResMapping, BIND_SHADER_RESOURCES_UPDATE_MUTABLE), SHADER_RESOURCE_VARIABLE_TYPE_FLAG_NONE);
+}
+
+TEST_F(PipelineResourceSignatureTest, CloneSRB)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Clone SRB test";
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_VERTEX, "g_Buffer",     1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_PIXEL,  "g_Textures",   2, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_DynTexture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+    };
+    // clang-format on
+
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc{"Clone SRB test buffer", 256, BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    }
+    ASSERT_TRUE(pBuffer);
+    pPRS->GetStaticVariableByName(SHADER_TYPE_VERTEX, "g_Buffer")->Set(pBuffer);
+
+    auto pTex0 = pEnv->CreateTexture("Clone SRB test texture 0", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    auto pTex1 = pEnv->CreateTexture("Clone SRB test texture 1", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_TRUE(pTex0 && pTex1);
+    auto* pSRV0 = pTex0->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    auto* pSRV1 = pTex1->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    constexpr Uint32        NumSRBs           = 4;
+    IShaderResourceBinding* pRawSRBs[NumSRBs] = {};
+    pPRS->CreateShaderResourceBindings(NumSRBs, pRawSRBs, true);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[NumSRBs];
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        pSRBs[i].Attach(pRawSRBs[i]);
+        ASSERT_TRUE(pSRBs[i]);
+        EXPECT_TRUE(pSRBs[i]->StaticResourcesInitialized());
+        for (Uint32 j = 0; j < i; ++j)
+            EXPECT_NE(pSRBs[i], pSRBs[j]);
+    }
+
+    auto& pSrcSRB = pSRBs[0];
+    pSrcSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Set(pSRV0);
+    pSrcSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Set(pSRV1);
+
+    RefCntAutoPtr<IShaderResourceBinding> pClone;
+    pPRS->CloneShaderResourceBinding(pSrcSRB, &pClone);
+    ASSERT_TRUE(pClone);
+    EXPECT_NE(pClone, pSrcSRB);
+    EXPECT_TRUE(pClone->StaticResourcesInitialized());
+
+    auto* pCloneTexVar = pClone->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures");
+    EXPECT_EQ(pCloneTexVar->Get(0), pSRV0);
+    EXPECT_EQ(pCloneTexVar->Get(1), nullptr);
+    EXPECT_EQ(pClone->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynTexture")->Get(), pSRV1);
+
+    // The clone is independent from the source
+    pCloneTexVar->Set(pSRV1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+    EXPECT_EQ(pCloneTexVar->Get(0), pSRV1);
+    EXPECT_EQ(pSrcSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->Get(0), pSRV0);
+}
+
+TEST_F(PipelineResourceSignatureTest, InlineConstants)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Inline constants test";
+
+    constexpr Uint32 NumConstants = 6;
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "cbInlineConstants", NumConstants, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS},
+        {SHADER_TYPE_PIXEL,                      "cbBuffer",          1,            SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+    };
+    // clang-format on
+
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    // Inline constants are bound as a single constant buffer
+    for (Uint32 r = 0; r < pPRS->GetDesc().NumResources; ++r)
+        EXPECT_EQ(pPRS->GetDesc().Resources[r].ArraySize, 1u);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_TRUE(pSRB);
+
+    auto* pVSVar = pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbInlineConstants");
+    auto* pPSVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "cbInlineConstants");
+    ASSERT_NE(pVSVar, nullptr);
+    ASSERT_NE(pPSVar, nullptr);
+
+    // The SRB creates the buffer and binds it to all stages
+    RefCntAutoPtr<IBuffer> pBuffer{pVSVar->Get(0), IID_Buffer};
+    ASSERT_TRUE(pBuffer);
+    EXPECT_EQ(pPSVar->Get(0), pVSVar->Get(0));
+    EXPECT_EQ(pBuffer->GetDesc().Usage, USAGE_DYNAMIC);
+    EXPECT_GE(pBuffer->GetDesc().Size, Uint64{NumConstants * sizeof(Uint32)});
+
+    // Every SRB has its own buffer
+    RefCntAutoPtr<IShaderResourceBinding> pSRB2;
+    pPRS->CreateShaderResourceBinding(&pSRB2, true);
+    ASSERT_TRUE(pSRB2);
+    EXPECT_NE(pSRB2->GetVariableByName(SHADER_TYPE_VERTEX, "cbInlineConstants")->Get(0), pVSVar->Get(0));
+
+    const Uint32 Constants[NumConstants] = {1, 2, 3, 4, 5, 6};
+    pContext->SetInlineConstants(pVSVar, Constants, 0, NumConstants);
+    pContext->SetInlineConstants(pPSVar, &Constants[4], 4, 2);
+
+    // Regular constant buffers are not inline constants
+    auto* pBufferVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "cbBuffer");
+    ASSERT_NE(pBufferVar, nullptr);
+    EXPECT_EQ(pBufferVar->Get(0), nullptr);
+
+    pContext->Flush();
+}
+
 } // namespace Diligent
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+void VSMain(out float4 pos : SV_POSITION)
+{
+    pos = float4(0.0, 0.0, 0.0, 1.0);
+}
+
+void PSMain(out float4 col : SV_TARGET)
+{
+    col = float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+class PipelineStateCacheTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = GPUTestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source         = g_ShaderSource;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+
+        ShaderCI.EntryPoint = "VSMain";
+        ShaderCI.Desc       = {"PipelineStateCacheTest - VS", SHADER_TYPE_VERTEX, true};
+        pDevice->CreateShader(ShaderCI, &sm_pVS);
+        ASSERT_NE(sm_pVS, nullptr);
+
+        ShaderCI.EntryPoint = "PSMain";
+        ShaderCI.Desc       = {"PipelineStateCacheTest - PS", SHADER_TYPE_PIXEL, true};
+        pDevice->CreateShader(ShaderCI, &sm_pPS);
+        ASSERT_NE(sm_pPS, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pVS.Release();
+        sm_pPS.Release();
+        GPUTestingEnvironment::GetInstance()->Reset();
+    }
+
+    static RefCntAutoPtr<IPipelineStateCache> CreateCache(PSO_CACHE_MODE Mode, const void* pData = nullptr, Uint32 DataSize = 0)
+    {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name     = "PipelineStateCacheTest - cache";
+        CacheCI.Desc.Mode     = Mode;
+        CacheCI.pCacheData    = pData;
+        CacheCI.CacheDataSize = DataSize;
+
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        GPUTestingEnvironment::GetInstance()->GetDevice()->CreatePipelineStateCache(CacheCI, &pCache);
+        return pCache;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(IPipelineStateCache* pCache)
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                       = "PipelineStateCacheTest - PSO";
+        PSOCreateInfo.pVS                                = sm_pVS;
+        PSOCreateInfo.pPS                                = sm_pPS;
+        PSOCreateInfo.pPSOCache                          = pCache;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets  = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        GPUTestingEnvironment::GetInstance()->GetDevice()->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static RefCntAutoPtr<IShader> sm_pVS;
+    static RefCntAutoPtr<IShader> sm_pPS;
+};
+
+RefCntAutoPtr<IShader> PipelineStateCacheTest::sm_pVS;
+RefCntAutoPtr<IShader> PipelineStateCacheTest::sm_pPS;
+
+TEST_F(PipelineStateCacheTest, ReuseData)
+{
+    auto pStoreCache = CreateCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
+    if (!pStoreCache)
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    ASSERT_NE(CreatePSO(pStoreCache), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    pStoreCache->GetData(&pData);
+    ASSERT_NE(pData, nullptr);
+    ASSERT_GT(pData->GetSize(), size_t{0});
+
+    // The pipeline must be created from the cached data
+    auto pLoadCache = CreateCache(PSO_CACHE_MODE_LOAD, pData->GetConstDataPtr(), static_cast<Uint32>(pData->GetSize()));
+    ASSERT_NE(pLoadCache, nullptr);
+    EXPECT_NE(CreatePSO(pLoadCache), nullptr);
+
+    // Merged cache must contain the same pipelines
+    auto pMergedCache = CreateCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
+    ASSERT_NE(pMergedCache, nullptr);
+    IPipelineStateCache* ppSrcCaches[] = {pLoadCache};
+    if (pMergedCache->Merge(_countof(ppSrcCaches), ppSrcCaches))
+    {
+        EXPECT_NE(CreatePSO(pMergedCache), nullptr);
+    }
+}
+
+TEST_F(PipelineStateCacheTest, InvalidData)
+{
+    if (!CreateCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE))
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    // Incompatible data must be ignored and the pipeline must be created from scratch
+    const std::vector<Uint8> InvalidData(256, Uint8{0xAB});
+
+    auto pCache = CreateCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE, InvalidData.data(), static_cast<Uint32>(InvalidData.size()));
+    ASSERT_NE(pCache, nullptr);
+    EXPECT_NE(CreatePSO(pCache), nullptr);
+}
+
+TEST_F(PipelineStateCacheTest, Statistics)
+{
+    auto pCache = CreateCache(PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE);
+    if (!pCache)
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    PipelineStateCacheStatistics Stats;
+    pCache->GetStatistics(Stats);
+    EXPECT_EQ(Stats.PipelineCount, 0u);
+    EXPECT_EQ(Stats.HitCount, 0u);
+    EXPECT_EQ(Stats.MissCount, 0u);
+
+    ASSERT_NE(CreatePSO(pCache), nullptr);
+    ASSERT_NE(CreatePSO(pCache), nullptr);
+
+    pCache->GetStatistics(Stats);
+    EXPECT_GE(Stats.PipelineCount, 2u);
+    // Pipelines whose cache result is unknown are counted, but are neither hits nor misses
+    EXPECT_LE(Stats.HitCount + Stats.MissCount, Stats.PipelineCount);
+    if (Stats.HitCount == 0)
+    {
+        EXPECT_EQ(Stats.HitDuration, 0u);
+    }
+    if (Stats.MissCount == 0)
+    {
+        EXPECT_EQ(Stats.MissDuration, 0u);
+    }
+}
+
+} // namespace
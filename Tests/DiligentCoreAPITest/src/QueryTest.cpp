@@ -28,8 +28,10 @@
 #include <sstream>
 #include <vector>
 #include <thread>
+#include <chrono>
 
 #include "GPUTestingEnvironment.hpp"
+#include "GraphicsAccessories.hpp"
 #include "ThreadSignal.hpp"
 
 #include "gtest/gtest.h"
@@ -452,6 +454,155 @@ TEST_F(QueryTest, Timestamp)
 }
 
 
+TEST_F(QueryTest, GetQueryData)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    for (Uint32 q = 0; q < pEnv->GetNumImmediateContexts(); ++q)
+    {
+        auto* pContext = pEnv->GetDeviceContext(q);
+
+        if ((pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_GRAPHICS) != COMMAND_QUEUE_TYPE_GRAPHICS)
+            continue;
+
+        QueryDesc queryDesc;
+        queryDesc.Name = "Timestamp query";
+        queryDesc.Type = QUERY_TYPE_TIMESTAMP;
+
+        std::vector<RefCntAutoPtr<IQuery>> Queries(sm_NumTestQueries);
+        std::vector<IQuery*>               ppQueries(sm_NumTestQueries);
+        for (Uint32 i = 0; i < sm_NumTestQueries; ++i)
+        {
+            pDevice->CreateQuery(queryDesc, &Queries[i]);
+            ASSERT_NE(Queries[i], nullptr) << "Failed to create timestamp query";
+            ppQueries[i] = Queries[i];
+        }
+
+        for (Uint32 frame = 0; frame < sm_NumFrames; ++frame)
+        {
+            for (Uint32 i = 0; i < sm_NumTestQueries; ++i)
+            {
+                DrawQuad(pContext);
+                pContext->EndQuery(ppQueries[i]);
+            }
+
+            pContext->Flush();
+            pContext->FinishFrame();
+            pContext->WaitForIdle();
+            if (pDevice->GetDeviceInfo().IsGLDevice())
+            {
+                // glFinish() is not a guarantee that queries will become available
+                for (auto* pQuery : ppQueries)
+                    WaitForQuery(pQuery);
+            }
+
+            // std::vector<Bool> does not provide data()
+            Bool DataAvailable[sm_NumTestQueries] = {};
+
+            auto NumAvailable = pContext->GetQueryData(sm_NumTestQueries, ppQueries.data(), nullptr, 0, DataAvailable);
+            ASSERT_EQ(NumAvailable, sm_NumTestQueries) << "Query data must be available after idling the context";
+
+            std::vector<QueryDataTimestamp> QueryData(sm_NumTestQueries);
+            NumAvailable = pContext->GetQueryData(sm_NumTestQueries, ppQueries.data(), QueryData.data(), sizeof(QueryDataTimestamp), DataAvailable);
+            ASSERT_EQ(NumAvailable, sm_NumTestQueries) << "Query data must be available after idling the context";
+            for (Uint32 i = 0; i < sm_NumTestQueries; ++i)
+            {
+                EXPECT_TRUE(DataAvailable[i]);
+                if (i > 0)
+                {
+                    EXPECT_TRUE(QueryData[i].Frequency == 0 || QueryData[i].Counter >= QueryData[i - 1].Counter);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_F(QueryTest, TimestampCalibration)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto GetCPUTime = []() {
+        return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    };
+
+    // Allow for the timer resolution and the clock drift during the test
+    constexpr Uint64 Tolerance = 1000000; // 1 ms
+
+    bool IsSupported = false;
+    for (Uint32 q = 0; q < pEnv->GetNumImmediateContexts(); ++q)
+    {
+        auto* pContext = pEnv->GetDeviceContext(q);
+
+        if ((pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_GRAPHICS) != COMMAND_QUEUE_TYPE_GRAPHICS)
+            continue;
+
+        const auto CalibrationStart = GetCPUTime();
+
+        TimestampCalibration Calibration;
+        if (!pContext->GetTimestampCalibration(Calibration))
+            continue;
+        IsSupported = true;
+
+        const auto CalibrationEnd = GetCPUTime();
+        EXPECT_GT(Calibration.GPUFrequency, Uint64{0});
+        EXPECT_GE(Calibration.CPUTime + Calibration.MaxDeviation + Tolerance, CalibrationStart);
+        EXPECT_LE(Calibration.CPUTime, CalibrationEnd + Calibration.MaxDeviation + Tolerance);
+
+        QueryDesc queryDesc;
+        queryDesc.Name = "Calibrated timestamp query";
+        queryDesc.Type = QUERY_TYPE_TIMESTAMP;
+
+        RefCntAutoPtr<IQuery> pQuery;
+        pDevice->CreateQuery(queryDesc, &pQuery);
+        ASSERT_NE(pQuery, nullptr) << "Failed to create timestamp query";
+
+        const auto SubmitTime = GetCPUTime();
+        pContext->EndQuery(pQuery);
+        pContext->Flush();
+        pContext->WaitForIdle();
+        if (DeviceInfo.IsGLDevice())
+            WaitForQuery(pQuery);
+        const auto IdleTime = GetCPUTime();
+
+        QueryDataTimestamp QueryData;
+        ASSERT_TRUE(pQuery->GetData(&QueryData, sizeof(QueryData))) << "Query data must be available after idling the context";
+        pContext->FinishFrame();
+        if (QueryData.Frequency == 0)
+            continue;
+        EXPECT_EQ(QueryData.Frequency, Calibration.GPUFrequency);
+
+        // The timestamp converted to the CPU time must be between the submission and the idle wait
+        const auto TimestampCPUTime = GPUTimestampToCPUTime(Calibration, QueryData.Counter);
+        EXPECT_GE(TimestampCPUTime + Calibration.MaxDeviation + Tolerance, SubmitTime);
+        EXPECT_LE(TimestampCPUTime, IdleTime + Calibration.MaxDeviation + Tolerance);
+    }
+
+    if (!IsSupported)
+    {
+        GTEST_SKIP() << "Timestamp calibration is not supported by this device";
+    }
+}
+
+
 TEST_F(QueryTest, Duration)
 {
     const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
@@ -493,6 +644,71 @@ TEST_F(QueryTest, Duration)
     }
 }
 
+TEST_F(QueryTest, DebugGroupProfiling)
+{
+    auto* const pEnv       = GPUTestingEnvironment::GetInstance();
+    const auto& DeviceInfo = pEnv->GetDevice()->GetDeviceInfo();
+    if (!DeviceInfo.Features.DurationQueries && !DeviceInfo.Features.PipelineStatisticsQueries)
+    {
+        GTEST_SKIP() << "Neither duration nor pipeline statistics queries are supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+    pContext->SetDebugGroupProfiling(true);
+    for (Uint32 frame = 0; frame < sm_NumFrames; ++frame)
+    {
+        pContext->BeginDebugGroup("Frame");
+        pContext->BeginDebugGroup("Quads");
+        DrawQuad(pContext);
+        DrawQuad(pContext);
+        pContext->EndDebugGroup();
+        pContext->EndDebugGroup();
+
+        pContext->Flush();
+        pContext->FinishFrame();
+        pContext->WaitForIdle();
+    }
+    pContext->SetDebugGroupProfiling(false);
+
+    // The results of the last frame are read by the next FinishFrame().
+    // glFinish() does not guarantee that the queries become available.
+    Uint32                   NumGroups = 0;
+    const DebugGroupProfile* pProfile  = nullptr;
+    for (Uint32 i = 0; i < 1000 && NumGroups == 0; ++i)
+    {
+        pContext->FinishFrame();
+        pProfile = pContext->GetDebugGroupProfile(NumGroups);
+        if (NumGroups == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ASSERT_EQ(NumGroups, 2u);
+    ASSERT_NE(pProfile, nullptr);
+
+    EXPECT_STREQ(pProfile[0].Name, "Frame");
+    EXPECT_EQ(pProfile[0].Depth, 0u);
+    EXPECT_STREQ(pProfile[1].Name, "Frame/Quads");
+    EXPECT_EQ(pProfile[1].Depth, 1u);
+
+    // Pipeline statistics are only collected for the outermost group
+    EXPECT_FALSE(pProfile[1].HasPipelineStatistics);
+    if (DeviceInfo.Features.PipelineStatisticsQueries)
+    {
+        EXPECT_TRUE(pProfile[0].HasPipelineStatistics);
+        if (!DeviceInfo.IsGLDevice())
+        {
+            EXPECT_GE(pProfile[0].VSInvocations, 4u * 2u);
+            EXPECT_GE(pProfile[0].InputPrimitives, 2u * 2u);
+        }
+    }
+
+    if (DeviceInfo.Features.DurationQueries && !DeviceInfo.IsGLDevice())
+    {
+        EXPECT_GE(pProfile[0].GPUTime, pProfile[1].GPUTime);
+    }
+}
+
 TEST_F(QueryTest, DeferredContexts)
 {
     auto* const pEnv       = GPUTestingEnvironment::GetInstance();
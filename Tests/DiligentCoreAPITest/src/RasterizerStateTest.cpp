@@ -126,4 +126,61 @@ TEST_F(RasterizerStateTest, CreatePSO)
     }
 }
 
+TEST_F(RasterizerStateTest, CreateDerivedPSO)
+{
+    auto* pDevice = GPUTestingEnvironment::GetInstance()->GetDevice();
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo = GetPSOCreateInfo();
+    PSOCreateInfo.Flags |= PSO_CREATE_FLAG_ALLOW_DERIVATIVES;
+
+    auto pBasePSO = CreateTestPSO(PSOCreateInfo, false);
+    ASSERT_TRUE(pBasePSO);
+
+    RasterizerStateDesc RSDesc = PSOCreateInfo.GraphicsPipeline.RasterizerDesc;
+    RSDesc.FillMode            = FILL_MODE_WIREFRAME;
+    RSDesc.CullMode            = CULL_MODE_FRONT;
+
+    DerivedGraphicsPipelineStateCreateInfo DerivedCI;
+    DerivedCI.pBasePipeline   = pBasePSO;
+    DerivedCI.Name            = "Derived PSO";
+    DerivedCI.pRasterizerDesc = &RSDesc;
+
+    RefCntAutoPtr<IPipelineState> pDerivedPSO;
+    pDevice->CreateDerivedGraphicsPipelineState(DerivedCI, &pDerivedPSO);
+    ASSERT_TRUE(pDerivedPSO);
+
+    const auto& BaseDesc    = pBasePSO->GetGraphicsPipelineDesc();
+    const auto& DerivedDesc = pDerivedPSO->GetGraphicsPipelineDesc();
+    EXPECT_EQ(DerivedDesc.RasterizerDesc.FillMode, FILL_MODE_WIREFRAME);
+    EXPECT_EQ(DerivedDesc.RasterizerDesc.CullMode, CULL_MODE_FRONT);
+    EXPECT_EQ(DerivedDesc.BlendDesc, BaseDesc.BlendDesc);
+    EXPECT_EQ(DerivedDesc.DepthStencilDesc, BaseDesc.DepthStencilDesc);
+    EXPECT_EQ(DerivedDesc.NumRenderTargets, BaseDesc.NumRenderTargets);
+    EXPECT_TRUE(pDerivedPSO->IsCompatibleWith(pBasePSO));
+}
+
+TEST_F(RasterizerStateTest, ShareImplicitSignature)
+{
+    GraphicsPipelineStateCreateInfo PSOCreateInfo = GetPSOCreateInfo();
+
+    auto pPSO0 = CreateTestPSO(PSOCreateInfo, false);
+    ASSERT_TRUE(pPSO0);
+    auto pPSO1 = CreateTestPSO(PSOCreateInfo, false);
+    ASSERT_TRUE(pPSO1);
+    EXPECT_NE(pPSO0->GetResourceSignature(0), pPSO1->GetResourceSignature(0));
+
+    PSOCreateInfo.Flags |= PSO_CREATE_FLAG_SHARE_IMPLICIT_SIGNATURE;
+
+    auto pSharedPSO0 = CreateTestPSO(PSOCreateInfo, false);
+    ASSERT_TRUE(pSharedPSO0);
+
+    PSOCreateInfo.GraphicsPipeline.RasterizerDesc.FillMode = FILL_MODE_WIREFRAME;
+
+    auto pSharedPSO1 = CreateTestPSO(PSOCreateInfo, false);
+    ASSERT_TRUE(pSharedPSO1);
+    EXPECT_EQ(pSharedPSO0->GetResourceSignature(0), pSharedPSO1->GetResourceSignature(0));
+    EXPECT_NE(pSharedPSO0->GetResourceSignature(0), pPSO0->GetResourceSignature(0));
+    EXPECT_TRUE(pSharedPSO0->IsCompatibleWith(pSharedPSO1));
+}
+
 } // namespace
@@ -1430,6 +1430,12 @@ TEST_P(RT4, MultiGeometry)
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 1", "Geom 1", 0, "HitGroup1", &Weights[0], sizeof(Weights[0]));
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 1", "Geom 2", 0, "HitGroup1", &Weights[1], sizeof(Weights[0]));
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 1", "Geom 3", 0, "HitGroup1", &Weights[2], sizeof(Weights[0]));
+    // Upload placeholder records for the second instance
+    pSBT->BindHitGroupForInstance(pTLAS, "Instance 2", 0, "HitGroup1", &Weights[0], sizeof(Weights[0]));
+    pContext->UpdateSBT(pSBT);
+
+    // Only the records of the second instance are uploaded by the next update
+    pSBT->BindHitGroupForGeometry(pTLAS, "Instance 1", "Geom 1", 0, "HitGroup1", &Weights[0], sizeof(Weights[0]));
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 2", "Geom 1", 0, "HitGroup2", &Weights[3], sizeof(Weights[0]));
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 2", "Geom 2", 0, "HitGroup2", &Weights[4], sizeof(Weights[0]));
     pSBT->BindHitGroupForGeometry(pTLAS, "Instance 2", "Geom 3", 0, "HitGroup2", &Weights[5], sizeof(Weights[0]));
@@ -1563,6 +1569,248 @@ TEST(RayTracingTest, ResourceBinding)
 }
 
 
+TEST(RayTracingTest, BuildBLASBatch)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Triangle vertices";
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = sizeof(Vertices);
+        BufferData BuffData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &BuffData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangle";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = 1;
+
+    BLASBuildTriangleData TriangleData;
+    TriangleData.GeometryName         = TriangleDesc.GeometryName;
+    TriangleData.pVertexBuffer        = pVertexBuffer;
+    TriangleData.VertexStride         = sizeof(Vertices[0]);
+    TriangleData.VertexCount          = TriangleDesc.MaxVertexCount;
+    TriangleData.VertexValueType      = TriangleDesc.VertexValueType;
+    TriangleData.VertexComponentCount = TriangleDesc.VertexComponentCount;
+    TriangleData.PrimitiveCount       = 1;
+    TriangleData.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    constexpr Uint32 NumBLASes = 32;
+
+    std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes(NumBLASes);
+    std::vector<BuildBLASAttribs>              Builds(NumBLASes);
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        BottomLevelASDesc ASDesc;
+        ASDesc.Name          = "Batched BLAS";
+        ASDesc.Flags         = RAYTRACING_BUILD_AS_ALLOW_UPDATE;
+        ASDesc.pTriangles    = &TriangleDesc;
+        ASDesc.TriangleCount = 1;
+        pDevice->CreateBLAS(ASDesc, &BLASes[i]);
+        ASSERT_NE(BLASes[i], nullptr);
+
+        auto& Attribs                  = Builds[i];
+        Attribs.pBLAS                  = BLASes[i];
+        Attribs.BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.pTriangleData          = &TriangleData;
+        Attribs.TriangleDataCount      = 1;
+    }
+
+    // The last build uses its own scratch buffer
+    RefCntAutoPtr<IBuffer> pScratchBuffer;
+    {
+        const auto& ScratchSizes = BLASes.back()->GetScratchBufferSizes();
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "BLAS Scratch Buffer";
+        BuffDesc.Usage     = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = std::max(ScratchSizes.Build, ScratchSizes.Update);
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pScratchBuffer);
+        ASSERT_NE(pScratchBuffer, nullptr);
+
+        Builds.back().pScratchBuffer              = pScratchBuffer;
+        Builds.back().ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    }
+
+    BuildBLASBatchAttribs BatchAttribs;
+    BatchAttribs.pBuilds    = Builds.data();
+    BatchAttribs.BuildCount = NumBLASes;
+    pContext->BuildBLASBatch(BatchAttribs);
+
+    for (const auto& pBLAS : BLASes)
+    {
+        EXPECT_EQ(pBLAS->GetState(), RESOURCE_STATE_BUILD_AS_WRITE);
+        EXPECT_EQ(pBLAS->GetActualGeometryCount(), 1u);
+    }
+
+    // Refit half of the BLASes. The internal scratch buffer is reused.
+    for (auto& Attribs : Builds)
+        Attribs.Update = true;
+    BatchAttribs.BuildCount = NumBLASes / 2;
+    pContext->BuildBLASBatch(BatchAttribs);
+
+    // Empty batch is a no-op
+    pContext->BuildBLASBatch(BuildBLASBatchAttribs{});
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+
+TEST(RayTracingTest, TLASDirtyInstances)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    BLASBuildTriangleData Triangle;
+    Triangle.GeometryName         = "Triangle";
+    Triangle.VertexStride         = sizeof(Vertices[0]);
+    Triangle.VertexCount          = _countof(Vertices);
+    Triangle.VertexValueType      = VT_FLOAT32;
+    Triangle.VertexComponentCount = 3;
+    Triangle.PrimitiveCount       = 1;
+    Triangle.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Triangle vertices";
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = sizeof(Vertices);
+        BufferData BuffData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &BuffData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+    Triangle.pVertexBuffer = pVertexBuffer;
+
+    RefCntAutoPtr<IBottomLevelAS> pBLAS;
+    CreateBLAS(pDevice, pContext, &Triangle, 1, RAYTRACING_BUILD_AS_NONE, pBLAS);
+    ASSERT_NE(pBLAS, nullptr);
+
+    constexpr Uint32 InstanceCount = 64;
+
+    std::vector<std::string>           InstanceNames(InstanceCount);
+    std::vector<TLASBuildInstanceData> Instances(InstanceCount);
+    for (Uint32 i = 0; i < InstanceCount; ++i)
+    {
+        InstanceNames[i] = "Instance " + std::to_string(i);
+
+        auto& Inst        = Instances[i];
+        Inst.InstanceName = InstanceNames[i].c_str();
+        Inst.pBLAS        = pBLAS;
+        Inst.Mask         = 0xFF;
+        Inst.CustomId     = i;
+        Inst.Transform.SetTranslation(static_cast<float>(i), 0.0f, 0.0f);
+    }
+
+    RefCntAutoPtr<ITopLevelAS> pTLAS;
+    {
+        TopLevelASDesc TLASDesc;
+        TLASDesc.Name             = "Dirty instances TLAS";
+        TLASDesc.MaxInstanceCount = InstanceCount;
+        TLASDesc.Flags            = RAYTRACING_BUILD_AS_ALLOW_UPDATE;
+        pDevice->CreateTLAS(TLASDesc, &pTLAS);
+        ASSERT_NE(pTLAS, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pScratchBuffer;
+    RefCntAutoPtr<IBuffer> pInstanceBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "TLAS Scratch Buffer";
+        BuffDesc.Usage     = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = std::max(pTLAS->GetScratchBufferSizes().Build, pTLAS->GetScratchBufferSizes().Update);
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pScratchBuffer);
+        ASSERT_NE(pScratchBuffer, nullptr);
+
+        BuffDesc.Name = "TLAS Instance Buffer";
+        BuffDesc.Size = TLAS_INSTANCE_DATA_SIZE * InstanceCount;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pInstanceBuffer);
+        ASSERT_NE(pInstanceBuffer, nullptr);
+    }
+
+    BuildTLASAttribs Attribs;
+    Attribs.pTLAS                        = pTLAS;
+    Attribs.pInstances                   = Instances.data();
+    Attribs.InstanceCount                = InstanceCount;
+    Attribs.HitGroupStride               = 1;
+    Attribs.BindingMode                  = HIT_GROUP_BINDING_MODE_PER_GEOMETRY;
+    Attribs.TLASTransitionMode           = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.BLASTransitionMode           = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.pInstanceBuffer              = pInstanceBuffer;
+    Attribs.InstanceBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.pScratchBuffer               = pScratchBuffer;
+    Attribs.ScratchBufferTransitionMode  = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->BuildTLAS(Attribs);
+
+    std::vector<TLASInstanceDesc> InitialDescs(InstanceCount);
+    for (Uint32 i = 0; i < InstanceCount; ++i)
+        InitialDescs[i] = pTLAS->GetInstanceDesc(InstanceNames[i].c_str());
+
+    // Move a few instances. Instances 10-12 are consecutive, 40 is separate.
+    std::vector<TLASBuildInstanceData> DirtyInstances;
+    for (Uint32 i : {40u, 11u, 10u, 12u})
+    {
+        auto Inst = Instances[i];
+        Inst.Transform.SetTranslation(static_cast<float>(i), 1.0f, 0.0f);
+        Inst.Mask = 0x0F;
+        DirtyInstances.push_back(Inst);
+    }
+
+    Attribs.Update             = true;
+    Attribs.DirtyInstancesOnly = true;
+    Attribs.pInstances         = DirtyInstances.data();
+    Attribs.InstanceCount      = static_cast<Uint32>(DirtyInstances.size());
+    pContext->BuildTLAS(Attribs);
+
+    EXPECT_EQ(pTLAS->GetBuildInfo().InstanceCount, InstanceCount);
+    EXPECT_EQ(pTLAS->GetState(), RESOURCE_STATE_BUILD_AS_WRITE);
+    for (Uint32 i = 0; i < InstanceCount; ++i)
+    {
+        const auto Desc = pTLAS->GetInstanceDesc(InstanceNames[i].c_str());
+        EXPECT_EQ(Desc.InstanceIndex, InitialDescs[i].InstanceIndex);
+        EXPECT_EQ(Desc.ContributionToHitGroupIndex, InitialDescs[i].ContributionToHitGroupIndex);
+        EXPECT_EQ(Desc.pBLAS, pBLAS);
+    }
+
+    // Refit without changed instances
+    Attribs.pInstances    = nullptr;
+    Attribs.InstanceCount = 0;
+    pContext->BuildTLAS(Attribs);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+
 class RT5 : public testing::TestWithParam<int>
 {};
 
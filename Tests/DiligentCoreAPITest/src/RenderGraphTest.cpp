@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "RenderGraph.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(RenderGraphTest, CullAndTransition)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Render graph test output";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 128;
+    TexDesc.Height    = 128;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+
+    auto pOutput = pEnv->CreateTexture(TexDesc.Name, TexDesc.Format, BIND_RENDER_TARGET | BIND_SHADER_RESOURCE, TexDesc.Width, TexDesc.Height);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    const auto hOutput = Graph.ImportTexture(pOutput);
+
+    TexDesc.Name       = "Render graph test intermediate";
+    const auto hInterm = Graph.CreateTexture(TexDesc);
+    TexDesc.Name       = "Render graph test unused";
+    const auto hUnused = Graph.CreateTexture(TexDesc);
+
+    std::vector<RenderGraph::PassHandle> ExecutedPasses;
+
+    const auto UnusedPass = Graph.AddPass("Unused pass", RENDER_GRAPH_PASS_FLAG_NONE,
+                                          [&](IDeviceContext*) { ExecutedPasses.push_back(0); });
+    Graph.Write(UnusedPass, hUnused, RESOURCE_STATE_RENDER_TARGET);
+
+    const auto ProducerPass = Graph.AddPass("Producer pass", RENDER_GRAPH_PASS_FLAG_NONE,
+                                            [&](IDeviceContext*) {
+                                                ExecutedPasses.push_back(1);
+                                                EXPECT_EQ(Graph.GetTexture(hInterm)->GetState(), RESOURCE_STATE_RENDER_TARGET);
+                                            });
+    Graph.Write(ProducerPass, hInterm, RESOURCE_STATE_RENDER_TARGET);
+
+    const auto ConsumerPass = Graph.AddPass("Consumer pass", RENDER_GRAPH_PASS_FLAG_NONE,
+                                            [&](IDeviceContext*) {
+                                                ExecutedPasses.push_back(2);
+                                                EXPECT_EQ(Graph.GetTexture(hInterm)->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+                                                EXPECT_EQ(pOutput->GetState(), RESOURCE_STATE_RENDER_TARGET);
+                                            });
+    Graph.Read(ConsumerPass, hInterm, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(ConsumerPass, hOutput, RESOURCE_STATE_RENDER_TARGET);
+
+    Graph.Compile();
+
+    EXPECT_TRUE(Graph.IsPassCulled(UnusedPass));
+    EXPECT_FALSE(Graph.IsPassCulled(ProducerPass));
+    EXPECT_FALSE(Graph.IsPassCulled(ConsumerPass));
+
+    const auto& Order = Graph.GetExecutionOrder();
+    ASSERT_EQ(Order.size(), 2u);
+    EXPECT_EQ(Order[0], ProducerPass);
+    EXPECT_EQ(Order[1], ConsumerPass);
+
+    EXPECT_NE(Graph.GetTexture(hInterm), nullptr);
+    EXPECT_EQ(Graph.GetTexture(hUnused), nullptr);
+    EXPECT_EQ(Graph.GetTexture(hOutput), pOutput);
+
+    RenderGraphExecuteAttribs Attribs;
+    Attribs.pContext = pContext;
+    Graph.Execute(Attribs);
+    pContext->Flush();
+
+    EXPECT_EQ(ExecutedPasses, (std::vector<RenderGraph::PassHandle>{1, 2}));
+
+    const auto& Stats = Graph.GetExecutionStats();
+    EXPECT_EQ(Stats.NumGraphicsPasses, 2u);
+    EXPECT_EQ(Stats.NumAsyncComputePasses, 0u);
+    EXPECT_EQ(Stats.NumFenceSignals, 0u);
+    EXPECT_EQ(Stats.NumFenceWaits, 0u);
+
+    Graph.Reset();
+}
+
+TEST(RenderGraphTest, AsyncComputeOverlap)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    IDeviceContext* pGraphicsCtx = nullptr;
+    IDeviceContext* pComputeCtx  = nullptr;
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto*       Ctx  = pEnv->GetDeviceContext(CtxInd);
+        const auto& Desc = Ctx->GetDesc();
+
+        constexpr auto QueueTypeMask = COMMAND_QUEUE_TYPE_GRAPHICS | COMMAND_QUEUE_TYPE_COMPUTE;
+        if (!pGraphicsCtx && (Desc.QueueType & QueueTypeMask) == COMMAND_QUEUE_TYPE_GRAPHICS)
+            pGraphicsCtx = Ctx;
+        else if (!pComputeCtx && (Desc.QueueType & QueueTypeMask) == COMMAND_QUEUE_TYPE_COMPUTE)
+            pComputeCtx = Ctx;
+    }
+    if (!pGraphicsCtx || !pComputeCtx)
+    {
+        GTEST_SKIP() << "Unable to find graphics and compute immediate contexts";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TextureDesc TexDesc;
+    TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width                = 128;
+    TexDesc.Height               = 128;
+    TexDesc.Format               = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags            = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    TexDesc.ImmediateContextMask = (Uint64{1} << pGraphicsCtx->GetDesc().ContextId) | (Uint64{1} << pComputeCtx->GetDesc().ContextId);
+
+    RefCntAutoPtr<ITexture> pTextures[4];
+    const char*             TexNames[] = {"Render graph async test G-buffer", "Render graph async test compute output", "Render graph async test shadow map", "Render graph async test output"};
+    for (size_t i = 0; i < _countof(pTextures); ++i)
+    {
+        TexDesc.Name = TexNames[i];
+        pDevice->CreateTexture(TexDesc, nullptr, &pTextures[i]);
+        ASSERT_NE(pTextures[i], nullptr);
+    }
+
+    RenderGraph Graph{pDevice};
+
+    const auto hGBuffer   = Graph.ImportTexture(pTextures[0]);
+    const auto hCompOut   = Graph.ImportTexture(pTextures[1]);
+    const auto hShadowMap = Graph.ImportTexture(pTextures[2]);
+    const auto hOutput    = Graph.ImportTexture(pTextures[3]);
+
+    const auto GBufferPass = Graph.AddPass("G-buffer pass", RENDER_GRAPH_PASS_FLAG_NONE, nullptr);
+    Graph.Write(GBufferPass, hGBuffer, RESOURCE_STATE_RENDER_TARGET);
+
+    // Depends on the G-buffer pass and requires the G-buffer to be transitioned
+    // out of the render target state on the graphics context.
+    const auto ComputePass = Graph.AddPass("Compute pass", RENDER_GRAPH_PASS_FLAG_ASYNC_COMPUTE,
+                                           [&](IDeviceContext* pCtx) { EXPECT_EQ(pCtx, pComputeCtx); });
+    Graph.Read(ComputePass, hGBuffer, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(ComputePass, hCompOut, RESOURCE_STATE_UNORDERED_ACCESS);
+
+    // Independent of the compute pass, so it may overlap with it
+    const auto ShadowPass = Graph.AddPass("Shadow pass", RENDER_GRAPH_PASS_FLAG_NONE, nullptr);
+    Graph.Write(ShadowPass, hShadowMap, RESOURCE_STATE_RENDER_TARGET);
+
+    const auto CompositePass = Graph.AddPass("Composite pass", RENDER_GRAPH_PASS_FLAG_NONE,
+                                             [&](IDeviceContext* pCtx) { EXPECT_EQ(pCtx, pGraphicsCtx); });
+    Graph.Read(CompositePass, hCompOut, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Read(CompositePass, hShadowMap, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(CompositePass, hOutput, RESOURCE_STATE_RENDER_TARGET);
+
+    Graph.Compile();
+
+    RenderGraphExecuteAttribs Attribs;
+    Attribs.pContext             = pGraphicsCtx;
+    Attribs.pAsyncComputeContext = pComputeCtx;
+    Graph.Execute(Attribs);
+    pGraphicsCtx->Flush();
+    pComputeCtx->Flush();
+
+    const auto& Stats = Graph.GetExecutionStats();
+    EXPECT_EQ(Stats.NumGraphicsPasses, 3u);
+    EXPECT_EQ(Stats.NumAsyncComputePasses, 1u);
+    EXPECT_EQ(Stats.NumDemotedComputePasses, 0u);
+    EXPECT_EQ(Stats.NumQueueHandoffTransitions, 1u);
+    // One signal on each queue: the G-buffer handoff and the compute output
+    EXPECT_EQ(Stats.NumFenceSignals, 2u);
+    EXPECT_EQ(Stats.NumFenceWaits, 2u);
+    // The compute pass may overlap with the shadow pass
+    EXPECT_EQ(Stats.NumOverlappingComputePasses, 1u);
+    EXPECT_EQ(Stats.NumOverlappingGraphicsPasses, 1u);
+
+    pGraphicsCtx->WaitForIdle();
+    pComputeCtx->WaitForIdle();
+
+    Graph.Reset();
+}
+
+TEST(RenderGraphTest, MemorylessAttachments)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const bool MemorylessSupported = (pDevice->GetAdapterInfo().Memory.MemorylessTextureBindFlags & BIND_RENDER_TARGET) != 0;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Render graph test output";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 128;
+    TexDesc.Height    = 128;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+    auto pOutput = pEnv->CreateTexture(TexDesc.Name, TexDesc.Format, BIND_RENDER_TARGET, TexDesc.Width, TexDesc.Height);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    const auto hOutput = Graph.ImportTexture(pOutput);
+
+    TexDesc.MiscFlags   = MISC_TEXTURE_FLAG_MEMORYLESS;
+    TexDesc.Name        = "Render graph test single-pass attachment";
+    const auto hSingle  = Graph.CreateTexture(TexDesc);
+    TexDesc.Name        = "Render graph test multi-pass attachment";
+    const auto hMulti   = Graph.CreateTexture(TexDesc);
+    TexDesc.BindFlags   = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.Name        = "Render graph test sampled attachment";
+    const auto hSampled = Graph.CreateTexture(TexDesc);
+
+    const auto Pass0 = Graph.AddPass("Pass 0", RENDER_GRAPH_PASS_FLAG_NONE, [](IDeviceContext*) {});
+    Graph.Write(Pass0, hMulti, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Write(Pass0, hSampled, RESOURCE_STATE_RENDER_TARGET);
+
+    const auto Pass1 = Graph.AddPass("Pass 1", RENDER_GRAPH_PASS_FLAG_NONE, [](IDeviceContext*) {});
+    Graph.Write(Pass1, hMulti, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Write(Pass1, hSingle, RESOURCE_STATE_RENDER_TARGET);
+    Graph.Read(Pass1, hSampled, RESOURCE_STATE_SHADER_RESOURCE);
+    Graph.Write(Pass1, hOutput, RESOURCE_STATE_RENDER_TARGET);
+
+    Graph.Compile();
+
+    ASSERT_NE(Graph.GetTexture(hSingle), nullptr);
+    ASSERT_NE(Graph.GetTexture(hMulti), nullptr);
+    ASSERT_NE(Graph.GetTexture(hSampled), nullptr);
+
+    const auto IsMemoryless = [&](RenderGraph::ResourceHandle hTex) {
+        return (Graph.GetTexture(hTex)->GetDesc().MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0;
+    };
+    // Only the texture that is used as an attachment by a single pass may be memoryless
+    EXPECT_EQ(IsMemoryless(hSingle), MemorylessSupported);
+    EXPECT_FALSE(IsMemoryless(hMulti));
+    EXPECT_FALSE(IsMemoryless(hSampled));
+
+    Graph.Reset();
+}
+
+} // namespace
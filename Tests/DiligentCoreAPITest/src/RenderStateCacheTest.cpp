@@ -34,6 +34,9 @@
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
 #include "ResourceLayoutTestCommon.hpp"
+#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
+#include "ThreadPool.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
 
@@ -314,6 +317,13 @@ TEST(RenderStateCacheTest, CreateShader)
                 EXPECT_NE(pCS, nullptr);
             }
 
+            {
+                RenderStateCacheStats Stats;
+                pCache->GetStats(Stats);
+                EXPECT_EQ(Stats.ShaderHitCount, 2u);
+                EXPECT_EQ(Stats.ShaderMissCount, 5u);
+            }
+
             pData.Release();
             pCache->WriteToBlob(&pData);
 
@@ -860,6 +870,216 @@ TEST(RenderStateCacheTest, AppendData)
     }
 }
 
+TEST(RenderStateCacheTest, Journal)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    constexpr bool UseSignature  = false;
+    constexpr bool UseRenderPass = false;
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false);
+
+        RefCntAutoPtr<IShader> pCS;
+        CreateComputeShader(pCache, pShaderSourceFactory, pCS, false);
+        ASSERT_NE(pCS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateComputePSO(pCache, /*PresentInCache = */ false, pCS, UseSignature, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        pCache->WriteToBlob(&pArchive);
+        ASSERT_NE(pArchive, nullptr);
+    }
+
+    auto pJournal       = DataBlobImpl::Create();
+    auto pJournalStream = MemoryFileStream::Create(pJournal);
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false, pArchive);
+
+        // Nothing new has been added to the cache
+        EXPECT_TRUE(pCache->AppendToJournal(pJournalStream));
+        EXPECT_EQ(pJournal->GetSize(), size_t{0});
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, false);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+        EXPECT_TRUE(pCache->AppendToJournal(pJournalStream));
+        const auto ShadersRecordSize = pJournal->GetSize();
+        EXPECT_GT(ShadersRecordSize, size_t{0});
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateGraphicsPSO(pCache, false, pVS, pPS, UseRenderPass, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+        EXPECT_TRUE(pCache->AppendToJournal(pJournalStream));
+        EXPECT_GT(pJournal->GetSize(), ShadersRecordSize);
+    }
+
+    auto VerifyCache = [&](IRenderStateCache* pCache) {
+        RefCntAutoPtr<IShader> pCS;
+        CreateComputeShader(pCache, pShaderSourceFactory, pCS, true);
+        ASSERT_NE(pCS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pCompPSO;
+        CreateComputePSO(pCache, /*PresentInCache = */ true, pCS, UseSignature, &pCompPSO);
+        ASSERT_NE(pCompPSO, nullptr);
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, true);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateGraphicsPSO(pCache, true, pVS, pPS, UseRenderPass, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+        VerifyGraphicsPSO(pPSO, UseRenderPass);
+    };
+
+    // Base archive + journal
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false, pArchive);
+        EXPECT_TRUE(pCache->LoadJournal(pJournal));
+        VerifyCache(pCache);
+    }
+
+    // Truncated journal: the incomplete last record is ignored
+    {
+        auto pTruncatedJournal = DataBlobImpl::Create(pJournal->GetSize() - 1, pJournal->GetConstDataPtr());
+
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false, pArchive);
+        EXPECT_TRUE(pCache->LoadJournal(pTruncatedJournal));
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, true);
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateGraphicsPSO(pCache, false, pVS, pPS, UseRenderPass, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    // Compacted archive
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false);
+
+        RefCntAutoPtr<IDataBlob> pCompactedArchive;
+        EXPECT_TRUE(pCache->CompactJournal(pArchive, pJournal, &pCompactedArchive));
+        ASSERT_NE(pCompactedArchive, nullptr);
+
+        EXPECT_TRUE(pCache->Load(pCompactedArchive));
+        VerifyCache(pCache);
+    }
+}
+
+TEST(RenderStateCacheTest, PrefetchPipelines)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    constexpr bool UseRenderPass = false;
+
+    RenderStateCacheCreateInfo CacheCI{pDevice, RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE};
+    CacheCI.EnableUsageLog = true;
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    RefCntAutoPtr<IDataBlob> pUsageLog;
+    {
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, false);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateGraphicsPSO(pCache, false, pVS, pPS, UseRenderPass, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        // Repeated requests are logged once
+        RefCntAutoPtr<IPipelineState> pPSO2;
+        CreateGraphicsPSO(pCache, true, pVS, pPS, UseRenderPass, &pPSO2);
+        EXPECT_EQ(pPSO, pPSO2);
+
+        EXPECT_TRUE(pCache->WriteToBlob(&pArchive));
+        ASSERT_NE(pArchive, nullptr);
+        EXPECT_TRUE(pCache->WriteUsageLog(&pUsageLog));
+        ASSERT_NE(pUsageLog, nullptr);
+
+        // The log has been reset
+        RefCntAutoPtr<IDataBlob> pEmptyLog;
+        EXPECT_TRUE(pCache->WriteUsageLog(&pEmptyLog));
+        ASSERT_NE(pEmptyLog, nullptr);
+        EXPECT_LT(pEmptyLog->GetSize(), pUsageLog->GetSize());
+    }
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_TRUE(pThreadPool);
+    for (IThreadPool* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr<IThreadPool>()})
+    {
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+        ASSERT_TRUE(pCache->Load(pArchive));
+
+        EXPECT_EQ(pCache->PrefetchPipelines(pUsageLog, pPool), 1u);
+        if (pPool != nullptr)
+            pPool->WaitForAllTasks();
+
+        RenderStateCacheStats Stats;
+        pCache->GetStats(Stats);
+        EXPECT_EQ(Stats.PendingPrefetchCount, 0u);
+        EXPECT_EQ(Stats.PrefetchHitCount, 0u);
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, pVS, pPS, true);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        CreateGraphicsPSO(pCache, true, pVS, pPS, UseRenderPass, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+        VerifyGraphicsPSO(pPSO, UseRenderPass);
+
+        pCache->GetStats(Stats);
+        EXPECT_EQ(Stats.PrefetchHitCount, 1u);
+    }
+
+    // Reset cancels pending prefetches
+    {
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+
+        EXPECT_EQ(pCache->PrefetchPipelines(pUsageLog, pThreadPool), 1u);
+        pCache->Reset();
+
+        RenderStateCacheStats Stats;
+        pCache->GetStats(Stats);
+        EXPECT_EQ(Stats.PendingPrefetchCount, 0u);
+    }
+
+    pThreadPool->StopThreads();
+}
+
 TEST(RenderStateCacheTest, RenderDeviceWithCache)
 {
     constexpr bool Execute = false;
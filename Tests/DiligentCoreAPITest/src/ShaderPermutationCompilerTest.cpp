@@ -0,0 +1,181 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <vector>
+
+#include "ShaderPermutationCompiler.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char PSSource[] = R"(
+float4 main() : SV_Target
+{
+#if USE_RED
+    return float4(1.0, 0.0, 0.0, 1.0);
+#else
+    return float4(0.0, 1.0, 0.0, 1.0);
+#endif
+}
+)";
+
+TEST(ShaderPermutationCompilerTest, Deduplication)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ShaderPermutationCompiler Compiler{{pDevice}};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = PSSource;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name       = "Shader permutation compiler test";
+
+    const ShaderMacro Macros0[] = {{"USE_RED", "1"}, {"UNUSED_FEATURE", "0"}, {}};
+    const ShaderMacro Macros1[] = {{"UNUSED_FEATURE", "1"}, {"USE_RED", "1"}, {}};
+    const ShaderMacro Macros2[] = {{"USE_RED", "0"}, {}};
+
+    ShaderCI.Macros = Macros0;
+    auto pShader0   = Compiler.CreateShader(ShaderCI);
+    ASSERT_NE(pShader0, nullptr);
+
+    ShaderCI.Macros = Macros1;
+    auto pShader1   = Compiler.CreateShader(ShaderCI);
+    EXPECT_EQ(pShader0, pShader1);
+
+    ShaderCI.Macros = Macros2;
+    auto pShader2   = Compiler.CreateShader(ShaderCI);
+    ASSERT_NE(pShader2, nullptr);
+    EXPECT_NE(pShader0, pShader2);
+
+    auto Stats = Compiler.GetStatistics();
+    EXPECT_EQ(Stats.NumRequests, 3u);
+    EXPECT_EQ(Stats.NumCompiled, 2u);
+    EXPECT_EQ(Stats.NumDeduplicated, 1u);
+}
+
+TEST(ShaderPermutationCompilerTest, ConcurrentRequests)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ShaderPermutationCompiler Compiler{{pDevice}};
+
+    constexpr Uint32 NumThreads = 4;
+
+    std::vector<RefCntAutoPtr<IShader>> Shaders(NumThreads);
+    std::vector<std::thread>            Threads;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back([&, i]() {
+            const ShaderMacro Macros[] = {{"USE_RED", "1"}, {}};
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.Source          = PSSource;
+            ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Desc.Name       = "Shader permutation compiler concurrency test";
+            ShaderCI.Macros          = Macros;
+            Shaders[i]               = Compiler.CreateShader(ShaderCI);
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    ASSERT_NE(Shaders[0], nullptr);
+    for (Uint32 i = 1; i < NumThreads; ++i)
+        EXPECT_EQ(Shaders[i], Shaders[0]);
+
+    auto Stats = Compiler.GetStatistics();
+    EXPECT_EQ(Stats.NumCompiled, 1u);
+    EXPECT_EQ(Stats.NumDeduplicated, NumThreads - 1);
+}
+
+TEST(ShaderPermutationCompilerTest, PermutationKeys)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ShaderPermutationCompiler Compiler{{pDevice}};
+
+    ShaderPermutationSchema Schema;
+
+    const auto UseRed        = Schema.AddBool("USE_RED");
+    const auto UnusedFeature = Schema.AddInt("UNUSED_FEATURE", 0, 3);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = PSSource;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name       = "Shader permutation key test";
+
+    const auto SourceHash = Compiler.ComputeSourceHash(ShaderCI, Schema);
+
+    ShaderPermutationKey Key0;
+    Schema.SetValue(Key0, UseRed, 1);
+    auto pShader0 = Compiler.CreateShader(ShaderCI, SourceHash, Schema, Key0);
+    ASSERT_NE(pShader0, nullptr);
+
+    // Same key
+    EXPECT_EQ(Compiler.CreateShader(ShaderCI, SourceHash, Schema, Key0), pShader0);
+
+    // The macro is not referenced by the source
+    ShaderPermutationKey Key1 = Key0;
+    Schema.SetValue(Key1, UnusedFeature, 2);
+    EXPECT_EQ(Compiler.CreateShader(ShaderCI, SourceHash, Schema, Key1), pShader0);
+
+    // Same permutation requested through the macros
+    auto Macros     = Schema.GetMacroHelper(Key0);
+    ShaderCI.Macros = Macros;
+    EXPECT_EQ(Compiler.CreateShader(ShaderCI), pShader0);
+
+    ShaderCI.Macros = nullptr;
+    auto pShader2   = Compiler.CreateShader(ShaderCI, SourceHash, Schema, ShaderPermutationKey{});
+    ASSERT_NE(pShader2, nullptr);
+    EXPECT_NE(pShader2, pShader0);
+
+    auto Stats = Compiler.GetStatistics();
+    EXPECT_EQ(Stats.NumRequests, 5u);
+    EXPECT_EQ(Stats.NumCompiled, 2u);
+    EXPECT_EQ(Stats.NumDeduplicated, 3u);
+}
+
+} // namespace
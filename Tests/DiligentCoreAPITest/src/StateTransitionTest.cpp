@@ -24,6 +24,8 @@
  *  of the possibility of such damages.
  */
 
+#include <vector>
+
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 
@@ -134,4 +136,84 @@ TEST(ResourceStateTest, DiscardSubresource)
     pContext->Flush();
 }
 
+TEST(ResourceStateTest, SplitBarrier)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "SplitBarrier test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    TexDesc.Name = "SplitBarrier test texture 2";
+    RefCntAutoPtr<ITexture> pTexture2;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture2);
+    ASSERT_NE(pTexture2, nullptr);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "SplitBarrier test buffer";
+    BuffDesc.Size      = 1024;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    const float ClearColor[] = {0.4f, 0.1f, 0.2f, 1.f};
+
+    ITextureView* pRTV = pTexture->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    const std::vector<Uint8> Data(static_cast<size_t>(BuffDesc.Size), 0xAB);
+    pContext->UpdateBuffer(pBuffer, 0, BuffDesc.Size, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    EXPECT_EQ(pBuffer->GetState(), RESOURCE_STATE_COPY_DEST);
+
+    {
+        StateTransitionDesc Barriers[] = {
+            {pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE},
+            {pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER},
+        };
+        for (auto& Barrier : Barriers)
+            Barrier.TransitionType = STATE_TRANSITION_TYPE_BEGIN;
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    // Begin-split barriers must not update the states
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(pBuffer->GetState(), RESOURCE_STATE_COPY_DEST);
+
+    // Independent work between the begin and end of the split
+    ITextureView* pRTV2 = pTexture2->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    pContext->SetRenderTargets(1, &pRTV2, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearRenderTarget(pRTV2, ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    {
+        StateTransitionDesc Barriers[] = {
+            {pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        };
+        for (auto& Barrier : Barriers)
+            Barrier.TransitionType = STATE_TRANSITION_TYPE_END;
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(pBuffer->GetState(), RESOURCE_STATE_VERTEX_BUFFER);
+
+    pContext->Flush();
+}
+
 } // namespace
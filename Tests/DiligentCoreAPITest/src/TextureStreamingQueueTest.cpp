@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "TextureStreamingQueue.hpp"
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TextureStreamingQueueTest, Update)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 Width       = 64;
+    constexpr Uint32 Height      = 64;
+    constexpr Uint32 StripHeight = 8;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture streaming queue test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.MipLevels = 2;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    std::vector<Uint32> Mip0Data(Width * Height);
+    for (size_t i = 0; i < Mip0Data.size(); ++i)
+        Mip0Data[i] = static_cast<Uint32>(i * 2654435761u);
+    std::vector<Uint32> Mip1Data(Width / 2 * Height / 2);
+    for (size_t i = 0; i < Mip1Data.size(); ++i)
+        Mip1Data[i] = static_cast<Uint32>(i * 40503u);
+
+    TextureStreamingQueueCreateInfo CI;
+    CI.MaxCommandsPerUpdate = 1;
+    TextureStreamingQueue Queue{CI};
+
+    Uint32 NumUploaded = 0;
+
+    TextureStreamingQueue::UploadRequest Req;
+    Req.pTexture   = pTexture;
+    Req.OnUploaded = [&NumUploaded]() { ++NumUploaded; };
+
+    // Mip level 0 is uploaded in horizontal strips that are merged into one copy command
+    for (Uint32 y = 0; y < Height; y += StripHeight)
+    {
+        Req.Region = Box{0, Width, y, y + StripHeight};
+        Req.pData  = &Mip0Data[y * Width];
+        Req.Stride = Width * 4;
+        Queue.Enqueue(Req);
+    }
+
+    // This request is cancelled before it is uploaded
+    std::vector<Uint32> Garbage(Width * StripHeight, 0xDEADBEEFu);
+    Req.pData              = Garbage.data();
+    Req.Region             = Box{0, Width, 0, StripHeight};
+    const auto CancelledId = Queue.Enqueue(Req);
+
+    // Mip level 1 has the same priority, but is enqueued last
+    Req.MipLevel = 1;
+    Req.Region   = Box{};
+    Req.pData    = Mip1Data.data();
+    Req.Stride   = Width / 2 * 4;
+    Queue.Enqueue(Req);
+
+    EXPECT_EQ(Queue.GetNumPendingRequests(), size_t{Height / StripHeight + 2});
+    EXPECT_TRUE(Queue.Cancel(CancelledId));
+    EXPECT_FALSE(Queue.Cancel(CancelledId));
+    EXPECT_EQ(Queue.GetNumPendingRequests(), size_t{Height / StripHeight + 1});
+
+    // The mip tail is uploaded first
+    auto Stats = Queue.Update(pContext);
+    EXPECT_EQ(Stats.NumCommands, Uint32{1});
+    EXPECT_EQ(Stats.NumRequests, Uint32{1});
+    EXPECT_EQ(Stats.NumBytes, Uint64{Width / 2 * Height / 2 * 4});
+    EXPECT_EQ(NumUploaded, Uint32{1});
+
+    Stats = Queue.Update(pContext);
+    EXPECT_EQ(Stats.NumCommands, Uint32{1});
+    EXPECT_EQ(Stats.NumRequests, Height / StripHeight);
+    EXPECT_EQ(Stats.NumBytes, Uint64{Width * Height * 4});
+    EXPECT_EQ(NumUploaded, Height / StripHeight + 1);
+    EXPECT_EQ(Queue.GetNumPendingRequests(), size_t{0});
+    EXPECT_EQ(Queue.GetPendingBytes(), Uint64{0});
+
+    GPUReadbackQueue::CreateInfo ReadbackCI;
+    ReadbackCI.pDevice = pDevice;
+    GPUReadbackQueue ReadbackQueue{ReadbackCI};
+
+    const auto VerifyMip = [&](Uint32 Mip, const std::vector<Uint32>& RefData) {
+        const Uint32 MipWidth  = Width >> Mip;
+        const Uint32 MipHeight = Height >> Mip;
+        ReadbackQueue.ReadTexture(pContext, pTexture, Mip, 0, nullptr,
+                                  [&, MipWidth, MipHeight](const GPUReadbackQueue::ReadbackData& Data) {
+                                      ASSERT_NE(Data.pData, nullptr);
+                                      for (Uint32 y = 0; y < MipHeight; ++y)
+                                      {
+                                          const auto* pRow = static_cast<const Uint8*>(Data.pData) + Data.Stride * y;
+                                          EXPECT_EQ(memcmp(pRow, &RefData[y * MipWidth], MipWidth * 4), 0) << "Mip " << Mip << ", row " << y;
+                                      }
+                                  });
+    };
+    VerifyMip(0, Mip0Data);
+    VerifyMip(1, Mip1Data);
+    ReadbackQueue.Flush(pContext);
+}
+
+TEST(TextureStreamingQueueTest, Budget)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture streaming queue budget test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    constexpr Uint32 TileSize  = 16;
+    constexpr Uint64 TileBytes = TileSize * TileSize * 4;
+
+    const std::vector<Uint32> TileData(TileSize * TileSize, 0xFF00FF00u);
+
+    TextureStreamingQueueCreateInfo CI;
+    CI.MaxBytesPerUpdate = TileBytes * 3;
+    TextureStreamingQueue Queue{CI};
+
+    // Diagonal tiles are not adjacent and can't be merged
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        TextureStreamingQueue::UploadRequest Req;
+        Req.pTexture = pTexture;
+        Req.Region   = Box{i * TileSize, (i + 1) * TileSize, i * TileSize, (i + 1) * TileSize};
+        Req.pData    = TileData.data();
+        Req.Stride   = TileSize * 4;
+        Req.Priority = static_cast<float>(i);
+        Queue.Enqueue(Req);
+    }
+    EXPECT_EQ(Queue.GetPendingBytes(), TileBytes * 4);
+
+    auto Stats = Queue.Update(pContext);
+    EXPECT_EQ(Stats.NumCommands, Uint32{3});
+    EXPECT_EQ(Stats.NumBytes, TileBytes * 3);
+    EXPECT_EQ(Queue.GetPendingBytes(), TileBytes);
+
+    Stats = Queue.Update(pContext);
+    EXPECT_EQ(Stats.NumCommands, Uint32{1});
+    EXPECT_EQ(Queue.GetNumPendingRequests(), size_t{0});
+}
+
+} // namespace
@@ -89,7 +89,7 @@ Uint32 WriteOrVerifyRGBAData(MappedTextureSubresource& MappedData,
     return NumInvalidPixels;
 }
 
-void TextureUploaderTest(bool IsRenderThread)
+void TextureUploaderTest(bool IsRenderThread, Uint64 MaxCopyBytesPerUpdate = 0)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -102,7 +102,9 @@ void TextureUploaderTest(bool IsRenderThread)
 
     GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
 
-    TextureUploaderDesc             UploaderDesc;
+    TextureUploaderDesc UploaderDesc;
+    UploaderDesc.MaxCopyBytesPerUpdate = MaxCopyBytesPerUpdate;
+
     RefCntAutoPtr<ITextureUploader> pTexUploader;
     CreateTextureUploader(pDevice, UploaderDesc, &pTexUploader);
     ASSERT_TRUE(pTexUploader);
@@ -220,4 +222,9 @@ TEST(TextureUploaderTest, WorkerThread)
     TextureUploaderTest(false);
 }
 
+TEST(TextureUploaderTest, WorkerThreadCopyBudget)
+{
+    TextureUploaderTest(false, 1);
+}
+
 } // namespace
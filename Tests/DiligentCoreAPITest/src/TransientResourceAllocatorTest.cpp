@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TransientResourceAllocatorTest, Aliasing)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TransientTextureDesc TexDesc;
+    TexDesc.Desc.Type         = RESOURCE_DIM_TEX_2D;
+    TexDesc.Desc.Width        = 256;
+    TexDesc.Desc.Height       = 256;
+    TexDesc.Desc.Format       = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Desc.BindFlags    = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.InitialState      = RESOURCE_STATE_RENDER_TARGET;
+
+    TransientResourceAllocator Allocator{pDevice};
+    for (Uint32 frame = 0; frame < 2; ++frame)
+    {
+        // A: passes 0-1, B: passes 1-2, C: passes 2-3 (may alias A), D: passes 4-4 with a different format
+        TexDesc.Desc.Name = "Transient texture A";
+        TexDesc.FirstPass = 0;
+        TexDesc.LastPass  = 1;
+        const auto hA     = Allocator.DeclareTexture(TexDesc);
+
+        TexDesc.Desc.Name = "Transient texture B";
+        TexDesc.FirstPass = 1;
+        TexDesc.LastPass  = 2;
+        const auto hB     = Allocator.DeclareTexture(TexDesc);
+
+        TexDesc.Desc.Name = "Transient texture C";
+        TexDesc.FirstPass = 2;
+        TexDesc.LastPass  = 3;
+        const auto hC     = Allocator.DeclareTexture(TexDesc);
+
+        auto DescD        = TexDesc;
+        DescD.Desc.Name   = "Transient texture D";
+        DescD.Desc.Format = TEX_FORMAT_RGBA16_FLOAT;
+        DescD.FirstPass   = 4;
+        DescD.LastPass    = 4;
+        const auto hD     = Allocator.DeclareTexture(DescD);
+
+        Allocator.Compile();
+
+        auto* pTexA = Allocator.GetTexture(hA);
+        auto* pTexB = Allocator.GetTexture(hB);
+        auto* pTexC = Allocator.GetTexture(hC);
+        auto* pTexD = Allocator.GetTexture(hD);
+        ASSERT_NE(pTexA, nullptr);
+        ASSERT_NE(pTexB, nullptr);
+        ASSERT_NE(pTexC, nullptr);
+        ASSERT_NE(pTexD, nullptr);
+
+        EXPECT_NE(pTexA, pTexB);
+        EXPECT_EQ(pTexA, pTexC);
+        EXPECT_NE(pTexA, pTexD);
+        EXPECT_NE(pTexB, pTexD);
+
+        const auto& Stats = Allocator.GetStatistics();
+        EXPECT_EQ(Stats.NumDeclaredTextures, 4u);
+        EXPECT_EQ(Stats.NumPhysicalTextures, 3u);
+        EXPECT_EQ(Stats.NumCreatedTextures, frame == 0 ? 3u : 0u);
+        EXPECT_LT(Stats.PhysicalMemorySize, Stats.DeclaredMemorySize);
+
+        for (Uint32 pass = 0; pass <= 4; ++pass)
+        {
+            Allocator.BeginPass(pContext, pass);
+            if (pass == 2)
+                EXPECT_EQ(pTexC->GetState(), RESOURCE_STATE_RENDER_TARGET);
+        }
+        pContext->Flush();
+
+        Allocator.Reset();
+    }
+
+    Allocator.ReleaseUnusedTextures();
+    EXPECT_EQ(Allocator.GetStatistics().NumPhysicalTextures, 0u);
+}
+
+} // namespace
@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <vector>
+
+#include "VRSImageGenerator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(VRSImageGeneratorTest, ContrastBasedRate)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    const auto& SRProps    = pDevice->GetAdapterInfo().ShadingRate;
+    if (!DeviceInfo.Features.VariableRateShading ||
+        !DeviceInfo.Features.ComputeShaders ||
+        (SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0 ||
+        (SRProps.Format != SHADING_RATE_FORMAT_PALETTE && SRProps.Format != SHADING_RATE_FORMAT_UNORM8))
+    {
+        GTEST_SKIP() << "Texture-based variable rate shading is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    // The left half of the frame is flat, the right half is a checkerboard
+    constexpr Uint32 FrameWidth  = 256;
+    constexpr Uint32 FrameHeight = 128;
+
+    std::vector<Uint32> ColorData(FrameWidth * FrameHeight);
+    for (Uint32 y = 0; y < FrameHeight; ++y)
+    {
+        for (Uint32 x = 0; x < FrameWidth; ++x)
+            ColorData[x + y * FrameWidth] = (x < FrameWidth / 2 || ((x + y) & 1) == 0) ? 0xFF808080u : 0xFF000000u;
+    }
+
+    TextureDesc ColorDesc;
+    ColorDesc.Name      = "VRS image generator test color";
+    ColorDesc.Type      = RESOURCE_DIM_TEX_2D;
+    ColorDesc.Width     = FrameWidth;
+    ColorDesc.Height    = FrameHeight;
+    ColorDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    ColorDesc.BindFlags = BIND_SHADER_RESOURCE;
+    ColorDesc.Usage     = USAGE_IMMUTABLE;
+
+    TextureSubResData ColorSubres{ColorData.data(), FrameWidth * 4};
+    TextureData       ColorInitData{&ColorSubres, 1};
+
+    RefCntAutoPtr<ITexture> pColor;
+    pDevice->CreateTexture(ColorDesc, &ColorInitData, &pColor);
+    ASSERT_NE(pColor, nullptr);
+
+    VRSImageGenerator::CreateInfo CI;
+    CI.pDevice = pDevice;
+    VRSImageGenerator Generator{CI};
+
+    VRSImageGenerator::GenerateAttribs Attribs;
+    Attribs.pColorSRV = pColor->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    Generator.Generate(pContext, Attribs);
+
+    ASSERT_NE(Generator.GetShadingRateView(), nullptr);
+    auto ImageDesc = Generator.GetTexture()->GetDesc();
+    EXPECT_EQ(ImageDesc.Width, (FrameWidth + Generator.GetTileSize() - 1) / Generator.GetTileSize());
+    EXPECT_EQ(ImageDesc.Height, (FrameHeight + Generator.GetTileSize() - 1) / Generator.GetTileSize());
+
+    ImageDesc.Name           = "VRS image staging texture";
+    ImageDesc.Usage          = USAGE_STAGING;
+    ImageDesc.BindFlags      = BIND_NONE;
+    ImageDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStaging;
+    pDevice->CreateTexture(ImageDesc, nullptr, &pStaging);
+    ASSERT_NE(pStaging, nullptr);
+
+    pContext->CopyTexture(CopyTextureAttribs{Generator.GetTexture(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                             pStaging, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+    pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pStaging, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    ASSERT_NE(MappedData.pData, nullptr);
+
+    const Uint32 TexelSize = SRProps.Format == SHADING_RATE_FORMAT_UNORM8 ? 2 : 1;
+    for (Uint32 y = 0; y < ImageDesc.Height; ++y)
+    {
+        for (Uint32 x = 0; x < ImageDesc.Width; ++x)
+        {
+            const auto* pTexel = static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride + x * TexelSize;
+            // Full rate is 1X1 for the palette format and 255 (density 1.0) for the density map
+            const bool IsFullRate = TexelSize == 1 ?
+                pTexel[0] == SHADING_RATE_1X1 :
+                pTexel[0] == 255 && pTexel[1] == 255;
+
+            if (x + 1 < ImageDesc.Width / 2)
+            {
+                // The last flat column borders the checkerboard.
+                // Only check the flat tiles if the device supports lower rates.
+                if (SRProps.NumShadingRates > 1 || TexelSize == 2)
+                    EXPECT_FALSE(IsFullRate) << "Flat tile " << x << ", " << y;
+            }
+            else if (x >= ImageDesc.Width / 2)
+            {
+                EXPECT_TRUE(IsFullRate) << "Checkerboard tile " << x << ", " << y;
+            }
+        }
+    }
+    pContext->UnmapTextureSubresource(pStaging, 0, 0);
+}
+
+} // namespace
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstring>
+
+#include "VirtualTexture.hpp"
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(VirtualTextureTest, Residency)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& SparseRes = pDevice->GetAdapterInfo().SparseResources;
+    if (!pDevice->GetDeviceInfo().Features.SparseResources || (SparseRes.CapFlags & SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D) == 0)
+    {
+        GTEST_SKIP() << "Sparse textures are not supported by this device";
+    }
+    if (pDevice->GetDeviceInfo().IsMetalDevice())
+    {
+        GTEST_SKIP() << "Virtual textures are not currently supported in Metal";
+    }
+
+    IDeviceContext* pSparseBindingCtx = nullptr;
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto* pCtx = pEnv->GetDeviceContext(CtxInd);
+        if ((pCtx->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING)
+        {
+            pSparseBindingCtx = pCtx;
+            break;
+        }
+    }
+    if (pSparseBindingCtx == nullptr)
+    {
+        GTEST_SKIP() << "Sparse binding queue is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    VirtualTextureCreateInfo CI;
+    CI.Name                  = "Virtual texture test";
+    CI.Width                 = 2048;
+    CI.Height                = 2048;
+    CI.Format                = TEX_FORMAT_RGBA8_UNORM;
+    CI.NumPhysicalPages      = 64;
+    CI.FeedbackBufferSize    = 16;
+    CI.pSparseBindingContext = pSparseBindingCtx;
+    CI.LoadTile              = [](Uint32 MipLevel, const Box& Region, void* pData, Uint64 Stride) {
+        for (Uint32 y = 0; y < Region.Height(); ++y)
+        {
+            auto* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pData) + Stride * y);
+            for (Uint32 x = 0; x < Region.Width(); ++x)
+                pRow[x] = 0xFF000000u | MipLevel;
+        }
+    };
+
+    VirtualTexture VirtTex{pDevice, CI};
+    ASSERT_NE(VirtTex.GetTexture(), nullptr);
+    ASSERT_NE(VirtTex.GetResidencyTexture(), nullptr);
+    ASSERT_NE(VirtTex.GetFeedbackBuffer(), nullptr);
+
+    const auto FirstMipInTail = VirtTex.GetTexture()->GetSparseProperties().FirstMipInTail;
+    if (FirstMipInTail < 2)
+    {
+        GTEST_SKIP() << "The texture has too few tiled mip levels";
+    }
+
+    // Simulates the feedback written by a shader
+    const auto RequestTiles = [&](std::vector<Uint32> Feedback) {
+        Feedback.resize(CI.FeedbackBufferSize);
+        pContext->UpdateBuffer(VirtTex.GetFeedbackBuffer(), 0, CI.FeedbackBufferSize * sizeof(Uint32), Feedback.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        for (Uint32 frame = 0; frame < 4; ++frame)
+        {
+            VirtTex.Update(pContext);
+            pContext->WaitForIdle();
+        }
+    };
+
+    // Tile (0, 0) of mip 0 and all its parents become resident
+    RequestTiles({VirtualTexture::PackFeedback(0, 0, 0)});
+
+    auto Stats = VirtTex.GetStats();
+    EXPECT_EQ(Stats.NumResidentTiles, FirstMipInTail);
+    EXPECT_EQ(Stats.NumLoadingTiles, Uint32{0});
+    EXPECT_EQ(Stats.NumEvictions, Uint64{0});
+
+    {
+        GPUReadbackQueue::CreateInfo ReadbackCI;
+        ReadbackCI.pDevice = pDevice;
+        GPUReadbackQueue Readback{ReadbackCI};
+
+        Uint8 Residency[2] = {0xFF, 0xFF};
+        Box   Region{0, 2, 0, 1};
+        Readback.ReadTexture(pContext, VirtTex.GetResidencyTexture(), 0, 0, &Region,
+                             [&Residency](const GPUReadbackQueue::ReadbackData& Data) {
+                                 if (Data.pData != nullptr)
+                                     memcpy(Residency, Data.pData, sizeof(Residency));
+                             });
+        Readback.Flush(pContext);
+
+        // Tile (0, 0) is resident at mip 0, tile (1, 0) only at mip 1
+        EXPECT_EQ(Residency[0], 0);
+        EXPECT_EQ(Residency[1], 1);
+    }
+
+    // Request more tiles than the pool can hold, in batches of 4x4 tiles of mip 0
+    const Uint32 NumTilesX = CI.Width / VirtTex.GetTileWidth();
+    for (Uint32 BatchX = 0; BatchX + 4 <= NumTilesX; BatchX += 4)
+    {
+        std::vector<Uint32> Feedback;
+        for (Uint32 y = 0; y < 4; ++y)
+        {
+            for (Uint32 x = BatchX; x < BatchX + 4; ++x)
+                Feedback.push_back(VirtualTexture::PackFeedback(0, x, y));
+        }
+        RequestTiles(Feedback);
+    }
+
+    Stats = VirtTex.GetStats();
+    EXPECT_EQ(Stats.NumLoadingTiles, Uint32{0});
+    EXPECT_GT(Stats.NumEvictions, Uint64{0});
+    EXPECT_EQ(Stats.NumFreePages, Uint32{0});
+}
+
+} // namespace
@@ -69,8 +69,9 @@ int TestSwapChainCInterface(struct ISwapChain* pSwapChain)
 
 void TestSwapChainC_API(struct ISwapChain* pSwapChain)
 {
-    DisplayModeAttribs* pDisplayMode = NULL;
-    ITextureView*       pDSV         = NULL;
+    DisplayModeAttribs*     pDisplayMode = NULL;
+    ITextureView*           pDSV         = NULL;
+    const FramePacingStats* pStats       = NULL;
 
     ISwapChain_Present(pSwapChain, 0);
     ISwapChain_Resize(pSwapChain, 1024, 768, SURFACE_TRANSFORM_OPTIMAL);
@@ -79,4 +80,6 @@ void TestSwapChainC_API(struct ISwapChain* pSwapChain)
     ISwapChain_SetWindowedMode(pSwapChain);
     pDSV = ISwapChain_GetDepthBufferDSV(pSwapChain);
     (void)pDSV;
+    pStats = ISwapChain_GetFramePacingStats(pSwapChain);
+    (void)pStats;
 }
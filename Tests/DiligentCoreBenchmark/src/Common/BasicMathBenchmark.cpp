@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BasicMath.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumElements = 1024;
+
+std::vector<float4x4> CreateMatrices()
+{
+    FastRandReal<float> Rnd{0, -1.f, 1.f};
+
+    std::vector<float4x4> Matrices(NumElements);
+    for (auto& Mat : Matrices)
+    {
+        Mat = float4x4::RotationY(Rnd()) * float4x4::Scale(1.f + Rnd() * 0.5f) * float4x4::Translation(Rnd(), Rnd(), Rnd());
+    }
+    return Matrices;
+}
+
+std::vector<float3> CreateVectors()
+{
+    FastRandReal<float> Rnd{1, -1.f, 1.f};
+
+    std::vector<float3> Vectors(NumElements);
+    for (auto& Vec : Vectors)
+        Vec = float3{Rnd(), Rnd(), Rnd() + 2.f};
+    return Vectors;
+}
+
+TEST(Common_BasicMath, Matrix4x4)
+{
+    const auto Matrices = CreateMatrices();
+
+    RunBenchmark(
+        "float4x4Multiply", [&]() {
+            float4x4 Result = float4x4::Identity();
+            for (const auto& Mat : Matrices)
+                Result = Result * Mat;
+            DoNotOptimize(Result);
+        },
+        NumElements);
+
+    RunBenchmark(
+        "float4x4Inverse", [&]() {
+            for (const auto& Mat : Matrices)
+                DoNotOptimize(Mat.Inverse());
+        },
+        NumElements);
+
+    const auto Vectors = CreateVectors();
+    RunBenchmark(
+        "float4TransformByMatrix", [&]() {
+            for (Uint32 i = 0; i < NumElements; ++i)
+                DoNotOptimize(float4{Vectors[i], 1} * Matrices[i]);
+        },
+        NumElements);
+}
+
+TEST(Common_BasicMath, Vector3)
+{
+    const auto Vectors = CreateVectors();
+
+    RunBenchmark(
+        "float3NormalizeCross", [&]() {
+            for (Uint32 i = 0; i + 1 < NumElements; ++i)
+                DoNotOptimize(normalize(cross(Vectors[i], Vectors[i + 1])));
+        },
+        NumElements - 1);
+}
+
+TEST(Common_BasicMath, Quaternion)
+{
+    const auto Vectors = CreateVectors();
+
+    RunBenchmark(
+        "QuaternionRotateVector", [&]() {
+            for (Uint32 i = 0; i + 1 < NumElements; ++i)
+            {
+                const auto Rotation = Quaternion::RotationFromAxisAngle(normalize(Vectors[i]), 0.5f);
+                DoNotOptimize(Rotation.RotateVector(Vectors[i + 1]));
+            }
+        },
+        NumElements - 1);
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HashUtils.hpp"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumValues = 1024;
+
+TEST(Common_HashUtils, ComputeHash)
+{
+    std::vector<Uint32> Values(NumValues);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        Values[i] = i * 2654435761u;
+
+    RunBenchmark(
+        "ComputeHashUint32x3", [&]() {
+            size_t Hash = 0;
+            for (Uint32 i = 0; i + 2 < NumValues; ++i)
+                Hash ^= ComputeHash(Values[i], Values[i + 1], Values[i + 2]);
+            DoNotOptimize(Hash);
+        },
+        NumValues - 2);
+
+    std::vector<std::string> Strings(NumValues);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        Strings[i] = "g_Texture" + std::to_string(i) + "_sampler";
+
+    RunBenchmark(
+        "CStringHash", [&]() {
+            size_t Hash = 0;
+            for (const auto& Str : Strings)
+                Hash ^= CStringHash<char>{}(Str.c_str());
+            DoNotOptimize(Hash);
+        },
+        NumValues);
+
+    std::vector<Uint8> Data(4096);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 31);
+
+    RunBenchmark(
+        "ComputeHashRaw4KB", [&]() {
+            DoNotOptimize(ComputeHashRaw(Data.data(), Data.size()));
+        },
+        1);
+}
+
+} // namespace
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParsingTools.hpp"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::string CreateShaderSource(Uint32 NumFunctions)
+{
+    std::string Source;
+    for (Uint32 i = 0; i < NumFunctions; ++i)
+    {
+        const auto Idx = std::to_string(i);
+        Source += "// Function " + Idx + "\n"
+                  "float4 Function" + Idx + "(float4 Pos : SV_Position, float2 UV : TEXCOORD0)\n"
+                  "{\n"
+                  "    /* Sample the texture */\n"
+                  "    float4 Color = g_Texture" + Idx + ".Sample(g_Sampler, UV * 2.5 + 0.125);\n"
+                  "    return Color * 0.75f + float4(1.0, 0.5, 0.25, 1e-3);\n"
+                  "}\n\n";
+    }
+    return Source;
+}
+
+TEST(Common_ParsingTools, SplitString)
+{
+    const auto Source = CreateShaderSource(64);
+
+    RunBenchmark(
+        "SplitString", [&]() {
+            size_t NumTokens = 0;
+            Parsing::SplitString(Source.begin(), Source.end(), [&](const auto&, auto& Pos) {
+                if (Pos == Source.end())
+                    return false;
+
+                auto NextPos = Parsing::SkipIdentifier(Pos, Source.end());
+                if (NextPos == Pos)
+                    NextPos = Parsing::SkipFloatNumber(Pos, Source.end());
+                Pos = NextPos != Pos ? NextPos : Pos + 1;
+                ++NumTokens;
+                return true;
+            });
+            DoNotOptimize(NumTokens);
+        },
+        Source.length());
+}
+
+} // namespace
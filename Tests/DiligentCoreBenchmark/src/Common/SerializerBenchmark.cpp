@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "Serializer.hpp"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumRecords = 256;
+
+template <SerializerMode Mode>
+void SerializeRecords(Serializer<Mode>& Ser, const std::vector<std::string>& Names)
+{
+    for (Uint32 i = 0; i < NumRecords; ++i)
+    {
+        Uint32      Id    = i;
+        Uint64      Flags = Uint64{i} << 32;
+        Uint16      Type  = static_cast<Uint16>(i & 0xFF);
+        const char* Name  = Names[i].c_str();
+        Ser(Id, Flags, Type, Name);
+    }
+}
+
+TEST(Common_Serializer, SerializeRecords)
+{
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    std::vector<std::string> Names(NumRecords);
+    for (Uint32 i = 0; i < NumRecords; ++i)
+        Names[i] = "SerializedRecord" + std::to_string(i);
+
+    Serializer<SerializerMode::Measure> MSer;
+    SerializeRecords(MSer, Names);
+    auto Data = MSer.AllocateData(RawAllocator);
+
+    RunBenchmark(
+        "Measure", [&]() {
+            Serializer<SerializerMode::Measure> Ser;
+            SerializeRecords(Ser, Names);
+            DoNotOptimize(Ser.GetSize());
+        },
+        NumRecords);
+
+    RunBenchmark(
+        "Write", [&]() {
+            Serializer<SerializerMode::Write> Ser{Data};
+            SerializeRecords(Ser, Names);
+            DoNotOptimize(Data.Ptr());
+        },
+        NumRecords);
+
+    RunBenchmark(
+        "Read", [&]() {
+            Serializer<SerializerMode::Read> Ser{Data};
+            for (Uint32 i = 0; i < NumRecords; ++i)
+            {
+                Uint32      Id    = 0;
+                Uint64      Flags = 0;
+                Uint16      Type  = 0;
+                const char* Name  = nullptr;
+                Ser(Id, Flags, Type, Name);
+                DoNotOptimize(Name);
+            }
+        },
+        NumRecords);
+}
+
+} // namespace
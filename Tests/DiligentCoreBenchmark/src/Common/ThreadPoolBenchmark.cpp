@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumTasks = 256;
+
+void RunThreadPoolBenchmark(const char* Name, bool EnableWorkStealing)
+{
+    ThreadPoolCreateInfo PoolCI{4};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<Uint32> Counter{0};
+    RunBenchmark(
+        Name, [&]() {
+            for (Uint32 i = 0; i < NumTasks; ++i)
+            {
+                EnqueueAsyncWork(pThreadPool,
+                                 [&Counter](Uint32) //
+                                 {
+                                     Counter.fetch_add(1);
+                                 });
+            }
+            pThreadPool->WaitForAllTasks();
+        },
+        NumTasks);
+
+    DoNotOptimize(Counter.load());
+}
+
+TEST(Common_ThreadPool, EnqueueShortTasks)
+{
+    RunThreadPoolBenchmark("EnqueueShortTasks", false);
+    RunThreadPoolBenchmark("EnqueueShortTasksWorkStealing", true);
+}
+
+} // namespace
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DynamicAtlasManager.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BasicMath.hpp"
+#include "FastRand.hpp"
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumRegions = 256;
+
+void RunAtlasBenchmark(const char* Name, DynamicAtlasManager::ALLOCATION_POLICY Policy)
+{
+    FastRandInt Rnd{0, 4, 32};
+
+    std::vector<uint2> Sizes(NumRegions);
+    for (auto& Size : Sizes)
+    {
+        Size.x = static_cast<Uint32>(Rnd());
+        Size.y = static_cast<Uint32>(Rnd());
+    }
+
+    DynamicAtlasManager Mgr{1024, 1024, Policy};
+
+    std::vector<DynamicAtlasManager::Region> Regions(NumRegions);
+    RunBenchmark(
+        Name, [&]() {
+            for (Uint32 i = 0; i < NumRegions; ++i)
+                Regions[i] = Mgr.Allocate(Sizes[i].x, Sizes[i].y);
+            for (Uint32 i = 0; i < NumRegions; ++i)
+            {
+                // Free regions in an interleaved order to fragment the free space
+                auto& R = Regions[(i * 97) % NumRegions];
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+        },
+        NumRegions);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateFree)
+{
+    RunAtlasBenchmark("AllocateFreeBestFit", DynamicAtlasManager::ALLOCATION_POLICY_BEST_FIT);
+    RunAtlasBenchmark("AllocateFreeShelf", DynamicAtlasManager::ALLOCATION_POLICY_SHELF);
+}
+
+} // namespace
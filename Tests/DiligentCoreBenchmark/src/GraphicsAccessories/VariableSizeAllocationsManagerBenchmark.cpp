@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VariableSizeAllocationsManager.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumAllocations = 1024;
+
+TEST(GraphicsAccessories_VariableSizeAllocationsManager, AllocateFree)
+{
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    FastRandInt Rnd{0, 16, 4096};
+
+    std::vector<VariableSizeAllocationsManager::OffsetType> Sizes(NumAllocations);
+    for (auto& Size : Sizes)
+        Size = static_cast<VariableSizeAllocationsManager::OffsetType>(Rnd());
+
+    // Free allocations in a shuffled order to fragment the free space
+    std::vector<Uint32> FreeOrder(NumAllocations);
+    for (Uint32 i = 0; i < NumAllocations; ++i)
+        FreeOrder[i] = (i * 577) % NumAllocations;
+
+    VariableSizeAllocationsManager Mgr{NumAllocations * 4096, DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::vector<Allocation> Allocations(NumAllocations);
+    RunBenchmark(
+        "AllocateFree", [&]() {
+            for (Uint32 i = 0; i < NumAllocations; ++i)
+                Allocations[i] = Mgr.Allocate(Sizes[i], 16);
+            for (auto i : FreeOrder)
+                Mgr.Free(std::move(Allocations[i]));
+        },
+        NumAllocations);
+}
+
+} // namespace
@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "XXH128Hasher.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GraphicsTools_XXH128Hasher, Update)
+{
+    std::vector<Uint8> Data(64 << 10);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 13);
+
+    RunBenchmark(
+        "UpdateRaw64KB", [&]() {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(Data.data(), Data.size());
+            DoNotOptimize(Hasher.Digest());
+        },
+        Data.size());
+
+    SamplerDesc Desc;
+    Desc.MaxAnisotropy = 8;
+    RunBenchmark(
+        "UpdateSamplerDesc", [&]() {
+            XXH128State Hasher;
+            Hasher.Update(Desc);
+            DoNotOptimize(Hasher.Digest());
+        });
+}
+
+} // namespace
@@ -26,11 +26,16 @@
  */
 
 #include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unordered_set>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +129,117 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 24;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+    constexpr Uint32 ThreadCacheSize       = 8;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize);
+
+    // Exceed the cache size several times to exercise magazine exchange with the depot
+    constexpr size_t   NumAllocations = ThreadCacheSize * 5 + 3;
+    std::vector<void*> Allocations(NumAllocations);
+    for (int iter = 0; iter < 3; ++iter)
+    {
+        std::unordered_set<void*> UniqueAllocations;
+        for (auto& pMem : Allocations)
+        {
+            pMem = TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+            ASSERT_NE(pMem, nullptr);
+            memset(pMem, 0xFF, AllocSize);
+            EXPECT_TRUE(UniqueAllocations.insert(pMem).second);
+        }
+        for (auto* pMem : Allocations)
+            TestAllocator.Free(pMem);
+    }
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ThreadCacheManyAllocators)
+{
+    constexpr Uint32 AllocSize       = 64;
+    constexpr Uint32 ThreadCacheSize = 8;
+
+    // Every pipeline resource signature has its own allocators, so one thread may
+    // use many allocators, most of which are destroyed while the thread is alive.
+    std::vector<std::unique_ptr<FixedBlockMemoryAllocator>> LiveAllocators;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        std::unique_ptr<FixedBlockMemoryAllocator> pAllocator{
+            new FixedBlockMemoryAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, 16, ThreadCacheSize}};
+
+        void* pMem = pAllocator->Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+        memset(pMem, 0xFF, AllocSize);
+        pAllocator->Free(pMem);
+
+        if (i % 64 == 0)
+            LiveAllocators.emplace_back(std::move(pAllocator));
+    }
+
+    for (auto& pAllocator : LiveAllocators)
+    {
+        void* pMem0 = pAllocator->Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+        void* pMem1 = pAllocator->Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+        EXPECT_NE(pMem0, pMem1);
+        pAllocator->Free(pMem1);
+        pAllocator->Free(pMem0);
+    }
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ThreadCacheMultithreaded)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr Uint32 ThreadCacheSize       = 16;
+    constexpr size_t NumThreads            = 4;
+    constexpr size_t NumAllocations        = 500;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize);
+
+    // Blocks allocated by one thread are freed by another
+    std::vector<std::vector<void*>> Allocations(NumThreads);
+    {
+        std::vector<std::thread> Threads;
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&TestAllocator, &Allocations, t]() {
+                auto& ThreadAllocations = Allocations[t];
+                for (size_t i = 0; i < NumAllocations; ++i)
+                {
+                    void* pMem = TestAllocator.Allocate(AllocSize, "Multithreaded thread cache test", __FILE__, __LINE__);
+                    memset(pMem, static_cast<int>(t), AllocSize);
+                    ThreadAllocations.push_back(pMem);
+                }
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    std::unordered_set<void*> UniqueAllocations;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        for (auto* pMem : Allocations[t])
+        {
+            EXPECT_TRUE(UniqueAllocations.insert(pMem).second);
+            EXPECT_EQ(static_cast<Uint8*>(pMem)[AllocSize - 1], static_cast<Uint8>(t));
+        }
+    }
+
+    {
+        std::vector<std::thread> Threads;
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&TestAllocator, &Allocations, t]() {
+                for (auto* pMem : Allocations[(t + 1) % NumThreads])
+                    TestAllocator.Free(pMem);
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -289,4 +405,186 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_DynamicLinearAllocator, Statistics)
+{
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 256};
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{0});
+    EXPECT_EQ(Allocator.GetReservedSize(), size_t{0});
+
+    void* Ptr0 = Allocator.Allocate(100, 1);
+    void* Ptr1 = Allocator.Allocate(100, 1);
+    EXPECT_EQ(static_cast<Uint8*>(Ptr1), static_cast<Uint8*>(Ptr0) + 100);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{200});
+    EXPECT_EQ(Allocator.GetReservedSize(), size_t{256});
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{1});
+
+    // Does not fit into the first block
+    void* Ptr2 = Allocator.Allocate(100, 1);
+    (void)Ptr2;
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{2});
+    EXPECT_EQ(Allocator.GetReservedSize(), size_t{512});
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{300});
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), size_t{300});
+
+    Allocator.Discard();
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{0});
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), size_t{300});
+    Allocator.ResetPeakUsedSize();
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), size_t{0});
+
+    // Pages are reused after Discard()
+    EXPECT_EQ(Allocator.Allocate(100, 1), Ptr0);
+    EXPECT_EQ(Allocator.Allocate(200, 1), Ptr2);
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{2});
+    EXPECT_EQ(Allocator.GetReservedSize(), size_t{512});
+}
+
+TEST(Common_DynamicLinearAllocator, Rollback)
+{
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 256};
+
+    const auto EmptyMarker = Allocator.GetMarker();
+
+    void* Ptr0 = Allocator.Allocate(64, 1);
+    (void)Ptr0;
+    {
+        DynamicLinearAllocatorScope Scope{Allocator};
+
+        void* Ptr1 = Allocator.Allocate(64, 1);
+        {
+            DynamicLinearAllocatorScope InnerScope{Allocator};
+            for (size_t i = 0; i < 10; ++i)
+                EXPECT_NE(Allocator.Allocate(128, 16), nullptr);
+            EXPECT_GT(Allocator.GetBlockCount(), size_t{1});
+        }
+        EXPECT_EQ(Allocator.GetUsedSize(), size_t{128});
+        // The next allocation follows Ptr1
+        EXPECT_EQ(Allocator.Allocate(8, 1), static_cast<Uint8*>(Ptr1) + 64);
+    }
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{64});
+
+    const auto NumBlocks    = Allocator.GetBlockCount();
+    const auto ReservedSize = Allocator.GetReservedSize();
+    {
+        DynamicLinearAllocatorScope Scope{Allocator};
+        for (size_t i = 0; i < 10; ++i)
+            EXPECT_NE(Allocator.Allocate(128, 16), nullptr);
+    }
+    // No new pages are created for the same allocations
+    EXPECT_EQ(Allocator.GetBlockCount(), NumBlocks);
+    EXPECT_EQ(Allocator.GetReservedSize(), ReservedSize);
+
+    Allocator.Rollback(EmptyMarker);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{0});
+    EXPECT_EQ(Allocator.Allocate(64, 1), Ptr0);
+}
+
+TEST(Common_DynamicLinearAllocator, ThreadLocal)
+{
+    auto& Allocator = GetThreadLocalLinearAllocator();
+    EXPECT_EQ(&Allocator, &GetThreadLocalLinearAllocator());
+
+    DynamicLinearAllocator* pOtherThreadAllocator = nullptr;
+    std::thread{[&]() { pOtherThreadAllocator = &GetThreadLocalLinearAllocator(); }}.join();
+    EXPECT_NE(pOtherThreadAllocator, &Allocator);
+
+    const auto UsedSize = Allocator.GetUsedSize();
+    {
+        DynamicLinearAllocatorScope Scope;
+        EXPECT_EQ(&Scope.GetAllocator(), &Allocator);
+        auto* pStr = Scope.GetAllocator().CopyString("thread-local");
+        EXPECT_STREQ(pStr, "thread-local");
+        EXPECT_GT(Allocator.GetUsedSize(), UsedSize);
+    }
+    EXPECT_EQ(Allocator.GetUsedSize(), UsedSize);
+}
+
+TEST(Common_TrackingMemoryAllocator, Tags)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    void* pUntagged = Allocator.Allocate(100, "Test", __FILE__, __LINE__);
+    EXPECT_EQ(reinterpret_cast<size_t>(pUntagged) % alignof(size_t), size_t{0});
+
+    void* pTagged0 = nullptr;
+    void* pTagged1 = nullptr;
+    {
+        MemoryAllocationTagScope Scope1{1};
+        pTagged0 = Allocator.Allocate(200, "Test", __FILE__, __LINE__);
+        {
+            MemoryAllocationTagScope Scope2{2};
+            pTagged1 = Allocator.Allocate(300, "Test", __FILE__, __LINE__);
+        }
+        EXPECT_EQ(TrackingMemoryAllocator::GetThreadTag(), Uint32{1});
+    }
+    EXPECT_EQ(TrackingMemoryAllocator::GetThreadTag(), Uint32{0});
+
+    {
+        const TrackingMemoryAllocator::TagStatistics Stats0 = Allocator.GetTagStatistics(0);
+        EXPECT_EQ(Stats0.CurrentSize, size_t{100});
+        EXPECT_EQ(Stats0.CurrentAllocationCount, size_t{1});
+
+        const TrackingMemoryAllocator::TagStatistics Stats1 = Allocator.GetTagStatistics(1);
+        EXPECT_EQ(Stats1.CurrentSize, size_t{200});
+        EXPECT_EQ(Stats1.PeakSize, size_t{200});
+
+        const TrackingMemoryAllocator::TagStatistics Stats2 = Allocator.GetTagStatistics(2);
+        EXPECT_EQ(Stats2.CurrentSize, size_t{300});
+        EXPECT_EQ(Stats2.TotalAllocationCount, Uint64{1});
+    }
+
+    // Memory is attributed to the allocation tag, not to the tag that is active when it is released
+    {
+        MemoryAllocationTagScope Scope{3};
+        Allocator.Free(pTagged1);
+    }
+    Allocator.Free(pTagged0);
+    Allocator.Free(pUntagged);
+
+    for (Uint32 Tag = 0; Tag < TrackingMemoryAllocator::MaxTags; ++Tag)
+    {
+        const TrackingMemoryAllocator::TagStatistics Stats = Allocator.GetTagStatistics(Tag);
+        EXPECT_EQ(Stats.CurrentSize, size_t{0});
+        EXPECT_EQ(Stats.CurrentAllocationCount, size_t{0});
+    }
+    EXPECT_EQ(Allocator.GetTagStatistics(2).PeakSize, size_t{300});
+
+    Allocator.ResetPeakSizes();
+    EXPECT_EQ(Allocator.GetTagStatistics(2).PeakSize, size_t{0});
+}
+
+TEST(Common_TrackingMemoryAllocator, Multithreaded)
+{
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr Uint32 NumThreads     = 4;
+    constexpr size_t NumAllocations = 1000;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Allocator, t]() {
+                MemoryAllocationTagScope Scope{1 + t % 2};
+
+                std::vector<void*> Ptrs(NumAllocations);
+                for (size_t i = 0; i < NumAllocations; ++i)
+                    Ptrs[i] = Allocator.Allocate(16 + i, "Test", __FILE__, __LINE__);
+                for (void* Ptr : Ptrs)
+                    Allocator.Free(Ptr);
+            });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    for (Uint32 Tag = 1; Tag <= 2; ++Tag)
+    {
+        const TrackingMemoryAllocator::TagStatistics Stats = Allocator.GetTagStatistics(Tag);
+        EXPECT_EQ(Stats.CurrentSize, size_t{0});
+        EXPECT_EQ(Stats.CurrentAllocationCount, size_t{0});
+        EXPECT_EQ(Stats.TotalAllocationCount, Uint64{NumAllocations * NumThreads / 2});
+        EXPECT_GE(Stats.PeakSize, (16 + 16 + NumAllocations - 1) * NumAllocations / 2);
+    }
+}
+
 } // namespace
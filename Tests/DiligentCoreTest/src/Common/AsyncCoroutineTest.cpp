@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "AsyncCoroutine.hpp"
+
+#include "gtest/gtest.h"
+
+#if DILIGENT_COROUTINES_SUPPORTED
+
+#    include <atomic>
+#    include <thread>
+
+using namespace Diligent;
+
+namespace
+{
+
+AsyncCoroutine RunOnThreadPool(IThreadPool* pThreadPool, std::thread::id CallerId, std::atomic<bool>& Done)
+{
+    co_await ResumeOn(pThreadPool);
+    EXPECT_NE(std::this_thread::get_id(), CallerId);
+    Done.store(true);
+}
+
+TEST(Common_AsyncCoroutine, ResumeOn)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<bool> Done{false};
+
+    auto Coro = RunOnThreadPool(pThreadPool, std::this_thread::get_id(), Done);
+    Coro.GetTask()->WaitForCompletion();
+    EXPECT_EQ(Coro.GetTask()->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_TRUE(Done);
+
+    pThreadPool->WaitForAllTasks();
+}
+
+
+class CancelledTask final : public AsyncTaskBase
+{
+public:
+    using AsyncTaskBase::AsyncTaskBase;
+
+    virtual void Run(Uint32 ThreadId) override final
+    {
+        SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+    }
+};
+
+AsyncCoroutine AwaitTasks(IThreadPool* pThreadPool, std::atomic<int>& Counter, std::atomic<int>& Result)
+{
+    // Wait for the task without blocking the thread
+    auto pTask = EnqueueAsyncWork(pThreadPool, [&Counter](Uint32) { Counter.fetch_add(1); });
+
+    auto Status = co_await AwaitTask(pThreadPool, pTask);
+    EXPECT_EQ(Status, ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(Counter.load(), 1);
+
+    // The coroutine is resumed if the awaited task is cancelled
+    RefCntAutoPtr<CancelledTask> pCancelledTask{MakeNewRCObj<CancelledTask>()()};
+    pThreadPool->EnqueueTask(pCancelledTask);
+
+    Status = co_await AwaitTask(pThreadPool, pCancelledTask);
+    EXPECT_EQ(Status, ASYNC_TASK_STATUS_CANCELLED);
+
+    Result.store(Counter.load() + 1);
+}
+
+AsyncCoroutine AwaitCoroutine(IThreadPool* pThreadPool, std::atomic<int>& Counter, std::atomic<int>& Result)
+{
+    auto Inner = AwaitTasks(pThreadPool, Counter, Result);
+
+    const auto Status = co_await AwaitTask(pThreadPool, Inner.GetTask());
+    EXPECT_EQ(Status, ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(Result.load(), 2);
+    Result.store(3);
+}
+
+TEST(Common_AsyncCoroutine, AwaitTask)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        std::atomic<int> Counter{0};
+        std::atomic<int> Result{0};
+
+        auto Coro = AwaitCoroutine(pThreadPool, Counter, Result);
+        Coro.GetTask()->WaitForCompletion();
+        EXPECT_EQ(Coro.GetTask()->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_EQ(Result.load(), 3);
+    }
+
+    pThreadPool->WaitForAllTasks();
+}
+
+
+AsyncCoroutine AwaitResult(AsyncResult<int> Result, std::atomic<int>& Value)
+{
+    Value.store(co_await Result);
+}
+
+TEST(Common_AsyncCoroutine, AsyncResult)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (IThreadPool* pPool : {static_cast<IThreadPool*>(pThreadPool), static_cast<IThreadPool*>(nullptr)})
+    {
+        // Result is set after the coroutine is suspended
+        {
+            AsyncResult<int> Result{pPool};
+            std::atomic<int> Value{0};
+
+            auto Coro = AwaitResult(Result, Value);
+            EXPECT_FALSE(Coro.GetTask()->IsFinished());
+            EXPECT_FALSE(Result.IsReady());
+
+            std::thread Producer{[Result] { Result.SetResult(42); }};
+            Producer.join();
+
+            Coro.GetTask()->WaitForCompletion();
+            EXPECT_EQ(Value.load(), 42);
+        }
+
+        // Result is set before the coroutine awaits it
+        {
+            AsyncResult<int> Result{pPool};
+            std::atomic<int> Value{0};
+
+            Result.SetResult(7);
+            EXPECT_TRUE(Result.IsReady());
+
+            auto Coro = AwaitResult(Result, Value);
+            EXPECT_TRUE(Coro.GetTask()->IsFinished());
+            EXPECT_EQ(Value.load(), 7);
+        }
+    }
+
+    pThreadPool->WaitForAllTasks();
+}
+
+} // namespace
+
+#endif // DILIGENT_COROUTINES_SUPPORTED
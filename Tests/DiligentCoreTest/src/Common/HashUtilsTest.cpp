@@ -29,8 +29,11 @@
 #include <unordered_set>
 #include <array>
 #include <vector>
+#include <algorithm>
 
 #include "HashUtils.hpp"
+#include "Timer.hpp"
+#include "DebugOutput.h"
 #include "XXH128Hasher.hpp"
 #include "GraphicsTypesOutputInserters.hpp"
 
@@ -186,6 +189,82 @@ TEST(Common_HashUtils, ComputeHashRaw)
     }
 }
 
+TEST(Common_HashUtils, ComputeHashRawXXH3)
+{
+    std::vector<Uint8> RefData(1024);
+    for (size_t i = 0; i < RefData.size(); ++i)
+        RefData[i] = static_cast<Uint8>((i * 7919u) >> 3);
+
+    std::unordered_set<size_t> Hashes;
+    for (size_t size : {ComputeHashRawXXH3Threshold - 1, ComputeHashRawXXH3Threshold, size_t{100}, size_t{257}, size_t{1000}})
+    {
+        const auto RefHash = ComputeHashRaw(RefData.data(), size);
+        EXPECT_TRUE(Hashes.insert(RefHash).second) << size;
+        if (size >= ComputeHashRawXXH3Threshold)
+            EXPECT_EQ(RefHash, ComputeHashRawXXH3(RefData.data(), size));
+        else
+            EXPECT_EQ(RefHash, ComputeHashRawCombine(RefData.data(), size));
+
+        for (size_t offset = 1; offset < 8; ++offset)
+        {
+            std::vector<Uint8> Data(size + offset);
+            std::copy(RefData.begin(), RefData.begin() + size, Data.begin() + offset);
+            EXPECT_EQ(RefHash, ComputeHashRaw(&Data[offset], size)) << offset << " " << size;
+        }
+    }
+}
+
+TEST(Common_HashUtils, HashedValue)
+{
+    SamplerDesc Desc1;
+    SamplerDesc Desc2;
+    Desc2.MaxAnisotropy = 8;
+
+    HashedValue<SamplerDesc> Val1{Desc1};
+    HashedValue<SamplerDesc> Val2{Desc2};
+    EXPECT_EQ(Val1.GetHash(), std::hash<SamplerDesc>{}(Desc1));
+    EXPECT_EQ(Val2.GetHash(), std::hash<SamplerDesc>{}(Desc2));
+    EXPECT_EQ(Val1, HashedValue<SamplerDesc>{Desc1});
+    EXPECT_NE(Val1, Val2);
+    EXPECT_EQ(Val2.Get(), Desc2);
+
+    std::unordered_map<HashedValue<SamplerDesc>, int> Map;
+    Map.emplace(Val1, 1);
+    Map.emplace(Val2, 2);
+    EXPECT_EQ(Map[HashedValue<SamplerDesc>{Desc1}], 1);
+    EXPECT_EQ(Map[HashedValue<SamplerDesc>{Desc2}], 2);
+}
+
+TEST(Common_HashUtils, ComputeHashRawBenchmark)
+{
+    for (size_t Size : {size_t{64}, size_t{256}, size_t{4096}, size_t{1 << 20}})
+    {
+        std::vector<Uint8> Data(Size);
+        for (size_t i = 0; i < Data.size(); ++i)
+            Data[i] = static_cast<Uint8>(i * 31u);
+
+        const size_t NumIterations = std::max(size_t{16} * 1024 * 1024 / Size, size_t{4});
+
+        auto Measure = [&](auto&& HashFunc) {
+            size_t Res = 0;
+            Timer  T;
+            for (size_t i = 0; i < NumIterations; ++i)
+            {
+                Data[0] = static_cast<Uint8>(i);
+                Res += HashFunc(Data.data(), Data.size());
+            }
+            const auto Time = T.GetElapsedTime();
+            EXPECT_NE(Res, size_t{0});
+            return Time;
+        };
+
+        const auto CombineTime = Measure(ComputeHashRawCombine);
+        const auto XXH3Time    = Measure(ComputeHashRawXXH3);
+        LOG_INFO_MESSAGE("ComputeHashRaw ", Size, " bytes: combine ", CombineTime * 1000, " ms, XXH3 ", XXH3Time * 1000,
+                         " ms, speedup ", XXH3Time > 0 ? CombineTime / XXH3Time : 0, "x");
+    }
+}
+
 
 template <typename Type>
 class StdHasherTestHelper
@@ -978,6 +1057,7 @@ void TestGraphicsPipelineDescHasher()
     TEST_RANGE(NumViewports, Uint8{2u}, Uint8{32u});
     TEST_RANGE(SubpassIndex, Uint8{1u}, Uint8{8u});
     TEST_FLAGS(ShadingRateFlags, static_cast<PIPELINE_SHADING_RATE_FLAGS>(1), PIPELINE_SHADING_RATE_FLAG_LAST);
+    TEST_FLAGS(DynamicStateFlags, static_cast<PIPELINE_DYNAMIC_STATE_FLAGS>(1), PIPELINE_DYNAMIC_STATE_FLAG_LAST);
 
     for (Uint8 i = 1; i < MAX_RENDER_TARGETS; ++i)
     {
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "LZCompression.hpp"
+
+#include <vector>
+#include <cstring>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void TestRoundTrip(const std::vector<Uint8>& SrcData, size_t MaxCompressedSize)
+{
+    std::vector<Uint8> Compressed(GetLZCompressedSizeBound(SrcData.size()));
+
+    const auto CompressedSize = LZCompress(SrcData.data(), SrcData.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    EXPECT_LE(CompressedSize, MaxCompressedSize);
+
+    std::vector<Uint8> Decompressed(SrcData.size());
+    EXPECT_TRUE(LZDecompress(Compressed.data(), CompressedSize, Decompressed.data(), Decompressed.size()));
+    EXPECT_EQ(Decompressed, SrcData);
+}
+
+TEST(Common_LZCompression, Empty)
+{
+    TestRoundTrip({}, 1);
+}
+
+TEST(Common_LZCompression, Repetitive)
+{
+    std::vector<Uint8> Data(1 << 20);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i % 7);
+    TestRoundTrip(Data, Data.size() / 100);
+
+    // Single repeated byte exercises overlapping matches
+    TestRoundTrip(std::vector<Uint8>(1000, 0xAB), 16);
+}
+
+TEST(Common_LZCompression, Random)
+{
+    FastRandInt        Rnd{0, 0, 255};
+    std::vector<Uint8> Data(100000);
+    for (auto& Byte : Data)
+        Byte = static_cast<Uint8>(Rnd());
+    TestRoundTrip(Data, GetLZCompressedSizeBound(Data.size()));
+
+    // Short inputs that do not contain a single match
+    for (size_t Size = 1; Size < 20; ++Size)
+        TestRoundTrip({Data.begin(), Data.begin() + Size}, GetLZCompressedSizeBound(Size));
+}
+
+TEST(Common_LZCompression, Text)
+{
+    std::string Text;
+    for (int i = 0; i < 500; ++i)
+        Text += "OpTypeVector %float " + std::to_string(i % 4) + "\nOpDecorate %gl_Position BuiltIn Position\n";
+    TestRoundTrip({Text.begin(), Text.end()}, Text.size() / 3);
+}
+
+TEST(Common_LZCompression, SmallDestination)
+{
+    std::vector<Uint8> Data(256);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i);
+
+    std::vector<Uint8> Compressed(Data.size() / 2);
+    EXPECT_EQ(LZCompress(Data.data(), Data.size(), Compressed.data(), Compressed.size()), size_t{0});
+}
+
+TEST(Common_LZCompression, InvalidData)
+{
+    std::vector<Uint8> Data(4096);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>((i * i) % 13);
+
+    std::vector<Uint8> Compressed(GetLZCompressedSizeBound(Data.size()));
+    const auto         CompressedSize = LZCompress(Data.data(), Data.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    Compressed.resize(CompressedSize);
+
+    std::vector<Uint8> Decompressed(Data.size());
+
+    // Wrong decompressed size
+    EXPECT_FALSE(LZDecompress(Compressed.data(), Compressed.size(), Decompressed.data(), Decompressed.size() - 1));
+    EXPECT_FALSE(LZDecompress(Compressed.data(), Compressed.size(), Decompressed.data(), Decompressed.size() / 2));
+
+    // Truncated stream
+    EXPECT_FALSE(LZDecompress(Compressed.data(), Compressed.size() / 2, Decompressed.data(), Decompressed.size()));
+
+    // Empty stream
+    EXPECT_FALSE(LZDecompress(Compressed.data(), 0, Decompressed.data(), Decompressed.size()));
+
+    // Corrupted bytes must never cause out-of-bounds access
+    FastRandInt Rnd{1, 0, 255};
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto Corrupted                      = Compressed;
+        Corrupted[Rnd() % Corrupted.size()] = static_cast<Uint8>(Rnd());
+        LZDecompress(Corrupted.data(), Corrupted.size(), Decompressed.data(), Decompressed.size());
+    }
+}
+
+} // namespace
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstring>
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+#include "DebugOutput.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+#if DILIGENT_SIMD_MATH
+
+void ExpectEqual(const float* pSIMD, const float* pScalar, size_t Count)
+{
+    for (size_t i = 0; i < Count; ++i)
+    {
+#    if DILIGENT_SIMD_MATH_SSE
+        // SSE code must match the scalar code bit for bit
+        EXPECT_EQ(memcmp(&pSIMD[i], &pScalar[i], sizeof(float)), 0) << "Element " << i << ": " << pSIMD[i] << " vs " << pScalar[i];
+#    else
+        // The compiler may contract scalar code into FMA instructions
+        EXPECT_NEAR(pSIMD[i], pScalar[i], std::abs(pScalar[i]) * 1e-5f) << "Element " << i;
+#    endif
+    }
+}
+
+float4x4 RandomMatrix(FastRandReal<float>& Rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 16; ++i)
+        m.Data()[i] = Rnd();
+    return m;
+}
+
+TEST(Common_BasicMathSIMD, Matrix4x4)
+{
+    FastRandReal<float> Rnd{0, -10.f, 10.f};
+    for (int test = 0; test < 1000; ++test)
+    {
+        const auto m1 = RandomMatrix(Rnd);
+        const auto m2 = RandomMatrix(Rnd);
+
+        float4x4 Res;
+        SIMD::Matrix4x4Mul(m1.Data(), m2.Data(), Res.Data());
+        ExpectEqual(Res.Data(), (m1 * m2).Data(), 16);
+
+        SIMD::Matrix4x4Transpose(m1.Data(), Res.Data());
+        ExpectEqual(Res.Data(), m1.Transpose().Data(), 16);
+
+        SIMD::Matrix4x4Inverse(m1.Data(), Res.Data());
+        ExpectEqual(Res.Data(), m1.Inverse().Data(), 16);
+
+        const float4 v{Rnd(), Rnd(), Rnd(), Rnd()};
+        float4       vRes;
+        SIMD::Vector4MulMatrix4x4(v.Data(), m1.Data(), vRes.Data());
+        ExpectEqual(vRes.Data(), (v * m1).Data(), 4);
+    }
+
+    // Aliased output
+    {
+        const auto m1 = RandomMatrix(Rnd);
+        const auto m2 = RandomMatrix(Rnd);
+
+        auto Res = m1;
+        SIMD::Matrix4x4Mul(Res.Data(), m2.Data(), Res.Data());
+        ExpectEqual(Res.Data(), (m1 * m2).Data(), 16);
+
+        Res = m1;
+        SIMD::Matrix4x4Inverse(Res.Data(), Res.Data());
+        ExpectEqual(Res.Data(), m1.Inverse().Data(), 16);
+    }
+}
+
+TEST(Common_BasicMathSIMD, Quaternion)
+{
+    FastRandReal<float> Rnd{0, -1.f, 1.f};
+    for (int test = 0; test < 1000; ++test)
+    {
+        const Quaternion q1{Rnd(), Rnd(), Rnd(), Rnd()};
+        const Quaternion q2{Rnd(), Rnd(), Rnd(), Rnd()};
+
+        Quaternion Res;
+        SIMD::QuaternionMul(q1.q.Data(), q2.q.Data(), Res.q.Data());
+        ExpectEqual(Res.q.Data(), (q1 * q2).q.Data(), 4);
+    }
+}
+
+template <typename OpType>
+double MeasureTime(OpType&& Op)
+{
+    Timer T;
+    Op();
+    return T.GetElapsedTime();
+}
+
+// Compares the performance of the SIMD functions with the BasicMath implementation
+// (which is scalar unless DILIGENT_USE_SIMD_MATH is enabled).
+TEST(Common_BasicMathSIMD, Benchmark)
+{
+    constexpr size_t NumObjects    = 1024;
+    constexpr int    NumIterations = 64;
+
+    FastRandReal<float>   Rnd{0, -1.f, 1.f};
+    std::vector<float4x4> Matrices(NumObjects);
+    std::vector<float4>   Vectors(NumObjects);
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        Matrices[i] = RandomMatrix(Rnd);
+        for (int j = 0; j < 4; ++j)
+            Matrices[i][j][j] += 8.f; // Keep the matrices well-conditioned
+        Vectors[i]  = float4{Rnd(), Rnd(), Rnd(), 1};
+    }
+    std::vector<float4x4> MatResults(NumObjects);
+    std::vector<float4>   VecResults(NumObjects);
+    MatResults[0] = float4x4::Identity();
+
+    // Transform hierarchy: multiply every matrix by its parent
+    const auto MulBasic = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 1; i < NumObjects; ++i)
+                MatResults[i] = Matrices[i] * MatResults[(i - 1) / 2];
+    });
+    const auto MulSIMD = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 1; i < NumObjects; ++i)
+                SIMD::Matrix4x4Mul(Matrices[i].Data(), MatResults[(i - 1) / 2].Data(), MatResults[i].Data());
+    });
+
+    const auto InvBasic = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 0; i < NumObjects; ++i)
+                MatResults[i] = Matrices[i].Inverse();
+    });
+    const auto InvSIMD = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 0; i < NumObjects; ++i)
+                SIMD::Matrix4x4Inverse(Matrices[i].Data(), MatResults[i].Data());
+    });
+
+    // Skinning/culling: transform vectors by matrices
+    const auto TransformBasic = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 0; i < NumObjects; ++i)
+                VecResults[i] = Vectors[i] * Matrices[(i + it) % NumObjects];
+    });
+    const auto TransformSIMD = MeasureTime([&]() {
+        for (int it = 0; it < NumIterations; ++it)
+            for (size_t i = 0; i < NumObjects; ++i)
+                SIMD::Vector4MulMatrix4x4(Vectors[i].Data(), Matrices[(i + it) % NumObjects].Data(), VecResults[i].Data());
+    });
+
+    const auto Report = [](const char* Op, double Basic, double SIMD) {
+        LOG_INFO_MESSAGE(Op, ": basic ", Basic * 1000, " ms, SIMD ", SIMD * 1000, " ms, speedup ", SIMD > 0 ? Basic / SIMD : 0, "x");
+    };
+    Report("float4x4 multiply", MulBasic, MulSIMD);
+    Report("float4x4 inverse", InvBasic, InvSIMD);
+    Report("float4 * float4x4", TransformBasic, TransformSIMD);
+
+    // Prevent the results from being optimized away
+    float Sum = 0;
+    for (size_t i = 0; i < NumObjects; ++i)
+        Sum += MatResults[i]._11 + VecResults[i].x;
+    volatile float Sink = Sum;
+    (void)Sink;
+}
+
+#else
+
+TEST(Common_BasicMathSIMD, Matrix4x4)
+{
+    GTEST_SKIP() << "SIMD math is not supported on this platform";
+}
+
+#endif
+
+} // namespace
@@ -27,9 +27,11 @@
 
 #include <climits>
 #include <sstream>
+#include <vector>
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -2382,4 +2384,90 @@ TEST(Common_AdvancedMath, CheckLineSectionOverlap)
     EXPECT_FALSE(CheckLineSectionOverlap<false>(10, 20, 0, 10));
 }
 
+TEST(Common_AdvancedMath, GetBoxVisibilityBatch)
+{
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 100.f, false), Frustum, false);
+    // Normalize the planes for the sphere test
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+    {
+        auto&       Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+        const float Len   = length(Plane.Normal);
+        Plane.Normal /= Len;
+        Plane.Distance /= Len;
+    }
+
+    constexpr size_t   NumObjects = 1000;
+    std::vector<float> MinX(NumObjects), MinY(NumObjects), MinZ(NumObjects);
+    std::vector<float> MaxX(NumObjects), MaxY(NumObjects), MaxZ(NumObjects);
+    std::vector<float> Radius(NumObjects);
+
+    FastRandReal<float> Rnd{0, -1.f, 1.f};
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        const float3 Center{Rnd() * 100.f, Rnd() * 100.f, Rnd() * 60.f + 50.f};
+        const float3 Extent{std::abs(Rnd()) * 10.f, std::abs(Rnd()) * 10.f, std::abs(Rnd()) * 10.f};
+
+        MinX[i]   = Center.x - Extent.x;
+        MinY[i]   = Center.y - Extent.y;
+        MinZ[i]   = Center.z - Extent.z;
+        MaxX[i]   = Center.x + Extent.x;
+        MaxY[i]   = Center.y + Extent.y;
+        MaxZ[i]   = Center.z + Extent.z;
+        Radius[i] = Extent.x;
+    }
+
+    BoundBoxesSoA Boxes;
+    Boxes.MinX = MinX.data();
+    Boxes.MinY = MinY.data();
+    Boxes.MinZ = MinZ.data();
+    Boxes.MaxX = MaxX.data();
+    Boxes.MaxY = MaxY.data();
+    Boxes.MaxZ = MaxZ.data();
+
+    // Sphere centers are the box min corners
+    BoundSpheresSoA Spheres;
+    Spheres.CenterX = MinX.data();
+    Spheres.CenterY = MinY.data();
+    Spheres.CenterZ = MinZ.data();
+    Spheres.Radius  = Radius.data();
+
+    for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_LEFT_PLANE})
+    {
+        // Test the whole range and two sub-ranges
+        std::vector<Uint32> BoxBits((NumObjects + 31) / 32, 0xCDCDCDCDu);
+        GetBoxVisibilityBatch(Frustum, Boxes, 0, 512, BoxBits.data(), PlaneFlags);
+        GetBoxVisibilityBatch(Frustum, Boxes, 512, NumObjects - 512, BoxBits.data(), PlaneFlags);
+
+        std::vector<Uint32> SphereBits((NumObjects + 31) / 32, 0xCDCDCDCDu);
+        GetSphereVisibilityBatch(Frustum, Spheres, 0, NumObjects, SphereBits.data(), PlaneFlags);
+
+        size_t NumVisible = 0;
+        for (size_t i = 0; i < NumObjects; ++i)
+        {
+            const BoundBox Box{float3{MinX[i], MinY[i], MinZ[i]}, float3{MaxX[i], MaxY[i], MaxZ[i]}};
+
+            const bool IsBoxVisible = GetBoxVisibility(Frustum, Box, PlaneFlags) != BoxVisibility::Invisible;
+            EXPECT_EQ((BoxBits[i / 32] & (1u << (i % 32))) != 0, IsBoxVisible) << "Box " << i;
+            NumVisible += IsBoxVisible ? 1 : 0;
+
+            bool IsSphereVisible = true;
+            for (Uint32 plane = 0; plane < ViewFrustum::NUM_PLANES; ++plane)
+            {
+                if ((PlaneFlags & (1 << plane)) == 0)
+                    continue;
+                const auto& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane));
+                if (MinX[i] * Plane.Normal.x + MinY[i] * Plane.Normal.y + MinZ[i] * Plane.Normal.z + Plane.Distance < -Radius[i])
+                    IsSphereVisible = false;
+            }
+            EXPECT_EQ((SphereBits[i / 32] & (1u << (i % 32))) != 0, IsSphereVisible) << "Sphere " << i;
+        }
+        EXPECT_GT(NumVisible, size_t{0});
+        EXPECT_LT(NumVisible, NumObjects);
+
+        // Bits beyond the range must be cleared
+        EXPECT_EQ(BoxBits.back() >> (NumObjects % 32), 0u);
+    }
+}
+
 } // namespace
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "MetricsRegistry.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_MetricsRegistry, HistogramBuckets)
+{
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(0), 0u);
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(1), 0u);
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(2), 1u);
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(3), 1u);
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(1000), 9u);
+    EXPECT_EQ(MetricAccumulator::GetHistogramBucket(Uint64{1} << 40), MetricAccumulator::NumHistogramBuckets - 1);
+}
+
+TEST(Common_MetricsRegistry, Accumulate)
+{
+    MetricsRegistry Registry{2};
+    EXPECT_EQ(Registry.GetNumMetrics(), 2u);
+
+    MetricAccumulator& Metric = Registry.Get(1);
+    Metric.Add(10);
+    Metric.Add(1000);
+
+    MetricAccumulator::Snapshot Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.Count, 2u);
+    EXPECT_EQ(Snap.Total, 1010u);
+    EXPECT_EQ(Snap.Max, 1000u);
+    EXPECT_EQ(Snap.LastFrameCount, 0u);
+    EXPECT_EQ(Snap.Histogram[3], 1u);
+    EXPECT_EQ(Snap.Histogram[9], 1u);
+
+    Registry.EndFrame();
+    Metric.Add(5);
+
+    Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.Count, 3u);
+    EXPECT_EQ(Snap.LastFrameCount, 2u);
+    EXPECT_EQ(Snap.LastFrameTotal, 1010u);
+
+    Registry.EndFrame();
+    Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.LastFrameCount, 1u);
+    EXPECT_EQ(Snap.LastFrameTotal, 5u);
+
+    EXPECT_EQ(Registry.Get(0).GetSnapshot().Count, 0u);
+
+    Registry.Reset();
+    Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.Count, 0u);
+    EXPECT_EQ(Snap.Max, 0u);
+    EXPECT_EQ(Snap.LastFrameCount, 0u);
+    EXPECT_EQ(Snap.Histogram[9], 0u);
+}
+
+TEST(Common_MetricsRegistry, TimerScope)
+{
+    MetricAccumulator Metric;
+    {
+        MetricTimerScope Scope{&Metric};
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    {
+        // Null metric is ignored
+        MetricTimerScope Scope{nullptr};
+    }
+
+    const MetricAccumulator::Snapshot Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.Count, 1u);
+    EXPECT_GE(Snap.Total, 1000000u);
+    EXPECT_EQ(Snap.Max, Snap.Total);
+}
+
+TEST(Common_MetricsRegistry, Multithreaded)
+{
+    MetricAccumulator Metric;
+
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumValues  = 10000;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Metric]() {
+            for (Uint32 i = 0; i < NumValues; ++i)
+                Metric.Add(i);
+        });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    const MetricAccumulator::Snapshot Snap = Metric.GetSnapshot();
+    EXPECT_EQ(Snap.Count, Uint64{NumThreads} * NumValues);
+    EXPECT_EQ(Snap.Total, Uint64{NumThreads} * NumValues * (NumValues - 1) / 2);
+    EXPECT_EQ(Snap.Max, NumValues - 1);
+
+    Uint64 HistogramTotal = 0;
+    for (Uint64 Count : Snap.Histogram)
+        HistogramTotal += Count;
+    EXPECT_EQ(HistogramTotal, Snap.Count);
+}
+
+} // namespace
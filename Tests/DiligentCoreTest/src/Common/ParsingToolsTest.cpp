@@ -26,6 +26,9 @@
 
 #include "ParsingTools.hpp"
 
+#include <deque>
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "TestingEnvironment.hpp"
@@ -264,6 +267,70 @@ TEST(Common_ParsingTools, SkipIdentifier)
     Test("_a1b2c3[5]", "[5]");
 }
 
+// Long inputs are scanned by the vectorized functions when the iterators point into
+// a contiguous buffer. The results must be the same as for non-contiguous iterators.
+TEST(Common_ParsingTools, ContiguousFastPath)
+{
+    static_assert(IsContiguousCharIterator<const char*>::value, "const char* is contiguous");
+    static_assert(IsContiguousCharIterator<std::string::const_iterator>::value, "std::string::const_iterator is contiguous");
+    static_assert(!IsContiguousCharIterator<std::deque<char>::const_iterator>::value, "std::deque<char>::const_iterator is not contiguous");
+
+    // Every terminator is placed at all offsets within and after a 16-character group
+    const std::string Runs[] = {
+        " \t\r\n",
+        "abcXYZ_019azAZ_",
+        "abc def /* * / **",
+    };
+    const char Terminators[] = {'x', ' ', '\n', '\r', '*', '/', '\0', '_', '0', '@', '[', '`', '{', static_cast<char>(0x80), static_cast<char>(0xE9)};
+
+    for (const auto& Run : Runs)
+    {
+        for (size_t Len = 0; Len < 50; ++Len)
+        {
+            for (char Term : Terminators)
+            {
+                std::string Str;
+                for (size_t i = 0; i < Len; ++i)
+                    Str.push_back(Run[i % Run.size()]);
+                Str.push_back(Term);
+                Str.append("tail */ \n");
+
+                const std::deque<char> Deque{Str.begin(), Str.end()};
+
+                const char* Start = Str.c_str();
+                const char* End   = Start + Str.size();
+
+                auto Check = [&](const char* Pos, std::deque<char>::const_iterator RefPos, const char* Name) {
+                    EXPECT_EQ(Pos - Start, RefPos - Deque.begin()) << Name << ": '" << Str << "'";
+                };
+
+                Check(SkipDelimiters(Start, End), SkipDelimiters(Deque.begin(), Deque.end()), "SkipDelimiters");
+                Check(SkipIdentifier(Start, End), SkipIdentifier(Deque.begin(), Deque.end()), "SkipIdentifier");
+                Check(SkipLine(Start, End), SkipLine(Deque.begin(), Deque.end()), "SkipLine");
+                Check(SkipLine(Start, End, true), SkipLine(Deque.begin(), Deque.end(), true), "SkipLine");
+
+                const std::string Comment = "/*" + Str;
+                const std::string Line    = "//" + Str;
+                for (const std::string* pStr : {&Comment, &Line})
+                {
+                    // Returns the length of the comment or -1 if the comment is not closed
+                    auto GetCommentLength = [](const auto& Container) -> ptrdiff_t {
+                        try
+                        {
+                            return SkipComment(Container.begin(), Container.end()) - Container.begin();
+                        }
+                        catch (...)
+                        {
+                            return -1;
+                        }
+                    };
+                    EXPECT_EQ(GetCommentLength(*pStr), GetCommentLength(std::deque<char>{pStr->begin(), pStr->end()})) << "SkipComment: '" << *pStr << "'";
+                }
+            }
+        }
+    }
+}
+
 TEST(Common_ParsingTools, SplitString)
 {
     static const char* TestStr = R"(
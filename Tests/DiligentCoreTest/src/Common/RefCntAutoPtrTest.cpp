@@ -904,4 +904,113 @@ TEST(Common_RefCntAutoPtr, Threading)
     ThreadingTest.RunConcurrencyTest();
 }
 
+TEST(Common_RefCntWeakPtr, LockVsFinalRelease)
+{
+    class TestObject : public RefCountedObject<IObject>
+    {
+    public:
+        TestObject(IReferenceCounters* pRefCounters, std::atomic_int& NumDestroyed) :
+            RefCountedObject<IObject>{pRefCounters},
+            m_NumDestroyed{NumDestroyed}
+        {
+        }
+
+        ~TestObject()
+        {
+            m_NumDestroyed.fetch_add(1);
+        }
+
+        // RefCntWeakPtr::Lock() queries the owner object through IID_Unknown
+        virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+        {
+            *ppInterface = nullptr;
+            if (IID == IID_Unknown)
+            {
+                *ppInterface = this;
+                (*ppInterface)->AddRef();
+            }
+        }
+
+    private:
+        std::atomic_int& m_NumDestroyed;
+    };
+
+#ifdef DILIGENT_DEBUG
+    constexpr int NumIterations = 10000;
+#else
+    constexpr int NumIterations = 50000;
+#endif
+
+    RefCntAutoPtr<TestObject> pObj;
+    RefCntWeakPtr<TestObject> wpObj;
+
+    std::atomic_int NumDestroyed{0};
+    std::atomic_int NumLocked{0};
+    // Iteration that the worker threads are allowed to start
+    std::atomic_int StartIteration{-1};
+    std::atomic_int NumThreadsDone{0};
+
+    auto WaitStart = [&](int Iteration) {
+        while (StartIteration.load() < Iteration)
+            std::this_thread::yield();
+    };
+    // Alternate the thread that starts first and vary the delay
+    // so that both outcomes of the race are exercised
+    auto Delay = [](int Iteration) {
+        for (int i = 0; i < (Iteration / 2) % 4; ++i)
+            std::this_thread::yield();
+    };
+
+    // Releases the last strong reference
+    std::thread ReleaseThread{
+        [&]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                WaitStart(i);
+                if (i % 2 == 0)
+                    Delay(i);
+                pObj.Release();
+                NumThreadsDone.fetch_add(1);
+            }
+        }};
+
+    // Concurrently tries to promote the weak reference
+    std::thread LockThread{
+        [&]() {
+            for (int i = 0; i < NumIterations; ++i)
+            {
+                WaitStart(i);
+                if (i % 2 != 0)
+                    Delay(i);
+                if (auto pLocked = wpObj.Lock())
+                {
+                    // The object must not be destroyed while the strong reference is held
+                    EXPECT_EQ(NumDestroyed.load(), i);
+                    NumLocked.fetch_add(1);
+                }
+                NumThreadsDone.fetch_add(1);
+            }
+        }};
+
+    for (int i = 0; i < NumIterations; ++i)
+    {
+        pObj  = RefCntAutoPtr<TestObject>{MakeNewRCObj<TestObject>()(NumDestroyed)};
+        wpObj = pObj;
+
+        StartIteration.store(i);
+        while (NumThreadsDone.load() < 2 * (i + 1))
+            std::this_thread::yield();
+
+        // The object must be destroyed exactly once, by whichever thread released the last reference
+        EXPECT_EQ(NumDestroyed.load(), i + 1);
+        EXPECT_FALSE(wpObj.Lock());
+        EXPECT_FALSE(wpObj.IsValid());
+    }
+
+    ReleaseThread.join();
+    LockThread.join();
+
+    LOG_INFO_MESSAGE("Weak pointer was locked in ", NumLocked.load(), " of ", NumIterations, " iterations");
+}
+
 } // namespace
@@ -25,6 +25,7 @@
  */
 
 #include <cstring>
+#include <vector>
 
 #include "Serializer.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -172,4 +173,87 @@ TEST(SerializerTest, SerializerTest)
     }
 }
 
+TEST(SerializerTest, SerializeArrayView)
+{
+    const Uint8       RefU8                            = 0x72;
+    const Uint32      RefArraySize                     = 3;
+    const Uint64      RefArray[RefArraySize]           = {0x1234567890ABCDEFull, 0x2468ACE013579BDFull, 0x1122334455667788ull};
+    const Uint16*     RefEmptyArray                    = nullptr;
+    const Uint32      RefEmptySize                     = 0;
+    const char* const RefStr                           = "array view";
+    const Uint8       RefFloatArraySize                = 2;
+    const float       RefFloatArray[RefFloatArraySize] = {1.5f, -2.25f};
+
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const auto WriteData = [&](auto& Ser) {
+        return Ser(RefU8) &&
+            Ser.SerializeArrayView(nullptr, RefArray, RefArraySize) &&
+            Ser.SerializeArrayView(nullptr, RefEmptyArray, RefEmptySize) &&
+            Ser(RefStr) &&
+            Ser.SerializeArrayView(nullptr, RefFloatArray, RefFloatArraySize);
+    };
+
+    size_t MeasuredSize = 0;
+    auto   Data         = SerializeToData(RawAllocator, WriteData, &MeasuredSize);
+    ASSERT_TRUE(Data);
+    EXPECT_EQ(MeasuredSize, Data.Size());
+
+    // The second call uses the cached size
+    {
+        auto Data2 = SerializeToData(RawAllocator, WriteData, &MeasuredSize);
+        EXPECT_EQ(Data, Data2);
+    }
+
+    auto ReadData = [&](const SerializedData& Src, DynamicLinearAllocator* pAllocator, bool ExpectInPlace) {
+        Serializer<SerializerMode::Read> RSer{Src};
+
+        Uint8 U8 = 0;
+        EXPECT_TRUE(RSer(U8));
+        EXPECT_EQ(U8, RefU8);
+
+        const Uint64* pArray    = nullptr;
+        Uint32        ArraySize = 0;
+        EXPECT_TRUE(RSer.SerializeArrayView(pAllocator, pArray, ArraySize));
+        ASSERT_EQ(ArraySize, RefArraySize);
+        EXPECT_EQ(reinterpret_cast<size_t>(pArray) % alignof(Uint64), size_t{0});
+        EXPECT_EQ(std::memcmp(pArray, RefArray, sizeof(RefArray)), 0);
+        const bool InPlace = reinterpret_cast<const Uint8*>(pArray) >= Src.Ptr<const Uint8>() &&
+            reinterpret_cast<const Uint8*>(pArray) < Src.Ptr<const Uint8>() + Src.Size();
+        EXPECT_EQ(InPlace, ExpectInPlace);
+
+        const Uint16* pEmptyArray = nullptr;
+        Uint32        EmptySize   = ~0u;
+        EXPECT_TRUE(RSer.SerializeArrayView(pAllocator, pEmptyArray, EmptySize));
+        EXPECT_EQ(EmptySize, 0u);
+        EXPECT_EQ(pEmptyArray, nullptr);
+
+        const char* Str = nullptr;
+        EXPECT_TRUE(RSer(Str));
+        EXPECT_STREQ(Str, RefStr);
+
+        const float* pFloatArray    = nullptr;
+        Uint8        FloatArraySize = 0;
+        EXPECT_TRUE(RSer.SerializeArrayView(pAllocator, pFloatArray, FloatArraySize));
+        ASSERT_EQ(FloatArraySize, RefFloatArraySize);
+        EXPECT_EQ(pFloatArray[0], RefFloatArray[0]);
+        EXPECT_EQ(pFloatArray[1], RefFloatArray[1]);
+
+        EXPECT_TRUE(RSer.IsEnded());
+    };
+
+    // Aligned source data - arrays are read in place
+    ReadData(Data, nullptr, true);
+
+    // Misaligned source data - arrays are copied
+    {
+        std::vector<Uint8> Buffer(Data.Size() + 1);
+        std::memcpy(Buffer.data() + 1, Data.Ptr(), Data.Size());
+        const SerializedData MisalignedData{Buffer.data() + 1, Data.Size()};
+
+        DynamicLinearAllocator TmpAllocator{RawAllocator};
+        ReadData(MisalignedData, &TmpAllocator, false);
+    }
+}
+
 } // namespace
@@ -28,6 +28,9 @@
 
 #include <vector>
 #include <thread>
+#include <mutex>
+
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -71,4 +74,105 @@ TEST(Common_SpinLock, ThreadContention)
     }
 }
 
+template <typename LockType>
+double RunContentionTest(LockType& Lock, size_t NumThreads, size_t NumThreadIterations, size_t& Counter)
+{
+    Timer                    T;
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads);
+    for (size_t i = 0; i < NumThreads; ++i)
+    {
+        Workers.emplace_back(
+            [&Lock, &Counter, NumThreadIterations] //
+            {
+                for (size_t i = 0; i < NumThreadIterations; ++i)
+                {
+                    std::lock_guard<LockType> Guard{Lock};
+                    ++Counter;
+                }
+            });
+    }
+    for (auto& Thread : Workers)
+        Thread.join();
+
+    return T.GetElapsedTime();
+}
+
+TEST(Common_AdaptiveSpinLock, ThreadContention)
+{
+    const auto NumCores   = std::thread::hardware_concurrency();
+    const auto NumThreads = NumCores * 8;
+
+    static constexpr size_t     NumThreadIterations = 32768;
+    Threading::AdaptiveSpinLock Lock;
+
+    size_t Counter = 0;
+    RunContentionTest(Lock, NumThreads, NumThreadIterations, Counter);
+
+    {
+        Threading::AdaptiveSpinLockGuard Guard{Lock};
+        EXPECT_EQ(Counter, NumThreadIterations * NumThreads);
+    }
+    EXPECT_FALSE(Lock.is_locked());
+
+    const auto Stats = Lock.GetStatistics();
+    LOG_INFO_MESSAGE("AdaptiveSpinLock contention: ", Stats.ContentionCount, " contended locks, ", Stats.YieldCount, " yields, ", Stats.ParkCount, " parks");
+
+    Lock.ResetStatistics();
+    EXPECT_EQ(Lock.GetStatistics().ContentionCount, 0u);
+}
+
+TEST(Common_AdaptiveSpinLock, TryLock)
+{
+    Threading::AdaptiveSpinLock Lock;
+    EXPECT_TRUE(Lock.try_lock());
+    EXPECT_TRUE(Lock.is_locked());
+    EXPECT_FALSE(Lock.try_lock());
+
+    // Another thread must park until the lock is released
+    bool Acquired = false;
+
+    std::thread Waiter{
+        [&]() {
+            Threading::AdaptiveSpinLockGuard Guard{Lock};
+            Acquired = true;
+        }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    Lock.unlock();
+    Waiter.join();
+
+    EXPECT_TRUE(Acquired);
+    EXPECT_FALSE(Lock.is_locked());
+    EXPECT_EQ(Lock.GetStatistics().ContentionCount, 1u);
+    EXPECT_EQ(Lock.GetStatistics().ParkCount, 1u);
+}
+
+TEST(Common_AdaptiveSpinLock, Benchmark)
+{
+    const auto NumCores = std::thread::hardware_concurrency();
+
+    static constexpr size_t NumThreadIterations = 16384;
+    for (size_t NumThreads : {size_t{NumCores}, size_t{NumCores} * 4})
+    {
+        size_t SpinCounter     = 0;
+        size_t AdaptiveCounter = 0;
+        size_t MutexCounter    = 0;
+
+        Threading::SpinLock         SpinLock;
+        Threading::AdaptiveSpinLock AdaptiveLock;
+        std::mutex                  Mutex;
+
+        const double SpinTime     = RunContentionTest(SpinLock, NumThreads, NumThreadIterations, SpinCounter);
+        const double AdaptiveTime = RunContentionTest(AdaptiveLock, NumThreads, NumThreadIterations, AdaptiveCounter);
+        const double MutexTime    = RunContentionTest(Mutex, NumThreads, NumThreadIterations, MutexCounter);
+
+        EXPECT_EQ(SpinCounter, NumThreads * NumThreadIterations);
+        EXPECT_EQ(AdaptiveCounter, NumThreads * NumThreadIterations);
+        EXPECT_EQ(MutexCounter, NumThreads * NumThreadIterations);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads / ", NumCores, " cores: SpinLock ", SpinTime * 1000.0, " ms, AdaptiveSpinLock ",
+                         AdaptiveTime * 1000.0, " ms, std::mutex ", MutexTime * 1000.0, " ms");
+    }
+}
+
 } // namespace
@@ -29,9 +29,15 @@
 #include "gtest/gtest.h"
 
 #include <array>
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include <cmath>
+#include <chrono>
+#include <thread>
 
 #include "ThreadSignal.hpp"
+#include "PlatformDefinitions.h"
 
 
 using namespace Diligent;
@@ -99,6 +105,23 @@ TEST(Common_ThreadPool, EnqueueTask)
 }
 
 
+TEST(Common_ThreadPool, DefaultSize)
+{
+    const size_t DefaultSize = GetDefaultThreadPoolSize();
+    EXPECT_GE(DefaultSize, size_t{1});
+    EXPECT_LE(DefaultSize, size_t{std::max(std::thread::hardware_concurrency(), 1u)});
+    EXPECT_EQ(ThreadPoolCreateInfo{}.NumThreads, DefaultSize);
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<int> NumTasksDone{0};
+    for (size_t i = 0; i < DefaultSize * 2; ++i)
+        EnqueueAsyncWork(pThreadPool, [&NumTasksDone](Uint32) { NumTasksDone.fetch_add(1); });
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(NumTasksDone.load(), static_cast<int>(DefaultSize * 2));
+}
+
 TEST(Common_ThreadPool, ProcessTask)
 {
     constexpr Uint32 NumThreads = 4;
@@ -356,4 +379,565 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+TEST(Common_ThreadPool, WorkStealing)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 256;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    // Block all but one thread so that the remaining thread has to steal tasks from other queues
+    std::array<RefCntAutoPtr<WaitTask>, NumThreads - 1> WaitTasks;
+    for (auto& Task : WaitTasks)
+    {
+        Task = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(Task);
+    }
+
+    std::array<std::atomic<bool>, NumTasks>         WorkComplete{};
+    std::array<RefCntAutoPtr<IAsyncTask>, NumTasks> Tasks{};
+    for (size_t i = 0; i < NumTasks; ++i)
+    {
+        Tasks[i] = EnqueueAsyncWork(pThreadPool,
+                                    [i, &WorkComplete](Uint32 ThreadId) //
+                                    {
+                                        WorkComplete[i].store(true);
+                                    });
+    }
+
+    for (size_t i = 0; i < NumTasks; ++i)
+    {
+        Tasks[i]->WaitForCompletion();
+        EXPECT_TRUE(WorkComplete[i]) << "i=" << i;
+    }
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+}
+
+
+TEST(Common_ThreadPool, WorkStealing_RemoveReprioritize)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    std::array<RefCntAutoPtr<WaitTask>, NumThreads> WaitTasks;
+    for (auto& Task : WaitTasks)
+    {
+        Task = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(Task);
+    }
+    for (auto& Task : WaitTasks)
+    {
+        Task->WaitUntilRunning();
+    }
+
+    // Dummy tasks are distributed between all queues
+    std::array<RefCntAutoPtr<DummyTask>, 16> DummyTasks;
+    for (auto& Task : DummyTasks)
+    {
+        Task = MakeNewRCObj<DummyTask>()();
+        pThreadPool->EnqueueTask(Task);
+    }
+    EXPECT_EQ(pThreadPool->GetQueueSize(), DummyTasks.size());
+
+    for (size_t i = 0; i < DummyTasks.size(); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            EXPECT_TRUE(pThreadPool->RemoveTask(DummyTasks[i], false)) << "i=" << i;
+        }
+        else
+        {
+            DummyTasks[i]->SetPriority(static_cast<float>(i));
+            EXPECT_TRUE(pThreadPool->ReprioritizeTask(DummyTasks[i])) << "i=" << i;
+        }
+    }
+    EXPECT_EQ(pThreadPool->GetQueueSize(), DummyTasks.size() / 2);
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    for (size_t i = 0; i < DummyTasks.size(); ++i)
+    {
+        EXPECT_EQ(DummyTasks[i]->GetStatus(), i % 2 == 0 ? ASYNC_TASK_STATUS_NOT_STARTED : ASYNC_TASK_STATUS_COMPLETE) << "i=" << i;
+    }
+}
+
+TEST(Common_ThreadPool, Prerequisites)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumChains  = 16;
+    constexpr Uint32 ChainLen   = 8;
+
+    for (bool EnableWorkStealing : {false, true})
+    {
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        std::array<std::atomic<Uint32>, NumChains>       Progress{};
+        std::array<RefCntAutoPtr<IAsyncTask>, NumChains> LastTasks{};
+        for (Uint32 chain = 0; chain < NumChains; ++chain)
+        {
+            for (Uint32 i = 0; i < ChainLen; ++i)
+            {
+                IAsyncTask* pPrerequisite = LastTasks[chain];
+                LastTasks[chain] =
+                    EnqueueAsyncWork(pThreadPool, &pPrerequisite, pPrerequisite != nullptr ? 1 : 0,
+                                     [chain, i, &Progress](Uint32 ThreadId) //
+                                     {
+                                         // Every task in the chain must run after its prerequisite
+                                         EXPECT_EQ(Progress[chain].load(), i);
+                                         Progress[chain].store(i + 1);
+                                     });
+            }
+        }
+
+        // The final task depends on the last tasks of all chains
+        std::atomic<bool> FinalTaskComplete{false};
+
+        std::vector<IAsyncTask*> Prerequisites{LastTasks.begin(), LastTasks.end()};
+        auto                     pFinalTask =
+            EnqueueAsyncWork(pThreadPool, Prerequisites.data(), static_cast<Uint32>(Prerequisites.size()),
+                             [ExpectedProgress = ChainLen, &Progress, &FinalTaskComplete](Uint32 ThreadId) //
+                             {
+                                 for (const auto& ChainProgress : Progress)
+                                     EXPECT_EQ(ChainProgress.load(), ExpectedProgress);
+                                 FinalTaskComplete.store(true);
+                             });
+
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+        EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+        EXPECT_EQ(pFinalTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_TRUE(FinalTaskComplete);
+    }
+}
+
+
+TEST(Common_ThreadPool, CancelledPrerequisite)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    class CancelledTask : public AsyncTaskBase
+    {
+    public:
+        CancelledTask(IReferenceCounters* pRefCounters) :
+            AsyncTaskBase{pRefCounters}
+        {}
+
+        virtual void Run(Uint32 ThreadId) override final
+        {
+            SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+        }
+    };
+
+    RefCntAutoPtr<IAsyncTask> pCancelledTask{MakeNewRCObj<CancelledTask>()()};
+    RefCntAutoPtr<IAsyncTask> pCompleteTask = EnqueueAsyncWork(pThreadPool, [](Uint32 ThreadId) {});
+
+    std::atomic<bool> DependentTaskRun{false};
+
+    IAsyncTask* Prerequisites[]   = {pCompleteTask, pCancelledTask};
+    auto        pDependentTask    = EnqueueAsyncWork(pThreadPool, Prerequisites, _countof(Prerequisites),
+                                           [&DependentTaskRun](Uint32 ThreadId) //
+                                           {
+                                               DependentTaskRun.store(true);
+                                           });
+    IAsyncTask* pDependentTaskPtr = pDependentTask;
+    auto        pSecondLevelTask  = EnqueueAsyncWork(pThreadPool, &pDependentTaskPtr, 1,
+                                             [&DependentTaskRun](Uint32 ThreadId) //
+                                             {
+                                                 DependentTaskRun.store(true);
+                                             });
+
+    pThreadPool->EnqueueTask(pCancelledTask);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pCancelledTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pDependentTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pSecondLevelTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_FALSE(DependentTaskRun);
+}
+
+
+TEST(Common_ThreadPool, ExternalPrerequisite)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // The prerequisites are never enqueued into the pool and are run by this thread
+    RefCntAutoPtr<IAsyncTask> pPrerequisite0{MakeNewRCObj<DummyTask>()()};
+    RefCntAutoPtr<IAsyncTask> pPrerequisite1{MakeNewRCObj<DummyTask>()()};
+
+    IAsyncTask* pPrerequisitePtr0 = pPrerequisite0;
+    auto        pDependentTask0   = EnqueueAsyncWork(pThreadPool, &pPrerequisitePtr0, 1, [](Uint32 ThreadId) {});
+    IAsyncTask* pPrerequisitePtr1 = pPrerequisite1;
+    auto        pDependentTask1   = EnqueueAsyncWork(pThreadPool, &pPrerequisitePtr1, 1, [](Uint32 ThreadId) {});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_EQ(pDependentTask0->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+    EXPECT_EQ(pDependentTask1->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+
+    // The dependent task must be started by an idle worker thread
+    pPrerequisite0->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+    pPrerequisite0->Run(0);
+    pDependentTask0->WaitForCompletion();
+    EXPECT_EQ(pDependentTask0->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+
+    // WaitForAllTasks() must not wait for a pool task to finish to schedule the dependent task
+    pPrerequisite1->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+    pPrerequisite1->Run(0);
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pDependentTask1->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+
+TEST(Common_ThreadPool, RemovedPrerequisite)
+{
+    for (bool EnableWorkStealing : {false, true})
+    {
+        ThreadPoolCreateInfo PoolCI{1};
+        PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        // Keep the only thread busy so that the prerequisites stay in the queue
+        Threading::Signal Signal;
+
+        RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+        pThreadPool->EnqueueTask(pWaitTask);
+        pWaitTask->WaitUntilRunning();
+
+        std::atomic<bool> DependentTaskRun{false};
+
+        const auto DependentTaskHandler = [&DependentTaskRun](Uint32 ThreadId) {
+            DependentTaskRun.store(true);
+        };
+
+        // The first prerequisite is removed from the queue
+        auto        pQueuedTask       = EnqueueAsyncWork(pThreadPool, [](Uint32 ThreadId) {});
+        IAsyncTask* pQueuedTaskPtr    = pQueuedTask;
+        auto        pDependentTask    = EnqueueAsyncWork(pThreadPool, &pQueuedTaskPtr, 1, DependentTaskHandler);
+        IAsyncTask* pDependentTaskPtr = pDependentTask;
+        auto        pSecondLevelTask  = EnqueueAsyncWork(pThreadPool, &pDependentTaskPtr, 1, DependentTaskHandler);
+
+        // The second prerequisite is itself waiting for the wait task and is removed from the waiting list
+        IAsyncTask* pWaitTaskPtr      = pWaitTask;
+        auto        pWaitingTask      = EnqueueAsyncWork(pThreadPool, &pWaitTaskPtr, 1, [](Uint32 ThreadId) {});
+        IAsyncTask* pWaitingTaskPtr   = pWaitingTask;
+        auto        pWaitingDependent = EnqueueAsyncWork(pThreadPool, &pWaitingTaskPtr, 1, DependentTaskHandler);
+
+        EXPECT_TRUE(pThreadPool->RemoveTask(pQueuedTask, false));
+        EXPECT_EQ(pDependentTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+        EXPECT_EQ(pSecondLevelTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+
+        EXPECT_TRUE(pThreadPool->RemoveTask(pWaitingTask, false));
+        EXPECT_EQ(pWaitingDependent->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+
+        // The removed tasks themselves are not run
+        EXPECT_EQ(pQueuedTask->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+        EXPECT_EQ(pWaitingTask->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+
+        Signal.Trigger(true, 1);
+
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+        EXPECT_EQ(pWaitTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_FALSE(DependentTaskRun);
+    }
+}
+
+TEST(Common_ThreadPool, Lanes)
+{
+    for (bool EnableWorkStealing : {false, true})
+    {
+        ThreadPoolCreateInfo PoolCI{1};
+        PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        Threading::Signal Signal;
+        auto              pWaitTask = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(pWaitTask);
+        pWaitTask->WaitUntilRunning();
+
+        std::vector<int> CompletionOrder;
+
+        auto EnqueueTask = [&](int Id, float fPriority, THREAD_POOL_LANE Lane) {
+            return EnqueueAsyncWork(
+                pThreadPool, [&CompletionOrder, Id](Uint32 ThreadId) { CompletionOrder.push_back(Id); }, fPriority, Lane);
+        };
+
+        // Lanes take precedence over priorities
+        EnqueueTask(0, 100, THREAD_POOL_LANE_BACKGROUND);
+        EnqueueTask(1, 0, THREAD_POOL_LANE_NORMAL);
+        EnqueueTask(2, -100, THREAD_POOL_LANE_CRITICAL);
+        EnqueueTask(3, 10, THREAD_POOL_LANE_NORMAL);
+        EnqueueTask(4, 0, THREAD_POOL_LANE_CRITICAL);
+
+        // Reprioritized task stays in its lane
+        auto pBackgroundTask = EnqueueTask(5, 0, THREAD_POOL_LANE_BACKGROUND);
+        pBackgroundTask->SetPriority(1000);
+        EXPECT_TRUE(pThreadPool->ReprioritizeTask(pBackgroundTask));
+
+        // Task whose prerequisite is not complete is placed into its lane when it is ready
+        IAsyncTask* pPrerequisite = pWaitTask;
+        EnqueueAsyncWork(
+            pThreadPool, &pPrerequisite, 1, [&CompletionOrder](Uint32 ThreadId) { CompletionOrder.push_back(6); }, 10, THREAD_POOL_LANE_CRITICAL);
+
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 7u);
+
+        Signal.Trigger(true, 1);
+        pThreadPool->WaitForAllTasks();
+
+        const std::vector<int> ExpectedOrder = {6, 4, 2, 3, 1, 5, 0};
+        ASSERT_EQ(ExpectedOrder.size(), CompletionOrder.size());
+        for (size_t i = 0; i < ExpectedOrder.size(); ++i)
+            EXPECT_EQ(ExpectedOrder[i], CompletionOrder[i]) << "i=" << i;
+    }
+}
+
+TEST(Common_ThreadPool, CriticalThreads)
+{
+    ThreadPoolCreateInfo PoolCI{2};
+    PoolCI.NumCriticalThreads = 1;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Block the only shared thread
+    Threading::Signal Signal;
+    auto              pWaitTask = MakeNewRCObj<WaitTask>()(Signal);
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    // The reserved thread does not run normal tasks
+    std::atomic<bool> NormalTaskRun{false};
+
+    auto pNormalTask = EnqueueAsyncWork(pThreadPool, [&NormalTaskRun](Uint32 ThreadId) { NormalTaskRun.store(true); });
+
+    // Critical tasks still run on the reserved thread
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        auto pCriticalTask = EnqueueAsyncWork(
+            pThreadPool, [](Uint32 ThreadId) { EXPECT_EQ(ThreadId, 0u); }, 0, THREAD_POOL_LANE_CRITICAL);
+        pCriticalTask->WaitForCompletion();
+        EXPECT_EQ(pCriticalTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    }
+
+    EXPECT_FALSE(NormalTaskRun);
+    EXPECT_EQ(pNormalTask->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+
+    Signal.Trigger(true, 1);
+    pThreadPool->WaitForAllTasks();
+    EXPECT_TRUE(NormalTaskRun);
+}
+
+TEST(Common_ThreadPool, MaxBackgroundThreads)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 32;
+
+    for (bool EnableWorkStealing : {false, true})
+    {
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.EnableWorkStealing   = EnableWorkStealing;
+        PoolCI.MaxBackgroundThreads = 1;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        std::atomic<int> NumRunning{0};
+        std::atomic<int> MaxRunning{0};
+        for (Uint32 i = 0; i < NumTasks; ++i)
+        {
+            EnqueueAsyncWork(
+                pThreadPool,
+                [&NumRunning, &MaxRunning](Uint32 ThreadId) //
+                {
+                    const int Running = NumRunning.fetch_add(1) + 1;
+
+                    int Max = MaxRunning.load();
+                    while (Running > Max && !MaxRunning.compare_exchange_weak(Max, Running))
+                    {}
+
+                    std::this_thread::sleep_for(std::chrono::microseconds{100});
+                    NumRunning.fetch_add(-1);
+                },
+                0, THREAD_POOL_LANE_BACKGROUND);
+        }
+
+        // Normal tasks are not blocked by the background tasks
+        auto pNormalTask = EnqueueAsyncWork(pThreadPool, [](Uint32 ThreadId) {});
+        pNormalTask->WaitForCompletion();
+
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(MaxRunning.load(), 1);
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    }
+}
+
+TEST(Common_ThreadPool, WorkerThreadPriorityAndCores)
+{
+    ThreadPoolCreateInfo PoolCI{4};
+    PoolCI.NumCriticalThreads     = 1;
+    PoolCI.CriticalThreadPriority = ThreadPriority::Normal;
+    PoolCI.CriticalThreadCores    = CPUCoreType::Performance;
+    PoolCI.WorkerThreadPriority   = ThreadPriority::Lowest;
+    PoolCI.WorkerThreadCores      = CPUCoreType::Efficiency;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Whether or not the OS honors the settings, all tasks must run
+    std::atomic<Uint32> NumTasksRun{0};
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        EnqueueAsyncWork(
+            pThreadPool, [&NumTasksRun](Uint32 ThreadId) { NumTasksRun.fetch_add(1); }, 0,
+            static_cast<THREAD_POOL_LANE>(i % THREAD_POOL_LANE_COUNT));
+    }
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(NumTasksRun.load(), 16u);
+}
+
+TEST(Common_ThreadPool, ParallelFor)
+{
+    constexpr size_t NumItems = 1000;
+
+    auto TestParallelFor = [](IThreadPool* pThreadPool, size_t BatchSize) {
+        std::vector<std::atomic<int>> Counters(NumItems);
+        for (auto& Counter : Counters)
+            Counter.store(0);
+
+        ParallelFor(pThreadPool, NumItems, BatchSize, [&](size_t Begin, size_t End) {
+            EXPECT_LT(Begin, End);
+            EXPECT_LE(End - Begin, BatchSize);
+            for (size_t i = Begin; i < End; ++i)
+                Counters[i].fetch_add(1);
+        });
+
+        for (size_t i = 0; i < NumItems; ++i)
+            EXPECT_EQ(Counters[i].load(), 1) << "Item " << i;
+    };
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    TestParallelFor(pThreadPool, 1);
+    TestParallelFor(pThreadPool, 32);
+    TestParallelFor(pThreadPool, NumItems * 2);
+    TestParallelFor(nullptr, 64);
+
+    // No items
+    ParallelFor(pThreadPool, 0, 16, [](size_t, size_t) { ADD_FAILURE() << "Handler must not be called"; });
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+TEST(Common_ThreadPool, ParallelReduce)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    constexpr size_t NumItems = 100000;
+
+    auto Sum = [](size_t Begin, size_t End) {
+        Uint64 Res = 0;
+        for (size_t i = Begin; i < End; ++i)
+            Res += i;
+        return Res;
+    };
+    auto Add = [](Uint64 Lhs, Uint64 Rhs) { return Lhs + Rhs; };
+
+    constexpr Uint64 RefSum = Uint64{NumItems} * (NumItems - 1) / 2;
+    EXPECT_EQ(ParallelReduce(pThreadPool, NumItems, 0, Uint64{0}, Sum, Add), RefSum);
+    EXPECT_EQ(ParallelReduce(pThreadPool, NumItems, 7, Uint64{0}, Sum, Add), RefSum);
+    EXPECT_EQ(ParallelReduce(nullptr, NumItems, 0, Uint64{0}, Sum, Add), RefSum);
+    EXPECT_EQ(ParallelReduce(pThreadPool, 0, 0, Uint64{5}, Sum, Add), Uint64{5});
+
+    // Batch results must be combined in order
+    auto Concat = [](std::vector<size_t> Lhs, std::vector<size_t> Rhs) {
+        Lhs.insert(Lhs.end(), Rhs.begin(), Rhs.end());
+        return Lhs;
+    };
+    auto Indices = ParallelReduce(
+        pThreadPool, 1000, 10, std::vector<size_t>{},
+        [](size_t Begin, size_t End) {
+            std::vector<size_t> Res;
+            for (size_t i = Begin; i < End; ++i)
+                Res.push_back(i);
+            return Res;
+        },
+        Concat);
+    ASSERT_EQ(Indices.size(), size_t{1000});
+    for (size_t i = 0; i < Indices.size(); ++i)
+        EXPECT_EQ(Indices[i], i);
+}
+
+TEST(Common_ThreadPool, ParallelSort)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (size_t NumItems : {size_t{0}, size_t{1}, size_t{100}, size_t{10000}, size_t{100003}})
+    {
+        std::vector<Uint32> Values(NumItems);
+        Uint32              Seed = 12345;
+        for (auto& Val : Values)
+        {
+            Seed = Seed * 1664525u + 1013904223u;
+            Val  = Seed >> 8;
+        }
+        auto RefValues = Values;
+        std::sort(RefValues.begin(), RefValues.end());
+
+        auto SortedValues = Values;
+        ParallelSort(pThreadPool, SortedValues.begin(), SortedValues.end());
+        EXPECT_EQ(SortedValues, RefValues) << "NumItems = " << NumItems;
+
+        // Small chunks to exercise many merge passes
+        SortedValues = Values;
+        ParallelSort(pThreadPool, SortedValues.begin(), SortedValues.end(), std::greater<Uint32>{}, 16);
+        EXPECT_TRUE(std::is_sorted(SortedValues.begin(), SortedValues.end(), std::greater<Uint32>{})) << "NumItems = " << NumItems;
+    }
+
+    // Pool with no worker threads: the calling thread must do all the work
+    auto pManualPool = CreateThreadPool(ThreadPoolCreateInfo{0});
+    ASSERT_NE(pManualPool, nullptr);
+
+    std::vector<int> Values(50000);
+    for (size_t i = 0; i < Values.size(); ++i)
+        Values[i] = static_cast<int>((i * 7919) % Values.size());
+    ParallelSort(pManualPool, Values.begin(), Values.end(), std::less<int>{}, 64);
+    EXPECT_TRUE(std::is_sorted(Values.begin(), Values.end()));
+    EXPECT_EQ(pManualPool->GetQueueSize(), 0u);
+}
+
 } // namespace
@@ -0,0 +1,218 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BlockCompression.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 TestWidth  = 37;
+constexpr Uint32 TestHeight = 23;
+
+// Creates a color ramp. Colors within every block lie on a line, so all formats
+// are expected to reproduce the image with a small error.
+std::vector<Uint8> CreateRampImage(Uint32 Width, Uint32 Height)
+{
+    std::vector<Uint8> Pixels(size_t{Width} * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const Uint32 t = std::min(x * 5 + y * 2, 255u);
+
+            auto* pPixel = &Pixels[(size_t{y} * Width + x) * 4];
+            pPixel[0]    = static_cast<Uint8>(t);
+            pPixel[1]    = static_cast<Uint8>(64 + t / 2);
+            pPixel[2]    = static_cast<Uint8>(255 - t);
+            pPixel[3]    = static_cast<Uint8>(128 + t / 2);
+        }
+    }
+    return Pixels;
+}
+
+std::vector<Uint8> Compress(TEXTURE_FORMAT Format, const std::vector<Uint8>& Pixels, Uint32 Width, Uint32 Height, Uint32 NumThreads = 1)
+{
+    const Uint32 BlockSize = (Format == TEX_FORMAT_BC1_UNORM || Format == TEX_FORMAT_BC4_UNORM) ? 8 : 16;
+    const size_t DstStride = size_t{(Width + 3) / 4} * BlockSize;
+
+    std::vector<Uint8> Blocks(DstStride * ((Height + 3) / 4));
+
+    CompressTextureDataAttribs Attribs;
+    Attribs.Format     = Format;
+    Attribs.Width      = Width;
+    Attribs.Height     = Height;
+    Attribs.pSrcData   = Pixels.data();
+    Attribs.SrcStride  = size_t{Width} * 4;
+    Attribs.pDstData   = Blocks.data();
+    Attribs.DstStride  = DstStride;
+    Attribs.NumThreads = NumThreads;
+    EXPECT_TRUE(CompressTextureData(Attribs));
+
+    return Blocks;
+}
+
+std::vector<Uint8> Decompress(TEXTURE_FORMAT Format, const std::vector<Uint8>& Blocks, Uint32 Width, Uint32 Height)
+{
+    std::vector<Uint8> Pixels(size_t{Width} * Height * 4);
+
+    DecompressTextureDataAttribs Attribs;
+    Attribs.Format    = Format;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.pSrcData  = Blocks.data();
+    Attribs.SrcStride = Blocks.size() / ((Height + 3) / 4);
+    Attribs.pDstData  = Pixels.data();
+    Attribs.DstStride = size_t{Width} * 4;
+    EXPECT_TRUE(DecompressTextureData(Attribs));
+
+    return Pixels;
+}
+
+void TestRoundTrip(TEXTURE_FORMAT Format, Uint32 NumComps, int MaxColorError, int MaxAlphaError)
+{
+    const auto Pixels = CreateRampImage(TestWidth, TestHeight);
+    const auto Blocks = Compress(Format, Pixels, TestWidth, TestHeight);
+    const auto Result = Decompress(Format, Blocks, TestWidth, TestHeight);
+
+    for (size_t i = 0; i < Pixels.size(); i += 4)
+    {
+        for (Uint32 c = 0; c < NumComps; ++c)
+        {
+            const int MaxError = c < 3 ? MaxColorError : MaxAlphaError;
+            ASSERT_LE(std::abs(int{Pixels[i + c]} - int{Result[i + c]}), MaxError) << "Pixel " << i / 4 << ", component " << c;
+        }
+        if (NumComps < 4)
+        {
+            EXPECT_EQ(Result[i + 3], 255);
+        }
+    }
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC1)
+{
+    TestRoundTrip(TEX_FORMAT_BC1_UNORM, 3, 6, 0);
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC3)
+{
+    TestRoundTrip(TEX_FORMAT_BC3_UNORM, 4, 6, 2);
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC4)
+{
+    TestRoundTrip(TEX_FORMAT_BC4_UNORM, 1, 2, 0);
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC5)
+{
+    TestRoundTrip(TEX_FORMAT_BC5_UNORM, 2, 2, 0);
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC7)
+{
+    TestRoundTrip(TEX_FORMAT_BC7_UNORM, 4, 2, 2);
+}
+
+TEST(GraphicsAccessories_BlockCompression, BC1Transparency)
+{
+    std::vector<Uint8> Pixels(8 * 8 * 4);
+    for (size_t i = 0; i < Pixels.size() / 4; ++i)
+    {
+        Pixels[i * 4 + 0] = 200;
+        Pixels[i * 4 + 1] = static_cast<Uint8>(i * 4);
+        Pixels[i * 4 + 2] = 50;
+        Pixels[i * 4 + 3] = (i % 3) == 0 ? 0 : 255;
+    }
+
+    const auto Blocks = Compress(TEX_FORMAT_BC1_UNORM, Pixels, 8, 8);
+    const auto Result = Decompress(TEX_FORMAT_BC1_UNORM, Blocks, 8, 8);
+    for (size_t i = 0; i < Pixels.size() / 4; ++i)
+    {
+        EXPECT_EQ(Result[i * 4 + 3], Pixels[i * 4 + 3]) << "Pixel " << i;
+    }
+}
+
+TEST(GraphicsAccessories_BlockCompression, Multithreaded)
+{
+    const auto Pixels = CreateRampImage(TestWidth, TestHeight);
+    for (auto Format : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC7_UNORM})
+    {
+        const auto Blocks   = Compress(Format, Pixels, TestWidth, TestHeight, 1);
+        const auto MTBlocks = Compress(Format, Pixels, TestWidth, TestHeight, 4);
+        EXPECT_EQ(Blocks, MTBlocks);
+    }
+}
+
+TEST(GraphicsAccessories_BlockCompression, Errors)
+{
+    EXPECT_FALSE(IsBlockCompressionSupported(TEX_FORMAT_BC2_UNORM));
+    EXPECT_TRUE(IsBlockDecompressionSupported(TEX_FORMAT_BC2_UNORM));
+    EXPECT_FALSE(IsBlockDecompressionSupported(TEX_FORMAT_RGBA8_UNORM));
+
+    std::vector<Uint8> Pixels(4 * 4 * 4);
+    std::vector<Uint8> Block(16);
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"is not supported by the block compressor"};
+
+        CompressTextureDataAttribs Attribs;
+        Attribs.Format    = TEX_FORMAT_RGBA8_UNORM;
+        Attribs.Width     = 4;
+        Attribs.Height    = 4;
+        Attribs.pSrcData  = Pixels.data();
+        Attribs.SrcStride = 16;
+        Attribs.pDstData  = Block.data();
+        Attribs.DstStride = 16;
+        EXPECT_FALSE(CompressTextureData(Attribs));
+    }
+
+    // BC7 mode 0 block uses three partitions and is not supported by the decoder
+    Block[0] = 0x01;
+
+    DecompressTextureDataAttribs Attribs;
+    Attribs.Format    = TEX_FORMAT_BC7_UNORM;
+    Attribs.Width     = 4;
+    Attribs.Height    = 4;
+    Attribs.pSrcData  = Block.data();
+    Attribs.SrcStride = 16;
+    Attribs.pDstData  = Pixels.data();
+    Attribs.DstStride = 16;
+    EXPECT_FALSE(DecompressTextureData(Attribs));
+}
+
+} // namespace
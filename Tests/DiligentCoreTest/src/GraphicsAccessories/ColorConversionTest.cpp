@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ColorConversion.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+double LinearToSRGBExact(double x)
+{
+    return x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055;
+}
+
+double SRGBToLinearExact(double x)
+{
+    return x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4);
+}
+
+// Values in [0, 1] that include both ends and the linear segment thresholds
+std::vector<float> GetTestValues()
+{
+    constexpr Uint32   NumValues = 100003;
+    std::vector<float> Values(NumValues);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        Values[i] = static_cast<float>(i) / static_cast<float>(NumValues - 1);
+    Values.push_back(0.0031308f);
+    Values.push_back(0.04045f);
+    Values.push_back(std::numeric_limits<float>::min());
+    return Values;
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearToSRGBBatch)
+{
+    const auto Values = GetTestValues();
+
+    std::vector<float> SRGB(Values.size());
+    LinearToSRGB(Values.data(), SRGB.data(), Values.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+        EXPECT_NEAR(SRGB[i], LinearToSRGBExact(Values[i]), 3e-7) << Values[i];
+
+    std::vector<Uint8> SRGB8(Values.size());
+    LinearToSRGB(Values.data(), SRGB8.data(), Values.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+    {
+        const double Exact = LinearToSRGBExact(Values[i]) * 255.0;
+        const double Dist  = std::abs(Exact - std::floor(Exact) - 0.5);
+        if (Dist > 4e-5)
+            EXPECT_EQ(SRGB8[i], static_cast<Uint8>(Exact + 0.5)) << Values[i];
+        else
+            EXPECT_NEAR(SRGB8[i], Exact, 0.5 + 4e-5) << Values[i];
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGBToLinearBatch)
+{
+    const auto Values = GetTestValues();
+
+    std::vector<float> Linear(Values.size());
+    SRGBToLinear(Values.data(), Linear.data(), Values.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+        EXPECT_NEAR(Linear[i], SRGBToLinearExact(Values[i]), 8e-7) << Values[i];
+}
+
+TEST(GraphicsAccessories_ColorConversion, ClampBatch)
+{
+    const float Values[] = {-1.f, 2.f, std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    constexpr size_t NumValues = sizeof(Values) / sizeof(Values[0]);
+
+    float Results[NumValues] = {};
+    LinearToSRGB(Values, Results, NumValues);
+    EXPECT_EQ(Results[0], 0.f);
+    EXPECT_NEAR(Results[1], 1.f, 3e-7);
+    EXPECT_EQ(Results[2], 0.f);
+    EXPECT_EQ(Results[3], 0.f);
+    EXPECT_NEAR(Results[4], 1.f, 3e-7);
+
+    SRGBToLinear(Values, Results, NumValues);
+    EXPECT_EQ(Results[0], 0.f);
+    EXPECT_NEAR(Results[1], 1.f, 8e-7);
+    EXPECT_EQ(Results[2], 0.f);
+
+    Uint8 Results8[NumValues] = {};
+    LinearToSRGB(Values, Results8, NumValues);
+    EXPECT_EQ(Results8[0], 0);
+    EXPECT_EQ(Results8[1], 255);
+    EXPECT_EQ(Results8[2], 0);
+    EXPECT_EQ(Results8[3], 0);
+    EXPECT_EQ(Results8[4], 255);
+}
+
+TEST(GraphicsAccessories_ColorConversion, Uint8Batch)
+{
+    Uint8 Values[256];
+    for (Uint32 i = 0; i < 256; ++i)
+        Values[i] = static_cast<Uint8>(i);
+
+    float SRGB[256];
+    float Linear[256];
+    LinearToSRGB(Values, SRGB, 256);
+    SRGBToLinear(Values, Linear, 256);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        EXPECT_EQ(SRGB[i], LinearToSRGB(Values[i]));
+        EXPECT_EQ(Linear[i], SRGBToLinear(Values[i]));
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, FastBatch)
+{
+    auto Values = GetTestValues();
+    Values.push_back(-0.5f);
+    Values.push_back(1.5f);
+
+    // Odd counts exercise the scalar tails
+    for (size_t Count : {size_t{0}, size_t{1}, size_t{3}, size_t{7}, Values.size()})
+    {
+        std::vector<float> SRGB(Count);
+        std::vector<float> Linear(Count);
+        FastLinearToSRGB(Values.data(), SRGB.data(), Count);
+        FastSRGBToLinear(Values.data(), Linear.data(), Count);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            EXPECT_EQ(SRGB[i], FastLinearToSRGB(Values[i])) << Values[i];
+            EXPECT_EQ(Linear[i], FastSRGBToLinear(Values[i])) << Values[i];
+        }
+    }
+
+    // In-place conversion
+    std::vector<float> InPlace = Values;
+    FastLinearToSRGB(InPlace.data(), InPlace.data(), InPlace.size());
+    for (size_t i = 0; i < Values.size(); ++i)
+        EXPECT_EQ(InPlace[i], FastLinearToSRGB(Values[i]));
+}
+
+} // namespace
@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    ConcurrentRingBuffer RB(1024, Allocator);
+    EXPECT_TRUE(RB.IsEmpty());
+
+    EXPECT_EQ(RB.Allocate(120, 16), OffsetType{0});
+    EXPECT_EQ(RB.Allocate(10, 1), OffsetType{128});
+    EXPECT_EQ(RB.Allocate(10, 32), OffsetType{160});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{192});
+    RB.FinishCurrentFrame(1);
+
+    EXPECT_EQ(RB.Allocate(512, 1), OffsetType{192});
+    RB.FinishCurrentFrame(2);
+
+    // Not enough space at the end, and the space at the start is not released yet
+    EXPECT_EQ(RB.Allocate(512, 1), InvalidOffset);
+
+    RB.ReleaseCompletedFrames(1);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{512});
+
+    EXPECT_EQ(RB.Allocate(160, 1), OffsetType{704});
+
+    // The allocation wraps around to the start of the buffer, and the
+    // space between 864 and 1024 is wasted
+    EXPECT_EQ(RB.Allocate(192, 1), OffsetType{0});
+    EXPECT_TRUE(RB.IsFull());
+    EXPECT_EQ(RB.Allocate(1, 1), InvalidOffset);
+    RB.FinishCurrentFrame(3);
+
+    RB.ReleaseCompletedFrames(2);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{160 + 160 + 192});
+
+    // Zero-size frames are ignored
+    RB.FinishCurrentFrame(4);
+
+    RB.ReleaseCompletedFrames(4);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, MultithreadedAllocation)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+
+    static constexpr OffsetType BufferSize      = 1 << 16;
+    static constexpr Uint64     NumFrames       = 64;
+    static constexpr size_t     AllocsPerThread = 256;
+    static constexpr Uint64     FramesInFlight  = 2;
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    ConcurrentRingBuffer RB(BufferSize, Allocator);
+
+    struct Range
+    {
+        OffsetType Offset;
+        OffsetType Size;
+        Uint64     Frame;
+    };
+    // Ranges allocated in the frames that may still be in flight
+    std::vector<Range> LiveRanges;
+
+    size_t NumAllocations = 0;
+    for (Uint64 Frame = 1; Frame <= NumFrames; ++Frame)
+    {
+        std::vector<std::vector<Range>> ThreadRanges(NumThreads);
+        std::vector<std::thread>        Threads(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&, t]() {
+                    FastRandInt SizeRnd{static_cast<unsigned int>(Frame * 131 + t), 1, 64};
+                    for (size_t i = 0; i < AllocsPerThread; ++i)
+                    {
+                        const auto Size   = static_cast<OffsetType>(SizeRnd());
+                        const auto Offset = RB.Allocate(Size, 16);
+                        if (Offset != InvalidOffset)
+                            ThreadRanges[t].push_back({Offset, Size, Frame});
+                    }
+                }};
+        }
+        // Release the space of completed frames while the threads are allocating
+        if (Frame > FramesInFlight)
+            RB.ReleaseCompletedFrames(Frame - FramesInFlight);
+        for (auto& Thread : Threads)
+            Thread.join();
+        RB.FinishCurrentFrame(Frame);
+
+        LiveRanges.erase(std::remove_if(LiveRanges.begin(), LiveRanges.end(),
+                                        [Frame](const Range& R) {
+                                            return R.Frame + FramesInFlight <= Frame;
+                                        }),
+                         LiveRanges.end());
+        for (const auto& Ranges : ThreadRanges)
+        {
+            for (const auto& R : Ranges)
+            {
+                EXPECT_EQ(R.Offset % 16, OffsetType{0});
+                EXPECT_LE(R.Offset + R.Size, BufferSize);
+                LiveRanges.push_back(R);
+                ++NumAllocations;
+            }
+        }
+
+        // Ranges of the current frame must not overlap each other or the ranges of the frames in flight
+        std::sort(LiveRanges.begin(), LiveRanges.end(),
+                  [](const Range& lhs, const Range& rhs) {
+                      return lhs.Offset < rhs.Offset;
+                  });
+        for (size_t i = 1; i < LiveRanges.size(); ++i)
+        {
+            EXPECT_LE(LiveRanges[i - 1].Offset + LiveRanges[i - 1].Size, LiveRanges[i].Offset) << "Overlapping ranges in frame " << Frame;
+        }
+    }
+    EXPECT_GT(NumAllocations, size_t{0});
+
+    RB.ReleaseCompletedFrames(NumFrames);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+} // namespace
@@ -28,11 +28,13 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <array>
+#include <vector>
 #include <algorithm>
 
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "Timer.hpp"
 
 using namespace Diligent;
 
@@ -465,4 +467,70 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+TEST(GraphicsAccessories_DynamicAtlasManager, ShelfPolicy)
+{
+    DynamicAtlasManager Mgr{64, 64, DynamicAtlasManager::ALLOCATION_POLICY_SHELF};
+    EXPECT_EQ(Mgr.GetAllocationPolicy(), DynamicAtlasManager::ALLOCATION_POLICY_SHELF);
+    EXPECT_TRUE(Mgr.IsEmpty());
+
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 32; ++i)
+    {
+        auto R = Mgr.Allocate(8, 16);
+        ASSERT_FALSE(R.IsEmpty());
+        EXPECT_EQ(R, Region((i % 8) * 8, (i / 8) * 16, 8, 16));
+        Regions.push_back(R);
+    }
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), Uint64{0});
+    EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+    DynamicAtlasManager Mgr1{std::move(Mgr)};
+
+    Mgr1.Free(std::move(Regions[9]));
+    EXPECT_EQ(Mgr1.GetTotalFreeArea(), Uint64{8 * 16});
+    EXPECT_EQ(Mgr1.Allocate(8, 16), Region(8, 16, 8, 16));
+    Mgr1.Free(Region{8, 16, 8, 16});
+    EXPECT_FALSE(Mgr1.IsEmpty());
+
+    for (auto& R : Regions)
+    {
+        if (!R.IsEmpty())
+            Mgr1.Free(std::move(R));
+    }
+    EXPECT_TRUE(Mgr1.IsEmpty());
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocationPolicyBenchmark)
+{
+    static constexpr Uint32 AtlasSize = 2048;
+    static constexpr Uint32 GlyphSize = 16;
+
+    for (auto Policy : {DynamicAtlasManager::ALLOCATION_POLICY_BEST_FIT, DynamicAtlasManager::ALLOCATION_POLICY_SHELF})
+    {
+        DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Policy};
+
+        // Glyphs of the same height and varying widths
+        FastRandInt         rnd{0, GlyphSize / 2, GlyphSize};
+        std::vector<Region> Regions(2048);
+
+        Timer T;
+        for (auto& R : Regions)
+        {
+            R = Mgr.Allocate(rnd(), GlyphSize);
+            EXPECT_FALSE(R.IsEmpty());
+        }
+        const auto AllocTime = T.GetElapsedTime();
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+
+        LOG_INFO_MESSAGE(Policy == DynamicAtlasManager::ALLOCATION_POLICY_SHELF ? "Shelf" : "Best-fit", " policy: ",
+                         Regions.size(), " glyph allocations took ", AllocTime * 1000.0, " ms");
+    }
+}
+
 } // namespace
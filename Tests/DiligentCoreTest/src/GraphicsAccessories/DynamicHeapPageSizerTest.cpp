@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DynamicHeapPageSizer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint64 MinPageSize = 1 << 16;
+constexpr Uint64 MaxPageSize = 1 << 22;
+
+TEST(GraphicsAccessories_DynamicHeapPageSizer, InitialSize)
+{
+    EXPECT_EQ(DynamicHeapPageSizer(MinPageSize, MaxPageSize, 0).GetPageSize(), MinPageSize);
+    EXPECT_EQ(DynamicHeapPageSizer(MinPageSize, MaxPageSize, MinPageSize * 3).GetPageSize(), MinPageSize * 4);
+    EXPECT_EQ(DynamicHeapPageSizer(MinPageSize, MaxPageSize, MaxPageSize * 8).GetPageSize(), MaxPageSize);
+}
+
+TEST(GraphicsAccessories_DynamicHeapPageSizer, Grow)
+{
+    DynamicHeapPageSizer Sizer{MinPageSize, MaxPageSize, MinPageSize};
+
+    EXPECT_FALSE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize);
+
+    // A frame that does not fit grows the page size immediately
+    EXPECT_TRUE(Sizer.FinishFrame(MinPageSize * 5));
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize * 8);
+    EXPECT_EQ(Sizer.GetPreviousPageSize(), MinPageSize);
+
+    // The page size never exceeds the maximum size
+    EXPECT_TRUE(Sizer.FinishFrame(MaxPageSize * 4));
+    EXPECT_EQ(Sizer.GetPageSize(), MaxPageSize);
+    EXPECT_FALSE(Sizer.FinishFrame(MaxPageSize * 4));
+
+    EXPECT_EQ(Sizer.GetWindowPeakSize(), MaxPageSize * 4);
+    Sizer.ResetWindowPeakSize();
+    EXPECT_EQ(Sizer.GetWindowPeakSize(), 0u);
+    EXPECT_EQ(Sizer.GetNumFrames(), 4u);
+}
+
+TEST(GraphicsAccessories_DynamicHeapPageSizer, Shrink)
+{
+    DynamicHeapPageSizer Sizer{MinPageSize, MaxPageSize, MinPageSize * 8};
+
+    // Low usage must persist for ShrinkDelay frames
+    for (Uint32 i = 0; i < DynamicHeapPageSizer::ShrinkDelay - 1; ++i)
+        EXPECT_FALSE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_TRUE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize * 4);
+
+    // Usage between a quarter of the page and the page size resets the counter
+    for (Uint32 i = 0; i < DynamicHeapPageSizer::ShrinkDelay - 1; ++i)
+        EXPECT_FALSE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_FALSE(Sizer.FinishFrame(MinPageSize * 2));
+    for (Uint32 i = 0; i < DynamicHeapPageSizer::ShrinkDelay - 1; ++i)
+        EXPECT_FALSE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize * 4);
+    EXPECT_TRUE(Sizer.FinishFrame(MinPageSize));
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize * 2);
+
+    // The page size never goes below the minimum size
+    for (Uint32 i = 0; i < DynamicHeapPageSizer::ShrinkDelay * 4; ++i)
+        Sizer.FinishFrame(0);
+    EXPECT_EQ(Sizer.GetPageSize(), MinPageSize);
+}
+
+} // namespace
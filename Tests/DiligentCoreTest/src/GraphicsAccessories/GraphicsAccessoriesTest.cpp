@@ -489,7 +489,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetTextureFormatAttribs)
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeIndex)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the test below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the test below to handle the new shader type");
 
     // clang-format off
     EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_UNKNOWN),             -1);
@@ -508,6 +508,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeIndex)
     EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_RAY_INTERSECTION), RISInd);
     EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_CALLABLE),         RCSInd);
     EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_TILE),             TLSInd);
+    EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_WORK_GRAPH),       WGSInd);
     EXPECT_EQ(GetShaderTypeIndex(SHADER_TYPE_LAST),             LastShaderInd);
     // clang-format on
 
@@ -520,7 +521,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeIndex)
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeFromIndex)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the test below to handle the new shader type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the test below to handle the new shader type");
 
     EXPECT_EQ(GetShaderTypeFromIndex(VSInd), SHADER_TYPE_VERTEX);
     EXPECT_EQ(GetShaderTypeFromIndex(PSInd), SHADER_TYPE_PIXEL);
@@ -537,6 +538,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeFromIndex)
     EXPECT_EQ(GetShaderTypeFromIndex(RISInd), SHADER_TYPE_RAY_INTERSECTION);
     EXPECT_EQ(GetShaderTypeFromIndex(RCSInd), SHADER_TYPE_CALLABLE);
     EXPECT_EQ(GetShaderTypeFromIndex(TLSInd), SHADER_TYPE_TILE);
+    EXPECT_EQ(GetShaderTypeFromIndex(WGSInd), SHADER_TYPE_WORK_GRAPH);
 
     EXPECT_EQ(GetShaderTypeFromIndex(LastShaderInd), SHADER_TYPE_LAST);
 
@@ -549,8 +551,8 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeFromIndex)
 
 TEST(GraphicsAccessories_GraphicsAccessories, IsConsistentShaderType)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the code below to handle the new shader type");
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the code below to handle the new pipeline type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the code below to handle the new shader type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the code below to handle the new pipeline type");
 
     {
         std::array<bool, LastShaderInd + 1> ValidGraphicsStages;
@@ -622,6 +624,18 @@ TEST(GraphicsAccessories_GraphicsAccessories, IsConsistentShaderType)
             EXPECT_EQ(IsConsistentShaderType(ShaderType, PIPELINE_TYPE_TILE), ValidTileStages[i]);
         }
     }
+
+    {
+        std::array<bool, LastShaderInd + 1> ValidWorkGraphStages;
+        ValidWorkGraphStages.fill(false);
+        ValidWorkGraphStages[WGSInd] = true;
+
+        for (Int32 i = 0; i <= LastShaderInd; ++i)
+        {
+            auto ShaderType = GetShaderTypeFromIndex(i);
+            EXPECT_EQ(IsConsistentShaderType(ShaderType, PIPELINE_TYPE_WORK_GRAPH), ValidWorkGraphStages[i]);
+        }
+    }
 }
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypePipelineIndex)
@@ -669,8 +683,8 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetShaderTypeFromPipelineIndex)
 
 TEST(GraphicsAccessories_GraphicsAccessories, PipelineTypeFromShaderStages)
 {
-    static_assert(SHADER_TYPE_LAST == 0x4000, "Please update the code below to handle the new shader type");
-    static_assert(PIPELINE_TYPE_LAST == 4, "Please update the code below to handle the new pipeline type");
+    static_assert(SHADER_TYPE_LAST == 0x8000, "Please update the code below to handle the new shader type");
+    static_assert(PIPELINE_TYPE_LAST == 5, "Please update the code below to handle the new pipeline type");
 
     EXPECT_EQ(PipelineTypeFromShaderStages(SHADER_TYPE_VERTEX), PIPELINE_TYPE_GRAPHICS);
     EXPECT_EQ(PipelineTypeFromShaderStages(SHADER_TYPE_PIXEL), PIPELINE_TYPE_GRAPHICS);
@@ -693,11 +707,13 @@ TEST(GraphicsAccessories_GraphicsAccessories, PipelineTypeFromShaderStages)
     EXPECT_EQ(PipelineTypeFromShaderStages(SHADER_TYPE_CALLABLE), PIPELINE_TYPE_RAY_TRACING);
 
     EXPECT_EQ(PipelineTypeFromShaderStages(SHADER_TYPE_TILE), PIPELINE_TYPE_TILE);
+
+    EXPECT_EQ(PipelineTypeFromShaderStages(SHADER_TYPE_WORK_GRAPH), PIPELINE_TYPE_WORK_GRAPH);
 }
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
 {
-    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 4), "Please add a test for the new flag here");
+    static_assert(PIPELINE_RESOURCE_FLAG_LAST == (1u << 6), "Please add a test for the new flag here");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE, true).c_str(), "PIPELINE_RESOURCE_FLAG_NONE");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE).c_str(), "UNKNOWN");
@@ -706,11 +722,15 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(), "PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER, true).c_str(), "PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT, true).c_str(), "PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS, true).c_str(), "PIPELINE_RESOURCE_FLAG_BINDLESS");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, true).c_str(), "PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS).c_str(), "NO_DYNAMIC_BUFFERS");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER).c_str(), "COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER).c_str(), "FORMATTED_BUFFER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT).c_str(), "GENERAL_INPUT_ATTACHMENT");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS).c_str(), "BINDLESS");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS).c_str(), "INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(),
                  "PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS|PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
@@ -738,6 +758,18 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineShadingRateFlagsString)
     EXPECT_STREQ(GetPipelineShadingRateFlagsString(PIPELINE_SHADING_RATE_FLAG_PER_PRIMITIVE | PIPELINE_SHADING_RATE_FLAG_TEXTURE_BASED).c_str(), "PER_PRIMITIVE | TEXTURE_BASED");
 }
 
+TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineDynamicStateFlagsString)
+{
+    static_assert(PIPELINE_DYNAMIC_STATE_FLAG_LAST == 0x08, "Please update the switch below to handle the new pipeline dynamic state flag");
+
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_NONE).c_str(), "NONE");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE).c_str(), "CULL_MODE");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_DEPTH_TEST).c_str(), "DEPTH_TEST");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_STENCIL_TEST).c_str(), "STENCIL_TEST");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY).c_str(), "PRIMITIVE_TOPOLOGY");
+    EXPECT_STREQ(GetPipelineDynamicStateFlagsString(PIPELINE_DYNAMIC_STATE_FLAG_CULL_MODE | PIPELINE_DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY).c_str(), "CULL_MODE | PRIMITIVE_TOPOLOGY");
+}
+
 TEST(GraphicsAccessories_GraphicsAccessories, GetMipLevelProperties)
 {
     TextureDesc        Desc;
@@ -1125,4 +1157,33 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetAdapterTypeString)
     EXPECT_STREQ(GetAdapterTypeString(ADAPTER_TYPE_DISCRETE, true), "ADAPTER_TYPE_DISCRETE");
 }
 
+TEST(GraphicsAccessories_GraphicsAccessories, TicksToNanoseconds)
+{
+    EXPECT_EQ(TicksToNanoseconds(0, 1000), Uint64{0});
+    EXPECT_EQ(TicksToNanoseconds(1, 1000), Uint64{1000000});
+    EXPECT_EQ(TicksToNanoseconds(1500, 1000), Uint64{1500000000});
+    EXPECT_EQ(TicksToNanoseconds(12345, 1000000000), Uint64{12345});
+    EXPECT_EQ(TicksToNanoseconds(3, 10000000), Uint64{300});
+
+    // Multiplying these ticks by 10^9 overflows 64 bits, but the result fits
+    constexpr Uint64 Frequency = 10000000;
+    constexpr Uint64 Seconds   = Uint64{1} << 34;
+    EXPECT_EQ(TicksToNanoseconds(Seconds * Frequency + 7, Frequency), Seconds * 1000000000 + 700);
+}
+
+TEST(GraphicsAccessories_GraphicsAccessories, GPUTimestampToCPUTime)
+{
+    TimestampCalibration Calibration;
+    Calibration.GPUCounter   = 1000000;
+    Calibration.GPUFrequency = 1000000; // 1 tick = 1 us
+    Calibration.CPUTime      = 5000000000;
+
+    EXPECT_EQ(GPUTimestampToCPUTime(Calibration, 1000000), Uint64{5000000000});
+    EXPECT_EQ(GPUTimestampToCPUTime(Calibration, 1000250), Uint64{5000250000});
+    EXPECT_EQ(GPUTimestampToCPUTime(Calibration, 999000), Uint64{4999000000});
+    // Timestamps long before the calibration point are clamped to zero
+    Calibration.CPUTime = 1000;
+    EXPECT_EQ(GPUTimestampToCPUTime(Calibration, 0), Uint64{0});
+}
+
 } // namespace
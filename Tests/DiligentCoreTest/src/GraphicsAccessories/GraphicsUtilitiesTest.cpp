@@ -28,9 +28,13 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "ThreadPool.hpp"
+#include "GraphicsAccessories.hpp"
 
 #include <vector>
+#include <algorithm>
 #include <array>
+#include <type_traits>
 
 #include "gtest/gtest.h"
 
@@ -575,4 +579,215 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+
+template <typename ChannelType>
+std::vector<ChannelType> ComputeBoxAverageReference(const std::vector<ChannelType>& FineData,
+                                                    Uint32                          FineWidth,
+                                                    Uint32                          FineHeight,
+                                                    Uint32                          NumChannels)
+{
+    const Uint32 CoarseWidth  = FineWidth / 2;
+    const Uint32 CoarseHeight = FineHeight / 2;
+
+    std::vector<ChannelType> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+    for (Uint32 y = 0; y < CoarseHeight; ++y)
+    {
+        for (Uint32 x = 0; x < CoarseWidth; ++x)
+        {
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const auto c00 = FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c];
+                const auto c10 = FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c];
+                const auto c01 = FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c];
+                const auto c11 = FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c];
+
+                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] = std::is_floating_point<ChannelType>::value ?
+                    static_cast<ChannelType>((c00 + c10 + c01 + c11) * 0.25f) :
+                    static_cast<ChannelType>((c00 + c10 + c01 + c11) / 4);
+            }
+        }
+    }
+    return RefCoarseData;
+}
+
+// Covers full SIMD blocks as well as the remaining texels
+TEST(GraphicsTools_CalculateMipLevel, RGBA_BOX_AVE_Wide)
+{
+    for (Uint32 NumChannels = 1; NumChannels <= 4; NumChannels *= 2)
+    {
+        for (Uint32 FineWidth = 66; FineWidth <= 67; ++FineWidth)
+        {
+            const Uint32 FineHeight = 21;
+
+            std::vector<Uint8> FineData(FineWidth * FineHeight * NumChannels);
+
+            FastRandInt rnd(0, 0, 255);
+            for (auto& c : FineData)
+                c = static_cast<Uint8>(rnd());
+
+            const auto RefCoarseData = ComputeBoxAverageReference(FineData, FineWidth, FineHeight, NumChannels);
+
+            const Uint32       CoarseWidth = FineWidth / 2;
+            std::vector<Uint8> CoarseData(RefCoarseData.size());
+            ComputeMipLevel({NumChannels == 1 ? TEX_FORMAT_R8_UNORM : (NumChannels == 2 ? TEX_FORMAT_RG8_UNORM : TEX_FORMAT_RGBA8_UNORM),
+                             FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels, CoarseData.data(), CoarseWidth * NumChannels});
+            EXPECT_TRUE(CoarseData == RefCoarseData);
+        }
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, FLOAT32_BOX_AVE_Wide)
+{
+    for (Uint32 NumChannels = 1; NumChannels <= 4; NumChannels *= 2)
+    {
+        for (Uint32 FineWidth = 66; FineWidth <= 67; ++FineWidth)
+        {
+            const Uint32 FineHeight = 21;
+
+            std::vector<Float32> FineData(FineWidth * FineHeight * NumChannels);
+
+            FastRandFloat rnd(0, -1000.f, 1000.f);
+            for (auto& c : FineData)
+                c = rnd();
+
+            const auto RefCoarseData = ComputeBoxAverageReference(FineData, FineWidth, FineHeight, NumChannels);
+
+            const Uint32         CoarseWidth = FineWidth / 2;
+            std::vector<Float32> CoarseData(RefCoarseData.size());
+            ComputeMipLevel({NumChannels == 1 ? TEX_FORMAT_R32_FLOAT : (NumChannels == 2 ? TEX_FORMAT_RG32_FLOAT : TEX_FORMAT_RGBA32_FLOAT),
+                             FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels * sizeof(Float32), CoarseData.data(), CoarseWidth * NumChannels * sizeof(Float32)});
+            EXPECT_TRUE(CoarseData == RefCoarseData);
+        }
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, ThreadPool)
+{
+    const Uint32 FineWidth   = 301;
+    const Uint32 FineHeight  = 517;
+    const Uint32 NumChannels = 4;
+
+    std::vector<Uint8> FineData(FineWidth * FineHeight * NumChannels);
+
+    FastRandInt rnd(0, 0, 255);
+    for (auto& c : FineData)
+        c = static_cast<Uint8>(rnd());
+
+    const Uint32 CoarseWidth  = FineWidth / 2;
+    const Uint32 CoarseHeight = FineHeight / 2;
+
+    for (Uint32 NumThreads : {0u, 1u, 4u})
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA8_UINT})
+        {
+            ComputeMipLevelAttribs Attribs{Fmt, FineWidth, FineHeight, FineData.data(), FineWidth * NumChannels, nullptr, CoarseWidth * NumChannels};
+            Attribs.AlphaCutoff = Fmt != TEX_FORMAT_RGBA8_UINT ? 0.5f : 0.f;
+
+            std::vector<Uint8> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+            Attribs.pCoarseMipData = RefCoarseData.data();
+            ComputeMipLevel(Attribs);
+
+            std::vector<Uint8> CoarseData(RefCoarseData.size());
+            Attribs.pCoarseMipData = CoarseData.data();
+            Attribs.pThreadPool    = pThreadPool;
+            ComputeMipLevel(Attribs);
+            EXPECT_TRUE(CoarseData == RefCoarseData);
+        }
+
+        pThreadPool->WaitForAllTasks();
+        pThreadPool->StopThreads();
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, MipChain)
+{
+    const Uint32 Width       = 301;
+    const Uint32 Height      = 157;
+    const Uint32 ArraySize   = 3;
+    const Uint32 NumChannels = 4;
+    const Uint32 MipLevels   = ComputeMipLevelsCount(Width, Height);
+
+    FastRandInt rnd(0, 0, 255);
+
+    std::vector<std::vector<Uint8>> RefData(ArraySize * MipLevels);
+    std::vector<std::vector<Uint8>> Data(ArraySize * MipLevels);
+    std::vector<TextureSubResData>  SubResources(ArraySize * MipLevels);
+    for (Uint32 Slice = 0; Slice < ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < MipLevels; ++Mip)
+        {
+            const Uint32 MipWidth  = std::max(Width >> Mip, 1u);
+            const Uint32 MipHeight = std::max(Height >> Mip, 1u);
+            // Use padded rows to make sure that strides are respected
+            const Uint32 Stride = (MipWidth + 3) * NumChannels;
+
+            const Uint32 Idx = Slice * MipLevels + Mip;
+            RefData[Idx].resize(size_t{Stride} * MipHeight);
+            Data[Idx].resize(RefData[Idx].size());
+            if (Mip == 0)
+            {
+                for (auto& c : RefData[Idx])
+                    c = static_cast<Uint8>(rnd());
+                Data[Idx] = RefData[Idx];
+            }
+            SubResources[Idx] = TextureSubResData{Data[Idx].data(), Stride};
+        }
+    }
+
+    for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RGBA8_UINT})
+    {
+        const float AlphaCutoff = Fmt != TEX_FORMAT_RGBA8_UINT ? 0.5f : 0.f;
+
+        for (Uint32 Slice = 0; Slice < ArraySize; ++Slice)
+        {
+            for (Uint32 Mip = 1; Mip < MipLevels; ++Mip)
+            {
+                const Uint32 Idx = Slice * MipLevels + Mip;
+
+                ComputeMipLevelAttribs Attribs{
+                    Fmt,
+                    std::max(Width >> (Mip - 1), 1u),
+                    std::max(Height >> (Mip - 1), 1u),
+                    RefData[Idx - 1].data(),
+                    static_cast<size_t>(SubResources[Idx - 1].Stride),
+                    RefData[Idx].data(),
+                    static_cast<size_t>(SubResources[Idx].Stride),
+                };
+                Attribs.AlphaCutoff = AlphaCutoff;
+                ComputeMipLevel(Attribs);
+            }
+        }
+
+        for (Uint32 NumThreads : {0u, 1u, 4u})
+        {
+            auto pThreadPool = NumThreads > 0 ? CreateThreadPool(ThreadPoolCreateInfo{NumThreads}) : RefCntAutoPtr<IThreadPool>{};
+
+            for (Uint32 Idx = 0; Idx < Data.size(); ++Idx)
+            {
+                if (Idx % MipLevels != 0)
+                    std::fill(Data[Idx].begin(), Data[Idx].end(), Uint8{0});
+            }
+
+            ComputeMipChainAttribs Attribs{Fmt, Width, Height, ArraySize, 0, SubResources.data()};
+            Attribs.AlphaCutoff = AlphaCutoff;
+            Attribs.pThreadPool = pThreadPool;
+            ComputeMipChain(Attribs);
+
+            for (Uint32 Idx = 0; Idx < Data.size(); ++Idx)
+            {
+                EXPECT_TRUE(Data[Idx] == RefData[Idx]) << "Slice " << Idx / MipLevels << ", mip " << Idx % MipLevels << ", " << NumThreads << " threads";
+            }
+
+            if (pThreadPool)
+            {
+                pThreadPool->WaitForAllTasks();
+                pThreadPool->StopThreads();
+            }
+        }
+    }
+}
+
 } // namespace
@@ -26,9 +26,13 @@
  */
 
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "TrackingMemoryAllocator.hpp"
 
 #include "gtest/gtest.h"
 
@@ -128,4 +132,121 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+TEST(GraphicsAccessories_ResourceReleaseQueue, MultithreadedRelease)
+{
+    std::atomic<int> NumDestroyed{0};
+
+    struct Resource
+    {
+        std::atomic<int>* pCounter = nullptr;
+
+        explicit Resource(std::atomic<int>* _pCounter) :
+            pCounter{_pCounter}
+        {}
+        Resource(Resource&& rhs) :
+            pCounter{rhs.pCounter}
+        {
+            rhs.pCounter = nullptr;
+        }
+        ~Resource()
+        {
+            if (pCounter != nullptr)
+                pCounter->fetch_add(1);
+        }
+    };
+
+    constexpr int NumThreads            = 4;
+    constexpr int NumResourcesPerThread = 1000;
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+        std::vector<std::thread> Threads;
+        for (int t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&]() {
+                for (int i = 0; i < NumResourcesPerThread; ++i)
+                    Queue.SafeReleaseResource(Resource{&NumDestroyed}, 1);
+            });
+        }
+
+        // Discard and purge while other threads are releasing resources
+        for (Uint64 i = 0; i < 10; ++i)
+        {
+            Queue.DiscardStaleResources(1, i);
+            Queue.Purge(i);
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        // Resources released with the command list number that has not been submitted must stay in the stale list
+        Queue.SafeReleaseResource(Resource{&NumDestroyed}, 2);
+
+        Queue.DiscardStaleResources(1, 10);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), 1u);
+
+        std::vector<DynamicStaleResourceWrapper> RetiredResources;
+        Queue.ExtractCompletedResources(10, RetiredResources);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+        EXPECT_EQ(static_cast<int>(RetiredResources.size()) + NumDestroyed.load(), NumThreads * NumResourcesPerThread);
+
+        RetiredResources.clear();
+        EXPECT_EQ(NumDestroyed.load(), NumThreads * NumResourcesPerThread);
+
+        Queue.DiscardStaleResources(2, 11);
+        Queue.Purge(11);
+    }
+    EXPECT_EQ(NumDestroyed.load(), NumThreads * NumResourcesPerThread + 1);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, SteadyStateAllocations)
+{
+    struct Resource
+    {
+        int Data = 0;
+    };
+
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr Uint32 QueueTag     = 1;
+    constexpr int    NumResources = 100;
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{Allocator, QueueTag};
+
+        auto RunFrame = [&](Uint64 Frame) {
+            for (int i = 0; i < NumResources; ++i)
+            {
+                // Odd resources go through the stale list, even resources are discarded directly
+                if (i & 0x01)
+                    Queue.SafeReleaseResource(Resource{i}, Frame);
+                else
+                    Queue.DiscardResource(Resource{i}, Frame);
+            }
+            Queue.DiscardStaleResources(Frame, Frame);
+            // Keep one frame in flight
+            if (Frame > 0)
+                Queue.Purge(Frame - 1);
+        };
+
+        Uint64 Frame = 0;
+        for (; Frame < 4; ++Frame)
+            RunFrame(Frame);
+
+        const auto WarmUpStats = Allocator.GetTagStatistics(QueueTag);
+        EXPECT_GT(WarmUpStats.TotalAllocationCount, 0u);
+
+        for (; Frame < 16; ++Frame)
+            RunFrame(Frame);
+
+        const auto SteadyStats = Allocator.GetTagStatistics(QueueTag);
+        EXPECT_EQ(SteadyStats.TotalAllocationCount, WarmUpStats.TotalAllocationCount);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{NumResources});
+
+        Queue.Purge(Frame);
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+    }
+    EXPECT_EQ(Allocator.GetTagStatistics(QueueTag).CurrentAllocationCount, 0u);
+}
+
 } // namespace
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShelfAtlasManager.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Region = ShelfAtlasManager::Region;
+
+bool RegionsOverlap(const Region& R0, const Region& R1)
+{
+    return R0.x < R1.x + R1.width && R1.x < R0.x + R0.width &&
+        R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, Allocate)
+{
+    ShelfAtlasManager Mgr{64, 64};
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 64u * 64u);
+
+    EXPECT_TRUE(Mgr.Allocate(65, 1).IsEmpty());
+    EXPECT_TRUE(Mgr.Allocate(1, 65).IsEmpty());
+
+    // Regions of the same height share the shelf
+    auto R0 = Mgr.Allocate(16, 8);
+    EXPECT_EQ(R0, Region(0, 0, 16, 8));
+    auto R1 = Mgr.Allocate(32, 8);
+    EXPECT_EQ(R1, Region(16, 0, 32, 8));
+    auto R2 = Mgr.Allocate(16, 7);
+    EXPECT_EQ(R2, Region(48, 0, 16, 7));
+    EXPECT_EQ(Mgr.GetShelfCount(), 1u);
+
+    // The first shelf is full
+    auto R3 = Mgr.Allocate(8, 8);
+    EXPECT_EQ(R3, Region(0, 8, 8, 8));
+
+    // The region is too low for existing shelves
+    auto R4 = Mgr.Allocate(8, 2);
+    EXPECT_EQ(R4, Region(0, 16, 8, 2));
+    EXPECT_EQ(Mgr.GetShelfCount(), 3u);
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 64u * 64u - (16 * 8 + 32 * 8 + 16 * 7 + 8 * 8 + 8 * 2));
+
+    // Free span in the middle of the first shelf is reused
+    Mgr.Free(std::move(R1));
+    auto R5 = Mgr.Allocate(24, 8);
+    EXPECT_EQ(R5, Region(16, 0, 24, 8));
+
+    Mgr.Free(std::move(R0));
+    Mgr.Free(std::move(R2));
+    Mgr.Free(std::move(R5));
+    EXPECT_EQ(Mgr.GetShelfCount(), 3u);
+
+    // The empty first shelf is split
+    auto R6 = Mgr.Allocate(64, 4);
+    EXPECT_EQ(R6, Region(0, 0, 64, 4));
+    EXPECT_EQ(Mgr.GetShelfCount(), 4u);
+
+    Mgr.Free(std::move(R6));
+    Mgr.Free(std::move(R4));
+    Mgr.Free(std::move(R3));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetShelfCount(), 0u);
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 64u * 64u);
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, UniformTiles)
+{
+    ShelfAtlasManager Mgr{256, 256};
+
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 16 * 16; ++i)
+    {
+        Regions.emplace_back(Mgr.Allocate(16, 16));
+        EXPECT_FALSE(Regions.back().IsEmpty());
+    }
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 0u);
+    EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+    // Free every other tile and allocate them again
+    for (size_t i = 0; i < Regions.size(); i += 2)
+        Mgr.Free(std::move(Regions[i]));
+    for (size_t i = 0; i < Regions.size(); i += 2)
+    {
+        Regions[i] = Mgr.Allocate(16, 16);
+        EXPECT_FALSE(Regions[i].IsEmpty());
+    }
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 0u);
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, Random)
+{
+    ShelfAtlasManager Mgr{512, 512};
+
+    FastRandInt Rnd{0, 1, 32};
+
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 4096; ++i)
+    {
+        if (!Regions.empty() && Rnd() < 12)
+        {
+            const size_t Idx = Rnd() % Regions.size();
+            Mgr.Free(std::move(Regions[Idx]));
+            Regions[Idx] = Regions.back();
+            Regions.pop_back();
+        }
+        else
+        {
+            const auto W = static_cast<Uint32>(Rnd());
+            const auto H = static_cast<Uint32>(Rnd());
+            auto       R = Mgr.Allocate(W, H);
+            if (R.IsEmpty())
+                continue;
+
+            EXPECT_EQ(R.width, W);
+            EXPECT_EQ(R.height, H);
+            EXPECT_LE(R.x + R.width, 512u);
+            EXPECT_LE(R.y + R.height, 512u);
+            for (const auto& R1 : Regions)
+                EXPECT_FALSE(RegionsOverlap(R, R1));
+
+            Regions.emplace_back(R);
+        }
+    }
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetShelfCount(), 0u);
+}
+
+} // namespace
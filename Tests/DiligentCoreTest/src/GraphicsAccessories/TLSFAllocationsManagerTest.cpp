@@ -0,0 +1,330 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "TLSFAllocationsManager.hpp"
+#include "VariableSizeGPUAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using OffsetType = TLSFAllocationsManager::OffsetType;
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(128, Allocator);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetFreeSize(), size_t{128});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128});
+
+    auto a1 = Mgr.Allocate(17, 4);
+    EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(a1.Size, OffsetType{20});
+    EXPECT_EQ(Mgr.GetUsedSize(), size_t{20});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128 - 20});
+
+    auto a2 = Mgr.Allocate(17, 8);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{20});
+    EXPECT_EQ(a2.Size, OffsetType{28});
+
+    auto a3 = Mgr.Allocate(8, 1);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{48});
+    EXPECT_EQ(a3.Size, OffsetType{8});
+
+    auto a4 = Mgr.Allocate(72, 1);
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{56});
+    EXPECT_EQ(a4.Size, OffsetType{72});
+    EXPECT_TRUE(Mgr.IsFull());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{0});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{0});
+
+    EXPECT_FALSE(Mgr.Allocate(8, 1).IsValid());
+
+    Mgr.Free(std::move(a3));
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    Mgr.Free(std::move(a1));
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{2});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{20});
+
+    // Only the block at offset 0 is large enough
+    auto a5 = Mgr.Allocate(12, 1);
+    EXPECT_EQ(a5.UnalignedOffset, OffsetType{0});
+
+    Mgr.Free(a2.UnalignedOffset, a2.Size);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{44});
+
+    Mgr.Free(std::move(a5));
+    Mgr.Free(std::move(a4));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    const auto NumAllocs = 6;
+    int        NumPerms  = 0;
+    size_t     ReleaseOrder[NumAllocs];
+    for (size_t a = 0; a < NumAllocs; ++a)
+        ReleaseOrder[a] = a;
+    do
+    {
+        ++NumPerms;
+        TLSFAllocationsManager Mgr(NumAllocs * 4, Allocator);
+
+        TLSFAllocationsManager::Allocation allocs[NumAllocs];
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            allocs[a] = Mgr.Allocate(4, 1);
+            EXPECT_EQ(allocs[a].UnalignedOffset, a * 4);
+            EXPECT_EQ(allocs[a].Size, OffsetType{4});
+        }
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            Mgr.Free(std::move(allocs[ReleaseOrder[a]]));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
+    EXPECT_EQ(NumPerms, 720);
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Extend)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(128, Allocator);
+
+    auto a1 = Mgr.Allocate(64, 1);
+    EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+    EXPECT_FALSE(Mgr.Allocate(128, 1).IsValid());
+
+    Mgr.Extend(128);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+
+    auto a2 = Mgr.Allocate(128, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{64});
+    EXPECT_EQ(a2.Size, OffsetType{128});
+
+    auto a3 = Mgr.Allocate(64, 1);
+    EXPECT_TRUE(Mgr.IsFull());
+
+    Mgr.Extend(32);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    auto a4 = Mgr.Allocate(32, 1);
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{256});
+    EXPECT_TRUE(Mgr.IsFull());
+
+    Mgr.Free(std::move(a1));
+    Mgr.Extend(1024);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{2});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{1024});
+
+    Mgr.Free(std::move(a4));
+    Mgr.Free(std::move(a2));
+    Mgr.Free(std::move(a3));
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateLowest)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(128, Allocator);
+
+    TLSFAllocationsManager::Allocation al[8];
+    for (size_t a = 0; a < _countof(al); ++a)
+        al[a] = Mgr.Allocate(16, 1);
+    EXPECT_TRUE(Mgr.IsFull());
+
+    // Free blocks: [16, 48), [96, 112)
+    Mgr.Free(std::move(al[1]));
+    Mgr.Free(std::move(al[2]));
+    Mgr.Free(std::move(al[6]));
+
+    {
+        auto a = Mgr.AllocateLowest(16, 1, 128);
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{16});
+        EXPECT_EQ(a.Size, OffsetType{16});
+        Mgr.Free(std::move(a));
+    }
+
+    EXPECT_FALSE(Mgr.AllocateLowest(16, 1, 16).IsValid());
+    EXPECT_FALSE(Mgr.AllocateLowest(48, 1, 128).IsValid());
+
+    al[1] = Mgr.AllocateLowest(32, 1, 64);
+    EXPECT_EQ(al[1].UnalignedOffset, OffsetType{16});
+    EXPECT_EQ(al[1].Size, OffsetType{32});
+
+    for (auto& a : al)
+    {
+        if (a.IsValid())
+            Mgr.Free(std::move(a));
+    }
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, GPUAllocationsManager)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFGPUAllocationsManager Mgr(128, Allocator);
+
+    TLSFGPUAllocationsManager::Allocation al[16];
+    for (size_t o = 0; o < _countof(al); ++o)
+        al[o] = Mgr.Allocate(8, 4);
+    EXPECT_TRUE(Mgr.IsFull());
+
+    for (size_t o = 0; o < _countof(al); ++o)
+        Mgr.Free(std::move(al[(o * 5) % _countof(al)]), o / 4);
+    EXPECT_EQ(Mgr.GetStaleAllocationsSize(), size_t{128});
+
+    Mgr.ReleaseStaleAllocations(1);
+    EXPECT_EQ(Mgr.GetStaleAllocationsSize(), size_t{64});
+    EXPECT_EQ(Mgr.GetFreeSize(), size_t{64});
+
+    Mgr.ReleaseStaleAllocations(3);
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+}
+
+// Allocates and releases random-size blocks, keeping up to MaxLiveAllocations alive.
+template <typename AllocationsManagerType>
+double RunRandomWorkload(AllocationsManagerType& Mgr, size_t NumIterations, size_t MaxLiveAllocations, Uint32 Seed)
+{
+    FastRandInt SizeRnd{Seed, 1, 256};
+    FastRandInt AlignRnd{Seed + 1, 0, 4};
+    FastRandInt IdxRnd{Seed + 2, 0, static_cast<int>(MaxLiveAllocations) - 1};
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocations(MaxLiveAllocations);
+
+    Timer T;
+    for (size_t i = 0; i < NumIterations; ++i)
+    {
+        auto& Alloc = Allocations[IdxRnd()];
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+        else
+            Alloc = Mgr.Allocate(static_cast<OffsetType>(SizeRnd()), OffsetType{1} << AlignRnd());
+    }
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+    return T.GetElapsedTime();
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, RandomAllocations)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    static constexpr size_t MaxLiveAllocations = 512;
+
+    TLSFAllocationsManager Mgr(MaxLiveAllocations * 128, Allocator);
+
+    FastRandInt SizeRnd{0, 1, 256};
+    FastRandInt IdxRnd{1, 0, static_cast<int>(MaxLiveAllocations) - 1};
+
+    std::vector<TLSFAllocationsManager::Allocation> Allocations(MaxLiveAllocations);
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        auto& Alloc = Allocations[IdxRnd()];
+        if (Alloc.IsValid())
+        {
+            Mgr.Free(std::move(Alloc));
+            continue;
+        }
+
+        Alloc = Mgr.Allocate(static_cast<OffsetType>(SizeRnd()), 4);
+        if (!Alloc.IsValid())
+            continue;
+
+        // The new allocation must not overlap any live allocation
+        for (const auto& Other : Allocations)
+        {
+            if (&Other == &Alloc || !Other.IsValid())
+                continue;
+            EXPECT_TRUE(Alloc.UnalignedOffset + Alloc.Size <= Other.UnalignedOffset ||
+                        Other.UnalignedOffset + Other.Size <= Alloc.UnalignedOffset);
+        }
+    }
+
+    OffsetType UsedSize = 0;
+    for (const auto& Alloc : Allocations)
+        UsedSize += Alloc.Size;
+    EXPECT_EQ(Mgr.GetUsedSize(), UsedSize);
+
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Benchmark)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+#ifdef DILIGENT_DEBUG
+    // Free block lists are fully verified after every operation in debug builds
+    static constexpr size_t NumIterations = 4096;
+#else
+    static constexpr size_t NumIterations = 1 << 20;
+#endif
+    for (size_t MaxLiveAllocations : {size_t{256}, size_t{4096}})
+    {
+        VariableSizeAllocationsManager MapMgr(MaxLiveAllocations * 128, Allocator);
+        TLSFAllocationsManager         TLSFMgr(MaxLiveAllocations * 128, Allocator);
+
+        const double MapTime  = RunRandomWorkload(MapMgr, NumIterations, MaxLiveAllocations, 19);
+        const double TLSFTime = RunRandomWorkload(TLSFMgr, NumIterations, MaxLiveAllocations, 19);
+
+        EXPECT_TRUE(MapMgr.IsEmpty());
+        EXPECT_TRUE(TLSFMgr.IsEmpty());
+
+        LOG_INFO_MESSAGE(NumIterations, " operations, up to ", MaxLiveAllocations, " live allocations: VariableSizeAllocationsManager ",
+                         MapTime * 1000.0, " ms, TLSFAllocationsManager ", TLSFTime * 1000.0, " ms");
+    }
+}
+
+} // namespace
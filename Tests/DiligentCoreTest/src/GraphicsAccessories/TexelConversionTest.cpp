@@ -0,0 +1,271 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TexelConversion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "ColorConversion.h"
+
+#include "gtest/gtest.h"
+
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Odd width exercises both the SIMD kernels and the scalar tails
+constexpr Uint32 TestWidth  = 21;
+constexpr Uint32 TestHeight = 5;
+
+template <typename SrcType, typename DstType>
+void Convert(TEXEL_CONVERSION Conversion, const std::vector<SrcType>& Src, size_t SrcStride, std::vector<DstType>& Dst, size_t DstStride, Uint32 Width, Uint32 NumRows, Uint32 NumComponents = 1)
+{
+    ConvertTexelDataAttribs Attribs;
+    Attribs.Conversion    = Conversion;
+    Attribs.Width         = Width;
+    Attribs.NumRows       = NumRows;
+    Attribs.NumComponents = NumComponents;
+    Attribs.pSrcData      = Src.data();
+    Attribs.SrcStride     = SrcStride;
+    Attribs.pDstData      = Dst.data();
+    Attribs.DstStride     = DstStride;
+    EXPECT_TRUE(ConvertTexelData(Attribs));
+}
+
+TEST(GraphicsAccessories_TexelConversion, RGB8ToRGBA8)
+{
+    // Padded source and destination rows
+    constexpr size_t SrcStride = TestWidth * 3 + 5;
+    constexpr size_t DstStride = TestWidth * 4 + 12;
+
+    std::vector<Uint8> Src(SrcStride * TestHeight);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>(i * 7 + 3);
+
+    std::vector<Uint8> Dst(DstStride * TestHeight, 0xCD);
+    Convert(TEXEL_CONVERSION_RGB8_TO_RGBA8, Src, SrcStride, Dst, DstStride, TestWidth, TestHeight);
+
+    for (Uint32 y = 0; y < TestHeight; ++y)
+    {
+        for (Uint32 x = 0; x < TestWidth; ++x)
+        {
+            const Uint8* pSrc = &Src[y * SrcStride + x * 3];
+            const Uint8* pDst = &Dst[y * DstStride + x * 4];
+            EXPECT_EQ(pDst[0], pSrc[0]) << x << " " << y;
+            EXPECT_EQ(pDst[1], pSrc[1]) << x << " " << y;
+            EXPECT_EQ(pDst[2], pSrc[2]) << x << " " << y;
+            EXPECT_EQ(pDst[3], 255) << x << " " << y;
+        }
+        // Padding must not be touched
+        for (size_t i = TestWidth * 4; i < DstStride; ++i)
+            EXPECT_EQ(Dst[y * DstStride + i], 0xCD);
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, BGRA8ToRGBA8)
+{
+    constexpr size_t SrcStride = TestWidth * 4 + 4;
+    constexpr size_t DstStride = TestWidth * 4;
+
+    std::vector<Uint8> Src(SrcStride * TestHeight);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint8>(i * 13 + 1);
+
+    std::vector<Uint8> Dst(DstStride * TestHeight);
+    Convert(TEXEL_CONVERSION_BGRA8_TO_RGBA8, Src, SrcStride, Dst, DstStride, TestWidth, TestHeight);
+
+    for (Uint32 y = 0; y < TestHeight; ++y)
+    {
+        for (Uint32 x = 0; x < TestWidth; ++x)
+        {
+            const Uint8* pSrc = &Src[y * SrcStride + x * 4];
+            const Uint8* pDst = &Dst[y * DstStride + x * 4];
+            EXPECT_EQ(pDst[0], pSrc[2]) << x << " " << y;
+            EXPECT_EQ(pDst[1], pSrc[1]) << x << " " << y;
+            EXPECT_EQ(pDst[2], pSrc[0]) << x << " " << y;
+            EXPECT_EQ(pDst[3], pSrc[3]) << x << " " << y;
+        }
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, Float32ToFloat16)
+{
+    // clang-format off
+    const float Values[] =
+    {
+        1.f, 0.5f, 65504.f, 1e6f, std::numeric_limits<float>::quiet_NaN(), -2.f, std::ldexp(1.f, -24), 0.f,
+        -0.f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 65520.f, 1.f + std::ldexp(1.f, -11), 1.f + 3.f * std::ldexp(1.f, -11), std::ldexp(1.f, -14), std::ldexp(1.f, -26),
+        -65504.f, 0.333333f, 1024.5f
+    };
+    const Uint16 Expected[] =
+    {
+        0x3C00,  0x3800, 0x7BFF,   0x7C00, 0x7E00, 0xC000, 0x0001,  0x0000,
+        0x8000,  0x7C00, 0xFC00,   0x7C00, 0x3C00, 0x3C02, 0x0400,  0x0000,
+        0xFBFF,  0x3555, 0x6400
+    };
+    // clang-format on
+    static_assert(sizeof(Values) / sizeof(Values[0]) == sizeof(Expected) / sizeof(Expected[0]), "Array size mismatch");
+
+    constexpr Uint32 NumRows = 3;
+    constexpr Uint32 Count   = sizeof(Values) / sizeof(Values[0]);
+    constexpr size_t SrcRow  = Count + 3;
+    constexpr size_t DstRow  = Count + 5;
+
+    std::vector<float> Src(SrcRow * NumRows);
+    for (Uint32 y = 0; y < NumRows; ++y)
+    {
+        // Shift the values to test every lane
+        for (Uint32 i = 0; i < Count; ++i)
+            Src[y * SrcRow + i] = Values[(i + y) % Count];
+    }
+
+    std::vector<Uint16> Dst(DstRow * NumRows);
+    Convert(TEXEL_CONVERSION_FLOAT32_TO_FLOAT16, Src, SrcRow * sizeof(float), Dst, DstRow * sizeof(Uint16), Count, NumRows);
+
+    for (Uint32 y = 0; y < NumRows; ++y)
+    {
+        for (Uint32 i = 0; i < Count; ++i)
+            EXPECT_EQ(Dst[y * DstRow + i], Expected[(i + y) % Count]) << "Value: " << Values[(i + y) % Count];
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, UNorm16ToFloat32)
+{
+    constexpr Uint32 NumComponents = 2;
+    constexpr size_t SrcRow        = TestWidth * NumComponents + 1;
+    constexpr size_t DstRow        = TestWidth * NumComponents + 2;
+
+    std::vector<Uint16> Src(SrcRow * TestHeight);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<Uint16>(i * 3119);
+    Src[0] = 0;
+    Src[1] = 65535;
+
+    std::vector<float> Dst(DstRow * TestHeight);
+    Convert(TEXEL_CONVERSION_UNORM16_TO_FLOAT32, Src, SrcRow * sizeof(Uint16), Dst, DstRow * sizeof(float), TestWidth, TestHeight, NumComponents);
+
+    EXPECT_EQ(Dst[0], 0.f);
+    EXPECT_EQ(Dst[1], 1.f);
+    for (Uint32 y = 0; y < TestHeight; ++y)
+    {
+        for (Uint32 i = 0; i < TestWidth * NumComponents; ++i)
+            EXPECT_EQ(Dst[y * DstRow + i], static_cast<float>(Src[y * SrcRow + i]) * (1.f / 65535.f));
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, RGBA8LinearToSRGB)
+{
+    std::vector<Uint8> Src(256 * 4);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        Src[i * 4 + 0] = static_cast<Uint8>(i);
+        Src[i * 4 + 1] = static_cast<Uint8>(255 - i);
+        Src[i * 4 + 2] = static_cast<Uint8>(i * 3);
+        Src[i * 4 + 3] = static_cast<Uint8>(i * 5);
+    }
+
+    std::vector<Uint8> Dst(Src.size());
+    Convert(TEXEL_CONVERSION_RGBA8_LINEAR_TO_SRGB, Src, Src.size(), Dst, Dst.size(), 256, 1);
+
+    auto ToSRGB = [](Uint8 c) {
+        return static_cast<Uint8>(LinearToSRGB(c) * 255.f + 0.5f);
+    };
+    EXPECT_EQ(Dst[0], 0);
+    EXPECT_EQ(Dst[255 * 4], 255);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        EXPECT_EQ(Dst[i * 4 + 0], ToSRGB(Src[i * 4 + 0]));
+        EXPECT_EQ(Dst[i * 4 + 1], ToSRGB(Src[i * 4 + 1]));
+        EXPECT_EQ(Dst[i * 4 + 2], ToSRGB(Src[i * 4 + 2]));
+        EXPECT_EQ(Dst[i * 4 + 3], Src[i * 4 + 3]);
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, RGBA32FLinearToRGBA8SRGB)
+{
+    constexpr size_t SrcRow = TestWidth * 4 + 4;
+    constexpr size_t DstRow = TestWidth * 4 + 8;
+
+    std::vector<float> Src(SrcRow * TestHeight);
+    for (size_t i = 0; i < Src.size(); ++i)
+        Src[i] = static_cast<float>(i % 97) / 90.f - 0.05f;
+    // Out-of-range and special values
+    Src[0] = -1.f;
+    Src[1] = 2.f;
+    Src[2] = std::numeric_limits<float>::quiet_NaN();
+    Src[3] = 1.f;
+    Src[4] = 0.001f;
+    Src[5] = 0.5f;
+
+    std::vector<Uint8> Dst(DstRow * TestHeight);
+    Convert(TEXEL_CONVERSION_RGBA32F_LINEAR_TO_RGBA8_SRGB, Src, SrcRow * sizeof(float), Dst, DstRow, TestWidth, TestHeight);
+
+    EXPECT_EQ(Dst[0], 0);
+    EXPECT_EQ(Dst[1], 255);
+    EXPECT_EQ(Dst[2], 0);
+    EXPECT_EQ(Dst[3], 255);
+    for (Uint32 y = 0; y < TestHeight; ++y)
+    {
+        for (Uint32 x = 0; x < TestWidth; ++x)
+        {
+            const float* pSrc = &Src[y * SrcRow + x * 4];
+            const Uint8* pDst = &Dst[y * DstRow + x * 4];
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                float Val = pSrc[c];
+                if (!(Val >= 0.f))
+                    Val = 0.f;
+                if (Val > 1.f)
+                    Val = 1.f;
+                const float  Ref   = c < 3 ? FastLinearToSRGB(Val) : Val;
+                const double Delta = std::abs(static_cast<double>(pDst[c]) - std::min(static_cast<double>(Ref), 1.0) * 255.0);
+                EXPECT_LE(Delta, 0.5 + 1e-3) << "Texel " << x << " " << y << ", component " << c;
+            }
+        }
+    }
+}
+
+TEST(GraphicsAccessories_TexelConversion, InvalidAttribs)
+{
+    TestingEnvironment::ErrorScope ExpectedErrors{"Source and destination data must not be null"};
+
+    ConvertTexelDataAttribs Attribs;
+    Attribs.Conversion = TEXEL_CONVERSION_BGRA8_TO_RGBA8;
+    Attribs.Width      = 4;
+    Attribs.NumRows    = 1;
+    EXPECT_FALSE(ConvertTexelData(Attribs));
+}
+
+} // namespace
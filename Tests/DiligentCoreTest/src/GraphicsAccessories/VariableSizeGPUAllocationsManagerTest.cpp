@@ -249,4 +249,108 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateLowest)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    VariableSizeAllocationsManager ListMgr(128, Allocator);
+
+    VariableSizeAllocationsManager::Allocation al[8];
+    for (size_t a = 0; a < _countof(al); ++a)
+        al[a] = ListMgr.Allocate(16, 1);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    // Free blocks: [16, 48), [96, 112)
+    ListMgr.Free(std::move(al[1]));
+    ListMgr.Free(std::move(al[2]));
+    ListMgr.Free(std::move(al[6]));
+
+    {
+        // Allocate() uses the smallest block
+        auto a = ListMgr.Allocate(16, 1);
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{96});
+        ListMgr.Free(std::move(a));
+    }
+
+    {
+        auto a = ListMgr.AllocateLowest(16, 1, 128);
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{16});
+        EXPECT_EQ(a.Size, OffsetType{16});
+        ListMgr.Free(std::move(a));
+    }
+
+    {
+        // The block must start before MaxOffset
+        auto a = ListMgr.AllocateLowest(16, 1, 16);
+        EXPECT_FALSE(a.IsValid());
+    }
+
+    {
+        // No free block is large enough
+        auto a = ListMgr.AllocateLowest(48, 1, 128);
+        EXPECT_FALSE(a.IsValid());
+        a = ListMgr.AllocateLowest(32, 1, 64);
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{16});
+        EXPECT_EQ(a.Size, OffsetType{32});
+        al[1] = std::move(a);
+    }
+
+    {
+        auto a = ListMgr.AllocateLowest(8, 8, 128);
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{96});
+        EXPECT_EQ(a.Size, OffsetType{8});
+        al[6] = std::move(a);
+    }
+
+    for (auto& a : al)
+    {
+        if (a.IsValid())
+            ListMgr.Free(std::move(a));
+    }
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+template <typename GPUAllocationsManagerType>
+void TestBulkRelease()
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = typename GPUAllocationsManagerType::OffsetType;
+
+    constexpr size_t NumAllocs = 64;
+
+    GPUAllocationsManagerType ListMgr(NumAllocs * 16, Allocator);
+
+    typename GPUAllocationsManagerType::Allocation al[NumAllocs];
+    for (size_t a = 0; a < NumAllocs; ++a)
+        al[a] = ListMgr.Allocate(16, 1);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    // Release allocations in scrambled order with two fence values:
+    // odd allocations with fence 1, even allocations with fence 2
+    for (size_t i = 0; i < NumAllocs; ++i)
+    {
+        const auto a = (i * 37) % NumAllocs;
+        ListMgr.Free(std::move(al[a]), (a & 0x01) ? 1 : 2);
+    }
+    EXPECT_EQ(ListMgr.GetStaleAllocationsSize(), NumAllocs * 16);
+
+    // Only fence-1 allocations that are at the front of the queue are released
+    ListMgr.ReleaseStaleAllocations(1);
+    EXPECT_EQ(ListMgr.GetFreeSize() + ListMgr.GetStaleAllocationsSize(), NumAllocs * 16);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), ListMgr.GetFreeSize() / 16);
+
+    ListMgr.ReleaseStaleAllocations(2);
+    EXPECT_EQ(ListMgr.GetStaleAllocationsSize(), size_t{0});
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), OffsetType{NumAllocs * 16});
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, BulkRelease)
+{
+    TestBulkRelease<VariableSizeGPUAllocationsManager>();
+    TestBulkRelease<TLSFGPUAllocationsManager>();
+}
+
 } // namespace
@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CompilationStatisticsImpl.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void Sleep(Uint32 Milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds{Milliseconds});
+}
+
+std::string BlobToString(IDataBlob* pBlob)
+{
+    return std::string{static_cast<const char*>(pBlob->GetConstDataPtr()), pBlob->GetSize()};
+}
+
+TEST(GraphicsEngine_CompilationStatistics, Records)
+{
+    RefCntAutoPtr<CompilationStatisticsImpl> pStats{MakeNewRCObj<CompilationStatisticsImpl>()()};
+    EXPECT_EQ(pStats->GetRecordCount(), 0u);
+
+    {
+        CompilationRecordScope Scope{pStats, COMPILATION_RECORD_TYPE_SHADER, SHADER_TYPE_PIXEL, "Test PS"};
+        EXPECT_TRUE(Scope.IsActive());
+        {
+            CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+            Sleep(10);
+        }
+        Scope.SetByteCodeSize(128);
+    }
+
+    {
+        CompilationRecordScope Scope{pStats, COMPILATION_RECORD_TYPE_PIPELINE, SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "Test PSO"};
+        CompilationStageTimer  Timer{COMPILATION_STAGE_DRIVER};
+    }
+
+    ASSERT_EQ(pStats->GetRecordCount(), 2u);
+
+    const auto& ShaderRecord = pStats->GetRecord(0);
+    EXPECT_EQ(ShaderRecord.Type, COMPILATION_RECORD_TYPE_SHADER);
+    EXPECT_EQ(ShaderRecord.ShaderType, SHADER_TYPE_PIXEL);
+    EXPECT_STREQ(ShaderRecord.Name, "Test PS");
+    EXPECT_EQ(ShaderRecord.ByteCodeSize, 128u);
+    EXPECT_GE(ShaderRecord.StageDurations[COMPILATION_STAGE_COMPILE], 10000u);
+    EXPECT_GE(ShaderRecord.Duration, ShaderRecord.StageDurations[COMPILATION_STAGE_COMPILE]);
+    EXPECT_EQ(ShaderRecord.StageDurations[COMPILATION_STAGE_PREPROCESS], 0u);
+
+    const auto& PipelineRecord = pStats->GetRecord(1);
+    EXPECT_EQ(PipelineRecord.Type, COMPILATION_RECORD_TYPE_PIPELINE);
+    EXPECT_EQ(PipelineRecord.ShaderType, SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL);
+    EXPECT_STREQ(PipelineRecord.Name, "Test PSO");
+    EXPECT_GE(PipelineRecord.StartTime, ShaderRecord.StartTime + ShaderRecord.Duration);
+
+    pStats->Reset();
+    EXPECT_EQ(pStats->GetRecordCount(), 0u);
+}
+
+TEST(GraphicsEngine_CompilationStatistics, NestedTimers)
+{
+    RefCntAutoPtr<CompilationStatisticsImpl> pStats{MakeNewRCObj<CompilationStatisticsImpl>()()};
+
+    {
+        CompilationRecordScope Scope{pStats, COMPILATION_RECORD_TYPE_SHADER, SHADER_TYPE_VERTEX, "Test VS"};
+
+        CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+        {
+            CompilationStageTimer InnerTimer{COMPILATION_STAGE_OPTIMIZE};
+            Sleep(20);
+        }
+
+        // A nested record is collected independently and does not affect the outer one
+        {
+            CompilationRecordScope InnerScope{pStats, COMPILATION_RECORD_TYPE_SHADER, SHADER_TYPE_PIXEL, "Inner PS"};
+            CompilationStageTimer  InnerTimer{COMPILATION_STAGE_PREPROCESS};
+        }
+    }
+    EXPECT_EQ(CompilationRecordScope::GetCurrent(), nullptr);
+
+    ASSERT_EQ(pStats->GetRecordCount(), 2u);
+    // The inner record is added first as it is completed first
+    EXPECT_STREQ(pStats->GetRecord(0).Name, "Inner PS");
+
+    const auto& Record = pStats->GetRecord(1);
+    EXPECT_STREQ(Record.Name, "Test VS");
+    EXPECT_GE(Record.StageDurations[COMPILATION_STAGE_OPTIMIZE], 20000u);
+    // Stage times are exclusive
+    EXPECT_LT(Record.StageDurations[COMPILATION_STAGE_COMPILE], 20000u);
+    EXPECT_EQ(Record.StageDurations[COMPILATION_STAGE_PREPROCESS], 0u);
+}
+
+TEST(GraphicsEngine_CompilationStatistics, InactiveScope)
+{
+    {
+        CompilationRecordScope Scope{nullptr, COMPILATION_RECORD_TYPE_SHADER, SHADER_TYPE_VERTEX, "Test VS"};
+        EXPECT_FALSE(Scope.IsActive());
+        EXPECT_EQ(CompilationRecordScope::GetCurrent(), nullptr);
+        CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+    }
+
+    // Timers without an active record do nothing
+    CompilationStageTimer Timer{COMPILATION_STAGE_COMPILE};
+}
+
+TEST(GraphicsEngine_CompilationStatistics, PipelineFeedback)
+{
+    EXPECT_EQ(CombinePipelineCacheResults(PIPELINE_CACHE_RESULT_HIT, PIPELINE_CACHE_RESULT_HIT), PIPELINE_CACHE_RESULT_HIT);
+    EXPECT_EQ(CombinePipelineCacheResults(PIPELINE_CACHE_RESULT_HIT, PIPELINE_CACHE_RESULT_UNKNOWN), PIPELINE_CACHE_RESULT_UNKNOWN);
+    EXPECT_EQ(CombinePipelineCacheResults(PIPELINE_CACHE_RESULT_UNKNOWN, PIPELINE_CACHE_RESULT_MISS), PIPELINE_CACHE_RESULT_MISS);
+
+    RefCntAutoPtr<CompilationStatisticsImpl> pStats{MakeNewRCObj<CompilationStatisticsImpl>()()};
+
+    {
+        CompilationRecordScope Scope{pStats, COMPILATION_RECORD_TYPE_PIPELINE, SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "Test PSO"};
+        Scope.SetPipelineFeedback(PIPELINE_CACHE_RESULT_HIT, 500);
+        Scope.AddStageFeedback(SHADER_TYPE_VERTEX, PIPELINE_CACHE_RESULT_HIT, 100);
+        Scope.AddStageFeedback(SHADER_TYPE_PIXEL, PIPELINE_CACHE_RESULT_HIT, 200);
+        // Feedback for the stages of the same type is combined
+        Scope.AddStageFeedback(SHADER_TYPE_PIXEL, PIPELINE_CACHE_RESULT_MISS, 50);
+    }
+
+    ASSERT_EQ(pStats->GetRecordCount(), 1u);
+
+    const auto& Record = pStats->GetRecord(0);
+    EXPECT_EQ(Record.CacheResult, PIPELINE_CACHE_RESULT_HIT);
+    EXPECT_EQ(Record.DriverDuration, 500u);
+    ASSERT_EQ(Record.NumStageFeedbacks, 2u);
+    EXPECT_EQ(Record.StageFeedbacks[0].ShaderType, SHADER_TYPE_VERTEX);
+    EXPECT_EQ(Record.StageFeedbacks[0].CacheResult, PIPELINE_CACHE_RESULT_HIT);
+    EXPECT_EQ(Record.StageFeedbacks[0].Duration, 100u);
+    EXPECT_EQ(Record.StageFeedbacks[1].ShaderType, SHADER_TYPE_PIXEL);
+    EXPECT_EQ(Record.StageFeedbacks[1].CacheResult, PIPELINE_CACHE_RESULT_MISS);
+    EXPECT_EQ(Record.StageFeedbacks[1].Duration, 250u);
+
+    {
+        RefCntAutoPtr<IDataBlob> pCSV;
+        pStats->ExportCSV(&pCSV);
+        ASSERT_TRUE(pCSV);
+        const auto CSV = BlobToString(pCSV);
+        EXPECT_NE(CSV.find(",Hit,500,SHADER_TYPE_VERTEX:Hit:100;SHADER_TYPE_PIXEL:Miss:250,"), std::string::npos) << CSV;
+    }
+
+    {
+        RefCntAutoPtr<IDataBlob> pTrace;
+        pStats->ExportChromeTrace(&pTrace);
+        ASSERT_TRUE(pTrace);
+        const auto Trace = BlobToString(pTrace);
+        EXPECT_NE(Trace.find("\"Cache\":\"Hit\""), std::string::npos) << Trace;
+        EXPECT_NE(Trace.find("\"SHADER_TYPE_PIXEL Cache\":\"Miss\""), std::string::npos) << Trace;
+        EXPECT_NE(Trace.find("\"SHADER_TYPE_PIXEL (us)\":250"), std::string::npos) << Trace;
+    }
+}
+
+TEST(GraphicsEngine_CompilationStatistics, Export)
+{
+    RefCntAutoPtr<CompilationStatisticsImpl> pStats{MakeNewRCObj<CompilationStatisticsImpl>()()};
+
+    {
+        CompilationRecordScope Scope{pStats, COMPILATION_RECORD_TYPE_SHADER, SHADER_TYPE_COMPUTE, "Shader, \"quoted\""};
+        Scope.SetByteCodeSize(256);
+    }
+
+    {
+        RefCntAutoPtr<IDataBlob> pCSV;
+        pStats->ExportCSV(&pCSV);
+        ASSERT_TRUE(pCSV);
+        const auto CSV = BlobToString(pCSV);
+        EXPECT_EQ(CSV.find("Type,Name,Shader Stages,Thread,Start (us),Duration (us),Preprocess (us),"), size_t{0}) << CSV;
+        EXPECT_NE(CSV.find("\nShader,\"Shader, \"\"quoted\"\"\",SHADER_TYPE_COMPUTE,"), std::string::npos) << CSV;
+        EXPECT_NE(CSV.find(",256\n"), std::string::npos) << CSV;
+    }
+
+    {
+        RefCntAutoPtr<IDataBlob> pTrace;
+        pStats->ExportChromeTrace(&pTrace);
+        ASSERT_TRUE(pTrace);
+        const auto Trace = BlobToString(pTrace);
+        EXPECT_EQ(Trace.find("{\"traceEvents\":["), size_t{0}) << Trace;
+        EXPECT_NE(Trace.find("\"name\":\"Shader, \\\"quoted\\\"\""), std::string::npos) << Trace;
+        EXPECT_NE(Trace.find("\"ph\":\"X\""), std::string::npos) << Trace;
+        EXPECT_NE(Trace.find("\"Byte Code Size\":256"), std::string::npos) << Trace;
+    }
+}
+
+} // namespace
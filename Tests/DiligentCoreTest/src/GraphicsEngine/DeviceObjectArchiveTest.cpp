@@ -0,0 +1,309 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "../../../../Graphics/GraphicsEngine/include/DeviceObjectArchive.hpp"
+#include "../../../../Graphics/GraphicsEngine/include/EngineMemory.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "DataBlobImpl.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using DeviceType   = DeviceObjectArchive::DeviceType;
+using ResourceType = DeviceObjectArchive::ResourceType;
+
+SerializedData MakeData(const char* Str)
+{
+    const auto     Size = strlen(Str) + 1;
+    SerializedData Data{Size, GetRawAllocator()};
+    memcpy(Data.Ptr(), Str, Size);
+    return Data;
+}
+
+void CheckData(const SerializedData& Data, const char* Str)
+{
+    ASSERT_TRUE(Data) << "Expected '" << Str << "'";
+    ASSERT_EQ(Data.Size(), strlen(Str) + 1);
+    EXPECT_STREQ(Data.Ptr<const char>(), Str);
+}
+
+RefCntAutoPtr<IDataBlob> CreateTestArchive()
+{
+    DeviceObjectArchive Archive;
+
+    {
+        auto& PSO                                                       = Archive.GetResourceData(ResourceType::GraphicsPipeline, "PSO");
+        PSO.Common                                                      = MakeData("PSO common");
+        PSO.DeviceSpecific[static_cast<size_t>(DeviceType::OpenGL)]     = MakeData("PSO GL");
+        PSO.DeviceSpecific[static_cast<size_t>(DeviceType::Vulkan)]     = MakeData("PSO VK");
+        auto& PRS                                                       = Archive.GetResourceData(ResourceType::ResourceSignature, "PRS");
+        PRS.Common                                                      = MakeData("PRS common");
+        PRS.DeviceSpecific[static_cast<size_t>(DeviceType::Direct3D12)] = MakeData("PRS D3D12");
+    }
+
+    Archive.GetDeviceShaders(DeviceType::OpenGL).emplace_back(MakeData("GL shader 0"));
+    Archive.GetDeviceShaders(DeviceType::Vulkan).emplace_back(MakeData("VK shader 0"));
+    Archive.GetDeviceShaders(DeviceType::Vulkan).emplace_back(MakeData("VK shader 1"));
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Archive.Serialize(&pData);
+    return pData;
+}
+
+TEST(DeviceObjectArchiveTest, SerializeDeserialize)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_TRUE(pData);
+
+    DeviceObjectArchive Archive{pData};
+
+    CheckData(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::Vulkan), "PSO VK");
+    CheckData(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::OpenGL), "PSO GL");
+    EXPECT_FALSE(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::Direct3D12));
+    CheckData(Archive.GetDeviceSpecificData(ResourceType::ResourceSignature, "PRS", DeviceType::Direct3D12), "PRS D3D12");
+    EXPECT_FALSE(Archive.GetDeviceSpecificData(ResourceType::ResourceSignature, "PRS", DeviceType::Vulkan));
+
+    CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, 0), "VK shader 0");
+    CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, 1), "VK shader 1");
+    EXPECT_FALSE(Archive.GetSerializedShader(DeviceType::Vulkan, 2));
+    CheckData(Archive.GetSerializedShader(DeviceType::OpenGL, 0), "GL shader 0");
+    EXPECT_FALSE(Archive.GetSerializedShader(DeviceType::Direct3D11, 0));
+
+    // Re-serialize the loaded archive and make sure the data is preserved
+    RefCntAutoPtr<IDataBlob> pData2;
+    Archive.Serialize(&pData2);
+    ASSERT_TRUE(pData2);
+    EXPECT_EQ(pData->GetSize(), pData2->GetSize());
+
+    DeviceObjectArchive Archive2{pData2};
+    CheckData(Archive2.GetDeviceSpecificData(ResourceType::ResourceSignature, "PRS", DeviceType::Direct3D12), "PRS D3D12");
+    CheckData(Archive2.GetSerializedShader(DeviceType::Vulkan, 1), "VK shader 1");
+}
+
+TEST(DeviceObjectArchiveTest, RemoveDeviceData)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_TRUE(pData);
+
+    RefCntAutoPtr<IDataBlob> pStrippedData;
+    {
+        DeviceObjectArchive Archive{pData};
+        Archive.RemoveDeviceData(DeviceType::Vulkan);
+        Archive.Serialize(&pStrippedData);
+        ASSERT_TRUE(pStrippedData);
+    }
+    EXPECT_LT(pStrippedData->GetSize(), pData->GetSize());
+
+    DeviceObjectArchive Archive{pStrippedData};
+    EXPECT_FALSE(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::Vulkan));
+    EXPECT_FALSE(Archive.GetSerializedShader(DeviceType::Vulkan, 0));
+    CheckData(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::OpenGL), "PSO GL");
+    CheckData(Archive.GetSerializedShader(DeviceType::OpenGL, 0), "GL shader 0");
+}
+
+TEST(DeviceObjectArchiveTest, PipelineCacheData)
+{
+    RefCntAutoPtr<IDataBlob> pData;
+    {
+        DeviceObjectArchive Archive;
+        Archive.GetResourceData(ResourceType::GraphicsPipeline, "PSO").Common = MakeData("PSO common");
+        Archive.SetPipelineCacheData(DeviceType::Metal_iOS, MakeData("MTL cache"));
+        Archive.SetPipelineCacheData(DeviceType::Vulkan, MakeData("VK cache"));
+        Archive.Serialize(&pData);
+        ASSERT_TRUE(pData);
+    }
+
+    {
+        DeviceObjectArchive Archive{pData};
+        CheckData(Archive.GetPipelineCacheData(DeviceType::Metal_iOS), "MTL cache");
+        CheckData(Archive.GetPipelineCacheData(DeviceType::Vulkan), "VK cache");
+        EXPECT_FALSE(Archive.GetPipelineCacheData(DeviceType::Direct3D12));
+
+        RefCntAutoPtr<IDataBlob> pStrippedData;
+        Archive.RemoveDeviceData(DeviceType::Vulkan);
+        Archive.Serialize(&pStrippedData);
+        ASSERT_TRUE(pStrippedData);
+
+        DeviceObjectArchive StrippedArchive{pStrippedData};
+        EXPECT_FALSE(StrippedArchive.GetPipelineCacheData(DeviceType::Vulkan));
+        CheckData(StrippedArchive.GetPipelineCacheData(DeviceType::Metal_iOS), "MTL cache");
+    }
+
+    {
+        // The destination data takes precedence when merging
+        DeviceObjectArchive Archive;
+        Archive.SetPipelineCacheData(DeviceType::Vulkan, MakeData("VK cache 2"));
+        Archive.Merge(DeviceObjectArchive{pData});
+        CheckData(Archive.GetPipelineCacheData(DeviceType::Vulkan), "VK cache 2");
+        CheckData(Archive.GetPipelineCacheData(DeviceType::Metal_iOS), "MTL cache");
+    }
+}
+
+TEST(DeviceObjectArchiveTest, UpgradeVersion4)
+{
+    // Version 4 layout: | Header | NumResources | {Type, Name, Common, Device data...} | Device shaders... |
+    auto SerializeV4 = [](auto& Ser) {
+        const Uint32 MagicNumber = DeviceObjectArchive::HeaderMagicNumber;
+        const Uint32 Version     = 4;
+        const Uint32 APIVersion  = DILIGENT_API_VERSION;
+        const char*  GitHash     = nullptr;
+        Ser(MagicNumber, Version, APIVersion, GitHash);
+
+        const Uint32 NumResources = 1;
+        const auto   ResType      = ResourceType::GraphicsPipeline;
+        const char*  Name         = "PSO";
+        Ser(NumResources, ResType, Name);
+
+        const auto Common = MakeData("PSO common");
+        const auto VkData = MakeData("PSO VK");
+        const auto Shader = MakeData("VK shader 0");
+        const auto NoData = SerializedData{};
+        Ser.Serialize(Common);
+        for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+            Ser.Serialize(dev == static_cast<Uint32>(DeviceType::Vulkan) ? VkData : NoData);
+
+        for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+        {
+            const Uint32 NumShaders = dev == static_cast<Uint32>(DeviceType::Vulkan) ? 1 : 0;
+            Ser(NumShaders);
+            if (NumShaders > 0)
+                Ser.Serialize(Shader);
+        }
+    };
+
+    Serializer<SerializerMode::Measure> Measurer;
+    SerializeV4(Measurer);
+    auto pV4Data = DataBlobImpl::Create(Measurer.GetSize());
+    {
+        Serializer<SerializerMode::Write> Writer{SerializedData{pV4Data->GetDataPtr(), pV4Data->GetSize()}};
+        SerializeV4(Writer);
+        ASSERT_TRUE(Writer.IsEnded());
+    }
+
+    RefCntAutoPtr<IDataBlob> pV5Data;
+    {
+        DeviceObjectArchive Archive{pV4Data};
+        CheckData(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::Vulkan), "PSO VK");
+        CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, 0), "VK shader 0");
+        Archive.Serialize(&pV5Data);
+        ASSERT_TRUE(pV5Data);
+    }
+
+    Serializer<SerializerMode::Read> Reader{SerializedData{pV5Data->GetDataPtr(), pV5Data->GetSize()}};
+    Uint32                           MagicNumber = 0;
+    Uint32                           Version     = 0;
+    ASSERT_TRUE(Reader(MagicNumber, Version));
+    EXPECT_EQ(Version, Uint32{DeviceObjectArchive::ArchiveVersion});
+
+    DeviceObjectArchive Archive{pV5Data};
+    CheckData(Archive.GetDeviceSpecificData(ResourceType::GraphicsPipeline, "PSO", DeviceType::Vulkan), "PSO VK");
+    CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, 0), "VK shader 0");
+}
+
+TEST(DeviceObjectArchiveTest, ShaderCompression)
+{
+    constexpr size_t NumShaders = 16;
+
+    std::vector<std::string> ShaderData(NumShaders);
+    for (size_t i = 0; i < NumShaders; ++i)
+    {
+        for (size_t j = 0; j < 256; ++j)
+            ShaderData[i] += "OpLoad %v4float %" + std::to_string(i + j % 8) + "\n";
+    }
+
+    auto CreateArchive = [&](DeviceObjectArchive::ShaderCompression Compression) {
+        DeviceObjectArchive Archive;
+        Archive.SetShaderCompression(Compression);
+        Archive.GetResourceData(ResourceType::StandaloneShader, "Shader").Common = MakeData("Shader common");
+        for (const auto& Data : ShaderData)
+            Archive.GetDeviceShaders(DeviceType::Vulkan).emplace_back(MakeData(Data.c_str()));
+        // Incompressible shaders are stored as is
+        Archive.GetDeviceShaders(DeviceType::Vulkan).emplace_back(MakeData("x"));
+
+        RefCntAutoPtr<IDataBlob> pData;
+        Archive.Serialize(&pData);
+        return pData;
+    };
+
+    auto pData           = CreateArchive(DeviceObjectArchive::ShaderCompression::None);
+    auto pCompressedData = CreateArchive(DeviceObjectArchive::ShaderCompression::LZ);
+    ASSERT_TRUE(pData);
+    ASSERT_TRUE(pCompressedData);
+    EXPECT_LT(pCompressedData->GetSize() * 3, pData->GetSize());
+
+    DeviceObjectArchive Archive{pCompressedData};
+    EXPECT_EQ(Archive.GetShaderCompression(), DeviceObjectArchive::ShaderCompression::LZ);
+
+    // Shaders are decompressed on first access, which may happen from multiple threads
+    std::vector<std::thread> Threads(4);
+    for (auto& Thread : Threads)
+    {
+        Thread = std::thread{[&]() {
+            for (size_t i = 0; i < NumShaders; ++i)
+                CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, i), ShaderData[i].c_str());
+        }};
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    CheckData(Archive.GetSerializedShader(DeviceType::Vulkan, NumShaders), "x");
+
+    // Compression is preserved when the archive is serialized again
+    RefCntAutoPtr<IDataBlob> pData2;
+    Archive.Serialize(&pData2);
+    ASSERT_TRUE(pData2);
+    EXPECT_EQ(pData2->GetSize(), pCompressedData->GetSize());
+
+    DeviceObjectArchive Archive2{pData2};
+    for (size_t i = 0; i < NumShaders; ++i)
+        CheckData(Archive2.GetSerializedShader(DeviceType::Vulkan, i), ShaderData[i].c_str());
+}
+
+TEST(DeviceObjectArchiveTest, CorruptedDeviceSection)
+{
+    auto pData = CreateTestArchive();
+    ASSERT_TRUE(pData);
+
+    // Truncate the archive so that device sections are out of bounds
+    auto pTruncated = DataBlobImpl::Create(StaticCast<size_t>(pData->GetSize()) - 16, pData->GetConstDataPtr());
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"Device section"};
+    EXPECT_THROW(DeviceObjectArchive{pTruncated}, std::runtime_error);
+}
+
+} // namespace
@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FenceCompletionWaiter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class DummyFence final : public ObjectBase<IFence>
+{
+public:
+    DummyFence(IReferenceCounters* pRefCounters, FenceCompletionWaiter& Waiter) :
+        ObjectBase<IFence>{pRefCounters},
+        m_Waiter{Waiter}
+    {}
+
+    ~DummyFence()
+    {
+        m_Waiter.UnregisterFence(this);
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Fence, ObjectBase<IFence>)
+
+    virtual const FenceDesc& DILIGENT_CALL_TYPE GetDesc() const override { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE            GetUniqueID() const override { return 0; }
+    virtual void DILIGENT_CALL_TYPE             SetUserData(IObject* pUserData) override {}
+    virtual IObject* DILIGENT_CALL_TYPE         GetUserData() const override { return nullptr; }
+
+    virtual Uint64 DILIGENT_CALL_TYPE GetCompletedValue() override { return m_Value.load(); }
+    virtual void DILIGENT_CALL_TYPE   Signal(Uint64 Value) override { m_Value.store(Value); }
+    virtual void DILIGENT_CALL_TYPE   Wait(Uint64 Value) override {}
+
+    virtual void DILIGENT_CALL_TYPE EnqueueCompletionCallback(Uint64 Value, FenceCompletionCallbackType Callback, void* pUserData) override
+    {
+        m_Waiter.EnqueueCallback(this, Value, Callback, pUserData);
+    }
+
+private:
+    FenceCompletionWaiter& m_Waiter;
+    FenceDesc              m_Desc;
+    std::atomic<Uint64>    m_Value{0};
+};
+
+struct CallbackCounter
+{
+    std::atomic<Uint32> NumCalls{0};
+    std::atomic<Uint64> LastValue{0};
+
+    static void DILIGENT_CALL_TYPE Callback(Uint64 CompletedValue, void* pUserData)
+    {
+        auto& Counter = *static_cast<CallbackCounter*>(pUserData);
+        Counter.LastValue.store(CompletedValue);
+        Counter.NumCalls.fetch_add(1);
+    }
+};
+
+bool WaitForCalls(const CallbackCounter& Counter, Uint32 NumCalls)
+{
+    const auto StartTime = std::chrono::steady_clock::now();
+    while (Counter.NumCalls.load() < NumCalls)
+    {
+        if (std::chrono::steady_clock::now() - StartTime > std::chrono::seconds{10})
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
+
+TEST(FenceCompletionWaiterTest, Polled)
+{
+    FenceCompletionWaiter Waiter{/*UseThread = */ false};
+
+    RefCntAutoPtr<DummyFence> pFence{MakeNewRCObj<DummyFence>()(Waiter)};
+
+    CallbackCounter Counter;
+    pFence->EnqueueCompletionCallback(0, CallbackCounter::Callback, &Counter);
+    pFence->EnqueueCompletionCallback(2, CallbackCounter::Callback, &Counter);
+    pFence->EnqueueCompletionCallback(4, CallbackCounter::Callback, &Counter);
+    EXPECT_EQ(Waiter.GetNumPendingCallbacks(), 3u);
+
+    // Callbacks are never invoked from EnqueueCallback()
+    EXPECT_EQ(Counter.NumCalls, 0u);
+
+    Waiter.ProcessCompletedFences();
+    EXPECT_EQ(Counter.NumCalls, 1u);
+    EXPECT_EQ(Counter.LastValue, 0u);
+
+    pFence->Signal(3);
+    Waiter.ProcessCompletedFences();
+    EXPECT_EQ(Counter.NumCalls, 2u);
+    EXPECT_EQ(Counter.LastValue, 3u);
+    EXPECT_EQ(Waiter.GetNumPendingCallbacks(), 1u);
+
+    // Pending callbacks are discarded when the fence is destroyed
+    pFence.Release();
+    EXPECT_EQ(Waiter.GetNumPendingCallbacks(), 0u);
+    Waiter.ProcessCompletedFences();
+    EXPECT_EQ(Counter.NumCalls, 2u);
+}
+
+TEST(FenceCompletionWaiterTest, Threaded)
+{
+    FenceCompletionWaiter Waiter{/*UseThread = */ true};
+
+    RefCntAutoPtr<DummyFence> pFence0{MakeNewRCObj<DummyFence>()(Waiter)};
+    RefCntAutoPtr<DummyFence> pFence1{MakeNewRCObj<DummyFence>()(Waiter)};
+
+    CallbackCounter Counter0;
+    CallbackCounter Counter1;
+    pFence0->EnqueueCompletionCallback(1, CallbackCounter::Callback, &Counter0);
+    pFence1->EnqueueCompletionCallback(1, CallbackCounter::Callback, &Counter1);
+    pFence1->EnqueueCompletionCallback(2, CallbackCounter::Callback, &Counter1);
+
+    pFence1->Signal(5);
+    EXPECT_TRUE(WaitForCalls(Counter1, 2));
+    EXPECT_EQ(Counter1.LastValue, 5u);
+    EXPECT_EQ(Counter0.NumCalls, 0u);
+
+    pFence0->Signal(1);
+    EXPECT_TRUE(WaitForCalls(Counter0, 1));
+    EXPECT_EQ(Waiter.GetNumPendingCallbacks(), 0u);
+
+    // Destroy a fence while the thread is waiting for it
+    pFence0->EnqueueCompletionCallback(10, CallbackCounter::Callback, &Counter0);
+    pFence0.Release();
+    EXPECT_EQ(Counter0.NumCalls, 1u);
+
+    Waiter.StopThread();
+}
+
+// Callbacks may enqueue other callbacks and release fences
+TEST(FenceCompletionWaiterTest, Reentrancy)
+{
+    FenceCompletionWaiter Waiter{/*UseThread = */ true};
+
+    struct ChainData
+    {
+        RefCntAutoPtr<DummyFence> pFence;
+        std::atomic<Uint32>       NumCalls{0};
+
+        static void DILIGENT_CALL_TYPE Callback(Uint64 CompletedValue, void* pUserData)
+        {
+            auto& Data = *static_cast<ChainData*>(pUserData);
+            if (CompletedValue < 3)
+                Data.pFence->EnqueueCompletionCallback(CompletedValue + 1, Callback, pUserData);
+            else
+                Data.pFence.Release();
+            Data.NumCalls.fetch_add(1);
+        }
+    };
+    ChainData Data;
+    Data.pFence = MakeNewRCObj<DummyFence>()(Waiter);
+    Data.pFence->EnqueueCompletionCallback(1, ChainData::Callback, &Data);
+
+    for (Uint64 Value = 1; Value <= 3; ++Value)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+        while (Data.NumCalls.load() < Value && std::chrono::steady_clock::now() - StartTime < std::chrono::seconds{10})
+        {
+            if (Data.NumCalls.load() == Value - 1)
+                Data.pFence->Signal(Value);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+    EXPECT_EQ(Data.NumCalls.load(), 3u);
+    EXPECT_EQ(Data.pFence, nullptr);
+
+    Waiter.StopThread();
+}
+
+} // namespace
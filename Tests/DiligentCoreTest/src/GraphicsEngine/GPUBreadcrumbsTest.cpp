@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUBreadcrumbs.hpp"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+bool Contains(const std::string& Str, const char* Substr)
+{
+    return Str.find(Substr) != std::string::npos;
+}
+
+TEST(GraphicsEngine_GPUBreadcrumbs, Markers)
+{
+    GPUBreadcrumbs Breadcrumbs{16};
+    EXPECT_EQ(Breadcrumbs.GetLastMarker(), 0u);
+
+    EXPECT_EQ(Breadcrumbs.AddCommand("Draw"), 1u);
+    EXPECT_EQ(Breadcrumbs.BeginDebugGroup("Frame"), 2u);
+    EXPECT_EQ(Breadcrumbs.AddCommand("Dispatch"), 3u);
+    EXPECT_EQ(Breadcrumbs.EndDebugGroup(), 4u);
+    EXPECT_EQ(Breadcrumbs.GetLastMarker(), 4u);
+}
+
+TEST(GraphicsEngine_GPUBreadcrumbs, Report)
+{
+    GPUBreadcrumbs Breadcrumbs{16};
+    Breadcrumbs.AddCommand("Draw");                  // 1
+    Breadcrumbs.BeginDebugGroup("Frame");            // 2
+    Breadcrumbs.BeginDebugGroup("Shadows");          // 3
+    Breadcrumbs.AddCommand("DrawIndexed");           // 4
+    Breadcrumbs.EndDebugGroup();                     // 5
+    Breadcrumbs.AddCommand("DispatchCompute");       // 6
+    Breadcrumbs.EndDebugGroup();                     // 7
+    Breadcrumbs.AddCommand("DrawIndexedIndirect");   // 8
+
+    const std::string Report = Breadcrumbs.GetReport(6, 4);
+    EXPECT_TRUE(Contains(Report, "#1 [completed] Draw\n")) << Report;
+    EXPECT_TRUE(Contains(Report, "#4 [completed] DrawIndexed (Frame/Shadows)")) << Report;
+    EXPECT_TRUE(Contains(Report, "#5 [in flight] EndDebugGroup (Frame/Shadows)")) << Report;
+    EXPECT_TRUE(Contains(Report, "#6 [in flight] DispatchCompute (Frame)")) << Report;
+    EXPECT_TRUE(Contains(Report, "#8 [not started] DrawIndexedIndirect")) << Report;
+    EXPECT_FALSE(Contains(Report, "DrawIndexedIndirect (")) << Report;
+}
+
+TEST(GraphicsEngine_GPUBreadcrumbs, History)
+{
+    GPUBreadcrumbs Breadcrumbs{16};
+    Breadcrumbs.BeginDebugGroup("Pass");
+    for (Uint32 i = 0; i < 100; ++i)
+        Breadcrumbs.AddCommand("Draw");
+    Breadcrumbs.EndDebugGroup();
+    EXPECT_EQ(Breadcrumbs.GetLastMarker(), 102u);
+
+    // Commands that are out of the history are not reported
+    const std::string Report = Breadcrumbs.GetReport(100, 99);
+    EXPECT_FALSE(Contains(Report, "#86 ")) << Report;
+    EXPECT_TRUE(Contains(Report, "#92 [completed] Draw (Pass)")) << Report;
+    EXPECT_TRUE(Contains(Report, "#100 [in flight] Draw (Pass)")) << Report;
+    EXPECT_TRUE(Contains(Report, "#102 [not started] EndDebugGroup (Pass)")) << Report;
+
+    // Same group path is reused
+    Breadcrumbs.BeginDebugGroup("Pass");
+    const Uint32 Marker = Breadcrumbs.AddCommand("Draw");
+    EXPECT_TRUE(Contains(Breadcrumbs.GetReport(Marker, 0), "[in flight] Draw (Pass)"));
+}
+
+} // namespace
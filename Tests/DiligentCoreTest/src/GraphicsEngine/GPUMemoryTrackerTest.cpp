@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUMemoryTracker.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsEngine_GPUMemoryTracker, Statistics)
+{
+    GPUMemoryTracker Tracker;
+
+    const auto Tex = Tracker.AddAllocation(GPU_MEMORY_CATEGORY_TEXTURE, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Texture", 1000, 1024);
+    const auto Buf = Tracker.AddAllocation(GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, "Buffer", 100, 256);
+    const auto Page = Tracker.AddAllocation(GPU_MEMORY_CATEGORY_MEMORY_POOL, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Page", 4096, 4096);
+    EXPECT_NE(Tex, GPUMemoryTracker::InvalidAllocationId);
+    EXPECT_NE(Buf, Tex);
+
+    GPUMemoryStatistics Stats;
+    Tracker.GetStatistics(Stats);
+
+    const auto& TexUsage = Stats.Categories[GPU_MEMORY_CATEGORY_TEXTURE];
+    EXPECT_EQ(TexUsage.Count, 1u);
+    EXPECT_EQ(TexUsage.Size, 1000u);
+    EXPECT_EQ(TexUsage.AllocatedSize, 1024u);
+
+    const auto& Committed = Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_COMMITTED];
+    EXPECT_EQ(Committed.Count, 2u);
+    EXPECT_EQ(Committed.AllocatedSize, 1024u + 4096u);
+
+    const auto& Suballocated = Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED];
+    EXPECT_EQ(Suballocated.Count, 1u);
+    EXPECT_EQ(Suballocated.AllocatedSize, 256u);
+
+    Tracker.RemoveAllocation(Tex);
+    Tracker.GetStatistics(Stats);
+    EXPECT_EQ(Stats.Categories[GPU_MEMORY_CATEGORY_TEXTURE].Count, 0u);
+    EXPECT_EQ(Stats.Categories[GPU_MEMORY_CATEGORY_TEXTURE].AllocatedSize, 0u);
+    EXPECT_EQ(Stats.Categories[GPU_MEMORY_CATEGORY_TEXTURE].PeakAllocatedSize, 1024u);
+    EXPECT_EQ(Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_COMMITTED].AllocatedSize, 4096u);
+    EXPECT_EQ(Stats.Types[GPU_MEMORY_ALLOCATION_TYPE_COMMITTED].PeakAllocatedSize, 1024u + 4096u);
+
+    Tracker.RemoveAllocation(Buf);
+    Tracker.RemoveAllocation(Page);
+    Tracker.GetStatistics(Stats);
+    for (const auto& Usage : Stats.Categories)
+    {
+        EXPECT_EQ(Usage.Count, 0u);
+        EXPECT_EQ(Usage.Size, 0u);
+        EXPECT_EQ(Usage.AllocatedSize, 0u);
+    }
+}
+
+TEST(GraphicsEngine_GPUMemoryTracker, Allocations)
+{
+    GPUMemoryTracker Tracker;
+
+    const std::string LongName(DILIGENT_GPU_MEMORY_ALLOCATION_NAME_LENGTH * 2, 'x');
+
+    Tracker.AddAllocation(GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Small", 10, 64);
+    Tracker.AddAllocation(GPU_MEMORY_CATEGORY_TEXTURE, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Large", 4000, 4096);
+    Tracker.AddAllocation(GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_PLACED, nullptr, 512, 0);
+    Tracker.AddAllocation(GPU_MEMORY_CATEGORY_TEXTURE, GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, LongName.c_str(), 200, 256);
+
+    EXPECT_EQ(Tracker.GetAllocations(nullptr, 0), 4u);
+
+    // Allocations are sorted by the allocated size
+    std::vector<GPUMemoryAllocationInfo> Allocations(2);
+    EXPECT_EQ(Tracker.GetAllocations(Allocations.data(), static_cast<Uint32>(Allocations.size())), 4u);
+    EXPECT_STREQ(Allocations[0].Name, "Large");
+    EXPECT_EQ(Allocations[0].Category, GPU_MEMORY_CATEGORY_TEXTURE);
+    EXPECT_EQ(Allocations[0].Size, 4000u);
+    EXPECT_EQ(Allocations[0].AllocatedSize, 4096u);
+    EXPECT_EQ(Allocations[1].Type, GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED);
+    EXPECT_EQ(strlen(Allocations[1].Name), size_t{DILIGENT_GPU_MEMORY_ALLOCATION_NAME_LENGTH - 1});
+
+    Allocations.resize(8);
+    EXPECT_EQ(Tracker.GetAllocations(Allocations.data(), static_cast<Uint32>(Allocations.size())), 4u);
+    EXPECT_STREQ(Allocations[2].Name, "Small");
+    EXPECT_STREQ(Allocations[3].Name, "");
+    EXPECT_EQ(Allocations[3].Type, GPU_MEMORY_ALLOCATION_TYPE_PLACED);
+    EXPECT_EQ(Allocations[3].AllocatedSize, 0u);
+}
+
+TEST(GraphicsEngine_GPUMemoryTracker, Record)
+{
+    GPUMemoryTracker Tracker;
+
+    const auto GetBufferCount = [&Tracker]() {
+        GPUMemoryStatistics Stats;
+        Tracker.GetStatistics(Stats);
+        return Stats.Categories[GPU_MEMORY_CATEGORY_BUFFER].Count;
+    };
+
+    {
+        GPUMemoryRecord Record{&Tracker, GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Buffer", 16, 16};
+        EXPECT_TRUE(Record.IsValid());
+        EXPECT_EQ(GetBufferCount(), 1u);
+
+        GPUMemoryRecord Record2{std::move(Record)};
+        EXPECT_FALSE(Record.IsValid());
+        EXPECT_TRUE(Record2.IsValid());
+        EXPECT_EQ(GetBufferCount(), 1u);
+
+        Record = GPUMemoryRecord{&Tracker, GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Buffer2", 32, 32};
+        EXPECT_EQ(GetBufferCount(), 2u);
+
+        Record2 = std::move(Record);
+        EXPECT_EQ(GetBufferCount(), 1u);
+
+        Record2.Reset();
+        EXPECT_FALSE(Record2.IsValid());
+        EXPECT_EQ(GetBufferCount(), 0u);
+
+        Record = GPUMemoryRecord{&Tracker, GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Buffer3", 64, 64};
+    }
+    EXPECT_EQ(GetBufferCount(), 0u);
+
+    // Null tracker means that the tracking is disabled
+    GPUMemoryRecord NullRecord{nullptr, GPU_MEMORY_CATEGORY_BUFFER, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Buffer", 16, 16};
+    EXPECT_FALSE(NullRecord.IsValid());
+}
+
+TEST(GraphicsEngine_GPUMemoryTracker, Report)
+{
+    GPUMemoryTracker Tracker;
+
+    GPUMemoryRecord Page{&Tracker, GPU_MEMORY_CATEGORY_MEMORY_POOL, GPU_MEMORY_ALLOCATION_TYPE_COMMITTED, "Memory page", 1 << 20, 1 << 20};
+    GPUMemoryRecord Tex{&Tracker, GPU_MEMORY_CATEGORY_TEXTURE, GPU_MEMORY_ALLOCATION_TYPE_SUBALLOCATED, "Albedo texture", 60000, 65536};
+
+    const auto Report = Tracker.GetReport();
+    EXPECT_NE(Report.find("Albedo texture"), std::string::npos);
+    EXPECT_NE(Report.find("Memory page"), std::string::npos);
+    EXPECT_NE(Report.find("Suballocated"), std::string::npos);
+}
+
+} // namespace
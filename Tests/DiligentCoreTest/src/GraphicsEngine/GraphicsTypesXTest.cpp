@@ -25,6 +25,7 @@
  */
 
 #include "GraphicsTypesX.hpp"
+#include "HashUtils.hpp"
 
 #include "gtest/gtest.h"
 
@@ -245,6 +246,32 @@ TEST(GraphicsTypesXTest, RenderPassDescX)
 }
 
 
+TEST(GraphicsTypesXTest, HashedRenderPassDescX)
+{
+    using HashedRenderPassDescX = HashedValue<RenderPassDescX, std::hash<RenderPassDesc>>;
+
+    RenderPassDescX DescX;
+    DescX
+        .AddAttachment({TEX_FORMAT_RGBA8_UNORM_SRGB, 2})
+        .AddAttachment({TEX_FORMAT_D32_FLOAT})
+        .AddSubpass(SubpassDescX{}.AddRenderTarget({0, RESOURCE_STATE_RENDER_TARGET}).SetDepthStencil({1, RESOURCE_STATE_DEPTH_WRITE}));
+
+    HashedRenderPassDescX Hashed{DescX};
+    EXPECT_EQ(Hashed.GetHash(), std::hash<RenderPassDesc>{}(DescX));
+    EXPECT_EQ(Hashed.Get(), DescX);
+
+    // The hashed value owns a copy of the description
+    DescX.AddAttachment({TEX_FORMAT_RGBA32_FLOAT});
+    EXPECT_NE(Hashed.Get(), DescX);
+    EXPECT_NE(Hashed, HashedRenderPassDescX{DescX});
+
+    DescX.ClearAttachments();
+    DescX
+        .AddAttachment({TEX_FORMAT_RGBA8_UNORM_SRGB, 2})
+        .AddAttachment({TEX_FORMAT_D32_FLOAT});
+    EXPECT_EQ(Hashed, HashedRenderPassDescX{DescX});
+}
+
 TEST(GraphicsTypesXTest, InputLayoutDescX)
 {
     // clang-format off
@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "StateObjectsRegistry.hpp"
+
+#include <thread>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "ObjectBase.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestObjectDesc
+{
+    Uint32 Value = 0;
+
+    bool operator==(const TestObjectDesc& RHS) const
+    {
+        return Value == RHS.Value;
+    }
+};
+
+} // namespace
+
+namespace std
+{
+
+template <>
+struct hash<TestObjectDesc>
+{
+    size_t operator()(const TestObjectDesc& Desc) const
+    {
+        return std::hash<Uint32>{}(Desc.Value);
+    }
+};
+
+} // namespace std
+
+namespace
+{
+
+using TestRegistry = StateObjectsRegistry<TestObjectDesc>;
+
+class TestObject : public ObjectBase<IDeviceObject>
+{
+public:
+    TestObject(IReferenceCounters* pRefCounters, TestRegistry& Registry, Uint32 Value) :
+        ObjectBase<IDeviceObject>{pRefCounters},
+        m_Registry{Registry},
+        m_Value{Value}
+    {}
+
+    ~TestObject()
+    {
+        // Same as device objects that are kept in the state object registries
+        m_Registry.ReportDeletedObject();
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceObject, ObjectBase<IDeviceObject>)
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE GetUniqueID() const override final { return static_cast<Int32>(m_Value); }
+    virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override final {}
+    virtual IObject* DILIGENT_CALL_TYPE GetUserData() const override final { return nullptr; }
+
+    Uint32 GetValue() const { return m_Value; }
+
+private:
+    TestRegistry&             m_Registry;
+    const Uint32              m_Value;
+    const DeviceObjectAttribs m_Desc;
+};
+
+RefCntAutoPtr<TestObject> CreateTestObject(TestRegistry& Registry, Uint32 Value)
+{
+    return RefCntAutoPtr<TestObject>{MakeNewRCObj<TestObject>()(Registry, Value)};
+}
+
+RefCntAutoPtr<TestObject> FindObject(TestRegistry& Registry, Uint32 Value)
+{
+    RefCntAutoPtr<IDeviceObject> pObject;
+    Registry.Find(TestObjectDesc{Value}, &pObject);
+    return RefCntAutoPtr<TestObject>{pObject, IID_DeviceObject};
+}
+
+RefCntAutoPtr<TestObject> GetOrCreateObject(TestRegistry& Registry, Uint32 Value)
+{
+    auto pObject = FindObject(Registry, Value);
+    if (!pObject)
+    {
+        pObject = CreateTestObject(Registry, Value);
+        Registry.Add(TestObjectDesc{Value}, pObject);
+    }
+    return pObject;
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, FindAndAdd)
+{
+    TestRegistry Registry{DefaultRawMemoryAllocator::GetAllocator(), "Test"};
+
+    EXPECT_FALSE(FindObject(Registry, 1));
+
+    auto pObj1 = GetOrCreateObject(Registry, 1);
+    ASSERT_TRUE(pObj1);
+    EXPECT_EQ(pObj1->GetValue(), 1u);
+    EXPECT_EQ(FindObject(Registry, 1), pObj1);
+    EXPECT_EQ(GetOrCreateObject(Registry, 1), pObj1);
+    EXPECT_FALSE(FindObject(Registry, 2));
+    EXPECT_EQ(Registry.GetSize(), size_t{1});
+
+    pObj1.Release();
+    EXPECT_FALSE(FindObject(Registry, 1));
+    // Expired reference stays in the registry until it is purged or replaced
+    EXPECT_EQ(Registry.GetSize(), size_t{1});
+
+    pObj1 = GetOrCreateObject(Registry, 1);
+    EXPECT_EQ(pObj1->GetValue(), 1u);
+    EXPECT_EQ(Registry.GetSize(), size_t{1});
+
+    pObj1.Release();
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetSize(), size_t{0});
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, ConcurrentGetOrCreate)
+{
+    TestRegistry Registry{DefaultRawMemoryAllocator::GetAllocator(), "Test"};
+
+    // Enough distinct descriptions to populate all shards
+    constexpr Uint32 NumValues     = TestRegistry::NumShards * 8;
+    constexpr size_t NumSlots      = 16;
+    constexpr int    NumIterations = 20000;
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::vector<RefCntAutoPtr<TestObject>>> ThreadSlots(NumThreads);
+    std::vector<std::thread>                            Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&, t]() {
+                auto& Slots = ThreadSlots[t];
+                Slots.resize(NumSlots);
+
+                std::mt19937 Gen{t};
+                for (int i = 0; i < NumIterations; ++i)
+                {
+                    const auto Value = static_cast<Uint32>(Gen() % NumValues);
+                    // Replacing the slot drops the previous reference, which eventually
+                    // reports deleted objects and makes Add() purge the shards.
+                    auto& pObj = Slots[Gen() % NumSlots];
+                    pObj       = GetOrCreateObject(Registry, Value);
+                    ASSERT_TRUE(pObj);
+                    EXPECT_EQ(pObj->GetValue(), Value);
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    // When two threads create the same object at the same time, the reference
+    // added last replaces the other one, so an object that is still alive may
+    // not be found. A lookup must however never return a different object.
+    for (const auto& Slots : ThreadSlots)
+    {
+        for (const auto& pObj : Slots)
+        {
+            if (!pObj)
+                continue;
+
+            if (auto pFound = FindObject(Registry, pObj->GetValue()))
+                EXPECT_EQ(pFound->GetValue(), pObj->GetValue());
+        }
+    }
+    for (Uint32 Value = 0; Value < NumValues; ++Value)
+    {
+        auto pObj = GetOrCreateObject(Registry, Value);
+        EXPECT_EQ(FindObject(Registry, Value), pObj);
+    }
+    EXPECT_LE(Registry.GetSize(), size_t{NumValues});
+
+    ThreadSlots.clear();
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetSize(), size_t{0});
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, PurgeNextShard)
+{
+    TestRegistry Registry{DefaultRawMemoryAllocator::GetAllocator(), "Test"};
+
+    constexpr Uint32 NumObjects = 512;
+
+    Uint32 NextValue = 0;
+
+    std::vector<RefCntAutoPtr<TestObject>> LiveObjects;
+
+    size_t NumExpired = 0;
+    // Several rounds make the round-robin shard index wrap around at
+    // different positions as the number of Add() calls per round varies.
+    for (Uint32 Round = 0; Round < 4; ++Round)
+    {
+        {
+            std::vector<RefCntAutoPtr<TestObject>> Objects;
+            for (Uint32 i = 0; i < NumObjects; ++i)
+            {
+                Objects.emplace_back(CreateTestObject(Registry, NextValue++));
+                Registry.Add(TestObjectDesc{Objects.back()->GetValue()}, Objects.back());
+            }
+            EXPECT_EQ(Registry.GetSize(), LiveObjects.size() + NumExpired + NumObjects);
+        }
+        // All objects created in this round have expired
+        NumExpired += NumObjects;
+        EXPECT_EQ(Registry.GetSize(), LiveObjects.size() + NumExpired);
+
+        Uint32 NumAdds = 0;
+        while (NumExpired >= static_cast<size_t>(TestRegistry::DeletedObjectsToPurge))
+        {
+            ASSERT_LT(NumAdds, Uint32{TestRegistry::NumShards}) << "All expired references must be purged after every shard has been visited once";
+
+            LiveObjects.emplace_back(CreateTestObject(Registry, NextValue++));
+            Registry.Add(TestObjectDesc{LiveObjects.back()->GetValue()}, LiveObjects.back());
+            ++NumAdds;
+
+            const auto NumPurged = LiveObjects.size() + NumExpired - Registry.GetSize();
+            // Only one shard is purged by a single Add(), which holds 1/NumShards
+            // of the references on average
+            EXPECT_LT(NumPurged, size_t{NumObjects / 4});
+            NumExpired -= NumPurged;
+            EXPECT_EQ(Registry.GetSize(), LiveObjects.size() + NumExpired);
+        }
+
+        // Live objects must never be purged
+        for (const auto& pObj : LiveObjects)
+            EXPECT_EQ(FindObject(Registry, pObj->GetValue()), pObj);
+    }
+
+    // Below the threshold, Add() does not purge anything
+    const auto SizeBeforeAdd = Registry.GetSize();
+    LiveObjects.emplace_back(CreateTestObject(Registry, NextValue++));
+    Registry.Add(TestObjectDesc{LiveObjects.back()->GetValue()}, LiveObjects.back());
+    EXPECT_EQ(Registry.GetSize(), SizeBeforeAdd + 1);
+
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetSize(), LiveObjects.size());
+
+    LiveObjects.clear();
+    Registry.Purge();
+    EXPECT_EQ(Registry.GetSize(), size_t{0});
+}
+
+} // namespace
@@ -0,0 +1,200 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "SubresourceStateTracker.hpp"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Range = SubresourceStateTracker::Range;
+
+// Verifies the tracker against the state of every subresource.
+void VerifyStates(const SubresourceStateTracker& Tracker, const std::vector<RESOURCE_STATE>& RefStates)
+{
+    const auto MipLevels   = Tracker.GetMipLevels();
+    const auto ArraySlices = Tracker.GetArraySlices();
+
+    bool IsUniform = true;
+    for (Uint32 slice = 0; slice < ArraySlices; ++slice)
+    {
+        for (Uint32 mip = 0; mip < MipLevels; ++mip)
+        {
+            const auto RefState = RefStates[slice * MipLevels + mip];
+            EXPECT_EQ(Tracker.GetState(mip, slice), RefState) << "mip " << mip << ", slice " << slice;
+            IsUniform = IsUniform && RefState == RefStates[0];
+        }
+    }
+    EXPECT_EQ(Tracker.IsUniform(), IsUniform);
+    EXPECT_EQ(Tracker.GetUniformState(), IsUniform ? RefStates[0] : RESOURCE_STATE_UNKNOWN);
+
+    size_t RunCount = 1;
+    for (size_t i = 1; i < RefStates.size(); ++i)
+        RunCount += RefStates[i] != RefStates[i - 1] ? 1 : 0;
+    EXPECT_EQ(Tracker.GetRunCount(), RunCount);
+
+    // Every subresource must be visited exactly once and with the correct state
+    std::vector<int> VisitCount(RefStates.size());
+    Tracker.ProcessRange(Range{0, MipLevels, 0, ArraySlices},
+                         [&](const Range& R, RESOURCE_STATE State) {
+                             EXPECT_GT(R.NumMips, 0u);
+                             EXPECT_GT(R.NumSlices, 0u);
+                             for (Uint32 slice = R.FirstSlice; slice < R.FirstSlice + R.NumSlices; ++slice)
+                             {
+                                 for (Uint32 mip = R.FirstMip; mip < R.FirstMip + R.NumMips; ++mip)
+                                 {
+                                     const auto Idx = slice * MipLevels + mip;
+                                     EXPECT_EQ(State, RefStates[Idx]);
+                                     ++VisitCount[Idx];
+                                 }
+                             }
+                         });
+    for (auto Count : VisitCount)
+        EXPECT_EQ(Count, 1);
+}
+
+void SetRefState(std::vector<RESOURCE_STATE>& RefStates, Uint32 MipLevels, const Range& R, RESOURCE_STATE State)
+{
+    for (Uint32 slice = R.FirstSlice; slice < R.FirstSlice + R.NumSlices; ++slice)
+    {
+        for (Uint32 mip = R.FirstMip; mip < R.FirstMip + R.NumMips; ++mip)
+            RefStates[slice * MipLevels + mip] = State;
+    }
+}
+
+TEST(GraphicsEngine_SubresourceStateTracker, Uniform)
+{
+    SubresourceStateTracker Tracker{8, 4, RESOURCE_STATE_SHADER_RESOURCE};
+    EXPECT_TRUE(Tracker.IsUniform());
+    EXPECT_EQ(Tracker.GetUniformState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+    Tracker.SetState(Range{0, 8, 0, 4}, RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_TRUE(Tracker.IsUniform());
+    EXPECT_EQ(Tracker.GetUniformState(), RESOURCE_STATE_RENDER_TARGET);
+
+    Uint32 NumRanges = 0;
+    Tracker.ProcessRange(Range{2, 3, 1, 2},
+                         [&](const Range& R, RESOURCE_STATE State) {
+                             EXPECT_EQ(R, (Range{2, 3, 1, 2}));
+                             EXPECT_EQ(State, RESOURCE_STATE_RENDER_TARGET);
+                             ++NumRanges;
+                         });
+    EXPECT_EQ(NumRanges, 1u);
+}
+
+TEST(GraphicsEngine_SubresourceStateTracker, MipChain)
+{
+    // Downsampling pass: mip N-1 is read while mip N is written
+    constexpr Uint32            MipLevels = 6;
+    SubresourceStateTracker     Tracker{MipLevels, 1, RESOURCE_STATE_RENDER_TARGET};
+    std::vector<RESOURCE_STATE> RefStates(MipLevels, RESOURCE_STATE_RENDER_TARGET);
+    for (Uint32 mip = 0; mip + 1 < MipLevels; ++mip)
+    {
+        Tracker.SetState(Range{mip, 1, 0, 1}, RESOURCE_STATE_SHADER_RESOURCE);
+        SetRefState(RefStates, MipLevels, Range{mip, 1, 0, 1}, RESOURCE_STATE_SHADER_RESOURCE);
+        VerifyStates(Tracker, RefStates);
+        // Read mips are merged into a single run
+        EXPECT_EQ(Tracker.GetRunCount(), 2u);
+    }
+
+    Tracker.SetState(Range{MipLevels - 1, 1, 0, 1}, RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_TRUE(Tracker.IsUniform());
+    EXPECT_EQ(Tracker.GetUniformState(), RESOURCE_STATE_SHADER_RESOURCE);
+}
+
+TEST(GraphicsEngine_SubresourceStateTracker, ArraySlices)
+{
+    constexpr Uint32            MipLevels   = 4;
+    constexpr Uint32            ArraySlices = 6;
+    SubresourceStateTracker     Tracker{MipLevels, ArraySlices, RESOURCE_STATE_SHADER_RESOURCE};
+    std::vector<RESOURCE_STATE> RefStates(MipLevels * ArraySlices, RESOURCE_STATE_SHADER_RESOURCE);
+
+    // All mips of slices 2..3
+    Tracker.SetState(Range{0, MipLevels, 2, 2}, RESOURCE_STATE_COPY_DEST);
+    SetRefState(RefStates, MipLevels, Range{0, MipLevels, 2, 2}, RESOURCE_STATE_COPY_DEST);
+    VerifyStates(Tracker, RefStates);
+    EXPECT_EQ(Tracker.GetRunCount(), 3u);
+
+    // Same mips in all slices are grouped into one range
+    Tracker.SetState(RESOURCE_STATE_SHADER_RESOURCE);
+    Tracker.SetState(Range{1, 2, 0, ArraySlices}, RESOURCE_STATE_RENDER_TARGET);
+    std::fill(RefStates.begin(), RefStates.end(), RESOURCE_STATE_SHADER_RESOURCE);
+    SetRefState(RefStates, MipLevels, Range{1, 2, 0, ArraySlices}, RESOURCE_STATE_RENDER_TARGET);
+    VerifyStates(Tracker, RefStates);
+
+    std::vector<std::pair<Range, RESOURCE_STATE>> Ranges;
+    Tracker.ProcessRange(Range{0, MipLevels, 0, ArraySlices},
+                         [&](const Range& R, RESOURCE_STATE State) {
+                             Ranges.emplace_back(R, State);
+                         });
+    ASSERT_EQ(Ranges.size(), 3u);
+    EXPECT_EQ(Ranges[0].first, (Range{0, 1, 0, ArraySlices}));
+    EXPECT_EQ(Ranges[1].first, (Range{1, 2, 0, ArraySlices}));
+    EXPECT_EQ(Ranges[1].second, RESOURCE_STATE_RENDER_TARGET);
+    EXPECT_EQ(Ranges[2].first, (Range{3, 1, 0, ArraySlices}));
+}
+
+TEST(GraphicsEngine_SubresourceStateTracker, Random)
+{
+    constexpr RESOURCE_STATE States[] = {
+        RESOURCE_STATE_SHADER_RESOURCE,
+        RESOURCE_STATE_RENDER_TARGET,
+        RESOURCE_STATE_UNORDERED_ACCESS,
+        RESOURCE_STATE_COPY_DEST,
+    };
+
+    std::mt19937 Gen{42};
+    for (Uint32 MipLevels : {1u, 3u, 7u})
+    {
+        for (Uint32 ArraySlices : {1u, 2u, 5u})
+        {
+            SubresourceStateTracker     Tracker{MipLevels, ArraySlices, States[0]};
+            std::vector<RESOURCE_STATE> RefStates(MipLevels * ArraySlices, States[0]);
+            for (Uint32 i = 0; i < 200; ++i)
+            {
+                Range R;
+                R.FirstMip   = std::uniform_int_distribution<Uint32>{0, MipLevels - 1}(Gen);
+                R.NumMips    = std::uniform_int_distribution<Uint32>{1, MipLevels - R.FirstMip}(Gen);
+                R.FirstSlice = std::uniform_int_distribution<Uint32>{0, ArraySlices - 1}(Gen);
+                R.NumSlices  = std::uniform_int_distribution<Uint32>{1, ArraySlices - R.FirstSlice}(Gen);
+
+                const auto State = States[std::uniform_int_distribution<size_t>{0, _countof(States) - 1}(Gen)];
+                Tracker.SetState(R, State);
+                SetRefState(RefStates, MipLevels, R, State);
+                VerifyStates(Tracker, RefStates);
+            }
+        }
+    }
+}
+
+} // namespace
@@ -24,6 +24,8 @@
  *  of the possibility of such damages.
  */
 
+#include <string>
+
 #include "BytecodeCache.h"
 #include "DataBlobImpl.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
@@ -72,6 +74,54 @@ TEST(BytecodeCacheTest, Basic)
     }
 }
 
+TEST(BytecodeCacheTest, Compression)
+{
+    BytecodeCacheCreateInfo CacheCI;
+    CacheCI.DeviceType       = RENDER_DEVICE_TYPE_VULKAN;
+    CacheCI.CompressBytecode = true;
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "TestName";
+    ShaderCI.Source          = "SomeCode";
+
+    std::string Data;
+    for (int i = 0; i < 1000; ++i)
+        Data += "OpStore %out_var_SV_Target %" + std::to_string(i % 10) + "\n";
+    RefCntAutoPtr<IDataBlob> pBytecodeSaved = DataBlobImpl::Create(Data.length(), Data.c_str());
+    pCache->AddBytecode(ShaderCI, pBytecodeSaved);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pCache->Store(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+    EXPECT_LT(pCacheData->GetSize(), Data.length() / 3);
+
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        pCache->Clear();
+        EXPECT_TRUE(pCache->Load(pCacheData));
+
+        // Storing the cache before the byte code is requested reuses the compressed data
+        if (i == 1)
+        {
+            RefCntAutoPtr<IDataBlob> pCacheData2;
+            pCache->Store(&pCacheData2);
+            ASSERT_NE(pCacheData2, nullptr);
+            EXPECT_EQ(pCacheData2->GetSize(), pCacheData->GetSize());
+        }
+
+        RefCntAutoPtr<IDataBlob> pBytecodeLoaded;
+        pCache->GetBytecode(ShaderCI, &pBytecodeLoaded);
+        ASSERT_NE(pBytecodeLoaded, nullptr);
+        ASSERT_EQ(pBytecodeSaved->GetSize(), pBytecodeLoaded->GetSize());
+        EXPECT_EQ(memcmp(pBytecodeSaved->GetConstDataPtr(), pBytecodeLoaded->GetConstDataPtr(), pBytecodeLoaded->GetSize()), 0);
+    }
+}
+
 TEST(BytecodeCacheTest, RemoveBytecode)
 {
     RefCntAutoPtr<IBytecodeCache> pCache;
@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Creates a grid of GridSize x GridSize quads in the XY plane
+void CreateGrid(Uint32 GridSize, std::vector<float3>& Positions, std::vector<Uint32>& Indices)
+{
+    for (Uint32 y = 0; y <= GridSize; ++y)
+    {
+        for (Uint32 x = 0; x <= GridSize; ++x)
+            Positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.f);
+    }
+
+    for (Uint32 y = 0; y < GridSize; ++y)
+    {
+        for (Uint32 x = 0; x < GridSize; ++x)
+        {
+            const Uint32 v0 = y * (GridSize + 1) + x;
+            const Uint32 v1 = v0 + 1;
+            const Uint32 v2 = v0 + GridSize + 1;
+            const Uint32 v3 = v2 + 1;
+            // Clockwise when viewed from -Z
+            Indices.insert(Indices.end(), {v0, v2, v1, v1, v2, v3});
+        }
+    }
+}
+
+std::vector<std::array<Uint32, 3>> GetSortedTriangles(const MeshletBuffer& Buffer)
+{
+    std::vector<std::array<Uint32, 3>> Triangles;
+    for (const auto& Meshlet : Buffer.Meshlets)
+    {
+        for (Uint32 t = 0; t < Meshlet.TriangleCount; ++t)
+        {
+            const auto Tri = Buffer.Triangles[Meshlet.TriangleOffset + t];
+
+            std::array<Uint32, 3> Verts;
+            for (Uint32 i = 0; i < 3; ++i)
+                Verts[i] = Buffer.Vertices[Meshlet.VertexOffset + ((Tri >> (i * 8)) & 0xFF)];
+            // Rotate the triangle to preserve the winding
+            std::rotate(Verts.begin(), std::min_element(Verts.begin(), Verts.end()), Verts.end());
+            Triangles.push_back(Verts);
+        }
+    }
+    std::sort(Triangles.begin(), Triangles.end());
+    return Triangles;
+}
+
+void TestBuildMeshlets(Uint32 MaxVertices, Uint32 MaxTriangles, bool OptimizeVertexCache)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(32, Positions, Indices);
+
+    BuildMeshletsAttribs Attribs;
+    Attribs.pIndices            = Indices.data();
+    Attribs.NumIndices          = static_cast<Uint32>(Indices.size());
+    Attribs.pPositions          = Positions.data();
+    Attribs.NumVertices         = static_cast<Uint32>(Positions.size());
+    Attribs.MaxVertices         = MaxVertices;
+    Attribs.MaxTriangles        = MaxTriangles;
+    Attribs.OptimizeVertexCache = OptimizeVertexCache;
+
+    MeshletBuffer Buffer;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+    ASSERT_EQ(Buffer.Bounds.size(), Buffer.Meshlets.size());
+
+    const auto NumTriangles = Indices.size() / 3;
+    // Meshlets must be reasonably full
+    EXPECT_LE(Buffer.Meshlets.size(), NumTriangles / std::min(MaxTriangles, MaxVertices) * 2 + 1);
+
+    for (size_t m = 0; m < Buffer.Meshlets.size(); ++m)
+    {
+        const auto& Meshlet = Buffer.Meshlets[m];
+        EXPECT_GT(Meshlet.TriangleCount, 0u);
+        EXPECT_LE(Meshlet.VertexCount, MaxVertices);
+        EXPECT_LE(Meshlet.TriangleCount, MaxTriangles);
+
+        // All vertices must be inside the bounding sphere
+        const auto& Sphere = Buffer.Bounds[m].Sphere;
+        for (Uint32 v = 0; v < Meshlet.VertexCount; ++v)
+        {
+            const auto& Pos = Positions[Buffer.Vertices[Meshlet.VertexOffset + v]];
+            EXPECT_LE(length(Pos - float3{Sphere}), Sphere.w * 1.0001f);
+        }
+
+        // Flat meshlets face -Z
+        const auto& Cone = Buffer.Bounds[m].Cone;
+        EXPECT_NEAR(Cone.z, -1.f, 1e-6f);
+        EXPECT_NEAR(Cone.w, 0.f, 1e-3f);
+    }
+
+    std::vector<std::array<Uint32, 3>> RefTriangles;
+    for (size_t t = 0; t < NumTriangles; ++t)
+    {
+        std::array<Uint32, 3> Verts{Indices[t * 3 + 0], Indices[t * 3 + 1], Indices[t * 3 + 2]};
+        std::rotate(Verts.begin(), std::min_element(Verts.begin(), Verts.end()), Verts.end());
+        RefTriangles.push_back(Verts);
+    }
+    std::sort(RefTriangles.begin(), RefTriangles.end());
+    EXPECT_EQ(GetSortedTriangles(Buffer), RefTriangles);
+}
+
+TEST(MeshletBuilderTest, Build)
+{
+    TestBuildMeshlets(64, 124, true);
+    TestBuildMeshlets(64, 124, false);
+    TestBuildMeshlets(3, 1, true);
+    TestBuildMeshlets(256, 512, true);
+    TestBuildMeshlets(32, 256, true);
+}
+
+TEST(MeshletBuilderTest, ConeCulling)
+{
+    // A tetrahedron-like cap: four triangles around the apex that face -Z
+    const float3 Positions[] =
+        {
+            {0, 0, -0.2f},
+            {-1, -1, 0},
+            {1, -1, 0},
+            {1, 1, 0},
+            {-1, 1, 0},
+        };
+    const Uint32 Indices[] = {0, 2, 1, 0, 3, 2, 0, 4, 3, 0, 1, 4};
+
+    BuildMeshletsAttribs Attribs;
+    Attribs.pIndices    = Indices;
+    Attribs.NumIndices  = sizeof(Indices) / sizeof(Indices[0]);
+    Attribs.pPositions  = Positions;
+    Attribs.NumVertices = sizeof(Positions) / sizeof(Positions[0]);
+
+    MeshletBuffer Buffer;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+    ASSERT_EQ(Buffer.Meshlets.size(), 1u);
+
+    const auto Bounds = Buffer.Bounds[0];
+    EXPECT_LT(Bounds.Cone.w, 1.f);
+
+    const auto IsBackFacing = [&](const float3& CameraPos) {
+        const auto Dir = float3{Bounds.Sphere} - CameraPos;
+        return dot(Dir, float3{Bounds.Cone}) >= Bounds.Cone.w * length(Dir) + Bounds.Sphere.w;
+    };
+    EXPECT_TRUE(IsBackFacing(float3{0, 0, 10}));
+    EXPECT_FALSE(IsBackFacing(float3{0, 0, -10}));
+    EXPECT_FALSE(IsBackFacing(float3{10, 0, 0}));
+
+    // Flip the winding
+    Attribs.FrontCounterClockwise = true;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+    EXPECT_NEAR(Buffer.Bounds[0].Cone.z, -Bounds.Cone.z, 1e-6f);
+
+    // A closed shape can't be cone-culled
+    const Uint32 ClosedIndices[] = {0, 2, 1, 0, 3, 2, 0, 4, 3, 0, 1, 4, 1, 2, 3, 1, 3, 4};
+    Attribs.pIndices             = ClosedIndices;
+    Attribs.NumIndices           = sizeof(ClosedIndices) / sizeof(ClosedIndices[0]);
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+    EXPECT_EQ(Buffer.Bounds[0].Cone.w, 1.f);
+}
+
+TEST(MeshletBuilderTest, DegenerateTriangles)
+{
+    const float3 Positions[] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    const Uint32 Indices[]   = {0, 0, 1, 0, 2, 1, 2, 2, 2};
+
+    BuildMeshletsAttribs Attribs;
+    Attribs.pIndices    = Indices;
+    Attribs.NumIndices  = sizeof(Indices) / sizeof(Indices[0]);
+    Attribs.pPositions  = Positions;
+    Attribs.NumVertices = sizeof(Positions) / sizeof(Positions[0]);
+
+    MeshletBuffer Buffer;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+    ASSERT_EQ(Buffer.Meshlets.size(), 1u);
+    EXPECT_EQ(Buffer.Meshlets[0].TriangleCount, 1u);
+    EXPECT_EQ(Buffer.Meshlets[0].VertexCount, 3u);
+
+    // Expected errors are checked in the reverse order
+    TestingEnvironment::ErrorScope ExpectedErrors{"must be in the range [3, 256]", "multiple of 3", "out of range"};
+
+    const Uint32 InvalidIndices[] = {0, 1, 3};
+    Attribs.pIndices              = InvalidIndices;
+    Attribs.NumIndices            = 3;
+    EXPECT_FALSE(BuildMeshlets(Attribs, Buffer));
+
+    Attribs.pIndices   = Indices;
+    Attribs.NumIndices = 4;
+    EXPECT_FALSE(BuildMeshlets(Attribs, Buffer));
+
+    Attribs.NumIndices  = 3;
+    Attribs.MaxVertices = 257;
+    EXPECT_FALSE(BuildMeshlets(Attribs, Buffer));
+}
+
+TEST(MeshletBuilderTest, Serialization)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateGrid(16, Positions, Indices);
+
+    BuildMeshletsAttribs Attribs;
+    Attribs.pIndices    = Indices.data();
+    Attribs.NumIndices  = static_cast<Uint32>(Indices.size());
+    Attribs.pPositions  = Positions.data();
+    Attribs.NumVertices = static_cast<Uint32>(Positions.size());
+
+    MeshletBuffer Buffer;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Buffer));
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Buffer.Store(&pData);
+    ASSERT_NE(pData, nullptr);
+
+    MeshletBuffer Loaded;
+    ASSERT_TRUE(Loaded.Load(pData));
+    EXPECT_EQ(Loaded.MaxVertices, Buffer.MaxVertices);
+    EXPECT_EQ(Loaded.MaxTriangles, Buffer.MaxTriangles);
+    EXPECT_EQ(Loaded.Vertices, Buffer.Vertices);
+    EXPECT_EQ(Loaded.Triangles, Buffer.Triangles);
+    ASSERT_EQ(Loaded.Meshlets.size(), Buffer.Meshlets.size());
+    EXPECT_EQ(memcmp(Loaded.Meshlets.data(), Buffer.Meshlets.data(), Buffer.Meshlets.size() * sizeof(MeshletDesc)), 0);
+    EXPECT_EQ(memcmp(Loaded.Bounds.data(), Buffer.Bounds.data(), Buffer.Bounds.size() * sizeof(MeshletBounds)), 0);
+
+    // Corrupt a triangle
+    {
+        auto* pTriangles = reinterpret_cast<Uint32*>(static_cast<Uint8*>(pData->GetDataPtr()) + pData->GetSize()) - Buffer.Triangles.size();
+        pTriangles[0] |= 0xFF;
+
+        TestingEnvironment::ErrorScope ExpectedErrors{"corrupted"};
+        EXPECT_FALSE(Loaded.Load(pData));
+        EXPECT_TRUE(Loaded.Meshlets.empty());
+    }
+
+    // Truncate the data
+    {
+        pData->Resize(pData->GetSize() - 4);
+
+        TestingEnvironment::ErrorScope ExpectedErrors{"does not match the expected size"};
+        EXPECT_FALSE(Loaded.Load(pData));
+    }
+}
+
+} // namespace
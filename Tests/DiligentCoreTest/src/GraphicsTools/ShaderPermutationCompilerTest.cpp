@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderPermutationCompiler.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+XXH128Hash ComputeKey(const char* Source, const ShaderMacro* Macros, const char* Name = "TestShader", const char* EntryPoint = "main")
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = Source;
+    ShaderCI.Macros          = Macros;
+    ShaderCI.EntryPoint      = EntryPoint;
+    ShaderCI.Desc.Name       = Name;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    return ShaderPermutationCompiler::ComputeKey(ShaderCI, RENDER_DEVICE_TYPE_VULKAN);
+}
+
+constexpr char Source[] = R"(
+// Test shader
+#define SCALE (A * 2.0)
+float4 main() : SV_Target
+{
+#if USE_COLOR
+    return float4(SCALE, 0.0, 0.0, 1.0); /* red */
+#else
+    return float4(0.0, 0.0, 0.0, 1.0);
+#endif
+}
+)";
+
+TEST(ShaderPermutationCompilerTest, NormalizedSource)
+{
+    constexpr char ReformattedSource[] = R"(
+/* Test shader */
+#define SCALE   (A * 2.0)
+
+float4 main()   :   SV_Target
+
+{
+#if USE_COLOR // Color
+        return float4(SCALE, 0.0, 0.0, 1.0);
+#else
+        return float4(0.0,  0.0, 0.0, 1.0);
+#endif
+}
+)";
+
+    const auto Key = ComputeKey(Source, nullptr);
+    EXPECT_EQ(Key, ComputeKey(ReformattedSource, nullptr));
+    EXPECT_EQ(Key, ComputeKey(Source, nullptr, "OtherName"));
+    EXPECT_FALSE(Key == ComputeKey(Source, nullptr, "TestShader", "main2"));
+
+    constexpr char ModifiedSource[] = R"(
+#define SCALE (A * 3.0)
+float4 main() : SV_Target
+{
+#if USE_COLOR
+    return float4(SCALE, 0.0, 0.0, 1.0);
+#else
+    return float4(0.0, 0.0, 0.0, 1.0);
+#endif
+}
+)";
+    EXPECT_FALSE(Key == ComputeKey(ModifiedSource, nullptr));
+}
+
+TEST(ShaderPermutationCompilerTest, Macros)
+{
+    const ShaderMacro Macros0[] = {{"USE_COLOR", "1"}, {"A", "1.0"}, {}};
+    const ShaderMacro Macros1[] = {{"A", "1.0"}, {"USE_COLOR", "1"}, {}};
+    const ShaderMacro Macros2[] = {{"UNUSED", "1"}, {"A", "1.0"}, {"USE_COLOR", "1"}, {"UNUSED2", "2"}, {}};
+    const ShaderMacro Macros3[] = {{"USE_COLOR", "0"}, {"A", "1.0"}, {}};
+    const ShaderMacro Macros4[] = {{"USE_COLOR", "1"}, {"A", "B"}, {"B", "1.0"}, {}};
+    const ShaderMacro Macros5[] = {{"USE_COLOR", "1"}, {"A", "B"}, {"B", "2.0"}, {}};
+    const ShaderMacro Macros6[] = {{"USE_COLOR", "0"}, {"A", "1.0"}, {"USE_COLOR", "1"}, {}};
+
+    const auto Key = ComputeKey(Source, Macros0);
+
+    // Order of macros does not matter
+    EXPECT_EQ(Key, ComputeKey(Source, Macros1));
+    // Unreferenced macros are ignored
+    EXPECT_EQ(Key, ComputeKey(Source, Macros2));
+    // The last definition is used
+    EXPECT_EQ(Key, ComputeKey(Source, Macros6));
+    // Referenced macro values matter
+    EXPECT_FALSE(Key == ComputeKey(Source, Macros3));
+    // Macros referenced by other macros matter
+    EXPECT_FALSE(ComputeKey(Source, Macros4) == ComputeKey(Source, Macros5));
+}
+
+} // namespace
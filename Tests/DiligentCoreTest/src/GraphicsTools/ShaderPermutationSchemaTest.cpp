@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderPermutationSchema.hpp"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(ShaderPermutationSchemaTest, PackKey)
+{
+    ShaderPermutationSchema Schema;
+
+    const auto UseColor = Schema.AddBool("USE_COLOR");
+    const auto NumLights = Schema.AddInt("NUM_LIGHTS", -2, 5);
+    const auto Mode      = Schema.AddEnum("MODE", {"MODE_A", "MODE_B", "MODE_C"});
+    const auto Constant  = Schema.AddInt("CONSTANT", 7, 7);
+    EXPECT_EQ(Schema.GetNumFields(), 4u);
+    EXPECT_EQ(Schema.GetNumKeyBits(), 1u + 3u + 2u);
+    EXPECT_EQ(Schema.GetFieldIndex("MODE"), Mode);
+    EXPECT_EQ(Schema.GetFieldIndex("UNKNOWN"), ~0u);
+
+    ShaderPermutationKey Key;
+    EXPECT_EQ(Schema.GetValue(Key, UseColor), 0);
+    EXPECT_EQ(Schema.GetValue(Key, NumLights), -2);
+    EXPECT_EQ(Schema.GetValue(Key, Constant), 7);
+
+    Schema.SetValue(Key, UseColor, 1);
+    Schema.SetValue(Key, NumLights, 5);
+    Schema.SetValue(Key, Mode, 2);
+    EXPECT_EQ(Schema.GetValue(Key, UseColor), 1);
+    EXPECT_EQ(Schema.GetValue(Key, NumLights), 5);
+    EXPECT_EQ(Schema.GetValue(Key, Mode), 2);
+
+    Schema.SetValue(Key, NumLights, 0);
+    EXPECT_EQ(Schema.GetValue(Key, UseColor), 1);
+    EXPECT_EQ(Schema.GetValue(Key, NumLights), 0);
+    EXPECT_EQ(Schema.GetValue(Key, Mode), 2);
+
+    std::vector<ShaderMacro> Macros;
+    Schema.GetMacros(Key, Macros);
+    ASSERT_EQ(Macros.size(), 5u);
+    EXPECT_STREQ(Macros[0].Name, "USE_COLOR");
+    EXPECT_STREQ(Macros[0].Definition, "1");
+    EXPECT_STREQ(Macros[1].Name, "NUM_LIGHTS");
+    EXPECT_STREQ(Macros[1].Definition, "0");
+    EXPECT_STREQ(Macros[2].Name, "MODE");
+    EXPECT_STREQ(Macros[2].Definition, "MODE_C");
+    EXPECT_STREQ(Macros[3].Name, "CONSTANT");
+    EXPECT_STREQ(Macros[3].Definition, "7");
+    EXPECT_EQ(Macros[4].Name, nullptr);
+}
+
+TEST(ShaderPermutationSchemaTest, MacroHelperConversion)
+{
+    ShaderPermutationSchema Schema;
+
+    const auto UseColor  = Schema.AddBool("USE_COLOR");
+    const auto NumLights = Schema.AddInt("NUM_LIGHTS", 0, 16);
+    const auto Mode      = Schema.AddEnum("MODE", {"MODE_A", "MODE_B"});
+
+    for (Uint32 i = 0; i < 2 * 17 * 2; ++i)
+    {
+        ShaderPermutationKey Key;
+        Schema.SetValue(Key, UseColor, static_cast<Int32>(i % 2));
+        Schema.SetValue(Key, NumLights, static_cast<Int32>((i / 2) % 17));
+        Schema.SetValue(Key, Mode, static_cast<Int32>(i / 34));
+
+        auto Helper = Schema.GetMacroHelper(Key);
+
+        ShaderPermutationKey Key2{~Uint64{0}};
+        EXPECT_TRUE(Schema.GetKey(Helper, Key2));
+        EXPECT_EQ(Key, Key2);
+    }
+
+    // Definitions written by ShaderMacroHelper
+    ShaderMacroHelper Helper;
+    Helper.AddShaderMacro("USE_COLOR", true);
+    Helper.AddShaderMacro("NUM_LIGHTS", Uint32{12});
+    Helper.AddShaderMacro("OTHER_MACRO", 3.5f);
+
+    ShaderPermutationKey Key;
+    EXPECT_TRUE(Schema.GetKey(Helper, Key));
+    EXPECT_EQ(Schema.GetValue(Key, UseColor), 1);
+    EXPECT_EQ(Schema.GetValue(Key, NumLights), 12);
+    EXPECT_EQ(Schema.GetValue(Key, Mode), 0);
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"does not match any value"};
+        Helper.UpdateMacro("MODE", "MODE_X");
+        EXPECT_FALSE(Schema.GetKey(Helper, Key));
+    }
+}
+
+TEST(ShaderPermutationSchemaTest, Hash)
+{
+    ShaderPermutationSchema Schema1;
+    Schema1.AddBool("A");
+    Schema1.AddEnum("B", {"X", "Y"});
+
+    ShaderPermutationSchema Schema2;
+    Schema2.AddBool("A");
+    Schema2.AddEnum("B", {"X", "Z"});
+    EXPECT_FALSE(Schema1.GetHash() == Schema2.GetHash());
+
+    ShaderPermutationSchema Schema3;
+    Schema3.AddBool("A");
+    Schema3.AddEnum("B", {"X", "Y"});
+    EXPECT_TRUE(Schema1.GetHash() == Schema3.GetHash());
+}
+
+TEST(ShaderPermutationSchemaTest, Errors)
+{
+    ShaderPermutationSchema Schema;
+    Schema.AddInt("A", 0, 4095);
+    Schema.AddInt("B", 0, 4095);
+    Schema.AddInt("C", 0, 4095);
+    Schema.AddInt("D", 0, 4095);
+    Schema.AddInt("E", 0, 4095);
+    EXPECT_EQ(Schema.GetNumKeyBits(), 60u);
+
+    // Expected errors are checked in the reverse order
+    TestingEnvironment::ErrorScope ExpectedErrors{"Invalid range", "exceeds the limit", "bits of the permutation key", "already declared"};
+    EXPECT_THROW(Schema.AddBool("A"), std::runtime_error);
+    EXPECT_THROW(Schema.AddEnum("F", {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12", "13", "14", "15", "16"}), std::runtime_error);
+    EXPECT_THROW(Schema.AddInt("G", 0, 4096), std::runtime_error);
+    EXPECT_THROW(Schema.AddInt("H", 1, 0), std::runtime_error);
+    EXPECT_EQ(Schema.GetNumFields(), 5u);
+    EXPECT_EQ(Schema.GetNumKeyBits(), 60u);
+}
+
+} // namespace
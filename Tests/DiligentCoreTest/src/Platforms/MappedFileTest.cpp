@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MappedFile.hpp"
+
+#include <vector>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "TempDirectory.hpp"
+#include "TestingEnvironment.hpp"
+#include "FileWrapper.hpp"
+#include "FastRand.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "MappedFileStream.hpp"
+#include "DataBlobImpl.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#if DILIGENT_MAPPED_FILE_SUPPORTED
+
+namespace
+{
+
+std::string WriteTestFile(const std::string& DirPath, const char* FileName, const std::vector<Int32>& Data)
+{
+    const auto FilePath = DirPath + FileSystem::SlashSymbol + FileName;
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (File && !Data.empty())
+        File->Write(Data.data(), Data.size() * sizeof(Data[0]));
+
+    return FilePath;
+}
+
+TEST(Platforms_MappedFile, Map)
+{
+    TempDirectory TmpDir;
+
+    std::vector<Int32> Data(4096);
+
+    FastRandInt rnd{0, 0, static_cast<Int32>(FastRand::Max - 1)};
+    for (auto& Elem : Data)
+        Elem = rnd();
+
+    const auto FilePath = WriteTestFile(TmpDir.Get(), "MappedFile.bin", Data);
+    {
+        MappedFile File{FilePath.c_str()};
+        ASSERT_EQ(File.GetSize(), Data.size() * sizeof(Data[0]));
+        ASSERT_NE(File.GetData(), nullptr);
+        EXPECT_EQ(std::memcmp(File.GetData(), Data.data(), File.GetSize()), 0);
+    }
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+TEST(Platforms_MappedFile, EmptyFile)
+{
+    TempDirectory TmpDir;
+
+    const auto FilePath = WriteTestFile(TmpDir.Get(), "EmptyFile.bin", {});
+    {
+        MappedFile File{FilePath.c_str()};
+        EXPECT_EQ(File.GetSize(), size_t{0});
+        EXPECT_EQ(File.GetData(), nullptr);
+    }
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+TEST(Platforms_MappedFile, DataBlob)
+{
+    TempDirectory TmpDir;
+
+    std::vector<Int32> Data(1024);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Int32>(i * 7);
+
+    const auto FilePath = WriteTestFile(TmpDir.Get(), "MappedBlob.bin", Data);
+    {
+        auto pBlob = MappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_NE(pBlob, nullptr);
+        ASSERT_EQ(pBlob->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(std::memcmp(pBlob->GetConstDataPtr(), Data.data(), pBlob->GetSize()), 0);
+    }
+    FileSystem::DeleteFile(FilePath.c_str());
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"Failed to open file"};
+    EXPECT_EQ(MappedFileDataBlob::Create(FilePath.c_str()), nullptr);
+}
+
+TEST(Platforms_MappedFile, Stream)
+{
+    TempDirectory TmpDir;
+
+    std::vector<Int32> Data(1024);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Int32>(i * 3);
+
+    const auto FilePath = WriteTestFile(TmpDir.Get(), "MappedStream.bin", Data);
+    {
+        auto pStream = MappedFileStream::Create(FilePath.c_str());
+        ASSERT_NE(pStream, nullptr);
+        EXPECT_TRUE(pStream->IsValid());
+        ASSERT_EQ(pStream->GetSize(), Data.size() * sizeof(Data[0]));
+
+        RefCntAutoPtr<IFileStream> pFileStream{pStream, IID_FileStream};
+        EXPECT_NE(pFileStream, nullptr);
+        RefCntAutoPtr<MappedFileStream> pMappedStream{pFileStream, IID_MappedFileStream};
+        EXPECT_EQ(pMappedStream, pStream);
+
+        // The data blob references the mapped file without copying
+        IDataBlob* pBlob = pStream->GetDataBlob();
+        ASSERT_NE(pBlob, nullptr);
+        EXPECT_EQ(std::memcmp(pBlob->GetConstDataPtr(), Data.data(), pBlob->GetSize()), 0);
+
+        Int32 FirstElements[4] = {};
+        EXPECT_TRUE(pStream->Read(FirstElements, sizeof(FirstElements)));
+        EXPECT_EQ(std::memcmp(FirstElements, Data.data(), sizeof(FirstElements)), 0);
+
+        auto pRemaining = DataBlobImpl::Create();
+        pStream->ReadBlob(pRemaining);
+        ASSERT_EQ(pRemaining->GetSize(), (Data.size() - 4) * sizeof(Data[0]));
+        EXPECT_EQ(std::memcmp(pRemaining->GetConstDataPtr(), &Data[4], pRemaining->GetSize()), 0);
+
+        EXPECT_FALSE(pStream->Read(FirstElements, sizeof(FirstElements)));
+    }
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+TEST(Platforms_MappedFile, ReadAsync)
+{
+    TempDirectory TmpDir;
+
+    std::vector<Int32> Data(65536);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Int32>(i * 5);
+
+    const auto FilePath = WriteTestFile(TmpDir.Get(), "AsyncRead.bin", Data);
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pData;
+
+        auto pTask = ReadFileAsync(FilePath.c_str(), pThreadPool,
+                                   [&pData](IDataBlob* pBlob) {
+                                       pData = pBlob;
+                                   });
+        ASSERT_NE(pTask, nullptr);
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+
+        ASSERT_NE(pData, nullptr);
+        ASSERT_EQ(pData->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(std::memcmp(pData->GetConstDataPtr(), Data.data(), pData->GetSize()), 0);
+
+        // Without a thread pool, the file is read synchronously
+        bool Called = false;
+        pTask       = ReadFileAsync(FilePath.c_str(), nullptr,
+                                    [&](IDataBlob* pBlob) {
+                                  EXPECT_NE(pBlob, nullptr);
+                                  Called = true;
+                              });
+        EXPECT_EQ(pTask, nullptr);
+        EXPECT_TRUE(Called);
+    }
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+} // namespace
+
+#endif
@@ -26,6 +26,8 @@
  */
 
 #include "PlatformMisc.hpp"
+#include "CPUDispatch.hpp"
+#include "Align.hpp"
 
 #include "gtest/gtest.h"
 
@@ -114,4 +116,73 @@ TEST(Platforms_PlatformMisc, SwapBytes)
     EXPECT_EQ(PlatformMisc::SwapBytes(fswap), f);
 }
 
+TEST(Platforms_PlatformMisc, GetCPUInfo)
+{
+    const CPUInfo& Info = PlatformMisc::GetCPUInfo();
+    EXPECT_EQ(&Info, &PlatformMisc::GetCPUInfo()) << "CPU information must be cached";
+
+    EXPECT_GE(Info.NumLogicalCores, 1u);
+    EXPECT_GE(Info.NumPhysicalCores, 1u);
+    EXPECT_LE(Info.NumPhysicalCores, Info.NumLogicalCores);
+    EXPECT_LE(Info.NumPerformanceCores + Info.NumEfficiencyCores, Info.NumLogicalCores);
+
+    // Instruction set extensions are detected the same way on all platforms
+    EXPECT_EQ(Info.Features & ~CPU_FEATURE_FLAG_SVE & ~CPU_FEATURE_FLAG_NEON,
+              BasicPlatformMisc::GetCPUInfo().Features & ~CPU_FEATURE_FLAG_SVE & ~CPU_FEATURE_FLAG_NEON);
+
+#if defined(_M_X64) || defined(__x86_64__)
+    EXPECT_TRUE(Info.Features & CPU_FEATURE_FLAG_SSE2) << "SSE2 is mandatory on x86-64";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    EXPECT_TRUE(Info.Features & CPU_FEATURE_FLAG_NEON) << "NEON is mandatory on AArch64";
+#endif
+
+    // Extensions imply the extensions they are based on
+    if (Info.Features & CPU_FEATURE_FLAG_AVX2)
+    {
+        EXPECT_TRUE(Info.Features & CPU_FEATURE_FLAG_AVX);
+    }
+    if (Info.Features & CPU_FEATURE_FLAG_AVX512F)
+    {
+        EXPECT_TRUE(Info.Features & CPU_FEATURE_FLAG_AVX2);
+    }
+
+    if (Info.CacheLineSize != 0)
+    {
+        EXPECT_TRUE(IsPowerOfTwo(Info.CacheLineSize)) << Info.CacheLineSize;
+    }
+}
+
+int GetKernelNone() { return 0; }
+int GetKernelSSE2() { return 1; }
+int GetKernelAVX2() { return 2; }
+int GetKernelNEON() { return 3; }
+
+TEST(Platforms_PlatformMisc, SelectCPUKernel)
+{
+    using KernelType = int (*)();
+
+    EXPECT_TRUE(IsCPUFeatureSupported(CPU_FEATURE_FLAG_NONE));
+
+    const KernelType Kernel = SelectCPUKernel<KernelType>(
+        {
+            {CPU_FEATURE_FLAG_AVX2, GetKernelAVX2},
+            {CPU_FEATURE_FLAG_SSE2, GetKernelSSE2},
+            {CPU_FEATURE_FLAG_NEON, GetKernelNEON},
+        },
+        GetKernelNone);
+
+    int Expected = 0;
+    if (IsCPUFeatureSupported(CPU_FEATURE_FLAG_AVX2))
+        Expected = 2;
+    else if (IsCPUFeatureSupported(CPU_FEATURE_FLAG_SSE2))
+        Expected = 1;
+    else if (IsCPUFeatureSupported(CPU_FEATURE_FLAG_NEON))
+        Expected = 3;
+    EXPECT_EQ(Kernel(), Expected);
+
+    // Null kernels are skipped
+    EXPECT_EQ(SelectCPUKernel<KernelType>({{CPU_FEATURE_FLAG_NONE, nullptr}}, GetKernelNone)(), 0);
+    EXPECT_EQ(SelectCPUKernel<KernelType>({{CPU_FEATURE_FLAG_NONE, GetKernelSSE2}}, GetKernelNone)(), 1);
+}
+
 } // namespace
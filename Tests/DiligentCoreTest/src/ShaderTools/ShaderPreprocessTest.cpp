@@ -25,11 +25,18 @@
  */
 
 #include <deque>
+#include <vector>
+#include <string>
+#include <unordered_set>
 
 #include "ShaderToolsCommon.hpp"
+#include "HashUtils.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
 #include "RenderDevice.h"
 #include "TestingEnvironment.hpp"
+#include "TempDirectory.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
 
 #include "gtest/gtest.h"
 
@@ -193,4 +200,100 @@ TEST(ShaderPreprocessTest, UnrollIncludes)
     }
 }
 
+TEST(ShaderPreprocessTest, IncludeCache)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory("shaders/ShaderPreprocessor", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderIncludeCache IncludeCache;
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.Name                  = "TestShader";
+    ShaderCI.FilePath                   = "IncludeBasicTest.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    std::vector<std::string> RefIncludes;
+    EXPECT_TRUE(ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+        RefIncludes.push_back(ProcessInfo.FilePath);
+    }));
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        std::vector<std::string> Includes;
+        EXPECT_TRUE(ProcessShaderIncludes(
+            ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+                Includes.push_back(ProcessInfo.FilePath);
+            },
+            &IncludeCache));
+        EXPECT_EQ(Includes, RefIncludes);
+        EXPECT_EQ(IncludeCache.GetNumFiles(), RefIncludes.size());
+    }
+
+    auto pFile0 = IncludeCache.GetFile(pShaderSourceFactory, "IncludeCommon0.hlsl");
+    auto pFile1 = IncludeCache.GetFile(pShaderSourceFactory, "IncludeCommon0.hlsl");
+    ASSERT_NE(pFile0, nullptr);
+    EXPECT_EQ(pFile0, pFile1);
+    EXPECT_EQ(pFile0->Hash, ComputeHashRaw(pFile0->Source, pFile0->SourceLength));
+
+    {
+        ShaderCreateInfo UnrollCI{ShaderCI};
+        UnrollCI.FilePath = "InlineIncludeShaderTest.hlsl";
+        EXPECT_EQ(UnrollShaderIncludes(UnrollCI, &IncludeCache), UnrollShaderIncludes(UnrollCI));
+    }
+
+    IncludeCache.Clear();
+    EXPECT_EQ(IncludeCache.GetNumFiles(), size_t{0});
+    EXPECT_NE(IncludeCache.GetFile(pShaderSourceFactory, "IncludeCommon0.hlsl"), pFile0);
+}
+
+TEST(ShaderPreprocessTest, IncludeCache_RemoveModifiedFiles)
+{
+    TempDirectory TmpDir;
+
+    auto WriteFile = [&](const char* Name, const std::string& Source) {
+        const auto   Path = TmpDir.Get() + FileSystem::SlashSymbol + Name;
+        FileWrapper File{Path.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Source.data(), Source.size()));
+    };
+    WriteFile("Main.hlsl", "#include \"Common.hlsl\"\nvoid main() {}\n");
+    WriteFile("Common.hlsl", "#define VALUE 0\n");
+    WriteFile("Other.hlsl", "#define OTHER 0\n");
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory(TmpDir.Get().c_str(), &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderIncludeCache IncludeCache;
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.FilePath                   = "Main.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+    EXPECT_TRUE(ProcessShaderIncludes(ShaderCI, nullptr, &IncludeCache));
+    IncludeCache.GetFile(pShaderSourceFactory, "Other.hlsl");
+    EXPECT_EQ(IncludeCache.GetNumFiles(), size_t{3});
+
+    EXPECT_TRUE(IncludeCache.RemoveModifiedFiles().empty());
+    EXPECT_EQ(IncludeCache.GetNumFiles(), size_t{3});
+
+    auto pMainFile = IncludeCache.GetFile(pShaderSourceFactory, "Main.hlsl");
+
+    // Same size, different contents
+    WriteFile("Common.hlsl", "#define VALUE 1\n");
+    EXPECT_EQ(IncludeCache.RemoveModifiedFiles(), std::unordered_set<std::string>{"Common.hlsl"});
+    EXPECT_EQ(IncludeCache.GetNumFiles(), size_t{2});
+    EXPECT_EQ(IncludeCache.GetFile(pShaderSourceFactory, "Main.hlsl"), pMainFile);
+
+    auto pCommonFile = IncludeCache.GetFile(pShaderSourceFactory, "Common.hlsl");
+    ASSERT_NE(pCommonFile, nullptr);
+    EXPECT_EQ(std::string(pCommonFile->Source, pCommonFile->SourceLength), "#define VALUE 1\n");
+
+    // Deleted files are removed too
+    FileSystem::DeleteFile((TmpDir.Get() + FileSystem::SlashSymbol + "Other.hlsl").c_str());
+    TestingEnvironment::ErrorScope ExpectedErrors{"Failed to load shader source file 'Other.hlsl'", "Failed to create input stream for source file Other.hlsl"};
+    EXPECT_EQ(IncludeCache.RemoveModifiedFiles(), std::unordered_set<std::string>{"Other.hlsl"});
+    EXPECT_EQ(IncludeCache.GetNumFiles(), size_t{2});
+}
+
 } // namespace
@@ -36,6 +36,7 @@
 #include "SwapChain.h"
 #include "GraphicsTypesOutputInserters.hpp"
 #include "NativeWindow.h"
+#include "ThreadPool.hpp"
 #if ARCHIVER_SUPPORTED
 #    include "ArchiverFactory.h"
 #endif
@@ -59,6 +60,7 @@ public:
         Uint32             AdapterId              = DEFAULT_ADAPTER_ID;
         Uint32             NumDeferredContexts    = 4;
         bool               EnableDeviceSimulation = false;
+        bool               EnableMemoryTracking   = false;
 
         DeviceFeatures Features{DEVICE_FEATURE_STATE_OPTIONAL};
     };
@@ -127,6 +129,13 @@ public:
     }
     IDeviceContext* GetDeferredContext(size_t ctx) { return m_pDeviceContexts[m_NumImmediateContexts + ctx]; }
     ISwapChain*     GetSwapChain() { return m_pSwapChain; }
+
+    // The number of worker threads in the shader compilation thread pool
+    static constexpr Uint32 NumShaderCompilationThreads = 2;
+
+    // Returns the thread pool that the device uses to compile shaders and pipeline states
+    // created with SHADER_COMPILE_FLAG_ASYNCHRONOUS and PSO_CREATE_FLAG_ASYNCHRONOUS flags.
+    IThreadPool* GetShaderCompilationThreadPool() { return m_pShaderCompilationThreadPool; }
     size_t          GetNumDeferredContexts() const { return m_pDeviceContexts.size() - m_NumImmediateContexts; }
     size_t          GetNumImmediateContexts() const { return m_NumImmediateContexts; }
 
@@ -165,6 +174,7 @@ protected:
     };
     std::unique_ptr<PlatformData> m_pPlatformData;
 
+    RefCntAutoPtr<IThreadPool>                 m_pShaderCompilationThreadPool;
     RefCntAutoPtr<IRenderDevice>               m_pDevice;
     std::vector<RefCntAutoPtr<IDeviceContext>> m_pDeviceContexts;
     Uint32                                     m_NumImmediateContexts = 1;
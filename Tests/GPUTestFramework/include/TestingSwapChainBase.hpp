@@ -209,6 +209,11 @@ public:
         UNEXPECTED("Testing swap chain can't set the maximum frame latency");
     }
 
+    virtual const FramePacingStats& DILIGENT_CALL_TYPE GetFramePacingStats() const override final
+    {
+        return m_FramePacingStats;
+    }
+
     virtual ITextureView* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
     {
         return m_pRTV;
@@ -239,6 +244,7 @@ protected:
     RefCntAutoPtr<ITextureView>   m_pUAV;
     RefCntAutoPtr<ITextureView>   m_pDSV;
     RefCntAutoPtr<ITexture>       m_pStagingTexture;
+    FramePacingStats              m_FramePacingStats;
 
     std::unordered_map<std::string, int> m_FailureCounters;
 
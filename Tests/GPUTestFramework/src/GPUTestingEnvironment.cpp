@@ -120,7 +120,8 @@ Uint32 GPUTestingEnvironment::FindAdapter(const std::vector<GraphicsAdapterInfo>
 }
 
 GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const SwapChainDesc& SCDesc) :
-    m_DeviceType{EnvCI.deviceType}
+    m_DeviceType{EnvCI.deviceType},
+    m_pShaderCompilationThreadPool{CreateThreadPool(ThreadPoolCreateInfo{NumShaderCompilationThreads})}
 {
     Uint32 NumDeferredCtx = 0;
 
@@ -252,10 +253,12 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
                                   return DisplayModes;
                               });
 
-            EngineCI.AdapterId           = FindAdapter(Adapters, EnvCI.AdapterType, EnvCI.AdapterId);
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            EngineCI.AdapterId            = FindAdapter(Adapters, EnvCI.AdapterType, EnvCI.AdapterId);
+            NumDeferredCtx                = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts  = NumDeferredCtx;
+            EngineCI.EnableMemoryTracking = EnvCI.EnableMemoryTracking;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
+            EngineCI.pAsyncShaderCompilationThreadPool = m_pShaderCompilationThreadPool;
             pFactoryD3D11->CreateDeviceAndContextsD3D11(EngineCI, &m_pDevice, ppContexts.data());
         }
         break;
@@ -316,9 +319,11 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             EngineCI.DynamicDescriptorAllocationChunkSize[0] = 8;  // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
             EngineCI.DynamicDescriptorAllocationChunkSize[1] = 8;  // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts  = NumDeferredCtx;
+            EngineCI.EnableMemoryTracking = EnvCI.EnableMemoryTracking;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
+            EngineCI.pAsyncShaderCompilationThreadPool = m_pShaderCompilationThreadPool;
             pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &m_pDevice, ppContexts.data());
         }
         break;
@@ -352,8 +357,12 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
 
             EngineCI.Window   = Window;
             EngineCI.Features = EnvCI.Features;
-            NumDeferredCtx    = 0;
+
+            NumDeferredCtx                = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts  = NumDeferredCtx;
+            EngineCI.EnableMemoryTracking = EnvCI.EnableMemoryTracking;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
+            EngineCI.pAsyncShaderCompilationThreadPool = m_pShaderCompilationThreadPool;
             RefCntAutoPtr<ISwapChain> pSwapChain; // We will use testing swap chain instead
             pFactoryOpenGL->CreateDeviceAndSwapChainGL(
                 EngineCI, &m_pDevice, ppContexts.data(), SCDesc, &pSwapChain);
@@ -403,9 +412,11 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             //EngineCI.HostVisibleMemoryReserveSize = 48 << 20;
             EngineCI.Features = EnvCI.Features;
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts  = NumDeferredCtx;
+            EngineCI.EnableMemoryTracking = EnvCI.EnableMemoryTracking;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
+            EngineCI.pAsyncShaderCompilationThreadPool = m_pShaderCompilationThreadPool;
             pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &m_pDevice, ppContexts.data());
         }
         break;
@@ -436,9 +447,11 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             // Always enable validation
             EngineCI.SetValidationLevel(VALIDATION_LEVEL_1);
 
-            NumDeferredCtx               = EnvCI.NumDeferredContexts;
-            EngineCI.NumDeferredContexts = NumDeferredCtx;
+            NumDeferredCtx                = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts  = NumDeferredCtx;
+            EngineCI.EnableMemoryTracking = EnvCI.EnableMemoryTracking;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
+            EngineCI.pAsyncShaderCompilationThreadPool = m_pShaderCompilationThreadPool;
             pFactoryMtl->CreateDeviceAndContextsMtl(EngineCI, &m_pDevice, ppContexts.data());
         }
         break;
@@ -849,6 +862,10 @@ GPUTestingEnvironment* GPUTestingEnvironment::Initialize(int argc, char** argv)
         {
             TestEnvCI.EnableDeviceSimulation = true;
         }
+        else if (strcmp(arg, "--memory_tracking") == 0)
+        {
+            TestEnvCI.EnableMemoryTracking = true;
+        }
         else if (ParseFeatureState(arg, TestEnvCI.Features))
         {
             // Feature state has been updated by ParseFeatureState
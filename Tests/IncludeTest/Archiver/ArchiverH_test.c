@@ -33,6 +33,7 @@ void TestArchiver_CInterface(IArchiver* pArchiver)
     IArchiver_AddShader(pArchiver, (IShader*)NULL);
     IArchiver_AddPipelineState(pArchiver, (IPipelineState*)NULL);
     IArchiver_AddPipelineResourceSignature(pArchiver, (IPipelineResourceSignature*)NULL);
+    IArchiver_SetPipelineStateCacheData(pArchiver, ARCHIVE_DEVICE_DATA_FLAG_VULKAN, (IDataBlob*)NULL);
     IShader* pShader = IArchiver_GetShader(pArchiver, "Name");
     (void)pShader;
     IPipelineState* pPSO = IArchiver_GetPipelineState(pArchiver, PIPELINE_TYPE_GRAPHICS, "Name");
@@ -31,8 +31,10 @@ void TestDearchiver_CInterface(IDearchiver* pDearchiver)
     IDearchiver_LoadArchive(pDearchiver, (IDataBlob*)NULL, false);
     IDearchiver_UnpackShader(pDearchiver, (const ShaderUnpackInfo*)NULL, (IShader**)NULL);
     IDearchiver_UnpackPipelineState(pDearchiver, (const PipelineStateUnpackInfo*)NULL, (IPipelineState**)NULL);
+    IDearchiver_UnpackPipelineStates(pDearchiver, (const PipelineStateUnpackInfo*)NULL, 0, (struct IThreadPool*)NULL, (IPipelineState**)NULL);
     IDearchiver_UnpackResourceSignature(pDearchiver, (const ResourceSignatureUnpackInfo*)NULL, (IPipelineResourceSignature**)NULL);
     IDearchiver_UnpackRenderPass(pDearchiver, (const RenderPassUnpackInfo*)NULL, (IRenderPass**)NULL);
+    IDearchiver_UnpackPipelineStateCache(pDearchiver, (struct IRenderDevice*)NULL, (IPipelineStateCache**)NULL);
     IDearchiver_Store(pDearchiver, (IDataBlob**)NULL);
     IDearchiver_Reset(pDearchiver);
 }
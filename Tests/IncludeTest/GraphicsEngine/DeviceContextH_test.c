@@ -81,6 +81,10 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 
     IDeviceContext_BeginQuery(pCtx, (struct IQuery*)NULL);
     IDeviceContext_EndQuery(pCtx, (struct IQuery*)NULL);
+    IDeviceContext_GetQueryData(pCtx, 0, (struct IQuery* const*)NULL, (void*)NULL, 0, (Bool*)NULL, true);
+    IDeviceContext_GetTimestampCalibration(pCtx, (TimestampCalibration*)NULL);
+    IDeviceContext_BeginConditionalRendering(pCtx, (const BeginConditionalRenderingAttribs*)NULL);
+    IDeviceContext_EndConditionalRendering(pCtx);
 
     IDeviceContext_UpdateBuffer(pCtx, (struct IBuffer*)NULL, (Uint64)1, (Uint64)1, NULL, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_CopyBuffer(pCtx, (struct IBuffer*)NULL, (Uint64)0, RESOURCE_STATE_TRANSITION_MODE_NONE, (struct IBuffer*)NULL, (Uint64)0, (Uint64)128, RESOURCE_STATE_TRANSITION_MODE_NONE);
@@ -94,6 +98,7 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_ResolveTextureSubresource(pCtx, (struct ITexture*)NULL, (struct ITexture*)NULL, (const struct ResolveTextureSubresourceAttribs*)NULL);
 
     IDeviceContext_BuildBLAS(pCtx, (struct BuildBLASAttribs*)NULL);
+    IDeviceContext_BuildBLASBatch(pCtx, (struct BuildBLASBatchAttribs*)NULL);
     IDeviceContext_BuildTLAS(pCtx, (struct BuildTLASAttribs*)NULL);
     IDeviceContext_CopyBLAS(pCtx, (struct CopyBLASAttribs*)NULL);
     IDeviceContext_CopyTLAS(pCtx, (struct CopyTLASAttribs*)NULL);
@@ -102,6 +107,7 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_TraceRays(pCtx, (struct TraceRaysAttribs*)NULL);
     IDeviceContext_TraceRaysIndirect(pCtx, (struct TraceRaysIndirectAttribs*)NULL);
     IDeviceContext_UpdateSBT(pCtx, (struct IShaderBindingTable*)NULL, (const struct UpdateIndirectRTBufferAttribs*)NULL);
+    IDeviceContext_DispatchGraph(pCtx, (struct DispatchGraphAttribs*)NULL);
 
     struct IObject* pUserData = NULL;
     IDeviceContext_SetUserData(pCtx, pUserData);
@@ -121,4 +127,6 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_SetShadingRate(pCtx, SHADING_RATE_1X1, SHADING_RATE_COMBINER_PASSTHROUGH, SHADING_RATE_COMBINER_PASSTHROUGH);
 
     IDeviceContext_BindSparseResourceMemory(pCtx, (const BindSparseResourceMemoryAttribs*)NULL);
+
+    IDeviceContext_SetCommandValidation(pCtx, true);
 }
@@ -36,4 +36,5 @@ void TestFenceCInterface(struct IFence* pFence)
 
     IFence_Signal(pFence, (Uint64)0);
     IFence_Wait(pFence, (Uint64)0);
+    IFence_EnqueueCompletionCallback(pFence, (Uint64)0, (FenceCompletionCallbackType)NULL, (void*)NULL);
 }
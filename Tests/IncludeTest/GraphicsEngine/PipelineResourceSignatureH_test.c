@@ -30,6 +30,8 @@
 void TestPipelineResourceSignature(struct IPipelineResourceSignature* pSign)
 {
     IPipelineResourceSignature_CreateShaderResourceBinding(pSign, (struct IShaderResourceBinding**)NULL, true);
+    IPipelineResourceSignature_CreateShaderResourceBindings(pSign, 1, (struct IShaderResourceBinding**)NULL, true);
+    IPipelineResourceSignature_CloneShaderResourceBinding(pSign, (struct IShaderResourceBinding*)NULL, (struct IShaderResourceBinding**)NULL);
 
     struct IShaderResourceVariable* pVar1 = IPipelineResourceSignature_GetStaticVariableByName(pSign, SHADER_TYPE_UNKNOWN, "name");
     (void)pVar1;
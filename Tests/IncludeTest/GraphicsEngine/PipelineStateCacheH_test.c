@@ -28,5 +28,10 @@
 
 void TestPSOCache_CInterface(IPipelineStateCache* pCache)
 {
+    PipelineStateCacheStatistics Stats;
+
     IPipelineStateCache_GetData(pCache, (IDataBlob**)NULL);
+    IPipelineStateCache_Merge(pCache, 1, (IPipelineStateCache**)NULL);
+    IPipelineStateCache_Save(pCache, true);
+    IPipelineStateCache_GetStatistics(pCache, &Stats);
 }
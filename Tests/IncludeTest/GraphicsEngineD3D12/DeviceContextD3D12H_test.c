@@ -36,4 +36,6 @@ void TestDeviceContextD3D12_CInterface(IDeviceContextD3D12* pCtx)
 
     ID3D12GraphicsCommandList* pd3d12CmdList = IDeviceContextD3D12_GetD3D12CommandList(pCtx);
     (void)pd3d12CmdList;
+
+    IDeviceContextD3D12_ExecuteIndirectCommands(pCtx, (const ExecuteIndirectCommandsAttribs*)NULL);
 }
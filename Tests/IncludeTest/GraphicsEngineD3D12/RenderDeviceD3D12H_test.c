@@ -39,5 +39,6 @@ void TestRenderDeviceD3D12CInterface(IRenderDeviceD3D12* pDevice)
     IRenderDeviceD3D12_CreateBLASFromD3DResource(pDevice, (ID3D12Resource*)NULL, (BottomLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (IBottomLevelAS**)NULL);
     IRenderDeviceD3D12_CreateTLASFromD3DResource(pDevice, (ID3D12Resource*)NULL, (TopLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (ITopLevelAS**)NULL);
     const ShaderVersion* MaxVer = IRenderDeviceD3D12_GetMaxShaderVersion(pDevice);
+    IRenderDeviceD3D12_GetRootSignatureCacheData(pDevice, (IDataBlob**)NULL);
     (void)MaxVer;
 }
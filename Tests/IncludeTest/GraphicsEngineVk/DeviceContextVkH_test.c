@@ -32,4 +32,10 @@ void TestDeviceContextVk_CInterface(IDeviceContextVk* pCtx)
 {
     IDeviceContextVk_TransitionImageLayout(pCtx, (ITexture*)NULL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
     IDeviceContextVk_BufferMemoryBarrier(pCtx, (IBuffer*)NULL, VK_ACCESS_HOST_READ_BIT);
+    IDeviceContextVk_BeginSecondaryCommandList(pCtx, 0, (IRenderPass*)NULL, 0, (IFramebuffer*)NULL);
+    IDeviceContextVk_EnableSecondaryCommandLists(pCtx, true);
+    IDeviceContextVk_SetCullMode(pCtx, CULL_MODE_BACK);
+    IDeviceContextVk_SetDepthState(pCtx, true, false, COMPARISON_FUNC_LESS);
+    IDeviceContextVk_SetStencilState(pCtx, true, (const StencilOpDesc*)NULL, (const StencilOpDesc*)NULL);
+    IDeviceContextVk_SetPrimitiveTopology(pCtx, PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP);
 }
@@ -45,6 +45,14 @@ void TestRenderStateCacheCInterface()
     IRenderStateCache_CreateTilePipelineState(pCache, (TilePipelineStateCreateInfo*)NULL, &pPSO);
     IRenderStateCache_WriteToBlob(pCache, (IDataBlob**)NULL);
     IRenderStateCache_WriteToStream(pCache, (IFileStream*)NULL);
+    IRenderStateCache_AppendToJournal(pCache, (IFileStream*)NULL);
+    IRenderStateCache_LoadJournal(pCache, (IDataBlob*)NULL);
+    IRenderStateCache_CompactJournal(pCache, (IDataBlob*)NULL, (IDataBlob*)NULL, (IDataBlob**)NULL);
+    IRenderStateCache_WriteUsageLog(pCache, (IDataBlob**)NULL, true);
+    IRenderStateCache_PrefetchPipelines(pCache, (IDataBlob*)NULL, NULL);
     IRenderStateCache_Reset(pCache);
     IRenderStateCache_Reload(pCache, NULL, NULL);
+
+    RenderStateCacheStats Stats;
+    IRenderStateCache_GetStats(pCache, &Stats);
 }
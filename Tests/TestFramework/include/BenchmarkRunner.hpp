@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BasicTypes.h"
+#include "Timer.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+/// Benchmark settings that can be set from the command line.
+struct BenchmarkSettings
+{
+    /// The minimum time in seconds every benchmark runs for (--benchmark_min_time=<seconds>).
+    double MinTime = 0.25;
+
+    static BenchmarkSettings& Get()
+    {
+        static BenchmarkSettings Settings;
+        return Settings;
+    }
+
+    /// Reads the settings from the command line arguments.
+    static void ParseCommandLine(int argc, char** argv)
+    {
+        static constexpr char MinTimeArg[] = "--benchmark_min_time=";
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strncmp(argv[i], MinTimeArg, sizeof(MinTimeArg) - 1) == 0)
+                Get().MinTime = atof(argv[i] + sizeof(MinTimeArg) - 1);
+        }
+    }
+};
+
+/// Prevents the compiler from optimizing away the computation of the value.
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(_MSC_VER)
+    static const volatile void* volatile Sink = nullptr;
+    Sink                                      = &Value;
+#else
+    asm volatile(""
+                 :
+                 : "r,m"(Value)
+                 : "memory");
+#endif
+}
+
+/// Prints the benchmark result and records it as a property of the current test.
+
+/// \param [in] Name        - Benchmark name.
+/// \param [in] ElapsedTime - Total time in seconds.
+/// \param [in] NumItems    - The number of items processed in this time.
+///
+/// \return     Average time in nanoseconds per item.
+///
+/// \remarks    Use this function directly for one-shot measurements that can't be
+///             repeated, e.g. populating a cold cache.
+inline double ReportBenchmarkResult(const char* Name, double ElapsedTime, Uint64 NumItems)
+{
+    const double NsPerItem = ElapsedTime * 1e+9 / static_cast<double>(std::max(NumItems, Uint64{1}));
+
+    std::cout << "[ BENCH    ] " << std::left << std::setw(40) << Name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << NsPerItem << " ns/item  (" << NumItems << " items)" << std::endl;
+
+    ::testing::Test::RecordProperty(std::string{Name} + "_ns", std::to_string(NsPerItem));
+
+    return NsPerItem;
+}
+
+/// Runs the benchmark body repeatedly and reports the time per item.
+
+/// \param [in] Name              - Benchmark name.
+/// \param [in] Body              - Function that runs one iteration of the benchmark.
+/// \param [in] ItemsPerIteration - The number of items processed by one iteration.
+///
+/// \return     Average time in nanoseconds per item.
+///
+/// \remarks    The number of iterations is increased until the benchmark runs for
+///             at least BenchmarkSettings::MinTime seconds.
+///             The result is recorded as a property of the current test, so that it
+///             is written to the report produced with --gtest_output=json:<file>
+///             or --gtest_output=xml:<file>, which can be compared across commits.
+template <typename BodyType>
+double RunBenchmark(const char* Name, BodyType&& Body, Uint64 ItemsPerIteration = 1)
+{
+    const double MinTime = BenchmarkSettings::Get().MinTime;
+
+    // Warm up caches and lazily initialized state
+    Body();
+
+    Uint64 NumIterations = 1;
+    double ElapsedTime   = 0;
+    while (true)
+    {
+        Timer T;
+        for (Uint64 i = 0; i < NumIterations; ++i)
+            Body();
+        ElapsedTime = T.GetElapsedTime();
+
+        if (ElapsedTime >= MinTime || NumIterations >= (Uint64{1} << 40))
+            break;
+
+        // Predict the number of iterations that will take slightly longer than the minimum time
+        const auto PredictedIterations = ElapsedTime > 0 ?
+            static_cast<Uint64>(static_cast<double>(NumIterations) * MinTime * 1.4 / ElapsedTime) :
+            NumIterations * 100;
+        NumIterations = std::min(std::max(PredictedIterations, NumIterations * 2), NumIterations * 100);
+    }
+
+    return ReportBenchmarkResult(Name, ElapsedTime, NumIterations * ItemsPerIteration);
+}
+
+} // namespace Testing
+
+} // namespace Diligent